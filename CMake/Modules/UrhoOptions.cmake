@@ -139,8 +139,10 @@ option                (URHO3D_MONOLITHIC_HEADER  "Create Urho3DAll.h which inclu
 cmake_dependent_option(URHO3D_MINIDUMPS          "Enable writing minidumps on crash"                     ${URHO3D_ENABLE_ALL} "MSVC;NOT UWP"                  OFF)
 cmake_dependent_option(URHO3D_PLUGINS            "Enable plugins"                                        ${URHO3D_ENABLE_ALL} "NOT WEB;NOT UWP"               OFF)
 cmake_dependent_option(URHO3D_THREADING          "Enable multithreading"                                 ${URHO3D_ENABLE_ALL} "NOT WEB"                       OFF)
+cmake_dependent_option(URHO3D_NONATOMIC_REFCOUNT "Use non-atomic reference counting"                     OFF                  "NOT URHO3D_THREADING"          OFF)
 option                (URHO3D_WEBP               "WEBP support enabled"                                  ${URHO3D_ENABLE_ALL}                                    )
 cmake_dependent_option(URHO3D_TESTING            "Enable unit tests"                                     OFF                  "NOT WEB;NOT MOBILE;NOT UWP"    OFF)
+cmake_dependent_option(URHO3D_BENCHMARKS         "Enable microbenchmarks"                                OFF                  "NOT WEB;NOT MOBILE;NOT UWP"    OFF)
 option                (URHO3D_PACKAGING          "Enable *.pak file creation"                            OFF                                                     )
 # Web
 cmake_dependent_option(EMSCRIPTEN_WASM           "Use wasm instead of asm.js"                            ON                   "WEB"                           OFF)
@@ -159,6 +161,8 @@ option(URHO3D_SAMPLES                           "Build samples"
 cmake_dependent_option(URHO3D_MERGE_STATIC_LIBS "Merge third party dependency libs to Urho3D.a"         OFF "NOT BUILD_SHARED_LIBS"                          OFF)
 option(URHO3D_NO_EDITOR_PLAYER_EXE              "Do not build editor or player executables."            OFF)
 option(URHO3D_SSL                               "Enable OpenSSL support"                                OFF)
+set(URHO3D_LOGGING_MIN_LEVEL TRACE CACHE STRING "Log messages below this level are removed at compile time")
+set_property(CACHE URHO3D_LOGGING_MIN_LEVEL PROPERTY STRINGS TRACE DEBUG INFO WARNING ERROR)
 
 if (WIN32)
     set(URHO3D_GRAPHICS_API D3D11 CACHE STRING "Graphics API")
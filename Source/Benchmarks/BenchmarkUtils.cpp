@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "BenchmarkUtils.h"
+
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/Geometry.h>
+#include <Urho3D/Graphics/IndexBuffer.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Graphics/VertexBuffer.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace Benchmarks
+{
+
+SharedPtr<Model> CreateBoxModel(Context* context)
+{
+    auto model = MakeShared<Model>(context);
+    auto vertexBuffer = MakeShared<VertexBuffer>(context);
+    auto indexBuffer = MakeShared<IndexBuffer>(context);
+    indexBuffer->SetSize(36, false);
+    model->SetVertexBuffers({vertexBuffer}, {}, {});
+    REQUIRE(model->SetIndexBuffers({indexBuffer}));
+
+    auto geometry = MakeShared<Geometry>(context);
+    REQUIRE(geometry->SetVertexBuffer(0, vertexBuffer));
+    geometry->SetIndexBuffer(indexBuffer);
+    REQUIRE(geometry->SetDrawRange(TRIANGLE_LIST, 0, 36));
+
+    model->SetNumGeometries(1);
+    REQUIRE(model->SetNumGeometryLodLevels(0, 1));
+    REQUIRE(model->SetGeometry(0, 0, geometry));
+    model->SetBoundingBox(BoundingBox(-0.5f * Vector3::ONE, 0.5f * Vector3::ONE));
+    return model;
+}
+
+SharedPtr<Scene> CreateStaticModelScene(Context* context, const IntVector3& gridSize, float spacing)
+{
+    auto scene = MakeShared<Scene>(context);
+    auto octree = scene->CreateComponent<Octree>();
+
+    const SharedPtr<Model> model = CreateBoxModel(context);
+    const Vector3 origin = -0.5f * spacing
+        * Vector3(static_cast<float>(gridSize.x_ - 1), static_cast<float>(gridSize.y_ - 1), static_cast<float>(gridSize.z_ - 1));
+    for (int x = 0; x < gridSize.x_; ++x)
+    {
+        for (int y = 0; y < gridSize.y_; ++y)
+        {
+            for (int z = 0; z < gridSize.z_; ++z)
+            {
+                Node* node = scene->CreateChild();
+                node->SetPosition(origin + spacing * Vector3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)));
+                auto staticModel = node->CreateComponent<StaticModel>();
+                staticModel->SetModel(model);
+            }
+        }
+    }
+
+    octree->Update(CreateFrameInfo(scene, nullptr));
+    return scene;
+}
+
+Camera* CreateCamera(Scene* scene, const Vector3& position, float farClip)
+{
+    Node* node = scene->CreateChild("Camera");
+    node->SetPosition(position);
+    auto camera = node->CreateComponent<Camera>();
+    camera->SetFarClip(farClip);
+    camera->SetAspectRatio(16.0f / 9.0f);
+    return camera;
+}
+
+FrameInfo CreateFrameInfo(Scene* scene, Camera* camera, unsigned frameNumber)
+{
+    FrameInfo frameInfo;
+    frameInfo.frameNumber_ = frameNumber;
+    frameInfo.timeStep_ = 1.0f / 60.0f;
+    frameInfo.viewSize_ = {1920, 1080};
+    frameInfo.viewRect_ = {0, 0, 1920, 1080};
+    frameInfo.scene_ = scene;
+    frameInfo.camera_ = camera;
+    frameInfo.octree_ = scene->GetComponent<Octree>();
+    return frameInfo;
+}
+
+}
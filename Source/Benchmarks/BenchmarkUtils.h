@@ -0,0 +1,56 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Tests/CommonUtils.h"
+
+#include <Urho3D/Graphics/Drawable.h>
+#include <Urho3D/Math/Vector3.h>
+
+namespace Urho3D
+{
+
+class Camera;
+class Model;
+class Scene;
+
+}
+
+namespace Benchmarks
+{
+
+/// Create model of unit size with single non-empty geometry.
+SharedPtr<Model> CreateBoxModel(Context* context);
+
+/// Create scene with Octree and static models placed on the grid centered at origin.
+/// Octree is updated so drawables are ready for queries.
+SharedPtr<Scene> CreateStaticModelScene(Context* context, const IntVector3& gridSize, float spacing);
+
+/// Create camera looking along +Z from given position.
+Camera* CreateCamera(Scene* scene, const Vector3& position, float farClip = 100.0f);
+
+/// Create frame info for scene and camera.
+FrameInfo CreateFrameInfo(Scene* scene, Camera* camera, unsigned frameNumber = 1);
+
+}
@@ -0,0 +1,131 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../BenchmarkUtils.h"
+
+#include <Urho3D/Container/ConcurrentQueue.h>
+#include <Urho3D/Core/Mutex.h>
+
+#include <EASTL/deque.h>
+
+#include <atomic>
+#include <thread>
+
+namespace
+{
+
+/// Reference queue protected by mutex.
+class LockedQueue
+{
+public:
+    bool Push(unsigned& value)
+    {
+        MutexLock lock(mutex_);
+        queue_.push_back(value);
+        return true;
+    }
+
+    bool Pop(unsigned& value)
+    {
+        MutexLock lock(mutex_);
+        if (queue_.empty())
+            return false;
+        value = queue_.front();
+        queue_.pop_front();
+        return true;
+    }
+
+private:
+    Mutex mutex_;
+    ea::deque<unsigned> queue_;
+};
+
+/// Half of threads push values and another half pops them until all values are consumed.
+template <class Queue>
+unsigned long long PushAndPopConcurrently(Queue& queue, unsigned numThreads, unsigned numValuesPerProducer)
+{
+    const unsigned numProducers = numThreads / 2;
+    const unsigned numValues = numProducers * numValuesPerProducer;
+
+    std::atomic<unsigned> numReceived{};
+    std::atomic<unsigned long long> sum{};
+
+    ea::vector<std::thread> threads;
+    for (unsigned i = 0; i < numProducers; ++i)
+    {
+        threads.emplace_back([&]
+        {
+            for (unsigned j = 0; j < numValuesPerProducer; ++j)
+            {
+                unsigned value = j;
+                while (!queue.Push(value))
+                    std::this_thread::yield();
+            }
+        });
+    }
+    for (unsigned i = numProducers; i < numThreads; ++i)
+    {
+        threads.emplace_back([&]
+        {
+            unsigned long long localSum = 0;
+            unsigned value{};
+            while (numReceived.load(std::memory_order_relaxed) < numValues)
+            {
+                if (queue.Pop(value))
+                {
+                    localSum += value;
+                    numReceived.fetch_add(1, std::memory_order_relaxed);
+                }
+                else
+                    std::this_thread::yield();
+            }
+            sum.fetch_add(localSum);
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+    return sum.load();
+}
+
+}
+
+TEST_CASE("Concurrent queue under contention", "[container]")
+{
+    static constexpr unsigned numValuesPerProducer = 4096;
+
+    for (unsigned numThreads : {8u, 16u, 32u})
+    {
+        BENCHMARK(Format("ConcurrentQueue, {} threads", numThreads).c_str())
+        {
+            ConcurrentQueue<unsigned> queue;
+            queue.Allocate(1024);
+            return PushAndPopConcurrently(queue, numThreads, numValuesPerProducer);
+        };
+
+        BENCHMARK(Format("Mutex and deque (reference), {} threads", numThreads).c_str())
+        {
+            LockedQueue queue;
+            return PushAndPopConcurrently(queue, numThreads, numValuesPerProducer);
+        };
+    }
+}
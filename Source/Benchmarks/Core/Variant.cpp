@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../BenchmarkUtils.h"
+
+#include <Urho3D/Core/Variant.h>
+#include <Urho3D/Math/StringHash.h>
+
+namespace
+{
+
+ea::vector<ea::string> CreateNames(unsigned count)
+{
+    ea::vector<ea::string> names;
+    for (unsigned i = 0; i < count; ++i)
+        names.push_back(Format("Attribute Name {}", i));
+    return names;
+}
+
+}
+
+TEST_CASE("StringHash calculation", "[stringhash]")
+{
+    const auto shortString = ea::string("Position");
+    const auto longString = ea::string("Materials/Environment/Terrain/RockyCliffWithMossAndSnow.xml");
+
+    BENCHMARK("StringHash short string")
+    {
+        return StringHash(shortString).Value();
+    };
+
+    BENCHMARK("StringHash long string")
+    {
+        return StringHash(longString).Value();
+    };
+
+    BENCHMARK("StringHash::Calculate long string")
+    {
+        return StringHash::Calculate(longString.c_str(), longString.length());
+    };
+}
+
+TEST_CASE("Variant operations", "[variant]")
+{
+    const Variant intValue{42};
+    const Variant vectorValue{Vector3(1.0f, 2.0f, 3.0f)};
+    const Variant stringValue{ea::string("Some text that doesn't fit into short string")};
+    const Variant matrixValue{Matrix4::IDENTITY};
+
+    BENCHMARK("Variant copy int")
+    {
+        Variant value = intValue;
+        return value.GetInt();
+    };
+
+    BENCHMARK("Variant copy Vector3")
+    {
+        Variant value = vectorValue;
+        return value.GetVector3().x_;
+    };
+
+    BENCHMARK("Variant copy string")
+    {
+        Variant value = stringValue;
+        return value.GetString().length();
+    };
+
+    BENCHMARK("Variant copy Matrix4")
+    {
+        Variant value = matrixValue;
+        return value.GetMatrix4().m00_;
+    };
+
+    BENCHMARK("Variant compare string")
+    {
+        return stringValue == stringValue;
+    };
+
+    BENCHMARK("Variant ToString Vector3")
+    {
+        return vectorValue.ToString().length();
+    };
+}
+
+TEST_CASE("VariantMap operations", "[variant]")
+{
+    const auto names = CreateNames(32);
+    ea::vector<StringHash> keys;
+    for (const ea::string& name : names)
+        keys.push_back(StringHash(name));
+
+    VariantMap map;
+    for (unsigned i = 0; i < keys.size(); ++i)
+        map[keys[i]] = static_cast<int>(i);
+
+    BENCHMARK("VariantMap insert 32")
+    {
+        VariantMap newMap;
+        for (unsigned i = 0; i < keys.size(); ++i)
+            newMap[keys[i]] = static_cast<int>(i);
+        return newMap.size();
+    };
+
+    BENCHMARK("VariantMap find 32")
+    {
+        int sum = 0;
+        for (const StringHash key : keys)
+        {
+            const auto iter = map.find(key);
+            if (iter != map.end())
+                sum += iter->second.GetInt();
+        }
+        return sum;
+    };
+
+    BENCHMARK("VariantMap copy 32")
+    {
+        VariantMap copy = map;
+        return copy.size();
+    };
+
+    BENCHMARK("VariantMap clear and refill 32")
+    {
+        map.clear();
+        for (unsigned i = 0; i < keys.size(); ++i)
+            map[keys[i]] = static_cast<int>(i);
+        return map.size();
+    };
+}
@@ -0,0 +1,66 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../BenchmarkUtils.h"
+
+#include <Urho3D/Core/WorkQueue.h>
+
+#include <atomic>
+
+TEST_CASE("WorkQueue overhead", "[workqueue]")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+
+    ea::vector<float> values(16384, 1.0f);
+
+    ea::vector<SharedPtr<WorkTask>> tasks;
+    BENCHMARK("WorkQueue::PostTask and WaitForTasks 64 tasks")
+    {
+        std::atomic<unsigned> counter{};
+        tasks.clear();
+        for (unsigned i = 0; i < 64; ++i)
+            tasks.push_back(workQueue->PostTask([&counter](unsigned /*threadIndex*/) { ++counter; }));
+        workQueue->WaitForTasks(tasks);
+        return counter.load();
+    };
+
+    BENCHMARK("ForEachParallel empty")
+    {
+        ForEachParallel(workQueue, 1u, 0u, [](unsigned /*begin*/, unsigned /*end*/) {});
+        return 0;
+    };
+
+    BENCHMARK("ForEachParallel 16384 elements, bucket 64")
+    {
+        ForEachParallel(workQueue, 64u, values, [](unsigned /*index*/, float& value) { value = value * 0.5f + 0.5f; });
+        return values[0];
+    };
+
+    BENCHMARK("Serial loop 16384 elements (reference)")
+    {
+        for (float& value : values)
+            value = value * 0.5f + 0.5f;
+        return values[0];
+    };
+}
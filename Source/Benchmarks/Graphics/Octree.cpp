@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../BenchmarkUtils.h"
+
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/OctreeQuery.h>
+#include <Urho3D/Scene/Scene.h>
+
+TEST_CASE("Octree queries", "[octree]")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto scene = Benchmarks::CreateStaticModelScene(context, {32, 4, 32}, 4.0f);
+    auto octree = scene->GetComponent<Octree>();
+    Camera* camera = Benchmarks::CreateCamera(scene, {0.0f, 8.0f, -64.0f});
+
+    ea::vector<Drawable*> drawables;
+    ea::vector<RayQueryResult> rayResults;
+
+    BENCHMARK("Octree::GetDrawables frustum")
+    {
+        drawables.clear();
+        FrustumOctreeQuery query(drawables, camera->GetFrustum(), DRAWABLE_GEOMETRY);
+        octree->GetDrawables(query);
+        return drawables.size();
+    };
+
+    BENCHMARK("Octree::GetDrawables box")
+    {
+        drawables.clear();
+        BoxOctreeQuery query(drawables, BoundingBox(-16.0f * Vector3::ONE, 16.0f * Vector3::ONE), DRAWABLE_GEOMETRY);
+        octree->GetDrawables(query);
+        return drawables.size();
+    };
+
+    BENCHMARK("Octree::GetDrawables sphere")
+    {
+        drawables.clear();
+        SphereOctreeQuery query(drawables, Sphere(Vector3::ZERO, 16.0f), DRAWABLE_GEOMETRY);
+        octree->GetDrawables(query);
+        return drawables.size();
+    };
+
+    BENCHMARK("Octree::Raycast")
+    {
+        rayResults.clear();
+        RayOctreeQuery query(rayResults, Ray({-64.0f, 0.0f, -64.0f}, {1.0f, 0.0f, 1.0f}), RAY_AABB, 200.0f, DRAWABLE_GEOMETRY);
+        octree->Raycast(query);
+        return rayResults.size();
+    };
+}
+
+TEST_CASE("Visible drawables processing", "[drawables]")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+    const auto scene = Benchmarks::CreateStaticModelScene(context, {32, 4, 32}, 4.0f);
+    auto octree = scene->GetComponent<Octree>();
+    Camera* camera = Benchmarks::CreateCamera(scene, {0.0f, 8.0f, -64.0f});
+
+    ea::vector<Drawable*> visibleDrawables;
+    FrustumOctreeQuery query(visibleDrawables, camera->GetFrustum(), DRAWABLE_GEOMETRY);
+    octree->GetDrawables(query);
+    REQUIRE(!visibleDrawables.empty());
+
+    // Per-drawable part of DrawableProcessor::ProcessVisibleDrawables
+    const FrameInfo frameInfo = Benchmarks::CreateFrameInfo(scene, camera);
+    BENCHMARK("Drawable::UpdateBatches")
+    {
+        for (Drawable* drawable : visibleDrawables)
+            drawable->UpdateBatches(frameInfo);
+        return visibleDrawables.size();
+    };
+
+    BENCHMARK("Drawable::UpdateBatches parallel")
+    {
+        ForEachParallel(workQueue, 64u, visibleDrawables,
+            [&](unsigned /*index*/, Drawable* drawable) { drawable->UpdateBatches(frameInfo); });
+        return visibleDrawables.size();
+    };
+}
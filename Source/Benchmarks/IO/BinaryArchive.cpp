@@ -0,0 +1,73 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../BenchmarkUtils.h"
+
+#include <Urho3D/IO/BinaryArchive.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+void SaveScene(Scene* scene, VectorBuffer& buffer)
+{
+    buffer.Clear();
+    BinaryOutputArchive archive{scene->GetContext(), buffer};
+    ArchiveBlock block = archive.OpenUnorderedBlock("scene");
+    scene->SerializeInBlock(archive, false, PrefabSaveFlag::CompactAttributeNames);
+}
+
+void LoadScene(Scene* scene, const VectorBuffer& buffer)
+{
+    MemoryBuffer source(buffer.GetBuffer());
+    BinaryInputArchive archive{scene->GetContext(), source};
+    ArchiveBlock block = archive.OpenUnorderedBlock("scene");
+    scene->SerializeInBlock(archive, false, PrefabSaveFlag::None);
+}
+
+}
+
+TEST_CASE("Scene binary archive serialization", "[archive]")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto scene = Benchmarks::CreateStaticModelScene(context, {16, 4, 16}, 4.0f);
+
+    VectorBuffer buffer;
+    SaveScene(scene, buffer);
+    REQUIRE(buffer.GetSize() > 0);
+
+    BENCHMARK("BinaryOutputArchive save 1024 nodes")
+    {
+        SaveScene(scene, buffer);
+        return buffer.GetSize();
+    };
+
+    auto loadedScene = MakeShared<Scene>(context);
+    BENCHMARK("BinaryInputArchive load 1024 nodes")
+    {
+        LoadScene(loadedScene, buffer);
+        return loadedScene->GetNumChildren();
+    };
+}
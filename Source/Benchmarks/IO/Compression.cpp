@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../BenchmarkUtils.h"
+
+#include <Urho3D/IO/Compression.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+
+#include <random>
+
+namespace
+{
+
+/// Create data that compresses moderately, similar to serialized scenes and meshes.
+ea::vector<unsigned char> CreateData(unsigned size)
+{
+    std::mt19937 random(42);
+    ea::vector<unsigned char> data(size);
+    for (unsigned i = 0; i < size; ++i)
+        data[i] = static_cast<unsigned char>(i % 64 < 48 ? i / 64 : random());
+    return data;
+}
+
+}
+
+TEST_CASE("Compression round trip", "[compression]")
+{
+    const unsigned dataSize = 1024 * 1024;
+    const auto data = CreateData(dataSize);
+
+    ea::vector<unsigned char> compressed(EstimateCompressBound(dataSize));
+    const unsigned compressedSize = CompressData(compressed.data(), data.data(), dataSize);
+    REQUIRE(compressedSize > 0);
+
+    ea::vector<unsigned char> decompressed(dataSize);
+
+    BENCHMARK("CompressData 1 MiB")
+    {
+        return CompressData(compressed.data(), data.data(), dataSize);
+    };
+
+    BENCHMARK("DecompressData 1 MiB")
+    {
+        return DecompressData(decompressed.data(), compressed.data(), dataSize);
+    };
+
+    BENCHMARK("CompressStream and DecompressStream 1 MiB")
+    {
+        MemoryBuffer source(data.data(), dataSize);
+        VectorBuffer compressedStream;
+        CompressStream(compressedStream, source);
+
+        compressedStream.Seek(0);
+        VectorBuffer decompressedStream;
+        DecompressStream(decompressedStream, compressedStream);
+        return decompressedStream.GetSize();
+    };
+}
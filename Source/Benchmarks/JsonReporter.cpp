@@ -0,0 +1,121 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include <catch2/catch_amalgamated.hpp>
+
+#include <iomanip>
+
+namespace
+{
+
+/// Write string as JSON string literal.
+void WriteJsonString(std::ostream& stream, const std::string& value)
+{
+    stream << '"';
+    for (const char ch : value)
+    {
+        switch (ch)
+        {
+        case '"': stream << "\\\""; break;
+        case '\\': stream << "\\\\"; break;
+        case '\n': stream << "\\n"; break;
+        case '\r': stream << "\\r"; break;
+        case '\t': stream << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20)
+                stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(ch) << std::dec;
+            else
+                stream << ch;
+        }
+    }
+    stream << '"';
+}
+
+/// Reports benchmark results as single JSON document. Assertions are not reported.
+class JsonReporter : public Catch::StreamingReporterBase
+{
+public:
+    explicit JsonReporter(Catch::ReporterConfig&& config)
+        : StreamingReporterBase(CATCH_MOVE(config))
+    {
+        m_preferences.shouldReportAllAssertions = false;
+    }
+
+    static std::string getDescription() { return "Reports benchmark results in JSON format"; }
+
+    void testRunStarting(const Catch::TestRunInfo& testRunInfo) override
+    {
+        StreamingReporterBase::testRunStarting(testRunInfo);
+        m_stream << "{\n  \"name\": ";
+        WriteJsonString(m_stream, std::string(testRunInfo.name));
+        m_stream << ",\n  \"benchmarks\": [";
+    }
+
+    void benchmarkEnded(const Catch::BenchmarkStats<>& stats) override
+    {
+        BeginEntry(stats.info.name);
+        m_stream << std::setprecision(9)
+            << ",\n      \"samples\": " << stats.info.samples
+            << ",\n      \"iterations\": " << stats.info.iterations
+            << ",\n      \"mean_ns\": " << stats.mean.point.count()
+            << ",\n      \"mean_lower_ns\": " << stats.mean.lower_bound.count()
+            << ",\n      \"mean_upper_ns\": " << stats.mean.upper_bound.count()
+            << ",\n      \"stddev_ns\": " << stats.standardDeviation.point.count()
+            << ",\n      \"outlier_variance\": " << stats.outlierVariance
+            << "\n    }";
+    }
+
+    void benchmarkFailed(Catch::StringRef error) override
+    {
+        BeginEntry(currentBenchmark_);
+        m_stream << ",\n      \"error\": ";
+        WriteJsonString(m_stream, std::string(error));
+        m_stream << "\n    }";
+    }
+
+    void benchmarkStarting(const Catch::BenchmarkInfo& info) override { currentBenchmark_ = info.name; }
+
+    void testRunEnded(const Catch::TestRunStats& testRunStats) override
+    {
+        m_stream << (firstEntry_ ? "]\n}\n" : "\n  ]\n}\n");
+        m_stream.flush();
+        StreamingReporterBase::testRunEnded(testRunStats);
+    }
+
+private:
+    void BeginEntry(const std::string& name)
+    {
+        m_stream << (firstEntry_ ? "\n" : ",\n") << "    {\n      \"test_case\": ";
+        firstEntry_ = false;
+        WriteJsonString(m_stream, currentTestCaseInfo ? currentTestCaseInfo->name : std::string{});
+        m_stream << ",\n      \"name\": ";
+        WriteJsonString(m_stream, name);
+    }
+
+    bool firstEntry_{true};
+    std::string currentBenchmark_;
+};
+
+}
+
+CATCH_REGISTER_REPORTER("json", JsonReporter)
@@ -0,0 +1,63 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_amalgamated.hpp>
+// Don't write benchmarks here!
+
+#include "SceneBenchmark.h"
+
+// Usage:
+//   Benchmarks                                   Run all benchmarks and print results to console.
+//   Benchmarks "[octree]"                        Run benchmarks with tag.
+//   Benchmarks --reporter json::out=result.json  Write results as JSON for comparison between commits.
+//   Benchmarks --benchmark-samples 50            Reduce number of samples for quick runs.
+//   Benchmarks "[stress]" --scene-results current.json --scene-baseline baseline.json
+//                                                Run stress scenes, save timings and fail on regression.
+int main(int argc, char* argv[])
+{
+    Catch::Session session;
+
+    using namespace Catch::Clara;
+    std::string sceneResults;
+    std::string sceneBaseline;
+    auto& sceneSettings = Benchmarks::GetSceneBenchmarkSettings();
+    session.cli(session.cli()
+        | Opt(sceneResults, "file")["--scene-results"]("write stress scene results to JSON file")
+        | Opt(sceneBaseline, "file")["--scene-baseline"]("compare stress scene results with JSON file")
+        | Opt(sceneSettings.tolerance_, "ratio")["--scene-tolerance"]("allowed relative slowdown, 0.2 by default"));
+
+    int result = session.applyCommandLine(argc, argv);
+    if (result != 0)
+        return result;
+
+    sceneSettings.resultsFile_ = sceneResults.c_str();
+    sceneSettings.baselineFile_ = sceneBaseline.c_str();
+
+    result = session.run();
+    if (result == 0 && !Benchmarks::FinalizeSceneBenchmarks())
+        result = 1;
+
+    Tests::ResetContext();
+    return result;
+}
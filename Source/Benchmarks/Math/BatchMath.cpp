@@ -0,0 +1,96 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../BenchmarkUtils.h"
+
+#include <Urho3D/Math/BatchMath.h>
+#include <Urho3D/Math/RandomEngine.h>
+
+TEST_CASE("Batched math kernels", "[math]")
+{
+    static const unsigned count = 4096;
+
+    RandomEngine random(0);
+    ea::vector<BoundingBox> boxes;
+    ea::vector<Matrix3x4> transforms;
+    ea::vector<Vector3> points;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const Vector3 center = random.GetVector3({-100.0f, -100.0f, -100.0f}, {100.0f, 100.0f, 100.0f});
+        boxes.emplace_back(center - Vector3::ONE, center + Vector3::ONE);
+        transforms.emplace_back(center, random.GetQuaternion(), 1.0f);
+        points.push_back(center);
+    }
+
+    Frustum frustum;
+    frustum.Define(60.0f, 1.0f, 1.0f, 0.1f, 100.0f);
+
+    ea::vector<BoundingBox> resultBoxes(count);
+    ea::vector<Matrix3x4> resultMatrices(count);
+    ea::vector<Vector3> resultPoints(count);
+    ea::vector<unsigned char> resultVisible(count);
+
+    BENCHMARK("BoundingBox::Transformed")
+    {
+        for (unsigned i = 0; i < count; ++i)
+            resultBoxes[i] = boxes[i].Transformed(transforms[i]);
+        return resultBoxes.back().min_.x_;
+    };
+
+    BENCHMARK("TransformBoundingBoxes")
+    {
+        TransformBoundingBoxes(resultBoxes.data(), boxes.data(), transforms.data(), count);
+        return resultBoxes.back().min_.x_;
+    };
+
+    BENCHMARK("TransformAndMergeBoundingBox")
+    {
+        return TransformAndMergeBoundingBox(boxes[0], transforms.data(), count).min_.x_;
+    };
+
+    BENCHMARK("MultiplyMatrices")
+    {
+        MultiplyMatrices(resultMatrices.data(), transforms.data(), transforms.data(), count);
+        return resultMatrices.back().m00_;
+    };
+
+    BENCHMARK("TransformPoints")
+    {
+        TransformPoints(resultPoints.data(), points.data(), count, transforms[0]);
+        return resultPoints.back().x_;
+    };
+
+    BENCHMARK("Frustum::IsInsideFast")
+    {
+        for (unsigned i = 0; i < count; ++i)
+            resultVisible[i] = frustum.IsInsideFast(boxes[i]) != OUTSIDE;
+        return resultVisible.back();
+    };
+
+    BENCHMARK("TestBoundingBoxesInside")
+    {
+        static_assert(sizeof(bool) == sizeof(unsigned char), "Unexpected bool size");
+        TestBoundingBoxesInside(reinterpret_cast<bool*>(resultVisible.data()), frustum, boxes.data(), count);
+        return resultVisible.back();
+    };
+}
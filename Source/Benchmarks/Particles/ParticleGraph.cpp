@@ -0,0 +1,124 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../BenchmarkUtils.h"
+
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/Particles/ParticleGraphEffect.h>
+#include <Urho3D/Particles/ParticleGraphEmitter.h>
+#include <Urho3D/Particles/ParticleGraphLayerInstance.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+/// Effect that moves particles with constant velocity.
+const char* movingParticlesEffect = R"(<particleGraphEffect>
+    <layers>
+        <layer capacity="4096">
+            <emit>
+                <nodes>
+                </nodes>
+            </emit>
+            <init>
+                <nodes>
+                    <node id="1" name="Constant">
+                        <properties>
+                            <property name="Value" type="Vector3" value="0 0 0" />
+                        </properties>
+                        <out>
+                            <pin type="Vector3" name="out" />
+                        </out>
+                    </node>
+                    <node id="2" name="SetAttribute">
+                        <in>
+                            <pin type="Vector3" name="" node="1" pin="out" />
+                        </in>
+                        <out>
+                            <pin type="Vector3" name="pos" />
+                        </out>
+                    </node>
+                </nodes>
+            </init>
+            <update>
+                <nodes>
+                    <node id="1" name="GetAttribute">
+                        <out>
+                            <pin type="Vector3" name="pos" />
+                        </out>
+                    </node>
+                    <node id="2" name="Constant">
+                        <properties>
+                            <property name="Value" type="Vector3" value="0 0.01 0" />
+                        </properties>
+                        <out>
+                            <pin type="Vector3" name="out" />
+                        </out>
+                    </node>
+                    <node id="3" name="Add">
+                        <in>
+                            <pin type="Vector3" name="x" node="1" pin="pos" />
+                            <pin type="Vector3" name="y" node="2" pin="out" />
+                        </in>
+                        <out>
+                            <pin type="Vector3" name="out" />
+                        </out>
+                    </node>
+                    <node id="4" name="SetAttribute">
+                        <in>
+                            <pin type="Vector3" name="" node="3" pin="out" />
+                        </in>
+                        <out>
+                            <pin type="Vector3" name="pos" />
+                        </out>
+                    </node>
+                </nodes>
+            </update>
+        </layer>
+    </layers>
+</particleGraphEffect>)";
+
+}
+
+TEST_CASE("Particle graph execution", "[particles]")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const auto effect = MakeShared<ParticleGraphEffect>(context);
+    MemoryBuffer buffer(movingParticlesEffect);
+    REQUIRE(effect->Load(buffer));
+
+    const auto scene = MakeShared<Scene>(context);
+    auto emitter = scene->CreateChild()->CreateComponent<ParticleGraphEmitter>();
+    emitter->SetEffect(effect);
+    while (emitter->EmitNewParticle(0))
+        ;
+    emitter->Tick(1.0f / 60.0f);
+    REQUIRE(emitter->GetLayer(0)->GetNumActiveParticles() == 4096);
+
+    BENCHMARK("ParticleGraphEmitter::Tick 4096 particles")
+    {
+        emitter->Tick(1.0f / 60.0f);
+        return emitter->GetLayer(0)->GetNumActiveParticles();
+    };
+}
@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../BenchmarkUtils.h"
+
+#include <Urho3D/RenderPipeline/BatchCompositor.h>
+#include <Urho3D/RenderPipeline/PipelineBatchSortKey.h>
+
+#include <EASTL/sort.h>
+
+#include <random>
+
+namespace
+{
+
+/// Number of batches in typical heavy scene pass.
+const unsigned numBatches = 10000;
+
+ea::vector<PipelineBatchByState> CreateBatchesByState()
+{
+    // Realistic scenes have few shaders and materials comparing to number of batches
+    std::mt19937_64 random(42);
+    ea::vector<PipelineBatchByState> batches(numBatches);
+    for (PipelineBatchByState& batch : batches)
+    {
+        batch.primaryKey_ |= 128ull << PipelineBatchByState::RenderOrderOffset;
+        batch.primaryKey_ |= (random() % 32) << PipelineBatchByState::ShaderProgramOffset;
+        batch.primaryKey_ |= (random() % 64) << PipelineBatchByState::PipelineStateOffset;
+        batch.primaryKey_ |= (random() % 256) << PipelineBatchByState::MaterialOffset;
+        batch.primaryKey_ |= (random() % 4) << PipelineBatchByState::PixelLightOffset;
+        batch.secondaryKey_ |= (random() % 512) << PipelineBatchByState::GeometryOffset;
+    }
+    return batches;
+}
+
+ea::vector<PipelineBatchBackToFront> CreateBatchesBackToFront()
+{
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<float> distance(0.0f, 1000.0f);
+    ea::vector<PipelineBatchBackToFront> batches(numBatches);
+    for (PipelineBatchBackToFront& batch : batches)
+    {
+        batch.renderOrder_ = 128;
+        batch.distance_ = distance(random);
+    }
+    return batches;
+}
+
+}
+
+TEST_CASE("Batch sorting", "[batches]")
+{
+    const auto batchesByState = CreateBatchesByState();
+    const auto batchesBackToFront = CreateBatchesBackToFront();
+
+    BENCHMARK_ADVANCED("BatchCompositor::SortBatches by state")(Catch::Benchmark::Chronometer meter)
+    {
+        ea::vector<ea::vector<PipelineBatchByState>> batches(meter.runs(), batchesByState);
+        meter.measure([&](int run)
+        {
+            BatchCompositor::SortBatches(batches[run]);
+            return batches[run].front().primaryKey_;
+        });
+    };
+
+    BENCHMARK_ADVANCED("ea::sort by state (reference)")(Catch::Benchmark::Chronometer meter)
+    {
+        ea::vector<ea::vector<PipelineBatchByState>> batches(meter.runs(), batchesByState);
+        meter.measure([&](int run)
+        {
+            ea::sort(batches[run].begin(), batches[run].end());
+            return batches[run].front().primaryKey_;
+        });
+    };
+
+    BENCHMARK_ADVANCED("BatchCompositor::SortBatches back to front")(Catch::Benchmark::Chronometer meter)
+    {
+        ea::vector<ea::vector<PipelineBatchBackToFront>> batches(meter.runs(), batchesBackToFront);
+        meter.measure([&](int run)
+        {
+            BatchCompositor::SortBatches(batches[run]);
+            return batches[run].front().distance_;
+        });
+    };
+}
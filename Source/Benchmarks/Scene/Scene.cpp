@@ -0,0 +1,92 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../BenchmarkUtils.h"
+
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+/// Save node hierarchy similar to typical prop prefab.
+VectorBuffer CreatePrefabData(Context* context)
+{
+    auto scene = MakeShared<Scene>(context);
+    Node* root = scene->CreateChild("Prefab");
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        Node* child = root->CreateChild(Format("Part {}", i));
+        child->SetPosition({static_cast<float>(i), 0.0f, 0.0f});
+        child->SetVar("Index", static_cast<int>(i));
+        child->CreateComponent<StaticModel>();
+    }
+
+    VectorBuffer buffer;
+    REQUIRE(root->Save(buffer));
+    return buffer;
+}
+
+}
+
+TEST_CASE("Scene instantiation", "[scene]")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const VectorBuffer prefabData = CreatePrefabData(context);
+    auto scene = MakeShared<Scene>(context);
+
+    BENCHMARK_ADVANCED("Scene::Instantiate 17 nodes")(Catch::Benchmark::Chronometer meter)
+    {
+        ea::vector<WeakPtr<Node>> nodes(meter.runs());
+        meter.measure([&](int run)
+        {
+            MemoryBuffer source(prefabData.GetBuffer());
+            nodes[run] = scene->Instantiate(source, Vector3::ZERO, Quaternion::IDENTITY);
+            return nodes[run] != nullptr;
+        });
+
+        for (Node* node : nodes)
+        {
+            if (node)
+                node->Remove();
+        }
+    };
+
+    BENCHMARK_ADVANCED("Node::Remove 17 nodes")(Catch::Benchmark::Chronometer meter)
+    {
+        ea::vector<WeakPtr<Node>> nodes(meter.runs());
+        for (WeakPtr<Node>& node : nodes)
+        {
+            MemoryBuffer source(prefabData.GetBuffer());
+            node = scene->Instantiate(source, Vector3::ZERO, Quaternion::IDENTITY);
+        }
+
+        meter.measure([&](int run)
+        {
+            nodes[run]->Remove();
+            return nodes[run].Expired();
+        });
+    };
+}
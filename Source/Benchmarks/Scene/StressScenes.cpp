@@ -0,0 +1,114 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../SceneBenchmark.h"
+
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Scene/SceneEvents.h>
+#ifdef URHO3D_PHYSICS
+#include <Urho3D/Physics/CollisionShape.h>
+#include <Urho3D/Physics/PhysicsWorld.h>
+#include <Urho3D/Physics/RigidBody.h>
+#endif
+
+// Stress scenes are deterministic: fixed content, fixed time step and fixed camera path.
+// Compare runs only on the same machine, absolute timings are hardware-dependent.
+
+TEST_CASE("Huge object count stress scene", "[stress]")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    // Same setup as 20_HugeObjectCount sample with animation enabled
+    const auto scene = Benchmarks::CreateStaticModelScene(context, {125, 1, 125}, 1.5f);
+    ea::vector<Node*> boxes;
+    scene->GetChildrenWithComponent<StaticModel>(boxes);
+
+    scene->SubscribeToEvent(scene, E_SCENEUPDATE, [&](StringHash, VariantMap& eventData)
+    {
+        const float timeStep = eventData[SceneUpdate::P_TIMESTEP].GetFloat();
+        const Quaternion rotation(10.0f * timeStep, 20.0f * timeStep, 30.0f * timeStep);
+        for (Node* node : boxes)
+            node->Rotate(rotation);
+    });
+
+    Benchmarks::SceneBenchmarkParams params;
+    params.numFrames_ = 240;
+    params.cameraStart_ = {0.0f, 10.0f, -100.0f};
+    params.cameraEnd_ = {0.0f, 10.0f, 100.0f};
+    params.cameraYaw_ = {0.0f, 180.0f};
+
+    auto runner = MakeShared<Benchmarks::SceneBenchmarkRunner>(context);
+    const auto result = runner->Run("HugeObjectCount", scene, params);
+    REQUIRE(result.sections_.contains("frame"));
+    Benchmarks::AddSceneBenchmarkResult(result);
+}
+
+#ifdef URHO3D_PHYSICS
+TEST_CASE("Physics stress scene", "[stress]")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    // Similar to 12_PhysicsStressTest sample: pile of boxes falling on the floor
+    const auto scene = MakeShared<Scene>(context);
+    scene->CreateComponent<Octree>();
+    scene->CreateComponent<PhysicsWorld>();
+
+    Node* floorNode = scene->CreateChild("Floor");
+    floorNode->SetPosition({0.0f, -0.5f, 0.0f});
+    floorNode->SetScale({200.0f, 1.0f, 200.0f});
+    floorNode->CreateComponent<RigidBody>();
+    floorNode->CreateComponent<CollisionShape>()->SetBox(Vector3::ONE);
+
+    const SharedPtr<Model> boxModel = Benchmarks::CreateBoxModel(context);
+    for (int y = 0; y < 10; ++y)
+    {
+        for (int x = 0; x < 10; ++x)
+        {
+            for (int z = 0; z < 10; ++z)
+            {
+                Node* boxNode = scene->CreateChild("Box");
+                boxNode->SetPosition({(x - 4.5f) * 1.2f, y + 2.0f, (z - 4.5f) * 1.2f});
+                boxNode->CreateComponent<StaticModel>()->SetModel(boxModel);
+                auto body = boxNode->CreateComponent<RigidBody>();
+                body->SetMass(1.0f);
+                body->SetFriction(0.75f);
+                boxNode->CreateComponent<CollisionShape>()->SetBox(Vector3::ONE);
+            }
+        }
+    }
+
+    Benchmarks::SceneBenchmarkParams params;
+    params.numFrames_ = 240;
+    params.cameraStart_ = {0.0f, 5.0f, -30.0f};
+    params.cameraEnd_ = {30.0f, 5.0f, 0.0f};
+    params.cameraYaw_ = {0.0f, -90.0f};
+
+    auto runner = MakeShared<Benchmarks::SceneBenchmarkRunner>(context);
+    const auto result = runner->Run("PhysicsStressTest", scene, params);
+    REQUIRE(result.sections_.contains("physics"));
+    Benchmarks::AddSceneBenchmarkResult(result);
+}
+#endif
@@ -0,0 +1,288 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "SceneBenchmark.h"
+
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Engine/Engine.h>
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/Geometry.h>
+#include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/OctreeQuery.h>
+#include <Urho3D/Resource/JSONFile.h>
+#include <Urho3D/Scene/Scene.h>
+#ifdef URHO3D_NETWORK
+#include <Urho3D/Network/NetworkEvents.h>
+#endif
+#ifdef URHO3D_PHYSICS
+#include <Urho3D/Physics/PhysicsEvents.h>
+#endif
+
+#include <iostream>
+
+namespace Benchmarks
+{
+
+namespace
+{
+
+ea::vector<SceneBenchmarkResult>& GetSceneBenchmarkResults()
+{
+    static ea::vector<SceneBenchmarkResult> results;
+    return results;
+}
+
+JSONValue ResultToJSON(const SceneBenchmarkResult& result)
+{
+    JSONValue sections;
+    for (const auto& [name, section] : result.sections_)
+    {
+        JSONValue value;
+        value.Set("mean_ms", section.GetMean());
+        value.Set("max_ms", section.max_);
+        sections.Set(name, value);
+    }
+
+    JSONValue value;
+    value.Set("name", result.name_);
+    value.Set("frames", result.numFrames_);
+    value.Set("peak_memory_bytes", static_cast<double>(result.peakMemory_));
+    value.Set("sections", sections);
+    return value;
+}
+
+void PrintResult(const SceneBenchmarkResult& result)
+{
+    std::cout << Format("Scene '{}', {} frames, peak memory {:.1f} MiB\n",
+        result.name_, result.numFrames_, result.peakMemory_ / (1024.0 * 1024.0)).c_str();
+    for (const auto& [name, section] : result.sections_)
+        std::cout << Format("  {:<10} mean {:8.3f} ms  max {:8.3f} ms\n", name, section.GetMean(), section.max_).c_str();
+}
+
+/// Compare results with baseline. Return false if any section is slower than allowed.
+bool CompareWithBaseline(const JSONValue& baseline, const SceneBenchmarkSettings& settings)
+{
+    bool success = true;
+    for (const JSONValue& baselineScene : baseline["scenes"].GetArray())
+    {
+        const ea::string& name = baselineScene["name"].GetString();
+        const auto& results = GetSceneBenchmarkResults();
+        const auto result = ea::find_if(results.begin(), results.end(),
+            [&](const SceneBenchmarkResult& result) { return result.name_ == name; });
+        if (result == results.end())
+            continue;
+
+        for (const auto& [sectionName, baselineSection] : baselineScene["sections"].GetObject())
+        {
+            const auto section = result->sections_.find(sectionName);
+            if (section == result->sections_.end())
+                continue;
+
+            const float baselineMean = baselineSection["mean_ms"].GetFloat();
+            const float mean = section->second.GetMean();
+            if (mean > baselineMean * (1.0f + settings.tolerance_) && mean - baselineMean > settings.minRegressionMs_)
+            {
+                std::cout << Format("REGRESSION in scene '{}' section '{}': {:.3f} ms, baseline {:.3f} ms\n",
+                    name, sectionName, mean, baselineMean).c_str();
+                success = false;
+            }
+        }
+    }
+    return success;
+}
+
+}
+
+SceneBenchmarkRunner::SceneBenchmarkRunner(Context* context)
+    : Object(context)
+{
+    // Update section includes scene update and all subsystems updated with it
+    SubscribeToEvent(E_BEGINFRAME, [this](StringHash, VariantMap&) { BeginSection("update"); });
+    SubscribeToEvent(E_POSTUPDATE, [this](StringHash, VariantMap&) { EndSection("update"); });
+#ifdef URHO3D_PHYSICS
+    SubscribeToEvent(E_PHYSICSPRESTEP, [this](StringHash, VariantMap&) { BeginSection("physics"); });
+    SubscribeToEvent(E_PHYSICSPOSTSTEP, [this](StringHash, VariantMap&) { EndSection("physics"); });
+#endif
+#ifdef URHO3D_NETWORK
+    SubscribeToEvent(E_NETWORKUPDATE, [this](StringHash, VariantMap&) { BeginSection("network"); });
+    SubscribeToEvent(E_NETWORKUPDATESENT, [this](StringHash, VariantMap&) { EndSection("network"); });
+#endif
+}
+
+SceneBenchmarkResult SceneBenchmarkRunner::Run(const ea::string& name, Scene* scene, const SceneBenchmarkParams& params)
+{
+    auto engine = GetSubsystem<Engine>();
+
+    // Frame limiter would be measured as frame time otherwise
+    const unsigned maxFps = engine->GetMaxFps();
+    engine->SetMaxFps(0);
+
+    SceneBenchmarkResult result;
+    result.name_ = name;
+    result.numFrames_ = params.numFrames_;
+
+    Camera* camera = CreateCamera(scene, params.cameraStart_, 1000.0f);
+    Node* cameraNode = camera->GetNode();
+
+    HiresTimer frameTimer;
+    for (unsigned frame = 0; frame < params.numFrames_; ++frame)
+    {
+        const float t = params.numFrames_ > 1 ? static_cast<float>(frame) / (params.numFrames_ - 1) : 0.0f;
+        cameraNode->SetPosition(params.cameraStart_.Lerp(params.cameraEnd_, t));
+        cameraNode->SetRotation(Quaternion(Lerp(params.cameraYaw_.x_, params.cameraYaw_.y_, t), Vector3::UP));
+
+        openSections_.clear();
+        frameSections_.clear();
+
+        frameTimer.Reset();
+        Tests::RunFrame(context_, params.timeStep_);
+        frameSections_["frame"] = frameTimer.GetUSec(false) / 1000.0f;
+
+        ProcessView(scene, camera, frame + 1);
+
+        for (const auto& [section, ms] : frameSections_)
+            result.sections_[section].AddSample(ms);
+    }
+
+    result.peakMemory_ = GetPeakMemoryUsage();
+
+    cameraNode->Remove();
+    engine->SetMaxFps(maxFps);
+    return result;
+}
+
+void SceneBenchmarkRunner::BeginSection(const char* name)
+{
+    openSections_[name].Reset();
+}
+
+void SceneBenchmarkRunner::EndSection(const char* name)
+{
+    const auto iter = openSections_.find(name);
+    if (iter == openSections_.end())
+        return;
+
+    frameSections_[name] += iter->second.GetUSec(false) / 1000.0f;
+    openSections_.erase(iter);
+}
+
+void SceneBenchmarkRunner::ProcessView(Scene* scene, Camera* camera, unsigned frameNumber)
+{
+    auto octree = scene->GetComponent<Octree>();
+    if (!octree)
+        return;
+
+    const FrameInfo frameInfo = CreateFrameInfo(scene, camera, frameNumber);
+
+    BeginSection("octree");
+    octree->Update(frameInfo);
+    visibleDrawables_.clear();
+    FrustumOctreeQuery query(visibleDrawables_, camera->GetFrustum(), DRAWABLE_GEOMETRY, camera->GetViewMask());
+    octree->GetDrawables(query);
+    EndSection("octree");
+
+    BeginSection("drawables");
+    ForEachParallel(GetSubsystem<WorkQueue>(), 64u, visibleDrawables_,
+        [&](unsigned /*index*/, Drawable* drawable) { drawable->UpdateBatches(frameInfo); });
+    EndSection("drawables");
+
+    BeginSection("batches");
+    sortedBatches_.clear();
+    for (Drawable* drawable : visibleDrawables_)
+    {
+        for (const SourceBatch& sourceBatch : drawable->GetBatches())
+        {
+            PipelineBatchByState& batch = sortedBatches_.emplace_back();
+            if (sourceBatch.material_)
+            {
+                batch.primaryKey_ |= (sourceBatch.material_->GetObjectID() & PipelineBatchByState::MaterialMask)
+                    << PipelineBatchByState::MaterialOffset;
+            }
+            if (sourceBatch.geometry_)
+            {
+                batch.secondaryKey_ |= (sourceBatch.geometry_->GetObjectID() & PipelineBatchByState::GeometryMask)
+                    << PipelineBatchByState::GeometryOffset;
+            }
+        }
+    }
+    BatchCompositor::SortBatches(sortedBatches_);
+    EndSection("batches");
+}
+
+SceneBenchmarkSettings& GetSceneBenchmarkSettings()
+{
+    static SceneBenchmarkSettings settings;
+    return settings;
+}
+
+void AddSceneBenchmarkResult(const SceneBenchmarkResult& result)
+{
+    PrintResult(result);
+    GetSceneBenchmarkResults().push_back(result);
+}
+
+bool FinalizeSceneBenchmarks()
+{
+    const auto& results = GetSceneBenchmarkResults();
+    const SceneBenchmarkSettings& settings = GetSceneBenchmarkSettings();
+    if (results.empty())
+        return true;
+
+    // Context is already created by scene benchmarks
+    const auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    bool success = true;
+    if (!settings.resultsFile_.empty())
+    {
+        JSONValue scenes;
+        for (const SceneBenchmarkResult& result : results)
+            scenes.Push(ResultToJSON(result));
+
+        auto file = MakeShared<JSONFile>(context);
+        file->GetRoot().Set("scenes", scenes);
+        if (!file->SaveFile(settings.resultsFile_))
+        {
+            std::cout << "Cannot save scene benchmark results to " << settings.resultsFile_.c_str() << "\n";
+            success = false;
+        }
+    }
+
+    if (!settings.baselineFile_.empty())
+    {
+        auto baseline = MakeShared<JSONFile>(context);
+        if (!baseline->LoadFile(settings.baselineFile_))
+        {
+            std::cout << "Cannot load scene benchmark baseline from " << settings.baselineFile_.c_str() << "\n";
+            return false;
+        }
+
+        if (!CompareWithBaseline(baseline->GetRoot(), settings))
+            success = false;
+    }
+    return success;
+}
+
+}
@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "BenchmarkUtils.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/RenderPipeline/PipelineBatchSortKey.h>
+
+#include <EASTL/map.h>
+
+namespace Benchmarks
+{
+
+/// Settings of scene benchmarks, filled from command line.
+struct SceneBenchmarkSettings
+{
+    /// File to write results to. Results are not written if empty.
+    ea::string resultsFile_;
+    /// File with baseline results. Results are not compared if empty.
+    ea::string baselineFile_;
+    /// Allowed relative slowdown comparing to baseline.
+    float tolerance_{0.2f};
+    /// Minimal absolute slowdown in milliseconds treated as regression. Filters noise of cheap sections.
+    float minRegressionMs_{0.05f};
+};
+
+/// Time spent in section over all frames, in milliseconds.
+struct SceneBenchmarkSection
+{
+    /// Add frame sample.
+    void AddSample(float ms)
+    {
+        total_ += ms;
+        max_ = ea::max(max_, ms);
+        ++numSamples_;
+    }
+
+    /// Return mean time per frame.
+    float GetMean() const { return numSamples_ ? total_ / numSamples_ : 0.0f; }
+
+    /// Total time.
+    float total_{};
+    /// Max time per frame.
+    float max_{};
+    /// Number of frames with samples.
+    unsigned numSamples_{};
+};
+
+/// Results of single scene run.
+struct SceneBenchmarkResult
+{
+    /// Scene name.
+    ea::string name_;
+    /// Number of simulated frames.
+    unsigned numFrames_{};
+    /// Timings per section.
+    ea::map<ea::string, SceneBenchmarkSection> sections_;
+    /// Process memory high-water mark after the run, in bytes.
+    unsigned long long peakMemory_{};
+};
+
+/// Parameters of scene run.
+struct SceneBenchmarkParams
+{
+    /// Number of frames to simulate.
+    unsigned numFrames_{120};
+    /// Fixed time step.
+    float timeStep_{1.0f / 60.0f};
+    /// Camera position at the first frame.
+    Vector3 cameraStart_;
+    /// Camera position at the last frame.
+    Vector3 cameraEnd_;
+    /// Camera yaw at the first and the last frame, in degrees.
+    Vector2 cameraYaw_;
+};
+
+/// Runs scene for fixed number of frames with fixed time step and camera path.
+/// Engine frame is measured as a whole and per subsystem via events.
+/// Renderer is not available in headless mode, so octree update, visibility, drawable
+/// and batch preparation are performed by the runner after each frame and measured as well.
+class SceneBenchmarkRunner : public Object
+{
+    URHO3D_OBJECT(SceneBenchmarkRunner, Object);
+
+public:
+    /// Construct.
+    explicit SceneBenchmarkRunner(Context* context);
+
+    /// Run scene and return results.
+    SceneBenchmarkResult Run(const ea::string& name, Scene* scene, const SceneBenchmarkParams& params);
+
+private:
+    /// Begin measuring section.
+    void BeginSection(const char* name);
+    /// End measuring section and accumulate time in current frame.
+    void EndSection(const char* name);
+    /// Prepare visible drawables and batches like render pipeline does.
+    void ProcessView(Scene* scene, Camera* camera, unsigned frameNumber);
+
+    /// Timer per open section.
+    ea::map<ea::string, HiresTimer> openSections_;
+    /// Time per section in current frame.
+    ea::map<ea::string, float> frameSections_;
+    /// Visible drawables.
+    ea::vector<Drawable*> visibleDrawables_;
+    /// Batches of visible drawables.
+    ea::vector<PipelineBatchByState> sortedBatches_;
+};
+
+/// Return global settings of scene benchmarks.
+SceneBenchmarkSettings& GetSceneBenchmarkSettings();
+
+/// Add result to be reported at exit.
+void AddSceneBenchmarkResult(const SceneBenchmarkResult& result);
+
+/// Print and save results, compare with baseline. Return false if regression is detected or baseline is invalid.
+bool FinalizeSceneBenchmarks();
+
+}
@@ -91,6 +91,14 @@ void ModelImporter::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Repair Looping", bool, settings_.repairLooping_, false, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Skip Tag", ea::string, settings_.skipTag_, DefaultSkipTag, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Keep Names On Merge", bool, settings_.keepNamesOnMerge_, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Compress Animations", bool, settings_.compressAnimations_, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Animation Position Error", float, settings_.animationCompression_.positionError_, 0.001f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Animation Rotation Error", float, settings_.animationCompression_.rotationError_, 0.1f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Animation Scale Error", float, settings_.animationCompression_.scaleError_, 0.001f, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Optimize Geometry", bool, settings_.optimizeGeometry_, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Compact Vertex Format", bool, settings_.compactVertexFormat_, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Build Meshlets", bool, settings_.buildMeshlets_, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Meshlet Triangles", unsigned, settings_.meshletTriangles_, DEFAULT_MESHLET_TRIANGLES, AM_DEFAULT);
 }
 
 ToolManager* ModelImporter::GetToolManager() const
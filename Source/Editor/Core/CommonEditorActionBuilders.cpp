@@ -84,7 +84,7 @@ CreateNodeActionBuilder::CreateNodeActionBuilder(Scene* scene, AttributeScopeHin
     }
     case AttributeScopeHint::Scene:
     {
-        oldSceneData_.FromScene(scene);
+        oldSceneData_ = PackedSceneData::FromScene(scene);
         break;
     }
     };
@@ -123,7 +123,7 @@ RemoveNodeActionBuilder::RemoveNodeActionBuilder(Node* node)
     }
     case AttributeScopeHint::Scene:
     {
-        oldSceneData_.FromScene(scene_);
+        oldSceneData_ = PackedSceneData::FromScene(scene_);
         break;
     }
     };
@@ -166,7 +166,7 @@ CreateComponentActionBuilder::CreateComponentActionBuilder(Node* node, StringHas
     }
     case AttributeScopeHint::Scene:
     {
-        oldSceneData_.FromScene(scene_);
+        oldSceneData_ = PackedSceneData::FromScene(scene_);
         break;
     }
     };
@@ -216,7 +216,7 @@ RemoveComponentActionBuilder::RemoveComponentActionBuilder(Component* component)
     }
     case AttributeScopeHint::Scene:
     {
-        oldSceneData_.FromScene(scene_);
+        oldSceneData_ = PackedSceneData::FromScene(scene_);
         break;
     }
     };
@@ -270,7 +270,7 @@ ChangeNodeAttributesActionBuilder::ChangeNodeAttributesActionBuilder(
     }
     case AttributeScopeHint::Scene:
     {
-        buffer_.oldScene_.FromScene(scene_);
+        buffer_.oldScene_ = PackedSceneData::FromScene(scene_);
         break;
     }
     default: break;
@@ -297,17 +297,21 @@ SharedPtr<EditorAction> ChangeNodeAttributesActionBuilder::Build() const
         for (Node* node : nodes_)
             buffer_.newNodes_.emplace_back(node);
 
+        // Don't store nodes that are not changed
         auto compositeAction = MakeShared<CompositeEditorAction>();
         for (unsigned index = 0; index < nodes_.size(); ++index)
         {
-            compositeAction->EmplaceAction<ChangeNodeSubtreeAction>(
-                scene_, buffer_.oldNodes_[index], buffer_.newNodes_[index]);
+            if (buffer_.oldNodes_[index] != buffer_.newNodes_[index])
+            {
+                compositeAction->EmplaceAction<ChangeNodeSubtreeAction>(
+                    scene_, buffer_.oldNodes_[index], buffer_.newNodes_[index]);
+            }
         }
         return compositeAction;
     }
     case AttributeScopeHint::Scene:
     {
-        buffer_.newScene_.FromScene(scene_);
+        buffer_.newScene_ = PackedSceneData::FromScene(scene_);
         return MakeShared<ChangeSceneAction>(scene_, buffer_.oldScene_, buffer_.newScene_);
     }
     default: return nullptr;
@@ -344,7 +348,7 @@ ChangeComponentAttributesActionBuilder::ChangeComponentAttributesActionBuilder(
 
     case AttributeScopeHint::Scene:
     {
-        buffer_.oldScene_.FromScene(scene_);
+        buffer_.oldScene_ = PackedSceneData::FromScene(scene_);
         break;
     }
 
@@ -373,18 +377,22 @@ SharedPtr<EditorAction> ChangeComponentAttributesActionBuilder::Build() const
         for (Node* node : nodes_)
             buffer_.newNodes_.emplace_back(node);
 
+        // Don't store nodes that are not changed
         auto compositeAction = MakeShared<CompositeEditorAction>();
         for (unsigned index = 0; index < nodes_.size(); ++index)
         {
-            compositeAction->EmplaceAction<ChangeNodeSubtreeAction>(
-                scene_, buffer_.oldNodes_[index], buffer_.newNodes_[index]);
+            if (buffer_.oldNodes_[index] != buffer_.newNodes_[index])
+            {
+                compositeAction->EmplaceAction<ChangeNodeSubtreeAction>(
+                    scene_, buffer_.oldNodes_[index], buffer_.newNodes_[index]);
+            }
         }
         return compositeAction;
     }
 
     case AttributeScopeHint::Scene:
     {
-        buffer_.newScene_.FromScene(scene_);
+        buffer_.newScene_ = PackedSceneData::FromScene(scene_);
 
         return MakeShared<ChangeSceneAction>(scene_, buffer_.oldScene_, buffer_.newScene_);
     }
@@ -51,6 +51,14 @@ void CompositeEditorAction::Undo() const
         action->Undo();
 }
 
+unsigned CompositeEditorAction::GetMemoryUsage() const
+{
+    unsigned memoryUsage = 0;
+    for (const auto& action : actions_)
+        memoryUsage += action->GetMemoryUsage();
+    return memoryUsage;
+}
+
 CreateRemoveNodeAction::CreateRemoveNodeAction(Node* node, bool removed)
     : removed_(removed)
     , scene_(node->GetScene())
@@ -79,6 +87,11 @@ void CreateRemoveNodeAction::Undo() const
         RemoveNode();
 }
 
+unsigned CreateRemoveNodeAction::GetMemoryUsage() const
+{
+    return data_.GetMemoryUsage();
+}
+
 void CreateRemoveNodeAction::AddNode() const
 {
     if (!scene_)
@@ -128,6 +141,11 @@ void CreateRemoveComponentAction::Undo() const
         RemoveComponent();
 }
 
+unsigned CreateRemoveComponentAction::GetMemoryUsage() const
+{
+    return data_.GetMemoryUsage();
+}
+
 void CreateRemoveComponentAction::AddComponent() const
 {
     if (!scene_)
@@ -207,6 +225,11 @@ bool ChangeNodeTransformAction::MergeWith(const EditorAction& other)
     return true;
 }
 
+unsigned ChangeNodeTransformAction::GetMemoryUsage() const
+{
+    return nodes_.size() * (sizeof(unsigned) + sizeof(NodeData));
+}
+
 bool ChangeNodeAttributesAction::CanUndoRedo() const
 {
     if (!scene_)
@@ -255,6 +278,11 @@ bool ChangeNodeAttributesAction::MergeWith(const EditorAction& other)
     return true;
 }
 
+unsigned ChangeNodeAttributesAction::GetMemoryUsage() const
+{
+    return nodeIds_.size() * (sizeof(unsigned) + 2 * sizeof(Variant));
+}
+
 bool ChangeComponentAttributesAction::CanUndoRedo() const
 {
     if (!scene_)
@@ -303,6 +331,11 @@ bool ChangeComponentAttributesAction::MergeWith(const EditorAction& other)
     return true;
 }
 
+unsigned ChangeComponentAttributesAction::GetMemoryUsage() const
+{
+    return componentIds_.size() * (sizeof(unsigned) + 2 * sizeof(Variant));
+}
+
 ReorderNodeAction::ReorderNodeAction(Node* node, unsigned oldIndex, unsigned newIndex)
     : scene_(node->GetScene())
     , parentNodeId_(node->GetParent()->GetID())
@@ -508,11 +541,16 @@ bool ChangeNodeSubtreeAction::MergeWith(const EditorAction& other)
     return true;
 }
 
+unsigned ChangeNodeSubtreeAction::GetMemoryUsage() const
+{
+    return oldData_.GetMemoryUsage() + newData_.GetMemoryUsage();
+}
+
 ChangeSceneAction::ChangeSceneAction(Scene* scene, const PackedSceneData& oldData)
     : scene_(scene)
     , oldData_(oldData)
+    , newData_(PackedSceneData::FromScene(scene))
 {
-    newData_.FromScene(scene);
 }
 
 ChangeSceneAction::ChangeSceneAction(Scene* scene, const PackedSceneData& oldData, const PackedSceneData& newData)
@@ -555,4 +593,9 @@ bool ChangeSceneAction::MergeWith(const EditorAction& other)
     return true;
 }
 
+unsigned ChangeSceneAction::GetMemoryUsage() const
+{
+    return oldData_.GetMemoryUsage() + newData_.GetMemoryUsage();
+}
+
 }
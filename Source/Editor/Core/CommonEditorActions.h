@@ -64,6 +64,7 @@ public:
     bool CanUndo() const override;
     void Redo() const override;
     void Undo() const override;
+    unsigned GetMemoryUsage() const override;
     /// @}
 
 private:
@@ -81,6 +82,7 @@ public:
     bool CanUndoRedo() const override;
     void Redo() const override;
     void Undo() const override;
+    unsigned GetMemoryUsage() const override;
     /// @}
 
 private:
@@ -103,6 +105,7 @@ public:
     bool CanUndoRedo() const override;
     void Redo() const override;
     void Undo() const override;
+    unsigned GetMemoryUsage() const override;
     /// @}
 
 private:
@@ -126,6 +129,7 @@ public:
     void Redo() const override;
     void Undo() const override;
     bool MergeWith(const EditorAction& other) override;
+    unsigned GetMemoryUsage() const override;
     /// @}
 
 private:
@@ -164,6 +168,7 @@ public:
     void Redo() const override;
     void Undo() const override;
     bool MergeWith(const EditorAction& other) override;
+    unsigned GetMemoryUsage() const override;
     /// @}
 
 private:
@@ -202,6 +207,7 @@ public:
     void Redo() const override;
     void Undo() const override;
     bool MergeWith(const EditorAction& other) override;
+    unsigned GetMemoryUsage() const override;
     /// @}
 
 private:
@@ -299,6 +305,7 @@ public:
     void Redo() const override;
     void Undo() const override;
     bool MergeWith(const EditorAction& other) override;
+    unsigned GetMemoryUsage() const override;
     /// @}
 
 private:
@@ -323,6 +330,7 @@ public:
     void Redo() const override;
     void Undo() const override;
     bool MergeWith(const EditorAction& other) override;
+    unsigned GetMemoryUsage() const override;
     /// @}
 
 private:
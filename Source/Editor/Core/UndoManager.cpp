@@ -90,6 +90,11 @@ bool BaseEditorActionWrapper::MergeWith(const EditorAction& other)
     return action_->MergeWith(*otherWrapper.action_);
 }
 
+unsigned BaseEditorActionWrapper::GetMemoryUsage() const
+{
+    return action_->GetMemoryUsage();
+}
+
 bool UndoManager::ActionGroup::CanRedo() const
 {
     const auto canRedo = [](const EditorActionPtr& action) { return action->CanRedo(); };
@@ -102,6 +107,18 @@ bool UndoManager::ActionGroup::CanUndo() const
     return ea::all_of(actions_.begin(), actions_.end(), canUndo);
 }
 
+unsigned UndoManager::ActionGroup::GetMemoryUsage() const
+{
+    if (!memoryUsage_)
+    {
+        unsigned memoryUsage = 0;
+        for (const EditorActionPtr& action : actions_)
+            memoryUsage += action->GetMemoryUsage();
+        memoryUsage_ = memoryUsage;
+    }
+    return *memoryUsage_;
+}
+
 UndoManager::UndoManager(Context* context)
     : Object(context)
 {
@@ -129,6 +146,7 @@ EditorActionFrame UndoManager::PushAction(const EditorActionPtr& action)
 
     // Try merge first
     ActionGroup& group = undoStack_.back();
+    group.memoryUsage_ = ea::nullopt;
     if (!group.actions_.empty())
     {
         if (group.actions_.back()->MergeWith(*action))
@@ -144,6 +162,7 @@ EditorActionFrame UndoManager::PushAction(const EditorActionPtr& action)
         incompleteActionTimer_.Reset();
     }
 
+    EnforceMemoryBudget();
     return frame_;
 }
 
@@ -165,6 +184,7 @@ bool UndoManager::Undo()
             action->Undo();
 
         ea::erase_if(group.actions_, [](const EditorActionPtr& action) { return action->RemoveOnUndo(); });
+        group.memoryUsage_ = ea::nullopt;
 
         if (!group.actions_.empty())
             redoStack_.push_back(ea::move(group));
@@ -224,6 +244,22 @@ bool UndoManager::CanRedo() const
     return *canRedo_;
 }
 
+void UndoManager::SetMaxMemoryUsage(unsigned maxMemoryUsage)
+{
+    maxMemoryUsage_ = maxMemoryUsage;
+    EnforceMemoryBudget();
+}
+
+unsigned UndoManager::GetMemoryUsage() const
+{
+    unsigned memoryUsage = 0;
+    for (const ActionGroup& group : undoStack_)
+        memoryUsage += group.GetMemoryUsage();
+    for (const ActionGroup& group : redoStack_)
+        memoryUsage += group.GetMemoryUsage();
+    return memoryUsage;
+}
+
 void UndoManager::ClearCanUndoRedo()
 {
     canRedo_ = ea::nullopt;
@@ -252,10 +288,46 @@ void UndoManager::CommitIncompleteAction(bool force)
         return;
 
     incompleteAction_->Complete(force);
+
+    // Completed action may have grown, find its group and invalidate memory usage
+    for (ActionGroup& group : ea::reverse(undoStack_))
+    {
+        if (group.actions_.contains(incompleteAction_))
+        {
+            group.memoryUsage_ = ea::nullopt;
+            break;
+        }
+    }
+
     if (incompleteAction_->IsComplete())
         incompleteAction_ = nullptr;
     else if (force)
         URHO3D_LOGERROR("Incomplete action failed to complete when it was forced");
 }
 
+void UndoManager::EnforceMemoryBudget()
+{
+    if (maxMemoryUsage_ == 0)
+        return;
+
+    // Never discard the most recent group so the last action can always be undone
+    unsigned memoryUsage = GetMemoryUsage();
+    unsigned numDiscarded = 0;
+    while (memoryUsage > maxMemoryUsage_ && numDiscarded + 1 < undoStack_.size())
+    {
+        const ActionGroup& group = undoStack_[numDiscarded];
+        if (incompleteAction_ && group.actions_.contains(incompleteAction_))
+            break;
+
+        memoryUsage -= group.GetMemoryUsage();
+        ++numDiscarded;
+    }
+
+    if (numDiscarded > 0)
+    {
+        undoStack_.erase(undoStack_.begin(), undoStack_.begin() + numDiscarded);
+        ClearCanUndoRedo();
+    }
+}
+
 }
@@ -70,6 +70,8 @@ public:
     virtual void Undo() const = 0;
     /// Try to merge this action with another. Return true if successfully merged.
     virtual bool MergeWith(const EditorAction& other) { return false; }
+    /// Return approximate memory used by the action, in bytes. Small actions may return zero.
+    virtual unsigned GetMemoryUsage() const { return 0; }
 };
 
 /// Base class for action wrappers.
@@ -90,6 +92,7 @@ public:
     bool CanUndo() const override;
     void Undo() const override;
     bool MergeWith(const EditorAction& other) override;
+    unsigned GetMemoryUsage() const override;
     /// @}
 
 protected:
@@ -120,22 +123,34 @@ public:
     /// Return whether can redo.
     bool CanRedo() const;
 
+    /// Set memory budget of undo history in bytes. Oldest actions are discarded when exceeded. Zero means unlimited.
+    void SetMaxMemoryUsage(unsigned maxMemoryUsage);
+    /// Return memory budget of undo history in bytes.
+    unsigned GetMaxMemoryUsage() const { return maxMemoryUsage_; }
+    /// Return approximate memory used by undo and redo history, in bytes.
+    unsigned GetMemoryUsage() const;
+
 private:
     struct ActionGroup
     {
         EditorActionFrame frame_{};
         ea::vector<EditorActionPtr> actions_;
+        /// Cached memory usage. Reset when actions are modified.
+        mutable ea::optional<unsigned> memoryUsage_;
 
         bool CanRedo() const;
         bool CanUndo() const;
+        unsigned GetMemoryUsage() const;
     };
 
     void ClearCanUndoRedo();
     void Update();
     bool NeedNewGroup() const;
     void CommitIncompleteAction(bool force);
+    void EnforceMemoryBudget();
 
     const unsigned actionCompletionTimeoutMs_{1000};
+    unsigned maxMemoryUsage_{256 * 1024 * 1024};
 
     ea::vector<ActionGroup> undoStack_;
     ea::vector<ActionGroup> redoStack_;
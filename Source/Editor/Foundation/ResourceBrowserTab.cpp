@@ -22,8 +22,11 @@
 
 #include "../Core/IniHelpers.h"
 #include "../Foundation/ResourceBrowserTab.h"
+#include "../Foundation/ResourceBrowserTab/ResourceThumbnailCache.h"
 
+#include <Urho3D/Graphics/Texture2D.h>
 #include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/SystemUI/Widgets.h>
 
 #include <EASTL/sort.h>
 #include <EASTL/tuple.h>
@@ -92,11 +95,13 @@ ResourceBrowserTab::ResourceBrowserTab(Context* context)
     : EditorTab(context, "Resources", "96c69b8e-ee83-43de-885c-8a51cef65d59",
         EditorTabFlag::OpenByDefault, EditorTabPlacement::DockBottom)
 {
+    auto project = GetProject();
+    thumbnailCache_ = MakeShared<ResourceThumbnailCache>(context_, project->GetTempPath() + "Thumbnails/");
+
     InitializeRoots();
     InitializeDefaultFactories();
     InitializeHotkeys();
 
-    auto project = GetProject();
     project->OnInitialized.Subscribe(this, &ResourceBrowserTab::RefreshContents);
     project->OnRequest.SubscribeWithSender(this, &ResourceBrowserTab::OnProjectRequest);
 }
@@ -127,6 +132,7 @@ void ResourceBrowserTab::InitializeRoots()
     {
         root.reflection_ = MakeShared<FileSystemReflection>(context_, root.watchedDirectories_);
         root.reflection_->OnListUpdated.Subscribe(this, &ResourceBrowserTab::RefreshContents);
+        root.reflection_->OnResourceUpdated.Subscribe(this, &ResourceBrowserTab::OnResourceUpdated);
     }
 }
 
@@ -174,6 +180,11 @@ void ResourceBrowserTab::OnProjectRequest(RefCounted* sender, ProjectRequest* re
     }
 }
 
+void ResourceBrowserTab::OnResourceUpdated(const FileSystemEntry& entry)
+{
+    thumbnailCache_->Invalidate(entry.resourceName_);
+}
+
 const FileSystemEntry* ResourceBrowserTab::FindLeftPanelEntry(const ea::string& resourceName) const
 {
     const ResourceRoot& root = roots_[left_.selectedRoot_];
@@ -277,6 +288,7 @@ void ResourceBrowserTab::RenderContent()
 
     for (ResourceRoot& root : roots_)
         root.reflection_->Update();
+    thumbnailCache_->Update();
 
     if (waitingForUpdate_ && ui::IsWindowHovered(ImGuiHoveredFlags_RootAndChildWindows))
         ui::SetTooltip("Waiting for update...");
@@ -589,6 +601,9 @@ void ResourceBrowserTab::RenderDirectoryContentEntry(const FileSystemEntry& entr
     const bool isContextMenuOpen = ui::IsItemClicked(MOUSEB_RIGHT);
     const bool toggleSelection = ui::IsKeyDown(KEY_LCTRL) || ui::IsKeyDown(KEY_RCTRL);
 
+    if (isNormalFile)
+        RenderEntryThumbnail(entry);
+
     if (ui::IsItemClicked(MOUSEB_LEFT) && ui::IsItemToggledOpen())
         ignoreNextMouseRelease_ = true;
 
@@ -658,6 +673,21 @@ void ResourceBrowserTab::RenderDirectoryContentEntry(const FileSystemEntry& entr
     RenderEntryContextMenu(entry);
 }
 
+void ResourceBrowserTab::RenderEntryThumbnail(const FileSystemEntry& entry)
+{
+    // Request thumbnails only for visible entries, so large folders are processed lazily
+    if (!ui::IsItemVisible())
+        return;
+
+    Texture2D* thumbnail = thumbnailCache_->GetThumbnail(entry.resourceName_, entry.absolutePath_);
+    if (thumbnail && ui::IsItemHovered() && !ui::IsMouseDragging(MOUSEB_LEFT))
+    {
+        ui::BeginTooltip();
+        Widgets::Image(thumbnail, ToImGui(thumbnail->GetSize()));
+        ui::EndTooltip();
+    }
+}
+
 void ResourceBrowserTab::RenderCompositeFile(const FileSystemEntry& entry)
 {
     tempEntryList_.clear();
@@ -37,6 +37,8 @@
 namespace Urho3D
 {
 
+class ResourceThumbnailCache;
+
 void Foundation_ResourceBrowserTab(Context* context, Project* project);
 
 class ResourceBrowserTab : public EditorTab
@@ -108,6 +110,7 @@ private:
     void InitializeHotkeys();
 
     void OnProjectRequest(RefCounted* sender, ProjectRequest* request);
+    void OnResourceUpdated(const FileSystemEntry& entry);
     const FileSystemEntry* FindLeftPanelEntry(const ea::string& resourceName) const;
 
     /// Render left panel
@@ -123,6 +126,7 @@ private:
     void RenderCompositeFile(const FileSystemEntry& entry);
     void RenderCompositeFileEntry(const FileSystemEntry& entry, const FileSystemEntry& ownerEntry);
     void RenderCreateButton(const FileSystemEntry& entry);
+    void RenderEntryThumbnail(const FileSystemEntry& entry);
     /// @}
 
     /// Common rendering
@@ -198,6 +202,8 @@ private:
     unsigned defaultRoot_{};
     bool waitingForUpdate_{};
 
+    SharedPtr<ResourceThumbnailCache> thumbnailCache_;
+
     ea::vector<SharedPtr<ResourceFactory>> factories_;
     bool sortFactories_{true};
 
@@ -0,0 +1,392 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../../Foundation/ResourceBrowserTab/ResourceThumbnailCache.h"
+
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/Light.h>
+#include <Urho3D/Graphics/Material.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Graphics/Texture2D.h>
+#include <Urho3D/Graphics/Zone.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/Resource/Image.h>
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Scene/Scene.h>
+#include <Urho3D/Utility/SceneRendererToTexture.h>
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Max number of thumbnails uploaded to GPU per frame.
+const unsigned maxUploadsPerFrame = 16;
+/// Max number of thumbnails kept in memory before unused ones are evicted.
+const unsigned maxThumbnails = 2048;
+/// Number of frames the thumbnail should stay unused to be evicted.
+const unsigned evictionDelayFrames = 120;
+
+SharedPtr<Texture2D> CreateThumbnailTexture(Context* context, Image* image)
+{
+    auto texture = MakeShared<Texture2D>(context);
+    texture->SetNumLevels(1);
+    if (!texture->SetData(image, true))
+        return nullptr;
+    return texture;
+}
+
+void FitImage(Image* image, unsigned thumbnailSize)
+{
+    const int width = image->GetWidth();
+    const int height = image->GetHeight();
+    const int maxSize = static_cast<int>(thumbnailSize);
+    if (width <= maxSize && height <= maxSize)
+        return;
+
+    const float scale = static_cast<float>(maxSize) / Max(width, height);
+    image->Resize(Max(1, RoundToInt(width * scale)), Max(1, RoundToInt(height * scale)));
+}
+
+}
+
+ResourceThumbnailCache::ResourceThumbnailCache(Context* context, const ea::string& cacheDirectory, unsigned thumbnailSize)
+    : Object(context)
+    , cacheDirectory_(AddTrailingSlash(cacheDirectory))
+    , thumbnailSize_(Max(thumbnailSize, 1u))
+    , sharedState_(ea::make_shared<SharedState>())
+{
+    auto fs = GetSubsystem<FileSystem>();
+    if (!fs->DirExists(cacheDirectory_))
+        fs->CreateDirsRecursive(cacheDirectory_);
+}
+
+ResourceThumbnailCache::~ResourceThumbnailCache()
+{
+    if (renderer_)
+        renderer_->SetActive(false);
+}
+
+Texture2D* ResourceThumbnailCache::GetThumbnail(const ea::string& resourceName, const ea::string& fileName)
+{
+    const unsigned frameNumber = GetSubsystem<Time>()->GetFrameNumber();
+
+    const auto iter = thumbnails_.find(resourceName);
+    if (iter != thumbnails_.end())
+    {
+        iter->second.lastUsedFrame_ = frameNumber;
+        return iter->second.texture_;
+    }
+
+    // Unsupported resources are remembered too, so the lookup is cheap next time
+    Thumbnail& thumbnail = thumbnails_[resourceName];
+    thumbnail.type_ = GetThumbnailType(resourceName);
+    thumbnail.lastUsedFrame_ = frameNumber;
+    thumbnail.version_ = ++nextVersion_;
+    if (thumbnail.type_ == ThumbnailType::Unsupported)
+    {
+        thumbnail.state_ = ThumbnailState::Failed;
+        return nullptr;
+    }
+
+    thumbnail.state_ = ThumbnailState::Loading;
+
+    // Hashing, disk cache lookup and texture downscaling are done in background
+    PostTask([context = context_, sharedState = sharedState_, resourceName,
+        version = thumbnail.version_, type = thumbnail.type_, fileName,
+        cacheDirectory = cacheDirectory_, thumbnailSize = thumbnailSize_]()
+    {
+        TaskResult result = ProcessThumbnail(context, type, fileName, cacheDirectory, thumbnailSize);
+        result.resourceName_ = resourceName;
+        result.version_ = version;
+
+        MutexLock lock(sharedState->mutex_);
+        sharedState->results_.push_back(ea::move(result));
+    });
+    return nullptr;
+}
+
+void ResourceThumbnailCache::Invalidate(const ea::string& resourceName)
+{
+    thumbnails_.erase(resourceName);
+}
+
+void ResourceThumbnailCache::Update()
+{
+    if (!renderingResource_.empty())
+        EndRender();
+
+    ConsumeResults();
+
+    // Render at most one thumbnail per frame to keep the editor responsive
+    if (renderingResource_.empty())
+    {
+        for (auto& [resourceName, thumbnail] : thumbnails_)
+        {
+            if (thumbnail.state_ == ThumbnailState::WaitingForRender)
+            {
+                BeginRender(resourceName, thumbnail);
+                break;
+            }
+        }
+    }
+
+    EvictUnused();
+}
+
+ResourceThumbnailCache::ThumbnailType ResourceThumbnailCache::GetThumbnailType(const ea::string& resourceName)
+{
+    static const StringVector textureExtensions{".dds", ".bmp", ".jpg", ".jpeg", ".tga", ".png"};
+
+    const ea::string extension = GetExtension(resourceName);
+    if (textureExtensions.contains(extension))
+        return ThumbnailType::Texture;
+    else if (extension == ".mdl")
+        return ThumbnailType::Model;
+    else if (extension == ".material")
+        return ThumbnailType::Material;
+    else
+        return ThumbnailType::Unsupported;
+}
+
+ResourceThumbnailCache::TaskResult ResourceThumbnailCache::ProcessThumbnail(Context* context, ThumbnailType type,
+    const ea::string& fileName, const ea::string& cacheDirectory, unsigned thumbnailSize)
+{
+    TaskResult result;
+
+    File file(context);
+    if (!file.Open(fileName, FILE_READ))
+        return result;
+
+    ByteVector bytes(file.GetSize());
+    if (!bytes.empty() && file.Read(bytes.data(), bytes.size()) != bytes.size())
+        return result;
+    file.Close();
+
+    const unsigned hash = StringHash::Calculate(bytes.data(), bytes.size());
+    result.cacheFileName_ = Format("{}{:08X}_{:X}_{}_{}.png", cacheDirectory, hash,
+        static_cast<unsigned>(bytes.size()), static_cast<unsigned>(type), thumbnailSize);
+
+    // Reuse thumbnail generated earlier
+    auto image = MakeShared<Image>(context);
+    if (context->GetSubsystem<FileSystem>()->FileExists(result.cacheFileName_))
+    {
+        File cachedFile(context, result.cacheFileName_);
+        if (image->Load(cachedFile))
+        {
+            result.image_ = image;
+            return result;
+        }
+    }
+
+    if (type != ThumbnailType::Texture)
+    {
+        result.needsRender_ = true;
+        return result;
+    }
+
+    MemoryBuffer buffer(bytes);
+    buffer.SetName(fileName);
+    if (!image->Load(buffer))
+        return result;
+
+    if (image->IsCompressed())
+        image = image->GetDecompressedImage();
+    if (image && image->GetComponents() != 4)
+        image = image->ConvertToRGBA();
+    if (!image)
+        return result;
+
+    FitImage(image, thumbnailSize);
+    image->SavePNG(result.cacheFileName_);
+    result.image_ = image;
+    return result;
+}
+
+void ResourceThumbnailCache::PostTask(ea::function<void()> task)
+{
+    auto workQueue = GetSubsystem<WorkQueue>();
+    if (workQueue->GetNumThreads() == 0)
+    {
+        // Nobody is going to execute background tasks, do the work immediately
+        task();
+        return;
+    }
+
+    workQueue->PostTask([task = ea::move(task)](unsigned /*threadIndex*/) { task(); });
+}
+
+void ResourceThumbnailCache::ConsumeResults()
+{
+    ea::vector<TaskResult> results;
+    {
+        MutexLock lock(sharedState_->mutex_);
+        const unsigned numResults = ea::min(maxUploadsPerFrame, sharedState_->results_.size());
+        const auto begin = sharedState_->results_.begin();
+        results.assign(ea::make_move_iterator(begin), ea::make_move_iterator(begin + numResults));
+        sharedState_->results_.erase(begin, begin + numResults);
+    }
+
+    for (TaskResult& result : results)
+    {
+        // Skip results of invalidated thumbnails
+        const auto iter = thumbnails_.find(result.resourceName_);
+        if (iter == thumbnails_.end() || iter->second.version_ != result.version_)
+            continue;
+
+        Thumbnail& thumbnail = iter->second;
+        thumbnail.cacheFileName_ = result.cacheFileName_;
+        if (result.image_)
+        {
+            thumbnail.texture_ = CreateThumbnailTexture(context_, result.image_);
+            thumbnail.state_ = thumbnail.texture_ ? ThumbnailState::Ready : ThumbnailState::Failed;
+        }
+        else
+        {
+            thumbnail.state_ = result.needsRender_ ? ThumbnailState::WaitingForRender : ThumbnailState::Failed;
+        }
+    }
+}
+
+void ResourceThumbnailCache::BeginRender(const ea::string& resourceName, Thumbnail& thumbnail)
+{
+    InitializeScene();
+
+    auto cache = GetSubsystem<ResourceCache>();
+    BoundingBox boundingBox;
+    if (thumbnail.type_ == ThumbnailType::Model)
+    {
+        auto model = cache->GetResource<Model>(resourceName);
+        staticModel_->SetModel(model);
+        staticModel_->SetMaterial(nullptr);
+        if (model)
+            boundingBox = model->GetBoundingBox();
+    }
+    else
+    {
+        auto model = cache->GetResource<Model>("Models/Sphere.mdl");
+        staticModel_->SetModel(model);
+        staticModel_->SetMaterial(cache->GetResource<Material>(resourceName));
+        if (model)
+            boundingBox = model->GetBoundingBox();
+    }
+
+    if (!staticModel_->GetModel() || !boundingBox.Defined())
+    {
+        thumbnail.state_ = ThumbnailState::Failed;
+        return;
+    }
+
+    const float distance = boundingBox.Size().Length();
+    Node* cameraNode = renderer_->GetCameraNode();
+    cameraNode->SetPosition(boundingBox.Center() + distance * Vector3(1.0f, 1.0f, -1.0f).Normalized());
+    cameraNode->LookAt(boundingBox.Center());
+    renderer_->GetCamera()->SetFarClip(distance * 4.0f);
+
+    // Scene is rendered at the end of this frame and read back on the next one
+    renderer_->SetActive(true);
+    renderer_->Update();
+
+    renderingResource_ = resourceName;
+    renderingVersion_ = thumbnail.version_;
+    renderingFrame_ = GetSubsystem<Time>()->GetFrameNumber();
+}
+
+void ResourceThumbnailCache::EndRender()
+{
+    if (GetSubsystem<Time>()->GetFrameNumber() == renderingFrame_)
+        return;
+
+    renderer_->SetActive(false);
+    const ea::string resourceName = ea::move(renderingResource_);
+    renderingResource_.clear();
+
+    const auto iter = thumbnails_.find(resourceName);
+    if (iter == thumbnails_.end() || iter->second.version_ != renderingVersion_)
+        return;
+
+    Thumbnail& thumbnail = iter->second;
+    SharedPtr<Image> image = renderer_->GetTexture()->GetImage();
+    if (image && image->GetComponents() != 4)
+        image = image->ConvertToRGBA();
+    if (!image)
+    {
+        thumbnail.state_ = ThumbnailState::Failed;
+        return;
+    }
+
+    thumbnail.texture_ = CreateThumbnailTexture(context_, image);
+    thumbnail.state_ = thumbnail.texture_ ? ThumbnailState::Ready : ThumbnailState::Failed;
+
+    // Store rendered thumbnail on disk in background
+    if (!thumbnail.cacheFileName_.empty())
+        PostTask([image, cacheFileName = thumbnail.cacheFileName_]() { image->SavePNG(cacheFileName); });
+}
+
+void ResourceThumbnailCache::InitializeScene()
+{
+    if (scene_)
+        return;
+
+    scene_ = MakeShared<Scene>(context_);
+    scene_->CreateComponent<Octree>();
+
+    auto zone = scene_->CreateComponent<Zone>();
+    zone->SetBoundingBox(BoundingBox(-M_LARGE_VALUE, M_LARGE_VALUE));
+    zone->SetAmbientColor(Color(0.4f, 0.4f, 0.4f));
+    zone->SetFogColor(Color(0.15f, 0.15f, 0.15f));
+
+    Node* lightNode = scene_->CreateChild("Light");
+    lightNode->SetDirection(Vector3(0.6f, -1.0f, 0.8f));
+    auto light = lightNode->CreateComponent<Light>();
+    light->SetLightType(LIGHT_DIRECTIONAL);
+
+    objectNode_ = scene_->CreateChild("Object");
+    staticModel_ = objectNode_->CreateComponent<StaticModel>();
+
+    renderer_ = MakeShared<SceneRendererToTexture>(scene_);
+    renderer_->SetTextureSize(IntVector2::ONE * static_cast<int>(thumbnailSize_));
+}
+
+void ResourceThumbnailCache::EvictUnused()
+{
+    if (thumbnails_.size() <= maxThumbnails)
+        return;
+
+    const unsigned frameNumber = GetSubsystem<Time>()->GetFrameNumber();
+    ea::erase_if(thumbnails_, [&](const auto& item)
+    {
+        const Thumbnail& thumbnail = item.second;
+        const bool isPending = thumbnail.state_ == ThumbnailState::Loading
+            || thumbnail.state_ == ThumbnailState::WaitingForRender;
+        return !isPending && thumbnail.lastUsedFrame_ + evictionDelayFrames < frameNumber;
+    });
+}
+
+}
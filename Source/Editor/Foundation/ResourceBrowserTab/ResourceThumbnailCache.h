@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include <Urho3D/Core/Mutex.h>
+#include <Urho3D/Core/Object.h>
+
+#include <EASTL/functional.h>
+#include <EASTL/shared_ptr.h>
+#include <EASTL/unordered_map.h>
+
+namespace Urho3D
+{
+
+class Image;
+class Node;
+class Scene;
+class SceneRendererToTexture;
+class StaticModel;
+class Texture2D;
+
+/// Generates preview thumbnails of resources in background and keeps them cached in memory and on disk.
+/// Textures are downscaled by worker threads, models and materials are rendered one per frame.
+/// Thumbnails on disk are keyed by the hash of file contents, so they survive renames and restarts.
+class ResourceThumbnailCache : public Object
+{
+    URHO3D_OBJECT(ResourceThumbnailCache, Object);
+
+public:
+    ResourceThumbnailCache(Context* context, const ea::string& cacheDirectory, unsigned thumbnailSize = 128);
+    ~ResourceThumbnailCache() override;
+
+    /// Return thumbnail if it's ready. Otherwise queue the resource for processing and return null.
+    /// Type of the resource is deduced from file extension.
+    Texture2D* GetThumbnail(const ea::string& resourceName, const ea::string& fileName);
+    /// Discard thumbnail of the resource so it is generated again on the next request.
+    void Invalidate(const ea::string& resourceName);
+    /// Process completed background tasks and render pending thumbnails. Should be called every frame.
+    void Update();
+
+    unsigned GetThumbnailSize() const { return thumbnailSize_; }
+
+private:
+    enum class ThumbnailType
+    {
+        Unsupported,
+        Texture,
+        Model,
+        Material
+    };
+
+    enum class ThumbnailState
+    {
+        Loading,
+        WaitingForRender,
+        Ready,
+        Failed
+    };
+
+    struct Thumbnail
+    {
+        ThumbnailType type_{};
+        ThumbnailState state_{};
+        ea::string cacheFileName_;
+        SharedPtr<Texture2D> texture_;
+        unsigned lastUsedFrame_{};
+        unsigned version_{};
+    };
+
+    /// Result of background task, produced by worker thread and consumed by main thread.
+    struct TaskResult
+    {
+        ea::string resourceName_;
+        unsigned version_{};
+        ea::string cacheFileName_;
+        SharedPtr<Image> image_;
+        bool needsRender_{};
+    };
+
+    /// State shared with background tasks. Outlives the cache if tasks are still running.
+    struct SharedState
+    {
+        Mutex mutex_;
+        ea::vector<TaskResult> results_;
+    };
+
+    static ThumbnailType GetThumbnailType(const ea::string& resourceName);
+    static TaskResult ProcessThumbnail(Context* context, ThumbnailType type, const ea::string& fileName,
+        const ea::string& cacheDirectory, unsigned thumbnailSize);
+
+    void PostTask(ea::function<void()> task);
+    void ConsumeResults();
+    void BeginRender(const ea::string& resourceName, Thumbnail& thumbnail);
+    void EndRender();
+    void InitializeScene();
+    void EvictUnused();
+
+    const ea::string cacheDirectory_;
+    const unsigned thumbnailSize_{};
+
+    ea::shared_ptr<SharedState> sharedState_;
+    ea::unordered_map<ea::string, Thumbnail> thumbnails_;
+    unsigned nextVersion_{};
+
+    /// Scene used to render thumbnails of models and materials.
+    /// @{
+    SharedPtr<Scene> scene_;
+    SharedPtr<SceneRendererToTexture> renderer_;
+    Node* objectNode_{};
+    StaticModel* staticModel_{};
+    /// @}
+
+    /// Thumbnail currently being rendered.
+    ea::string renderingResource_;
+    unsigned renderingVersion_{};
+    unsigned renderingFrame_{};
+};
+
+}
@@ -217,8 +217,16 @@ SceneViewTab::SceneViewTab(Context* context)
     BindHotkey(Hotkey_CreateSiblingNode, &SceneViewTab::CreateNodeNextToSelection);
     BindHotkey(Hotkey_CreateChildNode, &SceneViewTab::CreateNodeInSelection);
 
-    SubscribeToEvent(E_BEGINPLUGINRELOAD, [this](StringHash, VariantMap&) { BeginPluginReload(); });
-    SubscribeToEvent(E_ENDPLUGINRELOAD, [this](StringHash, VariantMap&) { EndPluginReload(); });
+    SubscribeToEvent(E_BEGINPLUGINRELOAD, [this](StringHash, VariantMap& eventData)
+    {
+        using namespace BeginPluginReload;
+        BeginPluginReload(eventData[P_PARTIAL].GetBool(), eventData[P_TYPES].GetStringVector());
+    });
+    SubscribeToEvent(E_ENDPLUGINRELOAD, [this](StringHash, VariantMap& eventData)
+    {
+        using namespace EndPluginReload;
+        EndPluginReload(eventData[P_PARTIAL].GetBool());
+    });
 }
 
 SceneViewTab::~SceneViewTab()
@@ -1166,22 +1174,54 @@ void SceneViewTab::LoadPageConfig(SceneViewPage& page) const
     }
 }
 
-void SceneViewTab::BeginPluginReload()
+void SceneViewTab::BeginPluginReload(bool partial, const StringVector& reloadedTypes)
 {
+    ea::vector<Component*> components;
+    ea::vector<Component*> componentsOfType;
     for (const auto& [_, page] : scenes_)
     {
-        page->archivedScene_ = PackedSceneData::FromScene(page->scene_);
         page->archivedSelection_ = page->selection_.Pack();
-        page->scene_->Clear();
+        if (!partial)
+        {
+            page->archivedScene_ = PackedSceneData::FromScene(page->scene_);
+            page->scene_->Clear();
+            continue;
+        }
+
+        // Only components of reloaded types are destroyed, the rest of the scene stays intact
+        components.clear();
+        for (const ea::string& typeName : reloadedTypes)
+        {
+            page->scene_->GetComponents(componentsOfType, typeName, true);
+            components.append(componentsOfType);
+        }
+
+        // Restore components in order of increasing index so each one gets back to its original position
+        const auto compareIndices = [](const Component* lhs, const Component* rhs)
+        { return lhs->GetIndexInParent() < rhs->GetIndexInParent(); };
+        ea::stable_sort(components.begin(), components.end(), compareIndices);
+
+        page->archivedComponents_ = PackedNodeComponentData::FromComponents(components.begin(), components.end());
+        for (Component* component : components)
+            component->Remove();
     }
 }
 
-void SceneViewTab::EndPluginReload()
+void SceneViewTab::EndPluginReload(bool partial)
 {
     for (const auto& [_, page] : scenes_)
     {
-        page->scene_->Clear();
-        page->archivedScene_.ToScene(page->scene_);
+        if (!partial)
+        {
+            page->scene_->Clear();
+            page->archivedScene_.ToScene(page->scene_);
+        }
+        else
+        {
+            for (const PackedComponentData& componentData : page->archivedComponents_.GetComponents())
+                componentData.SpawnExact(page->scene_);
+            page->archivedComponents_ = {};
+        }
         page->selection_.Load(page->scene_, page->archivedSelection_);
     }
 }
@@ -86,6 +86,7 @@ public:
     Ray cameraRay_;
 
     PackedSceneData archivedScene_;
+    PackedNodeComponentData archivedComponents_;
     PackedSceneSelection archivedSelection_;
 
     /// UI state
@@ -292,8 +293,8 @@ private:
     bool UpdateDropToScene();
     void InspectSelection(SceneViewPage& page);
 
-    void BeginPluginReload();
-    void EndPluginReload();
+    void BeginPluginReload(bool partial, const StringVector& reloadedTypes);
+    void EndPluginReload(bool partial);
 
     ea::vector<SharedPtr<SceneViewAddon>> addons_;
     AddonSetByInputPriority addonsByInputPriority_;
@@ -0,0 +1,306 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Project/AssetBuildCache.h"
+
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/IO/ArchiveSerialization.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Resource/JSONFile.h>
+#include <Urho3D/SystemUI/SystemUI.h>
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Increment to invalidate all existing cache entries.
+const unsigned CacheFormatVersion = 1;
+
+/// Two independent 64-bit hashes combined into 128-bit key.
+class ContentHasher
+{
+public:
+    void Append(const void* data, unsigned size)
+    {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (unsigned i = 0; i < size; ++i)
+        {
+            first_ = (first_ ^ bytes[i]) * 0x100000001b3ull;
+            second_ = (second_ ^ bytes[i]) * 0x9e3779b97f4a7c15ull;
+            second_ ^= second_ >> 29;
+        }
+    }
+
+    void Append(const ea::string& value)
+    {
+        Append(value.c_str(), value.length() + 1);
+    }
+
+    void Append(unsigned value)
+    {
+        Append(&value, sizeof(value));
+    }
+
+    ea::string ToString() const
+    {
+        return Format("{:016x}{:016x}", first_, second_);
+    }
+
+private:
+    unsigned long long first_{0xcbf29ce484222325ull};
+    unsigned long long second_{0x84222325cbf29ce4ull};
+};
+
+bool AppendFileContent(ContentHasher& hasher, Context* context, const ea::string& fileName)
+{
+    File file(context);
+    if (!file.Open(fileName, FILE_READ))
+        return false;
+
+    unsigned char buffer[64 * 1024];
+    while (!file.IsEof())
+    {
+        const unsigned size = file.Read(buffer, sizeof(buffer));
+        if (size == 0)
+            break;
+        hasher.Append(buffer, size);
+    }
+    return true;
+}
+
+ea::string GetDataFolder(const AssetTransformerInput& input)
+{
+    return input.originalInputFileName_.substr(
+        0, input.originalInputFileName_.length() - input.originalResourceName_.length());
+}
+
+}
+
+void AssetBuildCache::Settings::SerializeInBlock(Archive& archive)
+{
+    SerializeOptionalValue(archive, "Enabled", enabled_, Settings{}.enabled_);
+    SerializeOptionalValue(archive, "SharedPath", sharedPath_, Settings{}.sharedPath_);
+    SerializeOptionalValue(archive, "WriteShared", writeShared_, Settings{}.writeShared_);
+}
+
+void AssetBuildCache::Settings::RenderSettings()
+{
+    ui::Checkbox("Enabled", &enabled_);
+    ui::Text("Path to shared cache folder (local cache only if empty):");
+    ui::InputText("##SharedPath", &sharedPath_);
+    ui::Checkbox("Write to Shared Cache", &writeShared_);
+}
+
+void AssetBuildCache::Entry::SerializeInBlock(Archive& archive)
+{
+    SerializeOptionalValue(archive, "outputs", outputs_);
+    SerializeOptionalValue(archive, "transformers", transformers_);
+    SerializeOptionalValue(archive, "dependencyHashes", dependencyHashes_);
+}
+
+AssetBuildCache::AssetBuildCache(Context* context, const ea::string& localPath)
+    : Object(context)
+    , localPath_(localPath)
+    , settingsPage_(MakeShared<SettingsPage>(context))
+{
+}
+
+bool AssetBuildCache::IsEnabled() const
+{
+    return settingsPage_->GetValues().enabled_;
+}
+
+ea::string AssetBuildCache::CalculateKey(
+    const AssetTransformerInput& input, const AssetTransformerVector& transformers) const
+{
+    ContentHasher hasher;
+    hasher.Append(CacheFormatVersion);
+    hasher.Append(input.resourceName_);
+    hasher.Append(input.flavor_.ToString());
+
+    for (AssetTransformer* transformer : transformers)
+    {
+        JSONFile settings(context_);
+        if (!settings.SaveObject("transformer", *transformer))
+            return EMPTY_STRING;
+
+        hasher.Append(transformer->GetTypeName());
+        hasher.Append(transformer->GetVersion());
+        hasher.Append(settings.ToString());
+    }
+
+    if (!AppendFileContent(hasher, context_, input.inputFileName_))
+        return EMPTY_STRING;
+
+    return hasher.ToString();
+}
+
+ea::string AssetBuildCache::GetEntryPath(const ea::string& rootPath, const ea::string& key) const
+{
+    return Format("{}{}/{}/", rootPath, key.substr(0, 2), key);
+}
+
+ea::string AssetBuildCache::GetFileHash(const ea::string& fileName) const
+{
+    ContentHasher hasher;
+    return AppendFileContent(hasher, context_, fileName) ? hasher.ToString() : EMPTY_STRING;
+}
+
+bool AssetBuildCache::Fetch(const ea::string& key, const AssetTransformerInput& input, const ea::string& outputPath,
+    AssetTransformerOutput& output) const
+{
+    if (FetchFromRoot(localPath_, key, input, outputPath, output))
+        return true;
+
+    const Settings& settings = settingsPage_->GetValues();
+    if (settings.sharedPath_.empty())
+        return false;
+
+    const ea::string sharedPath = AddTrailingSlash(settings.sharedPath_);
+    if (!FetchFromRoot(sharedPath, key, input, outputPath, output))
+        return false;
+
+    // Keep local copy of the shared entry
+    auto fs = GetSubsystem<FileSystem>();
+    const ea::string entryPath = GetEntryPath(localPath_, key);
+    fs->CreateDirsRecursive(entryPath);
+    fs->CopyDir(GetEntryPath(sharedPath, key), entryPath);
+    return true;
+}
+
+bool AssetBuildCache::FetchFromRoot(const ea::string& rootPath, const ea::string& key,
+    const AssetTransformerInput& input, const ea::string& outputPath, AssetTransformerOutput& output) const
+{
+    auto fs = GetSubsystem<FileSystem>();
+
+    const ea::string entryPath = GetEntryPath(rootPath, key);
+    const ea::string manifestFileName = entryPath + "Entry.json";
+    if (!fs->FileExists(manifestFileName))
+        return false;
+
+    Entry entry;
+    auto manifest = MakeShared<JSONFile>(context_);
+    if (!manifest->LoadFile(manifestFileName) || !manifest->LoadObject("Entry", entry))
+        return false;
+
+    // Dependencies are not known before processing, so they are validated on fetch
+    const ea::string dataFolder = GetDataFolder(input);
+    for (const auto& [dependencyResourceName, hash] : entry.dependencyHashes_)
+    {
+        if (GetFileHash(dataFolder + dependencyResourceName) != hash)
+            return false;
+    }
+
+    const ea::string filesPath = entryPath + "Files/";
+    for (const ea::string& outputResourceName : entry.outputs_)
+    {
+        if (!fs->FileExists(filesPath + outputResourceName))
+            return false;
+    }
+
+    for (const ea::string& outputResourceName : entry.outputs_)
+    {
+        const ea::string outputFileName = outputPath + outputResourceName;
+        fs->CreateDirsRecursive(GetPath(outputFileName));
+        if (!fs->Copy(filesPath + outputResourceName, outputFileName))
+            return false;
+    }
+
+    output.outputResourceNames_ = entry.outputs_;
+    output.appliedTransformers_ = entry.transformers_;
+    for (const auto& [dependencyResourceName, hash] : entry.dependencyHashes_)
+    {
+        const ea::string fileName = dataFolder + dependencyResourceName;
+        output.dependencyModificationTimes_[dependencyResourceName] = fs->GetLastModifiedTime(fileName, true);
+    }
+
+    URHO3D_LOGDEBUG("Asset {} is fetched from build cache {}", input.resourceName_, rootPath);
+    return true;
+}
+
+void AssetBuildCache::Store(const ea::string& key, const AssetTransformerInput& input, const ea::string& outputPath,
+    const AssetTransformerOutput& output) const
+{
+    // Transformers that modify the source are not deterministic with respect to the key
+    if (output.sourceModified_)
+        return;
+
+    Entry entry;
+    entry.outputs_ = output.outputResourceNames_;
+    entry.transformers_ = output.appliedTransformers_;
+
+    const ea::string dataFolder = GetDataFolder(input);
+    for (const auto& [dependencyResourceName, modificationTime] : output.dependencyModificationTimes_)
+    {
+        const ea::string hash = GetFileHash(dataFolder + dependencyResourceName);
+        if (hash.empty())
+            return;
+        entry.dependencyHashes_[dependencyResourceName] = hash;
+    }
+
+    StoreInRoot(localPath_, key, entry, outputPath);
+
+    const Settings& settings = settingsPage_->GetValues();
+    if (!settings.sharedPath_.empty() && settings.writeShared_)
+        StoreInRoot(AddTrailingSlash(settings.sharedPath_), key, entry, outputPath);
+}
+
+void AssetBuildCache::StoreInRoot(
+    const ea::string& rootPath, const ea::string& key, const Entry& entry, const ea::string& outputPath) const
+{
+    auto fs = GetSubsystem<FileSystem>();
+
+    const ea::string entryPath = GetEntryPath(rootPath, key);
+    if (fs->DirExists(entryPath))
+        return;
+
+    // Fill temporary folder first so other processes never see incomplete entries
+    const ea::string tempPath = Format("{}Temp/{}/", rootPath, GenerateUUID());
+    const ea::string filesPath = tempPath + "Files/";
+    for (const ea::string& outputResourceName : entry.outputs_)
+    {
+        const ea::string fileName = filesPath + outputResourceName;
+        fs->CreateDirsRecursive(GetPath(fileName));
+        if (!fs->Copy(outputPath + outputResourceName, fileName))
+        {
+            fs->RemoveDir(tempPath, true);
+            return;
+        }
+    }
+
+    auto manifest = MakeShared<JSONFile>(context_);
+    if (!manifest->SaveObject("Entry", entry) || !manifest->SaveFile(tempPath + "Entry.json"))
+    {
+        fs->RemoveDir(tempPath, true);
+        return;
+    }
+
+    fs->CreateDirsRecursive(GetParentPath(entryPath));
+    if (!fs->Rename(RemoveTrailingSlash(tempPath), RemoveTrailingSlash(entryPath)))
+        fs->RemoveDir(tempPath, true);
+}
+
+}
@@ -0,0 +1,92 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Core/SettingsManager.h"
+
+#include <Urho3D/Utility/AssetTransformer.h>
+
+namespace Urho3D
+{
+
+/// Content-addressed cache of asset transformer outputs.
+/// Entries are keyed by the hash of the input file, the resource name, the flavor and
+/// the types, versions and settings of the transformers.
+/// Entries are stored in the local cache folder and optionally in the shared folder,
+/// e.g. network drive used by other developers and build agents.
+class AssetBuildCache : public Object
+{
+    URHO3D_OBJECT(AssetBuildCache, Object);
+
+public:
+    struct Settings
+    {
+        ea::string GetUniqueName() { return "Editor.AssetBuildCache"; }
+
+        void SerializeInBlock(Archive& archive);
+        void RenderSettings();
+
+        bool enabled_{true};
+        ea::string sharedPath_;
+        bool writeShared_{true};
+    };
+    using SettingsPage = SimpleSettingsPage<Settings>;
+
+    AssetBuildCache(Context* context, const ea::string& localPath);
+
+    /// Return settings page that should be registered in the settings manager.
+    SettingsPage* GetSettingsPage() const { return settingsPage_; }
+    /// Return whether the cache is enabled.
+    bool IsEnabled() const;
+
+    /// Calculate key of the cache entry. Return empty string if the input cannot be cached.
+    ea::string CalculateKey(const AssetTransformerInput& input, const AssetTransformerVector& transformers) const;
+    /// Copy outputs of cached entry to the output path. Return true on cache hit.
+    bool Fetch(const ea::string& key, const AssetTransformerInput& input, const ea::string& outputPath,
+        AssetTransformerOutput& output) const;
+    /// Store outputs of processed asset in the cache.
+    void Store(const ea::string& key, const AssetTransformerInput& input, const ea::string& outputPath,
+        const AssetTransformerOutput& output) const;
+
+private:
+    struct Entry
+    {
+        ea::vector<ea::string> outputs_;
+        ea::unordered_set<ea::string> transformers_;
+        ea::unordered_map<ea::string, ea::string> dependencyHashes_;
+
+        void SerializeInBlock(Archive& archive);
+    };
+
+    ea::string GetEntryPath(const ea::string& rootPath, const ea::string& key) const;
+    ea::string GetFileHash(const ea::string& fileName) const;
+    bool FetchFromRoot(const ea::string& rootPath, const ea::string& key, const AssetTransformerInput& input,
+        const ea::string& outputPath, AssetTransformerOutput& output) const;
+    void StoreInRoot(const ea::string& rootPath, const ea::string& key, const Entry& entry,
+        const ea::string& outputPath) const;
+
+    const ea::string localPath_;
+    SharedPtr<SettingsPage> settingsPage_;
+};
+
+}
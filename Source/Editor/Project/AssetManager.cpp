@@ -27,6 +27,7 @@
 #include <Urho3D/IO/Log.h>
 #include <Urho3D/Resource/JSONArchive.h>
 #include <Urho3D/Resource/JSONFile.h>
+#include <Urho3D/Resource/ResourceEvents.h>
 
 #include <EASTL/sort.h>
 
@@ -63,10 +64,17 @@ AssetManager::AssetManager(Context* context)
     , project_(GetSubsystem<Project>())
     , dataWatcher_(MakeShared<FileWatcher>(context))
     , transformerHierarchy_(MakeShared<AssetTransformerHierarchy>(context_))
+    , buildCache_(MakeShared<AssetBuildCache>(context_, project_->GetProjectPath() + "BuildCache/"))
 {
     dataWatcher_->StartWatching(project_->GetDataPath(), true);
     context_->OnReflectionRemoved.Subscribe(this, &AssetManager::OnReflectionRemoved);
     SetProcessCallback(nullptr);
+
+    // Process assets requested by the editor first
+    SubscribeToEvent(E_RESOURCENOTFOUND, [this](StringHash, VariantMap& eventData)
+    {
+        PrioritizeAsset(eventData[ResourceNotFound::P_RESOURCENAME].GetString());
+    });
 }
 
 AssetManager::~AssetManager()
@@ -135,10 +143,23 @@ void AssetManager::ConsumeAssetQueue()
     ea::vector<AssetTransformerInput> queue;
     while (!requestQueue_.empty() && numOngoingRequests_ < maxConcurrentRequests_)
     {
+        // Queue is consumed from the back so prioritized assets are processed first
+        auto iter = ea::find_if(requestQueue_.rbegin(), requestQueue_.rend(),
+            [this](const AssetTransformerInput& input) { return !IsAssetProcessingBlocked(input.resourceName_); });
+        if (iter == requestQueue_.rend())
+        {
+            // Wait for ongoing requests unless dependencies are cyclic
+            if (numOngoingRequests_ != 0)
+                break;
+            iter = requestQueue_.rbegin();
+        }
+
         ++numOngoingRequests_;
         ++progress_.second;
-        queue.push_back(requestQueue_.back());
-        requestQueue_.pop_back();
+        queue.push_back(*iter);
+        queuedAssets_.erase(iter->resourceName_);
+        ongoingAssets_.insert(iter->resourceName_);
+        requestQueue_.erase(ea::next(iter).base());
     }
 
     for (const AssetTransformerInput& input : queue)
@@ -151,6 +172,39 @@ void AssetManager::ConsumeAssetQueue()
     }
 }
 
+bool AssetManager::IsAssetProcessingBlocked(const ea::string& resourceName) const
+{
+    const auto iter = assets_.find(resourceName);
+    if (iter == assets_.end())
+        return false;
+
+    // Dependencies are known from the previous processing of the asset
+    for (const auto& [dependencyName, modificationTime] : iter->second.dependencyModificationTimes_)
+    {
+        if (dependencyName == resourceName)
+            continue;
+        if (queuedAssets_.contains(dependencyName) || ongoingAssets_.contains(dependencyName))
+            return true;
+    }
+    return false;
+}
+
+void AssetManager::PrioritizeAsset(const ea::string& resourceName)
+{
+    const auto isRequested = [&](const AssetTransformerInput& input)
+    {
+        if (input.resourceName_ == resourceName)
+            return true;
+
+        const auto iter = assets_.find(input.resourceName_);
+        return iter != assets_.end() && iter->second.outputs_.contains(resourceName);
+    };
+
+    const auto iter = ea::find_if(requestQueue_.begin(), requestQueue_.end(), isRequested);
+    if (iter != requestQueue_.end())
+        ea::rotate(iter, ea::next(iter), requestQueue_.end());
+}
+
 void AssetManager::MarkCacheDirty(const ea::string& resourcePath)
 {
     InvalidateAssetsInPath(resourcePath);
@@ -572,6 +626,7 @@ bool AssetManager::QueueAssetProcessing(const ea::string& resourceName, const Ap
     const ea::string tempPath = project_->GetRandomTemporaryPath();
     const ea::string outputFileName = tempPath + resourceName;
     requestQueue_.push_back(AssetTransformerInput{input, tempPath, outputFileName});
+    queuedAssets_.insert(resourceName);
     return true;
 }
 
@@ -583,9 +638,16 @@ void AssetManager::ProcessAsset(const AssetTransformerInput& input, const OnProc
     const AssetTransformerVector transformers = transformerHierarchy_->GetTransformerCandidates(
         input.resourceName_, input.flavor_);
 
+    const ea::string buildCacheKey = buildCache_->IsEnabled() ? buildCache_->CalculateKey(input, transformers) : "";
     AssetTransformerOutput output;
-    if (AssetTransformer::ExecuteTransformersAndStore(input, cachePath, output, transformers))
+    if (!buildCacheKey.empty() && buildCache_->Fetch(buildCacheKey, input, cachePath, output))
         callback(input, ea::move(output), EMPTY_STRING);
+    else if (AssetTransformer::ExecuteTransformersAndStore(input, cachePath, output, transformers))
+    {
+        if (!buildCacheKey.empty())
+            buildCache_->Store(buildCacheKey, input, cachePath, output);
+        callback(input, ea::move(output), EMPTY_STRING);
+    }
     else
         callback(input, ea::nullopt, EMPTY_STRING);
 }
@@ -599,6 +661,7 @@ void AssetManager::CompleteAssetProcessing(
         URHO3D_ASSERTLOG(false, "AssetManager::CompleteAssetProcessing() called with no ongoing requests");
 
     ++progress_.first;
+    ongoingAssets_.erase(input.resourceName_);
 
     if (output)
     {
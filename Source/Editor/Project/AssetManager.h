@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include "../Project/AssetBuildCache.h"
+
 #include <Urho3D/Core/Signal.h>
 #include <Urho3D/IO/FileSystem.h>
 #include <Urho3D/IO/FileWatcher.h>
@@ -61,8 +63,13 @@ public:
 
     /// Override asset processing.
     void SetProcessCallback(const OnProcessAssetQueued& callback, unsigned maxConcurrency = 1);
+    /// Return cache of asset transformer outputs.
+    AssetBuildCache* GetBuildCache() const { return buildCache_; }
     /// Process asset without affecting internal state of AssetManager.
     void ProcessAsset(const AssetTransformerInput& input, const OnProcessAssetCompleted& callback) const;
+    /// Move queued asset to the front of the queue.
+    /// Resource name may be either the name of the asset itself or the name of its output.
+    void PrioritizeAsset(const ea::string& resourceName);
 
     /// Initialize asset manager.
     /// Should be called after the manager configuration is loaded from file *and* plugins are initialized.
@@ -160,6 +167,8 @@ private:
     void ScanAssetsInPath(const ea::string& resourcePath, Stats& stats);
     bool QueueAssetProcessing(const ea::string& resourceName, const ApplicationFlavor& flavor);
     void ConsumeAssetQueue();
+    /// Return whether the asset depends on other assets that are queued or being processed.
+    bool IsAssetProcessingBlocked(const ea::string& resourceName) const;
 
     void CompleteAssetProcessing(
         const AssetTransformerInput& input, const ea::optional<AssetTransformerOutput>& output, const ea::string& message);
@@ -182,11 +191,14 @@ private:
 
     AssetPipelineDescVector assetPipelines_;
     SharedPtr<AssetTransformerHierarchy> transformerHierarchy_;
+    SharedPtr<AssetBuildCache> buildCache_;
     ea::unordered_map<ea::string, AssetDesc> assets_;
     AssetPipelineList assetPipelineFiles_;
     ea::unordered_set<ea::string> ignoredAssetUpdates_;
 
     ea::vector<AssetTransformerInput> requestQueue_;
+    ea::unordered_set<ea::string> queuedAssets_;
+    ea::unordered_set<ea::string> ongoingAssets_;
     unsigned numOngoingRequests_{};
 
     ProgressInfo progress_;
@@ -110,6 +110,16 @@ bool ModifyResourceAction::MergeWith(const EditorAction& other)
     return false;
 }
 
+unsigned ModifyResourceAction::GetMemoryUsage() const
+{
+    unsigned memoryUsage = 0;
+    for (const auto& [resourceName, data] : oldData_)
+        memoryUsage += data.bytes_ ? data.bytes_->size() : 0;
+    for (const auto& [resourceName, data] : newData_)
+        memoryUsage += data.bytes_ ? data.bytes_->size() : 0;
+    return memoryUsage;
+}
+
 void ModifyResourceAction::ApplyResourceData(const ea::string& resourceName, const ResourceData& data) const
 {
     auto cache = context_->GetSubsystem<ResourceCache>();
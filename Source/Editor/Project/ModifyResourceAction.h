@@ -45,6 +45,7 @@ public:
     void Redo() const override;
     void Undo() const override;
     bool MergeWith(const EditorAction& other) override;
+    unsigned GetMemoryUsage() const override;
     /// @}
 
 private:
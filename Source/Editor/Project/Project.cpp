@@ -235,6 +235,7 @@ Project::Project(Context* context, const ea::string& projectPath, const ea::stri
     ApplyPlugins();
 
     settingsManager_->AddPage(toolManager_);
+    settingsManager_->AddPage(assetManager_->GetBuildCache()->GetSettingsPage());
 
     settingsManager_->LoadFile(settingsJsonPath_);
     assetManager_->LoadFile(cacheJsonPath_);
@@ -669,6 +670,7 @@ void Project::SaveGitIgnore()
     content += "# Ignore asset cache\n";
     content += "/Cache/\n";
     content += "/Cache.json\n";
+    content += "/BuildCache/\n";
     content += "\n";
 
     content += "# Ignore temporary files\n";
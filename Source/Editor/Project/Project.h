@@ -192,6 +192,7 @@ public:
     const ea::string& GetCoreDataPath() const { return coreDataPath_; }
     const ea::string& GetDataPath() const { return dataPath_; }
     const ea::string& GetCachePath() const { return cachePath_; }
+    const ea::string& GetTempPath() const { return tempPath_; }
     const ea::string& GetPreviewPngPath() const { return previewPngPath_; }
     /// @}
 
@@ -586,3 +586,51 @@ TEST_CASE("Complete infinite Action")
 
     CHECK(0 == actionManager->GetNumActions(target));
 }
+
+TEST_CASE("Parallel update of node transform actions")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto actionManager = context->GetSubsystem<ActionManager>();
+    const auto scene = MakeShared<Scene>(context);
+
+    SharedPtr<Actions::BaseAction> moveAction = ActionBuilder(context)
+        .MoveBy(1.0f, Vector3(10, 0, 0))
+        .Also(ActionBuilder(context).RotateBy(1.0f, Quaternion(90, Vector3::UP)).Build())
+        .Build();
+    SharedPtr<Actions::BaseAction> disableAction = ActionBuilder(context).DelayTime(0.5f).Disable().Build();
+    CHECK(moveAction->IsTransformOnly());
+    CHECK_FALSE(disableAction->IsTransformOnly());
+
+    ea::vector<Node*> parents;
+    ea::vector<Node*> children;
+    for (unsigned i = 0; i < 200; ++i)
+    {
+        Node* parent = scene->CreateChild();
+        Node* child = parent->CreateChild();
+        actionManager->AddAction(moveAction, parent);
+        actionManager->AddAction(moveAction, child);
+        parents.push_back(parent);
+        children.push_back(child);
+    }
+    Node* disabledNode = scene->CreateChild();
+    actionManager->AddAction(disableAction, disabledNode);
+
+    actionManager->SetParallelUpdate(true);
+    actionManager->Update(0.0f);
+    actionManager->Update(0.5f);
+
+    for (unsigned i = 0; i < parents.size(); ++i)
+    {
+        CHECK(parents[i]->GetPosition().Equals(Vector3(5, 0, 0)));
+        CHECK(children[i]->GetPosition().Equals(Vector3(5, 0, 0)));
+        CHECK(children[i]->GetWorldPosition().Equals(parents[i]->GetWorldTransform() * Vector3(5, 0, 0)));
+    }
+
+    actionManager->Update(0.6f);
+    CHECK(parents[0]->GetPosition().Equals(Vector3(10, 0, 0)));
+    CHECK(0 == actionManager->GetNumActions(parents[0]));
+    CHECK(0 == actionManager->GetNumActions(disabledNode));
+
+    actionManager->SetParallelUpdate(false);
+    actionManager->CancelAllActions();
+}
@@ -0,0 +1,121 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Audio/AudioMixing.h>
+#include <Urho3D/Math/MathDefs.h>
+
+namespace
+{
+
+/// Frame counts that leave tails after vectorized loops of 2, 4 and 8 elements.
+const unsigned testFrameCounts[] = {0, 1, 2, 3, 5, 7, 8, 13, 31, 64};
+
+ea::vector<float> MakeTestSamples(unsigned numSamples, float phase)
+{
+    ea::vector<float> samples(numSamples);
+    for (unsigned i = 0; i < numSamples; ++i)
+        samples[i] = Sin(i * 37.0f + phase) * 1.2f;
+    return samples;
+}
+
+}
+
+TEST_CASE("Mono source is mixed into output channels same as scalar reference")
+{
+    const float gains[MAX_AUDIO_CHANNELS] = {0.3f, 1.7f, -0.5f, 0.25f, 1.0f, 0.75f};
+    for (unsigned numChannels : {1u, 2u, 6u})
+    {
+        for (unsigned numFrames : testFrameCounts)
+        {
+            const ea::vector<float> source = MakeTestSamples(numFrames, 0.0f);
+            ea::vector<float> dest = MakeTestSamples(numFrames * numChannels, 10.0f);
+            ea::vector<float> expected = dest;
+
+            MixMonoToChannels(dest.data(), source.data(), numFrames, numChannels, gains);
+            for (unsigned i = 0; i < numFrames; ++i)
+            {
+                for (unsigned channel = 0; channel < numChannels; ++channel)
+                    expected[i * numChannels + channel] += source[i] * gains[channel];
+            }
+
+            for (unsigned i = 0; i < dest.size(); ++i)
+                CHECK(dest[i] == Catch::Approx(expected[i]).margin(M_EPSILON));
+        }
+    }
+}
+
+TEST_CASE("Stereo source is mixed into output channels same as scalar reference")
+{
+    const float leftGains[MAX_AUDIO_CHANNELS] = {0.9f, 0.1f, 0.5f, -0.25f, 1.0f, 0.0f};
+    const float rightGains[MAX_AUDIO_CHANNELS] = {0.2f, 1.1f, 0.5f, 0.25f, 0.0f, 1.0f};
+    for (unsigned numChannels : {1u, 2u, 6u})
+    {
+        for (unsigned numFrames : testFrameCounts)
+        {
+            const ea::vector<float> source = MakeTestSamples(numFrames * 2, 0.0f);
+            ea::vector<float> dest = MakeTestSamples(numFrames * numChannels, 10.0f);
+            ea::vector<float> expected = dest;
+
+            MixStereoToChannels(dest.data(), source.data(), numFrames, numChannels, leftGains, rightGains);
+            for (unsigned i = 0; i < numFrames; ++i)
+            {
+                const float left = source[i * 2];
+                const float right = source[i * 2 + 1];
+                for (unsigned channel = 0; channel < numChannels; ++channel)
+                    expected[i * numChannels + channel] += left * leftGains[channel] + right * rightGains[channel];
+            }
+
+            for (unsigned i = 0; i < dest.size(); ++i)
+                CHECK(dest[i] == Catch::Approx(expected[i]).margin(M_EPSILON));
+        }
+    }
+}
+
+TEST_CASE("Samples are converted to 16-bit integers same as scalar reference")
+{
+    for (unsigned numSamples : testFrameCounts)
+    {
+        ea::vector<float> source = MakeTestSamples(numSamples, 0.0f);
+        // Fractional part of scaled value is far from 0.5, so truncation or different tie rounding is detected
+        if (numSamples > 1)
+        {
+            source[0] = 100.75f / 32767.0f;
+            source[numSamples - 1] = -100.75f / 32767.0f;
+        }
+
+        ea::vector<short> dest(numSamples);
+        ConvertToInt16(dest.data(), source.data(), numSamples);
+        for (unsigned i = 0; i < numSamples; ++i)
+        {
+            const int expected = RoundToInt(Clamp(source[i], -1.0f, 1.0f) * 32767.0f);
+            CHECK(dest[i] == expected);
+        }
+
+        if (numSamples > 1)
+        {
+            CHECK(dest[0] == 101);
+            CHECK(dest[numSamples - 1] == -101);
+        }
+    }
+}
@@ -0,0 +1,81 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+using System;
+using System.Threading.Tasks;
+using Xunit;
+
+namespace Urho3DNet.Tests
+{
+    public class NodeListTests
+    {
+        [Fact]
+        public async Task BulkTransforms_SetAndGet_MatchNodes()
+        {
+            await ApplicationRunner.RunAsync(app =>
+            {
+                var parent = new Node(app.Context);
+                parent.AddRef();
+                try
+                {
+                    parent.Position = new Vector3(10, 0, 0);
+                    for (int i = 0; i < 4; ++i)
+                        parent.CreateChild();
+
+                    var nodes = new NodeList();
+                    parent.GetChildren(nodes, false);
+                    Assert.Equal(4, nodes.Count);
+
+                    Span<Vector3> positions = stackalloc Vector3[4];
+                    for (int i = 0; i < positions.Length; ++i)
+                        positions[i] = new Vector3(i, 2 * i, 0);
+                    nodes.SetPositions(positions);
+
+                    Span<Vector3> worldPositions = stackalloc Vector3[4];
+                    nodes.GetPositions(worldPositions, true);
+                    for (int i = 0; i < worldPositions.Length; ++i)
+                    {
+                        Assert.Equal(positions[i], nodes[i].Position);
+                        Assert.Equal(positions[i] + new Vector3(10, 0, 0), worldPositions[i]);
+                    }
+
+                    Assert.Throws<ArgumentException>(() => nodes.GetPositions(new Vector3[2]));
+                }
+                finally
+                {
+                    parent.ReleaseRef();
+                }
+            });
+        }
+
+        [Fact]
+        public void VectorOfValues_AsSpan_SharesStorage()
+        {
+            var list = new Vector3List();
+            list.Assign(new[] { new Vector3(1, 2, 3), new Vector3(4, 5, 6) });
+            Assert.Equal(2, list.Count);
+
+            list.AsSpan()[1] = new Vector3(7, 8, 9);
+            Assert.Equal(new Vector3(7, 8, 9), list[1]);
+        }
+    }
+}
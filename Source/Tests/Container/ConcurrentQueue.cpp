@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Container/ConcurrentQueue.h>
+
+#include <EASTL/vector.h>
+
+#include <thread>
+
+TEST_CASE("ConcurrentQueue preserves order and respects capacity")
+{
+    ConcurrentQueue<unsigned> queue;
+    queue.Allocate(3);
+    REQUIRE(queue.GetCapacity() == 4);
+    REQUIRE(queue.IsEmpty());
+
+    for (unsigned i = 0; i < 4; ++i)
+        REQUIRE(queue.Push(i));
+
+    unsigned extra = 100;
+    REQUIRE_FALSE(queue.Push(extra));
+    REQUIRE(extra == 100);
+
+    unsigned value{};
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        REQUIRE(queue.Pop(value));
+        REQUIRE(value == i);
+    }
+    REQUIRE_FALSE(queue.Pop(value));
+    REQUIRE(queue.IsEmpty());
+}
+
+TEST_CASE("ConcurrentQueue delivers every element exactly once with many producers and consumers")
+{
+    static const unsigned numProducers = 4;
+    static const unsigned numConsumers = 4;
+    static const unsigned numElementsPerProducer = 20000;
+    static const unsigned numElements = numProducers * numElementsPerProducer;
+
+    ConcurrentQueue<unsigned> queue;
+    queue.Allocate(256);
+
+    ea::vector<std::atomic<unsigned>> received(numElements);
+    std::atomic<unsigned> numReceived{};
+
+    ea::vector<std::thread> threads;
+    for (unsigned producerIndex = 0; producerIndex < numProducers; ++producerIndex)
+    {
+        threads.emplace_back([&, producerIndex]
+        {
+            for (unsigned i = 0; i < numElementsPerProducer; ++i)
+            {
+                unsigned value = producerIndex * numElementsPerProducer + i;
+                while (!queue.Push(value))
+                    std::this_thread::yield();
+            }
+        });
+    }
+    for (unsigned consumerIndex = 0; consumerIndex < numConsumers; ++consumerIndex)
+    {
+        threads.emplace_back([&]
+        {
+            unsigned value{};
+            while (numReceived.load() < numElements)
+            {
+                if (queue.Pop(value))
+                {
+                    received[value].fetch_add(1);
+                    numReceived.fetch_add(1);
+                }
+                else
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    REQUIRE(queue.IsEmpty());
+    REQUIRE(numReceived.load() == numElements);
+    for (unsigned i = 0; i < numElements; ++i)
+        REQUIRE(received[i].load() == 1);
+}
@@ -0,0 +1,62 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Container/LinearAllocator.h>
+#include <Urho3D/Core/WorkQueue.h>
+
+TEST_CASE("LinearAllocator allocates aligned blocks and merges chunks on reset")
+{
+    LinearAllocator allocator{256};
+
+    LinearVector<unsigned> values{LinearAllocatorAdaptor{&allocator}};
+    for (unsigned i = 0; i < 1000; ++i)
+        values.push_back(i);
+    CHECK(values.size() == 1000);
+    CHECK(values[999] == 999);
+
+    const void* aligned = allocator.Allocate(10, 64);
+    CHECK(reinterpret_cast<uintptr_t>(aligned) % 64 == 0);
+    CHECK(allocator.GetNumChunks() > 1);
+
+    const unsigned capacity = allocator.GetCapacity();
+    allocator.Reset();
+    CHECK(allocator.GetNumChunks() == 1);
+    CHECK(allocator.GetCapacity() == capacity);
+    CHECK(allocator.GetUsedSize() == 0);
+}
+
+TEST_CASE("WorkQueue frame allocator is reset on new frame")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+
+    LinearAllocator& allocator = workQueue->GetFrameAllocator();
+    allocator.Allocate(128);
+    CHECK(allocator.GetUsedSize() >= 128);
+
+    Tests::RunFrame(context, 0.0f);
+    CHECK(&workQueue->GetFrameAllocator() == &allocator);
+    CHECK(allocator.GetUsedSize() == 0);
+}
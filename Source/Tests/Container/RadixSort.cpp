@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Container/RadixSort.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/RenderPipeline/BatchCompositor.h>
+#include <Urho3D/RenderPipeline/PipelineBatchSortKey.h>
+
+namespace
+{
+
+ea::vector<PipelineBatchByState> CreateBatchesByState(unsigned count, unsigned seed)
+{
+    RandomEngine re(seed);
+    ea::vector<PipelineBatchByState> batches(count);
+    for (PipelineBatchByState& batch : batches)
+    {
+        // Emulate realistic scene with limited number of states and geometries
+        batch.primaryKey_ = (static_cast<unsigned long long>(re.GetUInt(4)) << 56)
+            | (static_cast<unsigned long long>(re.GetUInt(64)) << 40)
+            | (static_cast<unsigned long long>(re.GetUInt(256)) << 16)
+            | re.GetUInt(8);
+        batch.secondaryKey_ = static_cast<unsigned long long>(re.GetUInt(1024)) << 40;
+    }
+    return batches;
+}
+
+ea::vector<PipelineBatchBackToFront> CreateBatchesBackToFront(unsigned count, unsigned seed)
+{
+    RandomEngine re(seed);
+    ea::vector<PipelineBatchBackToFront> batches(count);
+    for (PipelineBatchBackToFront& batch : batches)
+    {
+        batch.renderOrder_ = static_cast<unsigned char>(re.GetUInt(4));
+        batch.distance_ = re.GetFloat(-10.0f, 1000.0f);
+    }
+    return batches;
+}
+
+template <class T>
+bool IsSameOrder(const ea::vector<T>& lhs, const ea::vector<T>& rhs)
+{
+    return lhs.size() == rhs.size() && ea::equal(lhs.begin(), lhs.end(), rhs.begin(),
+        [](const T& x, const T& y) { return !(x < y) && !(y < x); });
+}
+
+}
+
+TEST_CASE("RadixSort is stable and matches comparison sort")
+{
+    for (const unsigned count : {0u, 1u, 10u, 63u, 64u, 1000u, 10000u})
+    {
+        RandomEngine re(count);
+        ea::vector<ea::pair<unsigned, unsigned>> values(count);
+        for (unsigned i = 0; i < count; ++i)
+            values[i] = { re.GetUInt(100) * 0x01010101u, i };
+
+        ea::vector<ea::pair<unsigned, unsigned>> buffer;
+        RadixSort(values.begin(), values.end(), buffer, [](const auto& value) { return value.first; });
+
+        for (unsigned i = 1; i < count; ++i)
+        {
+            REQUIRE(values[i - 1].first <= values[i].first);
+            if (values[i - 1].first == values[i].first)
+                REQUIRE(values[i - 1].second < values[i].second);
+        }
+    }
+
+    ea::vector<float> distances{3.0f, -1.0f, 0.0f, 1e6f, -1e6f, 0.5f, -0.5f};
+    ea::vector<float> buffer;
+    RadixSort(distances.begin(), distances.end(), buffer, [](float value) { return FloatToRadixKey(value); });
+    REQUIRE(ea::is_sorted(distances.begin(), distances.end()));
+}
+
+TEST_CASE("Pipeline batches are sorted in the same order as with comparison sort")
+{
+    for (const unsigned count : {10u, 1000u, 100000u})
+    {
+        auto batchesByState = CreateBatchesByState(count, count);
+        auto expectedByState = batchesByState;
+        ea::sort(expectedByState.begin(), expectedByState.end());
+        BatchCompositor::SortBatches(batchesByState);
+        REQUIRE(IsSameOrder(batchesByState, expectedByState));
+
+        auto batchesBackToFront = CreateBatchesBackToFront(count, count);
+        auto expectedBackToFront = batchesBackToFront;
+        ea::sort(expectedBackToFront.begin(), expectedBackToFront.end());
+        BatchCompositor::SortBatches(batchesBackToFront);
+        REQUIRE(IsSameOrder(batchesBackToFront, expectedBackToFront));
+    }
+}
+
+TEST_CASE("Pipeline batch sorting benchmark", "[.][benchmark]")
+{
+    for (const unsigned count : {10000u, 100000u, 1000000u})
+    {
+        const auto sourceBatches = CreateBatchesByState(count, count);
+        auto batches = sourceBatches;
+
+        BENCHMARK(Format("ea::sort {} batches", count).c_str())
+        {
+            batches = sourceBatches;
+            ea::sort(batches.begin(), batches.end());
+            return batches.front().primaryKey_;
+        };
+
+        BENCHMARK(Format("RadixSort {} batches", count).c_str())
+        {
+            batches = sourceBatches;
+            BatchCompositor::SortBatches(batches);
+            return batches.front().primaryKey_;
+        };
+    }
+}
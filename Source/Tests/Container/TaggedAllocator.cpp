@@ -0,0 +1,44 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Container/TaggedAllocator.h>
+
+TEST_CASE("TaggedAllocator accounts allocated memory to the tag")
+{
+    const MemoryTagStats initialStats = GetMemoryTagStats(MemoryTag::Other);
+    {
+        TaggedVector<unsigned, MemoryTag::Other> values;
+        values.reserve(100);
+
+        const MemoryTagStats stats = GetMemoryTagStats(MemoryTag::Other);
+        CHECK(stats.bytes_ - initialStats.bytes_ >= static_cast<long long>(100 * sizeof(unsigned)));
+        CHECK(stats.numAllocations_ - initialStats.numAllocations_ == 1);
+        CHECK(stats.totalAllocations_ - initialStats.totalAllocations_ == 1);
+    }
+
+    const MemoryTagStats finalStats = GetMemoryTagStats(MemoryTag::Other);
+    CHECK(finalStats.bytes_ == initialStats.bytes_);
+    CHECK(finalStats.numAllocations_ == initialStats.numAllocations_);
+    CHECK(finalStats.totalAllocations_ - initialStats.totalAllocations_ == 1);
+}
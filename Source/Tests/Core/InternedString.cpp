@@ -0,0 +1,63 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/InternedString.h>
+#include <Urho3D/Scene/Node.h>
+
+TEST_CASE("InternedString deduplicates strings")
+{
+    const InternedString empty;
+    const InternedString first{"InternedStringTest"};
+    const InternedString second{ea::string{"InternedStringTest"}};
+    const InternedString other{"InternedStringTestOther"};
+
+    CHECK(empty.IsEmpty());
+    CHECK(empty == InternedString{""});
+    CHECK(empty.GetHash() == StringHash{""});
+
+    CHECK(first == second);
+    CHECK(first != other);
+    CHECK(&first.GetString() == &second.GetString());
+    CHECK(first.GetString() == "InternedStringTest");
+    CHECK(first.GetHash() == StringHash{"InternedStringTest"});
+}
+
+TEST_CASE("Nodes with equal names share interned name")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto nodeA = MakeShared<Node>(context);
+    auto nodeB = MakeShared<Node>(context);
+    nodeA->SetName("SharedNodeName");
+    nodeB->SetName("SharedNodeName");
+
+    CHECK(nodeA->GetName() == "SharedNodeName");
+    CHECK(nodeA->GetNameHash() == StringHash{"SharedNodeName"});
+    CHECK(&nodeA->GetName() == &nodeB->GetName());
+
+    nodeB->SetName("");
+    CHECK(nodeB->GetName().empty());
+    CHECK(nodeB->GetNameHash() == StringHash{});
+}
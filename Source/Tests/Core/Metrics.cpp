@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/Metrics.h>
+
+TEST_CASE("Metrics registry returns shared metrics by name")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto metrics = MakeShared<Metrics>(context);
+
+    const auto counter = metrics->GetCounter("test_events_total", "Test events");
+    counter->Increment();
+    counter->Increment(2);
+    CHECK(metrics->GetCounter("test_events_total") == counter);
+    CHECK(metrics->GetValue("test_events_total") == 3.0);
+
+    const auto gauge = metrics->GetGauge("test_level");
+    gauge->Set(5.0);
+    gauge->Add(-1.5);
+    CHECK(metrics->GetValue("test_level") == 3.5);
+
+    CHECK(metrics->GetGauge("test_events_total") == nullptr);
+    CHECK(metrics->GetMetricNames() == StringVector{"test_events_total", "test_level"});
+
+    metrics->RemoveMetric("test_level");
+    CHECK_FALSE(metrics->HasMetric("test_level"));
+    CHECK(metrics->GetValue("test_level") == 0.0);
+}
+
+TEST_CASE("Metrics are exported in Prometheus format")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto metrics = MakeShared<Metrics>(context);
+
+    metrics->GetCounter("test_loads_total", "Number of loads")->Increment(4);
+    const auto histogram = metrics->GetHistogram("test_time_seconds", {0.1, 1.0});
+    histogram->Observe(0.05);
+    histogram->Observe(0.1);
+    histogram->Observe(0.5);
+    histogram->Observe(2.0);
+
+    CHECK(metrics->GetHistogramCount("test_time_seconds") == 4);
+    CHECK(histogram->GetBucketCount(0) == 2);
+    CHECK(histogram->GetBucketCount(1) == 1);
+    CHECK(histogram->GetBucketCount(2) == 1);
+
+    const ea::string expected =
+        "# HELP test_loads_total Number of loads\n"
+        "# TYPE test_loads_total counter\n"
+        "test_loads_total 4\n"
+        "# TYPE test_time_seconds histogram\n"
+        "test_time_seconds_bucket{le=\"0.1\"} 2\n"
+        "test_time_seconds_bucket{le=\"1\"} 3\n"
+        "test_time_seconds_bucket{le=\"+Inf\"} 4\n"
+        "test_time_seconds_sum 2.65\n"
+        "test_time_seconds_count 4\n";
+    CHECK(metrics->ExportPrometheus() == expected);
+}
+
+TEST_CASE("Standalone metrics are created without Metrics subsystem")
+{
+    auto context = MakeShared<Context>();
+
+    const auto counter = GetMetricCounter(context, "test_standalone_total");
+    REQUIRE(counter);
+    counter->Increment();
+    CHECK(counter->GetValue() == 1);
+}
@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+namespace
+{
+
+bool IsStoredInline(const Variant& variant, const void* value)
+{
+    const auto begin = reinterpret_cast<const unsigned char*>(&variant);
+    const auto ptr = reinterpret_cast<const unsigned char*>(value);
+    return ptr >= begin && ptr < begin + sizeof(Variant);
+}
+
+}
+
+TEST_CASE("Variant stores matrices and short strings inline")
+{
+    const Matrix3 matrix3{1, 2, 3, 4, 5, 6, 7, 8, 9};
+    const Matrix3x4 matrix3x4{Vector3{1, 2, 3}, Quaternion{30.0f, Vector3::UP}, 2.0f};
+
+    Variant variant3{matrix3};
+    Variant variant3x4{matrix3x4};
+    Variant variantString{"short"};
+    CHECK(IsStoredInline(variant3, &variant3.GetMatrix3()));
+    CHECK(IsStoredInline(variant3x4, &variant3x4.GetMatrix3x4()));
+    CHECK(IsStoredInline(variantString, variantString.GetString().data()));
+
+    // Copy, move and comparison keep value semantics
+    Variant copy3x4 = variant3x4;
+    CHECK(copy3x4 == variant3x4);
+    CHECK(copy3x4.GetMatrix3x4().Equals(matrix3x4));
+
+    Variant moved3 = ea::move(variant3);
+    CHECK(moved3.GetMatrix3().Equals(matrix3));
+    CHECK(variant3.IsEmpty());
+
+    copy3x4 = matrix3;
+    CHECK(copy3x4.GetType() == VAR_MATRIX3);
+    CHECK(copy3x4 == moved3);
+    CHECK_FALSE(copy3x4.IsZero());
+    CHECK(Variant{Matrix3x4::IDENTITY}.IsZero());
+}
+
+TEST_CASE("Variant copy benchmark", "[.][benchmark]")
+{
+    const VariantVector matrices3x4(1000, Variant{Matrix3x4::IDENTITY});
+    const VariantVector matrices4(1000, Variant{Matrix4::IDENTITY});
+
+    BENCHMARK("Copy 1000 inline Matrix3x4")
+    {
+        VariantVector copy = matrices3x4;
+        return copy.size();
+    };
+
+    BENCHMARK("Copy 1000 heap Matrix4")
+    {
+        VariantVector copy = matrices4;
+        return copy.size();
+    };
+}
@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Core/WorkQueue.h>
+
+TEST_CASE("WorkQueue tasks are executed after their dependencies")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+
+    std::atomic<unsigned> counter{};
+    std::atomic<unsigned> firstValue{};
+    std::atomic<unsigned> secondValue{};
+    std::atomic<unsigned> joinValue{};
+
+    const auto first = workQueue->PostTask([&](unsigned) { firstValue = ++counter; });
+    const auto second = workQueue->PostContinuation(first, [&](unsigned) { secondValue = ++counter; });
+    const auto third = workQueue->PostTask([&](unsigned) { ++counter; });
+    const auto join = workQueue->PostTask([&](unsigned) { joinValue = ++counter; }, {second, third});
+
+    workQueue->WaitForTask(join);
+
+    CHECK(first->IsCompleted());
+    CHECK(second->IsCompleted());
+    CHECK(third->IsCompleted());
+    CHECK(join->IsCompleted());
+    CHECK(firstValue < secondValue);
+    CHECK(joinValue == 4);
+}
+
+TEST_CASE("WorkQueue tasks can post and wait for other tasks")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+
+    constexpr unsigned numTasks = 64;
+    std::atomic<unsigned> counter{};
+
+    ea::vector<SharedPtr<WorkTask>> tasks;
+    for (unsigned i = 0; i < numTasks; ++i)
+    {
+        tasks.push_back(workQueue->PostTask([&](unsigned)
+        {
+            const auto child = workQueue->PostTask([&](unsigned) { ++counter; });
+            workQueue->WaitForTask(child);
+            ++counter;
+        }));
+    }
+
+    workQueue->WaitForTasks(tasks);
+
+    CHECK(counter == numTasks * 2);
+}
+
+TEST_CASE("WorkQueue ForEachParallel is processed when nested")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto workQueue = context->GetSubsystem<WorkQueue>();
+
+    constexpr unsigned outerSize = 16;
+    constexpr unsigned innerSize = 100;
+    ea::vector<std::atomic<unsigned>> sums(outerSize);
+
+    ForEachParallel(workQueue, 1, outerSize, [&](unsigned outerBegin, unsigned outerEnd)
+    {
+        for (unsigned outerIndex = outerBegin; outerIndex < outerEnd; ++outerIndex)
+        {
+            ForEachParallel(workQueue, 8, innerSize, [&, outerIndex](unsigned innerBegin, unsigned innerEnd)
+            {
+                for (unsigned innerIndex = innerBegin; innerIndex < innerEnd; ++innerIndex)
+                    sums[outerIndex] += innerIndex;
+            });
+        }
+    });
+
+    for (unsigned outerIndex = 0; outerIndex < outerSize; ++outerIndex)
+        CHECK(sums[outerIndex] == innerSize * (innerSize - 1) / 2);
+}
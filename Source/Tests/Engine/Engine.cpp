@@ -22,7 +22,10 @@
 
 #include "../CommonUtils.h"
 
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Engine/Engine.h>
 #include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Scene/Node.h>
 
 TEST_CASE("Engine started multiple times in same process")
 {
@@ -42,3 +45,30 @@ TEST_CASE("Random engine is stable for given seed")
     REQUIRE(re.GetUInt() == 43785880);
     REQUIRE(re.GetUInt() == 464353102);
 };
+
+TEST_CASE("Typed frame update signals are invoked before events")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto engine = context->GetSubsystem<Engine>();
+    auto receiver = MakeShared<Node>(context);
+
+    ea::vector<ea::string> calls;
+    engine->OnUpdate.Subscribe(receiver.Get(), [&](const FrameUpdateEventArgs& args)
+    {
+        CHECK(args.timeStep_ == 0.25f);
+        calls.push_back("OnUpdate");
+    });
+    engine->OnPostRenderUpdate.Subscribe(receiver.Get(), [&](const FrameUpdateEventArgs&) { calls.push_back("OnPostRenderUpdate"); });
+    receiver->SubscribeToEvent(E_UPDATE, [&](StringHash, VariantMap&) { calls.push_back("E_UPDATE"); });
+
+    Tests::RunFrame(context, 0.25f);
+    REQUIRE(calls.size() == 3);
+    CHECK(calls[0] == "OnUpdate");
+    CHECK(calls[1] == "E_UPDATE");
+    CHECK(calls[2] == "OnPostRenderUpdate");
+
+    // Expired receivers are unsubscribed
+    receiver = nullptr;
+    Tests::RunFrame(context, 0.25f);
+    CHECK(calls.size() == 3);
+}
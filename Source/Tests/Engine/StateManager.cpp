@@ -73,6 +73,22 @@ public:
     }
 };
 
+class PreloadedState : public ApplicationState
+{
+    URHO3D_OBJECT(PreloadedState, ApplicationState);
+public:
+    PreloadedState(Context* context)
+        : BaseClassName(context)
+    {
+    }
+
+    void Preload(StringVariantMap& bundle) override { ++numPreloads_; }
+    bool IsReadyToActivate() const override { return ready_; }
+
+    unsigned numPreloads_{};
+    bool ready_{};
+};
+
 template <typename T, typename AllocComp, typename AllocMatch>
 struct EaEqualsMatcher final : Catch::Matchers::MatcherBase<ea::vector<T, AllocMatch>>
 {
@@ -246,3 +262,34 @@ TEST_CASE("StateManager: Last state is unknown")
                 EventMatcher(E_LEAVINGAPPLICATIONSTATE, State1::GetTypeStatic(), unknownState),
                 EventMatcher(E_STATETRANSITIONCOMPLETE, State1::GetTypeStatic(), StringHash::Empty)}));
 }
+
+TEST_CASE("StateManager: Wait for next state to preload")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto guard = Tests::MakeScopedReflection<State1, PreloadedState>(context);
+
+    auto* stateManager = context->GetSubsystem<StateManager>();
+    stateManager->Reset();
+
+    stateManager->EnqueueState(State1::GetTypeStatic());
+    Tests::RunFrame(context, 0.1f);
+    REQUIRE(stateManager->GetState());
+    REQUIRE(stateManager->GetState()->GetType() == State1::GetTypeStatic());
+
+    auto nextState = MakeShared<PreloadedState>(context);
+    stateManager->EnqueueState(nextState);
+    CHECK(nextState->numPreloads_ == 1);
+
+    Tests::RunFrame(context, 0.1f);
+    Tests::RunFrame(context, 0.1f);
+    CHECK(stateManager->GetState()->GetType() == State1::GetTypeStatic());
+    CHECK(!nextState->IsActive());
+
+    nextState->ready_ = true;
+    Tests::RunFrame(context, 0.1f);
+    CHECK(stateManager->GetState() == nextState);
+    CHECK(nextState->IsActive());
+    CHECK(nextState->numPreloads_ == 1);
+
+    stateManager->Reset();
+}
@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Animation.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+
+namespace
+{
+
+AnimationTrack CreateTestTrack(unsigned numKeyFrames)
+{
+    AnimationTrack track;
+    track.channelMask_ = CHANNEL_POSITION | CHANNEL_ROTATION | CHANNEL_SCALE;
+    for (unsigned i = 0; i < numKeyFrames; ++i)
+    {
+        const float time = i / 30.0f;
+        const Vector3 position{Sin(time * 90.0f), time, 2.0f};
+        const Quaternion rotation{Sin(time * 180.0f) * 60.0f, Vector3::UP};
+        track.keyFrames_.emplace_back(time, position, rotation, Vector3::ONE);
+    }
+    return track;
+}
+
+}
+
+TEST_CASE("Compressed animation track is sampled within error bounds")
+{
+    const AnimationTrack track = CreateTestTrack(61);
+
+    AnimationTrack compressedTrack = track;
+    compressedTrack.Compress(AnimationCompressionSettings{});
+
+    REQUIRE(compressedTrack.isCompressed_);
+    CHECK(compressedTrack.keyFrames_.empty());
+    CHECK(compressedTrack.compressed_.scale_.GetNumKeys() == 1);
+    CHECK(compressedTrack.compressed_.position_.GetNumKeys() < 61);
+    CHECK(compressedTrack.GetMemoryUse() < track.GetMemoryUse());
+
+    for (unsigned i = 0; i <= 200; ++i)
+    {
+        const float time = i / 100.0f;
+        unsigned frameIndex{};
+        Transform expected;
+        Transform actual;
+        track.Sample(time, 2.0f, false, frameIndex, expected);
+        compressedTrack.Sample(time, 2.0f, false, frameIndex, actual);
+
+        CHECK(expected.position_.Equals(actual.position_, 0.002f));
+        CHECK(expected.rotation_.Equals(actual.rotation_, 0.002f));
+        CHECK(expected.scale_.Equals(actual.scale_, 0.001f));
+    }
+
+    compressedTrack.Decompress();
+    REQUIRE_FALSE(compressedTrack.isCompressed_);
+    CHECK(compressedTrack.keyFrames_.front().time_ == 0.0f);
+    CHECK(compressedTrack.keyFrames_.back().time_ == Catch::Approx(2.0f));
+}
+
+TEST_CASE("Compressed animation is serialized")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto animation = MakeShared<Animation>(context);
+    animation->SetLength(2.0f);
+    animation->SetTracks({CreateTestTrack(61)});
+    animation->GetTrack(0u)->name_ = "Bone";
+    animation->Compress(AnimationCompressionSettings{});
+
+    VectorBuffer buffer;
+    REQUIRE(animation->Save(buffer));
+
+    MemoryBuffer source{buffer.GetBuffer()};
+    auto loadedAnimation = MakeShared<Animation>(context);
+    REQUIRE(loadedAnimation->Load(source));
+
+    const AnimationTrack* sourceTrack = animation->GetTrack(0u);
+    const AnimationTrack* loadedTrack = loadedAnimation->GetTrack(0u);
+    REQUIRE(loadedTrack);
+    REQUIRE(loadedTrack->isCompressed_);
+    CHECK(loadedTrack->compressed_.position_.times_ == sourceTrack->compressed_.position_.times_);
+    CHECK(loadedTrack->compressed_.rotation_.values_ == sourceTrack->compressed_.rotation_.values_);
+    CHECK(loadedTrack->GetLastValue().position_.Equals(sourceTrack->GetLastValue().position_));
+}
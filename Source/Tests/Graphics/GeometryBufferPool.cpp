@@ -0,0 +1,124 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Geometry.h>
+#include <Urho3D/Graphics/GeometryBufferPool.h>
+#include <Urho3D/Graphics/IndexBuffer.h>
+#include <Urho3D/Graphics/VertexBuffer.h>
+
+TEST_CASE("GeometryBufferPool reuses released ranges")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto pool = MakeShared<GeometryBufferPool>(context);
+    pool->SetVertexBufferSize(100);
+    pool->SetIndexBufferSize(300);
+
+    const ea::vector<VertexElement> elements{VertexElement{TYPE_VECTOR3, SEM_POSITION}};
+    const GeometryBufferPoolRange range1 = pool->Allocate(elements, 40, false, 120);
+    const GeometryBufferPoolRange range2 = pool->Allocate(elements, 40, false, 120);
+    REQUIRE(range1.IsValid());
+    REQUIRE(range2.IsValid());
+    CHECK(range1.vertexBuffer_ == range2.vertexBuffer_);
+    CHECK(range1.indexBuffer_ == range2.indexBuffer_);
+    CHECK(range2.vertexStart_ == 40);
+    CHECK(range2.indexStart_ == 120);
+
+    // Doesn't fit into the first buffer
+    const GeometryBufferPoolRange range3 = pool->Allocate(elements, 40, false, 120);
+    REQUIRE(range3.IsValid());
+    CHECK(range3.vertexBuffer_ != range1.vertexBuffer_);
+    CHECK(pool->GetNumVertexBuffers() == 2);
+
+    // Adjacent free ranges are merged
+    pool->Release(range1);
+    pool->Release(range2);
+    const GeometryBufferPoolRange range4 = pool->Allocate(elements, 80, false, 240);
+    REQUIRE(range4.IsValid());
+    CHECK(range4.vertexBuffer_ == range1.vertexBuffer_);
+    CHECK(range4.vertexStart_ == 0);
+    CHECK(pool->GetNumVertexBuffers() == 2);
+
+    // Different formats use different buffers
+    const ea::vector<VertexElement> otherElements{
+        VertexElement{TYPE_VECTOR3, SEM_POSITION}, VertexElement{TYPE_VECTOR3, SEM_NORMAL}};
+    const GeometryBufferPoolRange range5 = pool->Allocate(otherElements, 10, true, 30);
+    REQUIRE(range5.IsValid());
+    CHECK(range5.vertexBuffer_ != range1.vertexBuffer_);
+    CHECK(range5.indexBuffer_->GetIndexSize() == sizeof(unsigned));
+    CHECK(pool->GetNumAllocations() == 3);
+}
+
+TEST_CASE("Geometry is moved to GeometryBufferPool with relative indices")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto pool = MakeShared<GeometryBufferPool>(context);
+
+    const ea::vector<VertexElement> elements{VertexElement{TYPE_VECTOR3, SEM_POSITION}};
+    const ea::vector<Vector3> vertices{Vector3::ZERO, Vector3::ONE, Vector3::LEFT, Vector3::UP, Vector3::RIGHT};
+    const ea::vector<unsigned short> indices{0, 1, 2, 2, 3, 4};
+
+    auto vertexBuffer = MakeShared<VertexBuffer>(context);
+    vertexBuffer->SetShadowed(true);
+    vertexBuffer->SetSize(vertices.size(), elements);
+    vertexBuffer->SetData(vertices.data());
+
+    auto indexBuffer = MakeShared<IndexBuffer>(context);
+    indexBuffer->SetShadowed(true);
+    indexBuffer->SetSize(indices.size(), false);
+    indexBuffer->SetData(indices.data());
+
+    // Occupy beginning of the pool so the geometry has non-zero base vertex
+    const GeometryBufferPoolRange otherRange = pool->Allocate(elements, 7, false, 9);
+    REQUIRE(otherRange.IsValid());
+
+    auto geometry = MakeShared<Geometry>(context);
+    geometry->SetVertexBuffer(0, vertexBuffer);
+    geometry->SetIndexBuffer(indexBuffer);
+    geometry->SetDrawRange(TRIANGLE_LIST, 3, 3);
+    REQUIRE(geometry->GetVertexStart() == 2);
+    REQUIRE(geometry->GetVertexCount() == 3);
+
+    REQUIRE(geometry->MoveToBufferPool(pool));
+    CHECK(geometry->IsPooled());
+    CHECK(geometry->GetDrawIndexBuffer() == otherRange.indexBuffer_);
+    CHECK(geometry->GetDrawIndexStart() == 9);
+    CHECK(geometry->GetDrawBaseVertexIndex() == 7);
+
+    // Source data is still available for CPU-side operations
+    CHECK(geometry->GetIndexBuffer() == indexBuffer);
+    CHECK(geometry->GetIndexStart() == 3);
+
+    const auto pooledVertices = reinterpret_cast<const Vector3*>(otherRange.vertexBuffer_->GetShadowData());
+    const auto pooledIndices = reinterpret_cast<const unsigned short*>(otherRange.indexBuffer_->GetShadowData());
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        CHECK(pooledIndices[9 + i] == indices[3 + i] - 2);
+        CHECK(pooledVertices[7 + pooledIndices[9 + i]] == vertices[indices[3 + i]]);
+    }
+
+    // Range is returned when geometry changes
+    geometry->SetDrawRange(TRIANGLE_LIST, 0, 3);
+    CHECK_FALSE(geometry->IsPooled());
+    CHECK(pool->GetNumAllocations() == 1);
+}
@@ -0,0 +1,228 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/GeometryOptimizer.h>
+#include <Urho3D/Graphics/VertexBuffer.h>
+
+#include <EASTL/sort.h>
+
+namespace
+{
+
+/// Create grid in XZ plane with given number of cells per side and Y of vertices produced by the function.
+template <class T>
+GeometryLODView CreateGridGeometry(unsigned size, const T& getHeight)
+{
+    GeometryLODView lodView;
+    lodView.primitiveType_ = TRIANGLE_LIST;
+    for (unsigned z = 0; z <= size; ++z)
+    {
+        for (unsigned x = 0; x <= size; ++x)
+        {
+            ModelVertex vertex;
+            vertex.SetPosition(Vector3{static_cast<float>(x), getHeight(x, z), static_cast<float>(z)});
+            lodView.vertices_.push_back(vertex);
+        }
+    }
+
+    const auto getIndex = [&](unsigned x, unsigned z) { return z * (size + 1) + x; };
+    for (unsigned z = 0; z < size; ++z)
+    {
+        for (unsigned x = 0; x < size; ++x)
+        {
+            lodView.indices_.insert(lodView.indices_.end(), {getIndex(x, z), getIndex(x, z + 1), getIndex(x + 1, z)});
+            lodView.indices_.insert(lodView.indices_.end(), {getIndex(x + 1, z), getIndex(x, z + 1), getIndex(x + 1, z + 1)});
+        }
+    }
+    return lodView;
+}
+
+GeometryLODView CreateFlatGrid(unsigned size)
+{
+    return CreateGridGeometry(size, [](unsigned x, unsigned z) { return 0.0f; });
+}
+
+ea::vector<ea::array<unsigned, 3>> GetSortedTriangles(const GeometryLODView& lodView)
+{
+    ea::vector<ea::array<unsigned, 3>> triangles;
+    for (unsigned i = 0; i < lodView.indices_.size(); i += 3)
+    {
+        ea::array<unsigned, 3> triangle{lodView.indices_[i], lodView.indices_[i + 1], lodView.indices_[i + 2]};
+        ea::rotate(triangle.begin(), ea::min_element(triangle.begin(), triangle.end()), triangle.end());
+        triangles.push_back(triangle);
+    }
+    ea::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+}
+
+TEST_CASE("Flat geometry is simplified without moving borders")
+{
+    const GeometryLODView sourceLod = CreateFlatGrid(16);
+    const GeometryLODView lod = SimplifyGeometry(sourceLod, 128);
+
+    REQUIRE(lod.GetNumPrimitives() <= 128);
+    REQUIRE(lod.GetNumPrimitives() > 0);
+    REQUIRE(lod.vertices_.size() < sourceLod.vertices_.size());
+
+    BoundingBox boundingBox;
+    for (const ModelVertex& vertex : lod.vertices_)
+        boundingBox.Merge(vertex.GetPosition());
+    REQUIRE(boundingBox.min_.Equals(Vector3::ZERO));
+    REQUIRE(boundingBox.max_.Equals(Vector3{16.0f, 0.0f, 16.0f}));
+
+    // Simplified grid still covers the whole area and faces up
+    float area = 0.0f;
+    for (unsigned i = 0; i < lod.indices_.size(); i += 3)
+    {
+        const Vector3 p0 = lod.vertices_[lod.indices_[i]].GetPosition();
+        const Vector3 p1 = lod.vertices_[lod.indices_[i + 1]].GetPosition();
+        const Vector3 p2 = lod.vertices_[lod.indices_[i + 2]].GetPosition();
+        const Vector3 normal = (p1 - p0).CrossProduct(p2 - p0);
+        REQUIRE(normal.y_ > 0.0f);
+        area += normal.Length() * 0.5f;
+    }
+    REQUIRE(area == Catch::Approx(256.0f));
+}
+
+TEST_CASE("Geometry simplification is limited by error")
+{
+    const GeometryLODView sourceLod = CreateGridGeometry(16,
+        [](unsigned x, unsigned z) { return ((x * x * 7 + z * z * 13 + x * z * 3) % 11) * 0.1f; });
+
+    const GeometryLODView strictLod = SimplifyGeometry(sourceLod, 0, 0.001f);
+    const GeometryLODView looseLod = SimplifyGeometry(sourceLod, 0, 1.0f);
+    REQUIRE(strictLod.GetNumPrimitives() > 0);
+    REQUIRE(looseLod.GetNumPrimitives() > 0);
+    REQUIRE(strictLod.GetNumPrimitives() <= sourceLod.GetNumPrimitives());
+    REQUIRE(looseLod.GetNumPrimitives() < strictLod.GetNumPrimitives());
+}
+
+TEST_CASE("Vertex cache and overdraw optimizations preserve triangles")
+{
+    GeometryLODView lod = CreateFlatGrid(32);
+    const auto sourceTriangles = GetSortedTriangles(lod);
+
+    // Shuffle triangles to make the source order cache unfriendly
+    ea::vector<unsigned> shuffledIndices;
+    const unsigned numTriangles = lod.GetNumPrimitives();
+    for (unsigned i = 0; i < numTriangles; ++i)
+    {
+        const unsigned triangleIndex = (i * 97) % numTriangles;
+        shuffledIndices.insert(shuffledIndices.end(),
+            lod.indices_.begin() + triangleIndex * 3, lod.indices_.begin() + triangleIndex * 3 + 3);
+    }
+    lod.indices_ = shuffledIndices;
+    const float sourceCacheMissRatio = CalculateAverageCacheMissRatio(lod);
+
+    OptimizeVertexCache(lod);
+    const float cacheMissRatio = CalculateAverageCacheMissRatio(lod);
+    REQUIRE(GetSortedTriangles(lod) == sourceTriangles);
+    REQUIRE(cacheMissRatio < sourceCacheMissRatio);
+    REQUIRE(cacheMissRatio < 0.8f);
+
+    OptimizeOverdraw(lod);
+    REQUIRE(GetSortedTriangles(lod) == sourceTriangles);
+    REQUIRE(CalculateAverageCacheMissRatio(lod) < 0.9f);
+}
+
+TEST_CASE("Duplicate vertices are removed and vertices are ordered by first use")
+{
+    GeometryLODView lod;
+    lod.primitiveType_ = TRIANGLE_LIST;
+    for (const Vector3& position : {Vector3::ZERO, Vector3::RIGHT, Vector3::FORWARD, Vector3::FORWARD, Vector3::RIGHT})
+    {
+        ModelVertex vertex;
+        vertex.SetPosition(position);
+        lod.vertices_.push_back(vertex);
+    }
+    lod.vertices_[4].uv_[0] = Vector4{1.0f, 0.0f, 0.0f, 0.0f};
+    lod.indices_ = {4, 0, 2, 0, 1, 3};
+
+    RemoveDuplicateVertices(lod);
+
+    // Vertex #3 is equal to vertex #2, vertex #4 differs from vertex #1 by UV
+    REQUIRE(lod.vertices_.size() == 4);
+    REQUIRE(lod.indices_ == ea::vector<unsigned>{0, 1, 2, 1, 3, 2});
+    REQUIRE(lod.vertices_[0].GetPosition() == Vector3::RIGHT);
+    REQUIRE(lod.vertices_[0].uv_[0].x_ == 1.0f);
+    REQUIRE(lod.vertices_[1].GetPosition() == Vector3::ZERO);
+    REQUIRE(lod.vertices_[2].GetPosition() == Vector3::FORWARD);
+    REQUIRE(lod.vertices_[3].GetPosition() == Vector3::RIGHT);
+    REQUIRE(lod.vertices_[3].uv_[0].x_ == 0.0f);
+}
+
+TEST_CASE("Duplicate vertices with positive and negative zero coordinates are removed")
+{
+    GeometryLODView lod;
+    lod.primitiveType_ = TRIANGLE_LIST;
+    for (const Vector3& position : {Vector3::ZERO, Vector3::RIGHT, Vector3::FORWARD, Vector3{-0.0f, 0.0f, -0.0f}})
+    {
+        ModelVertex vertex;
+        vertex.SetPosition(position);
+        lod.vertices_.push_back(vertex);
+    }
+    lod.indices_ = {0, 1, 2, 3, 2, 1};
+
+    RemoveDuplicateVertices(lod);
+
+    REQUIRE(lod.vertices_.size() == 3);
+    REQUIRE(lod.indices_ == ea::vector<unsigned>{0, 1, 2, 0, 2, 1});
+}
+
+TEST_CASE("Compact vertex elements are packed and unpacked")
+{
+    const Vector3 normals[] = {
+        Vector3::UP, Vector3::DOWN, Vector3::LEFT, Vector3::BACK,
+        Vector3{1.0f, -2.0f, 3.0f}.Normalized(), Vector3{-0.3f, 0.5f, -0.8f}.Normalized()};
+
+    for (const Vector3& normal : normals)
+    {
+        const VertexElement normalElement{TYPE_SHORT2_NORM, SEM_NORMAL};
+        const Vector4 source = normal.ToVector4();
+        unsigned char packed[4]{};
+        Vector4 unpacked;
+        VertexBuffer::PackVertexData(&source, sizeof(Vector4), packed, sizeof(packed), normalElement, 0, 1);
+        VertexBuffer::UnpackVertexData(packed, sizeof(packed), normalElement, 0, 1, &unpacked, sizeof(Vector4));
+        CHECK(unpacked.ToVector3().Equals(normal, 0.001f));
+        CHECK(unpacked.w_ == 0.0f);
+
+        const VertexElement tangentElement{TYPE_UINT_10_10_10_2_NORM, SEM_TANGENT};
+        const Vector4 tangent{normal, -1.0f};
+        VertexBuffer::PackVertexData(&tangent, sizeof(Vector4), packed, sizeof(packed), tangentElement, 0, 1);
+        VertexBuffer::UnpackVertexData(packed, sizeof(packed), tangentElement, 0, 1, &unpacked, sizeof(Vector4));
+        CHECK(unpacked.ToVector3().Equals(normal, 0.002f));
+        CHECK(unpacked.w_ == -1.0f);
+    }
+
+    const VertexElement uvElement{TYPE_HALF2, SEM_TEXCOORD};
+    const Vector4 uv{0.25f, 1.5f, 0.0f, 0.0f};
+    unsigned char packed[4]{};
+    Vector4 unpacked;
+    VertexBuffer::PackVertexData(&uv, sizeof(Vector4), packed, sizeof(packed), uvElement, 0, 1);
+    VertexBuffer::UnpackVertexData(packed, sizeof(packed), uvElement, 0, 1, &unpacked, sizeof(Vector4));
+    CHECK(unpacked == uv);
+}
@@ -0,0 +1,53 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/RenderPipeline/HiZOcclusionCuller.h>
+#include <Urho3D/Scene/Scene.h>
+
+#if defined(URHO3D_COMPUTE)
+
+TEST_CASE("Hi-Z texture coordinates are flipped once for flipped camera")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    auto camera = scene->CreateChild("Camera")->CreateComponent<Camera>();
+
+    // Point in the upper half of the screen
+    const Vector3 position{1.0f, 2.0f, 10.0f};
+    const Vector2 uv = HiZOcclusionCuller::WorldToUV(camera, position);
+#ifdef URHO3D_OPENGL
+    CHECK(uv.y_ > 0.5f);
+#else
+    CHECK(uv.y_ < 0.5f);
+#endif
+
+    // Flipped camera renders upside down, so the point is found in the mirrored texel row
+    camera->SetFlipVertical(true);
+    const Vector2 flippedUV = HiZOcclusionCuller::WorldToUV(camera, position);
+    CHECK(flippedUV.x_ == Catch::Approx(uv.x_));
+    CHECK(flippedUV.y_ == Catch::Approx(1.0f - uv.y_));
+}
+
+#endif
@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Camera.h>
+#include <Urho3D/Graphics/Geometry.h>
+#include <Urho3D/Graphics/IndexBuffer.h>
+#include <Urho3D/Graphics/InstancedStaticModel.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/VertexBuffer.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+SharedPtr<Model> CreateModelWithTwoLods(Context* context)
+{
+    auto model = MakeShared<Model>(context);
+    auto vb = MakeShared<VertexBuffer>(context);
+    model->SetVertexBuffers({vb}, {}, {});
+    auto ib = MakeShared<IndexBuffer>(context);
+    ib->SetSize(6, false);
+    REQUIRE(model->SetIndexBuffers({ib}));
+
+    model->SetNumGeometries(1);
+    REQUIRE(model->SetNumGeometryLodLevels(0, 2));
+    for (unsigned level = 0; level < 2; ++level)
+    {
+        auto geometry = MakeShared<Geometry>(context);
+        REQUIRE(geometry->SetVertexBuffer(0, vb));
+        geometry->SetIndexBuffer(ib);
+        REQUIRE(geometry->SetDrawRange(TRIANGLE_LIST, 0, level == 0 ? 6 : 3));
+        geometry->SetLodDistance(level == 0 ? 0.0f : 50.0f);
+        REQUIRE(model->SetGeometry(0, level, geometry));
+    }
+    model->SetBoundingBox(BoundingBox(-Vector3::ONE * 0.5f, Vector3::ONE * 0.5f));
+    return model;
+}
+
+}
+
+TEST_CASE("InstancedStaticModel culls instances and selects LOD per instance")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+
+    auto camera = scene->CreateChild()->CreateComponent<Camera>();
+    camera->SetFarClip(1000.0f);
+
+    auto instancedModel = scene->CreateChild()->CreateComponent<InstancedStaticModel>();
+    instancedModel->SetModel(CreateModelWithTwoLods(context));
+    instancedModel->SetInstances({
+        Matrix3x4{Vector3{0.0f, 0.0f, 10.0f}, Quaternion::IDENTITY, 1.0f},
+        Matrix3x4{Vector3{0.0f, 0.0f, 100.0f}, Quaternion::IDENTITY, 1.0f},
+        Matrix3x4{Vector3{100.0f, 0.0f, 10.0f}, Quaternion::IDENTITY, 1.0f},
+    });
+
+    // One batch per LOD level, materials are exposed per geometry only
+    const auto& batches = instancedModel->GetBatches();
+    REQUIRE(batches.size() == 2);
+    REQUIRE(instancedModel->GetMaterialsAttr().names_.size() == 1);
+
+    FrameInfo frameInfo;
+    frameInfo.camera_ = camera;
+    instancedModel->UpdateBatches(frameInfo);
+
+    CHECK(instancedModel->GetNumVisibleInstances() == 2);
+    REQUIRE(batches[0].numWorldTransforms_ == 1);
+    CHECK(batches[0].worldTransform_[0].Translation() == Vector3{0.0f, 0.0f, 10.0f});
+    REQUIRE(batches[1].numWorldTransforms_ == 1);
+    CHECK(batches[1].worldTransform_[0].Translation() == Vector3{0.0f, 0.0f, 100.0f});
+
+    // Instances beyond draw distance are skipped
+    instancedModel->SetInstanceDrawDistance(50.0f);
+    instancedModel->UpdateBatches(frameInfo);
+
+    CHECK(instancedModel->GetNumVisibleInstances() == 1);
+    CHECK(batches[0].numWorldTransforms_ == 1);
+    CHECK(batches[1].numWorldTransforms_ == 0);
+
+    // Instances follow the node
+    instancedModel->GetNode()->SetPosition(Vector3{0.0f, 0.0f, 5.0f});
+    instancedModel->UpdateBatches(frameInfo);
+
+    REQUIRE(batches[0].numWorldTransforms_ == 1);
+    CHECK(batches[0].worldTransform_[0].Translation() == Vector3{0.0f, 0.0f, 15.0f});
+}
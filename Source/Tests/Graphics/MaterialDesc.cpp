@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/MaterialDesc.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Resource/XMLFile.h>
+
+TEST_CASE("Material description is preserved in binary format")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const ea::string materialXml = R"(<material>
+        <shader psdefines="ALPHAMASK" />
+        <technique name="Techniques/LitOpaque.xml" quality="1" loddistance="10" />
+        <texture unit="diffuse" name="Textures/Diffuse.png" />
+        <texture unit="normal" name="Textures/Normal.png" />
+        <parameter name="MatDiffColor" value="1 0.5 0.25 1" />
+        <parameter name="Roughness" value="0.5" />
+        <parameter name="CustomInt" type="Int" value="3" />
+        <cull value="none" />
+        <depthbias constant="0.001" slopescaled="1" />
+        <renderorder value="100" />
+        <occlusion enable="false" />
+    </material>)";
+
+    auto xmlFile = MakeShared<XMLFile>(context);
+    REQUIRE(xmlFile->FromString(materialXml));
+
+    MaterialDesc sourceDesc;
+    REQUIRE(sourceDesc.LoadXML(context, xmlFile->GetRoot()));
+
+    VectorBuffer buffer;
+    REQUIRE(sourceDesc.SaveBinary(context, buffer));
+
+    MemoryBuffer readBuffer{buffer.GetBuffer()};
+    MaterialDesc desc;
+    REQUIRE(desc.Load(context, readBuffer));
+
+    CHECK(desc.pixelShaderDefines_ == "ALPHAMASK");
+    REQUIRE(desc.techniques_.size() == 1);
+    CHECK(desc.techniques_[0].name_ == "Techniques/LitOpaque.xml");
+    CHECK(desc.techniques_[0].qualityLevel_ == QUALITY_MEDIUM);
+    CHECK(desc.techniques_[0].lodDistance_ == 10.0f);
+
+    REQUIRE(desc.textures_.size() == 2);
+    CHECK(desc.textures_[0].unit_ == TU_DIFFUSE);
+    CHECK(desc.textures_[1].unit_ == TU_NORMAL);
+    CHECK(desc.textures_[1].name_ == "Textures/Normal.png");
+
+    REQUIRE(desc.shaderParameters_.size() == 3);
+    CHECK(desc.shaderParameters_[0].value_ == Variant(Vector4(1.0f, 0.5f, 0.25f, 1.0f)));
+    CHECK(desc.shaderParameters_[1].value_ == Variant(0.5f));
+    CHECK(desc.shaderParameters_[2].value_ == Variant(3));
+
+    CHECK(desc.cullMode_ == CULL_NONE);
+    CHECK(desc.shadowCullMode_ == CULL_CCW);
+    CHECK(desc.depthBias_.constantBias_ == 0.001f);
+    CHECK(desc.depthBias_.slopeScaledBias_ == 1.0f);
+    CHECK(desc.renderOrder_ == 100);
+    CHECK(desc.occlusion_ == false);
+}
@@ -0,0 +1,130 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Meshlet.h>
+#include <Urho3D/Graphics/ModelView.h>
+#include <Urho3D/Math/Frustum.h>
+
+#include <EASTL/sort.h>
+
+namespace
+{
+
+GeometryLODView CreateGridGeometry(unsigned size)
+{
+    GeometryLODView lodView;
+    lodView.primitiveType_ = TRIANGLE_LIST;
+    for (unsigned z = 0; z <= size; ++z)
+    {
+        for (unsigned x = 0; x <= size; ++x)
+        {
+            ModelVertex vertex;
+            vertex.SetPosition(Vector3{static_cast<float>(x), 0.0f, static_cast<float>(z)});
+            lodView.vertices_.push_back(vertex);
+        }
+    }
+
+    const auto getIndex = [&](unsigned x, unsigned z) { return z * (size + 1) + x; };
+    for (unsigned z = 0; z < size; ++z)
+    {
+        for (unsigned x = 0; x < size; ++x)
+        {
+            lodView.indices_.insert(lodView.indices_.end(), {getIndex(x, z), getIndex(x, z + 1), getIndex(x + 1, z)});
+            lodView.indices_.insert(lodView.indices_.end(), {getIndex(x + 1, z), getIndex(x, z + 1), getIndex(x + 1, z + 1)});
+        }
+    }
+    return lodView;
+}
+
+ea::vector<ea::array<unsigned, 3>> GetSortedTriangles(const GeometryLODView& lodView)
+{
+    ea::vector<ea::array<unsigned, 3>> triangles;
+    for (unsigned i = 0; i < lodView.indices_.size(); i += 3)
+    {
+        ea::array<unsigned, 3> triangle{lodView.indices_[i], lodView.indices_[i + 1], lodView.indices_[i + 2]};
+        ea::rotate(triangle.begin(), ea::min_element(triangle.begin(), triangle.end()), triangle.end());
+        triangles.push_back(triangle);
+    }
+    ea::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+}
+
+TEST_CASE("Meshlets are built from spatially coherent triangles")
+{
+    GeometryLODView lodView = CreateGridGeometry(16);
+    const auto sourceTriangles = GetSortedTriangles(lodView);
+
+    const auto meshlets = BuildMeshlets(lodView, 32);
+    REQUIRE(meshlets.size() == 16);
+    REQUIRE(GetSortedTriangles(lodView) == sourceTriangles);
+
+    for (unsigned i = 0; i < meshlets.size(); ++i)
+    {
+        const Meshlet& meshlet = meshlets[i];
+        REQUIRE(meshlet.indexStart_ == i * 32 * 3);
+        REQUIRE(meshlet.indexCount_ == 32 * 3);
+
+        // 32 triangles cover 16 grid cells, compact meshlet shouldn't span much more than 4x4 cells
+        const Vector3 size = meshlet.boundingBox_.Size();
+        REQUIRE(size.x_ * size.z_ <= 36.0f);
+
+        REQUIRE(meshlet.coneAxis_.Equals(Vector3::UP));
+        REQUIRE(meshlet.coneCutoff_ == Catch::Approx(0.0f).margin(M_LARGE_EPSILON));
+        REQUIRE(meshlet.IsFrontFacing(Vector3{8.0f, 10.0f, 8.0f}));
+        REQUIRE_FALSE(meshlet.IsFrontFacing(Vector3{8.0f, -10.0f, 8.0f}));
+    }
+}
+
+TEST_CASE("Meshlets are culled by frustum and normal cone")
+{
+    GeometryLODView lodView = CreateGridGeometry(16);
+    const auto meshlets = BuildMeshlets(lodView, 32);
+
+    Frustum frustum;
+    frustum.Define(BoundingBox{Vector3{-1.0f, -1.0f, -1.0f}, Vector3{17.0f, 1.0f, 17.0f}}, Matrix3x4::IDENTITY);
+
+    ea::vector<IndirectDrawIndexedArgs> drawArgs;
+    REQUIRE(CullMeshlets(drawArgs, meshlets.data(), meshlets.size(), frustum, Vector3{8.0f, 10.0f, 8.0f}) == 16);
+    REQUIRE(drawArgs.size() == 1);
+    REQUIRE(drawArgs[0].indexStart_ == 0);
+    REQUIRE(drawArgs[0].indexCount_ == lodView.indices_.size());
+    REQUIRE(drawArgs[0].instanceCount_ == 1);
+
+    drawArgs.clear();
+    REQUIRE(CullMeshlets(drawArgs, meshlets.data(), meshlets.size(), frustum, Vector3{8.0f, -10.0f, 8.0f}) == 0);
+    REQUIRE(drawArgs.empty());
+
+    frustum.Define(BoundingBox{Vector3{-1.0f, -1.0f, -1.0f}, Vector3{4.0f, 1.0f, 4.0f}}, Matrix3x4::IDENTITY);
+    const unsigned numVisible = CullMeshlets(drawArgs, meshlets.data(), meshlets.size(), frustum, Vector3{8.0f, 10.0f, 8.0f});
+    REQUIRE(numVisible > 0);
+    REQUIRE(numVisible < meshlets.size());
+
+    unsigned numIndices = 0;
+    for (const IndirectDrawIndexedArgs& args : drawArgs)
+        numIndices += args.indexCount_;
+    REQUIRE(numIndices == numVisible * 32 * 3);
+}
@@ -25,11 +25,13 @@
 #include "Urho3D/IO/MemoryBuffer.h"
 #include "Urho3D/Resource/XMLArchive.h"
 
+#include <Urho3D/Particles/ParticleGraphComputeGenerator.h>
 #include <Urho3D/Particles/ParticleGraphLayer.h>
 #include <Urho3D/Particles/ParticleGraphLayerInstance.h>
 #include <Urho3D/Graphics/Material.h>
 #include <Urho3D/Resource/ResourceCache.h>
 #include <Urho3D/Particles/ParticleGraphEffect.h>
+#include <Urho3D/Particles/ParticleGraphSystem.h>
 #include <Urho3D/Particles/All.h>
 #include <Urho3D/Scene/Scene.h>
 #include <EASTL/variant.h>
@@ -492,3 +494,164 @@ TEST_CASE("Test Make IntVector2")
     auto attributeSpan = emitter->GetLayer(0)->GetAttributeValues<IntVector2>(0);
     CHECK(attributeSpan[0] == IntVector2(2, 3));
 }
+
+namespace
+{
+
+/// Create effect with particles moving up with unit speed.
+SharedPtr<ParticleGraphEffect> CreateMovingParticlesEffect(Context* context)
+{
+    const auto effect = MakeShared<ParticleGraphEffect>(context);
+    effect->SetNumLayers(1);
+    auto layer = effect->GetLayer(0);
+    layer->SetCapacity(8);
+    {
+        auto& initGraph = layer->GetInitGraph();
+
+        auto position = MakeShared<ParticleGraphNodes::Constant>(context);
+        position->SetValue(Vector3(1, 2, 3));
+        auto positionIndex = initGraph.Add(position);
+
+        auto setPosition = MakeShared<ParticleGraphNodes::SetAttribute>(context);
+        setPosition->SetAttributeName("pos");
+        setPosition->SetAttributeType(VAR_VECTOR3);
+        setPosition->SetPinSource(setPosition->GetPinIndex(""), positionIndex);
+        initGraph.Add(setPosition);
+
+        auto velocity = MakeShared<ParticleGraphNodes::Constant>(context);
+        velocity->SetValue(Vector3(0, 1, 0));
+        auto velocityIndex = initGraph.Add(velocity);
+
+        auto setVelocity = MakeShared<ParticleGraphNodes::SetAttribute>(context);
+        setVelocity->SetAttributeName("vel");
+        setVelocity->SetAttributeType(VAR_VECTOR3);
+        setVelocity->SetPinSource(setVelocity->GetPinIndex(""), velocityIndex);
+        initGraph.Add(setVelocity);
+    }
+    {
+        auto& updateGraph = layer->GetUpdateGraph();
+
+        auto getPosition = MakeShared<ParticleGraphNodes::GetAttribute>(context);
+        getPosition->SetAttributeName("pos");
+        getPosition->SetAttributeType(VAR_VECTOR3);
+        auto getPositionIndex = updateGraph.Add(getPosition);
+
+        auto getVelocity = MakeShared<ParticleGraphNodes::GetAttribute>(context);
+        getVelocity->SetAttributeName("vel");
+        getVelocity->SetAttributeType(VAR_VECTOR3);
+        auto getVelocityIndex = updateGraph.Add(getVelocity);
+
+        auto move = MakeShared<ParticleGraphNodes::Move>(context);
+        move->SetPinSource(0, getPositionIndex);
+        move->SetPinSource(1, getVelocityIndex);
+        auto moveIndex = updateGraph.Add(move);
+
+        auto setPosition = MakeShared<ParticleGraphNodes::SetAttribute>(context);
+        setPosition->SetAttributeName("pos");
+        setPosition->SetAttributeType(VAR_VECTOR3);
+        setPosition->SetPinSource(setPosition->GetPinIndex(""), moveIndex, 2);
+        updateGraph.Add(setPosition);
+    }
+
+    return effect;
+}
+
+}
+
+TEST_CASE("Dense particle attributes are updated and compacted")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto effect = CreateMovingParticlesEffect(context);
+
+    const auto scene = MakeShared<Scene>(context);
+    const auto node = scene->CreateChild();
+    auto emitter = node->CreateComponent<ParticleGraphEmitter>();
+    emitter->SetEffect(effect);
+
+    // Odd number of particles to cover both vector and scalar tails of kernels
+    auto layerInstance = emitter->GetLayer(0);
+    REQUIRE(layerInstance->EmitNewParticles(5.0f));
+    REQUIRE(layerInstance->GetNumActiveParticles() == 5);
+
+    layerInstance->Update(0.5f, false);
+    auto positions = layerInstance->GetAttributeValues<Vector3>(0);
+    for (unsigned i = 0; i < 5; ++i)
+        CHECK(positions[i].Equals(Vector3(1.0f, 2.5f, 3.0f)));
+
+    for (unsigned i = 0; i < 5; ++i)
+        positions[i] = Vector3(static_cast<float>(i), 0.0f, 0.0f);
+
+    // Destroyed particles are compacted away, survivors keep their order and indices stay sequential
+    layerInstance->MarkForDeletion(1);
+    layerInstance->MarkForDeletion(1);
+    layerInstance->MarkForDeletion(3);
+    layerInstance->Update(0.0f, false);
+    REQUIRE(layerInstance->GetNumActiveParticles() == 3);
+
+    positions = layerInstance->GetAttributeValues<Vector3>(0);
+    CHECK(positions[0].Equals(Vector3(0.0f, 0.0f, 0.0f)));
+    CHECK(positions[1].Equals(Vector3(2.0f, 0.0f, 0.0f)));
+    CHECK(positions[2].Equals(Vector3(4.0f, 0.0f, 0.0f)));
+    for (unsigned i = 0; i < 3; ++i)
+        CHECK(positions.indices_[i] == i);
+}
+
+TEST_CASE("Particle graph emitters are updated in parallel")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto effect = CreateMovingParticlesEffect(context);
+
+    const auto scene = MakeShared<Scene>(context);
+    ea::vector<ParticleGraphEmitter*> emitters;
+    for (unsigned i = 0; i < 2 * ParticleGraphSystem::MinThreadedLayers; ++i)
+    {
+        auto emitter = scene->CreateChild()->CreateComponent<ParticleGraphEmitter>();
+        emitter->SetEffect(effect);
+        REQUIRE(emitter->GetLayer(0)->EmitNewParticles(static_cast<float>(i + 1)));
+        emitters.push_back(emitter);
+    }
+
+    auto system = context->GetSubsystem<ParticleGraphSystem>();
+    system->UpdateEmitters(scene, 0.5f);
+
+    for (unsigned i = 0; i < emitters.size(); ++i)
+    {
+        auto layerInstance = emitters[i]->GetLayer(0);
+        REQUIRE(layerInstance->GetNumActiveParticles() == i + 1);
+
+        auto positions = layerInstance->GetAttributeValues<Vector3>(0);
+        for (unsigned j = 0; j < i + 1; ++j)
+            CHECK(positions[j].Equals(Vector3(1.0f, 2.5f, 3.0f)));
+    }
+}
+
+TEST_CASE("Particle graph layer is translated to compute shader")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto effect = CreateMovingParticlesEffect(context);
+    auto layer = effect->GetLayer(0);
+
+    {
+        ParticleGraphComputeGenerator generator(layer);
+        REQUIRE(generator.Generate());
+        CHECK(generator.GetNumSlots() == 3);
+        CHECK(generator.GetBillboardNode() == nullptr);
+
+        const ea::string& source = generator.GetSource();
+        CHECK(source.starts_with("#version 430"));
+        CHECK(source.contains("const vec3 update_2_2 = update_0_0 + timeStep * update_1_0;"));
+        CHECK(source.contains("void main()"));
+    }
+
+    auto& updateGraph = layer->GetUpdateGraph();
+    auto print = MakeShared<ParticleGraphNodes::Print>(context);
+    print->SetPinSource(0, 0);
+    updateGraph.Add(print);
+    layer->Invalidate();
+
+    {
+        ParticleGraphComputeGenerator generator(layer);
+        REQUIRE_FALSE(generator.Generate());
+        CHECK(generator.GetError().contains("Print"));
+    }
+}
@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Graphics/Octree.h>
+#include <Urho3D/Graphics/Zone.h>
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+Zone* QueryZoneReference(const ea::vector<Zone*>& zonesByPriority, const Vector3& position)
+{
+    for (Zone* zone : zonesByPriority)
+    {
+        const Vector3 localPosition = zone->GetInverseWorldTransform() * position;
+        if (zone->GetBoundingBox().SignedDistanceToPoint(localPosition) <= 0.0f)
+            return zone;
+    }
+    return nullptr;
+}
+
+}
+
+TEST_CASE("ZoneLookupIndex grid returns same zones as linear search")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    RandomEngine re(0);
+
+    // Rooms of a building with random rotated zones on top
+    ea::vector<Zone*> zones;
+    for (int i = 0; i < 40; ++i)
+    {
+        Node* node = scene->CreateChild();
+        auto zone = node->CreateComponent<Zone>();
+        if (i < 25)
+        {
+            node->SetPosition(Vector3((i % 5) * 10.0f, 0.0f, (i / 5) * 10.0f));
+            zone->SetBoundingBox(BoundingBox(Vector3(-5.0f, -2.0f, -5.0f), Vector3(5.0f, 2.0f, 5.0f)));
+        }
+        else
+        {
+            node->SetPosition(re.GetVector3(Vector3(-5.0f, -2.0f, -5.0f), Vector3(45.0f, 2.0f, 45.0f)));
+            node->SetRotation(re.GetQuaternion());
+            zone->SetBoundingBox(BoundingBox(-re.GetVector3(Vector3::ONE, Vector3::ONE * 4.0f), Vector3::ONE));
+        }
+        zone->SetPriority(i);
+        zones.push_back(zone);
+    }
+
+    ZoneLookupIndex index(context);
+    for (Zone* zone : zones)
+        index.AddZone(zone);
+    index.Commit();
+    REQUIRE(index.IsGridEnabled());
+
+    const ea::vector<Zone*> zonesByPriority(zones.rbegin(), zones.rend());
+    Zone* defaultZone = index.QueryZone(Vector3::ZERO, 0).zone_;
+    for (int i = 0; i < 1000; ++i)
+    {
+        const Vector3 position = re.GetVector3(Vector3(-10.0f, -5.0f, -10.0f), Vector3(50.0f, 5.0f, 50.0f));
+        const CachedDrawableZone result = index.QueryZone(position, M_MAX_UNSIGNED);
+        Zone* expectedZone = QueryZoneReference(zonesByPriority, position);
+        REQUIRE(result.zone_ == (expectedZone ? expectedZone : defaultZone));
+
+        // Zone should not change within cache invalidation distance
+        const float cacheDistance = Sqrt(result.cacheInvalidationDistanceSquared_) * 0.99f;
+        const Vector3 offsetPosition = position + re.GetDirectionVector3() * cacheDistance;
+        REQUIRE(QueryZoneReference(zonesByPriority, offsetPosition) == expectedZone);
+    }
+
+    // Removed zones are not returned
+    index.RemoveZone(zones[0]);
+    index.Commit();
+    CHECK(index.QueryZone(Vector3::ZERO, M_MAX_UNSIGNED).zone_ != zones[0]);
+}
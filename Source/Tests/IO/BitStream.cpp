@@ -0,0 +1,78 @@
+//
+// Copyright (c) 2017-2021 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/IO/BitStream.h>
+#include <Urho3D/IO/VectorBuffer.h>
+
+TEST_CASE("BitStream values are read in the same order as written")
+{
+    VectorBuffer buffer;
+    {
+        BitStreamWriter writer(buffer);
+        writer.WriteBool(true);
+        writer.WriteBits(5, 3);
+        writer.WriteBits(0xABCDEF12, 32);
+        writer.WriteFloat(1.5f);
+        writer.WriteBits(1, 1);
+    }
+    // 1 + 3 + 32 + 32 + 1 bits padded to whole bytes
+    REQUIRE(buffer.GetSize() == 9);
+
+    buffer.Seek(0);
+    BitStreamReader reader(buffer);
+    CHECK(reader.ReadBool() == true);
+    CHECK(reader.ReadBits(3) == 5);
+    CHECK(reader.ReadBits(32) == 0xABCDEF12);
+    CHECK(reader.ReadFloat() == 1.5f);
+    CHECK(reader.ReadBits(1) == 1);
+    CHECK(buffer.IsEof());
+}
+
+TEST_CASE("BitStream quantized values are restored within precision")
+{
+    const float range = 100.0f;
+    const float precision = 0.01f;
+    const unsigned numBits = GetNumQuantizationBits(2.0f * range, precision);
+    CHECK(numBits == 15);
+
+    const Vector3 position{12.345f, -67.891f, 99.999f};
+    const Quaternion rotation{37.0f, Vector3{1.0f, -2.0f, 0.5f}.Normalized()};
+
+    VectorBuffer buffer;
+    {
+        BitStreamWriter writer(buffer);
+        writer.WriteQuantizedVector3(position, -range, range, numBits);
+        writer.WriteQuantizedQuaternion(rotation, 12);
+        writer.WriteQuantizedQuaternion(-rotation, 12);
+    }
+    // 3 * 15 + 2 * (2 + 3 * 12) bits
+    CHECK(buffer.GetSize() == 16);
+
+    buffer.Seek(0);
+    BitStreamReader reader(buffer);
+    CHECK(position.Equals(reader.ReadQuantizedVector3(-range, range, numBits), precision));
+    CHECK(rotation.Equivalent(reader.ReadQuantizedQuaternion(12), 0.001f));
+    CHECK(rotation.Equivalent(reader.ReadQuantizedQuaternion(12), 0.001f));
+}
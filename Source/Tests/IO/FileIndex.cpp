@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileIndex.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/FileWatcher.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Resource/ResourceCache.h>
+
+TEST_CASE("FileIndex answers existence checks and scans without file system")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+
+    const ea::string directory = fileSystem->GetTemporaryDir() + "Urho3DTestFileIndex/";
+    REQUIRE(fileSystem->CreateDirsRecursive(directory + "Textures/Nested"));
+    for (const char* fileName : {"Scene.xml", "Textures/A.png", "Textures/B.dds", "Textures/Nested/C.png"})
+        File(context, directory + fileName, FILE_WRITE).WriteUInt(0);
+
+    auto index = MakeShared<FileIndex>(directory);
+    index->Build(fileSystem);
+    CHECK(index->GetNumFiles() == 4);
+    CHECK(index->Contains("Scene.xml"));
+    CHECK(index->Contains("Textures/Nested/C.png"));
+    CHECK_FALSE(index->Contains("Textures"));
+    CHECK_FALSE(index->Contains("Missing.xml"));
+
+    ea::vector<ea::string> result;
+    index->Scan(result, "Textures", "*.png", SCAN_FILES, true);
+    ea::quick_sort(result.begin(), result.end());
+    CHECK(result == ea::vector<ea::string>{"A.png", "Nested/C.png"});
+
+    index->Scan(result, "Textures/", "*", SCAN_FILES, false);
+    ea::quick_sort(result.begin(), result.end());
+    CHECK(result == ea::vector<ea::string>{"A.png", "B.dds"});
+
+    // Removed directory removes nested files
+    fileSystem->RemoveDir(directory + "Textures/Nested", true);
+    index->ApplyChange(fileSystem, FileChange{FILECHANGE_REMOVED, "Textures/Nested", ""});
+    CHECK_FALSE(index->Contains("Textures/Nested/C.png"));
+    CHECK(index->GetNumFiles() == 3);
+
+    // Renamed file is moved in the index
+    fileSystem->Rename(directory + "Scene.xml", directory + "Level.xml");
+    index->ApplyChange(fileSystem, FileChange{FILECHANGE_RENAMED, "Level.xml", "Scene.xml"});
+    CHECK(index->Contains("Level.xml"));
+    CHECK_FALSE(index->Contains("Scene.xml"));
+
+    // Serialized index is identical
+    VectorBuffer buffer;
+    REQUIRE(index->Save(buffer));
+    buffer.Seek(0);
+    auto loadedIndex = MakeShared<FileIndex>(EMPTY_STRING);
+    REQUIRE(loadedIndex->Load(buffer));
+    CHECK(loadedIndex->GetDirectory() == index->GetDirectory());
+    CHECK(loadedIndex->GetNumFiles() == 3);
+    CHECK(loadedIndex->Contains("Level.xml"));
+    CHECK(loadedIndex->Contains("Textures/B.dds"));
+
+    fileSystem->RemoveDir(directory, true);
+}
+
+TEST_CASE("ResourceCache builds file indices of all resource directories")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+    auto cache = context->GetSubsystem<ResourceCache>();
+
+    const ea::string directory = fileSystem->GetTemporaryDir() + "Urho3DTestResourceFileIndex/";
+    ea::vector<ea::string> resourceDirs;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        const ea::string resourceDir = Format("{}Dir{}/", directory, i);
+        REQUIRE(fileSystem->CreateDirsRecursive(resourceDir + "Nested"));
+        File(context, Format("{}Nested/File{}.txt", resourceDir, i), FILE_WRITE).WriteUInt(0);
+        REQUIRE(cache->AddResourceDir(resourceDir));
+        resourceDirs.push_back(resourceDir);
+    }
+
+    cache->SetFileIndexEnabled(true);
+    for (unsigned i = 0; i < 4; ++i)
+        CHECK(cache->Exists(Format("Nested/File{}.txt", i)));
+    CHECK_FALSE(cache->Exists("Nested/File4.txt"));
+
+    // Loaded index is used as is, new files are not picked up
+    REQUIRE(cache->SaveFileIndex(directory + "Index.bin"));
+    File(context, resourceDirs[0] + "Nested/File4.txt", FILE_WRITE).WriteUInt(0);
+    REQUIRE(cache->LoadFileIndex(directory + "Index.bin"));
+    CHECK_FALSE(cache->Exists("Nested/File4.txt"));
+
+    cache->SetFileIndexEnabled(false);
+    CHECK(cache->Exists("Nested/File4.txt"));
+
+    for (const ea::string& resourceDir : resourceDirs)
+        cache->RemoveResourceDir(resourceDir);
+    fileSystem->RemoveDir(directory, true);
+}
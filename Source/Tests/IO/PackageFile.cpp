@@ -0,0 +1,152 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/PackageFile.h>
+
+#include <LZ4/lz4.h>
+
+namespace
+{
+
+/// Write compressed package with block index in the same layout as PackageTool.
+void WriteIndexedPackage(Context* context, const ea::string& fileName, const ea::string& entryName,
+    const ea::vector<unsigned char>& data, unsigned blockSize)
+{
+    File dest(context, fileName, FILE_WRITE);
+    REQUIRE(dest.IsOpen());
+
+    const auto writeHeader = [&](long long fileListOffset)
+    {
+        dest.WriteFileID("RLZ4");
+        dest.WriteUInt(1);
+        dest.WriteUInt(0);
+        dest.WriteUInt(1);
+        dest.WriteInt64(fileListOffset);
+        dest.WriteUInt(blockSize);
+    };
+    writeHeader(0);
+
+    const unsigned entryOffset = dest.GetSize();
+    ea::vector<unsigned> blockOffsets;
+    ea::vector<char> compressBuffer(LZ4_compressBound(blockSize));
+    for (unsigned pos = 0; pos < data.size(); pos += blockSize)
+    {
+        const unsigned unpackedSize = ea::min(blockSize, static_cast<unsigned>(data.size()) - pos);
+        const int packedSize = LZ4_compress_default(reinterpret_cast<const char*>(&data[pos]), compressBuffer.data(),
+            unpackedSize, compressBuffer.size());
+        REQUIRE(packedSize > 0);
+
+        blockOffsets.push_back(dest.GetSize() - entryOffset);
+        dest.WriteUShort(unpackedSize);
+        dest.WriteUShort(packedSize);
+        dest.Write(compressBuffer.data(), packedSize);
+    }
+    const unsigned packedSize = dest.GetSize() - entryOffset;
+
+    const unsigned fileListOffset = dest.GetSize();
+    dest.WriteString(entryName);
+    dest.WriteUInt(entryOffset);
+    dest.WriteUInt(data.size());
+    dest.WriteUInt(0);
+    dest.WriteUInt(packedSize);
+    dest.WriteVLE(blockOffsets.size());
+    for (unsigned blockOffset : blockOffsets)
+        dest.WriteUInt(blockOffset);
+    dest.WriteUInt(dest.GetSize() + sizeof(unsigned));
+
+    dest.Seek(0);
+    writeHeader(fileListOffset);
+}
+
+}
+
+TEST_CASE("Compressed package with block index supports random access")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+
+    const unsigned blockSize = 1024;
+    ea::vector<unsigned char> data(blockSize * 9 + 123);
+    for (unsigned i = 0; i < data.size(); ++i)
+        data[i] = static_cast<unsigned char>((i * 7) ^ (i >> 5));
+
+    const ea::string packageName = fileSystem->GetTemporaryDir() + "Urho3DTestIndexedPackage.pak";
+    WriteIndexedPackage(context, packageName, "Data.bin", data, blockSize);
+
+    {
+        auto package = MakeShared<PackageFile>(context, packageName);
+        REQUIRE(package->IsCompressed());
+        CHECK(package->GetBlockSize() == blockSize);
+
+        const PackageEntry* entry = package->GetEntry("Data.bin");
+        REQUIRE(entry);
+        CHECK(entry->blockOffsets_.size() == 10);
+
+        File file(context);
+        REQUIRE(file.Open(package, "Data.bin"));
+
+        // Whole file read decompresses blocks directly into destination
+        ea::vector<unsigned char> buffer(data.size());
+        REQUIRE(file.Read(buffer.data(), buffer.size()) == data.size());
+        CHECK(buffer == data);
+
+        // Seek backward into the middle of a block
+        const unsigned offsets[] = {5000u, 100u, 1024u, static_cast<unsigned>(data.size()) - 50, 0u, 3000u};
+        for (const unsigned offset : offsets)
+        {
+            REQUIRE(file.Seek(offset) == offset);
+            unsigned char chunk[50];
+            REQUIRE(file.Read(chunk, sizeof(chunk)) == sizeof(chunk));
+            CHECK(ea::equal(chunk, chunk + sizeof(chunk), data.begin() + offset));
+        }
+
+        // Seek back into blocks that were decompressed directly, bypassing the read buffer
+        {
+            REQUIRE(file.Seek(10) == 10);
+            ea::vector<unsigned char> head(blockSize - 10);
+            REQUIRE(file.Read(head.data(), head.size()) == head.size());
+            CHECK(ea::equal(head.begin(), head.end(), data.begin() + 10));
+
+            ea::vector<unsigned char> blocks(blockSize * 2);
+            REQUIRE(file.Read(blocks.data(), blocks.size()) == blocks.size());
+            CHECK(ea::equal(blocks.begin(), blocks.end(), data.begin() + blockSize));
+
+            const unsigned offset = blockSize * 2 + 452;
+            REQUIRE(file.Seek(offset) == offset);
+            unsigned char chunk[50];
+            REQUIRE(file.Read(chunk, sizeof(chunk)) == sizeof(chunk));
+            CHECK(ea::equal(chunk, chunk + sizeof(chunk), data.begin() + offset));
+        }
+
+        // Seek forward within current block and read across block boundary
+        REQUIRE(file.Seek(3040) == 3040);
+        ea::vector<unsigned char> tail(data.size() - 3040);
+        REQUIRE(file.Read(tail.data(), tail.size()) == tail.size());
+        CHECK(ea::equal(tail.begin(), tail.end(), data.begin() + 3040));
+    }
+
+    fileSystem->Delete(packageName);
+}
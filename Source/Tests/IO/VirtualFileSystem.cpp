@@ -21,8 +21,14 @@
 //
 #include "../CommonUtils.h"
 
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/MountedDirectory.h>
 #include <Urho3D/IO/VirtualFileSystem.h>
 
+#include <atomic>
+
 TEST_CASE("VirtualFileSystem has mount points")
 {
     auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
@@ -36,3 +42,56 @@ TEST_CASE("VirtualFileSystem has mount points")
         CHECK(mountPoint);
     }
 }
+
+TEST_CASE("VirtualFileSystem reads byte ranges asynchronously")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto vfs = context->GetSubsystem<VirtualFileSystem>();
+    auto fileSystem = context->GetSubsystem<FileSystem>();
+
+    const ea::string directory = fileSystem->GetTemporaryDir() + "Urho3DTestAsyncRead/";
+    REQUIRE(fileSystem->CreateDir(directory));
+
+    ea::vector<unsigned char> data(10000);
+    for (unsigned i = 0; i < data.size(); ++i)
+        data[i] = static_cast<unsigned char>(i * 13);
+    {
+        File file(context, directory + "Data.bin", FILE_WRITE);
+        REQUIRE(file.Write(data.data(), data.size()) == data.size());
+    }
+
+    auto mountPoint = MakeShared<MountedDirectory>(context, directory, "asynctest");
+    vfs->Mount(mountPoint);
+
+    std::atomic<unsigned> numCallbacks{};
+    const auto callback = [&](AsyncFileRead*) { ++numCallbacks; };
+
+    const ea::pair<unsigned, unsigned> ranges[] = {{0, 100}, {5000, 2000}, {9990, 100}, {0, M_MAX_UNSIGNED}, {3, 0}};
+    ea::vector<SharedPtr<AsyncFileRead>> reads;
+    for (const auto& [offset, size] : ranges)
+        reads.push_back(vfs->ReadFileAsync(FileIdentifier{"asynctest", "Data.bin"}, offset, size, callback));
+    auto missingRead = vfs->ReadFileAsync(FileIdentifier{"asynctest", "Missing.bin"}, 0, 100, callback);
+
+    const auto allFinished = [&]
+    {
+        return missingRead->IsFinished() && ea::all_of(reads.begin(), reads.end(), [](AsyncFileRead* read) { return read->IsFinished(); });
+    };
+    for (unsigned i = 0; i < 5000 && !allFinished(); ++i)
+        Time::Sleep(1);
+    REQUIRE(allFinished());
+
+    CHECK(numCallbacks == reads.size() + 1);
+    CHECK(missingRead->GetState() == AsyncReadState::Failed);
+    for (unsigned i = 0; i < reads.size(); ++i)
+    {
+        const auto [offset, size] = ranges[i];
+        const unsigned expectedSize = ea::min(size, static_cast<unsigned>(data.size()) - offset);
+
+        REQUIRE(reads[i]->GetState() == AsyncReadState::Completed);
+        REQUIRE(reads[i]->GetData().size() == expectedSize);
+        CHECK(ea::equal(reads[i]->GetData().begin(), reads[i]->GetData().end(), data.begin() + offset));
+    }
+
+    vfs->Unmount(mountPoint);
+    fileSystem->RemoveDir(directory, true);
+}
@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Math/BatchMath.h>
+#include <Urho3D/Math/RandomEngine.h>
+
+using namespace Urho3D;
+
+namespace
+{
+
+Matrix3x4 GetRandomTransform(RandomEngine& random)
+{
+    const Vector3 position = random.GetVector3({-10.0f, -10.0f, -10.0f}, {10.0f, 10.0f, 10.0f});
+    const Quaternion rotation = random.GetQuaternion();
+    const Vector3 scale = random.GetVector3({0.5f, 0.5f, 0.5f}, {2.0f, 2.0f, 2.0f});
+    return Matrix3x4(position, rotation, scale);
+}
+
+BoundingBox GetRandomBox(RandomEngine& random)
+{
+    const Vector3 center = random.GetVector3({-10.0f, -10.0f, -10.0f}, {10.0f, 10.0f, 10.0f});
+    const Vector3 halfSize = random.GetVector3({0.1f, 0.1f, 0.1f}, {3.0f, 3.0f, 3.0f});
+    return BoundingBox(center - halfSize, center + halfSize);
+}
+
+}
+
+TEST_CASE("Bounding boxes are transformed in batch")
+{
+    RandomEngine random(0);
+    const unsigned count = 37;
+
+    ea::vector<BoundingBox> boxes;
+    ea::vector<Matrix3x4> transforms;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        boxes.push_back(GetRandomBox(random));
+        transforms.push_back(GetRandomTransform(random));
+    }
+
+    ea::vector<BoundingBox> result(count);
+    TransformBoundingBoxes(result.data(), boxes.data(), transforms.data(), count);
+
+    BoundingBox expectedMerged;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const BoundingBox expected = boxes[i].Transformed(transforms[i]);
+        CHECK(result[i].min_.Equals(expected.min_, M_LARGE_EPSILON));
+        CHECK(result[i].max_.Equals(expected.max_, M_LARGE_EPSILON));
+        expectedMerged.Merge(boxes[0].Transformed(transforms[i]));
+    }
+
+    const BoundingBox merged = TransformAndMergeBoundingBox(boxes[0], transforms.data(), count);
+    CHECK(merged.min_.Equals(expectedMerged.min_, M_LARGE_EPSILON));
+    CHECK(merged.max_.Equals(expectedMerged.max_, M_LARGE_EPSILON));
+    CHECK_FALSE(TransformAndMergeBoundingBox(boxes[0], transforms.data(), 0).Defined());
+}
+
+TEST_CASE("Matrices and points are transformed in batch")
+{
+    RandomEngine random(0);
+    const unsigned count = 23;
+
+    ea::vector<Matrix3x4> lhs;
+    ea::vector<Matrix3x4> rhs;
+    ea::vector<Vector3> points;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        lhs.push_back(GetRandomTransform(random));
+        rhs.push_back(GetRandomTransform(random));
+        points.push_back(random.GetVector3({-10.0f, -10.0f, -10.0f}, {10.0f, 10.0f, 10.0f}));
+    }
+
+    ea::vector<Matrix3x4> products(count);
+    MultiplyMatrices(products.data(), lhs.data(), rhs.data(), count);
+
+    ea::vector<Vector3> transformedPoints(count);
+    TransformPoints(transformedPoints.data(), points.data(), count, lhs[0]);
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        CHECK(products[i].Equals(lhs[i] * rhs[i]));
+        CHECK(transformedPoints[i].Equals(lhs[0] * points[i], M_LARGE_EPSILON));
+    }
+}
+
+TEST_CASE("Bounding boxes and spheres are tested against frustum in batch")
+{
+    RandomEngine random(0);
+    const unsigned count = 101;
+
+    Frustum frustum;
+    frustum.Define(60.0f, 1.0f, 1.0f, 0.1f, 15.0f, Matrix3x4(Vector3(0.0f, 0.0f, -10.0f), Quaternion::IDENTITY, 1.0f));
+
+    ea::vector<BoundingBox> boxes;
+    ea::vector<Sphere> spheres;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        boxes.push_back(GetRandomBox(random));
+        spheres.push_back(Sphere(boxes.back().Center(), boxes.back().HalfSize().x_));
+    }
+
+    bool boxesInside[count]{};
+    bool spheresInside[count]{};
+    TestBoundingBoxesInside(boxesInside, frustum, boxes.data(), count);
+    TestSpheresInside(spheresInside, frustum, spheres.data(), count);
+
+    unsigned numInside = 0;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        CHECK(boxesInside[i] == (frustum.IsInsideFast(boxes[i]) != OUTSIDE));
+        CHECK(spheresInside[i] == (frustum.IsInsideFast(spheres[i]) != OUTSIDE));
+        numInside += boxesInside[i];
+    }
+
+    // Make sure the test is meaningful
+    CHECK(numInside > 0);
+    CHECK(numInside < count);
+}
@@ -0,0 +1,74 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Math/PerlinNoise.h>
+#include <Urho3D/Math/RandomEngine.h>
+
+using namespace Urho3D;
+
+TEST_CASE("Random values are generated in batch")
+{
+    RandomEngine expectedRandom(13);
+    RandomEngine random(13);
+    const unsigned count = 203;
+
+    ea::vector<unsigned> uints(count);
+    random.GetUIntArray(uints);
+    for (unsigned i = 0; i < count; ++i)
+        REQUIRE(uints[i] == expectedRandom.GetUInt());
+
+    ea::vector<float> floats(count);
+    random.GetFloatArray(floats, -3.0f, 5.0f);
+    for (unsigned i = 0; i < count; ++i)
+        REQUIRE(floats[i] == expectedRandom.GetFloat(-3.0f, 5.0f));
+
+    const Vector3 min{-1.0f, 2.0f, -10.0f};
+    const Vector3 max{1.0f, 4.0f, 10.0f};
+    ea::vector<Vector3> vectors(count);
+    random.GetVector3Array(vectors, min, max);
+    for (unsigned i = 0; i < count; ++i)
+        REQUIRE(vectors[i] == expectedRandom.GetVector3(min, max));
+
+    // Engine state is left exactly as after sequential calls
+    REQUIRE(random.Save() == expectedRandom.Save());
+    REQUIRE(random.GetUInt() == expectedRandom.GetUInt());
+}
+
+TEST_CASE("Perlin noise is evaluated in batch")
+{
+    RandomEngine random(0);
+    PerlinNoise noise(random);
+    const unsigned count = 39;
+
+    ea::vector<Vector3> positions(count);
+    random.GetVector3Array(positions, {-100.0f, -100.0f, -100.0f}, {100.0f, 100.0f, 100.0f});
+
+    ea::vector<float> values(count);
+    noise.GetBatch(values.data(), positions.data(), count);
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const Vector3& pos = positions[i];
+        CHECK(values[i] == Catch::Approx(noise.Get(pos.x_, pos.y_, pos.z_)).margin(M_LARGE_EPSILON));
+    }
+}
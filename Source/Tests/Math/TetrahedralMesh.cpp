@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Math/RandomEngine.h>
+#include <Urho3D/Math/TetrahedralMesh.h>
+
+using namespace Urho3D;
+
+namespace
+{
+
+bool IsInsideTetrahedron(const Vector4& weights)
+{
+    const float eps = -M_LARGE_EPSILON;
+    return weights.x_ >= eps && weights.y_ >= eps && weights.z_ >= eps && weights.w_ >= eps;
+}
+
+}
+
+TEST_CASE("TetrahedralMesh lookup finds containing tetrahedron from any hint")
+{
+    RandomEngine re(0);
+
+    ea::vector<Vector3> positions;
+    for (int x = 0; x < 4; ++x)
+    {
+        for (int y = 0; y < 3; ++y)
+        {
+            for (int z = 0; z < 4; ++z)
+            {
+                const Vector3 offset = re.GetVector3(-Vector3::ONE, Vector3::ONE);
+                positions.push_back(Vector3(x * 10.0f, y * 5.0f, z * 10.0f) + offset);
+            }
+        }
+    }
+
+    TetrahedralMesh mesh;
+    mesh.Define(positions);
+    REQUIRE(mesh.numInnerTetrahedrons_ > 0);
+    REQUIRE(mesh.GetSeedTetrahedron(Vector3(15.0f, 5.0f, 15.0f)) < mesh.tetrahedrons_.size());
+
+    unsigned coherentHint = M_MAX_UNSIGNED;
+    for (int i = 0; i < 200; ++i)
+    {
+        const Vector3 position = re.GetVector3(Vector3(-5.0f, -5.0f, -5.0f), Vector3(35.0f, 15.0f, 35.0f));
+
+        unsigned seedHint = M_MAX_UNSIGNED;
+        const Vector4 seedWeights = mesh.GetInterpolationFactors(position, seedHint);
+        REQUIRE(seedHint < mesh.tetrahedrons_.size());
+        CHECK(IsInsideTetrahedron(seedWeights));
+
+        unsigned staleHint = 0;
+        const Vector4 staleWeights = mesh.GetInterpolationFactors(position, staleHint);
+        CHECK(IsInsideTetrahedron(staleWeights));
+
+        const Vector4 coherentWeights = mesh.GetInterpolationFactors(position, coherentHint);
+        CHECK(IsInsideTetrahedron(coherentWeights));
+    }
+}
@@ -0,0 +1,212 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Math/BoundingBox.h>
+#include <Urho3D/Math/Matrix3x4.h>
+#include <Urho3D/Math/RandomEngine.h>
+
+using namespace Urho3D;
+
+// SSE and NEON code paths of math classes are compared against plain scalar formulas here.
+// Results may differ only by rounding because of different summation order.
+
+namespace
+{
+
+Matrix3x4 GetRandomMatrix3x4(RandomEngine& random)
+{
+    Matrix3x4 result;
+    float* data = &result.m00_;
+    for (unsigned i = 0; i < 12; ++i)
+        data[i] = random.GetFloat(-4.0f, 4.0f);
+    return result;
+}
+
+Matrix4 GetRandomMatrix4(RandomEngine& random)
+{
+    Matrix4 result;
+    float* data = &result.m00_;
+    for (unsigned i = 0; i < 16; ++i)
+        data[i] = random.GetFloat(-4.0f, 4.0f);
+    return result;
+}
+
+Vector3 GetRandomVector3(RandomEngine& random)
+{
+    return random.GetVector3(-4.0f * Vector3::ONE, 4.0f * Vector3::ONE);
+}
+
+Vector4 GetRandomVector4(RandomEngine& random)
+{
+    return {GetRandomVector3(random), random.GetFloat(-4.0f, 4.0f)};
+}
+
+float GetElement(const Matrix4& matrix, unsigned row, unsigned column)
+{
+    return (&matrix.m00_)[row * 4 + column];
+}
+
+float GetElement(const Matrix3x4& matrix, unsigned row, unsigned column)
+{
+    if (row == 3)
+        return column == 3 ? 1.0f : 0.0f;
+    return (&matrix.m00_)[row * 4 + column];
+}
+
+template <class T, class U> Matrix4 MultiplyReference(const T& lhs, const U& rhs)
+{
+    Matrix4 result;
+    float* data = &result.m00_;
+    for (unsigned row = 0; row < 4; ++row)
+    {
+        for (unsigned column = 0; column < 4; ++column)
+        {
+            float sum = 0.0f;
+            for (unsigned k = 0; k < 4; ++k)
+                sum += GetElement(lhs, row, k) * GetElement(rhs, k, column);
+            data[row * 4 + column] = sum;
+        }
+    }
+    return result;
+}
+
+}
+
+TEST_CASE("Vectorized Matrix3x4 operations match scalar formulas")
+{
+    RandomEngine random(0);
+    for (unsigned iteration = 0; iteration < 100; ++iteration)
+    {
+        const Matrix3x4 lhs = GetRandomMatrix3x4(random);
+        const Matrix3x4 rhs = GetRandomMatrix3x4(random);
+        const Matrix4 rhs4 = GetRandomMatrix4(random);
+        const Vector3 vector3 = GetRandomVector3(random);
+        const Vector4 vector4 = GetRandomVector4(random);
+
+        CHECK((lhs * rhs).ToMatrix4().Equals(MultiplyReference(lhs, rhs), M_LARGE_EPSILON));
+        CHECK((lhs * rhs4).Equals(MultiplyReference(lhs, rhs4), M_LARGE_EPSILON));
+
+        const Vector4 expected3 = MultiplyReference(lhs, Matrix4::IDENTITY) * Vector4(vector3, 1.0f);
+        CHECK((lhs * vector3).Equals(expected3.ToVector3(), M_LARGE_EPSILON));
+        CHECK((lhs * vector4).Equals((lhs.ToMatrix4() * vector4).ToVector3(), M_LARGE_EPSILON));
+
+        const float* lhsData = &lhs.m00_;
+        const float* rhsData = &rhs.m00_;
+        const Matrix3x4 sum = lhs + rhs;
+        const Matrix3x4 difference = lhs - rhs;
+        const Matrix3x4 scaled = lhs * 3.0f;
+        for (unsigned i = 0; i < 12; ++i)
+        {
+            CHECK((&sum.m00_)[i] == lhsData[i] + rhsData[i]);
+            CHECK((&difference.m00_)[i] == lhsData[i] - rhsData[i]);
+            CHECK((&scaled.m00_)[i] == lhsData[i] * 3.0f);
+        }
+    }
+}
+
+TEST_CASE("Vectorized Matrix4 operations match scalar formulas")
+{
+    RandomEngine random(0);
+    for (unsigned iteration = 0; iteration < 100; ++iteration)
+    {
+        const Matrix4 lhs = GetRandomMatrix4(random);
+        const Matrix4 rhs = GetRandomMatrix4(random);
+        const Vector4 vector = GetRandomVector4(random);
+
+        CHECK((lhs * rhs).Equals(MultiplyReference(lhs, rhs), M_LARGE_EPSILON));
+
+        float expected[4]{};
+        for (unsigned row = 0; row < 4; ++row)
+        {
+            for (unsigned k = 0; k < 4; ++k)
+                expected[row] += GetElement(lhs, row, k) * vector.Data()[k];
+        }
+        CHECK((lhs * vector).Equals(Vector4(expected), M_LARGE_EPSILON));
+
+        const Vector3 position = GetRandomVector3(random);
+        const Vector4 projected = lhs * Vector4(position, 1.0f);
+        if (Abs(projected.w_) > 0.5f)
+        {
+            const Vector3 expectedPosition = projected.ToVector3() / projected.w_;
+            CHECK((lhs * position).Equals(expectedPosition, 0.01f));
+        }
+
+        Matrix4 transposed;
+        Matrix4::BulkTranspose(&transposed.m00_, &lhs.m00_, 1);
+        CHECK(transposed == lhs.Transpose());
+
+        const float* lhsData = &lhs.m00_;
+        const float* rhsData = &rhs.m00_;
+        const Matrix4 sum = lhs + rhs;
+        const Matrix4 difference = lhs - rhs;
+        const Matrix4 scaled = lhs * 3.0f;
+        for (unsigned i = 0; i < 16; ++i)
+        {
+            CHECK((&sum.m00_)[i] == lhsData[i] + rhsData[i]);
+            CHECK((&difference.m00_)[i] == lhsData[i] - rhsData[i]);
+            CHECK((&scaled.m00_)[i] == lhsData[i] * 3.0f);
+        }
+    }
+}
+
+TEST_CASE("Vectorized Quaternion and BoundingBox operations match scalar formulas")
+{
+    RandomEngine random(0);
+    for (unsigned iteration = 0; iteration < 100; ++iteration)
+    {
+        const Quaternion lhs = random.GetQuaternion();
+        const Quaternion rhs = random.GetQuaternion();
+        const Quaternion expected{
+            lhs.w_ * rhs.w_ - lhs.x_ * rhs.x_ - lhs.y_ * rhs.y_ - lhs.z_ * rhs.z_,
+            lhs.w_ * rhs.x_ + lhs.x_ * rhs.w_ + lhs.y_ * rhs.z_ - lhs.z_ * rhs.y_,
+            lhs.w_ * rhs.y_ + lhs.y_ * rhs.w_ + lhs.z_ * rhs.x_ - lhs.x_ * rhs.z_,
+            lhs.w_ * rhs.z_ + lhs.z_ * rhs.w_ + lhs.x_ * rhs.y_ - lhs.y_ * rhs.x_};
+        CHECK((lhs * rhs).Equals(expected, M_LARGE_EPSILON));
+
+        const Vector3 center = GetRandomVector3(random);
+        const Vector3 halfSize = random.GetVector3(0.1f * Vector3::ONE, Vector3::ONE);
+        const BoundingBox box{center - halfSize, center + halfSize};
+        const Matrix3x4 transform = GetRandomMatrix3x4(random);
+
+        // Transformed box must contain all transformed corners and touch at least one of them on each side
+        BoundingBox expectedBox;
+        for (unsigned corner = 0; corner < 8; ++corner)
+        {
+            const Vector3 point{
+                corner & 1 ? box.max_.x_ : box.min_.x_,
+                corner & 2 ? box.max_.y_ : box.min_.y_,
+                corner & 4 ? box.max_.z_ : box.min_.z_};
+            expectedBox.Merge(transform * point);
+        }
+        const BoundingBox transformedBox = box.Transformed(transform);
+        CHECK(transformedBox.min_.Equals(expectedBox.min_, M_LARGE_EPSILON));
+        CHECK(transformedBox.max_.Equals(expectedBox.max_, M_LARGE_EPSILON));
+
+        BoundingBox mergedBox{center, center};
+        mergedBox.Merge(box);
+        CHECK(mergedBox.min_ == box.min_);
+        CHECK(mergedBox.max_ == box.max_);
+    }
+}
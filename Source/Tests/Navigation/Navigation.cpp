@@ -185,5 +185,78 @@ TEST_CASE("Recast/Detour Crowdmanager test with DynamicNavigationMesh")
 
 }
 
+TEST_CASE("NavigationMesh rebuilds changed area asynchronously")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = CreateTestScene(context, 0);
+    auto* navMesh = scene->CreateComponent<NavigationMesh>();
+    navMesh->SetTileSize(32);
+    scene->CreateComponent<Navigable>();
+    navMesh->Build();
+
+    const Vector3 start{-10.0f, 0.0f, 0.0f};
+    const Vector3 end{10.0f, 0.0f, 0.0f};
+    REQUIRE(navMesh->Raycast(start, end).Equals(end, 0.1f));
+
+    // Place a wall between the points
+    Node* wallNode = scene->CreateChild("Wall");
+    wallNode->SetScale(Vector3(2.0f, 4.0f, 20.0f));
+    wallNode->SetPosition(Vector3(0.0f, 2.0f, 0.0f));
+    wallNode->CreateComponent<RigidBody>();
+    auto* wallShape = wallNode->CreateComponent<CollisionShape>();
+    wallShape->SetShapeType(SHAPE_BOX);
+    wallShape->SetBox(Vector3::ONE);
+
+    unsigned numRebuiltTiles = 0;
+    scene->SubscribeToEvent(navMesh, E_NAVIGATION_AREA_REBUILT, [&](StringHash, VariantMap&) { ++numRebuiltTiles; });
+
+    navMesh->BuildAsync(BoundingBox(Vector3(-1.0f, 0.0f, -10.0f), Vector3(1.0f, 4.0f, 10.0f)));
+    REQUIRE(navMesh->IsBuildingAsync());
+
+    navMesh->CompleteAsyncBuild();
+    REQUIRE_FALSE(navMesh->IsBuildingAsync());
+    REQUIRE(numRebuiltTiles > 0);
+    REQUIRE(navMesh->Raycast(start, end).x_ < 0.0f);
+}
+
+TEST_CASE("NavigationMesh finds paths asynchronously with sliced pathfinding")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    SetRandomSeed(1);
+    auto scene = CreateTestScene(context, 20);
+    auto* navMesh = scene->CreateComponent<NavigationMesh>();
+    navMesh->SetTileSize(32);
+    navMesh->SetPathIterationsPerFrame(4);
+    scene->CreateComponent<Navigable>();
+    navMesh->Build();
+
+    const Vector3 start{-40.0f, 0.0f, -40.0f};
+    const Vector3 end{40.0f, 0.0f, 40.0f};
+
+    ea::vector<NavigationPathPoint> expectedPath;
+    navMesh->FindPath(expectedPath, start, end);
+    REQUIRE_FALSE(expectedPath.empty());
+
+    bool completed = false;
+    ea::vector<NavigationPathPoint> path;
+    navMesh->FindPathAsync(start, end, [&](const ea::vector<NavigationPathPoint>& result)
+    {
+        completed = true;
+        path = result;
+    });
+    REQUIRE(navMesh->GetNumPathRequests() == 1);
+
+    for (unsigned i = 0; i < 1000 && !completed; ++i)
+        Tests::RunFrame(context, 0.01f, 0.01f);
+
+    REQUIRE(completed);
+    REQUIRE(navMesh->GetNumPathRequests() == 0);
+    REQUIRE(path.size() == expectedPath.size());
+    for (unsigned i = 0; i < path.size(); ++i)
+        REQUIRE(path[i].position_.Equals(expectedPath[i].position_));
+}
+
 #endif
 #endif
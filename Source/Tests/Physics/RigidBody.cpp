@@ -0,0 +1,62 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Physics/CollisionShape.h>
+#include <Urho3D/Physics/PhysicsWorld.h>
+#include <Urho3D/Physics/RigidBody.h>
+#include <Urho3D/Scene/Scene.h>
+
+TEST_CASE("Distant rigid body is synchronized when it falls asleep")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = MakeShared<Scene>(context);
+    auto physicsWorld = scene->CreateComponent<PhysicsWorld>();
+
+    // Body is distant and its node is almost never synchronized
+    const Vector3 interestPoints[] = {{1000.0f, 0.0f, 0.0f}};
+    physicsWorld->SetLodMode(PHYSICS_LOD_REDUCED_SYNC);
+    physicsWorld->SetLodSyncInterval(1000);
+    physicsWorld->SetLodInterestPoints(interestPoints);
+
+    Node* floorNode = scene->CreateChild("Floor");
+    floorNode->SetPosition({0.0f, -0.5f, 0.0f});
+    floorNode->CreateComponent<RigidBody>();
+    floorNode->CreateComponent<CollisionShape>()->SetBox({10.0f, 1.0f, 10.0f});
+
+    Node* boxNode = scene->CreateChild("Box");
+    boxNode->SetPosition({0.0f, 2.0f, 0.0f});
+    auto boxBody = boxNode->CreateComponent<RigidBody>();
+    boxBody->SetMass(1.0f);
+    boxBody->SetLodEnabled(true);
+    boxNode->CreateComponent<CollisionShape>()->SetBox(Vector3::ONE);
+
+    for (unsigned i = 0; i < 600; ++i)
+        physicsWorld->Update(1.0f / 60.0f);
+
+    // Expect final transform to be applied to the node
+    REQUIRE(boxBody->IsLodDistant());
+    REQUIRE_FALSE(boxBody->IsActive());
+    CHECK(boxNode->GetWorldPosition().Equals({0.0f, 0.5f, 0.0f}, 0.05f));
+}
@@ -0,0 +1,69 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Replica/ClientInputStatistics.h>
+
+TEST_CASE("ClientInputStatistics recommends buffering for repeated input loss")
+{
+    ClientInputStatistics stats{16, 8};
+
+    NetworkFrame frame{1};
+    stats.OnInputReceived(frame);
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        frame = frame + 3;
+        stats.OnInputReceived(frame);
+    }
+
+    CHECK(stats.GetRecommendedBufferSize() == 2);
+}
+
+TEST_CASE("ClientInputStatistics doesn't buffer for input loss not covered by redundancy")
+{
+    // Frames recovered from redundant input arrive late and need buffering
+    ClientInputStatistics stats{16, 8};
+
+    NetworkFrame frame{1};
+    stats.OnInputReceived(frame, 3);
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        frame = frame + 3;
+        stats.OnInputReceived(frame, 3);
+    }
+
+    CHECK(stats.GetRecommendedBufferSize() == 2);
+
+    // Frames that are not sent again are lost anyway
+    ClientInputStatistics statsWithoutRedundancy{16, 8};
+
+    frame = NetworkFrame{1};
+    statsWithoutRedundancy.OnInputReceived(frame, 1);
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        frame = frame + 3;
+        statsWithoutRedundancy.OnInputReceived(frame, 1);
+    }
+
+    CHECK(statsWithoutRedundancy.GetRecommendedBufferSize() == 0);
+}
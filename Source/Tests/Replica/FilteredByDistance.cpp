@@ -162,3 +162,49 @@ TEST_CASE("FilteredByDistance handles object hierarchies")
         REQUIRE_FALSE(unfilteredChildNode);
     }
 }
+
+TEST_CASE("FilteredByDistance objects are tracked in interest grid")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto filteredPrefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/FilteredByDistance/FilteredTest.prefab", CreateFilteredTestPrefab);
+
+    // Create scenes
+    auto serverScene = MakeShared<Scene>(context);
+    auto clientScene = MakeShared<Scene>(context);
+
+    const auto quality = Tests::ConnectionQuality{ 0.08f, 0.12f, 0.20f, 0.02f, 0.02f };
+    Tests::NetworkSimulator sim(serverScene);
+    sim.AddClient(clientScene, quality);
+    sim.SimulateTime(5.0f);
+
+    // Spawn objects, one of them is many grid cells away from the client
+    {
+        auto clientNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, filteredPrefab, "Client Node");
+        clientNode->GetComponent<BehaviorNetworkObject>()->SetOwner(sim.GetServerToClientConnection(clientScene));
+        clientNode->SetWorldPosition(Vector3(0.0f, 0.0f, 0.0f));
+
+        auto nearNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, filteredPrefab, "Near Node");
+        nearNode->SetWorldPosition(Vector3(5.0f, 0.0f, 0.0f));
+
+        auto farNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, filteredPrefab, "Far Node");
+        farNode->SetWorldPosition(Vector3(1000.0f, 0.0f, 0.0f));
+    }
+
+    sim.SimulateTime(8.0f);
+
+    REQUIRE(clientScene->GetChild("Client Node", true));
+    REQUIRE(clientScene->GetChild("Near Node", true));
+    REQUIRE_FALSE(clientScene->GetChild("Far Node", true));
+
+    // Swap objects
+    serverScene->GetChild("Near Node", true)->SetWorldPosition(Vector3{-1000.0f, 0.0f, 0.0f});
+    serverScene->GetChild("Far Node", true)->SetWorldPosition(Vector3{0.0f, 0.0f, 5.0f});
+    sim.SimulateTime(8.0f);
+
+    REQUIRE(clientScene->GetChild("Client Node", true));
+    REQUIRE_FALSE(clientScene->GetChild("Near Node", true));
+    REQUIRE(clientScene->GetChild("Far Node", true));
+    REQUIRE(clientScene->GetChild("Far Node", true)->GetWorldPosition() == Vector3{0.0f, 0.0f, 5.0f});
+}
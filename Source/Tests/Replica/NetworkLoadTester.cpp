@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+#include "../NetworkUtils.h"
+#include "../SceneUtils.h"
+
+#include <Urho3D/Network/Network.h>
+#include <Urho3D/Replica/BehaviorNetworkObject.h>
+#include <Urho3D/Replica/NetworkLoadTester.h>
+#include <Urho3D/Replica/ReplicatedTransform.h>
+#include <Urho3D/Replica/ReplicationManager.h>
+#include <Urho3D/Scene/PrefabResource.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+SharedPtr<PrefabResource> CreateTestPrefab(Context* context)
+{
+    auto node = MakeShared<Node>(context);
+    node->CreateComponent<ReplicatedTransform>();
+
+    return Tests::ConvertNodeToPrefab(node);
+}
+
+}
+
+TEST_CASE("Load tester simulates many clients with scripted input")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto prefab =
+        Tests::GetOrCreateResource<PrefabResource>(context, "@/NetworkLoadTester/Test.prefab", CreateTestPrefab);
+
+    auto serverScene = MakeShared<Scene>(context);
+    Tests::NetworkSimulator sim(serverScene);
+    auto serverReplicationManager = serverScene->GetComponent<ReplicationManager>();
+
+    static constexpr unsigned numClients = 16;
+    auto tester = MakeShared<NetworkLoadTester>(serverReplicationManager);
+    tester->AddClients(numClients);
+    REQUIRE(tester->GetNumClients() == numClients);
+
+    // Spawn one controlled object per client
+    for (unsigned i = 0; i < numClients; ++i)
+    {
+        Node* node = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, prefab, Format("Object {}", i));
+        node->GetComponent<BehaviorNetworkObject>()->SetOwner(tester->GetClient(i));
+    }
+
+    ea::vector<unsigned> numInputFrames(numClients);
+    tester->SetInputGenerator([&](unsigned clientIndex, NetworkObject* networkObject, NetworkFrame, VectorBuffer&)
+    {
+        CHECK(networkObject->GetOwnerConnection() == tester->GetClient(clientIndex));
+        ++numInputFrames[clientIndex];
+        return true;
+    });
+
+    sim.SimulateTime(1.0f);
+    tester->ResetStats();
+    sim.SimulateTime(2.0f);
+
+    for (unsigned i = 0; i < numClients; ++i)
+    {
+        CHECK(tester->GetClient(i)->IsSynchronized());
+        CHECK(tester->GetClient(i)->GetNumBytesReceived() > 0);
+        CHECK(numInputFrames[i] > 0);
+    }
+
+    const NetworkLoadTestStats stats = tester->GetStats();
+    CHECK(stats.numFrames_ >= 2 * Tests::NetworkSimulator::FramesInSecond - 1);
+    CHECK(stats.elapsedTime_ == Catch::Approx(2.0f).margin(0.05f));
+    CHECK(stats.maxServerFrameTime_ >= stats.averageServerFrameTime_);
+    CHECK(stats.bytesReceivedPerClient_ > 0.0f);
+    CHECK(stats.bytesSentPerClient_ > 0.0f);
+
+    tester->RemoveAllClients();
+    CHECK(tester->GetNumClients() == 0);
+}
@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+#include "../NetworkUtils.h"
+#include "../SceneUtils.h"
+
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Network/Network.h>
+#include <Urho3D/Replica/BehaviorNetworkObject.h>
+#include <Urho3D/Replica/NetworkReplay.h>
+#include <Urho3D/Replica/ReplicatedTransform.h>
+#include <Urho3D/Replica/ReplicationManager.h>
+#include <Urho3D/Scene/PrefabResource.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace
+{
+
+SharedPtr<PrefabResource> CreateTestPrefab(Context* context)
+{
+    auto node = MakeShared<Node>(context);
+    node->CreateComponent<ReplicatedTransform>();
+
+    return Tests::ConvertNodeToPrefab(node);
+}
+
+}
+
+TEST_CASE("Replication stream is recorded and played back with seeking")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/NetworkReplay/Test.prefab", CreateTestPrefab);
+
+    auto serverScene = MakeShared<Scene>(context);
+    Node* serverNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, prefab, "Replicated Node");
+
+    Tests::NetworkSimulator sim(serverScene);
+    auto serverReplicationManager = serverScene->GetComponent<ReplicationManager>();
+
+    // Record few seconds of moving object
+    VectorBuffer replayData;
+    {
+        auto recorder = MakeShared<NetworkReplayRecorder>(serverReplicationManager);
+        recorder->SetKeyFrameInterval(1.0f);
+        REQUIRE(recorder->StartRecording(&replayData));
+
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            serverNode->SetPosition({static_cast<float>(i), 0.0f, 0.0f});
+            sim.SimulateTime(1.0f);
+        }
+
+        recorder->StopRecording();
+        REQUIRE(recorder->GetNumChunks() >= 4);
+    }
+
+    // Play it back into the client scene
+    auto clientScene = MakeShared<Scene>(context);
+    auto clientReplicationManager = clientScene->GetOrCreateComponent<ReplicationManager>();
+
+    auto player = MakeShared<NetworkReplayPlayer>(clientReplicationManager);
+    MemoryBuffer replaySource{replayData.GetBuffer()};
+    REQUIRE(player->Load(replaySource));
+    CHECK(player->GetDuration() == Catch::Approx(4.0f).margin(0.05f));
+    CHECK(player->GetNumKeyFrames() >= 4);
+
+    sim.SimulateTime(2.0f);
+    CHECK(clientScene->GetChild("Replicated Node", true));
+
+    // Seek backwards and play at higher speed until the end
+    player->Seek(0.5f);
+    player->SetSpeed(4.0f);
+    sim.SimulateTime(1.0f);
+    CHECK(player->IsFinished());
+    CHECK(clientScene->GetChild("Replicated Node", true));
+}
@@ -36,6 +36,7 @@
 #include <Urho3D/Replica/BehaviorNetworkObject.h>
 #include <Urho3D/Replica/ReplicationManager.h>
 #include <Urho3D/Replica/NetworkObject.h>
+#include <Urho3D/Replica/NetworkSettingsConsts.h>
 #include <Urho3D/Replica/NetworkValue.h>
 #include <Urho3D/Replica/ReplicatedTransform.h>
 
@@ -371,6 +372,138 @@ TEST_CASE("Position and rotation are synchronized between client and server")
     }
 }
 
+TEST_CASE("Unreliable updates are limited by bandwidth budget")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/SceneSynchronization/SimpleTest.prefab", CreateSimpleTestPrefab);
+
+    // Setup scenes
+    const auto quality = Tests::ConnectionQuality{0.08f, 0.12f, 0.20f, 0, 0};
+    const unsigned numNodes = 16;
+    const float moveSpeed = 1.0f;
+    auto serverScene = MakeShared<Scene>(context);
+    auto clientScene = MakeShared<Scene>(context);
+
+    ea::vector<Node*> serverNodes;
+    for (unsigned i = 0; i < numNodes; ++i)
+    {
+        const Vector3 position{static_cast<float>(i), 0.0f, 0.0f};
+        serverNodes.push_back(Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, prefab, Format("Node {}", i), position));
+    }
+
+    // Animate objects forever
+    serverScene->SubscribeToEvent(serverScene, E_SCENEUPDATE,
+        [&](StringHash, VariantMap& eventData)
+    {
+        const float timeStep = eventData[SceneUpdate::P_TIMESTEP].GetFloat();
+        for (Node* node : serverNodes)
+            node->Translate(timeStep * moveSpeed * Vector3::FORWARD, TS_PARENT);
+    });
+
+    // Allow only a few object updates per frame
+    Tests::NetworkSimulator sim(serverScene);
+    auto& serverReplicator = *serverScene->GetComponent<ReplicationManager>()->GetServerReplicator();
+    serverReplicator.SetSetting(NetworkSettings::UnreliableUpdateBudget, 160u);
+
+    sim.AddClient(clientScene, quality);
+    sim.SimulateTime(9.0f);
+
+    // Expect all objects to be updated eventually
+    const auto& clientReplica = *clientScene->GetComponent<ReplicationManager>()->GetClientReplica();
+    const NetworkTime replicaTime = clientReplica.GetReplicaTime();
+    for (unsigned i = 0; i < numNodes; ++i)
+    {
+        auto serverTransform = serverNodes[i]->GetComponent<ReplicatedTransform>();
+        auto clientNode = clientScene->GetChild(Format("Node {}", i), true);
+        REQUIRE(clientNode);
+        REQUIRE(serverTransform->SampleTemporalPosition(replicaTime).value_.Equals(clientNode->GetWorldPosition(), 0.25f));
+    }
+}
+
+TEST_CASE("Unreliable updates are delta compressed against acknowledged frames")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    context->GetSubsystem<Network>()->SetUpdateFps(Tests::NetworkSimulator::FramesInSecond);
+
+    auto prefab = Tests::GetOrCreateResource<PrefabResource>(context, "@/SceneSynchronization/SimpleTest.prefab", CreateSimpleTestPrefab);
+
+    // Encoding is lossless and skips unchanged bytes
+    {
+        const ByteVector baseline{1, 2, 3, 4, 5, 6, 7, 8};
+        const ByteVector data{1, 2, 3, 4, 5, 6, 9, 8, 10};
+
+        VectorBuffer encodedData;
+        EncodeDeltaAgainstBaseline(baseline, data, encodedData);
+        CHECK(encodedData.GetSize() < data.size());
+
+        ByteVector decodedData;
+        encodedData.Seek(0);
+        REQUIRE(DecodeDeltaAgainstBaseline(baseline, encodedData, decodedData));
+        CHECK(decodedData == data);
+    }
+
+    // Baselines received out of order don't evict newer ones
+    {
+        ea::vector<UnreliableDeltaBaseline> history;
+        StoreDeltaBaseline(history, NetworkFrame{11}, ByteVector{2}, 4);
+        StoreDeltaBaseline(history, NetworkFrame{10}, ByteVector{1}, 4);
+        StoreDeltaBaseline(history, NetworkFrame{11}, ByteVector{3}, 4);
+        REQUIRE(history.size() == 2);
+        CHECK(history[0].frame_ == NetworkFrame{10});
+        CHECK(history[1].frame_ == NetworkFrame{11});
+        CHECK(history[1].data_ == ByteVector{3});
+
+        StoreDeltaBaseline(history, NetworkFrame{14}, ByteVector{4}, 4);
+        REQUIRE(history.size() == 2);
+        CHECK(history[0].frame_ == NetworkFrame{11});
+        CHECK(history[1].frame_ == NetworkFrame{14});
+    }
+
+    // Setup scenes
+    const auto quality = Tests::ConnectionQuality{0.08f, 0.12f, 0.20f, 0.1f, 0.1f};
+    const float moveSpeed = 1.0f;
+    auto serverScene = MakeShared<Scene>(context);
+    auto clientScene = MakeShared<Scene>(context);
+
+    Node* serverNode = Tests::SpawnOnServer<BehaviorNetworkObject>(serverScene, prefab, "Node");
+    auto serverTransform = serverNode->GetComponent<ReplicatedTransform>();
+
+    // Animate objects forever
+    serverScene->SubscribeToEvent(serverScene, E_SCENEUPDATE,
+        [&](StringHash, VariantMap& eventData)
+    {
+        const float timeStep = eventData[SceneUpdate::P_TIMESTEP].GetFloat();
+        serverNode->Translate(timeStep * moveSpeed * Vector3::FORWARD, TS_PARENT);
+    });
+
+    // Enable delta compression and lose some messages
+    Tests::NetworkSimulator sim(serverScene);
+    auto& serverReplicator = *serverScene->GetComponent<ReplicationManager>()->GetServerReplicator();
+    serverReplicator.SetSetting(NetworkSettings::UnreliableDeltaWindow, 16u);
+
+    sim.AddClient(clientScene, quality);
+    sim.SimulateTime(4.0f);
+
+    const auto& clientReplica = *clientScene->GetComponent<ReplicationManager>()->GetClientReplica();
+    const unsigned numDeltaUpdates = clientReplica.GetNumUnreliableDeltaUpdates();
+    const unsigned numDeltaFailures = clientReplica.GetNumUnreliableDeltaFailures();
+    sim.SimulateTime(5.0f);
+
+    // Expect updates to be decoded from deltas despite reordering
+    const unsigned numNewDeltaUpdates = clientReplica.GetNumUnreliableDeltaUpdates() - numDeltaUpdates;
+    const unsigned numNewDeltaFailures = clientReplica.GetNumUnreliableDeltaFailures() - numDeltaFailures;
+    CHECK(numNewDeltaUpdates >= 2 * Tests::NetworkSimulator::FramesInSecond);
+    CHECK(numNewDeltaFailures * 10 < numNewDeltaUpdates);
+
+    // Expect object to be synchronized despite lost baselines
+    const NetworkTime replicaTime = clientReplica.GetReplicaTime();
+    auto clientNode = clientScene->GetChild("Node", true);
+    REQUIRE(clientNode);
+    REQUIRE(serverTransform->SampleTemporalPosition(replicaTime).value_.Equals(clientNode->GetWorldPosition(), 0.05f));
+}
+
 TEST_CASE("Prefabs are replicated on clients")
 {
     auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
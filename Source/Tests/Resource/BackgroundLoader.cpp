@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Resource/ResourceCache.h>
+#include <Urho3D/Resource/XMLFile.h>
+
+namespace Tests
+{
+
+TEST_CASE("Resources are loaded in background by multiple threads")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto cache = context->GetSubsystem<ResourceCache>();
+
+    const ea::vector<ea::string> resourceNames = {
+        "Techniques/BasicVColUnlitAlpha.xml",
+        "Techniques/DeferredDecalFar.xml",
+        "Techniques/DeferredDecalNear.xml",
+        "Techniques/Diff.xml",
+        "Techniques/DiffAO.xml",
+    };
+
+    for (const ea::string& name : resourceNames)
+        cache->ReleaseResource(XMLFile::GetTypeStatic(), name, true);
+
+    for (const ea::string& name : resourceNames)
+        REQUIRE(cache->BackgroundLoadResource<XMLFile>(name));
+    REQUIRE(cache->BackgroundLoadResource<XMLFile>("Techniques/Missing.xml", false));
+
+    for (unsigned i = 0; i < 1000 && cache->GetNumBackgroundLoadResources() > 0; ++i)
+        Tests::RunFrame(context, 0.01f);
+    REQUIRE(cache->GetNumBackgroundLoadResources() == 0);
+
+    for (const ea::string& name : resourceNames)
+    {
+        const auto xmlFile = cache->GetExistingResource<XMLFile>(name);
+        REQUIRE(xmlFile);
+        CHECK(xmlFile->GetRoot().GetName() == "technique");
+    }
+    CHECK_FALSE(cache->GetExistingResource<XMLFile>("Techniques/Missing.xml"));
+}
+
+TEST_CASE("Resource load requests are completed or cancelled")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto cache = context->GetSubsystem<ResourceCache>();
+
+    cache->ReleaseResource(XMLFile::GetTypeStatic(), "Techniques/Diff.xml", true);
+    cache->ReleaseResource(XMLFile::GetTypeStatic(), "Techniques/DiffAO.xml", true);
+
+    unsigned numCallbacks = 0;
+    Resource* loadedResource = nullptr;
+    const auto request = cache->RequestResource<XMLFile>("Techniques/Diff.xml", 1.0f,
+        [&](Resource* resource, bool success)
+    {
+        ++numCallbacks;
+        loadedResource = success ? resource : nullptr;
+    });
+
+    bool cancelledCallback = false;
+    const auto cancelledRequest = cache->RequestResource<XMLFile>("Techniques/DiffAO.xml", 0.0f,
+        [&](Resource* resource, bool success) { cancelledCallback = true; });
+    cancelledRequest->Cancel();
+
+    bool missingSuccess = true;
+    const auto missingRequest = cache->RequestResource<XMLFile>("Techniques/Missing.xml", 2.0f,
+        [&](Resource* resource, bool success) { missingSuccess = success; }, false);
+
+    request->SetPriority(3.0f);
+    CHECK(request->GetPriority() == 3.0f);
+
+    for (unsigned i = 0; i < 1000 && cache->GetNumBackgroundLoadResources() > 0; ++i)
+        Tests::RunFrame(context, 0.01f);
+    REQUIRE(cache->GetNumBackgroundLoadResources() == 0);
+
+    CHECK(request->IsCompleted());
+    CHECK(request->IsSuccessful());
+    CHECK(numCallbacks == 1);
+    CHECK(loadedResource == cache->GetExistingResource<XMLFile>("Techniques/Diff.xml"));
+    CHECK(request->GetResource() == loadedResource);
+
+    CHECK(cancelledRequest->IsCancelled());
+    CHECK_FALSE(cancelledRequest->IsCompleted());
+    CHECK_FALSE(cancelledCallback);
+
+    CHECK(missingRequest->IsCompleted());
+    CHECK_FALSE(missingRequest->IsSuccessful());
+    CHECK_FALSE(missingSuccess);
+
+    // Already loaded resource is returned immediately
+    bool immediateCallback = false;
+    const auto immediateRequest = cache->RequestResource<XMLFile>("Techniques/Diff.xml", 0.0f,
+        [&](Resource* resource, bool success) { immediateCallback = success; });
+    CHECK(immediateCallback);
+    CHECK(immediateRequest->GetResource() == loadedResource);
+}
+
+}
@@ -23,6 +23,7 @@
 #include "../CommonUtils.h"
 #include "Urho3D/IO/MemoryBuffer.h"
 #include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/IO/VectorBuffer.h>
 #include <Urho3D/Resource/Image.h>
 
 namespace Tests
@@ -98,4 +99,56 @@ TEST_CASE("DXT, ETC and PVRTC images are decompressed")
     REQUIRE(CompareImages(*imageReference, *imagePVRTC4, false) < 0.15f);
 }
 
+TEST_CASE("Images are compressed to DXT and ETC formats")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    const auto imageReference = ReadImage(context, PNG, CF_NONE);
+
+    for (const CompressedFormat format : {CF_DXT1, CF_DXT5, CF_ETC1, CF_ETC2_RGB, CF_ETC2_RGBA})
+    {
+        VectorBuffer buffer;
+        REQUIRE(imageReference->SaveCompressedDDS(buffer, format));
+
+        buffer.Seek(0);
+        auto image = MakeShared<Image>(context);
+        REQUIRE(image->BeginLoad(buffer));
+        REQUIRE(image->GetCompressedFormat() == format);
+        REQUIRE(image->GetNumCompressedLevels() == 5);
+
+        const bool hasAlpha = format == CF_DXT5 || format == CF_ETC2_RGBA;
+        const auto decompressed = image->GetDecompressedImageLevel(0)->ConvertToRGBA();
+        REQUIRE(CompareImages(*imageReference, *decompressed, hasAlpha) < 0.05f);
+    }
+}
+
+TEST_CASE("Image resize averages all source pixels when reducing size")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    // Checkerboard with 1-pixel cells averages to uniform gray
+    auto image = MakeShared<Image>(context);
+    image->SetSize(8, 8, 4);
+    for (const IntVector2 index : IntRect(IntVector2::ZERO, IntVector2(8, 8)))
+        image->SetPixelInt(index.x_, index.y_, (index.x_ + index.y_) % 2 ? 0xffffffff : 0xff000000);
+
+    REQUIRE(image->Resize(2, 2));
+    REQUIRE(image->GetSize() == IntVector3{2, 2, 1});
+    for (const IntVector2 index : IntRect(IntVector2::ZERO, IntVector2(2, 2)))
+    {
+        const unsigned color = image->GetPixelInt(index.x_, index.y_);
+        CHECK((color & 0xff) >= 127);
+        CHECK((color & 0xff) <= 128);
+        CHECK((color >> 24) == 0xff);
+    }
+
+    // Same size resize keeps pixels intact
+    const auto imageReference = ReadImage(context, PNG, CF_NONE);
+    auto imageCopy = MakeShared<Image>(context);
+    imageCopy->SetSize(imageReference->GetWidth(), imageReference->GetHeight(), imageReference->GetComponents());
+    imageCopy->SetData(imageReference->GetData());
+    REQUIRE(imageCopy->Resize(imageReference->GetWidth(), imageReference->GetHeight()));
+    REQUIRE(CompareImages(*imageReference, *imageCopy, true) == 0.0f);
+}
+
 } // namespace Tests
@@ -181,6 +181,44 @@ TEST_CASE("Animation of hierarchical AnimatedModels is stable")
         REQUIRE(positions[i].x_ == i * -0.125f);
 }
 
+TEST_CASE("Passive bone nodes are not updated if skipped")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto model = Tests::GetOrCreateResource<Model>(context, "@Tests/AnimationController/SkinnedModel.mdl", CreateTestSkinnedModel);
+    auto animationTranslateX = Tests::GetOrCreateResource<Animation>(context, "@Tests/AnimationController/TranslateX.ani", CreateTestTranslateXAnimation);
+
+    auto scene = MakeShared<Scene>(context);
+    scene->CreateComponent<Octree>();
+
+    const auto createModel = [&](bool skipPassiveBoneNodes)
+    {
+        Node* node = scene->CreateChild("Model");
+        auto animatedModel = node->CreateComponent<AnimatedModel>();
+        animatedModel->SetModel(model);
+        animatedModel->SetSkipPassiveBoneNodes(skipPassiveBoneNodes);
+
+        auto controller = node->CreateComponent<AnimationController>();
+        controller->Play(animationTranslateX->GetName(), 0, true);
+        return animatedModel;
+    };
+
+    auto referenceModel = createModel(false);
+    auto skippedModel = createModel(true);
+
+    Node* referenceBoneNode = referenceModel->GetNode()->GetChild("Quad 2", true);
+    Node* skippedBoneNode = skippedModel->GetNode()->GetChild("Quad 2", true);
+    const Vector3 initialPosition = skippedBoneNode->GetPosition();
+
+    Tests::RunFrame(context, 0.5f, 0.05f);
+    REQUIRE_FALSE(referenceBoneNode->GetPosition().Equals(initialPosition));
+    REQUIRE(skippedBoneNode->GetPosition().Equals(initialPosition));
+
+    // Nodes are synchronized when skipping is disabled
+    skippedModel->SetSkipPassiveBoneNodes(false);
+    REQUIRE(skippedBoneNode->GetPosition().Equals(referenceBoneNode->GetPosition()));
+}
+
 TEST_CASE("Animations are blended with linear interpolation")
 {
     auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
@@ -44,3 +44,38 @@ TEST_CASE("Load node from XML node file")
     CHECK(child->GetName() == "NodeName");
     CHECK(child->GetComponent<StaticModel>());
 };
+
+TEST_CASE("Dirty world transforms are updated in batch")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    scene->SetBatchedTransformUpdate(true);
+
+    ea::vector<Node*> leaves;
+    for (unsigned i = 0; i < 50; ++i)
+    {
+        Node* parent = scene->CreateChild();
+        parent->SetPosition({static_cast<float>(i), 0.0f, 0.0f});
+        Node* child = parent->CreateChild();
+        child->SetPosition({0.0f, 1.0f, 0.0f});
+        leaves.push_back(child->CreateChild());
+    }
+    scene->UpdateDirtyTransforms();
+
+    for (Node* leaf : leaves)
+        CHECK_FALSE(leaf->IsDirty());
+
+    // Move both a node and its descendant so that the queued subtrees overlap
+    for (unsigned i = 0; i < leaves.size(); ++i)
+    {
+        leaves[i]->SetPosition({0.0f, 0.0f, 2.0f});
+        leaves[i]->GetParent()->GetParent()->SetRotation(Quaternion{90.0f, Vector3::UP});
+    }
+    scene->UpdateDirtyTransforms();
+
+    for (unsigned i = 0; i < leaves.size(); ++i)
+    {
+        REQUIRE_FALSE(leaves[i]->IsDirty());
+        CHECK(leaves[i]->GetWorldPosition().Equals({static_cast<float>(i) + 2.0f, 1.0f, 0.0f}));
+    }
+}
@@ -366,6 +366,35 @@ TEST_CASE("Serializable is loaded from and to prefab")
     }
 }
 
+TEST_CASE("Serializable prefab is exported repeatedly after modification")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto guard = Tests::MakeScopedReflection<Tests::RegisterObject<TestComponent>>(context);
+
+    SerializablePrefab prefab;
+    prefab.SetType(TestComponent::GetTypeNameStatic());
+    prefab.GetMutableAttributes().emplace_back("Enum").SetValue("Green");
+    prefab.GetMutableAttributes().emplace_back("UnknownAttribute").SetValue(1);
+    prefab.GetMutableAttributes().emplace_back("Vector").SetValue(IntVector2{1, 2});
+
+    for (unsigned i = 0; i < 2; ++i)
+    {
+        TestComponent dest(context);
+        prefab.Export(&dest);
+        CHECK(dest.enum_ == TestEnum::Green);
+        CHECK(dest.vector_ == IntVector2{1, 2});
+    }
+
+    prefab.GetMutableAttributes()[0].SetValue("Blue");
+    prefab.GetMutableAttributes().emplace_back("UnchangedString").SetValue("changed");
+
+    TestComponent dest(context);
+    prefab.Export(&dest);
+    CHECK(dest.enum_ == TestEnum::Blue);
+    CHECK(dest.vector_ == IntVector2{1, 2});
+    CHECK(dest.unchangedString_ == "changed");
+}
+
 TEST_CASE("Serializable prefab is serialized as binary")
 {
     auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
@@ -679,6 +708,37 @@ TEST_CASE("Prefab is loaded to Node")
     }
 }
 
+TEST_CASE("Prefab is instantiated multiple times at once")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto guard = Tests::MakeScopedReflection<Tests::RegisterObject<TestComponent>>(context);
+
+    const NodePrefab source = MakeTestPrefab();
+
+    auto scene = MakeShared<Scene>(context);
+    const Transform transforms[] = {
+        Transform{Vector3{1, 0, 0}},
+        Transform{Vector3{2, 0, 0}, Quaternion{90.0f, Vector3::UP}},
+        Transform{Vector3{3, 0, 0}, Quaternion::IDENTITY, Vector3{2, 2, 2}},
+    };
+
+    const ea::vector<Node*> nodes = scene->InstantiatePrefab(source, transforms);
+    REQUIRE(nodes.size() == 3);
+    CHECK(scene->GetNumChildren() == 3);
+
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        Node* node = nodes[i];
+        CHECK(node->GetParent() == scene);
+        CHECK(node->GetName() == "Apple");
+        CHECK(node->GetNumComponents() == 2);
+        CHECK(node->GetNumChildren() == 4);
+        CHECK(node->GetPosition().Equals(transforms[i].position_));
+        CHECK(node->GetRotation().Equals(transforms[i].rotation_));
+        CHECK(node->GetScale().Equals(transforms[i].scale_));
+    }
+}
+
 TEST_CASE("PrefabWriter iterates over nodes and components")
 {
     auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
@@ -23,7 +23,15 @@
 #include "../CommonUtils.h"
 #include "../SceneUtils.h"
 
+#include <Urho3D/Core/Thread.h>
+#include <Urho3D/Graphics/Octree.h>
 #include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Scene/LogicComponent.h>
+#include <Urho3D/Scene/SceneEvents.h>
+#include <Urho3D/Scene/SceneResource.h>
+#include <Urho3D/Scene/SceneSnapshot.h>
 
 TEST_CASE("Scene lookup")
 {
@@ -55,3 +63,363 @@ TEST_CASE("Scene lookup")
     CHECK(Tests::GetAttributeValue(child20->FindComponentAttribute("@/Name")) == Variant(child20->GetName()));
     CHECK(Tests::GetAttributeValue(child20->FindComponentAttribute("@StaticModel/LOD Bias")) == Variant(1.0f));
 }
+
+namespace
+{
+
+class SceneFileBuffer : public RefCounted, public VectorBuffer
+{
+};
+
+}
+
+TEST_CASE("Scene is loaded asynchronously from binary file")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto sourceScene = MakeShared<Scene>(context);
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        Node* child = sourceScene->CreateChild(Format("Child_{}", i));
+        child->SetPosition(Vector3::ONE * static_cast<float>(i));
+        for (unsigned j = 0; j < 3; ++j)
+        {
+            Node* grandChild = child->CreateChild(Format("Child_{}_{}", i, j));
+            grandChild->CreateChild(Format("Child_{}_{}_0", i, j));
+            grandChild->CreateComponent<StaticModel>()->SetLodBias(static_cast<float>(j + 1));
+        }
+    }
+
+    auto file = MakeShared<SceneFileBuffer>();
+    REQUIRE(sourceScene->Save(*file));
+    file->Seek(0);
+
+    auto scene = MakeShared<Scene>(context);
+    scene->SetAsyncLoadingMs(0);
+    REQUIRE(scene->LoadAsync(AbstractFilePtr(file), LOAD_SCENE));
+
+    for (unsigned i = 0; i < 1000 && scene->IsAsyncLoading(); ++i)
+        Tests::RunFrame(context, 0.01f);
+
+    REQUIRE_FALSE(scene->IsAsyncLoading());
+    REQUIRE(scene->GetNumChildren() == 4);
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        Node* child = scene->GetChild(i);
+        CHECK(child->GetName() == Format("Child_{}", i));
+        CHECK(child->GetPosition().Equals(Vector3::ONE * static_cast<float>(i)));
+        REQUIRE(child->GetNumChildren() == 3);
+        for (unsigned j = 0; j < 3; ++j)
+        {
+            Node* grandChild = child->GetChild(j);
+            CHECK(grandChild->GetName() == Format("Child_{}_{}", i, j));
+            CHECK(grandChild->GetID() == sourceScene->GetChild(Format("Child_{}_{}", i, j), true)->GetID());
+            REQUIRE(grandChild->GetNumChildren() == 1);
+            CHECK(grandChild->GetChild(0u)->GetName() == Format("Child_{}_{}_0", i, j));
+
+            auto staticModel = grandChild->GetComponent<StaticModel>();
+            REQUIRE(staticModel);
+            CHECK(staticModel->GetLodBias() == static_cast<float>(j + 1));
+        }
+    }
+}
+
+TEST_CASE("Plain attributes are serialized in binary form without Variant conversion")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+
+    auto staticModel = scene->CreateChild("Child")->CreateComponent<StaticModel>();
+    staticModel->SetLodBias(2.5f);
+    staticModel->SetCastShadows(true);
+    staticModel->SetViewMask(0x00ff00ff);
+
+    const auto& attributes = *staticModel->GetAttributes();
+    REQUIRE(ea::any_of(attributes.begin(), attributes.end(),
+        [](const AttributeInfo& attr) { return attr.accessor_->HasBinaryAccess(); }));
+
+    // Binary data should match Variant serialization
+    VectorBuffer expectedData;
+    for (const AttributeInfo& attr : attributes)
+    {
+        if (!attr.ShouldSave())
+            continue;
+
+        Variant value;
+        staticModel->OnGetAttribute(attr, value);
+        REQUIRE(expectedData.WriteVariantData(value));
+    }
+
+    VectorBuffer data;
+    REQUIRE(staticModel->Serializable::Save(data));
+    REQUIRE(data.GetBuffer() == expectedData.GetBuffer());
+
+    auto loadedModel = scene->CreateChild("Loaded")->CreateComponent<StaticModel>();
+    data.Seek(0);
+    REQUIRE(loadedModel->Serializable::Load(data));
+    CHECK(loadedModel->GetLodBias() == 2.5f);
+    CHECK(loadedModel->GetCastShadows() == true);
+    CHECK(loadedModel->GetViewMask() == 0x00ff00ff);
+}
+
+namespace
+{
+
+class CountingLogicComponent : public LogicComponent
+{
+    URHO3D_OBJECT(CountingLogicComponent, LogicComponent);
+
+public:
+    explicit CountingLogicComponent(Context* context) : LogicComponent(context) {}
+
+    void DelayedStart() override
+    {
+        ++numDelayedStarts_;
+        isDelayedStartInMainThread_ = Thread::IsMainThread();
+    }
+    void Update(float timeStep) override
+    {
+        ++numUpdates_;
+        if (removeOnUpdate_)
+            removeOnUpdate_->Remove();
+    }
+    void PostUpdate(float timeStep) override { ++numPostUpdates_; }
+
+    unsigned numDelayedStarts_{};
+    unsigned numUpdates_{};
+    unsigned numPostUpdates_{};
+    bool isDelayedStartInMainThread_{};
+    WeakPtr<Node> removeOnUpdate_;
+};
+
+class ThreadSafeLogicComponent : public LogicComponent
+{
+    URHO3D_OBJECT(ThreadSafeLogicComponent, LogicComponent);
+
+public:
+    explicit ThreadSafeLogicComponent(Context* context) : LogicComponent(context) {}
+
+    bool IsUpdateThreadSafe() const override { return true; }
+    void Update(float timeStep) override { elapsedTime_ += timeStep; }
+
+    float elapsedTime_{};
+};
+
+class LatePostUpdateComponent : public LogicComponent
+{
+    URHO3D_OBJECT(LatePostUpdateComponent, LogicComponent);
+
+public:
+    explicit LatePostUpdateComponent(Context* context) : LogicComponent(context) {}
+
+    bool IsUpdateThreadSafe() const override { return true; }
+    StringHash GetPostUpdateEvent() const override { return E_SCENEDRAWABLEUPDATEFINISHED; }
+    void PostUpdate(float timeStep) override { node_->Translate(Vector3::UP * timeStep); }
+};
+
+}
+
+TEST_CASE("Logic components are updated directly by scene")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto guard = Tests::MakeScopedReflection<CountingLogicComponent, ThreadSafeLogicComponent>(context);
+    auto scene = MakeShared<Scene>(context);
+
+    auto first = scene->CreateChild()->CreateComponent<CountingLogicComponent>();
+    auto second = scene->CreateChild()->CreateComponent<CountingLogicComponent>();
+    auto third = scene->CreateChild()->CreateComponent<CountingLogicComponent>();
+    auto updateOnly = scene->CreateChild()->CreateComponent<CountingLogicComponent>();
+    updateOnly->SetUpdateEventMask(USE_UPDATE);
+
+    ea::vector<ThreadSafeLogicComponent*> threadSafeComponents;
+    for (unsigned i = 0; i < 200; ++i)
+        threadSafeComponents.push_back(scene->CreateChild()->CreateComponent<ThreadSafeLogicComponent>());
+
+    // Removal of another component during update is deferred
+    first->removeOnUpdate_ = third->GetNode();
+    WeakPtr<CountingLogicComponent> weakThird{third};
+
+    scene->Update(0.5f);
+    CHECK(first->numDelayedStarts_ == 1);
+    CHECK(first->numUpdates_ == 1);
+    CHECK(first->numPostUpdates_ == 1);
+    CHECK(second->numUpdates_ == 1);
+    CHECK(updateOnly->numUpdates_ == 1);
+    CHECK(updateOnly->numPostUpdates_ == 0);
+    CHECK(weakThird.Expired());
+
+    second->SetEnabled(false);
+    scene->Update(0.5f);
+    CHECK(first->numDelayedStarts_ == 1);
+    CHECK(first->numUpdates_ == 2);
+    CHECK(first->numPostUpdates_ == 2);
+    CHECK(second->numUpdates_ == 1);
+    CHECK(second->numPostUpdates_ == 1);
+
+    for (ThreadSafeLogicComponent* component : threadSafeComponents)
+        CHECK(component->elapsedTime_ == 1.0f);
+
+    const LogicUpdateQueue& queue = scene->GetLogicUpdateQueue();
+    CHECK(queue.GetNumComponents(LogicUpdatePhase::Update) == 2 + threadSafeComponents.size());
+    CHECK(queue.GetNumComponents(LogicUpdatePhase::PostUpdate) == 1 + threadSafeComponents.size());
+
+    first->GetNode()->Remove();
+    CHECK(queue.GetNumComponents(LogicUpdatePhase::Update) == 1 + threadSafeComponents.size());
+    CHECK(queue.GetNumComponents(LogicUpdatePhase::PostUpdate) == threadSafeComponents.size());
+}
+
+TEST_CASE("Logic components of independent scenes are updated concurrently")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto guard = Tests::MakeScopedReflection<CountingLogicComponent, ThreadSafeLogicComponent>(context);
+
+    ea::vector<SharedPtr<Scene>> scenes;
+    ea::vector<Scene*> scenePtrs;
+    ea::vector<CountingLogicComponent*> countingComponents;
+    ea::vector<ThreadSafeLogicComponent*> threadSafeComponents;
+    for (unsigned i = 0; i < 8; ++i)
+    {
+        auto scene = MakeShared<Scene>(context);
+        countingComponents.push_back(scene->CreateChild()->CreateComponent<CountingLogicComponent>());
+        for (unsigned j = 0; j < 100; ++j)
+            threadSafeComponents.push_back(scene->CreateChild()->CreateComponent<ThreadSafeLogicComponent>());
+        scenes.push_back(scene);
+        scenePtrs.push_back(scene);
+    }
+
+    Scene::UpdateLogicComponents(scenePtrs, 0.5f);
+    Scene::UpdateLogicComponents(scenePtrs, 0.5f);
+
+    for (Scene* scene : scenePtrs)
+        CHECK(scene->GetElapsedTime() == 1.0f);
+    for (CountingLogicComponent* component : countingComponents)
+    {
+        CHECK(component->numDelayedStarts_ == 1);
+        CHECK(component->isDelayedStartInMainThread_);
+        CHECK(component->numUpdates_ == 2);
+        CHECK(component->numPostUpdates_ == 2);
+    }
+    for (ThreadSafeLogicComponent* component : threadSafeComponents)
+        CHECK(component->elapsedTime_ == 1.0f);
+}
+
+TEST_CASE("Logic components are post-updated after drawable update")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto guard = Tests::MakeScopedReflection<LatePostUpdateComponent>(context);
+    auto scene = MakeShared<Scene>(context);
+    auto octree = scene->CreateComponent<Octree>();
+    Node* parentNode = scene->CreateChild("Parent");
+
+    ea::vector<Node*> nodes;
+    for (unsigned i = 0; i < 200; ++i)
+    {
+        Node* node = parentNode->CreateChild();
+        node->CreateComponent<StaticModel>();
+        node->CreateComponent<LatePostUpdateComponent>();
+        nodes.push_back(node);
+    }
+
+    const LogicUpdateQueue& queue = scene->GetLogicUpdateQueue();
+    CHECK(queue.GetNumComponents(LogicUpdatePhase::PostUpdate) == 0);
+    CHECK(queue.GetNumComponents(LogicUpdatePhase::DrawableUpdateFinished) == nodes.size());
+
+    scene->Update(0.5f);
+    CHECK(nodes[0]->GetPosition() == Vector3::ZERO);
+
+    // Shared parent is dirty when the components are updated
+    parentNode->SetPosition(Vector3::ONE);
+
+    FrameInfo frameInfo;
+    frameInfo.timeStep_ = 0.5f;
+    octree->Update(frameInfo);
+    for (Node* node : nodes)
+    {
+        CHECK(node->GetPosition() == Vector3::UP * 0.5f);
+        CHECK(node->GetWorldPosition().Equals(Vector3::ONE + Vector3::UP * 0.5f));
+    }
+
+    nodes[0]->Remove();
+    CHECK(queue.GetNumComponents(LogicUpdatePhase::DrawableUpdateFinished) == nodes.size() - 1);
+}
+
+TEST_CASE("Scene component index is dense and can be iterated in parallel")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto scene = MakeShared<Scene>(context);
+    scene->CreateComponentIndex<StaticModel>();
+
+    ea::vector<SharedPtr<StaticModel>> models;
+    for (unsigned i = 0; i < 100; ++i)
+        models.emplace_back(scene->CreateChild()->CreateComponent<StaticModel>());
+
+    const SceneComponentIndex& index = scene->GetComponentIndex<StaticModel>();
+    REQUIRE(index.Size() == 100);
+
+    // Removed component is replaced with the last one
+    models[10]->Remove();
+    models[99]->GetNode()->Remove();
+    CHECK(index.Size() == 98);
+    for (unsigned i = 0; i < 100; ++i)
+        CHECK(index.Contains(models[i]) == (i != 10 && i != 99));
+
+    std::atomic<unsigned> numProcessed{};
+    scene->ForEachComponentParallel<StaticModel>(8, [&](unsigned /*index*/, StaticModel* model)
+    {
+        if (model->GetNode())
+            ++numProcessed;
+    });
+    CHECK(numProcessed == 98);
+}
+
+TEST_CASE("Scene snapshot is saved independently from live scene")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    auto sceneResource = MakeShared<SceneResource>(context);
+    Scene* scene = sceneResource->GetScene();
+
+    scene->CreateComponent<Octree>();
+    auto child0 = scene->CreateChild("Child_0");
+    child0->SetPosition({1.0f, 2.0f, 3.0f});
+    child0->CreateComponent<StaticModel>();
+    auto child1 = child0->CreateChild("Child_1");
+    child1->CreateComponent<StaticModel>()->SetCastShadows(true);
+    scene->CreateChild("Temporary")->SetTemporary(true);
+
+    for (const auto format : {InternalResourceFormat::Json, InternalResourceFormat::Xml, InternalResourceFormat::Binary})
+    {
+        VectorBuffer expectedBuffer;
+        REQUIRE(sceneResource->Save(expectedBuffer, format));
+
+        const SceneSnapshot snapshot{scene, format};
+        REQUIRE_FALSE(snapshot.IsEmpty());
+
+        // Modification of the scene after capture doesn't affect the snapshot
+        auto extraNode = scene->CreateChild("Extra");
+
+        VectorBuffer snapshotBuffer;
+        REQUIRE(snapshot.Save(snapshotBuffer));
+        CHECK(snapshotBuffer.GetBuffer() == expectedBuffer.GetBuffer());
+
+        // Compressed snapshot is loaded as regular scene
+        VectorBuffer compressedBuffer;
+        REQUIRE(snapshot.Save(compressedBuffer, true));
+
+        auto loadedResource = MakeShared<SceneResource>(context);
+        MemoryBuffer compressedSource{compressedBuffer.GetBuffer()};
+        REQUIRE(loadedResource->Load(compressedSource));
+
+        Scene* loadedScene = loadedResource->GetScene();
+        Node* loadedChild0 = loadedScene->GetChild("Child_0");
+        Node* loadedChild1 = loadedScene->GetChild("Child_1", true);
+        REQUIRE(loadedChild0);
+        REQUIRE(loadedChild1);
+        CHECK(loadedChild0->GetPosition() == Vector3{1.0f, 2.0f, 3.0f});
+        REQUIRE(loadedChild1->GetComponent<StaticModel>());
+        CHECK(loadedChild1->GetComponent<StaticModel>()->GetCastShadows());
+        CHECK_FALSE(loadedScene->GetChild("Extra"));
+        CHECK_FALSE(loadedScene->GetChild("Temporary"));
+
+        extraNode->Remove();
+    }
+}
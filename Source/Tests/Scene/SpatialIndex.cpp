@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+#include "../SceneUtils.h"
+
+#include <Urho3D/Scene/SpatialIndex.h>
+
+namespace
+{
+
+ea::vector<Node*> GetNodes(const ea::vector<SpatialIndexItem*>& items)
+{
+    ea::vector<Node*> nodes;
+    for (SpatialIndexItem* item : items)
+        nodes.push_back(item->GetNode());
+    return nodes;
+}
+
+bool ContainsSameNodes(ea::vector<Node*> lhs, ea::vector<Node*> rhs)
+{
+    ea::sort(lhs.begin(), lhs.end());
+    ea::sort(rhs.begin(), rhs.end());
+    return lhs == rhs;
+}
+
+}
+
+TEST_CASE("SpatialIndex finds items in radius and box")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = MakeShared<Scene>(context);
+    auto spatialIndex = scene->CreateComponent<SpatialIndex>();
+    spatialIndex->SetCellSize(4.0f);
+
+    ea::vector<Node*> nodes;
+    for (int i = 0; i < 10; ++i)
+    {
+        Node* node = scene->CreateChild();
+        node->SetWorldPosition(Vector3{i * 3.0f, 0.0f, 0.0f});
+        auto item = node->CreateComponent<SpatialIndexItem>();
+        item->SetLayerMask(i % 2 == 0 ? 1 : 2);
+        nodes.push_back(node);
+    }
+    nodes[9]->GetComponent<SpatialIndexItem>()->SetRadius(2.0f);
+    spatialIndex->Update();
+
+    ea::vector<SpatialIndexItem*> result;
+
+    spatialIndex->QueryRadius(result, Vector3{6.0f, 0.0f, 0.0f}, 3.5f);
+    REQUIRE(ContainsSameNodes(GetNodes(result), {nodes[1], nodes[2], nodes[3]}));
+
+    spatialIndex->QueryRadius(result, Vector3{6.0f, 0.0f, 0.0f}, 3.5f, 1);
+    REQUIRE(ContainsSameNodes(GetNodes(result), {nodes[2]}));
+
+    // Item radius is taken into account
+    spatialIndex->QueryRadius(result, Vector3{30.0f, 0.0f, 0.0f}, 2.5f);
+    REQUIRE(ContainsSameNodes(GetNodes(result), {nodes[9]}));
+
+    spatialIndex->QueryBox(result, BoundingBox{Vector3{5.0f, -1.0f, -1.0f}, Vector3{13.0f, 1.0f, 1.0f}});
+    REQUIRE(ContainsSameNodes(GetNodes(result), {nodes[2], nodes[3], nodes[4]}));
+
+    // Index is updated when nodes move or are removed
+    nodes[0]->SetWorldPosition(Vector3{12.0f, 0.5f, 0.0f});
+    nodes[3]->Remove();
+    nodes[4]->GetComponent<SpatialIndexItem>()->SetEnabled(false);
+    spatialIndex->Update();
+
+    spatialIndex->QueryBox(result, BoundingBox{Vector3{5.0f, -1.0f, -1.0f}, Vector3{13.0f, 1.0f, 1.0f}});
+    REQUIRE(ContainsSameNodes(GetNodes(result), {nodes[0], nodes[2]}));
+
+    // Cell size change rebuilds the index
+    spatialIndex->SetCellSize(1.0f);
+    spatialIndex->Update();
+
+    spatialIndex->QueryBox(result, BoundingBox{Vector3{5.0f, -1.0f, -1.0f}, Vector3{13.0f, 1.0f, 1.0f}});
+    REQUIRE(ContainsSameNodes(GetNodes(result), {nodes[0], nodes[2]}));
+}
+
+TEST_CASE("SpatialIndex finds nearest items")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto scene = MakeShared<Scene>(context);
+    auto spatialIndex = scene->CreateComponent<SpatialIndex>();
+    spatialIndex->SetCellSize(2.0f);
+
+    ea::vector<Node*> nodes;
+    for (int i = 0; i < 20; ++i)
+    {
+        Node* node = scene->CreateChild();
+        node->SetWorldPosition(Vector3{0.0f, 0.0f, i * i * 1.0f});
+        node->CreateComponent<SpatialIndexItem>();
+        nodes.push_back(node);
+    }
+    spatialIndex->Update();
+
+    ea::vector<SpatialIndexItem*> result;
+
+    spatialIndex->QueryNearest(result, Vector3{0.0f, 0.0f, 51.0f}, 3);
+    REQUIRE(GetNodes(result) == ea::vector<Node*>{nodes[7], nodes[8], nodes[6]});
+
+    spatialIndex->QueryNearest(result, Vector3{0.0f, 0.0f, 1000.0f}, 2);
+    REQUIRE(GetNodes(result) == ea::vector<Node*>{nodes[19], nodes[18]});
+
+    spatialIndex->QueryNearest(result, Vector3{0.0f, 0.0f, 1000.0f}, 2, 100.0f);
+    REQUIRE(result.empty());
+
+    spatialIndex->QueryNearest(result, Vector3{0.0f, 0.0f, 0.0f}, 100);
+    REQUIRE(result.size() == 20);
+    for (unsigned i = 0; i < 20; ++i)
+        REQUIRE(result[i]->GetNode() == nodes[i]);
+}
@@ -0,0 +1,69 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+
+#include <Urho3D/Scene/ValueAnimation.h>
+
+TEST_CASE("ValueAnimation evaluates packed values with binary search")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto animation = MakeShared<ValueAnimation>(context);
+    animation->SetKeyFrame(0.0f, Vector3(0.0f, 0.0f, 0.0f));
+    animation->SetKeyFrame(2.0f, Vector3(4.0f, 0.0f, 0.0f));
+    animation->SetKeyFrame(1.0f, Vector3(2.0f, 2.0f, 0.0f));
+    animation->SetKeyFrame(3.0f, Vector3(0.0f, 0.0f, 0.0f));
+
+    REQUIRE(animation->HasPackedValues());
+
+    animation->SetInterpolationMethod(IM_NONE);
+    REQUIRE(animation->GetAnimationValue(-1.0f) == Variant(Vector3(0.0f, 0.0f, 0.0f)));
+    REQUIRE(animation->GetAnimationValue(1.5f) == Variant(Vector3(2.0f, 2.0f, 0.0f)));
+    REQUIRE(animation->GetAnimationValue(2.0f) == Variant(Vector3(4.0f, 0.0f, 0.0f)));
+
+    animation->SetInterpolationMethod(IM_LINEAR);
+    REQUIRE(animation->GetAnimationValue(0.5f) == Variant(Vector3(1.0f, 1.0f, 0.0f)));
+    REQUIRE(animation->GetAnimationValue(1.5f) == Variant(Vector3(3.0f, 1.0f, 0.0f)));
+    REQUIRE(animation->GetPackedAnimationValue(2.5f).Equals(Vector4(2.0f, 0.0f, 0.0f, 0.0f)));
+    REQUIRE(animation->GetAnimationValue(5.0f) == Variant(Vector3(0.0f, 0.0f, 0.0f)));
+
+    // Closed spline: tangents at key frames 0 and 1 are (-1, 1, 0) and (2, 0, 0)
+    animation->SetInterpolationMethod(IM_SPLINE);
+    animation->SetSplineTension(0.5f);
+    REQUIRE(animation->GetAnimationValue(1.0f) == Variant(Vector3(2.0f, 2.0f, 0.0f)));
+    const Vector3 value = animation->GetAnimationValue(0.5f).GetVector3();
+    REQUIRE(value.Equals(Vector3(0.625f, 1.125f, 0.0f)));
+}
+
+TEST_CASE("ValueAnimation evaluates non-packed values")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+
+    auto animation = MakeShared<ValueAnimation>(context);
+    animation->SetKeyFrame(0.0f, Quaternion::IDENTITY);
+    animation->SetKeyFrame(1.0f, Quaternion(90.0f, Vector3::UP));
+
+    REQUIRE_FALSE(animation->HasPackedValues());
+    REQUIRE(animation->GetAnimationValue(0.5f).GetQuaternion().Equals(Quaternion(45.0f, Vector3::UP)));
+    REQUIRE(animation->GetAnimationValue(2.0f).GetQuaternion().Equals(Quaternion(90.0f, Vector3::UP)));
+}
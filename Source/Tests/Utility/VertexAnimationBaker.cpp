@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../CommonUtils.h"
+#include "../ModelUtils.h"
+
+#include <Urho3D/Resource/Image.h>
+#include <Urho3D/Utility/VertexAnimationBaker.h>
+
+namespace
+{
+
+Vector3 DecodeBakedPosition(const VertexAnimationBakeResult& result, unsigned vertexIndex, unsigned frame)
+{
+    const unsigned width = static_cast<unsigned>(result.layout_.x_);
+    const unsigned rowsPerFrame = static_cast<unsigned>(result.layout_.y_);
+    const unsigned numFrames = static_cast<unsigned>(result.layout_.z_);
+    const unsigned x = vertexIndex % width;
+    const unsigned y = frame * rowsPerFrame + vertexIndex / width;
+
+    const unsigned char* high = result.image_->GetData() + (y * width + x) * 4;
+    const unsigned char* low = result.image_->GetData() + ((y + numFrames * rowsPerFrame) * width + x) * 4;
+    const Vector3 normalized{(high[0] * 256 + low[0]) / 65535.0f, (high[1] * 256 + low[1]) / 65535.0f,
+        (high[2] * 256 + low[2]) / 65535.0f};
+    return result.bounds_.min_ + normalized * result.bounds_.Size();
+}
+
+}
+
+TEST_CASE("Skeletal animation is baked into vertex animation texture")
+{
+    auto context = Tests::GetOrCreateContext(Tests::CreateCompleteContext);
+    const auto model = Tests::CreateSkinnedQuad_Model(context)->ExportModel();
+    const auto animation = Tests::CreateLoopedTranslationAnimation(
+        context, "", "Quad 2", {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 2.0f);
+
+    auto baker = MakeShared<VertexAnimationBaker>(context);
+    VertexAnimationBakeResult result;
+    REQUIRE(baker->Bake(model, animation, 2.0f, result));
+
+    // 2 quads, 4 frames, 3 blocks of rows
+    REQUIRE(result.layout_ == Vector4(8.0f, 1.0f, 4.0f, 2.0f));
+    REQUIRE(result.image_->GetWidth() == 8);
+    REQUIRE(result.image_->GetHeight() == 12);
+
+    REQUIRE(result.model_->GetSkeleton().GetNumBones() == 0);
+
+    auto bakedModelView = MakeShared<ModelView>(context);
+    REQUIRE(bakedModelView->ImportModel(result.model_));
+    const auto& vertices = bakedModelView->GetGeometries()[0].lods_[0].vertices_;
+    REQUIRE(vertices.size() == 8);
+
+    for (unsigned i = 0; i < vertices.size(); ++i)
+    {
+        CHECK(vertices[i].uv_[1].x_ == static_cast<float>(i));
+
+        // First quad is static, second quad moves along X
+        const Vector3 bindPosition = vertices[i].GetPosition();
+        const Vector3 offset = i < 4 ? Vector3::ZERO : Vector3::LEFT;
+        CHECK(DecodeBakedPosition(result, i, 0).Equals(bindPosition, 0.001f));
+        CHECK(DecodeBakedPosition(result, i, 1).Equals(bindPosition + offset, 0.001f));
+        CHECK(DecodeBakedPosition(result, i, 3).Equals(bindPosition - offset, 0.001f));
+    }
+}
@@ -37,6 +37,12 @@ class BOX2D_API b2Island
 public:
 	b2Island(int32 bodyCapacity, int32 contactCapacity, int32 jointCapacity,
 			b2StackAllocator* allocator, b2ContactListener* listener);
+	// Urho3D - parallel island solving
+	/// Construct over external arrays. Positions and velocities are indexed by b2Body::m_islandIndex
+	/// and may be shared between islands as long as body indices are unique.
+	b2Island(b2Body** bodies, int32 bodyCount, b2Contact** contacts, int32 contactCount,
+			b2Joint** joints, int32 jointCount, b2Position* positions, b2Velocity* velocities,
+			b2StackAllocator* allocator, b2ContactListener* listener);
 	~b2Island();
 
 	void Clear()
@@ -89,6 +95,8 @@ public:
 	int32 m_bodyCapacity;
 	int32 m_contactCapacity;
 	int32 m_jointCapacity;
+
+	bool m_ownsArrays;
 };
 
 #endif
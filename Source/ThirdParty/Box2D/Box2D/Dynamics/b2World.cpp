@@ -38,6 +38,7 @@ b2World::b2World(const b2Vec2& gravity)
 {
 	m_destructionListener = nullptr;
 	m_debugDraw = nullptr;
+	m_taskExecutor = nullptr;
 
 	m_bodyList = nullptr;
 	m_jointList = nullptr;
@@ -383,12 +384,8 @@ void b2World::SetAllowSleeping(bool flag)
 }
 
 // Find islands, integrate and solve constraints, solve position constraints
-void b2World::Solve(const b2TimeStep& step)
+void b2World::SolveIslands(const b2TimeStep& step)
 {
-	m_profile.solveInit = 0.0f;
-	m_profile.solveVelocity = 0.0f;
-	m_profile.solvePosition = 0.0f;
-
 	// Size the island for the worst case.
 	b2Island island(m_bodyCount,
 					m_contactManager.m_contactCount,
@@ -546,6 +543,243 @@ void b2World::Solve(const b2TimeStep& step)
 	}
 
 	m_stackAllocator.Free(stack);
+}
+
+// Urho3D - parallel island solving
+struct b2IslandRange
+{
+	int32 bodyStart;
+	int32 bodyCount;
+	int32 contactStart;
+	int32 contactCount;
+	int32 jointStart;
+	int32 jointCount;
+};
+
+struct b2ParallelIslandContext
+{
+	const b2IslandRange* islands;
+	b2Body** bodies;
+	b2Contact** contacts;
+	b2Joint** joints;
+	b2Position* positions;
+	b2Velocity* velocities;
+	b2ContactListener* listener;
+	b2TimeStep step;
+	b2Vec2 gravity;
+	bool allowSleep;
+};
+
+static void b2SolveIslandRange(void* context, int32 begin, int32 end)
+{
+	const b2ParallelIslandContext* ctx = (const b2ParallelIslandContext*)context;
+
+	// Stack allocator is too large for small thread stacks
+	void* mem = b2Alloc(sizeof(b2StackAllocator));
+	b2StackAllocator* allocator = new (mem) b2StackAllocator();
+
+	for (int32 i = begin; i < end; ++i)
+	{
+		const b2IslandRange& range = ctx->islands[i];
+		b2Island island(ctx->bodies + range.bodyStart, range.bodyCount,
+						ctx->contacts + range.contactStart, range.contactCount,
+						ctx->joints + range.jointStart, range.jointCount,
+						ctx->positions, ctx->velocities, allocator, ctx->listener);
+
+		b2Profile profile;
+		island.Solve(&profile, ctx->step, ctx->gravity, ctx->allowSleep);
+	}
+
+	allocator->~b2StackAllocator();
+	b2Free(mem);
+}
+
+// Islands are built sequentially and solved by the task executor. Every body gets a unique
+// solver index, so all islands share the same position and velocity arrays. Static bodies are
+// not added to islands: their state is only read by the constraint solvers. Per-phase solver
+// timings are not collected in this mode.
+void b2World::SolveParallel(const b2TimeStep& step)
+{
+	if (m_bodyCount == 0)
+	{
+		return;
+	}
+
+	const int32 contactCapacity = m_contactManager.m_contactCount;
+	b2Position* positions = (b2Position*)b2Alloc(m_bodyCount * sizeof(b2Position));
+	b2Velocity* velocities = (b2Velocity*)b2Alloc(m_bodyCount * sizeof(b2Velocity));
+	b2Body** bodies = (b2Body**)b2Alloc(m_bodyCount * sizeof(b2Body*));
+	b2Contact** contacts = (b2Contact**)b2Alloc(b2Max(contactCapacity, 1) * sizeof(b2Contact*));
+	b2Joint** joints = (b2Joint**)b2Alloc(b2Max(m_jointCount, 1) * sizeof(b2Joint*));
+	b2IslandRange* islands = (b2IslandRange*)b2Alloc(m_bodyCount * sizeof(b2IslandRange));
+
+	// Clear all the island flags and initialize solver state.
+	int32 solverIndex = 0;
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		b->m_flags &= ~b2Body::e_islandFlag;
+		b->m_islandIndex = solverIndex;
+		positions[solverIndex].c = b->m_sweep.c;
+		positions[solverIndex].a = b->m_sweep.a;
+		velocities[solverIndex].v = b->m_linearVelocity;
+		velocities[solverIndex].w = b->m_angularVelocity;
+		++solverIndex;
+	}
+	for (b2Contact* c = m_contactManager.m_contactList; c; c = c->m_next)
+	{
+		c->m_flags &= ~b2Contact::e_islandFlag;
+	}
+	for (b2Joint* j = m_jointList; j; j = j->m_next)
+	{
+		j->m_islandFlag = false;
+	}
+
+	// Build all awake islands.
+	int32 bodyCount = 0;
+	int32 contactCount = 0;
+	int32 jointCount = 0;
+	int32 islandCount = 0;
+	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2Body*));
+	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+	{
+		if (seed->m_flags & b2Body::e_islandFlag)
+		{
+			continue;
+		}
+
+		if (seed->IsAwake() == false || seed->IsActive() == false)
+		{
+			continue;
+		}
+
+		if (seed->GetType() == b2_staticBody)
+		{
+			continue;
+		}
+
+		b2IslandRange& island = islands[islandCount++];
+		island.bodyStart = bodyCount;
+		island.contactStart = contactCount;
+		island.jointStart = jointCount;
+
+		int32 stackCount = 0;
+		stack[stackCount++] = seed;
+		seed->m_flags |= b2Body::e_islandFlag;
+
+		// Perform a depth first search (DFS) on the constraint graph.
+		while (stackCount > 0)
+		{
+			b2Body* b = stack[--stackCount];
+			b2Assert(b->IsActive() == true);
+			bodies[bodyCount++] = b;
+
+			// Make sure the body is awake (without resetting sleep timer).
+			b->m_flags |= b2Body::e_awakeFlag;
+
+			for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
+			{
+				b2Contact* contact = ce->contact;
+
+				if (contact->m_flags & b2Contact::e_islandFlag)
+				{
+					continue;
+				}
+
+				if (contact->IsEnabled() == false ||
+					contact->IsTouching() == false)
+				{
+					continue;
+				}
+
+				if (contact->m_fixtureA->m_isSensor || contact->m_fixtureB->m_isSensor)
+				{
+					continue;
+				}
+
+				contacts[contactCount++] = contact;
+				contact->m_flags |= b2Contact::e_islandFlag;
+
+				b2Body* other = ce->other;
+				if ((other->m_flags & b2Body::e_islandFlag) || other->GetType() == b2_staticBody)
+				{
+					continue;
+				}
+
+				stack[stackCount++] = other;
+				other->m_flags |= b2Body::e_islandFlag;
+			}
+
+			for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+			{
+				if (je->joint->m_islandFlag == true)
+				{
+					continue;
+				}
+
+				b2Body* other = je->other;
+
+				// Don't simulate joints connected to inactive bodies.
+				if (other->IsActive() == false)
+				{
+					continue;
+				}
+
+				joints[jointCount++] = je->joint;
+				je->joint->m_islandFlag = true;
+
+				if ((other->m_flags & b2Body::e_islandFlag) || other->GetType() == b2_staticBody)
+				{
+					continue;
+				}
+
+				stack[stackCount++] = other;
+				other->m_flags |= b2Body::e_islandFlag;
+			}
+		}
+
+		island.bodyCount = bodyCount - island.bodyStart;
+		island.contactCount = contactCount - island.contactStart;
+		island.jointCount = jointCount - island.jointStart;
+	}
+	m_stackAllocator.Free(stack);
+
+	// Solve islands.
+	b2ParallelIslandContext context;
+	context.islands = islands;
+	context.bodies = bodies;
+	context.contacts = contacts;
+	context.joints = joints;
+	context.positions = positions;
+	context.velocities = velocities;
+	context.listener = m_contactManager.m_contactListener;
+	context.step = step;
+	context.gravity = m_gravity;
+	context.allowSleep = m_allowSleep;
+	m_taskExecutor->ParallelFor(islandCount, b2SolveIslandRange, &context);
+
+	b2Free(islands);
+	b2Free(joints);
+	b2Free(contacts);
+	b2Free(bodies);
+	b2Free(velocities);
+	b2Free(positions);
+}
+
+void b2World::Solve(const b2TimeStep& step)
+{
+	m_profile.solveInit = 0.0f;
+	m_profile.solveVelocity = 0.0f;
+	m_profile.solvePosition = 0.0f;
+
+	// Urho3D - parallel island solving
+	if (m_taskExecutor)
+	{
+		SolveParallel(step);
+	}
+	else
+	{
+		SolveIslands(step);
+	}
 
 	{
 		b2Timer timer;
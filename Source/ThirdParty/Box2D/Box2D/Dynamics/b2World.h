@@ -62,6 +62,15 @@ public:
 	/// remain in scope.
 	void SetContactListener(b2ContactListener* listener);
 
+	// Urho3D - parallel island solving
+	/// Register an executor used to solve islands in parallel. Pass nullptr to solve
+	/// islands sequentially. The executor is owned by you and must remain in scope.
+	/// Warning: b2ContactListener::PostSolve is called from executor threads in this mode.
+	void SetTaskExecutor(b2TaskExecutor* executor) { m_taskExecutor = executor; }
+
+	/// Get the executor used to solve islands in parallel.
+	b2TaskExecutor* GetTaskExecutor() const { return m_taskExecutor; }
+
 	/// Register a routine for debug drawing. The debug draw functions are called
 	/// inside with b2World::DrawDebugData method. The debug draw object is owned
 	/// by you and must remain in scope.
@@ -226,6 +235,8 @@ private:
 	friend class b2Controller;
 
 	void Solve(const b2TimeStep& step);
+	void SolveIslands(const b2TimeStep& step);
+	void SolveParallel(const b2TimeStep& step);
 	void SolveTOI(const b2TimeStep& step);
 
 	void DrawJoint(b2Joint* joint);
@@ -249,6 +260,7 @@ private:
 
 	b2DestructionListener* m_destructionListener;
 	b2Draw* m_debugDraw;
+	b2TaskExecutor* m_taskExecutor;
 
 	// This is used to compute the time step ratio to
 	// support a variable time step.
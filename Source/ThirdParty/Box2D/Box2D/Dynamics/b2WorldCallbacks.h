@@ -153,4 +153,19 @@ public:
 									const b2Vec2& normal, float32 fraction) = 0;
 };
 
+// Urho3D - parallel island solving
+/// Executes independent tasks, possibly in parallel. Used by b2World to solve islands.
+/// See b2World::SetTaskExecutor
+class BOX2D_API b2TaskExecutor
+{
+public:
+	typedef void (*Task)(void* context, int32 begin, int32 end);
+
+	virtual ~b2TaskExecutor() {}
+
+	/// Call task for all indices in [0, count) split into ranges, possibly from
+	/// multiple threads. Must return only after all ranges are processed.
+	virtual void ParallelFor(int32 count, Task task, void* context) = 0;
+};
+
 #endif
@@ -204,11 +204,36 @@ struct dtCrowdAgentDebugInfo
 /// Type for the update callback.
 typedef void (*dtUpdateCallback)(bool positionUpdate, dtCrowdAgent* agent, float* pos, float dt);
 
+// Urho3D: Add parallel update support
+/// Executes loops of the crowd update in parallel.
+class dtCrowdTaskExecutor
+{
+public:
+	/// Type of the task processing items [begin, end) on the thread with the given index.
+	typedef void (*Task)(void* context, int begin, int end, int threadIndex);
+
+	virtual ~dtCrowdTaskExecutor() {}
+
+	/// Returns the max number of threads executing tasks, including the calling thread.
+	virtual int getNumThreads() const = 0;
+
+	/// Processes items [0, count) and returns when all of them are processed.
+	/// Thread index passed to the task must be unique per thread and in range [0, getNumThreads()).
+	virtual void parallelFor(int count, Task task, void* context) = 0;
+};
+
 /// Provides local steering behaviors for a group of agents. 
 /// @ingroup crowd
 class dtCrowd
 {
 	dtUpdateCallback m_updateCallback; // Urho3D
+
+	// Urho3D: Add parallel update support
+	dtCrowdTaskExecutor* m_taskExecutor;
+	int m_numThreads;
+	dtNavMeshQuery** m_threadNavQueries;
+	dtObstacleAvoidanceQuery** m_threadObstacleQueries;
+	int* m_threadVelocitySampleCounts;
 	int m_maxAgents;
 	dtCrowdAgent* m_agents;
 	dtCrowdAgent** m_activeAgents;
@@ -243,6 +268,10 @@ class dtCrowd
 	bool requestMoveTargetReplan(const int idx, dtPolyRef ref, const float* pos);
 
 	void purge();
+
+	// Urho3D: Add parallel update support
+	bool allocThreadData();
+	void freeThreadData();
 	
 public:
 	dtCrowd();
@@ -255,6 +284,16 @@ public:
 	///  @param[in]		nav				The navigation mesh to use for planning.
 	/// @return True if the initialization succeeded.
 	bool init(const int maxAgents, const float maxAgentRadius, dtNavMesh* nav, dtUpdateCallback cb = 0);
+
+	// Urho3D: Add parallel update support
+	/// Sets the executor used to run the update in parallel, or null to run it on the calling thread.
+	/// Allocates navigation and obstacle avoidance queries for each thread of the executor.
+	/// Position update callbacks are still invoked on the calling thread. Velocity update callbacks too.
+	/// @return True if thread data was allocated.
+	bool setTaskExecutor(dtCrowdTaskExecutor* executor);
+
+	/// Gets the executor used to run the update in parallel.
+	dtCrowdTaskExecutor* getTaskExecutor() const { return m_taskExecutor; }
 	
 	/// Sets the shared avoidance configuration for the specified index.
 	///  @param[in]		idx		The index. [Limits: 0 <= value < #DT_CROWD_MAX_OBSTAVOIDANCE_PARAMS]
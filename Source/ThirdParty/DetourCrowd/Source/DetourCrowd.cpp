@@ -333,6 +333,11 @@ Notes:
 
 dtCrowd::dtCrowd() :
 	m_updateCallback(0), // Urho3D: Add update callback support
+	m_taskExecutor(0), // Urho3D: Add parallel update support
+	m_numThreads(0),
+	m_threadNavQueries(0),
+	m_threadObstacleQueries(0),
+	m_threadVelocitySampleCounts(0),
 	m_maxAgents(0),
 	m_agents(0),
 	m_activeAgents(0),
@@ -378,10 +383,89 @@ void dtCrowd::purge()
 	dtFreeObstacleAvoidanceQuery(m_obstacleQuery);
 	m_obstacleQuery = 0;
 	
+	freeThreadData(); // Urho3D
+
 	dtFreeNavMeshQuery(m_navquery);
 	m_navquery = 0;
 }
 
+// Urho3D: Add parallel update support
+bool dtCrowd::setTaskExecutor(dtCrowdTaskExecutor* executor)
+{
+	freeThreadData();
+	m_taskExecutor = executor;
+	return allocThreadData();
+}
+
+bool dtCrowd::allocThreadData()
+{
+	if (!m_taskExecutor || !m_navquery || !m_obstacleQuery)
+		return true;
+
+	const int numThreads = m_taskExecutor->getNumThreads();
+	if (numThreads < 1)
+		return false;
+
+	m_threadNavQueries = (dtNavMeshQuery**)dtAlloc(sizeof(dtNavMeshQuery*)*numThreads, DT_ALLOC_PERM);
+	m_threadObstacleQueries = (dtObstacleAvoidanceQuery**)dtAlloc(sizeof(dtObstacleAvoidanceQuery*)*numThreads, DT_ALLOC_PERM);
+	m_threadVelocitySampleCounts = (int*)dtAlloc(sizeof(int)*numThreads, DT_ALLOC_PERM);
+	if (!m_threadNavQueries || !m_threadObstacleQueries || !m_threadVelocitySampleCounts)
+	{
+		freeThreadData();
+		return false;
+	}
+	memset(m_threadNavQueries, 0, sizeof(dtNavMeshQuery*)*numThreads);
+	memset(m_threadObstacleQueries, 0, sizeof(dtObstacleAvoidanceQuery*)*numThreads);
+	m_numThreads = numThreads;
+
+	// Calling thread uses the queries of the crowd
+	m_threadNavQueries[0] = m_navquery;
+	m_threadObstacleQueries[0] = m_obstacleQuery;
+	for (int i = 1; i < numThreads; ++i)
+	{
+		m_threadNavQueries[i] = dtAllocNavMeshQuery();
+		m_threadObstacleQueries[i] = dtAllocObstacleAvoidanceQuery();
+		if (!m_threadNavQueries[i] || dtStatusFailed(m_threadNavQueries[i]->init(m_navquery->getAttachedNavMesh(), MAX_COMMON_NODES))
+			|| !m_threadObstacleQueries[i] || !m_threadObstacleQueries[i]->init(6, 8))
+		{
+			freeThreadData();
+			return false;
+		}
+	}
+	return true;
+}
+
+void dtCrowd::freeThreadData()
+{
+	for (int i = 1; i < m_numThreads; ++i)
+	{
+		dtFreeNavMeshQuery(m_threadNavQueries[i]);
+		dtFreeObstacleAvoidanceQuery(m_threadObstacleQueries[i]);
+	}
+	dtFree(m_threadNavQueries);
+	m_threadNavQueries = 0;
+	dtFree(m_threadObstacleQueries);
+	m_threadObstacleQueries = 0;
+	dtFree(m_threadVelocitySampleCounts);
+	m_threadVelocitySampleCounts = 0;
+	m_numThreads = 0;
+}
+
+// Urho3D: Run loop body over items [0, count) in parallel if the crowd has thread data
+template <class Body>
+static void runParallel(dtCrowdTaskExecutor* executor, const int numThreads, const int count, Body& body)
+{
+	if (executor && numThreads > 1 && count > 1)
+	{
+		executor->parallelFor(count, [](void* context, int begin, int end, int threadIndex)
+		{
+			(*static_cast<Body*>(context))(begin, end, threadIndex);
+		}, &body);
+	}
+	else if (count > 0)
+		body(0, count, 0);
+}
+
 // Urho3D: Add update callback support
 /// @par
 ///
@@ -466,6 +550,10 @@ bool dtCrowd::init(const int maxAgents, const float maxAgentRadius, dtNavMesh* n
 		return false;
 	if (dtStatusFailed(m_navquery->init(nav, MAX_COMMON_NODES)))
 		return false;
+
+	// Urho3D: Add parallel update support
+	if (!allocThreadData())
+		return false;
 	
 	return true;
 }
@@ -1064,6 +1152,10 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 	dtCrowdAgent** agents = m_activeAgents;
 	int nagents = getActiveAgents(agents, m_maxAgents);
 
+	// Urho3D: Add parallel update support. Each thread uses its own queries, thread 0 uses the crowd ones.
+	dtNavMeshQuery* const* navqueries = m_threadNavQueries ? m_threadNavQueries : &m_navquery;
+	dtObstacleAvoidanceQuery* const* obstacleQueries = m_threadObstacleQueries ? m_threadObstacleQueries : &m_obstacleQuery;
+
 	// Check that all agents still have valid paths.
 	checkPathValidity(agents, nagents, dt);
 	
@@ -1084,67 +1176,79 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 	}
 	
 	// Get nearby navmesh segments and agents to collide with.
-	for (int i = 0; i < nagents; ++i)
+	// Urho3D: Run in parallel, the proximity grid is only read here.
+	auto updateNeighbours = [&](int begin, int end, int threadIndex)
 	{
-		dtCrowdAgent* ag = agents[i];
-		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
-
-		// Update the collision boundary after certain distance has been passed or
-		// if it has become invalid.
-		const float updateThr = ag->params.collisionQueryRange*0.25f;
-		if (dtVdist2DSqr(ag->npos, ag->boundary.getCenter()) > dtSqr(updateThr) ||
-			!ag->boundary.isValid(m_navquery, &m_filters[ag->params.queryFilterType]))
+		dtNavMeshQuery* navquery = navqueries[threadIndex];
+		for (int i = begin; i < end; ++i)
 		{
-			ag->boundary.update(ag->corridor.getFirstPoly(), ag->npos, ag->params.collisionQueryRange,
-								m_navquery, &m_filters[ag->params.queryFilterType]);
+			dtCrowdAgent* ag = agents[i];
+			if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+				continue;
+
+			// Update the collision boundary after certain distance has been passed or
+			// if it has become invalid.
+			const float updateThr = ag->params.collisionQueryRange*0.25f;
+			if (dtVdist2DSqr(ag->npos, ag->boundary.getCenter()) > dtSqr(updateThr) ||
+				!ag->boundary.isValid(navquery, &m_filters[ag->params.queryFilterType]))
+			{
+				ag->boundary.update(ag->corridor.getFirstPoly(), ag->npos, ag->params.collisionQueryRange,
+									navquery, &m_filters[ag->params.queryFilterType]);
+			}
+			// Query neighbour agents
+			ag->nneis = getNeighbours(ag->npos, ag->params.height, ag->params.collisionQueryRange,
+									  ag, ag->neis, DT_CROWDAGENT_MAX_NEIGHBOURS,
+									  agents, nagents, m_grid);
+			for (int j = 0; j < ag->nneis; j++)
+				ag->neis[j].idx = getAgentIndex(agents[ag->neis[j].idx]);
 		}
-		// Query neighbour agents
-		ag->nneis = getNeighbours(ag->npos, ag->params.height, ag->params.collisionQueryRange,
-								  ag, ag->neis, DT_CROWDAGENT_MAX_NEIGHBOURS,
-								  agents, nagents, m_grid);
-		for (int j = 0; j < ag->nneis; j++)
-			ag->neis[j].idx = getAgentIndex(agents[ag->neis[j].idx]);
-	}
+	};
+	runParallel(m_taskExecutor, m_numThreads, nagents, updateNeighbours);
 	
 	// Find next corner to steer to.
-	for (int i = 0; i < nagents; ++i)
+	// Urho3D: Run in parallel, each agent only modifies its own corridor.
+	auto updateCorners = [&](int begin, int end, int threadIndex)
 	{
-		dtCrowdAgent* ag = agents[i];
-		
-		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
-		if (ag->targetState == DT_CROWDAGENT_TARGET_NONE || ag->targetState == DT_CROWDAGENT_TARGET_VELOCITY)
-			continue;
-		
-		// Find corners for steering
-		ag->ncorners = ag->corridor.findCorners(ag->cornerVerts, ag->cornerFlags, ag->cornerPolys,
-												DT_CROWDAGENT_MAX_CORNERS, m_navquery, &m_filters[ag->params.queryFilterType]);
-		
-		// Check to see if the corner after the next corner is directly visible,
-		// and short cut to there.
-		if ((ag->params.updateFlags & DT_CROWD_OPTIMIZE_VIS) && ag->ncorners > 0)
+		dtNavMeshQuery* navquery = navqueries[threadIndex];
+		for (int i = begin; i < end; ++i)
 		{
-			const float* target = &ag->cornerVerts[dtMin(1,ag->ncorners-1)*3];
-			ag->corridor.optimizePathVisibility(target, ag->params.pathOptimizationRange, m_navquery, &m_filters[ag->params.queryFilterType]);
+			dtCrowdAgent* ag = agents[i];
+			
+			if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+				continue;
+			if (ag->targetState == DT_CROWDAGENT_TARGET_NONE || ag->targetState == DT_CROWDAGENT_TARGET_VELOCITY)
+				continue;
+			
+			// Find corners for steering
+			ag->ncorners = ag->corridor.findCorners(ag->cornerVerts, ag->cornerFlags, ag->cornerPolys,
+													DT_CROWDAGENT_MAX_CORNERS, navquery, &m_filters[ag->params.queryFilterType]);
 			
-			// Copy data for debug purposes.
-			if (debugIdx == i)
+			// Check to see if the corner after the next corner is directly visible,
+			// and short cut to there.
+			if ((ag->params.updateFlags & DT_CROWD_OPTIMIZE_VIS) && ag->ncorners > 0)
 			{
-				dtVcopy(debug->optStart, ag->corridor.getPos());
-				dtVcopy(debug->optEnd, target);
+				const float* target = &ag->cornerVerts[dtMin(1,ag->ncorners-1)*3];
+				ag->corridor.optimizePathVisibility(target, ag->params.pathOptimizationRange, navquery, &m_filters[ag->params.queryFilterType]);
+				
+				// Copy data for debug purposes.
+				if (debugIdx == i)
+				{
+					dtVcopy(debug->optStart, ag->corridor.getPos());
+					dtVcopy(debug->optEnd, target);
+				}
 			}
-		}
-		else
-		{
-			// Copy data for debug purposes.
-			if (debugIdx == i)
+			else
 			{
-				dtVset(debug->optStart, 0,0,0);
-				dtVset(debug->optEnd, 0,0,0);
+				// Copy data for debug purposes.
+				if (debugIdx == i)
+				{
+					dtVset(debug->optStart, 0,0,0);
+					dtVset(debug->optEnd, 0,0,0);
+				}
 			}
 		}
-	}
+	};
+	runParallel(m_taskExecutor, m_numThreads, nagents, updateCorners);
 	
 	// Trigger off-mesh connections (depends on corners).
 	for (int i = 0; i < nagents; ++i)
@@ -1271,60 +1375,74 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 	}
 	
 	// Velocity planning.	
-	for (int i = 0; i < nagents; ++i)
+	// Urho3D: Run in parallel, each thread samples with its own obstacle query and counts its own samples.
+	int* velocitySampleCounts = m_threadVelocitySampleCounts ? m_threadVelocitySampleCounts : &m_velocitySampleCount;
+	for (int i = 0; i < m_numThreads; ++i)
+		velocitySampleCounts[i] = 0;
+	auto planVelocities = [&](int begin, int end, int threadIndex)
 	{
-		dtCrowdAgent* ag = agents[i];
-		
-		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
-		
-		if (ag->params.updateFlags & DT_CROWD_OBSTACLE_AVOIDANCE)
+		dtObstacleAvoidanceQuery* obstacleQuery = obstacleQueries[threadIndex];
+		for (int i = begin; i < end; ++i)
 		{
-			m_obstacleQuery->reset();
+			dtCrowdAgent* ag = agents[i];
 			
-			// Add neighbours as obstacles.
-			for (int j = 0; j < ag->nneis; ++j)
-			{
-				const dtCrowdAgent* nei = &m_agents[ag->neis[j].idx];
-				m_obstacleQuery->addCircle(nei->npos, nei->params.radius, nei->vel, nei->dvel);
-			}
-
-			// Append neighbour segments as obstacles.
-			for (int j = 0; j < ag->boundary.getSegmentCount(); ++j)
+			if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+				continue;
+			
+			if (ag->params.updateFlags & DT_CROWD_OBSTACLE_AVOIDANCE)
 			{
-				const float* s = ag->boundary.getSegment(j);
-				if (dtTriArea2D(ag->npos, s, s+3) < 0.0f)
-					continue;
-				m_obstacleQuery->addSegment(s, s+3);
-			}
+				obstacleQuery->reset();
+				
+				// Add neighbours as obstacles.
+				for (int j = 0; j < ag->nneis; ++j)
+				{
+					const dtCrowdAgent* nei = &m_agents[ag->neis[j].idx];
+					obstacleQuery->addCircle(nei->npos, nei->params.radius, nei->vel, nei->dvel);
+				}
 
-			dtObstacleAvoidanceDebugData* vod = 0;
-			if (debugIdx == i) 
-				vod = debug->vod;
-			
-			// Sample new safe velocity.
-			bool adaptive = true;
-			int ns = 0;
+				// Append neighbour segments as obstacles.
+				for (int j = 0; j < ag->boundary.getSegmentCount(); ++j)
+				{
+					const float* s = ag->boundary.getSegment(j);
+					if (dtTriArea2D(ag->npos, s, s+3) < 0.0f)
+						continue;
+					obstacleQuery->addSegment(s, s+3);
+				}
 
-			const dtObstacleAvoidanceParams* params = &m_obstacleQueryParams[ag->params.obstacleAvoidanceType];
+				dtObstacleAvoidanceDebugData* vod = 0;
+				if (debugIdx == i) 
+					vod = debug->vod;
 				
-			if (adaptive)
-			{
-				ns = m_obstacleQuery->sampleVelocityAdaptive(ag->npos, ag->params.radius, ag->desiredSpeed,
-															 ag->vel, ag->dvel, ag->nvel, params, vod);
+				// Sample new safe velocity.
+				bool adaptive = true;
+				int ns = 0;
+
+				const dtObstacleAvoidanceParams* params = &m_obstacleQueryParams[ag->params.obstacleAvoidanceType];
+					
+				if (adaptive)
+				{
+					ns = obstacleQuery->sampleVelocityAdaptive(ag->npos, ag->params.radius, ag->desiredSpeed,
+																ag->vel, ag->dvel, ag->nvel, params, vod);
+				}
+				else
+				{
+					ns = obstacleQuery->sampleVelocityGrid(ag->npos, ag->params.radius, ag->desiredSpeed,
+															ag->vel, ag->dvel, ag->nvel, params, vod);
+				}
+				velocitySampleCounts[threadIndex] += ns;
 			}
 			else
 			{
-				ns = m_obstacleQuery->sampleVelocityGrid(ag->npos, ag->params.radius, ag->desiredSpeed,
-														 ag->vel, ag->dvel, ag->nvel, params, vod);
+				// If not using velocity planning, new velocity is directly the desired velocity.
+				dtVcopy(ag->nvel, ag->dvel);
 			}
-			m_velocitySampleCount += ns;
-		}
-		else
-		{
-			// If not using velocity planning, new velocity is directly the desired velocity.
-			dtVcopy(ag->nvel, ag->dvel);
 		}
+	};
+	runParallel(m_taskExecutor, m_numThreads, nagents, planVelocities);
+	if (m_threadVelocitySampleCounts)
+	{
+		for (int i = 0; i < m_numThreads; ++i)
+			m_velocitySampleCount += m_threadVelocitySampleCounts[i];
 	}
 
 	// Integrate.
@@ -1339,9 +1457,10 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 	// Handle collisions.
 	static const float COLLISION_RESOLVE_FACTOR = 0.7f;
 	
-	for (int iter = 0; iter < 4; ++iter)
+	// Urho3D: Displacements are calculated in parallel, they only read positions of the neighbours.
+	auto calculateDisplacements = [&](int begin, int end, int /*threadIndex*/)
 	{
-		for (int i = 0; i < nagents; ++i)
+		for (int i = begin; i < end; ++i)
 		{
 			dtCrowdAgent* ag = agents[i];
 			const int idx0 = getAgentIndex(ag);
@@ -1396,6 +1515,11 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 				dtVscale(ag->disp, ag->disp, iw);
 			}
 		}
+	};
+
+	for (int iter = 0; iter < 4; ++iter)
+	{
+		runParallel(m_taskExecutor, m_numThreads, nagents, calculateDisplacements);
 		
 		for (int i = 0; i < nagents; ++i)
 		{
@@ -1407,27 +1531,41 @@ void dtCrowd::update(const float dt, dtCrowdAgentDebugInfo* debug)
 		}
 	}
 	
-	for (int i = 0; i < nagents; ++i)
+	// Urho3D: Move agents in parallel, position callbacks are invoked on the calling thread afterwards.
+	auto moveAgents = [&](int begin, int end, int threadIndex)
 	{
-		dtCrowdAgent* ag = agents[i];
-		if (ag->state != DT_CROWDAGENT_STATE_WALKING)
-			continue;
-		
-		// Move along navmesh.
-		ag->corridor.movePosition(ag->npos, m_navquery, &m_filters[ag->params.queryFilterType]);
-		// Get valid constrained position back.
-		dtVcopy(ag->npos, ag->corridor.getPos());
-
-		// If not using path, truncate the corridor to just one poly.
-		if (ag->targetState == DT_CROWDAGENT_TARGET_NONE || ag->targetState == DT_CROWDAGENT_TARGET_VELOCITY)
+		dtNavMeshQuery* navquery = navqueries[threadIndex];
+		for (int i = begin; i < end; ++i)
 		{
-			ag->corridor.reset(ag->corridor.getFirstPoly(), ag->npos);
-			ag->partial = false;
+			dtCrowdAgent* ag = agents[i];
+			if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+				continue;
+			
+			// Move along navmesh.
+			ag->corridor.movePosition(ag->npos, navquery, &m_filters[ag->params.queryFilterType]);
+			// Get valid constrained position back.
+			dtVcopy(ag->npos, ag->corridor.getPos());
+
+			// If not using path, truncate the corridor to just one poly.
+			if (ag->targetState == DT_CROWDAGENT_TARGET_NONE || ag->targetState == DT_CROWDAGENT_TARGET_VELOCITY)
+			{
+				ag->corridor.reset(ag->corridor.getFirstPoly(), ag->npos);
+				ag->partial = false;
+			}
 		}
-		
-		// Urho3D: Update position callback support
-		if (m_updateCallback)
+	};
+	runParallel(m_taskExecutor, m_numThreads, nagents, moveAgents);
+
+	// Urho3D: Update position callback support
+	if (m_updateCallback)
+	{
+		for (int i = 0; i < nagents; ++i)
+		{
+			dtCrowdAgent* ag = agents[i];
+			if (ag->state != DT_CROWDAGENT_STATE_WALKING)
+				continue;
 			m_updateCallback(true, ag, ag->npos, dt);
+		}
 	}
 	
 	// Update agents using off-mesh connection.
@@ -326,6 +326,10 @@ protected:
 	RNS2_BerkleyBindParameters binding;
 
 	unsigned RecvFromLoopInt(void);
+#if defined(__linux__) && !defined(__ANDROID__)
+	// Urho3D: receive multiple datagrams per syscall
+	unsigned RecvFromLoopIntBatched(void);
+#endif
 	SLNet::LocklessUint32_t isRecvFromLoopThreadActive;
 	volatile bool endThreads;
 	// Constructor not called!
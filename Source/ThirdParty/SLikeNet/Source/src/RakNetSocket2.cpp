@@ -313,6 +313,10 @@ RAK_THREAD_DECLARATION(RNS2_Berkley::RecvFromLoop)
 }
 unsigned RNS2_Berkley::RecvFromLoopInt(void)
 {
+#if defined(__linux__) && !defined(__ANDROID__)
+	// Urho3D: receive multiple datagrams per syscall
+	return RecvFromLoopIntBatched();
+#else
 	isRecvFromLoopThreadActive.Increment();
 	
 	while ( endThreads == false )
@@ -339,7 +343,110 @@ unsigned RNS2_Berkley::RecvFromLoopInt(void)
 	isRecvFromLoopThreadActive.Decrement();
 
 	return 0;
+#endif
 }
+#if defined(__linux__) && !defined(__ANDROID__)
+// Urho3D: receive multiple datagrams per syscall
+unsigned RNS2_Berkley::RecvFromLoopIntBatched(void)
+{
+	static const unsigned batchSize = 32;
+
+	RNS2RecvStruct *recvStructs[batchSize];
+	mmsghdr messages[batchSize];
+	iovec buffers[batchSize];
+	sockaddr_storage addresses[batchSize];
+	unsigned numAllocated = 0;
+
+	isRecvFromLoopThreadActive.Increment();
+
+	while ( endThreads == false )
+	{
+		// Structures that were not filled by previous call are reused
+		while (numAllocated < batchSize)
+		{
+			RNS2RecvStruct *recvFromStruct = binding.eventHandler->AllocRNS2RecvStruct(_FILE_AND_LINE_);
+			if (recvFromStruct == NULL)
+				break;
+			recvFromStruct->socket = this;
+			recvStructs[numAllocated++] = recvFromStruct;
+		}
+
+		if (numAllocated == 0)
+		{
+			RakSleep(0);
+			continue;
+		}
+
+		for (unsigned i = 0; i < numAllocated; ++i)
+		{
+			buffers[i].iov_base = recvStructs[i]->data;
+			buffers[i].iov_len = sizeof(recvStructs[i]->data);
+
+			memset(&messages[i], 0, sizeof(mmsghdr));
+			messages[i].msg_hdr.msg_name = &addresses[i];
+			messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+			messages[i].msg_hdr.msg_iov = &buffers[i];
+			messages[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		// Block until at least one datagram is available, then take everything that is already queued
+		const int numReceived = recvmmsg(rns2Socket, messages, numAllocated, MSG_WAITFORONE, NULL);
+		if (numReceived <= 0)
+		{
+			RakSleep(0);
+			continue;
+		}
+
+		const SLNet::TimeUS timeRead = SLNet::GetTimeUS();
+		for (int i = 0; i < numReceived; ++i)
+		{
+			RNS2RecvStruct *recvFromStruct = recvStructs[i];
+			recvFromStruct->bytesRead = static_cast<int>(messages[i].msg_len);
+			recvFromStruct->timeRead = timeRead;
+
+			const sockaddr_storage &theirAddress = addresses[i];
+			if (theirAddress.ss_family == AF_INET)
+			{
+				memcpy(&recvFromStruct->systemAddress.address.addr4, &theirAddress, sizeof(sockaddr_in));
+				recvFromStruct->systemAddress.debugPort = ntohs(recvFromStruct->systemAddress.address.addr4.sin_port);
+			}
+#if RAKNET_SUPPORT_IPV6==1
+			else if (theirAddress.ss_family == AF_INET6)
+			{
+				memcpy(&recvFromStruct->systemAddress.address.addr6, &theirAddress, sizeof(sockaddr_in6));
+				recvFromStruct->systemAddress.debugPort = ntohs(recvFromStruct->systemAddress.address.addr6.sin6_port);
+			}
+#endif
+			else
+			{
+				recvFromStruct->bytesRead = 0;
+			}
+
+			if (recvFromStruct->bytesRead > 0)
+			{
+				RakAssert(recvFromStruct->systemAddress.GetPort());
+				binding.eventHandler->OnRNS2Recv(recvFromStruct);
+			}
+			else
+			{
+				binding.eventHandler->DeallocRNS2RecvStruct(recvFromStruct, _FILE_AND_LINE_);
+			}
+		}
+
+		const unsigned numUnused = numAllocated - static_cast<unsigned>(numReceived);
+		for (unsigned i = 0; i < numUnused; ++i)
+			recvStructs[i] = recvStructs[numReceived + i];
+		numAllocated = numUnused;
+	}
+
+	for (unsigned i = 0; i < numAllocated; ++i)
+		binding.eventHandler->DeallocRNS2RecvStruct(recvStructs[i], _FILE_AND_LINE_);
+
+	isRecvFromLoopThreadActive.Decrement();
+
+	return 0;
+}
+#endif
 RNS2_Berkley::RNS2_Berkley()
 {
 	rns2Socket=(RNS2Socket)INVALID_SOCKET;
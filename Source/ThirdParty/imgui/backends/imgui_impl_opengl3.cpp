@@ -184,6 +184,12 @@ struct ImGui_ImplOpenGL3_Data
     GLsizeiptr      VertexBufferSize;
     GLsizeiptr      IndexBufferSize;
     bool            HasClipOrigin;
+    // rbfx: draw lists of the whole frame are packed and uploaded at once, upload is skipped if nothing changed
+    ImVector<ImDrawVert> StagingVertices;
+    ImVector<ImDrawIdx>  StagingIndices;
+    ImVector<ImDrawVert> UploadedVertices;
+    ImVector<ImDrawIdx>  UploadedIndices;
+    bool            UploadedValid;
 
     ImGui_ImplOpenGL3_Data() { memset(this, 0, sizeof(*this)); }
 };
@@ -407,6 +413,56 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col));
 }
 
+// rbfx: Point vertex attributes to the first vertex of draw list in the shared vertex buffer.
+static void ImGui_ImplOpenGL3_SetupVertexAttribOffset(ImGui_ImplOpenGL3_Data* bd, int vtx_offset)
+{
+    const size_t base = (size_t)vtx_offset * sizeof(ImDrawVert);
+    glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)(base + IM_OFFSETOF(ImDrawVert, pos)));
+    glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)(base + IM_OFFSETOF(ImDrawVert, uv)));
+    glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)(base + IM_OFFSETOF(ImDrawVert, col)));
+}
+
+// rbfx: Pack all draw lists into staging buffers and upload them at once.
+// If the frame is identical to the previously uploaded one, GPU buffers are reused as is.
+static void ImGui_ImplOpenGL3_UploadDrawData(ImGui_ImplOpenGL3_Data* bd, ImDrawData* draw_data)
+{
+    bd->StagingVertices.resize(draw_data->TotalVtxCount);
+    bd->StagingIndices.resize(draw_data->TotalIdxCount);
+    ImDrawVert* vtx_dst = bd->StagingVertices.Data;
+    ImDrawIdx* idx_dst = bd->StagingIndices.Data;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        memcpy(vtx_dst, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
+        memcpy(idx_dst, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+        vtx_dst += cmd_list->VtxBuffer.Size;
+        idx_dst += cmd_list->IdxBuffer.Size;
+    }
+
+    const GLsizeiptr vtx_buffer_size = (GLsizeiptr)bd->StagingVertices.size_in_bytes();
+    const GLsizeiptr idx_buffer_size = (GLsizeiptr)bd->StagingIndices.size_in_bytes();
+    const bool is_same_frame = bd->UploadedValid
+        && bd->UploadedVertices.Size == bd->StagingVertices.Size && bd->UploadedIndices.Size == bd->StagingIndices.Size
+        && memcmp(bd->UploadedVertices.Data, bd->StagingVertices.Data, (size_t)vtx_buffer_size) == 0
+        && memcmp(bd->UploadedIndices.Data, bd->StagingIndices.Data, (size_t)idx_buffer_size) == 0;
+    if (is_same_frame)
+        return;
+
+    // Orphan buffers so the driver doesn't have to wait for previous frame. Grow with reserve to avoid frequent reallocations.
+    if (bd->VertexBufferSize < vtx_buffer_size)
+        bd->VertexBufferSize = vtx_buffer_size + vtx_buffer_size / 2;
+    if (bd->IndexBufferSize < idx_buffer_size)
+        bd->IndexBufferSize = idx_buffer_size + idx_buffer_size / 2;
+    glBufferData(GL_ARRAY_BUFFER, bd->VertexBufferSize, NULL, GL_STREAM_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, bd->IndexBufferSize, NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vtx_buffer_size, (const GLvoid*)bd->StagingVertices.Data);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, idx_buffer_size, (const GLvoid*)bd->StagingIndices.Data);
+
+    bd->UploadedVertices.swap(bd->StagingVertices);
+    bd->UploadedIndices.swap(bd->StagingIndices);
+    bd->UploadedValid = true;
+}
+
 // OpenGL3 Render function.
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
 // This is in order to be able to run within an OpenGL engine that doesn't do so.
@@ -474,26 +530,28 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
     ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
 
+    // rbfx: Upload whole frame at once
+    ImGui_ImplOpenGL3_UploadDrawData(bd, draw_data);
+
+    // rbfx: Base vertex is applied either by draw call or by vertex attribute offset
+    bool use_base_vertex = false;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
+    use_base_vertex = bd->GlVersion >= 320;
+#endif
+
+    // rbfx: Skip redundant texture and scissor changes, most commands use the same font atlas
+    bool state_valid = false;
+    GLuint bound_texture = 0;
+    ImVec4 bound_scissor;
+
     // Render command lists
+    int global_vtx_offset = 0;
+    int global_idx_offset = 0;
     for (int n = 0; n < draw_data->CmdListsCount; n++)
     {
         const ImDrawList* cmd_list = draw_data->CmdLists[n];
-
-        // Upload vertex/index buffers
-        GLsizeiptr vtx_buffer_size = (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert);
-        GLsizeiptr idx_buffer_size = (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx);
-        if (bd->VertexBufferSize < vtx_buffer_size)
-        {
-            bd->VertexBufferSize = vtx_buffer_size;
-            glBufferData(GL_ARRAY_BUFFER, bd->VertexBufferSize, NULL, GL_STREAM_DRAW);
-        }
-        if (bd->IndexBufferSize < idx_buffer_size)
-        {
-            bd->IndexBufferSize = idx_buffer_size;
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, bd->IndexBufferSize, NULL, GL_STREAM_DRAW);
-        }
-        glBufferSubData(GL_ARRAY_BUFFER, 0, vtx_buffer_size, (const GLvoid*)cmd_list->VtxBuffer.Data);
-        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, idx_buffer_size, (const GLvoid*)cmd_list->IdxBuffer.Data);
+        if (!use_base_vertex)
+            ImGui_ImplOpenGL3_SetupVertexAttribOffset(bd, global_vtx_offset);
 
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
         {
@@ -503,9 +561,14 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                {
                     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+                    if (!use_base_vertex)
+                        ImGui_ImplOpenGL3_SetupVertexAttribOffset(bd, global_vtx_offset);
+                }
                 else
                     pcmd->UserCallback(cmd_list, pcmd);
+                state_valid = false;
             }
             else
             {
@@ -516,18 +579,34 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                     continue;
 
                 // Apply scissor/clipping rectangle (Y is inverted in OpenGL)
-                glScissor((int)clip_min.x, (int)(fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y));
+                const ImVec4 scissor(clip_min.x, clip_min.y, clip_max.x, clip_max.y);
+                if (!state_valid || scissor.x != bound_scissor.x || scissor.y != bound_scissor.y || scissor.z != bound_scissor.z || scissor.w != bound_scissor.w)
+                {
+                    glScissor((int)clip_min.x, (int)(fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y));
+                    bound_scissor = scissor;
+                }
 
                 // Bind texture, Draw
-                glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID());
+                const GLuint texture = (GLuint)(intptr_t)pcmd->GetTexID();
+                if (!state_valid || texture != bound_texture)
+                {
+                    glBindTexture(GL_TEXTURE_2D, texture);
+                    bound_texture = texture;
+                }
+                state_valid = true;
+
+                const GLenum idx_type = sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+                const void* idx_offset = (void*)(intptr_t)((global_idx_offset + pcmd->IdxOffset) * sizeof(ImDrawIdx));
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
-                if (bd->GlVersion >= 320)
-                    glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset);
+                if (use_base_vertex)
+                    glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, idx_type, idx_offset, (GLint)(global_vtx_offset + pcmd->VtxOffset));
                 else
 #endif
-                glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)));
+                glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, idx_type, idx_offset);
             }
         }
+        global_vtx_offset += cmd_list->VtxBuffer.Size;
+        global_idx_offset += cmd_list->IdxBuffer.Size;
     }
 
     // Destroy the temporary VAO
@@ -873,6 +952,8 @@ void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
     if (bd->VboHandle)      { glDeleteBuffers(1, &bd->VboHandle); bd->VboHandle = 0; }
     if (bd->ElementsHandle) { glDeleteBuffers(1, &bd->ElementsHandle); bd->ElementsHandle = 0; }
+    bd->VertexBufferSize = bd->IndexBufferSize = 0;  // rbfx
+    bd->UploadedValid = false;                       // rbfx
     if (bd->ShaderHandle)   { glDeleteProgram(bd->ShaderHandle); bd->ShaderHandle = 0; }
     ImGui_ImplOpenGL3_DestroyFontsTexture();
 }
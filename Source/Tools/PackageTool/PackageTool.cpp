@@ -33,6 +33,7 @@
 #endif
 
 #include <EASTL/unique_ptr.h>
+#include <EASTL/unordered_map.h>
 #include <LZ4/lz4.h>
 #include <LZ4/lz4hc.h>
 
@@ -42,6 +43,7 @@
 using namespace Urho3D;
 
 static const unsigned COMPRESSED_BLOCK_SIZE = 32768;
+static const unsigned COMPRESSED_PACKAGE_VERSION = 1;
 
 struct FileEntry
 {
@@ -49,6 +51,8 @@ struct FileEntry
     unsigned offset_{};
     unsigned size_{};
     unsigned checksum_{};
+    unsigned packedSize_{};
+    ea::vector<unsigned> blockOffsets_;
 };
 
 Context* context_ = nullptr;
@@ -59,6 +63,9 @@ unsigned checksum_ = 0;
 bool compress_ = false;
 bool quiet_ = false;
 unsigned blockSize_ = COMPRESSED_BLOCK_SIZE;
+long long fileListOffset_ = 0;
+SharedPtr<PackageFile> basePackage_;
+ea::unordered_map<unsigned long long, ea::vector<unsigned>> contentIndex_;
 
 ea::string ignoreExtensions_[] = {
     ".bak",
@@ -70,6 +77,11 @@ void Run(const ea::vector<ea::string>& arguments);
 void ProcessFile(const ea::string& fileName, const ea::string& rootDir);
 void WritePackageFile(const ea::string& fileName, const ea::string& rootDir);
 void WriteHeader(File& dest);
+void WriteFileList(File& dest);
+void ReadSourceFile(const ea::string& fullPath, ea::vector<unsigned char>& data);
+unsigned CalculateChecksum(const unsigned char* data, unsigned size);
+bool IsUnchangedInBasePackage(const ea::string& entryName, const ea::vector<unsigned char>& data);
+const FileEntry* FindDuplicateEntry(unsigned index, const unsigned char* data, const ea::string& rootDir);
 
 int main(int argc, char** argv)
 {
@@ -96,10 +108,12 @@ void Run(const ea::vector<ea::string>& arguments)
             "Usage: PackageTool <directory to process> <package name> [basepath] [options]\n"
             "\n"
             "Options:\n"
-            "-c      Enable package file LZ4 compression\n"
+            "-c      Enable package file LZ4 compression with block index for random access\n"
             "-q      Enable quiet mode\n"
+            "-p      Create patch package with only the files that differ from the base package given as next argument\n"
             "\n"
-            "Basepath is an optional prefix that will be added to the file entries.\n\n"
+            "Basepath is an optional prefix that will be added to the file entries.\n"
+            "Files with identical contents are stored only once. Patch packages should be mounted after the base package.\n\n"
             "Alternative output usage: PackageTool <output option> <package name>\n"
             "Output option:\n"
             "-i      Output package file information\n"
@@ -128,6 +142,13 @@ void Run(const ea::vector<ea::string>& arguments)
                     case 'q':
                         quiet_ = true;
                         break;
+                    case 'p':
+                        if (i + 1 >= arguments.size())
+                            ErrorExit("Base package name expected after -p");
+                        basePackage_ = MakeShared<PackageFile>(context_);
+                        if (!basePackage_->Open(arguments[++i]))
+                            ErrorExit("Could not open base package " + arguments[i]);
+                        break;
                     default:
                         ErrorExit("Unrecognized option");
                     }
@@ -165,7 +186,7 @@ void Run(const ea::vector<ea::string>& arguments)
         ea::quick_sort(fileNames.begin(), fileNames.end());
 
         // Check if up to date
-        if (fileSystem_->Exists(packageName))
+        if (!basePackage_ && fileSystem_->Exists(packageName))
         {
             unsigned packageTime = fileSystem_->GetLastModifiedTime(packageName);
             SharedPtr<PackageFile> packageFile(new PackageFile(context_, packageName));
@@ -206,6 +227,8 @@ void Run(const ea::vector<ea::string>& arguments)
             PrintLine("Package size: " + ea::to_string(packageFile->GetTotalSize()));
             PrintLine("Checksum: " + ea::to_string(packageFile->GetChecksum()));
             PrintLine("Compressed: " + ea::string(packageFile->IsCompressed() ? "yes" : "no"));
+            if (packageFile->GetBlockSize())
+                PrintLine("Block size: " + ea::to_string(packageFile->GetBlockSize()));
             break;
         case 'L':
             if (!packageFile->IsCompressed())
@@ -221,9 +244,13 @@ void Run(const ea::vector<ea::string>& arguments)
                     ea::string fileEntry(current->first);
                     if (outputCompressionRatio)
                     {
-                        unsigned compressedSize =
-                            (i == entries.end() ? packageFile->GetTotalSize() - sizeof(unsigned) : i->second.offset_) -
-                            current->second.offset_;
+                        unsigned compressedSize = current->second.packedSize_;
+                        if (!compressedSize)
+                        {
+                            compressedSize =
+                                (i == entries.end() ? packageFile->GetTotalSize() - sizeof(unsigned) : i->second.offset_) -
+                                current->second.offset_;
+                        }
                         fileEntry.append_sprintf("\tin: %u\tout: %u\tratio: %f", current->second.size_, compressedSize,
                             compressedSize ? 1.f * current->second.size_ / compressedSize : 0.f);
                     }
@@ -244,6 +271,18 @@ void ProcessFile(const ea::string& fileName, const ea::string& rootDir)
     if (!file.Open(fullPath))
         ErrorExit("Could not open file " + fileName);
 
+    if (basePackage_)
+    {
+        ea::vector<unsigned char> data;
+        file.ReadBinary(data);
+        if (IsUnchangedInBasePackage(basePath_ + fileName, data))
+        {
+            if (!quiet_)
+                PrintLine(fileName + " is unchanged, skipping");
+            return;
+        }
+    }
+
     FileEntry newEntry;
     newEntry.name_ = fileName;
     newEntry.offset_ = 0; // Offset not yet known
@@ -264,13 +303,11 @@ void WritePackageFile(const ea::string& fileName, const ea::string& rootDir)
     // Write ID, number of files & placeholder for checksum
     WriteHeader(dest);
 
-    for (unsigned i = 0; i < entries_.size(); ++i)
+    // Compressed packages have the file list at the end, uncompressed packages reserve space for it after the header
+    if (!compress_)
     {
-        // Write entry (correct offset is still unknown, will be filled in later)
-        dest.WriteString(basePath_ + entries_[i].name_);
-        dest.WriteUInt(entries_[i].offset_);
-        dest.WriteUInt(entries_[i].size_);
-        dest.WriteUInt(entries_[i].checksum_);
+        // Correct offsets are still unknown, will be filled in later
+        WriteFileList(dest);
     }
 
     unsigned totalDataSize = 0;
@@ -300,6 +337,17 @@ void WritePackageFile(const ea::string& fileName, const ea::string& rootDir)
             entries_[i].checksum_ = SDBMHash(entries_[i].checksum_, buffer[j]);
         }
 
+        // Store identical file contents only once
+        if (const FileEntry* duplicate = FindDuplicateEntry(i, buffer.get(), rootDir))
+        {
+            entries_[i].offset_ = duplicate->offset_;
+            entries_[i].packedSize_ = duplicate->packedSize_;
+            entries_[i].blockOffsets_ = duplicate->blockOffsets_;
+            if (!quiet_)
+                PrintLine(entries_[i].name_ + " is identical to " + duplicate->name_);
+            continue;
+        }
+
         if (!compress_)
         {
             if (!quiet_)
@@ -322,6 +370,7 @@ void WritePackageFile(const ea::string& fileName, const ea::string& rootDir)
                 if (!packedSize)
                     ErrorExit("LZ4 compression failed for file " + entries_[i].name_ + " at offset " + ea::to_string(pos));
 
+                entries_[i].blockOffsets_.push_back(dest.GetSize() - lastOffset);
                 dest.WriteUShort((unsigned short)unpackedSize);
                 dest.WriteUShort((unsigned short)packedSize);
                 dest.Write(compressBuffer.get(), packedSize);
@@ -329,9 +378,11 @@ void WritePackageFile(const ea::string& fileName, const ea::string& rootDir)
                 pos += unpackedSize;
             }
 
+            entries_[i].packedSize_ = dest.GetSize() - lastOffset;
+
             if (!quiet_)
             {
-                unsigned totalPackedBytes = dest.GetSize() - lastOffset;
+                unsigned totalPackedBytes = entries_[i].packedSize_;
                 ea::string fileEntry(entries_[i].name_);
                 fileEntry.append_sprintf("\tin: %u\tout: %u\tratio: %f", dataSize, totalPackedBytes,
                     totalPackedBytes ? 1.f * dataSize / totalPackedBytes : 0.f);
@@ -340,6 +391,12 @@ void WritePackageFile(const ea::string& fileName, const ea::string& rootDir)
         }
     }
 
+    if (compress_)
+    {
+        fileListOffset_ = dest.GetSize();
+        WriteFileList(dest);
+    }
+
     // Write package size to the end of file to allow finding it linked to an executable file
     unsigned currentSize = dest.GetSize();
     dest.WriteUInt(currentSize + sizeof(unsigned));
@@ -348,13 +405,8 @@ void WritePackageFile(const ea::string& fileName, const ea::string& rootDir)
     dest.Seek(0);
     WriteHeader(dest);
 
-    for (unsigned i = 0; i < entries_.size(); ++i)
-    {
-        dest.WriteString(basePath_ + entries_[i].name_);
-        dest.WriteUInt(entries_[i].offset_);
-        dest.WriteUInt(entries_[i].size_);
-        dest.WriteUInt(entries_[i].checksum_);
-    }
+    if (!compress_)
+        WriteFileList(dest);
 
     if (!quiet_)
     {
@@ -371,7 +423,86 @@ void WriteHeader(File& dest)
     if (!compress_)
         dest.WriteFileID("UPAK");
     else
-        dest.WriteFileID("ULZ4");
+        dest.WriteFileID("RLZ4");
     dest.WriteUInt(entries_.size());
     dest.WriteUInt(checksum_);
+
+    if (compress_)
+    {
+        dest.WriteUInt(COMPRESSED_PACKAGE_VERSION);
+        dest.WriteInt64(fileListOffset_);
+        dest.WriteUInt(blockSize_);
+    }
+}
+
+void WriteFileList(File& dest)
+{
+    for (const FileEntry& entry : entries_)
+    {
+        dest.WriteString(basePath_ + entry.name_);
+        dest.WriteUInt(entry.offset_);
+        dest.WriteUInt(entry.size_);
+        dest.WriteUInt(entry.checksum_);
+
+        if (compress_)
+        {
+            dest.WriteUInt(entry.packedSize_);
+            dest.WriteVLE(entry.blockOffsets_.size());
+            for (unsigned blockOffset : entry.blockOffsets_)
+                dest.WriteUInt(blockOffset);
+        }
+    }
+}
+
+void ReadSourceFile(const ea::string& fullPath, ea::vector<unsigned char>& data)
+{
+    File file(context_, fullPath);
+    if (!file.IsOpen())
+        ErrorExit("Could not open file " + fullPath);
+    file.ReadBinary(data);
+}
+
+unsigned CalculateChecksum(const unsigned char* data, unsigned size)
+{
+    unsigned checksum = 0;
+    for (unsigned i = 0; i < size; ++i)
+        checksum = SDBMHash(checksum, data[i]);
+    return checksum;
+}
+
+bool IsUnchangedInBasePackage(const ea::string& entryName, const ea::vector<unsigned char>& data)
+{
+    const PackageEntry* baseEntry = basePackage_->GetEntry(entryName);
+    if (!baseEntry || baseEntry->size_ != data.size())
+        return false;
+
+    if (baseEntry->checksum_ != CalculateChecksum(data.data(), data.size()))
+        return false;
+
+    // Checksum is weak, compare actual contents
+    File baseFile(context_);
+    if (!baseFile.Open(basePackage_, entryName))
+        return false;
+
+    ea::vector<unsigned char> baseData;
+    baseFile.ReadBinary(baseData);
+    return baseData == data;
+}
+
+const FileEntry* FindDuplicateEntry(unsigned index, const unsigned char* data, const ea::string& rootDir)
+{
+    const FileEntry& entry = entries_[index];
+    const unsigned long long key = (static_cast<unsigned long long>(entry.size_) << 32u) | entry.checksum_;
+    ea::vector<unsigned>& candidates = contentIndex_[key];
+
+    for (unsigned candidateIndex : candidates)
+    {
+        ea::vector<unsigned char> candidateData;
+        ReadSourceFile(rootDir + "/" + entries_[candidateIndex].name_, candidateData);
+        if (candidateData.size() == entry.size_ && (!entry.size_ || memcmp(candidateData.data(), data, entry.size_) == 0))
+            return &entries_[candidateIndex];
+    }
+
+    candidates.push_back(index);
+    return nullptr;
 }
@@ -23,6 +23,7 @@
 #include <Urho3D/Core/Context.h>
 #include <Urho3D/Core/ProcessUtils.h>
 #include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/IO/File.h>
 #include <Urho3D/IO/FileSystem.h>
 #include <Urho3D/IO/Log.h>
@@ -30,6 +31,8 @@
 #include <Urho3D/Resource/XMLElement.h>
 #include <Urho3D/Resource/XMLFile.h>
 
+#include <EASTL/sort.h>
+
 #ifdef WIN32
 #include <windows.h>
 #endif
@@ -64,6 +67,10 @@ public:
     int height{};
     int frameWidth{};
     int frameHeight{};
+    /// Loaded image in RGBA format.
+    SharedPtr<Image> image;
+    /// Error occurred during loading, if any.
+    ea::string error;
 
     PackerInfo(const ea::string& path_, const ea::string& name_) :
         path(path_),
@@ -113,6 +120,8 @@ void Run(ea::vector<ea::string>& arguments)
     SharedPtr<Context> context(new Context());
     context->RegisterSubsystem(new FileSystem(context));
     context->RegisterSubsystem(new Log(context));
+    context->RegisterSubsystem(new WorkQueue(context));
+    context->GetSubsystem<WorkQueue>()->CreateThreads(Max(GetNumLogicalCPUs(), 2u) - 1);
     auto* fileSystem = context->GetSubsystem<FileSystem>();
 
     ea::vector<ea::string> inputFiles;
@@ -197,23 +206,38 @@ void Run(ea::vector<ea::string>& arguments)
     offsetY = Min((int)offsetY, (int)padY);
 
     ea::vector<SharedPtr<PackerInfo > > packerInfos;
+    for (const ea::string& path : inputFiles)
+        packerInfos.push_back(MakeShared<PackerInfo>(path, ReplaceExtension(GetFileName(path), "")));
 
-    for (unsigned i = 0; i < inputFiles.size(); ++i)
+    // Load and trim images in worker threads, errors are reported afterwards from the main thread
+    auto* workQueue = context->GetSubsystem<WorkQueue>();
+    ForEachParallel(workQueue, packerInfos, [&](unsigned /*index*/, PackerInfo* packerInfo)
     {
-        ea::string path = inputFiles[i];
-        ea::string name = ReplaceExtension(GetFileName(path), "");
-        File file(context, path);
-        Image image(context);
+        File file(context, packerInfo->path);
+        auto image = MakeShared<Image>(context);
 
-        if (!image.Load(file))
-            ErrorExit("Could not load image " + path + ".");
+        if (!image->Load(file))
+        {
+            packerInfo->error = "Could not load image " + packerInfo->path + ".";
+            return;
+        }
 
-        if (image.IsCompressed())
-            ErrorExit(path + " is compressed. Compressed images are not allowed.");
+        if (image->IsCompressed())
+        {
+            packerInfo->error = packerInfo->path + " is compressed. Compressed images are not allowed.";
+            return;
+        }
 
-        SharedPtr<PackerInfo> packerInfo(new PackerInfo(path, name));
-        int imageWidth = image.GetWidth();
-        int imageHeight = image.GetHeight();
+        if (image->GetComponents() != 4)
+            image = image->ConvertToRGBA();
+        if (!image)
+        {
+            packerInfo->error = "Could not convert image " + packerInfo->path + " to RGBA.";
+            return;
+        }
+
+        int imageWidth = image->GetWidth();
+        int imageHeight = image->GetHeight();
         int trimOffsetX = 0;
         int trimOffsetY = 0;
         int adjustedWidth = imageWidth;
@@ -226,11 +250,13 @@ void Run(ea::vector<ea::string>& arguments)
             int maxX = 0;
             int maxY = 0;
 
+            const unsigned char* data = image->GetData();
             for (int y = 0; y < imageHeight; ++y)
             {
+                const unsigned char* row = data + y * imageWidth * 4;
                 for (int x = 0; x < imageWidth; ++x)
                 {
-                    bool found = (image.GetPixelInt(x, y) & 0x000000ffu) != 0;
+                    const bool found = row[x * 4 + 3] != 0;
                     if (found) {
                         minX = Min(minX, x);
                         minY = Min(minY, y);
@@ -240,6 +266,13 @@ void Run(ea::vector<ea::string>& arguments)
                 }
             }
 
+            // Keep single pixel of fully transparent image
+            if (minX > maxX || minY > maxY)
+            {
+                minX = maxX = 0;
+                minY = maxY = 0;
+            }
+
             trimOffsetX = minX;
             trimOffsetY = minY;
             adjustedWidth = maxX - minX + 1;
@@ -260,160 +293,216 @@ void Run(ea::vector<ea::string>& arguments)
         packerInfo->height = adjustedHeight;
         packerInfo->offsetX -= trimOffsetX;
         packerInfo->offsetY -= trimOffsetY;
-        packerInfos.push_back(packerInfo);
+        packerInfo->image = image;
+    });
+
+    for (PackerInfo* packerInfo : packerInfos)
+    {
+        if (!packerInfo->error.empty())
+            ErrorExit(packerInfo->error);
     }
 
-    int packedWidth = MAX_TEXTURE_SIZE;
-    int packedHeight = MAX_TEXTURE_SIZE;
+    // Pack images into one or more pages. Each page is as small as possible, but not larger than max texture size.
+    struct Page
+    {
+        int width{};
+        int height{};
+        ea::vector<PackerInfo*> packerInfos;
+    };
+    ea::vector<Page> pages;
     {
         // fill up an list of tries in increasing size and take the first win
         ea::vector<IntVector2> tries;
-        for(unsigned x=2; x<11; ++x)
+        for(unsigned x=2; x<12; ++x)
         {
-            for(unsigned y=2; y<11; ++y)
-                tries.push_back(IntVector2((1u << x), (1u << y)));
+            for(unsigned y=2; y<12; ++y)
+            {
+                const IntVector2 size((1u << x), (1u << y));
+                if (size.x_ <= MAX_TEXTURE_SIZE && size.y_ <= MAX_TEXTURE_SIZE)
+                    tries.push_back(size);
+            }
         }
+        ea::stable_sort(tries.begin(), tries.end(),
+            [](const IntVector2& lhs, const IntVector2& rhs) { return lhs.x_ * lhs.y_ < rhs.x_ * rhs.y_; });
 
-        // load rectangles
-        auto* packerRects = new stbrp_rect[packerInfos.size()];
-        for (unsigned i = 0; i < packerInfos.size(); ++i)
+        ea::vector<stbrp_node> packerMemory(PACKER_NUM_NODES);
+        const auto packRects = [&](ea::vector<stbrp_rect>& packerRects, const IntVector2& size)
         {
-            PackerInfo* packerInfo = packerInfos[i];
-            stbrp_rect* packerRect = &packerRects[i];
-            packerRect->id = i;
-            packerRect->h = packerInfo->height + padY;
-            packerRect->w = packerInfo->width + padX;
-        }
+            stbrp_context packerContext;
+            stbrp_init_target(&packerContext, size.x_, size.y_, packerMemory.data(), PACKER_NUM_NODES);
+            return stbrp_pack_rects(&packerContext, packerRects.data(), packerRects.size()) != 0;
+        };
+
+        ea::vector<PackerInfo*> remaining;
+        for (PackerInfo* packerInfo : packerInfos)
+            remaining.push_back(packerInfo);
 
-        bool success = false;
-        while (tries.size() > 0)
+        ea::vector<stbrp_rect> packerRects;
+        while (!remaining.empty())
         {
-            IntVector2 size = tries[0];
-            tries.pop_front();
-            bool fit = true;
-            int textureHeight = size.y_;
-            int textureWidth = size.x_;
-            if (success && textureHeight * textureWidth > packedWidth * packedHeight)
-                continue;
+            // load rectangles
+            packerRects.resize(remaining.size());
+            for (unsigned i = 0; i < remaining.size(); ++i)
+            {
+                PackerInfo* packerInfo = remaining[i];
+                stbrp_rect* packerRect = &packerRects[i];
+                packerRect->id = i;
+                packerRect->h = packerInfo->height + padY;
+                packerRect->w = packerInfo->width + padX;
+            }
 
-            stbrp_context packerContext;
-            stbrp_node packerMemory[PACKER_NUM_NODES];
-            stbrp_init_target(&packerContext, textureWidth, textureHeight, packerMemory, PACKER_NUM_NODES);
-            if (!stbrp_pack_rects(&packerContext, packerRects, packerInfos.size()))
+            // Tries are sorted by area, so the first fit is the best one
+            Page page;
+            for (const IntVector2& size : tries)
+            {
+                if (packRects(packerRects, size))
+                {
+                    page.width = size.x_;
+                    page.height = size.y_;
+                    break;
+                }
+            }
+
+            ea::vector<PackerInfo*> notPacked;
+            if (!page.width)
             {
-                // check to see if everything fit
-                fit = false;
+                // Everything doesn't fit, fill the page of max size and put the rest to next pages
+                page.width = MAX_TEXTURE_SIZE;
+                page.height = MAX_TEXTURE_SIZE;
+                packRects(packerRects, IntVector2(page.width, page.height));
             }
 
-            if (fit)
+            // distribute values to packer info
+            for (const stbrp_rect& packerRect : packerRects)
             {
-                success = true;
-                // distribute values to packer info
-                for (unsigned i = 0; i < packerInfos.size(); ++i)
+                PackerInfo* packerInfo = remaining[packerRect.id];
+                if (!packerRect.was_packed)
                 {
-                    stbrp_rect* packerRect = &packerRects[i];
-                    PackerInfo* packerInfo = packerInfos[packerRect->id];
-                    packerInfo->x = packerRect->x;
-                    packerInfo->y = packerRect->y;
+                    notPacked.push_back(packerInfo);
+                    continue;
                 }
-                packedWidth = size.x_;
-                packedHeight = size.y_;
+
+                packerInfo->x = packerRect.x;
+                packerInfo->y = packerRect.y;
+                page.packerInfos.push_back(packerInfo);
             }
-        }
-        delete[] packerRects;
-        if (!success)
-            ErrorExit("Could not allocate for all images.  The max sprite sheet texture size is " + ea::to_string(MAX_TEXTURE_SIZE) + "x" + ea::to_string(MAX_TEXTURE_SIZE) + ".");
-    }
 
-    // create image for spritesheet
-    Image spriteSheetImage(context);
-    spriteSheetImage.SetSize(packedWidth, packedHeight, 4);
+            if (page.packerInfos.empty())
+                ErrorExit("Could not allocate for all images.  The max sprite sheet texture size is " + ea::to_string(MAX_TEXTURE_SIZE) + "x" + ea::to_string(MAX_TEXTURE_SIZE) + ".");
 
-    // zero out image
-    spriteSheetImage.SetData(nullptr);
+            pages.push_back(ea::move(page));
+            remaining = ea::move(notPacked);
+        }
+    }
 
-    XMLFile xml(context);
-    XMLElement root = xml.CreateRoot("TextureAtlas");
-    root.SetAttribute("imagePath", GetFileNameAndExtension(outputFile));
+    if (pages.size() > 1)
+        URHO3D_LOGINFO("Images don't fit into single texture, " + ea::to_string(pages.size()) + " pages are created.");
 
-    for (unsigned i = 0; i < packerInfos.size(); ++i)
+    for (unsigned pageIndex = 0; pageIndex < pages.size(); ++pageIndex)
     {
-        SharedPtr<PackerInfo> packerInfo = packerInfos[i];
-        XMLElement subTexture = root.CreateChild("SubTexture");
-        subTexture.SetString("name", packerInfo->name);
-        subTexture.SetInt("x", packerInfo->x + offsetX);
-        subTexture.SetInt("y", packerInfo->y + offsetY);
-        subTexture.SetInt("width", packerInfo->width);
-        subTexture.SetInt("height", packerInfo->height);
-
-        if (packerInfo->frameWidth || packerInfo->frameHeight)
+        const Page& page = pages[pageIndex];
+
+        // First page uses specified file names, next pages have index suffix
+        ea::string pageOutputFile = outputFile;
+        ea::string pageSpriteSheetFileName = spriteSheetFileName;
+        if (pageIndex > 0)
         {
-            subTexture.SetInt("frameWidth", packerInfo->frameWidth);
-            subTexture.SetInt("frameHeight", packerInfo->frameHeight);
-            subTexture.SetInt("offsetX", packerInfo->offsetX);
-            subTexture.SetInt("offsetY", packerInfo->offsetY);
+            const ea::string suffix = "_" + ea::to_string(pageIndex);
+            pageOutputFile = ReplaceExtension(outputFile, suffix + GetExtension(outputFile, false));
+            pageSpriteSheetFileName = ReplaceExtension(spriteSheetFileName, suffix + GetExtension(spriteSheetFileName, false));
         }
 
-        URHO3D_LOGINFO("Transferring " + packerInfo->path + " to sprite sheet.");
+        // create image for spritesheet
+        Image spriteSheetImage(context);
+        spriteSheetImage.SetSize(page.width, page.height, 4);
 
-        File file(context, packerInfo->path);
-        Image image(context);
-        if (!image.Load(file))
-            ErrorExit("Could not load image " + packerInfo->path + ".");
+        // zero out image
+        spriteSheetImage.SetData(nullptr);
+
+        XMLFile xml(context);
+        XMLElement root = xml.CreateRoot("TextureAtlas");
+        root.SetAttribute("imagePath", GetFileNameAndExtension(pageOutputFile));
 
-        for (int y = 0; y < packerInfo->height; ++y)
+        for (PackerInfo* packerInfo : page.packerInfos)
         {
-            for (int x = 0; x < packerInfo->width; ++x)
+            XMLElement subTexture = root.CreateChild("SubTexture");
+            subTexture.SetString("name", packerInfo->name);
+            subTexture.SetInt("x", packerInfo->x + offsetX);
+            subTexture.SetInt("y", packerInfo->y + offsetY);
+            subTexture.SetInt("width", packerInfo->width);
+            subTexture.SetInt("height", packerInfo->height);
+
+            if (packerInfo->frameWidth || packerInfo->frameHeight)
             {
-                unsigned color = image.GetPixelInt(x - packerInfo->offsetX, y - packerInfo->offsetY);
-                spriteSheetImage.SetPixelInt(
-                    packerInfo->x + offsetX + x,
-                    packerInfo->y + offsetY + y, color);
+                subTexture.SetInt("frameWidth", packerInfo->frameWidth);
+                subTexture.SetInt("frameHeight", packerInfo->frameHeight);
+                subTexture.SetInt("offsetX", packerInfo->offsetX);
+                subTexture.SetInt("offsetY", packerInfo->offsetY);
             }
         }
-    }
-
-    if (debug)
-    {
-        unsigned OUTER_BOUNDS_DEBUG_COLOR = Color::BLUE.ToUInt();
-        unsigned INNER_BOUNDS_DEBUG_COLOR = Color::GREEN.ToUInt();
 
-        URHO3D_LOGINFO("Drawing debug information.");
-        for (unsigned i = 0; i < packerInfos.size(); ++i)
+        // Allocated areas don't overlap, so images are copied in parallel
+        URHO3D_LOGINFO("Transferring " + ea::to_string(page.packerInfos.size()) + " images to sprite sheet.");
+        unsigned char* destData = spriteSheetImage.GetData();
+        ForEachParallel(workQueue, page.packerInfos, [&](unsigned /*index*/, PackerInfo* packerInfo)
         {
-            SharedPtr<PackerInfo> packerInfo = packerInfos[i];
-
-            // Draw outer bounds
-            for (int x = 0; x < packerInfo->frameWidth; ++x)
+            const Image* image = packerInfo->image;
+            const unsigned char* sourceData = image->GetData();
+            const int sourceX = -packerInfo->offsetX;
+            const int sourceY = -packerInfo->offsetY;
+            const int destX = packerInfo->x + offsetX;
+            const int destY = packerInfo->y + offsetY;
+            const int rowWidth = Min(packerInfo->width, image->GetWidth() - sourceX);
+            const int numRows = Min(packerInfo->height, image->GetHeight() - sourceY);
+
+            for (int y = 0; y < numRows; ++y)
             {
-                spriteSheetImage.SetPixelInt(packerInfo->x + x, packerInfo->y, OUTER_BOUNDS_DEBUG_COLOR);
-                spriteSheetImage.SetPixelInt(packerInfo->x + x, packerInfo->y + packerInfo->frameHeight, OUTER_BOUNDS_DEBUG_COLOR);
-            }
-            for (int y = 0; y < packerInfo->frameHeight; ++y)
-            {
-                spriteSheetImage.SetPixelInt(packerInfo->x, packerInfo->y + y, OUTER_BOUNDS_DEBUG_COLOR);
-                spriteSheetImage.SetPixelInt(packerInfo->x + packerInfo->frameWidth, packerInfo->y + y, OUTER_BOUNDS_DEBUG_COLOR);
+                const unsigned char* source = sourceData + ((sourceY + y) * image->GetWidth() + sourceX) * 4;
+                unsigned char* dest = destData + ((destY + y) * page.width + destX) * 4;
+                memcpy(dest, source, rowWidth * 4);
             }
+        });
 
-            // Draw inner bounds
-            for (int x = 0; x < packerInfo->width; ++x)
-            {
-                spriteSheetImage.SetPixelInt(packerInfo->x + offsetX + x, packerInfo->y + offsetY, INNER_BOUNDS_DEBUG_COLOR);
-                spriteSheetImage.SetPixelInt(packerInfo->x + offsetX + x, packerInfo->y + offsetY + packerInfo->height, INNER_BOUNDS_DEBUG_COLOR);
-            }
-            for (int y = 0; y < packerInfo->height; ++y)
+        if (debug)
+        {
+            unsigned OUTER_BOUNDS_DEBUG_COLOR = Color::BLUE.ToUInt();
+            unsigned INNER_BOUNDS_DEBUG_COLOR = Color::GREEN.ToUInt();
+
+            URHO3D_LOGINFO("Drawing debug information.");
+            for (PackerInfo* packerInfo : page.packerInfos)
             {
-                spriteSheetImage.SetPixelInt(packerInfo->x + offsetX, packerInfo->y + offsetY + y, INNER_BOUNDS_DEBUG_COLOR);
-                spriteSheetImage.SetPixelInt(packerInfo->x + offsetX + packerInfo->width, packerInfo->y + offsetY + y, INNER_BOUNDS_DEBUG_COLOR);
+                // Draw outer bounds
+                for (int x = 0; x < packerInfo->frameWidth; ++x)
+                {
+                    spriteSheetImage.SetPixelInt(packerInfo->x + x, packerInfo->y, OUTER_BOUNDS_DEBUG_COLOR);
+                    spriteSheetImage.SetPixelInt(packerInfo->x + x, packerInfo->y + packerInfo->frameHeight, OUTER_BOUNDS_DEBUG_COLOR);
+                }
+                for (int y = 0; y < packerInfo->frameHeight; ++y)
+                {
+                    spriteSheetImage.SetPixelInt(packerInfo->x, packerInfo->y + y, OUTER_BOUNDS_DEBUG_COLOR);
+                    spriteSheetImage.SetPixelInt(packerInfo->x + packerInfo->frameWidth, packerInfo->y + y, OUTER_BOUNDS_DEBUG_COLOR);
+                }
+
+                // Draw inner bounds
+                for (int x = 0; x < packerInfo->width; ++x)
+                {
+                    spriteSheetImage.SetPixelInt(packerInfo->x + offsetX + x, packerInfo->y + offsetY, INNER_BOUNDS_DEBUG_COLOR);
+                    spriteSheetImage.SetPixelInt(packerInfo->x + offsetX + x, packerInfo->y + offsetY + packerInfo->height, INNER_BOUNDS_DEBUG_COLOR);
+                }
+                for (int y = 0; y < packerInfo->height; ++y)
+                {
+                    spriteSheetImage.SetPixelInt(packerInfo->x + offsetX, packerInfo->y + offsetY + y, INNER_BOUNDS_DEBUG_COLOR);
+                    spriteSheetImage.SetPixelInt(packerInfo->x + offsetX + packerInfo->width, packerInfo->y + offsetY + y, INNER_BOUNDS_DEBUG_COLOR);
+                }
             }
         }
-    }
 
-    URHO3D_LOGINFO("Saving output image.");
-    spriteSheetImage.SavePNG(outputFile);
+        URHO3D_LOGINFO("Saving output image " + pageOutputFile + ".");
+        spriteSheetImage.SavePNG(pageOutputFile);
 
-    URHO3D_LOGINFO("Saving SpriteSheet xml file.");
-    File spriteSheetFile(context);
-    spriteSheetFile.Open(spriteSheetFileName, FILE_WRITE);
-    xml.Save(spriteSheetFile);
+        URHO3D_LOGINFO("Saving SpriteSheet xml file " + pageSpriteSheetFileName + ".");
+        File spriteSheetFile(context);
+        spriteSheetFile.Open(pageSpriteSheetFileName, FILE_WRITE);
+        xml.Save(spriteSheetFile);
+    }
 }
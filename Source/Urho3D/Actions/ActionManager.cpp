@@ -24,7 +24,9 @@
 #include "ActionManager.h"
 
 #include "../Core/CoreEvents.h"
+#include "../Core/WorkQueue.h"
 #include "../IO/Log.h"
+#include "../Scene/Scene.h"
 #include "ActionSet.h"
 #include "ActionState.h"
 #include "Attribute.h"
@@ -70,6 +72,9 @@ public:
     /// Get action duration.
     float GetDuration() const override { return ea::numeric_limits<float>::epsilon(); }
 
+    /// Empty action changes nothing.
+    bool IsTransformOnly() const override { return true; }
+
     /// Create reversed action.
     SharedPtr<FiniteTimeAction> Reverse() const override
     {
@@ -344,6 +349,9 @@ void ActionManager::Update(float dt)
         tmpKeysArray_.push_back(target.first);
     }
 
+    if (parallelUpdate_)
+        StepInParallel(dt);
+
     for (unsigned i = 0; i < count; i++)
     {
         auto elementlt = targets_.find(tmpKeysArray_[i]);
@@ -359,6 +367,7 @@ void ActionManager::Update(float dt)
 
         currentTarget_ = element.Target.Get();
         currentTargetSalvaged_ = false;
+        const unsigned numSteppedInParallel = ea::exchange(element.NumSteppedInParallel, 0u);
 
         if (!element.Paused)
         {
@@ -373,7 +382,8 @@ void ActionManager::Update(float dt)
 
                 element.CurrentActionSalvaged = false;
 
-                element.CurrentActionState->Step(dt);
+                if (static_cast<unsigned>(element.ActionIndex) >= numSteppedInParallel)
+                    element.CurrentActionState->Step(dt);
 
                 if (element.CurrentActionSalvaged)
                 {
@@ -407,6 +417,65 @@ void ActionManager::Update(float dt)
 
 FiniteTimeAction* ActionManager::GetEmptyAction() { return emptyAction_; }
 
+void ActionManager::StepInParallel(float dt)
+{
+    auto workQueue = GetSubsystem<WorkQueue>();
+    if (!workQueue || workQueue->GetNumThreads() == 0 || targets_.size() <= ParallelUpdateBucket)
+        return;
+
+    // Transform-only actions never add or remove actions, so the elements stay valid until the serial pass
+    parallelElements_.clear();
+    parallelScenes_.clear();
+    for (auto& [target, element] : targets_)
+    {
+        if (element.Paused || element.ActionStates.empty())
+            continue;
+
+        auto node = dynamic_cast<Node*>(element.Target.Get());
+        Scene* scene = node ? node->GetScene() : nullptr;
+        if (!scene)
+            continue;
+
+        const bool transformOnly = ea::all_of(element.ActionStates.begin(), element.ActionStates.end(),
+            [](const SharedPtr<ActionState>& state) { return state && state->GetAction()->IsTransformOnly(); });
+        // Animated ancestor would mark this node dirty concurrently, so this node is left for the serial pass
+        if (!transformOnly || HasAnimatedAncestor(node))
+            continue;
+
+        parallelElements_.push_back(&element);
+        if (!parallelScenes_.contains(scene))
+            parallelScenes_.push_back(scene);
+    }
+
+    if (parallelElements_.size() <= ParallelUpdateBucket)
+        return;
+
+    // Nodes react to being moved in threaded update mode as they do during octree update
+    for (Scene* scene : parallelScenes_)
+        scene->BeginThreadedUpdate();
+
+    ForEachParallel(workQueue, ParallelUpdateBucket, parallelElements_,
+        [&](unsigned /*index*/, HashElement* element)
+    {
+        for (const SharedPtr<ActionState>& state : element->ActionStates)
+            state->Step(dt);
+        element->NumSteppedInParallel = element->ActionStates.size();
+    });
+
+    for (Scene* scene : parallelScenes_)
+        scene->EndThreadedUpdate();
+}
+
+bool ActionManager::HasAnimatedAncestor(Node* node) const
+{
+    for (Node* parent = node->GetParent(); parent; parent = parent->GetParent())
+    {
+        if (targets_.find(parent) != targets_.end())
+            return true;
+    }
+    return false;
+}
+
 void SerializeValue(Archive& archive, const char* name, SharedPtr<BaseAction>& value)
 {
     const bool loading = archive.IsInput();
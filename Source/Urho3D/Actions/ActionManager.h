@@ -35,6 +35,9 @@ class BaseAction;
 class FiniteTimeAction;
 } // namespace Actions
 
+class Node;
+class Scene;
+
 /// Action manager.
 class URHO3D_API ActionManager
     : public Object
@@ -50,8 +53,13 @@ private:
         bool CurrentActionSalvaged {};
         bool Paused {};
         WeakPtr<Object> Target;
+        /// Number of leading action states already stepped in parallel this frame.
+        unsigned NumSteppedInParallel {};
     };
 
+    /// Min number of nodes to update in parallel.
+    static constexpr unsigned ParallelUpdateBucket = 64;
+
 public:
     ActionManager(Context* context);
 
@@ -78,8 +86,17 @@ public:
 
     Actions::FiniteTimeAction* GetEmptyAction();
 
+    /// Set whether transform-only actions of unrelated nodes are updated in parallel.
+    void SetParallelUpdate(bool enable) { parallelUpdate_ = enable; }
+    /// Return whether transform-only actions of unrelated nodes are updated in parallel.
+    bool GetParallelUpdate() const { return parallelUpdate_; }
+
 private:
     void HandleUpdate(StringHash eventType, VariantMap& eventData);
+    /// Step actions of nodes that have only transform-only actions and no animated ancestors.
+    void StepInParallel(float dt);
+    /// Return whether any ancestor of the node has actions.
+    bool HasAnimatedAncestor(Node* node) const;
 
 private:
     // Current target strong pointer to keep target alive while manager operates on actions.
@@ -88,6 +105,12 @@ private:
     ea::unordered_map<Object*, HashElement> targets_;
     ea::vector<Object*> tmpKeysArray_;
     SharedPtr<Actions::FiniteTimeAction> emptyAction_;
+    /// Whether transform-only actions are updated in parallel.
+    bool parallelUpdate_{};
+    /// Elements stepped in parallel this frame.
+    ea::vector<HashElement*> parallelElements_;
+    /// Scenes of nodes stepped in parallel this frame.
+    ea::vector<Scene*> parallelScenes_;
 };
 
 /// Register Particle Graph library objects.
@@ -79,6 +79,12 @@ AttributeInfo* AttributeAction::GetAttribute(Object* target)
     return attribute;
 }
 
+bool AttributeAction::IsTransformOnly() const
+{
+    const ea::string_view name = GetAttributeName();
+    return name == POSITION_ATTRIBUTE || name == ROTATION_ATTRIBUTE || name == SCALE_ATTRIBUTE;
+}
+
 
 } // namespace Actions
 } // namespace Urho3D
@@ -55,6 +55,9 @@ public:
 protected:
     AttributeInfo* GetAttribute(Object* target);
 
+    /// Return whether the action changes nothing but position, rotation and scale of the target.
+    bool IsTransformOnly() const override;
+
 private:
     ea::string animatedAttribute_{};
 };
@@ -50,6 +50,10 @@ public:
     /// Serialize content from/to archive. May throw ArchiveException.
     void SerializeInBlock(Archive& archive) override;
 
+    /// Return whether the action changes nothing but position, rotation and scale of the target.
+    /// Such actions of unrelated nodes may be updated in parallel.
+    virtual bool IsTransformOnly() const { return false; }
+
 protected:
     /// Create new action state from the action.
     virtual SharedPtr<ActionState> StartAction(Object* target);
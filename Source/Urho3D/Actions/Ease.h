@@ -57,6 +57,9 @@ public:
     /// Apply easing function to the time argument.
     virtual float Ease(float time) const;
 
+    /// Return whether the action changes nothing but position, rotation and scale of the target.
+    bool IsTransformOnly() const override { return innerAction_ && innerAction_->IsTransformOnly(); }
+
 private:
     SharedPtr<FiniteTimeAction> innerAction_;
 };
@@ -129,6 +129,9 @@ public:
     /// Construct.
     explicit DelayTime(Context* context);
 
+    /// Return whether the action changes nothing but position, rotation and scale of the target.
+    bool IsTransformOnly() const override { return true; }
+
 protected:
     /// Create new action state from the action.
     SharedPtr<ActionState> StartAction(Object* target) override;
@@ -162,6 +162,9 @@ public:
     /// Get rotation pivot.
     const Vector3& GetPivot() const { return pivot_; }
 
+    /// Return whether the action changes nothing but position, rotation and scale of the target.
+    bool IsTransformOnly() const override { return true; }
+
     /// Create reversed action.
     SharedPtr<FiniteTimeAction> Reverse() const override;
 
@@ -28,6 +28,8 @@
 #include "FiniteTimeActionState.h"
 #include "Urho3D/IO/ArchiveSerializationContainer.h"
 
+#include <EASTL/algorithm.h>
+
 #include <numeric>
 
 namespace Urho3D
@@ -135,6 +137,13 @@ float Parallel::GetDuration() const {
     return duration;
 }
 
+/// Return whether the action changes nothing but position, rotation and scale of the target.
+bool Parallel::IsTransformOnly() const
+{
+    return ea::all_of(actions_.begin(), actions_.end(),
+        [](const SharedPtr<FiniteTimeAction>& action) { return action->IsTransformOnly(); });
+}
+
 /// Create reversed action.
 SharedPtr<FiniteTimeAction> Parallel::Reverse() const
 {
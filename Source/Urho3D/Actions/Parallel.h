@@ -54,6 +54,9 @@ public:
     /// Get action by index.
     FiniteTimeAction* GetAction(unsigned index) const;
 
+    /// Return whether the action changes nothing but position, rotation and scale of the target.
+    bool IsTransformOnly() const override;
+
     /// Create reversed action.
     SharedPtr<FiniteTimeAction> Reverse() const override;
 
@@ -47,6 +47,9 @@ public:
     /// Get inner action.
     FiniteTimeAction* GetInnerAction() const { return innerAction_.Get(); }
 
+    /// Return whether the action changes nothing but position, rotation and scale of the target.
+    bool IsTransformOnly() const override { return innerAction_ && innerAction_->IsTransformOnly(); }
+
     /// Set number of repetitions.
     void SetTimes(unsigned times);
 
@@ -85,6 +88,9 @@ public:
     /// Get inner action.
     FiniteTimeAction* GetInnerAction() const { return innerAction_.Get(); }
 
+    /// Return whether the action changes nothing but position, rotation and scale of the target.
+    bool IsTransformOnly() const override { return innerAction_ && innerAction_->IsTransformOnly(); }
+
     /// Create reversed action.
     SharedPtr<FiniteTimeAction> Reverse() const override;
 
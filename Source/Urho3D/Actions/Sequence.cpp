@@ -164,6 +164,12 @@ void Sequence::SetSecondAction(FiniteTimeAction* action)
 /// Get action duration.
 float Sequence::GetDuration() const { return actions_[0]->GetDuration() + actions_[1]->GetDuration(); }
 
+/// Return whether the action changes nothing but position, rotation and scale of the target.
+bool Sequence::IsTransformOnly() const
+{
+    return actions_[0]->IsTransformOnly() && actions_[1]->IsTransformOnly();
+}
+
 /// Create reversed action.
 SharedPtr<FiniteTimeAction> Sequence::Reverse() const
 {
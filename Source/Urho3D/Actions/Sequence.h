@@ -50,6 +50,8 @@ public:
     FiniteTimeAction* GetFirstAction() const { return actions_[0]; }
     /// Get second action.
     FiniteTimeAction* GetSecondAction() const { return actions_[1]; }
+    /// Return whether the action changes nothing but position, rotation and scale of the target.
+    bool IsTransformOnly() const override;
 
     /// Create reversed action.
     SharedPtr<FiniteTimeAction> Reverse() const override;
@@ -23,18 +23,23 @@
 #include "../Precompiled.h"
 
 #include "../Audio/Audio.h"
+#include "../Audio/AudioMixing.h"
 #include "../Audio/Microphone.h"
 #include "../Audio/Sound.h"
 #include "../Audio/SoundListener.h"
 #include "../Audio/SoundSource3D.h"
+#include "../Audio/SoundStream.h"
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
 #include "../Core/ProcessUtils.h"
 #include "../Core/Profiler.h"
+#include "../Core/Thread.h"
 #include "../IO/Log.h"
 
 #include <SDL.h>
 
+#include <EASTL/sort.h>
+
 #include "../DebugNew.h"
 
 #ifdef _MSC_VER
@@ -48,17 +53,11 @@ static const int MIN_BUFFERLENGTH = 20;
 static const int MIN_MIXRATE = 11025;
 static const int MAX_MIXRATE = 48000;
 static const StringHash SOUND_MASTER_HASH("Master");
+static const unsigned REVERB_TAIL_SECONDS = 5;
+static const unsigned DECODE_AHEAD_INTERVAL_MS = 10;
 
 static void SDLAudioCallback(void* userdata, Uint8* stream, int len);
 
-static const int AUDIO_NUM_CHANNELS[] = {
-    6, // Auto, just aim for 5.1
-    1, // mono
-    2, // stereo
-    4, // quadrophonic
-    6, // 5.1
-};
-
 // SM_AUTO is BAD!
 static const SpeakerMode CHANNELS_TO_MODE[] = {
     SPK_AUTO, // invalid actually,
@@ -88,6 +87,25 @@ static const char* SPEAKER_MODE_NAMES[] = {
     "5.1 Surround",
 };
 
+class Audio::DecoderThread : public Thread
+{
+public:
+    explicit DecoderThread(Audio* owner)
+        : Thread("AudioDecoder")
+        , owner_(owner)
+    {
+    }
+
+    void ThreadFunction() override
+    {
+        URHO3D_PROFILE_THREAD(name_.c_str());
+        owner_->ProcessDecodeAhead();
+    }
+
+private:
+    Audio* owner_{};
+};
+
 Audio::Audio(Context* context) :
     Object(context)
 {
@@ -104,6 +122,7 @@ Audio::Audio(Context* context) :
 
 Audio::~Audio()
 {
+    StopDecoderThread();
     Release();
     context_->ReleaseSDL();
 }
@@ -201,7 +220,20 @@ bool Audio::SetMode(int bufferLengthMSec, int mixRate, SpeakerMode speakerMode,
     fragmentSize_ = Min(NextPowerOfTwo((unsigned)mixRate >> 6u), (unsigned)obtained.samples);
     mixRate_ = obtained.freq;
     interpolation_ = interpolation;
-    clipBuffer_.reset(new int[fragmentSize_ * AUDIO_NUM_CHANNELS[speakerMode_]]);
+    clipBuffer_.reset(new float[fragmentSize_ * AUDIO_NUM_CHANNELS[speakerMode_]]);
+    sourceBuffer_.reset(new float[fragmentSize_ * 2]);
+    busBuffer_.reset(new float[fragmentSize_ * AUDIO_NUM_CHANNELS[speakerMode_]]);
+    reverbBuffer_.reset(new float[fragmentSize_]);
+
+    // Audio thread is not running, update its state directly
+    ProcessCommands();
+    reverb_.Initialize(mixRate_);
+    reverbTailSamples_ = 0;
+    for (MixBus& bus : mixBuses_)
+    {
+        bus.lowPass_.SetLowPass(bus.parameters_.lowPassCutoff_, mixRate_);
+        bus.highPass_.SetHighPass(bus.parameters_.highPassCutoff_, mixRate_);
+    }
 
     URHO3D_LOGINFO("Set audio mode " + ea::to_string(mixRate_) + " Hz " + SPEAKER_MODE_NAMES[speakerMode_] + " " +
             (interpolation_ ? "interpolated" : ""));
@@ -226,6 +258,13 @@ void Audio::Update(float timeStep)
 
     UpdateInternal(timeStep);
 
+    // Release streams that are no longer played
+    if (decoderThread_)
+    {
+        std::lock_guard<std::mutex> lock(decodeAheadMutex_);
+        ea::erase_if(decodeAheadStreams_, [](const SharedPtr<SoundStream>& stream) { return stream->Refs() == 1; });
+    }
+
     for (int i = 0; i < microphones_.size(); ++i)
     {
         if (auto mic = microphones_[i].Lock())
@@ -275,24 +314,60 @@ void Audio::SetMasterGain(const ea::string& type, float gain)
 
 void Audio::PauseSoundType(const ea::string& type)
 {
-    MutexLock lock(audioMutex_);
     pausedSoundTypes_.insert(type);
+
+    Command command;
+    command.type_ = CommandType::PauseSoundType;
+    command.soundType_ = type;
+    PushCommand(command);
 }
 
 void Audio::ResumeSoundType(const ea::string& type)
 {
-    MutexLock lock(audioMutex_);
     pausedSoundTypes_.erase(type);
-    // Update sound sources before resuming playback to make sure 3D positions are up to date
-    // Done under mutex to ensure no mixing happens before we are ready
+    // Update sound sources before resuming playback to make sure 3D positions are up to date.
+    // Audio thread resumes mixing only after the command is sent
     UpdateInternal(0.0f);
+
+    Command command;
+    command.type_ = CommandType::ResumeSoundType;
+    command.soundType_ = type;
+    PushCommand(command);
 }
 
 void Audio::ResumeAll()
 {
-    MutexLock lock(audioMutex_);
     pausedSoundTypes_.clear();
     UpdateInternal(0.0f);
+
+    Command command;
+    command.type_ = CommandType::ResumeAll;
+    PushCommand(command);
+}
+
+void Audio::SetBusParameters(const ea::string& type, const AudioBusParameters& parameters)
+{
+    const StringHash typeHash{type};
+    if (parameters.IsIdentity())
+        busParameters_.erase(typeHash);
+    else
+        busParameters_[typeHash] = parameters;
+
+    Command command;
+    command.type_ = CommandType::SetBusParameters;
+    command.soundType_ = typeHash;
+    command.busParameters_ = parameters;
+    PushCommand(command);
+}
+
+void Audio::SetReverbParameters(const AudioReverbParameters& parameters)
+{
+    reverbParameters_ = parameters;
+
+    Command command;
+    command.type_ = CommandType::SetReverbParameters;
+    command.reverbParameters_ = parameters;
+    PushCommand(command);
 }
 
 void Audio::SetListener(SoundListener* listener)
@@ -309,6 +384,12 @@ void Audio::StopSound(Sound* sound)
     }
 }
 
+void Audio::SetMaxVoices(unsigned maxVoices)
+{
+    MutexLock lock(audioMutex_);
+    maxVoices_ = maxVoices;
+}
+
 float Audio::GetMasterGain(const ea::string& type) const
 {
     // By definition previously unknown types return full volume
@@ -324,6 +405,12 @@ bool Audio::IsSoundTypePaused(const ea::string& type) const
     return pausedSoundTypes_.contains(type);
 }
 
+AudioBusParameters Audio::GetBusParameters(const ea::string& type) const
+{
+    const auto iter = busParameters_.find(type);
+    return iter != busParameters_.end() ? iter->second : AudioBusParameters{};
+}
+
 SoundListener* Audio::GetListener() const
 {
     return listener_;
@@ -345,6 +432,66 @@ void Audio::RemoveSoundSource(SoundSource* soundSource)
     }
 }
 
+void Audio::AddDecodeAheadStream(SoundStream* stream)
+{
+    if (!decodeAheadMs_ || !stream)
+        return;
+
+    const unsigned numBytes = stream->GetSampleSize() * stream->GetIntFrequency() * decodeAheadMs_ / 1000;
+    if (!stream->EnableDecodeAhead(numBytes))
+        return;
+
+    // Fill the buffer before playback starts
+    stream->DecodeAhead();
+
+    {
+        std::lock_guard<std::mutex> lock(decodeAheadMutex_);
+        decodeAheadStreams_.emplace_back(stream);
+    }
+
+    if (!decoderThread_)
+    {
+        decoderThread_ = ea::make_unique<DecoderThread>(this);
+        decoderThread_->Run();
+    }
+}
+
+void Audio::ProcessDecodeAhead()
+{
+    ea::vector<SharedPtr<SoundStream>> streams;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(decodeAheadMutex_);
+            decodeAheadCondition_.wait_for(lock, std::chrono::milliseconds(DECODE_AHEAD_INTERVAL_MS),
+                [this] { return stopDecoding_; });
+            if (stopDecoding_)
+                return;
+
+            streams = decodeAheadStreams_;
+        }
+
+        for (SoundStream* stream : streams)
+            stream->DecodeAhead();
+        streams.clear();
+    }
+}
+
+void Audio::StopDecoderThread()
+{
+    if (!decoderThread_)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(decodeAheadMutex_);
+        stopDecoding_ = true;
+    }
+    decodeAheadCondition_.notify_all();
+    decoderThread_->Stop();
+    decoderThread_ = nullptr;
+    decodeAheadStreams_.clear();
+}
+
 float Audio::GetSoundSourceMasterGain(StringHash typeHash) const
 {
     auto masterIt = masterGain_.find(SOUND_MASTER_HASH);
@@ -377,41 +524,198 @@ void Audio::MixOutput(void* dest, unsigned samples)
         return;
     }
 
+    ProcessCommands();
+
+    const unsigned numMixedSources = CollectMixedSources();
+    const unsigned numChannels = AUDIO_NUM_CHANNELS[speakerMode_];
+
     while (samples)
     {
         // If sample count exceeds the fragment (clip buffer) size, split the work
         unsigned workSamples = Min(samples, fragmentSize_);
-        unsigned clipSamples = workSamples;
-        if (speakerMode_ != SPK_MONO)
-            clipSamples = AUDIO_NUM_CHANNELS[speakerMode_] * fragmentSize_;
+        unsigned clipSamples = workSamples * numChannels;
+
+        // Mix samples to clip buffer and copy output from clip buffer to destination
+        float* clipPtr = clipBuffer_.get();
+        MixFragment(clipPtr, workSamples, numMixedSources);
+        ConvertToInt16(static_cast<short*>(dest), clipPtr, clipSamples);
 
-        // Clear clip buffer
-        int* clipPtr = clipBuffer_.get();
-        memset(clipPtr, 0, clipSamples * sizeof(int));
+        samples -= workSamples;
+        ((unsigned char*&)dest) += sampleSize_ * workSamples;
+    }
+}
 
-        // Mix samples to clip buffer
-        for (auto i = soundSources_.begin(); i != soundSources_.end(); ++i)
+void Audio::MixFragment(float dest[], unsigned samples, unsigned numMixedSources)
+{
+    const unsigned numChannels = AUDIO_NUM_CHANNELS[speakerMode_];
+    ea::fill_n(dest, samples * numChannels, 0.0f);
+
+    // Mix sources without bus effects directly. Virtualized sources only advance their playback position
+    for (unsigned i = 0; i < mixedSources_.size(); ++i)
+    {
+        const bool virtualized = i >= numMixedSources;
+        if (virtualized || mixedSourceBuses_[i] == M_MAX_UNSIGNED)
+            mixedSources_[i]->Mix(dest, sourceBuffer_.get(), samples, mixRate_, speakerMode_, interpolation_, virtualized);
+    }
+
+    // Process buses one by one block-wise
+    float* busBuffer = busBuffer_.get();
+    float* reverbBuffer = reverbBuffer_.get();
+    bool hasReverbInput = false;
+    for (unsigned busIndex = 0; busIndex < mixBuses_.size(); ++busIndex)
+    {
+        if (!mixedSourceBuses_.contains(busIndex))
+            continue;
+
+        MixBus& bus = mixBuses_[busIndex];
+        ea::fill_n(busBuffer, samples * numChannels, 0.0f);
+        for (unsigned i = 0; i < numMixedSources; ++i)
         {
-            SoundSource* source = *i;
+            if (mixedSourceBuses_[i] == busIndex)
+                mixedSources_[i]->Mix(busBuffer, sourceBuffer_.get(), samples, mixRate_, speakerMode_, interpolation_, false);
+        }
 
-            // Check for pause if necessary
-            if (!pausedSoundTypes_.empty())
+        bus.lowPass_.Process(busBuffer, samples, numChannels);
+        bus.highPass_.Process(busBuffer, samples, numChannels);
+
+        // Send downmixed bus output to the reverb
+        const float reverbSend = bus.parameters_.reverbSend_;
+        if (reverbSend > 0.0f)
+        {
+            if (!hasReverbInput)
+                ea::fill_n(reverbBuffer, samples, 0.0f);
+            hasReverbInput = true;
+
+            const float scale = reverbSend / numChannels;
+            for (unsigned frame = 0; frame < samples; ++frame)
             {
-                if (pausedSoundTypes_.contains(source->GetSoundType()))
-                    continue;
+                const float* busFrame = busBuffer + frame * numChannels;
+                for (unsigned channel = 0; channel < numChannels; ++channel)
+                    reverbBuffer[frame] += busFrame[channel] * scale;
             }
+        }
+
+        for (unsigned i = 0; i < samples * numChannels; ++i)
+            dest[i] += busBuffer[i];
+    }
+
+    // Keep reverb running for a while after the last send stopped to let the tail decay
+    if (hasReverbInput)
+        reverbTailSamples_ = mixRate_ * REVERB_TAIL_SECONDS;
+    else if (reverbTailSamples_ > 0)
+    {
+        ea::fill_n(reverbBuffer, samples, 0.0f);
+        reverbTailSamples_ -= Min(reverbTailSamples_, samples);
+    }
+    else
+        return;
+
+    reverb_.Process(reverbBuffer, dest, samples, numChannels, reverbGain_);
+}
+
+void Audio::PushCommand(const Command& command)
+{
+    if (commands_.Push(command))
+        return;
 
-            source->Mix(clipPtr, workSamples, mixRate_, speakerMode_, interpolation_);
+    // The queue is full because audio thread is not mixing, apply commands under the mutex
+    MutexLock lock(audioMutex_);
+    ProcessCommands();
+    commands_.Push(command);
+}
+
+void Audio::ProcessCommands()
+{
+    Command command;
+    while (commands_.Pop(command))
+    {
+        switch (command.type_)
+        {
+        case CommandType::PauseSoundType:
+            mixPausedSoundTypes_.insert(command.soundType_);
+            break;
+
+        case CommandType::ResumeSoundType:
+            mixPausedSoundTypes_.erase(command.soundType_);
+            break;
+
+        case CommandType::ResumeAll:
+            mixPausedSoundTypes_.clear();
+            break;
+
+        case CommandType::SetBusParameters:
+            ApplyBusParameters(command.soundType_, command.busParameters_);
+            break;
+
+        case CommandType::SetReverbParameters:
+            reverb_.SetParameters(command.reverbParameters_.roomSize_, command.reverbParameters_.damping_);
+            reverbGain_ = command.reverbParameters_.gain_;
+            break;
         }
-        // Copy output from clip buffer to destination
-        auto* destPtr = (short*)dest;
-        while (clipSamples--)
-            *destPtr++ = (short)Clamp(*clipPtr++, -32768, 32767);
-        samples -= workSamples;
-        ((unsigned char*&)dest) += sampleSize_ * workSamples;
     }
 }
 
+void Audio::ApplyBusParameters(StringHash soundType, const AudioBusParameters& parameters)
+{
+    const unsigned index = GetMixBusIndex(soundType);
+    if (parameters.IsIdentity())
+    {
+        if (index != M_MAX_UNSIGNED)
+            mixBuses_.erase_at(index);
+        return;
+    }
+
+    MixBus& bus = index != M_MAX_UNSIGNED ? mixBuses_[index] : mixBuses_.emplace_back();
+    bus.soundType_ = soundType;
+    bus.parameters_ = parameters;
+    bus.lowPass_.SetLowPass(parameters.lowPassCutoff_, mixRate_);
+    bus.highPass_.SetHighPass(parameters.highPassCutoff_, mixRate_);
+}
+
+unsigned Audio::GetMixBusIndex(StringHash soundType) const
+{
+    for (unsigned i = 0; i < mixBuses_.size(); ++i)
+    {
+        if (mixBuses_[i].soundType_ == soundType)
+            return i;
+    }
+    return M_MAX_UNSIGNED;
+}
+
+unsigned Audio::CollectMixedSources()
+{
+    mixedSources_.clear();
+    for (SoundSource* source : soundSources_)
+    {
+        // Check for pause if necessary
+        if (!mixPausedSoundTypes_.empty() && mixPausedSoundTypes_.contains(source->GetSoundTypeHash()))
+            continue;
+
+        mixedSources_.push_back(source);
+    }
+
+    unsigned numMixedSources = mixedSources_.size();
+    numVirtualVoices_ = 0;
+    if (maxVoices_ && numMixedSources > maxVoices_)
+    {
+        const auto isLouder = [](const SoundSource* lhs, const SoundSource* rhs)
+        {
+            return lhs->GetAudibility() > rhs->GetAudibility();
+        };
+        ea::nth_element(mixedSources_.begin(), mixedSources_.begin() + maxVoices_, mixedSources_.end(), isLouder);
+
+        numMixedSources = maxVoices_;
+        numVirtualVoices_ = ea::count_if(mixedSources_.begin() + maxVoices_, mixedSources_.end(),
+            [](const SoundSource* source) { return source->IsPlaying(); });
+    }
+
+    mixedSourceBuses_.clear();
+    for (SoundSource* source : mixedSources_)
+        mixedSourceBuses_.push_back(mixBuses_.empty() ? M_MAX_UNSIGNED : GetMixBusIndex(source->GetSoundTypeHash()));
+
+    return numMixedSources;
+}
+
 void Audio::HandleRenderUpdate(StringHash eventType, VariantMap& eventData)
 {
     using namespace RenderUpdate;
@@ -428,6 +732,9 @@ void Audio::Release()
         SDL_CloseAudioDevice(deviceID_);
         deviceID_ = 0;
         clipBuffer_.reset();
+        sourceBuffer_.reset();
+        busBuffer_.reset();
+        reverbBuffer_.reset();
     }
 }
 
@@ -25,7 +25,12 @@
 #include <EASTL/unique_ptr.h>
 #include <EASTL/hash_set.h>
 
+#include <condition_variable>
+#include <mutex>
+
 #include "../Audio/AudioDefs.h"
+#include "../Audio/AudioMixing.h"
+#include "../Container/SingleProducerQueue.h"
 #include "../Core/Mutex.h"
 #include "../Core/Object.h"
 
@@ -37,6 +42,32 @@ class Microphone;
 class Sound;
 class SoundListener;
 class SoundSource;
+class SoundStream;
+
+/// Parameters of submix bus that processes all sound sources of one sound type.
+struct AudioBusParameters
+{
+    /// Low-pass filter cutoff frequency in Hz. Zero disables the filter.
+    float lowPassCutoff_{};
+    /// High-pass filter cutoff frequency in Hz. Zero disables the filter.
+    float highPassCutoff_{};
+    /// Amount of bus output sent to the reverb.
+    float reverbSend_{};
+
+    /// Return whether the bus doesn't change the sound.
+    bool IsIdentity() const { return lowPassCutoff_ <= 0.0f && highPassCutoff_ <= 0.0f && reverbSend_ <= 0.0f; }
+};
+
+/// Parameters of the shared reverb.
+struct AudioReverbParameters
+{
+    /// Room size in range [0, 1].
+    float roomSize_{0.5f};
+    /// High frequency damping in range [0, 1].
+    float damping_{0.5f};
+    /// Output gain.
+    float gain_{1.0f};
+};
 
 /// %Audio subsystem.
 class URHO3D_API Audio : public Object
@@ -75,6 +106,16 @@ public:
     void SetListener(SoundListener* listener);
     /// Stop any sound source playing a certain sound clip.
     void StopSound(Sound* sound);
+    /// Set submix bus parameters of specific sound type. Sound types without bus effects are mixed directly.
+    void SetBusParameters(const ea::string& type, const AudioBusParameters& parameters);
+    /// Set parameters of the reverb shared by all buses.
+    void SetReverbParameters(const AudioReverbParameters& parameters);
+    /// Set how many milliseconds of compressed streams are decoded ahead of playback on the decoder thread. 0 decodes in the mixing thread.
+    /// @property
+    void SetDecodeAheadMs(unsigned ms) { decodeAheadMs_ = ms; }
+    /// Set maximum number of sound sources mixed at the same time. Quieter sources are virtualized and only advance their playback position. 0 is unlimited.
+    /// @property
+    void SetMaxVoices(unsigned maxVoices);
 
     /// Return byte size of one sample.
     /// @property
@@ -88,6 +129,17 @@ public:
     /// @property
     unsigned GetBufferLengthMS() const { return bufferLengthMSec_; }
 
+    /// Return maximum number of sound sources mixed at the same time.
+    /// @property
+    unsigned GetMaxVoices() const { return maxVoices_; }
+
+    /// Return how many milliseconds of compressed streams are decoded ahead of playback.
+    /// @property
+    unsigned GetDecodeAheadMs() const { return decodeAheadMs_; }
+
+    /// Return number of sound sources virtualized during last mix.
+    unsigned GetNumVirtualVoices() const { return numVirtualVoices_; }
+
     /// Return whether output is interpolated.
     /// @property
     bool GetInterpolation() const { return interpolation_; }
@@ -111,6 +163,12 @@ public:
     /// Return whether specific sound type has been paused.
     bool IsSoundTypePaused(const ea::string& type) const;
 
+    /// Return submix bus parameters of specific sound type.
+    AudioBusParameters GetBusParameters(const ea::string& type) const;
+
+    /// Return parameters of the reverb shared by all buses.
+    const AudioReverbParameters& GetReverbParameters() const { return reverbParameters_; }
+
     /// Return active sound listener.
     /// @property
     SoundListener* GetListener() const;
@@ -125,6 +183,8 @@ public:
     void AddSoundSource(SoundSource* soundSource);
     /// Remove a sound source. Called by SoundSource.
     void RemoveSoundSource(SoundSource* soundSource);
+    /// Start decoding stream ahead of playback if enabled and supported by stream. Called by SoundSource.
+    void AddDecodeAheadStream(SoundStream* stream);
 
     /// Return audio thread mutex.
     Mutex& GetMutex() { return audioMutex_; }
@@ -143,15 +203,94 @@ public:
     void CloseMicrophoneForLoss(unsigned which);
 
 private:
+    class DecoderThread;
+
+    /// Type of command sent from main thread to audio thread.
+    enum class CommandType
+    {
+        PauseSoundType,
+        ResumeSoundType,
+        ResumeAll,
+        SetBusParameters,
+        SetReverbParameters,
+    };
+
+    /// Command sent from main thread to audio thread.
+    struct Command
+    {
+        /// Command type.
+        CommandType type_{};
+        /// Sound type affected by the command.
+        StringHash soundType_;
+        /// Bus parameters.
+        AudioBusParameters busParameters_;
+        /// Reverb parameters.
+        AudioReverbParameters reverbParameters_;
+    };
+
+    /// Submix bus state owned by audio thread.
+    struct MixBus
+    {
+        /// Sound type.
+        StringHash soundType_;
+        /// Parameters.
+        AudioBusParameters parameters_;
+        /// Low-pass filter.
+        BiquadFilter lowPass_;
+        /// High-pass filter.
+        BiquadFilter highPass_;
+    };
+
+    /// Maximum number of commands queued between mixes.
+    static const unsigned MAX_COMMANDS = 256;
+
+    /// Send command to audio thread without blocking. Blocks only if the queue is full.
+    void PushCommand(const Command& command);
+    /// Apply commands sent from main thread. Called from audio thread or under audio mutex.
+    void ProcessCommands();
+    /// Apply bus parameters to audio thread state.
+    void ApplyBusParameters(StringHash soundType, const AudioBusParameters& parameters);
+    /// Return index of the bus for sound type or M_MAX_UNSIGNED if mixed directly.
+    unsigned GetMixBusIndex(StringHash soundType) const;
+    /// Mix one fragment of all collected sound sources with bus processing.
+    void MixFragment(float dest[], unsigned samples, unsigned numMixedSources);
+    /// Decode streams ahead of playback until stopped. Called from decoder thread.
+    void ProcessDecodeAhead();
+    /// Stop decoder thread.
+    void StopDecoderThread();
     /// Handle render update event.
     void HandleRenderUpdate(StringHash eventType, VariantMap& eventData);
     /// Stop sound output and release the sound buffer.
     void Release();
     /// Actually update sound sources with the specific timestep. Called internally.
     void UpdateInternal(float timeStep);
+    /// Collect unpaused sound sources for mixing, loudest first. Return number of sources that are actually mixed.
+    unsigned CollectMixedSources();
 
     /// Clipping buffer for mixing.
-    ea::unique_ptr<int[]> clipBuffer_;
+    ea::unique_ptr<float[]> clipBuffer_;
+    /// Scratch buffer for resampling of individual sound sources.
+    ea::unique_ptr<float[]> sourceBuffer_;
+    /// Buffer of submix bus being processed.
+    ea::unique_ptr<float[]> busBuffer_;
+    /// Mono input of the reverb.
+    ea::unique_ptr<float[]> reverbBuffer_;
+    /// Sound sources being mixed.
+    ea::vector<SoundSource*> mixedSources_;
+    /// Bus indices of sound sources being mixed.
+    ea::vector<unsigned> mixedSourceBuses_;
+    /// Submix buses with effects. Owned by audio thread.
+    ea::vector<MixBus> mixBuses_;
+    /// Shared reverb. Owned by audio thread.
+    AudioReverb reverb_;
+    /// Reverb output gain. Owned by audio thread.
+    float reverbGain_{1.0f};
+    /// Number of samples to process reverb after the last input. Owned by audio thread.
+    unsigned reverbTailSamples_{};
+    /// Paused sound types as seen by audio thread.
+    ea::hash_set<StringHash> mixPausedSoundTypes_;
+    /// Commands from main thread to audio thread.
+    SingleProducerQueue<Command, MAX_COMMANDS> commands_;
     /// Audio thread mutex.
     Mutex audioMutex_;
     /// SDL audio device ID.
@@ -170,14 +309,34 @@ private:
     SpeakerMode speakerMode_{SpeakerMode::SPK_AUTO};
     /// Playing flag.
     bool playing_{};
+    /// Maximum number of sound sources mixed at the same time.
+    unsigned maxVoices_{};
+    /// Number of sound sources virtualized during last mix.
+    unsigned numVirtualVoices_{};
     /// Master gain by sound source type.
     ea::unordered_map<StringHash, Variant> masterGain_;
-    /// Paused sound types.
+    /// Paused sound types as seen by main thread.
     ea::hash_set<StringHash> pausedSoundTypes_;
+    /// Submix bus parameters as seen by main thread.
+    ea::unordered_map<StringHash, AudioBusParameters> busParameters_;
+    /// Reverb parameters as seen by main thread.
+    AudioReverbParameters reverbParameters_;
     /// Sound sources.
     ea::vector<SoundSource*> soundSources_;
     /// Sound listener.
     WeakPtr<SoundListener> listener_;
+    /// How many milliseconds of compressed streams are decoded ahead of playback.
+    unsigned decodeAheadMs_{250};
+    /// Streams decoded ahead of playback.
+    ea::vector<SharedPtr<SoundStream>> decodeAheadStreams_;
+    /// Protects decoding ahead state.
+    std::mutex decodeAheadMutex_;
+    /// Wakes up decoder thread.
+    std::condition_variable decodeAheadCondition_;
+    /// Whether decoder thread should stop.
+    bool stopDecoding_{};
+    /// Decoder thread.
+    ea::unique_ptr<DecoderThread> decoderThread_;
     /// List of microphones being tracked.
     ea::vector< WeakPtr<Microphone> > microphones_;
 };
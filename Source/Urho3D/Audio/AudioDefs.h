@@ -44,4 +44,13 @@ enum SpeakerMode
     SPK_SURROUND_5_1,   // 5.1 Surround, FL-FR-RL-RR-C-S (again WAV order)
 };
 
+// Number of output channels by speaker mode.
+static const int AUDIO_NUM_CHANNELS[] = {
+    6, // Auto, just aim for 5.1
+    1, // mono
+    2, // stereo
+    4, // quadrophonic
+    6, // 5.1
+};
+
 }
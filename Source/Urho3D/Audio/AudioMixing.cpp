@@ -0,0 +1,372 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Audio/AudioMixing.h"
+#include "../Math/MathDefs.h"
+
+#if defined(URHO3D_SSE)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+const float INT16_SCALE = 32767.0f;
+
+/// Delay line lengths are tuned for 44.1 kHz and scaled for other mixing rates.
+const unsigned REVERB_COMB_LENGTHS[] = {1116, 1188, 1277, 1356};
+const unsigned REVERB_ALLPASS_LENGTHS[] = {556, 441};
+const float REVERB_INPUT_GAIN = 0.03f;
+const float REVERB_ALLPASS_FEEDBACK = 0.5f;
+
+void MixMonoToMonoScalar(float dest[], const float source[], unsigned numFrames, float gain)
+{
+    for (unsigned i = 0; i < numFrames; ++i)
+        dest[i] += source[i] * gain;
+}
+
+void MixMonoToStereoScalar(float dest[], const float source[], unsigned numFrames, float leftGain, float rightGain)
+{
+    for (unsigned i = 0; i < numFrames; ++i)
+    {
+        dest[i * 2] += source[i] * leftGain;
+        dest[i * 2 + 1] += source[i] * rightGain;
+    }
+}
+
+void MixStereoToStereoScalar(float dest[], const float source[], unsigned numFrames,
+    const float leftGains[], const float rightGains[])
+{
+    for (unsigned i = 0; i < numFrames; ++i)
+    {
+        const float left = source[i * 2];
+        const float right = source[i * 2 + 1];
+        dest[i * 2] += left * leftGains[0] + right * rightGains[0];
+        dest[i * 2 + 1] += left * leftGains[1] + right * rightGains[1];
+    }
+}
+
+void ConvertToInt16Scalar(short dest[], const float source[], unsigned numSamples)
+{
+    for (unsigned i = 0; i < numSamples; ++i)
+        dest[i] = static_cast<short>(RoundToInt(Clamp(source[i], -1.0f, 1.0f) * INT16_SCALE));
+}
+
+#if defined(__ARM_NEON)
+/// Round to nearest integer as other paths do, plain conversion truncates.
+int32x4_t RoundToInt32x4(float32x4_t value)
+{
+#if defined(__aarch64__)
+    return vcvtnq_s32_f32(value);
+#else
+    // Add 0.5 with the sign of the value, so the truncation rounds half away from zero
+    const uint32x4_t signBit = vandq_u32(vreinterpretq_u32_f32(value), vdupq_n_u32(0x80000000u));
+    const float32x4_t half = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(vdupq_n_f32(0.5f)), signBit));
+    return vcvtq_s32_f32(vaddq_f32(value, half));
+#endif
+}
+#endif
+
+}
+
+void MixMonoToChannels(float dest[], const float source[], unsigned numFrames, unsigned numChannels,
+    const float gains[])
+{
+    unsigned numProcessed = 0;
+
+    if (numChannels == 1)
+    {
+#if defined(URHO3D_SSE)
+        const __m128 gain = _mm_set1_ps(gains[0]);
+        for (; numProcessed + 4 <= numFrames; numProcessed += 4)
+        {
+            const __m128 value = _mm_loadu_ps(source + numProcessed);
+            const __m128 result = _mm_add_ps(_mm_loadu_ps(dest + numProcessed), _mm_mul_ps(value, gain));
+            _mm_storeu_ps(dest + numProcessed, result);
+        }
+#elif defined(__ARM_NEON)
+        const float32x4_t gain = vdupq_n_f32(gains[0]);
+        for (; numProcessed + 4 <= numFrames; numProcessed += 4)
+        {
+            const float32x4_t value = vld1q_f32(source + numProcessed);
+            vst1q_f32(dest + numProcessed, vmlaq_f32(vld1q_f32(dest + numProcessed), value, gain));
+        }
+#endif
+        MixMonoToMonoScalar(dest + numProcessed, source + numProcessed, numFrames - numProcessed, gains[0]);
+    }
+    else if (numChannels == 2)
+    {
+#if defined(URHO3D_SSE)
+        const __m128 gain = _mm_setr_ps(gains[0], gains[1], gains[0], gains[1]);
+        for (; numProcessed + 4 <= numFrames; numProcessed += 4)
+        {
+            const __m128 value = _mm_loadu_ps(source + numProcessed);
+            float* destPtr = dest + numProcessed * 2;
+            const __m128 low = _mm_mul_ps(_mm_unpacklo_ps(value, value), gain);
+            const __m128 high = _mm_mul_ps(_mm_unpackhi_ps(value, value), gain);
+            _mm_storeu_ps(destPtr, _mm_add_ps(_mm_loadu_ps(destPtr), low));
+            _mm_storeu_ps(destPtr + 4, _mm_add_ps(_mm_loadu_ps(destPtr + 4), high));
+        }
+#elif defined(__ARM_NEON)
+        const float32x4_t gain = {gains[0], gains[1], gains[0], gains[1]};
+        for (; numProcessed + 4 <= numFrames; numProcessed += 4)
+        {
+            const float32x4_t value = vld1q_f32(source + numProcessed);
+            const float32x4x2_t duplicated = vzipq_f32(value, value);
+            float* destPtr = dest + numProcessed * 2;
+            vst1q_f32(destPtr, vmlaq_f32(vld1q_f32(destPtr), duplicated.val[0], gain));
+            vst1q_f32(destPtr + 4, vmlaq_f32(vld1q_f32(destPtr + 4), duplicated.val[1], gain));
+        }
+#endif
+        MixMonoToStereoScalar(dest + numProcessed * 2, source + numProcessed, numFrames - numProcessed,
+            gains[0], gains[1]);
+    }
+    else
+    {
+        for (unsigned i = 0; i < numFrames; ++i)
+        {
+            for (unsigned channel = 0; channel < numChannels; ++channel)
+                dest[channel] += source[i] * gains[channel];
+            dest += numChannels;
+        }
+    }
+}
+
+void MixStereoToChannels(float dest[], const float source[], unsigned numFrames, unsigned numChannels,
+    const float leftGains[], const float rightGains[])
+{
+    unsigned numProcessed = 0;
+
+    if (numChannels == 2)
+    {
+        // Each output channel is sum of the same channel and the swapped channel of the input frame
+#if defined(URHO3D_SSE)
+        const __m128 directGain = _mm_setr_ps(leftGains[0], rightGains[1], leftGains[0], rightGains[1]);
+        const __m128 crossGain = _mm_setr_ps(rightGains[0], leftGains[1], rightGains[0], leftGains[1]);
+        for (; numProcessed + 2 <= numFrames; numProcessed += 2)
+        {
+            const __m128 value = _mm_loadu_ps(source + numProcessed * 2);
+            const __m128 swapped = _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1));
+            float* destPtr = dest + numProcessed * 2;
+            const __m128 result = _mm_add_ps(_mm_mul_ps(value, directGain), _mm_mul_ps(swapped, crossGain));
+            _mm_storeu_ps(destPtr, _mm_add_ps(_mm_loadu_ps(destPtr), result));
+        }
+#elif defined(__ARM_NEON)
+        const float32x4_t directGain = {leftGains[0], rightGains[1], leftGains[0], rightGains[1]};
+        const float32x4_t crossGain = {rightGains[0], leftGains[1], rightGains[0], leftGains[1]};
+        for (; numProcessed + 2 <= numFrames; numProcessed += 2)
+        {
+            const float32x4_t value = vld1q_f32(source + numProcessed * 2);
+            const float32x4_t swapped = vrev64q_f32(value);
+            float* destPtr = dest + numProcessed * 2;
+            const float32x4_t result = vmlaq_f32(vmulq_f32(value, directGain), swapped, crossGain);
+            vst1q_f32(destPtr, vaddq_f32(vld1q_f32(destPtr), result));
+        }
+#endif
+        MixStereoToStereoScalar(dest + numProcessed * 2, source + numProcessed * 2, numFrames - numProcessed,
+            leftGains, rightGains);
+    }
+    else
+    {
+        for (unsigned i = 0; i < numFrames; ++i)
+        {
+            const float left = source[i * 2];
+            const float right = source[i * 2 + 1];
+            for (unsigned channel = 0; channel < numChannels; ++channel)
+                dest[channel] += left * leftGains[channel] + right * rightGains[channel];
+            dest += numChannels;
+        }
+    }
+}
+
+void ConvertToInt16(short dest[], const float source[], unsigned numSamples)
+{
+    unsigned numProcessed = 0;
+
+#if defined(URHO3D_SSE)
+    const __m128 scale = _mm_set1_ps(INT16_SCALE);
+    const __m128 minValue = _mm_set1_ps(-1.0f);
+    const __m128 maxValue = _mm_set1_ps(1.0f);
+    for (; numProcessed + 8 <= numSamples; numProcessed += 8)
+    {
+        const __m128 low = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + numProcessed), minValue), maxValue);
+        const __m128 high = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + numProcessed + 4), minValue), maxValue);
+        const __m128i lowInt = _mm_cvtps_epi32(_mm_mul_ps(low, scale));
+        const __m128i highInt = _mm_cvtps_epi32(_mm_mul_ps(high, scale));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + numProcessed), _mm_packs_epi32(lowInt, highInt));
+    }
+#elif defined(__ARM_NEON)
+    const float32x4_t minValue = vdupq_n_f32(-1.0f);
+    const float32x4_t maxValue = vdupq_n_f32(1.0f);
+    for (; numProcessed + 8 <= numSamples; numProcessed += 8)
+    {
+        const float32x4_t low = vminq_f32(vmaxq_f32(vld1q_f32(source + numProcessed), minValue), maxValue);
+        const float32x4_t high = vminq_f32(vmaxq_f32(vld1q_f32(source + numProcessed + 4), minValue), maxValue);
+        const int32x4_t lowInt = RoundToInt32x4(vmulq_n_f32(low, INT16_SCALE));
+        const int32x4_t highInt = RoundToInt32x4(vmulq_n_f32(high, INT16_SCALE));
+        vst1q_s16(dest + numProcessed, vcombine_s16(vqmovn_s32(lowInt), vqmovn_s32(highInt)));
+    }
+#endif
+
+    ConvertToInt16Scalar(dest + numProcessed, source + numProcessed, numSamples - numProcessed);
+}
+
+void BiquadFilter::SetLowPass(float cutoff, int mixRate)
+{
+    SetCoefficients(cutoff, mixRate, false);
+}
+
+void BiquadFilter::SetHighPass(float cutoff, int mixRate)
+{
+    SetCoefficients(cutoff, mixRate, true);
+}
+
+void BiquadFilter::SetCoefficients(float cutoff, int mixRate, bool highPass)
+{
+    const float nyquist = mixRate * 0.5f;
+    enabled_ = cutoff > 0.0f && cutoff < nyquist;
+    if (!enabled_)
+    {
+        Reset();
+        return;
+    }
+
+    // Butterworth response
+    const float q = 0.70710678f;
+    const float omega = 2.0f * M_PI * cutoff / mixRate;
+    const float cosOmega = cosf(omega);
+    const float alpha = sinf(omega) / (2.0f * q);
+    const float a0 = 1.0f + alpha;
+
+    if (highPass)
+    {
+        b0_ = (1.0f + cosOmega) * 0.5f / a0;
+        b1_ = -(1.0f + cosOmega) / a0;
+    }
+    else
+    {
+        b0_ = (1.0f - cosOmega) * 0.5f / a0;
+        b1_ = (1.0f - cosOmega) / a0;
+    }
+    b2_ = b0_;
+    a1_ = -2.0f * cosOmega / a0;
+    a2_ = (1.0f - alpha) / a0;
+}
+
+void BiquadFilter::Reset()
+{
+    for (auto& channelState : state_)
+        channelState[0] = channelState[1] = 0.0f;
+}
+
+void BiquadFilter::Process(float buffer[], unsigned numFrames, unsigned numChannels)
+{
+    if (!enabled_)
+        return;
+
+    // Transposed direct form II, channels are processed separately to keep history in registers
+    for (unsigned channel = 0; channel < numChannels; ++channel)
+    {
+        float z1 = state_[channel][0];
+        float z2 = state_[channel][1];
+        for (unsigned i = 0; i < numFrames; ++i)
+        {
+            float& sample = buffer[i * numChannels + channel];
+            const float input = sample;
+            const float output = b0_ * input + z1;
+            z1 = b1_ * input - a1_ * output + z2;
+            z2 = b2_ * input - a2_ * output;
+            sample = output;
+        }
+        state_[channel][0] = z1;
+        state_[channel][1] = z2;
+    }
+}
+
+void AudioReverb::Initialize(int mixRate)
+{
+    const float scale = mixRate / 44100.0f;
+    for (unsigned i = 0; i < combs_.size(); ++i)
+    {
+        combs_[i].buffer_.assign(Max(1, RoundToInt(REVERB_COMB_LENGTHS[i] * scale)), 0.0f);
+        combs_[i].index_ = 0;
+        combs_[i].filterStore_ = 0.0f;
+    }
+    for (unsigned i = 0; i < allpasses_.size(); ++i)
+    {
+        allpasses_[i].buffer_.assign(Max(1, RoundToInt(REVERB_ALLPASS_LENGTHS[i] * scale)), 0.0f);
+        allpasses_[i].index_ = 0;
+    }
+}
+
+void AudioReverb::SetParameters(float roomSize, float damping)
+{
+    feedback_ = Clamp(roomSize, 0.0f, 1.0f) * 0.28f + 0.7f;
+    damping_ = Clamp(damping, 0.0f, 1.0f) * 0.4f;
+}
+
+void AudioReverb::Process(const float input[], float dest[], unsigned numFrames, unsigned numChannels, float gain)
+{
+    if (combs_[0].buffer_.empty())
+        return;
+
+    for (unsigned i = 0; i < numFrames; ++i)
+    {
+        const float value = input[i] * REVERB_INPUT_GAIN;
+
+        float output = 0.0f;
+        for (DelayLine& comb : combs_)
+        {
+            const float delayed = comb.buffer_[comb.index_];
+            comb.filterStore_ = delayed * (1.0f - damping_) + comb.filterStore_ * damping_;
+            comb.buffer_[comb.index_] = value + comb.filterStore_ * feedback_;
+            if (++comb.index_ >= comb.buffer_.size())
+                comb.index_ = 0;
+            output += delayed;
+        }
+
+        for (DelayLine& allpass : allpasses_)
+        {
+            const float delayed = allpass.buffer_[allpass.index_];
+            allpass.buffer_[allpass.index_] = output + delayed * REVERB_ALLPASS_FEEDBACK;
+            if (++allpass.index_ >= allpass.buffer_.size())
+                allpass.index_ = 0;
+            output = delayed - output;
+        }
+
+        output *= gain;
+        for (unsigned channel = 0; channel < numChannels; ++channel)
+            dest[channel] += output;
+        dest += numChannels;
+    }
+}
+
+}
@@ -0,0 +1,110 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/// \file
+/// Mixing kernels used by Audio and SoundSource.
+/// Samples are 32-bit floats where full scale is [-1, 1]. Multichannel buffers are interleaved.
+
+#pragma once
+
+#include "../Urho3D.h"
+
+#include <EASTL/array.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+/// Maximum number of output channels.
+static const unsigned MAX_AUDIO_CHANNELS = 6;
+
+/// Mix mono frames into output buffer with per output channel gains.
+URHO3D_API void MixMonoToChannels(float dest[], const float source[], unsigned numFrames, unsigned numChannels,
+    const float gains[]);
+/// Mix stereo frames into output buffer with per output channel gains of left and right input channels.
+URHO3D_API void MixStereoToChannels(float dest[], const float source[], unsigned numFrames, unsigned numChannels,
+    const float leftGains[], const float rightGains[]);
+/// Clamp and convert samples to 16-bit integers.
+URHO3D_API void ConvertToInt16(short dest[], const float source[], unsigned numSamples);
+
+/// Second order filter applied to interleaved buffer in place.
+class URHO3D_API BiquadFilter
+{
+public:
+    /// Configure as low-pass filter. Zero cutoff disables the filter.
+    void SetLowPass(float cutoff, int mixRate);
+    /// Configure as high-pass filter. Zero cutoff disables the filter.
+    void SetHighPass(float cutoff, int mixRate);
+    /// Reset filter history.
+    void Reset();
+    /// Filter buffer in place.
+    void Process(float buffer[], unsigned numFrames, unsigned numChannels);
+
+    /// Return whether the filter is enabled.
+    bool IsEnabled() const { return enabled_; }
+
+private:
+    /// Calculate coefficients from cookbook formulas.
+    void SetCoefficients(float cutoff, int mixRate, bool highPass);
+
+    /// Whether the filter is enabled.
+    bool enabled_{};
+    /// Normalized coefficients.
+    float b0_{1.0f}, b1_{}, b2_{}, a1_{}, a2_{};
+    /// Filter history per channel.
+    float state_[MAX_AUDIO_CHANNELS][2]{};
+};
+
+/// Low-cost mono reverb made of parallel comb filters followed by series allpass filters.
+class URHO3D_API AudioReverb
+{
+public:
+    /// Allocate delay lines for mixing rate.
+    void Initialize(int mixRate);
+    /// Set room size and high frequency damping, both in range [0, 1].
+    void SetParameters(float roomSize, float damping);
+    /// Process mono input and add reverberated output to all channels of interleaved buffer.
+    void Process(const float input[], float dest[], unsigned numFrames, unsigned numChannels, float gain);
+
+private:
+    /// Delay line.
+    struct DelayLine
+    {
+        /// Delayed samples.
+        ea::vector<float> buffer_;
+        /// Current index.
+        unsigned index_{};
+        /// Low-pass state of comb filter.
+        float filterStore_{};
+    };
+
+    /// Comb filters.
+    ea::array<DelayLine, 4> combs_;
+    /// Allpass filters.
+    ea::array<DelayLine, 2> allpasses_;
+    /// Comb filter feedback.
+    float feedback_{0.84f};
+    /// Comb filter damping.
+    float damping_{0.2f};
+};
+
+}
@@ -66,6 +66,9 @@ bool OggVorbisSoundStream::Seek(unsigned sample_number)
 
     auto* vorbis = static_cast<stb_vorbis*>(decoder_);
 
+    MutexLock lock(decoderMutex_);
+    if (decodeAhead_)
+        flushPending_.store(true, std::memory_order_release);
     return stb_vorbis_seek(vorbis, sample_number) == 1;
 }
 
@@ -74,6 +77,69 @@ unsigned OggVorbisSoundStream::GetData(signed char* dest, unsigned numBytes)
     if (!decoder_)
         return 0;
 
+    if (!decodeAhead_)
+    {
+        MutexLock lock(decoderMutex_);
+        return Decode(dest, numBytes);
+    }
+
+    if (flushPending_.load(std::memory_order_acquire))
+    {
+        decodedData_.Clear();
+        flushPending_.store(false, std::memory_order_release);
+    }
+
+    unsigned outBytes = decodedData_.Pop(dest, numBytes);
+    if (outBytes < numBytes)
+    {
+        // Decoder thread fell behind, decode the rest synchronously
+        MutexLock lock(decoderMutex_);
+        outBytes += decodedData_.Pop(dest + outBytes, numBytes - outBytes);
+        if (outBytes < numBytes && !flushPending_.load(std::memory_order_acquire))
+            outBytes += Decode(dest + outBytes, numBytes - outBytes);
+    }
+
+    return outBytes;
+}
+
+bool OggVorbisSoundStream::EnableDecodeAhead(unsigned numBytes)
+{
+    if (!decoder_ || decodeAhead_)
+        return false;
+
+    const unsigned sampleSize = GetSampleSize();
+    decodedData_.Allocate(Max(numBytes / sampleSize, 1u) * sampleSize);
+    decodeAhead_ = true;
+    return true;
+}
+
+void OggVorbisSoundStream::DecodeAhead()
+{
+    static const unsigned chunkSize = 4096;
+    signed char chunk[chunkSize];
+
+    const unsigned sampleSize = GetSampleSize();
+    const unsigned maxChunkBytes = chunkSize / sampleSize * sampleSize;
+    while (true)
+    {
+        // Release the lock between chunks so the mixing thread is never blocked for long
+        MutexLock lock(decoderMutex_);
+        if (flushPending_.load(std::memory_order_acquire))
+            break;
+
+        const unsigned numBytes = Min(decodedData_.GetFreeSpace() / sampleSize * sampleSize, maxChunkBytes);
+        if (!numBytes)
+            break;
+
+        const unsigned outBytes = Decode(chunk, numBytes);
+        decodedData_.Push(chunk, outBytes);
+        if (outBytes < numBytes)
+            break;
+    }
+}
+
+unsigned OggVorbisSoundStream::Decode(signed char* dest, unsigned numBytes)
+{
     auto* vorbis = static_cast<stb_vorbis*>(decoder_);
 
     unsigned channels = stereo_ ? 2 : 1;
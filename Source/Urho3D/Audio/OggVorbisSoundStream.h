@@ -25,6 +25,10 @@
 #include <EASTL/shared_array.h>
 
 #include "../Audio/SoundStream.h"
+#include "../Container/SingleProducerQueue.h"
+#include "../Core/Mutex.h"
+
+#include <atomic>
 
 namespace Urho3D
 {
@@ -44,9 +48,25 @@ public:
     bool Seek(unsigned sample_number) override;
 
     /// Produce sound data into destination. Return number of bytes produced. Called by SoundSource from the mixing thread.
+    /// Copies decoded data if decoding ahead is enabled and decodes the rest synchronously.
     unsigned GetData(signed char* dest, unsigned numBytes) override;
+    /// Enable decoding ahead of playback into buffer of specified size.
+    bool EnableDecodeAhead(unsigned numBytes) override;
+    /// Decode data ahead of playback until the buffer is full.
+    void DecodeAhead() override;
 
 protected:
+    /// Decode data with looping. Decoder mutex should be locked.
+    unsigned Decode(signed char* dest, unsigned numBytes);
+
+    /// Protects decoder state.
+    Mutex decoderMutex_;
+    /// Data decoded ahead of playback.
+    SingleProducerRingBuffer<signed char> decodedData_;
+    /// Whether decoding ahead is enabled.
+    bool decodeAhead_{};
+    /// Whether decoded data is outdated after seek and should be discarded by the mixing thread.
+    std::atomic<bool> flushPending_{};
     /// Decoder state.
     void* decoder_;
     /// Compressed sound data.
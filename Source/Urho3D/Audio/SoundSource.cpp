@@ -23,6 +23,7 @@
 #include "../Precompiled.h"
 
 #include "../Audio/Audio.h"
+#include "../Audio/AudioMixing.h"
 #include "../Audio/AudioEvents.h"
 #include "../Audio/Sound.h"
 #include "../Audio/SoundSource.h"
@@ -46,61 +47,75 @@ static const int SOUND_SOURCE_LOW_FREQ_CHANNEL[] = {
     3, // SPK_SURROUND_5_1
 };
 
-#define INC_POS_LOOPED() \
-    pos += intAdd; \
-    fractPos += fractAdd; \
-    if (fractPos > 65535) \
-    { \
-        fractPos &= 65535; \
-        ++pos; \
-    } \
-    while (pos >= end) \
-        pos -= (end - repeat); \
-
-#define INC_POS_ONESHOT() \
-    pos += intAdd; \
-    fractPos += fractAdd; \
-    if (fractPos > 65535) \
-    { \
-        fractPos &= 65535; \
-        ++pos; \
-    } \
-    if (pos >= end) \
-    { \
-        pos = 0; \
-        break; \
-    } \
-
-#define INC_POS_STEREO_LOOPED() \
-    pos += ((unsigned)intAdd << 1u); \
-    fractPos += fractAdd; \
-    if (fractPos > 65535) \
-    { \
-        fractPos &= 65535; \
-        pos += 2; \
-    } \
-    while (pos >= end) \
-        pos -= (end - repeat); \
-
-#define INC_POS_STEREO_ONESHOT() \
-    pos += ((unsigned)intAdd << 1u); \
-    fractPos += fractAdd; \
-    if (fractPos > 65535) \
-    { \
-        fractPos &= 65535; \
-        pos += 2; \
-    } \
-    if (pos >= end) \
-    { \
-        pos = 0; \
-        break; \
-    } \
-
-#define GET_IP_SAMPLE() (((((int)pos[1] - (int)pos[0]) * fractPos) / 65536) + (int)pos[0])
-
-#define GET_IP_SAMPLE_LEFT() (((((int)pos[2] - (int)pos[0]) * fractPos) / 65536) + (int)pos[0])
-
-#define GET_IP_SAMPLE_RIGHT() (((((int)pos[3] - (int)pos[1]) * fractPos) / 65536) + (int)pos[1])
+namespace
+{
+
+/// Resample sound data into normalized float frames. Return number of frames produced before one-shot sound end.
+template <class T, unsigned NumChannels, bool Looped, bool Interpolate>
+unsigned ResampleFrames(const T*& pos, int& fractPos, const T* end, const T* repeat, int intAdd, int fractAdd,
+    float scale, float dest[], unsigned numFrames)
+{
+    for (unsigned i = 0; i < numFrames; ++i)
+    {
+        for (unsigned channel = 0; channel < NumChannels; ++channel)
+        {
+            float value = pos[channel];
+            if constexpr (Interpolate)
+                value += (pos[channel + NumChannels] - value) * (fractPos * (1.0f / 65536.0f));
+            dest[channel] = value * scale;
+        }
+        dest += NumChannels;
+
+        pos += intAdd * NumChannels;
+        fractPos += fractAdd;
+        if (fractPos > 65535)
+        {
+            fractPos &= 65535;
+            pos += NumChannels;
+        }
+
+        if constexpr (Looped)
+        {
+            while (pos >= end)
+                pos -= (end - repeat);
+        }
+        else if (pos >= end)
+        {
+            pos = nullptr;
+            return i + 1;
+        }
+    }
+    return numFrames;
+}
+
+template <class T, unsigned NumChannels>
+unsigned ResampleFrames(const T*& pos, int& fractPos, const T* end, const T* repeat, int intAdd, int fractAdd,
+    float scale, float dest[], unsigned numFrames, bool looped, bool interpolate)
+{
+    if (looped)
+    {
+        return interpolate
+            ? ResampleFrames<T, NumChannels, true, true>(pos, fractPos, end, repeat, intAdd, fractAdd, scale, dest, numFrames)
+            : ResampleFrames<T, NumChannels, true, false>(pos, fractPos, end, repeat, intAdd, fractAdd, scale, dest, numFrames);
+    }
+    else
+    {
+        return interpolate
+            ? ResampleFrames<T, NumChannels, false, true>(pos, fractPos, end, repeat, intAdd, fractAdd, scale, dest, numFrames)
+            : ResampleFrames<T, NumChannels, false, false>(pos, fractPos, end, repeat, intAdd, fractAdd, scale, dest, numFrames);
+    }
+}
+
+template <class T>
+unsigned ResampleFrames(const T*& pos, int& fractPos, const T* end, const T* repeat, int intAdd, int fractAdd,
+    float scale, float dest[], unsigned numFrames, bool stereo, bool looped, bool interpolate)
+{
+    return stereo
+        ? ResampleFrames<T, 2>(pos, fractPos, end, repeat, intAdd, fractAdd, scale, dest, numFrames, looped, interpolate)
+        : ResampleFrames<T, 1>(pos, fractPos, end, repeat, intAdd, fractAdd, scale, dest, numFrames, looped, interpolate);
+}
+
+}
 
 static const int STREAM_SAFETY_SAMPLES = 4;
 
@@ -356,7 +371,8 @@ void SoundSource::Update(float timeStep)
     }
 }
 
-void SoundSource::Mix(int dest[], unsigned samples, int mixRate, SpeakerMode mode, bool interpolation)
+void SoundSource::Mix(float dest[], float buffer[], unsigned samples, int mixRate, SpeakerMode mode, bool interpolation,
+    bool virtualized)
 {
     if (!position_ || (!sound_ && !soundStream_) || (!IsEnabledEffective() && node_ != nullptr))
         return;
@@ -394,74 +410,20 @@ void SoundSource::Mix(int dest[], unsigned samples, int mixRate, SpeakerMode mod
     if (!sound)
         return;
 
-    // Choose the correct mixing routine
-    if (!sound->IsStereo())
-    {
-        if (interpolation)
-        {
-            switch (mode)
-            {
-            case SPK_AUTO:
-                assert(!"SPK_AUTO");
-                break;
-            case SPK_MONO:
-                if (!lowFrequency_) MixMonoToMonoIP(sound, dest, samples, mixRate);
-                break;
-            case SPK_STEREO:
-                if (!lowFrequency_) MixMonoToStereoIP(sound, dest, samples, mixRate);
-                break;
-            case SPK_QUADROPHONIC:
-                if (!lowFrequency_) MixMonoToSurroundIP(sound, dest, samples, mixRate, mode);
-                break;
-            case SPK_SURROUND_5_1:
-                if (lowFrequency_)
-                    MixMonoToMonoIP(sound, dest, samples, mixRate, SOUND_SOURCE_LOW_FREQ_CHANNEL[mode], 6);
-                else
-                    MixMonoToSurroundIP(sound, dest, samples, mixRate, mode);
-                break;
-            }
-        }
-        else
-        {
-            switch (mode)
-            {
-            case SPK_AUTO:
-                assert(!"SPK_AUTO");
-                break;
-            case SPK_MONO:
-                if (!lowFrequency_) MixMonoToStereo(sound, dest, samples, mixRate);
-                break;
-            case SPK_STEREO:
-                if (!lowFrequency_) MixMonoToMono(sound, dest, samples, mixRate);
-                break;
-            case SPK_QUADROPHONIC:
-                if (!lowFrequency_) MixMonoToSurround(sound, dest, samples, mixRate, mode);
-                break;
-            case SPK_SURROUND_5_1:
-                if (lowFrequency_)
-                    MixMonoToMono(sound, dest, samples, mixRate, SOUND_SOURCE_LOW_FREQ_CHANNEL[mode], 6);
-                else
-                    MixMonoToSurround(sound, dest, samples, mixRate, mode);
-                break;
-            }
-        }
-    }
+    // Resample the sound and mix it to the output with per channel gains.
+    // Sources that are virtualized or silent only advance the playback position
+    float leftGains[MAX_AUDIO_CHANNELS]{};
+    float rightGains[MAX_AUDIO_CHANNELS]{};
+    if (virtualized || !CalculateChannelGains(sound->IsStereo(), mode, leftGains, rightGains))
+        MixZeroVolume(sound, samples, mixRate);
     else
     {
-        if (interpolation)
-        {
-            if (mode == SPK_MONO)
-                MixStereoToMonoIP(sound, dest, samples, mixRate);
-            else
-                MixStereoToMultiIP(sound, dest, samples, mixRate, mode);
-        }
+        const unsigned numFrames = Resample(sound, buffer, samples, mixRate, interpolation);
+        const unsigned numChannels = AUDIO_NUM_CHANNELS[mode];
+        if (sound->IsStereo())
+            MixStereoToChannels(dest, buffer, numFrames, numChannels, leftGains, rightGains);
         else
-        {
-            if (mode == SPK_MONO)
-                MixStereoToMono(sound, dest, samples, mixRate);
-            else
-                MixStereoToMulti(sound, dest, samples, mixRate, mode);
-        }
+            MixMonoToChannels(dest, buffer, numFrames, numChannels, leftGains);
     }
 
     // Update the time position. In stream mode, copy unused data back to the beginning of the stream buffer
@@ -588,6 +550,10 @@ void SoundSource::PlayLockless(const SharedPtr<SoundStream>& stream)
         streamBuffer_->SetFormat(stream->GetIntFrequency(), stream->IsSixteenBit(), stream->IsStereo());
         streamBuffer_->SetLooped(true);
 
+        // Start decoding ahead before the stream is visible to the mixing thread
+        if (audio_)
+            audio_->AddDecodeAheadStream(stream);
+
         soundStream_ = stream;
         unusedStreamSize_ = 0;
         position_ = streamBuffer_->GetStart();
@@ -629,1180 +595,116 @@ void SoundSource::SetPlayPositionLockless(signed char* pos)
     timePosition_ = ((float)(int)(size_t)(pos - sound_->GetStart())) / (sound_->GetSampleSize() * sound_->GetFrequency());
 }
 
-void SoundSource::MixMonoToMono(Sound* sound, int dest[], unsigned samples, int mixRate, int channel, int channelCount)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    auto vol = RoundToInt(256.0f * totalGain);
-    if (!vol)
-    {
-        MixZeroVolume(sound, samples, mixRate);
-        return;
-    }
-
-    float add = frequency_ / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                dest += channel;
-                *dest = *dest + (*pos * vol) / 256;
-                dest += channelCount - channel;
-                INC_POS_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                dest += channel;
-                *dest = *dest + (*pos * vol) / 256;
-                dest += channelCount - channel;
-                INC_POS_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                dest += channel;
-                *dest = *dest + *pos * vol;
-                dest += channelCount - channel;
-                INC_POS_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                dest += channel;
-                *dest = *dest + *pos * vol;
-                dest += channelCount - channel;
-                INC_POS_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixMonoToStereo(Sound* sound, int dest[], unsigned samples, int mixRate)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    auto leftVol = (int)((-panning_ + 1.0f) * (256.0f * totalGain + 0.5f));
-    auto rightVol = (int)((panning_ + 1.0f) * (256.0f * totalGain + 0.5f));
-    if (!leftVol && !rightVol)
-    {
-        MixZeroVolume(sound, samples, mixRate);
-        return;
-    }
-
-    float add = frequency_ / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + (*pos * leftVol) / 256;
-                ++dest;
-                *dest = *dest + (*pos * rightVol) / 256;
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + (*pos * leftVol) / 256;
-                ++dest;
-                *dest = *dest + (*pos * rightVol) / 256;
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + *pos * leftVol;
-                ++dest;
-                *dest = *dest + *pos * rightVol;
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + *pos * leftVol;
-                ++dest;
-                *dest = *dest + *pos * rightVol;
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixMonoToMonoIP(Sound* sound, int dest[], unsigned samples, int mixRate, int channel, int channelCount)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    auto vol = RoundToInt(256.0f * totalGain);
-    if (!vol)
-    {
-        MixZeroVolume(sound, samples, mixRate);
-        return;
-    }
-
-    float add = frequency_ / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                dest += channel;
-                *dest = *dest + (GET_IP_SAMPLE() * vol) / 256;
-                dest += channelCount - channel;
-                INC_POS_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                dest += channel;
-                *dest = *dest + (GET_IP_SAMPLE() * vol) / 256;
-                dest += channelCount - channel;
-                INC_POS_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                dest += channel;
-                *dest = *dest + GET_IP_SAMPLE() * vol;
-                dest += channelCount - channel;
-                INC_POS_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                dest += channel;
-                *dest = *dest + GET_IP_SAMPLE() * vol;
-                dest += channelCount - channel;
-                INC_POS_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixMonoToStereoIP(Sound* sound, int dest[], unsigned samples, int mixRate)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    auto leftVol = (int)((-panning_ + 1.0f) * (256.0f * totalGain + 0.5f));
-    auto rightVol = (int)((panning_ + 1.0f) * (256.0f * totalGain + 0.5f));
-    if (!leftVol && !rightVol)
-    {
-        MixZeroVolume(sound, samples, mixRate);
-        return;
-    }
-
-    float add = frequency_ / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + (s * leftVol) / 256;
-                ++dest;
-                *dest = *dest + (s * rightVol) / 256;
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + (s * leftVol) / 256;
-                ++dest;
-                *dest = *dest + (s * rightVol) / 256;
-                ++dest;
-                INC_POS_ONESHOT();
+bool SoundSource::CalculateChannelGains(bool stereo, SpeakerMode mode, float leftGains[], float rightGains[]) const
+{
+    const float totalGain = masterGain_ * attenuation_ * gain_;
+    if (totalGain <= 0.0f)
+        return false;
+
+    // Channels are in WAV order, FL FR FC LFE RL RR
+    const float leftPan = (-panning_ + 1.0f) * totalGain;
+    const float rightPan = (panning_ + 1.0f) * totalGain;
+    if (!stereo)
+    {
+        switch (mode)
+        {
+        case SPK_MONO:
+            if (lowFrequency_)
+                return false;
+            leftGains[0] = totalGain;
+            break;
+        case SPK_STEREO:
+            if (lowFrequency_)
+                return false;
+            leftGains[0] = leftPan;
+            leftGains[1] = rightPan;
+            break;
+        case SPK_QUADROPHONIC:
+            if (lowFrequency_)
+                return false;
+            leftGains[0] = leftPan * (reach_ + 1.0f);
+            leftGains[1] = rightPan * (reach_ + 1.0f);
+            leftGains[2] = leftPan * (-reach_ + 1.0f);
+            leftGains[3] = rightPan * (-reach_ + 1.0f);
+            break;
+        case SPK_SURROUND_5_1:
+            if (lowFrequency_)
+            {
+                leftGains[SOUND_SOURCE_LOW_FREQ_CHANNEL[mode]] = totalGain;
+                break;
             }
-            position_ = (signed char*)pos;
+            leftGains[0] = leftPan * (reach_ + 1.0f);
+            leftGains[1] = rightPan * (reach_ + 1.0f);
+            leftGains[2] = Lerp(leftGains[0], leftGains[1], 0.5f) * Clamp(reach_, 0.0f, 1.0f);
+            leftGains[4] = leftPan * (-reach_ + 1.0f);
+            leftGains[5] = rightPan * (-reach_ + 1.0f);
+            break;
+        default:
+            assert(!"SPK_AUTO");
+            return false;
         }
     }
     else
     {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + s * leftVol;
-                ++dest;
-                *dest = *dest + s * rightVol;
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
+        // Front-center and LFE are omitted for stereo sounds
+        switch (mode)
         {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + s * leftVol;
-                ++dest;
-                *dest = *dest + s * rightVol;
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = pos;
+        case SPK_MONO:
+            leftGains[0] = 0.5f * totalGain;
+            rightGains[0] = 0.5f * totalGain;
+            break;
+        case SPK_STEREO:
+            leftGains[0] = totalGain;
+            rightGains[1] = totalGain;
+            break;
+        case SPK_QUADROPHONIC:
+            leftGains[0] = leftGains[2] = totalGain;
+            rightGains[1] = rightGains[3] = totalGain;
+            break;
+        case SPK_SURROUND_5_1:
+            leftGains[0] = leftGains[4] = totalGain;
+            rightGains[1] = rightGains[5] = totalGain;
+            break;
+        default:
+            assert(!"SPK_AUTO");
+            return false;
         }
     }
 
-    fractPosition_ = fractPos;
+    return true;
 }
 
-void SoundSource::MixStereoToMono(Sound* sound, int dest[], unsigned samples, int mixRate)
+unsigned SoundSource::Resample(Sound* sound, float dest[], unsigned samples, int mixRate, bool interpolation)
 {
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    auto vol = RoundToInt(256.0f * totalGain);
-    if (!vol)
-    {
-        MixZeroVolume(sound, samples, mixRate);
-        return;
-    }
-
     float add = frequency_ / (float)mixRate;
     auto intAdd = (int)add;
     auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
     int fractPos = fractPosition_;
 
+    const bool stereo = sound->IsStereo();
+    const bool looped = sound->IsLooped();
+    unsigned numFrames;
     if (sound->IsSixteenBit())
     {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = ((int)pos[0] + (int)pos[1]) / 2;
-                *dest = *dest + (s * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                int s = ((int)pos[0] + (int)pos[1]) / 2;
-                *dest = *dest + (s * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
+        auto* pos = (const short*)position_;
+        const auto* end = (const short*)sound->GetEnd();
+        const auto* repeat = (const short*)sound->GetRepeat();
+        numFrames = ResampleFrames(pos, fractPos, end, repeat, intAdd, fractAdd, 1.0f / 32768.0f, dest, samples,
+            stereo, looped, interpolation);
+        position_ = (signed char*)pos;
     }
     else
     {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = ((int)pos[0] + (int)pos[1]) / 2;
-                *dest = *dest + s * vol;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                int s = ((int)pos[0] + (int)pos[1]) / 2;
-                *dest = *dest + s * vol;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixStereoToStereo(Sound* sound, int dest[], unsigned samples, int mixRate)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    auto vol = RoundToInt(256.0f * totalGain);
-    if (!vol)
-    {
-        MixZeroVolume(sound, samples, mixRate);
-        return;
-    }
-
-    float add = frequency_ / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + (pos[0] * vol) / 256;
-                ++dest;
-                *dest = *dest + (pos[1] * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + (pos[0] * vol) / 256;
-                ++dest;
-                *dest = *dest + (pos[1] * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + pos[0] * vol;
-                ++dest;
-                *dest = *dest + pos[1] * vol;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + pos[0] * vol;
-                ++dest;
-                *dest = *dest + pos[1] * vol;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixStereoToMonoIP(Sound* sound, int dest[], unsigned samples, int mixRate)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    auto vol = RoundToInt(256.0f * totalGain);
-    if (!vol)
-    {
-        MixZeroVolume(sound, samples, mixRate);
-        return;
-    }
-
-    float add = frequency_ / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = (GET_IP_SAMPLE_LEFT() + GET_IP_SAMPLE_RIGHT()) / 2;
-                *dest = *dest + (s * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                int s = (GET_IP_SAMPLE_LEFT() + GET_IP_SAMPLE_RIGHT()) / 2;
-                *dest = *dest + (s * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = (GET_IP_SAMPLE_LEFT() + GET_IP_SAMPLE_RIGHT()) / 2;
-                *dest = *dest + s * vol;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                int s = (GET_IP_SAMPLE_LEFT() + GET_IP_SAMPLE_RIGHT()) / 2;
-                *dest = *dest + s * vol;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixStereoToStereoIP(Sound* sound, int dest[], unsigned samples, int mixRate)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    auto vol = RoundToInt(256.0f * totalGain);
-    if (!vol)
-    {
-        MixZeroVolume(sound, samples, mixRate);
-        return;
-    }
-
-    float add = frequency_ / (float)mixRate;
-    auto intAdd = (int)add;
-    auto fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        auto* pos = (short*)position_;
-        auto* end = (short*)sound->GetEnd();
-        auto* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + (GET_IP_SAMPLE_LEFT() * vol) / 256;
-                ++dest;
-                *dest = *dest + (GET_IP_SAMPLE_RIGHT() * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + (GET_IP_SAMPLE_LEFT() * vol) / 256;
-                ++dest;
-                *dest = *dest + (GET_IP_SAMPLE_RIGHT() * vol) / 256;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
-    {
-        auto* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + GET_IP_SAMPLE_LEFT() * vol;
-                ++dest;
-                *dest = *dest + GET_IP_SAMPLE_RIGHT() * vol;
-                ++dest;
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + GET_IP_SAMPLE_LEFT() * vol;
-                ++dest;
-                *dest = *dest + GET_IP_SAMPLE_RIGHT() * vol;
-                ++dest;
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixMonoToSurround(Sound* sound, int* dest, unsigned samples, int mixRate, SpeakerMode speakerMode)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    int frontLeftVol = (int)(((-panning_ + 1.0f) * (reach_ + 1.0f)) * (256.0f * totalGain + 0.5f));
-    int frontRightVol = (int)(((panning_ + 1.0f) * (reach_ + 1.0f)) * (256.0f * totalGain + 0.5f));
-    int rearLeftVol = (int)(((-panning_ + 1.0f) * (-reach_ + 1.0f)) * (256.0f * totalGain + 0.5f));
-    int rearRightVol = (int)(((panning_ + 1.0f) * (-reach_ + 1.0f)) * (256.0f * totalGain + 0.5f));
-    int centerVol = Lerp(frontLeftVol, frontRightVol, 0.5f) * Clamp(reach_, 0.0f, 1.0f);
-
-    if (!frontLeftVol && !frontRightVol && !rearLeftVol && !rearRightVol)
-    {
-        MixZeroVolume(sound, samples, mixRate);
-        return;
-    }
-
-    float add = frequency_ / (float)mixRate;
-    int intAdd = (int)add;
-    int fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        short* pos = (short*)position_;
-        short* end = (short*)sound->GetEnd();
-        short* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + (*pos * frontLeftVol) / 256; // FL
-                ++dest;
-                *dest = *dest + (*pos * frontRightVol) / 256; // FR
-                ++dest;
-
-                if (speakerMode == SPK_SURROUND_5_1)
-                {
-                    *dest = *dest + (*pos * centerVol) / 256; // FC
-                    ++dest;
-                    ++dest; // LFE
-                }
-
-                *dest = *dest + (*pos * rearLeftVol) / 256; // RL
-                ++dest;
-                *dest = *dest + (*pos * rearRightVol) / 256; // RR
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + (*pos * frontLeftVol) / 256; // FL
-                ++dest;
-                *dest = *dest + (*pos * frontRightVol) / 256; // FR
-                ++dest;
-
-                if (speakerMode == SPK_SURROUND_5_1)
-                {
-                    *dest = *dest + (*pos * centerVol) / 256; // FC
-                    ++dest;
-                    ++dest; // LFE
-                }
-
-                *dest = *dest + (*pos * rearLeftVol) / 256; // RL
-                ++dest;
-                *dest = *dest + (*pos * rearRightVol) / 256; // RR
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
-    {
-        signed char* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + *pos * frontLeftVol; // FL
-                ++dest;
-                *dest = *dest + *pos * frontRightVol; // FR
-                ++dest;
-
-                if (speakerMode == SPK_SURROUND_5_1)
-                {
-                    *dest = *dest + *pos * centerVol; // FC
-                    ++dest;
-                    ++dest; // LFE
-                }
-
-                *dest = *dest + *pos * rearLeftVol; // RL
-                ++dest;
-                *dest = *dest + *pos * rearRightVol; // RR
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + *pos * frontLeftVol; // FL
-                ++dest;
-                *dest = *dest + *pos * frontRightVol; // FR
-                ++dest;
-
-                if (speakerMode == SPK_SURROUND_5_1)
-                {
-                    *dest = *dest + *pos * centerVol; // FC
-                    ++dest;
-                    ++dest; // LFE
-                }
-
-                *dest = *dest + *pos * rearLeftVol; // RL
-                ++dest;
-                *dest = *dest + *pos * rearRightVol; // RR
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixMonoToSurroundIP(Sound* sound, int* dest, unsigned samples, int mixRate, SpeakerMode speakerMode)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    int frontLeftVol = (int)(((-panning_ + 1.0f) * (reach_ + 1.0f)) * (256.0f * totalGain + 0.5f));
-    int frontRightVol = (int)(((panning_ + 1.0f) * (reach_ + 1.0f)) * (256.0f * totalGain + 0.5f));
-    int rearLeftVol = (int)(((-panning_ + 1.0f) * (-reach_ + 1.0f)) * (256.0f * totalGain + 0.05f));
-    int rearRightVol = (int)(((panning_ + 1.0f) * (-reach_ + 1.0f)) * (256.0f * totalGain + 0.5f));
-    int centerVol = Lerp(frontLeftVol, frontRightVol, 0.5f) * Clamp(reach_, 0.0f, 1.0f);
-
-    if (!frontLeftVol && !frontRightVol && !rearLeftVol && !rearRightVol)
-    {
-        MixZeroVolume(sound, samples, mixRate);
-        return;
-    }
-
-    float add = frequency_ / (float)mixRate;
-    int intAdd = (int)add;
-    int fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        short* pos = (short*)position_;
-        short* end = (short*)sound->GetEnd();
-        short* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + (s * frontLeftVol) / 256; // FL
-                ++dest;
-                *dest = *dest + (s * frontRightVol) / 256; // FR
-                ++dest;
-
-                if (speakerMode == SPK_SURROUND_5_1)
-                {
-                    *dest = *dest + (s * centerVol) / 256; // FC
-                    ++dest;
-                    ++dest; // LFE
-                }
-
-                *dest = *dest + (s * rearLeftVol) / 256; // RL
-                ++dest;
-                *dest = *dest + (s * rearRightVol) / 256; // RR
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + (s * frontLeftVol) / 256; // FL
-                ++dest;
-                *dest = *dest + (s * frontRightVol) / 256; // FR
-                ++dest;
-
-                if (speakerMode == SPK_SURROUND_5_1)
-                {
-                    *dest = *dest + (s * centerVol) / 256; // FC
-                    ++dest;
-                    ++dest; // LFE
-                }
-
-                *dest = *dest + (s * rearLeftVol) / 256; // RL
-                ++dest;
-                *dest = *dest + (s * rearRightVol) / 256; // RR
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
-    {
-        signed char* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + s * frontLeftVol; // FL
-                ++dest;
-                *dest = *dest + s * frontRightVol; // FR
-                ++dest;
-
-                if (speakerMode == SPK_SURROUND_5_1)
-                {
-                    *dest = *dest + s * centerVol; // FC
-                    ++dest;
-                    ++dest; // LFE
-                }
-
-                *dest = *dest + s * rearLeftVol; // RL
-                ++dest;
-                *dest = *dest + s * rearRightVol; // RR
-                ++dest;
-                INC_POS_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                int s = GET_IP_SAMPLE();
-                *dest = *dest + s * frontLeftVol; // FL
-                ++dest;
-                *dest = *dest + s * frontRightVol; // FR
-                ++dest;
-
-                if (speakerMode == SPK_SURROUND_5_1)
-                {
-                    *dest = *dest + s * centerVol; // FC
-                    ++dest; // FC
-                    ++dest; // LFE
-                }
-
-                *dest = *dest + s * rearLeftVol; // RL
-                ++dest;
-                *dest = *dest + s * rearRightVol; // RR
-                ++dest;
-                INC_POS_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixStereoToMulti(Sound* sound, int* dest, unsigned samples, int mixRate, SpeakerMode speakers)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    int vol = (int)(256.0f * totalGain + 0.5f);
-    if (!vol)
-    {
-        MixZeroVolume(sound, samples, mixRate);
-        return;
-    }
-
-    float add = frequency_ / (float)mixRate;
-    int intAdd = (int)add;
-    int fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        short* pos = (short*)position_;
-        short* end = (short*)sound->GetEnd();
-        short* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + (pos[0] * vol) / 256; // FL
-                ++dest;
-                *dest = *dest + (pos[1] * vol) / 256; // FR
-                ++dest;
-
-                if (speakers > SPK_STEREO)
-                {
-                    if (speakers == SPK_SURROUND_5_1)
-                    {
-                        ++dest; // FC
-                        ++dest; // LFE
-                    }
-
-                    *dest = *dest + (pos[0] * vol) / 256; // RL
-                    ++dest;
-                    *dest = *dest + (pos[1] * vol) / 256; // RR
-                    ++dest;
-                }
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + (pos[0] * vol) / 256; // FL
-                ++dest;
-                *dest = *dest + (pos[1] * vol) / 256; // FR
-                ++dest;
-                if (speakers > SPK_STEREO)
-                {
-                    if (speakers == SPK_SURROUND_5_1)
-                    {
-                        ++dest; // FC
-                        ++dest; // LFE
-                    }
-                    *dest = *dest + (pos[0] * vol) / 256; // RL
-                    ++dest;
-                    *dest = *dest + (pos[1] * vol) / 256; // RR
-                    ++dest;
-                }
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
-    {
-        signed char* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + pos[0] * vol; // FL
-                ++dest;
-                *dest = *dest + pos[1] * vol; // FR
-                ++dest;
-                if (speakers > SPK_STEREO)
-                {
-                    if (speakers == SPK_SURROUND_5_1)
-                    {
-                        ++dest; // FC
-                        ++dest; // LFE
-                    }
-                    *dest = *dest + pos[0] * vol; // RL
-                    ++dest;
-                    *dest = *dest + pos[1] * vol; // RR
-                    ++dest;
-                }
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + pos[0] * vol; // FL
-                ++dest;
-                *dest = *dest + pos[1] * vol; // FR
-                ++dest;
-                if (speakers > SPK_STEREO)
-                {
-                    if (speakers == SPK_SURROUND_5_1)
-                    {
-                        ++dest; // FC
-                        ++dest; // LFE
-                    }
-
-                    *dest = *dest + pos[0] * vol; // RL
-                    ++dest;
-                    *dest = *dest + pos[1] * vol; // RR
-                    ++dest;
-                }
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = pos;
-        }
-    }
-
-    fractPosition_ = fractPos;
-}
-
-void SoundSource::MixStereoToMultiIP(Sound* sound, int* dest, unsigned samples, int mixRate, SpeakerMode speakers)
-{
-    float totalGain = masterGain_ * attenuation_ * gain_;
-    int vol = (int)(256.0f * totalGain + 0.5f);
-    if (!vol)
-    {
-        MixZeroVolume(sound, samples, mixRate);
-        return;
-    }
-
-    float add = frequency_ / (float)mixRate;
-    int intAdd = (int)add;
-    int fractAdd = (int)((add - floorf(add)) * 65536.0f);
-    int fractPos = fractPosition_;
-
-    if (sound->IsSixteenBit())
-    {
-        short* pos = (short*)position_;
-        short* end = (short*)sound->GetEnd();
-        short* repeat = (short*)sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + (GET_IP_SAMPLE_LEFT() * vol) / 256; // FL
-                ++dest;
-                *dest = *dest + (GET_IP_SAMPLE_RIGHT() * vol) / 256; // FR
-                ++dest;
-                if (speakers > SPK_STEREO)
-                {
-                    if (speakers == SPK_SURROUND_5_1)
-                    {
-                        *dest = *dest + (((GET_IP_SAMPLE_LEFT() * vol) + GET_IP_SAMPLE_RIGHT() * vol) / 256) / 2;
-                        ++dest; // FC
-                        *dest = *dest + (((GET_IP_SAMPLE_LEFT() * vol) + GET_IP_SAMPLE_RIGHT() * vol) / 256) / 2;
-                        ++dest; // LFE
-                    }
-
-                    *dest = *dest + (GET_IP_SAMPLE_LEFT() * vol) / 256; // RL
-                    ++dest;
-                    *dest = *dest + (GET_IP_SAMPLE_RIGHT() * vol) / 256; // RR
-                    ++dest;
-                }
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = (signed char*)pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + (GET_IP_SAMPLE_LEFT() * vol) / 256; // FL
-                ++dest;
-                *dest = *dest + (GET_IP_SAMPLE_RIGHT() * vol) / 256; // FR
-                ++dest;
-                if (speakers > SPK_STEREO)
-                {
-                    if (speakers == SPK_SURROUND_5_1)
-                    {
-                        ++dest; // FC
-                        ++dest; // LFE
-                    }
-
-                    *dest = *dest + (GET_IP_SAMPLE_LEFT() * vol) / 256; // RL
-                    ++dest;
-                    *dest = *dest + (GET_IP_SAMPLE_RIGHT() * vol) / 256; // RR
-                    ++dest;
-                }
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = (signed char*)pos;
-        }
-    }
-    else
-    {
-        signed char* pos = (signed char*)position_;
-        signed char* end = sound->GetEnd();
-        signed char* repeat = sound->GetRepeat();
-
-        if (sound->IsLooped())
-        {
-            while (samples--)
-            {
-                *dest = *dest + GET_IP_SAMPLE_LEFT() * vol; // FL
-                ++dest;
-                *dest = *dest + GET_IP_SAMPLE_RIGHT() * vol; // FR
-                ++dest;
-                if (speakers > SPK_STEREO)
-                {
-                    if (speakers == SPK_SURROUND_5_1)
-                    {
-                        ++dest; // FC
-                        ++dest; // LFE
-                    }
-
-                    *dest = *dest + GET_IP_SAMPLE_LEFT() * vol; // RL
-                    ++dest;
-                    *dest = *dest + GET_IP_SAMPLE_RIGHT() * vol; // RR
-                    ++dest;
-                }
-                INC_POS_STEREO_LOOPED();
-            }
-            position_ = pos;
-        }
-        else
-        {
-            while (samples--)
-            {
-                *dest = *dest + GET_IP_SAMPLE_LEFT() * vol; // FL
-                ++dest;
-                *dest = *dest + GET_IP_SAMPLE_RIGHT() * vol; // FR
-                ++dest;
-                if (speakers > SPK_STEREO)
-                {
-                    if (speakers == SPK_SURROUND_5_1)
-                    {
-                        ++dest; // FC
-                        ++dest; // LFE
-                    }
-
-                    *dest = *dest + GET_IP_SAMPLE_LEFT() * vol; // RL
-                    ++dest;
-                    *dest = *dest + GET_IP_SAMPLE_RIGHT() * vol; // RR
-                    ++dest;
-                }
-                INC_POS_STEREO_ONESHOT();
-            }
-            position_ = pos;
-        }
+        auto* pos = (const signed char*)position_;
+        const signed char* end = sound->GetEnd();
+        const signed char* repeat = sound->GetRepeat();
+        numFrames = ResampleFrames(pos, fractPos, end, repeat, intAdd, fractAdd, 1.0f / 128.0f, dest, samples,
+            stereo, looped, interpolation);
+        position_ = (signed char*)pos;
     }
 
     fractPosition_ = fractPos;
+    return numFrames;
 }
 
 void SoundSource::MixZeroVolume(Sound* sound, unsigned samples, int mixRate)
@@ -100,6 +100,9 @@ public:
     /// @property
     ea::string GetSoundType() const { return soundType_; }
 
+    /// Return hash of sound type.
+    StringHash GetSoundTypeHash() const { return soundTypeHash_; }
+
     /// Return playback time position.
     /// @property
     float GetTimePosition() const { return timePosition_; }
@@ -135,11 +138,15 @@ public:
     /// Return whether is playing.
     /// @property
     bool IsPlaying() const;
+    /// Return effective gain used to pick the loudest sources for mixing.
+    float GetAudibility() const { return position_ ? masterGain_ * attenuation_ * gain_ : 0.0f; }
 
     /// Update the sound source. Perform subclass specific operations. Called by Audio.
     virtual void Update(float timeStep);
-    /// Mix sound source output to a 32-bit clipping buffer. Called by Audio.
-    void Mix(int dest[], unsigned samples, int mixRate, SpeakerMode mode, bool interpolation);
+    /// Mix sound source output to a float clipping buffer, using the scratch buffer for resampling. Called by Audio.
+    /// Virtualized source only advances playback position.
+    void Mix(float dest[], float buffer[], unsigned samples, int mixRate, SpeakerMode mode, bool interpolation,
+        bool virtualized);
     /// Update the effective master gain. Called internally and by Audio when the master gain changes.
     void UpdateMasterGain();
 
@@ -189,30 +196,10 @@ private:
     void StopLockless();
     /// Set new playback position without locking the audio mutex. Called internally.
     void SetPlayPositionLockless(signed char* pos);
-    /// Mix mono sample to mono buffer.
-    void MixMonoToMono(Sound* sound, int dest[], unsigned samples, int mixRate, int channel = 0, int channelCount = 1);
-    /// Mix mono sample to stereo buffer.
-    void MixMonoToStereo(Sound* sound, int dest[], unsigned samples, int mixRate);
-    /// Mix mono sample to mono buffer interpolated.
-    void MixMonoToMonoIP(Sound* sound, int dest[], unsigned samples, int mixRate, int channel = 0, int channelCount = 1);
-    /// Mix mono sample to stereo buffer interpolated.
-    void MixMonoToStereoIP(Sound* sound, int dest[], unsigned samples, int mixRate);
-    /// Mix stereo sample to mono buffer.
-    void MixStereoToMono(Sound* sound, int dest[], unsigned samples, int mixRate);
-    /// Mix stereo sample to stereo buffer.
-    void MixStereoToStereo(Sound* sound, int dest[], unsigned samples, int mixRate);
-    /// Mix stereo sample to mono buffer interpolated.
-    void MixStereoToMonoIP(Sound* sound, int dest[], unsigned samples, int mixRate);
-    /// Mix stereo sample to stereo buffer interpolated.
-    void MixStereoToStereoIP(Sound* sound, int dest[], unsigned samples, int mixRate);
-    /// Mix a mono track to surround buffer.
-    void MixMonoToSurround(Sound* sound, int* dest, unsigned samples, int mixRate, SpeakerMode speakers);
-    /// Mix a mono track into a surround buffer.
-    void MixMonoToSurroundIP(Sound* sound, int* dest, unsigned samples, int mixRate, SpeakerMode speakers);
-    /// Mix stereo sample into multichannel. Front-center and LFE are ommitted.
-    void MixStereoToMulti(Sound* sound, int* dest, unsigned samples, int mixRate, SpeakerMode speakers);
-    /// Mix stereo sample into multichannel. Front-center and LFE are ommitted.
-    void MixStereoToMultiIP(Sound* sound, int* dest, unsigned samples, int mixRate, SpeakerMode speakers);
+    /// Calculate per output channel gains of left and right (or mono) sound channels. Return false if silent.
+    bool CalculateChannelGains(bool stereo, SpeakerMode mode, float leftGains[], float rightGains[]) const;
+    /// Resample sound into interleaved float frames and advance playback pointer. Return number of frames produced.
+    unsigned Resample(Sound* sound, float dest[], unsigned samples, int mixRate, bool interpolation);
     /// Advance playback pointer without producing audible output.
     void MixZeroVolume(Sound* sound, unsigned samples, int mixRate);
     /// Advance playback pointer to simulate audio playback in headless mode.
@@ -41,6 +41,10 @@ public:
 
     /// Produce sound data into destination. Return number of bytes produced. Called by SoundSource from the mixing thread.
     virtual unsigned GetData(signed char* dest, unsigned numBytes) = 0;
+    /// Enable decoding ahead of playback into buffer of specified size. Return true if supported. Called before the stream is played.
+    virtual bool EnableDecodeAhead(unsigned numBytes) { return false; }
+    /// Decode data ahead of playback. Called from the audio decoder thread if decoding ahead is enabled.
+    virtual void DecodeAhead() {}
 
     /// Set sound data format.
     void SetFormat(unsigned frequency, bool sixteenBit, bool stereo);
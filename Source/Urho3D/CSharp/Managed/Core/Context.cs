@@ -58,6 +58,7 @@ namespace Urho3DNet
                 RegisterSubsystem(script);
 
             Urho3DRegisterDirectorFactories(swigCPtr);
+            LogicUpdateDispatcher.Install();
 
             // Register factories marked with attributes
             foreach (var assembly in AppDomain.CurrentDomain.GetAssemblies())
@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+using System;
+using System.Runtime.InteropServices;
+
+namespace Urho3DNet
+{
+    /// <summary>
+    /// Arguments of typed frame update signals. Layout matches native FrameUpdateEventArgs.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct FrameUpdateEventArgs
+    {
+        /// <summary>
+        /// Frame timestep in seconds.
+        /// </summary>
+        public float TimeStep;
+    }
+
+    /// <summary>
+    /// Frame update phase, in the order of invocation.
+    /// </summary>
+    public enum FrameUpdatePhase
+    {
+        Update,
+        PostUpdate,
+        RenderUpdate,
+        PostRenderUpdate
+    }
+
+    /// <summary>
+    /// Handler of typed frame update signal. Arguments are passed by reference to native memory.
+    /// </summary>
+    public delegate void FrameUpdateHandler(in FrameUpdateEventArgs args);
+
+    public partial class Engine
+    {
+        [DllImport(global::Urho3DNet.Urho3DPINVOKE.DllImportModule, EntryPoint = "Urho3D_Engine_SubscribeToFrameUpdate")]
+        private static extern void Urho3D_Engine_SubscribeToFrameUpdate(HandleRef engine, HandleRef receiver, int phase,
+            IntPtr callback, IntPtr callbackHandle);
+
+        [DllImport(global::Urho3DNet.Urho3DPINVOKE.DllImportModule, EntryPoint = "Urho3D_Engine_UnsubscribeFromFrameUpdate")]
+        private static extern void Urho3D_Engine_UnsubscribeFromFrameUpdate(HandleRef engine, HandleRef receiver);
+
+#if __IOS__
+        [global::ObjCRuntime.MonoNativeFunctionWrapper]
+#endif
+        private delegate void FrameUpdateCallbackDelegate(IntPtr callbackHandle, IntPtr args);
+
+#if __IOS__
+        [global::ObjCRuntime.MonoPInvokeCallback(typeof(FrameUpdateCallbackDelegate))]
+#endif
+        private static void FrameUpdateCallback(IntPtr callbackHandle, IntPtr args)
+        {
+            var handler = (FrameUpdateHandler)GCHandle.FromIntPtr(callbackHandle).Target;
+            unsafe
+            {
+                handler(in *(FrameUpdateEventArgs*)args.ToPointer());
+            }
+        }
+        private static readonly FrameUpdateCallbackDelegate FrameUpdateCallbackInstance = FrameUpdateCallback;
+
+        /// <summary>
+        /// Subscribe to typed frame update signal. Unlike E_UPDATE and related events, the handler is called without
+        /// building and marshalling event data. Subscription expires together with the receiver.
+        /// </summary>
+        public void SubscribeToFrameUpdate(RefCounted receiver, FrameUpdatePhase phase, FrameUpdateHandler handler)
+        {
+            if (receiver == null)
+                throw new ArgumentNullException(nameof(receiver));
+            if (handler == null)
+                throw new ArgumentNullException(nameof(handler));
+
+            IntPtr handle = GCHandle.ToIntPtr(GCHandle.Alloc(handler));
+            IntPtr callback = Marshal.GetFunctionPointerForDelegate(FrameUpdateCallbackInstance);
+            Urho3D_Engine_SubscribeToFrameUpdate(swigCPtr, RefCounted.getCPtr(receiver), (int)phase, callback, handle);
+        }
+
+        /// <summary>
+        /// Unsubscribe receiver from all typed frame update signals.
+        /// </summary>
+        public void UnsubscribeFromFrameUpdate(RefCounted receiver)
+        {
+            Urho3D_Engine_UnsubscribeFromFrameUpdate(swigCPtr, RefCounted.getCPtr(receiver));
+        }
+    }
+}
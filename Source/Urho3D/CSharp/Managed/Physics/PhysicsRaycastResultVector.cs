@@ -0,0 +1,64 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+using System;
+using System.Runtime.InteropServices;
+
+namespace Urho3DNet
+{
+    public partial class PhysicsRaycastResultVector
+    {
+        [DllImport(global::Urho3DNet.Urho3DPINVOKE.DllImportModule, EntryPoint = "Urho3D_PhysicsRaycastResultVector_GetHits")]
+        private static extern unsafe void Urho3D_PhysicsRaycastResultVector_GetHits(HandleRef results, Vector3* positions, Vector3* normals, float* distances);
+        [DllImport(global::Urho3DNet.Urho3DPINVOKE.DllImportModule, EntryPoint = "Urho3D_PhysicsRaycastResultVector_GetNodes")]
+        private static extern void Urho3D_PhysicsRaycastResultVector_GetNodes(HandleRef results, HandleRef nodes);
+
+        /// <summary>
+        /// Copy hit positions, normals and distances into spans without marshalling of individual results.
+        /// Empty spans are skipped, other spans should have at least as many elements as the list.
+        /// </summary>
+        public unsafe void GetHits(Span<Vector3> positions, Span<Vector3> normals, Span<float> distances)
+        {
+            CheckLength(positions.Length, nameof(positions));
+            CheckLength(normals.Length, nameof(normals));
+            CheckLength(distances.Length, nameof(distances));
+            fixed (Vector3* positionsPtr = positions)
+            fixed (Vector3* normalsPtr = normals)
+            fixed (float* distancesPtr = distances)
+                Urho3D_PhysicsRaycastResultVector_GetHits(swigCPtr, positionsPtr, normalsPtr, distancesPtr);
+        }
+
+        /// <summary>
+        /// Fill list with hit nodes without creating managed wrappers of individual results.
+        /// </summary>
+        public void GetNodes(NodeList nodes)
+        {
+            Urho3D_PhysicsRaycastResultVector_GetNodes(swigCPtr, NodeList.getCPtr(nodes));
+        }
+
+        private void CheckLength(int length, string paramName)
+        {
+            if (length != 0 && length < Count)
+                throw new ArgumentException("Span is shorter than the result list.", paramName);
+        }
+    }
+}
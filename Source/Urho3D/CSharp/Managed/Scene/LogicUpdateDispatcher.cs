@@ -0,0 +1,75 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+using System;
+using System.Runtime.InteropServices;
+
+namespace Urho3DNet
+{
+    /// <summary>
+    /// Calls managed logic component updates in bulk. Scene update queue passes script object handles of all managed
+    /// components of one type in a single call instead of calling each component through its director.
+    /// </summary>
+    internal static class LogicUpdateDispatcher
+    {
+        [DllImport(global::Urho3DNet.Urho3DPINVOKE.DllImportModule, EntryPoint = "Urho3D_LogicUpdateQueue_SetScriptUpdateCallback")]
+        private static extern void Urho3D_LogicUpdateQueue_SetScriptUpdateCallback(IntPtr callback);
+
+#if __IOS__
+        [global::ObjCRuntime.MonoNativeFunctionWrapper]
+#endif
+        [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+        private delegate void ScriptUpdateCallbackDelegate(IntPtr scriptObjects, uint count, int phase, float timeStep);
+
+#if __IOS__
+        [global::ObjCRuntime.MonoPInvokeCallback(typeof(ScriptUpdateCallbackDelegate))]
+#endif
+        private static void ScriptUpdateCallback(IntPtr scriptObjects, uint count, int phase, float timeStep)
+        {
+            unsafe
+            {
+                var handles = (IntPtr*)scriptObjects.ToPointer();
+                for (uint i = 0; i < count; ++i)
+                {
+                    // Handles are read one by one, components removed by previous updates are reset to null
+                    IntPtr handle = handles[i];
+                    if (handle == IntPtr.Zero)
+                        continue;
+
+                    if (GCHandle.FromIntPtr(handle).Target is LogicComponent component)
+                    {
+                        if (phase == 0)
+                            component.Update(timeStep);
+                        else
+                            component.PostUpdate(timeStep);
+                    }
+                }
+            }
+        }
+        private static readonly ScriptUpdateCallbackDelegate ScriptUpdateCallbackInstance = ScriptUpdateCallback;
+
+        internal static void Install()
+        {
+            Urho3D_LogicUpdateQueue_SetScriptUpdateCallback(Marshal.GetFunctionPointerForDelegate(ScriptUpdateCallbackInstance));
+        }
+    }
+}
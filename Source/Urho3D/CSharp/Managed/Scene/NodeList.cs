@@ -0,0 +1,140 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+using System;
+using System.Runtime.InteropServices;
+
+namespace Urho3DNet
+{
+    /// <summary>
+    /// Bulk access to transforms of listed nodes. Values are copied between spans and native nodes in a single call
+    /// without creating managed wrappers of individual nodes. Null nodes are skipped on write and yield default values
+    /// on read.
+    /// </summary>
+    public partial class NodeList
+    {
+        [DllImport(global::Urho3DNet.Urho3DPINVOKE.DllImportModule, EntryPoint = "Urho3D_NodeList_GetPositions")]
+        private static extern unsafe void Urho3D_NodeList_GetPositions(HandleRef nodes, Vector3* positions, [MarshalAs(UnmanagedType.I1)] bool world);
+        [DllImport(global::Urho3DNet.Urho3DPINVOKE.DllImportModule, EntryPoint = "Urho3D_NodeList_SetPositions")]
+        private static extern unsafe void Urho3D_NodeList_SetPositions(HandleRef nodes, Vector3* positions, [MarshalAs(UnmanagedType.I1)] bool world);
+        [DllImport(global::Urho3DNet.Urho3DPINVOKE.DllImportModule, EntryPoint = "Urho3D_NodeList_GetRotations")]
+        private static extern unsafe void Urho3D_NodeList_GetRotations(HandleRef nodes, Quaternion* rotations, [MarshalAs(UnmanagedType.I1)] bool world);
+        [DllImport(global::Urho3DNet.Urho3DPINVOKE.DllImportModule, EntryPoint = "Urho3D_NodeList_SetRotations")]
+        private static extern unsafe void Urho3D_NodeList_SetRotations(HandleRef nodes, Quaternion* rotations, [MarshalAs(UnmanagedType.I1)] bool world);
+        [DllImport(global::Urho3DNet.Urho3DPINVOKE.DllImportModule, EntryPoint = "Urho3D_NodeList_GetScales")]
+        private static extern unsafe void Urho3D_NodeList_GetScales(HandleRef nodes, Vector3* scales, [MarshalAs(UnmanagedType.I1)] bool world);
+        [DllImport(global::Urho3DNet.Urho3DPINVOKE.DllImportModule, EntryPoint = "Urho3D_NodeList_SetScales")]
+        private static extern unsafe void Urho3D_NodeList_SetScales(HandleRef nodes, Vector3* scales, [MarshalAs(UnmanagedType.I1)] bool world);
+        [DllImport(global::Urho3DNet.Urho3DPINVOKE.DllImportModule, EntryPoint = "Urho3D_NodeList_GetWorldTransforms")]
+        private static extern unsafe void Urho3D_NodeList_GetWorldTransforms(HandleRef nodes, Matrix3x4* transforms);
+        [DllImport(global::Urho3DNet.Urho3DPINVOKE.DllImportModule, EntryPoint = "Urho3D_NodeList_SetTransforms")]
+        private static extern unsafe void Urho3D_NodeList_SetTransforms(HandleRef nodes, Vector3* positions, Quaternion* rotations, [MarshalAs(UnmanagedType.I1)] bool world);
+
+        /// <summary>
+        /// Copy node positions into span. Span should have at least as many elements as the list.
+        /// </summary>
+        public unsafe void GetPositions(Span<Vector3> positions, bool world = false)
+        {
+            CheckLength(positions.Length, nameof(positions));
+            fixed (Vector3* ptr = positions)
+                Urho3D_NodeList_GetPositions(swigCPtr, ptr, world);
+        }
+
+        /// <summary>
+        /// Set node positions from span. Span should have at least as many elements as the list.
+        /// </summary>
+        public unsafe void SetPositions(ReadOnlySpan<Vector3> positions, bool world = false)
+        {
+            CheckLength(positions.Length, nameof(positions));
+            fixed (Vector3* ptr = positions)
+                Urho3D_NodeList_SetPositions(swigCPtr, ptr, world);
+        }
+
+        /// <summary>
+        /// Copy node rotations into span. Span should have at least as many elements as the list.
+        /// </summary>
+        public unsafe void GetRotations(Span<Quaternion> rotations, bool world = false)
+        {
+            CheckLength(rotations.Length, nameof(rotations));
+            fixed (Quaternion* ptr = rotations)
+                Urho3D_NodeList_GetRotations(swigCPtr, ptr, world);
+        }
+
+        /// <summary>
+        /// Set node rotations from span. Span should have at least as many elements as the list.
+        /// </summary>
+        public unsafe void SetRotations(ReadOnlySpan<Quaternion> rotations, bool world = false)
+        {
+            CheckLength(rotations.Length, nameof(rotations));
+            fixed (Quaternion* ptr = rotations)
+                Urho3D_NodeList_SetRotations(swigCPtr, ptr, world);
+        }
+
+        /// <summary>
+        /// Copy node scales into span. Span should have at least as many elements as the list.
+        /// </summary>
+        public unsafe void GetScales(Span<Vector3> scales, bool world = false)
+        {
+            CheckLength(scales.Length, nameof(scales));
+            fixed (Vector3* ptr = scales)
+                Urho3D_NodeList_GetScales(swigCPtr, ptr, world);
+        }
+
+        /// <summary>
+        /// Set node scales from span. Span should have at least as many elements as the list.
+        /// </summary>
+        public unsafe void SetScales(ReadOnlySpan<Vector3> scales, bool world = false)
+        {
+            CheckLength(scales.Length, nameof(scales));
+            fixed (Vector3* ptr = scales)
+                Urho3D_NodeList_SetScales(swigCPtr, ptr, world);
+        }
+
+        /// <summary>
+        /// Copy node world transforms into span. Span should have at least as many elements as the list.
+        /// </summary>
+        public unsafe void GetWorldTransforms(Span<Matrix3x4> transforms)
+        {
+            CheckLength(transforms.Length, nameof(transforms));
+            fixed (Matrix3x4* ptr = transforms)
+                Urho3D_NodeList_GetWorldTransforms(swigCPtr, ptr);
+        }
+
+        /// <summary>
+        /// Set node positions and rotations from spans. Spans should have at least as many elements as the list.
+        /// </summary>
+        public unsafe void SetTransforms(ReadOnlySpan<Vector3> positions, ReadOnlySpan<Quaternion> rotations, bool world = false)
+        {
+            CheckLength(positions.Length, nameof(positions));
+            CheckLength(rotations.Length, nameof(rotations));
+            fixed (Vector3* positionsPtr = positions)
+            fixed (Quaternion* rotationsPtr = rotations)
+                Urho3D_NodeList_SetTransforms(swigCPtr, positionsPtr, rotationsPtr, world);
+        }
+
+        private void CheckLength(int length, string paramName)
+        {
+            if (length < Count)
+                throw new ArgumentException("Span is shorter than the node list.", paramName);
+        }
+    }
+}
@@ -0,0 +1,65 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Engine/Engine.h>
+#include <Urho3D/Script/Script.h>
+
+namespace Urho3D
+{
+
+typedef void(SWIGSTDCALL* FrameUpdateCallback)(void* callbackHandle, const FrameUpdateEventArgs* args);
+
+extern "C"
+{
+
+// Phase is index of Engine::OnUpdate, OnPostUpdate, OnRenderUpdate or OnPostRenderUpdate signal.
+URHO3D_EXPORT_API void SWIGSTDCALL Urho3D_Engine_SubscribeToFrameUpdate(
+    Engine* engine, RefCounted* receiver, int phase, FrameUpdateCallback callback, void* callbackHandle)
+{
+    Signal<void(const FrameUpdateEventArgs&), Engine>* signals[] = {
+        &engine->OnUpdate, &engine->OnPostUpdate, &engine->OnRenderUpdate, &engine->OnPostRenderUpdate};
+    if (phase < 0 || phase >= static_cast<int>(ea::size(signals)))
+    {
+        Script::GetRuntimeApi()->FreeGCHandle(callbackHandle);
+        return;
+    }
+
+    // Handle is freed together with subscription when receiver expires
+    GCHandleRef callbackHandleHolder(callbackHandle);
+    signals[phase]->Subscribe(receiver,
+        [callback, callbackHandleHolder{ea::move(callbackHandleHolder)}](const FrameUpdateEventArgs& args)
+    {
+        callback(callbackHandleHolder.GetHandle(), &args);
+    });
+}
+
+URHO3D_EXPORT_API void SWIGSTDCALL Urho3D_Engine_UnsubscribeFromFrameUpdate(Engine* engine, RefCounted* receiver)
+{
+    engine->OnUpdate.Unsubscribe(receiver);
+    engine->OnPostUpdate.Unsubscribe(receiver);
+    engine->OnRenderUpdate.Unsubscribe(receiver);
+    engine->OnPostRenderUpdate.Unsubscribe(receiver);
+}
+
+}   // extern "C"
+
+}   // namespace Urho3D
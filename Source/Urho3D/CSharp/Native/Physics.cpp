@@ -0,0 +1,63 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#ifdef URHO3D_PHYSICS
+
+#include <Urho3D/Physics/PhysicsWorld.h>
+#include <Urho3D/Physics/RigidBody.h>
+#include <Urho3D/Script/Script.h>
+
+namespace Urho3D
+{
+
+extern "C"
+{
+
+// Output arrays must have at least as many elements as the result list. Null output arrays are skipped.
+URHO3D_EXPORT_API void SWIGSTDCALL Urho3D_PhysicsRaycastResultVector_GetHits(
+    const ea::vector<PhysicsRaycastResult>* results, Vector3* positions, Vector3* normals, float* distances)
+{
+    for (const PhysicsRaycastResult& result : *results)
+    {
+        if (positions)
+            *positions++ = result.position_;
+        if (normals)
+            *normals++ = result.normal_;
+        if (distances)
+            *distances++ = result.distance_;
+    }
+}
+
+URHO3D_EXPORT_API void SWIGSTDCALL Urho3D_PhysicsRaycastResultVector_GetNodes(
+    const ea::vector<PhysicsRaycastResult>* results, ea::vector<Node*>* nodes)
+{
+    nodes->clear();
+    nodes->reserve(results->size());
+    for (const PhysicsRaycastResult& result : *results)
+        nodes->push_back(result.body_ ? result.body_->GetNode() : nullptr);
+}
+
+}   // extern "C"
+
+}   // namespace Urho3D
+
+#endif
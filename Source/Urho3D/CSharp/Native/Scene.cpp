@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Scene/Component.h>
+#include <Urho3D/Scene/LogicUpdateQueue.h>
+#include <Urho3D/Scene/Node.h>
+#include <Urho3D/Script/Script.h>
+
+namespace Urho3D
+{
+
+namespace
+{
+
+template <class T, class Getter> void GetNodeValues(const ea::vector<Node*>* nodes, T* values, Getter getter)
+{
+    for (Node* node : *nodes)
+        *values++ = node ? getter(node) : T{};
+}
+
+template <class T, class Setter> void SetNodeValues(const ea::vector<Node*>* nodes, const T* values, Setter setter)
+{
+    for (Node* node : *nodes)
+    {
+        if (node)
+            setter(node, *values);
+        ++values;
+    }
+}
+
+}
+
+extern "C"
+{
+
+// Destination and source arrays must have at least as many elements as the node list. Null nodes are skipped on write
+// and yield default values on read.
+
+URHO3D_EXPORT_API void SWIGSTDCALL Urho3D_NodeList_GetPositions(
+    const ea::vector<Node*>* nodes, Vector3* positions, bool world)
+{
+    if (world)
+        GetNodeValues(nodes, positions, [](Node* node) { return node->GetWorldPosition(); });
+    else
+        GetNodeValues(nodes, positions, [](Node* node) { return node->GetPosition(); });
+}
+
+URHO3D_EXPORT_API void SWIGSTDCALL Urho3D_NodeList_SetPositions(
+    const ea::vector<Node*>* nodes, const Vector3* positions, bool world)
+{
+    if (world)
+        SetNodeValues(nodes, positions, [](Node* node, const Vector3& value) { node->SetWorldPosition(value); });
+    else
+        SetNodeValues(nodes, positions, [](Node* node, const Vector3& value) { node->SetPosition(value); });
+}
+
+URHO3D_EXPORT_API void SWIGSTDCALL Urho3D_NodeList_GetRotations(
+    const ea::vector<Node*>* nodes, Quaternion* rotations, bool world)
+{
+    if (world)
+        GetNodeValues(nodes, rotations, [](Node* node) { return node->GetWorldRotation(); });
+    else
+        GetNodeValues(nodes, rotations, [](Node* node) { return node->GetRotation(); });
+}
+
+URHO3D_EXPORT_API void SWIGSTDCALL Urho3D_NodeList_SetRotations(
+    const ea::vector<Node*>* nodes, const Quaternion* rotations, bool world)
+{
+    if (world)
+        SetNodeValues(nodes, rotations, [](Node* node, const Quaternion& value) { node->SetWorldRotation(value); });
+    else
+        SetNodeValues(nodes, rotations, [](Node* node, const Quaternion& value) { node->SetRotation(value); });
+}
+
+URHO3D_EXPORT_API void SWIGSTDCALL Urho3D_NodeList_GetScales(
+    const ea::vector<Node*>* nodes, Vector3* scales, bool world)
+{
+    if (world)
+        GetNodeValues(nodes, scales, [](Node* node) { return node->GetWorldScale(); });
+    else
+        GetNodeValues(nodes, scales, [](Node* node) { return node->GetScale(); });
+}
+
+URHO3D_EXPORT_API void SWIGSTDCALL Urho3D_NodeList_SetScales(
+    const ea::vector<Node*>* nodes, const Vector3* scales, bool world)
+{
+    if (world)
+        SetNodeValues(nodes, scales, [](Node* node, const Vector3& value) { node->SetWorldScale(value); });
+    else
+        SetNodeValues(nodes, scales, [](Node* node, const Vector3& value) { node->SetScale(value); });
+}
+
+URHO3D_EXPORT_API void SWIGSTDCALL Urho3D_NodeList_GetWorldTransforms(
+    const ea::vector<Node*>* nodes, Matrix3x4* transforms)
+{
+    GetNodeValues(nodes, transforms, [](Node* node) { return node->GetWorldTransform(); });
+}
+
+URHO3D_EXPORT_API void SWIGSTDCALL Urho3D_NodeList_SetTransforms(
+    const ea::vector<Node*>* nodes, const Vector3* positions, const Quaternion* rotations, bool world)
+{
+    for (Node* node : *nodes)
+    {
+        if (node)
+        {
+            if (world)
+                node->SetWorldTransform(*positions, *rotations);
+            else
+                node->SetTransform(*positions, *rotations);
+        }
+        ++positions;
+        ++rotations;
+    }
+}
+
+URHO3D_EXPORT_API void SWIGSTDCALL Urho3D_ComponentList_GetNodes(
+    const ea::vector<Component*>* components, ea::vector<Node*>* nodes)
+{
+    nodes->clear();
+    nodes->reserve(components->size());
+    for (Component* component : *components)
+        nodes->push_back(component ? component->GetNode() : nullptr);
+}
+
+URHO3D_EXPORT_API void SWIGSTDCALL Urho3D_LogicUpdateQueue_SetScriptUpdateCallback(ScriptLogicUpdateCallback callback)
+{
+    LogicUpdateQueue::SetScriptUpdateCallback(callback);
+}
+
+}   // extern "C"
+
+}   // namespace Urho3D
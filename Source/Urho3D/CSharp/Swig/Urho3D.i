@@ -358,6 +358,12 @@ namespace SDL
 
 // --------------------------------------- Engine ---------------------------------------
 %ignore Urho3D::Engine::DefineParameters;
+// Typed frame update signals are exposed through Engine.SubscribeToFrameUpdate(), arguments are defined in C#
+%ignore Urho3D::FrameUpdateEventArgs;
+%ignore Urho3D::Engine::OnUpdate;
+%ignore Urho3D::Engine::OnPostUpdate;
+%ignore Urho3D::Engine::OnRenderUpdate;
+%ignore Urho3D::Engine::OnPostRenderUpdate;
 %ignore Urho3D::Application::engine_;
 %ignore Urho3D::Application::GetCommandLineParser;
 %ignore Urho3D::PluginApplicationMain;
@@ -473,11 +479,14 @@ public:
 // These expose iterators of underlying collection. Iterate object through GetObject() instead.
 %ignore Urho3D::BackgroundLoadItem;
 %ignore Urho3D::BackgroundLoader::ThreadFunction;
+%ignore Urho3D::ResourceLoadRequest::ResourceLoadRequest;
+%ignore Urho3D::ResourceCache::RequestResource;
 %ignore Urho3D::ImageCube::CalculateSphericalHarmonics;
 %rename(GetValueType) Urho3D::PListValue::GetType;
 
 %include "generated/Urho3D/_pre_resource.i"
 %include "Urho3D/Resource/Resource.h"
+%include "Urho3D/Resource/ResourceLoadRequest.h"
 #if defined(URHO3D_THREADING)
 %include "Urho3D/Resource/BackgroundLoader.h"
 #endif
@@ -962,6 +971,7 @@ using ImGuiConfigFlags = unsigned;
 %include "Urho3D/Urho2D/Renderer2D.h"
 %include "Urho3D/Urho2D/SpriteSheet2D.h"
 %include "Urho3D/Urho2D/TileMapLayer2D.h"
+%include "Urho3D/Urho2D/TileMapChunk2D.h"
 %include "Urho3D/Urho2D/ParticleEmitter2D.h"
 %include "Urho3D/Urho2D/Sprite2D.h"
 %include "Urho3D/Urho2D/StretchableSprite2D.h"
@@ -1040,6 +1050,17 @@ using ImGuiConfigFlags = unsigned;
 %template(TextureMap)                   eastl::unordered_map<Urho3D::TextureUnit, Urho3D::SharedPtr<Urho3D::Texture>>;
 
 using Vector3 = Urho3D::Vector3;
+// Vectors of types with identical memory layout in C++ and C# expose elements as Span
+SWIG_EASTL_VECTOR_BLITTABLE(Urho3D::StringHash)
+SWIG_EASTL_VECTOR_BLITTABLE(Urho3D::Vector2)
+SWIG_EASTL_VECTOR_BLITTABLE(Urho3D::Vector3)
+SWIG_EASTL_VECTOR_BLITTABLE(Urho3D::Vector4)
+SWIG_EASTL_VECTOR_BLITTABLE(Urho3D::IntVector2)
+SWIG_EASTL_VECTOR_BLITTABLE(Urho3D::IntVector3)
+SWIG_EASTL_VECTOR_BLITTABLE(Urho3D::Quaternion)
+SWIG_EASTL_VECTOR_BLITTABLE(Urho3D::Rect)
+SWIG_EASTL_VECTOR_BLITTABLE(Urho3D::IntRect)
+SWIG_EASTL_VECTOR_BLITTABLE(Urho3D::Matrix3x4)
 %template(StringHashList)                   eastl::vector<Urho3D::StringHash>;
 %template(Vector2List)                      eastl::vector<Urho3D::Vector2>;
 %template(Vector3List)                      eastl::vector<Urho3D::Vector3>;
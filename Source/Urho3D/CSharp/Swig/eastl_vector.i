@@ -355,6 +355,53 @@ namespace eastl {
 }
 %enddef
 
+// Extra methods added to the collection class if C++ and C# element types have identical memory layout.
+// Elements may be accessed as Span without copying and without marshalling of individual elements.
+%define SWIG_EASTL_VECTOR_EXTRA_SPAN(CTYPE...)
+%proxycode %{
+  /// Return span over native storage. Span is invalidated when vector is resized or destroyed.
+  public unsafe global::System.Span<$typemap(cstype, CTYPE)> AsSpan() {
+    return new global::System.Span<$typemap(cstype, CTYPE)>(data().ToPointer(), Count);
+  }
+
+  /// Replace contents of vector with elements of the span.
+  public void Assign(global::System.ReadOnlySpan<$typemap(cstype, CTYPE)> values) {
+    resize(values.Length);
+    values.CopyTo(AsSpan());
+  }
+%}
+    %extend {
+      void* data() {
+        return $self->data();
+      }
+      void resize(int count) throw (std::out_of_range) {
+        if (count >= 0)
+          $self->resize(count);
+        else
+          throw std::out_of_range("count");
+      }
+    }
+%enddef
+
+%define SWIG_EASTL_VECTOR_ENHANCED_BLITTABLE(CTYPE...)
+namespace eastl {
+  template<> class vector< CTYPE > {
+    SWIG_EASTL_VECTOR_MINIMUM_INTERNAL(IList, %arg(CTYPE const&), %arg(CTYPE))
+    SWIG_EASTL_VECTOR_EXTRA_OP_EQUALS_EQUALS(CTYPE)
+    SWIG_EASTL_VECTOR_EXTRA_SPAN(CTYPE)
+  };
+}
+%enddef
+
+%define SWIG_EASTL_VECTOR_BLITTABLE(CTYPE...)
+namespace eastl {
+  template<> class vector< CTYPE > {
+    SWIG_EASTL_VECTOR_MINIMUM_INTERNAL(IEnumerable, %arg(CTYPE const&), %arg(CTYPE))
+    SWIG_EASTL_VECTOR_EXTRA_SPAN(CTYPE)
+  };
+}
+%enddef
+
 // Legacy macros
 %define SWIG_EASTL_VECTOR_SPECIALIZE(CSTYPE, CTYPE...)
 #warning SWIG_EASTL_VECTOR_SPECIALIZE macro deprecated, please see csharp/std_vector.i and switch to SWIG_EASTL_VECTOR_ENHANCED
@@ -377,6 +424,8 @@ SWIG_EASTL_VECTOR_ENHANCED(CTYPE)
 %csmethodmodifiers eastl::vector::size "private"
 %csmethodmodifiers eastl::vector::capacity "private"
 %csmethodmodifiers eastl::vector::reserve "private"
+%csmethodmodifiers eastl::vector::data "private"
+%csmethodmodifiers eastl::vector::resize "private"
 
 namespace eastl {
   // primary (unspecialized) class template for eastl::vector
@@ -398,19 +447,20 @@ namespace eastl {
 
 // template specializations for eastl::vector
 // these provide extra collections methods as operator== is defined
+// char and long are excluded from span access because their C# counterparts have different size
 SWIG_EASTL_VECTOR_ENHANCED(char)
-SWIG_EASTL_VECTOR_ENHANCED(signed char)
-SWIG_EASTL_VECTOR_ENHANCED(unsigned char)
-SWIG_EASTL_VECTOR_ENHANCED(short)
-SWIG_EASTL_VECTOR_ENHANCED(unsigned short)
-SWIG_EASTL_VECTOR_ENHANCED(int)
-SWIG_EASTL_VECTOR_ENHANCED(unsigned int)
+SWIG_EASTL_VECTOR_ENHANCED_BLITTABLE(signed char)
+SWIG_EASTL_VECTOR_ENHANCED_BLITTABLE(unsigned char)
+SWIG_EASTL_VECTOR_ENHANCED_BLITTABLE(short)
+SWIG_EASTL_VECTOR_ENHANCED_BLITTABLE(unsigned short)
+SWIG_EASTL_VECTOR_ENHANCED_BLITTABLE(int)
+SWIG_EASTL_VECTOR_ENHANCED_BLITTABLE(unsigned int)
 SWIG_EASTL_VECTOR_ENHANCED(long)
 SWIG_EASTL_VECTOR_ENHANCED(unsigned long)
-SWIG_EASTL_VECTOR_ENHANCED(long long)
-SWIG_EASTL_VECTOR_ENHANCED(unsigned long long)
-SWIG_EASTL_VECTOR_ENHANCED(float)
-SWIG_EASTL_VECTOR_ENHANCED(double)
+SWIG_EASTL_VECTOR_ENHANCED_BLITTABLE(long long)
+SWIG_EASTL_VECTOR_ENHANCED_BLITTABLE(unsigned long long)
+SWIG_EASTL_VECTOR_ENHANCED_BLITTABLE(float)
+SWIG_EASTL_VECTOR_ENHANCED_BLITTABLE(double)
 SWIG_EASTL_VECTOR_ENHANCED(eastl::string) // also requires a %include <std_string.i>
 SWIG_EASTL_VECTOR_ENHANCED(eastl::wstring) // also requires a %include <std_wstring.i>
 
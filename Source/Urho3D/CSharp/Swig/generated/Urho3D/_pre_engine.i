@@ -28,6 +28,8 @@
 %ignore Urho3D::EP_GPU_DEBUG;
 %constant const char* EpHeadless = "Headless";
 %ignore Urho3D::EP_HEADLESS;
+%constant const char* EpHeadlessRenderUpdates = "HeadlessRenderUpdates";
+%ignore Urho3D::EP_HEADLESS_RENDER_UPDATES;
 %constant const char* EpHighDpi = "HighDPI";
 %ignore Urho3D::EP_HIGH_DPI;
 %constant const char* EpLogLevel = "LogLevel";
@@ -132,6 +134,7 @@
 %csattribute(Urho3D::Engine, %arg(bool), IsInitialized, IsInitialized);
 %csattribute(Urho3D::Engine, %arg(bool), IsExiting, IsExiting);
 %csattribute(Urho3D::Engine, %arg(bool), IsHeadless, IsHeadless);
+%csattribute(Urho3D::Engine, %arg(bool), IsRenderUpdateSkipped, IsRenderUpdateSkipped);
 %csattribute(Urho3D::ApplicationState, %arg(bool), IsActive, IsActive);
 %csattribute(Urho3D::ApplicationState, %arg(Urho3D::Cursor *), Cursor, GetCursor, SetCursor);
 %csattribute(Urho3D::ApplicationState, %arg(bool), IsMouseVisible, IsMouseVisible, SetMouseVisible);
@@ -28,6 +28,12 @@
 %ignore Urho3D::NetworkSettings::InputBufferingMax;
 %constant Urho3D::NetworkSetting RelevanceTimeout = Urho3D::NetworkSettings::RelevanceTimeout;
 %ignore Urho3D::NetworkSettings::RelevanceTimeout;
+%constant Urho3D::NetworkSetting InterestGridCellSize = Urho3D::NetworkSettings::InterestGridCellSize;
+%ignore Urho3D::NetworkSettings::InterestGridCellSize;
+%constant Urho3D::NetworkSetting UnreliableUpdateBudget = Urho3D::NetworkSettings::UnreliableUpdateBudget;
+%ignore Urho3D::NetworkSettings::UnreliableUpdateBudget;
+%constant Urho3D::NetworkSetting UnreliableDeltaWindow = Urho3D::NetworkSettings::UnreliableDeltaWindow;
+%ignore Urho3D::NetworkSettings::UnreliableDeltaWindow;
 %constant Urho3D::NetworkSetting ServerTracingDuration = Urho3D::NetworkSettings::ServerTracingDuration;
 %ignore Urho3D::NetworkSettings::ServerTracingDuration;
 %constant Urho3D::NetworkSetting TimeErrorTolerance = Urho3D::NetworkSettings::TimeErrorTolerance;
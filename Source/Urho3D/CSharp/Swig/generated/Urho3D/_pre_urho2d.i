@@ -122,6 +122,7 @@
 %csattribute(Urho3D::TileMap2D, %arg(Urho3D::TileMapInfo2D), Info, GetInfo);
 %csattribute(Urho3D::TileMap2D, %arg(unsigned int), NumLayers, GetNumLayers);
 %csattribute(Urho3D::TileMap2D, %arg(Urho3D::ResourceRef), TmxFileAttr, GetTmxFileAttr, SetTmxFileAttr);
+%csattribute(Urho3D::TileMap2D, %arg(int), ChunkSize, GetChunkSize, SetChunkSize);
 %csattribute(Urho3D::TileMapLayer2D, %arg(Urho3D::TileMap2D *), TileMap, GetTileMap);
 %csattribute(Urho3D::TileMapLayer2D, %arg(Urho3D::TmxLayer2D *), TmxLayer, GetTmxLayer);
 %csattribute(Urho3D::TileMapLayer2D, %arg(int), DrawOrder, GetDrawOrder, SetDrawOrder);
@@ -129,6 +130,7 @@
 %csattribute(Urho3D::TileMapLayer2D, %arg(Urho3D::TileMapLayerType2D), LayerType, GetLayerType);
 %csattribute(Urho3D::TileMapLayer2D, %arg(int), Width, GetWidth);
 %csattribute(Urho3D::TileMapLayer2D, %arg(int), Height, GetHeight);
+%csattribute(Urho3D::TileMapLayer2D, %arg(int), ChunkSize, GetChunkSize);
 %csattribute(Urho3D::TileMapLayer2D, %arg(unsigned int), NumObjects, GetNumObjects);
 %csattribute(Urho3D::TileMapLayer2D, %arg(Urho3D::Node *), ImageNode, GetImageNode);
 %csattribute(Urho3D::TmxLayer2D, %arg(Urho3D::TmxFile2D *), TmxFile, GetTmxFile);
@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Container/LinearAllocator.h"
+
+#include "../Core/Assert.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+LinearAllocator::LinearAllocator(unsigned chunkSize)
+    : chunkSize_(chunkSize)
+{
+}
+
+LinearAllocator::~LinearAllocator() = default;
+
+void* LinearAllocator::Allocate(unsigned size, unsigned alignment)
+{
+    URHO3D_ASSERT(alignment != 0 && (alignment & (alignment - 1)) == 0, "Alignment should be power of two");
+
+    const auto tryAllocate = [&]() -> void*
+    {
+        const Chunk& chunk = chunks_.back();
+        const auto begin = reinterpret_cast<uintptr_t>(chunk.data_.get());
+        const auto alignedAddress = (begin + offset_ + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+        const auto alignedOffset = static_cast<unsigned>(alignedAddress - begin);
+        if (alignedOffset + size > chunk.size_)
+            return nullptr;
+
+        offset_ = alignedOffset + size;
+        usedSize_ += size;
+        return chunk.data_.get() + alignedOffset;
+    };
+
+    if (!chunks_.empty())
+    {
+        if (void* ptr = tryAllocate())
+            return ptr;
+    }
+
+    // New chunk always fits the block, including worst case alignment padding
+    AllocateChunk(size + alignment);
+    return tryAllocate();
+}
+
+void LinearAllocator::Reset()
+{
+    if (chunks_.size() > 1)
+    {
+        const unsigned capacity = GetCapacity();
+        chunks_.clear();
+        AllocateChunk(capacity);
+    }
+
+    offset_ = 0;
+    usedSize_ = 0;
+}
+
+unsigned LinearAllocator::GetCapacity() const
+{
+    unsigned capacity = 0;
+    for (const Chunk& chunk : chunks_)
+        capacity += chunk.size_;
+    return capacity;
+}
+
+void LinearAllocator::AllocateChunk(unsigned minSize)
+{
+    Chunk& chunk = chunks_.emplace_back();
+    chunk.size_ = ea::max(minSize, chunkSize_);
+    chunk.data_ = ea::make_unique<unsigned char[]>(chunk.size_);
+    offset_ = 0;
+}
+
+}
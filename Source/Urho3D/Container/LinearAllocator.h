@@ -0,0 +1,130 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Core/NonCopyable.h"
+
+#include <Urho3D/Urho3D.h>
+
+#include <EASTL/unique_ptr.h>
+#include <EASTL/vector.h>
+
+#include <cstddef>
+
+namespace Urho3D
+{
+
+/// Linear (bump) allocator. Individual allocations are never freed, all memory is released at once on Reset.
+/// Not thread-safe.
+class URHO3D_API LinearAllocator : private NonCopyable
+{
+public:
+    /// Default size of memory chunk.
+    static constexpr unsigned DefaultChunkSize = 64 * 1024;
+
+    /// Construct.
+    explicit LinearAllocator(unsigned chunkSize = DefaultChunkSize);
+    /// Destruct.
+    ~LinearAllocator();
+
+    /// Allocate memory block. Never returns null.
+    void* Allocate(unsigned size, unsigned alignment = alignof(std::max_align_t));
+    /// Release all allocated memory at once.
+    /// If more than one chunk was used, chunks are merged into one so next time it's enough.
+    void Reset();
+
+    /// Return total size of allocated memory blocks.
+    unsigned GetUsedSize() const { return usedSize_; }
+    /// Return total size of owned memory chunks.
+    unsigned GetCapacity() const;
+    /// Return number of owned memory chunks.
+    unsigned GetNumChunks() const { return chunks_.size(); }
+
+private:
+    /// Memory chunk.
+    struct Chunk
+    {
+        ea::unique_ptr<unsigned char[]> data_;
+        unsigned size_{};
+    };
+
+    /// Allocate new chunk that fits at least given size.
+    void AllocateChunk(unsigned minSize);
+
+    /// Default size of new chunk.
+    unsigned chunkSize_{};
+    /// Memory chunks. Only the last one is used for new allocations.
+    ea::vector<Chunk> chunks_;
+    /// Offset in the last chunk.
+    unsigned offset_{};
+    /// Total size of allocated memory blocks.
+    unsigned usedSize_{};
+};
+
+/// EASTL allocator that allocates from LinearAllocator. Deallocation does nothing.
+class LinearAllocatorAdaptor
+{
+public:
+    /// Construct with allocator.
+    explicit LinearAllocatorAdaptor(LinearAllocator* allocator) : allocator_(allocator) {}
+    /// Construct without allocator. Required by EASTL. Allocator should be assigned before use.
+    explicit LinearAllocatorAdaptor(const char* /*name*/ = nullptr) {}
+
+    /// Allocate memory. Required by EASTL.
+    void* allocate(size_t n, int /*flags*/ = 0)
+    {
+        return allocator_->Allocate(static_cast<unsigned>(n));
+    }
+
+    /// Allocate aligned memory. Required by EASTL.
+    void* allocate(size_t n, size_t alignment, size_t /*offset*/, int /*flags*/ = 0)
+    {
+        return allocator_->Allocate(static_cast<unsigned>(n), static_cast<unsigned>(alignment));
+    }
+
+    /// Deallocate memory. Does nothing, memory is released on LinearAllocator::Reset.
+    void deallocate(void* /*p*/, size_t /*n*/) {}
+
+    /// Return name. Required by EASTL.
+    const char* get_name() const { return "LinearAllocator"; }
+    /// Set name. Required by EASTL.
+    void set_name(const char* /*name*/) {}
+
+    /// Return underlying allocator.
+    LinearAllocator* GetAllocator() const { return allocator_; }
+
+    /// Compare allocators.
+    bool operator ==(const LinearAllocatorAdaptor& rhs) const { return allocator_ == rhs.allocator_; }
+    /// Compare allocators.
+    bool operator !=(const LinearAllocatorAdaptor& rhs) const { return allocator_ != rhs.allocator_; }
+
+private:
+    /// Underlying allocator.
+    LinearAllocator* allocator_{};
+};
+
+/// Vector that allocates from LinearAllocator. Should not outlive allocated memory.
+template <class T> using LinearVector = ea::vector<T, LinearAllocatorAdaptor>;
+
+}
@@ -0,0 +1,117 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Math/MathDefs.h"
+
+#include <EASTL/unique_ptr.h>
+#include <EASTL/utility.h>
+
+#include <atomic>
+
+namespace Urho3D
+{
+
+/// Bounded lock-free queue with multiple producer threads and single consumer thread.
+/// Each cell carries sequence number so producers can claim cells without locking.
+template <class T>
+class MultipleProducerQueue
+{
+public:
+    /// Allocate storage and discard contents. Capacity is rounded up to power of two. Not thread-safe.
+    void Allocate(unsigned capacity)
+    {
+        capacity = NextPowerOfTwo(Max(capacity, 2u));
+        cells_ = ea::make_unique<Cell[]>(capacity);
+        for (unsigned i = 0; i < capacity; ++i)
+            cells_[i].sequence_.store(i, std::memory_order_relaxed);
+        mask_ = capacity - 1;
+        head_ = 0;
+        tail_.store(0, std::memory_order_relaxed);
+    }
+
+    /// Push element. Return false and leave the value intact if the queue is full. Thread-safe.
+    bool Push(T& value)
+    {
+        unsigned position = tail_.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+        while (true)
+        {
+            cell = &cells_[position & mask_];
+            const unsigned sequence = cell->sequence_.load(std::memory_order_acquire);
+            const int difference = static_cast<int>(sequence - position);
+            if (difference == 0)
+            {
+                if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+                return false;
+            else
+                position = tail_.load(std::memory_order_relaxed);
+        }
+
+        cell->value_ = ea::move(value);
+        cell->sequence_.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Pop element. Return false if the queue is empty. Should be called from consumer thread only.
+    bool Pop(T& value)
+    {
+        Cell& cell = cells_[head_ & mask_];
+        const unsigned sequence = cell.sequence_.load(std::memory_order_acquire);
+        if (static_cast<int>(sequence - (head_ + 1)) < 0)
+            return false;
+
+        value = ea::move(cell.value_);
+        cell.sequence_.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    /// Return capacity.
+    unsigned GetCapacity() const { return cells_ ? mask_ + 1 : 0; }
+
+private:
+    /// Queue cell.
+    struct Cell
+    {
+        /// Sequence number. Equals position when the cell is free and position + 1 when the cell is filled.
+        std::atomic<unsigned> sequence_{};
+        /// Stored value.
+        T value_{};
+    };
+
+    /// Cells.
+    ea::unique_ptr<Cell[]> cells_;
+    /// Mask of cell index.
+    unsigned mask_{};
+    /// Position of the next element to pop. Owned by consumer.
+    unsigned head_{};
+    /// Position of the next element to push.
+    std::atomic<unsigned> tail_{};
+};
+
+}
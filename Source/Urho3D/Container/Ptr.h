@@ -22,7 +22,6 @@
 
 #pragma once
 
-#include <EASTL/internal/thread_support.h>
 #include <EASTL/utility.h>
 
 #include "../Container/RefCounted.h"
@@ -277,9 +276,9 @@ public:
         if (ptr)
         {
             RefCount* refCount = RefCountPtr();
-            ea::Internal::atomic_increment(&refCount->refs_); // 2 refs
+            RefCount::Increment(refCount->refs_); // 2 refs
             Reset(); // 1 ref
-            ea::Internal::atomic_decrement(&refCount->refs_); // 0 refs
+            RefCount::Decrement(refCount->refs_); // 0 refs
         }
         return ptr;
     }
@@ -571,7 +570,7 @@ private:
         if (refCount_)
         {
             assert(refCount_->weakRefs_ >= 0);
-            ea::Internal::atomic_increment(&refCount_->weakRefs_);
+            RefCount::Increment(refCount_->weakRefs_);
         }
     }
 
@@ -581,7 +580,7 @@ private:
         if (refCount_)
         {
             assert(refCount_->weakRefs_ > 0);
-            int weakRefs = ea::Internal::atomic_decrement(&refCount_->weakRefs_);
+            int weakRefs = RefCount::Decrement(refCount_->weakRefs_);
 
             if (Expired() && weakRefs == 0)
                 RefCount::Free(refCount_);
@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+
+#include <EASTL/sort.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/vector.h>
+
+#include <cstring>
+
+namespace Urho3D
+{
+
+/// Ranges shorter than this are sorted with insertion sort.
+static constexpr unsigned RadixSortThreshold = 64;
+
+/// Convert float to unsigned integer key that preserves order of finite values.
+inline unsigned FloatToRadixKey(float value)
+{
+    unsigned bits{};
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+/// Stable LSD radix sort by unsigned integer key, 8 bits per pass.
+/// Passes over bytes that are equal for all elements are skipped, so only the varying bits of the key cost time.
+/// Buffer is used as temporary storage and is resized to the size of the range.
+template <class T, class GetKey>
+void RadixSort(T* begin, T* end, ea::vector<T>& buffer, const GetKey& getKey)
+{
+    using KeyType = ea::decay_t<decltype(getKey(*begin))>;
+    static_assert(ea::is_unsigned<KeyType>::value, "Radix sort key should be unsigned integer");
+
+    static constexpr unsigned NumDigits = sizeof(KeyType);
+    static constexpr unsigned NumBuckets = 256;
+
+    const unsigned size = static_cast<unsigned>(end - begin);
+    if (size < RadixSortThreshold)
+    {
+        const auto compare = [&](const T& lhs, const T& rhs) { return getKey(lhs) < getKey(rhs); };
+        ea::insertion_sort(begin, end, compare);
+        return;
+    }
+
+    // Build histograms for all digits at once
+    unsigned histograms[NumDigits][NumBuckets]{};
+    for (const T* iter = begin; iter != end; ++iter)
+    {
+        const KeyType key = getKey(*iter);
+        for (unsigned digit = 0; digit < NumDigits; ++digit)
+            ++histograms[digit][(key >> (digit * 8)) & 0xff];
+    }
+
+    buffer.resize(size);
+    T* source = begin;
+    T* destination = buffer.data();
+    for (unsigned digit = 0; digit < NumDigits; ++digit)
+    {
+        unsigned* histogram = histograms[digit];
+        const unsigned shift = digit * 8;
+
+        // Skip digit if it's the same for all elements
+        if (histogram[(getKey(*source) >> shift) & 0xff] == size)
+            continue;
+
+        unsigned offset = 0;
+        for (unsigned bucket = 0; bucket < NumBuckets; ++bucket)
+        {
+            const unsigned count = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += count;
+        }
+
+        for (T* iter = source; iter != source + size; ++iter)
+            destination[histogram[(getKey(*iter) >> shift) & 0xff]++] = ea::move(*iter);
+
+        ea::swap(source, destination);
+    }
+
+    if (source != begin)
+        ea::move(source, source + size, begin);
+}
+
+}
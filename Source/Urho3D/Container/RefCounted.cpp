@@ -24,8 +24,6 @@
 
 #include <cassert>
 
-#include <EASTL/internal/thread_support.h>
-
 #include "../Container/RefCounted.h"
 #include "../Core/Macros.h"
 #if URHO3D_CSHARP
@@ -79,7 +77,7 @@ RefCounted::~RefCounted()
     // Mark object as expired, release the self weak ref and delete the refcount if no other weak refs exist
     refCount_->refs_ = -1;
 
-    if (ea::Internal::atomic_decrement(&refCount_->weakRefs_) == 0)
+    if (RefCount::Decrement(refCount_->weakRefs_) == 0)
         RefCount::Free(refCount_);
 
     refCount_ = nullptr;
@@ -87,7 +85,7 @@ RefCounted::~RefCounted()
 
 int RefCounted::AddRef()
 {
-    int refs = ea::Internal::atomic_increment(&refCount_->refs_);
+    int refs = RefCount::Increment(refCount_->refs_);
     assert(refs > 0);
 #if URHO3D_CSHARP
     if (URHO3D_UNLIKELY(scriptObject_ && !isScriptStrongRef_))
@@ -105,7 +103,7 @@ int RefCounted::AddRef()
 
 int RefCounted::ReleaseRef()
 {
-    int refs = ea::Internal::atomic_decrement(&refCount_->refs_);
+    int refs = RefCount::Decrement(refCount_->refs_);
     assert(refs >= 0);
 #if URHO3D_CSHARP
     if (refs == 0)
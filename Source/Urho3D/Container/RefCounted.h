@@ -23,6 +23,7 @@
 #pragma once
 
 #include <EASTL/allocator.h>
+#include <EASTL/internal/thread_support.h>
 
 #include <Urho3D/Urho3D.h>
 
@@ -52,6 +53,28 @@ public:
     /// Free RefCount using it's default allocator.
     static void Free(RefCount* instance);
 
+    /// Increment counter and return new value.
+    /// Operation is atomic unless URHO3D_NONATOMIC_REFCOUNT is defined.
+    static int Increment(int& counter)
+    {
+#ifdef URHO3D_NONATOMIC_REFCOUNT
+        return ++counter;
+#else
+        return ea::Internal::atomic_increment(&counter);
+#endif
+    }
+
+    /// Decrement counter and return new value.
+    /// Operation is atomic unless URHO3D_NONATOMIC_REFCOUNT is defined.
+    static int Decrement(int& counter)
+    {
+#ifdef URHO3D_NONATOMIC_REFCOUNT
+        return --counter;
+#else
+        return ea::Internal::atomic_decrement(&counter);
+#endif
+    }
+
     /// Reference count. If below zero, the object has been destroyed.
     int refs_ = 0;
     /// Weak reference count.
@@ -72,10 +95,10 @@ public:
     /// Prevent assignment.
     RefCounted& operator =(const RefCounted& rhs) = delete;
 
-    /// Increment reference count. Can also be called outside of a SharedPtr for traditional reference counting. Returns new reference count value. Operation is atomic.
+    /// Increment reference count. Can also be called outside of a SharedPtr for traditional reference counting. Returns new reference count value. Operation is atomic unless URHO3D_NONATOMIC_REFCOUNT is defined.
     /// @manualbind
     int AddRef();
-    /// Decrement reference count and delete self if no more references. Can also be called outside of a SharedPtr for traditional reference counting. Returns new reference count value. Operation is atomic.
+    /// Decrement reference count and delete self if no more references. Can also be called outside of a SharedPtr for traditional reference counting. Returns new reference count value. Operation is atomic unless URHO3D_NONATOMIC_REFCOUNT is defined.
     /// @manualbind
     int ReleaseRef();
     /// Return reference count.
@@ -0,0 +1,150 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include <EASTL/algorithm.h>
+#include <EASTL/array.h>
+#include <EASTL/vector.h>
+
+#include <atomic>
+
+namespace Urho3D
+{
+
+/// Fixed-capacity lock-free queue with single producer thread and single consumer thread.
+template <class T, unsigned Capacity>
+class SingleProducerQueue
+{
+    static_assert(Capacity > 1, "Capacity must be greater than 1");
+
+public:
+    /// Push element. Return false if the queue is full. Should be called from producer thread only.
+    bool Push(const T& value)
+    {
+        const unsigned tail = tail_.load(std::memory_order_relaxed);
+        const unsigned nextTail = (tail + 1) % Capacity;
+        if (nextTail == head_.load(std::memory_order_acquire))
+            return false;
+
+        elements_[tail] = value;
+        tail_.store(nextTail, std::memory_order_release);
+        return true;
+    }
+
+    /// Pop element. Return false if the queue is empty. Should be called from consumer thread only.
+    bool Pop(T& value)
+    {
+        const unsigned head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+            return false;
+
+        value = elements_[head];
+        head_.store((head + 1) % Capacity, std::memory_order_release);
+        return true;
+    }
+
+    /// Return whether the queue is empty. The result may be outdated immediately.
+    bool IsEmpty() const { return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire); }
+
+private:
+    /// Elements. One element is always unused to distinguish full queue from empty one.
+    ea::array<T, Capacity> elements_{};
+    /// Index of the first element. Written by consumer.
+    std::atomic<unsigned> head_{};
+    /// Index past the last element. Written by producer.
+    std::atomic<unsigned> tail_{};
+};
+
+/// Lock-free ring buffer with single producer thread and single consumer thread. Elements are pushed and popped in bulk.
+template <class T>
+class SingleProducerRingBuffer
+{
+public:
+    /// Allocate storage and discard contents. Not thread-safe.
+    void Allocate(unsigned capacity)
+    {
+        elements_.resize(capacity + 1);
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+    }
+
+    /// Push up to count elements. Return number of pushed elements. Should be called from producer thread only.
+    unsigned Push(const T* values, unsigned count)
+    {
+        const unsigned tail = tail_.load(std::memory_order_relaxed);
+        const unsigned head = head_.load(std::memory_order_acquire);
+        count = ea::min(count, GetFreeSpace(head, tail));
+
+        const unsigned firstPart = ea::min(count, static_cast<unsigned>(elements_.size()) - tail);
+        ea::copy_n(values, firstPart, elements_.begin() + tail);
+        ea::copy_n(values + firstPart, count - firstPart, elements_.begin());
+
+        tail_.store((tail + count) % elements_.size(), std::memory_order_release);
+        return count;
+    }
+
+    /// Pop up to count elements. Return number of popped elements. Should be called from consumer thread only.
+    unsigned Pop(T* values, unsigned count)
+    {
+        const unsigned head = head_.load(std::memory_order_relaxed);
+        const unsigned tail = tail_.load(std::memory_order_acquire);
+        count = ea::min(count, GetSize(head, tail));
+
+        const unsigned firstPart = ea::min(count, static_cast<unsigned>(elements_.size()) - head);
+        ea::copy_n(elements_.begin() + head, firstPart, values);
+        ea::copy_n(elements_.begin(), count - firstPart, values + firstPart);
+
+        head_.store((head + count) % elements_.size(), std::memory_order_release);
+        return count;
+    }
+
+    /// Discard all elements. Should be called from consumer thread only.
+    void Clear() { head_.store(tail_.load(std::memory_order_acquire), std::memory_order_release); }
+
+    /// Return number of elements that can be popped. The result may be outdated immediately.
+    unsigned GetSize() const { return GetSize(head_.load(std::memory_order_acquire), tail_.load(std::memory_order_acquire)); }
+    /// Return number of elements that can be pushed. The result may be outdated immediately.
+    unsigned GetFreeSpace() const { return GetFreeSpace(head_.load(std::memory_order_acquire), tail_.load(std::memory_order_acquire)); }
+    /// Return capacity.
+    unsigned GetCapacity() const { return elements_.empty() ? 0 : elements_.size() - 1; }
+
+private:
+    unsigned GetSize(unsigned head, unsigned tail) const
+    {
+        return tail >= head ? tail - head : tail + elements_.size() - head;
+    }
+
+    unsigned GetFreeSpace(unsigned head, unsigned tail) const
+    {
+        return elements_.empty() ? 0 : elements_.size() - 1 - GetSize(head, tail);
+    }
+
+    /// Elements. One element is always unused to distinguish full buffer from empty one.
+    ea::vector<T> elements_;
+    /// Index of the first element. Written by consumer.
+    std::atomic<unsigned> head_{};
+    /// Index past the last element. Written by producer.
+    std::atomic<unsigned> tail_{};
+};
+
+}
@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Container/TaggedAllocator.h"
+#include "../Core/Profiler.h"
+
+#include <EASTL/array.h>
+
+#include <atomic>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+struct MemoryTagCounters
+{
+    std::atomic<long long> bytes_{};
+    std::atomic<long long> numAllocations_{};
+    std::atomic<unsigned long long> totalAllocations_{};
+};
+
+ea::array<MemoryTagCounters, static_cast<unsigned>(MemoryTag::Count)> memoryTagCounters;
+std::atomic<bool> memoryProfilingEnabled{};
+
+}
+
+void TrackAllocation(MemoryTag tag, void* ptr, size_t size)
+{
+    MemoryTagCounters& counters = memoryTagCounters[static_cast<unsigned>(tag)];
+    counters.bytes_.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    counters.numAllocations_.fetch_add(1, std::memory_order_relaxed);
+    counters.totalAllocations_.fetch_add(1, std::memory_order_relaxed);
+
+    if (memoryProfilingEnabled.load(std::memory_order_relaxed))
+        TracyAllocN(ptr, size, GetMemoryTagName(tag));
+}
+
+void TrackDeallocation(MemoryTag tag, void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    MemoryTagCounters& counters = memoryTagCounters[static_cast<unsigned>(tag)];
+    counters.bytes_.fetch_sub(static_cast<long long>(size), std::memory_order_relaxed);
+    counters.numAllocations_.fetch_sub(1, std::memory_order_relaxed);
+
+    if (memoryProfilingEnabled.load(std::memory_order_relaxed))
+        TracyFreeN(ptr, GetMemoryTagName(tag));
+}
+
+MemoryTagStats GetMemoryTagStats(MemoryTag tag)
+{
+    const MemoryTagCounters& counters = memoryTagCounters[static_cast<unsigned>(tag)];
+
+    MemoryTagStats stats;
+    stats.bytes_ = counters.bytes_.load(std::memory_order_relaxed);
+    stats.numAllocations_ = counters.numAllocations_.load(std::memory_order_relaxed);
+    stats.totalAllocations_ = counters.totalAllocations_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+const char* GetMemoryTagName(MemoryTag tag)
+{
+    switch (tag)
+    {
+    case MemoryTag::Scene: return "Scene";
+    case MemoryTag::Rendering: return "Rendering";
+    case MemoryTag::Physics: return "Physics";
+    case MemoryTag::Network: return "Network";
+    case MemoryTag::Other: return "Other";
+    default: return "Unknown";
+    }
+}
+
+void SetMemoryProfilingEnabled(bool enabled)
+{
+    memoryProfilingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+}
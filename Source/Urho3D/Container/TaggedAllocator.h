@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+
+#include <EASTL/allocator.h>
+#include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
+
+#include <cstddef>
+
+namespace Urho3D
+{
+
+/// Subsystem that owns tracked memory.
+enum class MemoryTag
+{
+    Scene,
+    Rendering,
+    Physics,
+    Network,
+    Other,
+
+    Count
+};
+
+/// Memory statistics of the tag.
+struct MemoryTagStats
+{
+    /// Number of bytes currently allocated.
+    long long bytes_{};
+    /// Number of allocations currently alive.
+    long long numAllocations_{};
+    /// Total number of allocations since the start of the application.
+    unsigned long long totalAllocations_{};
+};
+
+/// Register allocation of tracked memory. Thread-safe.
+URHO3D_API void TrackAllocation(MemoryTag tag, void* ptr, size_t size);
+/// Register deallocation of tracked memory. Thread-safe.
+URHO3D_API void TrackDeallocation(MemoryTag tag, void* ptr, size_t size);
+/// Return memory statistics of the tag. Thread-safe.
+URHO3D_API MemoryTagStats GetMemoryTagStats(MemoryTag tag);
+/// Return human-readable name of the tag.
+URHO3D_API const char* GetMemoryTagName(MemoryTag tag);
+/// Enable or disable reporting of tracked allocations to the profiler. Disabled by default.
+URHO3D_API void SetMemoryProfilingEnabled(bool enabled);
+
+/// EASTL allocator that allocates from default allocator and accounts memory to the tag.
+template <MemoryTag Tag>
+class TaggedAllocator
+{
+public:
+    /// Construct. Required by EASTL.
+    explicit TaggedAllocator(const char* /*name*/ = nullptr) {}
+
+    /// Allocate memory. Required by EASTL.
+    void* allocate(size_t n, int flags = 0)
+    {
+        void* ptr = EASTLAllocatorDefault()->allocate(n, flags);
+        TrackAllocation(Tag, ptr, n);
+        return ptr;
+    }
+
+    /// Allocate aligned memory. Required by EASTL.
+    void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0)
+    {
+        void* ptr = EASTLAllocatorDefault()->allocate(n, alignment, offset, flags);
+        TrackAllocation(Tag, ptr, n);
+        return ptr;
+    }
+
+    /// Deallocate memory. Required by EASTL.
+    void deallocate(void* p, size_t n)
+    {
+        TrackDeallocation(Tag, p, n);
+        EASTLAllocatorDefault()->deallocate(p, n);
+    }
+
+    /// Return name. Required by EASTL.
+    const char* get_name() const { return GetMemoryTagName(Tag); }
+    /// Set name. Required by EASTL.
+    void set_name(const char* /*name*/) {}
+
+    /// Compare allocators. All allocators with the same tag are interchangeable.
+    bool operator ==(const TaggedAllocator& rhs) const { return true; }
+    /// Compare allocators.
+    bool operator !=(const TaggedAllocator& rhs) const { return false; }
+};
+
+/// Vector with memory accounted to the tag.
+template <class T, MemoryTag Tag> using TaggedVector = ea::vector<T, TaggedAllocator<Tag>>;
+/// Hash map with memory accounted to the tag.
+template <class K, class V, MemoryTag Tag>
+using TaggedUnorderedMap = ea::unordered_map<K, V, ea::hash<K>, ea::equal_to<K>, TaggedAllocator<Tag>>;
+
+}
@@ -72,7 +72,9 @@ enum class AttributeScopeHint
     Scene,
 };
 
+class Deserializer;
 class Serializable;
+class Serializer;
 
 /// Abstract base class for invoking attribute accessors.
 class URHO3D_API AttributeAccessor : public RefCounted
@@ -84,6 +86,13 @@ public:
     virtual void Get(const Serializable* ptr, Variant& dest) const = 0;
     /// Set the attribute.
     virtual void Set(Serializable* ptr, const Variant& src) = 0;
+
+    /// Return whether the attribute can be written and read in binary form without Variant conversion.
+    virtual bool HasBinaryAccess() const { return false; }
+    /// Write the attribute in the same binary form as Variant data. Return true if successful.
+    virtual bool WriteBinary(const Serializable* ptr, Serializer& dest) const { return false; }
+    /// Read the attribute written by WriteBinary. Return true if successful.
+    virtual bool ReadBinary(Serializable* ptr, Deserializer& source) { return false; }
 };
 
 /// Description of an automatically serializable variable.
@@ -164,6 +164,7 @@ Context::~Context()
     RemoveSubsystem("Input");
     RemoveSubsystem("Renderer");
     RemoveSubsystem("ComputeDevice");
+    RemoveSubsystem("GPUProfiler");
     RemoveSubsystem("Graphics");
     RemoveSubsystem("StateManager");
 
@@ -67,6 +67,15 @@ private:
 };
 
 /// Urho3D execution context. Provides access to subsystems, object factories and attributes, and event receivers.
+///
+/// Thread safety:
+/// - Subsystems and reflections may be registered and removed only from main thread.
+///   They may be queried from any thread while nothing is registered or removed concurrently.
+/// - Events may be sent, subscribed and unsubscribed only from main thread.
+///   Scene::Update sends events and is called on main thread. Logic components of independent scenes
+///   may be updated concurrently on WorkQueue threads via Scene::UpdateLogicComponents.
+/// - Subsystems are not thread-safe unless explicitly stated otherwise.
+///   Loaded resources may be read concurrently as long as they are not modified or reloaded.
 class URHO3D_API Context : public RefCounted, public ObjectReflectionRegistry
 {
     friend class Object;
@@ -87,6 +96,7 @@ public:
     /// Remove a subsystem.
     void RemoveSubsystem(StringHash objectType);
     /// Return a preallocated map for event data. Used for optimization to avoid constant re-allocation of event data maps.
+    /// Should be called only from main thread.
     VariantMap& GetEventDataMap();
     /// Initialises the specified SDL systems, if not already. Returns true if successful. This call must be matched with ReleaseSDL() when SDL functions are no longer required, even if this call fails.
     bool RequireSDL(unsigned int sdlFlags);
@@ -100,7 +110,7 @@ public:
     /// Template version of removing a subsystem.
     template <class T> void RemoveSubsystem();
 
-    /// Return subsystem by type.
+    /// Return subsystem by type. Safe to call from any thread while no subsystem is registered or removed concurrently.
     Object* GetSubsystem(StringHash type) const;
 
     /// Return global variable based on key.
@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/InternedString.h"
+
+#include "../Core/Mutex.h"
+
+#include <EASTL/deque.h>
+#include <EASTL/unordered_map.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Global table of interned strings. Entries are stored in deque chunks and are never moved or freed.
+struct InternedStringTable
+{
+    Mutex mutex_;
+    ea::deque<InternedStringEntry> entries_;
+    ea::unordered_map<ea::string_view, const InternedStringEntry*> index_;
+};
+
+InternedStringTable& GetInternedStringTable()
+{
+    static InternedStringTable table;
+    return table;
+}
+
+}
+
+InternedString::InternedString(ea::string_view string)
+{
+    if (string.empty())
+        return;
+
+    InternedStringTable& table = GetInternedStringTable();
+    MutexLock lock(table.mutex_);
+
+    const auto iter = table.index_.find(string);
+    if (iter != table.index_.end())
+    {
+        entry_ = iter->second;
+        return;
+    }
+
+    table.entries_.emplace_back(string);
+    const InternedStringEntry& entry = table.entries_.back();
+    table.index_.emplace(ea::string_view{entry.string_}, &entry);
+    entry_ = &entry;
+}
+
+unsigned InternedString::GetNumInternedStrings()
+{
+    InternedStringTable& table = GetInternedStringTable();
+    MutexLock lock(table.mutex_);
+    return static_cast<unsigned>(table.entries_.size());
+}
+
+}
@@ -0,0 +1,77 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Container/Str.h"
+#include "../Math/StringHash.h"
+
+namespace Urho3D
+{
+
+/// Entry of global interned string table. Never destroyed or modified once created.
+struct InternedStringEntry
+{
+    /// Construct.
+    explicit InternedStringEntry(ea::string_view string) : string_(string), hash_(string) {}
+
+    /// String value.
+    const ea::string string_;
+    /// String hash.
+    const StringHash hash_;
+};
+
+/// Handle to immutable deduplicated string stored in global string table.
+/// Handles of equal strings point to the same entry, so comparison is pointer comparison.
+/// Interning is thread-safe. Reading interned string doesn't require any locks.
+class URHO3D_API InternedString
+{
+public:
+    /// Construct empty.
+    InternedString() = default;
+    /// Construct from string.
+    explicit InternedString(ea::string_view string);
+
+    /// Return string value. Reference is valid for the lifetime of the program.
+    const ea::string& GetString() const { return entry_ ? entry_->string_ : EMPTY_STRING; }
+    /// Return string hash.
+    StringHash GetHash() const { return entry_ ? entry_->hash_ : StringHash::Empty; }
+    /// Return whether the string is empty.
+    bool IsEmpty() const { return entry_ == nullptr; }
+    /// Return hash value for hash containers.
+    unsigned ToHash() const { return MakeHash(entry_); }
+
+    /// Test for equality.
+    bool operator ==(const InternedString& rhs) const { return entry_ == rhs.entry_; }
+    /// Test for inequality.
+    bool operator !=(const InternedString& rhs) const { return entry_ != rhs.entry_; }
+
+    /// Return number of unique non-empty strings in global string table.
+    static unsigned GetNumInternedStrings();
+
+private:
+    /// Entry in global string table. Null for empty string.
+    const InternedStringEntry* entry_{};
+};
+
+}
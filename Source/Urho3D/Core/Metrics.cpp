@@ -0,0 +1,279 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Core/Metrics.h"
+
+#include <cmath>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+void AtomicAdd(std::atomic<double>& value, double delta)
+{
+    double oldValue = value.load(std::memory_order_relaxed);
+    while (!value.compare_exchange_weak(oldValue, oldValue + delta, std::memory_order_relaxed))
+        ;
+}
+
+ea::string FormatMetricValue(double value)
+{
+    if (std::isinf(value))
+        return value > 0 ? "+Inf" : "-Inf";
+    if (std::isnan(value))
+        return "NaN";
+    return Format("{}", value);
+}
+
+ea::string EscapeHelp(const ea::string& help)
+{
+    ea::string result;
+    for (const char ch : help)
+    {
+        if (ch == '\\')
+            result += "\\\\";
+        else if (ch == '\n')
+            result += "\\n";
+        else
+            result += ch;
+    }
+    return result;
+}
+
+const char* GetMetricTypeName(MetricType type)
+{
+    switch (type)
+    {
+    case MetricType::Counter: return "counter";
+    case MetricType::Gauge: return "gauge";
+    case MetricType::Histogram: return "histogram";
+    default: return "untyped";
+    }
+}
+
+}
+
+void MetricGauge::Add(double delta)
+{
+    AtomicAdd(value_, delta);
+}
+
+MetricHistogram::MetricHistogram(const ea::vector<double>& bounds)
+    : bounds_(bounds)
+    , buckets_(new std::atomic<unsigned long long>[bounds.size() + 1])
+{
+    for (unsigned i = 0; i <= bounds_.size(); ++i)
+        buckets_[i].store(0, std::memory_order_relaxed);
+}
+
+void MetricHistogram::Observe(double value)
+{
+    const unsigned index = ea::upper_bound(bounds_.begin(), bounds_.end(), value, ea::less_equal<double>()) - bounds_.begin();
+    buckets_[index].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    AtomicAdd(sum_, value);
+}
+
+Metrics::Metrics(Context* context)
+    : Object(context)
+{
+}
+
+Metrics::~Metrics() = default;
+
+template <class T, class... Args>
+SharedPtr<T> Metrics::GetOrCreateMetric(MetricType type, const ea::string& name, const ea::string& help, const Args&... args)
+{
+    MutexLock lock(mutex_);
+
+    const auto iter = metrics_.find(name);
+    if (iter != metrics_.end())
+    {
+        if (iter->second.type_ != type)
+            return nullptr;
+        return SharedPtr<T>(static_cast<T*>(iter->second.metric_.Get()));
+    }
+
+    const auto metric = MakeShared<T>(args...);
+    MetricDesc& desc = metrics_[name];
+    desc.type_ = type;
+    desc.help_ = help;
+    desc.metric_ = metric;
+    return metric;
+}
+
+SharedPtr<MetricCounter> Metrics::GetCounter(const ea::string& name, const ea::string& help)
+{
+    return GetOrCreateMetric<MetricCounter>(MetricType::Counter, name, help);
+}
+
+SharedPtr<MetricGauge> Metrics::GetGauge(const ea::string& name, const ea::string& help)
+{
+    return GetOrCreateMetric<MetricGauge>(MetricType::Gauge, name, help);
+}
+
+SharedPtr<MetricHistogram> Metrics::GetHistogram(const ea::string& name, const ea::vector<double>& bounds, const ea::string& help)
+{
+    return GetOrCreateMetric<MetricHistogram>(MetricType::Histogram, name, help, bounds);
+}
+
+void Metrics::RemoveMetric(const ea::string& name)
+{
+    MutexLock lock(mutex_);
+    metrics_.erase(name);
+}
+
+StringVector Metrics::GetMetricNames() const
+{
+    MutexLock lock(mutex_);
+
+    StringVector result;
+    for (const auto& [name, desc] : metrics_)
+        result.push_back(name);
+    return result;
+}
+
+bool Metrics::HasMetric(const ea::string& name) const
+{
+    MutexLock lock(mutex_);
+    return metrics_.contains(name);
+}
+
+double Metrics::GetValue(const ea::string& name) const
+{
+    MutexLock lock(mutex_);
+
+    const auto iter = metrics_.find(name);
+    if (iter == metrics_.end())
+        return 0.0;
+
+    const MetricDesc& desc = iter->second;
+    switch (desc.type_)
+    {
+    case MetricType::Counter:
+        return static_cast<double>(static_cast<const MetricCounter*>(desc.metric_.Get())->GetValue());
+    case MetricType::Gauge:
+        return static_cast<const MetricGauge*>(desc.metric_.Get())->GetValue();
+    case MetricType::Histogram:
+        return static_cast<const MetricHistogram*>(desc.metric_.Get())->GetSum();
+    default:
+        return 0.0;
+    }
+}
+
+unsigned long long Metrics::GetHistogramCount(const ea::string& name) const
+{
+    MutexLock lock(mutex_);
+
+    const auto iter = metrics_.find(name);
+    if (iter == metrics_.end() || iter->second.type_ != MetricType::Histogram)
+        return 0;
+
+    return static_cast<const MetricHistogram*>(iter->second.metric_.Get())->GetCount();
+}
+
+ea::string Metrics::ExportPrometheus() const
+{
+    MutexLock lock(mutex_);
+
+    ea::string result;
+    for (const auto& [name, desc] : metrics_)
+    {
+        if (!desc.help_.empty())
+            result += Format("# HELP {} {}\n", name, EscapeHelp(desc.help_));
+        result += Format("# TYPE {} {}\n", name, GetMetricTypeName(desc.type_));
+
+        switch (desc.type_)
+        {
+        case MetricType::Counter:
+        {
+            const auto counter = static_cast<const MetricCounter*>(desc.metric_.Get());
+            result += Format("{} {}\n", name, counter->GetValue());
+            break;
+        }
+        case MetricType::Gauge:
+        {
+            const auto gauge = static_cast<const MetricGauge*>(desc.metric_.Get());
+            result += Format("{} {}\n", name, FormatMetricValue(gauge->GetValue()));
+            break;
+        }
+        case MetricType::Histogram:
+        {
+            // Buckets are cumulative in Prometheus format
+            const auto histogram = static_cast<const MetricHistogram*>(desc.metric_.Get());
+            const ea::vector<double>& bounds = histogram->GetBounds();
+            unsigned long long cumulativeCount = 0;
+            for (unsigned i = 0; i < bounds.size(); ++i)
+            {
+                cumulativeCount += histogram->GetBucketCount(i);
+                result += Format("{}_bucket{{le=\"{}\"}} {}\n", name, FormatMetricValue(bounds[i]), cumulativeCount);
+            }
+            cumulativeCount += histogram->GetBucketCount(bounds.size());
+            result += Format("{}_bucket{{le=\"+Inf\"}} {}\n", name, cumulativeCount);
+            result += Format("{}_sum {}\n", name, FormatMetricValue(histogram->GetSum()));
+            result += Format("{}_count {}\n", name, cumulativeCount);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return result;
+}
+
+SharedPtr<MetricCounter> GetMetricCounter(Context* context, const ea::string& name, const ea::string& help)
+{
+    auto metrics = context ? context->GetSubsystem<Metrics>() : nullptr;
+    SharedPtr<MetricCounter> counter = metrics ? metrics->GetCounter(name, help) : nullptr;
+    return counter ? counter : MakeShared<MetricCounter>();
+}
+
+SharedPtr<MetricGauge> GetMetricGauge(Context* context, const ea::string& name, const ea::string& help)
+{
+    auto metrics = context ? context->GetSubsystem<Metrics>() : nullptr;
+    SharedPtr<MetricGauge> gauge = metrics ? metrics->GetGauge(name, help) : nullptr;
+    return gauge ? gauge : MakeShared<MetricGauge>();
+}
+
+SharedPtr<MetricHistogram> GetMetricHistogram(Context* context, const ea::string& name,
+    const ea::vector<double>& bounds, const ea::string& help)
+{
+    auto metrics = context ? context->GetSubsystem<Metrics>() : nullptr;
+    SharedPtr<MetricHistogram> histogram = metrics ? metrics->GetHistogram(name, bounds, help) : nullptr;
+    return histogram ? histogram : MakeShared<MetricHistogram>(bounds);
+}
+
+const ea::vector<double>& GetDefaultTimingBounds()
+{
+    static const ea::vector<double> bounds{0.001, 0.002, 0.004, 0.008, 0.0167, 0.0333, 0.05, 0.1, 0.25, 1.0};
+    return bounds;
+}
+
+}
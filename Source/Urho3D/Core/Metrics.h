@@ -0,0 +1,176 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Core/Mutex.h"
+#include "../Core/Object.h"
+
+#include <EASTL/map.h>
+#include <EASTL/unique_ptr.h>
+
+#include <atomic>
+
+namespace Urho3D
+{
+
+/// Type of metric.
+enum class MetricType
+{
+    /// Monotonically increasing value.
+    Counter,
+    /// Value that can go up and down.
+    Gauge,
+    /// Distribution of observed values.
+    Histogram,
+};
+
+/// Monotonically increasing counter. Thread-safe and lock-free.
+class URHO3D_API MetricCounter : public RefCounted
+{
+public:
+    /// Increment counter.
+    void Increment(unsigned long long delta = 1) { value_.fetch_add(delta, std::memory_order_relaxed); }
+    /// Return current value.
+    unsigned long long GetValue() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    /// Current value.
+    std::atomic<unsigned long long> value_{};
+};
+
+/// Value that can go up and down, e.g. number of batches in the last frame. Thread-safe and lock-free.
+class URHO3D_API MetricGauge : public RefCounted
+{
+public:
+    /// Set value.
+    void Set(double value) { value_.store(value, std::memory_order_relaxed); }
+    /// Add delta to value.
+    void Add(double delta);
+    /// Return current value.
+    double GetValue() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    /// Current value.
+    std::atomic<double> value_{};
+};
+
+/// Distribution of observed values in fixed buckets, e.g. frame times. Thread-safe and lock-free.
+class URHO3D_API MetricHistogram : public RefCounted
+{
+public:
+    /// Construct with sorted upper bounds of buckets. Bucket for values above the last bound is added implicitly.
+    explicit MetricHistogram(const ea::vector<double>& bounds);
+
+    /// Add observed value.
+    void Observe(double value);
+
+    /// Return upper bounds of buckets, except the implicit last one.
+    const ea::vector<double>& GetBounds() const { return bounds_; }
+    /// Return number of observed values that fell into bucket. Bucket with index equal to number of bounds is the implicit one.
+    unsigned long long GetBucketCount(unsigned index) const { return buckets_[index].load(std::memory_order_relaxed); }
+    /// Return total number of observed values.
+    unsigned long long GetCount() const { return count_.load(std::memory_order_relaxed); }
+    /// Return sum of observed values.
+    double GetSum() const { return sum_.load(std::memory_order_relaxed); }
+
+private:
+    /// Upper bounds of buckets.
+    const ea::vector<double> bounds_;
+    /// Number of observed values per bucket.
+    ea::unique_ptr<std::atomic<unsigned long long>[]> buckets_;
+    /// Total number of observed values.
+    std::atomic<unsigned long long> count_{};
+    /// Sum of observed values.
+    std::atomic<double> sum_{};
+};
+
+/// Registry of named metrics collected by engine subsystems and user code.
+/// Metric names should follow Prometheus conventions, e.g. "urho3d_resource_loads_total".
+/// Metric objects are obtained once and updated directly, updates don't touch the registry.
+class URHO3D_API Metrics : public Object
+{
+    URHO3D_OBJECT(Metrics, Object);
+
+public:
+    /// Construct.
+    explicit Metrics(Context* context);
+    /// Destruct.
+    ~Metrics() override;
+
+    /// Return existing or create new counter. Return nullptr if there's metric of other type with the same name.
+    SharedPtr<MetricCounter> GetCounter(const ea::string& name, const ea::string& help = EMPTY_STRING);
+    /// Return existing or create new gauge. Return nullptr if there's metric of other type with the same name.
+    SharedPtr<MetricGauge> GetGauge(const ea::string& name, const ea::string& help = EMPTY_STRING);
+    /// Return existing or create new histogram. Return nullptr if there's metric of other type with the same name.
+    SharedPtr<MetricHistogram> GetHistogram(const ea::string& name, const ea::vector<double>& bounds, const ea::string& help = EMPTY_STRING);
+    /// Remove metric from registry. Objects owned by the callers stay valid.
+    void RemoveMetric(const ea::string& name);
+
+    /// Return names of all metrics in alphabetical order.
+    StringVector GetMetricNames() const;
+    /// Return whether the metric exists.
+    bool HasMetric(const ea::string& name) const;
+    /// Return value of counter or gauge, or sum of histogram values. Return 0 if the metric doesn't exist.
+    double GetValue(const ea::string& name) const;
+    /// Return number of values observed by histogram. Return 0 if the histogram doesn't exist.
+    unsigned long long GetHistogramCount(const ea::string& name) const;
+
+    /// Return all metrics formatted as Prometheus text exposition format.
+    ea::string ExportPrometheus() const;
+
+private:
+    /// Registered metric.
+    struct MetricDesc
+    {
+        /// Type of metric.
+        MetricType type_{};
+        /// Description.
+        ea::string help_;
+        /// Metric object.
+        SharedPtr<RefCounted> metric_;
+    };
+
+    /// Find or create metric.
+    template <class T, class... Args>
+    SharedPtr<T> GetOrCreateMetric(MetricType type, const ea::string& name, const ea::string& help, const Args&... args);
+
+    /// Registered metrics sorted by name.
+    ea::map<ea::string, MetricDesc> metrics_;
+    /// Mutex that protects the registry.
+    mutable Mutex mutex_;
+};
+
+/// Return existing or create new counter in Metrics subsystem.
+/// If the subsystem doesn't exist, return new standalone counter so the callers never need to check for null.
+URHO3D_API SharedPtr<MetricCounter> GetMetricCounter(Context* context, const ea::string& name, const ea::string& help = EMPTY_STRING);
+/// Return existing or create new gauge in Metrics subsystem, or standalone gauge if the subsystem doesn't exist.
+URHO3D_API SharedPtr<MetricGauge> GetMetricGauge(Context* context, const ea::string& name, const ea::string& help = EMPTY_STRING);
+/// Return existing or create new histogram in Metrics subsystem, or standalone histogram if the subsystem doesn't exist.
+URHO3D_API SharedPtr<MetricHistogram> GetMetricHistogram(Context* context, const ea::string& name,
+    const ea::vector<double>& bounds, const ea::string& help = EMPTY_STRING);
+
+/// Default histogram bounds for frame and subsystem timings, in seconds.
+URHO3D_API const ea::vector<double>& GetDefaultTimingBounds();
+
+}
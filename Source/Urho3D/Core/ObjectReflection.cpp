@@ -44,11 +44,18 @@ unsigned FindIndexInCategory(const ea::vector<StringHash>& objectsInCategory, St
     return objectsInCategory.index_of(typeNameHash);
 }
 
+unsigned GetNextAttributesRevision()
+{
+    static std::atomic<unsigned> revision{};
+    return ++revision;
+}
+
 }
 
 ObjectReflection::ObjectReflection(Context* context, const TypeInfo* typeInfo)
     : context_(context)
     , typeInfo_(typeInfo)
+    , attributesRevision_(GetNextAttributesRevision())
 {
 }
 
@@ -56,6 +63,7 @@ ObjectReflection::ObjectReflection(Context* context, ea::unique_ptr<TypeInfo> ty
     : context_(context)
     , typeInfo_(typeInfo.get())
     , ownedTypeInfo_(ea::move(typeInfo))
+    , attributesRevision_(GetNextAttributesRevision())
 {
 }
 
@@ -85,6 +93,7 @@ AttributeHandle ObjectReflection::AddAttribute(const AttributeInfo& attr)
     attributes_.push_back(attr);
     attributeNames_.push_back(attr.nameHash_);
     handle.attributeInfo_ = &attributes_.back();
+    attributesRevision_ = GetNextAttributesRevision();
     return handle;
 
 }
@@ -100,12 +109,14 @@ void ObjectReflection::RemoveAttribute(StringHash nameHash)
 
     attributes_.erase_at(index);
     attributeNames_.erase_at(index);
+    attributesRevision_ = GetNextAttributesRevision();
 }
 
 void ObjectReflection::RemoveAllAttributes()
 {
     attributes_.clear();
     attributeNames_.clear();
+    attributesRevision_ = GetNextAttributesRevision();
 }
 
 void ObjectReflection::CopyAttributesFrom(const ObjectReflection* other)
@@ -125,6 +136,7 @@ void ObjectReflection::CopyAttributesFrom(const ObjectReflection* other)
 
     attributes_.append(other->attributes_);
     attributeNames_.append(other->attributeNames_);
+    attributesRevision_ = GetNextAttributesRevision();
 }
 
 void ObjectReflection::UpdateAttributeDefaultValue(StringHash nameHash, const Variant& defaultValue)
@@ -87,6 +87,8 @@ public:
     const AttributeInfo& GetAttributeByIndex(unsigned index) const { return attributes_[index]; }
     const ea::vector<AttributeInfo>& GetAttributes() const { return attributes_; }
     unsigned GetNumAttributes() const { return attributes_.size(); }
+    /// Return revision of attribute list. Globally unique, changes whenever attributes are added or removed.
+    unsigned GetAttributesRevision() const { return attributesRevision_; }
     /// @}
 
     /// @name Metadata
@@ -121,6 +123,8 @@ private:
     /// Attributes of the Serializable.
     ea::vector<AttributeInfo> attributes_;
     ea::vector<StringHash> attributeNames_;
+    /// Revision of attribute list.
+    unsigned attributesRevision_{};
 };
 
 /// Registry of Object reflections.
@@ -48,6 +48,7 @@ extern "C" unsigned SDL_TVOS_GetActiveProcessorCount();
 #include <rpc.h>
 #include <io.h>
 #include <direct.h>
+#include <psapi.h>
 #define getcwd _getcwd
 #define popen _popen
 #define pclose _pclose
@@ -60,12 +61,14 @@ extern "C" unsigned SDL_TVOS_GetActiveProcessorCount();
 #include <Rpc.h>
 #endif
 #elif defined(__APPLE__)
+#include <sys/resource.h>
 #include <sys/sysctl.h>
 #include <SystemConfiguration/SystemConfiguration.h> // For the detection functions inside GetLoginName().
 #elif defined(__ANDROID__)
 #include <jni.h>
 #else
 #include <pwd.h>
+#include <sys/resource.h>
 #include <sys/sysinfo.h>
 #include <sys/utsname.h>
 #include <uuid/uuid.h>
@@ -175,6 +178,80 @@ static void GetCPUData(struct CpuCoreCount* data)
     }
 }
 
+/// Parse CPU list in format "0-3,8,10-11" into mask.
+static unsigned long long ReadCPUListMask(const char* fileName)
+{
+    FILE* fp = fopen(fileName, "r");
+    if (!fp)
+        return 0;
+
+    char buffer[256]{};
+    const bool success = fgets(buffer, sizeof(buffer), fp) != nullptr;
+    fclose(fp);
+    if (!success)
+        return 0;
+
+    unsigned long long mask = 0;
+    const char* ptr = buffer;
+    while (*ptr)
+    {
+        char* end = nullptr;
+        const unsigned long first = strtoul(ptr, &end, 10);
+        if (end == ptr)
+            break;
+
+        unsigned long last = first;
+        ptr = end;
+        if (*ptr == '-')
+        {
+            last = strtoul(ptr + 1, &end, 10);
+            ptr = end;
+        }
+
+        for (unsigned long i = first; i <= last && i < 64; ++i)
+            mask |= 1ull << i;
+
+        if (*ptr != ',')
+            break;
+        ++ptr;
+    }
+    return mask;
+}
+
+static bool GetHybridCPUCoreMasksImpl(unsigned long long& performanceCores, unsigned long long& efficiencyCores)
+{
+    // Intel hybrid CPUs expose separate PMUs for core types
+    performanceCores = ReadCPUListMask("/sys/devices/cpu_core/cpus");
+    efficiencyCores = ReadCPUListMask("/sys/devices/cpu_atom/cpus");
+    if (performanceCores && efficiencyCores)
+        return true;
+
+    // ARM big.LITTLE reports relative capacity of each core, cores with the lowest capacity are efficiency cores
+    const unsigned numCPUs = Min(GetNumLogicalCPUs(), 64u);
+    ea::vector<unsigned> capacities(numCPUs);
+    for (unsigned i = 0; i < numCPUs; ++i)
+    {
+        FILE* fp = fopen(Format("/sys/devices/system/cpu/cpu{}/cpu_capacity", i).c_str(), "r");
+        if (!fp)
+            return false;
+
+        const int res = fscanf(fp, "%u", &capacities[i]);               // NOLINT(cert-err34-c)
+        fclose(fp);
+        if (res != 1)
+            return false;
+    }
+
+    if (capacities.empty())
+        return false;
+
+    const unsigned minCapacity = *ea::min_element(capacities.begin(), capacities.end());
+    performanceCores = 0;
+    efficiencyCores = 0;
+    for (unsigned i = 0; i < numCPUs; ++i)
+        (capacities[i] == minCapacity ? efficiencyCores : performanceCores) |= 1ull << i;
+    return performanceCores && efficiencyCores;
+}
+
 #elif !defined(__EMSCRIPTEN__) && !defined(TVOS) && !defined(UWP)
 static void GetCPUData(struct cpu_id_t* data)
 {
@@ -554,6 +631,49 @@ unsigned GetNumLogicalCPUs()
 #endif
 }
 
+bool GetHybridCPUCoreMasks(unsigned long long& performanceCores, unsigned long long& efficiencyCores)
+{
+    performanceCores = 0;
+    efficiencyCores = 0;
+
+#if defined(_WIN32) && !defined(UWP)
+    DWORD size = 0;
+    GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &size);
+    if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+        return false;
+
+    ea::vector<unsigned char> buffer(size);
+    auto info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data());
+    if (!GetLogicalProcessorInformationEx(RelationProcessorCore, info, &size))
+        return false;
+
+    // Higher efficiency class means higher performance, all cores have class 0 on non-hybrid CPUs
+    BYTE maxEfficiencyClass = 0;
+    for (DWORD offset = 0; offset < size;)
+    {
+        const auto& core = *reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+        maxEfficiencyClass = ea::max(maxEfficiencyClass, core.Processor.EfficiencyClass);
+        offset += core.Size;
+    }
+
+    for (DWORD offset = 0; offset < size;)
+    {
+        const auto& core = *reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+        if (core.Processor.GroupMask[0].Group == 0)
+        {
+            const auto mask = static_cast<unsigned long long>(core.Processor.GroupMask[0].Mask);
+            (core.Processor.EfficiencyClass == maxEfficiencyClass ? performanceCores : efficiencyCores) |= mask;
+        }
+        offset += core.Size;
+    }
+    return performanceCores && efficiencyCores;
+#elif defined(__linux__)
+    return GetHybridCPUCoreMasksImpl(performanceCores, efficiencyCores);
+#else
+    return false;
+#endif
+}
+
 void SetMiniDumpDir(const ea::string& pathName)
 {
     miniDumpDir = AddTrailingSlash(pathName);
@@ -600,6 +720,24 @@ unsigned long long GetTotalMemory()
     return 0ull;
 }
 
+unsigned long long GetPeakMemoryUsage()
+{
+#if defined(_WIN32) && !defined(UWP)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize;
+#elif defined(__linux__) && !defined(__ANDROID__)
+    struct rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+        return static_cast<unsigned long long>(usage.ru_maxrss) * 1024ull;
+#elif defined(__APPLE__)
+    struct rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+        return static_cast<unsigned long long>(usage.ru_maxrss);
+#endif
+    return 0ull;
+}
+
 ea::string GetLoginName()
 {
 #if defined(__linux__) && !defined(__ANDROID__)
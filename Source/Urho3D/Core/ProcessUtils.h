@@ -95,12 +95,17 @@ URHO3D_API ea::string GetPlatformName();
 URHO3D_API unsigned GetNumPhysicalCPUs();
 /// Return the number of logical CPUs (different from physical if hyperthreading is used).
 URHO3D_API unsigned GetNumLogicalCPUs();
+/// Return masks of logical CPUs on hybrid CPUs with performance and efficiency cores.
+/// Return false if the CPU is not hybrid or core types can't be detected. Only the first 64 logical CPUs are reported.
+URHO3D_API bool GetHybridCPUCoreMasks(unsigned long long& performanceCores, unsigned long long& efficiencyCores);
 /// Set minidump write location as an absolute path. If empty, uses default (UserProfile/AppData/Roaming/urho3D/crashdumps) Minidumps are only supported on MSVC compiler.
 URHO3D_API void SetMiniDumpDir(const ea::string& pathName);
 /// Return minidump write location.
 URHO3D_API ea::string GetMiniDumpDir();
 /// Return the total amount of usable memory in bytes.
 URHO3D_API unsigned long long GetTotalMemory();
+/// Return peak amount of physical memory used by the process in bytes, or 0 if not supported.
+URHO3D_API unsigned long long GetPeakMemoryUsage();
 /// Return the name of the currently logged in user, or (?) if not identified.
 URHO3D_API ea::string GetLoginName();
 /// Return the name of the running machine.
@@ -29,6 +29,7 @@
 #include <windows.h>
 #else
 #include <pthread.h>
+#include <sched.h>
 #endif
 #include <SDL_hints.h>
 #if defined(__ANDROID_API__) && __ANDROID_API__ < 26
@@ -155,6 +156,8 @@ bool Thread::Run()
     pthread_create((pthread_t*)&handle_, &type, ThreadFunctionStatic, this);
 
 #endif
+    if (handle_ && affinity_)
+        SetAffinity(affinity_);
     return handle_ != nullptr;
 #else
     return false;
@@ -195,6 +198,39 @@ void Thread::SetPriority(int priority)
 #endif // URHO3D_THREADING
 }
 
+void Thread::SetAffinity(unsigned long long mask)
+{
+    affinity_ = mask;
+
+#ifdef URHO3D_THREADING
+    if (!handle_)
+        return;
+
+#if defined(_WIN32) && !defined(UWP)
+    // Zero mask is invalid, allow all CPUs of the process instead
+    DWORD_PTR processMask{};
+    DWORD_PTR systemMask{};
+    if (!mask && GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask))
+        mask = processMask;
+    if (mask)
+        SetThreadAffinityMask((HANDLE)handle_, static_cast<DWORD_PTR>(mask));
+#elif defined(__linux__) && !defined(__EMSCRIPTEN__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (unsigned i = 0; i < CPU_SETSIZE; ++i)
+    {
+        if (!mask || (i < 64 && (mask & (1ull << i))))
+            CPU_SET(i, &cpuSet);
+    }
+#if defined(__ANDROID__)
+    sched_setaffinity(pthread_gettid_np((pthread_t)handle_), sizeof(cpuSet), &cpuSet);
+#else
+    pthread_setaffinity_np((pthread_t)handle_, sizeof(cpuSet), &cpuSet);
+#endif
+#endif
+#endif // URHO3D_THREADING
+}
+
 void Thread::SetMainThread()
 {
     mainThreadID = GetCurrentThreadID();
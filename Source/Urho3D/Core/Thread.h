@@ -54,6 +54,9 @@ public:
     void Stop();
     /// Set thread priority. The thread must have been started first.
     void SetPriority(int priority);
+    /// Set mask of logical CPUs the thread may run on. Zero mask allows any CPU.
+    /// May be called before or after Run(). Not supported on all platforms.
+    void SetAffinity(unsigned long long mask);
 
     /// Return whether thread exists.
     bool IsStarted() const { return handle_ != nullptr; }
@@ -77,6 +80,8 @@ protected:
 #endif
     /// Name of the thread. It will be propagated to underlying OS thread if possible.
     ea::string name_{};
+    /// Mask of logical CPUs the thread may run on.
+    unsigned long long affinity_{};
     /// Thread handle.
     void* handle_;
     /// Running flag.
@@ -46,8 +46,12 @@ public:
     bool IsInvalidated() const { return dirty_.load(std::memory_order_acquire); }
 
     /// Restore cached object. This call may be ignored if cache is already restored.
+    /// Lock is taken only while the cache is dirty, so readers of restored cache never spin.
     void Restore(const T& object)
     {
+        if (!dirty_.load(std::memory_order_acquire))
+            return;
+
         MutexLock<SpinLockMutex> lock(mutex_);
         if (dirty_.load(std::memory_order_acquire))
         {
@@ -124,14 +124,6 @@ Variant& Variant::operator =(const Variant& rhs)
         value_.weakPtr_ = rhs.value_.weakPtr_;
         break;
 
-    case VAR_MATRIX3:
-        *value_.matrix3_ = *rhs.value_.matrix3_;
-        break;
-
-    case VAR_MATRIX3X4:
-        *value_.matrix3x4_ = *rhs.value_.matrix3x4_;
-        break;
-
     case VAR_MATRIX4:
         *value_.matrix4_ = *rhs.value_.matrix4_;
         break;
@@ -284,10 +276,10 @@ bool Variant::operator ==(const Variant& rhs) const
         return value_.intVector3_ == rhs.value_.intVector3_;
 
     case VAR_MATRIX3:
-        return *value_.matrix3_ == *rhs.value_.matrix3_;
+        return value_.matrix3_ == rhs.value_.matrix3_;
 
     case VAR_MATRIX3X4:
-        return *value_.matrix3x4_ == *rhs.value_.matrix3x4_;
+        return value_.matrix3x4_ == rhs.value_.matrix3x4_;
 
     case VAR_MATRIX4:
         return *value_.matrix4_ == *rhs.value_.matrix4_;
@@ -693,10 +685,10 @@ ea::string Variant::ToString() const
         return value_.intVector3_.ToString();
 
     case VAR_MATRIX3:
-        return value_.matrix3_->ToString();
+        return value_.matrix3_.ToString();
 
     case VAR_MATRIX3X4:
-        return value_.matrix3x4_->ToString();
+        return value_.matrix3x4_.ToString();
 
     case VAR_MATRIX4:
         return value_.matrix4_->ToString();
@@ -795,10 +787,10 @@ bool Variant::IsZero() const
         return value_.weakPtr_ == nullptr;
 
     case VAR_MATRIX3:
-        return *value_.matrix3_ == Matrix3::IDENTITY;
+        return value_.matrix3_ == Matrix3::IDENTITY;
 
     case VAR_MATRIX3X4:
-        return *value_.matrix3x4_ == Matrix3x4::IDENTITY;
+        return value_.matrix3x4_ == Matrix3x4::IDENTITY;
 
     case VAR_MATRIX4:
         return *value_.matrix4_ == Matrix4::IDENTITY;
@@ -862,14 +854,6 @@ void Variant::SetType(VariantType newType)
         value_.weakPtr_.~WeakPtr<RefCounted>();
         break;
 
-    case VAR_MATRIX3:
-        delete value_.matrix3_;
-        break;
-
-    case VAR_MATRIX3X4:
-        delete value_.matrix3x4_;
-        break;
-
     case VAR_MATRIX4:
         delete value_.matrix4_;
         break;
@@ -927,11 +911,11 @@ void Variant::SetType(VariantType newType)
         break;
 
     case VAR_MATRIX3:
-        value_.matrix3_ = new Matrix3();
+        new(&value_.matrix3_) Matrix3();
         break;
 
     case VAR_MATRIX3X4:
-        value_.matrix3x4_ = new Matrix3x4();
+        new(&value_.matrix3x4_) Matrix3x4();
         break;
 
     case VAR_MATRIX4:
@@ -419,13 +419,14 @@ private:
     T value_;
 };
 
-/// Size of variant value. 16 bytes on 32-bit platform, 32 bytes on 64-bit platform.
-static const unsigned VARIANT_VALUE_SIZE = sizeof(void*) * 4;
+/// Size of variant value. Large enough to store Matrix3x4 and four pointers inline, i.e. 48 bytes on both 32-bit and 64-bit platform.
+static const unsigned VARIANT_VALUE_SIZE = sizeof(Matrix3x4) > sizeof(void*) * 4 ? sizeof(Matrix3x4) : sizeof(void*) * 4;
 
 /// Checks whether the custom variant type could be stored on stack.
 template <class T> constexpr bool IsCustomTypeOnStack() { return sizeof(CustomVariantValueImpl<T>) <= VARIANT_VALUE_SIZE; }
 
 /// Union for the possible variant values. Objects exceeding the VARIANT_VALUE_SIZE are allocated on the heap.
+/// Short strings are stored inline by ea::string small string optimization.
 union VariantValue
 {
     unsigned char storage_[VARIANT_VALUE_SIZE];
@@ -443,8 +444,8 @@ union VariantValue
     IntVector2 intVector2_;
     IntVector3 intVector3_;
     IntRect intRect_;
-    Matrix3* matrix3_;
-    Matrix3x4* matrix3x4_;
+    Matrix3 matrix3_;
+    Matrix3x4 matrix3x4_;
     Matrix4* matrix4_;
     Quaternion quaternion_;
     Color color_;
@@ -471,7 +472,7 @@ union VariantValue
     const CustomVariantValue& AsCustomValue() const { return *reinterpret_cast<const CustomVariantValue*>(&storage_[0]); }
 };
 
-// TODO: static_assert(sizeof(VariantValue) == VARIANT_VALUE_SIZE, "Unexpected size of VariantValue");
+static_assert(sizeof(VariantValue) == VARIANT_VALUE_SIZE, "Unexpected size of VariantValue");
 static_assert(sizeof(CustomVariantValueImpl<SharedPtr<RefCounted>>) <= VARIANT_VALUE_SIZE, "SharedPtr<> does not fit into variant.");
 
 /// Variable that supports a fixed set of types.
@@ -959,7 +960,7 @@ public:
     Variant& operator =(const Matrix3& rhs)
     {
         SetType(VAR_MATRIX3);
-        *value_.matrix3_ = rhs;
+        value_.matrix3_ = rhs;
         return *this;
     }
 
@@ -967,7 +968,7 @@ public:
     Variant& operator =(const Matrix3x4& rhs)
     {
         SetType(VAR_MATRIX3X4);
-        *value_.matrix3x4_ = rhs;
+        value_.matrix3x4_ = rhs;
         return *this;
     }
 
@@ -1137,13 +1138,13 @@ public:
     /// Test for equality with a Matrix3. To return true, both the type and value must match.
     bool operator ==(const Matrix3& rhs) const
     {
-        return type_ == VAR_MATRIX3 ? *value_.matrix3_ == rhs : false;
+        return type_ == VAR_MATRIX3 ? value_.matrix3_ == rhs : false;
     }
 
     /// Test for equality with a Matrix3x4. To return true, both the type and value must match.
     bool operator ==(const Matrix3x4& rhs) const
     {
-        return type_ == VAR_MATRIX3X4 ? *value_.matrix3x4_ == rhs : false;
+        return type_ == VAR_MATRIX3X4 ? value_.matrix3x4_ == rhs : false;
     }
 
     /// Test for equality with a Matrix4. To return true, both the type and value must match.
@@ -1481,13 +1482,13 @@ public:
     /// Return a Matrix3 or identity on type mismatch.
     const Matrix3& GetMatrix3() const
     {
-        return type_ == VAR_MATRIX3 ? *value_.matrix3_ : Matrix3::IDENTITY;
+        return type_ == VAR_MATRIX3 ? value_.matrix3_ : Matrix3::IDENTITY;
     }
 
     /// Return a Matrix3x4 or identity on type mismatch.
     const Matrix3x4& GetMatrix3x4() const
     {
-        return type_ == VAR_MATRIX3X4 ? *value_.matrix3x4_ : Matrix3x4::IDENTITY;
+        return type_ == VAR_MATRIX3X4 ? value_.matrix3x4_ : Matrix3x4::IDENTITY;
     }
 
     /// Return a Matrix4 or identity on type mismatch.
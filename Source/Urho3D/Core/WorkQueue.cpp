@@ -36,6 +36,8 @@ namespace Urho3D
 /// Thread index.
 static thread_local unsigned currentThreadIndex = M_MAX_UNSIGNED;
 static unsigned maxThreadIndex = 1;
+/// Capacity of the queue for tasks posted outside of worker threads.
+static const unsigned maxSharedTasks = 1024;
 
 /// Worker thread managed by the work queue.
 class WorkerThread : public Thread, public RefCounted
@@ -81,6 +83,9 @@ WorkQueue::WorkQueue(Context* context) :
     currentThreadIndex = 0;
     maxThreadIndex = 1;
     mainThreadTasks_.Clear();
+    taskDeques_.push_back(ea::make_unique<TaskDeque>());
+    sharedTasks_.Allocate(maxSharedTasks);
+    frameAllocators_.push_back(ea::make_unique<FrameAllocator>());
     SubscribeToEvent(E_BEGINFRAME, URHO3D_HANDLER(WorkQueue, HandleBeginFrame));
 }
 
@@ -106,10 +111,16 @@ void WorkQueue::CreateThreads(unsigned numThreads)
     Pause();
 
     maxThreadIndex = numThreads + 1;
+    while (taskDeques_.size() < maxThreadIndex)
+        taskDeques_.push_back(ea::make_unique<TaskDeque>());
+    while (frameAllocators_.size() < maxThreadIndex)
+        frameAllocators_.push_back(ea::make_unique<FrameAllocator>());
+
     for (unsigned i = 0; i < numThreads; ++i)
     {
         SharedPtr<WorkerThread> thread(new WorkerThread(this, i + 1));
         thread->SetName(Format("Worker {}", i + 1));
+        thread->SetAffinity(threadAffinity_);
         thread->Run();
         threads_.push_back(thread);
     }
@@ -119,6 +130,13 @@ void WorkQueue::CreateThreads(unsigned numThreads)
 #endif
 }
 
+void WorkQueue::SetThreadAffinity(unsigned long long mask)
+{
+    threadAffinity_ = mask;
+    for (WorkerThread* thread : threads_)
+        thread->SetAffinity(mask);
+}
+
 void WorkQueue::CallFromMainThread(WorkFunction workFunction)
 {
     if (GetThreadIndex() == 0)
@@ -205,6 +223,183 @@ SharedPtr<WorkItem> WorkQueue::AddWorkItem(ea::function<void(unsigned threadInde
     return item;
 }
 
+SharedPtr<WorkTask> WorkQueue::PostTask(WorkFunction function, std::initializer_list<WorkTask*> dependencies)
+{
+    SharedPtr<WorkTask> task = CreateTask(ea::move(function));
+    for (WorkTask* dependency : dependencies)
+    {
+        if (dependency)
+            AddTaskDependency(task, dependency);
+    }
+    SubmitTask(task);
+    return task;
+}
+
+SharedPtr<WorkTask> WorkQueue::PostTask(WorkFunction function, ea::span<const SharedPtr<WorkTask>> dependencies)
+{
+    SharedPtr<WorkTask> task = CreateTask(ea::move(function));
+    for (const SharedPtr<WorkTask>& dependency : dependencies)
+    {
+        if (dependency)
+            AddTaskDependency(task, dependency);
+    }
+    SubmitTask(task);
+    return task;
+}
+
+void WorkQueue::WaitForTask(WorkTask* task)
+{
+    if (!task)
+        return;
+
+    const unsigned threadIndex = GetThreadIndex();
+    if (threadIndex == 0)
+        Resume();
+
+    while (!task->IsCompleted())
+    {
+        if (!TryProcessTask(threadIndex))
+            std::this_thread::yield();
+    }
+}
+
+void WorkQueue::WaitForTasks(ea::span<const SharedPtr<WorkTask>> tasks)
+{
+    for (const SharedPtr<WorkTask>& task : tasks)
+        WaitForTask(task);
+}
+
+SharedPtr<WorkTask> WorkQueue::CreateTask(WorkFunction function)
+{
+    auto task = MakeShared<WorkTask>();
+    task->function_ = ea::move(function);
+    numPendingTasks_.fetch_add(1, std::memory_order_relaxed);
+    return task;
+}
+
+void WorkQueue::AddTaskDependency(WorkTask* task, WorkTask* dependency)
+{
+    MutexLock lock(dependency->continuationsMutex_);
+    if (dependency->IsCompleted())
+        return;
+
+    task->numDependencies_.fetch_add(1, std::memory_order_relaxed);
+    dependency->continuations_.emplace_back(task);
+}
+
+void WorkQueue::SubmitTask(SharedPtr<WorkTask> task)
+{
+    // Release the extra dependency held during submission
+    if (task->numDependencies_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        ScheduleTask(ea::move(task));
+}
+
+void WorkQueue::ScheduleTask(SharedPtr<WorkTask> task)
+{
+    const unsigned threadIndex = GetThreadIndex();
+
+    // Tasks posted outside of worker threads are taken by all workers at once, so don't make them contend for one lock
+    const bool isWorkerThread = threadIndex != 0 && threadIndex < taskDeques_.size();
+    if (!isWorkerThread && sharedTasks_.Push(task))
+    {
+        if (threadIndex == 0)
+            Resume();
+        return;
+    }
+
+    TaskDeque& taskDeque = *taskDeques_[GetTaskDequeIndex(threadIndex)];
+    {
+        MutexLock lock(taskDeque.mutex_);
+        taskDeque.tasks_.push_back(ea::move(task));
+        taskDeque.numTasks_.fetch_add(1, std::memory_order_release);
+    }
+
+    // Make sure that worker threads can pick up the task
+    if (threadIndex == 0)
+        Resume();
+}
+
+void WorkQueue::ExecuteTask(WorkTask* task, unsigned threadIndex)
+{
+    task->function_(threadIndex);
+    task->function_ = nullptr;
+
+    ea::vector<SharedPtr<WorkTask>> continuations;
+    {
+        MutexLock lock(task->continuationsMutex_);
+        task->completed_.store(true, std::memory_order_release);
+        continuations.swap(task->continuations_);
+    }
+
+    for (SharedPtr<WorkTask>& continuation : continuations)
+    {
+        if (continuation->numDependencies_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            ScheduleTask(ea::move(continuation));
+    }
+
+    // Continuations are already counted as pending, so the counter never drops to zero while graph is running
+    numPendingTasks_.fetch_sub(1, std::memory_order_release);
+}
+
+SharedPtr<WorkTask> WorkQueue::TryTakeTask(unsigned threadIndex)
+{
+    const unsigned numDeques = taskDeques_.size();
+    const unsigned ownIndex = GetTaskDequeIndex(threadIndex);
+
+    // Take the most recent task from own deque first, it is likely to be hot in cache
+    {
+        TaskDeque& taskDeque = *taskDeques_[ownIndex];
+        if (taskDeque.numTasks_.load(std::memory_order_acquire) > 0)
+        {
+            MutexLock lock(taskDeque.mutex_);
+            if (!taskDeque.tasks_.empty())
+            {
+                SharedPtr<WorkTask> task = ea::move(taskDeque.tasks_.back());
+                taskDeque.tasks_.pop_back();
+                taskDeque.numTasks_.fetch_sub(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+    }
+
+    // Take the task posted outside of worker threads
+    SharedPtr<WorkTask> sharedTask;
+    if (sharedTasks_.Pop(sharedTask))
+        return sharedTask;
+
+    // Steal the oldest task from other threads
+    for (unsigned i = 1; i < numDeques; ++i)
+    {
+        TaskDeque& taskDeque = *taskDeques_[(ownIndex + i) % numDeques];
+        if (taskDeque.numTasks_.load(std::memory_order_acquire) == 0)
+            continue;
+
+        MutexLock lock(taskDeque.mutex_);
+        if (!taskDeque.tasks_.empty())
+        {
+            SharedPtr<WorkTask> task = ea::move(taskDeque.tasks_.front());
+            taskDeque.tasks_.pop_front();
+            taskDeque.numTasks_.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
+bool WorkQueue::TryProcessTask(unsigned threadIndex)
+{
+    if (numPendingTasks_.load(std::memory_order_relaxed) == 0)
+        return false;
+
+    const SharedPtr<WorkTask> task = TryTakeTask(threadIndex);
+    if (!task)
+        return false;
+
+    ExecuteTask(task, threadIndex);
+    return true;
+}
+
 bool WorkQueue::RemoveWorkItem(SharedPtr<WorkItem> item)
 {
     if (!item)
@@ -303,13 +498,14 @@ void WorkQueue::Complete(unsigned priority)
             }
         }
 
-        // Wait for threaded work to complete
+        // Wait for threaded work to complete, execute pending tasks meanwhile
         while (!IsCompleted(priority))
         {
+            TryProcessTask(0);
         }
 
         // If no work at all remaining, pause worker threads by leaving the mutex locked
-        if (queue_.empty())
+        if (queue_.empty() && GetNumPendingTasks() == 0)
             Pause();
     }
     else
@@ -369,6 +565,12 @@ void WorkQueue::ProcessItems(unsigned threadIndex)
         if (shutDown_)
             return;
 
+        if (TryProcessTask(threadIndex))
+        {
+            wasActive = true;
+            continue;
+        }
+
         if (pausing_ && !wasActive)
             Time::Sleep(0);
         else
@@ -454,8 +656,26 @@ void WorkQueue::ReturnToPool(SharedPtr<WorkItem>& item)
     }
 }
 
+LinearAllocator& WorkQueue::GetFrameAllocator()
+{
+    const unsigned threadIndex = GetThreadIndex();
+    URHO3D_ASSERT(threadIndex < frameAllocators_.size(), "Frame allocator is only available for WorkQueue threads");
+
+    // Reset lazily from the owner thread so other threads never touch the allocator
+    FrameAllocator& frameAllocator = *frameAllocators_[threadIndex];
+    const unsigned frameIndex = frameIndex_.load(std::memory_order_relaxed);
+    if (frameAllocator.frameIndex_ != frameIndex)
+    {
+        frameAllocator.allocator_.Reset();
+        frameAllocator.frameIndex_ = frameIndex;
+    }
+    return frameAllocator.allocator_;
+}
+
 void WorkQueue::HandleBeginFrame(StringHash eventType, VariantMap& eventData)
 {
+    frameIndex_.fetch_add(1, std::memory_order_relaxed);
+
     ProcessMainThreadTasks();
 
     // If no worker threads, complete low-priority work here
@@ -474,6 +694,14 @@ void WorkQueue::HandleBeginFrame(StringHash eventType, VariantMap& eventData)
         }
     }
 
+    // If no worker threads, execute tasks that nobody waited for
+    if (threads_.empty())
+    {
+        while (TryProcessTask(0))
+        {
+        }
+    }
+
     // Complete and signal items down to the lowest priority
     PurgeCompleted(0);
     PurgePool();
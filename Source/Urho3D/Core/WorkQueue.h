@@ -24,11 +24,17 @@
 
 #include "../Core/Mutex.h"
 #include "../Core/Object.h"
+#include "../Container/ConcurrentQueue.h"
+#include "../Container/LinearAllocator.h"
 #include "../Container/MultiVector.h"
 
+#include <EASTL/deque.h>
+#include <EASTL/fixed_vector.h>
 #include <EASTL/list.h>
 #include <EASTL/span.h>
+#include <EASTL/unique_ptr.h>
 #include <atomic>
+#include <initializer_list>
 
 namespace Urho3D
 {
@@ -87,6 +93,29 @@ private:
     WorkFunction workLambda_;
 };
 
+/// Task in the dependency graph of WorkQueue.
+/// Task is executed once all dependencies are completed. Completed task schedules its continuations.
+class URHO3D_API WorkTask : public RefCounted
+{
+    friend class WorkQueue;
+
+public:
+    /// Return whether the task is completed. Thread-safe.
+    bool IsCompleted() const { return completed_.load(std::memory_order_acquire); }
+
+private:
+    /// Task function.
+    WorkFunction function_;
+    /// Number of incomplete dependencies. One extra reference is held until the task is fully submitted.
+    std::atomic<unsigned> numDependencies_{1};
+    /// Protects continuations and completion flag.
+    SpinLockMutex continuationsMutex_;
+    /// Tasks waiting for this task to complete.
+    ea::vector<SharedPtr<WorkTask>> continuations_;
+    /// Whether the task is completed.
+    std::atomic<bool> completed_{};
+};
+
 /// Work queue subsystem for multithreading.
 class URHO3D_API WorkQueue : public Object
 {
@@ -102,6 +131,10 @@ public:
 
     /// Create worker threads. Can only be called once.
     void CreateThreads(unsigned numThreads);
+    /// Set mask of logical CPUs worker threads may run on. Zero mask allows any CPU.
+    void SetThreadAffinity(unsigned long long mask);
+    /// Return mask of logical CPUs worker threads may run on.
+    unsigned long long GetThreadAffinity() const { return threadAffinity_; }
 
     /// Invoke callback from main thread. May be called immediately.
     void CallFromMainThread(WorkFunction workFunction);
@@ -123,6 +156,25 @@ public:
     /// Finish all queued work which has at least the specified priority. Main thread will also execute priority work. Pause worker threads if no more work remains.
     void Complete(unsigned priority);
 
+    /// Post task that is executed as soon as all dependencies are completed. Safe to call from any WorkQueue thread.
+    /// Tasks are executed by worker threads and by any thread waiting for task completion.
+    SharedPtr<WorkTask> PostTask(WorkFunction function, std::initializer_list<WorkTask*> dependencies = {});
+    /// Post task that is executed as soon as all dependencies are completed. Safe to call from any WorkQueue thread.
+    SharedPtr<WorkTask> PostTask(WorkFunction function, ea::span<const SharedPtr<WorkTask>> dependencies);
+    /// Post task that is executed after another task is completed.
+    SharedPtr<WorkTask> PostContinuation(WorkTask* parent, WorkFunction function) { return PostTask(ea::move(function), {parent}); }
+    /// Wait until task is completed. Calling thread executes pending tasks while waiting.
+    void WaitForTask(WorkTask* task);
+    /// Wait until all tasks are completed. Calling thread executes pending tasks while waiting.
+    void WaitForTasks(ea::span<const SharedPtr<WorkTask>> tasks);
+    /// Return number of tasks that are posted but not completed yet.
+    unsigned GetNumPendingTasks() const { return numPendingTasks_.load(std::memory_order_relaxed); }
+
+    /// Return frame allocator of the current thread. Should be called from WorkQueue threads (or main thread).
+    /// Memory allocated from frame allocator is released all at once, so it must not be used after the end of the frame.
+    /// Frame allocator of each thread is reset by the owner thread on the first use in a new frame.
+    LinearAllocator& GetFrameAllocator();
+
     /// Set the pool telerance before it starts deleting pool items.
     void SetTolerance(int tolerance) { tolerance_ = tolerance; }
 
@@ -151,6 +203,40 @@ public:
     static unsigned GetMaxThreadIndex();
 
 private:
+    /// Per-thread task deque. Owner thread pushes and pops from the back, other threads steal from the front.
+    struct TaskDeque
+    {
+        SpinLockMutex mutex_;
+        ea::deque<SharedPtr<WorkTask>> tasks_;
+        /// Number of tasks in the deque. Used to skip empty deques without locking.
+        std::atomic<unsigned> numTasks_{};
+    };
+
+    /// Per-thread frame allocator.
+    struct FrameAllocator
+    {
+        LinearAllocator allocator_;
+        /// Index of the frame when the allocator was reset last time.
+        unsigned frameIndex_{};
+    };
+
+    /// Create task and register its dependencies.
+    SharedPtr<WorkTask> CreateTask(WorkFunction function);
+    /// Register dependency of not yet submitted task.
+    void AddTaskDependency(WorkTask* task, WorkTask* dependency);
+    /// Finish task submission and schedule it if all dependencies are completed.
+    void SubmitTask(SharedPtr<WorkTask> task);
+    /// Push ready task to the deque of the current thread.
+    void ScheduleTask(SharedPtr<WorkTask> task);
+    /// Execute task and schedule its continuations.
+    void ExecuteTask(WorkTask* task, unsigned threadIndex);
+    /// Pop task from own deque or steal it from other threads.
+    SharedPtr<WorkTask> TryTakeTask(unsigned threadIndex);
+    /// Execute one pending task if any. Return whether the task was executed.
+    bool TryProcessTask(unsigned threadIndex);
+    /// Return task deque index for a thread.
+    unsigned GetTaskDequeIndex(unsigned threadIndex) const { return threadIndex < taskDeques_.size() ? threadIndex : 0; }
+
     /// Process main thread tasks.
     void ProcessMainThreadTasks();
     /// Process work items until shut down. Called by the worker threads.
@@ -166,6 +252,8 @@ private:
 
     /// Worker threads.
     ea::vector<SharedPtr<WorkerThread> > threads_;
+    /// Mask of logical CPUs worker threads may run on.
+    unsigned long long threadAffinity_{};
     /// Tasks to be invoked from main thread.
     WorkQueueVector<WorkFunction> mainThreadTasks_;
     /// Work item pool for reuse to cut down on allocation. The bool is a flag for item pooling and whether it is available or not.
@@ -176,6 +264,16 @@ private:
     ea::list<WorkItem*> queue_;
     /// Worker queue mutex.
     Mutex queueMutex_;
+    /// Task deques, one per thread including main thread.
+    ea::vector<ea::unique_ptr<TaskDeque>> taskDeques_;
+    /// Tasks posted by main thread and foreign threads. Taken by any thread without locking.
+    ConcurrentQueue<SharedPtr<WorkTask>> sharedTasks_;
+    /// Frame allocators, one per thread including main thread.
+    ea::vector<ea::unique_ptr<FrameAllocator>> frameAllocators_;
+    /// Index of current frame. Incremented on each frame start.
+    std::atomic<unsigned> frameIndex_{};
+    /// Number of posted but not completed tasks.
+    std::atomic<unsigned> numPendingTasks_{};
     /// Shutting down flag.
     std::atomic<bool> shutDown_;
     /// Pausing flag. Indicates the worker threads should not contend for the queue mutex.
@@ -195,11 +293,13 @@ private:
 /// Process arbitrary array in multiple threads. Callback is copied internally.
 /// One copy of callback is always used by at most one thread.
 /// One copy of callback is always invoked from smaller to larger indices.
+/// Calling thread processes the array too and executes other pending tasks while waiting,
+/// so it is safe to call this function from WorkQueue tasks, including nested ForEachParallel.
 /// Signature of callback: void(unsigned beginIndex, unsigned endIndex)
 template <class Callback>
 void ForEachParallel(WorkQueue* workQueue, unsigned bucket, unsigned size, Callback callback)
 {
-    // Just call in main thread
+    // Just call in current thread
     if (size <= bucket)
     {
         if (size > 0)
@@ -208,23 +308,34 @@ void ForEachParallel(WorkQueue* workQueue, unsigned bucket, unsigned size, Callb
     }
 
     std::atomic<unsigned> offset = 0;
-    const unsigned maxThreads = workQueue->GetNumThreads() + 1;
-    for (unsigned i = 0; i < maxThreads; ++i)
+    const auto processBuckets = [&offset, bucket, size](Callback& bucketCallback)
     {
-        workQueue->AddWorkItem([=, &offset](unsigned /*threadIndex*/) mutable
+        while (true)
         {
-            while (true)
-            {
-                const unsigned beginIndex = offset.fetch_add(bucket, std::memory_order_relaxed);
-                if (beginIndex >= size)
-                    break;
-
-                const unsigned endIndex = ea::min(beginIndex + bucket, size);
-                callback(beginIndex, endIndex);
-            }
-        }, M_MAX_UNSIGNED);
+            const unsigned beginIndex = offset.fetch_add(bucket, std::memory_order_relaxed);
+            if (beginIndex >= size)
+                break;
+
+            const unsigned endIndex = ea::min(beginIndex + bucket, size);
+            bucketCallback(beginIndex, endIndex);
+        }
+    };
+
+    // Current thread takes one share of work, don't post more tasks than buckets
+    const unsigned numBuckets = (size + bucket - 1) / bucket;
+    const unsigned numTasks = ea::min(workQueue->GetNumThreads(), numBuckets - 1);
+
+    ea::fixed_vector<SharedPtr<WorkTask>, 16> tasks;
+    for (unsigned i = 0; i < numTasks; ++i)
+    {
+        tasks.push_back(workQueue->PostTask([=, &processBuckets](unsigned /*threadIndex*/) mutable
+        {
+            processBuckets(callback);
+        }));
     }
-    workQueue->Complete(M_MAX_UNSIGNED);
+
+    processBuckets(callback);
+    workQueue->WaitForTasks(tasks);
 }
 
 /// Process collection in multiple threads.
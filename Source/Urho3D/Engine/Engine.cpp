@@ -38,6 +38,7 @@
 #include "../Engine/Engine.h"
 #include "../Engine/EngineDefs.h"
 #include "../Engine/StateManager.h"
+#include "../Graphics/GPUProfiler.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/GraphicsEvents.h"
 #include "../Graphics/Renderer.h"
@@ -91,7 +92,11 @@
 #include "../Utility/AnimationVelocityExtractor.h"
 #include "../Utility/AssetPipeline.h"
 #include "../Utility/AssetTransformer.h"
+#include "../Utility/MaterialCompiler.h"
+#include "../Utility/ModelLODGenerator.h"
 #include "../Utility/SceneViewerApplication.h"
+#include "../Utility/TextureCompressor.h"
+#include "../Utility/VertexAnimationBaker.h"
 #ifdef URHO3D_ACTIONS
 #include "../Actions/ActionManager.h"
 #endif
@@ -127,6 +132,9 @@ namespace Urho3D
 
 extern const char* logLevelNames[];
 
+/// Time before the frame limiting goal which is spent spinning instead of sleeping, in microseconds.
+static const long long FRAME_LIMIT_SPIN_USEC = 2000LL;
+
 Engine::Engine(Context* context) :
     Object(context),
     timeStep_(0.0f),
@@ -154,6 +162,8 @@ Engine::Engine(Context* context) :
     context_->RegisterSubsystem(this);
 
     // Create subsystems which do not depend on engine initialization or startup parameters
+    // Metrics are created first so other subsystems can register their metrics on construction
+    context_->RegisterSubsystem(new Metrics(context_));
     context_->RegisterSubsystem(new Time(context_));
     context_->RegisterSubsystem(new WorkQueue(context_));
     context_->RegisterSubsystem(new FileSystem(context_));
@@ -208,12 +218,38 @@ Engine::Engine(Context* context) :
     context_->AddFactoryReflection<AssetPipeline>();
     context_->AddFactoryReflection<AssetTransformer>();
     AnimationVelocityExtractor::RegisterObject(context_);
+    ModelLODGenerator::RegisterObject(context_);
+    TextureCompressor::RegisterObject(context_);
+    MaterialCompiler::RegisterObject(context_);
+    VertexAnimationBaker::RegisterObject(context_);
+
+    const ea::vector<double>& timingBounds = GetDefaultTimingBounds();
+    frameTimeMetric_ = GetMetricHistogram(context_, "urho3d_frame_time_seconds", timingBounds, "CPU time of frame excluding frame limiter");
+    updateTimeMetric_ = GetMetricHistogram(context_, "urho3d_update_time_seconds", timingBounds, "CPU time of scene and logic update");
+    renderTimeMetric_ = GetMetricHistogram(context_, "urho3d_render_time_seconds", timingBounds, "CPU time of rendering");
+    presentTimeMetric_ = GetMetricHistogram(context_, "urho3d_present_time_seconds", timingBounds, "Time spent in present waiting for GPU or display");
+    framesMetric_ = GetMetricCounter(context_, "urho3d_frames_total", "Number of frames");
+    drawCallsMetric_ = GetMetricCounter(context_, "urho3d_graphics_draw_calls_total", "Number of draw calls");
+    batchesMetric_ = GetMetricGauge(context_, "urho3d_graphics_batches", "Number of draw calls in the last frame");
+    primitivesMetric_ = GetMetricGauge(context_, "urho3d_graphics_primitives", "Number of primitives in the last frame");
+
+    for (unsigned i = 0; i < static_cast<unsigned>(MemoryTag::Count); ++i)
+    {
+        const ea::string tagName = ea::string{GetMemoryTagName(static_cast<MemoryTag>(i))}.to_lower();
+        memoryTagMetrics_[i].bytes_ = GetMetricGauge(context_, Format("urho3d_memory_{}_bytes", tagName),
+            "Tracked memory currently allocated by the subsystem");
+        memoryTagMetrics_[i].allocations_ = GetMetricCounter(context_,
+            Format("urho3d_memory_{}_allocations_total", tagName), "Number of tracked allocations by the subsystem");
+    }
 
     SubscribeToEvent(E_EXITREQUESTED, URHO3D_HANDLER(Engine, HandleExitRequested));
     SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(Engine, HandleEndFrame));
 }
 
-Engine::~Engine() = default;
+Engine::~Engine()
+{
+    WaitForOverlappedTasks();
+}
 
 bool Engine::Initialize(const StringVariantMap& parameters)
 {
@@ -222,6 +258,17 @@ bool Engine::Initialize(const StringVariantMap& parameters)
 
     URHO3D_PROFILE("InitEngine");
 
+    // Time individual steps of startup for the report
+    HiresTimer startupTimer;
+    long long startupTotal = 0;
+    ea::vector<ea::pair<const char*, long long>> startupSteps;
+    const auto finishStartupStep = [&](const char* name)
+    {
+        const long long elapsed = startupTimer.GetUSec(true);
+        startupTotal += elapsed;
+        startupSteps.emplace_back(name, elapsed);
+    };
+
     engineParameters_->DefineVariables(parameters);
     auto* fileSystem = GetSubsystem<FileSystem>();
 
@@ -250,9 +297,11 @@ bool Engine::Initialize(const StringVariantMap& parameters)
 
     // Read and merge configs
     LoadConfigFiles();
+    finishStartupStep("Configuration");
 
     // Set headless mode
     headless_ = GetParameter(EP_HEADLESS).GetBool();
+    skipRenderUpdates_ = headless_ && !GetParameter(EP_HEADLESS_RENDER_UPDATES).GetBool();
 
     // Register the rest of the subsystems
     context_->RegisterSubsystem(new Input(context_));
@@ -270,6 +319,7 @@ bool Engine::Initialize(const StringVariantMap& parameters)
     {
         context_->RegisterSubsystem(new Graphics(context_));
         context_->RegisterSubsystem(new Renderer(context_));
+        context_->RegisterSubsystem(new GPUProfiler(context_));
 #ifdef URHO3D_COMPUTE
         context_->RegisterSubsystem(new ComputeDevice(context_, context_->GetSubsystem<Graphics>()));
 #endif
@@ -285,6 +335,7 @@ bool Engine::Initialize(const StringVariantMap& parameters)
 #endif
 
     context_->RegisterSubsystem(new PluginManager(context_));
+    finishStartupStep("Subsystems");
 
     // Set maximally accurate low res timer
     GetSubsystem<Time>()->SetTimerPeriod(1);
@@ -293,6 +344,8 @@ bool Engine::Initialize(const StringVariantMap& parameters)
     if (GetParameter(EP_FRAME_LIMITER) == false)
         SetMaxFps(0);
 
+    SetFramePipelining(GetParameter(EP_FRAME_PIPELINING).GetBool());
+
     // Set amount of worker threads according to the available physical CPU cores. Using also hyperthreaded cores results in
     // unpredictable extra synchronization overhead. Also reserve one core for the main thread
 #ifdef URHO3D_THREADING
@@ -304,11 +357,30 @@ bool Engine::Initialize(const StringVariantMap& parameters)
         URHO3D_LOGINFOF("Created %u worker thread%s", numThreads, numThreads > 1 ? "s" : "");
     }
 #endif
+    finishStartupStep("Worker threads");
 
     // Add resource paths
     if (!InitializeResourceCache(parameters, false))
         return false;
 
+    // Scan all resource directories at once so they are scanned in parallel
+    if (GetParameter(EP_RESOURCE_FILE_INDEX).GetBool())
+        GetSubsystem<ResourceCache>()->SetFileIndexEnabled(true);
+    finishStartupStep("Resource cache");
+
+    // Keep frame work on performance cores and move background loading to efficiency cores
+#ifdef URHO3D_THREADING
+    unsigned long long performanceCores{};
+    unsigned long long efficiencyCores{};
+    if (GetParameter(EP_HYBRID_CPU_AFFINITY).GetBool() && GetHybridCPUCoreMasks(performanceCores, efficiencyCores))
+    {
+        GetSubsystem<WorkQueue>()->SetThreadAffinity(performanceCores);
+        GetSubsystem<ResourceCache>()->SetBackgroundLoaderAffinity(efficiencyCores);
+        URHO3D_LOGINFO("Hybrid CPU detected, performance cores {:#x}, efficiency cores {:#x}",
+            performanceCores, efficiencyCores);
+    }
+#endif
+
     auto* cache = GetSubsystem<ResourceCache>();
 
     // Initialize graphics & audio output
@@ -389,6 +461,7 @@ bool Engine::Initialize(const StringVariantMap& parameters)
                 GetParameter(EP_SOUND_INTERPOLATION).GetBool()
             );
         }
+        finishStartupStep("Graphics and audio");
     }
 
     // Init FPU state of main thread
@@ -415,9 +488,12 @@ bool Engine::Initialize(const StringVariantMap& parameters)
         RegisterStandardSerializableHooks();
 #endif
     }
+    finishStartupStep("Other");
     frameTimer_.Reset();
 
-    URHO3D_LOGINFO("Initialized engine");
+    for (const auto& [name, elapsed] : startupSteps)
+        URHO3D_LOGDEBUG("Startup step '{}' took {:.2f} ms", name, elapsed / 1000.0);
+    URHO3D_LOGINFO("Initialized engine in {:.2f} ms", startupTotal / 1000.0);
     initialized_ = true;
     SendEvent(E_ENGINEINITIALIZED);
     return true;
@@ -633,10 +709,14 @@ void Engine::RunFrame()
     auto* input = GetSubsystem<Input>();
     auto* audio = GetSubsystem<Audio>();
 
+    HiresTimer frameMetricTimer;
     {
         URHO3D_PROFILE("DoFrame");
         time->BeginFrame(timeStep_);
 
+        // Results of the tasks overlapped with previous frame rendering should be available for update
+        WaitForOverlappedTasks();
+
         // If pause when minimized -mode is in use, stop updates and audio as necessary
         if (pauseMinimized_ && input->IsMinimized())
         {
@@ -655,10 +735,27 @@ void Engine::RunFrame()
                 audioPaused_ = false;
             }
 
+            HiresTimer updateMetricTimer;
             Update();
+            updateTimeMetric_->Observe(updateMetricTimer.GetUSec(false) / 1000000.0);
         }
 
+        if (!framePipelining_)
+            WaitForOverlappedTasks();
+
+        HiresTimer renderMetricTimer;
         Render();
+        renderTimeMetric_->Observe(renderMetricTimer.GetUSec(false) / 1000000.0);
+    }
+    frameTimeMetric_->Observe(frameMetricTimer.GetUSec(false) / 1000000.0);
+    framesMetric_->Increment();
+    for (unsigned i = 0; i < static_cast<unsigned>(MemoryTag::Count); ++i)
+    {
+        MemoryTagMetrics& metrics = memoryTagMetrics_[i];
+        const MemoryTagStats stats = GetMemoryTagStats(static_cast<MemoryTag>(i));
+        metrics.bytes_->Set(static_cast<double>(stats.bytes_));
+        metrics.allocations_->Increment(stats.totalAllocations_ - metrics.lastTotalAllocations_);
+        metrics.lastTotalAllocations_ = stats.totalAllocations_;
     }
     ApplyFrameLimit();
 
@@ -733,6 +830,14 @@ void Engine::SetPauseMinimized(bool enable)
     pauseMinimized_ = enable;
 }
 
+SharedPtr<WorkTask> Engine::PostOverlappedTask(WorkFunction function)
+{
+    auto workQueue = GetSubsystem<WorkQueue>();
+    SharedPtr<WorkTask> task = workQueue->PostTask(ea::move(function));
+    overlappedTasks_.push_back(task);
+    return task;
+}
+
 void Engine::SetAutoExit(bool enable)
 {
     // On mobile platforms exit is mandatory if requested by the platform itself and should not be attempted to be disabled
@@ -852,20 +957,25 @@ void Engine::Update()
 
     VariantMap& eventData = GetEventDataMap();
     eventData[P_TIMESTEP] = timeStep_;
+    const FrameUpdateEventArgs args{timeStep_};
 
     // Pre-update event that indicates
     SendEvent(E_INPUTREADY, eventData);
 
     // Logic update event
+    OnUpdate(this, args);
     SendEvent(E_UPDATE, eventData);
 
     // Logic post-update event
+    OnPostUpdate(this, args);
     SendEvent(E_POSTUPDATE, eventData);
 
     // Rendering update event
+    OnRenderUpdate(this, args);
     SendEvent(E_RENDERUPDATE, eventData);
 
     // Post-render update event
+    OnPostRenderUpdate(this, args);
     SendEvent(E_POSTRENDERUPDATE, eventData);
 }
 
@@ -892,7 +1002,14 @@ void Engine::Render()
             ui->Render();
     }
 
+    // Present blocks when too many frames are queued, which is the time to cut first when reducing latency
+    HiresTimer presentMetricTimer;
     graphics->EndFrame();
+    presentTimeMetric_->Observe(presentMetricTimer.GetUSec(false) / 1000000.0);
+
+    drawCallsMetric_->Increment(graphics->GetNumBatches());
+    batchesMetric_->Set(graphics->GetNumBatches());
+    primitivesMetric_->Set(graphics->GetNumPrimitives());
 }
 
 void Engine::ApplyFrameLimit()
@@ -919,22 +1036,31 @@ void Engine::ApplyFrameLimit()
     {
         URHO3D_PROFILE("ApplyFrameLimit");
 
-        long long targetMax = 1000000LL / maxFps;
+        const long long targetMax = 1000000LL / maxFps;
+        // Wait less if the previous wait was late, so frames stay on schedule instead of drifting
+        const long long target = targetMax - Min(frameLimitOvershoot_, targetMax);
 
+        bool waited = false;
         for (;;)
         {
             elapsed = frameTimer_.GetUSec(false);
-            if (elapsed >= targetMax)
+            if (elapsed >= target)
                 break;
 
-            // Sleep if 1 ms or more off the frame limiting goal
-            if (targetMax - elapsed >= 1000LL)
+            // Sleep granularity of the OS is about a millisecond, so spin close to the goal
+            waited = true;
+            if (target - elapsed >= FRAME_LIMIT_SPIN_USEC + 1000LL)
             {
-                auto sleepTime = (unsigned)((targetMax - elapsed) / 1000LL);
+                auto sleepTime = (unsigned)((target - elapsed - FRAME_LIMIT_SPIN_USEC) / 1000LL);
                 Time::Sleep(sleepTime);
             }
         }
+
+        // Slow frames are not compensated, only the waiting error is
+        frameLimitOvershoot_ = waited ? Min(elapsed - target, targetMax / 2) : 0;
     }
+    else
+        frameLimitOvershoot_ = 0;
 #endif
 
     elapsed = frameTimer_.GetUSec(true);
@@ -1031,9 +1157,11 @@ void Engine::DefineParameters(CLI::App& commandLine, StringVariantMap& enginePar
     };
 
     addFlag("--headless", EP_HEADLESS, true, "Do not initialize graphics subsystem");
+    addFlag("--no-render-updates", EP_HEADLESS_RENDER_UPDATES, false, "Skip render-only updates of components in headless mode");
     addFlag("--validate-shaders", EP_VALIDATE_SHADERS, true, "Validate shaders before submitting them to GAPI");
     addFlag("--nolimit", EP_FRAME_LIMITER, false, "Disable frame limiter");
     addFlag("--flushgpu", EP_FLUSH_GPU, true, "Enable GPU flushing");
+    addFlag("--pipelining", EP_FRAME_PIPELINING, true, "Overlap frame rendering with tasks of the next frame");
     addFlag("--gl2", EP_FORCE_GL2, true, "Force OpenGL2");
     addOptionPrependString("--landscape", EP_ORIENTATIONS, "LandscapeLeft LandscapeRight ", "Force landscape orientation");
     addOptionPrependString("--portrait", EP_ORIENTATIONS, "Portrait PortraitUpsideDown ", "Force portrait orientation");
@@ -1156,10 +1284,13 @@ void Engine::PopulateDefaultParameters()
     engineParameters_->DefineVariable(EP_FLUSH_GPU, false);
     engineParameters_->DefineVariable(EP_FORCE_GL2, false);
     engineParameters_->DefineVariable(EP_FRAME_LIMITER, true).Overridable();
+    engineParameters_->DefineVariable(EP_FRAME_PIPELINING, false).Overridable();
     engineParameters_->DefineVariable(EP_FULL_SCREEN, false).Overridable();
     engineParameters_->DefineVariable(EP_GPU_DEBUG, false);
     engineParameters_->DefineVariable(EP_HEADLESS, false);
+    engineParameters_->DefineVariable(EP_HEADLESS_RENDER_UPDATES, true);
     engineParameters_->DefineVariable(EP_HIGH_DPI, true);
+    engineParameters_->DefineVariable(EP_HYBRID_CPU_AFFINITY, false);
     engineParameters_->DefineVariable(EP_LOG_LEVEL, LOG_TRACE);
     engineParameters_->DefineVariable(EP_LOG_NAME, "Urho3D.log");
     engineParameters_->DefineVariable(EP_LOG_QUIET, false);
@@ -1173,6 +1304,7 @@ void Engine::PopulateDefaultParameters()
     engineParameters_->DefineVariable(EP_PACKAGE_CACHE_DIR, EMPTY_STRING);
     engineParameters_->DefineVariable(EP_PLUGINS, EMPTY_STRING);
     engineParameters_->DefineVariable(EP_REFRESH_RATE, 0).Overridable();
+    engineParameters_->DefineVariable(EP_RESOURCE_FILE_INDEX, false);
     engineParameters_->DefineVariable(EP_RESOURCE_PACKAGES, EMPTY_STRING);
     engineParameters_->DefineVariable(EP_RESOURCE_PATHS, "Data;CoreData");
     engineParameters_->DefineVariable(EP_RESOURCE_PREFIX_PATHS, EMPTY_STRING);
@@ -1221,6 +1353,18 @@ void Engine::HandleEndFrame(StringHash eventType, VariantMap& eventData)
     }
 }
 
+void Engine::WaitForOverlappedTasks()
+{
+    if (overlappedTasks_.empty())
+        return;
+
+    URHO3D_PROFILE("WaitForOverlappedTasks");
+
+    if (auto workQueue = GetSubsystem<WorkQueue>())
+        workQueue->WaitForTasks(overlappedTasks_);
+    overlappedTasks_.clear();
+}
+
 void Engine::DoExit()
 {
     auto* graphics = GetSubsystem<Graphics>();
@@ -22,10 +22,16 @@
 
 #pragma once
 
+#include "../Container/TaggedAllocator.h"
+#include "../Core/Metrics.h"
 #include "../Core/Object.h"
+#include "../Core/Signal.h"
 #include "../Core/Timer.h"
+#include "../Core/WorkQueue.h"
 #include "../Engine/ConfigFile.h"
 
+#include <EASTL/array.h>
+
 namespace CLI
 {
 
@@ -39,6 +45,13 @@ namespace Urho3D
 class Console;
 class DebugHud;
 
+/// Arguments of typed frame update signals. Same as the parameters of E_UPDATE and related events.
+struct FrameUpdateEventArgs
+{
+    /// Frame timestep in seconds.
+    float timeStep_{};
+};
+
 /// Urho3D engine. Creates the other subsystems.
 class URHO3D_API Engine : public Object
 {
@@ -80,6 +93,15 @@ public:
     /// Set whether to exit automatically on exit request (window close button).
     /// @property
     void SetAutoExit(bool enable);
+    /// Set whether the frame pipelining is enabled.
+    /// If enabled, overlapped tasks posted during the frame update are executed in parallel with rendering of the
+    /// same frame and are waited for at the beginning of the next frame.
+    /// If disabled, overlapped tasks are waited for before rendering.
+    /// @property
+    void SetFramePipelining(bool enable) { framePipelining_ = enable; }
+    /// Post task that may overlap with frame rendering. Task must not access scene or rendering state.
+    /// Result of the task is guaranteed to be available on the next frame update.
+    SharedPtr<WorkTask> PostOverlappedTask(WorkFunction function);
     /// Override timestep of the next frame. Should be called in between RunFrame() calls.
     void SetNextTimeStep(float seconds);
     /// Set engine parameter. Not all parameter changes will have effect.
@@ -100,6 +122,15 @@ public:
     /// Return preference directory name.
     const ea::string& GetAppPreferencesDir() const { return appPreferencesDir_; }
 
+    /// Typed frame update signals, invoked right before E_UPDATE, E_POSTUPDATE, E_RENDERUPDATE and E_POSTRENDERUPDATE.
+    /// Handlers are called directly without building event data. String hash events are still sent for compatibility.
+    /// @{
+    Signal<void(const FrameUpdateEventArgs&), Engine> OnUpdate;
+    Signal<void(const FrameUpdateEventArgs&), Engine> OnPostUpdate;
+    Signal<void(const FrameUpdateEventArgs&), Engine> OnRenderUpdate;
+    Signal<void(const FrameUpdateEventArgs&), Engine> OnPostRenderUpdate;
+    /// @}
+
     /// Get timestep of the next frame. Updated by ApplyFrameLimit().
     float GetNextTimeStep() const { return timeStep_; }
 
@@ -123,6 +154,10 @@ public:
     /// @property
     bool GetPauseMinimized() const { return pauseMinimized_; }
 
+    /// Return whether the frame pipelining is enabled.
+    /// @property
+    bool IsFramePipelining() const { return framePipelining_; }
+
     /// Return whether to exit automatically on exit request.
     /// @property
     bool GetAutoExit() const { return autoExit_; }
@@ -138,6 +173,9 @@ public:
     /// Return whether the engine has been created in headless mode.
     /// @property
     bool IsHeadless() const { return headless_; }
+    /// Return whether render-only updates of components (animation, octree reinsertion, particles) are skipped.
+    /// Only possible in headless mode.
+    bool IsRenderUpdateSkipped() const { return skipRenderUpdates_; }
 
     /// Send frame update events.
     void Update();
@@ -164,6 +202,8 @@ private:
     void HandleEndFrame(StringHash eventType, VariantMap& eventData);
     /// Actually perform the exit actions.
     void DoExit();
+    /// Wait for all overlapped tasks to complete.
+    void WaitForOverlappedTasks();
 
     /// Engine parameters (default and current values).
     SharedPtr<ConfigFile> engineParameters_;
@@ -172,6 +212,8 @@ private:
     ea::string appPreferencesDir_;
     /// Frame update timer.
     HiresTimer frameTimer_;
+    /// Time the frame limiter waited past the target in the last frame, in microseconds.
+    long long frameLimitOvershoot_{};
     /// Previous timesteps for smoothing.
     ea::vector<float> lastTimeSteps_;
     /// Next frame timestep in seconds.
@@ -198,8 +240,37 @@ private:
     bool exiting_;
     /// Headless mode flag.
     bool headless_;
+    /// Whether to skip render-only updates in headless mode.
+    bool skipRenderUpdates_{};
     /// Audio paused flag.
     bool audioPaused_;
+    /// Whether the frame pipelining is enabled.
+    bool framePipelining_{};
+    /// Overlapped tasks posted during current frame.
+    ea::vector<SharedPtr<WorkTask>> overlappedTasks_;
+
+    /// Frame metrics.
+    /// @{
+    SharedPtr<MetricHistogram> frameTimeMetric_;
+    SharedPtr<MetricHistogram> updateTimeMetric_;
+    SharedPtr<MetricHistogram> renderTimeMetric_;
+    SharedPtr<MetricHistogram> presentTimeMetric_;
+    SharedPtr<MetricCounter> framesMetric_;
+    SharedPtr<MetricCounter> drawCallsMetric_;
+    SharedPtr<MetricGauge> batchesMetric_;
+    SharedPtr<MetricGauge> primitivesMetric_;
+    /// @}
+
+    /// Tagged memory metrics.
+    /// @{
+    struct MemoryTagMetrics
+    {
+        SharedPtr<MetricGauge> bytes_;
+        SharedPtr<MetricCounter> allocations_;
+        unsigned long long lastTotalAllocations_{};
+    };
+    ea::array<MemoryTagMetrics, static_cast<unsigned>(MemoryTag::Count)> memoryTagMetrics_;
+    /// @}
 };
 
 }
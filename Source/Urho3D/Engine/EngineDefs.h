@@ -44,10 +44,13 @@ URHO3D_GLOBAL_CONSTANT(ConstString EP_EXTERNAL_WINDOW{"ExternalWindow"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_FLUSH_GPU{"FlushGPU"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_FORCE_GL2{"ForceGL2"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_FRAME_LIMITER{"FrameLimiter"});
+URHO3D_GLOBAL_CONSTANT(ConstString EP_FRAME_PIPELINING{"FramePipelining"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_FULL_SCREEN{"FullScreen"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_GPU_DEBUG{"GPUDebug"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_HEADLESS{"Headless"});
+URHO3D_GLOBAL_CONSTANT(ConstString EP_HEADLESS_RENDER_UPDATES{"HeadlessRenderUpdates"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_HIGH_DPI{"HighDPI"});
+URHO3D_GLOBAL_CONSTANT(ConstString EP_HYBRID_CPU_AFFINITY{"HybridCPUAffinity"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_LOG_LEVEL{"LogLevel"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_LOG_NAME{"LogName"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_LOG_QUIET{"LogQuiet"});
@@ -61,6 +64,7 @@ URHO3D_GLOBAL_CONSTANT(ConstString EP_ORIENTATIONS{"Orientations"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_PACKAGE_CACHE_DIR{"PackageCacheDir"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_PLUGINS{"Plugins"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_REFRESH_RATE{"RefreshRate"});
+URHO3D_GLOBAL_CONSTANT(ConstString EP_RESOURCE_FILE_INDEX{"ResourceFileIndex"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_RESOURCE_PACKAGES{"ResourcePackages"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_RESOURCE_PATHS{"ResourcePaths"});
 URHO3D_GLOBAL_CONSTANT(ConstString EP_RESOURCE_PREFIX_PATHS{"ResourcePrefixPaths"});
@@ -52,13 +52,18 @@ URHO3D_EVENT(E_APPLICATIONSTARTED, ApplicationStarted)
 }
 
 /// Begin plugin reloading.
+/// If reload is partial, only objects of the listed types are destroyed and have to be restored.
+/// Otherwise all plugin types are unregistered.
 URHO3D_EVENT(E_BEGINPLUGINRELOAD, BeginPluginReload)
 {
+    URHO3D_PARAM(P_PARTIAL, Partial);              // bool
+    URHO3D_PARAM(P_TYPES, Types);                  // StringVector
 }
 
 /// End plugin reloading.
 URHO3D_EVENT(E_ENDPLUGINRELOAD, EndPluginReload)
 {
+    URHO3D_PARAM(P_PARTIAL, Partial);              // bool
 }
 
 }
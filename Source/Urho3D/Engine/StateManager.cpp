@@ -29,6 +29,7 @@
 #include "../Core/Thread.h"
 #include "../Graphics/Renderer.h"
 #include "../Graphics/Zone.h"
+#include "../IO/FileSystem.h"
 #include "../UI/UI.h"
 #include "../Resource/ResourceCache.h"
 #if URHO3D_SYSTEMUI
@@ -51,6 +52,74 @@ ApplicationState::~ApplicationState() = default;
 
 void ApplicationState::RegisterObject(Context* context) { context->AddFactoryReflection<ApplicationState>(); }
 
+/// Start loading dependencies of the state in background. Executed by StateManager.
+void ApplicationState::Preload(StringVariantMap& bundle)
+{
+}
+
+/// Return true if all preloaded dependencies are loaded. Executed by StateManager.
+bool ApplicationState::IsReadyToActivate() const
+{
+    for (const WeakPtr<Scene>& scene : preloadScenes_)
+    {
+        if (scene && scene->IsAsyncLoading())
+            return false;
+    }
+    for (const SharedPtr<ResourceLoadRequest>& request : preloadRequests_)
+    {
+        if (!request->IsCompleted() && !request->IsCancelled())
+            return false;
+    }
+    return true;
+}
+
+/// Load scene from file asynchronously and wait for it before activation.
+bool ApplicationState::PreloadScene(Scene* scene, const ea::string& fileName, LoadMode mode)
+{
+    if (!scene)
+        return false;
+
+    auto* cache = GetSubsystem<ResourceCache>();
+    AbstractFilePtr file = cache->GetFile(fileName);
+    if (!file)
+        return false;
+
+    const ea::string extension = GetExtension(fileName);
+    bool started = false;
+    if (extension == ".xml")
+        started = scene->LoadAsyncXML(file, mode);
+    else if (extension == ".json")
+        started = scene->LoadAsyncJSON(file, mode);
+    else
+        started = scene->LoadAsync(file, mode);
+
+    if (started)
+        preloadScenes_.emplace_back(scene);
+    return started;
+}
+
+/// Load resource in background and wait for it before activation.
+void ApplicationState::PreloadResource(StringHash type, const ea::string& name, float priority)
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+    preloadRequests_.push_back(cache->RequestResource(type, name, priority));
+}
+
+/// Return progress of preloading in range [0, 1].
+float ApplicationState::GetPreloadProgress() const
+{
+    const unsigned numItems = preloadScenes_.size() + preloadRequests_.size();
+    if (numItems == 0)
+        return 1.0f;
+
+    float progress = 0.0f;
+    for (const WeakPtr<Scene>& scene : preloadScenes_)
+        progress += scene && scene->IsAsyncLoading() ? scene->GetAsyncProgress() : 1.0f;
+    for (const SharedPtr<ResourceLoadRequest>& request : preloadRequests_)
+        progress += request->IsCompleted() || request->IsCancelled() ? 1.0f : 0.0f;
+    return progress / numItems;
+}
+
 /// Activate game screen. Executed by Application.
 void ApplicationState::Activate(StringVariantMap& bundle)
 {
@@ -131,6 +200,12 @@ void ApplicationState::Deactivate()
     // Subscribe HandleUpdate() method for processing update events
     UnsubscribeFromEvent(E_UPDATE);
 
+    // Release preloaded dependencies, they are owned by the state itself from now on
+    for (const SharedPtr<ResourceLoadRequest>& request : preloadRequests_)
+        request->Cancel();
+    preloadRequests_.clear();
+    preloadScenes_.clear();
+
     auto* ui = GetSubsystem<UI>();
     if (ui)
     {
@@ -554,11 +629,14 @@ void StateManager::InitiateTransition()
         return;
     }
 
+    PreloadNextState();
+
     if (transitionState_ == TransitionState::Sustain)
     {
         if (activeState_ != nullptr)
         {
-            SetTransitionState(TransitionState::FadeOut);
+            // Keep current state running until the next one is preloaded
+            SetTransitionState(IsNextStateReady() ? TransitionState::FadeOut : TransitionState::WaitToExit);
         }
         else
         {
@@ -623,7 +701,7 @@ void StateManager::Update(float timeStep)
         case TransitionState::Sustain:
             return;
         case TransitionState::WaitToExit:
-            if (activeState_ && activeState_->CanLeaveState())
+            if (activeState_ && activeState_->CanLeaveState() && IsNextStateReady())
                 SetTransitionState(TransitionState::FadeOut);
             else
                 return;
@@ -637,7 +715,7 @@ void StateManager::Update(float timeStep)
 
                 if (stateQueue_.empty())
                     SetTransitionState(TransitionState::Sustain);
-                else if (activeState_ && !activeState_->CanLeaveState())
+                else if (activeState_ && (!activeState_->CanLeaveState() || !IsNextStateReady()))
                     SetTransitionState(TransitionState::WaitToExit);
                 else
                     SetTransitionState(TransitionState::FadeOut);
@@ -707,6 +785,9 @@ void StateManager::CreateNextState()
         SetTransitionState(TransitionState::FadeIn);
         activeState_->Activate(nextQueueItem.bundle_);
         UpdateFadeOverlay(0.0f);
+
+        // Start loading the following state while this one is active
+        PreloadNextState();
         return;
     }
     destinationState_ = StringHash::Empty;
@@ -714,5 +795,41 @@ void StateManager::CreateNextState()
     CompleteTransition();
 }
 
+/// Create next state in the queue, if not created yet, and start preloading it.
+void StateManager::PreloadNextState()
+{
+    if (stateQueue_.empty())
+        return;
+
+    QueueItem& nextQueueItem = stateQueue_.front();
+    if (nextQueueItem.preloaded_)
+        return;
+    nextQueueItem.preloaded_ = true;
+
+    if (!nextQueueItem.state_)
+    {
+        auto stateCacheIt = stateCache_.find(nextQueueItem.stateType_);
+        if (stateCacheIt != stateCache_.end() && !stateCacheIt->second.Expired())
+            nextQueueItem.state_ = stateCacheIt->second.Lock();
+        else
+            nextQueueItem.state_.DynamicCast(context_->CreateObject(nextQueueItem.stateType_));
+    }
+
+    // Unknown states are reported and skipped by CreateNextState, active state doesn't need preloading
+    if (nextQueueItem.state_ && nextQueueItem.state_ != activeState_)
+        nextQueueItem.state_->Preload(nextQueueItem.bundle_);
+}
+
+/// Return true if next state in the queue is preloaded and can be activated.
+bool StateManager::IsNextStateReady()
+{
+    PreloadNextState();
+
+    if (stateQueue_.empty())
+        return true;
+
+    const QueueItem& nextQueueItem = stateQueue_.front();
+    return !nextQueueItem.state_ || nextQueueItem.state_ == activeState_ || nextQueueItem.state_->IsReadyToActivate();
+}
 
 } // namespace Urho3D
@@ -25,6 +25,7 @@
 #include "../Core/Context.h"
 #include "../Input/Input.h"
 #include "../Graphics/Viewport.h"
+#include "../Scene/Scene.h"
 #include "Urho3D/UI/Window.h"
 #if URHO3D_ACTIONS
 #include "../Actions/ActionManager.h"
@@ -35,6 +36,7 @@
 namespace Urho3D
 {
 class ResourceCache;
+class ResourceLoadRequest;
 class UI;
 
 /// Base class for an application state. Examples of a state would be a loading screen, a menu or a game screen.
@@ -50,6 +52,14 @@ public:
     /// Register object factory.
     static void RegisterObject(Context* context);
 
+    /// Start loading dependencies of the state in background. Executed by StateManager while previous state is still
+    /// active. Use PreloadScene and PreloadResource to declare dependencies.
+    virtual void Preload(StringVariantMap& bundle);
+
+    /// Return true if all preloaded dependencies are loaded and state can be activated without stalls.
+    /// Executed by StateManager.
+    virtual bool IsReadyToActivate() const;
+
     /// Activate game state. Executed by StateManager.
     virtual void Activate(StringVariantMap& bundle);
 
@@ -71,6 +81,14 @@ public:
     /// Get activation flag. Returns true if game screen is active.
     bool IsActive() const { return active_; }
 
+    /// Load scene from file asynchronously and wait for it before activation.
+    bool PreloadScene(Scene* scene, const ea::string& fileName, LoadMode mode = LOAD_SCENE_AND_RESOURCES);
+    /// Load resource in background and wait for it before activation.
+    void PreloadResource(StringHash type, const ea::string& name, float priority = 0.0f);
+    template <class T> void PreloadResource(const ea::string& name, float priority = 0.0f);
+    /// Return progress of preloading in range [0, 1].
+    float GetPreloadProgress() const;
+
     /// Set whether the operating system mouse cursor is visible.
     void SetMouseVisible(bool enable);
     /// Set whether the mouse is currently being grabbed by an operation.
@@ -175,8 +193,17 @@ private:
     /// Local action manager.
     SharedPtr<ActionManager> actionManager_;
 #endif
+    /// Scenes being loaded asynchronously before activation.
+    ea::vector<WeakPtr<Scene>> preloadScenes_;
+    /// Resources being loaded in background before activation.
+    ea::vector<SharedPtr<ResourceLoadRequest>> preloadRequests_;
 };
 
+template <class T> void ApplicationState::PreloadResource(const ea::string& name, float priority)
+{
+    PreloadResource(T::GetTypeStatic(), name, priority);
+}
+
 class URHO3D_API StateManager: public Object
 {
     URHO3D_OBJECT(StateManager, Object);
@@ -190,6 +217,8 @@ class URHO3D_API StateManager: public Object
         StringHash stateType_;
         /// Target state arguments.
         StringVariantMap bundle_;
+        /// Whether the target state is created and preloaded.
+        bool preloaded_{};
     };
 
     enum class TransitionState
@@ -264,6 +293,12 @@ private:
     /// Dequeue and set next state as active.
     void CreateNextState();
 
+    /// Create next state in the queue, if not created yet, and start preloading it.
+    void PreloadNextState();
+
+    /// Return true if next state in the queue is preloaded and can be activated.
+    bool IsNextStateReady();
+
     /// Notify subscribers about transition state updates.
     void Notify(StringHash eventType);
 
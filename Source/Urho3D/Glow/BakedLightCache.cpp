@@ -26,9 +26,35 @@
 
 #include "../Glow/BakedLightCache.h"
 
+#include "../IO/ArchiveSerialization.h"
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+#include "../Resource/BinaryFile.h"
+
 namespace Urho3D
 {
 
+/// Serialize direct light for lightmap chart.
+static void SerializeValue(Archive& archive, const char* name, LightmapChartBakedDirect& value)
+{
+    ArchiveBlock block = archive.OpenUnorderedBlock(name);
+    SerializeValue(archive, "lightmapSize", value.lightmapSize_);
+    SerializeVectorAsBytes(archive, "directLight", value.directLight_);
+    SerializeVectorAsBytes(archive, "surfaceLight", value.surfaceLight_);
+    SerializeVectorAsBytes(archive, "albedo", value.albedo_);
+
+    if (archive.IsInput())
+        value.realLightmapSize_ = static_cast<float>(value.lightmapSize_);
+}
+
+/// Serialize baked lightmap.
+static void SerializeValue(Archive& archive, const char* name, BakedLightmap& value)
+{
+    ArchiveBlock block = archive.OpenUnorderedBlock(name);
+    SerializeValue(archive, "lightmapSize", value.lightmapSize_);
+    SerializeVectorAsBytes(archive, "lightmap", value.lightmap_);
+}
+
 BakedLightCache::~BakedLightCache() = default;
 
 void BakedLightMemoryCache::StoreBakedChunk(const IntVector3& chunk, BakedSceneChunk bakedChunk)
@@ -64,4 +90,116 @@ ea::shared_ptr<const BakedLightmap> BakedLightMemoryCache::LoadLightmap(unsigned
     return iter != lightmapCache_.end() ? iter->second : nullptr;
 }
 
+void BakedLightMemoryCache::StoreLightProbes(const IntVector3& chunk, LightProbeCollectionBakedData bakedData)
+{
+    lightProbesCache_[chunk] = ea::make_shared<LightProbeCollectionBakedData>(ea::move(bakedData));
+}
+
+ea::shared_ptr<const LightProbeCollectionBakedData> BakedLightMemoryCache::LoadLightProbes(const IntVector3& chunk)
+{
+    auto iter = lightProbesCache_.find(chunk);
+    return iter != lightProbesCache_.end() ? iter->second : nullptr;
+}
+
+BakedLightSharedCache::BakedLightSharedCache(Context* context, const ea::string& directory)
+    : context_(context)
+    , directory_(AddTrailingSlash(directory))
+{
+    context_->GetSubsystem<FileSystem>()->CreateDirsRecursive(directory_);
+}
+
+void BakedLightSharedCache::StoreBakedChunk(const IntVector3& chunk, BakedSceneChunk bakedChunk)
+{
+    localCache_.StoreBakedChunk(chunk, ea::move(bakedChunk));
+}
+
+ea::shared_ptr<const BakedSceneChunk> BakedLightSharedCache::LoadBakedChunk(const IntVector3& chunk)
+{
+    return localCache_.LoadBakedChunk(chunk);
+}
+
+void BakedLightSharedCache::StoreDirectLight(unsigned lightmapIndex, LightmapChartBakedDirect bakedDirect)
+{
+    SaveSharedFile(Format("Direct-{}.bin", lightmapIndex), "BakedDirect", bakedDirect);
+    localCache_.StoreDirectLight(lightmapIndex, ea::move(bakedDirect));
+}
+
+ea::shared_ptr<const LightmapChartBakedDirect> BakedLightSharedCache::LoadDirectLight(unsigned lightmapIndex)
+{
+    if (auto bakedDirect = localCache_.LoadDirectLight(lightmapIndex))
+        return bakedDirect;
+
+    auto bakedDirect = LoadSharedFile<LightmapChartBakedDirect>(Format("Direct-{}.bin", lightmapIndex), "BakedDirect");
+    if (bakedDirect)
+        localCache_.StoreDirectLight(lightmapIndex, *bakedDirect);
+    return localCache_.LoadDirectLight(lightmapIndex);
+}
+
+void BakedLightSharedCache::StoreLightmap(unsigned lightmapIndex, BakedLightmap bakedLightmap)
+{
+    SaveSharedFile(Format("Lightmap-{}.bin", lightmapIndex), "BakedLightmap", bakedLightmap);
+    localCache_.StoreLightmap(lightmapIndex, ea::move(bakedLightmap));
+}
+
+ea::shared_ptr<const BakedLightmap> BakedLightSharedCache::LoadLightmap(unsigned lightmapIndex)
+{
+    if (auto bakedLightmap = localCache_.LoadLightmap(lightmapIndex))
+        return bakedLightmap;
+
+    auto bakedLightmap = LoadSharedFile<BakedLightmap>(Format("Lightmap-{}.bin", lightmapIndex), "BakedLightmap");
+    if (bakedLightmap)
+        localCache_.StoreLightmap(lightmapIndex, *bakedLightmap);
+    return localCache_.LoadLightmap(lightmapIndex);
+}
+
+void BakedLightSharedCache::StoreLightProbes(const IntVector3& chunk, LightProbeCollectionBakedData bakedData)
+{
+    SaveSharedFile(Format("LightProbes-{}-{}-{}.bin", chunk.x_, chunk.y_, chunk.z_), "LightProbesBakedData", bakedData);
+    localCache_.StoreLightProbes(chunk, ea::move(bakedData));
+}
+
+ea::shared_ptr<const LightProbeCollectionBakedData> BakedLightSharedCache::LoadLightProbes(const IntVector3& chunk)
+{
+    if (auto bakedData = localCache_.LoadLightProbes(chunk))
+        return bakedData;
+
+    auto bakedData = LoadSharedFile<LightProbeCollectionBakedData>(
+        Format("LightProbes-{}-{}-{}.bin", chunk.x_, chunk.y_, chunk.z_), "LightProbesBakedData");
+    if (bakedData)
+        localCache_.StoreLightProbes(chunk, *bakedData);
+    return localCache_.LoadLightProbes(chunk);
+}
+
+template <class T>
+void BakedLightSharedCache::SaveSharedFile(const ea::string& name, const char* objectName, const T& object)
+{
+    const ea::string fileName = directory_ + name;
+    const ea::string tempFileName = fileName + ".tmp";
+
+    BinaryFile file(context_);
+    if (!file.SaveObject(objectName, object) || !file.SaveFile(tempFileName)
+        || !context_->GetSubsystem<FileSystem>()->Rename(tempFileName, fileName))
+    {
+        URHO3D_LOGERROR("Cannot save baked light to shared file '{}'", fileName);
+    }
+}
+
+template <class T>
+ea::shared_ptr<const T> BakedLightSharedCache::LoadSharedFile(const ea::string& name, const char* objectName)
+{
+    const ea::string fileName = directory_ + name;
+    if (!context_->GetSubsystem<FileSystem>()->FileExists(fileName))
+        return nullptr;
+
+    BinaryFile file(context_);
+    auto object = ea::make_shared<T>();
+    if (!file.LoadFile(fileName) || !file.LoadObject(objectName, *object))
+    {
+        URHO3D_LOGERROR("Cannot load baked light from shared file '{}'", fileName);
+        return nullptr;
+    }
+
+    return object;
+}
+
 }
@@ -75,6 +75,11 @@ public:
     virtual void StoreLightmap(unsigned lightmapIndex, BakedLightmap bakedLightmap) = 0;
     /// Load baked lightmap.
     virtual ea::shared_ptr<const BakedLightmap> LoadLightmap(unsigned lightmapIndex) = 0;
+
+    /// Store baked light probes for the chunk.
+    virtual void StoreLightProbes(const IntVector3& chunk, LightProbeCollectionBakedData bakedData) = 0;
+    /// Load baked light probes for the chunk.
+    virtual ea::shared_ptr<const LightProbeCollectionBakedData> LoadLightProbes(const IntVector3& chunk) = 0;
 };
 
 /// Memory lightmap cache.
@@ -96,6 +101,11 @@ public:
     /// Load baked lightmap.
     ea::shared_ptr<const BakedLightmap> LoadLightmap(unsigned lightmapIndex) override;
 
+    /// Store baked light probes for the chunk.
+    void StoreLightProbes(const IntVector3& chunk, LightProbeCollectionBakedData bakedData) override;
+    /// Load baked light probes for the chunk.
+    ea::shared_ptr<const LightProbeCollectionBakedData> LoadLightProbes(const IntVector3& chunk) override;
+
 private:
     /// Baking contexts cache.
     ea::unordered_map<IntVector3, ea::shared_ptr<const BakedSceneChunk>> bakedChunkCache_;
@@ -103,6 +113,52 @@ private:
     ea::unordered_map<unsigned, ea::shared_ptr<const LightmapChartBakedDirect>> directLightCache_;
     /// Baked lightmaps.
     ea::unordered_map<unsigned, ea::shared_ptr<const BakedLightmap>> lightmapCache_;
+    /// Baked light probes.
+    ea::unordered_map<IntVector3, ea::shared_ptr<const LightProbeCollectionBakedData>> lightProbesCache_;
+};
+
+/// Lightmap cache that exchanges baked light with other processes via shared directory.
+/// Baked scene chunks are kept in memory, because each process generates them on its own.
+/// Other results are written to shared directory as soon as they are stored
+/// and are read from shared directory if they were baked by another process.
+class URHO3D_API BakedLightSharedCache : public BakedLightCache
+{
+public:
+    /// Construct.
+    BakedLightSharedCache(Context* context, const ea::string& directory);
+
+    /// Store baked scene chunk in the cache.
+    void StoreBakedChunk(const IntVector3& chunk, BakedSceneChunk bakedChunk) override;
+    /// Load baked scene chunk.
+    ea::shared_ptr<const BakedSceneChunk> LoadBakedChunk(const IntVector3& chunk) override;
+
+    /// Store direct light for the lightmap chart.
+    void StoreDirectLight(unsigned lightmapIndex, LightmapChartBakedDirect bakedDirect) override;
+    /// Load direct light for the lightmap chart. Return null if not baked yet.
+    ea::shared_ptr<const LightmapChartBakedDirect> LoadDirectLight(unsigned lightmapIndex) override;
+
+    /// Store baked lightmap.
+    void StoreLightmap(unsigned lightmapIndex, BakedLightmap bakedLightmap) override;
+    /// Load baked lightmap. Return null if not baked yet.
+    ea::shared_ptr<const BakedLightmap> LoadLightmap(unsigned lightmapIndex) override;
+
+    /// Store baked light probes for the chunk.
+    void StoreLightProbes(const IntVector3& chunk, LightProbeCollectionBakedData bakedData) override;
+    /// Load baked light probes for the chunk. Return null if not baked yet.
+    ea::shared_ptr<const LightProbeCollectionBakedData> LoadLightProbes(const IntVector3& chunk) override;
+
+private:
+    /// Save object to shared directory. File is renamed after writing so other processes never see partial data.
+    template <class T> void SaveSharedFile(const ea::string& name, const char* objectName, const T& object);
+    /// Load object from shared directory. Return null if file doesn't exist.
+    template <class T> ea::shared_ptr<const T> LoadSharedFile(const ea::string& name, const char* objectName);
+
+    /// Context.
+    Context* context_{};
+    /// Shared directory.
+    ea::string directory_;
+    /// Local cache.
+    BakedLightMemoryCache localCache_;
 };
 
 }
@@ -0,0 +1,322 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Glow/GpuRaytracer.h"
+
+#include "../Glow/RaytracerScene.h"
+#include "../Graphics/ComputeBuffer.h"
+#include "../Graphics/ComputeDevice.h"
+#include "../Graphics/Graphics.h"
+#include "../Graphics/ShaderVariation.h"
+#include "../IO/Log.h"
+#include "../Math/BoundingBox.h"
+
+#include <embree3/rtcore.h>
+
+#include <EASTL/sort.h>
+
+#if defined(URHO3D_COMPUTE)
+
+using namespace embree3;
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Size of compute shader thread group.
+const unsigned TraceGroupSize = 64;
+/// Max number of rays traced in single dispatch. Limited to keep single dispatch reasonably short.
+const unsigned MaxRaysPerDispatch = 256 * 1024;
+/// Max number of triangles in BVH leaf.
+const unsigned MaxTrianglesPerLeaf = 4;
+/// Geometry flag: geometry is opaque.
+const unsigned GeometryFlagOpaque = 1u;
+
+/// BVH node. Layout matches compute shader.
+struct GpuBvhNode
+{
+    /// Min corner of bounding box.
+    Vector3 min_;
+    /// Index of first triangle for leaf, index of right child for inner node. Left child immediately follows the node.
+    unsigned offset_{};
+    /// Max corner of bounding box.
+    Vector3 max_;
+    /// Number of triangles for leaf, zero for inner node.
+    unsigned count_{};
+};
+
+/// Triangle. Layout matches compute shader.
+struct GpuTriangle
+{
+    Vector3 v0_;
+    unsigned geometryId_{};
+    Vector3 v1_;
+    unsigned primitiveId_{};
+    Vector3 v2_;
+    unsigned mask_{};
+};
+
+/// Geometry properties. Layout matches compute shader.
+struct GpuGeometry
+{
+    unsigned objectIndex_{};
+    unsigned geometryIndex_{};
+    unsigned lodIndex_{};
+    unsigned flags_{};
+};
+
+/// Triangle reference used to build BVH.
+struct BvhBuildItem
+{
+    /// Bounding box.
+    BoundingBox boundingBox_;
+    /// Center of bounding box.
+    Vector3 centroid_;
+    /// Triangle index.
+    unsigned triangleIndex_{};
+};
+
+/// Build BVH node for range of items with median split. Return node index.
+unsigned BuildBvhNode(ea::vector<BvhBuildItem>& items, unsigned begin, unsigned end, ea::vector<GpuBvhNode>& nodes)
+{
+    const unsigned nodeIndex = nodes.size();
+    nodes.emplace_back();
+
+    BoundingBox boundingBox;
+    BoundingBox centroidBox;
+    for (unsigned i = begin; i < end; ++i)
+    {
+        boundingBox.Merge(items[i].boundingBox_);
+        centroidBox.Merge(items[i].centroid_);
+    }
+
+    nodes[nodeIndex].min_ = boundingBox.min_;
+    nodes[nodeIndex].max_ = boundingBox.max_;
+
+    const Vector3 centroidExtent = centroidBox.Size();
+    const unsigned axis = centroidExtent.x_ >= centroidExtent.y_ && centroidExtent.x_ >= centroidExtent.z_ ? 0
+        : centroidExtent.y_ >= centroidExtent.z_ ? 1 : 2;
+
+    const unsigned count = end - begin;
+    if (count <= MaxTrianglesPerLeaf || centroidExtent.Data()[axis] <= 0.0f)
+    {
+        nodes[nodeIndex].offset_ = begin;
+        nodes[nodeIndex].count_ = count;
+        return nodeIndex;
+    }
+
+    const unsigned middle = begin + count / 2;
+    ea::nth_element(items.begin() + begin, items.begin() + middle, items.begin() + end,
+        [axis](const BvhBuildItem& lhs, const BvhBuildItem& rhs)
+    {
+        return lhs.centroid_.Data()[axis] < rhs.centroid_.Data()[axis];
+    });
+
+    BuildBvhNode(items, begin, middle, nodes);
+    const unsigned rightChild = BuildBvhNode(items, middle, end, nodes);
+
+    nodes[nodeIndex].offset_ = rightChild;
+    nodes[nodeIndex].count_ = 0;
+    return nodeIndex;
+}
+
+unsigned DivideRoundUp(unsigned value, unsigned divisor)
+{
+    return (value + divisor - 1) / divisor;
+}
+
+}
+
+GpuRaytracer::GpuRaytracer(Context* context)
+    : Object(context)
+    , computeDevice_(GetSubsystem<ComputeDevice>())
+    , parametersBuffer_(MakeShared<ComputeBuffer>(context))
+    , nodesBuffer_(MakeShared<ComputeBuffer>(context))
+    , trianglesBuffer_(MakeShared<ComputeBuffer>(context))
+    , geometriesBuffer_(MakeShared<ComputeBuffer>(context))
+    , raysBuffer_(MakeShared<ComputeBuffer>(context))
+    , resultsBuffer_(MakeShared<ComputeBuffer>(context))
+{
+}
+
+GpuRaytracer::~GpuRaytracer()
+{
+}
+
+bool GpuRaytracer::IsSupported() const
+{
+    return computeDevice_ && computeDevice_->IsSupported();
+}
+
+bool GpuRaytracer::Initialize(const RaytracerScene& raytracerScene)
+{
+    if (!IsSupported())
+        return false;
+
+    const ea::vector<RaytracerGeometry>& raytracerGeometries = raytracerScene.GetGeometries();
+
+    // Collect world-space triangles from Embree buffers
+    ea::vector<GpuGeometry> geometries(ea::max(1u, raytracerGeometries.size()));
+    ea::vector<GpuTriangle> triangles;
+    for (const RaytracerGeometry& raytracerGeometry : raytracerGeometries)
+    {
+        GpuGeometry& geometry = geometries[raytracerGeometry.raytracerGeometryId_];
+        geometry.objectIndex_ = raytracerGeometry.objectIndex_;
+        geometry.geometryIndex_ = raytracerGeometry.geometryIndex_;
+        geometry.lodIndex_ = raytracerGeometry.lodIndex_;
+        geometry.flags_ = raytracerGeometry.material_.opaque_ ? GeometryFlagOpaque : 0u;
+
+        const auto vertices = static_cast<const Vector3*>(
+            rtcGetGeometryBufferData(raytracerGeometry.embreeGeometry_, RTC_BUFFER_TYPE_VERTEX, 0));
+        const auto indices = static_cast<const unsigned*>(
+            rtcGetGeometryBufferData(raytracerGeometry.embreeGeometry_, RTC_BUFFER_TYPE_INDEX, 0));
+        if (!vertices || !indices)
+            continue;
+
+        for (unsigned i = 0; i < raytracerGeometry.numTriangles_; ++i)
+        {
+            GpuTriangle& triangle = triangles.emplace_back();
+            triangle.v0_ = vertices[indices[i * 3 + 0]];
+            triangle.v1_ = vertices[indices[i * 3 + 1]];
+            triangle.v2_ = vertices[indices[i * 3 + 2]];
+            triangle.geometryId_ = raytracerGeometry.raytracerGeometryId_;
+            triangle.primitiveId_ = i;
+            triangle.mask_ = raytracerGeometry.mask_;
+        }
+    }
+
+    // Build BVH and reorder triangles
+    ea::vector<BvhBuildItem> items(triangles.size());
+    for (unsigned i = 0; i < triangles.size(); ++i)
+    {
+        const GpuTriangle& triangle = triangles[i];
+        items[i].boundingBox_.Define(triangle.v0_);
+        items[i].boundingBox_.Merge(triangle.v1_);
+        items[i].boundingBox_.Merge(triangle.v2_);
+        items[i].centroid_ = items[i].boundingBox_.Center();
+        items[i].triangleIndex_ = i;
+    }
+
+    ea::vector<GpuBvhNode> nodes;
+    if (!items.empty())
+        BuildBvhNode(items, 0, items.size(), nodes);
+
+    ea::vector<GpuTriangle> sortedTriangles(ea::max(1u, triangles.size()));
+    for (unsigned i = 0; i < items.size(); ++i)
+        sortedTriangles[i] = triangles[items[i].triangleIndex_];
+
+    numNodes_ = nodes.size();
+    numTriangles_ = triangles.size();
+    if (nodes.empty())
+        nodes.emplace_back();
+
+    // Upload scene
+    if (!nodesBuffer_->SetSize(nodes.size() * sizeof(GpuBvhNode), sizeof(Vector4))
+        || !trianglesBuffer_->SetSize(sortedTriangles.size() * sizeof(GpuTriangle), sizeof(Vector4))
+        || !geometriesBuffer_->SetSize(geometries.size() * sizeof(GpuGeometry), sizeof(GpuGeometry)))
+    {
+        URHO3D_LOGERROR("Failed to allocate GPU memory for raytracer scene with {} triangles", numTriangles_);
+        return false;
+    }
+
+    nodesBuffer_->SetData(nodes.data(), nodes.size() * sizeof(GpuBvhNode), sizeof(Vector4));
+    trianglesBuffer_->SetData(sortedTriangles.data(), sortedTriangles.size() * sizeof(GpuTriangle), sizeof(Vector4));
+    geometriesBuffer_->SetData(geometries.data(), geometries.size() * sizeof(GpuGeometry), sizeof(GpuGeometry));
+    return true;
+}
+
+bool GpuRaytracer::TraceOcclusion(ea::span<const GpuRay> rays, ea::vector<GpuRayOcclusion>& result)
+{
+    result.resize(rays.size());
+    return Trace(rays, true, result.data(), sizeof(GpuRayOcclusion));
+}
+
+bool GpuRaytracer::TraceClosestHit(ea::span<const GpuRay> rays, ea::vector<GpuRayHit>& result)
+{
+    result.resize(rays.size());
+    return Trace(rays, false, result.data(), sizeof(GpuRayHit));
+}
+
+bool GpuRaytracer::Trace(ea::span<const GpuRay> rays, bool occlusion, void* result, unsigned resultSize)
+{
+    if (!IsSupported() || rays.empty())
+        return IsSupported();
+
+    auto graphics = GetSubsystem<Graphics>();
+    ShaderVariation* traceShader = graphics->GetShader(CS, "v2/C_Raytrace", occlusion ? "OCCLUSION" : "");
+    if (!traceShader)
+        return false;
+
+    // Pad buffers to power of two to avoid reallocation for every batch
+    const unsigned capacity = NextPowerOfTwo(ea::min<unsigned>(rays.size(), MaxRaysPerDispatch));
+    if (!EnsureBufferSize(parametersBuffer_, sizeof(unsigned) * 4, sizeof(unsigned) * 4)
+        || !EnsureBufferSize(raysBuffer_, capacity * sizeof(GpuRay), sizeof(Vector4))
+        || !EnsureBufferSize(resultsBuffer_, capacity * resultSize, occlusion ? resultSize : sizeof(Vector4)))
+        return false;
+
+    auto resultBytes = static_cast<unsigned char*>(result);
+    for (unsigned offset = 0; offset < rays.size(); offset += MaxRaysPerDispatch)
+    {
+        const unsigned numRays = ea::min<unsigned>(rays.size() - offset, MaxRaysPerDispatch);
+        unsigned parameters[4] = { numRays, numNodes_, 0, 0 };
+
+        parametersBuffer_->SetData(parameters, sizeof(parameters), sizeof(parameters));
+        raysBuffer_->SetData(const_cast<GpuRay*>(rays.data() + offset), numRays * sizeof(GpuRay), sizeof(Vector4));
+
+        computeDevice_->SetWriteBuffer(parametersBuffer_, 0);
+        computeDevice_->SetWriteBuffer(nodesBuffer_, 1);
+        computeDevice_->SetWriteBuffer(trianglesBuffer_, 2);
+        computeDevice_->SetWriteBuffer(geometriesBuffer_, 3);
+        computeDevice_->SetWriteBuffer(raysBuffer_, 4);
+        computeDevice_->SetWriteBuffer(resultsBuffer_, 5);
+        computeDevice_->SetProgram(traceShader);
+        computeDevice_->Dispatch(DivideRoundUp(numRays, TraceGroupSize), 1, 1);
+
+        for (unsigned unit = 0; unit < 6; ++unit)
+            computeDevice_->SetWriteBuffer(static_cast<ComputeBuffer*>(nullptr), unit);
+        computeDevice_->ApplyBindings();
+
+        if (!resultsBuffer_->GetData(resultBytes + offset * resultSize, 0, numRays * resultSize))
+        {
+            URHO3D_LOGERROR("Failed to read back results of GPU ray tracing");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool GpuRaytracer::EnsureBufferSize(ComputeBuffer* buffer, unsigned size, unsigned structureSize)
+{
+    if (buffer->GetSize() == size && buffer->GetStructSize() == structureSize)
+        return true;
+    return buffer->SetSize(size, structureSize);
+}
+
+}
+
+#endif
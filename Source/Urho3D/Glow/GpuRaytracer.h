@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/// \file
+
+
+#pragma once
+
+#include "../Core/Object.h"
+#include "../Math/Vector3.h"
+
+#include <EASTL/span.h>
+#include <EASTL/vector.h>
+
+#if defined(URHO3D_COMPUTE)
+
+namespace Urho3D
+{
+
+class ComputeBuffer;
+class ComputeDevice;
+class RaytracerScene;
+
+/// Ray traced on GPU. Layout matches compute shader.
+struct GpuRay
+{
+    /// Source geometry that is not set, LODs are not filtered.
+    static const unsigned NoSourceGeometry = M_MAX_UNSIGNED;
+
+    /// Ray origin.
+    Vector3 origin_;
+    /// Max distance along ray direction, in units of direction length.
+    float maxDistance_{};
+    /// Ray direction. May be not normalized.
+    Vector3 direction_;
+    /// Geometry mask. Ray is ignored if zero.
+    unsigned mask_{};
+    /// Raytracer geometry ID of ray source. Hits of other LODs are ignored in the same way as in direct light tracing.
+    unsigned sourceGeometry_{ NoSourceGeometry };
+    /// Padding.
+    unsigned padding_[3]{};
+};
+
+/// Closest hit of ray traced on GPU. Layout matches compute shader.
+struct GpuRayHit
+{
+    /// Geometry ID if nothing is hit.
+    static const unsigned NoHit = M_MAX_UNSIGNED;
+    /// Geometry ID if closest hit is not opaque and the ray should be traced on CPU.
+    static const unsigned Unresolved = M_MAX_UNSIGNED - 1;
+
+    /// Raytracer geometry ID.
+    unsigned geometryId_{};
+    /// Primitive ID within geometry.
+    unsigned primitiveId_{};
+    /// Barycentric U coordinate.
+    float u_{};
+    /// Barycentric V coordinate.
+    float v_{};
+    /// Geometric normal, not normalized. Oriented in the same way as Embree normal.
+    Vector3 normal_;
+    /// Distance along ray direction, in units of direction length.
+    float distance_{};
+};
+
+/// Result of occlusion test for ray traced on GPU.
+enum class GpuRayOcclusion : unsigned
+{
+    /// Nothing is hit.
+    Visible,
+    /// Opaque geometry is hit.
+    Occluded,
+    /// Only non-opaque geometry is hit, the ray should be traced on CPU.
+    Unresolved
+};
+
+/// Raytracer that traces rays against BVH of raytracer scene in compute shader.
+/// Non-opaque geometry is reported as unresolved, so materials are always evaluated on CPU.
+/// Should be used from main thread only.
+class URHO3D_API GpuRaytracer : public Object
+{
+    URHO3D_OBJECT(GpuRaytracer, Object);
+
+public:
+    /// Construct.
+    explicit GpuRaytracer(Context* context);
+    /// Destruct.
+    ~GpuRaytracer() override;
+
+    /// Return whether the compute device is available.
+    bool IsSupported() const;
+    /// Build BVH for scene and upload scene to GPU.
+    bool Initialize(const RaytracerScene& raytracerScene);
+
+    /// Trace rays and test occlusion.
+    bool TraceOcclusion(ea::span<const GpuRay> rays, ea::vector<GpuRayOcclusion>& result);
+    /// Trace rays and find closest hits.
+    bool TraceClosestHit(ea::span<const GpuRay> rays, ea::vector<GpuRayHit>& result);
+
+    /// Return number of triangles in scene.
+    unsigned GetNumTriangles() const { return numTriangles_; }
+
+private:
+    /// Trace rays in batches and read back results.
+    bool Trace(ea::span<const GpuRay> rays, bool occlusion, void* result, unsigned resultSize);
+    /// Resize buffer if needed.
+    bool EnsureBufferSize(ComputeBuffer* buffer, unsigned size, unsigned structureSize);
+
+    /// Compute device.
+    WeakPtr<ComputeDevice> computeDevice_;
+    /// Trace parameters.
+    SharedPtr<ComputeBuffer> parametersBuffer_;
+    /// BVH nodes.
+    SharedPtr<ComputeBuffer> nodesBuffer_;
+    /// Triangles in BVH order.
+    SharedPtr<ComputeBuffer> trianglesBuffer_;
+    /// Geometry properties.
+    SharedPtr<ComputeBuffer> geometriesBuffer_;
+    /// Rays of current batch.
+    SharedPtr<ComputeBuffer> raysBuffer_;
+    /// Results of current batch.
+    SharedPtr<ComputeBuffer> resultsBuffer_;
+
+    /// Number of BVH nodes.
+    unsigned numNodes_{};
+    /// Number of triangles.
+    unsigned numTriangles_{};
+};
+
+}
+
+#endif
@@ -27,7 +27,10 @@
 #include "../Glow/IncrementalLightBaker.h"
 
 #include "../Core/Context.h"
+#include "../Core/Thread.h"
+#include "../Core/Timer.h"
 #include "../Glow/BakedSceneChunk.h"
+#include "../Glow/GpuRaytracer.h"
 #include "../Glow/LightmapCharter.h"
 #include "../Glow/LightmapGeometryBuffer.h"
 #include "../Glow/LightmapFilter.h"
@@ -66,6 +69,9 @@ ea::string GetResourceName(ResourceCache* cache, const ea::string& fileName)
     return {};
 }
 
+/// Interval between checks for results of other workers, in milliseconds.
+const unsigned WorkerPollingInterval = 500;
+
 /// Per-component min for 3D integer vector.
 IntVector3 MinIntVector3(const IntVector3& lhs, const IntVector3& rhs) { return VectorMin(lhs, rhs); }
 
@@ -133,6 +139,39 @@ struct IncrementalLightBaker::Impl
 
         settings_.incremental_.outputDirectory_ = AddTrailingSlash(settings_.incremental_.outputDirectory_);
 
+        const unsigned numWorkers = settings_.incremental_.numWorkers_;
+        const unsigned workerIndex = settings_.incremental_.workerIndex_;
+        if (numWorkers == 0 || workerIndex >= numWorkers)
+        {
+            URHO3D_LOGERROR("Invalid light baking worker {} of {}", workerIndex, numWorkers);
+            return false;
+        }
+
+        // Divide samples between progressive passes
+        unsigned& numPasses = settings_.incremental_.numPasses_;
+        if (numPasses > 1 && numWorkers > 1)
+        {
+            URHO3D_LOGWARNING("Progressive light baking is not supported for multiple workers");
+            numPasses = 1;
+        }
+
+        numPasses = ea::max(1u, numPasses);
+        if (numPasses > 1)
+        {
+            for (unsigned* maxSamples : { &settings_.directChartTracing_.maxSamples_,
+                &settings_.directProbesTracing_.maxSamples_, &settings_.indirectChartTracing_.maxSamples_,
+                &settings_.indirectProbesTracing_.maxSamples_ })
+            {
+                *maxSamples = ea::max(1u, (*maxSamples + numPasses - 1) / numPasses);
+            }
+        }
+        status_.numPasses_.store(numPasses, std::memory_order_relaxed);
+
+#if !defined(URHO3D_COMPUTE)
+        if (settings_.tracingBackend_ == LightTracingBackend::GPU)
+            URHO3D_LOGWARNING("GPU light tracing requires compute shaders support, CPU is used instead");
+#endif
+
         FileSystem* fs = context_->GetSubsystem<FileSystem>();
         if (!fs->CreateDir(settings_.incremental_.outputDirectory_))
         {
@@ -155,6 +194,11 @@ struct IncrementalLightBaker::Impl
             ea::sort(chunks_.begin(), chunks_.end(), compareSwizzled);
         }
 
+        // Distribute chunks between workers
+        ownedChunks_.clear();
+        for (unsigned i = workerIndex; i < chunks_.size(); i += numWorkers)
+            ownedChunks_.push_back(chunks_[i]);
+
         // Initialize GI data file
         auto gi = scene_->GetComponent<GlobalIllumination>();
         const ea::string giFileName = settings_.incremental_.outputDirectory_ + settings_.incremental_.giDataFileName_;
@@ -246,7 +290,8 @@ struct IncrementalLightBaker::Impl
         for (const IntVector3& chunk : chunks_)
         {
             BakedSceneChunk bakedChunk = CreateBakedSceneChunk(context_, *collector_, chunk, settings_);
-            numLightmapsTotal_ += bakedChunk.lightmaps_.size();
+            if (ownedChunks_.contains(chunk))
+                numLightmapsTotal_ += bakedChunk.lightmaps_.size();
             cache_->StoreBakedChunk(chunk, ea::move(bakedChunk));
         }
     }
@@ -258,9 +303,14 @@ struct IncrementalLightBaker::Impl
         status_.processedElements_.store(0, std::memory_order_relaxed);
         status_.totalElements_.store(numLightmapsTotal_, std::memory_order_relaxed);
 
-        for (const IntVector3 chunk : chunks_)
+        for (const IntVector3 chunk : ownedChunks_)
         {
             const ea::shared_ptr<const BakedSceneChunk> bakedChunk = cache_->LoadBakedChunk(chunk);
+#if defined(URHO3D_COMPUTE)
+            const SharedPtr<GpuRaytracer> gpuRaytracer = CreateGpuRaytracer(*bakedChunk->raytracerScene_);
+#else
+            GpuRaytracer* const gpuRaytracer = nullptr;
+#endif
 
             // Bake direct lighting
             for (unsigned i = 0; i < bakedChunk->lightmaps_.size(); ++i)
@@ -280,7 +330,7 @@ struct IncrementalLightBaker::Impl
                 for (const BakedLight& bakedLight : bakedChunk->bakedLights_)
                 {
                     BakeDirectLightForCharts(bakedDirect, geometryBuffer, *bakedChunk->raytracerScene_,
-                        bakedChunk->geometryBufferToRaytracer_, bakedLight, settings_.directChartTracing_);
+                        bakedChunk->geometryBufferToRaytracer_, bakedLight, settings_.directChartTracing_, gpuRaytracer);
                 }
 
                 // Store direct light
@@ -306,7 +356,7 @@ struct IncrementalLightBaker::Impl
         LightProbeCollectionBakedData lightProbesBakedData;
         LightmapChartBakedIndirect bakedIndirect{ settings_.charting_.lightmapSize_ };
 
-        for (const IntVector3 chunk : chunks_)
+        for (const IntVector3 chunk : ownedChunks_)
         {
             if (stopToken.IsStopped())
                 return false;
@@ -329,6 +379,12 @@ struct IncrementalLightBaker::Impl
             BakeIndirectLightForLightProbes(lightProbesBakedData, bakedChunk->lightProbesCollection_,
                 bakedDirectLightmaps, *bakedChunk->raytracerScene_, settings_.indirectProbesTracing_);
 
+#if defined(URHO3D_COMPUTE)
+            const SharedPtr<GpuRaytracer> gpuRaytracer = CreateGpuRaytracer(*bakedChunk->raytracerScene_);
+#else
+            GpuRaytracer* const gpuRaytracer = nullptr;
+#endif
+
             // Build light probes mesh for fallback indirect
             TetrahedralMesh lightProbesMesh;
             lightProbesMesh.Define(bakedChunk->lightProbesCollection_.worldPositions_);
@@ -349,7 +405,7 @@ struct IncrementalLightBaker::Impl
                 BakeIndirectLightForCharts(bakedIndirect, bakedDirectLightmaps,
                     geometryBuffer, lightProbesMesh, lightProbesBakedData,
                     *bakedChunk->raytracerScene_, bakedChunk->geometryBufferToRaytracer_,
-                    settings_.indirectChartTracing_);
+                    settings_.indirectChartTracing_, gpuRaytracer);
 
                 // Filter direct and indirect
                 bakedIndirect.NormalizeLight();
@@ -376,7 +432,9 @@ struct IncrementalLightBaker::Impl
                     bakedLightmap.lightmap_[i] += VectorMax(Vector3::ZERO, indirectLight);
                 }
 
-                // Store lightmap
+                // Accumulate with previous passes and store lightmap
+                if (passIndex_ > 0)
+                    AccumulatePreviousPasses(bakedLightmap, cache_->LoadLightmap(lightmapIndex));
                 cache_->StoreLightmap(lightmapIndex, ea::move(bakedLightmap));
 
                 status_.processedElements_.fetch_add(1u, std::memory_order_relaxed);
@@ -390,12 +448,84 @@ struct IncrementalLightBaker::Impl
                     bakedLight, settings_.directProbesTracing_);
             }
 
-            // Save light probes
+            // Accumulate with previous passes and store light probes
+            LightProbeCollectionBakedData accumulatedLightProbesBakedData = lightProbesBakedData;
+            if (passIndex_ > 0)
+                AccumulatePreviousPasses(accumulatedLightProbesBakedData, cache_->LoadLightProbes(chunk));
+            cache_->StoreLightProbes(chunk, ea::move(accumulatedLightProbesBakedData));
+        }
+
+        return true;
+    }
+
+    /// Wait until direct light required by owned chunks is baked by other workers.
+    bool WaitForDirectLight(StopToken stopToken)
+    {
+        if (settings_.incremental_.numWorkers_ <= 1)
+            return true;
+
+        ea::vector<unsigned> requiredLightmaps;
+        for (const IntVector3 chunk : ownedChunks_)
+        {
+            const ea::shared_ptr<const BakedSceneChunk> bakedChunk = cache_->LoadBakedChunk(chunk);
+            requiredLightmaps.insert(requiredLightmaps.end(),
+                bakedChunk->requiredDirectLightmaps_.begin(), bakedChunk->requiredDirectLightmaps_.end());
+        }
+
+        return WaitForWorkers(stopToken, [&]()
+        {
+            return ea::all_of(requiredLightmaps.begin(), requiredLightmaps.end(),
+                [&](unsigned lightmapIndex) { return cache_->LoadDirectLight(lightmapIndex) != nullptr; });
+        });
+    }
+
+    /// Wait until all chunks are baked by other workers. Only main worker waits.
+    bool WaitForAllChunks(StopToken stopToken)
+    {
+        if (settings_.incremental_.numWorkers_ > 1 && settings_.incremental_.workerIndex_ == 0)
+        {
+            const bool finished = WaitForWorkers(stopToken, [&]()
+            {
+                for (const IntVector3 chunk : chunks_)
+                {
+                    const ea::shared_ptr<const BakedSceneChunk> bakedChunk = cache_->LoadBakedChunk(chunk);
+                    for (unsigned lightmapIndex : bakedChunk->lightmaps_)
+                    {
+                        if (!cache_->LoadLightmap(lightmapIndex))
+                            return false;
+                    }
+                    if (!cache_->LoadLightProbes(chunk))
+                        return false;
+                }
+                return true;
+            });
+
+            if (!finished)
+                return false;
+        }
+
+        status_.phase_.store(IncrementalLightBakerPhase::Finalizing, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// Save light probes for all chunks.
+    void SaveLightProbes()
+    {
+        for (const IntVector3 chunk : chunks_)
+        {
+            const ea::shared_ptr<const BakedSceneChunk> bakedChunk = cache_->LoadBakedChunk(chunk);
+            const ea::shared_ptr<const LightProbeCollectionBakedData> lightProbesBakedData = cache_->LoadLightProbes(chunk);
+            if (!lightProbesBakedData)
+            {
+                URHO3D_LOGERROR("Light probes for chunk {} are not baked", chunk.ToString());
+                continue;
+            }
+
             for (unsigned groupIndex = 0; groupIndex < bakedChunk->numUniqueLightProbes_; ++groupIndex)
             {
                 const ea::string fileName = GetLightProbeBakedDataFileName(chunk, groupIndex);
                 if (!LightProbeGroup::SaveLightProbesBakedData(context_, fileName,
-                    bakedChunk->lightProbesCollection_, lightProbesBakedData, groupIndex))
+                    bakedChunk->lightProbesCollection_, *lightProbesBakedData, groupIndex))
                 {
                     const ea::string groupName = groupIndex < bakedChunk->lightProbesCollection_.GetNumGroups()
                         ? bakedChunk->lightProbesCollection_.names_[groupIndex] : "";
@@ -404,9 +534,6 @@ struct IncrementalLightBaker::Impl
                 }
             }
         }
-
-        status_.phase_.store(IncrementalLightBakerPhase::Finalizing, std::memory_order_relaxed);
-        return true;
     }
 
     // Stitch and save lightmaps.
@@ -437,6 +564,11 @@ struct IncrementalLightBaker::Impl
                 const unsigned lightmapIndex = bakedChunk->lightmaps_[i];
                 const ea::shared_ptr<const BakedLightmap> bakedLightmap = cache_->LoadLightmap(lightmapIndex);
                 const LightmapChartGeometryBuffer& geometryBuffer = bakedChunk->geometryBuffers_[i];
+                if (!bakedLightmap)
+                {
+                    URHO3D_LOGERROR("Lightmap {} is not baked", lightmapIndex);
+                    continue;
+                }
 
                 // Stitch seams or just copy data to buffer
                 if (settings_.stitching_.numIterations_ > 0 && !geometryBuffer.seams_.empty())
@@ -473,9 +605,93 @@ struct IncrementalLightBaker::Impl
         }
     }
 
+    /// Finish current pass.
+    void EndPass()
+    {
+        ++passIndex_;
+        status_.passIndex_.store(ea::min(passIndex_, settings_.incremental_.numPasses_ - 1), std::memory_order_relaxed);
+    }
+
+    /// Return whether all passes are baked.
+    bool IsFinished() const { return passIndex_ >= settings_.incremental_.numPasses_; }
+
+    /// Return whether this worker saves outputs.
+    bool IsMainWorker() const { return settings_.incremental_.workerIndex_ == 0; }
+
     const IncrementalLightBakerStatus& GetStatus() const { return status_; }
 
 private:
+    /// Accumulate lightmap with results of previous passes.
+    void AccumulatePreviousPasses(BakedLightmap& bakedLightmap, const ea::shared_ptr<const BakedLightmap>& previousPasses) const
+    {
+        if (!previousPasses || previousPasses->lightmap_.size() != bakedLightmap.lightmap_.size())
+            return;
+
+        const float weight = 1.0f / (passIndex_ + 1);
+        for (unsigned i = 0; i < bakedLightmap.lightmap_.size(); ++i)
+            bakedLightmap.lightmap_[i] = Lerp(previousPasses->lightmap_[i], bakedLightmap.lightmap_[i], weight);
+    }
+
+    /// Accumulate light probes with results of previous passes.
+    void AccumulatePreviousPasses(LightProbeCollectionBakedData& bakedData,
+        const ea::shared_ptr<const LightProbeCollectionBakedData>& previousPasses) const
+    {
+        if (!previousPasses || previousPasses->Size() != bakedData.Size())
+            return;
+
+        const float weight = 1.0f / (passIndex_ + 1);
+        for (unsigned i = 0; i < bakedData.Size(); ++i)
+        {
+            SphericalHarmonicsDot9 sphericalHarmonics = previousPasses->sphericalHarmonics_[i] * (1.0f - weight);
+            sphericalHarmonics += bakedData.sphericalHarmonics_[i] * weight;
+            bakedData.sphericalHarmonics_[i] = sphericalHarmonics;
+            bakedData.ambient_[i] = Lerp(previousPasses->ambient_[i], bakedData.ambient_[i], weight);
+        }
+    }
+
+    /// Wait until predicate is satisfied. Return false if canceled.
+    template <class T>
+    bool WaitForWorkers(StopToken stopToken, const T& isReady)
+    {
+        status_.phase_.store(IncrementalLightBakerPhase::WaitingForWorkers, std::memory_order_relaxed);
+        while (!isReady())
+        {
+            if (stopToken.IsStopped())
+                return false;
+            Time::Sleep(WorkerPollingInterval);
+        }
+        return true;
+    }
+
+#if defined(URHO3D_COMPUTE)
+    /// Create GPU raytracer for chunk if requested and supported. Return null if rays should be traced on CPU.
+    SharedPtr<GpuRaytracer> CreateGpuRaytracer(const RaytracerScene& raytracerScene)
+    {
+        if (settings_.tracingBackend_ != LightTracingBackend::GPU)
+            return nullptr;
+
+        // Compute device can be used only from main thread
+        if (!Thread::IsMainThread())
+        {
+            if (!gpuFallbackReported_)
+                URHO3D_LOGWARNING("GPU light tracing is available only for synchronous baking, CPU is used instead");
+            gpuFallbackReported_ = true;
+            return nullptr;
+        }
+
+        auto gpuRaytracer = MakeShared<GpuRaytracer>(context_);
+        if (!gpuRaytracer->IsSupported() || !gpuRaytracer->Initialize(raytracerScene))
+        {
+            if (!gpuFallbackReported_)
+                URHO3D_LOGWARNING("GPU light tracing is not supported, CPU is used instead");
+            gpuFallbackReported_ = true;
+            return nullptr;
+        }
+
+        return gpuRaytracer;
+    }
+#endif
+
     /// Return lightmap file name.
     ea::string GetLightmapFileName(unsigned lightmapIndex)
     {
@@ -505,8 +721,14 @@ private:
     BakedSceneCollector* collector_{};
     /// Lightmap cache.
     BakedLightCache* cache_{};
+    /// Whether the fallback from GPU to CPU tracing is already reported.
+    bool gpuFallbackReported_{};
     /// List of all chunks.
     ea::vector<IntVector3> chunks_;
+    /// List of chunks baked by this worker.
+    ea::vector<IntVector3> ownedChunks_;
+    /// Index of current progressive pass.
+    unsigned passIndex_{};
     /// Number of lightmap charts.
     unsigned numLightmapCharts_{};
 
@@ -518,15 +740,20 @@ ea::string IncrementalLightBakerStatus::ToString() const
 {
     const unsigned current = processedElements_.load(std::memory_order_relaxed);
     const unsigned total = totalElements_.load(std::memory_order_relaxed);
+    const unsigned numPasses = numPasses_.load(std::memory_order_relaxed);
+    const ea::string pass = numPasses > 1
+        ? Format("Pass {}/{}: ", passIndex_.load(std::memory_order_relaxed) + 1, numPasses) : "";
 
     switch (phase_.load(std::memory_order_relaxed))
     {
     case IncrementalLightBakerPhase::Finalizing:
         return "Finalizing...";
+    case IncrementalLightBakerPhase::WaitingForWorkers:
+        return "Waiting for other workers...";
     case IncrementalLightBakerPhase::BakingDirectLighting:
-        return Format("Baking direct lighting: {}/{} lightmaps...", current, total);
+        return Format("{}Baking direct lighting: {}/{} lightmaps...", pass, current, total);
     case IncrementalLightBakerPhase::BakingIndirectLighting:
-        return Format("Baking indirect lighting: {}/{} lightmaps...", current, total);
+        return Format("{}Baking indirect lighting: {}/{} lightmaps...", pass, current, total);
     case IncrementalLightBakerPhase::NotStarted:
     default:
         return "Not started.";
@@ -559,15 +786,31 @@ bool IncrementalLightBaker::Bake(StopToken stopToken)
     if (!impl_->BakeDirectCharts(stopToken))
         return false;
 
+    if (!impl_->WaitForDirectLight(stopToken))
+        return false;
+
     if (!impl_->BakeIndirectAndFilter(stopToken))
         return false;
 
+    if (!impl_->WaitForAllChunks(stopToken))
+        return false;
+
+    impl_->EndPass();
     return true;
 }
 
+bool IncrementalLightBaker::IsFinished() const
+{
+    return impl_->IsFinished();
+}
+
 void IncrementalLightBaker::CommitScene()
 {
+    if (!impl_->IsMainWorker())
+        return;
+
     impl_->StitchAndSaveImages();
+    impl_->SaveLightProbes();
 }
 
 const IncrementalLightBakerStatus& IncrementalLightBaker::GetStatus() const
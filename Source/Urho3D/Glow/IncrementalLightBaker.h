@@ -40,6 +40,7 @@ enum class IncrementalLightBakerPhase
     NotStarted,
     BakingDirectLighting,
     BakingIndirectLighting,
+    WaitingForWorkers,
     Finalizing
 };
 
@@ -48,6 +49,8 @@ struct IncrementalLightBakerStatus
     std::atomic<IncrementalLightBakerPhase> phase_{ IncrementalLightBakerPhase::NotStarted };
     std::atomic_uint32_t processedElements_{ 0 };
     std::atomic_uint32_t totalElements_{ 0 };
+    std::atomic_uint32_t passIndex_{ 0 };
+    std::atomic_uint32_t numPasses_{ 1 };
 
     ea::string ToString() const;
 };
@@ -67,10 +70,14 @@ public:
     /// Process and update the scene. Scene collector is used here.
     void ProcessScene();
     /// Bake lighting and save results.
+    /// If progressive baking is enabled, bake next pass and accumulate it with previous passes.
     /// It is safe to call Bake from another thread as long as lightmap cache is safe to use from said thread.
     /// Return false if canceled.
     bool Bake(StopToken stopToken);
+    /// Return whether all passes are baked.
+    bool IsFinished() const;
     /// Commit the rest of changes to scene. Scene collector is used here.
+    /// Outputs are saved only by main worker if baking is distributed.
     void CommitScene();
 
     /// Return current status. Thread-safe.
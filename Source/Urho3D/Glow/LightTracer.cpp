@@ -23,6 +23,7 @@
 #include "../Precompiled.h"
 
 #include "../Glow/BakedSceneChunk.h"
+#include "../Glow/GpuRaytracer.h"
 #include "../Glow/Helpers.h"
 #include "../Glow/RaytracerScene.h"
 #include "../Glow/LightTracer.h"
@@ -932,6 +933,346 @@ void TraceIndirectLight(T sharedKernel, const ea::vector<const LightmapChartBake
     });
 }
 
+#if defined(URHO3D_COMPUTE)
+/// Max number of rays traced on GPU in one batch.
+const unsigned MaxGpuRaysPerBatch = 1024 * 1024;
+
+/// Trace direct lighting for charts on GPU. Rays that hit non-opaque geometry are traced again on CPU.
+template <class U>
+void TraceDirectLightForChartsOnGpu(const ChartDirectTracingKernel& sharedKernel, const U& sharedGenerator,
+    const RaytracerScene& raytracerScene, GpuRaytracer& gpuRaytracer, const DirectLightTracingSettings& settings)
+{
+    RTCScene scene = raytracerScene.GetEmbreeScene();
+
+    const unsigned numElements = sharedKernel.GetNumElements();
+    const unsigned numSamples = sharedKernel.GetNumSamples();
+    const unsigned maxElementsPerBatch = ea::max(1u, MaxGpuRaysPerBatch / numSamples);
+
+    ea::vector<GpuRay> rays;
+    ea::vector<Vector3> lightIntensities;
+    ea::vector<Vector3> lightDirections;
+    ea::vector<GpuRayOcclusion> occlusion;
+
+    for (unsigned batchBegin = 0; batchBegin < numElements; batchBegin += maxElementsPerBatch)
+    {
+        const unsigned batchSize = ea::min(numElements - batchBegin, maxElementsPerBatch);
+
+        // Rays with zero mask are ignored
+        rays.clear();
+        rays.resize(batchSize * numSamples);
+        lightIntensities.resize(batchSize * numSamples);
+        lightDirections.resize(batchSize * numSamples);
+
+        // Generate rays
+        ParallelFor(batchSize, settings.numTasks_,
+            [&](unsigned fromIndex, unsigned toIndex)
+        {
+            auto kernel = sharedKernel;
+            auto generator = sharedGenerator;
+            auto rayContext = kernel.GetRayContext();
+
+            for (unsigned index = fromIndex; index < toIndex; ++index)
+            {
+                Vector3 position;
+                if (!kernel.BeginElement(batchBegin + index, rayContext, position))
+                    continue;
+
+                for (unsigned sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+                {
+                    kernel.BeginSample(sampleIndex);
+
+                    const unsigned rayIndex = index * numSamples + sampleIndex;
+                    Vector3 rayOffset;
+                    if (!generator.Generate(position, rayOffset, lightIntensities[rayIndex], lightDirections[rayIndex]))
+                        continue;
+
+                    GpuRay& ray = rays[rayIndex];
+                    ray.origin_ = position - rayOffset;
+                    ray.direction_ = rayOffset;
+                    ray.maxDistance_ = 1.0f;
+                    ray.mask_ = kernel.GetGeometryMask();
+                    ray.sourceGeometry_ = rayContext.currentGeometry_->raytracerGeometryId_;
+                }
+            }
+        });
+
+        // Trace everything on CPU if GPU failed
+        if (!gpuRaytracer.TraceOcclusion(rays, occlusion))
+            occlusion.assign(rays.size(), GpuRayOcclusion::Unresolved);
+
+        // Accumulate light
+        ParallelFor(batchSize, settings.numTasks_,
+            [&](unsigned fromIndex, unsigned toIndex)
+        {
+            auto kernel = sharedKernel;
+            auto rayContext = kernel.GetRayContext();
+
+            Vector3 incomingLightIntensity;
+            rayContext.incomingLight_ = &incomingLightIntensity;
+
+            RTCRayHit rayHit;
+            rayHit.ray.mask = sharedKernel.GetGeometryMask();
+            rayHit.ray.tnear = 0.0f;
+            rayHit.ray.time = 0.0f;
+            rayHit.ray.id = 0;
+            rayHit.ray.flags = 0;
+
+            for (unsigned index = fromIndex; index < toIndex; ++index)
+            {
+                const unsigned elementIndex = batchBegin + index;
+                Vector3 position;
+                if (!kernel.BeginElement(elementIndex, rayContext, position))
+                    continue;
+
+                for (unsigned sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+                {
+                    const unsigned rayIndex = index * numSamples + sampleIndex;
+                    const GpuRay& ray = rays[rayIndex];
+                    if (!ray.mask_ || occlusion[rayIndex] == GpuRayOcclusion::Occluded)
+                        continue;
+
+                    incomingLightIntensity = lightIntensities[rayIndex];
+                    if (occlusion[rayIndex] == GpuRayOcclusion::Unresolved)
+                    {
+                        rayHit.ray.dir_x = ray.direction_.x_;
+                        rayHit.ray.dir_y = ray.direction_.y_;
+                        rayHit.ray.dir_z = ray.direction_.z_;
+                        rayHit.ray.org_x = ray.origin_.x_;
+                        rayHit.ray.org_y = ray.origin_.y_;
+                        rayHit.ray.org_z = ray.origin_.z_;
+                        rayHit.ray.tfar = ray.maxDistance_;
+                        rayHit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+                        rtcIntersect1(scene, &rayContext, &rayHit);
+
+                        if (rayHit.hit.geomID != RTC_INVALID_GEOMETRY_ID)
+                            continue;
+                    }
+
+                    kernel.EndSample(incomingLightIntensity, lightDirections[rayIndex]);
+                }
+
+                kernel.EndElement(elementIndex);
+            }
+        });
+    }
+}
+
+/// State of indirect light path traced on GPU.
+struct IndirectLightPath
+{
+    /// Current position.
+    Vector3 position_;
+    /// Current ray direction.
+    Vector3 direction_;
+    /// Factor applied to incoming light.
+    Vector3 incomingFactor_;
+    /// Accumulated color.
+    Vector3 sampleColor_;
+    /// Background index.
+    unsigned backgroundIndex_{};
+    /// Number of bounces.
+    unsigned numBounces_{};
+    /// Whether the path is still traced.
+    bool active_{};
+};
+
+/// Trace indirect lighting for charts on GPU, one bounce at a time. Rays that hit non-opaque geometry are traced again on CPU.
+void TraceIndirectLightForChartsOnGpu(const ChartIndirectTracingKernel& sharedKernel,
+    const ea::vector<const LightmapChartBakedDirect*>& bakedDirect, const RaytracerScene& raytracerScene,
+    GpuRaytracer& gpuRaytracer, const IndirectLightTracingSettings& settings)
+{
+    assert(settings.maxBounces_ <= IndirectLightTracingSettings::MaxBounces);
+
+    RTCScene scene = raytracerScene.GetEmbreeScene();
+    const float maxDistance = raytracerScene.GetMaxDistance();
+    const auto& geometryIndex = raytracerScene.GetGeometries();
+    const auto& backgrounds = raytracerScene.GetBackgrounds();
+
+    const unsigned numElements = sharedKernel.GetNumElements();
+    const unsigned numSamples = sharedKernel.GetNumSamples();
+    const unsigned maxElementsPerBatch = ea::max(1u, MaxGpuRaysPerBatch / ea::max(1u, numSamples));
+
+    ea::vector<IndirectLightPath> paths;
+    ea::vector<unsigned char> activeElements;
+    ea::vector<GpuRay> rays;
+    ea::vector<unsigned> rayPaths;
+    ea::vector<GpuRayHit> hits;
+
+    for (unsigned batchBegin = 0; batchBegin < numElements; batchBegin += maxElementsPerBatch)
+    {
+        const unsigned batchSize = ea::min(numElements - batchBegin, maxElementsPerBatch);
+
+        paths.clear();
+        paths.resize(batchSize * numSamples);
+        activeElements.clear();
+        activeElements.resize(batchSize, 0);
+
+        // Begin paths
+        ParallelFor(batchSize, settings.numTasks_,
+            [&](unsigned fromIndex, unsigned toIndex)
+        {
+            auto kernel = sharedKernel;
+            for (unsigned index = fromIndex; index < toIndex; ++index)
+            {
+                if (!kernel.BeginElement(batchBegin + index))
+                    continue;
+
+                activeElements[index] = 1;
+                for (unsigned sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+                {
+                    IndirectLightPath& path = paths[index * numSamples + sampleIndex];
+                    Vector3 faceNormal;
+                    Vector3 smoothNormal;
+                    kernel.BeginSample(sampleIndex, path.position_, faceNormal, smoothNormal, path.direction_, path.incomingFactor_);
+                    path.backgroundIndex_ = kernel.GetElementBackgroundIndex();
+                    path.active_ = true;
+                }
+            }
+        });
+
+        for (unsigned bounceIndex = 0; bounceIndex < settings.maxBounces_; ++bounceIndex)
+        {
+            rays.clear();
+            rayPaths.clear();
+            for (unsigned pathIndex = 0; pathIndex < paths.size(); ++pathIndex)
+            {
+                const IndirectLightPath& path = paths[pathIndex];
+                if (!path.active_)
+                    continue;
+
+                GpuRay& ray = rays.emplace_back();
+                ray.origin_ = path.position_;
+                ray.direction_ = path.direction_;
+                ray.maxDistance_ = maxDistance;
+                ray.mask_ = RaytracerScene::PrimaryLODGeometry;
+                rayPaths.push_back(pathIndex);
+            }
+
+            if (rays.empty())
+                break;
+
+            // Trace everything on CPU if GPU failed
+            if (!gpuRaytracer.TraceClosestHit(rays, hits))
+            {
+                GpuRayHit unresolvedHit;
+                unresolvedHit.geometryId_ = GpuRayHit::Unresolved;
+                hits.assign(rays.size(), unresolvedHit);
+            }
+
+            // Process hits
+            ParallelFor(rays.size(), settings.numTasks_,
+                [&](unsigned fromIndex, unsigned toIndex)
+            {
+                RTCRayHit rayHit;
+                IndirectTracingContext rayContext;
+                rtcInitIntersectContext(&rayContext);
+                rayContext.geometryIndex_ = &geometryIndex;
+                rayContext.filter = TracingFilterIndirect;
+
+                rayHit.ray.tnear = 0.0f;
+                rayHit.ray.time = 0.0f;
+                rayHit.ray.id = 0;
+                rayHit.ray.mask = RaytracerScene::PrimaryLODGeometry;
+                rayHit.ray.flags = 0;
+
+                for (unsigned rayIndex = fromIndex; rayIndex < toIndex; ++rayIndex)
+                {
+                    IndirectLightPath& path = paths[rayPaths[rayIndex]];
+                    GpuRayHit hit = hits[rayIndex];
+
+                    if (hit.geometryId_ == GpuRayHit::Unresolved)
+                    {
+                        rayHit.ray.org_x = path.position_.x_;
+                        rayHit.ray.org_y = path.position_.y_;
+                        rayHit.ray.org_z = path.position_.z_;
+                        rayHit.ray.dir_x = path.direction_.x_;
+                        rayHit.ray.dir_y = path.direction_.y_;
+                        rayHit.ray.dir_z = path.direction_.z_;
+                        rayHit.ray.tfar = maxDistance;
+                        rayHit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+                        rtcIntersect1(scene, &rayContext, &rayHit);
+
+                        hit.geometryId_ = rayHit.hit.geomID == RTC_INVALID_GEOMETRY_ID ? GpuRayHit::NoHit : rayHit.hit.geomID;
+                        hit.primitiveId_ = rayHit.hit.primID;
+                        hit.u_ = rayHit.hit.u;
+                        hit.v_ = rayHit.hit.v;
+                        hit.normal_ = { rayHit.hit.Ng_x, rayHit.hit.Ng_y, rayHit.hit.Ng_z };
+                        hit.distance_ = rayHit.ray.tfar;
+                    }
+
+                    // If hit background, pick light and stop
+                    if (hit.geometryId_ == GpuRayHit::NoHit)
+                    {
+                        const BakedSceneBackground& background = (*backgrounds)[path.backgroundIndex_];
+                        path.sampleColor_ += path.incomingFactor_ * background.SampleLinear(path.direction_);
+                        ++path.numBounces_;
+                        path.active_ = false;
+                        continue;
+                    }
+
+                    // Check normal orientation
+                    if (path.direction_.DotProduct(hit.normal_) > 0.0f)
+                    {
+                        path.active_ = false;
+                        continue;
+                    }
+
+                    // Sample lightmap UV
+                    const RaytracerGeometry& geometry = geometryIndex[hit.geometryId_];
+                    Vector2 lightmapUV;
+                    rtcInterpolate0(geometry.embreeGeometry_, hit.primitiveId_, hit.u_, hit.v_,
+                        RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE, RaytracerScene::LightmapUVAttribute, &lightmapUV.x_, 2);
+
+                    // Modify incoming flux
+                    const unsigned lightmapIndex = geometry.lightmapIndex_;
+                    const IntVector2 sampleLocation = bakedDirect[lightmapIndex]->GetNearestLocation(lightmapUV);
+                    path.sampleColor_ += path.incomingFactor_ * bakedDirect[lightmapIndex]->GetSurfaceLight(sampleLocation);
+                    ++path.numBounces_;
+
+                    if (path.numBounces_ >= settings.maxBounces_)
+                    {
+                        path.active_ = false;
+                        continue;
+                    }
+
+                    // Update albedo for hit surface
+                    path.incomingFactor_ *= bakedDirect[lightmapIndex]->GetAlbedo(sampleLocation);
+
+                    // Move to hit position and offset it a bit
+                    path.position_ += path.direction_ * hit.distance_;
+
+                    const Vector3 hitNormal = hit.normal_.Normalized();
+                    const float bias = settings.scaledPositionBounceBias_ * CalculateBiasScale(path.position_);
+                    path.position_.x_ += Sign(hitNormal.x_) * bias + hitNormal.x_ * settings.constPositionBounceBias_;
+                    path.position_.y_ += Sign(hitNormal.y_) * bias + hitNormal.y_ * settings.constPositionBounceBias_;
+                    path.position_.z_ += Sign(hitNormal.z_) * bias + hitNormal.z_ * settings.constPositionBounceBias_;
+
+                    // Find new direction to sample
+                    path.direction_ = RandomHemisphereDirectionCos(hitNormal);
+                }
+            });
+        }
+
+        // Accumulate samples
+        ParallelFor(batchSize, settings.numTasks_,
+            [&](unsigned fromIndex, unsigned toIndex)
+        {
+            for (unsigned index = fromIndex; index < toIndex; ++index)
+            {
+                if (!activeElements[index])
+                    continue;
+
+                Vector4 accumulatedIndirectLight;
+                for (unsigned sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex)
+                    accumulatedIndirectLight += Vector4{ paths[index * numSamples + sampleIndex].sampleColor_, 1.0f };
+
+                sharedKernel.bakedIndirect_->light_[batchBegin + index] += accumulatedIndirectLight;
+            }
+        });
+    }
+}
+#endif
+
 }
 
 void PreprocessGeometryBuffer(LightmapChartGeometryBuffer& geometryBuffer,
@@ -1051,7 +1392,7 @@ void BakeEmissionLight(LightmapChartBakedDirect& bakedDirect, const LightmapChar
 
 void BakeDirectLightForCharts(LightmapChartBakedDirect& bakedDirect, const LightmapChartGeometryBuffer& geometryBuffer,
     const RaytracerScene& raytracerScene, const ea::vector<unsigned>& geometryBufferToRaytracer,
-    const BakedLight& light, const DirectLightTracingSettings& settings)
+    const BakedLight& light, const DirectLightTracingSettings& settings, GpuRaytracer* gpuRaytracer)
 {
     const bool bakeDirect = light.lightMode_ == LM_BAKED;
     const bool bakeIndirect = true;
@@ -1060,22 +1401,34 @@ void BakeDirectLightForCharts(LightmapChartBakedDirect& bakedDirect, const Light
         &raytracerScene.GetGeometries(), &settings, light.indirectBrightness_, numSamples,
         bakeDirect, bakeIndirect, light.lightMask_ };
 
+    const auto traceDirectLight = [&](const auto& generator)
+    {
+#if defined(URHO3D_COMPUTE)
+        if (gpuRaytracer)
+        {
+            TraceDirectLightForChartsOnGpu(kernel, generator, raytracerScene, *gpuRaytracer, settings);
+            return;
+        }
+#endif
+        TraceDirectLight(kernel, generator, raytracerScene, settings);
+    };
+
     if (light.lightType_ == LIGHT_DIRECTIONAL)
     {
         const RayGeneratorForDirectLight generator{ light.color_, light.direction_, light.rotation_,
             raytracerScene.GetMaxDistance(), light.halfAngleTan_ };
-        TraceDirectLight(kernel, generator, raytracerScene, settings);
+        traceDirectLight(generator);
     }
     else if (light.lightType_ == LIGHT_POINT)
     {
         const RayGeneratorForPointLight generator{ light.color_, light.position_, light.distance_, light.radius_ };
-        TraceDirectLight(kernel, generator, raytracerScene, settings);
+        traceDirectLight(generator);
     }
     else if (light.lightType_ == LIGHT_SPOT)
     {
         const RayGeneratorForSpotLight generator{ light.color_, light.position_, light.direction_, light.rotation_,
             light.distance_, light.radius_, light.cutoff_ };
-        TraceDirectLight(kernel, generator, raytracerScene, settings);
+        traceDirectLight(generator);
     }
 }
 
@@ -1111,13 +1464,22 @@ void BakeIndirectLightForCharts(LightmapChartBakedIndirect& bakedIndirect,
     const ea::vector<const LightmapChartBakedDirect*>& bakedDirect, const LightmapChartGeometryBuffer& geometryBuffer,
     const TetrahedralMesh& lightProbesMesh, const LightProbeCollectionBakedData& lightProbesData,
     const RaytracerScene& raytracerScene, const ea::vector<unsigned>& geometryBufferToRaytracer,
-    const IndirectLightTracingSettings& settings)
+    const IndirectLightTracingSettings& settings, GpuRaytracer* gpuRaytracer)
 {
     if (settings.maxBounces_ == 0)
         return;
 
     const ChartIndirectTracingKernel kernel{ &bakedIndirect, &geometryBuffer, &lightProbesMesh, &lightProbesData,
         &geometryBufferToRaytracer, &raytracerScene.GetGeometries(), &settings };
+
+#if defined(URHO3D_COMPUTE)
+    if (gpuRaytracer)
+    {
+        TraceIndirectLightForChartsOnGpu(kernel, bakedDirect, raytracerScene, *gpuRaytracer, settings);
+        return;
+    }
+#endif
+
     TraceIndirectLight(kernel, bakedDirect, raytracerScene, settings);
 }
 
@@ -32,6 +32,7 @@
 namespace Urho3D
 {
 
+class GpuRaytracer;
 class RaytracerScene;
 class TetrahedralMesh;
 struct LightProbeCollectionForBaking;
@@ -119,9 +120,10 @@ URHO3D_API void BakeEmissionLight(LightmapChartBakedDirect& bakedDirect, const L
     const EmissionLightTracingSettings& settings, float indirectBrightnessMultiplier);
 
 /// Accumulate direct light for charts.
+/// If GPU raytracer is specified, rays are traced on GPU and only rays hitting non-opaque geometry are traced on CPU.
 URHO3D_API void BakeDirectLightForCharts(LightmapChartBakedDirect& bakedDirect, const LightmapChartGeometryBuffer& geometryBuffer,
     const RaytracerScene& raytracerScene, const ea::vector<unsigned>& geometryBufferToRaytracer,
-    const BakedLight& light, const DirectLightTracingSettings& settings);
+    const BakedLight& light, const DirectLightTracingSettings& settings, GpuRaytracer* gpuRaytracer = nullptr);
 
 /// Accumulate direct light for light probes.
 URHO3D_API void BakeDirectLightForLightProbes(
@@ -129,11 +131,12 @@ URHO3D_API void BakeDirectLightForLightProbes(
     const RaytracerScene& raytracerScene, const BakedLight& light, const DirectLightTracingSettings& settings);
 
 /// Accumulate indirect light for charts.
+/// If GPU raytracer is specified, rays are traced on GPU and only rays hitting non-opaque geometry are traced on CPU.
 URHO3D_API void BakeIndirectLightForCharts(LightmapChartBakedIndirect& bakedIndirect,
     const ea::vector<const LightmapChartBakedDirect*>& bakedDirect, const LightmapChartGeometryBuffer& geometryBuffer,
     const TetrahedralMesh& lightProbesMesh, const LightProbeCollectionBakedData& lightProbesData,
     const RaytracerScene& raytracerScene, const ea::vector<unsigned>& geometryBufferToRaytracer,
-    const IndirectLightTracingSettings& settings);
+    const IndirectLightTracingSettings& settings, GpuRaytracer* gpuRaytracer = nullptr);
 
 /// Accumulate indirect light for light probes.
 URHO3D_API void BakeIndirectLightForLightProbes(
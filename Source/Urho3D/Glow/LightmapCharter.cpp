@@ -77,8 +77,10 @@ IntVector2 AdjustRegionSize(const IntVector2& desiredSize, int maxSize)
 };
 
 /// Allocate region in the set of lightmap charts.
+/// Smallest sizes that failed to allocate are tracked per chart so that full charts are skipped without searching.
 LightmapChartRegion AllocateLightmapChartRegion(const LightmapChartingSettings& settings,
-    ea::vector<LightmapChart>& charts, const IntVector2& size, unsigned baseChartIndex)
+    ea::vector<LightmapChart>& charts, ea::vector<IntVector2>& failedSizes, const IntVector2& size,
+    unsigned baseChartIndex)
 {
     const int padding = static_cast<int>(settings.padding_);
     const IntVector2 paddedSize = size + 2 * padding * IntVector2::ONE;
@@ -87,17 +89,23 @@ LightmapChartRegion AllocateLightmapChartRegion(const LightmapChartingSettings&
     unsigned chartIndex = 0;
     for (LightmapChart& lightmapDesc : charts)
     {
-        IntVector2 paddedPosition;
-        if (lightmapDesc.allocator_.Allocate(paddedSize.x_, paddedSize.y_, paddedPosition.x_, paddedPosition.y_))
+        IntVector2& failedSize = failedSizes[chartIndex];
+        if (paddedSize.x_ < failedSize.x_ || paddedSize.y_ < failedSize.y_)
         {
-            const IntVector2 position = paddedPosition + padding * IntVector2::ONE;
-            return { chartIndex, position, size, settings.lightmapSize_ };
+            IntVector2 paddedPosition;
+            if (lightmapDesc.allocator_.Allocate(paddedSize.x_, paddedSize.y_, paddedPosition.x_, paddedPosition.y_))
+            {
+                const IntVector2 position = paddedPosition + padding * IntVector2::ONE;
+                return { chartIndex, position, size, settings.lightmapSize_ };
+            }
+            failedSize = paddedSize;
         }
         ++chartIndex;
     }
 
     // Create general-purpose chart
     LightmapChart& chart = charts.emplace_back(chartIndex + baseChartIndex, settings.lightmapSize_);
+    failedSizes.push_back(IntVector2::ONE * M_MAX_INT);
 
     // Allocate region from the new chart
     IntVector2 paddedPosition;
@@ -183,16 +191,21 @@ ea::vector<LightmapChart> GenerateLightmapCharts(
     {
         const IntVector2& lhsRegion = lhs.adjustedRegionSize_;
         const IntVector2& rhsRegion = rhs.adjustedRegionSize_;
-        return ea::max(lhsRegion.x_, lhsRegion.y_) > ea::max(rhsRegion.x_, rhsRegion.y_);
+        const int lhsMax = ea::max(lhsRegion.x_, lhsRegion.y_);
+        const int rhsMax = ea::max(rhsRegion.x_, rhsRegion.y_);
+        if (lhsMax != rhsMax)
+            return lhsMax > rhsMax;
+        return ea::min(lhsRegion.x_, lhsRegion.y_) > ea::min(rhsRegion.x_, rhsRegion.y_);
     };
     ea::sort(requestedRegions.begin(), requestedRegions.end(), compareDimensions);
 
     // Generate charts
     ea::vector<LightmapChart> charts;
+    ea::vector<IntVector2> failedSizes;
     for (const RequestedChartRegion& requestedRegion : requestedRegions)
     {
         const LightmapChartRegion region = AllocateLightmapChartRegion(
-            settings, charts, requestedRegion.adjustedRegionSize_, baseChartIndex);
+            settings, charts, failedSizes, requestedRegion.adjustedRegionSize_, baseChartIndex);
 
         const LightmapChartElement chartElement{ requestedRegion.component_, requestedRegion.objectIndex_, region };
         charts[region.chartIndex_].elements_.push_back(chartElement);
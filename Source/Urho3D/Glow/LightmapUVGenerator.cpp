@@ -24,6 +24,8 @@
 
 #include "../Glow/LightmapUVGenerator.h"
 
+#include "../Core/WorkQueue.h"
+
 #include <xatlas.h>
 
 namespace Urho3D
@@ -124,4 +126,18 @@ bool GenerateLightmapUV(ModelView& modelView, const LightmapUVGenerationSettings
     return true;
 }
 
+bool GenerateLightmapUV(
+    const ea::vector<ModelView*>& models, const LightmapUVGenerationSettings& settings, WorkQueue* workQueue)
+{
+    // xatlas is built without internal threads, so models are unwrapped concurrently instead
+    std::atomic<bool> success{true};
+    ForEachParallel(workQueue, models,
+        [&](unsigned /*index*/, ModelView* model)
+    {
+        if (!GenerateLightmapUV(*model, settings))
+            success.store(false, std::memory_order_relaxed);
+    });
+    return success.load(std::memory_order_relaxed);
+}
+
 }
@@ -31,6 +31,8 @@
 namespace Urho3D
 {
 
+class WorkQueue;
+
 /// Lightmap UV generation settings.
 struct URHO3D_API LightmapUVGenerationSettings
 {
@@ -50,4 +52,9 @@ struct URHO3D_API LightmapUVGenerationSettings
 /// Generate lightmap UVs for the model.
 bool URHO3D_API GenerateLightmapUV(ModelView& model, const LightmapUVGenerationSettings& settings);
 
+/// Generate lightmap UVs for multiple models in parallel, one model per task.
+/// Return false if generation failed for any model.
+bool URHO3D_API GenerateLightmapUV(
+    const ea::vector<ModelView*>& models, const LightmapUVGenerationSettings& settings, WorkQueue* workQueue);
+
 }
@@ -415,6 +415,8 @@ ea::vector<RaytracerGeometry> CreateRaytracerGeometriesForStaticModel(RTCDevice
             params.material_ = raytracerGeometry.material_;
             params.lightmapping_.primaryLod_ = lodIndex == 0;
 
+            raytracerGeometry.mask_ = params.lightmapping_.GetMask();
+            raytracerGeometry.numTriangles_ = geometryLODView.indices_.size() / 3;
             raytracerGeometry.embreeGeometry_ = CreateEmbreeGeometryForGeometryView(embreeDevice, params);
             result.push_back(raytracerGeometry);
         }
@@ -457,6 +459,11 @@ ea::vector<RaytracerGeometry> CreateRaytracerGeometriesForTerrain(RTCDevice embr
     params.terrain_ = terrain;
     params.material_ = raytracerGeometry.material_;
 
+    const IntVector2 numPatches = terrain->GetNumPatches();
+    const int patchSize = terrain->GetPatchSize();
+    raytracerGeometry.mask_ = params.lightmapping_.GetMask();
+    raytracerGeometry.numTriangles_ = static_cast<unsigned>(numPatches.x_ * numPatches.y_ * patchSize * patchSize * 2);
+
     raytracerGeometry.embreeGeometry_ = CreateEmbreeGeometryForTerrain(embreeDevice, params);
     return { raytracerGeometry };
 }
@@ -100,6 +100,10 @@ struct RaytracerGeometry
     unsigned lightmapIndex_{};
     /// Raytracer geometry ID, aka index of this structure in the array of geometries.
     unsigned raytracerGeometryId_{};
+    /// Geometry mask.
+    unsigned mask_{};
+    /// Number of triangles.
+    unsigned numTriangles_{};
     /// Internal geometry pointer.
     embree3::RTCGeometry embreeGeometry_{};
     /// Material.
@@ -31,6 +31,7 @@
 #include "../Graphics/AnimationState.h"
 #include "../Graphics/Batch.h"
 #include "../Graphics/Camera.h"
+#include "../Graphics/ComputeModelAnimator.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../Graphics/DrawableEvents.h"
 #include "../Graphics/Geometry.h"
@@ -65,6 +66,7 @@ AnimatedModel::AnimatedModel(Context* context) :
     forceAnimationUpdate_(false)
 {
     UpdateSoftwareSkinningState();
+    animationLodCounter_ = static_cast<unsigned>(reinterpret_cast<uintptr_t>(this) / sizeof(AnimatedModel));
 }
 
 AnimatedModel::~AnimatedModel()
@@ -98,6 +100,7 @@ void AnimatedModel::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Shadow Distance", GetShadowDistance, SetShadowDistance, float, 0.0f, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("LOD Bias", GetLodBias, SetLodBias, float, 1.0f, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Animation LOD Bias", GetAnimationLodBias, SetAnimationLodBias, float, 1.0f, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Skip Passive Bone Nodes", GetSkipPassiveBoneNodes, SetSkipPassiveBoneNodes, bool, false, AM_DEFAULT);
     URHO3D_COPY_BASE_ATTRIBUTES(Drawable);
     URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Bone Animation Enabled", GetBonesEnabledAttr, SetBonesEnabledAttr, VariantVector,
         Variant::emptyVariantVector, AM_DEFAULT | AM_NOEDIT);
@@ -231,17 +234,27 @@ void AnimatedModel::Update(const FrameInfo& frame)
     {
         // On main component, update animation and bounding box
         bool transformsDirty = false;
-        if (animationDirty_ || boneBoundingBoxDirty_)
+        if (animationDirty_ || boneBoundingBoxDirty_ || IsInterpolatingAnimation())
         {
             InitializeLocalBoneTransforms(false);
 
-            if (animationDirty_)
+            if (animationDirty_ && UpdateAndCheckAnimationTimers(frame.timeStep_))
             {
-                if (UpdateAndCheckAnimationTimers(frame.timeStep_))
-                {
-                    CalculateAnimations();
-                    transformsDirty = true;
-                }
+                const Renderer* renderer = context_->GetSubsystem<Renderer>();
+                const bool interpolate = renderer && renderer->GetAnimationLodSettings().enabled_
+                    && renderer->GetAnimationLodSettings().interpolate_ && animationLodInterval_ > 1;
+
+                BeginAnimationInterpolation(interpolate);
+                CalculateAnimations();
+                UpdatePassiveBones();
+                if (interpolate)
+                    ApplyAnimationInterpolation();
+                transformsDirty = true;
+            }
+            else if (IsInterpolatingAnimation())
+            {
+                ApplyAnimationInterpolation();
+                transformsDirty = true;
             }
 
             if (boneBoundingBoxDirty_)
@@ -255,9 +268,12 @@ void AnimatedModel::Update(const FrameInfo& frame)
             {
                 Node* node = skeleton_.GetBone(boneIndex)->node_;
                 const Transform& transform = skeletonData_[boneIndex].localToParent_;
-                if (node)
+                if (node && !passiveBones_[boneIndex])
                     octree->QueueNodeTransformUpdate(node, transform);
             }
+
+            // Passive bones don't notify the model via nodes
+            skinningDirty_ = true;
         }
     }
     else
@@ -282,7 +298,11 @@ void AnimatedModel::InitializeLocalBoneTransforms(bool reset)
         ModelAnimationOutput& output = skeletonData_[i];
 
         output.dirty_ = CHANNEL_NONE;
-        if (!reset && bone->node_)
+        if (!reset && i < passiveBones_.size() && passiveBones_[i])
+        {
+            // Node of passive bone is not updated, keep last animated transform
+        }
+        else if (!reset && bone->node_)
         {
             output.localToParent_.position_ = bone->node_->GetPosition();
             output.localToParent_.rotation_ = bone->node_->GetRotation();
@@ -333,14 +353,24 @@ void AnimatedModel::UpdateBatches(const FrameInfo& frame)
     float scale = transformedBoundingBox.Size().DotProduct(DOT_SCALE);
     float newLodDistance = frame.camera_->GetLodDistance(distance_, scale, lodBias_);
 
+    // Fraction of viewport height covered by the model
+    const Camera* camera = frame.camera_;
+    const float viewHeight = camera->IsOrthographic() ? camera->GetOrthoSize()
+        : 2.0f * Max(distance_, M_EPSILON) * tanf(camera->GetFov() * M_DEGTORAD_2);
+    const float newScreenSize = scale * camera->GetZoom() / Max(viewHeight, M_EPSILON);
+
     // If model is rendered from several views, use the minimum LOD distance for animation LOD
     if (frame.frameNumber_ != animationLodFrameNumber_)
     {
         animationLodDistance_ = newLodDistance;
+        animationScreenSize_ = newScreenSize;
         animationLodFrameNumber_ = frame.frameNumber_;
     }
     else
+    {
         animationLodDistance_ = Min(animationLodDistance_, newLodDistance);
+        animationScreenSize_ = Max(animationScreenSize_, newScreenSize);
+    }
 
     if (newLodDistance != lodDistance_)
     {
@@ -425,7 +455,7 @@ void AnimatedModel::SetModel(Model* model, bool createBones)
             geometryBoneMappings_.push_back(geometryBoneMappings[i]);
 
         // Copy morphs. Note: morph vertex buffers will be created later on-demand
-        modelAnimator_ = nullptr;
+        ResetModelAnimator();
         morphs_ = model->GetMorphs();
 
         // Copy bounding box & skeleton
@@ -439,6 +469,7 @@ void AnimatedModel::SetModel(Model* model, bool createBones)
         // Reserve space for skinning matrices
         skinMatrices_.resize(skeleton_.GetNumBones());
         skeletonData_.resize(skeleton_.GetNumBones());
+        passiveBones_.clear();
         SetGeometryBoneMappings();
 
         // Reconsider software skinning
@@ -486,9 +517,10 @@ void AnimatedModel::SetModel(Model* model, bool createBones)
         RemoveRootBone(); // Remove existing root bone if any
         SetNumGeometries(0);
         geometryBoneMappings_.clear();
-        modelAnimator_ = nullptr;
+        ResetModelAnimator();
         morphs_.clear();
         skeletonData_.clear();
+        passiveBones_.clear();
         SetBoundingBox(BoundingBox());
         SetSkeleton(Skeleton(), false);
     }
@@ -504,6 +536,22 @@ void AnimatedModel::SetUpdateInvisible(bool enable)
     updateInvisible_ = enable;
 }
 
+void AnimatedModel::SetSkipPassiveBoneNodes(bool enable)
+{
+    if (skipPassiveBoneNodes_ != enable)
+    {
+        skipPassiveBoneNodes_ = enable;
+
+        // Bring nodes of passive bones up to date
+        const bool hadPassiveBones = ea::find(passiveBones_.begin(), passiveBones_.end(), true) != passiveBones_.end();
+        passiveBones_.clear();
+        if (hadPassiveBones)
+            ApplyBoneTransformsToNodes();
+
+        MarkAnimationDirty();
+    }
+}
+
 
 void AnimatedModel::SetMorphWeight(unsigned index, float weight)
 {
@@ -511,7 +559,7 @@ void AnimatedModel::SetMorphWeight(unsigned index, float weight)
         return;
 
     // If morph vertex buffers have not been created yet, create now
-    if (weight != 0.0f && !modelAnimator_)
+    if (weight != 0.0f && !HasModelAnimator())
         CloneGeometries();
 
     if (weight != morphs_[index].weight_)
@@ -584,11 +632,16 @@ void AnimatedModel::ResetMorphWeights()
 void AnimatedModel::ResetBones()
 {
     skeleton_.Reset();
+    passiveBones_.clear();
 }
 
 const ea::vector<SharedPtr<VertexBuffer> >& AnimatedModel::GetMorphVertexBuffers() const
 {
     static const ea::vector<SharedPtr<VertexBuffer>> empty;
+#if defined(URHO3D_COMPUTE)
+    if (computeAnimator_)
+        return computeAnimator_->GetVertexBuffers();
+#endif
     return modelAnimator_ ? modelAnimator_->GetVertexBuffers() : empty;
 }
 
@@ -966,15 +1019,44 @@ void AnimatedModel::MarkMorphsDirty()
 
 void AnimatedModel::CloneGeometries()
 {
-    modelAnimator_ = MakeShared<SoftwareModelAnimator>(context_);
-    modelAnimator_->Initialize(model_, softwareSkinning_, numSoftwareSkinningBones_);
-    geometries_ = modelAnimator_->GetGeometries();
+    ResetModelAnimator();
+#if defined(URHO3D_COMPUTE)
+    if (computeSkinning_)
+    {
+        computeAnimator_ = MakeShared<ComputeModelAnimator>(context_);
+        computeAnimator_->Initialize(model_, softwareSkinning_);
+        geometries_ = computeAnimator_->GetGeometries();
+    }
+    else
+#endif
+    {
+        modelAnimator_ = MakeShared<SoftwareModelAnimator>(context_);
+        modelAnimator_->Initialize(model_, softwareSkinning_, numSoftwareSkinningBones_);
+        geometries_ = modelAnimator_->GetGeometries();
+    }
 
     // Make sure the rendering batches use the new cloned geometries
     ResetLodLevels();
     MarkMorphsDirty();
 }
 
+void AnimatedModel::ResetModelAnimator()
+{
+    modelAnimator_ = nullptr;
+#if defined(URHO3D_COMPUTE)
+    computeAnimator_ = nullptr;
+#endif
+}
+
+bool AnimatedModel::HasModelAnimator() const
+{
+#if defined(URHO3D_COMPUTE)
+    if (computeAnimator_)
+        return true;
+#endif
+    return modelAnimator_ != nullptr;
+}
+
 void AnimatedModel::SetGeometryBoneMappings()
 {
     geometrySkinMatrices_.clear();
@@ -1015,6 +1097,10 @@ void AnimatedModel::SetGeometryBoneMappings()
 
 bool AnimatedModel::UpdateAndCheckAnimationTimers(float timeStep)
 {
+    auto renderer = context_->GetSubsystem<Renderer>();
+    if (renderer && renderer->GetAnimationLodSettings().enabled_)
+        return UpdateAndCheckAnimationLod(renderer);
+
     // If using animation LOD, accumulate time and see if it is time to update
     if (animationLodBias_ > 0.0f && animationLodDistance_ > 0.0f)
     {
@@ -1033,6 +1119,105 @@ bool AnimatedModel::UpdateAndCheckAnimationTimers(float timeStep)
     return true;
 }
 
+bool AnimatedModel::UpdateAndCheckAnimationLod(Renderer* renderer)
+{
+    const AnimationLodSettings& settings = renderer->GetAnimationLodSettings();
+
+    // Perform the first update always, as well as updates when the model was not seen by any camera
+    useReducedBones_ = false;
+    if (animationLodTimer_ < 0.0f || animationScreenSize_ < 0.0f)
+    {
+        animationLodTimer_ = 0.0f;
+        animationLodInterval_ = 1;
+        return true;
+    }
+
+    const float screenSize = animationScreenSize_ * animationLodBias_;
+    if (screenSize < settings.frozenScreenSize_)
+    {
+        animationLodInterval_ = 0;
+        return false;
+    }
+
+    unsigned interval = 1;
+    if (screenSize < settings.quarterRateScreenSize_)
+        interval = 4;
+    else if (screenSize < settings.halfRateScreenSize_)
+        interval = 2;
+
+    const unsigned numBones = skeleton_.GetNumBones();
+    renderer->AddAnimationLodDemand((numBones + interval - 1) / interval);
+
+    if (screenSize < settings.reducedBonesScreenSize_)
+    {
+        UpdateReducedBones(settings.reducedBonesMaxDepth_);
+        useReducedBones_ = true;
+    }
+
+    animationLodInterval_ = Min(interval * renderer->GetAnimationLodRateScale(), AnimationLodSettings::MaxUpdateInterval);
+    ++animationLodCounter_;
+    return animationLodCounter_ % animationLodInterval_ == 0;
+}
+
+void AnimatedModel::UpdateReducedBones(unsigned maxDepth)
+{
+    const unsigned numBones = skeleton_.GetNumBones();
+    if (reducedBones_.size() == numBones && reducedBonesMaxDepth_ == maxDepth)
+        return;
+
+    // Bones order guarantees that parents are visited before children
+    ea::vector<unsigned> depths(numBones);
+    reducedBones_.clear();
+    reducedBones_.resize(numBones);
+    reducedBonesMaxDepth_ = maxDepth;
+    for (unsigned boneIndex : skeleton_.GetBonesOrder())
+    {
+        const unsigned parentIndex = skeleton_.GetBone(boneIndex)->parentIndex_;
+        depths[boneIndex] = parentIndex == boneIndex ? 0 : depths[parentIndex] + 1;
+        reducedBones_[boneIndex] = depths[boneIndex] > maxDepth;
+    }
+}
+
+void AnimatedModel::BeginAnimationInterpolation(bool interpolate)
+{
+    animationInterpolationStep_ = 0;
+    animationInterpolationInterval_ = 0;
+    if (!interpolate)
+        return;
+
+    const unsigned numBones = skeleton_.GetNumBones();
+    animationInterpolationFrom_.resize(numBones);
+    for (unsigned i = 0; i < numBones; ++i)
+        animationInterpolationFrom_[i] = skeletonData_[i].localToParent_;
+    animationInterpolationInterval_ = animationLodInterval_;
+}
+
+void AnimatedModel::ApplyAnimationInterpolation()
+{
+    const unsigned numBones = skeleton_.GetNumBones();
+    if (animationInterpolationFrom_.size() != numBones)
+    {
+        animationInterpolationInterval_ = 0;
+        return;
+    }
+
+    // Store target pose on the first step
+    if (animationInterpolationStep_ == 0)
+    {
+        animationInterpolationTo_.resize(numBones);
+        for (unsigned i = 0; i < numBones; ++i)
+            animationInterpolationTo_[i] = skeletonData_[i].localToParent_;
+    }
+
+    ++animationInterpolationStep_;
+    const float factor = static_cast<float>(animationInterpolationStep_) / animationInterpolationInterval_;
+    for (unsigned i = 0; i < numBones; ++i)
+    {
+        skeletonData_[i].localToParent_ = animationInterpolationFrom_[i].Lerp(animationInterpolationTo_[i], factor);
+    }
+    boneBoundingBoxDirty_ = true;
+}
+
 void AnimatedModel::CalculateAnimations()
 {
     URHO3D_ASSERT(isMaster_);
@@ -1040,22 +1225,68 @@ void AnimatedModel::CalculateAnimations()
     // AnimationStateSource is a weak pointer which may or may not be an issue
     if (AnimationStateSource* animationStateSource = animationStateSource_)
     {
+        const ea::span<const bool> skippedBones = useReducedBones_ && reducedBones_.size() == skeletonData_.size()
+            ? ea::span<const bool>(reducedBones_) : ea::span<const bool>();
         for (AnimationState* state : animationStateSource->GetAnimationStates())
-            state->CalculateModelTracks(skeletonData_);
+            state->CalculateModelTracks(skeletonData_, skippedBones);
     }
 
     animationDirty_ = false;
     boneBoundingBoxDirty_ = true;
 }
 
+void AnimatedModel::UpdatePassiveBones()
+{
+    const unsigned numBones = skeleton_.GetNumBones();
+    passiveBones_.clear();
+    passiveBones_.resize(numBones, skipPassiveBoneNodes_);
+    if (!skipPassiveBoneNodes_)
+        return;
+
+    // Other models in the same node take bone transforms from nodes
+    unsigned numModels = 0;
+    for (Component* component : node_->GetComponents())
+    {
+        if (component->IsInstanceOf<AnimatedModel>())
+            ++numModels;
+    }
+    if (numModels > 1)
+    {
+        ea::fill(passiveBones_.begin(), passiveBones_.end(), false);
+        return;
+    }
+
+    numPassiveChildBones_.clear();
+    numPassiveChildBones_.resize(numBones);
+
+    // Visit children before parents
+    const ea::vector<unsigned>& bonesOrder = skeleton_.GetBonesOrder();
+    for (auto iter = bonesOrder.rbegin(); iter != bonesOrder.rend(); ++iter)
+    {
+        const unsigned boneIndex = *iter;
+        const Bone* bone = skeleton_.GetBone(boneIndex);
+        const Node* node = bone->node_;
+
+        const bool isPassive = node && node->GetNumComponents() == 0
+            && node->GetNumChildren() == numPassiveChildBones_[boneIndex];
+        passiveBones_[boneIndex] = isPassive;
+
+        if (isPassive && bone->parentIndex_ != boneIndex)
+            ++numPassiveChildBones_[bone->parentIndex_];
+    }
+}
+
 void AnimatedModel::ApplyAnimation()
 {
     // Reset skeleton, apply all animations, calculate bones' bounding box. Make sure this is only done for the master model
     // (first AnimatedModel in a node)
     if (isMaster_)
     {
+        animationInterpolationStep_ = 0;
+        animationInterpolationInterval_ = 0;
         InitializeLocalBoneTransforms(false);
         CalculateAnimations();
+        UpdatePassiveBones();
         CalculateLocalBoundingBox();
         ApplyBoneTransformsToNodes();
     }
@@ -1065,12 +1296,17 @@ void AnimatedModel::ApplyBoneTransformsToNodes()
 {
     for (unsigned boneIndex = 0; boneIndex < skeleton_.GetNumBones(); ++boneIndex)
     {
+        if (boneIndex < passiveBones_.size() && passiveBones_[boneIndex])
+            continue;
+
         Bone* bone = skeleton_.GetBone(boneIndex);
         const Transform& transform = skeletonData_[boneIndex].localToParent_;
         if (Node* node = bone->node_)
             node->SetTransformSilent(transform.position_, transform.rotation_, transform.scale_);
     }
 
+    skinningDirty_ = true;
+
     // Skeleton reset and animations apply the node transforms "silently" to avoid repeated marking dirty. Mark dirty now
     node_->MarkDirty();
 }
@@ -1087,28 +1323,46 @@ void AnimatedModel::UpdateSkinning()
     // Use model's world transform in case a bone is missing
     const Matrix3x4& worldTransform = node_->GetWorldTransform();
 
-    // Skinning with global matrices only
-    if (!geometrySkinMatrices_.size())
+    // Calculate world transforms of passive bones from animation output, parents first
+    const bool hasPassiveBones = ea::find(passiveBones_.begin(), passiveBones_.end(), true) != passiveBones_.end();
+    if (hasPassiveBones)
     {
-        for (unsigned i = 0; i < bones.size(); ++i)
+        passiveBoneWorldTransforms_.resize(bones.size());
+        for (unsigned boneIndex : skeleton_.GetBonesOrder())
         {
-            const Bone& bone = bones[i];
-            if (bone.node_)
-                skinMatrices_[i] = bone.node_->GetWorldTransform() * bone.offsetMatrix_;
+            if (!passiveBones_[boneIndex])
+                continue;
+
+            const Bone& bone = bones[boneIndex];
+            const Matrix3x4 localToParent = skeletonData_[boneIndex].localToParent_.ToMatrix3x4();
+            if (bone.parentIndex_ != boneIndex && passiveBones_[bone.parentIndex_])
+                passiveBoneWorldTransforms_[boneIndex] = passiveBoneWorldTransforms_[bone.parentIndex_] * localToParent;
+            else if (Node* parentNode = bone.node_->GetParent())
+                passiveBoneWorldTransforms_[boneIndex] = parentNode->GetWorldTransform() * localToParent;
             else
-                skinMatrices_[i] = worldTransform;
+                passiveBoneWorldTransforms_[boneIndex] = localToParent;
         }
     }
+    const auto getBoneWorldTransform = [&](unsigned boneIndex) -> const Matrix3x4&
+    {
+        const Bone& bone = bones[boneIndex];
+        if (hasPassiveBones && passiveBones_[boneIndex])
+            return passiveBoneWorldTransforms_[boneIndex];
+        return bone.node_ ? bone.node_->GetWorldTransform() : worldTransform;
+    };
+
+    // Skinning with global matrices only
+    if (!geometrySkinMatrices_.size())
+    {
+        for (unsigned i = 0; i < bones.size(); ++i)
+            skinMatrices_[i] = getBoneWorldTransform(i) * bones[i].offsetMatrix_;
+    }
     // Skinning with per-geometry matrices
     else
     {
         for (unsigned i = 0; i < bones.size(); ++i)
         {
-            const Bone& bone = bones[i];
-            if (bone.node_)
-                skinMatrices_[i] = bone.node_->GetWorldTransform() * bone.offsetMatrix_;
-            else
-                skinMatrices_[i] = worldTransform;
+            skinMatrices_[i] = getBoneWorldTransform(i) * bones[i].offsetMatrix_;
 
             // Copy the skin matrix to per-geometry matrices as needed
             for (unsigned j = 0; j < geometrySkinMatrixPtrs_[i].size(); ++j)
@@ -1137,6 +1391,16 @@ void AnimatedModel::UpdateMorphs()
             modelAnimator_->ApplySkinning(skinMatrices_);
         modelAnimator_->Commit();
     }
+#if defined(URHO3D_COMPUTE)
+    else if (computeAnimator_)
+    {
+        computeAnimator_->ResetAnimation();
+        computeAnimator_->ApplyMorphs(morphs_);
+        if (softwareSkinning_)
+            computeAnimator_->ApplySkinning(skinMatrices_);
+        computeAnimator_->Commit();
+    }
+#endif
 
     morphsDirty_ = false;
 }
@@ -1156,6 +1420,13 @@ void AnimatedModel::UpdateSoftwareSkinningState()
 
     softwareSkinning_ = !renderer->GetUseHardwareSkinning();
     numSoftwareSkinningBones_ = renderer->GetNumSoftwareSkinningBones();
+    computeSkinning_ = false;
+#if defined(URHO3D_COMPUTE)
+    if (renderer->GetSkinningMode() == SKINNING_COMPUTE)
+    {
+        computeSkinning_ = ComputeModelAnimator::IsSupported(context_);
+    }
+#endif
 
     if (renderer->GetSkinningMode() == SKINNING_AUTO && model_)
     {
@@ -32,6 +32,8 @@ namespace Urho3D
 
 class Animation;
 class AnimationState;
+class ComputeModelAnimator;
+class Renderer;
 class SoftwareModelAnimator;
 
 /// Animated model component.
@@ -80,6 +82,12 @@ public:
     /// Set whether to update animation and the bounding box when not visible. Recommended to enable for physically controlled models like ragdolls.
     /// @property
     void SetUpdateInvisible(bool enable);
+    /// Set whether to skip transform updates of passive bone nodes.
+    /// Bone node is passive if it has no components and no children except other passive bone nodes.
+    /// Skinning of passive bones is calculated directly from animation output.
+    /// External changes of passive bone node transforms (e.g. IK) are ignored if enabled.
+    /// @property
+    void SetSkipPassiveBoneNodes(bool enable);
     /// Set vertex morph weight by index.
     void SetMorphWeight(unsigned index, float weight);
     /// Set vertex morph weight by name.
@@ -103,11 +111,18 @@ public:
     /// Return animation LOD bias.
     /// @property
     float GetAnimationLodBias() const { return animationLodBias_; }
+    /// Return current interval between animation updates in frames, 0 if animation is frozen.
+    /// Used only if animation LOD is enabled in Renderer.
+    unsigned GetAnimationLodInterval() const { return animationLodInterval_; }
 
     /// Return whether to update animation when not visible.
     /// @property
     bool GetUpdateInvisible() const { return updateInvisible_; }
 
+    /// Return whether to skip transform updates of passive bone nodes.
+    /// @property
+    bool GetSkipPassiveBoneNodes() const { return skipPassiveBoneNodes_; }
+
     /// Return all vertex morphs.
     const ea::vector<ModelMorph>& GetMorphs() const { return morphs_; }
 
@@ -176,6 +191,10 @@ private:
     void SetGeometryBoneMappings();
     /// Clone geometries for vertex morphing.
     void CloneGeometries();
+    /// Release animated geometries of software or compute animator.
+    void ResetModelAnimator();
+    /// Return whether software or compute animator is created.
+    bool HasModelAnimator() const;
     /// Handle model reload finished.
     void HandleModelReloadFinished(StringHash eventType, VariantMap& eventData);
     /// Reconsider whether to use software skinning.
@@ -185,11 +204,17 @@ private:
     /// @{
     bool PrepareForThreadedUpdate(Camera* camera, unsigned frameNumber);
     bool UpdateAndCheckAnimationTimers(float timeStep);
+    bool UpdateAndCheckAnimationLod(Renderer* renderer);
+    void UpdateReducedBones(unsigned maxDepth);
+    bool IsInterpolatingAnimation() const { return animationInterpolationStep_ < animationInterpolationInterval_; }
+    void BeginAnimationInterpolation(bool interpolate);
+    void ApplyAnimationInterpolation();
 
     void InitializeLocalBoneTransforms(bool reset);
     void CalculateFinalBoneTransforms();
     void CalculateLocalBoundingBox();
     void CalculateAnimations();
+    void UpdatePassiveBones();
     void ApplyBoneTransformsToNodes();
 
     void UpdateSkinning();
@@ -212,10 +237,21 @@ private:
     WeakPtr<AnimationStateSource> animationStateSource_;
     /// Software model animator.
     SharedPtr<SoftwareModelAnimator> modelAnimator_;
+#if defined(URHO3D_COMPUTE)
+    /// Compute model animator.
+    SharedPtr<ComputeModelAnimator> computeAnimator_;
+#endif
     /// Vertex morphs.
     ea::vector<ModelMorph> morphs_;
     /// Skinning matrices.
     ea::vector<Matrix3x4> skinMatrices_;
+    /// Whether the bone is passive and its node is not updated.
+    ea::vector<bool> passiveBones_;
+    /// Temporary buffers used to update passive bones.
+    /// @{
+    ea::vector<unsigned> numPassiveChildBones_;
+    ea::vector<Matrix3x4> passiveBoneWorldTransforms_;
+    /// @}
     /// Mapping of subgeometry bone indices, used if more bones than skinning shader can manage.
     ea::vector<ea::vector<unsigned> > geometryBoneMappings_;
     /// Subgeometry skinning matrices, used if more bones than skinning shader can manage.
@@ -234,10 +270,34 @@ private:
     float animationLodTimer_;
     /// Animation LOD distance, the minimum of all LOD view distances last frame.
     float animationLodDistance_;
+    /// Screen size for animation LOD, the maximum of all view sizes last frame. Negative if unknown.
+    float animationScreenSize_{-1.0f};
+    /// Current interval between animation updates if budgeted animation LOD is used.
+    unsigned animationLodInterval_{1};
+    /// Counter of animation LOD frames, initialized randomly to spread updates of models across frames.
+    unsigned animationLodCounter_{};
+    /// Whether reduced set of bones is animated.
+    bool useReducedBones_{};
+    /// Max depth of bones in reduced set.
+    unsigned reducedBonesMaxDepth_{M_MAX_UNSIGNED};
+    /// Bones that are not animated in reduced set.
+    ea::vector<bool> reducedBones_;
+    /// Current step of interpolation between animation updates.
+    unsigned animationInterpolationStep_{};
+    /// Number of steps of interpolation between animation updates.
+    unsigned animationInterpolationInterval_{};
+    /// Bone transforms at the beginning of interpolation.
+    ea::vector<Transform> animationInterpolationFrom_;
+    /// Bone transforms at the end of interpolation.
+    ea::vector<Transform> animationInterpolationTo_;
     /// Update animation when invisible flag.
     bool updateInvisible_;
+    /// Whether to skip transform updates of passive bone nodes.
+    bool skipPassiveBoneNodes_{};
     /// Software skinning flag.
     bool softwareSkinning_{};
+    /// Whether software skinning and morphing is performed in compute shader.
+    bool computeSkinning_{};
     /// Number of bones used for software skinning.
     unsigned numSoftwareSkinningBones_{ 4 };
     /// Master model flag.
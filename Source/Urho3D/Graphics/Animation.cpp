@@ -77,6 +77,53 @@ void WriteTransform(Serializer& dest, const Transform& transform, AnimationChann
         dest.WriteVector3(transform.scale_);
 }
 
+void ReadCompressedChannel(Deserializer& source, CompressedAnimationChannel& channel)
+{
+    const unsigned numKeys = source.ReadUInt();
+    channel.minValue_ = source.ReadVector3();
+    channel.valueRange_ = source.ReadVector3();
+    channel.times_.resize(numKeys);
+    channel.values_.resize(numKeys * 3);
+    source.Read(channel.times_.data(), channel.times_.size() * sizeof(unsigned short));
+    source.Read(channel.values_.data(), channel.values_.size() * sizeof(unsigned short));
+}
+
+void WriteCompressedChannel(Serializer& dest, const CompressedAnimationChannel& channel)
+{
+    dest.WriteUInt(channel.GetNumKeys());
+    dest.WriteVector3(channel.minValue_);
+    dest.WriteVector3(channel.valueRange_);
+    dest.Write(channel.times_.data(), channel.times_.size() * sizeof(unsigned short));
+    dest.Write(channel.values_.data(), channel.values_.size() * sizeof(unsigned short));
+}
+
+void ReadCompressedTrack(Deserializer& source, AnimationTrack& track)
+{
+    CompressedAnimationTrack& compressed = track.compressed_;
+    track.isCompressed_ = true;
+    compressed.startTime_ = source.ReadFloat();
+    compressed.timeRange_ = source.ReadFloat();
+    if (track.channelMask_ & CHANNEL_POSITION)
+        ReadCompressedChannel(source, compressed.position_);
+    if (track.channelMask_ & CHANNEL_ROTATION)
+        ReadCompressedChannel(source, compressed.rotation_);
+    if (track.channelMask_ & CHANNEL_SCALE)
+        ReadCompressedChannel(source, compressed.scale_);
+}
+
+void WriteCompressedTrack(Serializer& dest, const AnimationTrack& track)
+{
+    const CompressedAnimationTrack& compressed = track.compressed_;
+    dest.WriteFloat(compressed.startTime_);
+    dest.WriteFloat(compressed.timeRange_);
+    if (track.channelMask_ & CHANNEL_POSITION)
+        WriteCompressedChannel(dest, compressed.position_);
+    if (track.channelMask_ & CHANNEL_ROTATION)
+        WriteCompressedChannel(dest, compressed.rotation_);
+    if (track.channelMask_ & CHANNEL_SCALE)
+        WriteCompressedChannel(dest, compressed.scale_);
+}
+
 }
 
 Animation::Animation(Context* context) :
@@ -231,6 +278,13 @@ bool Animation::BeginLoad(Deserializer& source)
         AnimationTrack* newTrack = CreateTrack(source.ReadString());
         newTrack->channelMask_ = AnimationChannelFlags(source.ReadUByte());
 
+        if (version >= compressedTrackVersion && source.ReadBool())
+        {
+            ReadCompressedTrack(source, *newTrack);
+            memoryUse += newTrack->GetMemoryUse();
+            continue;
+        }
+
         const unsigned keyFrames = source.ReadUInt();
         newTrack->keyFrames_.resize(keyFrames);
         memoryUse += keyFrames * sizeof(AnimationKeyFrame);
@@ -331,6 +385,13 @@ bool Animation::Save(Serializer& dest) const
         const AnimationTrack& track = item.second;
         dest.WriteString(track.name_);
         dest.WriteUByte(track.channelMask_);
+        dest.WriteBool(track.isCompressed_);
+        if (track.isCompressed_)
+        {
+            WriteCompressedTrack(dest, track);
+            continue;
+        }
+
         dest.WriteUInt(track.keyFrames_.size());
 
         // Write keyframes of the track
@@ -576,6 +637,18 @@ AnimationTriggerPoint* Animation::GetTrigger(unsigned index)
     return index < triggers_.size() ? &triggers_[index] : nullptr;
 }
 
+void Animation::Compress(const AnimationCompressionSettings& settings)
+{
+    unsigned memoryUse = GetMemoryUse();
+    for (auto& [nameHash, track] : tracks_)
+    {
+        memoryUse -= track.GetMemoryUse();
+        track.Compress(settings);
+        memoryUse += track.GetMemoryUse();
+    }
+    SetMemoryUse(memoryUse);
+}
+
 void Animation::SetTracks(const ea::vector<AnimationTrack>& tracks)
 {
     tracks_.clear();
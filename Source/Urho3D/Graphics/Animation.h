@@ -144,6 +144,8 @@ public:
 
     /// Set all animation tracks.
     void SetTracks(const ea::vector<AnimationTrack>& tracks);
+    /// Compress all bone tracks. Compressed tracks are sampled directly without decompression.
+    void Compress(const AnimationCompressionSettings& settings);
 
 private:
     void LoadTriggersFromXML(const XMLElement& source);
@@ -152,8 +154,9 @@ private:
     /// @{
     static const unsigned legacyVersion = 1; // Fake version for legacy unversioned UANI file
     static const unsigned variantTrackVersion = 2; // VariantAnimationTrack support added here
+    static const unsigned compressedTrackVersion = 3; // Compressed AnimationTrack support added here
 
-    static const unsigned currentVersion = variantTrackVersion;
+    static const unsigned currentVersion = compressedTrackVersion;
     /// @}
 
     /// Animation name.
@@ -232,7 +232,7 @@ float AnimationState::GetLength() const
     return animation_ ? animation_->GetLength() : 0.0f;
 }
 
-void AnimationState::CalculateModelTracks(ea::vector<ModelAnimationOutput>& output) const
+void AnimationState::CalculateModelTracks(ea::vector<ModelAnimationOutput>& output, ea::span<const bool> skippedBones) const
 {
     if (!animation_ || !IsEnabled())
         return;
@@ -243,6 +243,9 @@ void AnimationState::CalculateModelTracks(ea::vector<ModelAnimationOutput>& outp
         if (!stateTrack.bone_->animated_)
             continue;
 
+        if (stateTrack.boneIndex_ < skippedBones.size() && skippedBones[stateTrack.boneIndex_])
+            continue;
+
         URHO3D_ASSERT(output.size() > stateTrack.boneIndex_);
         ModelAnimationOutput& trackOutput = output[stateTrack.boneIndex_];
 
@@ -284,11 +287,11 @@ void AnimationState::CalculateAttributeTracks(ea::unordered_map<AnimatedAttribut
 
 void AnimationState::CalculateTransformTrack(NodeAnimationOutput& output, const AnimationTrack& track, unsigned& frame, float weight) const
 {
-    if (track.keyFrames_.empty())
+    if (track.IsEmpty())
         return;
 
     const bool isFullWeight = Equals(weight, 1.0f);
-    const AnimationKeyFrame& baseValue = track.keyFrames_.front();
+    const Transform baseValue = track.GetFirstValue();
 
     Transform sampledValue;
     track.Sample(time_, animation_->GetLength(), looped_, frame, sampledValue);
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <EASTL/span.h>
 #include <EASTL/unordered_map.h>
 
 #include "../Container/Ptr.h"
@@ -208,8 +209,8 @@ public:
     /// @property
     float GetLength() const;
 
-    /// Calculate animation for the model skeleton.
-    void CalculateModelTracks(ea::vector<ModelAnimationOutput>& output) const;
+    /// Calculate animation for the model skeleton. Bones set in optional mask are skipped.
+    void CalculateModelTracks(ea::vector<ModelAnimationOutput>& output, ea::span<const bool> skippedBones = {}) const;
     /// Apply animation to a scene node hierarchy.
     void CalculateNodeTracks(ea::unordered_map<Node*, NodeAnimationOutput>& output) const;
     /// Apply animation to attributes.
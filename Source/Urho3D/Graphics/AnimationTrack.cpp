@@ -30,8 +30,282 @@
 namespace Urho3D
 {
 
+namespace
+{
+
+const float MaxQuantizedValue = 65535.0f;
+const float MaxQuantizedRotation = 32767.0f;
+const float MaxSmallestComponent = 0.70710678f;
+
+unsigned short QuantizeUnitFloat(float value)
+{
+    return static_cast<unsigned short>(RoundToInt(Clamp(value, 0.0f, 1.0f) * MaxQuantizedValue));
+}
+
+float DequantizeUnitFloat(unsigned short value)
+{
+    return value / MaxQuantizedValue;
+}
+
+void EncodeVector3(ea::vector<unsigned short>& dest, const Vector3& value, const Vector3& minValue, const Vector3& range)
+{
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        const float componentRange = range.Data()[i];
+        const float normalized = componentRange > 0.0f ? (value.Data()[i] - minValue.Data()[i]) / componentRange : 0.0f;
+        dest.push_back(QuantizeUnitFloat(normalized));
+    }
+}
+
+Vector3 DecodeVector3(const unsigned short* data, const Vector3& minValue, const Vector3& range)
+{
+    const Vector3 normalized{DequantizeUnitFloat(data[0]), DequantizeUnitFloat(data[1]), DequantizeUnitFloat(data[2])};
+    return minValue + range * normalized;
+}
+
+void EncodeQuaternion(ea::vector<unsigned short>& dest, const Quaternion& value)
+{
+    const Quaternion normalized = value.Normalized();
+    const float components[4] = {normalized.w_, normalized.x_, normalized.y_, normalized.z_};
+
+    unsigned largestIndex = 0;
+    for (unsigned i = 1; i < 4; ++i)
+    {
+        if (Abs(components[i]) > Abs(components[largestIndex]))
+            largestIndex = i;
+    }
+
+    // Quaternions q and -q represent the same rotation, so the largest component is always positive
+    const float sign = components[largestIndex] < 0.0f ? -1.0f : 1.0f;
+
+    unsigned short encoded[3]{};
+    unsigned encodedIndex = 0;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        if (i == largestIndex)
+            continue;
+
+        const float normalizedComponent = (components[i] * sign / MaxSmallestComponent + 1.0f) * 0.5f;
+        encoded[encodedIndex++] =
+            static_cast<unsigned short>(RoundToInt(Clamp(normalizedComponent, 0.0f, 1.0f) * MaxQuantizedRotation));
+    }
+
+    // Store index of the largest component in the highest bits
+    encoded[0] |= (largestIndex & 1u) << 15;
+    encoded[1] |= (largestIndex >> 1u) << 15;
+    dest.insert(dest.end(), ea::begin(encoded), ea::end(encoded));
+}
+
+Quaternion DecodeQuaternion(const unsigned short* data)
+{
+    const unsigned largestIndex = (data[0] >> 15u) | ((data[1] >> 15u) << 1u);
+
+    float components[4]{};
+    float sumSquares = 0.0f;
+    unsigned encodedIndex = 0;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        if (i == largestIndex)
+            continue;
+
+        const float normalizedComponent = (data[encodedIndex++] & 0x7fffu) / MaxQuantizedRotation;
+        components[i] = (normalizedComponent * 2.0f - 1.0f) * MaxSmallestComponent;
+        sumSquares += components[i] * components[i];
+    }
+    components[largestIndex] = Sqrt(ea::max(0.0f, 1.0f - sumSquares));
+
+    return Quaternion{components[0], components[1], components[2], components[3]};
+}
+
+/// Return indices of keys that should be kept so that linear interpolation of the remaining keys
+/// doesn't deviate from removed keys more than by maxError. Constant channel is reduced to single key.
+template <class T, class Interpolate, class Distance>
+ea::vector<unsigned> ReduceKeys(const ea::vector<float>& times, const ea::vector<T>& values, float maxError,
+    const Interpolate& interpolate, const Distance& distance)
+{
+    const unsigned numKeys = values.size();
+
+    bool isConstant = true;
+    for (unsigned i = 1; i < numKeys && isConstant; ++i)
+        isConstant = distance(values[0], values[i]) <= maxError;
+    if (isConstant)
+        return ea::vector<unsigned>{0u};
+
+    ea::vector<unsigned> result{0u};
+    unsigned anchor = 0;
+    for (unsigned candidate = 2; candidate < numKeys; ++candidate)
+    {
+        const float timeInterval = times[candidate] - times[anchor];
+        for (unsigned i = anchor + 1; i < candidate; ++i)
+        {
+            const float factor = timeInterval > 0.0f ? (times[i] - times[anchor]) / timeInterval : 0.0f;
+            if (distance(interpolate(values[anchor], values[candidate], factor), values[i]) > maxError)
+            {
+                anchor = candidate - 1;
+                result.push_back(anchor);
+                break;
+            }
+        }
+    }
+    result.push_back(numKeys - 1);
+    return result;
+}
+
+void QuantizeKeyTimes(CompressedAnimationChannel& channel, const CompressedAnimationTrack& track,
+    const ea::vector<float>& times, const ea::vector<unsigned>& keys)
+{
+    channel.times_.reserve(keys.size());
+    for (unsigned key : keys)
+    {
+        const float normalizedTime = track.timeRange_ > 0.0f ? (times[key] - track.startTime_) / track.timeRange_ : 0.0f;
+        channel.times_.push_back(QuantizeUnitFloat(normalizedTime));
+    }
+}
+
+void CompressVector3Channel(CompressedAnimationChannel& channel, const CompressedAnimationTrack& track,
+    const ea::vector<float>& times, const ea::vector<Vector3>& values, float maxError)
+{
+    const auto interpolate = [](const Vector3& lhs, const Vector3& rhs, float factor) { return lhs.Lerp(rhs, factor); };
+    const auto distance = [](const Vector3& lhs, const Vector3& rhs) { return (lhs - rhs).Length(); };
+    const ea::vector<unsigned> keys = ReduceKeys(times, values, maxError, interpolate, distance);
+
+    Vector3 minValue = values[keys[0]];
+    Vector3 maxValue = minValue;
+    for (unsigned key : keys)
+    {
+        minValue = VectorMin(minValue, values[key]);
+        maxValue = VectorMax(maxValue, values[key]);
+    }
+    channel.minValue_ = minValue;
+    channel.valueRange_ = maxValue - minValue;
+
+    QuantizeKeyTimes(channel, track, times, keys);
+    channel.values_.reserve(keys.size() * 3);
+    for (unsigned key : keys)
+        EncodeVector3(channel.values_, values[key], channel.minValue_, channel.valueRange_);
+}
+
+void CompressQuaternionChannel(CompressedAnimationChannel& channel, const CompressedAnimationTrack& track,
+    const ea::vector<float>& times, const ea::vector<Quaternion>& values, float maxError)
+{
+    const auto interpolate = [](const Quaternion& lhs, const Quaternion& rhs, float factor) { return lhs.Slerp(rhs, factor); };
+    const auto distance = [](const Quaternion& lhs, const Quaternion& rhs) { return 2.0f * Acos(Abs(lhs.DotProduct(rhs))); };
+    const ea::vector<unsigned> keys = ReduceKeys(times, values, maxError, interpolate, distance);
+
+    QuantizeKeyTimes(channel, track, times, keys);
+    channel.values_.reserve(keys.size() * 3);
+    for (unsigned key : keys)
+        EncodeQuaternion(channel.values_, values[key]);
+}
+
+float GetCompressedKeyTime(const CompressedAnimationTrack& track, const CompressedAnimationChannel& channel, unsigned index)
+{
+    return track.startTime_ + DequantizeUnitFloat(channel.times_[index]) * track.timeRange_;
+}
+
+/// Same as KeyFrameSet::GetKeyFrames, but for compressed channel.
+void GetCompressedKeys(const CompressedAnimationTrack& track, const CompressedAnimationChannel& channel,
+    float time, float duration, bool isLooped, unsigned& frameIndex, unsigned& nextFrameIndex, float& blendFactor)
+{
+    const unsigned numKeys = channel.GetNumKeys();
+    const float normalizedTime =
+        track.timeRange_ > 0.0f ? (ea::max(time, 0.0f) - track.startTime_) / track.timeRange_ * MaxQuantizedValue : 0.0f;
+
+    const auto iter = ea::upper_bound(channel.times_.begin(), channel.times_.end(), normalizedTime,
+        [](float lhs, unsigned short rhs) { return lhs < static_cast<float>(rhs); });
+    frameIndex = iter != channel.times_.begin() ? static_cast<unsigned>(iter - channel.times_.begin()) - 1 : 0;
+
+    nextFrameIndex = isLooped
+        ? (frameIndex + 1) % numKeys  // Wrap around if looped
+        : ea::min(frameIndex + 1, numKeys - 1);  // Trim if not looped
+
+    if (frameIndex != nextFrameIndex)
+    {
+        const float frameTime = GetCompressedKeyTime(track, channel, frameIndex);
+        const float nextFrameTime = GetCompressedKeyTime(track, channel, nextFrameIndex);
+
+        float timeInterval = nextFrameTime - frameTime;
+        if (timeInterval < 0.0f)
+            timeInterval += duration;
+        blendFactor = timeInterval > 0.0f ? (time - frameTime) / timeInterval : 1.0f;
+    }
+    else
+    {
+        blendFactor = 0.0f;
+    }
+}
+
+Vector3 SampleVector3Channel(const CompressedAnimationTrack& track, const CompressedAnimationChannel& channel,
+    float time, float duration, bool isLooped)
+{
+    unsigned frameIndex{};
+    unsigned nextFrameIndex{};
+    float blendFactor{};
+    GetCompressedKeys(track, channel, time, duration, isLooped, frameIndex, nextFrameIndex, blendFactor);
+
+    const Vector3 value = DecodeVector3(&channel.values_[frameIndex * 3], channel.minValue_, channel.valueRange_);
+    if (blendFactor < M_EPSILON)
+        return value;
+
+    const Vector3 nextValue = DecodeVector3(&channel.values_[nextFrameIndex * 3], channel.minValue_, channel.valueRange_);
+    return value.Lerp(nextValue, blendFactor);
+}
+
+Quaternion SampleQuaternionChannel(const CompressedAnimationTrack& track, const CompressedAnimationChannel& channel,
+    float time, float duration, bool isLooped)
+{
+    unsigned frameIndex{};
+    unsigned nextFrameIndex{};
+    float blendFactor{};
+    GetCompressedKeys(track, channel, time, duration, isLooped, frameIndex, nextFrameIndex, blendFactor);
+
+    const Quaternion value = DecodeQuaternion(&channel.values_[frameIndex * 3]);
+    if (blendFactor < M_EPSILON)
+        return value;
+
+    const Quaternion nextValue = DecodeQuaternion(&channel.values_[nextFrameIndex * 3]);
+    return value.Slerp(nextValue, blendFactor);
+}
+
+Transform DecodeCompressedKey(const AnimationTrack& track, bool isLast)
+{
+    const CompressedAnimationTrack& compressed = track.compressed_;
+    const auto getIndex = [&](const CompressedAnimationChannel& channel) { return isLast ? channel.GetNumKeys() - 1 : 0; };
+
+    Transform result;
+    if (track.channelMask_.Test(CHANNEL_POSITION))
+    {
+        const CompressedAnimationChannel& channel = compressed.position_;
+        result.position_ = DecodeVector3(&channel.values_[getIndex(channel) * 3], channel.minValue_, channel.valueRange_);
+    }
+    if (track.channelMask_.Test(CHANNEL_ROTATION))
+    {
+        const CompressedAnimationChannel& channel = compressed.rotation_;
+        result.rotation_ = DecodeQuaternion(&channel.values_[getIndex(channel) * 3]);
+    }
+    if (track.channelMask_.Test(CHANNEL_SCALE))
+    {
+        const CompressedAnimationChannel& channel = compressed.scale_;
+        result.scale_ = DecodeVector3(&channel.values_[getIndex(channel) * 3], channel.minValue_, channel.valueRange_);
+    }
+    return result;
+}
+
+}
+
 void AnimationTrack::Sample(float time, float duration, bool isLooped, unsigned& frameIndex, Transform& value) const
 {
+    if (isCompressed_)
+    {
+        if (channelMask_ & CHANNEL_POSITION)
+            value.position_ = SampleVector3Channel(compressed_, compressed_.position_, time, duration, isLooped);
+        if (channelMask_ & CHANNEL_ROTATION)
+            value.rotation_ = SampleQuaternionChannel(compressed_, compressed_.rotation_, time, duration, isLooped);
+        if (channelMask_ & CHANNEL_SCALE)
+            value.scale_ = SampleVector3Channel(compressed_, compressed_.scale_, time, duration, isLooped);
+        return;
+    }
+
     float blendFactor{};
     unsigned nextFrameIndex{};
     GetKeyFrames(time, duration, isLooped, frameIndex, nextFrameIndex, blendFactor);
@@ -61,11 +335,11 @@ void AnimationTrack::Sample(float time, float duration, bool isLooped, unsigned&
 
 bool AnimationTrack::IsLooped(float positionThreshold, float rotationThreshold, float scaleThreshold) const
 {
-    if (keyFrames_.empty())
+    if (IsEmpty())
         return true;
 
-    const Transform& firstTransform = keyFrames_.front();
-    const Transform& lastTransform = keyFrames_.back();
+    const Transform firstTransform = GetFirstValue();
+    const Transform lastTransform = GetLastValue();
 
     if (channelMask_.Test(CHANNEL_POSITION) && !firstTransform.position_.Equals(lastTransform.position_, positionThreshold))
         return false;
@@ -77,6 +351,102 @@ bool AnimationTrack::IsLooped(float positionThreshold, float rotationThreshold,
     return true;
 }
 
+void AnimationTrack::Compress(const AnimationCompressionSettings& settings)
+{
+    if (isCompressed_ || keyFrames_.empty())
+        return;
+
+    compressed_ = {};
+    compressed_.startTime_ = keyFrames_.front().time_;
+    compressed_.timeRange_ = keyFrames_.back().time_ - compressed_.startTime_;
+
+    const unsigned numKeyFrames = keyFrames_.size();
+    ea::vector<float> times(numKeyFrames);
+    for (unsigned i = 0; i < numKeyFrames; ++i)
+        times[i] = keyFrames_[i].time_;
+
+    if (channelMask_.Test(CHANNEL_POSITION))
+    {
+        ea::vector<Vector3> positions(numKeyFrames);
+        for (unsigned i = 0; i < numKeyFrames; ++i)
+            positions[i] = keyFrames_[i].position_;
+        CompressVector3Channel(compressed_.position_, compressed_, times, positions, settings.positionError_);
+    }
+
+    if (channelMask_.Test(CHANNEL_ROTATION))
+    {
+        ea::vector<Quaternion> rotations(numKeyFrames);
+        for (unsigned i = 0; i < numKeyFrames; ++i)
+            rotations[i] = keyFrames_[i].rotation_;
+        CompressQuaternionChannel(compressed_.rotation_, compressed_, times, rotations, settings.rotationError_);
+    }
+
+    if (channelMask_.Test(CHANNEL_SCALE))
+    {
+        ea::vector<Vector3> scales(numKeyFrames);
+        for (unsigned i = 0; i < numKeyFrames; ++i)
+            scales[i] = keyFrames_[i].scale_;
+        CompressVector3Channel(compressed_.scale_, compressed_, times, scales, settings.scaleError_);
+    }
+
+    isCompressed_ = true;
+    keyFrames_.clear();
+    keyFrames_.shrink_to_fit();
+}
+
+void AnimationTrack::Decompress()
+{
+    if (!isCompressed_)
+        return;
+
+    // Merge key times of all channels
+    ea::vector<unsigned short> quantizedTimes;
+    quantizedTimes.append(compressed_.position_.times_);
+    quantizedTimes.append(compressed_.rotation_.times_);
+    quantizedTimes.append(compressed_.scale_.times_);
+    ea::sort(quantizedTimes.begin(), quantizedTimes.end());
+    quantizedTimes.erase(ea::unique(quantizedTimes.begin(), quantizedTimes.end()), quantizedTimes.end());
+
+    ea::vector<AnimationKeyFrame> keyFrames(quantizedTimes.size());
+    for (unsigned i = 0; i < quantizedTimes.size(); ++i)
+    {
+        AnimationKeyFrame& keyFrame = keyFrames[i];
+        keyFrame.time_ = compressed_.startTime_ + DequantizeUnitFloat(quantizedTimes[i]) * compressed_.timeRange_;
+
+        unsigned frameIndex{};
+        Sample(keyFrame.time_, compressed_.timeRange_, false, frameIndex, keyFrame);
+    }
+
+    keyFrames_ = ea::move(keyFrames);
+    compressed_ = {};
+    isCompressed_ = false;
+}
+
+Transform AnimationTrack::GetFirstValue() const
+{
+    if (isCompressed_)
+        return DecodeCompressedKey(*this, false);
+    return !keyFrames_.empty() ? static_cast<const Transform&>(keyFrames_.front()) : Transform{};
+}
+
+Transform AnimationTrack::GetLastValue() const
+{
+    if (isCompressed_)
+        return DecodeCompressedKey(*this, true);
+    return !keyFrames_.empty() ? static_cast<const Transform&>(keyFrames_.back()) : Transform{};
+}
+
+unsigned AnimationTrack::GetMemoryUse() const
+{
+    if (!isCompressed_)
+        return keyFrames_.size() * sizeof(AnimationKeyFrame);
+
+    unsigned memoryUse = sizeof(CompressedAnimationTrack);
+    for (const CompressedAnimationChannel* channel : {&compressed_.position_, &compressed_.rotation_, &compressed_.scale_})
+        memoryUse += (channel->times_.size() + channel->values_.size()) * sizeof(unsigned short);
+    return memoryUse;
+}
+
 bool VariantAnimationTrack::IsLooped() const
 {
     if (keyFrames_.empty())
@@ -49,6 +49,52 @@ struct AnimationKeyFrame : public Transform
     }
 };
 
+/// Settings of skeletal animation track compression.
+struct AnimationCompressionSettings
+{
+    /// Max error of position introduced by key reduction.
+    float positionError_{0.001f};
+    /// Max error of rotation introduced by key reduction, in degrees.
+    float rotationError_{0.1f};
+    /// Max error of scale introduced by key reduction.
+    float scaleError_{0.001f};
+};
+
+/// Single channel of compressed skeletal animation track.
+/// Keys are reduced independently for each channel. Each key stores quantized time and three 16-bit values:
+/// positions and scales are quantized within value range of the channel,
+/// rotations are stored as three smallest components of the quaternion.
+struct CompressedAnimationChannel
+{
+    /// Key times quantized within time range of the track.
+    ea::vector<unsigned short> times_;
+    /// Quantized key values, three per key.
+    ea::vector<unsigned short> values_;
+    /// Minimum value of position or scale channel.
+    Vector3 minValue_;
+    /// Range of values of position or scale channel. Zero for constant channel.
+    Vector3 valueRange_;
+
+    /// Return number of keys.
+    unsigned GetNumKeys() const { return times_.size(); }
+};
+
+/// Compressed keyframes of skeletal animation track.
+struct CompressedAnimationTrack
+{
+    /// Time of the first keyframe.
+    float startTime_{};
+    /// Time between the first and the last keyframes.
+    float timeRange_{};
+
+    /// Channels.
+    /// @{
+    CompressedAnimationChannel position_;
+    CompressedAnimationChannel rotation_;
+    CompressedAnimationChannel scale_;
+    /// @}
+};
+
 /// Skeletal animation track, stores keyframes of a single bone.
 /// @fakeref
 struct URHO3D_API AnimationTrack : public KeyFrameSet<AnimationKeyFrame>
@@ -59,11 +105,29 @@ struct URHO3D_API AnimationTrack : public KeyFrameSet<AnimationKeyFrame>
     StringHash nameHash_;
     /// Bitmask of included data (position, rotation, scale).
     AnimationChannelFlags channelMask_{};
+    /// Whether the track is compressed. Compressed track doesn't store keyframes.
+    bool isCompressed_{};
+    /// Compressed keyframes.
+    CompressedAnimationTrack compressed_;
 
     /// Sample value at given time.
     void Sample(float time, float duration, bool isLooped, unsigned& frameIndex, Transform& transform) const;
     /// Return whether the track is looped, i.e. the first and the last keyframes have the same value.
     bool IsLooped(float positionThreshold = 0.001f, float rotationThreshold = 0.001f, float scaleThreshold = 0.001f) const;
+
+    /// Compress keyframes and release uncompressed data.
+    void Compress(const AnimationCompressionSettings& settings);
+    /// Restore keyframes from compressed data. Removed keys are not restored.
+    void Decompress();
+    /// Return whether the track has no keyframes.
+    bool IsEmpty() const { return isCompressed_ ? compressed_.rotation_.times_.empty()
+        && compressed_.position_.times_.empty() && compressed_.scale_.times_.empty() : keyFrames_.empty(); }
+    /// Return value of the first keyframe.
+    Transform GetFirstValue() const;
+    /// Return value of the last keyframe.
+    Transform GetLastValue() const;
+    /// Return approximate memory used by keyframes, in bytes.
+    unsigned GetMemoryUse() const;
 };
 
 /// Generic variant animation keyframe.
@@ -720,9 +720,6 @@ void BatchGroup::Draw(View* view, Camera* camera, bool allowDepthWrite) const
         {
             Batch::Prepare(view, camera, false, allowDepthWrite);
 
-            graphics->SetIndexBuffer(geometry_->GetIndexBuffer());
-            graphics->SetVertexBuffers(geometry_->GetVertexBuffers());
-
             for (unsigned i = 0; i < instances_.size(); ++i)
             {
                 if (graphics->NeedParameterUpdate(SP_OBJECT, instances_[i].worldTransform_))
@@ -731,8 +728,7 @@ void BatchGroup::Draw(View* view, Camera* camera, bool allowDepthWrite) const
                     SetInstanceShaderParameters(graphics, instances_[i].shaderParameters_);
                 }
 
-                graphics->Draw(geometry_->GetPrimitiveType(), geometry_->GetIndexStart(), geometry_->GetIndexCount(),
-                    geometry_->GetVertexStart(), geometry_->GetVertexCount());
+                geometry_->Draw(graphics);
             }
         }
         else
@@ -742,13 +738,23 @@ void BatchGroup::Draw(View* view, Camera* camera, bool allowDepthWrite) const
             // Get the geometry vertex buffers, then add the instancing stream buffer
             // Hack: use a const_cast to avoid dynamic allocation of new temp vectors
             auto& vertexBuffers = const_cast<ea::vector<SharedPtr<VertexBuffer> >&>(
-                geometry_->GetVertexBuffers());
+                geometry_->GetDrawVertexBuffers());
             vertexBuffers.push_back(SharedPtr<VertexBuffer>(instanceBuffer));
 
-            graphics->SetIndexBuffer(geometry_->GetIndexBuffer());
+            graphics->SetIndexBuffer(geometry_->GetDrawIndexBuffer());
             graphics->SetVertexBuffers(vertexBuffers, startIndex_);
-            graphics->DrawInstanced(geometry_->GetPrimitiveType(), geometry_->GetIndexStart(), geometry_->GetIndexCount(),
-                geometry_->GetVertexStart(), geometry_->GetVertexCount(), instances_.size());
+            if (geometry_->IsPooled())
+            {
+                graphics->DrawInstanced(geometry_->GetPrimitiveType(), geometry_->GetDrawIndexStart(),
+                    geometry_->GetIndexCount(), geometry_->GetDrawBaseVertexIndex(), 0, geometry_->GetVertexCount(),
+                    instances_.size());
+            }
+            else
+            {
+                graphics->DrawInstanced(geometry_->GetPrimitiveType(), geometry_->GetIndexStart(),
+                    geometry_->GetIndexCount(), geometry_->GetVertexStart(), geometry_->GetVertexCount(),
+                    instances_.size());
+            }
 
             // Remove the instancing buffer & element mask now
             vertexBuffers.pop_back();
@@ -44,6 +44,14 @@ namespace Urho3D
 {
 
 static const float INV_SQRT_TWO = 1.0f / sqrtf(2.0f);
+/// Number of key bits sorted per radix sort pass.
+static const unsigned RADIX_SORT_BITS = 11;
+/// Number of radix sort buckets.
+static const unsigned RADIX_SORT_BUCKETS = 1u << RADIX_SORT_BITS;
+/// Min number of billboards to use radix sort instead of comparison sort.
+static const unsigned MIN_RADIX_SORT_BILLBOARDS = 256;
+/// Quad corners for billboards expanded in vertex shader.
+static const Vector2 BILLBOARD_CORNERS[] = { {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f} };
 
 const char* faceCameraModeNames[] =
 {
@@ -75,6 +83,14 @@ inline bool CompareBillboards(Billboard* lhs, Billboard* rhs)
     return lhs->sortDistance_ > rhs->sortDistance_;
 }
 
+/// Return radix sort key digit. Distances are non-negative so inverted bit patterns sort back to front.
+inline unsigned GetBillboardSortDigit(const Billboard* billboard, unsigned shift)
+{
+    unsigned bits;
+    memcpy(&bits, &billboard->sortDistance_, sizeof(bits));
+    return (~bits >> shift) & (RADIX_SORT_BUCKETS - 1);
+}
+
 BillboardSet::BillboardSet(Context* context) :
     Drawable(context, DRAWABLE_GEOMETRY),
     animationLodBias_(1.0f),
@@ -85,6 +101,7 @@ BillboardSet::BillboardSet(Context* context) :
     fixedScreenSize_(false),
     faceCameraMode_(FC_ROTATE_XYZ),
     minAngle_(0.0f),
+    expandOnGPU_(false),
     geometry_(MakeShared<Geometry>(context)),
     vertexBuffer_(MakeShared<VertexBuffer>(context_)),
     indexBuffer_(MakeShared<IndexBuffer>(context_)),
@@ -126,6 +143,7 @@ void BillboardSet::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Draw Distance", GetDrawDistance, SetDrawDistance, float, 0.0f, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Shadow Distance", GetShadowDistance, SetShadowDistance, float, 0.0f, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Animation LOD Bias", GetAnimationLodBias, SetAnimationLodBias, float, 1.0f, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Expand On GPU", IsExpandedOnGPU, SetExpandOnGPU, bool, false, AM_DEFAULT);
     URHO3D_COPY_BASE_ATTRIBUTES(Drawable);
     URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Billboards", GetBillboardsAttr, SetBillboardsAttr, VariantVector, Variant::emptyVariantVector, AM_DEFAULT)
         .SetMetadata(AttributeMetadata::VectorStructElements, billboardsStructureElementNames);
@@ -363,6 +381,17 @@ void BillboardSet::SetAnimationLodBias(float bias)
     animationLodBias_ = Max(bias, 0.0f);
 }
 
+void BillboardSet::SetExpandOnGPU(bool enable)
+{
+    if (enable == expandOnGPU_)
+        return;
+
+    expandOnGPU_ = enable;
+    geometryTypeUpdate_ = true;
+    bufferSizeDirty_ = true;
+    Commit();
+}
+
 void BillboardSet::Commit()
 {
     MarkPositionsDirty();
@@ -485,20 +514,49 @@ void BillboardSet::OnWorldBoundingBoxUpdate()
 
 void BillboardSet::UpdateBufferSize()
 {
-    unsigned numBillboards = billboards_.size();
+    const unsigned numBillboards = billboards_.size();
+    const bool perInstance = IsPerInstanceLayout();
+    const unsigned numVertices = perInstance ? numBillboards : numBillboards * 4;
 
-    if (vertexBuffer_->GetVertexCount() != numBillboards * 4 || geometryTypeUpdate_
-        || vertexBuffer_->GetElementMask() == MASK_NONE)
+    if (vertexBuffer_->GetVertexCount() != numVertices || geometryTypeUpdate_ || vertexBuffer_->GetElements().empty())
     {
-        vertexBuffer_->SetSize(numBillboards * 4, GetVertexBufferFormat(), true);
-        geometry_->SetVertexBuffer(0, vertexBuffer_);
+        if (perInstance)
+        {
+            static const ea::vector<VertexElement> instanceElements = {
+                VertexElement(TYPE_VECTOR3, SEM_POSITION, 0, true),
+                VertexElement(TYPE_UBYTE4_NORM, SEM_COLOR, 0, true),
+                VertexElement(TYPE_VECTOR4, SEM_TEXCOORD, 0, true),
+                VertexElement(TYPE_VECTOR4, SEM_TEXCOORD, 1, true),
+            };
+            vertexBuffer_->SetSize(numVertices, instanceElements, true);
+
+            if (!cornerBuffer_)
+            {
+                cornerBuffer_ = MakeShared<VertexBuffer>(context_);
+                cornerBuffer_->SetShadowed(true);
+                cornerBuffer_->SetSize(4, {VertexElement(TYPE_VECTOR2, SEM_TEXCOORD, 2)});
+                cornerBuffer_->SetData(BILLBOARD_CORNERS);
+            }
+
+            geometry_->SetNumVertexBuffers(2);
+            geometry_->SetVertexBuffer(0, vertexBuffer_);
+            geometry_->SetVertexBuffer(1, cornerBuffer_);
+        }
+        else
+        {
+            vertexBuffer_->SetSize(numVertices, GetVertexBufferFormat(), true);
+            geometry_->SetNumVertexBuffers(1);
+            geometry_->SetVertexBuffer(0, vertexBuffer_);
+        }
         geometryTypeUpdate_ = false;
     }
 
-    bool largeIndices = (numBillboards * 4) >= 65536;
+    // All instances share the same quad
+    const unsigned numQuads = perInstance ? ea::min(numBillboards, 1u) : numBillboards;
+    bool largeIndices = (numQuads * 4) >= 65536;
 
-    if (indexBuffer_->GetIndexCount() != numBillboards * 6)
-        indexBuffer_->SetSize(numBillboards * 6, largeIndices);
+    if (indexBuffer_->GetIndexCount() != numQuads * 6)
+        indexBuffer_->SetSize(numQuads * 6, largeIndices);
 
     bufferSizeDirty_ = false;
     bufferDirty_ = true;
@@ -508,15 +566,17 @@ void BillboardSet::UpdateBufferSize()
         return;
 
     // Indices do not change for a given billboard capacity
-    void* destPtr = indexBuffer_->Lock(0, numBillboards * 6, true);
+    void* destPtr = indexBuffer_->Lock(0, numQuads * 6, true);
     if (!destPtr)
         return;
 
+    unsigned remainingQuads = numQuads;
+
     if (!largeIndices)
     {
         auto* dest = (unsigned short*)destPtr;
         unsigned short vertexIndex = 0;
-        while (numBillboards--)
+        while (remainingQuads--)
         {
             dest[0] = vertexIndex;
             dest[1] = vertexIndex + 1;
@@ -533,7 +593,7 @@ void BillboardSet::UpdateBufferSize()
     {
         auto* dest = (unsigned*)destPtr;
         unsigned vertexIndex = 0;
-        while (numBillboards--)
+        while (remainingQuads--)
         {
             dest[0] = vertexIndex;
             dest[1] = vertexIndex + 1;
@@ -746,6 +806,71 @@ void BillboardSet::BuildAxisAngleVertexBuffer(unsigned enabledBillboards, float*
         ++dest;
     }
 }
+void BillboardSet::BuildPerInstanceVertexBuffer(unsigned enabledBillboards, float* dest, const Vector3& billboardScale)
+{
+    for (unsigned i = 0; i < enabledBillboards; ++i)
+    {
+        Billboard& billboard = *sortedBillboards_[i];
+
+        Vector2 size(billboard.size_.x_ * billboardScale.x_, billboard.size_.y_ * billboardScale.y_);
+        if (fixedScreenSize_)
+            size *= billboard.screenScaleFactor_;
+
+        float rotationSin, rotationCos;
+        SinCos(billboard.rotation_, rotationSin, rotationCos);
+
+        dest[0] = billboard.position_.x_;
+        dest[1] = billboard.position_.y_;
+        dest[2] = billboard.position_.z_;
+        ((unsigned&)dest[3]) = billboard.color_.ToUInt();
+        dest[4] = billboard.uv_.min_.x_;
+        dest[5] = billboard.uv_.min_.y_;
+        dest[6] = billboard.uv_.max_.x_;
+        dest[7] = billboard.uv_.max_.y_;
+        dest[8] = size.x_;
+        dest[9] = size.y_;
+        dest[10] = rotationCos;
+        dest[11] = rotationSin;
+
+        dest += 12;
+    }
+}
+
+void BillboardSet::SortBillboards()
+{
+    if (sortedBillboards_.size() < MIN_RADIX_SORT_BILLBOARDS)
+    {
+        ea::quick_sort(sortedBillboards_.begin(), sortedBillboards_.end(), CompareBillboards);
+        return;
+    }
+
+    // Stable LSD radix sort, sort keys are 32 bit
+    sortBuffer_.resize(sortedBillboards_.size());
+    ea::vector<Billboard*>* source = &sortedBillboards_;
+    ea::vector<Billboard*>* dest = &sortBuffer_;
+    for (unsigned shift = 0; shift < 32; shift += RADIX_SORT_BITS)
+    {
+        unsigned offsets[RADIX_SORT_BUCKETS]{};
+        for (const Billboard* billboard : *source)
+            ++offsets[GetBillboardSortDigit(billboard, shift)];
+
+        unsigned offset = 0;
+        for (unsigned& bucketOffset : offsets)
+        {
+            const unsigned count = bucketOffset;
+            bucketOffset = offset;
+            offset += count;
+        }
+
+        for (Billboard* billboard : *source)
+            (*dest)[offsets[GetBillboardSortDigit(billboard, shift)]++] = billboard;
+        ea::swap(source, dest);
+    }
+
+    if (source != &sortedBillboards_)
+        sortedBillboards_.swap(sortBuffer_);
+}
+
 void BillboardSet::UpdateVertexBuffer(const FrameInfo& frame)
 {
     // If using animation LOD, accumulate time and see if it is time to update
@@ -790,7 +915,17 @@ void BillboardSet::UpdateVertexBuffer(const FrameInfo& frame)
         }
     }
 
-    batches_[0].geometry_->SetDrawRange(TRIANGLE_LIST, 0, enabledBillboards * 6, false);
+    const bool perInstance = IsPerInstanceLayout();
+    if (perInstance)
+    {
+        batches_[0].geometry_->SetDrawRange(TRIANGLE_LIST, 0, enabledBillboards ? 6 : 0, false);
+        batches_[0].numGeometryInstances_ = enabledBillboards;
+    }
+    else
+    {
+        batches_[0].geometry_->SetDrawRange(TRIANGLE_LIST, 0, enabledBillboards * 6, false);
+        batches_[0].numGeometryInstances_ = 0;
+    }
 
     bufferDirty_ = false;
     forceUpdate_ = false;
@@ -799,17 +934,21 @@ void BillboardSet::UpdateVertexBuffer(const FrameInfo& frame)
 
     if (sorted_)
     {
-        ea::quick_sort(sortedBillboards_.begin(), sortedBillboards_.end(), CompareBillboards);
+        SortBillboards();
         Vector3 worldPos = node_->GetWorldPosition();
         // Store the "last sorted position" now
         previousOffset_ = (worldPos - frame.camera_->GetNode()->GetWorldPosition());
     }
 
-    auto* dest = (float*)vertexBuffer_->Lock(0, enabledBillboards * 4, true);
+    auto* dest = (float*)vertexBuffer_->Lock(0, perInstance ? enabledBillboards : enabledBillboards * 4, true);
     if (!dest)
         return;
 
-    if (faceCameraMode_ == FC_DIRECTION)
+    if (perInstance)
+    {
+        BuildPerInstanceVertexBuffer(enabledBillboards, dest, billboardScale);
+    }
+    else if (faceCameraMode_ == FC_DIRECTION)
     {
         BuildDirectionVertexBuffer(enabledBillboards, dest, billboardScale);
     }
@@ -110,6 +110,10 @@ public:
     /// Set animation LOD bias.
     /// @property
     void SetAnimationLodBias(float bias);
+    /// Set whether to upload one vertex per billboard and expand quads in vertex shader. Default false.
+    /// Applies only to face camera modes other than FC_DIRECTION and FC_AXIS_ANGLE. Requires render pipeline.
+    /// @property
+    void SetExpandOnGPU(bool enable);
     /// Mark for bounding box and vertex buffer update. Call after modifying the billboards.
     void Commit();
 
@@ -156,6 +160,10 @@ public:
     /// @property
     float GetAnimationLodBias() const { return animationLodBias_; }
 
+    /// Return whether to upload one vertex per billboard and expand quads in vertex shader.
+    /// @property
+    bool IsExpandedOnGPU() const { return expandOnGPU_; }
+
     /// Set material attribute.
     void SetMaterialAttr(const ResourceRef& value);
     /// Set billboards attribute.
@@ -191,6 +199,8 @@ protected:
     FaceCameraMode faceCameraMode_;
     /// Minimal angle between billboard normal and look-at direction.
     float minAngle_;
+    /// Expand quads in vertex shader flag.
+    bool expandOnGPU_;
 
 private:
     /// Resize billboard vertex and index buffers.
@@ -203,6 +213,12 @@ private:
     void BuildDirectionVertexBuffer(unsigned enabledBillboards, float* dest, const Vector3& billboardScale);
     ///
     void BuildAxisAngleVertexBuffer(unsigned enabledBillboards, float* dest, const Vector3& billboardScale);
+    /// Write one per-instance vertex per billboard.
+    void BuildPerInstanceVertexBuffer(unsigned enabledBillboards, float* dest, const Vector3& billboardScale);
+    /// Sort billboards back to front.
+    void SortBillboards();
+    /// Return whether vertex buffer contains per-instance data expanded in vertex shader.
+    bool IsPerInstanceLayout() const { return expandOnGPU_ && batches_[0].geometryType_ == GEOM_BILLBOARD; }
     /// Return currently requested format of vertex buffer.
     unsigned GetVertexBufferFormat() const;
     /// Calculate billboard scale factors in fixed screen size mode.
@@ -214,6 +230,8 @@ private:
     SharedPtr<VertexBuffer> vertexBuffer_;
     /// Index buffer.
     SharedPtr<IndexBuffer> indexBuffer_;
+    /// Quad corners vertex buffer used with per-instance vertex buffer.
+    SharedPtr<VertexBuffer> cornerBuffer_;
     /// Transform matrices for position and billboard orientation.
     Matrix3x4 transforms_[2];
     /// Buffers need resize flag.
@@ -234,6 +252,8 @@ private:
     Vector3 previousOffset_;
     /// Billboard pointers for sorting.
     ea::vector<Billboard*> sortedBillboards_;
+    /// Temporary storage for sorting.
+    ea::vector<Billboard*> sortBuffer_;
 };
 
 }
@@ -0,0 +1,102 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Graphics/ClusteredDecalSet.h"
+
+#include "../Core/Context.h"
+#include "../Graphics/Texture2D.h"
+#include "../Resource/ResourceCache.h"
+
+#include <EASTL/algorithm.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+ClusteredDecalSet::ClusteredDecalSet(Context* context)
+    : Component(context)
+{
+}
+
+ClusteredDecalSet::~ClusteredDecalSet() = default;
+
+void ClusteredDecalSet::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<ClusteredDecalSet>(Category_Geometry);
+
+    URHO3D_ACCESSOR_ATTRIBUTE("Is Enabled", IsEnabled, SetEnabled, bool, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Texture", GetTextureAttr, SetTextureAttr, ResourceRef, ResourceRef(Texture2D::GetTypeStatic()), AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max Decals", GetMaxDecals, SetMaxDecals, unsigned, DefaultMaxDecals, AM_DEFAULT);
+}
+
+void ClusteredDecalSet::AddDecal(const Vector3& position, const Quaternion& rotation, const Vector3& size, const Rect& uvRect)
+{
+    if (maxDecals_ == 0)
+        return;
+
+    const ClusteredDecal decal{Matrix3x4{position, rotation, size}, uvRect};
+    if (decals_.size() < maxDecals_)
+        decals_.push_back(decal);
+    else
+    {
+        decals_[nextDecal_] = decal;
+        nextDecal_ = (nextDecal_ + 1) % maxDecals_;
+    }
+}
+
+void ClusteredDecalSet::RemoveAllDecals()
+{
+    decals_.clear();
+    nextDecal_ = 0;
+}
+
+void ClusteredDecalSet::SetTexture(Texture2D* texture)
+{
+    texture_ = texture;
+}
+
+void ClusteredDecalSet::SetMaxDecals(unsigned maxDecals)
+{
+    maxDecals_ = maxDecals;
+
+    // Order decals from the oldest to the newest and keep the newest ones
+    ea::rotate(decals_.begin(), decals_.begin() + nextDecal_, decals_.end());
+    nextDecal_ = 0;
+    if (decals_.size() > maxDecals_)
+        decals_.erase(decals_.begin(), decals_.end() - maxDecals_);
+}
+
+void ClusteredDecalSet::SetTextureAttr(const ResourceRef& value)
+{
+    auto* cache = GetSubsystem<ResourceCache>();
+    SetTexture(cache->GetResource<Texture2D>(value.name_));
+}
+
+ResourceRef ClusteredDecalSet::GetTextureAttr() const
+{
+    return GetResourceRef(texture_, Texture2D::GetTypeStatic());
+}
+
+}
@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Math/Matrix3x4.h"
+#include "../Math/Rect.h"
+#include "../Scene/Component.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class Texture2D;
+
+/// Decal rendered by ClusteredDecalSet.
+struct ClusteredDecal
+{
+    /// Transform of the decal box. Decal texture is projected onto unit box along local Z axis.
+    Matrix3x4 worldTransform_;
+    /// Texture coordinates of the decal in the decal texture.
+    Rect uvRect_{Rect::POSITIVE};
+};
+
+/// Set of decals applied to surfaces in the base pass without generating any geometry.
+/// Decals are binned into the same view clusters as clustered lights and are rendered
+/// only if clustered forward lighting is enabled. Should be created on the Scene node.
+/// Decals are stored in a ring buffer: when the set is full, the oldest decal is replaced.
+class URHO3D_API ClusteredDecalSet : public Component
+{
+    URHO3D_OBJECT(ClusteredDecalSet, Component);
+
+public:
+    /// Default max number of decals.
+    static const unsigned DefaultMaxDecals = 256;
+
+    /// Construct.
+    explicit ClusteredDecalSet(Context* context);
+    /// Destruct.
+    ~ClusteredDecalSet() override;
+    /// Register object factory.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Add decal with world-space box center, orientation and size. Decal is projected along local Z axis.
+    void AddDecal(const Vector3& position, const Quaternion& rotation, const Vector3& size, const Rect& uvRect = Rect::POSITIVE);
+    /// Remove all decals.
+    void RemoveAllDecals();
+
+    /// Set decal texture. Decals refer to rectangles of this texture.
+    /// @property
+    void SetTexture(Texture2D* texture);
+    /// Set max number of decals.
+    /// @property
+    void SetMaxDecals(unsigned maxDecals);
+
+    /// Return decal texture.
+    /// @property
+    Texture2D* GetTexture() const { return texture_; }
+    /// Return max number of decals.
+    /// @property
+    unsigned GetMaxDecals() const { return maxDecals_; }
+    /// Return number of decals.
+    /// @property
+    unsigned GetNumDecals() const { return decals_.size(); }
+    /// Return all decals in no particular order.
+    const ea::vector<ClusteredDecal>& GetDecals() const { return decals_; }
+
+    /// Set texture attribute.
+    void SetTextureAttr(const ResourceRef& value);
+    /// Return texture attribute.
+    ResourceRef GetTextureAttr() const;
+
+private:
+    /// Decals.
+    ea::vector<ClusteredDecal> decals_;
+    /// Index of the decal to be replaced when the set is full.
+    unsigned nextDecal_{};
+    /// Decal texture.
+    SharedPtr<Texture2D> texture_;
+    /// Max number of decals.
+    unsigned maxDecals_{DefaultMaxDecals};
+};
+
+}
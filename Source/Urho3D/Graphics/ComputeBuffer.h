@@ -71,8 +71,8 @@ public:
 #endif
 
 private:
-    unsigned size_;
-    unsigned structureSize_;
+    unsigned size_{};
+    unsigned structureSize_{};
 #if defined(URHO3D_D3D11)
     ID3D11UnorderedAccessView* uav_;
 #endif
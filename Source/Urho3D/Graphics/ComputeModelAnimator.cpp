@@ -0,0 +1,388 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Graphics/ComputeBuffer.h"
+#include "../Graphics/ComputeDevice.h"
+#include "../Graphics/ComputeModelAnimator.h"
+#include "../Graphics/Geometry.h"
+#include "../Graphics/Graphics.h"
+#include "../Graphics/IndexBuffer.h"
+#include "../Graphics/VertexBuffer.h"
+#include "../IO/Log.h"
+
+#include "../DebugNew.h"
+
+#if defined(URHO3D_COMPUTE)
+
+namespace Urho3D
+{
+
+namespace
+{
+
+unsigned DivideRoundUp(unsigned value, unsigned divisor)
+{
+    return (value + divisor - 1) / divisor;
+}
+
+void UnpackElement(const VertexBuffer* buffer, VertexElementSemantic semantic, Vector4* dest, unsigned destStride)
+{
+    if (const VertexElement* element = buffer->GetElement(semantic))
+    {
+        VertexBuffer::UnpackVertexData(buffer->GetShadowData(), buffer->GetVertexSize(), *element,
+            0, buffer->GetVertexCount(), dest, destStride);
+    }
+}
+
+void ReadMorphDelta(Vector4& dest, const unsigned char*& src)
+{
+    float delta[3];
+    memcpy(delta, src, sizeof(delta));
+    dest = Vector4(delta[0], delta[1], delta[2], 0.0f);
+    src += sizeof(delta);
+}
+
+}
+
+ComputeModelAnimationData::ComputeModelAnimationData(Context* context, Model* model)
+{
+    const auto& vertexBuffers = model->GetVertexBuffers();
+    const auto& morphs = model->GetMorphs();
+    buffers_.resize(vertexBuffers.size());
+
+    ea::vector<Vector4> data;
+    for (unsigned bufferIndex = 0; bufferIndex < vertexBuffers.size(); ++bufferIndex)
+    {
+        VertexBuffer* vertexBuffer = vertexBuffers[bufferIndex];
+        ComputeAnimationBufferData& bufferData = buffers_[bufferIndex];
+        if (!vertexBuffer || !vertexBuffer->GetShadowData())
+        {
+            URHO3D_LOGERROR("Vertex buffer must be shadowed for compute skinning and morphing");
+            continue;
+        }
+
+        const unsigned numVertices = vertexBuffer->GetVertexCount();
+        bufferData.numVertices_ = numVertices;
+        bufferData.morphRangeStart_ = model->GetMorphRangeStart(bufferIndex);
+        bufferData.morphRangeCount_ = model->GetMorphRangeCount(bufferIndex);
+        bufferData.hasSkeletalAnimation_ =
+            vertexBuffer->HasElement(SEM_BLENDINDICES) && vertexBuffer->HasElement(SEM_BLENDWEIGHTS);
+
+        // Unpack source vertices
+        const unsigned stride = SourceVertexSize * sizeof(Vector4);
+        data.clear();
+        data.resize(numVertices * SourceVertexSize, Vector4::ZERO);
+        UnpackElement(vertexBuffer, SEM_POSITION, &data[0], stride);
+        UnpackElement(vertexBuffer, SEM_NORMAL, &data[1], stride);
+        UnpackElement(vertexBuffer, SEM_TANGENT, &data[2], stride);
+        if (bufferData.hasSkeletalAnimation_)
+        {
+            UnpackElement(vertexBuffer, SEM_BLENDWEIGHTS, &data[3], stride);
+            UnpackElement(vertexBuffer, SEM_BLENDINDICES, &data[4], stride);
+        }
+
+        bufferData.vertices_ = MakeShared<ComputeBuffer>(context);
+        if (!bufferData.vertices_->SetSize(data.size() * sizeof(Vector4), sizeof(Vector4))
+            || !bufferData.vertices_->SetData(data.data(), data.size() * sizeof(Vector4), sizeof(Vector4)))
+        {
+            URHO3D_LOGERROR("Failed to create source vertices for compute skinning and morphing");
+            bufferData = {};
+            continue;
+        }
+
+        // Expand sparse morph data into dense deltas within morph range
+        bufferData.morphSlots_.resize(morphs.size(), M_MAX_UNSIGNED);
+        unsigned numSlots = 0;
+        for (unsigned morphIndex = 0; morphIndex < morphs.size(); ++morphIndex)
+        {
+            if (morphs[morphIndex].buffers_.count(bufferIndex) && bufferData.morphRangeCount_ > 0)
+                bufferData.morphSlots_[morphIndex] = numSlots++;
+        }
+
+        data.clear();
+        data.resize(ea::max(1u, numSlots * bufferData.morphRangeCount_ * MorphDeltaSize), Vector4::ZERO);
+        for (unsigned morphIndex = 0; morphIndex < morphs.size(); ++morphIndex)
+        {
+            const unsigned slot = bufferData.morphSlots_[morphIndex];
+            if (slot == M_MAX_UNSIGNED)
+                continue;
+
+            const VertexBufferMorph& morph = morphs[morphIndex].buffers_.find(bufferIndex)->second;
+            bufferData.animatedElementMask_ |= morph.elementMask_;
+
+            const unsigned char* srcData = morph.morphData_.get();
+            for (unsigned i = 0; i < morph.vertexCount_; ++i)
+            {
+                unsigned vertexIndex{};
+                memcpy(&vertexIndex, srcData, sizeof(unsigned));
+                srcData += sizeof(unsigned);
+
+                Vector4 deltas[MorphDeltaSize];
+                if (morph.elementMask_ & MASK_POSITION)
+                    ReadMorphDelta(deltas[0], srcData);
+                if (morph.elementMask_ & MASK_NORMAL)
+                    ReadMorphDelta(deltas[1], srcData);
+                if (morph.elementMask_ & MASK_TANGENT)
+                    ReadMorphDelta(deltas[2], srcData);
+
+                const unsigned rangeIndex = vertexIndex - bufferData.morphRangeStart_;
+                if (rangeIndex >= bufferData.morphRangeCount_)
+                    continue;
+
+                const unsigned deltaIndex = (slot * bufferData.morphRangeCount_ + rangeIndex) * MorphDeltaSize;
+                ea::copy(ea::begin(deltas), ea::end(deltas), &data[deltaIndex]);
+            }
+        }
+
+        bufferData.morphDeltas_ = MakeShared<ComputeBuffer>(context);
+        bufferData.morphDeltas_->SetSize(data.size() * sizeof(Vector4), sizeof(Vector4));
+        bufferData.morphDeltas_->SetData(data.data(), data.size() * sizeof(Vector4), sizeof(Vector4));
+        bufferData.animatedElementMask_ &= vertexBuffer->GetElementMask();
+    }
+}
+
+SharedPtr<ComputeModelAnimationData> ComputeModelAnimationData::GetOrCreate(Context* context, Model* model)
+{
+    if (auto data = dynamic_cast<ComputeModelAnimationData*>(model->GetAnimationData()))
+        return SharedPtr<ComputeModelAnimationData>(data);
+
+    auto data = MakeShared<ComputeModelAnimationData>(context, model);
+    model->SetAnimationData(data);
+    return data;
+}
+
+ComputeModelAnimator::ComputeModelAnimator(Context* context)
+    : Object(context)
+    , computeDevice_(GetSubsystem<ComputeDevice>())
+{
+}
+
+ComputeModelAnimator::~ComputeModelAnimator() {}
+
+void ComputeModelAnimator::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<ComputeModelAnimator>();
+}
+
+bool ComputeModelAnimator::IsSupported(Context* context)
+{
+    auto computeDevice = context->GetSubsystem<ComputeDevice>();
+    return computeDevice && computeDevice->IsSupported();
+}
+
+void ComputeModelAnimator::Initialize(Model* model, bool skinned)
+{
+    originalModel_ = model;
+    skinned_ = skinned;
+    sourceData_ = ComputeModelAnimationData::GetOrCreate(context_, model);
+    CreateOutputGeometries();
+    ResetAnimation();
+}
+
+void ComputeModelAnimator::ResetAnimation()
+{
+    activeMorphs_.clear();
+    boneMatrices_.clear();
+}
+
+void ComputeModelAnimator::ApplyMorphs(ea::span<const ModelMorph> morphs)
+{
+    for (unsigned morphIndex = 0; morphIndex < morphs.size(); ++morphIndex)
+    {
+        if (morphs[morphIndex].weight_ != 0.0f)
+            activeMorphs_.emplace_back(morphIndex, morphs[morphIndex].weight_);
+    }
+}
+
+void ComputeModelAnimator::ApplySkinning(ea::span<const Matrix3x4> worldTransforms)
+{
+    if (skinned_)
+        boneMatrices_.assign(worldTransforms.begin(), worldTransforms.end());
+}
+
+void ComputeModelAnimator::Commit()
+{
+    if (!computeDevice_ || !computeDevice_->IsSupported())
+        return;
+
+    auto graphics = GetSubsystem<Graphics>();
+    ShaderVariation* animationShader = graphics->GetShader(CS, "v2/C_Skinning");
+    if (!animationShader)
+        return;
+
+    computeDevice_->SetProgram(animationShader);
+
+    const auto& buffersData = sourceData_->GetBuffers();
+    for (unsigned bufferIndex = 0; bufferIndex < vertexBuffers_.size(); ++bufferIndex)
+    {
+        VertexBuffer* outputBuffer = vertexBuffers_[bufferIndex];
+        if (!outputBuffer)
+            continue;
+
+        const ComputeAnimationBufferData& bufferData = buffersData[bufferIndex];
+        const bool applySkinning = skinned_ && bufferData.hasSkeletalAnimation_ && !boneMatrices_.empty();
+
+        // Fill parameters: header, active morphs of this buffer and bone matrices
+        AnimationParameters parameters;
+        parametersData_.clear();
+        for (const auto& [morphIndex, weight] : activeMorphs_)
+        {
+            const unsigned slot = morphIndex < bufferData.morphSlots_.size() ? bufferData.morphSlots_[morphIndex] : M_MAX_UNSIGNED;
+            if (slot != M_MAX_UNSIGNED)
+                parametersData_.emplace_back(static_cast<float>(slot), weight, 0.0f, 0.0f);
+        }
+
+        parameters.header_[0] = bufferData.numVertices_;
+        parameters.header_[1] = bufferData.morphRangeStart_;
+        parameters.header_[2] = bufferData.morphRangeCount_;
+        parameters.header_[3] = parametersData_.size();
+
+        parameters.layout_[0] = applySkinning;
+        parameters.layout_[1] = outputBuffer->GetVertexSize() / sizeof(Vector4);
+        const unsigned normalOffset = outputBuffer->GetElementOffset(SEM_NORMAL);
+        const unsigned tangentOffset = outputBuffer->GetElementOffset(SEM_TANGENT);
+        parameters.layout_[2] = normalOffset != M_MAX_UNSIGNED ? normalOffset / sizeof(Vector4) : M_MAX_UNSIGNED;
+        parameters.layout_[3] = tangentOffset != M_MAX_UNSIGNED ? tangentOffset / sizeof(Vector4) : M_MAX_UNSIGNED;
+
+        if (applySkinning)
+        {
+            for (const Matrix3x4& matrix : boneMatrices_)
+            {
+                parametersData_.emplace_back(matrix.m00_, matrix.m01_, matrix.m02_, matrix.m03_);
+                parametersData_.emplace_back(matrix.m10_, matrix.m11_, matrix.m12_, matrix.m13_);
+                parametersData_.emplace_back(matrix.m20_, matrix.m21_, matrix.m22_, matrix.m23_);
+            }
+        }
+
+        static_assert(sizeof(AnimationParameters) % sizeof(Vector4) == 0);
+        const unsigned headerSize = sizeof(AnimationParameters) / sizeof(Vector4);
+        parametersData_.insert(parametersData_.begin(), headerSize, Vector4::ZERO);
+        memcpy(parametersData_.data(), &parameters, sizeof(AnimationParameters));
+
+        // Pad data to buffer capacity to avoid buffer reallocation on every change of active morphs
+        ComputeBuffer* parametersBuffer = parametersBuffers_[bufferIndex];
+        const unsigned capacity = NextPowerOfTwo(parametersData_.size());
+        if (!EnsureBufferSize(parametersBuffer, capacity * sizeof(Vector4), sizeof(Vector4)))
+            continue;
+        parametersBuffer->SetData(parametersData_.data(), parametersData_.size() * sizeof(Vector4), sizeof(Vector4));
+
+        computeDevice_->SetWriteBuffer(parametersBuffer, 0);
+        computeDevice_->SetWriteBuffer(bufferData.vertices_, 1);
+        computeDevice_->SetWriteBuffer(bufferData.morphDeltas_, 2);
+        computeDevice_->SetWriteBuffer(outputBuffer, 3);
+        computeDevice_->Dispatch(DivideRoundUp(bufferData.numVertices_, GroupSize), 1, 1);
+    }
+
+    // Unbind output buffers so they can be used as vertex buffers
+    for (unsigned unit = 0; unit < 4; ++unit)
+        computeDevice_->SetWriteBuffer(static_cast<ComputeBuffer*>(nullptr), unit);
+    computeDevice_->SetProgram(nullptr);
+    computeDevice_->ApplyBindings();
+}
+
+void ComputeModelAnimator::CreateOutputGeometries()
+{
+    const auto& originalVertexBuffers = originalModel_->GetVertexBuffers();
+    const auto& buffersData = sourceData_->GetBuffers();
+    vertexBuffers_.clear();
+    vertexBuffers_.resize(originalVertexBuffers.size());
+    parametersBuffers_.clear();
+    parametersBuffers_.resize(originalVertexBuffers.size());
+
+    ea::unordered_map<VertexBuffer*, VertexBuffer*> originalToOutputMapping;
+    for (unsigned i = 0; i < originalVertexBuffers.size(); ++i)
+    {
+        VertexBuffer* originalVertexBuffer = originalVertexBuffers[i];
+        const ComputeAnimationBufferData& bufferData = buffersData[i];
+        if (!bufferData.vertices_)
+            continue;
+
+        const VertexMaskFlags skinnedMask = skinned_ && bufferData.hasSkeletalAnimation_
+            ? VertexMaskFlags{MASK_POSITION | MASK_NORMAL | MASK_TANGENT} : VertexMaskFlags{MASK_NONE};
+        const VertexMaskFlags outputMask = (skinnedMask | bufferData.animatedElementMask_) & originalVertexBuffer->GetElementMask();
+        if (!outputMask)
+            continue;
+
+        // All elements are Vector4 so the buffer can be written by compute shader
+        ea::vector<VertexElement> outputElements;
+        outputElements.emplace_back(TYPE_VECTOR4, SEM_POSITION);
+        if (outputMask & MASK_NORMAL)
+            outputElements.emplace_back(TYPE_VECTOR4, SEM_NORMAL);
+        if (outputMask & MASK_TANGENT)
+            outputElements.emplace_back(TYPE_VECTOR4, SEM_TANGENT);
+
+        auto outputVertexBuffer = MakeShared<VertexBuffer>(context_);
+        if (!outputVertexBuffer->SetSize(bufferData.numVertices_, outputElements, false))
+        {
+            URHO3D_LOGERROR("Failed to create output vertex buffer for compute skinning and morphing");
+            continue;
+        }
+
+        originalToOutputMapping[originalVertexBuffer] = outputVertexBuffer;
+        vertexBuffers_[i] = outputVertexBuffer;
+        parametersBuffers_[i] = MakeShared<ComputeBuffer>(context_);
+    }
+
+    // Append output vertex buffers to original geometries, later buffers override animated elements
+    geometries_ = originalModel_->GetGeometries();
+    for (auto& geometryLods : geometries_)
+    {
+        for (SharedPtr<Geometry>& geometry : geometryLods)
+        {
+            SharedPtr<Geometry> originalGeometry = geometry;
+            SharedPtr<Geometry> animatedGeometry = MakeShared<Geometry>(context_);
+
+            // Note: array grows inside loop
+            ea::vector<SharedPtr<VertexBuffer>> vertexBuffers = originalGeometry->GetVertexBuffers();
+            const unsigned numVertexBuffers = vertexBuffers.size();
+            for (unsigned i = 0; i < numVertexBuffers; ++i)
+            {
+                const auto outputBufferIter = originalToOutputMapping.find(vertexBuffers[i]);
+                if (outputBufferIter != originalToOutputMapping.end())
+                    vertexBuffers.emplace_back(outputBufferIter->second);
+            }
+
+            animatedGeometry->SetIndexBuffer(originalGeometry->GetIndexBuffer());
+            animatedGeometry->SetVertexBuffers(vertexBuffers);
+            animatedGeometry->SetDrawRange(originalGeometry->GetPrimitiveType(),
+                originalGeometry->GetIndexStart(), originalGeometry->GetIndexCount());
+            animatedGeometry->SetLodDistance(originalGeometry->GetLodDistance());
+
+            geometry = animatedGeometry;
+        }
+    }
+}
+
+bool ComputeModelAnimator::EnsureBufferSize(ComputeBuffer* buffer, unsigned size, unsigned structureSize)
+{
+    if (buffer->GetSize() >= size && buffer->GetStructSize() == structureSize)
+        return true;
+    return buffer->SetSize(size, structureSize);
+}
+
+}
+
+#endif
@@ -0,0 +1,162 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Graphics/Model.h"
+
+#include <EASTL/span.h>
+
+#if defined(URHO3D_COMPUTE)
+
+namespace Urho3D
+{
+
+class ComputeBuffer;
+class ComputeDevice;
+
+/// Source data of vertex buffer for compute animation.
+struct ComputeAnimationBufferData
+{
+    /// Number of vertices.
+    unsigned numVertices_{};
+    /// First morphed vertex.
+    unsigned morphRangeStart_{};
+    /// Number of morphed vertices.
+    unsigned morphRangeCount_{};
+    /// Whether the buffer has skeletal animation data.
+    bool hasSkeletalAnimation_{};
+    /// Elements overridden by animated data.
+    VertexMaskFlags animatedElementMask_{};
+    /// Index of morph data within vertex buffer for each model morph, or M_MAX_UNSIGNED if not morphed.
+    ea::vector<unsigned> morphSlots_;
+    /// Source vertices: position, normal, tangent, blend weights and blend indices per vertex.
+    SharedPtr<ComputeBuffer> vertices_;
+    /// Dense morph deltas of position, normal and tangent for each morph slot and each vertex in morph range.
+    SharedPtr<ComputeBuffer> morphDeltas_;
+};
+
+/// Source data for compute animation of the model. Shared between all animated instances of the model.
+class URHO3D_API ComputeModelAnimationData : public RefCounted
+{
+public:
+    /// Number of Vector4 elements in source vertex.
+    static const unsigned SourceVertexSize = 5;
+    /// Number of Vector4 elements in morph delta.
+    static const unsigned MorphDeltaSize = 3;
+
+    /// Construct from model.
+    ComputeModelAnimationData(Context* context, Model* model);
+    /// Return existing data for the model or create new one.
+    static SharedPtr<ComputeModelAnimationData> GetOrCreate(Context* context, Model* model);
+
+    /// Return data of vertex buffers. Indices match vertex buffers of the model.
+    const ea::vector<ComputeAnimationBufferData>& GetBuffers() const { return buffers_; }
+
+private:
+    /// Data of vertex buffers.
+    ea::vector<ComputeAnimationBufferData> buffers_;
+};
+
+/// Class for model animation (morphing and skinning) in compute shader.
+/// Source data is uploaded once per model. Each instance owns only its parameters and output vertex buffers,
+/// so geometries are not cloned: output buffers are appended to original geometries and override animated elements.
+/// Output is computed once per update and reused by all passes that render the model.
+class URHO3D_API ComputeModelAnimator : public Object
+{
+    URHO3D_OBJECT(ComputeModelAnimator, Object);
+
+public:
+    /// Number of threads in compute group.
+    static const unsigned GroupSize = 64;
+
+    /// Construct.
+    explicit ComputeModelAnimator(Context* context);
+    /// Destruct.
+    ~ComputeModelAnimator() override;
+    /// Register object factory.
+    static void RegisterObject(Context* context);
+
+    /// Return whether compute animation is supported by the device.
+    static bool IsSupported(Context* context);
+
+    /// Initialize with model. Shall be manually called on model reload.
+    void Initialize(Model* model, bool skinned);
+
+    /// Reset morph and/or skeletal animation.
+    void ResetAnimation();
+    /// Apply morphs.
+    void ApplyMorphs(ea::span<const ModelMorph> morphs);
+    /// Apply skinning.
+    void ApplySkinning(ea::span<const Matrix3x4> worldTransforms);
+    /// Dispatch animation to GPU.
+    void Commit();
+
+    /// Return animated geometries.
+    const ea::vector<ea::vector<SharedPtr<Geometry>>>& GetGeometries() const { return geometries_; }
+
+    /// Return all output vertex buffers.
+    const ea::vector<SharedPtr<VertexBuffer> >& GetVertexBuffers() const { return vertexBuffers_; }
+
+private:
+    /// Parameters header of animation shader. Layout should match C_Skinning shader.
+    struct AnimationParameters
+    {
+        /// Number of vertices, morph range start, morph range count, number of active morphs.
+        unsigned header_[4]{};
+        /// Whether to apply skinning, output stride, normal offset and tangent offset in output vertex.
+        unsigned layout_[4]{};
+    };
+
+    /// Create output vertex buffers and geometries.
+    void CreateOutputGeometries();
+    /// Ensure that compute buffer has at least specified size.
+    bool EnsureBufferSize(ComputeBuffer* buffer, unsigned size, unsigned structureSize);
+
+    /// Compute device.
+    WeakPtr<ComputeDevice> computeDevice_;
+    /// Original model.
+    SharedPtr<Model> originalModel_;
+    /// Shared source data.
+    SharedPtr<ComputeModelAnimationData> sourceData_;
+    /// Whether skinning is applied.
+    bool skinned_{};
+
+    /// Output vertex buffers.
+    ea::vector<SharedPtr<VertexBuffer>> vertexBuffers_;
+    /// Animated geometries.
+    ea::vector<ea::vector<SharedPtr<Geometry>>> geometries_;
+    /// Parameters buffers for each output vertex buffer.
+    ea::vector<SharedPtr<ComputeBuffer>> parametersBuffers_;
+
+    /// Active morphs as (index, weight) pairs.
+    ea::vector<ea::pair<unsigned, float>> activeMorphs_;
+    /// Bone matrices.
+    ea::vector<Matrix3x4> boneMatrices_;
+    /// CPU-side parameters data.
+    ea::vector<Vector4> parametersData_;
+};
+
+}
+
+#endif
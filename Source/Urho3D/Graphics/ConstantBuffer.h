@@ -52,17 +52,25 @@ public:
     /// Release the buffer.
     void Release() override;
 
-    /// Set size and create GPU-side buffer. Return true on success.
-    bool SetSize(unsigned size);
+    /// Set size and create GPU-side buffer. Dynamic buffers support partial updates. Return true on success.
+    bool SetSize(unsigned size, bool dynamic = false);
     /// Update data on GPU.
     void Update(const void* data);
+    /// Update region of dynamic buffer without synchronization with the GPU.
+    /// Caller is responsible for not overwriting regions used by pending draws.
+    /// If discard is true, the rest of buffer contents become undefined.
+    void UpdateRange(const void* data, unsigned offset, unsigned size, bool discard);
 
     /// Return size.
     unsigned GetSize() const { return size_; }
+    /// Return whether the buffer is dynamic.
+    bool IsDynamic() const { return dynamic_; }
 
 private:
     /// Buffer byte size.
     unsigned size_{};
+    /// Whether the buffer is dynamic.
+    bool dynamic_{};
 };
 
 }
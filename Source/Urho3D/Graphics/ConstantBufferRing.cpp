@@ -0,0 +1,84 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Graphics/ConstantBuffer.h"
+#include "../Graphics/ConstantBufferRing.h"
+#include "../Graphics/Graphics.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+ConstantBufferRing::ConstantBufferRing(Context* context)
+    : Object(context)
+{
+}
+
+ConstantBufferRing::~ConstantBufferRing()
+{
+}
+
+void ConstantBufferRing::SetCapacity(unsigned capacity)
+{
+    capacity_ = NextPowerOfTwo(Max(capacity, BindingSlack * 2));
+}
+
+bool ConstantBufferRing::EnsureBuffer()
+{
+    if (!buffer_)
+        buffer_ = MakeShared<ConstantBuffer>(context_);
+
+    if (buffer_->GetSize() == capacity_ && buffer_->IsDynamic())
+        return true;
+
+    // Next upload should start from the beginning of new storage
+    offset_ = 0;
+    return buffer_->SetSize(capacity_, true);
+}
+
+ConstantBufferRange ConstantBufferRing::Upload(const void* data, unsigned dataSize, unsigned reservedSize)
+{
+    assert(dataSize <= reservedSize);
+
+    if (reservedSize + BindingSlack > capacity_)
+        SetCapacity(reservedSize + BindingSlack);
+
+    if (!EnsureBuffer())
+        return {};
+
+    const unsigned alignment = Max(Graphics::GetCaps().constantBufferOffsetAlignment_, 16u);
+    const unsigned alignedOffset = (offset_ + alignment - 1) / alignment * alignment;
+
+    const bool discard = alignedOffset + reservedSize + BindingSlack > capacity_;
+    const unsigned offset = discard ? 0 : alignedOffset;
+
+    if (dataSize > 0)
+        buffer_->UpdateRange(data, offset, dataSize, discard);
+
+    offset_ = offset + reservedSize;
+    return {buffer_, offset, reservedSize};
+}
+
+}
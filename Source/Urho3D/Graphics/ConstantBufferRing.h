@@ -0,0 +1,73 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Core/Object.h"
+#include "../Graphics/GraphicsDefs.h"
+
+namespace Urho3D
+{
+
+class ConstantBuffer;
+
+/// Large dynamic constant buffer filled sequentially by draw command queues.
+/// Regions are written without synchronization with the GPU.
+/// When the ring wraps around, buffer storage is discarded and renamed by the driver,
+/// so regions still referenced by pending draws are never overwritten.
+class URHO3D_API ConstantBufferRing : public Object
+{
+    URHO3D_OBJECT(ConstantBufferRing, Object);
+
+public:
+    /// Default capacity in bytes.
+    static const unsigned DefaultCapacity = 4 * 1024 * 1024;
+    /// Extra space reserved after each region, because regions may be bound with size rounded up.
+    static const unsigned BindingSlack = 256;
+
+    /// Construct.
+    explicit ConstantBufferRing(Context* context);
+    /// Destruct.
+    ~ConstantBufferRing() override;
+
+    /// Set capacity in bytes. Capacity may grow if a region doesn't fit.
+    void SetCapacity(unsigned capacity);
+    /// Upload data to the ring and return region to bind.
+    /// Region size is reservedSize, which should not be less than dataSize.
+    ConstantBufferRange Upload(const void* data, unsigned dataSize, unsigned reservedSize);
+
+    /// Return capacity in bytes.
+    unsigned GetCapacity() const { return capacity_; }
+
+private:
+    /// Create or resize GPU buffer if needed.
+    bool EnsureBuffer();
+
+    /// GPU buffer.
+    SharedPtr<ConstantBuffer> buffer_;
+    /// Capacity in bytes.
+    unsigned capacity_{DefaultCapacity};
+    /// Offset of the first free byte.
+    unsigned offset_{};
+};
+
+}
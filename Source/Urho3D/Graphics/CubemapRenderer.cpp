@@ -50,6 +50,25 @@ Quaternion faceRotations[MAX_CUBEMAP_FACES] = {
     Quaternion(0, 180, 0),
 };
 
+ea::span<const unsigned> GetFilterRayCounts(unsigned textureSize)
+{
+    static const unsigned rayCounts[]{1, 8, 16};
+    static const unsigned rayCounts128[]{1, 8, 16, 16, 16, 16, 32, 32};
+    static const unsigned rayCounts256[]{1, 8, 16, 16, 16, 16, 16, 32, 32};
+
+    if (textureSize == 128)
+        return rayCounts128;
+    else if (textureSize == 256)
+        return rayCounts256;
+    else
+        return rayCounts;
+}
+
+unsigned GetFilterRayCount(ea::span<const unsigned> rayCounts, unsigned level)
+{
+    return rayCounts[Clamp<unsigned>(level, 0, rayCounts.size() - 1)];
+}
+
 }
 
 CubemapRenderer::CubemapRenderer(Scene* scene)
@@ -131,6 +150,13 @@ CubemapUpdateResult CubemapRenderer::Update(const CubemapUpdateParameters& param
         numFacesToRender_ = 0;
     }
 
+    if (updateStage_ == CubemapUpdateStage::FilterLevels)
+        return UpdateFilterLevels();
+
+    // Sliced update may be called again before the last queued face is rendered
+    if (updateStage_ == CubemapUpdateStage::Ready && params.slicedUpdate_)
+        return {0, false};
+
     URHO3D_ASSERT(updateStage_ != CubemapUpdateStage::Ready);
 
     if (params.overrideFinalTexture_ && !IsTextureMatching(params.overrideFinalTexture_, params.settings_))
@@ -241,10 +267,48 @@ CubemapUpdateResult CubemapRenderer::UpdateSliced()
         }
     }
 
-    const bool isComplete = updateStage_ == CubemapUpdateStage::Ready;
+    // Filtering is sliced as well and completes the update later
+    const bool isComplete = updateStage_ == CubemapUpdateStage::Ready && !currentFilteredTexture_;
     return {1, isComplete};
 }
 
+CubemapUpdateResult CubemapRenderer::UpdateFilterLevels()
+{
+    if (!currentViewportTexture_ || !currentFilteredTexture_)
+    {
+        updateStage_ = CubemapUpdateStage::Idle;
+        return {0, true};
+    }
+
+    const unsigned numLevels = currentFilteredTexture_->GetLevels();
+    const auto rayCounts = GetFilterRayCounts(currentFilteredTexture_->GetWidth());
+    const auto getLevelCost = [&](unsigned level)
+    {
+        const unsigned levelWidth = currentFilteredTexture_->GetLevelWidth(level);
+        return levelWidth * levelWidth * GetFilterRayCount(rayCounts, level);
+    };
+
+    // Filter levels until the cost of the most expensive level is reached, so each update does similar amount of work
+    unsigned maxLevelCost = 0;
+    for (unsigned level = 0; level < numLevels; ++level)
+        maxLevelCost = ea::max(maxLevelCost, getLevelCost(level));
+
+    const unsigned beginLevel = nextFilterLevel_;
+    unsigned cost = getLevelCost(nextFilterLevel_++);
+    while (nextFilterLevel_ < numLevels && cost + getLevelCost(nextFilterLevel_) <= maxLevelCost)
+        cost += getLevelCost(nextFilterLevel_++);
+
+    FilterCubemapLevels(currentViewportTexture_, currentFilteredTexture_, beginLevel, nextFilterLevel_);
+
+    // Filtering is accounted as one face in the render budget
+    if (nextFilterLevel_ < numLevels)
+        return {1, false};
+
+    updateStage_ = CubemapUpdateStage::Idle;
+    FinalizeCubemap();
+    return {1, true};
+}
+
 void CubemapRenderer::ProcessFaceRendered()
 {
     URHO3D_ASSERTLOG(updateStage_ != CubemapUpdateStage::Ready || numFacesToRender_ > 0);
@@ -265,9 +329,22 @@ void CubemapRenderer::ProcessCubemapRendered()
     if (currentViewportTexture_ != viewportTexture_)
         DisconnectViewportsFromTexture(currentViewportTexture_);
 
+    // Sliced update filters mip levels over the next updates
+    if (currentFilteredTexture_ && currentParams_.slicedUpdate_)
+    {
+        updateStage_ = CubemapUpdateStage::FilterLevels;
+        nextFilterLevel_ = 0;
+        return;
+    }
+
     if (currentFilteredTexture_)
         FilterCubemap(currentViewportTexture_, currentFilteredTexture_);
 
+    FinalizeCubemap();
+}
+
+void CubemapRenderer::FinalizeCubemap()
+{
     TextureCube* finalTexture = currentFilteredTexture_ ? currentFilteredTexture_ : currentViewportTexture_;
     OnCubemapRendered(this, finalTexture);
 
@@ -285,7 +362,8 @@ void CubemapRenderer::QueueFaceUpdate(CubeMapFace face)
     renderer->QueueRenderSurface(surface);
 }
 
-void CubemapRenderer::FilterCubemap(TextureCube* sourceTexture, TextureCube* destTexture, ea::span<const unsigned> rayCounts)
+void CubemapRenderer::FilterCubemapLevels(
+    TextureCube* sourceTexture, TextureCube* destTexture, unsigned beginLevel, unsigned endLevel)
 {
 #if !defined(URHO3D_COMPUTE)
     URHO3D_LOGERROR("CubemapRenderer::FilterCubemap cannot be executed without URHO3D_COMPUTE enabled");
@@ -295,12 +373,13 @@ void CubemapRenderer::FilterCubemap(TextureCube* sourceTexture, TextureCube* des
 
     const unsigned numLevels = destTexture->GetLevels();
     const float roughStep = 1.0f / (float)(numLevels - 1);
+    const auto rayCounts = GetFilterRayCounts(destTexture->GetWidth());
 
     ea::fixed_vector<ShaderVariation*, 64> shaders;
-    for (unsigned i = 0; i < numLevels; ++i)
+    for (unsigned i = beginLevel; i < endLevel; ++i)
     {
         const unsigned levelWidth = destTexture->GetLevelWidth(i);
-        const unsigned rayCount = rayCounts[Clamp<unsigned>(i, 0, rayCounts.size() - 1)];
+        const unsigned rayCount = GetFilterRayCount(rayCounts, i);
 
         const ea::string shaderParams = Format("RAY_COUNT={} FILTER_RES={} FILTER_INV_RES={} ROUGHNESS={}",
             rayCount, levelWidth, 1.0f / levelWidth, roughStep * i);
@@ -309,10 +388,10 @@ void CubemapRenderer::FilterCubemap(TextureCube* sourceTexture, TextureCube* des
 
     // go through them cubemap -> level
     computeDevice->SetReadTexture(sourceTexture, 0);
-    for (unsigned i = 0; i < numLevels; ++i)
+    for (unsigned i = beginLevel; i < endLevel; ++i)
     {
         computeDevice->SetWriteTexture(destTexture, 1, UINT_MAX, i);
-        computeDevice->SetProgram(shaders[i]);
+        computeDevice->SetProgram(shaders[i - beginLevel]);
         computeDevice->Dispatch(destTexture->GetLevelWidth(i), destTexture->GetLevelHeight(i), 6);
     }
     computeDevice->SetWriteTexture(nullptr, 1, 0, 0);
@@ -322,16 +401,7 @@ void CubemapRenderer::FilterCubemap(TextureCube* sourceTexture, TextureCube* des
 
 void CubemapRenderer::FilterCubemap(TextureCube* sourceTexture, TextureCube* destTexture)
 {
-    const unsigned rayCounts[]{1, 8, 16};
-    const unsigned rayCounts128[]{1, 8, 16, 16, 16, 16, 32, 32};
-    const unsigned rayCounts256[]{1, 8, 16, 16, 16, 16, 16, 32, 32};
-
-    if (destTexture->GetWidth() == 128)
-        FilterCubemap(sourceTexture, destTexture, rayCounts128);
-    else if (destTexture->GetWidth() == 256)
-        FilterCubemap(sourceTexture, destTexture, rayCounts256);
-    else
-        FilterCubemap(sourceTexture, destTexture, rayCounts);
+    FilterCubemapLevels(sourceTexture, destTexture, 0, destTexture->GetLevels());
 }
 
 }
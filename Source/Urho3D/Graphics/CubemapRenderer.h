@@ -45,7 +45,8 @@ enum class CubemapUpdateStage
 {
     Idle,
     RenderFaces,
-    Ready
+    Ready,
+    FilterLevels
 };
 
 struct CubemapUpdateResult
@@ -121,10 +122,14 @@ private:
     CubemapUpdateResult UpdateSliced();
     void QueueFaceUpdate(CubeMapFace face);
 
+    CubemapUpdateResult UpdateFilterLevels();
+
     void ProcessFaceRendered();
     void ProcessCubemapRendered();
+    void FinalizeCubemap();
 
-    void FilterCubemap(TextureCube* sourceTexture, TextureCube* destTexture, ea::span<const unsigned> rayCounts);
+    /// Filter mip levels in range [beginLevel, endLevel) of destination texture.
+    void FilterCubemapLevels(TextureCube* sourceTexture, TextureCube* destTexture, unsigned beginLevel, unsigned endLevel);
     void FilterCubemap(TextureCube* sourceTexture, TextureCube* destTexture);
 
     WeakPtr<Scene> scene_;
@@ -138,6 +143,7 @@ private:
     CubemapUpdateStage updateStage_{};
     unsigned numFacesToUpdate_{};
     unsigned numFacesToRender_{};
+    unsigned nextFilterLevel_{};
     WeakPtr<TextureCube> currentViewportTexture_;
     WeakPtr<TextureCube> currentFilteredTexture_;
     bool viewportsConnectedToSelf_{};
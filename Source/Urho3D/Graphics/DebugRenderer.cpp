@@ -25,6 +25,7 @@
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/AnimatedModel.h"
 #include "../Graphics/Camera.h"
 #include "../Graphics/DebugRenderer.h"
@@ -47,6 +48,57 @@ namespace Urho3D
 static const unsigned MAX_LINES = 1000000;
 // Cap the amount of triangles to prevent crash.
 static const unsigned MAX_TRIANGLES = 100000;
+// Number of primitives written to the vertex buffer by one task.
+static const unsigned PARALLEL_WRITE_BUCKET = 16 * 1024;
+
+namespace
+{
+
+void WriteLineVertices(float* dest, const DebugLine* lines, unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const DebugLine& line = lines[i];
+
+        dest[0] = line.start_.x_;
+        dest[1] = line.start_.y_;
+        dest[2] = line.start_.z_;
+        ((unsigned&)dest[3]) = line.color_;
+        dest[4] = line.end_.x_;
+        dest[5] = line.end_.y_;
+        dest[6] = line.end_.z_;
+        ((unsigned&)dest[7]) = line.color_;
+
+        dest += 8;
+    }
+}
+
+void WriteTriangleVertices(float* dest, const DebugTriangle* triangles, unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const DebugTriangle& triangle = triangles[i];
+
+        dest[0] = triangle.v1_.x_;
+        dest[1] = triangle.v1_.y_;
+        dest[2] = triangle.v1_.z_;
+        ((unsigned&)dest[3]) = triangle.color_;
+
+        dest[4] = triangle.v2_.x_;
+        dest[5] = triangle.v2_.y_;
+        dest[6] = triangle.v2_.z_;
+        ((unsigned&)dest[7]) = triangle.color_;
+
+        dest[8] = triangle.v3_.x_;
+        dest[9] = triangle.v3_.y_;
+        dest[10] = triangle.v3_.z_;
+        ((unsigned&)dest[11]) = triangle.color_;
+
+        dest += 12;
+    }
+}
+
+}
 
 DebugRenderer::DebugRenderer(Context* context) :
     Component(context),
@@ -99,6 +151,24 @@ void DebugRenderer::AddLine(const Vector3& start, const Vector3& end, unsigned c
         noDepthLines_.push_back(DebugLine(start, end, color));
 }
 
+void DebugRenderer::AddLines(const DebugLine* lines, unsigned count, bool depthTest)
+{
+    const unsigned numLines = lines_.size() + noDepthLines_.size();
+    count = Min(count, MAX_LINES - Min(numLines, MAX_LINES));
+
+    auto& dest = depthTest ? lines_ : noDepthLines_;
+    dest.insert(dest.end(), lines, lines + count);
+}
+
+void DebugRenderer::AddTriangles(const DebugTriangle* triangles, unsigned count, bool depthTest)
+{
+    const unsigned numTriangles = triangles_.size() + noDepthTriangles_.size();
+    count = Min(count, MAX_TRIANGLES - Min(numTriangles, MAX_TRIANGLES));
+
+    auto& dest = depthTest ? triangles_ : noDepthTriangles_;
+    dest.insert(dest.end(), triangles, triangles + count);
+}
+
 void DebugRenderer::AddLine2D(const Vector2& start, const Vector2& end, const Color& color, bool depthTest)
 {
     AddLine2D(start, end, color.ToUInt(), depthTest);
@@ -547,89 +617,39 @@ void DebugRenderer::Render()
     URHO3D_PROFILE("RenderDebugGeometry");
 
     unsigned numVertices = (lines_.size() + noDepthLines_.size()) * 2 + (triangles_.size() + noDepthTriangles_.size()) * 3;
-    // Resize the vertex buffer if too small or much too large
-    if (vertexBuffer_->GetVertexCount() < numVertices || vertexBuffer_->GetVertexCount() > numVertices * 2)
-        vertexBuffer_->SetSize(numVertices, MASK_POSITION | MASK_COLOR, true);
+    // Grow the vertex buffer geometrically and shrink only if it's much too large, so it's not recreated every frame
+    const unsigned bufferSize = vertexBuffer_->GetVertexCount();
+    if (bufferSize < numVertices || bufferSize > numVertices * 4)
+        vertexBuffer_->SetSize(NextPowerOfTwo(numVertices), MASK_POSITION | MASK_COLOR, true);
 
     auto* dest = (float*)vertexBuffer_->Lock(0, numVertices, true);
     if (!dest)
         return;
 
-    for (unsigned i = 0; i < lines_.size(); ++i)
-    {
-        const DebugLine& line = lines_[i];
-
-        dest[0] = line.start_.x_;
-        dest[1] = line.start_.y_;
-        dest[2] = line.start_.z_;
-        ((unsigned&)dest[3]) = line.color_;
-        dest[4] = line.end_.x_;
-        dest[5] = line.end_.y_;
-        dest[6] = line.end_.z_;
-        ((unsigned&)dest[7]) = line.color_;
-
-        dest += 8;
-    }
-
-    for (unsigned i = 0; i < noDepthLines_.size(); ++i)
-    {
-        const DebugLine& line = noDepthLines_[i];
-
-        dest[0] = line.start_.x_;
-        dest[1] = line.start_.y_;
-        dest[2] = line.start_.z_;
-        ((unsigned&)dest[3]) = line.color_;
-        dest[4] = line.end_.x_;
-        dest[5] = line.end_.y_;
-        dest[6] = line.end_.z_;
-        ((unsigned&)dest[7]) = line.color_;
-
-        dest += 8;
-    }
-
-    for (unsigned i = 0; i < triangles_.size(); ++i)
-    {
-        const DebugTriangle& triangle = triangles_[i];
-
-        dest[0] = triangle.v1_.x_;
-        dest[1] = triangle.v1_.y_;
-        dest[2] = triangle.v1_.z_;
-        ((unsigned&)dest[3]) = triangle.color_;
+    // Large amounts of debug geometry are written in parallel, every primitive has fixed location in the buffer
+    auto* workQueue = GetSubsystem<WorkQueue>();
+    float* noDepthLinesDest = dest + lines_.size() * 8;
+    float* trianglesDest = noDepthLinesDest + noDepthLines_.size() * 8;
+    float* noDepthTrianglesDest = trianglesDest + triangles_.size() * 12;
 
-        dest[4] = triangle.v2_.x_;
-        dest[5] = triangle.v2_.y_;
-        dest[6] = triangle.v2_.z_;
-        ((unsigned&)dest[7]) = triangle.color_;
+    ForEachParallel(workQueue, PARALLEL_WRITE_BUCKET, lines_.size(),
+        [&](unsigned beginIndex, unsigned endIndex)
+    { WriteLineVertices(dest + beginIndex * 8, &lines_[beginIndex], endIndex - beginIndex); });
 
-        dest[8] = triangle.v3_.x_;
-        dest[9] = triangle.v3_.y_;
-        dest[10] = triangle.v3_.z_;
-        ((unsigned&)dest[11]) = triangle.color_;
+    ForEachParallel(workQueue, PARALLEL_WRITE_BUCKET, noDepthLines_.size(),
+        [&](unsigned beginIndex, unsigned endIndex)
+    { WriteLineVertices(noDepthLinesDest + beginIndex * 8, &noDepthLines_[beginIndex], endIndex - beginIndex); });
 
-        dest += 12;
-    }
+    ForEachParallel(workQueue, PARALLEL_WRITE_BUCKET, triangles_.size(),
+        [&](unsigned beginIndex, unsigned endIndex)
+    { WriteTriangleVertices(trianglesDest + beginIndex * 12, &triangles_[beginIndex], endIndex - beginIndex); });
 
-    for (unsigned i = 0; i < noDepthTriangles_.size(); ++i)
+    ForEachParallel(workQueue, PARALLEL_WRITE_BUCKET, noDepthTriangles_.size(),
+        [&](unsigned beginIndex, unsigned endIndex)
     {
-        const DebugTriangle& triangle = noDepthTriangles_[i];
-
-        dest[0] = triangle.v1_.x_;
-        dest[1] = triangle.v1_.y_;
-        dest[2] = triangle.v1_.z_;
-        ((unsigned&)dest[3]) = triangle.color_;
-
-        dest[4] = triangle.v2_.x_;
-        dest[5] = triangle.v2_.y_;
-        dest[6] = triangle.v2_.z_;
-        ((unsigned&)dest[7]) = triangle.color_;
-
-        dest[8] = triangle.v3_.x_;
-        dest[9] = triangle.v3_.y_;
-        dest[10] = triangle.v3_.z_;
-        ((unsigned&)dest[11]) = triangle.color_;
-
-        dest += 12;
-    }
+        WriteTriangleVertices(
+            noDepthTrianglesDest + beginIndex * 12, &noDepthTriangles_[beginIndex], endIndex - beginIndex);
+    });
 
     vertexBuffer_->Unlock();
 
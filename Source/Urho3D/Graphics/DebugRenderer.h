@@ -111,6 +111,10 @@ public:
     void AddLine(const Vector3& start, const Vector3& end, const Color& color, bool depthTest = true);
     /// Add a line with color already converted to unsigned.
     void AddLine(const Vector3& start, const Vector3& end, unsigned color, bool depthTest = true);
+    /// Add lines in bulk. Lines may be prepared in worker threads and submitted from the main thread.
+    void AddLines(const DebugLine* lines, unsigned count, bool depthTest = true);
+    /// Add solid triangles in bulk. Triangles may be prepared in worker threads and submitted from the main thread.
+    void AddTriangles(const DebugTriangle* triangles, unsigned count, bool depthTest = true);
     /// Add a line in 2D screen space.
     void AddLine2D(const Vector2& start, const Vector2& end, const Color& color, bool depthTest = true);
     /// Add a line in 2D screen space with color already converted to unsigned.
@@ -44,7 +44,7 @@ void ConstantBuffer::Release()
     size_ = 0;
 }
 
-bool ConstantBuffer::SetSize(unsigned size)
+bool ConstantBuffer::SetSize(unsigned size, bool dynamic)
 {
     Release();
 
@@ -59,6 +59,7 @@ bool ConstantBuffer::SetSize(unsigned size)
     size &= 0xfffffff0;
 
     size_ = size;
+    dynamic_ = dynamic;
 
     if (graphics_)
     {
@@ -67,8 +68,8 @@ bool ConstantBuffer::SetSize(unsigned size)
 
         bufferDesc.ByteWidth = size_;
         bufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-        bufferDesc.CPUAccessFlags = 0;
-        bufferDesc.Usage = D3D11_USAGE_DEFAULT;
+        bufferDesc.CPUAccessFlags = dynamic_ ? D3D11_CPU_ACCESS_WRITE : 0;
+        bufferDesc.Usage = dynamic_ ? D3D11_USAGE_DYNAMIC : D3D11_USAGE_DEFAULT;
 
         HRESULT hr = graphics_->GetImpl()->GetDevice()->CreateBuffer(&bufferDesc, 0, (ID3D11Buffer**)&object_.ptr_);
         if (FAILED(hr))
@@ -86,8 +87,32 @@ void ConstantBuffer::Update(const void* data)
 {
     if (object_.ptr_)
     {
-        graphics_->GetImpl()->GetDeviceContext()->UpdateSubresource((ID3D11Buffer*)object_.ptr_, 0, 0, data, 0, 0);
+        if (dynamic_)
+            UpdateRange(data, 0, size_, true);
+        else
+            graphics_->GetImpl()->GetDeviceContext()->UpdateSubresource((ID3D11Buffer*)object_.ptr_, 0, 0, data, 0, 0);
     }
 }
 
+void ConstantBuffer::UpdateRange(const void* data, unsigned offset, unsigned size, bool discard)
+{
+    if (!object_.ptr_ || !dynamic_ || offset + size > size_)
+        return;
+
+    ID3D11DeviceContext* deviceContext = graphics_->GetImpl()->GetDeviceContext();
+    D3D11_MAPPED_SUBRESOURCE mappedData;
+    mappedData.pData = nullptr;
+
+    const D3D11_MAP mapType = discard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE;
+    HRESULT hr = deviceContext->Map((ID3D11Buffer*)object_.ptr_, 0, mapType, 0, &mappedData);
+    if (FAILED(hr) || !mappedData.pData)
+    {
+        URHO3D_LOGD3DERROR("Failed to map constant buffer", hr);
+        return;
+    }
+
+    memcpy(static_cast<unsigned char*>(mappedData.pData) + offset, data, size);
+    deviceContext->Unmap((ID3D11Buffer*)object_.ptr_, 0);
+}
+
 }
@@ -0,0 +1,128 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../../Precompiled.h"
+
+#include "../../Graphics/GPUProfiler.h"
+#include "../../Graphics/Graphics.h"
+#include "../../Graphics/GraphicsImpl.h"
+#include "../../IO/Log.h"
+
+#include "../../DebugNew.h"
+
+namespace Urho3D
+{
+
+bool GPUProfiler::IsSupported() const
+{
+    return graphics_ && graphics_->IsInitialized();
+}
+
+void GPUProfiler::OnDeviceLost()
+{
+    Release();
+}
+
+void GPUProfiler::OnDeviceReset()
+{
+    // Queries are recreated on demand
+}
+
+bool GPUProfiler::CreateQueries(FrameQueries& frame)
+{
+    ID3D11Device* device = graphics_->GetImpl()->GetDevice();
+
+    D3D11_QUERY_DESC queryDesc{};
+    queryDesc.Query = D3D11_QUERY_TIMESTAMP_DISJOINT;
+    HRESULT hr = device->CreateQuery(&queryDesc, reinterpret_cast<ID3D11Query**>(&frame.disjoint_.ptr_));
+    if (FAILED(hr))
+    {
+        URHO3D_LOGD3DERROR("Failed to create timestamp disjoint query", hr);
+        return false;
+    }
+
+    queryDesc.Query = D3D11_QUERY_TIMESTAMP;
+    frame.timestamps_.resize(MaxZonesPerFrame * 2 + 2);
+    for (GPUObjectHandle& query : frame.timestamps_)
+    {
+        hr = device->CreateQuery(&queryDesc, reinterpret_cast<ID3D11Query**>(&query.ptr_));
+        if (FAILED(hr))
+        {
+            URHO3D_LOGD3DERROR("Failed to create timestamp query", hr);
+            return false;
+        }
+    }
+    return true;
+}
+
+void GPUProfiler::ReleaseQueries(FrameQueries& frame)
+{
+    for (GPUObjectHandle& query : frame.timestamps_)
+        URHO3D_SAFE_RELEASE(query.ptr_);
+    URHO3D_SAFE_RELEASE(frame.disjoint_.ptr_);
+    frame.timestamps_.clear();
+}
+
+void GPUProfiler::BeginDisjoint(FrameQueries& frame)
+{
+    graphics_->GetImpl()->GetDeviceContext()->Begin(static_cast<ID3D11Query*>(frame.disjoint_.ptr_));
+}
+
+void GPUProfiler::EndDisjoint(FrameQueries& frame)
+{
+    graphics_->GetImpl()->GetDeviceContext()->End(static_cast<ID3D11Query*>(frame.disjoint_.ptr_));
+}
+
+void GPUProfiler::WriteTimestamp(GPUObjectHandle query)
+{
+    graphics_->GetImpl()->GetDeviceContext()->End(static_cast<ID3D11Query*>(query.ptr_));
+}
+
+bool GPUProfiler::ReadTimestamps(FrameQueries& frame, ea::vector<unsigned long long>& timestamps, bool& valid)
+{
+    ID3D11DeviceContext* deviceContext = graphics_->GetImpl()->GetDeviceContext();
+
+    D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjointData{};
+    if (deviceContext->GetData(static_cast<ID3D11Query*>(frame.disjoint_.ptr_),
+        &disjointData, sizeof(disjointData), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+        return false;
+
+    valid = !disjointData.Disjoint && disjointData.Frequency != 0;
+    if (!valid)
+        return true;
+
+    const UINT64 frequency = disjointData.Frequency;
+    for (unsigned i = 0; i < frame.numTimestamps_; ++i)
+    {
+        UINT64 ticks = 0;
+        if (deviceContext->GetData(static_cast<ID3D11Query*>(frame.timestamps_[i].ptr_),
+            &ticks, sizeof(ticks), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+            return false;
+
+        // Convert to nanoseconds without overflow
+        timestamps[i] = ticks / frequency * 1000000000ull + ticks % frequency * 1000000000ull / frequency;
+    }
+    return true;
+}
+
+}
@@ -27,6 +27,7 @@
 #include "../../Core/Profiler.h"
 #include "../../Graphics/ComputeDevice.h"
 #include "../../Graphics/ConstantBuffer.h"
+#include "../../Graphics/ConstantBufferRing.h"
 #include "../../Graphics/Geometry.h"
 #include "../../Graphics/Graphics.h"
 #include "../../Graphics/GraphicsEvents.h"
@@ -854,6 +855,11 @@ void Graphics::DrawInstanced(PrimitiveType type, unsigned indexStart, unsigned i
     ++numBatches_;
 }
 
+void Graphics::MultiDrawIndexedInstancedIndirect(PrimitiveType type, ea::span<const IndirectDrawIndexedArgs> draws)
+{
+    URHO3D_LOGERROR("Graphics::MultiDrawIndexedInstancedIndirect is not supported for DX11");
+}
+
 void Graphics::SetVertexBuffer(VertexBuffer* buffer)
 {
     // Note: this is not multi-instance safe
@@ -2311,6 +2317,11 @@ void Graphics::CheckFeatureSupport()
     caps.maxPixelShaderUniforms_ = D3D11_REQ_CONSTANT_BUFFER_ELEMENT_COUNT;
     caps.constantBuffersSupported_ = true;
     caps.constantBufferOffsetAlignment_ = 256;
+    caps.baseVertexIndexSupported_ = true;
+
+    D3D11_FEATURE_DATA_D3D11_OPTIONS options{};
+    if (SUCCEEDED(impl_->device_->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))))
+        caps.constantBufferRingSupported_ = !!options.MapNoOverwriteOnDynamicConstantBuffer;
     caps.maxTextureSize_ = D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION;
     caps.maxRenderTargetSize_ = D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION;
     caps.maxNumRenderTargets_ = 8;
@@ -2666,7 +2677,11 @@ void Graphics::SetTextureUnitMappings()
     textureUnits_["ShadowMap"] = TU_SHADOWMAP;
     textureUnits_["FaceSelectCubeMap"] = TU_FACESELECT;
     textureUnits_["IndirectionCubeMap"] = TU_INDIRECTION;
+    textureUnits_["LightClusterMap"] = TU_FACESELECT;
+    textureUnits_["LightDataMap"] = TU_INDIRECTION;
+    textureUnits_["DecalMap"] = TU_LIGHTBUFFER;
     textureUnits_["VolumeMap"] = TU_VOLUMEMAP;
+    textureUnits_["HeightMap"] = TU_CUSTOM1;
     textureUnits_["ZoneCubeMap"] = TU_ZONE;
     textureUnits_["ZoneVolumeMap"] = TU_ZONE;
 }
@@ -499,6 +499,12 @@ void ShaderVariation::SaveByteCode(const ea::string& binaryShaderName)
         file->Write(&byteCode_[0], byteCode_.size());
 }
 
+unsigned ShaderVariation::GetSourceCodeHash() const
+{
+    // Bytecode is cached per shader on Direct3D11
+    return 0;
+}
+
 void ShaderVariation::CalculateConstantBufferSizes()
 {
     for (unsigned i = 0; i < MAX_SHADER_PARAMETER_GROUPS; ++i)
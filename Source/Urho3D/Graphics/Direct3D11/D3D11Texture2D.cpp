@@ -177,6 +177,8 @@ bool Texture2D::SetData(Image* image, bool useAlpha)
     if (renderer)
         quality = renderer->GetTextureQuality();
 
+    sourceSize_ = IntVector2(image->GetWidth(), image->GetHeight());
+
     if (!image->IsCompressed())
     {
         // Convert unsuitable formats to RGBA
@@ -195,7 +197,8 @@ bool Texture2D::SetData(Image* image, bool useAlpha)
         unsigned format = 0;
 
         // Discard unnecessary mip levels
-        for (unsigned i = 0; i < mipsToSkip_[quality]; ++i)
+        const unsigned mipsToSkip = Max(mipsToSkip_[quality], streamingMipsToSkip_);
+        for (unsigned i = 0; i < mipsToSkip && (image->GetWidth() > 1 || image->GetHeight() > 1); ++i)
         {
             mipImage = image->GetNextLevel(); image = mipImage;
             levelData = image->GetData();
@@ -250,7 +253,7 @@ bool Texture2D::SetData(Image* image, bool useAlpha)
             needDecompress = true;
         }
 
-        unsigned mipsToSkip = mipsToSkip_[quality];
+        unsigned mipsToSkip = Max(mipsToSkip_[quality], streamingMipsToSkip_);
         if (mipsToSkip >= levels)
             mipsToSkip = levels - 1;
         while (mipsToSkip && (width / (1 << mipsToSkip) < 4 || height / (1 << mipsToSkip) < 4))
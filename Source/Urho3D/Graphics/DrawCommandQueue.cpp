@@ -22,8 +22,13 @@
 
 #include "../Precompiled.h"
 
+#include "../Graphics/ConstantBufferRing.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/DrawCommandQueue.h"
+#include "../Graphics/GPUProfiler.h"
+#include "../Graphics/Material.h"
+
+#include <EASTL/fixed_vector.h>
 
 #include "../DebugNew.h"
 
@@ -41,6 +46,7 @@ void DrawCommandQueue::Reset(bool preferConstantBuffers)
     useConstantBuffers_ = preferConstantBuffers
         ? graphics_->GetCaps().constantBuffersSupported_
         : !graphics_->GetCaps().globalUniformsSupported_;
+    useMultiDraw_ = graphics_->GetCaps().multiDrawIndirectSupported_;
 
     // Reset state accumulators
     currentDrawCommand_ = {};
@@ -53,6 +59,7 @@ void DrawCommandQueue::Reset(bool preferConstantBuffers)
         constantBuffers_.currentLayout_ = nullptr;
         constantBuffers_.currentData_ = nullptr;
         constantBuffers_.currentHashes_.fill(0);
+        constantBuffers_.materialBuffers_.clear();
 
         currentDrawCommand_.constantBuffers_.fill({});
     }
@@ -71,13 +78,138 @@ void DrawCommandQueue::Reset(bool preferConstantBuffers)
     scissorRects_.push_back(IntRect::ZERO);
 }
 
+void DrawCommandQueue::Append(const DrawCommandQueue& other)
+{
+    if (!useConstantBuffers_ || !other.useConstantBuffers_)
+    {
+        URHO3D_LOGERROR("DrawCommandQueue::Append is supported only for queues with constant buffers");
+        return;
+    }
+
+    // Copy constant buffers with their contents, keep block offsets relative to the copied buffers
+    const ConstantBufferCollection& otherCollection = other.constantBuffers_.collection_;
+    const unsigned numBuffers = otherCollection.GetNumBuffers();
+    ea::fixed_vector<ConstantBufferCollectionRef, 8> bufferRemap(numBuffers);
+    for (unsigned i = 0; i < numBuffers; ++i)
+    {
+        const unsigned bufferSize = otherCollection.GetBufferSize(i);
+        if (bufferSize == 0)
+        {
+            bufferRemap[i] = {};
+            continue;
+        }
+
+        const auto& refAndData = constantBuffers_.collection_.AddBlock(bufferSize);
+        memcpy(refAndData.second, otherCollection.GetBufferData(i), bufferSize);
+        bufferRemap[i] = refAndData.first;
+    }
+
+    const unsigned materialBuffersOffset = constantBuffers_.materialBuffers_.size();
+    const unsigned shaderResourcesOffset = shaderResources_.size();
+    const unsigned scissorRectsOffset = scissorRects_.size() - 1;
+
+    const auto remapCommand = [&](DrawCommandDescription cmd)
+    {
+        for (ConstantBufferCollectionRef& ref : cmd.constantBuffers_)
+        {
+            if (ref.size_ == 0)
+                continue;
+
+            if (ref.index_ & MaterialConstantBufferFlag)
+            {
+                ref.index_ += materialBuffersOffset;
+                continue;
+            }
+
+            ref.offset_ += bufferRemap[ref.index_].offset_;
+            ref.index_ = bufferRemap[ref.index_].index_;
+        }
+
+        cmd.shaderResources_.first += shaderResourcesOffset;
+        cmd.shaderResources_.second += shaderResourcesOffset;
+
+        // Scissor rect #0 is shared "disabled" rect
+        if (cmd.scissorRect_ != 0)
+            cmd.scissorRect_ += scissorRectsOffset;
+        return cmd;
+    };
+
+    const auto& otherMaterialBuffers = other.constantBuffers_.materialBuffers_;
+    constantBuffers_.materialBuffers_.insert(
+        constantBuffers_.materialBuffers_.end(), otherMaterialBuffers.begin(), otherMaterialBuffers.end());
+    shaderResources_.insert(shaderResources_.end(), other.shaderResources_.begin(), other.shaderResources_.end());
+    scissorRects_.insert(scissorRects_.end(), other.scissorRects_.begin() + 1, other.scissorRects_.end());
+
+    drawCommands_.reserve(drawCommands_.size() + other.drawCommands_.size());
+    for (const DrawCommandDescription& cmd : other.drawCommands_)
+        drawCommands_.push_back(remapCommand(cmd));
+
+    // Adopt current state of the other queue
+    currentDrawCommand_ = remapCommand(other.currentDrawCommand_);
+    currentShaderResourceGroup_.first = other.currentShaderResourceGroup_.first + shaderResourcesOffset;
+    currentShaderResourceGroup_.second = other.currentShaderResourceGroup_.second + shaderResourcesOffset;
+    constantBuffers_.currentLayout_ = other.constantBuffers_.currentLayout_;
+    constantBuffers_.currentHashes_ = other.constantBuffers_.currentHashes_;
+}
+
+bool DrawCommandQueue::IsSameDrawState(const DrawCommandDescription& lhs, const DrawCommandDescription& rhs) const
+{
+    if (lhs.pipelineState_ != rhs.pipelineState_
+        || lhs.scissorRect_ != rhs.scissorRect_
+        || lhs.shaderResources_ != rhs.shaderResources_
+        || lhs.inputBuffers_.indexBuffer_ != rhs.inputBuffers_.indexBuffer_
+        || lhs.inputBuffers_.vertexBuffers_ != rhs.inputBuffers_.vertexBuffers_)
+        return false;
+
+    for (unsigned i = 0; i < MAX_SHADER_PARAMETER_GROUPS; ++i)
+    {
+        if (useConstantBuffers_)
+        {
+            const ConstantBufferCollectionRef& lhsRef = lhs.constantBuffers_[i];
+            const ConstantBufferCollectionRef& rhsRef = rhs.constantBuffers_[i];
+            if (lhsRef.size_ != rhsRef.size_ || (lhsRef.size_ != 0
+                && (lhsRef.index_ != rhsRef.index_ || lhsRef.offset_ != rhsRef.offset_)))
+                return false;
+        }
+        else
+        {
+            const ShaderParameterRange& lhsRange = lhs.shaderParameters_[i];
+            const ShaderParameterRange& rhsRange = rhs.shaderParameters_[i];
+            if (lhsRange.first != rhsRange.first || lhsRange.second != rhsRange.second)
+                return false;
+        }
+    }
+    return true;
+}
+
+unsigned DrawCommandQueue::GetNumMultiDrawCommands(unsigned firstCommand) const
+{
+    const DrawCommandDescription& firstCmd = drawCommands_[firstCommand];
+    if (!useMultiDraw_ || firstCmd.instanceCount_ == 0 || !firstCmd.inputBuffers_.indexBuffer_)
+        return 1;
+
+    unsigned lastCommand = firstCommand + 1;
+    while (lastCommand < drawCommands_.size())
+    {
+        const DrawCommandDescription& cmd = drawCommands_[lastCommand];
+        if (cmd.instanceCount_ == 0 || !IsSameDrawState(firstCmd, cmd))
+            break;
+        ++lastCommand;
+    }
+    return lastCommand - firstCommand;
+}
+
 void DrawCommandQueue::Execute()
 {
     if (drawCommands_.empty())
         return;
 
-    // Constant buffers to store all shader parameters for queue
-    ea::vector<SharedPtr<ConstantBuffer>> constantBuffers;
+    GPUProfilerScope gpuScope(graphics_->GetSubsystem<GPUProfiler>(), "DrawCommandQueue");
+
+    // Regions of constant buffers to store all shader parameters for queue
+    ea::vector<ConstantBufferRange> constantBuffers;
+    // Persistent material constant buffers, rebuilt by materials if needed
+    ea::vector<ConstantBufferRange> materialConstantBuffers;
 
     // Utility to set shader parameters if constant buffers are not used
     const SharedParameterSetter shaderParameterSetter{ graphics_ };
@@ -85,12 +217,33 @@ void DrawCommandQueue::Execute()
     // Prepare shader parameters
     if (useConstantBuffers_)
     {
-        const unsigned numConstantBuffers = constantBuffers_.collection_.GetNumBuffers();
+        const ConstantBufferCollection& collection = constantBuffers_.collection_;
+        const unsigned numConstantBuffers = collection.GetNumBuffers();
         constantBuffers.resize(numConstantBuffers);
+
+        // Append data to shared ring if possible, otherwise upload whole buffers
+        ConstantBufferRing* ring =
+            Graphics::GetCaps().constantBufferRingSupported_ ? graphics_->GetConstantBufferRing() : nullptr;
         for (unsigned i = 0; i < numConstantBuffers; ++i)
         {
-            constantBuffers[i] = graphics_->GetOrCreateConstantBuffer(VS, i, constantBuffers_.collection_.GetGPUBufferSize(i));
-            constantBuffers[i]->Update(constantBuffers_.collection_.GetBufferData(i));
+            const unsigned gpuBufferSize = collection.GetGPUBufferSize(i);
+            if (ring)
+                constantBuffers[i] = ring->Upload(collection.GetBufferData(i), collection.GetBufferSize(i), gpuBufferSize);
+            else
+            {
+                ConstantBuffer* constantBuffer = graphics_->GetOrCreateConstantBuffer(VS, i, gpuBufferSize);
+                constantBuffer->Update(collection.GetBufferData(i));
+                constantBuffers[i] = {constantBuffer, 0, gpuBufferSize};
+            }
+        }
+
+        const auto& materialBuffers = constantBuffers_.materialBuffers_;
+        materialConstantBuffers.resize(materialBuffers.size());
+        for (unsigned i = 0; i < materialBuffers.size(); ++i)
+        {
+            const auto& desc = materialBuffers[i];
+            ConstantBuffer* constantBuffer = desc.material_->GetOrCreateConstantBuffer(desc.layout_, desc.depthRange_);
+            materialConstantBuffers[i] = {constantBuffer, 0, constantBuffer ? constantBuffer->GetSize() : 0};
         }
     }
     else
@@ -110,8 +263,15 @@ void DrawCommandQueue::Execute()
     ea::vector<VertexBuffer*> tempVertexBuffers;
     ea::array<ConstantBufferRange, MAX_SHADER_PARAMETER_GROUPS> constantBufferRanges{};
 
-    for (const DrawCommandDescription& cmd : drawCommands_)
+    const unsigned numDrawCommands = drawCommands_.size();
+    for (unsigned cmdIndex = 0; cmdIndex < numDrawCommands; )
     {
+        const DrawCommandDescription& cmd = drawCommands_[cmdIndex];
+
+        // Instance offset is passed via draw arguments in multi-draw
+        const unsigned numMultiDrawCommands = GetNumMultiDrawCommands(cmdIndex);
+        const unsigned instanceOffset = numMultiDrawCommands > 1 ? 0 : cmd.instanceStart_;
+
         // Set pipeline state
         if (cmd.pipelineState_ != currentPipelineState)
         {
@@ -142,7 +302,7 @@ void DrawCommandQueue::Execute()
         {
             tempVertexBuffers.clear();
             tempVertexBuffers.assign(cmd.inputBuffers_.vertexBuffers_.begin(), cmd.inputBuffers_.vertexBuffers_.end());
-            graphics_->SetVertexBuffers(tempVertexBuffers, cmd.instanceStart_);
+            graphics_->SetVertexBuffers(tempVertexBuffers, instanceOffset);
             currentVertexBuffers = cmd.inputBuffers_.vertexBuffers_;
         }
 
@@ -168,8 +328,12 @@ void DrawCommandQueue::Execute()
                 if (cmd.constantBuffers_[i].size_ == 0)
                     continue;
 
-                constantBufferRanges[i].constantBuffer_ = constantBuffers[cmd.constantBuffers_[i].index_];
-                constantBufferRanges[i].offset_ = cmd.constantBuffers_[i].offset_;
+                const unsigned bufferIndex = cmd.constantBuffers_[i].index_;
+                const ConstantBufferRange& bufferRange = (bufferIndex & MaterialConstantBufferFlag)
+                    ? materialConstantBuffers[bufferIndex & ~MaterialConstantBufferFlag]
+                    : constantBuffers[bufferIndex];
+                constantBufferRanges[i].constantBuffer_ = bufferRange.constantBuffer_;
+                constantBufferRanges[i].offset_ = bufferRange.offset_ + cmd.constantBuffers_[i].offset_;
                 constantBufferRanges[i].size_ = cmd.constantBuffers_[i].size_;
             }
 
@@ -192,6 +356,22 @@ void DrawCommandQueue::Execute()
             }
         }
 
+        // Invoke multi-draw for all commands with the same state
+        if (numMultiDrawCommands > 1)
+        {
+            multiDrawArgs_.clear();
+            for (unsigned i = cmdIndex; i < cmdIndex + numMultiDrawCommands; ++i)
+            {
+                const DrawCommandDescription& drawCmd = drawCommands_[i];
+                multiDrawArgs_.push_back(IndirectDrawIndexedArgs{drawCmd.indexCount_, drawCmd.instanceCount_,
+                    drawCmd.indexStart_, static_cast<int>(drawCmd.baseVertexIndex_), drawCmd.instanceStart_});
+            }
+
+            graphics_->MultiDrawIndexedInstancedIndirect(currentPrimitiveType, multiDrawArgs_);
+            cmdIndex += numMultiDrawCommands;
+            continue;
+        }
+
         // Invoke appropriate draw command
 #ifdef URHO3D_D3D9
         const unsigned vertexStart = cmd.vertexStart_;
@@ -230,6 +410,8 @@ void DrawCommandQueue::Execute()
                     cmd.baseVertexIndex_, vertexStart, vertexCount);
             }
         }
+
+        ++cmdIndex;
     }
 }
 
@@ -36,6 +36,7 @@ namespace Urho3D
 {
 
 class Graphics;
+class Material;
 
 /// Reference to input shader resource. Only textures are supported now.
 struct ShaderResourceDesc
@@ -160,6 +161,35 @@ public:
         }
     }
 
+    /// Reference persistent constant buffer owned by the material instead of copying material parameters.
+    /// Material buffer is validated on execution. Custom material parameters are not included.
+    /// Shall be called only if constant buffers are used. Return true if new buffer is referenced.
+    bool SetMaterialConstantBuffer(Material* material, float depthRange, bool differentFromPrevious)
+    {
+        assert(useConstantBuffers_);
+        const unsigned groupLayoutHash = constantBuffers_.currentLayout_->GetConstantBufferHash(SP_MATERIAL);
+
+        if (groupLayoutHash == 0)
+        {
+            if (differentFromPrevious)
+                constantBuffers_.currentHashes_[SP_MATERIAL] = 0;
+            return false;
+        }
+
+        if (differentFromPrevious || groupLayoutHash != constantBuffers_.currentHashes_[SP_MATERIAL])
+        {
+            const unsigned size = constantBuffers_.currentLayout_->GetConstantBufferSize(SP_MATERIAL);
+            const unsigned index = constantBuffers_.materialBuffers_.size() | MaterialConstantBufferFlag;
+            constantBuffers_.materialBuffers_.push_back({material, constantBuffers_.currentLayout_, depthRange});
+
+            currentDrawCommand_.constantBuffers_[SP_MATERIAL] = {index, 0, size};
+            constantBuffers_.currentHashes_[SP_MATERIAL] = groupLayoutHash;
+            return true;
+        }
+
+        return false;
+    }
+
     /// Add shader parameter. Shall be called only if BeginShaderParameterGroup returned true.
     template <class T>
     void AddShaderParameter(StringHash name, const T& value)
@@ -290,14 +320,35 @@ public:
         drawCommands_.push_back(currentDrawCommand_);
     }
 
+    /// Append commands recorded in another queue. Both queues shall use constant buffers.
+    /// Queue state is updated as if the commands were recorded directly into this queue.
+    void Append(const DrawCommandQueue& other);
+
     /// Execute commands in the queue.
     void Execute();
 
+    /// Return whether the queue uses constant buffers.
+    bool UsesConstantBuffers() const { return useConstantBuffers_; }
+    /// Return current scissor rect.
+    const IntRect& GetCurrentScissorRect() const { return scissorRects_[currentDrawCommand_.scissorRect_]; }
+    /// Return number of recorded draw commands.
+    unsigned GetNumDrawCommands() const { return drawCommands_.size(); }
+
 private:
+    /// Flag in constant buffer index that indicates persistent material buffer.
+    static constexpr unsigned MaterialConstantBufferFlag = 0x80000000u;
+
+    /// Return number of consecutive commands starting from given one that can be executed with one multi-draw call.
+    unsigned GetNumMultiDrawCommands(unsigned firstCommand) const;
+    /// Return whether two instanced draw commands use the same state.
+    bool IsSameDrawState(const DrawCommandDescription& lhs, const DrawCommandDescription& rhs) const;
+
     /// Cached pointer to Graphics.
     Graphics* graphics_{};
     /// Whether to use constant buffers.
     bool useConstantBuffers_{};
+    /// Whether to merge instanced draw commands with the same state into multi-draw calls.
+    bool useMultiDraw_{};
 
     /// Shader parameters data when constant buffers are not used.
     struct ShaderParametersData
@@ -323,6 +374,16 @@ private:
         unsigned char* currentData_{};
         /// Current constant buffer layout hashes.
         ea::array<unsigned, MAX_SHADER_PARAMETER_GROUPS> currentHashes_{};
+
+        /// Persistent material constant buffer referenced by draw commands.
+        struct MaterialBufferDesc
+        {
+            Material* material_{};
+            ShaderProgramLayout* layout_{};
+            float depthRange_{};
+        };
+        /// Material buffers referenced by draw commands.
+        ea::vector<MaterialBufferDesc> materialBuffers_;
     } constantBuffers_;
 
     /// Shader resources.
@@ -336,6 +397,8 @@ private:
     DrawCommandDescription currentDrawCommand_;
     /// Current shader resource group.
     ShaderResourceRange currentShaderResourceGroup_;
+    /// Temporary buffer for multi-draw arguments.
+    ea::vector<IndirectDrawIndexedArgs> multiDrawArgs_;
 };
 
 }
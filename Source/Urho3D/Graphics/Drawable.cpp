@@ -205,6 +205,8 @@ void Drawable::SetLodBias(float bias)
 void Drawable::SetViewMask(unsigned mask)
 {
     viewMask_ = mask;
+    if (octant_)
+        octant_->MarkCullingDataDirty();
 }
 
 void Drawable::SetLightMask(unsigned mask)
@@ -171,6 +171,9 @@ struct URHO3D_API SourceBatch
     unsigned numWorldTransforms_{1};
     /// Per-instance data. If not null, must contain enough data to fill instancing buffer.
     void* instancingData_{};
+    /// Number of instances stored in per-instance vertex buffer of the geometry itself.
+    /// If not zero, the geometry is drawn with single instanced draw call. Supported only by render pipeline.
+    unsigned numGeometryInstances_{};
     /// %Geometry type.
     GeometryType geometryType_{GEOM_STATIC};
     /// Lightmap UV scale and offset.
@@ -185,7 +188,8 @@ struct URHO3D_API SourceBatch
             return true;
         return distance_ == other.distance_ && geometry_ == other.geometry_ && material_ == other.material_ &&
             worldTransform_ == other.worldTransform_ && numWorldTransforms_ == other.numWorldTransforms_ &&
-            instancingData_ == other.instancingData_ && geometryType_ == other.geometryType_;
+            instancingData_ == other.instancingData_ && numGeometryInstances_ == other.numGeometryInstances_ &&
+            geometryType_ == other.geometryType_;
     }
 
     /// Inequality comparison operator.
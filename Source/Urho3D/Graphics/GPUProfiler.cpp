@@ -0,0 +1,216 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/Profiler.h"
+#include "../Graphics/GPUProfiler.h"
+#include "../Graphics/Graphics.h"
+#include "../Graphics/GraphicsEvents.h"
+#include "../IO/Log.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+float GetDurationMs(unsigned long long begin, unsigned long long end)
+{
+    return end > begin ? static_cast<float>((end - begin) / 1000000.0) : 0.0f;
+}
+
+}
+
+GPUProfiler::GPUProfiler(Context* context)
+    : Object(context)
+    , GPUObject(GetSubsystem<Graphics>())
+{
+    SubscribeToEvent(E_BEGINRENDERING, &GPUProfiler::HandleBeginRendering);
+    SubscribeToEvent(E_ENDRENDERING, &GPUProfiler::HandleEndRendering);
+}
+
+GPUProfiler::~GPUProfiler()
+{
+    Release();
+}
+
+void GPUProfiler::SetEnabled(bool enabled)
+{
+    if (enabled && !IsSupported())
+    {
+        URHO3D_LOGWARNING("GPU timestamp queries are not supported");
+        return;
+    }
+
+    enabled_ = enabled;
+    if (!enabled_)
+    {
+        zones_.clear();
+        frameTime_ = 0.0f;
+    }
+}
+
+void GPUProfiler::BeginZone(ea::string_view name)
+{
+    if (!frameActive_)
+        return;
+
+    FrameQueries& frame = frames_[currentFrame_];
+    if (frame.numTimestamps_ + 2 > frame.timestamps_.size())
+    {
+        // Keep the stack balanced even if the scope is not recorded
+        zoneStack_.push_back(M_MAX_UNSIGNED);
+        return;
+    }
+
+    // Reserve end timestamp immediately so nested scopes never run out of queries
+    RecordedZone zone;
+    zone.name_ = InternedString{name};
+    zone.depth_ = zoneStack_.size();
+    zone.beginTimestamp_ = IssueTimestamp(frame);
+    zone.endTimestamp_ = frame.numTimestamps_++;
+
+    zoneStack_.push_back(frame.zones_.size());
+    frame.zones_.push_back(zone);
+}
+
+void GPUProfiler::EndZone()
+{
+    if (!frameActive_ || zoneStack_.empty())
+        return;
+
+    const unsigned zoneIndex = zoneStack_.back();
+    zoneStack_.pop_back();
+    if (zoneIndex == M_MAX_UNSIGNED)
+        return;
+
+    FrameQueries& frame = frames_[currentFrame_];
+    WriteTimestamp(frame.timestamps_[frame.zones_[zoneIndex].endTimestamp_]);
+}
+
+void GPUProfiler::Release()
+{
+    for (FrameQueries& frame : frames_)
+    {
+        ReleaseQueries(frame);
+        frame.numTimestamps_ = 0;
+        frame.zones_.clear();
+        frame.pending_ = false;
+    }
+
+    frameActive_ = false;
+    zoneStack_.clear();
+}
+
+void GPUProfiler::HandleBeginRendering(StringHash eventType, VariantMap& eventData)
+{
+    frameActive_ = false;
+    if (!enabled_ || !graphics_ || graphics_->IsDeviceLost())
+        return;
+
+    // Queries of the oldest frame are reused, discard its results if they are still not ready
+    FrameQueries& frame = frames_[currentFrame_];
+    if (frame.pending_)
+    {
+        CollectResults(frame);
+        frame.pending_ = false;
+    }
+
+    // Results of the frame before the previous one are usually ready by now
+    FrameQueries& previousFrame = frames_[(currentFrame_ + 1) % NumFramesInFlight];
+    if (previousFrame.pending_ && CollectResults(previousFrame))
+        previousFrame.pending_ = false;
+
+    if (frame.timestamps_.empty() && !CreateQueries(frame))
+    {
+        URHO3D_LOGERROR("Failed to create GPU timestamp queries, GPU profiling is disabled");
+        ReleaseQueries(frame);
+        enabled_ = false;
+        return;
+    }
+
+    frame.numTimestamps_ = 0;
+    frame.zones_.clear();
+    zoneStack_.clear();
+
+    // First two timestamps are reserved for the whole frame
+    BeginDisjoint(frame);
+    IssueTimestamp(frame);
+    frame.numTimestamps_ = 2;
+    frameActive_ = true;
+}
+
+void GPUProfiler::HandleEndRendering(StringHash eventType, VariantMap& eventData)
+{
+    if (!frameActive_)
+        return;
+
+    while (!zoneStack_.empty())
+        EndZone();
+
+    FrameQueries& frame = frames_[currentFrame_];
+    WriteTimestamp(frame.timestamps_[1]);
+    EndDisjoint(frame);
+    frame.pending_ = true;
+
+    currentFrame_ = (currentFrame_ + 1) % NumFramesInFlight;
+    frameActive_ = false;
+}
+
+bool GPUProfiler::CollectResults(FrameQueries& frame)
+{
+    timestampsTemp_.resize(frame.numTimestamps_);
+    bool valid = true;
+    if (!ReadTimestamps(frame, timestampsTemp_, valid))
+        return false;
+
+    // Timestamps may be unreliable if GPU clock changed during the frame, skip such frames
+    if (!valid)
+        return true;
+
+    frameTime_ = GetDurationMs(timestampsTemp_[0], timestampsTemp_[1]);
+    URHO3D_PROFILE_VALUE("GPU Frame", frameTime_);
+
+    zones_.clear();
+    for (const RecordedZone& recordedZone : frame.zones_)
+    {
+        GPUProfilerZone& zone = zones_.emplace_back();
+        zone.name_ = recordedZone.name_;
+        zone.depth_ = recordedZone.depth_;
+        zone.duration_ = GetDurationMs(timestampsTemp_[recordedZone.beginTimestamp_], timestampsTemp_[recordedZone.endTimestamp_]);
+        URHO3D_PROFILE_VALUE(zone.name_.GetString().c_str(), zone.duration_);
+    }
+    return true;
+}
+
+unsigned GPUProfiler::IssueTimestamp(FrameQueries& frame)
+{
+    const unsigned index = frame.numTimestamps_++;
+    WriteTimestamp(frame.timestamps_[index]);
+    return index;
+}
+
+}
@@ -0,0 +1,185 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Core/InternedString.h"
+#include "../Core/Object.h"
+#include "../Graphics/GPUObject.h"
+
+#include <EASTL/array.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+/// GPU time of single profiled scope.
+struct GPUProfilerZone
+{
+    /// Name of the scope.
+    InternedString name_;
+    /// Nesting depth, zero for top-level scopes.
+    unsigned depth_{};
+    /// GPU time in milliseconds.
+    float duration_{};
+};
+
+/// Measures GPU time of rendering scopes with timestamp queries.
+/// Results are read back with the latency of two frames so the CPU never waits for the GPU.
+/// Results are also forwarded to Tracy as plots if profiling is enabled.
+class URHO3D_API GPUProfiler : public Object, public GPUObject
+{
+    URHO3D_OBJECT(GPUProfiler, Object);
+
+public:
+    /// Number of frames with queries in flight.
+    static constexpr unsigned NumFramesInFlight = 3;
+    /// Maximum number of profiled scopes per frame.
+    static constexpr unsigned MaxZonesPerFrame = 256;
+
+    /// Construct.
+    explicit GPUProfiler(Context* context);
+    /// Destruct.
+    ~GPUProfiler() override;
+
+    /// Enable or disable profiling. Disabled by default.
+    /// @property
+    void SetEnabled(bool enabled);
+    /// Return whether profiling is enabled.
+    /// @property
+    bool IsEnabled() const { return enabled_; }
+    /// Return whether timestamp queries are supported by graphics backend.
+    bool IsSupported() const;
+    /// Return whether the scopes are recorded in the current frame.
+    bool IsActive() const { return frameActive_; }
+
+    /// Begin profiled scope. Should be paired with EndZone(). Ignored if profiler is not active.
+    void BeginZone(ea::string_view name);
+    /// End profiled scope.
+    void EndZone();
+
+    /// Return scopes of the latest frame with available results in the order of beginning.
+    const ea::vector<GPUProfilerZone>& GetZones() const { return zones_; }
+    /// Return GPU time of the latest frame with available results, in milliseconds.
+    float GetFrameTime() const { return frameTime_; }
+
+    /// Implement GPUObject.
+    /// @{
+    void OnDeviceLost() override;
+    void OnDeviceReset() override;
+    void Release() override;
+    /// @}
+
+private:
+    /// Scope recorded in frame.
+    struct RecordedZone
+    {
+        /// Name of the scope.
+        InternedString name_;
+        /// Nesting depth.
+        unsigned depth_{};
+        /// Index of timestamp at the beginning of the scope.
+        unsigned beginTimestamp_{};
+        /// Index of timestamp at the end of the scope.
+        unsigned endTimestamp_{};
+    };
+
+    /// Queries of single frame.
+    struct FrameQueries
+    {
+        /// Timestamp queries. First two are the beginning and the end of the frame.
+        ea::vector<GPUObjectHandle> timestamps_;
+        /// Query that tells whether timestamps are reliable and their frequency. Only used by Direct3D.
+        GPUObjectHandle disjoint_{};
+        /// Number of issued timestamps.
+        unsigned numTimestamps_{};
+        /// Recorded scopes.
+        ea::vector<RecordedZone> zones_;
+        /// Whether the queries are issued and results are not read yet.
+        bool pending_{};
+    };
+
+    /// Handle beginning of rendering.
+    void HandleBeginRendering(StringHash eventType, VariantMap& eventData);
+    /// Handle end of rendering.
+    void HandleEndRendering(StringHash eventType, VariantMap& eventData);
+    /// Read results of the frame if available. Return false if the results are not ready yet.
+    bool CollectResults(FrameQueries& frame);
+    /// Issue timestamp and return its index.
+    unsigned IssueTimestamp(FrameQueries& frame);
+
+    /// Backend-specific implementation.
+    /// @{
+    bool CreateQueries(FrameQueries& frame);
+    void ReleaseQueries(FrameQueries& frame);
+    void BeginDisjoint(FrameQueries& frame);
+    void EndDisjoint(FrameQueries& frame);
+    void WriteTimestamp(GPUObjectHandle query);
+    /// Read issued timestamps in nanoseconds. Return false if not ready. Set valid to false if timestamps are unreliable.
+    bool ReadTimestamps(FrameQueries& frame, ea::vector<unsigned long long>& timestamps, bool& valid);
+    /// @}
+
+    /// Whether the profiling is enabled.
+    bool enabled_{};
+    /// Whether the current frame is being recorded.
+    bool frameActive_{};
+    /// Queries of frames in flight.
+    ea::array<FrameQueries, NumFramesInFlight> frames_;
+    /// Index of the current frame in flight.
+    unsigned currentFrame_{};
+    /// Stack of indices of open scopes in the current frame.
+    ea::vector<unsigned> zoneStack_;
+    /// Temporary buffer for timestamps.
+    ea::vector<unsigned long long> timestampsTemp_;
+
+    /// Scopes of the latest frame with available results.
+    ea::vector<GPUProfilerZone> zones_;
+    /// GPU time of the latest frame with available results.
+    float frameTime_{};
+};
+
+/// Profiles GPU time of the enclosing scope if GPUProfiler exists and is active.
+class GPUProfilerScope
+{
+public:
+    /// Begin scope.
+    GPUProfilerScope(GPUProfiler* profiler, ea::string_view name)
+        : profiler_(profiler && profiler->IsActive() ? profiler : nullptr)
+    {
+        if (profiler_)
+            profiler_->BeginZone(name);
+    }
+
+    /// End scope.
+    ~GPUProfilerScope()
+    {
+        if (profiler_)
+            profiler_->EndZone();
+    }
+
+private:
+    /// Profiler if active.
+    GPUProfiler* profiler_{};
+};
+
+}
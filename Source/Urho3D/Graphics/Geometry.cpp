@@ -22,6 +22,7 @@
 
 #include "../Precompiled.h"
 
+#include "../Container/ByteVector.h"
 #include "../Core/Context.h"
 #include "../Graphics/Geometry.h"
 #include "../Graphics/Graphics.h"
@@ -52,7 +53,10 @@ Geometry::Geometry(Context* context) :
     SetNumVertexBuffers(1);
 }
 
-Geometry::~Geometry() = default;
+Geometry::~Geometry()
+{
+    ReleaseBufferPoolRange();
+}
 
 void Geometry::RegisterObject(Context* context)
 {
@@ -67,6 +71,7 @@ bool Geometry::SetNumVertexBuffers(unsigned num)
         return false;
     }
 
+    ReleaseBufferPoolRange();
     vertexBuffersDependencies_.resize(num);
     vertexBuffers_.resize(num);
 
@@ -81,6 +86,7 @@ bool Geometry::SetVertexBuffer(unsigned index, VertexBuffer* buffer)
         return false;
     }
 
+    ReleaseBufferPoolRange();
     vertexBuffersDependencies_[index] = CreateDependency(buffer);
     vertexBuffers_[index] = buffer;
     return true;
@@ -88,6 +94,7 @@ bool Geometry::SetVertexBuffer(unsigned index, VertexBuffer* buffer)
 
 void Geometry::SetVertexBuffers(const ea::vector<SharedPtr<VertexBuffer>>& vertexBuffers)
 {
+    ReleaseBufferPoolRange();
     vertexBuffersDependencies_.resize(vertexBuffers.size());
     for (unsigned i = 0; i < vertexBuffers.size(); ++i)
         vertexBuffersDependencies_[i] = CreateDependency(vertexBuffers[i]);
@@ -96,6 +103,7 @@ void Geometry::SetVertexBuffers(const ea::vector<SharedPtr<VertexBuffer>>& verte
 
 void Geometry::SetIndexBuffer(IndexBuffer* buffer)
 {
+    ReleaseBufferPoolRange();
     indexBufferDependency_ = CreateDependency(indexBuffer_);
     indexBuffer_ = buffer;
 }
@@ -114,6 +122,7 @@ bool Geometry::SetDrawRange(PrimitiveType type, unsigned indexStart, unsigned in
         return false;
     }
 
+    ReleaseBufferPoolRange();
     primitiveType_ = type;
     indexStart_ = indexStart;
     indexCount_ = indexCount;
@@ -156,6 +165,7 @@ bool Geometry::SetDrawRange(PrimitiveType type, unsigned indexStart, unsigned in
         indexCount = 0;
     }
 
+    ReleaseBufferPoolRange();
     primitiveType_ = type;
     indexStart_ = indexStart;
     indexCount_ = indexCount;
@@ -194,9 +204,79 @@ void Geometry::SetRawIndexData(const ea::shared_array<unsigned char>& data, unsi
     rawIndexSize_ = indexSize;
 }
 
+bool Geometry::MoveToBufferPool(GeometryBufferPool* pool)
+{
+    ReleaseBufferPoolRange();
+
+    VertexBuffer* vertexBuffer = vertexBuffers_.size() == 1 ? vertexBuffers_[0].Get() : nullptr;
+    if (!pool || !vertexBuffer || !indexBuffer_ || indexCount_ == 0 || vertexCount_ == 0)
+        return false;
+
+    const unsigned char* vertexData = vertexBuffer->GetShadowData();
+    const unsigned char* indexData = indexBuffer_->GetShadowData();
+    if (!vertexData || !indexData || vertexStart_ + vertexCount_ > vertexBuffer->GetVertexCount())
+        return false;
+
+    const bool largeIndices = indexBuffer_->GetIndexSize() > sizeof(unsigned short);
+    GeometryBufferPoolRange range =
+        pool->Allocate(vertexBuffer->GetElements(), vertexCount_, largeIndices, indexCount_);
+    if (!range.IsValid())
+        return false;
+
+    // Store indices relative to the first used vertex, base vertex index is applied on draw
+    ByteVector indices(indexCount_ * indexBuffer_->GetIndexSize());
+    const unsigned char* sourceIndices = indexData + indexStart_ * indexBuffer_->GetIndexSize();
+    if (largeIndices)
+    {
+        const auto source = reinterpret_cast<const unsigned*>(sourceIndices);
+        const auto dest = reinterpret_cast<unsigned*>(indices.data());
+        for (unsigned i = 0; i < indexCount_; ++i)
+            dest[i] = source[i] - vertexStart_;
+    }
+    else
+    {
+        const auto source = reinterpret_cast<const unsigned short*>(sourceIndices);
+        const auto dest = reinterpret_cast<unsigned short*>(indices.data());
+        for (unsigned i = 0; i < indexCount_; ++i)
+            dest[i] = static_cast<unsigned short>(source[i] - vertexStart_);
+    }
+
+    const unsigned char* sourceVertices = vertexData + vertexStart_ * vertexBuffer->GetVertexSize();
+    if (!range.vertexBuffer_->SetDataRange(sourceVertices, range.vertexStart_, vertexCount_)
+        || !range.indexBuffer_->SetDataRange(indices.data(), range.indexStart_, indexCount_))
+    {
+        pool->Release(range);
+        return false;
+    }
+
+    pool_ = pool;
+    pooledRange_ = ea::move(range);
+    pooledVertexBuffers_ = {pooledRange_.vertexBuffer_};
+    return true;
+}
+
+void Geometry::ReleaseBufferPoolRange()
+{
+    if (!pooledRange_.IsValid())
+        return;
+
+    if (pool_)
+        pool_->Release(pooledRange_);
+    pool_ = nullptr;
+    pooledRange_ = {};
+    pooledVertexBuffers_.clear();
+}
+
 void Geometry::Draw(Graphics* graphics)
 {
-    if (indexBuffer_ && indexCount_ > 0)
+    if (IsPooled())
+    {
+        graphics->SetIndexBuffer(pooledRange_.indexBuffer_);
+        graphics->SetVertexBuffers(pooledVertexBuffers_);
+        graphics->Draw(
+            primitiveType_, pooledRange_.indexStart_, indexCount_, pooledRange_.vertexStart_, 0, vertexCount_);
+    }
+    else if (indexBuffer_ && indexCount_ > 0)
     {
         graphics->SetIndexBuffer(indexBuffer_);
         graphics->SetVertexBuffers(vertexBuffers_);
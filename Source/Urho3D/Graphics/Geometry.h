@@ -26,6 +26,7 @@
 
 #include "../Container/IndexAllocator.h"
 #include "../Core/Object.h"
+#include "../Graphics/GeometryBufferPool.h"
 #include "../Graphics/GraphicsDefs.h"
 #include "../Graphics/PipelineStateTracker.h"
 
@@ -75,6 +76,11 @@ public:
     void SetRawVertexData(const ea::shared_array<unsigned char>& data, unsigned elementMask);
     /// Override raw index data to be returned for CPU-side operations.
     void SetRawIndexData(const ea::shared_array<unsigned char>& data, unsigned indexSize);
+    /// Copy draw range into the pool and draw from pooled buffers afterwards.
+    /// Source buffers are kept for CPU-side operations. Return false if the geometry cannot be pooled.
+    bool MoveToBufferPool(GeometryBufferPool* pool);
+    /// Return pooled range to the pool and draw from source buffers again.
+    void ReleaseBufferPoolRange();
     /// Draw.
     void Draw(Graphics* graphics);
 
@@ -135,6 +141,20 @@ public:
     /// Return whether or not the ray is inside geometry.
     bool IsInside(const Ray& ray) const;
 
+    /// Return whether the geometry is drawn from GeometryBufferPool.
+    bool IsPooled() const { return pooledRange_.IsValid(); }
+    /// Return vertex buffers used for drawing.
+    const ea::vector<SharedPtr<VertexBuffer>>& GetDrawVertexBuffers() const
+    {
+        return IsPooled() ? pooledVertexBuffers_ : vertexBuffers_;
+    }
+    /// Return index buffer used for drawing.
+    IndexBuffer* GetDrawIndexBuffer() const { return IsPooled() ? pooledRange_.indexBuffer_ : indexBuffer_; }
+    /// Return start index used for drawing.
+    unsigned GetDrawIndexStart() const { return IsPooled() ? pooledRange_.indexStart_ : indexStart_; }
+    /// Return base vertex index used for drawing.
+    unsigned GetDrawBaseVertexIndex() const { return IsPooled() ? pooledRange_.vertexStart_ : 0; }
+
     /// Return whether has empty draw range.
     /// @property
     bool IsEmpty() const { return indexCount_ == 0 && vertexCount_ == 0; }
@@ -180,6 +200,12 @@ private:
     unsigned rawVertexSize_;
     /// Raw index data override size.
     unsigned rawIndexSize_;
+    /// Pool that owns pooled range.
+    WeakPtr<GeometryBufferPool> pool_;
+    /// Range of draw data in the pool.
+    GeometryBufferPoolRange pooledRange_;
+    /// Pooled vertex buffers in the same format as source vertex buffers.
+    ea::vector<SharedPtr<VertexBuffer>> pooledVertexBuffers_;
 };
 
 }
@@ -0,0 +1,205 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Graphics/GeometryBufferPool.h"
+
+#include "../Graphics/IndexBuffer.h"
+#include "../Graphics/VertexBuffer.h"
+#include "../IO/Log.h"
+
+#include <EASTL/numeric.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+GeometryBufferPool::GeometryBufferPool(Context* context)
+    : Object(context)
+{
+}
+
+GeometryBufferPool::~GeometryBufferPool()
+{
+}
+
+GeometryBufferPoolRange GeometryBufferPool::Allocate(
+    const ea::vector<VertexElement>& elements, unsigned vertexCount, bool largeIndices, unsigned indexCount)
+{
+    if (elements.empty() || vertexCount == 0 || indexCount == 0)
+        return {};
+
+    VertexPageGroup& vertexGroup = GetOrCreateVertexPageGroup(elements);
+    const auto [vertexBuffer, vertexStart] = AllocateInPages(vertexGroup.pages_, vertexCount, vertexBufferSize_,
+        [&](unsigned pageSize)
+    {
+        auto buffer = MakeShared<VertexBuffer>(context_);
+        buffer->SetShadowed(shadowed_);
+        if (!buffer->SetSize(pageSize, elements))
+            buffer = nullptr;
+        return buffer;
+    });
+    if (!vertexBuffer)
+        return {};
+
+    auto& indexPages = GetIndexPages(largeIndices);
+    const auto [indexBuffer, indexStart] = AllocateInPages(indexPages, indexCount, indexBufferSize_,
+        [&](unsigned pageSize)
+    {
+        auto buffer = MakeShared<IndexBuffer>(context_);
+        buffer->SetShadowed(shadowed_);
+        if (!buffer->SetSize(pageSize, largeIndices))
+            buffer = nullptr;
+        return buffer;
+    });
+    if (!indexBuffer)
+    {
+        ReleaseInPages(vertexGroup.pages_, vertexBuffer, vertexStart, vertexCount);
+        return {};
+    }
+
+    ++numAllocations_;
+
+    GeometryBufferPoolRange range;
+    range.vertexBuffer_ = vertexBuffer;
+    range.vertexStart_ = vertexStart;
+    range.vertexCount_ = vertexCount;
+    range.indexBuffer_ = indexBuffer;
+    range.indexStart_ = indexStart;
+    range.indexCount_ = indexCount;
+    return range;
+}
+
+void GeometryBufferPool::Release(const GeometryBufferPoolRange& range)
+{
+    if (!range.IsValid())
+        return;
+
+    VertexPageGroup& vertexGroup = GetOrCreateVertexPageGroup(range.vertexBuffer_->GetElements());
+    ReleaseInPages(vertexGroup.pages_, range.vertexBuffer_.Get(), range.vertexStart_, range.vertexCount_);
+
+    const bool largeIndices = range.indexBuffer_->GetIndexSize() > sizeof(unsigned short);
+    ReleaseInPages(GetIndexPages(largeIndices), range.indexBuffer_.Get(), range.indexStart_, range.indexCount_);
+
+    --numAllocations_;
+}
+
+unsigned GeometryBufferPool::GetNumVertexBuffers() const
+{
+    return ea::accumulate(vertexPageGroups_.begin(), vertexPageGroups_.end(), 0u,
+        [](unsigned sum, const VertexPageGroup& group) { return sum + group.pages_.size(); });
+}
+
+unsigned GeometryBufferPool::GetNumIndexBuffers() const
+{
+    return indexPages_.size() + largeIndexPages_.size();
+}
+
+GeometryBufferPool::VertexPageGroup& GeometryBufferPool::GetOrCreateVertexPageGroup(
+    const ea::vector<VertexElement>& elements)
+{
+    for (VertexPageGroup& group : vertexPageGroups_)
+    {
+        if (group.elements_ == elements)
+            return group;
+    }
+
+    VertexPageGroup& group = vertexPageGroups_.emplace_back();
+    group.elements_ = elements;
+    return group;
+}
+
+template <class T, class CreateBuffer>
+ea::pair<T*, unsigned> GeometryBufferPool::AllocateInPages(
+    ea::vector<Page<T>>& pages, unsigned count, unsigned pageSize, const CreateBuffer& createBuffer)
+{
+    // First fit in existing pages
+    for (Page<T>& page : pages)
+    {
+        for (auto iter = page.freeRanges_.begin(); iter != page.freeRanges_.end(); ++iter)
+        {
+            if (iter->count_ < count)
+                continue;
+
+            const unsigned start = iter->start_;
+            iter->start_ += count;
+            iter->count_ -= count;
+            if (iter->count_ == 0)
+                page.freeRanges_.erase(iter);
+            return {page.buffer_.Get(), start};
+        }
+    }
+
+    // Oversized ranges get dedicated page
+    const unsigned newPageSize = ea::max(pageSize, count);
+    SharedPtr<T> buffer = createBuffer(newPageSize);
+    if (!buffer)
+    {
+        URHO3D_LOGERROR("Failed to create pooled geometry buffer of {} elements", newPageSize);
+        return {nullptr, 0};
+    }
+
+    Page<T>& page = pages.emplace_back();
+    page.buffer_ = buffer;
+    if (newPageSize > count)
+        page.freeRanges_.push_back(FreeRange{count, newPageSize - count});
+    return {buffer.Get(), 0};
+}
+
+template <class T>
+void GeometryBufferPool::ReleaseInPages(ea::vector<Page<T>>& pages, T* buffer, unsigned start, unsigned count)
+{
+    const auto pageIter = ea::find_if(pages.begin(), pages.end(),
+        [&](const Page<T>& page) { return page.buffer_ == buffer; });
+    if (pageIter == pages.end())
+    {
+        URHO3D_LOGERROR("Released geometry range doesn't belong to the pool");
+        return;
+    }
+
+    // Insert free range keeping the order and merge it with adjacent ranges
+    auto& freeRanges = pageIter->freeRanges_;
+    auto iter = ea::upper_bound(freeRanges.begin(), freeRanges.end(), start,
+        [](unsigned value, const FreeRange& range) { return value < range.start_; });
+    iter = freeRanges.insert(iter, FreeRange{start, count});
+
+    const auto next = ea::next(iter);
+    if (next != freeRanges.end() && iter->start_ + iter->count_ == next->start_)
+    {
+        iter->count_ += next->count_;
+        freeRanges.erase(next);
+    }
+
+    if (iter != freeRanges.begin())
+    {
+        const auto prev = ea::prev(iter);
+        if (prev->start_ + prev->count_ == iter->start_)
+        {
+            prev->count_ += iter->count_;
+            freeRanges.erase(iter);
+        }
+    }
+}
+
+}
@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Core/Object.h"
+#include "../Graphics/GraphicsDefs.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class IndexBuffer;
+class VertexBuffer;
+
+/// Range of vertices and indices allocated in GeometryBufferPool.
+struct GeometryBufferPoolRange
+{
+    /// Shared vertex buffer.
+    SharedPtr<VertexBuffer> vertexBuffer_;
+    /// Shared index buffer.
+    SharedPtr<IndexBuffer> indexBuffer_;
+    /// First vertex of the range.
+    unsigned vertexStart_{};
+    /// Number of vertices in the range.
+    unsigned vertexCount_{};
+    /// First index of the range.
+    unsigned indexStart_{};
+    /// Number of indices in the range.
+    unsigned indexCount_{};
+
+    /// Return whether the range is allocated.
+    bool IsValid() const { return vertexBuffer_ != nullptr && indexBuffer_ != nullptr; }
+};
+
+/// Suballocates vertex and index data of static geometries from few large GPU buffers,
+/// one set of buffers per vertex format and index size.
+/// Geometries stored in the pool share buffers, so consecutive draws don't need to rebind them.
+/// Indices are stored relative to the first vertex of the range and drawn with base vertex index.
+/// Register as subsystem to enable pooling for static models loaded afterwards.
+class URHO3D_API GeometryBufferPool : public Object
+{
+    URHO3D_OBJECT(GeometryBufferPool, Object);
+
+public:
+    /// Construct.
+    explicit GeometryBufferPool(Context* context);
+    /// Destruct.
+    ~GeometryBufferPool() override;
+
+    /// Allocate range of vertices and indices. Return invalid range on failure.
+    GeometryBufferPoolRange Allocate(
+        const ea::vector<VertexElement>& elements, unsigned vertexCount, bool largeIndices, unsigned indexCount);
+    /// Return range to the pool.
+    void Release(const GeometryBufferPoolRange& range);
+
+    /// Set number of vertices in each vertex buffer. Affects buffers created afterwards.
+    void SetVertexBufferSize(unsigned vertexCount) { vertexBufferSize_ = ea::max(vertexCount, 1u); }
+    /// Set number of indices in each index buffer. Affects buffers created afterwards.
+    void SetIndexBufferSize(unsigned indexCount) { indexBufferSize_ = ea::max(indexCount, 1u); }
+    /// Set whether to keep copy of pooled data in CPU memory to restore it on device loss.
+    void SetShadowed(bool enable) { shadowed_ = enable; }
+
+    /// Return properties of the pool.
+    /// @{
+    unsigned GetVertexBufferSize() const { return vertexBufferSize_; }
+    unsigned GetIndexBufferSize() const { return indexBufferSize_; }
+    bool IsShadowed() const { return shadowed_; }
+    unsigned GetNumVertexBuffers() const;
+    unsigned GetNumIndexBuffers() const;
+    unsigned GetNumAllocations() const { return numAllocations_; }
+    /// @}
+
+private:
+    /// Free range within the buffer.
+    struct FreeRange
+    {
+        unsigned start_{};
+        unsigned count_{};
+    };
+
+    /// Large buffer with the list of free ranges sorted by start.
+    template <class T> struct Page
+    {
+        SharedPtr<T> buffer_;
+        ea::vector<FreeRange> freeRanges_;
+    };
+
+    /// Vertex buffers with the same vertex format.
+    struct VertexPageGroup
+    {
+        ea::vector<VertexElement> elements_;
+        ea::vector<Page<VertexBuffer>> pages_;
+    };
+
+    VertexPageGroup& GetOrCreateVertexPageGroup(const ea::vector<VertexElement>& elements);
+    ea::vector<Page<IndexBuffer>>& GetIndexPages(bool largeIndices)
+    {
+        return largeIndices ? largeIndexPages_ : indexPages_;
+    }
+
+    /// Allocate range in existing page or create new page.
+    template <class T, class CreateBuffer>
+    ea::pair<T*, unsigned> AllocateInPages(
+        ea::vector<Page<T>>& pages, unsigned count, unsigned pageSize, const CreateBuffer& createBuffer);
+    /// Return range to the page that owns the buffer.
+    template <class T> void ReleaseInPages(ea::vector<Page<T>>& pages, T* buffer, unsigned start, unsigned count);
+
+    unsigned vertexBufferSize_{256 * 1024};
+    unsigned indexBufferSize_{1024 * 1024};
+    bool shadowed_{true};
+
+    ea::vector<VertexPageGroup> vertexPageGroups_;
+    ea::vector<Page<IndexBuffer>> indexPages_;
+    ea::vector<Page<IndexBuffer>> largeIndexPages_;
+    unsigned numAllocations_{};
+};
+
+}
@@ -0,0 +1,732 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Graphics/GeometryOptimizer.h"
+
+#include <EASTL/array.h>
+#include <EASTL/sort.h>
+#include <EASTL/unordered_map.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+using Triangle = ea::array<unsigned, 3>;
+
+/// Symmetric 4x4 matrix of quadric error function, weighted by triangle area.
+struct Quadric
+{
+    double a00_{}, a01_{}, a02_{}, a11_{}, a12_{}, a22_{};
+    double b0_{}, b1_{}, b2_{};
+    double c_{};
+    double weight_{};
+
+    /// Construct from plane defined by normal and distance.
+    static Quadric FromPlane(const Vector3& normal, float distance, float weight)
+    {
+        const double x = normal.x_;
+        const double y = normal.y_;
+        const double z = normal.z_;
+        const double d = distance;
+        const double w = weight;
+
+        Quadric result;
+        result.a00_ = w * x * x;
+        result.a01_ = w * x * y;
+        result.a02_ = w * x * z;
+        result.a11_ = w * y * y;
+        result.a12_ = w * y * z;
+        result.a22_ = w * z * z;
+        result.b0_ = w * x * d;
+        result.b1_ = w * y * d;
+        result.b2_ = w * z * d;
+        result.c_ = w * d * d;
+        result.weight_ = w;
+        return result;
+    }
+
+    Quadric& operator +=(const Quadric& rhs)
+    {
+        a00_ += rhs.a00_;
+        a01_ += rhs.a01_;
+        a02_ += rhs.a02_;
+        a11_ += rhs.a11_;
+        a12_ += rhs.a12_;
+        a22_ += rhs.a22_;
+        b0_ += rhs.b0_;
+        b1_ += rhs.b1_;
+        b2_ += rhs.b2_;
+        c_ += rhs.c_;
+        weight_ += rhs.weight_;
+        return *this;
+    }
+
+    Quadric operator +(const Quadric& rhs) const { return Quadric{*this} += rhs; }
+
+    /// Return weighted sum of squared distances to the planes.
+    double Evaluate(const Vector3& position) const
+    {
+        const double x = position.x_;
+        const double y = position.y_;
+        const double z = position.z_;
+        const double result = a00_ * x * x + a11_ * y * y + a22_ * z * z
+            + 2.0 * (a01_ * x * y + a02_ * x * z + a12_ * y * z)
+            + 2.0 * (b0_ * x + b1_ * y + b2_ * z) + c_;
+        return Max(result, 0.0);
+    }
+
+    /// Return error as average distance to the planes.
+    float GetError(const Vector3& position) const
+    {
+        return weight_ > 0.0 ? static_cast<float>(std::sqrt(Evaluate(position) / weight_)) : 0.0f;
+    }
+};
+
+/// Candidate for edge collapse.
+struct EdgeCollapse
+{
+    /// Vertex that is removed.
+    unsigned from_{};
+    /// Vertex that is kept.
+    unsigned to_{};
+    /// Error after collapse.
+    float error_{};
+
+    bool operator <(const EdgeCollapse& rhs) const { return error_ < rhs.error_; }
+};
+
+/// Vertex to triangle adjacency.
+struct TriangleAdjacency
+{
+    ea::vector<unsigned> offsets_;
+    ea::vector<unsigned> triangles_;
+
+    void Build(const ea::vector<Triangle>& triangles, unsigned numVertices)
+    {
+        offsets_.clear();
+        offsets_.resize(numVertices + 1);
+        for (const Triangle& triangle : triangles)
+        {
+            for (unsigned index : triangle)
+                ++offsets_[index + 1];
+        }
+        for (unsigned i = 0; i < numVertices; ++i)
+            offsets_[i + 1] += offsets_[i];
+
+        triangles_.resize(offsets_.back());
+        ea::vector<unsigned> cursors(offsets_.begin(), offsets_.end() - 1);
+        for (unsigned i = 0; i < triangles.size(); ++i)
+        {
+            for (unsigned index : triangles[i])
+                triangles_[cursors[index]++] = i;
+        }
+    }
+
+    const unsigned* Begin(unsigned vertex) const { return triangles_.data() + offsets_[vertex]; }
+    const unsigned* End(unsigned vertex) const { return triangles_.data() + offsets_[vertex + 1]; }
+};
+
+ea::vector<Triangle> GetTriangleList(GeometryLODView& lodView)
+{
+    ea::vector<Triangle> triangles;
+    triangles.reserve(lodView.GetNumPrimitives());
+    lodView.ForEachTriangle([&](unsigned i0, unsigned i1, unsigned i2) { triangles.push_back({i0, i1, i2}); });
+    return triangles;
+}
+
+void SetTriangleList(GeometryLODView& lodView, const ea::vector<Triangle>& triangles)
+{
+    lodView.primitiveType_ = TRIANGLE_LIST;
+    lodView.indices_.clear();
+    lodView.indices_.reserve(triangles.size() * 3);
+    for (const Triangle& triangle : triangles)
+        lodView.indices_.insert(lodView.indices_.end(), triangle.begin(), triangle.end());
+}
+
+Vector3 GetTriangleNormal(const Vector3& p0, const Vector3& p1, const Vector3& p2)
+{
+    return (p1 - p0).CrossProduct(p2 - p0);
+}
+
+/// Group vertices with equal positions. Return group index for each vertex.
+ea::vector<unsigned> GroupVerticesByPosition(const ea::vector<ModelVertex>& vertices, unsigned& numGroups)
+{
+    const unsigned numVertices = vertices.size();
+    ea::unordered_map<Vector3, unsigned> positionToGroup;
+    positionToGroup.reserve(numVertices);
+
+    // Positive and negative zeros should be in the same group
+    const auto normalizeZero = [](float value) { return value == 0.0f ? 0.0f : value; };
+
+    ea::vector<unsigned> groups(numVertices);
+    numGroups = 0;
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        const Vector4& p = vertices[i].position_;
+        const Vector3 position{normalizeZero(p.x_), normalizeZero(p.y_), normalizeZero(p.z_)};
+        const auto [iter, inserted] = positionToGroup.emplace(position, numGroups);
+        if (inserted)
+            ++numGroups;
+        groups[i] = iter->second;
+    }
+    return groups;
+}
+
+/// Remap vertex indices of morphs. Morphs of removed vertices are discarded.
+void RemapMorphs(GeometryLODView& lodView, const ea::vector<unsigned>& remap)
+{
+    for (auto& [morphIndex, morphs] : lodView.morphs_)
+    {
+        ModelVertexMorphVector remappedMorphs;
+        for (const ModelVertexMorph& morph : morphs)
+        {
+            if (morph.index_ < remap.size() && remap[morph.index_] != M_MAX_UNSIGNED)
+            {
+                remappedMorphs.push_back(morph);
+                remappedMorphs.back().index_ = remap[morph.index_];
+            }
+        }
+        NormalizeModelVertexMorphVector(remappedMorphs);
+        morphs = ea::move(remappedMorphs);
+    }
+}
+
+/// Remove unused vertices and remap indices and morphs.
+GeometryLODView CompactGeometry(const GeometryLODView& source, const ea::vector<Triangle>& triangles)
+{
+    GeometryLODView result;
+    result.primitiveType_ = TRIANGLE_LIST;
+    result.lodDistance_ = source.lodDistance_;
+    result.vertexFormat_ = source.vertexFormat_;
+
+    ea::vector<unsigned> remap(source.vertices_.size(), M_MAX_UNSIGNED);
+    result.indices_.reserve(triangles.size() * 3);
+    for (const Triangle& triangle : triangles)
+    {
+        for (unsigned index : triangle)
+        {
+            if (remap[index] == M_MAX_UNSIGNED)
+            {
+                remap[index] = result.vertices_.size();
+                result.vertices_.push_back(source.vertices_[index]);
+            }
+            result.indices_.push_back(remap[index]);
+        }
+    }
+
+    result.morphs_ = source.morphs_;
+    RemapMorphs(result, remap);
+    return result;
+}
+
+/// Return score of the vertex for vertex cache optimization.
+float GetVertexCacheScore(int cachePosition, unsigned numRemainingTriangles, unsigned cacheSize)
+{
+    static const float cacheDecayPower = 1.5f;
+    static const float lastTriangleScore = 0.75f;
+    static const float valenceBoostScale = 2.0f;
+    static const float valenceBoostPower = 0.5f;
+
+    if (numRemainingTriangles == 0)
+        return -1.0f;
+
+    float score = 0.0f;
+    if (cachePosition >= 0)
+    {
+        if (cachePosition < 3)
+            score = lastTriangleScore;
+        else
+        {
+            const float scaler = 1.0f / (cacheSize - 3);
+            score = Pow(1.0f - (cachePosition - 3) * scaler, cacheDecayPower);
+        }
+    }
+
+    score += valenceBoostScale * Pow(static_cast<float>(numRemainingTriangles), -valenceBoostPower);
+    return score;
+}
+
+}
+
+GeometryLODView SimplifyGeometry(const GeometryLODView& lodView, unsigned targetTriangles, float maxError)
+{
+    if (!lodView.IsTriangleGeometry())
+        return lodView;
+
+    GeometryLODView source = lodView;
+    ea::vector<Triangle> triangles = GetTriangleList(source);
+    const unsigned numVertices = source.vertices_.size();
+
+    // Weld vertices with equal positions and attributes, vertices with equal positions and different attributes are seams
+    unsigned numGroups = 0;
+    const ea::vector<unsigned> groups = GroupVerticesByPosition(source.vertices_, numGroups);
+    ea::vector<unsigned> groupVertices(numGroups, M_MAX_UNSIGNED);
+    ea::vector<bool> locked(numVertices);
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        unsigned& groupVertex = groupVertices[groups[i]];
+        if (groupVertex == M_MAX_UNSIGNED)
+            groupVertex = i;
+        else if (source.vertices_[groupVertex] != source.vertices_[i])
+            locked[groupVertex] = true;
+    }
+
+    ea::vector<unsigned> remap(numVertices);
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        const unsigned groupVertex = groupVertices[groups[i]];
+        remap[i] = locked[groupVertex] ? i : groupVertex;
+        locked[i] = locked[groupVertex];
+    }
+
+    for (Triangle& triangle : triangles)
+    {
+        for (unsigned& index : triangle)
+            index = remap[index];
+    }
+
+    // Initialize quadrics
+    const auto getPosition = [&](unsigned index) { return source.vertices_[index].GetPosition(); };
+    ea::vector<Quadric> quadrics(numVertices);
+    for (const Triangle& triangle : triangles)
+    {
+        const Vector3 p0 = getPosition(triangle[0]);
+        const Vector3 normal = GetTriangleNormal(p0, getPosition(triangle[1]), getPosition(triangle[2]));
+        const float area = normal.Length();
+        if (area < M_EPSILON)
+            continue;
+
+        const Vector3 unitNormal = normal / area;
+        const Quadric quadric = Quadric::FromPlane(unitNormal, -unitNormal.DotProduct(p0), area);
+        for (unsigned index : triangle)
+            quadrics[groupVertices[groups[index]]] += quadric;
+    }
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        if (locked[i])
+            quadrics[i] = quadrics[groupVertices[groups[i]]];
+    }
+
+    TriangleAdjacency adjacency;
+    ea::vector<ea::pair<unsigned, unsigned>> edges;
+    ea::vector<bool> border(numVertices);
+    ea::vector<EdgeCollapse> collapses;
+    ea::vector<bool> touched(numVertices);
+
+    while (triangles.size() > targetTriangles)
+    {
+        // Find border and non-manifold edges. Edges are identified by position groups so seams are not borders
+        edges.clear();
+        for (const Triangle& triangle : triangles)
+        {
+            for (unsigned i = 0; i < 3; ++i)
+            {
+                const unsigned g0 = groups[triangle[i]];
+                const unsigned g1 = groups[triangle[(i + 1) % 3]];
+                edges.emplace_back(Min(g0, g1), Max(g0, g1));
+            }
+        }
+        ea::sort(edges.begin(), edges.end());
+
+        ea::fill(border.begin(), border.end(), false);
+        ea::vector<bool> borderGroups(numGroups);
+        for (unsigned i = 0; i < edges.size();)
+        {
+            unsigned j = i + 1;
+            while (j < edges.size() && edges[j] == edges[i])
+                ++j;
+            if (j - i != 2)
+            {
+                borderGroups[edges[i].first] = true;
+                borderGroups[edges[i].second] = true;
+            }
+            i = j;
+        }
+        for (unsigned i = 0; i < numVertices; ++i)
+            border[i] = borderGroups[groups[i]];
+
+        // Collect collapse candidates. Locked and border vertices are kept in place
+        collapses.clear();
+        for (const Triangle& triangle : triangles)
+        {
+            for (unsigned i = 0; i < 3; ++i)
+            {
+                const unsigned from = triangle[i];
+                const unsigned to = triangle[(i + 1) % 3];
+                if (locked[from] || border[from] || locked[to] || from == to)
+                    continue;
+
+                const float error = (quadrics[from] + quadrics[to]).GetError(getPosition(to));
+                if (error <= maxError)
+                    collapses.push_back({from, to, error});
+            }
+        }
+        if (collapses.empty())
+            break;
+        ea::sort(collapses.begin(), collapses.end());
+
+        // Apply collapses with the lowest error that don't affect each other
+        adjacency.Build(triangles, numVertices);
+        ea::fill(touched.begin(), touched.end(), false);
+        for (unsigned i = 0; i < numVertices; ++i)
+            remap[i] = i;
+
+        const unsigned numTrianglesToRemove = triangles.size() - targetTriangles;
+        unsigned numRemovedTriangles = 0;
+        for (const EdgeCollapse& collapse : collapses)
+        {
+            if (numRemovedTriangles >= numTrianglesToRemove)
+                break;
+            if (touched[collapse.from_] || touched[collapse.to_])
+                continue;
+
+            // Check that no triangle is flipped
+            bool flipped = false;
+            unsigned numCollapsedTriangles = 0;
+            const Vector3 newPosition = getPosition(collapse.to_);
+            for (const unsigned* iter = adjacency.Begin(collapse.from_); iter != adjacency.End(collapse.from_); ++iter)
+            {
+                const Triangle& triangle = triangles[*iter];
+                if (ea::find(triangle.begin(), triangle.end(), collapse.to_) != triangle.end())
+                {
+                    ++numCollapsedTriangles;
+                    continue;
+                }
+
+                Vector3 positions[3];
+                for (unsigned j = 0; j < 3; ++j)
+                    positions[j] = getPosition(triangle[j]);
+                const Vector3 oldNormal = GetTriangleNormal(positions[0], positions[1], positions[2]);
+                for (unsigned j = 0; j < 3; ++j)
+                {
+                    if (triangle[j] == collapse.from_)
+                        positions[j] = newPosition;
+                }
+                const Vector3 newNormal = GetTriangleNormal(positions[0], positions[1], positions[2]);
+                if (oldNormal.DotProduct(newNormal) <= 0.0f)
+                {
+                    flipped = true;
+                    break;
+                }
+            }
+            if (flipped)
+                continue;
+
+            // Neighbors are touched as well so flip checks of later collapses stay valid
+            for (const unsigned* iter = adjacency.Begin(collapse.from_); iter != adjacency.End(collapse.from_); ++iter)
+            {
+                for (unsigned index : triangles[*iter])
+                    touched[index] = true;
+            }
+
+            remap[collapse.from_] = collapse.to_;
+            quadrics[collapse.to_] += quadrics[collapse.from_];
+            numRemovedTriangles += numCollapsedTriangles;
+        }
+
+        if (numRemovedTriangles == 0)
+            break;
+
+        // Remap triangles and remove degenerate ones
+        ea::vector<Triangle> remainingTriangles;
+        remainingTriangles.reserve(triangles.size() - numRemovedTriangles);
+        for (Triangle triangle : triangles)
+        {
+            for (unsigned& index : triangle)
+                index = remap[index];
+            if (triangle[0] != triangle[1] && triangle[1] != triangle[2] && triangle[2] != triangle[0])
+                remainingTriangles.push_back(triangle);
+        }
+        triangles = ea::move(remainingTriangles);
+    }
+
+    return CompactGeometry(source, triangles);
+}
+
+void OptimizeVertexCache(GeometryLODView& lodView, unsigned cacheSize)
+{
+    if (!lodView.IsTriangleGeometry() || cacheSize < 4)
+        return;
+
+    const ea::vector<Triangle> triangles = GetTriangleList(lodView);
+    const unsigned numTriangles = triangles.size();
+    const unsigned numVertices = lodView.vertices_.size();
+
+    TriangleAdjacency adjacency;
+    adjacency.Build(triangles, numVertices);
+
+    ea::vector<unsigned> numRemainingTriangles(numVertices);
+    ea::vector<int> cachePositions(numVertices, -1);
+    ea::vector<float> vertexScores(numVertices);
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        numRemainingTriangles[i] = adjacency.End(i) - adjacency.Begin(i);
+        vertexScores[i] = GetVertexCacheScore(-1, numRemainingTriangles[i], cacheSize);
+    }
+
+    ea::vector<bool> emitted(numTriangles);
+    ea::vector<Triangle> result;
+    result.reserve(numTriangles);
+
+    // Cache is extended by 3 so vertices pushed out by the last triangle can be updated
+    ea::vector<unsigned> cache;
+    ea::vector<unsigned> newCache;
+    cache.reserve(cacheSize + 3);
+    newCache.reserve(cacheSize + 3);
+
+    unsigned nextTriangle = M_MAX_UNSIGNED;
+    unsigned scanCursor = 0;
+    while (result.size() < numTriangles)
+    {
+        // Fall back to the first triangle that is not emitted yet if there's no candidate in cache
+        if (nextTriangle == M_MAX_UNSIGNED)
+        {
+            while (emitted[scanCursor])
+                ++scanCursor;
+            nextTriangle = scanCursor;
+        }
+
+        const Triangle& triangle = triangles[nextTriangle];
+        emitted[nextTriangle] = true;
+        result.push_back(triangle);
+
+        // Update cache and remaining triangles
+        newCache.clear();
+        for (unsigned index : triangle)
+        {
+            newCache.push_back(index);
+            --numRemainingTriangles[index];
+        }
+        for (unsigned index : cache)
+        {
+            if (ea::find(triangle.begin(), triangle.end(), index) == triangle.end())
+                newCache.push_back(index);
+        }
+
+        for (unsigned i = 0; i < newCache.size(); ++i)
+            cachePositions[newCache[i]] = i < cacheSize ? static_cast<int>(i) : -1;
+        if (newCache.size() > cacheSize)
+            newCache.resize(cacheSize);
+
+        // Update scores of vertices in cache and their triangles, pick the best triangle
+        for (unsigned index : cache)
+        {
+            if (cachePositions[index] < 0)
+                vertexScores[index] = GetVertexCacheScore(-1, numRemainingTriangles[index], cacheSize);
+        }
+        ea::swap(cache, newCache);
+
+        float bestScore = -1.0f;
+        nextTriangle = M_MAX_UNSIGNED;
+        for (unsigned index : cache)
+            vertexScores[index] = GetVertexCacheScore(cachePositions[index], numRemainingTriangles[index], cacheSize);
+        for (unsigned index : cache)
+        {
+            for (const unsigned* iter = adjacency.Begin(index); iter != adjacency.End(index); ++iter)
+            {
+                if (emitted[*iter])
+                    continue;
+
+                const Triangle& candidate = triangles[*iter];
+                const float score = vertexScores[candidate[0]] + vertexScores[candidate[1]] + vertexScores[candidate[2]];
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    nextTriangle = *iter;
+                }
+            }
+        }
+    }
+
+    SetTriangleList(lodView, result);
+}
+
+void OptimizeOverdraw(GeometryLODView& lodView, unsigned clusterSize)
+{
+    if (!lodView.IsTriangleGeometry() || clusterSize == 0)
+        return;
+
+    const ea::vector<Triangle> triangles = GetTriangleList(lodView);
+    const unsigned numTriangles = triangles.size();
+    const unsigned numClusters = (numTriangles + clusterSize - 1) / clusterSize;
+    if (numClusters < 2)
+        return;
+
+    const auto getPosition = [&](unsigned index) { return lodView.vertices_[index].GetPosition(); };
+
+    // Calculate area-weighted centroid of the mesh and centroids and normals of clusters
+    Vector3 meshCentroid;
+    float meshArea = 0.0f;
+    ea::vector<Vector3> clusterCentroids(numClusters);
+    ea::vector<Vector3> clusterNormals(numClusters);
+    for (unsigned i = 0; i < numTriangles; ++i)
+    {
+        const Triangle& triangle = triangles[i];
+        const Vector3 p0 = getPosition(triangle[0]);
+        const Vector3 p1 = getPosition(triangle[1]);
+        const Vector3 p2 = getPosition(triangle[2]);
+        const Vector3 normal = GetTriangleNormal(p0, p1, p2);
+        const float area = normal.Length();
+        const Vector3 centroid = (p0 + p1 + p2) / 3.0f;
+
+        meshCentroid += centroid * area;
+        meshArea += area;
+        clusterCentroids[i / clusterSize] += centroid * area;
+        clusterNormals[i / clusterSize] += normal;
+    }
+    if (meshArea < M_EPSILON)
+        return;
+    meshCentroid /= meshArea;
+
+    // Clusters facing outwards are rendered first because they are likely to occlude the rest
+    ea::vector<ea::pair<float, unsigned>> clusterOrder(numClusters);
+    for (unsigned i = 0; i < numClusters; ++i)
+    {
+        const float clusterArea = clusterNormals[i].Length();
+        const Vector3 centroid = clusterArea > M_EPSILON ? clusterCentroids[i] / clusterArea : meshCentroid;
+        const float score = (centroid - meshCentroid).DotProduct(clusterNormals[i].Normalized());
+        clusterOrder[i] = {-score, i};
+    }
+    ea::stable_sort(clusterOrder.begin(), clusterOrder.end());
+
+    ea::vector<Triangle> result;
+    result.reserve(numTriangles);
+    for (const auto& [score, clusterIndex] : clusterOrder)
+    {
+        const unsigned begin = clusterIndex * clusterSize;
+        const unsigned end = Min(begin + clusterSize, numTriangles);
+        result.insert(result.end(), triangles.begin() + begin, triangles.begin() + end);
+    }
+
+    SetTriangleList(lodView, result);
+}
+
+void RemoveDuplicateVertices(GeometryLODView& lodView)
+{
+    const unsigned numVertices = lodView.vertices_.size();
+    if (numVertices == 0)
+        return;
+
+    ea::vector<bool> morphed(numVertices);
+    for (const auto& [morphIndex, morphs] : lodView.morphs_)
+    {
+        for (const ModelVertexMorph& morph : morphs)
+        {
+            if (morph.index_ < numVertices)
+                morphed[morph.index_] = true;
+        }
+    }
+
+    // Vertices with equal positions are compared with each other
+    unsigned numGroups = 0;
+    const ea::vector<unsigned> groups = GroupVerticesByPosition(lodView.vertices_, numGroups);
+    ea::vector<ea::vector<unsigned>> groupVertices(numGroups);
+    ea::vector<unsigned> remap(numVertices);
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        remap[i] = i;
+        if (morphed[i])
+            continue;
+
+        for (unsigned candidate : groupVertices[groups[i]])
+        {
+            if (lodView.vertices_[candidate] == lodView.vertices_[i])
+            {
+                remap[i] = candidate;
+                break;
+            }
+        }
+        if (remap[i] == i)
+            groupVertices[groups[i]].push_back(i);
+    }
+
+    for (unsigned& index : lodView.indices_)
+        index = remap[index];
+    OptimizeVertexFetch(lodView);
+}
+
+void OptimizeVertexFetch(GeometryLODView& lodView)
+{
+    const unsigned numVertices = lodView.vertices_.size();
+    ea::vector<unsigned> remap(numVertices, M_MAX_UNSIGNED);
+    ea::vector<ModelVertex> vertices;
+    vertices.reserve(numVertices);
+    for (unsigned& index : lodView.indices_)
+    {
+        if (remap[index] == M_MAX_UNSIGNED)
+        {
+            remap[index] = vertices.size();
+            vertices.push_back(lodView.vertices_[index]);
+        }
+        index = remap[index];
+    }
+
+    lodView.vertices_ = ea::move(vertices);
+    RemapMorphs(lodView, remap);
+}
+
+void UseCompactVertexFormat(GeometryLODView& lodView, float maxHalfUV)
+{
+    ModelVertexFormat& format = lodView.vertexFormat_;
+    if (format.normal_ == TYPE_VECTOR3)
+        format.normal_ = TYPE_SHORT2_NORM;
+    if (format.tangent_ == TYPE_VECTOR4)
+        format.tangent_ = TYPE_UINT_10_10_10_2_NORM;
+
+    // Secondary UVs are usually used for lightmaps and need full precision
+    if (format.uv_[0] == TYPE_VECTOR2)
+    {
+        const bool fitsHalf = ea::all_of(lodView.vertices_.begin(), lodView.vertices_.end(), [&](const ModelVertex& vertex)
+            { return Abs(vertex.uv_[0].x_) <= maxHalfUV && Abs(vertex.uv_[0].y_) <= maxHalfUV; });
+        if (fitsHalf)
+            format.uv_[0] = TYPE_HALF2;
+    }
+}
+
+float CalculateAverageCacheMissRatio(const GeometryLODView& lodView, unsigned cacheSize)
+{
+    const unsigned numPrimitives = lodView.GetNumPrimitives();
+    if (!lodView.IsTriangleGeometry() || numPrimitives == 0 || lodView.primitiveType_ != TRIANGLE_LIST)
+        return 0.0f;
+
+    ea::vector<unsigned> cacheTimestamps(lodView.vertices_.size());
+    unsigned timestamp = cacheSize + 1;
+    unsigned numMisses = 0;
+    for (unsigned index : lodView.indices_)
+    {
+        if (timestamp - cacheTimestamps[index] > cacheSize)
+        {
+            cacheTimestamps[index] = timestamp++;
+            ++numMisses;
+        }
+    }
+    return static_cast<float>(numMisses) / numPrimitives;
+}
+
+}
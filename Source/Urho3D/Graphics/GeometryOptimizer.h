@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/// \file
+
+#pragma once
+
+#include "../Graphics/ModelView.h"
+
+namespace Urho3D
+{
+
+/// Default size of simulated post-transform vertex cache.
+static const unsigned DEFAULT_VERTEX_CACHE_SIZE = 32;
+/// Default number of triangles in cluster used for overdraw optimization.
+static const unsigned DEFAULT_OVERDRAW_CLUSTER_SIZE = 64;
+
+/// Simplify triangle geometry with quadric error metric until the number of triangles is at most targetTriangles
+/// or collapse error exceeds maxError. Error is measured as distance in model space.
+/// Vertices on open borders and attribute seams are never moved, so the silhouette and texture mapping are kept.
+/// Return simplified geometry with unused vertices removed. Geometries other than triangle ones are returned as is.
+URHO3D_API GeometryLODView SimplifyGeometry(
+    const GeometryLODView& lodView, unsigned targetTriangles, float maxError = M_INFINITY);
+/// Reorder triangles to improve post-transform vertex cache utilization.
+/// Non-list triangle geometries are converted to triangle lists.
+URHO3D_API void OptimizeVertexCache(GeometryLODView& lodView, unsigned cacheSize = DEFAULT_VERTEX_CACHE_SIZE);
+/// Reorder clusters of consecutive triangles so outward facing clusters are rendered first, reducing overdraw.
+/// Should be called after vertex cache optimization, vertex cache efficiency is preserved within clusters.
+URHO3D_API void OptimizeOverdraw(GeometryLODView& lodView, unsigned clusterSize = DEFAULT_OVERDRAW_CLUSTER_SIZE);
+/// Merge vertices with equal attributes. Vertices affected by morphs are kept as is.
+URHO3D_API void RemoveDuplicateVertices(GeometryLODView& lodView);
+/// Reorder vertices in order of first use by indices to improve vertex fetch locality. Unused vertices are removed.
+URHO3D_API void OptimizeVertexFetch(GeometryLODView& lodView);
+/// Use compact vertex element types where precision loss is acceptable:
+/// octahedral normals, 10:10:10:2 tangents and half float first UVs if they are within [-maxHalfUV, maxHalfUV] range.
+URHO3D_API void UseCompactVertexFormat(GeometryLODView& lodView, float maxHalfUV = 2.0f);
+/// Return average number of vertex shader invocations per triangle with FIFO vertex cache of given size.
+URHO3D_API float CalculateAverageCacheMissRatio(const GeometryLODView& lodView, unsigned cacheSize = DEFAULT_VERTEX_CACHE_SIZE);
+
+}
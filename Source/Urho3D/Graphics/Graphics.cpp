@@ -27,8 +27,10 @@
 #include "../Graphics/Animation.h"
 #include "../Graphics/AnimationController.h"
 #include "../Graphics/Camera.h"
+#include "../Graphics/ClusteredDecalSet.h"
 #include "../Graphics/ComputeBuffer.h"
 #include "../Graphics/ConstantBuffer.h"
+#include "../Graphics/ConstantBufferRing.h"
 #include "../Graphics/Geometry.h"
 #include "../Graphics/CustomGeometry.h"
 #include "../Graphics/DebugRenderer.h"
@@ -38,6 +40,7 @@
 #include "../Graphics/GraphicsEvents.h"
 #include "../Graphics/GraphicsImpl.h"
 #include "../Graphics/IndexBuffer.h"
+#include "../Graphics/InstancedStaticModel.h"
 #include "../Graphics/LightBaker.h"
 #include "../Graphics/LightProbeGroup.h"
 #include "../Graphics/Material.h"
@@ -55,6 +58,7 @@
 #include "../Graphics/Technique.h"
 #include "../Graphics/Terrain.h"
 #include "../Graphics/TerrainPatch.h"
+#include "../Graphics/TerrainStreamer.h"
 #ifdef _WIN32
 #include "../Graphics/Texture2D.h"
 #endif
@@ -404,6 +408,13 @@ void Graphics::SetShaderCacheDir(const ea::string& path)
         shaderCacheDir_ = AddTrailingSlash(trimmedPath);
 }
 
+ConstantBufferRing* Graphics::GetConstantBufferRing()
+{
+    if (!constantBufferRing_)
+        constantBufferRing_ = MakeShared<ConstantBufferRing>(context_);
+    return constantBufferRing_;
+}
+
 void Graphics::AddGPUObject(GPUObject* object)
 {
     MutexLock lock(gpuObjectMutex_);
@@ -643,6 +654,7 @@ void RegisterGraphicsLibrary(Context* context)
     GlobalIllumination::RegisterObject(context);
     StaticModel::RegisterObject(context);
     StaticModelGroup::RegisterObject(context);
+    InstancedStaticModel::RegisterObject(context);
     Skybox::RegisterObject(context);
     AnimatedModel::RegisterObject(context);
     AnimationController::RegisterObject(context);
@@ -652,8 +664,10 @@ void RegisterGraphicsLibrary(Context* context)
     RibbonTrail::RegisterObject(context);
     CustomGeometry::RegisterObject(context);
     DecalSet::RegisterObject(context);
+    ClusteredDecalSet::RegisterObject(context);
     Terrain::RegisterObject(context);
     TerrainPatch::RegisterObject(context);
+    TerrainStreamer::RegisterObject(context);
     DebugRenderer::RegisterObject(context);
     Octree::RegisterObject(context);
     OutlineGroup::RegisterObject(context);
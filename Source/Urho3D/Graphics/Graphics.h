@@ -41,6 +41,7 @@ namespace Urho3D
 {
 
 class ComputeDevice;
+class ConstantBufferRing;
 class ShaderProgramLayout;
 class File;
 class Image;
@@ -155,6 +156,13 @@ struct GraphicsCaps
     unsigned maxTextureSize_{};
     unsigned maxRenderTargetSize_{};
     unsigned maxNumRenderTargets_{};
+
+    /// Whether indexed draws with base vertex index are supported.
+    bool baseVertexIndexSupported_{};
+    /// Whether MultiDrawIndexedInstancedIndirect is natively supported.
+    bool multiDrawIndirectSupported_{};
+    /// Whether dynamic constant buffers can be updated in parts without synchronization.
+    bool constantBufferRingSupported_{};
 };
 
 /// %Graphics subsystem. Manages the application window, rendering state and GPU resources.
@@ -244,6 +252,10 @@ public:
     /// Draw indexed, instanced geometry with vertex index offset.
     void DrawInstanced(PrimitiveType type, unsigned indexStart, unsigned indexCount, unsigned baseVertexIndex, unsigned minVertex,
         unsigned vertexCount, unsigned instanceCount);
+    /// Draw multiple indexed, instanced geometries with the same state in one call.
+    /// Instance offsets are taken from draw arguments, so vertex buffers should be set with zero instance offset.
+    /// Shall be called only if multi-draw indirect is supported.
+    void MultiDrawIndexedInstancedIndirect(PrimitiveType type, ea::span<const IndirectDrawIndexedArgs> draws);
     /// Set vertex buffer.
     void SetVertexBuffer(VertexBuffer* buffer);
     /// Set multiple vertex buffers.
@@ -485,6 +497,12 @@ public:
     /// @property
     bool GetInstancingSupport() const { return instancingSupport_; }
 
+    /// Return whether linked shader programs can be cached in shader cache directory. OpenGL only.
+    bool GetProgramBinarySupport() const { return programBinarySupport_; }
+
+    /// Return hash of driver identification used to validate cached program binaries.
+    unsigned GetProgramBinaryDriverHash() const { return programBinaryDriverHash_; }
+
     /// Return whether light pre-pass rendering is supported.
     /// @property
     bool GetLightPrepassSupport() const { return lightPrepassSupport_; }
@@ -690,6 +708,9 @@ public:
     /// Get or create a constant buffer. Will be shared between shaders if possible.
     /// @nobind
     ConstantBuffer* GetOrCreateConstantBuffer(ShaderType type, unsigned index, unsigned size);
+    /// Return shared ring of dynamic constant buffer memory. Should be used only if supported by caps.
+    /// @nobind
+    ConstantBufferRing* GetConstantBufferRing();
     /// Mark the FBO needing an update. Used only on OpenGL.
     /// @nobind
     void MarkFBODirty();
@@ -844,6 +865,10 @@ private:
     bool hardwareShadowSupport_{};
     /// Instancing support flag.
     bool instancingSupport_{};
+    /// Program binary caching support flag.
+    bool programBinarySupport_{};
+    /// Hash of driver vendor, renderer and version.
+    unsigned programBinaryDriverHash_{};
     /// sRGB conversion on read support flag.
     bool sRGBSupport_{};
     /// sRGB conversion on write support flag.
@@ -956,6 +981,8 @@ private:
     mutable ea::string lastShaderName_;
     /// Shader precache utility.
     SharedPtr<ShaderPrecache> shaderPrecache_;
+    /// Shared ring of dynamic constant buffer memory.
+    SharedPtr<ConstantBufferRing> constantBufferRing_;
     /// Allowed screen orientations.
     ea::string orientations_;
     /// Graphics API name.
@@ -128,6 +128,9 @@ extern URHO3D_API const unsigned ELEMENT_TYPESIZES[] =
     3 * sizeof(float),
     4 * sizeof(float),
     sizeof(unsigned),
+    sizeof(unsigned),
+    2 * sizeof(unsigned short),
+    2 * sizeof(short),
     sizeof(unsigned)
 };
 
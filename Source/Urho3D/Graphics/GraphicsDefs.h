@@ -164,6 +164,12 @@ enum VertexElementType : unsigned char
     TYPE_VECTOR4,
     TYPE_UBYTE4,
     TYPE_UBYTE4_NORM,
+    /// Two half floats.
+    TYPE_HALF2,
+    /// Two signed normalized shorts. Normals are stored with octahedral encoding and decoded in shader.
+    TYPE_SHORT2_NORM,
+    /// Three 10-bit and one 2-bit unsigned normalized values. Normals and tangents are remapped from [-1, 1].
+    TYPE_UINT_10_10_10_2_NORM,
     MAX_VERTEX_ELEMENT_TYPES
 };
 
@@ -426,6 +432,22 @@ struct ConstantBufferRange
     bool operator !=(const ConstantBufferRange& rhs) const { return !(*this == rhs); }
 };
 
+/// Arguments of one indexed, instanced draw in indirect draw buffer.
+/// Layout matches both DrawElementsIndirectCommand in OpenGL and DrawIndexedInstancedIndirect arguments in Direct3D11.
+struct IndirectDrawIndexedArgs
+{
+    /// Number of indices.
+    unsigned indexCount_{};
+    /// Number of instances.
+    unsigned instanceCount_{};
+    /// First index.
+    unsigned indexStart_{};
+    /// Value added to vertex index before fetching vertex.
+    int baseVertexIndex_{};
+    /// First instance in instance buffer.
+    unsigned instanceStart_{};
+};
+
 // Inbuilt shader parameters.
 extern URHO3D_API const StringHash VSP_AMBIENTSTARTCOLOR;
 extern URHO3D_API const StringHash VSP_AMBIENTENDCOLOR;
@@ -0,0 +1,453 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Graphics/Camera.h"
+#include "../Graphics/Geometry.h"
+#include "../Graphics/InstancedStaticModel.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/Model.h"
+#include "../Graphics/OctreeQuery.h"
+#include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
+#include "../IO/VectorBuffer.h"
+#include "../Math/BatchMath.h"
+#include "../Scene/Node.h"
+
+#include <EASTL/sort.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Max number of instances in one cluster.
+const unsigned clusterSize = 64;
+/// Number of clusters in one cluster group.
+const unsigned clusterGroupSize = 16;
+
+/// Spread lower 10 bits of the value so there are two zero bits between each pair of bits.
+unsigned SpreadBits(unsigned value)
+{
+    value &= 0x3ff;
+    value = (value | (value << 16)) & 0x030000ff;
+    value = (value | (value << 8)) & 0x0300f00f;
+    value = (value | (value << 4)) & 0x030c30c3;
+    value = (value | (value << 2)) & 0x09249249;
+    return value;
+}
+
+/// Return Morton code of the position within the box.
+unsigned GetMortonCode(const Vector3& position, const BoundingBox& box)
+{
+    const Vector3 size = box.Size();
+    const Vector3 normalized = position - box.min_;
+    const auto quantize = [](float value, float range)
+    { return range > M_EPSILON ? static_cast<unsigned>(Clamp(value / range, 0.0f, 1.0f) * 1023.0f) : 0u; };
+
+    return SpreadBits(quantize(normalized.x_, size.x_)) | (SpreadBits(quantize(normalized.y_, size.y_)) << 1)
+        | (SpreadBits(quantize(normalized.z_, size.z_)) << 2);
+}
+
+}
+
+InstancedStaticModel::InstancedStaticModel(Context* context)
+    : StaticModel(context)
+{
+}
+
+InstancedStaticModel::~InstancedStaticModel() = default;
+
+void InstancedStaticModel::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<InstancedStaticModel>(Category_Geometry);
+
+    URHO3D_COPY_BASE_ATTRIBUTES(StaticModel);
+    URHO3D_ACCESSOR_ATTRIBUTE("Instance Draw Distance", GetInstanceDrawDistance, SetInstanceDrawDistance, float, 0.0f, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Instances", GetInstancesAttr, SetInstancesAttr, ea::vector<unsigned char>, Variant::emptyBuffer,
+        AM_DEFAULT | AM_NOEDIT);
+}
+
+void InstancedStaticModel::ProcessRayQuery(const RayOctreeQuery& query, ea::vector<RayQueryResult>& results)
+{
+    const RayQueryLevel level = query.level_;
+    if (level < RAY_AABB)
+    {
+        Drawable::ProcessRayQuery(query, results);
+        return;
+    }
+
+    // GetWorldBoundingBox() updates the world transforms
+    if (query.ray_.HitDistance(GetWorldBoundingBox()) >= query.maxDistance_)
+        return;
+
+    const unsigned numGeometries = geometries_.size();
+    for (const Cluster& cluster : clusters_)
+    {
+        if (query.ray_.HitDistance(cluster.worldBoundingBox_) >= query.maxDistance_)
+            continue;
+
+        for (unsigned i = cluster.start_; i < cluster.start_ + cluster.count_; ++i)
+        {
+            const auto distanceAndNormal = query.ray_.HitDistanceAndNormal(worldBoundingBoxes_[i]);
+            float distance = distanceAndNormal.distance_;
+            Vector3 normal = distanceAndNormal.normal_;
+
+            if (level >= RAY_OBB && distance < query.maxDistance_)
+            {
+                const Matrix3x4& worldTransform = worldTransforms_[i];
+                const Ray localRay = query.ray_.Transformed(worldTransform.Inverse());
+                distance = localRay.HitDistance(boundingBox_);
+
+                if (level >= RAY_TRIANGLE && distance < query.maxDistance_)
+                {
+                    distance = M_INFINITY;
+
+                    for (unsigned j = 0; j < numGeometries; ++j)
+                    {
+                        Geometry* geometry = batches_[j].geometry_;
+                        if (!geometry)
+                            continue;
+
+                        Vector3 geometryNormal;
+                        const float geometryDistance = geometry->GetHitDistance(localRay, &geometryNormal);
+                        if (geometryDistance < query.maxDistance_ && geometryDistance < distance)
+                        {
+                            distance = geometryDistance;
+                            normal = (worldTransform * geometryNormal.ToVector4()).Normalized();
+                        }
+                    }
+                }
+            }
+
+            if (distance < query.maxDistance_)
+            {
+                RayQueryResult result;
+                result.position_ = query.ray_.origin_ + distance * query.ray_.direction_;
+                result.normal_ = normal;
+                result.distance_ = distance;
+                result.drawable_ = this;
+                result.node_ = node_;
+                result.subObject_ = sortedInstances_[i];
+                results.push_back(result);
+            }
+        }
+    }
+}
+
+void InstancedStaticModel::UpdateBatches(const FrameInfo& frame)
+{
+    // Getting the world bounding box ensures the transforms and clusters are updated
+    const BoundingBox& worldBoundingBox = GetWorldBoundingBox();
+    Camera* camera = frame.camera_;
+
+    // Use distance to the closest point so the whole set is not rejected by draw distance
+    const Vector3 cameraPosition = camera->GetNode() ? camera->GetNode()->GetWorldPosition() : Vector3::ZERO;
+    if (worldBoundingBox.Defined())
+        distance_ = camera->GetDistance(VectorMax(worldBoundingBox.min_, VectorMin(worldBoundingBox.max_, cameraPosition)));
+    else
+        distance_ = 0.0f;
+
+    for (ea::vector<Matrix3x4>& transforms : batchTransforms_)
+        transforms.clear();
+    for (unsigned& level : desiredLodLevels_)
+        level = M_MAX_UNSIGNED;
+    numVisibleInstances_ = 0;
+
+    // Batches are reused by shadow passes of the same view, so frustum culling can't be used for shadow casters
+    const Frustum* frustum = castShadows_ ? nullptr : &camera->GetFrustum();
+    for (const ClusterGroup& group : clusterGroups_)
+    {
+        // IsInsideFast doesn't distinguish intersection, so full test is needed to skip culling of nested boxes
+        const Intersection groupIntersection = frustum ? frustum->IsInside(group.worldBoundingBox_) : INSIDE;
+        if (groupIntersection == OUTSIDE)
+            continue;
+
+        for (unsigned i = group.start_; i < group.start_ + group.count_; ++i)
+        {
+            const Cluster& cluster = clusters_[i];
+            const Intersection intersection = groupIntersection == INSIDE ? INSIDE : frustum->IsInside(cluster.worldBoundingBox_);
+            if (intersection != OUTSIDE)
+                ProcessCluster(cluster, camera, intersection == INSIDE ? nullptr : frustum);
+        }
+    }
+
+    for (unsigned i = 0; i < batches_.size(); ++i)
+    {
+        const ea::vector<Matrix3x4>& transforms = batchTransforms_[i];
+        batches_[i].distance_ = distance_;
+        batches_[i].worldTransform_ = transforms.empty() ? &Matrix3x4::IDENTITY : transforms.data();
+        batches_[i].numWorldTransforms_ = transforms.size();
+    }
+
+    if (model_ && model_->IsLodStreamed())
+    {
+        for (unsigned i = 0; i < desiredLodLevels_.size(); ++i)
+        {
+            if (desiredLodLevels_[i] != M_MAX_UNSIGNED)
+                model_->RequestLod(i, desiredLodLevels_[i], frame.frameNumber_);
+        }
+    }
+}
+
+void InstancedStaticModel::ProcessCluster(const Cluster& cluster, Camera* camera, const Frustum* frustum)
+{
+    bool isVisible[clusterSize];
+    if (frustum)
+        TestBoundingBoxesInside(isVisible, *frustum, &worldBoundingBoxes_[cluster.start_], cluster.count_);
+
+    const unsigned numGeometries = geometries_.size();
+    const bool isStreamed = model_ && model_->IsLodStreamed();
+
+    for (unsigned i = 0; i < cluster.count_; ++i)
+    {
+        if (frustum && !isVisible[i])
+            continue;
+
+        const unsigned index = cluster.start_ + i;
+        const Matrix3x4& worldTransform = worldTransforms_[index];
+        const float distance = camera->GetDistance(worldTransform.Translation());
+        if (instanceDrawDistance_ > 0.0f && distance > instanceDrawDistance_)
+            continue;
+
+        const float scale = worldBoundingBoxes_[index].Size().DotProduct(DOT_SCALE);
+        const float lodDistance = camera->GetLodDistance(distance, scale, lodBias_);
+
+        for (unsigned j = 0; j < numGeometries; ++j)
+        {
+            // Same LOD selection as StaticModel, but per instance
+            const ea::vector<SharedPtr<Geometry>>& lodGeometries = geometries_[j];
+            unsigned lodLevel = 1;
+            while (lodLevel < lodGeometries.size()
+                && !(lodGeometries[lodLevel] && lodDistance <= lodGeometries[lodLevel]->GetLodDistance()))
+                ++lodLevel;
+            --lodLevel;
+
+            desiredLodLevels_[j] = ea::min(desiredLodLevels_[j], lodLevel);
+
+            // Fall back to the closest coarser resident LOD level
+            if (isStreamed)
+            {
+                while (lodLevel + 1 < lodGeometries.size() && !model_->IsLodResident(j, lodLevel))
+                    ++lodLevel;
+            }
+
+            batchTransforms_[lodLevel * numGeometries + j].push_back(worldTransform);
+        }
+
+        ++numVisibleInstances_;
+    }
+}
+
+Geometry* InstancedStaticModel::GetLodGeometry(unsigned batchIndex, unsigned level)
+{
+    // LOD batches follow the geometry batches in the same order
+    return geometries_.empty() ? nullptr : StaticModel::GetLodGeometry(batchIndex % geometries_.size(), level);
+}
+
+void InstancedStaticModel::SetModel(Model* model)
+{
+    StaticModel::SetModel(model);
+    UpdateLodBatches();
+}
+
+bool InstancedStaticModel::SetMaterial(unsigned index, Material* material)
+{
+    const unsigned numGeometries = geometries_.size();
+    if (index >= numGeometries)
+    {
+        URHO3D_LOGERROR("Material index out of bounds");
+        return false;
+    }
+
+    for (unsigned i = index; i < batches_.size(); i += numGeometries)
+        batches_[i].material_ = material;
+    return true;
+}
+
+unsigned InstancedStaticModel::AddInstance(const Matrix3x4& transform)
+{
+    instanceTransforms_.push_back(transform);
+    MarkInstancesDirty();
+    return instanceTransforms_.size() - 1;
+}
+
+void InstancedStaticModel::SetInstances(const ea::vector<Matrix3x4>& transforms)
+{
+    instanceTransforms_ = transforms;
+    MarkInstancesDirty();
+}
+
+void InstancedStaticModel::SetInstanceTransform(unsigned index, const Matrix3x4& transform)
+{
+    if (index >= instanceTransforms_.size())
+    {
+        URHO3D_LOGERROR("Instance index out of bounds");
+        return;
+    }
+
+    instanceTransforms_[index] = transform;
+    MarkInstancesDirty();
+}
+
+void InstancedStaticModel::RemoveInstance(unsigned index)
+{
+    if (index >= instanceTransforms_.size())
+    {
+        URHO3D_LOGERROR("Instance index out of bounds");
+        return;
+    }
+
+    instanceTransforms_.erase_unsorted(instanceTransforms_.begin() + index);
+    MarkInstancesDirty();
+}
+
+void InstancedStaticModel::RemoveAllInstances()
+{
+    instanceTransforms_.clear();
+    MarkInstancesDirty();
+}
+
+const Matrix3x4& InstancedStaticModel::GetInstanceTransform(unsigned index) const
+{
+    return index < instanceTransforms_.size() ? instanceTransforms_[index] : Matrix3x4::IDENTITY;
+}
+
+void InstancedStaticModel::SetInstancesAttr(const ea::vector<unsigned char>& value)
+{
+    ea::vector<Matrix3x4> transforms;
+
+    MemoryBuffer buffer(value);
+    while (!buffer.IsEof())
+        transforms.push_back(buffer.ReadMatrix3x4());
+
+    SetInstances(transforms);
+}
+
+ea::vector<unsigned char> InstancedStaticModel::GetInstancesAttr() const
+{
+    VectorBuffer ret;
+
+    for (const Matrix3x4& transform : instanceTransforms_)
+        ret.WriteMatrix3x4(transform);
+
+    return ret.GetBuffer();
+}
+
+void InstancedStaticModel::OnWorldBoundingBoxUpdate()
+{
+    if (clustersDirty_)
+        UpdateClusters();
+
+    const Matrix3x4& nodeTransform = node_->GetWorldTransform();
+    const unsigned numInstances = sortedInstances_.size();
+    for (unsigned i = 0; i < numInstances; ++i)
+    {
+        worldTransforms_[i] = nodeTransform * instanceTransforms_[sortedInstances_[i]];
+        worldBoundingBoxes_[i] = boundingBox_.Transformed(worldTransforms_[i]);
+    }
+
+    for (Cluster& cluster : clusters_)
+    {
+        cluster.worldBoundingBox_.Clear();
+        for (unsigned i = cluster.start_; i < cluster.start_ + cluster.count_; ++i)
+            cluster.worldBoundingBox_.Merge(worldBoundingBoxes_[i]);
+    }
+
+    worldBoundingBox_.Clear();
+    for (ClusterGroup& group : clusterGroups_)
+    {
+        group.worldBoundingBox_.Clear();
+        for (unsigned i = group.start_; i < group.start_ + group.count_; ++i)
+            group.worldBoundingBox_.Merge(clusters_[i].worldBoundingBox_);
+        worldBoundingBox_.Merge(group.worldBoundingBox_);
+    }
+}
+
+void InstancedStaticModel::UpdateLodBatches()
+{
+    const unsigned numGeometries = geometries_.size();
+    unsigned numLodLevels = 1;
+    for (const auto& lodGeometries : geometries_)
+        numLodLevels = ea::max(numLodLevels, static_cast<unsigned>(lodGeometries.size()));
+
+    // Batches of LOD level N of all geometries are stored after batches of level N-1
+    batches_.resize(numGeometries * numLodLevels);
+    for (unsigned level = 1; level < numLodLevels; ++level)
+    {
+        for (unsigned i = 0; i < numGeometries; ++i)
+        {
+            SourceBatch& batch = batches_[level * numGeometries + i];
+            batch = batches_[i];
+            batch.geometry_ = level < geometries_[i].size() ? GetGeometryIfNotEmpty(geometries_[i][level]) : nullptr;
+        }
+    }
+
+    batchTransforms_.resize(batches_.size());
+    desiredLodLevels_.resize(numGeometries);
+}
+
+void InstancedStaticModel::MarkInstancesDirty()
+{
+    clustersDirty_ = true;
+    OnMarkedDirty(node_);
+}
+
+void InstancedStaticModel::UpdateClusters()
+{
+    const unsigned numInstances = instanceTransforms_.size();
+
+    BoundingBox positionsBox;
+    for (const Matrix3x4& transform : instanceTransforms_)
+        positionsBox.Merge(transform.Translation());
+
+    // Sort instances along Morton curve so consecutive instances are close to each other
+    ea::vector<ea::pair<unsigned, unsigned>> spatialOrder(numInstances);
+    for (unsigned i = 0; i < numInstances; ++i)
+        spatialOrder[i] = {GetMortonCode(instanceTransforms_[i].Translation(), positionsBox), i};
+    ea::sort(spatialOrder.begin(), spatialOrder.end());
+
+    sortedInstances_.resize(numInstances);
+    for (unsigned i = 0; i < numInstances; ++i)
+        sortedInstances_[i] = spatialOrder[i].second;
+
+    worldTransforms_.resize(numInstances);
+    worldBoundingBoxes_.resize(numInstances);
+
+    clusters_.clear();
+    for (unsigned start = 0; start < numInstances; start += clusterSize)
+        clusters_.push_back(Cluster{start, ea::min(clusterSize, numInstances - start)});
+
+    const unsigned numClusters = clusters_.size();
+    clusterGroups_.clear();
+    for (unsigned start = 0; start < numClusters; start += clusterGroupSize)
+        clusterGroups_.push_back(ClusterGroup{start, ea::min(clusterGroupSize, numClusters - start)});
+
+    clustersDirty_ = false;
+}
+
+}
@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Graphics/StaticModel.h"
+
+namespace Urho3D
+{
+
+/// Renders many instances of the same model with transforms stored in a dense array instead of scene nodes.
+/// Instances are grouped into spatial clusters that are culled as a unit. LOD levels are chosen per instance.
+/// Instance transforms are relative to the owner node.
+class URHO3D_API InstancedStaticModel : public StaticModel
+{
+    URHO3D_OBJECT(InstancedStaticModel, StaticModel);
+
+public:
+    /// Construct.
+    explicit InstancedStaticModel(Context* context);
+    /// Destruct.
+    ~InstancedStaticModel() override;
+    /// Register object factory. StaticModel must be registered first.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Process octree raycast. May be called from a worker thread.
+    void ProcessRayQuery(const RayOctreeQuery& query, ea::vector<RayQueryResult>& results) override;
+    /// Calculate distance and prepare batches for rendering. May be called from worker thread(s), possibly re-entrantly.
+    void UpdateBatches(const FrameInfo& frame) override;
+    /// Return the geometry for a specific LOD level.
+    Geometry* GetLodGeometry(unsigned batchIndex, unsigned level) override;
+    /// Return number of occlusion geometry triangles. Instance sets are never used as occluders.
+    unsigned GetNumOccluderTriangles() override { return 0; }
+    /// Draw to occlusion buffer. Instance sets are never used as occluders.
+    bool DrawOcclusion(OcclusionBuffer* buffer) override { return true; }
+
+    /// Set model.
+    /// @manualbind
+    void SetModel(Model* model) override;
+    /// Set material on one geometry. Return true if successful.
+    /// @property{set_materials}
+    bool SetMaterial(unsigned index, Material* material) override;
+    using StaticModel::SetMaterial;
+
+    /// Add instance. Return instance index.
+    unsigned AddInstance(const Matrix3x4& transform);
+    /// Replace all instances.
+    void SetInstances(const ea::vector<Matrix3x4>& transforms);
+    /// Set transform of existing instance.
+    void SetInstanceTransform(unsigned index, const Matrix3x4& transform);
+    /// Remove instance. The last instance takes its index.
+    void RemoveInstance(unsigned index);
+    /// Remove all instances.
+    void RemoveAllInstances();
+    /// Set distance beyond which individual instances are not rendered. Zero means unlimited.
+    /// @property
+    void SetInstanceDrawDistance(float distance) { instanceDrawDistance_ = Max(distance, 0.0f); }
+
+    /// Return number of instances.
+    /// @property
+    unsigned GetNumInstances() const { return instanceTransforms_.size(); }
+    /// Return transform of instance relative to the node.
+    const Matrix3x4& GetInstanceTransform(unsigned index) const;
+    /// Return transforms of all instances relative to the node.
+    const ea::vector<Matrix3x4>& GetInstances() const { return instanceTransforms_; }
+    /// Return distance beyond which individual instances are not rendered.
+    /// @property
+    float GetInstanceDrawDistance() const { return instanceDrawDistance_; }
+    /// Return number of instances rendered in the last processed view.
+    unsigned GetNumVisibleInstances() const { return numVisibleInstances_; }
+    /// Return number of instance clusters.
+    unsigned GetNumClusters() const { return clusters_.size(); }
+
+    /// Set instances attribute.
+    void SetInstancesAttr(const ea::vector<unsigned char>& value);
+    /// Return instances attribute.
+    ea::vector<unsigned char> GetInstancesAttr() const;
+
+protected:
+    /// Recalculate the world-space bounding box.
+    void OnWorldBoundingBoxUpdate() override;
+
+private:
+    /// Spatially coherent range of sorted instances.
+    struct Cluster
+    {
+        /// Index of the first instance in sorted order.
+        unsigned start_{};
+        /// Number of instances.
+        unsigned count_{};
+        /// World-space bounding box.
+        BoundingBox worldBoundingBox_;
+    };
+
+    /// Range of clusters culled before the clusters themselves.
+    struct ClusterGroup
+    {
+        /// Index of the first cluster.
+        unsigned start_{};
+        /// Number of clusters.
+        unsigned count_{};
+        /// World-space bounding box.
+        BoundingBox worldBoundingBox_;
+    };
+
+    /// Return number of LOD batches per geometry.
+    unsigned GetNumLodBatches() const { return geometries_.empty() ? 0 : batches_.size() / geometries_.size(); }
+    /// Create per-LOD copies of geometry batches.
+    void UpdateLodBatches();
+    /// Mark instances dirty after change.
+    void MarkInstancesDirty();
+    /// Sort instances along Morton curve and split them into clusters.
+    void UpdateClusters();
+    /// Append visible instances of the cluster to LOD batches. Frustum is null if the cluster is known to be visible.
+    void ProcessCluster(const Cluster& cluster, Camera* camera, const Frustum* frustum);
+
+    /// Instance transforms relative to the node.
+    ea::vector<Matrix3x4> instanceTransforms_;
+    /// Instance world transforms in spatial order.
+    ea::vector<Matrix3x4> worldTransforms_;
+    /// Instance world bounding boxes in spatial order.
+    ea::vector<BoundingBox> worldBoundingBoxes_;
+    /// Instance indices in spatial order.
+    ea::vector<unsigned> sortedInstances_;
+    /// Instance clusters.
+    ea::vector<Cluster> clusters_;
+    /// Cluster groups.
+    ea::vector<ClusterGroup> clusterGroups_;
+    /// Visible instance transforms per batch.
+    ea::vector<ea::vector<Matrix3x4>> batchTransforms_;
+    /// Finest LOD level used by visible instances per geometry.
+    ea::vector<unsigned> desiredLodLevels_;
+    /// Distance beyond which individual instances are not rendered.
+    float instanceDrawDistance_{};
+    /// Number of instances rendered in the last processed view.
+    unsigned numVisibleInstances_{};
+    /// Whether the instances were changed and clusters should be rebuilt.
+    bool clustersDirty_{};
+};
+
+}
@@ -32,8 +32,10 @@
 #include "../Graphics/Octree.h"
 #include "../Graphics/Renderer.h"
 #include "../Graphics/Skybox.h"
+#include "../Graphics/Texture2D.h"
 #include "../Graphics/Zone.h"
 #include "../IO/Log.h"
+#include "../Resource/ResourceCache.h"
 #include "../Scene/Scene.h"
 
 #if URHO3D_GLOW
@@ -55,6 +57,13 @@ static const char* qualityNames[] =
     nullptr
 };
 
+static const char* tracingBackendNames[] =
+{
+    "CPU",
+    "GPU",
+    nullptr
+};
+
 }
 
 /// State of async light baker task.
@@ -69,8 +78,8 @@ struct LightBaker::TaskData
 #if URHO3D_GLOW
     /// Scene collector.
     DefaultBakedSceneCollector sceneCollector_;
-    /// Memory cache
-    BakedLightMemoryCache cache_;
+    /// Lightmap cache.
+    ea::unique_ptr<BakedLightCache> cache_;
     /// Baker.
     IncrementalLightBaker baker_;
 #endif
@@ -100,11 +109,13 @@ void LightBaker::RegisterObject(Context* context)
     context->AddFactoryReflection<LightBaker>(Category_Subsystem);
 
     URHO3D_ACTION_DYNAMIC_LABEL("Bake", BakeAsync, GetBakeLabel);
+    URHO3D_ACTION_STATIC_LABEL("Stop", StopBaking, "Stop baking and discard current pass");
 
     URHO3D_ATTRIBUTE("Output Directory", ea::string, settings_.incremental_.outputDirectory_, "", AM_DEFAULT);
     URHO3D_ATTRIBUTE("Lightmap Size", unsigned, settings_.charting_.lightmapSize_, defaultSettings.charting_.lightmapSize_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Texel Density", float, settings_.charting_.texelDensity_, defaultSettings.charting_.texelDensity_, AM_DEFAULT);
     URHO3D_ENUM_ACCESSOR_ATTRIBUTE("Quality", GetQuality, SetQuality, LightBakingQuality, qualityNames, LightBakingQuality::Custom, AM_DEFAULT);
+    URHO3D_ENUM_ATTRIBUTE("Tracing Backend", settings_.tracingBackend_, tracingBackendNames, LightTracingBackend::CPU, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Direct Samples (Lightmap)", unsigned, settings_.directChartTracing_.maxSamples_, defaultSettings.directChartTracing_.maxSamples_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Direct Samples (Light Probes)", unsigned, settings_.directProbesTracing_.maxSamples_, defaultSettings.directProbesTracing_.maxSamples_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Indirect Bounces", unsigned, settings_.indirectChartTracing_.maxBounces_, defaultSettings.indirectChartTracing_.maxBounces_, AM_DEFAULT);
@@ -115,6 +126,10 @@ void LightBaker::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Chunk Size", Vector3, settings_.incremental_.chunkSize_, defaultSettings.incremental_.chunkSize_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Chunk Indirect Padding", float, settings_.incremental_.indirectPadding_, defaultSettings.incremental_.indirectPadding_, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Chunk Shadow Distance", float, settings_.incremental_.directionalLightShadowDistance_, defaultSettings.incremental_.directionalLightShadowDistance_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Progressive Passes", unsigned, settings_.incremental_.numPasses_, defaultSettings.incremental_.numPasses_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Worker Count", unsigned, settings_.incremental_.numWorkers_, defaultSettings.incremental_.numWorkers_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Worker Index", unsigned, settings_.incremental_.workerIndex_, defaultSettings.incremental_.workerIndex_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Shared Directory", ea::string, settings_.incremental_.sharedDirectory_, "", AM_DEFAULT);
     URHO3D_ATTRIBUTE("Stitch Iterations", unsigned, settings_.stitching_.numIterations_, defaultSettings.stitching_.numIterations_, AM_DEFAULT);
 }
 
@@ -160,6 +175,21 @@ void LightBaker::BakeAsync()
 {
     if (state_ == InternalState::NotStarted)
         state_ = InternalState::ScheduledAsync;
+    else if (state_ == InternalState::InProgress)
+    {
+        // Restart baking from scratch, e.g. if scene is changed
+        taskData_->stopToken_.Stop();
+        restartPending_ = true;
+    }
+}
+
+void LightBaker::StopBaking()
+{
+    if (state_ == InternalState::InProgress)
+    {
+        taskData_->stopToken_.Stop();
+        restartPending_ = false;
+    }
 }
 
 bool LightBaker::UpdateSettings()
@@ -203,7 +233,18 @@ void LightBaker::Update()
 
         auto taskData = ea::make_shared<TaskData>();
         taskData->weakSelf_ = this;
-        if (!taskData->baker_.Initialize(settings_, GetScene(), &taskData->sceneCollector_, &taskData->cache_))
+        if (!settings_.incremental_.sharedDirectory_.empty())
+            taskData->cache_ = ea::make_unique<BakedLightSharedCache>(context_, settings_.incremental_.sharedDirectory_);
+        else if (settings_.incremental_.numWorkers_ <= 1)
+            taskData->cache_ = ea::make_unique<BakedLightMemoryCache>();
+        else
+        {
+            URHO3D_LOGERROR("Shared directory is required to bake light with multiple workers");
+            state_ = InternalState::NotStarted;
+            return;
+        }
+
+        if (!taskData->baker_.Initialize(settings_, GetScene(), &taskData->sceneCollector_, taskData->cache_.get()))
         {
             URHO3D_LOGERROR("Cannot initialize light baking");
             state_ = InternalState::NotStarted;
@@ -216,7 +257,9 @@ void LightBaker::Update()
         // Bake now or schedule task
         if (state_ == InternalState::ScheduledSync)
         {
-            taskData->baker_.Bake(taskData->stopToken_);
+            // Bake all progressive passes at once, there's no one to see intermediate results
+            while (!taskData->baker_.IsFinished() && taskData->baker_.Bake(taskData->stopToken_))
+                ;
 
             state_ = InternalState::CommitPending;
             taskData_ = taskData;
@@ -224,19 +267,10 @@ void LightBaker::Update()
         }
         else
         {
-            const auto taskFunction = [taskData]()
-            {
-                taskData->baker_.Bake(taskData->stopToken_);
-
-                // Self is never destroyed before the task is finished
-                taskData->weakSelf_->state_ = InternalState::CommitPending;
-            };
-
-            task_ = std::async(taskFunction);
+            taskData_ = taskData;
+            StartBakingTask();
 
             // Don't expect any results now, so return
-            state_ = InternalState::InProgress;
-            taskData_ = taskData;
             return;
         }
 #else
@@ -254,13 +288,38 @@ void LightBaker::Update()
         if (task_.valid())
             task_.get();
 
+        // Discard incomplete results if stopped
+        if (taskData_->stopToken_.IsStopped())
+        {
+            URHO3D_LOGINFO("Light baking is stopped");
+            state_ = restartPending_ ? InternalState::ScheduledAsync : InternalState::NotStarted;
+            restartPending_ = false;
+            taskData_ = nullptr;
+            return;
+        }
+
 #if URHO3D_GLOW
         taskData_->baker_.CommitScene();
 #endif
 
-        // Compile light probes
-        auto gi = GetScene()->GetComponent<GlobalIllumination>();
-        gi->CompileLightProbes();
+        // Compile light probes, only main worker has all of them
+        if (settings_.incremental_.workerIndex_ == 0)
+        {
+            auto gi = GetScene()->GetComponent<GlobalIllumination>();
+            gi->CompileLightProbes();
+        }
+
+        // Show intermediate results and bake next progressive pass
+        if (settings_.incremental_.numPasses_ > 1)
+            ReloadLightmaps();
+
+#if URHO3D_GLOW
+        if (!taskData_->baker_.IsFinished())
+        {
+            StartBakingTask();
+            return;
+        }
+#endif
 
         // Log overall time
         const unsigned totalMSec = taskData_->timer_.GetMSec(true);
@@ -272,6 +331,34 @@ void LightBaker::Update()
     }
 }
 
+void LightBaker::StartBakingTask()
+{
+#if URHO3D_GLOW
+    const auto taskFunction = [taskData = taskData_]()
+    {
+        taskData->baker_.Bake(taskData->stopToken_);
+
+        // Self is never destroyed before the task is finished
+        taskData->weakSelf_->state_ = InternalState::CommitPending;
+    };
+
+    // Update state before the task is started so it cannot overwrite task result
+    state_ = InternalState::InProgress;
+    task_ = std::async(taskFunction);
+#endif
+}
+
+void LightBaker::ReloadLightmaps()
+{
+    Scene* scene = GetScene();
+    auto cache = GetSubsystem<ResourceCache>();
+    for (unsigned i = 0; i < scene->GetNumLightmaps(); ++i)
+    {
+        if (Texture2D* lightmapTexture = scene->GetLightmapTexture(i))
+            cache->ReloadResource(lightmapTexture);
+    }
+}
+
 const ea::string& LightBaker::GetBakeLabel() const
 {
 #if URHO3D_GLOW
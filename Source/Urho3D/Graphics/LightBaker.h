@@ -68,8 +68,11 @@ public:
 
     /// Bake light in main thread. Must be called outside rendering.
     void Bake();
-    /// Bake light in worker thread.
+    /// Bake light in worker thread. Restart baking if already in progress.
+    /// If progressive passes are enabled, lightmaps are updated after each pass.
     void BakeAsync();
+    /// Stop baking in worker thread. Results of current pass are discarded.
+    void StopBaking();
 
 private:
     /// Baking task data.
@@ -94,6 +97,10 @@ private:
     bool UpdateSettings();
     /// Update baker. May start or finish baking depending on current state.
     void Update();
+    /// Start baking task for next pass in worker thread.
+    void StartBakingTask();
+    /// Reload lightmap textures to show intermediate results.
+    void ReloadLightmaps();
     /// Return baking status.
     const ea::string& GetBakeLabel() const;
 
@@ -103,6 +110,8 @@ private:
     LightBakingSettings settings_;
     /// Current state.
     std::atomic<InternalState> state_{};
+    /// Whether to restart baking after current task is stopped.
+    bool restartPending_{};
     /// Async baking task.
     std::future<void> task_;
     /// Task data.
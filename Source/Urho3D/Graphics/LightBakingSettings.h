@@ -32,6 +32,15 @@
 namespace Urho3D
 {
 
+/// Backend used to trace lightmap rays.
+enum class LightTracingBackend
+{
+    /// Trace rays on CPU.
+    CPU,
+    /// Trace rays on GPU via compute shaders if supported, fall back to CPU otherwise.
+    GPU
+};
+
 /// Lightmap chart allocation settings.
 struct LightmapChartingSettings
 {
@@ -183,6 +192,18 @@ struct IncrementalLightBakerSettings
     /// Placeholders 1-3: x, y and z components of chunk index.
     /// Placeholder 4: light probe group index within chunk.
     ea::string lightProbeGroupNameFormat_{ "Binary/LightProbeGroup-{}-{}-{}-{}.bin" };
+
+    /// Number of progressive passes. Sample counts are divided between passes,
+    /// results of each pass are accumulated with previous passes and can be committed immediately.
+    unsigned numPasses_{ 1 };
+
+    /// Number of worker processes baking the scene together. Chunks are distributed between workers.
+    unsigned numWorkers_{ 1 };
+    /// Index of current worker process. Worker 0 collects results of all workers and saves outputs.
+    unsigned workerIndex_{ 0 };
+    /// Directory shared between worker processes, used to exchange intermediate results.
+    /// Should be unique for each baking session, stale results are not detected.
+    ea::string sharedDirectory_;
 };
 
 /// Aggregated light baking settings.
@@ -216,6 +237,8 @@ struct LightBakingSettings
 
     /// Calculation properties.
     LightCalculationProperties properties_;
+    /// Backend used to trace lightmap rays. Light probes are always traced on CPU.
+    LightTracingBackend tracingBackend_{};
 
     /// Incremental light baker settings.
     IncrementalLightBakerSettings incremental_;
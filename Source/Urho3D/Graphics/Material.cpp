@@ -28,9 +28,12 @@
 #include "../Core/CoreEvents.h"
 #include "../Core/Profiler.h"
 #include "../Core/Thread.h"
+#include "../Graphics/ConstantBuffer.h"
+#include "../Graphics/ConstantBufferCollection.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/Material.h"
 #include "../Graphics/Renderer.h"
+#include "../Graphics/ShaderProgramLayout.h"
 #include "../Graphics/Technique.h"
 #include "../Graphics/Texture2D.h"
 #include "../Graphics/Texture2DArray.h"
@@ -39,6 +42,7 @@
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
 #include "../IO/VectorBuffer.h"
+#include "../RenderPipeline/ShaderConsts.h"
 #include "../Resource/ResourceCache.h"
 #include "../Resource/ResourceEvents.h"
 #include "../Resource/XMLFile.h"
@@ -197,22 +201,20 @@ bool Material::BeginLoad(Deserializer& source)
     if (!graphics)
         return true;
 
-    const InternalResourceFormat format = PeekResourceFormat(source);
-
-    if (format == InternalResourceFormat::Xml)
-    {
-        if (BeginLoadXML(source))
-            return true;
-    }
-    else if (format == InternalResourceFormat::Json)
+    ResetToDefaults();
+    loadDesc_ = ea::make_unique<MaterialDesc>();
+    if (loadDesc_->Load(context_, source))
     {
-        if (BeginLoadJSON(source))
-            return true;
+        // If async loading, request techniques and textures to also be loaded.
+        // Can not do anything else at this point
+        if (GetAsyncLoadState() == ASYNC_LOADING)
+            BackgroundLoadResources(*loadDesc_);
+        return true;
     }
 
     // All loading failed
     ResetToDefaults();
-    loadJSONFile_.Reset();
+    loadDesc_ = nullptr;
     return false;
 }
 
@@ -223,139 +225,39 @@ bool Material::EndLoad()
     if (!graphics)
         return true;
 
-    bool success = false;
-    if (loadXMLFile_)
-    {
-        // If async loading, get the techniques / textures which should be ready now
-        XMLElement rootElem = loadXMLFile_->GetRoot();
-        success = Load(rootElem);
-    }
-
-    if (loadJSONFile_)
-    {
-        JSONValue rootVal = loadJSONFile_->GetRoot();
-        success = Load(rootVal);
-    }
-
-    loadXMLFile_.Reset();
-    loadJSONFile_.Reset();
+    const bool success = loadDesc_ && Load(*loadDesc_);
+    loadDesc_ = nullptr;
     return success;
 }
 
-bool Material::BeginLoadXML(Deserializer& source)
-{
-    ResetToDefaults();
-    loadXMLFile_ = MakeShared<XMLFile>(context_);
-    if (loadXMLFile_->Load(source))
-    {
-        // If async loading, scan the XML content beforehand for technique & texture resources
-        // and request them to also be loaded. Can not do anything else at this point
-        if (GetAsyncLoadState() == ASYNC_LOADING)
-        {
-            auto* cache = GetSubsystem<ResourceCache>();
-            XMLElement rootElem = loadXMLFile_->GetRoot();
-            XMLElement techniqueElem = rootElem.GetChild("technique");
-            while (techniqueElem)
-            {
-                cache->BackgroundLoadResource<Technique>(techniqueElem.GetAttribute("name"), true, this);
-                techniqueElem = techniqueElem.GetNext("technique");
-            }
-
-            XMLElement textureElem = rootElem.GetChild("texture");
-            while (textureElem)
-            {
-                ea::string name = textureElem.GetAttribute("name");
-                // Detect cube maps and arrays by file extension: they are defined by an XML file
-                if (GetExtension(name) == ".xml")
-                {
-#ifdef DESKTOP_GRAPHICS
-                    StringHash type = ParseTextureTypeXml(cache, name);
-                    if (!type && textureElem.HasAttribute("unit"))
-                    {
-                        TextureUnit unit = ParseTextureUnitName(textureElem.GetAttribute("unit"));
-                        if (unit == TU_VOLUMEMAP)
-                            type = Texture3D::GetTypeStatic();
-                    }
-
-                    if (type == Texture3D::GetTypeStatic())
-                        cache->BackgroundLoadResource<Texture3D>(name, true, this);
-                    else if (type == Texture2DArray::GetTypeStatic())
-                        cache->BackgroundLoadResource<Texture2DArray>(name, true, this);
-                    else
-#endif
-                        cache->BackgroundLoadResource<TextureCube>(name, true, this);
-                }
-                else
-                    cache->BackgroundLoadResource<Texture2D>(name, true, this);
-                textureElem = textureElem.GetNext("texture");
-            }
-        }
-
-        return true;
-    }
-
-    return false;
-}
-
-bool Material::BeginLoadJSON(Deserializer& source)
+void Material::BackgroundLoadResources(const MaterialDesc& desc)
 {
-    // Attempt to load a JSON file
-    ResetToDefaults();
-    loadXMLFile_.Reset();
+    auto* cache = GetSubsystem<ResourceCache>();
+    for (const MaterialDesc::TechniqueDesc& technique : desc.techniques_)
+        cache->BackgroundLoadResource<Technique>(technique.name_, true, this);
 
-    // Attempt to load from JSON file instead
-    loadJSONFile_ = MakeShared<JSONFile>(context_);
-    if (loadJSONFile_->Load(source))
+    for (const MaterialDesc::TextureDesc& texture : desc.textures_)
     {
-        // If async loading, scan the XML content beforehand for technique & texture resources
-        // and request them to also be loaded. Can not do anything else at this point
-        if (GetAsyncLoadState() == ASYNC_LOADING)
+        const ea::string& name = texture.name_;
+        // Detect cube maps and arrays by file extension: they are defined by an XML file
+        if (GetExtension(name) == ".xml")
         {
-            auto* cache = GetSubsystem<ResourceCache>();
-            const JSONValue& rootVal = loadJSONFile_->GetRoot();
-
-            JSONArray techniqueArray = rootVal.Get("techniques").GetArray();
-            for (unsigned i = 0; i < techniqueArray.size(); i++)
-            {
-                const JSONValue& techVal = techniqueArray[i];
-                cache->BackgroundLoadResource<Technique>(techVal.Get("name").GetString(), true, this);
-            }
-
-            JSONObject textureObject = rootVal.Get("textures").GetObject();
-            for (auto it = textureObject.begin(); it != textureObject.end(); it++)
-            {
-                ea::string unitString = it->first;
-                ea::string name = it->second.GetString();
-                // Detect cube maps and arrays by file extension: they are defined by an XML file
-                if (GetExtension(name) == ".xml")
-                {
 #ifdef DESKTOP_GRAPHICS
-                    StringHash type = ParseTextureTypeXml(cache, name);
-                    if (!type && !unitString.empty())
-                    {
-                        TextureUnit unit = ParseTextureUnitName(unitString);
-                        if (unit == TU_VOLUMEMAP)
-                            type = Texture3D::GetTypeStatic();
-                    }
-
-                    if (type == Texture3D::GetTypeStatic())
-                        cache->BackgroundLoadResource<Texture3D>(name, true, this);
-                    else if (type == Texture2DArray::GetTypeStatic())
-                        cache->BackgroundLoadResource<Texture2DArray>(name, true, this);
-                    else
+            StringHash type = ParseTextureTypeXml(cache, name);
+            if (!type && texture.unit_ == TU_VOLUMEMAP)
+                type = Texture3D::GetTypeStatic();
+
+            if (type == Texture3D::GetTypeStatic())
+                cache->BackgroundLoadResource<Texture3D>(name, true, this);
+            else if (type == Texture2DArray::GetTypeStatic())
+                cache->BackgroundLoadResource<Texture2DArray>(name, true, this);
+            else
 #endif
-                        cache->BackgroundLoadResource<TextureCube>(name, true, this);
-                }
-                else
-                    cache->BackgroundLoadResource<Texture2D>(name, true, this);
-            }
+                cache->BackgroundLoadResource<TextureCube>(name, true, this);
         }
-
-        // JSON material was successfully loaded
-        return true;
+        else
+            cache->BackgroundLoadResource<Texture2D>(name, true, this);
     }
-
-    return false;
 }
 
 bool Material::Save(Serializer& dest) const
@@ -369,194 +271,62 @@ bool Material::Save(Serializer& dest) const
 
 bool Material::Load(const XMLElement& source)
 {
-    ResetToDefaults();
-
     if (source.IsNull())
     {
+        ResetToDefaults();
         URHO3D_LOGERROR("Can not load material from null XML element");
         return false;
     }
 
-    auto* cache = GetSubsystem<ResourceCache>();
-
-    XMLElement shaderElem = source.GetChild("shader");
-    if (shaderElem)
+    MaterialDesc desc;
+    if (!desc.LoadXML(context_, source))
     {
-        vertexShaderDefines_ = shaderElem.GetAttribute("vsdefines");
-        pixelShaderDefines_ = shaderElem.GetAttribute("psdefines");
-    }
-
-    XMLElement techniqueElem = source.GetChild("technique");
-    techniques_.clear();
-
-    while (techniqueElem)
-    {
-        auto* tech = cache->GetResource<Technique>(techniqueElem.GetAttribute("name"));
-        if (tech)
-        {
-            TechniqueEntry newTechnique;
-            newTechnique.technique_ = newTechnique.original_ = tech;
-            if (techniqueElem.HasAttribute("quality"))
-                newTechnique.qualityLevel_ = (MaterialQuality)techniqueElem.GetInt("quality");
-            if (techniqueElem.HasAttribute("loddistance"))
-                newTechnique.lodDistance_ = techniqueElem.GetFloat("loddistance");
-            techniques_.push_back(newTechnique);
-        }
-
-        techniqueElem = techniqueElem.GetNext("technique");
+        ResetToDefaults();
+        return false;
     }
 
-    SortTechniques();
-    ApplyShaderDefines();
-
-    XMLElement textureElem = source.GetChild("texture");
-    while (textureElem)
-    {
-        TextureUnit unit = TU_DIFFUSE;
-        if (textureElem.HasAttribute("unit"))
-            unit = ParseTextureUnitName(textureElem.GetAttribute("unit"));
-        if (unit < MAX_TEXTURE_UNITS)
-        {
-            ea::string name = textureElem.GetAttribute("name");
-            // Detect cube maps and arrays by file extension: they are defined by an XML file
-            if (GetExtension(name) == ".xml")
-            {
-#ifdef DESKTOP_GRAPHICS
-                StringHash type = ParseTextureTypeXml(cache, name);
-                if (!type && unit == TU_VOLUMEMAP)
-                    type = Texture3D::GetTypeStatic();
-
-                if (type == Texture3D::GetTypeStatic())
-                    SetTextureInternal(unit, cache->GetResource<Texture3D>(name));
-                else if (type == Texture2DArray::GetTypeStatic())
-                    SetTextureInternal(unit, cache->GetResource<Texture2DArray>(name));
-                else
-#endif
-                    SetTextureInternal(unit, cache->GetResource<TextureCube>(name));
-            }
-            else
-                SetTextureInternal(unit, cache->GetResource<Texture2D>(name));
-        }
-        textureElem = textureElem.GetNext("texture");
-    }
-    RefreshTextureEventSubscriptions();
+    return Load(desc);
+}
 
-    batchedParameterUpdate_ = true;
-    XMLElement parameterElem = source.GetChild("parameter");
-    while (parameterElem)
+bool Material::Load(const JSONValue& source)
+{
+    if (source.IsNull())
     {
-        ea::string name = parameterElem.GetAttribute("name");
-        if (!parameterElem.HasAttribute("type"))
-            SetShaderParameter(name, ParseShaderParameterValue(parameterElem.GetAttribute("value")));
-        else
-            SetShaderParameter(name, Variant(parameterElem.GetAttribute("type"), parameterElem.GetAttribute("value")));
-        parameterElem = parameterElem.GetNext("parameter");
+        ResetToDefaults();
+        URHO3D_LOGERROR("Can not load material from null JSON element");
+        return false;
     }
-    batchedParameterUpdate_ = false;
 
-    XMLElement parameterAnimationElem = source.GetChild("parameteranimation");
-    while (parameterAnimationElem)
+    MaterialDesc desc;
+    if (!desc.LoadJSON(context_, source))
     {
-        ea::string name = parameterAnimationElem.GetAttribute("name");
-        SharedPtr<ValueAnimation> animation(MakeShared<ValueAnimation>(context_));
-        if (!animation->LoadXML(parameterAnimationElem))
-        {
-            URHO3D_LOGERROR("Could not load parameter animation");
-            return false;
-        }
-
-        ea::string wrapModeString = parameterAnimationElem.GetAttribute("wrapmode");
-        WrapMode wrapMode = WM_LOOP;
-        for (int i = 0; i <= WM_CLAMP; ++i)
-        {
-            if (wrapModeString == wrapModeNames[i])
-            {
-                wrapMode = (WrapMode)i;
-                break;
-            }
-        }
-
-        float speed = parameterAnimationElem.GetFloat("speed");
-        SetShaderParameterAnimation(name, animation, wrapMode, speed);
-
-        parameterAnimationElem = parameterAnimationElem.GetNext("parameteranimation");
+        ResetToDefaults();
+        return false;
     }
 
-    XMLElement cullElem = source.GetChild("cull");
-    if (cullElem)
-        SetCullMode((CullMode)GetStringListIndex(cullElem.GetAttribute("value").c_str(), cullModeNames, CULL_CCW));
-
-    XMLElement shadowCullElem = source.GetChild("shadowcull");
-    if (shadowCullElem)
-        SetShadowCullMode((CullMode)GetStringListIndex(shadowCullElem.GetAttribute("value").c_str(), cullModeNames, CULL_CCW));
-
-    XMLElement fillElem = source.GetChild("fill");
-    if (fillElem)
-        SetFillMode((FillMode)GetStringListIndex(fillElem.GetAttribute("value").c_str(), fillModeNames, FILL_SOLID));
-
-    XMLElement depthBiasElem = source.GetChild("depthbias");
-    if (depthBiasElem)
-        SetDepthBias(BiasParameters(depthBiasElem.GetFloat("constant"), depthBiasElem.GetFloat("slopescaled"), depthBiasElem.GetFloat("normaloffset")));
-
-    XMLElement alphaToCoverageElem = source.GetChild("alphatocoverage");
-    if (alphaToCoverageElem)
-        SetAlphaToCoverage(alphaToCoverageElem.GetBool("enable"));
-
-    XMLElement lineAntiAliasElem = source.GetChild("lineantialias");
-    if (lineAntiAliasElem)
-        SetLineAntiAlias(lineAntiAliasElem.GetBool("enable"));
-
-    XMLElement renderOrderElem = source.GetChild("renderorder");
-    if (renderOrderElem)
-        SetRenderOrder((unsigned char)renderOrderElem.GetUInt("value"));
-
-    XMLElement occlusionElem = source.GetChild("occlusion");
-    if (occlusionElem)
-        SetOcclusion(occlusionElem.GetBool("enable"));
-
-    RefreshShaderParameterHash();
-    RefreshMemoryUse();
-    return true;
+    return Load(desc);
 }
 
-bool Material::Load(const JSONValue& source)
+bool Material::Load(const MaterialDesc& desc)
 {
     ResetToDefaults();
 
-    if (source.IsNull())
-    {
-        URHO3D_LOGERROR("Can not load material from null JSON element");
-        return false;
-    }
-
     auto* cache = GetSubsystem<ResourceCache>();
 
-    const JSONValue& shaderVal = source.Get("shader");
-    if (!shaderVal.IsNull())
-    {
-        vertexShaderDefines_ = shaderVal.Get("vsdefines").GetString();
-        pixelShaderDefines_ = shaderVal.Get("psdefines").GetString();
-    }
+    vertexShaderDefines_ = desc.vertexShaderDefines_;
+    pixelShaderDefines_ = desc.pixelShaderDefines_;
 
-    // Load techniques
-    JSONArray techniquesArray = source.Get("techniques").GetArray();
     techniques_.clear();
-    techniques_.reserve(techniquesArray.size());
-
-    for (unsigned i = 0; i < techniquesArray.size(); i++)
+    techniques_.reserve(desc.techniques_.size());
+    for (const MaterialDesc::TechniqueDesc& techniqueDesc : desc.techniques_)
     {
-        const JSONValue& techVal = techniquesArray[i];
-        auto* tech = cache->GetResource<Technique>(techVal.Get("name").GetString());
+        auto* tech = cache->GetResource<Technique>(techniqueDesc.name_);
         if (tech)
         {
             TechniqueEntry newTechnique;
             newTechnique.technique_ = newTechnique.original_ = tech;
-            JSONValue qualityVal = techVal.Get("quality");
-            if (!qualityVal.IsNull())
-                newTechnique.qualityLevel_ = (MaterialQuality)qualityVal.GetInt();
-            JSONValue lodDistanceVal = techVal.Get("loddistance");
-            if (!lodDistanceVal.IsNull())
-                newTechnique.lodDistance_ = lodDistanceVal.GetFloat();
+            newTechnique.qualityLevel_ = techniqueDesc.qualityLevel_;
+            newTechnique.lodDistance_ = techniqueDesc.lodDistance_;
             techniques_.push_back(newTechnique);
         }
     }
@@ -564,117 +334,50 @@ bool Material::Load(const JSONValue& source)
     SortTechniques();
     ApplyShaderDefines();
 
-    // Load textures
-    JSONObject textureObject = source.Get("textures").GetObject();
-    for (auto it = textureObject.begin(); it != textureObject.end(); it++)
+    for (const MaterialDesc::TextureDesc& textureDesc : desc.textures_)
     {
-        ea::string textureUnit = it->first;
-        ea::string textureName = it->second.GetString();
-
-        TextureUnit unit = TU_DIFFUSE;
-        unit = ParseTextureUnitName(textureUnit);
-
-        if (unit < MAX_TEXTURE_UNITS)
+        const TextureUnit unit = textureDesc.unit_;
+        const ea::string& name = textureDesc.name_;
+        // Detect cube maps and arrays by file extension: they are defined by an XML file
+        if (GetExtension(name) == ".xml")
         {
-            // Detect cube maps and arrays by file extension: they are defined by an XML file
-            if (GetExtension(textureName) == ".xml")
-            {
 #ifdef DESKTOP_GRAPHICS
-                StringHash type = ParseTextureTypeXml(cache, textureName);
-                if (!type && unit == TU_VOLUMEMAP)
-                    type = Texture3D::GetTypeStatic();
-
-                if (type == Texture3D::GetTypeStatic())
-                    SetTextureInternal(unit, cache->GetResource<Texture3D>(textureName));
-                else if (type == Texture2DArray::GetTypeStatic())
-                    SetTextureInternal(unit, cache->GetResource<Texture2DArray>(textureName));
-                else
-#endif
-                    SetTextureInternal(unit, cache->GetResource<TextureCube>(textureName));
-            }
+            StringHash type = ParseTextureTypeXml(cache, name);
+            if (!type && unit == TU_VOLUMEMAP)
+                type = Texture3D::GetTypeStatic();
+
+            if (type == Texture3D::GetTypeStatic())
+                SetTextureInternal(unit, cache->GetResource<Texture3D>(name));
+            else if (type == Texture2DArray::GetTypeStatic())
+                SetTextureInternal(unit, cache->GetResource<Texture2DArray>(name));
             else
-                SetTextureInternal(unit, cache->GetResource<Texture2D>(textureName));
+#endif
+                SetTextureInternal(unit, cache->GetResource<TextureCube>(name));
         }
+        else
+            SetTextureInternal(unit, cache->GetResource<Texture2D>(name));
     }
     RefreshTextureEventSubscriptions();
 
-    // Get shader parameters
     batchedParameterUpdate_ = true;
-    JSONObject parameterObject = source.Get("shaderParameters").GetObject();
-
-    for (auto it = parameterObject.begin(); it != parameterObject.end(); it++)
-    {
-        ea::string name = it->first;
-        if (it->second.IsString())
-            SetShaderParameter(name, ParseShaderParameterValue(it->second.GetString()));
-        else if (it->second.IsObject())
-        {
-            JSONObject valueObj = it->second.GetObject();
-            SetShaderParameter(name, Variant(valueObj["type"].GetString(), valueObj["value"].GetString()));
-        }
-    }
+    for (const MaterialDesc::ShaderParameterDesc& parameterDesc : desc.shaderParameters_)
+        SetShaderParameter(parameterDesc.name_, parameterDesc.value_);
     batchedParameterUpdate_ = false;
 
-    // Load shader parameter animations
-    JSONObject paramAnimationsObject = source.Get("shaderParameterAnimations").GetObject();
-    for (auto it = paramAnimationsObject.begin(); it != paramAnimationsObject.end(); it++)
+    for (const MaterialDesc::ShaderParameterAnimationDesc& animationDesc : desc.shaderParameterAnimations_)
     {
-        ea::string name = it->first;
-        JSONValue paramAnimVal = it->second;
-
-        SharedPtr<ValueAnimation> animation(MakeShared<ValueAnimation>(context_));
-        if (!animation->LoadJSON(paramAnimVal))
-        {
-            URHO3D_LOGERROR("Could not load parameter animation");
-            return false;
-        }
-
-        ea::string wrapModeString = paramAnimVal.Get("wrapmode").GetString();
-        WrapMode wrapMode = WM_LOOP;
-        for (int i = 0; i <= WM_CLAMP; ++i)
-        {
-            if (wrapModeString == wrapModeNames[i])
-            {
-                wrapMode = (WrapMode)i;
-                break;
-            }
-        }
-
-        float speed = paramAnimVal.Get("speed").GetFloat();
-        SetShaderParameterAnimation(name, animation, wrapMode, speed);
+        SetShaderParameterAnimation(
+            animationDesc.name_, animationDesc.animation_, animationDesc.wrapMode_, animationDesc.speed_);
     }
 
-    JSONValue cullVal = source.Get("cull");
-    if (!cullVal.IsNull())
-        SetCullMode((CullMode)GetStringListIndex(cullVal.GetString().c_str(), cullModeNames, CULL_CCW));
-
-    JSONValue shadowCullVal = source.Get("shadowcull");
-    if (!shadowCullVal.IsNull())
-        SetShadowCullMode((CullMode)GetStringListIndex(shadowCullVal.GetString().c_str(), cullModeNames, CULL_CCW));
-
-    JSONValue fillVal = source.Get("fill");
-    if (!fillVal.IsNull())
-        SetFillMode((FillMode)GetStringListIndex(fillVal.GetString().c_str(), fillModeNames, FILL_SOLID));
-
-    JSONValue depthBiasVal = source.Get("depthbias");
-    if (!depthBiasVal.IsNull())
-        SetDepthBias(BiasParameters(depthBiasVal.Get("constant").GetFloat(), depthBiasVal.Get("slopescaled").GetFloat(), depthBiasVal.Get("normaloffset").GetFloat()));
-
-    JSONValue alphaToCoverageVal = source.Get("alphatocoverage");
-    if (!alphaToCoverageVal.IsNull())
-        SetAlphaToCoverage(alphaToCoverageVal.GetBool());
-
-    JSONValue lineAntiAliasVal = source.Get("lineantialias");
-    if (!lineAntiAliasVal.IsNull())
-        SetLineAntiAlias(lineAntiAliasVal.GetBool());
-
-    JSONValue renderOrderVal = source.Get("renderorder");
-    if (!renderOrderVal.IsNull())
-        SetRenderOrder((unsigned char)renderOrderVal.GetUInt());
-
-    JSONValue occlusionVal = source.Get("occlusion");
-    if (!occlusionVal.IsNull())
-        SetOcclusion(occlusionVal.GetBool());
+    SetCullMode(desc.cullMode_);
+    SetShadowCullMode(desc.shadowCullMode_);
+    SetFillMode(desc.fillMode_);
+    SetDepthBias(desc.depthBias_);
+    SetAlphaToCoverage(desc.alphaToCoverage_);
+    SetLineAntiAlias(desc.lineAntiAlias_);
+    SetRenderOrder(desc.renderOrder_);
+    SetOcclusion(desc.occlusion_);
 
     RefreshShaderParameterHash();
     RefreshMemoryUse();
@@ -899,6 +602,7 @@ void Material::SetNumTechniques(unsigned num)
 
     techniques_.resize(num);
     RefreshMemoryUse();
+    MarkRevisionUpdated();
 }
 
 void Material::SetTechnique(unsigned index, Technique* tech, MaterialQuality qualityLevel, float lodDistance)
@@ -908,6 +612,7 @@ void Material::SetTechnique(unsigned index, Technique* tech, MaterialQuality qua
 
     techniques_[index] = TechniqueEntry(tech, qualityLevel, lodDistance);
     ApplyShaderDefines(index);
+    MarkRevisionUpdated();
 }
 
 void Material::SetTechniques(const ea::vector<TechniqueEntry>& techniques)
@@ -1178,6 +883,7 @@ SharedPtr<Material> Material::Clone(const ea::string& cloneName) const
 void Material::SortTechniques()
 {
     ea::sort(techniques_.begin(), techniques_.end());
+    MarkRevisionUpdated();
 }
 
 void Material::MarkForAuxView(unsigned frameNumber)
@@ -1342,6 +1048,51 @@ void Material::RefreshShaderParameterHash()
     unsigned dataSize = temp.GetSize();
     for (unsigned i = 0; i < dataSize; ++i)
         shaderParameterHash_ = SDBMHash(shaderParameterHash_, data[i]);
+
+    ++shaderParametersRevision_;
+}
+
+ConstantBuffer* Material::GetOrCreateConstantBuffer(const ShaderProgramLayout* layout, float depthRange)
+{
+    unsigned key = layout->GetConstantBufferHash(SP_MATERIAL);
+    CombineHash(key, MakeHash(depthRange));
+
+    BakedConstantBuffer& baked = constantBuffers_[key];
+    if (baked.buffer_ && baked.revision_ == shaderParametersRevision_ && !baked.buffer_->IsDataLost())
+        return baked.buffer_;
+
+    const unsigned size = layout->GetConstantBufferSize(SP_MATERIAL);
+    ByteVector data((size + 15) / 16 * 16);
+    for (const auto& [name, parameter] : shaderParameters_)
+    {
+        if (parameter.isCustom_)
+            continue;
+
+        const ConstantBufferElement& element = layout->GetConstantBufferParameter(name);
+        if (element.group_ != SP_MATERIAL)
+            continue;
+
+        // Keep in sync with BatchRenderer
+        unsigned char* dest = data.data() + element.offset_;
+        if (name == ShaderConsts::Material_FadeOffsetScale)
+        {
+            const Vector2 param = parameter.value_.GetVector2();
+            const Vector2 paramAdjusted{param.x_ / depthRange, depthRange / param.y_};
+            ConstantBufferCollection::StoreParameter(dest, element.size_, paramAdjusted);
+        }
+        else
+            ConstantBufferCollection::StoreParameter(dest, element.size_, parameter.value_);
+    }
+
+    if (!baked.buffer_)
+        baked.buffer_ = MakeShared<ConstantBuffer>(context_);
+    if (baked.buffer_->GetSize() != data.size() && !baked.buffer_->SetSize(data.size()))
+        return nullptr;
+
+    baked.buffer_->Update(data.data());
+    baked.buffer_->ClearDataLost();
+    baked.revision_ = shaderParametersRevision_;
+    return baked.buffer_;
 }
 
 void Material::RefreshMemoryUse()
@@ -1425,14 +1176,24 @@ void Material::ApplyShaderDefines(unsigned index)
         techniques_[index].technique_ = techniques_[index].original_;
     else
         techniques_[index].technique_ = techniques_[index].original_->CloneWithDefines(vertexShaderDefines_, pixelShaderDefines_);
+    MarkRevisionUpdated();
 }
 
 void Material::RefreshTextureEventSubscriptions()
 {
     UnsubscribeFromEvent(E_RELOADFINISHED);
     const auto onReload = [this](StringHash, const VariantMap&) { MarkPipelineStateHashDirty(); };
+    // Hash is order-independent so that materials with equal texture maps have equal hashes
+    texturesHash_ = 0;
     for (const auto& item : textures_)
+    {
         SubscribeToEvent(item.second, E_RELOADFINISHED, onReload);
+
+        unsigned itemHash = 0;
+        CombineHash(itemHash, item.first);
+        CombineHash(itemHash, MakeHash(item.second.Get()));
+        texturesHash_ += itemHash;
+    }
     MarkPipelineStateHashDirty();
 }
 
@@ -23,8 +23,10 @@
 #pragma once
 
 #include "../Container/IndexAllocator.h"
+#include "../Core/ObjectRevisionTracker.h"
 #include "../Graphics/GraphicsDefs.h"
 #include "../Graphics/Light.h"
+#include "../Graphics/MaterialDesc.h"
 #include "../Graphics/Technique.h"
 #include "../Math/Vector4.h"
 #include "../Resource/Resource.h"
@@ -35,8 +37,10 @@
 namespace Urho3D
 {
 
+class ConstantBuffer;
 class Material;
 class Pass;
+class ShaderProgramLayout;
 class Scene;
 class Texture;
 class Texture2D;
@@ -44,8 +48,6 @@ class TextureCube;
 class ValueAnimationInfo;
 class JSONFile;
 
-static const unsigned char DEFAULT_RENDER_ORDER = 128;
-
 static const char* textureUnitNames[] =
 {
     "diffuse",
@@ -147,7 +149,11 @@ private:
 };
 
 /// Describes how to render 3D geometries.
-class URHO3D_API Material : public Resource, public PipelineStateTracker, public IDFamily<Material>
+/// Revision is updated whenever the set of techniques changes.
+class URHO3D_API Material : public Resource,
+                            public PipelineStateTracker,
+                            public IDFamily<Material>,
+                            public ObjectRevisionTracker
 {
     URHO3D_OBJECT(Material, Resource);
 
@@ -183,6 +189,9 @@ public:
     /// Save to a JSON value. Return true if successful.
     bool Save(JSONValue& dest) const;
 
+    /// Load from parsed description. Techniques and textures are resolved by name. Return true if successful.
+    bool Load(const MaterialDesc& desc);
+
     /// Set number of techniques.
     /// @property
     void SetNumTechniques(unsigned num);
@@ -275,6 +284,8 @@ public:
 
     /// Return all textures.
     const ea::unordered_map<TextureUnit, SharedPtr<Texture> >& GetTextures() const { return textures_; }
+    /// Return hash of all textures. Materials with different hashes never bind the same textures.
+    unsigned GetTexturesHash() const { return texturesHash_; }
 
     /// Return additional vertex shader defines.
     /// @property
@@ -340,6 +351,10 @@ public:
 
     /// Return shader parameter hash value. Used as an optimization to avoid setting shader parameters unnecessarily.
     unsigned GetShaderParameterHash() const { return shaderParameterHash_; }
+    /// Return persistent constant buffer with material shader parameters laid out for given shader program.
+    /// Custom shader parameters are not included. Buffer is rebuilt only when shader parameters change.
+    /// Should be called from main thread only.
+    ConstantBuffer* GetOrCreateConstantBuffer(const ShaderProgramLayout* layout, float depthRange);
 
     /// Return name for texture unit.
     static ea::string GetTextureUnitName(TextureUnit unit);
@@ -347,10 +362,8 @@ public:
     static Variant ParseShaderParameterValue(const ea::string& value);
 
 private:
-    /// Helper function for loading JSON files.
-    bool BeginLoadJSON(Deserializer& source);
-    /// Helper function for loading XML files.
-    bool BeginLoadXML(Deserializer& source);
+    /// Request background loading of techniques and textures referenced by material description.
+    void BackgroundLoadResources(const MaterialDesc& desc);
 
     /// Reset to defaults.
     void ResetToDefaults();
@@ -377,6 +390,8 @@ private:
     ea::vector<TechniqueEntry> techniques_;
     /// Textures.
     ea::unordered_map<TextureUnit, SharedPtr<Texture> > textures_;
+    /// Hash of textures.
+    unsigned texturesHash_{};
     /// %Shader parameters.
     ea::unordered_map<StringHash, MaterialShaderParameter> shaderParameters_;
     /// %Shader parameters animation infos.
@@ -399,6 +414,16 @@ private:
     std::atomic_uint32_t auxViewFrameNumber_{ 0 };
     /// Shader parameter hash value.
     unsigned shaderParameterHash_{};
+    /// Revision of shader parameters, incremented whenever the hash is recalculated.
+    unsigned shaderParametersRevision_{1};
+    /// Persistent constant buffer with shader parameters.
+    struct BakedConstantBuffer
+    {
+        SharedPtr<ConstantBuffer> buffer_;
+        unsigned revision_{};
+    };
+    /// Persistent constant buffers for each combination of shader program layout and camera depth range.
+    ea::unordered_map<unsigned, BakedConstantBuffer> constantBuffers_;
     /// Alpha-to-coverage flag.
     bool alphaToCoverage_{};
     /// Line antialiasing flag.
@@ -411,10 +436,8 @@ private:
     bool subscribed_{};
     /// Flag to suppress parameter hash and memory use recalculation when setting multiple shader parameters (loading or resetting the material).
     bool batchedParameterUpdate_{};
-    /// XML file used while loading.
-    SharedPtr<XMLFile> loadXMLFile_;
-    /// JSON file used while loading.
-    SharedPtr<JSONFile> loadJSONFile_;
+    /// Material description used while loading.
+    ea::unique_ptr<MaterialDesc> loadDesc_;
     /// Associated scene for shader parameter animation updates.
     WeakPtr<Scene> scene_;
 };
@@ -0,0 +1,366 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Graphics/MaterialDesc.h"
+
+#include "../Graphics/Material.h"
+#include "../IO/ArchiveSerialization.h"
+#include "../IO/BinaryArchive.h"
+#include "../IO/Log.h"
+#include "../Resource/JSONFile.h"
+#include "../Resource/XMLFile.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+extern const char* wrapModeNames[];
+TextureUnit ParseTextureUnitName(ea::string name);
+
+namespace
+{
+
+const char* materialRootBlock = "material";
+
+WrapMode ParseWrapMode(const ea::string& name)
+{
+    for (int i = 0; i <= WM_CLAMP; ++i)
+    {
+        if (name == wrapModeNames[i])
+            return static_cast<WrapMode>(i);
+    }
+    return WM_LOOP;
+}
+
+}
+
+void MaterialDesc::TechniqueDesc::SerializeInBlock(Archive& archive)
+{
+    SerializeValue(archive, "name", name_);
+    SerializeValueAsType<unsigned>(archive, "quality", qualityLevel_);
+    SerializeValue(archive, "lodDistance", lodDistance_);
+}
+
+void MaterialDesc::TextureDesc::SerializeInBlock(Archive& archive)
+{
+    SerializeValueAsType<unsigned>(archive, "unit", unit_);
+    SerializeValue(archive, "name", name_);
+}
+
+void MaterialDesc::ShaderParameterDesc::SerializeInBlock(Archive& archive)
+{
+    SerializeValue(archive, "name", name_);
+    SerializeValue(archive, "value", value_);
+}
+
+void MaterialDesc::ShaderParameterAnimationDesc::SerializeInBlock(Archive& archive)
+{
+    SerializeValue(archive, "name", name_);
+    SerializeEnum(archive, "wrapMode", wrapMode_, wrapModeNames);
+    SerializeValue(archive, "speed", speed_);
+
+    // Animations are rare, store them as embedded XML
+    ea::string animationXml;
+    XMLFile xmlFile(archive.GetContext());
+    if (!archive.IsInput() && animation_)
+    {
+        XMLElement rootElem = xmlFile.CreateRoot("valueanimation");
+        animation_->SaveXML(rootElem);
+        animationXml = xmlFile.ToString();
+    }
+
+    SerializeValue(archive, "animation", animationXml);
+
+    if (archive.IsInput())
+    {
+        animation_ = MakeShared<ValueAnimation>(archive.GetContext());
+        if (!xmlFile.FromString(animationXml) || !animation_->LoadXML(xmlFile.GetRoot()))
+            throw ArchiveException("Cannot load parameter animation '{}'", name_);
+    }
+}
+
+bool MaterialDesc::LoadXML(Context* context, const XMLElement& source)
+{
+    XMLElement shaderElem = source.GetChild("shader");
+    if (shaderElem)
+    {
+        vertexShaderDefines_ = shaderElem.GetAttribute("vsdefines");
+        pixelShaderDefines_ = shaderElem.GetAttribute("psdefines");
+    }
+
+    for (XMLElement techniqueElem = source.GetChild("technique"); techniqueElem;
+         techniqueElem = techniqueElem.GetNext("technique"))
+    {
+        TechniqueDesc& technique = techniques_.emplace_back();
+        technique.name_ = techniqueElem.GetAttribute("name");
+        if (techniqueElem.HasAttribute("quality"))
+            technique.qualityLevel_ = static_cast<MaterialQuality>(techniqueElem.GetInt("quality"));
+        if (techniqueElem.HasAttribute("loddistance"))
+            technique.lodDistance_ = techniqueElem.GetFloat("loddistance");
+    }
+
+    for (XMLElement textureElem = source.GetChild("texture"); textureElem;
+         textureElem = textureElem.GetNext("texture"))
+    {
+        TextureUnit unit = TU_DIFFUSE;
+        if (textureElem.HasAttribute("unit"))
+            unit = ParseTextureUnitName(textureElem.GetAttribute("unit"));
+        if (unit < MAX_TEXTURE_UNITS)
+            textures_.push_back(TextureDesc{unit, textureElem.GetAttribute("name")});
+    }
+
+    for (XMLElement parameterElem = source.GetChild("parameter"); parameterElem;
+         parameterElem = parameterElem.GetNext("parameter"))
+    {
+        ShaderParameterDesc& parameter = shaderParameters_.emplace_back();
+        parameter.name_ = parameterElem.GetAttribute("name");
+        if (!parameterElem.HasAttribute("type"))
+            parameter.value_ = Material::ParseShaderParameterValue(parameterElem.GetAttribute("value"));
+        else
+            parameter.value_ = Variant(parameterElem.GetAttribute("type"), parameterElem.GetAttribute("value"));
+    }
+
+    for (XMLElement parameterAnimationElem = source.GetChild("parameteranimation"); parameterAnimationElem;
+         parameterAnimationElem = parameterAnimationElem.GetNext("parameteranimation"))
+    {
+        ShaderParameterAnimationDesc& parameterAnimation = shaderParameterAnimations_.emplace_back();
+        parameterAnimation.name_ = parameterAnimationElem.GetAttribute("name");
+        parameterAnimation.animation_ = MakeShared<ValueAnimation>(context);
+        if (!parameterAnimation.animation_->LoadXML(parameterAnimationElem))
+        {
+            URHO3D_LOGERROR("Could not load parameter animation");
+            return false;
+        }
+
+        parameterAnimation.wrapMode_ = ParseWrapMode(parameterAnimationElem.GetAttribute("wrapmode"));
+        parameterAnimation.speed_ = parameterAnimationElem.GetFloat("speed");
+    }
+
+    XMLElement cullElem = source.GetChild("cull");
+    if (cullElem)
+        cullMode_ = static_cast<CullMode>(GetStringListIndex(cullElem.GetAttribute("value").c_str(), cullModeNames, CULL_CCW));
+
+    XMLElement shadowCullElem = source.GetChild("shadowcull");
+    if (shadowCullElem)
+    {
+        shadowCullMode_ = static_cast<CullMode>(
+            GetStringListIndex(shadowCullElem.GetAttribute("value").c_str(), cullModeNames, CULL_CCW));
+    }
+
+    XMLElement fillElem = source.GetChild("fill");
+    if (fillElem)
+        fillMode_ = static_cast<FillMode>(GetStringListIndex(fillElem.GetAttribute("value").c_str(), fillModeNames, FILL_SOLID));
+
+    XMLElement depthBiasElem = source.GetChild("depthbias");
+    if (depthBiasElem)
+    {
+        depthBias_ = BiasParameters(depthBiasElem.GetFloat("constant"), depthBiasElem.GetFloat("slopescaled"),
+            depthBiasElem.GetFloat("normaloffset"));
+    }
+
+    XMLElement alphaToCoverageElem = source.GetChild("alphatocoverage");
+    if (alphaToCoverageElem)
+        alphaToCoverage_ = alphaToCoverageElem.GetBool("enable");
+
+    XMLElement lineAntiAliasElem = source.GetChild("lineantialias");
+    if (lineAntiAliasElem)
+        lineAntiAlias_ = lineAntiAliasElem.GetBool("enable");
+
+    XMLElement renderOrderElem = source.GetChild("renderorder");
+    if (renderOrderElem)
+        renderOrder_ = static_cast<unsigned char>(renderOrderElem.GetUInt("value"));
+
+    XMLElement occlusionElem = source.GetChild("occlusion");
+    if (occlusionElem)
+        occlusion_ = occlusionElem.GetBool("enable");
+
+    return true;
+}
+
+bool MaterialDesc::LoadJSON(Context* context, const JSONValue& source)
+{
+    const JSONValue& shaderVal = source.Get("shader");
+    if (!shaderVal.IsNull())
+    {
+        vertexShaderDefines_ = shaderVal.Get("vsdefines").GetString();
+        pixelShaderDefines_ = shaderVal.Get("psdefines").GetString();
+    }
+
+    const JSONArray& techniquesArray = source.Get("techniques").GetArray();
+    techniques_.reserve(techniquesArray.size());
+    for (const JSONValue& techVal : techniquesArray)
+    {
+        TechniqueDesc& technique = techniques_.emplace_back();
+        technique.name_ = techVal.Get("name").GetString();
+        const JSONValue& qualityVal = techVal.Get("quality");
+        if (!qualityVal.IsNull())
+            technique.qualityLevel_ = static_cast<MaterialQuality>(qualityVal.GetInt());
+        const JSONValue& lodDistanceVal = techVal.Get("loddistance");
+        if (!lodDistanceVal.IsNull())
+            technique.lodDistance_ = lodDistanceVal.GetFloat();
+    }
+
+    for (const auto& [unitName, textureVal] : source.Get("textures").GetObject())
+    {
+        const TextureUnit unit = ParseTextureUnitName(unitName);
+        if (unit < MAX_TEXTURE_UNITS)
+            textures_.push_back(TextureDesc{unit, textureVal.GetString()});
+    }
+
+    for (const auto& [name, parameterVal] : source.Get("shaderParameters").GetObject())
+    {
+        if (parameterVal.IsString())
+            shaderParameters_.push_back({name, Material::ParseShaderParameterValue(parameterVal.GetString())});
+        else if (parameterVal.IsObject())
+        {
+            const Variant value{parameterVal.Get("type").GetString(), parameterVal.Get("value").GetString()};
+            shaderParameters_.push_back({name, value});
+        }
+    }
+
+    for (const auto& [name, paramAnimVal] : source.Get("shaderParameterAnimations").GetObject())
+    {
+        ShaderParameterAnimationDesc& parameterAnimation = shaderParameterAnimations_.emplace_back();
+        parameterAnimation.name_ = name;
+        parameterAnimation.animation_ = MakeShared<ValueAnimation>(context);
+        if (!parameterAnimation.animation_->LoadJSON(paramAnimVal))
+        {
+            URHO3D_LOGERROR("Could not load parameter animation");
+            return false;
+        }
+
+        parameterAnimation.wrapMode_ = ParseWrapMode(paramAnimVal.Get("wrapmode").GetString());
+        parameterAnimation.speed_ = paramAnimVal.Get("speed").GetFloat();
+    }
+
+    const JSONValue& cullVal = source.Get("cull");
+    if (!cullVal.IsNull())
+        cullMode_ = static_cast<CullMode>(GetStringListIndex(cullVal.GetString().c_str(), cullModeNames, CULL_CCW));
+
+    const JSONValue& shadowCullVal = source.Get("shadowcull");
+    if (!shadowCullVal.IsNull())
+        shadowCullMode_ = static_cast<CullMode>(GetStringListIndex(shadowCullVal.GetString().c_str(), cullModeNames, CULL_CCW));
+
+    const JSONValue& fillVal = source.Get("fill");
+    if (!fillVal.IsNull())
+        fillMode_ = static_cast<FillMode>(GetStringListIndex(fillVal.GetString().c_str(), fillModeNames, FILL_SOLID));
+
+    const JSONValue& depthBiasVal = source.Get("depthbias");
+    if (!depthBiasVal.IsNull())
+    {
+        depthBias_ = BiasParameters(depthBiasVal.Get("constant").GetFloat(), depthBiasVal.Get("slopescaled").GetFloat(),
+            depthBiasVal.Get("normaloffset").GetFloat());
+    }
+
+    const JSONValue& alphaToCoverageVal = source.Get("alphatocoverage");
+    if (!alphaToCoverageVal.IsNull())
+        alphaToCoverage_ = alphaToCoverageVal.GetBool();
+
+    const JSONValue& lineAntiAliasVal = source.Get("lineantialias");
+    if (!lineAntiAliasVal.IsNull())
+        lineAntiAlias_ = lineAntiAliasVal.GetBool();
+
+    const JSONValue& renderOrderVal = source.Get("renderorder");
+    if (!renderOrderVal.IsNull())
+        renderOrder_ = static_cast<unsigned char>(renderOrderVal.GetUInt());
+
+    const JSONValue& occlusionVal = source.Get("occlusion");
+    if (!occlusionVal.IsNull())
+        occlusion_ = occlusionVal.GetBool();
+
+    return true;
+}
+
+bool MaterialDesc::Load(Context* context, Deserializer& source)
+{
+    switch (PeekResourceFormat(source))
+    {
+    case InternalResourceFormat::Xml:
+    {
+        XMLFile xmlFile(context);
+        return xmlFile.Load(source) && LoadXML(context, xmlFile.GetRoot());
+    }
+    case InternalResourceFormat::Json:
+    {
+        JSONFile jsonFile(context);
+        return jsonFile.Load(source) && LoadJSON(context, jsonFile.GetRoot());
+    }
+    case InternalResourceFormat::Binary:
+    {
+        try
+        {
+            source.SeekRelative(BinaryMagicSize);
+            BinaryInputArchive archive{context, source};
+            SerializeValue(archive, materialRootBlock, *this);
+            return true;
+        }
+        catch (const ArchiveException& e)
+        {
+            URHO3D_LOGERROR("Cannot load binary material: {}", e.what());
+            return false;
+        }
+    }
+    default:
+        return false;
+    }
+}
+
+bool MaterialDesc::SaveBinary(Context* context, Serializer& dest) const
+{
+    try
+    {
+        dest.Write(DefaultBinaryMagic.data(), BinaryMagicSize);
+        BinaryOutputArchive archive{context, dest};
+        SerializeValue(archive, materialRootBlock, const_cast<MaterialDesc&>(*this));
+        return true;
+    }
+    catch (const ArchiveException& e)
+    {
+        URHO3D_LOGERROR("Cannot save binary material: {}", e.what());
+        return false;
+    }
+}
+
+void MaterialDesc::SerializeInBlock(Archive& archive)
+{
+    SerializeValue(archive, "vsDefines", vertexShaderDefines_);
+    SerializeValue(archive, "psDefines", pixelShaderDefines_);
+    SerializeVectorAsObjects(archive, "techniques", techniques_, "technique");
+    SerializeVectorAsObjects(archive, "textures", textures_, "texture");
+    SerializeVectorAsObjects(archive, "shaderParameters", shaderParameters_, "shaderParameter");
+    SerializeVectorAsObjects(archive, "shaderParameterAnimations", shaderParameterAnimations_, "shaderParameterAnimation");
+    SerializeEnum(archive, "cullMode", cullMode_, cullModeNames);
+    SerializeEnum(archive, "shadowCullMode", shadowCullMode_, cullModeNames);
+    SerializeEnum(archive, "fillMode", fillMode_, fillModeNames);
+    SerializeValue(archive, "constantBias", depthBias_.constantBias_);
+    SerializeValue(archive, "slopeScaledBias", depthBias_.slopeScaledBias_);
+    SerializeValue(archive, "normalOffset", depthBias_.normalOffset_);
+    SerializeValue(archive, "alphaToCoverage", alphaToCoverage_);
+    SerializeValue(archive, "lineAntiAlias", lineAntiAlias_);
+    SerializeValue(archive, "renderOrder", renderOrder_);
+    SerializeValue(archive, "occlusion", occlusion_);
+}
+
+}
@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Core/Variant.h"
+#include "../Graphics/GraphicsDefs.h"
+#include "../Graphics/Light.h"
+#include "../Scene/AnimationDefs.h"
+#include "../Scene/ValueAnimation.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class Archive;
+class Deserializer;
+class JSONValue;
+class Serializer;
+class XMLElement;
+
+static const unsigned char DEFAULT_RENDER_ORDER = 128;
+
+/// %Material contents with all values parsed and resources referenced by name.
+/// Used to load materials from XML, JSON and compact binary format with the same code.
+struct URHO3D_API MaterialDesc
+{
+    /// Technique reference.
+    struct TechniqueDesc
+    {
+        /// Technique name.
+        ea::string name_;
+        /// Quality level.
+        MaterialQuality qualityLevel_{QUALITY_LOW};
+        /// LOD distance.
+        float lodDistance_{};
+
+        void SerializeInBlock(Archive& archive);
+    };
+
+    /// Texture reference.
+    struct TextureDesc
+    {
+        /// Texture unit.
+        TextureUnit unit_{TU_DIFFUSE};
+        /// Texture name.
+        ea::string name_;
+
+        void SerializeInBlock(Archive& archive);
+    };
+
+    /// Shader parameter.
+    struct ShaderParameterDesc
+    {
+        /// Parameter name.
+        ea::string name_;
+        /// Parsed value.
+        Variant value_;
+
+        void SerializeInBlock(Archive& archive);
+    };
+
+    /// Shader parameter animation.
+    struct ShaderParameterAnimationDesc
+    {
+        /// Parameter name.
+        ea::string name_;
+        /// Animation.
+        SharedPtr<ValueAnimation> animation_;
+        /// Wrap mode.
+        WrapMode wrapMode_{WM_LOOP};
+        /// Animation speed.
+        float speed_{};
+
+        void SerializeInBlock(Archive& archive);
+    };
+
+    /// Load from XML element. Return true if successful.
+    bool LoadXML(Context* context, const XMLElement& source);
+    /// Load from JSON value. Return true if successful.
+    bool LoadJSON(Context* context, const JSONValue& source);
+    /// Load from stream in XML, JSON or binary format. Return true if successful.
+    bool Load(Context* context, Deserializer& source);
+    /// Save to stream in binary format. Return true if successful.
+    bool SaveBinary(Context* context, Serializer& dest) const;
+    /// Serialize contents. Parameter animations are supported only for binary archives.
+    void SerializeInBlock(Archive& archive);
+
+    /// Additional vertex shader defines.
+    ea::string vertexShaderDefines_;
+    /// Additional pixel shader defines.
+    ea::string pixelShaderDefines_;
+    /// Techniques in order of declaration.
+    ea::vector<TechniqueDesc> techniques_;
+    /// Textures.
+    ea::vector<TextureDesc> textures_;
+    /// Shader parameters.
+    ea::vector<ShaderParameterDesc> shaderParameters_;
+    /// Shader parameter animations.
+    ea::vector<ShaderParameterAnimationDesc> shaderParameterAnimations_;
+    /// Normal culling mode.
+    CullMode cullMode_{CULL_CCW};
+    /// Culling mode for shadow rendering.
+    CullMode shadowCullMode_{CULL_CCW};
+    /// Polygon fill mode.
+    FillMode fillMode_{FILL_SOLID};
+    /// Depth bias parameters.
+    BiasParameters depthBias_{0.0f, 0.0f};
+    /// Alpha-to-coverage flag.
+    bool alphaToCoverage_{};
+    /// Line antialiasing flag.
+    bool lineAntiAlias_{};
+    /// Render order value.
+    unsigned char renderOrder_{DEFAULT_RENDER_ORDER};
+    /// Render occlusion flag.
+    bool occlusion_{true};
+};
+
+}
@@ -0,0 +1,240 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Graphics/Meshlet.h"
+
+#include "../Graphics/Geometry.h"
+#include "../Graphics/ModelView.h"
+#include "../Graphics/VertexBuffer.h"
+#include "../Math/Frustum.h"
+
+#include <EASTL/array.h>
+#include <EASTL/sort.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Minimal cosine between cone axis and triangle normal that allows backface culling of the meshlet.
+const float minConeCosine = 0.1f;
+
+/// Spread lower 10 bits of the value so there are two zero bits between each pair of bits.
+unsigned SpreadBits(unsigned value)
+{
+    value &= 0x3ff;
+    value = (value | (value << 16)) & 0x030000ff;
+    value = (value | (value << 8)) & 0x0300f00f;
+    value = (value | (value << 4)) & 0x030c30c3;
+    value = (value | (value << 2)) & 0x09249249;
+    return value;
+}
+
+/// Return Morton code of the position within the box.
+unsigned GetMortonCode(const Vector3& position, const BoundingBox& box)
+{
+    const Vector3 size = box.Size();
+    const Vector3 normalized = position - box.min_;
+    const auto quantize = [](float value, float range)
+    { return range > M_EPSILON ? static_cast<unsigned>(Clamp(value / range, 0.0f, 1.0f) * 1023.0f) : 0u; };
+
+    return SpreadBits(quantize(normalized.x_, size.x_)) | (SpreadBits(quantize(normalized.y_, size.y_)) << 1)
+        | (SpreadBits(quantize(normalized.z_, size.z_)) << 2);
+}
+
+/// Calculate meshlet bounds and normal cone from triangle vertex positions.
+Meshlet CreateMeshlet(unsigned indexStart, const ea::vector<Vector3>& positions)
+{
+    Meshlet meshlet;
+    meshlet.indexStart_ = indexStart;
+    meshlet.indexCount_ = positions.size();
+
+    meshlet.boundingBox_.Define(positions.data(), positions.size());
+    meshlet.boundingSphere_.Define(meshlet.boundingBox_);
+
+    ea::vector<Vector3> normals;
+    normals.reserve(positions.size() / 3);
+    Vector3 axis;
+    for (unsigned i = 0; i + 2 < positions.size(); i += 3)
+    {
+        const Vector3 normal = (positions[i + 1] - positions[i]).CrossProduct(positions[i + 2] - positions[i]);
+        const float length = normal.Length();
+        if (length < M_EPSILON)
+            continue;
+
+        normals.push_back(normal / length);
+        axis += normals.back();
+    }
+
+    if (axis.Length() < M_EPSILON)
+        return meshlet;
+
+    meshlet.coneAxis_ = axis.Normalized();
+    float minCosine = 1.0f;
+    for (const Vector3& normal : normals)
+        minCosine = Min(minCosine, normal.DotProduct(meshlet.coneAxis_));
+
+    if (minCosine >= minConeCosine)
+        meshlet.coneCutoff_ = Sqrt(1.0f - minCosine * minCosine);
+    return meshlet;
+}
+
+template <class T>
+void ReadMeshletPositions(ea::vector<Vector3>& positions, const unsigned char* vertexData, unsigned vertexSize,
+    unsigned positionOffset, const T* indices, unsigned indexStart, unsigned indexCount)
+{
+    positions.clear();
+    for (unsigned i = indexStart; i < indexStart + indexCount; ++i)
+    {
+        const unsigned char* vertex = vertexData + indices[i] * vertexSize + positionOffset;
+        positions.push_back(*reinterpret_cast<const Vector3*>(vertex));
+    }
+}
+
+}
+
+ea::vector<Meshlet> BuildMeshlets(GeometryLODView& lodView, unsigned maxTriangles)
+{
+    if (!lodView.IsTriangleGeometry() || lodView.vertices_.empty() || maxTriangles == 0)
+        return {};
+
+    // Convert to triangle list
+    ea::vector<ea::array<unsigned, 3>> triangles;
+    lodView.ForEachTriangle([&](unsigned i0, unsigned i1, unsigned i2) { triangles.push_back({i0, i1, i2}); });
+    const unsigned numTriangles = triangles.size();
+
+    // Sort triangles along Morton curve so consecutive triangles are close to each other
+    ea::vector<Vector3> centroids(numTriangles);
+    BoundingBox boundingBox;
+    for (unsigned i = 0; i < numTriangles; ++i)
+    {
+        Vector3 centroid;
+        for (unsigned index : triangles[i])
+            centroid += lodView.vertices_[index].GetPosition();
+        centroids[i] = centroid / 3.0f;
+        boundingBox.Merge(centroids[i]);
+    }
+
+    ea::vector<ea::pair<unsigned, unsigned>> spatialOrder(numTriangles);
+    for (unsigned i = 0; i < numTriangles; ++i)
+        spatialOrder[i] = {GetMortonCode(centroids[i], boundingBox), i};
+    ea::sort(spatialOrder.begin(), spatialOrder.end());
+
+    ea::vector<unsigned> indices;
+    indices.reserve(numTriangles * 3);
+    for (const auto& [code, triangleIndex] : spatialOrder)
+        indices.insert(indices.end(), triangles[triangleIndex].begin(), triangles[triangleIndex].end());
+
+    lodView.primitiveType_ = TRIANGLE_LIST;
+    lodView.indices_ = ea::move(indices);
+
+    ea::vector<Meshlet> meshlets;
+    ea::vector<Vector3> positions;
+    const unsigned numIndices = lodView.indices_.size();
+    for (unsigned indexStart = 0; indexStart < numIndices; indexStart += maxTriangles * 3)
+    {
+        const unsigned indexEnd = Min(indexStart + maxTriangles * 3, numIndices);
+        positions.clear();
+        for (unsigned i = indexStart; i < indexEnd; ++i)
+            positions.push_back(lodView.vertices_[lodView.indices_[i]].GetPosition());
+        meshlets.push_back(CreateMeshlet(indexStart, positions));
+    }
+    return meshlets;
+}
+
+ea::vector<Meshlet> CalculateMeshlets(const Geometry* geometry, unsigned maxTriangles)
+{
+    if (!geometry || geometry->GetPrimitiveType() != TRIANGLE_LIST || maxTriangles == 0)
+        return {};
+
+    const unsigned char* vertexData{};
+    const unsigned char* indexData{};
+    unsigned vertexSize{};
+    unsigned indexSize{};
+    const ea::vector<VertexElement>* elements{};
+    geometry->GetRawData(vertexData, vertexSize, indexData, indexSize, elements);
+    if (!vertexData || !indexData || !elements)
+        return {};
+
+    const unsigned positionOffset = VertexBuffer::GetElementOffset(*elements, TYPE_VECTOR3, SEM_POSITION);
+    if (positionOffset == M_MAX_UNSIGNED)
+        return {};
+
+    ea::vector<Meshlet> meshlets;
+    ea::vector<Vector3> positions;
+    const unsigned indexStart = geometry->GetIndexStart();
+    const unsigned indexEnd = indexStart + geometry->GetIndexCount();
+    for (unsigned meshletStart = indexStart; meshletStart + 2 < indexEnd; meshletStart += maxTriangles * 3)
+    {
+        const unsigned meshletCount = Min(maxTriangles * 3, (indexEnd - meshletStart) / 3 * 3);
+        if (indexSize == sizeof(unsigned))
+        {
+            ReadMeshletPositions(positions, vertexData, vertexSize, positionOffset,
+                reinterpret_cast<const unsigned*>(indexData), meshletStart, meshletCount);
+        }
+        else
+        {
+            ReadMeshletPositions(positions, vertexData, vertexSize, positionOffset,
+                reinterpret_cast<const unsigned short*>(indexData), meshletStart, meshletCount);
+        }
+        meshlets.push_back(CreateMeshlet(meshletStart, positions));
+    }
+    return meshlets;
+}
+
+unsigned CullMeshlets(ea::vector<IndirectDrawIndexedArgs>& drawArgs, const Meshlet meshlets[], unsigned count,
+    const Frustum& frustum, const Vector3& viewPosition, unsigned instanceCount)
+{
+    unsigned numVisible = 0;
+    IndirectDrawIndexedArgs* lastDraw = nullptr;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const Meshlet& meshlet = meshlets[i];
+        if (!meshlet.IsFrontFacing(viewPosition) || frustum.IsInsideFast(meshlet.boundingBox_) == OUTSIDE)
+        {
+            lastDraw = nullptr;
+            continue;
+        }
+
+        ++numVisible;
+        if (lastDraw && lastDraw->indexStart_ + lastDraw->indexCount_ == meshlet.indexStart_)
+        {
+            lastDraw->indexCount_ += meshlet.indexCount_;
+            continue;
+        }
+
+        IndirectDrawIndexedArgs& args = drawArgs.emplace_back();
+        args.indexStart_ = meshlet.indexStart_;
+        args.indexCount_ = meshlet.indexCount_;
+        args.instanceCount_ = instanceCount;
+        lastDraw = &args;
+    }
+    return numVisible;
+}
+
+}
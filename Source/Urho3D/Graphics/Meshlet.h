@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/// \file
+
+#pragma once
+
+#include "../Graphics/GraphicsDefs.h"
+#include "../Math/BoundingBox.h"
+#include "../Math/Sphere.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class Frustum;
+class Geometry;
+struct GeometryLODView;
+
+/// Default number of triangles per meshlet.
+static const unsigned DEFAULT_MESHLET_TRIANGLES = 64;
+
+/// Cluster of spatially coherent triangles that occupy contiguous index range of the geometry.
+struct URHO3D_API Meshlet
+{
+    /// First index.
+    unsigned indexStart_{};
+    /// Number of indices.
+    unsigned indexCount_{};
+    /// Bounding box of the triangles.
+    BoundingBox boundingBox_;
+    /// Bounding sphere of the triangles.
+    Sphere boundingSphere_;
+    /// Average direction of triangle normals.
+    Vector3 coneAxis_;
+    /// Sine of the angle between cone axis and the most deviating triangle normal.
+    /// One if the triangles face too many directions for the meshlet to be backface culled.
+    float coneCutoff_{1.0f};
+
+    /// Return whether the meshlet may be visible from the position, i.e. it's not entirely backfacing.
+    bool IsFrontFacing(const Vector3& viewPosition) const
+    {
+        const Vector3 offset = boundingSphere_.center_ - viewPosition;
+        return offset.DotProduct(coneAxis_) < coneCutoff_ * offset.Length() + boundingSphere_.radius_;
+    }
+};
+
+/// Reorder triangles of the geometry so each consecutive range of maxTriangles triangles is spatially coherent.
+/// The last meshlet may contain fewer triangles. Non-list triangle geometries are converted to triangle lists.
+/// Return meshlets with bounds and normal cones. Geometries other than triangle ones are not changed.
+URHO3D_API ea::vector<Meshlet> BuildMeshlets(GeometryLODView& lodView, unsigned maxTriangles = DEFAULT_MESHLET_TRIANGLES);
+/// Calculate meshlets of triangle list geometry split into ranges of maxTriangles triangles.
+/// Geometry should have raw vertex and index data with positions. Return empty array on failure.
+URHO3D_API ea::vector<Meshlet> CalculateMeshlets(const Geometry* geometry, unsigned maxTriangles = DEFAULT_MESHLET_TRIANGLES);
+/// Append draw arguments of meshlets that are inside the frustum and not backfacing from the view position.
+/// Adjacent visible meshlets are merged into single draw. Frustum and view position are in geometry space.
+/// Return number of visible meshlets.
+URHO3D_API unsigned CullMeshlets(ea::vector<IndirectDrawIndexedArgs>& drawArgs, const Meshlet meshlets[], unsigned count,
+    const Frustum& frustum, const Vector3& viewPosition, unsigned instanceCount = 1);
+
+}
@@ -25,8 +25,10 @@
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
 #include "../Graphics/Geometry.h"
+#include "../Graphics/GeometryBufferPool.h"
 #include "../Graphics/IndexBuffer.h"
 #include "../Graphics/Model.h"
+#include "../Graphics/ModelStreamer.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/VertexBuffer.h"
 #include "../IO/Log.h"
@@ -92,10 +94,17 @@ bool Model::BeginLoad(Deserializer& source)
     morphs_.clear();
     vertexBuffers_.clear();
     indexBuffers_.clear();
+    animationData_ = nullptr;
 
     unsigned memoryUse = sizeof(Model);
     bool async = GetAsyncLoadState() == ASYNC_LOADING;
 
+    // When LOD levels may be streamed, buffer data is read after geometries are known
+    lodStreaming_ = nullptr;
+    ea::unique_ptr<LodStreamingState> lodStreaming;
+    if (GetSubsystem<ModelStreamer>())
+        lodStreaming = ea::make_unique<LodStreamingState>();
+
     // Read vertex buffers
     unsigned numVertexBuffers = source.ReadUInt();
     vertexBuffers_.reserve(numVertexBuffers);
@@ -134,7 +143,13 @@ bool Model::BeginLoad(Deserializer& source)
         desc.dataSize_ = desc.vertexCount_ * vertexSize;
 
         // Prepare vertex buffer data to be uploaded during EndLoad()
-        if (async)
+        if (lodStreaming)
+        {
+            desc.data_.reset();
+            lodStreaming->vertexBufferOffsets_.push_back(source.GetPosition());
+            source.Seek(source.GetPosition() + desc.dataSize_);
+        }
+        else if (async)
         {
             desc.data_ = new unsigned char[desc.dataSize_];
             source.Read(desc.data_.get(), desc.dataSize_);
@@ -166,7 +181,16 @@ bool Model::BeginLoad(Deserializer& source)
         SharedPtr<IndexBuffer> buffer(MakeShared<IndexBuffer>(context_));
 
         // Prepare index buffer data to be uploaded during EndLoad()
-        if (async)
+        if (lodStreaming)
+        {
+            loadIBData_[i].indexCount_ = indexCount;
+            loadIBData_[i].indexSize_ = indexSize;
+            loadIBData_[i].dataSize_ = indexCount * indexSize;
+            loadIBData_[i].data_.reset();
+            lodStreaming->indexBufferOffsets_.push_back(source.GetPosition());
+            source.Seek(source.GetPosition() + loadIBData_[i].dataSize_);
+        }
+        else if (async)
         {
             loadIBData_[i].indexCount_ = indexCount;
             loadIBData_[i].indexSize_ = indexSize;
@@ -310,6 +334,53 @@ bool Model::BeginLoad(Deserializer& source)
         geometryCenters_.push_back(Vector3::ZERO);
     memoryUse += sizeof(Vector3) * geometries_.size();
 
+    // Read buffer data that should be resident
+    if (lodStreaming)
+    {
+        lodStreaming_ = ea::move(lodStreaming);
+        lodStreaming_->vertexBuffers_ = loadVBData_;
+        lodStreaming_->indexBuffers_ = loadIBData_;
+        lodStreaming_->geometries_ = loadGeometries_;
+        if (IsLodStreamable())
+            InitializeLodStreaming();
+        else
+        {
+            lodStreaming_->vertexBuffersPinned_.resize(vertexBuffers_.size(), true);
+            lodStreaming_->indexBuffersPinned_.resize(indexBuffers_.size(), true);
+        }
+
+        for (unsigned i = 0; i < vertexBuffers_.size(); ++i)
+        {
+            VertexBufferDesc& desc = loadVBData_[i];
+            if (!lodStreaming_->vertexBuffersPinned_[i])
+            {
+                memoryUse -= desc.dataSize_;
+                continue;
+            }
+
+            desc.data_ = new unsigned char[desc.dataSize_];
+            source.Seek(lodStreaming_->vertexBufferOffsets_[i]);
+            source.Read(desc.data_.get(), desc.dataSize_);
+        }
+
+        for (unsigned i = 0; i < indexBuffers_.size(); ++i)
+        {
+            IndexBufferDesc& desc = loadIBData_[i];
+            if (!lodStreaming_->indexBuffersPinned_[i])
+            {
+                memoryUse -= desc.dataSize_;
+                continue;
+            }
+
+            desc.data_ = new unsigned char[desc.dataSize_];
+            source.Seek(lodStreaming_->indexBufferOffsets_[i]);
+            source.Read(desc.data_.get(), desc.dataSize_);
+        }
+
+        if (!IsLodStreamable())
+            lodStreaming_ = nullptr;
+    }
+
     // Read metadata
     auto* cache = GetSubsystem<ResourceCache>();
     ea::string xmlName = ReplaceExtension(GetName(), ".xml");
@@ -323,12 +394,23 @@ bool Model::BeginLoad(Deserializer& source)
 
 bool Model::EndLoad()
 {
+    // Pooled models keep CPU-only copies of their buffers and are drawn from shared GPU buffers
+    GeometryBufferPool* bufferPool = IsBufferPoolable() ? GetSubsystem<GeometryBufferPool>() : nullptr;
+
     // Upload vertex buffer data
     for (unsigned i = 0; i < vertexBuffers_.size(); ++i)
     {
         VertexBuffer* buffer = vertexBuffers_[i];
         VertexBufferDesc& desc = loadVBData_[i];
-        if (desc.data_)
+        if (bufferPool)
+        {
+            auto headlessBuffer = MakeShared<VertexBuffer>(context_, true);
+            headlessBuffer->SetShadowed(true);
+            headlessBuffer->SetSize(desc.vertexCount_, desc.vertexElements_);
+            headlessBuffer->SetData(desc.data_ ? desc.data_.get() : buffer->GetShadowData());
+            vertexBuffers_[i] = headlessBuffer;
+        }
+        else if (desc.data_)
         {
             buffer->SetShadowed(true);
             buffer->SetSize(desc.vertexCount_, desc.vertexElements_);
@@ -341,7 +423,15 @@ bool Model::EndLoad()
     {
         IndexBuffer* buffer = indexBuffers_[i];
         IndexBufferDesc& desc = loadIBData_[i];
-        if (desc.data_)
+        if (bufferPool)
+        {
+            auto headlessBuffer = MakeShared<IndexBuffer>(context_, true);
+            headlessBuffer->SetShadowed(true);
+            headlessBuffer->SetSize(desc.indexCount_, desc.indexSize_ > sizeof(unsigned short));
+            headlessBuffer->SetData(desc.data_ ? desc.data_.get() : buffer->GetShadowData());
+            indexBuffers_[i] = headlessBuffer;
+        }
+        else if (desc.data_)
         {
             buffer->SetShadowed(true);
             buffer->SetSize(desc.indexCount_, desc.indexSize_ > sizeof(unsigned short));
@@ -349,27 +439,54 @@ bool Model::EndLoad()
         }
     }
 
-    // Set up geometries
+    // Set up geometries. Streamed LOD levels stay empty until loaded
     for (unsigned i = 0; i < geometries_.size(); ++i)
     {
         for (unsigned j = 0; j < geometries_[i].size(); ++j)
         {
-            Geometry* geometry = geometries_[i][j];
-            GeometryDesc& desc = loadGeometries_[i][j];
-            geometry->SetVertexBuffer(0, vertexBuffers_[desc.vbRef_]);
-            geometry->SetIndexBuffer(indexBuffers_[desc.ibRef_]);
-            geometry->SetDrawRange(desc.type_, desc.indexStart_, desc.indexCount_);
+            if (IsLodResident(i, j))
+                DefineGeometry(i, j, loadGeometries_[i][j]);
+        }
+    }
+
+    if (bufferPool)
+    {
+        for (const auto& lodLevels : geometries_)
+        {
+            for (Geometry* geometry : lodLevels)
+                geometry->MoveToBufferPool(bufferPool);
         }
     }
 
     loadVBData_.clear();
     loadIBData_.clear();
     loadGeometries_.clear();
+
+    if (lodStreaming_)
+    {
+        if (auto modelStreamer = GetSubsystem<ModelStreamer>())
+            modelStreamer->AddModel(this);
+    }
     return true;
 }
 
 bool Model::Save(Serializer& dest) const
 {
+    if (lodStreaming_)
+    {
+        for (unsigned i = 0; i < geometries_.size(); ++i)
+        {
+            for (unsigned j = 0; j < geometries_[i].size(); ++j)
+            {
+                if (!IsLodResident(i, j))
+                {
+                    URHO3D_LOGERROR("Cannot save model {} with streamed LOD levels that are not resident", GetName());
+                    return false;
+                }
+            }
+        }
+    }
+
     // Write ID
     if (!dest.WriteFileID("UMD3"))
         return false;
@@ -511,6 +628,7 @@ bool Model::SetVertexBuffers(const ea::vector<SharedPtr<VertexBuffer> >& buffers
     }
 
     vertexBuffers_ = buffers;
+    animationData_ = nullptr;
     morphRangeStarts_.resize(buffers.size());
     morphRangeCounts_.resize(buffers.size());
 
@@ -617,10 +735,14 @@ void Model::SetGeometryBoneMappings(const ea::vector<ea::vector<unsigned> >& geo
 void Model::SetMorphs(const ea::vector<ModelMorph>& morphs)
 {
     morphs_ = morphs;
+    animationData_ = nullptr;
 }
 
 SharedPtr<Model> Model::Clone(const ea::string& cloneName) const
 {
+    if (lodStreaming_)
+        URHO3D_LOGWARNING("Model {} has streamed LOD levels, only resident LOD levels are cloned", GetName());
+
     SharedPtr<Model> ret(MakeShared<Model>(context_));
 
     ret->SetName(cloneName);
@@ -786,4 +908,249 @@ unsigned Model::GetMorphRangeCount(unsigned bufferIndex) const
     return bufferIndex < vertexBuffers_.size() ? morphRangeCounts_[bufferIndex] : 0;
 }
 
+bool Model::IsLodResident(unsigned index, unsigned lodLevel) const
+{
+    if (!lodStreaming_)
+        return true;
+
+    if (index >= lodStreaming_->lodOffsets_.size() || lodLevel >= geometries_[index].size())
+        return false;
+    return lodStreaming_->lodResident_[lodStreaming_->lodOffsets_[index] + lodLevel];
+}
+
+void Model::RequestLod(unsigned index, unsigned lodLevel, unsigned frameNumber)
+{
+    if (!lodStreaming_ || index >= lodStreaming_->lodOffsets_.size() || lodLevel >= geometries_[index].size())
+        return;
+
+    std::atomic<unsigned>& requestFrame = lodStreaming_->lodRequestFrames_[lodStreaming_->lodOffsets_[index] + lodLevel];
+    if (requestFrame.load(std::memory_order_relaxed) != frameNumber)
+        requestFrame.store(frameNumber, std::memory_order_relaxed);
+}
+
+unsigned Model::GetLodRequestFrame(unsigned index, unsigned lodLevel) const
+{
+    if (!lodStreaming_ || index >= lodStreaming_->lodOffsets_.size() || lodLevel >= geometries_[index].size())
+        return 0;
+
+    return lodStreaming_->lodRequestFrames_[lodStreaming_->lodOffsets_[index] + lodLevel].load(std::memory_order_relaxed);
+}
+
+unsigned Model::GetLodMemoryUse(unsigned index, unsigned lodLevel) const
+{
+    if (!lodStreaming_ || index >= lodStreaming_->geometries_.size() || lodLevel >= lodStreaming_->geometries_[index].size())
+        return 0;
+
+    const GeometryDesc& desc = lodStreaming_->geometries_[index][lodLevel];
+    unsigned memoryUse = 0;
+    if (!lodStreaming_->vertexBuffersPinned_[desc.vbRef_])
+        memoryUse += lodStreaming_->vertexBuffers_[desc.vbRef_].dataSize_;
+    if (!lodStreaming_->indexBuffersPinned_[desc.ibRef_])
+        memoryUse += lodStreaming_->indexBuffers_[desc.ibRef_].dataSize_;
+    return memoryUse;
+}
+
+bool Model::IsLodPinned(unsigned index, unsigned lodLevel) const
+{
+    if (!lodStreaming_)
+        return true;
+
+    return GetLodMemoryUse(index, lodLevel) == 0;
+}
+
+bool Model::ReadLodData(Deserializer& source, ModelLodData& data) const
+{
+    if (!lodStreaming_ || data.geometryIndex_ >= lodStreaming_->geometries_.size()
+        || data.lodLevel_ >= lodStreaming_->geometries_[data.geometryIndex_].size())
+        return false;
+
+    const GeometryDesc& desc = lodStreaming_->geometries_[data.geometryIndex_][data.lodLevel_];
+
+    const unsigned vertexDataSize = lodStreaming_->vertexBuffers_[desc.vbRef_].dataSize_;
+    data.vertexData_.first = desc.vbRef_;
+    data.vertexData_.second = nullptr;
+    if (!lodStreaming_->vertexBuffersPinned_[desc.vbRef_])
+    {
+        data.vertexData_.second = new unsigned char[vertexDataSize];
+        source.Seek(lodStreaming_->vertexBufferOffsets_[desc.vbRef_]);
+        if (source.Read(data.vertexData_.second.get(), vertexDataSize) != vertexDataSize)
+            return false;
+    }
+
+    const unsigned indexDataSize = lodStreaming_->indexBuffers_[desc.ibRef_].dataSize_;
+    data.indexData_.first = desc.ibRef_;
+    data.indexData_.second = nullptr;
+    if (!lodStreaming_->indexBuffersPinned_[desc.ibRef_])
+    {
+        data.indexData_.second = new unsigned char[indexDataSize];
+        source.Seek(lodStreaming_->indexBufferOffsets_[desc.ibRef_]);
+        if (source.Read(data.indexData_.second.get(), indexDataSize) != indexDataSize)
+            return false;
+    }
+
+    return true;
+}
+
+void Model::ApplyLodData(const ModelLodData& data)
+{
+    if (!lodStreaming_)
+        return;
+
+    const unsigned vbRef = data.vertexData_.first;
+    if (data.vertexData_.second && vbRef < vertexBuffers_.size() && !lodStreaming_->vertexBuffersResident_[vbRef])
+    {
+        const VertexBufferDesc& desc = lodStreaming_->vertexBuffers_[vbRef];
+        VertexBuffer* buffer = vertexBuffers_[vbRef];
+        buffer->SetShadowed(true);
+        buffer->SetSize(desc.vertexCount_, desc.vertexElements_);
+        buffer->SetData(data.vertexData_.second.get());
+        lodStreaming_->vertexBuffersResident_[vbRef] = true;
+        SetMemoryUse(GetMemoryUse() + desc.dataSize_);
+    }
+
+    const unsigned ibRef = data.indexData_.first;
+    if (data.indexData_.second && ibRef < indexBuffers_.size() && !lodStreaming_->indexBuffersResident_[ibRef])
+    {
+        const IndexBufferDesc& desc = lodStreaming_->indexBuffers_[ibRef];
+        IndexBuffer* buffer = indexBuffers_[ibRef];
+        buffer->SetShadowed(true);
+        buffer->SetSize(desc.indexCount_, desc.indexSize_ > sizeof(unsigned short));
+        buffer->SetData(data.indexData_.second.get());
+        lodStreaming_->indexBuffersResident_[ibRef] = true;
+        SetMemoryUse(GetMemoryUse() + desc.dataSize_);
+    }
+
+    // Buffers may be shared, so other LOD levels may become resident too
+    for (unsigned i = 0; i < geometries_.size(); ++i)
+    {
+        for (unsigned j = 0; j < geometries_[i].size(); ++j)
+        {
+            const unsigned lodIndex = lodStreaming_->lodOffsets_[i] + j;
+            const GeometryDesc& desc = lodStreaming_->geometries_[i][j];
+            if (!lodStreaming_->lodResident_[lodIndex] && lodStreaming_->vertexBuffersResident_[desc.vbRef_]
+                && lodStreaming_->indexBuffersResident_[desc.ibRef_])
+            {
+                DefineGeometry(i, j, desc);
+                lodStreaming_->lodResident_[lodIndex] = true;
+            }
+        }
+    }
+
+    ++lodStreaming_->version_;
+}
+
+void Model::UnloadLod(unsigned index, unsigned lodLevel)
+{
+    if (!IsLodResident(index, lodLevel) || IsLodPinned(index, lodLevel))
+        return;
+
+    const GeometryDesc& desc = lodStreaming_->geometries_[index][lodLevel];
+    lodStreaming_->lodResident_[lodStreaming_->lodOffsets_[index] + lodLevel] = false;
+
+    Geometry* geometry = geometries_[index][lodLevel];
+    geometry->SetVertexBuffer(0, nullptr);
+    geometry->SetIndexBuffer(nullptr);
+    geometry->SetDrawRange(desc.type_, 0, 0, 0, 0, false);
+
+    // Release buffers that are not used by any other resident LOD level
+    bool vertexBufferUsed = lodStreaming_->vertexBuffersPinned_[desc.vbRef_];
+    bool indexBufferUsed = lodStreaming_->indexBuffersPinned_[desc.ibRef_];
+    for (unsigned i = 0; i < geometries_.size(); ++i)
+    {
+        for (unsigned j = 0; j < geometries_[i].size(); ++j)
+        {
+            if (!lodStreaming_->lodResident_[lodStreaming_->lodOffsets_[i] + j])
+                continue;
+
+            const GeometryDesc& otherDesc = lodStreaming_->geometries_[i][j];
+            vertexBufferUsed = vertexBufferUsed || otherDesc.vbRef_ == desc.vbRef_;
+            indexBufferUsed = indexBufferUsed || otherDesc.ibRef_ == desc.ibRef_;
+        }
+    }
+
+    if (!vertexBufferUsed)
+    {
+        vertexBuffers_[desc.vbRef_] = MakeShared<VertexBuffer>(context_);
+        lodStreaming_->vertexBuffersResident_[desc.vbRef_] = false;
+        SetMemoryUse(GetMemoryUse() - lodStreaming_->vertexBuffers_[desc.vbRef_].dataSize_);
+    }
+
+    if (!indexBufferUsed)
+    {
+        indexBuffers_[desc.ibRef_] = MakeShared<IndexBuffer>(context_);
+        lodStreaming_->indexBuffersResident_[desc.ibRef_] = false;
+        SetMemoryUse(GetMemoryUse() - lodStreaming_->indexBuffers_[desc.ibRef_].dataSize_);
+    }
+
+    // Other LOD levels that used released buffers are already not resident
+    ++lodStreaming_->version_;
+}
+
+bool Model::IsLodStreamable() const
+{
+    // Morphs and skinning need all vertex data of all LOD levels
+    if (!morphs_.empty() || skeleton_.GetNumBones() > 0)
+        return false;
+
+    for (const auto& lodLevels : geometries_)
+    {
+        if (lodLevels.size() > 1)
+            return true;
+    }
+    return false;
+}
+
+bool Model::IsBufferPoolable() const
+{
+    if (!Graphics::GetCaps().baseVertexIndexSupported_)
+        return false;
+
+    // Morphs and skinning modify or read source vertex buffers on GPU, streamed LOD levels own their buffers
+    return morphs_.empty() && skeleton_.GetNumBones() == 0 && !lodStreaming_;
+}
+
+void Model::InitializeLodStreaming()
+{
+    LodStreamingState& state = *lodStreaming_;
+
+    // Coarsest LOD levels are always resident
+    state.vertexBuffersPinned_.clear();
+    state.indexBuffersPinned_.clear();
+    state.vertexBuffersPinned_.resize(vertexBuffers_.size(), false);
+    state.indexBuffersPinned_.resize(indexBuffers_.size(), false);
+    for (const ea::vector<GeometryDesc>& lodLevels : state.geometries_)
+    {
+        if (!lodLevels.empty())
+        {
+            state.vertexBuffersPinned_[lodLevels.back().vbRef_] = true;
+            state.indexBuffersPinned_[lodLevels.back().ibRef_] = true;
+        }
+    }
+    state.vertexBuffersResident_ = state.vertexBuffersPinned_;
+    state.indexBuffersResident_ = state.indexBuffersPinned_;
+
+    unsigned numLods = 0;
+    state.lodOffsets_.clear();
+    state.lodResident_.clear();
+    for (const ea::vector<GeometryDesc>& lodLevels : state.geometries_)
+    {
+        state.lodOffsets_.push_back(numLods);
+        numLods += lodLevels.size();
+        for (const GeometryDesc& desc : lodLevels)
+            state.lodResident_.push_back(state.vertexBuffersResident_[desc.vbRef_] && state.indexBuffersResident_[desc.ibRef_]);
+    }
+
+    state.lodRequestFrames_ = ea::make_unique<std::atomic<unsigned>[]>(numLods);
+    for (unsigned i = 0; i < numLods; ++i)
+        state.lodRequestFrames_[i].store(0, std::memory_order_relaxed);
+}
+
+void Model::DefineGeometry(unsigned index, unsigned lodLevel, const GeometryDesc& desc)
+{
+    Geometry* geometry = geometries_[index][lodLevel];
+    geometry->SetVertexBuffer(0, vertexBuffers_[desc.vbRef_]);
+    geometry->SetIndexBuffer(indexBuffers_[desc.ibRef_]);
+    geometry->SetDrawRange(desc.type_, desc.indexStart_, desc.indexCount_);
+}
+
 }
@@ -23,6 +23,9 @@
 #pragma once
 
 #include <EASTL/shared_array.h>
+#include <EASTL/unique_ptr.h>
+
+#include <atomic>
 
 #include "../Container/Ptr.h"
 #include "../Graphics/GraphicsDefs.h"
@@ -105,6 +108,19 @@ struct GeometryDesc
     unsigned indexCount_;
 };
 
+/// Vertex and index buffer data of a streamed model LOD level.
+struct ModelLodData
+{
+    /// Geometry index.
+    unsigned geometryIndex_{};
+    /// LOD level.
+    unsigned lodLevel_{};
+    /// Vertex buffer index and data.
+    ea::pair<unsigned, ea::shared_array<unsigned char>> vertexData_;
+    /// Index buffer index and data.
+    ea::pair<unsigned, ea::shared_array<unsigned char>> indexData_;
+};
+
 /// 3D model resource.
 class URHO3D_API Model : public ResourceWithMetadata
 {
@@ -222,6 +238,32 @@ public:
     /// Return morph range vertex counts for each vertex buffer.
     const ea::vector<unsigned>& GetMorphRangeCounts() const { return morphRangeCounts_; }
 
+    /// Return whether LOD levels of the model are streamed. Only the coarsest LOD levels are always resident then.
+    bool IsLodStreamed() const { return lodStreaming_ != nullptr; }
+    /// Return whether geometry LOD level is resident. Always true if LOD levels are not streamed.
+    bool IsLodResident(unsigned index, unsigned lodLevel) const;
+    /// Request streaming of geometry LOD level and mark it as used. Thread-safe.
+    void RequestLod(unsigned index, unsigned lodLevel, unsigned frameNumber);
+    /// Return last frame when geometry LOD level was requested.
+    unsigned GetLodRequestFrame(unsigned index, unsigned lodLevel) const;
+    /// Return memory used by geometry LOD level buffers that can be unloaded.
+    unsigned GetLodMemoryUse(unsigned index, unsigned lodLevel) const;
+    /// Return whether geometry LOD level is never unloaded.
+    bool IsLodPinned(unsigned index, unsigned lodLevel) const;
+    /// Return version of LOD residency, incremented whenever LOD levels are loaded or unloaded.
+    unsigned GetLodResidencyVersion() const { return lodStreaming_ ? lodStreaming_->version_ : 0; }
+    /// Read buffer data of geometry LOD level from model file. Thread-safe. Return true if successful.
+    bool ReadLodData(Deserializer& source, ModelLodData& data) const;
+    /// Upload buffer data of geometry LOD level and make it resident.
+    void ApplyLodData(const ModelLodData& data);
+    /// Unload buffers of a geometry LOD level that are not used by other resident LOD levels.
+    void UnloadLod(unsigned index, unsigned lodLevel);
+
+    /// Set GPU animation data shared by all animated instances of the model. Reset when vertex data changes.
+    void SetAnimationData(RefCounted* data) { animationData_ = data; }
+    /// Return GPU animation data shared by all animated instances of the model.
+    RefCounted* GetAnimationData() const { return animationData_; }
+
 private:
     /// Class versions (used for serialization)
     /// @{
@@ -257,6 +299,51 @@ private:
     ea::vector<IndexBufferDesc> loadIBData_;
     /// Geometry definitions for asynchronous loading.
     ea::vector<ea::vector<GeometryDesc> > loadGeometries_;
+    /// GPU animation data shared by all animated instances.
+    SharedPtr<RefCounted> animationData_;
+
+    /// State of LOD streaming.
+    struct LodStreamingState
+    {
+        /// Offsets of vertex buffer data in the model file.
+        ea::vector<unsigned> vertexBufferOffsets_;
+        /// Offsets of index buffer data in the model file.
+        ea::vector<unsigned> indexBufferOffsets_;
+        /// Vertex buffer descriptions.
+        ea::vector<VertexBufferDesc> vertexBuffers_;
+        /// Index buffer descriptions.
+        ea::vector<IndexBufferDesc> indexBuffers_;
+        /// Geometry descriptions.
+        ea::vector<ea::vector<GeometryDesc>> geometries_;
+        /// Whether vertex buffer is used by coarsest LOD level and is never unloaded.
+        ea::vector<bool> vertexBuffersPinned_;
+        /// Whether index buffer is used by coarsest LOD level and is never unloaded.
+        ea::vector<bool> indexBuffersPinned_;
+        /// Whether vertex buffer is resident.
+        ea::vector<bool> vertexBuffersResident_;
+        /// Whether index buffer is resident.
+        ea::vector<bool> indexBuffersResident_;
+        /// Index of the first LOD level of each geometry in per-LOD arrays.
+        ea::vector<unsigned> lodOffsets_;
+        /// Whether LOD level is resident.
+        ea::vector<bool> lodResident_;
+        /// Last frame when LOD level was requested.
+        ea::unique_ptr<std::atomic<unsigned>[]> lodRequestFrames_;
+        /// Residency version.
+        unsigned version_{};
+    };
+
+    /// Return whether the model can be streamed.
+    bool IsLodStreamable() const;
+    /// Return whether the model can be drawn from GeometryBufferPool.
+    bool IsBufferPoolable() const;
+    /// Initialize residency of buffers and LOD levels for streaming.
+    void InitializeLodStreaming();
+    /// Define the geometry from its description.
+    void DefineGeometry(unsigned index, unsigned lodLevel, const GeometryDesc& desc);
+
+    /// LOD streaming state, if enabled.
+    ea::unique_ptr<LodStreamingState> lodStreaming_;
 };
 
 }
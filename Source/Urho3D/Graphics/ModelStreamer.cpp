@@ -0,0 +1,229 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/CoreEvents.h"
+#include "../Core/Profiler.h"
+#include "../Core/Timer.h"
+#include "../Core/WorkQueue.h"
+#include "../Graphics/Model.h"
+#include "../Graphics/ModelStreamer.h"
+#include "../IO/Log.h"
+#include "../Resource/ResourceCache.h"
+
+#include <EASTL/sort.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+ModelStreamer::ModelStreamer(Context* context)
+    : Object(context)
+{
+    SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(ModelStreamer, HandleEndFrame));
+}
+
+ModelStreamer::~ModelStreamer()
+{
+    // Pending loads access the resource cache, wait for them
+    auto workQueue = GetSubsystem<WorkQueue>();
+    for (const auto& pendingLoad : pendingLoads_)
+    {
+        if (pendingLoad->task_ && workQueue)
+            workQueue->WaitForTask(pendingLoad->task_);
+    }
+}
+
+void ModelStreamer::AddModel(Model* model)
+{
+    // Only models that can be reloaded from file are streamed
+    if (!model || !model->IsLodStreamed() || model->GetName().empty())
+        return;
+
+    // Data being loaded for the previous version of the model cannot be used
+    for (const auto& pendingLoad : pendingLoads_)
+    {
+        if (pendingLoad->model_ == model)
+            pendingLoad->discarded_ = true;
+    }
+
+    if (!models_.contains(WeakPtr<Model>(model)))
+        models_.emplace_back(model);
+}
+
+void ModelStreamer::Update()
+{
+    URHO3D_PROFILE("UpdateModelStreaming");
+
+    auto time = GetSubsystem<Time>();
+    const unsigned frameNumber = time ? time->GetFrameNumber() : 0;
+
+    // Remove destroyed models. Pending loads keep their models alive.
+    ea::erase_if(models_, [](const WeakPtr<Model>& model) { return !model || !model->IsLodStreamed(); });
+
+    // Finish completed loads
+    for (const auto& pendingLoad : pendingLoads_)
+    {
+        if (pendingLoad->task_->IsCompleted())
+            FinishLoad(*pendingLoad);
+    }
+    ea::erase_if(pendingLoads_, [](const ea::unique_ptr<PendingLoad>& pendingLoad) { return !pendingLoad->task_; });
+
+    // Gather LOD levels that can be unloaded and LOD levels requested in the last frame
+    ea::vector<LodReference> residentLods;
+    ea::vector<LodReference> requestedLods;
+    unsigned long long memoryUse = 0;
+    for (Model* model : models_)
+    {
+        const unsigned numGeometries = model->GetNumGeometries();
+        for (unsigned i = 0; i < numGeometries; ++i)
+        {
+            const unsigned numLodLevels = model->GetNumGeometryLodLevels(i);
+            for (unsigned j = 0; j < numLodLevels; ++j)
+            {
+                if (model->IsLodPinned(i, j))
+                    continue;
+
+                const LodReference lod{model, i, j, model->GetLodRequestFrame(i, j), model->GetLodMemoryUse(i, j)};
+                if (model->IsLodResident(i, j))
+                {
+                    residentLods.push_back(lod);
+                    memoryUse += lod.memoryUse_;
+                }
+                else if (lod.requestFrame_ != 0 && lod.requestFrame_ + 1 >= frameNumber && !IsLoading(model, i, j))
+                    requestedLods.push_back(lod);
+            }
+        }
+    }
+
+    // Most recently requested LOD levels are loaded first, finer LOD levels first within the same frame
+    ea::sort(requestedLods.begin(), requestedLods.end(), [](const LodReference& lhs, const LodReference& rhs)
+    {
+        if (lhs.requestFrame_ != rhs.requestFrame_)
+            return lhs.requestFrame_ > rhs.requestFrame_;
+        return lhs.lodLevel_ < rhs.lodLevel_;
+    });
+
+    // Least recently requested LOD levels are unloaded first
+    ea::sort(residentLods.begin(), residentLods.end(),
+        [](const LodReference& lhs, const LodReference& rhs) { return lhs.requestFrame_ < rhs.requestFrame_; });
+
+    // Unload LOD levels that were not used recently while over the budget
+    unsigned numUnloaded = 0;
+    const auto unloadUnused = [&](unsigned long long targetMemoryUse)
+    {
+        while (memoryUse > targetMemoryUse && numUnloaded < residentLods.size())
+        {
+            const LodReference& lod = residentLods[numUnloaded];
+            if (lod.requestFrame_ + 1 >= frameNumber)
+                return false;
+
+            lod.model_->UnloadLod(lod.index_, lod.lodLevel_);
+            memoryUse -= Min<unsigned long long>(memoryUse, lod.memoryUse_);
+            ++numUnloaded;
+        }
+        return memoryUse <= targetMemoryUse;
+    };
+    unloadUnused(memoryBudget_);
+
+    // Start new loads if they fit into the budget
+    unsigned long long pendingMemoryUse = 0;
+    for (const LodReference& lod : requestedLods)
+    {
+        if (pendingLoads_.size() >= maxPendingLoads_)
+            break;
+
+        const unsigned long long requiredMemoryUse = pendingMemoryUse + lod.memoryUse_;
+        if (requiredMemoryUse > memoryBudget_ || !unloadUnused(memoryBudget_ - requiredMemoryUse))
+            continue;
+
+        pendingMemoryUse = requiredMemoryUse;
+        StartLoad(lod.model_, lod.index_, lod.lodLevel_);
+    }
+
+    memoryUse_ = memoryUse;
+}
+
+bool ModelStreamer::IsLoading(Model* model, unsigned index, unsigned lodLevel) const
+{
+    return ea::any_of(pendingLoads_.begin(), pendingLoads_.end(), [&](const ea::unique_ptr<PendingLoad>& pendingLoad)
+    {
+        return pendingLoad->model_ == model && pendingLoad->data_->geometryIndex_ == index
+            && pendingLoad->data_->lodLevel_ == lodLevel;
+    });
+}
+
+void ModelStreamer::StartLoad(Model* model, unsigned index, unsigned lodLevel)
+{
+    auto cache = GetSubsystem<ResourceCache>();
+    auto workQueue = GetSubsystem<WorkQueue>();
+
+    pendingLoads_.push_back(ea::make_unique<PendingLoad>());
+    PendingLoad& pendingLoad = *pendingLoads_.back();
+    pendingLoad.model_ = model;
+    pendingLoad.data_ = ea::make_unique<ModelLodData>();
+    pendingLoad.data_->geometryIndex_ = index;
+    pendingLoad.data_->lodLevel_ = lodLevel;
+
+    const auto loadData = [cache, &pendingLoad](unsigned)
+    {
+        AbstractFilePtr file = cache->GetFile(pendingLoad.model_->GetName(), false);
+        pendingLoad.success_ = file && pendingLoad.model_->ReadLodData(*file, *pendingLoad.data_);
+    };
+
+    if (workQueue && workQueue->GetNumThreads() > 0)
+        pendingLoad.task_ = workQueue->PostTask(loadData);
+    else
+    {
+        loadData(0);
+        FinishLoad(pendingLoad);
+        pendingLoads_.pop_back();
+    }
+}
+
+void ModelStreamer::FinishLoad(PendingLoad& pendingLoad)
+{
+    pendingLoad.task_ = nullptr;
+    if (pendingLoad.discarded_)
+        return;
+
+    if (!pendingLoad.success_)
+    {
+        URHO3D_LOGWARNING("Failed to stream LOD level {} of geometry {} of model {}", pendingLoad.data_->lodLevel_,
+            pendingLoad.data_->geometryIndex_, pendingLoad.model_->GetName());
+        // Do not retry until the model is reloaded
+        models_.erase_first(WeakPtr<Model>(pendingLoad.model_));
+        return;
+    }
+
+    pendingLoad.model_->ApplyLodData(*pendingLoad.data_);
+}
+
+void ModelStreamer::HandleEndFrame(StringHash eventType, VariantMap& eventData)
+{
+    Update();
+}
+
+}
@@ -0,0 +1,128 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Core/Object.h"
+
+#include <EASTL/unique_ptr.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class Model;
+class WorkTask;
+struct ModelLodData;
+
+/// Streams LOD levels of models loaded from files within the GPU memory budget.
+/// Models are loaded with the coarsest LOD levels only. Finer LOD levels are loaded
+/// when requested by visible drawables and unloaded when the budget is exceeded, least recently used first.
+/// Models with vertex morphs or skeletons are not streamed.
+/// Register as subsystem to enable streaming for models loaded afterwards.
+class URHO3D_API ModelStreamer : public Object
+{
+    URHO3D_OBJECT(ModelStreamer, Object);
+
+public:
+    /// Construct.
+    explicit ModelStreamer(Context* context);
+    /// Destruct.
+    ~ModelStreamer() override;
+
+    /// Start streaming of the model. Called after the model is loaded.
+    void AddModel(Model* model);
+    /// Update streaming state and apply loaded LOD levels. Called on the end of the frame.
+    void Update();
+
+    /// Set GPU memory budget in bytes for streamed LOD levels.
+    void SetMemoryBudget(unsigned long long budget) { memoryBudget_ = budget; }
+    /// Set maximum number of LOD levels being loaded at the same time.
+    void SetMaxPendingLoads(unsigned count) { maxPendingLoads_ = Max(count, 1u); }
+
+    /// Return GPU memory budget in bytes.
+    unsigned long long GetMemoryBudget() const { return memoryBudget_; }
+    /// Return maximum number of LOD levels being loaded at the same time.
+    unsigned GetMaxPendingLoads() const { return maxPendingLoads_; }
+
+    /// Return number of streamed models.
+    unsigned GetNumModels() const { return models_.size(); }
+    /// Return GPU memory used by streamed LOD levels, as of last update.
+    unsigned long long GetMemoryUse() const { return memoryUse_; }
+    /// Return number of LOD levels being loaded.
+    unsigned GetNumPendingLoads() const { return pendingLoads_.size(); }
+
+private:
+    /// LOD level being loaded.
+    struct PendingLoad
+    {
+        /// Model.
+        SharedPtr<Model> model_;
+        /// Loaded data.
+        ea::unique_ptr<ModelLodData> data_;
+        /// Whether the data was loaded successfully.
+        bool success_{};
+        /// Whether the model was reloaded and the data is outdated.
+        bool discarded_{};
+        /// Task that loads the data.
+        SharedPtr<WorkTask> task_;
+    };
+
+    /// Reference to streamed LOD level.
+    struct LodReference
+    {
+        /// Model.
+        Model* model_{};
+        /// Geometry index.
+        unsigned index_{};
+        /// LOD level.
+        unsigned lodLevel_{};
+        /// Last frame when LOD level was requested.
+        unsigned requestFrame_{};
+        /// Memory used by LOD level.
+        unsigned memoryUse_{};
+    };
+
+    /// Return whether the LOD level is being loaded.
+    bool IsLoading(Model* model, unsigned index, unsigned lodLevel) const;
+    /// Start loading of the LOD level.
+    void StartLoad(Model* model, unsigned index, unsigned lodLevel);
+    /// Finish loading of the LOD level and upload it to the model.
+    void FinishLoad(PendingLoad& pendingLoad);
+    /// Handle end of frame.
+    void HandleEndFrame(StringHash eventType, VariantMap& eventData);
+
+    /// Streamed models.
+    ea::vector<WeakPtr<Model>> models_;
+    /// LOD levels being loaded.
+    ea::vector<ea::unique_ptr<PendingLoad>> pendingLoads_;
+    /// Memory use.
+    unsigned long long memoryUse_{};
+
+    /// GPU memory budget.
+    unsigned long long memoryBudget_{128 * 1024 * 1024};
+    /// Maximum number of LOD levels being loaded at the same time.
+    unsigned maxPendingLoads_{4};
+};
+
+}
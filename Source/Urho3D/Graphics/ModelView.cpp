@@ -24,6 +24,7 @@
 
 #include "../Graphics/ModelView.h"
 
+#include "../Core/WorkQueue.h"
 #include "../Graphics/Geometry.h"
 #include "../Graphics/IndexBuffer.h"
 #include "../Graphics/Model.h"
@@ -1285,10 +1286,29 @@ BoundingBox ModelView::CalculateBoundingBox() const
     return boundingBox;
 }
 
-void ModelView::Normalize()
+template <class T> void ModelView::ForEachGeometryLOD(const T& callback)
 {
+    ea::vector<GeometryLODView*> lodViews;
     for (GeometryView& geometryView : geometries_)
-        geometryView.Normalize();
+    {
+        for (GeometryLODView& lodView : geometryView.lods_)
+            lodViews.push_back(&lodView);
+    }
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    if (!workQueue || lodViews.size() <= 1)
+    {
+        for (GeometryLODView* lodView : lodViews)
+            callback(*lodView);
+        return;
+    }
+
+    ForEachParallel(workQueue, lodViews, [&](unsigned /*index*/, GeometryLODView* lodView) { callback(*lodView); });
+}
+
+void ModelView::Normalize()
+{
+    ForEachGeometryLOD([](GeometryLODView& lodView) { lodView.Normalize(); });
 
     unsigned numMorphs = 0;
     for (GeometryView& geometryView : geometries_)
@@ -1299,110 +1319,98 @@ void ModelView::Normalize()
 
 void ModelView::MirrorGeometriesX()
 {
-    for (GeometryView& geometryView : geometries_)
+    ForEachGeometryLOD([](GeometryLODView& lodView)
     {
-        for (GeometryLODView& lodView : geometryView.lods_)
+        for (ModelVertex& vertex : lodView.vertices_)
         {
-            for (ModelVertex& vertex : lodView.vertices_)
-            {
-                vertex.position_.x_ = -vertex.position_.x_;
-                vertex.normal_.x_ = -vertex.normal_.x_;
-                vertex.tangent_.x_ = -vertex.tangent_.x_;
-            }
+            vertex.position_.x_ = -vertex.position_.x_;
+            vertex.normal_.x_ = -vertex.normal_.x_;
+            vertex.tangent_.x_ = -vertex.tangent_.x_;
+        }
 
-            for (auto& [morphIndex, morphVector] : lodView.morphs_)
+        for (auto& [morphIndex, morphVector] : lodView.morphs_)
+        {
+            for (ModelVertexMorph& vertexMorph : morphVector)
             {
-                for (ModelVertexMorph& vertexMorph : morphVector)
-                {
-                    vertexMorph.positionDelta_.x_ = -vertexMorph.positionDelta_.x_;
-                    vertexMorph.normalDelta_.x_ = -vertexMorph.normalDelta_.x_;
-                    vertexMorph.tangentDelta_.x_ = -vertexMorph.tangentDelta_.x_;
-                }
+                vertexMorph.positionDelta_.x_ = -vertexMorph.positionDelta_.x_;
+                vertexMorph.normalDelta_.x_ = -vertexMorph.normalDelta_.x_;
+                vertexMorph.tangentDelta_.x_ = -vertexMorph.tangentDelta_.x_;
             }
+        }
 
-            if (lodView.IsTriangleGeometry())
+        if (lodView.IsTriangleGeometry())
+        {
+            const unsigned numPrimitives = lodView.GetNumPrimitives();
+            switch (lodView.primitiveType_)
             {
-                const unsigned numPrimitives = lodView.GetNumPrimitives();
-                switch (lodView.primitiveType_)
-                {
-                case TRIANGLE_LIST:
-                    for (unsigned i = 0; i < numPrimitives; ++i)
-                        ea::swap(lodView.indices_[i * 3 + 1], lodView.indices_[i * 3 + 2]);
-                    break;
-
-                case TRIANGLE_STRIP:
-                    if (numPrimitives > 0 && numPrimitives % 2 == 0)
-                        lodView.indices_.push_back(lodView.indices_.back());
-                    ea::reverse(lodView.indices_.begin(), lodView.indices_.end());
-                    break;
-
-                case TRIANGLE_FAN:
-                    if (numPrimitives >= 1)
-                        ea::reverse(lodView.indices_.begin() + 1, lodView.indices_.end());
-                    break;
-
-                default:
-                    break;
-                }
+            case TRIANGLE_LIST:
+                for (unsigned i = 0; i < numPrimitives; ++i)
+                    ea::swap(lodView.indices_[i * 3 + 1], lodView.indices_[i * 3 + 2]);
+                break;
+
+            case TRIANGLE_STRIP:
+                if (numPrimitives > 0 && numPrimitives % 2 == 0)
+                    lodView.indices_.push_back(lodView.indices_.back());
+                ea::reverse(lodView.indices_.begin(), lodView.indices_.end());
+                break;
+
+            case TRIANGLE_FAN:
+                if (numPrimitives >= 1)
+                    ea::reverse(lodView.indices_.begin() + 1, lodView.indices_.end());
+                break;
+
+            default:
+                break;
             }
         }
-    }
+    });
 }
 
 void ModelView::ScaleGeometries(float scale)
 {
-    for (GeometryView& geometryView : geometries_)
+    ForEachGeometryLOD([scale](GeometryLODView& lodView)
     {
-        for (GeometryLODView& lodView : geometryView.lods_)
-        {
-            for (ModelVertex& vertex : lodView.vertices_)
-                vertex.position_ = (scale * vertex.GetPosition()).ToVector4(vertex.position_.w_);
+        for (ModelVertex& vertex : lodView.vertices_)
+            vertex.position_ = (scale * vertex.GetPosition()).ToVector4(vertex.position_.w_);
 
-            for (auto& [morphIndex, morphVector] : lodView.morphs_)
-            {
-                for (ModelVertexMorph& vertexMorph : morphVector)
-                    vertexMorph.positionDelta_ *= scale;
-            }
+        for (auto& [morphIndex, morphVector] : lodView.morphs_)
+        {
+            for (ModelVertexMorph& vertexMorph : morphVector)
+                vertexMorph.positionDelta_ *= scale;
         }
-    }
+    });
 }
 
 void ModelView::CalculateMissingNormals(bool flatNormals)
 {
-    for (GeometryView& geometryView : geometries_)
+    ForEachGeometryLOD([flatNormals](GeometryLODView& lodView)
     {
-        for (GeometryLODView& lodView : geometryView.lods_)
-        {
-            if (!lodView.IsTriangleGeometry())
-                continue;
-            if (lodView.vertexFormat_.normal_ != ModelVertexFormat::Undefined)
-                continue;
-
-            lodView.vertexFormat_.normal_ = TYPE_VECTOR3;
-            lodView.vertexFormat_.tangent_ = ModelVertexFormat::Undefined;
-            if (flatNormals)
-                lodView.RecalculateFlatNormals();
-            else
-                lodView.RecalculateSmoothNormals();
-        }
-    }
+        if (!lodView.IsTriangleGeometry())
+            return;
+        if (lodView.vertexFormat_.normal_ != ModelVertexFormat::Undefined)
+            return;
+
+        lodView.vertexFormat_.normal_ = TYPE_VECTOR3;
+        lodView.vertexFormat_.tangent_ = ModelVertexFormat::Undefined;
+        if (flatNormals)
+            lodView.RecalculateFlatNormals();
+        else
+            lodView.RecalculateSmoothNormals();
+    });
 }
 
 void ModelView::CalculateMissingTangents()
 {
-    for (GeometryView& geometryView : geometries_)
+    ForEachGeometryLOD([](GeometryLODView& lodView)
     {
-        for (GeometryLODView& lodView : geometryView.lods_)
-        {
-            if (!lodView.IsTriangleGeometry())
-                continue;
-            if (lodView.vertexFormat_.tangent_ != ModelVertexFormat::Undefined)
-                continue;
+        if (!lodView.IsTriangleGeometry())
+            return;
+        if (lodView.vertexFormat_.tangent_ != ModelVertexFormat::Undefined)
+            return;
 
-            lodView.vertexFormat_.tangent_ = TYPE_VECTOR4;
-            lodView.RecalculateTangents();
-        }
-    }
+        lodView.vertexFormat_.tangent_ = TYPE_VECTOR4;
+        lodView.RecalculateTangents();
+    });
 }
 
 void ModelView::RepairBoneWeights()
@@ -1410,42 +1418,40 @@ void ModelView::RepairBoneWeights()
     if (bones_.empty())
         return;
 
-    for (GeometryView& geometryView : geometries_)
+    const unsigned numBones = bones_.size();
+    ForEachGeometryLOD([numBones](GeometryLODView& lodView)
     {
-        for (GeometryLODView& lodView : geometryView.lods_)
+        for (ModelVertex& vertex : lodView.vertices_)
         {
-            for (ModelVertex& vertex : lodView.vertices_)
+            // Reset invalid bones
+            for (unsigned i = 0; i < ModelVertex::MaxBones; ++i)
             {
-                // Reset invalid bones
-                for (unsigned i = 0; i < ModelVertex::MaxBones; ++i)
+                const float index = vertex.blendIndices_[i];
+                const float weight = vertex.blendWeights_[i];
+                if (index < 0 || index >= numBones || weight < 0.0f)
                 {
-                    const float index = vertex.blendIndices_[i];
-                    const float weight = vertex.blendWeights_[i];
-                    if (index < 0 || index >= bones_.size() || weight < 0.0f)
-                    {
-                        vertex.blendIndices_[i] = 0;
-                        vertex.blendWeights_[i] = 0.0f;
-                    }
+                    vertex.blendIndices_[i] = 0;
+                    vertex.blendWeights_[i] = 0.0f;
                 }
+            }
 
-                // Skip if okay
-                const float weightSum = vertex.blendWeights_.DotProduct(Vector4::ONE);
-                if (Equals(weightSum, 1.0f))
-                    continue;
-
-                // Revert if degenerate
-                if (weightSum < M_EPSILON)
-                {
-                    vertex.blendIndices_ = Vector4::ZERO;
-                    vertex.blendWeights_ = { 1.0f, 0.0f, 0.0f, 0.0f };
-                    continue;
-                }
+            // Skip if okay
+            const float weightSum = vertex.blendWeights_.DotProduct(Vector4::ONE);
+            if (Equals(weightSum, 1.0f))
+                continue;
 
-                // Normalize otherwise
-                vertex.blendWeights_ /= weightSum;
+            // Revert if degenerate
+            if (weightSum < M_EPSILON)
+            {
+                vertex.blendIndices_ = Vector4::ZERO;
+                vertex.blendWeights_ = { 1.0f, 0.0f, 0.0f, 0.0f };
+                continue;
             }
+
+            // Normalize otherwise
+            vertex.blendWeights_ /= weightSum;
         }
-    }
+    });
 }
 
 void ModelView::RecalculateBoneBoundingBoxes()
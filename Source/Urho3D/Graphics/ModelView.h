@@ -345,6 +345,9 @@ public:
     /// @}
 
 private:
+    /// Process all geometry LODs in parallel if WorkQueue is available. LODs are processed independently.
+    template <class T> void ForEachGeometryLOD(const T& callback);
+
     ea::string name_;
     ea::vector<GeometryView> geometries_;
     ea::vector<BoneView> bones_;
@@ -29,6 +29,10 @@
 #include "../Graphics/OcclusionBuffer.h"
 #include "../IO/Log.h"
 
+#ifdef URHO3D_SSE
+#include <emmintrin.h>
+#endif
+
 #include "../DebugNew.h"
 
 namespace Urho3D
@@ -45,12 +49,34 @@ enum ClipMask : unsigned
 };
 URHO3D_FLAGSET(ClipMask, ClipMaskFlags);
 
-void DrawOcclusionBatchWork(const WorkItem* item, unsigned threadIndex)
+/// Fill span of depth buffer, keeping the closest depth.
+inline void FillSpan(int* dest, int* end, int invZ, int dInvZdX)
 {
-    URHO3D_PROFILE("DrawOcclusionBatchWork");
-    auto* buffer = reinterpret_cast<OcclusionBuffer*>(item->aux_);
-    OcclusionBatch& batch = *reinterpret_cast<OcclusionBatch*>(item->start_);
-    buffer->DrawBatch(batch, threadIndex);
+#ifdef URHO3D_SSE
+    if (end - dest >= 4)
+    {
+        __m128i invZ4 = _mm_add_epi32(_mm_set1_epi32(invZ), _mm_set_epi32(3 * dInvZdX, 2 * dInvZdX, dInvZdX, 0));
+        const __m128i step4 = _mm_set1_epi32(4 * dInvZdX);
+        while (end - dest >= 4)
+        {
+            const __m128i depth = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dest));
+            const __m128i closer = _mm_cmplt_epi32(invZ4, depth);
+            const __m128i result = _mm_or_si128(_mm_and_si128(closer, invZ4), _mm_andnot_si128(closer, depth));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), result);
+            invZ4 = _mm_add_epi32(invZ4, step4);
+            dest += 4;
+        }
+        invZ = _mm_cvtsi128_si32(invZ4);
+    }
+#endif
+
+    while (dest < end)
+    {
+        if (invZ < *dest)
+            *dest = invZ;
+        invZ += dInvZdX;
+        ++dest;
+    }
 }
 
 OcclusionBuffer::OcclusionBuffer(Context* context) :
@@ -72,7 +98,10 @@ bool OcclusionBuffer::SetSize(int width, int height, bool threaded)
         ++height;
 
     if (width == width_ && height == height_)
+    {
+        threaded_ = threaded;
         return true;
+    }
 
     if (width <= 0 || height <= 0)
         return false;
@@ -85,18 +114,11 @@ bool OcclusionBuffer::SetSize(int width, int height, bool threaded)
 
     width_ = width;
     height_ = height;
+    threaded_ = threaded;
 
-    // Build work buffers for threading
-    unsigned numThreadBuffers = threaded ? GetSubsystem<WorkQueue>()->GetNumThreads() + 1 : 1;
-    buffers_.resize(numThreadBuffers);
-    for (unsigned i = 0; i < numThreadBuffers; ++i)
-    {
-        // Reserve extra memory in case 3D clipping is not exact
-        OcclusionBufferData& buffer = buffers_[i];
-        buffer.dataWithSafety_ = new int[width * (height + 2) + 2];
-        buffer.data_ = buffer.dataWithSafety_.get() + width + 1;
-        buffer.used_ = false;
-    }
+    // Reserve extra memory in case 3D clipping is not exact
+    buffer_.dataWithSafety_ = new int[width * (height + 2) + 2];
+    buffer_.data_ = buffer_.dataWithSafety_.get() + width + 1;
 
     mipBuffers_.clear();
 
@@ -113,7 +135,7 @@ bool OcclusionBuffer::SetSize(int width, int height, bool threaded)
     }
 
     URHO3D_LOGDEBUG("Set occlusion buffer size " + ea::to_string(width_) + "x" + ea::to_string(height_) + " with " +
-             ea::to_string(mipBuffers_.size()) + " mip levels and " + ea::to_string(numThreadBuffers) + " thread buffers");
+             ea::to_string(mipBuffers_.size()) + " mip levels" + (threaded_ ? ", threaded" : ""));
 
     CalculateViewport();
     return true;
@@ -160,10 +182,7 @@ void OcclusionBuffer::Clear()
 {
     Reset();
 
-    // Only clear the main thread buffer. Rest are cleared on-demand when drawing the first batch
-    ClearBuffer(0);
-    for (unsigned i = 1; i < buffers_.size(); ++i)
-        buffers_[i].used_ = false;
+    ClearBuffer();
 
     depthHierarchyDirty_ = true;
 }
@@ -206,41 +225,44 @@ bool OcclusionBuffer::AddTriangles(const Matrix3x4& model, const void* vertexDat
 
 void OcclusionBuffer::DrawTriangles()
 {
-    if (buffers_.size() == 1)
+    if (!buffer_.data_)
+    {
+        batches_.clear();
+        return;
+    }
+
+    if (!threaded_)
     {
-        // Not threaded
         for (auto i = batches_.begin(); i != batches_.end(); ++i)
             DrawBatch(*i, 0);
-
-        depthHierarchyDirty_ = true;
     }
-    else if (buffers_.size() > 1)
+    else
     {
-        // Threaded
-        auto* queue = GetSubsystem<WorkQueue>();
+        auto* workQueue = GetSubsystem<WorkQueue>();
 
-        for (auto i = batches_.begin(); i != batches_.end(); ++i)
+        // Transform and clip triangles in parallel, then rasterize horizontal bands in parallel.
+        // Bands don't overlap, so no per-thread buffers or merging are needed
+        queuedTriangles_.Clear();
+        queueTriangles_ = true;
+        ForEachParallel(workQueue, 1u, static_cast<unsigned>(batches_.size()), [&](unsigned beginIndex, unsigned endIndex)
         {
-            SharedPtr<WorkItem> item = queue->GetFreeItem();
-            item->priority_ = M_MAX_UNSIGNED;
-            item->workFunction_ = DrawOcclusionBatchWork;
-            item->aux_ = this;
-            item->start_ = &(*i);
-            queue->AddWorkItem(item);
-        }
-
-        queue->Complete(M_MAX_UNSIGNED);
-
-        MergeBuffers();
-        depthHierarchyDirty_ = true;
+            URHO3D_PROFILE("SetupOcclusionTriangles");
+            const unsigned threadIndex = WorkQueue::GetThreadIndex();
+            for (unsigned i = beginIndex; i < endIndex; ++i)
+                DrawBatch(batches_[i], threadIndex);
+        });
+        queueTriangles_ = false;
+
+        DrawQueuedTriangles();
     }
 
+    depthHierarchyDirty_ = true;
     batches_.clear();
 }
 
 void OcclusionBuffer::BuildDepthHierarchy()
 {
-    if (buffers_.empty() || !depthHierarchyDirty_)
+    if (!buffer_.data_ || !depthHierarchyDirty_)
         return;
 
     URHO3D_PROFILE("BuildDepthHierarchy");
@@ -252,7 +274,7 @@ void OcclusionBuffer::BuildDepthHierarchy()
     {
         for (int y = 0; y < height; ++y)
         {
-            int* src = buffers_[0].data_ + (y * 2) * width_;
+            int* src = buffer_.data_ + (y * 2) * width_;
             DepthValue* dest = mipBuffers_[0].get() + y * width;
             DepthValue* end = dest + width;
 
@@ -342,7 +364,7 @@ void OcclusionBuffer::ResetUseTimer()
 
 bool OcclusionBuffer::IsVisible(const BoundingBox& worldSpaceBox) const
 {
-    if (buffers_.empty())
+    if (!buffer_.data_)
         return true;
 
     // Transform corners to projection space
@@ -444,8 +466,8 @@ bool OcclusionBuffer::IsVisible(const BoundingBox& worldSpaceBox) const
     }
 
     // If no conclusive result, finally check the pixel-level data
-    int* row = buffers_[0].data_ + rect.top_ * width_;
-    int* endRow = buffers_[0].data_ + rect.bottom_ * width_;
+    int* row = buffer_.data_ + rect.top_ * width_;
+    int* endRow = buffer_.data_ + rect.bottom_ * width_;
     while (row <= endRow)
     {
         int* src = row + rect.left_;
@@ -470,13 +492,6 @@ unsigned OcclusionBuffer::GetUseTimer()
 
 void OcclusionBuffer::DrawBatch(const OcclusionBatch& batch, unsigned threadIndex)
 {
-    // If buffer not yet used, clear it
-    if (threadIndex > 0 && !buffers_[threadIndex].used_)
-    {
-        ClearBuffer(threadIndex);
-        buffers_[threadIndex].used_ = true;
-    }
-
     Matrix4 modelViewProj = viewProj_ * batch.model_;
 
     // Theoretical max. amount of vertices if each of the 6 clipping planes doubles the triangle count
@@ -640,7 +655,7 @@ void OcclusionBuffer::DrawTriangle(Vector4* vertices, unsigned threadIndex)
         bool clockwise = SignedArea(projected[0], projected[1], projected[2]) < 0.0f;
         if (cullMode_ == CULL_NONE || (cullMode_ == CULL_CCW && clockwise) || (cullMode_ == CULL_CW && !clockwise))
         {
-            DrawTriangle2D(projected, clockwise, threadIndex);
+            EmitTriangle2D(projected, clockwise, threadIndex);
             drawOk = true;
         }
     }
@@ -678,14 +693,15 @@ void OcclusionBuffer::DrawTriangle(Vector4* vertices, unsigned threadIndex)
                 bool clockwise = SignedArea(projected[0], projected[1], projected[2]) < 0.0f;
                 if (cullMode_ == CULL_NONE || (cullMode_ == CULL_CCW && clockwise) || (cullMode_ == CULL_CW && !clockwise))
                 {
-                    DrawTriangle2D(projected, clockwise, threadIndex);
+                    EmitTriangle2D(projected, clockwise, threadIndex);
                     drawOk = true;
                 }
             }
         }
     }
 
-    if (drawOk)
+    // Queued triangles are already counted on submission
+    if (drawOk && !queueTriangles_)
         ++numTriangles_;
 }
 
@@ -819,7 +835,61 @@ struct Edge
     int invZStep_;
 };
 
-void OcclusionBuffer::DrawTriangle2D(const Vector3* vertices, bool clockwise, unsigned threadIndex)
+/// Fill rows [beginY, endY) of a triangle half between left and right edges. Only rows in [clipBegin, clipEnd) are written.
+/// Edges are advanced past the half in any case.
+static void RasterizeRows(int* bufferData, int width, int dInvZdX, Edge& left, Edge& right,
+    int beginY, int endY, int clipBegin, int clipEnd)
+{
+    const int drawBegin = Max(beginY, clipBegin);
+    const int drawEnd = Min(endY, clipEnd);
+    const int skipBefore = Min(drawBegin, endY) - beginY;
+    if (skipBefore > 0)
+    {
+        left.x_ += left.xStep_ * skipBefore;
+        left.invZ_ += left.invZStep_ * skipBefore;
+        right.x_ += right.xStep_ * skipBefore;
+    }
+
+    if (drawBegin < drawEnd)
+    {
+        int* row = bufferData + drawBegin * width;
+        int* endRow = bufferData + drawEnd * width;
+        while (row < endRow)
+        {
+            FillSpan(row + (left.x_ >> 16u), row + (right.x_ >> 16u), left.invZ_, dInvZdX);
+
+            left.x_ += left.xStep_;
+            left.invZ_ += left.invZStep_;
+            right.x_ += right.xStep_;
+            row += width;
+        }
+    }
+
+    const int skipAfter = endY - Max(drawEnd, drawBegin);
+    if (skipAfter > 0)
+    {
+        left.x_ += left.xStep_ * skipAfter;
+        left.invZ_ += left.invZStep_ * skipAfter;
+        right.x_ += right.xStep_ * skipAfter;
+    }
+}
+
+void OcclusionBuffer::EmitTriangle2D(const Vector3* vertices, bool clockwise, unsigned threadIndex)
+{
+    if (!queueTriangles_)
+    {
+        DrawTriangle2D(vertices, clockwise, M_MIN_INT, M_MAX_INT);
+        return;
+    }
+
+    OcclusionTriangle& triangle = queuedTriangles_.Emplace();
+    ea::copy(vertices, vertices + 3, triangle.vertices_);
+    triangle.clockwise_ = clockwise;
+    triangle.beginRow_ = (int)Min(Min(vertices[0].y_, vertices[1].y_), vertices[2].y_);
+    triangle.endRow_ = (int)Max(Max(vertices[0].y_, vertices[1].y_), vertices[2].y_);
+}
+
+void OcclusionBuffer::DrawTriangle2D(const Vector3* vertices, bool clockwise, int beginRow, int endRow)
 {
     int top, middle, bottom;
     bool middleIsRight;
@@ -896,150 +966,81 @@ void OcclusionBuffer::DrawTriangle2D(const Vector3* vertices, bool clockwise, un
     Gradients gradients(vertices);
     Edge topToBottom(gradients, vertices[top], vertices[bottom], topY);
 
-    int* bufferData = buffers_[threadIndex].data_;
+    int* bufferData = buffer_.data_;
 
     if (middleIsRight)
     {
-        // Top half
         if (!topDegenerate)
         {
             Edge topToMiddle(gradients, vertices[top], vertices[middle], topY);
-            int* row = bufferData + topY * width_;
-            int* endRow = bufferData + middleY * width_;
-            while (row < endRow)
-            {
-                int invZ = topToBottom.invZ_;
-                int* dest = row + (topToBottom.x_ >> 16u);
-                int* end = row + (topToMiddle.x_ >> 16u);
-                while (dest < end)
-                {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
-                }
-
-                topToBottom.x_ += topToBottom.xStep_;
-                topToBottom.invZ_ += topToBottom.invZStep_;
-                topToMiddle.x_ += topToMiddle.xStep_;
-                row += width_;
-            }
+            RasterizeRows(bufferData, width_, gradients.dInvZdXInt_, topToBottom, topToMiddle, topY, middleY, beginRow, endRow);
         }
 
-        // Bottom half
         if (!bottomDegenerate)
         {
             Edge middleToBottom(gradients, vertices[middle], vertices[bottom], middleY);
-            int* row = bufferData + middleY * width_;
-            int* endRow = bufferData + bottomY * width_;
-            while (row < endRow)
-            {
-                int invZ = topToBottom.invZ_;
-                int* dest = row + (topToBottom.x_ >> 16u);
-                int* end = row + (middleToBottom.x_ >> 16u);
-                while (dest < end)
-                {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
-                }
-
-                topToBottom.x_ += topToBottom.xStep_;
-                topToBottom.invZ_ += topToBottom.invZStep_;
-                middleToBottom.x_ += middleToBottom.xStep_;
-                row += width_;
-            }
+            RasterizeRows(bufferData, width_, gradients.dInvZdXInt_, topToBottom, middleToBottom, middleY, bottomY, beginRow, endRow);
         }
     }
     else
     {
-        // Top half
         if (!topDegenerate)
         {
             Edge topToMiddle(gradients, vertices[top], vertices[middle], topY);
-            int* row = bufferData + topY * width_;
-            int* endRow = bufferData + middleY * width_;
-            while (row < endRow)
-            {
-                int invZ = topToMiddle.invZ_;
-                int* dest = row + (topToMiddle.x_ >> 16u);
-                int* end = row + (topToBottom.x_ >> 16u);
-                while (dest < end)
-                {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
-                }
-
-                topToMiddle.x_ += topToMiddle.xStep_;
-                topToMiddle.invZ_ += topToMiddle.invZStep_;
-                topToBottom.x_ += topToBottom.xStep_;
-                row += width_;
-            }
+            RasterizeRows(bufferData, width_, gradients.dInvZdXInt_, topToMiddle, topToBottom, topY, middleY, beginRow, endRow);
         }
 
-        // Bottom half
         if (!bottomDegenerate)
         {
             Edge middleToBottom(gradients, vertices[middle], vertices[bottom], middleY);
-            int* row = bufferData + middleY * width_;
-            int* endRow = bufferData + bottomY * width_;
-            while (row < endRow)
-            {
-                int invZ = middleToBottom.invZ_;
-                int* dest = row + (middleToBottom.x_ >> 16u);
-                int* end = row + (topToBottom.x_ >> 16u);
-                while (dest < end)
-                {
-                    if (invZ < *dest)
-                        *dest = invZ;
-                    invZ += gradients.dInvZdXInt_;
-                    ++dest;
-                }
-
-                middleToBottom.x_ += middleToBottom.xStep_;
-                middleToBottom.invZ_ += middleToBottom.invZStep_;
-                topToBottom.x_ += topToBottom.xStep_;
-                row += width_;
-            }
+            RasterizeRows(bufferData, width_, gradients.dInvZdXInt_, middleToBottom, topToBottom, middleY, bottomY, beginRow, endRow);
         }
     }
 }
 
-void OcclusionBuffer::MergeBuffers()
+void OcclusionBuffer::DrawQueuedTriangles()
 {
-    URHO3D_PROFILE("MergeBuffers");
+    URHO3D_PROFILE("RasterizeOcclusionTriangles");
 
-    for (unsigned i = 1; i < buffers_.size(); ++i)
-    {
-        if (!buffers_[i].used_)
-            continue;
-
-        int* src = buffers_[i].data_;
-        int* dest = buffers_[0].data_;
-        int count = width_ * height_;
+    auto* workQueue = GetSubsystem<WorkQueue>();
+    const unsigned numBands = Clamp((workQueue->GetNumThreads() + 1) * 4,
+        1u, static_cast<unsigned>(Max(height_ / OCCLUSION_MIN_BAND_HEIGHT, 1)));
+    const int bandHeight = (height_ + numBands - 1) / numBands;
 
-        while (count--)
+    ForEachParallel(workQueue, 1u, numBands, [&](unsigned beginIndex, unsigned endIndex)
+    {
+        URHO3D_PROFILE("RasterizeOcclusionBand");
+        for (unsigned bandIndex = beginIndex; bandIndex < endIndex; ++bandIndex)
         {
-            // If thread buffer's depth value is closer, overwrite the original
-            if (*src < *dest)
-                *dest = *src;
-            ++src;
-            ++dest;
+            const int beginRow = bandIndex * bandHeight;
+            const int endRow = Min(beginRow + bandHeight, height_);
+            for (const OcclusionTriangle& triangle : queuedTriangles_)
+            {
+                if (triangle.endRow_ > beginRow && triangle.beginRow_ < endRow)
+                    DrawTriangle2D(triangle.vertices_, triangle.clockwise_, beginRow, endRow);
+            }
         }
-    }
+    });
 }
 
-void OcclusionBuffer::ClearBuffer(unsigned threadIndex)
+void OcclusionBuffer::ClearBuffer()
 {
-    if (threadIndex >= buffers_.size())
+    if (!buffer_.data_)
         return;
 
-    int* dest = buffers_[threadIndex].data_;
+    int* dest = buffer_.data_;
     int count = width_ * height_;
-    auto fillValue = (int)OCCLUSION_Z_SCALE;
+    const auto fillValue = (int)OCCLUSION_Z_SCALE;
+
+#ifdef URHO3D_SSE
+    const __m128i fillValue4 = _mm_set1_epi32(fillValue);
+    while (count >= 4)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), fillValue4);
+        dest += 4;
+        count -= 4;
+    }
+#endif
 
     while (count--)
         *dest++ = fillValue;
@@ -28,6 +28,7 @@
 
 #include "../Core/Object.h"
 #include "../Core/Timer.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/GraphicsDefs.h"
 #include "../Math/Frustum.h"
 
@@ -51,15 +52,13 @@ struct DepthValue
     int max_;
 };
 
-/// Per-thread occlusion buffer data.
+/// Occlusion buffer data.
 struct OcclusionBufferData
 {
     /// Full buffer data with safety padding.
     ea::shared_array<int> dataWithSafety_;
     /// Buffer data.
-    int* data_;
-    /// Use flag.
-    bool used_;
+    int* data_{};
 };
 
 /// Stored occlusion render job.
@@ -81,10 +80,24 @@ struct OcclusionBatch
     unsigned drawCount_;
 };
 
+/// Clipped and projected triangle waiting for rasterization.
+struct OcclusionTriangle
+{
+    /// Vertices in viewport space.
+    Vector3 vertices_[3];
+    /// Whether the triangle is clockwise.
+    bool clockwise_;
+    /// First covered row.
+    int beginRow_;
+    /// Last covered row plus one.
+    int endRow_;
+};
+
 static const int OCCLUSION_MIN_SIZE = 8;
 static const int OCCLUSION_DEFAULT_MAX_TRIANGLES = 5000;
 static const float OCCLUSION_RELATIVE_BIAS = 0.00001f;
 static const int OCCLUSION_FIXED_BIAS = 16;
+static const int OCCLUSION_MIN_BAND_HEIGHT = 8;
 static const float OCCLUSION_X_SCALE = 65536.0f;
 static const float OCCLUSION_Z_SCALE = 16777216.0f;
 
@@ -102,7 +115,8 @@ public:
     /// Register object with the engine.
     static void RegisterObject(Context* context);
 
-    /// Set occlusion buffer size and whether to reserve multiple buffers for threading optimization.
+    /// Set occlusion buffer size and whether to rasterize in worker threads.
+    /// In threaded mode triangles are set up in parallel and then rasterized in parallel horizontal bands of the buffer.
     bool SetSize(int width, int height, bool threaded);
     /// Set camera view to render from.
     void SetView(Camera* camera);
@@ -127,7 +141,7 @@ public:
     void ResetUseTimer();
 
     /// Return highest level depth values.
-    int* GetBuffer() const { return buffers_.size() ? buffers_[0].data_ : nullptr; }
+    int* GetBuffer() const { return buffer_.data_; }
 
     /// Return view transform matrix.
     const Matrix3x4& GetView() const { return view_; }
@@ -151,7 +165,7 @@ public:
     CullMode GetCullMode() const { return cullMode_; }
 
     /// Return whether is using threads to speed up rendering.
-    bool IsThreaded() const { return buffers_.size() > 1; }
+    bool IsThreaded() const { return threaded_; }
 
     /// Test a bounding box for visibility. For best performance, build depth hierarchy first.
     bool IsVisible(const BoundingBox& worldSpaceBox) const;
@@ -172,19 +186,23 @@ private:
     inline float SignedArea(const Vector3& v0, const Vector3& v1, const Vector3& v2) const;
     /// Calculate viewport transform.
     void CalculateViewport();
-    /// Draw a triangle.
+    /// Draw a triangle. Triangle is queued for rasterization if called from threaded DrawTriangles.
     void DrawTriangle(Vector4* vertices, unsigned threadIndex);
     /// Clip vertices against a plane.
     void ClipVertices(const Vector4& plane, Vector4* vertices, bool* triangles, unsigned& numTriangles);
-    /// Draw a clipped triangle.
-    void DrawTriangle2D(const Vector3* vertices, bool clockwise, unsigned threadIndex);
-    /// Clear a thread work buffer.
-    void ClearBuffer(unsigned threadIndex);
-    /// Merge thread work buffers into the first buffer.
-    void MergeBuffers();
-
-    /// Highest-level buffer data per thread.
-    ea::vector<OcclusionBufferData> buffers_;
+    /// Draw a clipped triangle or queue it for rasterization.
+    void EmitTriangle2D(const Vector3* vertices, bool clockwise, unsigned threadIndex);
+    /// Draw a clipped triangle. Only rows in range [beginRow, endRow) are modified.
+    void DrawTriangle2D(const Vector3* vertices, bool clockwise, int beginRow, int endRow);
+    /// Rasterize queued triangles in parallel horizontal bands.
+    void DrawQueuedTriangles();
+    /// Clear the buffer.
+    void ClearBuffer();
+
+    /// Highest-level buffer data.
+    OcclusionBufferData buffer_;
+    /// Triangles queued for rasterization in threaded mode.
+    WorkQueueVector<OcclusionTriangle> queuedTriangles_;
     /// Reduced size depth buffers.
     ea::vector<ea::shared_array<DepthValue> > mipBuffers_;
     /// Submitted render jobs.
@@ -201,6 +219,10 @@ private:
     CullMode cullMode_{CULL_CCW};
     /// Depth hierarchy needs update flag.
     bool depthHierarchyDirty_{true};
+    /// Whether to rasterize in worker threads.
+    bool threaded_{};
+    /// Whether triangles are queued instead of being drawn immediately.
+    bool queueTriangles_{};
     /// Culling reverse flag.
     bool reverseCulling_{};
     /// View transform matrix.
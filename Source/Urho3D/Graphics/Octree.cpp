@@ -28,6 +28,8 @@
 #include "../Core/CoreEvents.h"
 #include "../Core/Profiler.h"
 #include "../Core/Thread.h"
+#include "../Engine/Engine.h"
+#include "../Graphics/Camera.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/Octree.h"
@@ -49,6 +51,13 @@ namespace Urho3D
 
 static const float DEFAULT_OCTREE_SIZE = 1000.0f;
 static const int DEFAULT_OCTREE_LEVELS = 8;
+static const unsigned DRAWABLE_REINSERTION_BUCKET = 128;
+/// Minimum number of zones to use grid for zone lookup.
+static const unsigned MIN_ZONES_FOR_GRID = 16;
+/// Desired number of zone grid cells per zone.
+static const unsigned ZONE_GRID_CELLS_PER_ZONE = 4;
+/// Maximum number of zone grid cells along each axis.
+static const int MAX_ZONE_GRID_SIZE = 64;
 
 void UpdateDrawablesWork(const WorkItem* item, unsigned threadIndex)
 {
@@ -93,6 +102,8 @@ Octant::~Octant()
             rootOctant->drawables_.push_back(*i);
             octree_->QueueUpdate(*i);
         }
+        if (!drawables_.empty())
+            rootOctant->MarkCullingDataDirty();
         drawables_.clear();
         numDrawables_ = 0;
     }
@@ -258,17 +269,45 @@ void Octant::GetDrawablesInternal(OctreeQuery& query, bool inside) const
         }
     }
 
-    if (drawables_.size())
+    TestDrawablesInternal(query, inside);
+
+    for (auto child : children_)
+    {
+        if (child)
+            child->GetDrawablesInternal(query, inside);
+    }
+}
+
+void Octant::TestDrawablesInternal(OctreeQuery& query, bool inside) const
+{
+    if (drawables_.empty())
+        return;
+
+    const bool packedCulling = octree_->IsPackedCulling() && !cullingDataDirty_;
+    if (!packedCulling || !query.TestPackedDrawables(drawables_.data(), cullingData_, inside))
     {
         auto** start = const_cast<Drawable**>(&drawables_[0]);
         Drawable** end = start + drawables_.size();
         query.TestDrawables(start, end, inside);
     }
+}
 
-    for (auto child : children_)
+void Octant::UpdateCullingData()
+{
+    if (!subtreeCullingDataDirty_)
+        return;
+
+    subtreeCullingDataDirty_ = false;
+    if (cullingDataDirty_)
+    {
+        cullingDataDirty_ = false;
+        cullingData_.Reset(drawables_);
+    }
+
+    for (Octant* child : children_)
     {
         if (child)
-            child->GetDrawablesInternal(query, inside);
+            child->UpdateCullingData();
     }
 }
 
@@ -350,6 +389,7 @@ void ZoneLookupIndex::RemoveZone(Zone* zone)
     const unsigned index = zones_.index_of(zone);
     assert(index < zones_.size());
     zones_.erase_at(index);
+    zonesDirty_ = true;
 }
 
 void ZoneLookupIndex::Commit()
@@ -372,6 +412,8 @@ void ZoneLookupIndex::Commit()
             data.boundingBox_ = zone->GetBoundingBox();
             data.inverseWorldTransform_ = zone->GetInverseWorldTransform();
         }
+
+        UpdateGrid();
     }
 
     for (Zone* zone : zones_)
@@ -380,18 +422,112 @@ void ZoneLookupIndex::Commit()
         defaultZone_->UpdateCachedData();
 }
 
+void ZoneLookupIndex::UpdateGrid()
+{
+    gridCells_.clear();
+    gridZoneIndices_.clear();
+
+    const unsigned numZones = zones_.size();
+    if (numZones < MIN_ZONES_FOR_GRID)
+        return;
+
+    ea::vector<BoundingBox> worldBoundingBoxes(numZones);
+    gridBoundingBox_.Clear();
+    for (unsigned i = 0; i < numZones; ++i)
+    {
+        worldBoundingBoxes[i] = zones_[i]->GetWorldBoundingBox();
+        gridBoundingBox_.Merge(worldBoundingBoxes[i]);
+    }
+
+    // Pick cubic cells so that there are a few cells per zone
+    const Vector3 gridExtent = VectorMax(gridBoundingBox_.Size(), Vector3::ONE * M_EPSILON);
+    const float desiredNumCells = static_cast<float>(numZones * ZONE_GRID_CELLS_PER_ZONE);
+    const float cellSize = Pow(gridExtent.x_ * gridExtent.y_ * gridExtent.z_ / desiredNumCells, 1.0f / 3.0f);
+    gridSize_ = VectorMin(VectorMax(VectorCeilToInt(gridExtent / cellSize), IntVector3::ONE),
+        IntVector3::ONE * MAX_ZONE_GRID_SIZE);
+    gridCellSize_ = gridExtent / gridSize_.ToVector3();
+
+    const auto getCell = [&](const Vector3& position)
+    {
+        const IntVector3 cell = VectorFloorToInt((position - gridBoundingBox_.min_) / gridCellSize_);
+        return VectorMin(VectorMax(cell, IntVector3::ZERO), gridSize_ - IntVector3::ONE);
+    };
+    const auto getCellRange = [&](const BoundingBox& box, IntVector3& minCell, IntVector3& maxCell)
+    {
+        minCell = getCell(box.min_);
+        maxCell = getCell(box.max_);
+    };
+    const auto forEachCell = [&](const IntVector3& minCell, const IntVector3& maxCell, const auto& callback)
+    {
+        for (int z = minCell.z_; z <= maxCell.z_; ++z)
+        {
+            for (int y = minCell.y_; y <= maxCell.y_; ++y)
+            {
+                for (int x = minCell.x_; x <= maxCell.x_; ++x)
+                    callback((z * gridSize_.y_ + y) * gridSize_.x_ + x);
+            }
+        }
+    };
+
+    // Count zones per cell, then fill zone indices in the order of priority
+    gridCells_.resize(gridSize_.x_ * gridSize_.y_ * gridSize_.z_);
+    for (unsigned i = 0; i < numZones; ++i)
+    {
+        IntVector3 minCell, maxCell;
+        getCellRange(worldBoundingBoxes[i], minCell, maxCell);
+        forEachCell(minCell, maxCell, [&](unsigned cellIndex) { ++gridCells_[cellIndex].count_; });
+    }
+
+    unsigned offset = 0;
+    for (GridCell& cell : gridCells_)
+    {
+        cell.offset_ = offset;
+        offset += cell.count_;
+        cell.count_ = 0;
+    }
+
+    gridZoneIndices_.resize(offset);
+    for (unsigned i = 0; i < numZones; ++i)
+    {
+        IntVector3 minCell, maxCell;
+        getCellRange(worldBoundingBoxes[i], minCell, maxCell);
+        forEachCell(minCell, maxCell, [&](unsigned cellIndex)
+        {
+            GridCell& cell = gridCells_[cellIndex];
+            gridZoneIndices_[cell.offset_ + cell.count_++] = i;
+        });
+    }
+}
+
+unsigned ZoneLookupIndex::GetGridCellIndex(const Vector3& position, IntVector3& cell) const
+{
+    if (gridBoundingBox_.IsInside(position) == OUTSIDE)
+        return M_MAX_UNSIGNED;
+
+    const IntVector3 lastCell = gridSize_ - IntVector3::ONE;
+    cell = VectorMin(VectorFloorToInt((position - gridBoundingBox_.min_) / gridCellSize_), lastCell);
+    return (cell.z_ * gridSize_.y_ + cell.y_) * gridSize_.x_ + cell.x_;
+}
+
+float ZoneLookupIndex::GetDistanceToCellBorder(const Vector3& position, const IntVector3& cell) const
+{
+    const Vector3 cellMin = gridBoundingBox_.min_ + cell.ToVector3() * gridCellSize_;
+    const Vector3 cellMax = cellMin + gridCellSize_;
+    const Vector3 distances = VectorMin(position - cellMin, cellMax - position);
+    return ea::max(0.0f, ea::min({distances.x_, distances.y_, distances.z_}));
+}
+
 CachedDrawableZone ZoneLookupIndex::QueryZone(const Vector3& position, unsigned zoneMask) const
 {
     float minDistanceToOtherZone = M_LARGE_VALUE;
     float distanceToBestZoneBorder = M_LARGE_VALUE;
     Zone* bestZone = nullptr;
 
-    const unsigned numZones = zones_.size();
-    for (unsigned i = 0; i < numZones; ++i)
+    const auto processZone = [&](unsigned i)
     {
         const ZoneData& data = zonesData_[i];
         if ((data.zoneMask_ & zoneMask) == 0)
-            continue;
+            return;
 
         const Vector3 localPosition = data.inverseWorldTransform_ * position;
         const float signedDistance = data.boundingBox_.SignedDistanceToPoint(localPosition);
@@ -407,6 +543,31 @@ CachedDrawableZone ZoneLookupIndex::QueryZone(const Vector3& position, unsigned
             bestZone = zones_[i];
             distanceToBestZoneBorder = -signedDistance;
         }
+    };
+
+    if (!IsGridEnabled())
+    {
+        const unsigned numZones = zones_.size();
+        for (unsigned i = 0; i < numZones; ++i)
+            processZone(i);
+    }
+    else
+    {
+        IntVector3 cell;
+        const unsigned cellIndex = GetGridCellIndex(position, cell);
+        if (cellIndex == M_MAX_UNSIGNED)
+        {
+            // No zone can affect point outside of the grid
+            minDistanceToOtherZone = gridBoundingBox_.SignedDistanceToPoint(position);
+        }
+        else
+        {
+            // Cell zones are ordered by priority, zones that don't overlap the cell are farther than the cell border
+            const GridCell& gridCell = gridCells_[cellIndex];
+            for (unsigned i = 0; i < gridCell.count_; ++i)
+                processZone(gridZoneIndices_[gridCell.offset_ + i]);
+            minDistanceToOtherZone = ea::min(minDistanceToOtherZone, GetDistanceToCellBorder(position, cell));
+        }
     }
 
     const float cacheInvalidationDistance = ea::min(minDistanceToOtherZone, distanceToBestZoneBorder);
@@ -426,9 +587,15 @@ Octree::Octree(Context* context) :
     zones_(context)
 {
     // If the engine is running headless, subscribe to RenderUpdate events for manually updating the octree
-    // to allow raycasts and animation update
+    // to allow raycasts and animation update. Dedicated servers may opt out of it.
     if (!GetSubsystem<Graphics>())
-        SubscribeToEvent(E_RENDERUPDATE, URHO3D_HANDLER(Octree, HandleRenderUpdate));
+    {
+        const auto engine = GetSubsystem<Engine>();
+        if (engine && engine->IsRenderUpdateSkipped())
+            skipDrawableUpdates_ = true;
+        else
+            SubscribeToEvent(E_RENDERUPDATE, URHO3D_HANDLER(Octree, HandleRenderUpdate));
+    }
 }
 
 Octree::~Octree()
@@ -448,6 +615,7 @@ void Octree::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE_EX("Bounding Box Min", Vector3, worldBoundingBox_.min_, UpdateOctreeSize, defaultBoundsMin, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Bounding Box Max", Vector3, worldBoundingBox_.max_, UpdateOctreeSize, defaultBoundsMax, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Number of Levels", int, numLevels_, UpdateOctreeSize, DEFAULT_OCTREE_LEVELS, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Packed Culling", bool, packedCulling_, false, AM_DEFAULT);
 }
 
 void Octree::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
@@ -547,6 +715,15 @@ void Octree::Update(const FrameInfo& frame)
     Scene* scene = GetScene();
     if (scene)
     {
+        scene->GetLogicUpdateQueue().Update(LogicUpdatePhase::DrawableUpdateFinished, frame.timeStep_, scene);
+
+        // Drawables moved by post-update in worker threads are reinserted in the same frame. They are not updated
+        // again: the update would reapply animation and discard the pose just modified, same as for drawables moved
+        // from the event handlers below
+        drawableUpdates_.insert(
+            drawableUpdates_.end(), threadedDrawableUpdates_.begin(), threadedDrawableUpdates_.end());
+        threadedDrawableUpdates_.clear();
+
         using namespace SceneDrawableUpdateFinished;
 
         VariantMap& eventData = GetEventDataMap();
@@ -555,31 +732,60 @@ void Octree::Update(const FrameInfo& frame)
         scene->SendEvent(E_SCENEDRAWABLEUPDATEFINISHED, eventData);
     }
 
+    // Recalculate moved world transforms at once instead of lazily from the reinsertion below
+    if (scene && scene->IsBatchedTransformUpdate())
+        scene->UpdateDirtyTransforms();
+
     // Reinsert drawables that have been moved or resized, or that have been newly added to the octree and do not sit inside
     // the proper octant yet
     if (!drawableUpdates_.empty())
     {
         URHO3D_PROFILE("ReinsertToOctree");
 
-        for (auto i = drawableUpdates_.begin(); i != drawableUpdates_.end(); ++i)
+        // World bounding boxes are evaluated lazily and may update cached world transforms of shared parent nodes,
+        // so resolve them in the main thread first
+        for (Drawable* drawable : drawableUpdates_)
         {
-            Drawable* drawable = *i;
             drawable->updateQueued_ = false;
-            Octant* octant = drawable->GetOctant();
-            const BoundingBox& box = drawable->GetWorldBoundingBox();
+            drawable->GetWorldBoundingBox();
+        }
 
-            // Skip if no octant or does not belong to this octree anymore
-            if (!octant || octant->GetOctree() != this)
-                continue;
-            // Skip if still fits the current octant
-            if (drawable->IsOccludee() && octant->GetCullingBox().IsInside(box) == INSIDE && octant->CheckDrawableFit(box))
+        // Check whether drawables still fit their octants in worker threads, neither the octree nor nodes are modified
+        drawableReinsertions_.clear();
+        drawableReinsertions_.resize(drawableUpdates_.size());
+        ForEachParallel(GetSubsystem<WorkQueue>(), DRAWABLE_REINSERTION_BUCKET, drawableUpdates_.size(),
+            [&](unsigned beginIndex, unsigned endIndex)
+        {
+            for (unsigned index = beginIndex; index < endIndex; ++index)
+            {
+                Drawable* drawable = drawableUpdates_[index];
+                Octant* octant = drawable->GetOctant();
+                const BoundingBox& box = drawable->GetWorldBoundingBox();
+
+                // Skip if no octant or does not belong to this octree anymore
+                if (!octant || octant->GetOctree() != this)
+                    continue;
+                // Skip if still fits the current octant
+                if (drawable->IsOccludee() && octant->GetCullingBox().IsInside(box) == INSIDE && octant->CheckDrawableFit(box))
+                    continue;
+
+                drawableReinsertions_[index] = true;
+            }
+        });
+
+        // Reinsert in the main thread in the original order so the octree layout stays deterministic
+        for (unsigned index = 0; index < drawableUpdates_.size(); ++index)
+        {
+            if (!drawableReinsertions_[index])
                 continue;
 
+            Drawable* drawable = drawableUpdates_[index];
             rootOctant_.InsertDrawable(drawable);
 
 #ifdef _DEBUG
             // Verify that the drawable will be culled correctly
-            octant = drawable->GetOctant();
+            const BoundingBox& box = drawable->GetWorldBoundingBox();
+            Octant* octant = drawable->GetOctant();
             if (octant != GetRootOctant() && octant->GetCullingBox().IsInside(box) != INSIDE)
             {
                 URHO3D_LOGERROR("Drawable is not fully inside its octant's culling bounds: drawable box " + box.ToString() +
@@ -591,6 +797,12 @@ void Octree::Update(const FrameInfo& frame)
 
     drawableUpdates_.clear();
 
+    if (packedCulling_)
+    {
+        URHO3D_PROFILE("UpdateOctreeCullingData");
+        rootOctant_.UpdateCullingData();
+    }
+
     // Update other singletons.
     // TODO: Refactor it, maybe split Octree?
     zones_.Commit();
@@ -632,6 +844,8 @@ void Octree::AddDrawable(Drawable* drawable)
         return;
     }
 
+    InvalidateCachedVisibleDrawables();
+
     // Add drawable to index
     const unsigned index = drawables_.size();
     drawables_.push_back(drawable);
@@ -666,6 +880,7 @@ void Octree::RemoveDrawable(Drawable* drawable, Octant* octant)
 
     // Remove drawable from Octree
     octant->RemoveDrawable(drawable);
+    InvalidateCachedVisibleDrawables();
 
     // Remove drawable from Zone index
     if (drawable->GetDrawableFlags().Test(DRAWABLE_ZONE))
@@ -765,16 +980,51 @@ Zone* Octree::GetBackgroundZone() const
     return zones_.GetBackgroundZone();
 }
 
+void Octree::SetCachedVisibleDrawables(
+    unsigned frameNumber, Camera* cullCamera, const ea::vector<Drawable*>& drawables)
+{
+    cachedVisibleDrawables_.frameNumber_ = frameNumber;
+    cachedVisibleDrawables_.cullCamera_ = cullCamera;
+    cachedVisibleDrawables_.viewMask_ = cullCamera->GetViewMask();
+    cachedVisibleDrawables_.frustum_ = cullCamera->GetFrustum();
+    cachedVisibleDrawables_.drawables_ = drawables;
+}
+
+const ea::vector<Drawable*>* Octree::GetCachedVisibleDrawables(unsigned frameNumber, Camera* cullCamera) const
+{
+    const CachedVisibleDrawables& cache = cachedVisibleDrawables_;
+    if (cache.frameNumber_ == 0 || cache.frameNumber_ != frameNumber || cache.cullCamera_ != cullCamera
+        || cache.viewMask_ != cullCamera->GetViewMask())
+        return nullptr;
+
+    // Camera may be moved between views
+    const Frustum& frustum = cullCamera->GetFrustum();
+    if (!ea::equal(ea::begin(frustum.vertices_), ea::end(frustum.vertices_), ea::begin(cache.frustum_.vertices_)))
+        return nullptr;
+
+    return &cache.drawables_;
+}
+
 void Octree::QueueUpdate(Drawable* drawable)
 {
+    // Drawables keep their initial octants, animations are applied only on demand
+    if (skipDrawableUpdates_)
+        return;
+
     Scene* scene = GetScene();
     if (scene && scene->IsThreadedUpdate())
     {
         MutexLock lock(octreeMutex_);
         threadedDrawableUpdates_.push_back(drawable);
+        if (Octant* octant = drawable->GetOctant())
+            octant->MarkCullingDataDirty();
     }
     else
+    {
         drawableUpdates_.push_back(drawable);
+        if (Octant* octant = drawable->GetOctant())
+            octant->MarkCullingDataDirty();
+    }
 
     drawable->updateQueued_ = true;
 }
@@ -32,6 +32,7 @@
 namespace Urho3D
 {
 
+class Camera;
 class Octree;
 class Zone;
 
@@ -63,6 +64,7 @@ public:
         drawable->SetOctant(this);
         drawables_.push_back(drawable);
         IncDrawableCount();
+        MarkCullingDataDirty();
     }
 
     /// Remove a drawable object from this octant.
@@ -74,10 +76,21 @@ public:
             drawables_.erase(it);
             if (resetOctant)
                 drawable->SetOctant(nullptr);
+            MarkCullingDataDirty();
             DecDrawableCount();
         }
     }
 
+    /// Mark packed culling data as dirty. Octant falls back to drawables until the data is updated.
+    void MarkCullingDataDirty()
+    {
+        cullingDataDirty_ = true;
+        for (Octant* octant = this; octant && !octant->subtreeCullingDataDirty_; octant = octant->parent_)
+            octant->subtreeCullingDataDirty_ = true;
+    }
+    /// Update dirty packed culling data recursively.
+    void UpdateCullingData();
+
     /// Return world-space bounding box.
     /// @property
     const BoundingBox& GetWorldBoundingBox() const { return worldBoundingBox_; }
@@ -91,6 +104,9 @@ public:
     /// Return parent octant.
     Octant* GetParent() const { return parent_; }
 
+    /// Return child octant or null if it does not exist.
+    Octant* GetChild(unsigned index) const { return children_[index]; }
+
     /// Return octree.
     Octree* GetOctree() const { return octree_; }
 
@@ -110,6 +126,8 @@ public:
 
     /// Return drawable objects by a query, called internally.
     void GetDrawablesInternal(OctreeQuery& query, bool inside) const;
+    /// Return drawable objects of this octant only by a query, called internally. Child octants are not visited.
+    void TestDrawablesInternal(OctreeQuery& query, bool inside) const;
     /// Return drawable objects by a ray query, called internally.
     void GetDrawablesInternal(RayOctreeQuery& query) const;
     /// Return drawable objects only for a threaded ray query, called internally.
@@ -165,9 +183,16 @@ protected:
     Octree* octree_{};
     /// Octant index relative to its siblings or ROOT_INDEX for root octant.
     unsigned index_{};
+    /// Packed culling data of drawables.
+    OctantCullingData cullingData_;
+    /// Whether the packed culling data of this octant is dirty.
+    bool cullingDataDirty_{true};
+    /// Whether the packed culling data of this octant or any child octant is dirty.
+    bool subtreeCullingDataDirty_{};
 };
 
 /// Acceleration structure for zone search.
+/// If there are many zones, zones are indexed by uniform grid over their world bounding boxes.
 class URHO3D_API ZoneLookupIndex
 {
 public:
@@ -188,6 +213,9 @@ public:
     /// Return background zone.
     Zone* GetBackgroundZone() const;
 
+    /// Return whether the grid is used for lookup.
+    bool IsGridEnabled() const { return !gridCells_.empty(); }
+
 private:
     /// Cached zone parameters.
     struct ZoneData
@@ -200,6 +228,22 @@ private:
         unsigned zoneMask_{};
     };
 
+    /// Range of zones overlapping grid cell.
+    struct GridCell
+    {
+        /// Offset in the zone indices.
+        unsigned offset_{};
+        /// Number of zones.
+        unsigned count_{};
+    };
+
+    /// Rebuild grid over zone bounds.
+    void UpdateGrid();
+    /// Return index of grid cell containing the position, or M_MAX_UNSIGNED if the position is outside of the grid.
+    unsigned GetGridCellIndex(const Vector3& position, IntVector3& cell) const;
+    /// Return distance from the position inside the cell to the cell border.
+    float GetDistanceToCellBorder(const Vector3& position, const IntVector3& cell) const;
+
     /// Default zone.
     Zone* defaultZone_{};
     /// Zones.
@@ -208,6 +252,17 @@ private:
     ea::vector<ZoneData> zonesData_;
     /// Whether zones are dirty.
     bool zonesDirty_{};
+
+    /// World bounding box of all zones covered by grid.
+    BoundingBox gridBoundingBox_;
+    /// Number of grid cells along each axis.
+    IntVector3 gridSize_;
+    /// Size of grid cell.
+    Vector3 gridCellSize_;
+    /// Grid cells. Empty if the grid is not used.
+    ea::vector<GridCell> gridCells_;
+    /// Indices of zones overlapping grid cells. Zones of each cell are ordered by priority from high to low.
+    ea::vector<unsigned> gridZoneIndices_;
 };
 
 /// %Octree component. Should be added only to the root scene node.
@@ -246,6 +301,28 @@ public:
     /// Return drawable objects by a query.
     /// @nobind
     void GetDrawables(OctreeQuery& query) const;
+    /// Return drawable objects by a query using worker threads. Child octants of the root are processed in parallel.
+    /// Query is constructed for each thread as T(result, args...). Order of results is not deterministic.
+    /// @nobind
+    template <class T, class ... Args>
+    void GetDrawablesParallel(WorkQueue* workQueue, WorkQueueVector<Drawable*>& result, const Args& ... args) const
+    {
+        result.Clear();
+        auto& threadResults = result.GetUnderlyingCollection();
+
+        // Index 0 is the root octant itself, other indices are the subtrees of its children
+        ForEachParallel(workQueue, 1u, NUM_OCTANTS + 1u, [&](unsigned beginIndex, unsigned endIndex)
+        {
+            T query(threadResults[WorkQueue::GetThreadIndex()], args...);
+            for (unsigned index = beginIndex; index < endIndex; ++index)
+            {
+                if (index == 0)
+                    rootOctant_.TestDrawablesInternal(query, false);
+                else if (const Octant* child = rootOctant_.GetChild(index - 1))
+                    child->GetDrawablesInternal(query, false);
+            }
+        });
+    }
     /// Return drawable objects by a ray query.
     void Raycast(RayOctreeQuery& query) const;
     /// Return the closest drawable object by a ray query.
@@ -267,9 +344,22 @@ public:
     /// @property
     unsigned GetNumLevels() const { return numLevels_; }
 
+    /// Set whether to keep packed culling data of drawables in octants.
+    /// Speeds up frustum queries at the cost of extra memory and update time.
+    /// @property
+    void SetPackedCulling(bool enable) { packedCulling_ = enable; }
+    /// Return whether to keep packed culling data of drawables in octants.
+    /// @property
+    bool IsPackedCulling() const { return packedCulling_; }
+
     /// Return all drawables in all octants.
     const ea::vector<Drawable*>& GetAllDrawables() const { return drawables_; }
 
+    /// Store visible drawables of the cull camera for the frame, so other views sharing the cull camera can reuse them.
+    void SetCachedVisibleDrawables(unsigned frameNumber, Camera* cullCamera, const ea::vector<Drawable*>& drawables);
+    /// Return visible drawables stored for the cull camera on this frame, or null if the camera or its frustum differ.
+    const ea::vector<Drawable*>* GetCachedVisibleDrawables(unsigned frameNumber, Camera* cullCamera) const;
+
     /// Mark drawable object as requiring an update and a reinsertion.
     void QueueUpdate(Drawable* drawable);
     /// Cancel drawable object's update.
@@ -285,6 +375,8 @@ private:
     void HandleRenderUpdate(StringHash eventType, VariantMap& eventData);
     /// Update octree size.
     void UpdateOctreeSize() { SetSize(worldBoundingBox_, numLevels_); }
+    /// Discard cached visible drawables.
+    void InvalidateCachedVisibleDrawables() { cachedVisibleDrawables_.frameNumber_ = 0; }
 
     /// Root octant.
     Octant rootOctant_;
@@ -292,6 +384,8 @@ private:
     ea::vector<Drawable*> drawableUpdates_;
     /// Drawable objects that were inserted during threaded update phase.
     ea::vector<Drawable*> threadedDrawableUpdates_;
+    /// Whether the drawable object from drawableUpdates_ with the same index should be reinserted.
+    ea::vector<bool> drawableReinsertions_;
     /// Node transforms to be applied before reinsertion.
     WorkQueueVector<ea::pair<Node*, Transform>> pendingNodeTransforms_;
     /// All Drawable objects.
@@ -304,8 +398,22 @@ private:
     unsigned numLevels_;
     /// World bounding box.
     BoundingBox worldBoundingBox_;
+    /// Whether to keep packed culling data of drawables in octants.
+    bool packedCulling_{};
+    /// Whether drawables are never updated and reinserted. Used by headless servers.
+    bool skipDrawableUpdates_{};
     /// Zones.
     ZoneLookupIndex zones_;
+
+    /// Visible drawables of the cull camera shared between views.
+    struct CachedVisibleDrawables
+    {
+        unsigned frameNumber_{};
+        WeakPtr<Camera> cullCamera_;
+        unsigned viewMask_{};
+        Frustum frustum_;
+        ea::vector<Drawable*> drawables_;
+    } cachedVisibleDrawables_;
 };
 
 }
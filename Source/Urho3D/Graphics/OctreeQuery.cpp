@@ -24,11 +24,47 @@
 
 #include "../Graphics/OctreeQuery.h"
 
+#ifdef URHO3D_SSE
+#include <xmmintrin.h>
+#endif
+
 #include "../DebugNew.h"
 
 namespace Urho3D
 {
 
+void OctantCullingData::Reset(ea::span<Drawable* const> drawables)
+{
+    const unsigned numDrawables = drawables.size();
+    const unsigned numBlocks = (numDrawables + BlockSize - 1) / BlockSize;
+
+    // Padding elements are zero-sized boxes that are never returned because of empty masks
+    boxes_.clear();
+    boxes_.resize(numBlocks * BlockStride, 0.0f);
+    viewMasks_.resize(numDrawables);
+    drawableFlags_.resize(numDrawables);
+
+    for (unsigned i = 0; i < numDrawables; ++i)
+    {
+        Drawable* drawable = drawables[i];
+        const BoundingBox& box = drawable->GetWorldBoundingBox();
+        const Vector3 center = box.Center();
+        const Vector3 edge = center - box.min_;
+
+        float* block = &boxes_[i / BlockSize * BlockStride];
+        const unsigned lane = i % BlockSize;
+        block[0 * BlockSize + lane] = center.x_;
+        block[1 * BlockSize + lane] = center.y_;
+        block[2 * BlockSize + lane] = center.z_;
+        block[3 * BlockSize + lane] = edge.x_;
+        block[4 * BlockSize + lane] = edge.y_;
+        block[5 * BlockSize + lane] = edge.z_;
+
+        viewMasks_[i] = drawable->GetViewMask();
+        drawableFlags_[i] = drawable->GetDrawableFlags();
+    }
+}
+
 Intersection PointOctreeQuery::TestOctant(const BoundingBox& box, bool inside)
 {
     if (inside)
@@ -117,6 +153,71 @@ void FrustumOctreeQuery::TestDrawables(Drawable** start, Drawable** end, bool in
     }
 }
 
+bool PackedFrustumOctreeQuery::TestPackedDrawables(Drawable* const* drawables, const OctantCullingData& data, bool inside)
+{
+    static constexpr unsigned BlockSize = OctantCullingData::BlockSize;
+    const unsigned numDrawables = data.viewMasks_.size();
+
+    for (unsigned blockIndex = 0; blockIndex * BlockSize < numDrawables; ++blockIndex)
+    {
+        unsigned outsideMask = 0;
+        if (!inside)
+        {
+            const float* block = &data.boxes_[blockIndex * OctantCullingData::BlockStride];
+#ifdef URHO3D_SSE
+            const __m128 centerX = _mm_loadu_ps(block + 0 * BlockSize);
+            const __m128 centerY = _mm_loadu_ps(block + 1 * BlockSize);
+            const __m128 centerZ = _mm_loadu_ps(block + 2 * BlockSize);
+            const __m128 edgeX = _mm_loadu_ps(block + 3 * BlockSize);
+            const __m128 edgeY = _mm_loadu_ps(block + 4 * BlockSize);
+            const __m128 edgeZ = _mm_loadu_ps(block + 5 * BlockSize);
+
+            __m128 outside = _mm_setzero_ps();
+            for (const Plane& plane : frustum_.planes_)
+            {
+                const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(_mm_set1_ps(plane.normal_.x_), centerX),
+                    _mm_mul_ps(_mm_set1_ps(plane.normal_.y_), centerY)),
+                    _mm_mul_ps(_mm_set1_ps(plane.normal_.z_), centerZ)),
+                    _mm_set1_ps(plane.d_));
+                const __m128 absDist = _mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(_mm_set1_ps(plane.absNormal_.x_), edgeX),
+                    _mm_mul_ps(_mm_set1_ps(plane.absNormal_.y_), edgeY)),
+                    _mm_mul_ps(_mm_set1_ps(plane.absNormal_.z_), edgeZ));
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, _mm_sub_ps(_mm_setzero_ps(), absDist)));
+            }
+            outsideMask = static_cast<unsigned>(_mm_movemask_ps(outside));
+#else
+            for (unsigned lane = 0; lane < BlockSize; ++lane)
+            {
+                const Vector3 center{block[0 * BlockSize + lane], block[1 * BlockSize + lane], block[2 * BlockSize + lane]};
+                const Vector3 edge{block[3 * BlockSize + lane], block[4 * BlockSize + lane], block[5 * BlockSize + lane]};
+                for (const Plane& plane : frustum_.planes_)
+                {
+                    const float dist = plane.normal_.DotProduct(center) + plane.d_;
+                    const float absDist = plane.absNormal_.DotProduct(edge);
+                    if (dist < -absDist)
+                    {
+                        outsideMask |= 1u << lane;
+                        break;
+                    }
+                }
+            }
+#endif
+        }
+
+        const unsigned endIndex = ea::min((blockIndex + 1) * BlockSize, numDrawables);
+        for (unsigned index = blockIndex * BlockSize; index < endIndex; ++index)
+        {
+            if (outsideMask & (1u << (index % BlockSize)))
+                continue;
+
+            if ((data.drawableFlags_[index] & drawableFlags_) && (data.viewMasks_[index] & viewMask_))
+                result_.push_back(drawables[index]);
+        }
+    }
+    return true;
+}
 
 Intersection AllContentOctreeQuery::TestOctant(const BoundingBox& box, bool inside)
 {
@@ -31,12 +31,34 @@
 #include "../Math/Ray.h"
 #include "../Math/Sphere.h"
 
+#include <EASTL/span.h>
+
 namespace Urho3D
 {
 
 class Drawable;
 class Node;
 
+/// Packed culling data of drawables in octant. Allows to cull drawables without accessing them.
+/// Bounding boxes are stored in blocks of BlockSize elements: centers X, Y, Z, then half sizes X, Y, Z.
+struct URHO3D_API OctantCullingData
+{
+    /// Number of drawables in block.
+    static constexpr unsigned BlockSize = 4;
+    /// Number of floats per block.
+    static constexpr unsigned BlockStride = 6 * BlockSize;
+
+    /// Reset data from drawables.
+    void Reset(ea::span<Drawable* const> drawables);
+
+    /// Bounding boxes of drawables.
+    ea::vector<float> boxes_;
+    /// View masks of drawables.
+    ea::vector<unsigned> viewMasks_;
+    /// Flags of drawables.
+    ea::vector<DrawableFlags> drawableFlags_;
+};
+
 /// Base class for octree queries.
 class URHO3D_API OctreeQuery : private NonCopyable
 {
@@ -56,6 +78,9 @@ public:
     virtual Intersection TestOctant(const BoundingBox& box, bool inside) = 0;
     /// Intersection test for drawables.
     virtual void TestDrawables(Drawable** start, Drawable** end, bool inside) = 0;
+    /// Intersection test for drawables using packed culling data.
+    /// Return false if not supported by the query, TestDrawables is used then.
+    virtual bool TestPackedDrawables(Drawable* const* drawables, const OctantCullingData& data, bool inside) { return false; }
 
     /// Result vector reference.
     ea::vector<Drawable*>& result_;
@@ -153,6 +178,18 @@ public:
     Frustum frustum_;
 };
 
+/// Frustum octree query that uses packed culling data of octants when available.
+/// Final because derived queries with custom drawable tests would be bypassed by packed culling.
+/// @nobind
+class URHO3D_API PackedFrustumOctreeQuery final : public FrustumOctreeQuery
+{
+public:
+    using FrustumOctreeQuery::FrustumOctreeQuery;
+
+    /// Intersection test for drawables using packed culling data.
+    bool TestPackedDrawables(Drawable* const* drawables, const OctantCullingData& data, bool inside) override;
+};
+
 /// General octree query result. Used for Lua bindings only.
 struct URHO3D_API OctreeQueryResult
 {
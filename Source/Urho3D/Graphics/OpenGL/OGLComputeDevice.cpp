@@ -200,15 +200,20 @@ bool ComputeDevice::SetConstantBuffer(ConstantBuffer* buffer, unsigned unit)
 
 bool ComputeDevice::SetWriteTexture(Texture* texture, unsigned unit, unsigned faceIndex, unsigned mipLevel)
 {
-    if (texture == nullptr)
-        return false;
-
-    if (!texture || unit >= MAX_COMPUTE_WRITE_TARGETS)
+    if (unit >= MAX_COMPUTE_WRITE_TARGETS)
     {
         URHO3D_LOGERROR("ComputeDevice::SetWriteTexture, attempted to assign write texture to out-of-bounds slot {}", unit);
         return false;
     }
 
+    // If null then clear and mark.
+    if (texture == nullptr)
+    {
+        uavs_[unit] = {};
+        uavsDirty_ = true;
+        return true;
+    }
+
     if (!texture->IsUnorderedAccessSupported())
     {
         URHO3D_LOGERROR("ComputeDevice::SetWriteTexture, texture format {} is not a compute-writeable format", texture->GetFormat());
@@ -323,7 +328,8 @@ void ComputeDevice::Dispatch(unsigned xDim, unsigned yDim, unsigned zDim)
     //          alpha-texture that a shadow pass is using.
     // Not that this actually does anything.
     if (anyUavs)
-        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT);
+        glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT
+            | GL_TEXTURE_FETCH_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
 }
 
 
@@ -52,10 +52,13 @@ void ConstantBuffer::Release()
 void ConstantBuffer::OnDeviceReset()
 {
     if (size_)
-        SetSize(size_); // Recreate
+    {
+        SetSize(size_, dynamic_); // Recreate
+        dataLost_ = true;
+    }
 }
 
-bool ConstantBuffer::SetSize(unsigned size)
+bool ConstantBuffer::SetSize(unsigned size, bool dynamic)
 {
     if (!size)
     {
@@ -68,6 +71,7 @@ bool ConstantBuffer::SetSize(unsigned size)
     size &= 0xfffffff0;
 
     size_ = size;
+    dynamic_ = dynamic;
 
     if (graphics_)
     {
@@ -75,6 +79,9 @@ bool ConstantBuffer::SetSize(unsigned size)
         if (!object_.name_)
             glGenBuffers(1, &object_.name_);
         graphics_->SetUBO(object_.name_);
+        // Dynamic buffers are updated in parts and need storage in advance
+        if (dynamic_)
+            glBufferData(GL_UNIFORM_BUFFER, size_, nullptr, GL_STREAM_DRAW);
 #endif
     }
 
@@ -87,9 +94,32 @@ void ConstantBuffer::Update(const void* data)
     {
 #ifndef GL_ES_VERSION_2_0
         graphics_->SetUBO(object_.name_);
-        glBufferData(GL_UNIFORM_BUFFER, size_, data, GL_DYNAMIC_DRAW);
+        glBufferData(GL_UNIFORM_BUFFER, size_, data, dynamic_ ? GL_STREAM_DRAW : GL_DYNAMIC_DRAW);
 #endif
     }
 }
 
+void ConstantBuffer::UpdateRange(const void* data, unsigned offset, unsigned size, bool discard)
+{
+    if (!object_.name_ || !dynamic_ || offset + size > size_)
+        return;
+
+#ifndef GL_ES_VERSION_2_0
+    graphics_->SetUBO(object_.name_);
+
+    // Orphan old storage, it is kept alive by the driver while used by pending draws
+    if (discard)
+        glBufferData(GL_UNIFORM_BUFFER, size_, nullptr, GL_STREAM_DRAW);
+
+    const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+    if (void* dest = glMapBufferRange(GL_UNIFORM_BUFFER, offset, size, access))
+    {
+        memcpy(dest, data, size);
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+    }
+    else
+        glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+#endif
+}
+
 }
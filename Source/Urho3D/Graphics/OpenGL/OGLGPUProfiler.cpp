@@ -0,0 +1,131 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../../Precompiled.h"
+
+#include "../../Graphics/GPUProfiler.h"
+#include "../../Graphics/Graphics.h"
+#include "../../Graphics/GraphicsImpl.h"
+
+#include "../../DebugNew.h"
+
+namespace Urho3D
+{
+
+bool GPUProfiler::IsSupported() const
+{
+#ifndef GL_ES_VERSION_2_0
+    return graphics_ && graphics_->IsInitialized() && (GLEW_VERSION_3_3 || GLEW_ARB_timer_query);
+#else
+    return false;
+#endif
+}
+
+void GPUProfiler::OnDeviceLost()
+{
+    // Query names are lost together with the context
+    for (FrameQueries& frame : frames_)
+    {
+        frame.timestamps_.clear();
+        frame.numTimestamps_ = 0;
+        frame.zones_.clear();
+        frame.pending_ = false;
+    }
+    frameActive_ = false;
+    zoneStack_.clear();
+}
+
+void GPUProfiler::OnDeviceReset()
+{
+    // Queries are recreated on demand
+}
+
+bool GPUProfiler::CreateQueries(FrameQueries& frame)
+{
+#ifndef GL_ES_VERSION_2_0
+    ea::vector<GLuint> names(MaxZonesPerFrame * 2 + 2);
+    glGenQueries(names.size(), names.data());
+
+    frame.timestamps_.resize(names.size());
+    for (unsigned i = 0; i < names.size(); ++i)
+        frame.timestamps_[i].name_ = names[i];
+    return glGetError() == GL_NO_ERROR;
+#else
+    return false;
+#endif
+}
+
+void GPUProfiler::ReleaseQueries(FrameQueries& frame)
+{
+#ifndef GL_ES_VERSION_2_0
+    if (!frame.timestamps_.empty() && graphics_ && !graphics_->IsDeviceLost())
+    {
+        ea::vector<GLuint> names;
+        for (const GPUObjectHandle& query : frame.timestamps_)
+            names.push_back(query.name_);
+        glDeleteQueries(names.size(), names.data());
+    }
+#endif
+    frame.timestamps_.clear();
+}
+
+void GPUProfiler::BeginDisjoint(FrameQueries& frame)
+{
+    // Desktop OpenGL doesn't report disjoint timestamps
+}
+
+void GPUProfiler::EndDisjoint(FrameQueries& frame)
+{
+}
+
+void GPUProfiler::WriteTimestamp(GPUObjectHandle query)
+{
+#ifndef GL_ES_VERSION_2_0
+    glQueryCounter(query.name_, GL_TIMESTAMP);
+#endif
+}
+
+bool GPUProfiler::ReadTimestamps(FrameQueries& frame, ea::vector<unsigned long long>& timestamps, bool& valid)
+{
+#ifndef GL_ES_VERSION_2_0
+    // Queries complete in order, so checking the last issued one is enough
+    GLint available = 0;
+    glGetQueryObjectiv(frame.timestamps_[1].name_, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available)
+        return false;
+
+    for (unsigned i = 0; i < frame.numTimestamps_; ++i)
+    {
+        GLuint64 value = 0;
+        glGetQueryObjectui64v(frame.timestamps_[i].name_, GL_QUERY_RESULT, &value);
+        timestamps[i] = value;
+    }
+
+    valid = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+}
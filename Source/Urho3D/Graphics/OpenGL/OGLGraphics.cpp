@@ -27,6 +27,7 @@
 #include "../../Core/ProcessUtils.h"
 #include "../../Core/Profiler.h"
 #include "../../Graphics/ConstantBuffer.h"
+#include "../../Graphics/ConstantBufferRing.h"
 #include "../../Graphics/Graphics.h"
 #include "../../Graphics/GraphicsEvents.h"
 #include "../../Graphics/GraphicsImpl.h"
@@ -283,6 +284,15 @@ static const unsigned glStencilOps[] =
 };
 #endif
 
+#ifdef GL_ES_VERSION_2_0
+#ifndef GL_HALF_FLOAT
+#define GL_HALF_FLOAT GL_HALF_FLOAT_OES
+#endif
+#ifndef GL_UNSIGNED_INT_2_10_10_10_REV
+#define GL_UNSIGNED_INT_2_10_10_10_REV GL_UNSIGNED_INT_2_10_10_10_REV_EXT
+#endif
+#endif
+
 static const unsigned glElementTypes[] =
 {
     GL_INT,
@@ -291,8 +301,12 @@ static const unsigned glElementTypes[] =
     GL_FLOAT,
     GL_FLOAT,
     GL_UNSIGNED_BYTE,
-    GL_UNSIGNED_BYTE
+    GL_UNSIGNED_BYTE,
+    GL_HALF_FLOAT,
+    GL_SHORT,
+    GL_UNSIGNED_INT_2_10_10_10_REV
 };
+static_assert(sizeof(glElementTypes) / sizeof(glElementTypes[0]) == MAX_VERTEX_ELEMENT_TYPES, "");
 
 static const unsigned glElementComponents[] =
 {
@@ -302,8 +316,17 @@ static const unsigned glElementComponents[] =
     3,
     4,
     4,
+    4,
+    2,
+    2,
     4
 };
+static_assert(sizeof(glElementComponents) / sizeof(glElementComponents[0]) == MAX_VERTEX_ELEMENT_TYPES, "");
+
+static bool IsNormalizedElementType(VertexElementType type)
+{
+    return type == TYPE_UBYTE4_NORM || type == TYPE_SHORT2_NORM || type == TYPE_UINT_10_10_10_2_NORM;
+}
 
 #ifdef GL_ES_VERSION_2_0
 static unsigned glesDepthStencilFormat = GL_DEPTH_COMPONENT16;
@@ -1034,6 +1057,40 @@ void Graphics::DrawInstanced(PrimitiveType type, unsigned indexStart, unsigned i
 #endif
 }
 
+void Graphics::MultiDrawIndexedInstancedIndirect(PrimitiveType type, ea::span<const IndirectDrawIndexedArgs> draws)
+{
+#ifndef GL_ES_VERSION_2_0
+    if (!caps.multiDrawIndirectSupported_ || draws.empty() || !indexBuffer_ || !indexBuffer_->GetGPUObjectName())
+        return;
+
+    PrepareDraw();
+
+    if (!impl_->drawIndirectBuffer_)
+        glGenBuffers(1, &impl_->drawIndirectBuffer_);
+
+    // Orphan previous content, the buffer is rewritten for each call
+    const auto size = static_cast<GLsizeiptr>(draws.size() * sizeof(IndirectDrawIndexedArgs));
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, impl_->drawIndirectBuffer_);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, size, draws.data(), GL_STREAM_DRAW);
+
+    const unsigned indexSize = indexBuffer_->GetIndexSize();
+    const GLenum indexType = indexSize == sizeof(unsigned short) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+    unsigned primitiveCount = 0;
+    GLenum glPrimitiveType{};
+    for (const IndirectDrawIndexedArgs& draw : draws)
+    {
+        GetGLPrimitiveType(draw.indexCount_, type, primitiveCount, glPrimitiveType);
+        numPrimitives_ += draw.instanceCount_ * primitiveCount;
+    }
+
+    glMultiDrawElementsIndirect(glPrimitiveType, indexType, nullptr, static_cast<GLsizei>(draws.size()), 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    ++numBatches_;
+#endif
+}
+
 void Graphics::SetVertexBuffer(VertexBuffer* buffer)
 {
     // Note: this is not multi-instance safe
@@ -1110,8 +1167,23 @@ void Graphics::SetShaders(ShaderVariation* vs, ShaderVariation* ps)
     if (vs == vertexShader_ && ps == pixelShader_)
         return;
 
+    // Try to load linked program from cache first, so the shaders don't need to be compiled at all
+    bool loadedFromCache = false;
+    if (vs && ps && programBinarySupport_ && !impl_->shaderPrograms_.contains(ea::make_pair(vs, ps)))
+    {
+        URHO3D_PROFILE("LoadShaderProgramBinary");
+
+        SharedPtr<ShaderProgram> cachedProgram(new ShaderProgram(this, vs, ps));
+        if (cachedProgram->LoadFromBinaryCache())
+        {
+            URHO3D_LOGDEBUG("Loaded cached program for vertex shader {} and pixel shader {}", vs->GetFullName(), ps->GetFullName());
+            impl_->shaderPrograms_[ea::make_pair(vs, ps)] = cachedProgram;
+            loadedFromCache = true;
+        }
+    }
+
     // Compile the shaders now if not yet compiled. If already attempted, do not retry
-    if (vs && !vs->GetGPUObjectName())
+    if (vs && !vs->GetGPUObjectName() && !loadedFromCache)
     {
         if (vs->GetCompilerOutput().empty())
         {
@@ -1130,7 +1202,7 @@ void Graphics::SetShaders(ShaderVariation* vs, ShaderVariation* ps)
             vs = nullptr;
     }
 
-    if (ps && !ps->GetGPUObjectName())
+    if (ps && !ps->GetGPUObjectName() && !loadedFromCache)
     {
         if (ps->GetCompilerOutput().empty())
         {
@@ -2435,6 +2507,15 @@ void Graphics::Release(bool clearGPUObjects, bool closeWindow)
     CleanupFramebuffers();
     impl_->depthTextures_.clear();
 
+#ifndef GL_ES_VERSION_2_0
+    if (impl_->drawIndirectBuffer_)
+    {
+        if (!IsDeviceLost())
+            glDeleteBuffers(1, &impl_->drawIndirectBuffer_);
+        impl_->drawIndirectBuffer_ = 0;
+    }
+#endif
+
     // End fullscreen mode first to counteract transition and getting stuck problems on OS X
 #if defined(__APPLE__) && !defined(IOS) && !defined(TVOS)
     if (closeWindow && screenParams_.fullscreen_ && !externalWindow_)
@@ -2851,6 +2932,11 @@ void Graphics::CheckFeatureSupport()
         caps.constantBufferOffsetAlignment_ = GetIntParam(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT);
         caps.constantBuffersSupported_ = true;
         caps.maxNumRenderTargets_ = GetIntParam(GL_MAX_COLOR_ATTACHMENTS);
+        caps.baseVertexIndexSupported_ = glDrawElementsBaseVertex != nullptr;
+        // Base instance in indirect commands requires GL 4.2 or ARB_base_instance
+        caps.multiDrawIndirectSupported_ = instancingSupport_ && glMultiDrawElementsIndirect != nullptr
+            && (GLEW_VERSION_4_3 || (GLEW_ARB_multi_draw_indirect && GLEW_ARB_base_instance));
+        caps.constantBufferRingSupported_ = glMapBufferRange != nullptr;
     }
     else
     {
@@ -2864,6 +2950,28 @@ void Graphics::CheckFeatureSupport()
         caps.maxNumRenderTargets_ = GetIntParam(GL_MAX_COLOR_ATTACHMENTS_EXT);
     }
 
+    // Check support for program binaries. Some drivers expose the API but support no binary formats
+#if (!defined(GL_ES_VERSION_2_0) || defined(GL_ES_VERSION_3_0)) && !defined(__EMSCRIPTEN__)
+#ifndef GL_ES_VERSION_2_0
+    const bool programBinaryApi = gl3Support && (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary);
+#else
+    const bool programBinaryApi = gl3Support;
+#endif
+    programBinarySupport_ = programBinaryApi && GetIntParam(GL_NUM_PROGRAM_BINARY_FORMATS) > 0;
+    if (programBinarySupport_)
+    {
+        const ea::string driverName = Format("{} {} {}", (const char*)glGetString(GL_VENDOR),
+            (const char*)glGetString(GL_RENDERER), (const char*)glGetString(GL_VERSION));
+        programBinaryDriverHash_ = StringHash::Calculate(driverName.c_str());
+    }
+#endif
+
+    // Let the driver compile and link shaders on its own threads when possible
+#ifndef GL_ES_VERSION_2_0
+    if (GLEW_KHR_parallel_shader_compile)
+        glMaxShaderCompilerThreadsKHR(0xffffffffu);
+#endif
+
     // Must support 2 rendertargets for light pre-pass, and 4 for deferred
     if (caps.maxNumRenderTargets_ >= 2)
         lightPrepassSupport_ = true;
@@ -3237,7 +3345,7 @@ void Graphics::PrepareDraw()
 #endif
                     {
                         glVertexAttribPointer(location, glElementComponents[element.type_], glElementTypes[element.type_],
-                            element.type_ == TYPE_UBYTE4_NORM ? GL_TRUE : GL_FALSE, (unsigned)buffer->GetVertexSize(),
+                            IsNormalizedElementType(element.type_) ? GL_TRUE : GL_FALSE, (unsigned)buffer->GetVertexSize(),
                             (const void *)(size_t)dataStart);
                     }
                 }
@@ -3369,10 +3477,14 @@ void Graphics::SetTextureUnitMappings()
     textureUnits_["ShadowMap"] = TU_SHADOWMAP;
 #ifndef GL_ES_VERSION_2_0
     textureUnits_["VolumeMap"] = TU_VOLUMEMAP;
+    textureUnits_["HeightMap"] = TU_CUSTOM1;
     textureUnits_["FaceSelectCubeMap"] = TU_FACESELECT;
     textureUnits_["IndirectionCubeMap"] = TU_INDIRECTION;
+    textureUnits_["LightClusterMap"] = TU_FACESELECT;
+    textureUnits_["LightDataMap"] = TU_INDIRECTION;
     textureUnits_["DepthBuffer"] = TU_DEPTHBUFFER;
     textureUnits_["LightBuffer"] = TU_LIGHTBUFFER;
+    textureUnits_["DecalMap"] = TU_LIGHTBUFFER;
     textureUnits_["ZoneCubeMap"] = TU_ZONE;
     textureUnits_["ZoneVolumeMap"] = TU_ZONE;
 #endif
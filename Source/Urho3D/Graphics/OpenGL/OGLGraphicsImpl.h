@@ -153,6 +153,8 @@ private:
     ConstantBufferMap allConstantBuffers_;
     /// Last used instance data offset.
     unsigned lastInstanceOffset_{};
+    /// Buffer with arguments of indirect draw calls.
+    unsigned drawIndirectBuffer_{};
     /// Map for additional depth textures, to emulate Direct3D9 ability to mix render texture and backbuffer rendering.
     /// TODO: Revisit this place? We may want to handle this manually.
     ea::unordered_map<unsigned, SharedPtr<Texture2D> > depthTextures_;
@@ -26,7 +26,10 @@
 #include "../../Graphics/Graphics.h"
 #include "../../Graphics/GraphicsImpl.h"
 #include "../../Graphics/ShaderProgram.h"
+#include "../../Graphics/Shader.h"
 #include "../../Graphics/ShaderVariation.h"
+#include "../../IO/File.h"
+#include "../../IO/FileSystem.h"
 #include "../../IO/Log.h"
 
 #include "../../DebugNew.h"
@@ -248,6 +251,12 @@ bool ShaderProgram::Link()
         return false;
     }
 
+    const ea::string binaryFileName = GetBinaryCacheFileName();
+#if !defined(GL_ES_VERSION_2_0) || defined(GL_ES_VERSION_3_0)
+    if (!binaryFileName.empty())
+        glProgramParameteri(object_.name_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+
     glAttachShader(object_.name_, vertexShader_->GetGPUObjectName());
     glAttachShader(object_.name_, pixelShader_->GetGPUObjectName());
     glLinkProgram(object_.name_);
@@ -269,6 +278,15 @@ bool ShaderProgram::Link()
     if (!object_.name_)
         return false;
 
+    if (!binaryFileName.empty())
+        SaveToBinaryCache(binaryFileName);
+
+    ReflectProgram();
+    return true;
+}
+
+void ShaderProgram::ReflectProgram()
+{
     const int MAX_NAME_LENGTH = 256;
     char nameBuffer[MAX_NAME_LENGTH];
     int attributeCount, uniformCount, elementCount, nameLength;
@@ -438,7 +456,124 @@ bool ShaderProgram::Link()
     shaderParameters_.rehash(Max(2, NextPowerOfTwo(shaderParameters_.size())));
 
     RecalculateLayoutHash();
+}
+
+ea::string ShaderProgram::GetBinaryCacheFileName() const
+{
+    if (!graphics_ || !graphics_->GetProgramBinarySupport() || !vertexShader_ || !pixelShader_)
+        return EMPTY_STRING;
+
+    // Only absolute cache directory is supported, program binaries shall not be written into resource directories
+    const ea::string& cacheDir = graphics_->GetShaderCacheDir();
+    if (cacheDir.empty() || !IsAbsolutePath(cacheDir))
+        return EMPTY_STRING;
+
+    const unsigned vsHash = vertexShader_->GetSourceCodeHash();
+    const unsigned psHash = pixelShader_->GetSourceCodeHash();
+    return Format("{}Program_{}_{}.glbin", cacheDir, StringHash(vsHash).ToString(), StringHash(psHash).ToString());
+}
+
+bool ShaderProgram::LoadFromBinaryCache()
+{
+#if !defined(GL_ES_VERSION_2_0) || defined(GL_ES_VERSION_3_0)
+    Release();
+
+    const ea::string fileName = GetBinaryCacheFileName();
+    if (fileName.empty())
+        return false;
+
+    auto fileSystem = graphics_->GetSubsystem<FileSystem>();
+    if (!fileSystem->FileExists(fileName))
+        return false;
+
+    // Binary is considered stale if either shader source was modified after the binary was saved
+    const unsigned binaryTime = fileSystem->GetLastModifiedTime(fileName);
+    for (Shader* owner : {vertexShader_->GetOwner(), pixelShader_->GetOwner()})
+    {
+        if (!owner || owner->GetTimeStamp() > binaryTime)
+        {
+            fileSystem->Delete(fileName);
+            return false;
+        }
+    }
+
+    ByteVector binary;
+    unsigned binaryFormat = 0;
+    {
+        auto file = MakeShared<File>(graphics_->GetContext(), fileName, FILE_READ);
+        if (!file->IsOpen() || file->ReadFileID() != "UGLP" || file->ReadUInt() != graphics_->GetProgramBinaryDriverHash())
+        {
+            file->Close();
+            fileSystem->Delete(fileName);
+            return false;
+        }
+
+        binaryFormat = file->ReadUInt();
+        binary.resize(file->ReadUInt());
+        if (binary.empty() || file->Read(binary.data(), binary.size()) != binary.size())
+        {
+            file->Close();
+            fileSystem->Delete(fileName);
+            return false;
+        }
+    }
+
+    object_.name_ = glCreateProgram();
+    if (!object_.name_)
+        return false;
+
+    glProgramBinary(object_.name_, binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+    // Driver may reject binary for any reason, e.g. after driver update
+    int linked = 0;
+    glGetProgramiv(object_.name_, GL_LINK_STATUS, &linked);
+    if (!linked)
+    {
+        URHO3D_LOGDEBUG("Rejected cached program binary {}", fileName);
+        glDeleteProgram(object_.name_);
+        object_.name_ = 0;
+        fileSystem->Delete(fileName);
+        return false;
+    }
+
+    linkerOutput_.clear();
+    ReflectProgram();
     return true;
+#else
+    return false;
+#endif
+}
+
+void ShaderProgram::SaveToBinaryCache(const ea::string& fileName)
+{
+#if !defined(GL_ES_VERSION_2_0) || defined(GL_ES_VERSION_3_0)
+    int binaryLength = 0;
+    glGetProgramiv(object_.name_, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    if (binaryLength <= 0)
+        return;
+
+    ByteVector binary(static_cast<unsigned>(binaryLength));
+    GLenum binaryFormat = 0;
+    GLsizei actualLength = 0;
+    glGetProgramBinary(object_.name_, binaryLength, &actualLength, &binaryFormat, binary.data());
+    if (actualLength <= 0)
+        return;
+
+    auto fileSystem = graphics_->GetSubsystem<FileSystem>();
+    const ea::string path = GetPath(fileName);
+    if (!fileSystem->DirExists(path))
+        fileSystem->CreateDir(path);
+
+    auto file = MakeShared<File>(graphics_->GetContext(), fileName, FILE_WRITE);
+    if (!file->IsOpen())
+        return;
+
+    file->WriteFileID("UGLP");
+    file->WriteUInt(graphics_->GetProgramBinaryDriverHash());
+    file->WriteUInt(binaryFormat);
+    file->WriteUInt(static_cast<unsigned>(actualLength));
+    file->Write(binary.data(), static_cast<unsigned>(actualLength));
+#endif
 }
 
 ShaderVariation* ShaderProgram::GetVertexShader() const
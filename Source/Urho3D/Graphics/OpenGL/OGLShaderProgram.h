@@ -53,7 +53,11 @@ public:
     void Release() override;
 
     /// Link the shaders and examine the uniforms and samplers used. Return true if successful.
+    /// Linked program binary is saved to shader cache directory if program binaries are supported.
     bool Link();
+    /// Load linked program binary from shader cache directory without compiling the shaders. Return true if successful.
+    /// Stale or rejected binaries are deleted.
+    bool LoadFromBinaryCache();
 
     /// Return the vertex shader.
     ShaderVariation* GetVertexShader() const;
@@ -90,6 +94,13 @@ public:
     static void ClearGlobalParameterSource(ShaderParameterGroup group);
 
 private:
+    /// Examine vertex attributes, uniforms and samplers of linked program.
+    void ReflectProgram();
+    /// Return file name of cached program binary, or empty string if caching is disabled.
+    ea::string GetBinaryCacheFileName() const;
+    /// Save linked program binary to shader cache directory.
+    void SaveToBinaryCache(const ea::string& fileName);
+
     /// Vertex shader.
     WeakPtr<ShaderVariation> vertexShader_;
     /// Pixel shader.
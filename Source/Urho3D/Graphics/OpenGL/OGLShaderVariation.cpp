@@ -51,6 +51,92 @@ const char* ShaderVariation::elementSemanticNames[] =
     "OBJECTINDEX"
 };
 
+namespace
+{
+
+/// Generate final shader code passed to the compiler.
+ea::string GenerateShaderCode(const Shader& owner, ShaderType type, const ea::string& defines, bool checkDefines)
+{
+    const ea::string& originalShaderCode = owner.GetSourceCode(type);
+    ea::string shaderCode;
+
+    // Check if the shader code contains a version define
+    const auto versionTag = FindVersionTag(originalShaderCode);
+    if (versionTag)
+    {
+        // If version define found, insert it first
+        const ea::string versionDefine = originalShaderCode.substr(versionTag->first, versionTag->second - versionTag->first);
+        shaderCode += versionDefine + "\n";
+    }
+    else if (Graphics::GetGL3Support())
+    {
+#ifdef MOBILE_GRAPHICS
+        shaderCode += "#version 300 es\n";
+#else
+        shaderCode += "#version 150\n";
+#endif
+    }
+#if defined(DESKTOP_GRAPHICS)
+    shaderCode += "#define DESKTOP_GRAPHICS\n";
+#elif defined(MOBILE_GRAPHICS)
+    shaderCode += "#define MOBILE_GRAPHICS\n";
+#endif
+
+    // Distinguish between VS and PS compile in case the shader code wants to include/omit different things
+    static const char* STAGE_DEFS[] = {
+        "#define COMPILEVS\n", // VS
+        "#define COMPILEPS\n", // PS
+        "#define COMPILEGS\n", // GS
+        "#define COMPILEHS\n", // HS
+        "#define COMPILEDS\n", // DS
+        "#define COMPILECS\n", // CS
+    };
+    shaderCode += STAGE_DEFS[type];
+
+    // Add define for the maximum number of supported bones
+    shaderCode += "#define MAXBONES " + ea::to_string(Graphics::GetMaxBones()) + "\n";
+
+    // Prepend the defines to the shader code
+    ea::vector<ea::string> defineVec = defines.split(' ');
+    for (unsigned i = 0; i < defineVec.size(); ++i)
+    {
+        // Add extra space for the checking code below
+        ea::string defineString = "#define " + defineVec[i].replaced('=', ' ') + " \n";
+        shaderCode += defineString;
+
+        // In debug mode, check that all defines are referenced by the shader code
+#ifdef _DEBUG
+        ea::string defineCheck = defineString.substr(8, defineString.find(' ', 8) - 8);
+        if (checkDefines && originalShaderCode.find(defineCheck) == ea::string::npos)
+            URHO3D_LOGWARNING("Shader " + owner.GetName() + " does not use the define " + defineCheck);
+#endif
+    }
+
+#ifdef RPI
+    if (type == VS)
+        shaderCode += "#define RPI\n";
+#endif
+#ifdef __EMSCRIPTEN__
+    shaderCode += "#define WEBGL\n";
+#endif
+    if (Graphics::GetGL3Support())
+        shaderCode += "#define GL3\n";
+
+    // When version define found, do not insert it a second time
+    if (versionTag)
+    {
+        shaderCode += originalShaderCode.substr(0, versionTag->first);
+        shaderCode += "//";
+        shaderCode += originalShaderCode.substr(versionTag->first);
+    }
+    else
+        shaderCode += originalShaderCode;
+
+    return shaderCode;
+}
+
+}
+
 void ShaderVariation::OnDeviceLost()
 {
     if (object_.name_ && !graphics_->IsDeviceLost())
@@ -85,9 +171,12 @@ void ShaderVariation::Release()
         }
 
         object_.name_ = 0;
-        graphics_->CleanupShaderPrograms(this);
     }
 
+    // Shader programs may be loaded from binary cache without compiling shaders, so clean them up unconditionally
+    if (graphics_)
+        graphics_->CleanupShaderPrograms(this);
+
     compilerOutput_.clear();
 }
 
@@ -138,81 +227,7 @@ bool ShaderVariation::Create()
         return false;
     }
 
-    const ea::string& originalShaderCode = owner_->GetSourceCode(type_);
-    ea::string shaderCode;
-
-    // Check if the shader code contains a version define
-    const auto versionTag = FindVersionTag(originalShaderCode);
-    if (versionTag)
-    {
-        // If version define found, insert it first
-        const ea::string versionDefine = originalShaderCode.substr(versionTag->first, versionTag->second - versionTag->first);
-        shaderCode += versionDefine + "\n";
-    }
-    else if (Graphics::GetGL3Support())
-    {
-#ifdef MOBILE_GRAPHICS
-        shaderCode += "#version 300 es\n";
-#else
-        shaderCode += "#version 150\n";
-#endif
-    }
-#if defined(DESKTOP_GRAPHICS)
-    shaderCode += "#define DESKTOP_GRAPHICS\n";
-#elif defined(MOBILE_GRAPHICS)
-    shaderCode += "#define MOBILE_GRAPHICS\n";
-#endif
-
-    // Distinguish between VS and PS compile in case the shader code wants to include/omit different things
-    static const char* STAGE_DEFS[] = {
-        "#define COMPILEVS\n", // VS
-        "#define COMPILEPS\n", // PS
-        "#define COMPILEGS\n", // GS
-        "#define COMPILEHS\n", // HS
-        "#define COMPILEDS\n", // DS
-        "#define COMPILECS\n", // CS
-    };
-    shaderCode += STAGE_DEFS[type_];
-
-    // Add define for the maximum number of supported bones
-    shaderCode += "#define MAXBONES " + ea::to_string(Graphics::GetMaxBones()) + "\n";
-
-    // Prepend the defines to the shader code
-    ea::vector<ea::string> defineVec = defines_.split(' ');
-    for (unsigned i = 0; i < defineVec.size(); ++i)
-    {
-        // Add extra space for the checking code below
-        ea::string defineString = "#define " + defineVec[i].replaced('=', ' ') + " \n";
-        shaderCode += defineString;
-
-        // In debug mode, check that all defines are referenced by the shader code
-#ifdef _DEBUG
-        ea::string defineCheck = defineString.substr(8, defineString.find(' ', 8) - 8);
-        if (originalShaderCode.find(defineCheck) == ea::string::npos)
-            URHO3D_LOGWARNING("Shader " + GetFullName() + " does not use the define " + defineCheck);
-#endif
-    }
-
-#ifdef RPI
-    if (type_ == VS)
-        shaderCode += "#define RPI\n";
-#endif
-#ifdef __EMSCRIPTEN__
-    shaderCode += "#define WEBGL\n";
-#endif
-    if (Graphics::GetGL3Support())
-        shaderCode += "#define GL3\n";
-
-    // When version define found, do not insert it a second time
-    if (versionTag)
-    {
-        shaderCode += originalShaderCode.substr(0, versionTag->first);
-        shaderCode += "//";
-        shaderCode += originalShaderCode.substr(versionTag->first);
-    }
-    else
-        shaderCode += originalShaderCode;
-
+    const ea::string shaderCode = GenerateShaderCode(*owner_, type_, defines_, true);
     const char* shaderCStr = shaderCode.c_str();
     glShaderSource(object_.name_, 1, &shaderCStr, nullptr);
     glCompileShader(object_.name_);
@@ -241,6 +256,15 @@ void ShaderVariation::SetDefines(const ea::string& defines)
     defines_ = defines;
 }
 
+unsigned ShaderVariation::GetSourceCodeHash() const
+{
+    if (!owner_)
+        return 0;
+
+    const ea::string shaderCode = GenerateShaderCode(*owner_, type_, defines_, false);
+    return StringHash::Calculate(shaderCode.c_str());
+}
+
 // These methods are no-ops for OpenGL
 bool ShaderVariation::LoadByteCode(const ea::string& binaryShaderName) { return false; }
 bool ShaderVariation::Compile() { return false; }
@@ -186,6 +186,8 @@ bool Texture2D::SetData(Image* image, bool useAlpha)
     if (renderer)
         quality = renderer->GetTextureQuality();
 
+    sourceSize_ = IntVector2(image->GetWidth(), image->GetHeight());
+
     if (!image->IsCompressed())
     {
         // Convert unsuitable formats to RGBA
@@ -204,7 +206,8 @@ bool Texture2D::SetData(Image* image, bool useAlpha)
         unsigned format = 0;
 
         // Discard unnecessary mip levels
-        for (unsigned i = 0; i < mipsToSkip_[quality]; ++i)
+        const unsigned mipsToSkip = Max(mipsToSkip_[quality], streamingMipsToSkip_);
+        for (unsigned i = 0; i < mipsToSkip && (image->GetWidth() > 1 || image->GetHeight() > 1); ++i)
         {
             mipImage = image->GetNextLevel(); image = mipImage;
             levelData = image->GetData();
@@ -274,6 +277,7 @@ bool Texture2D::SetData(Image* image, bool useAlpha)
         unsigned mipsToSkip = 0;
         if (quality < URHO3D_ARRAYSIZE(mipsToSkip_))
             mipsToSkip = mipsToSkip_[quality];
+        mipsToSkip = Max(mipsToSkip, streamingMipsToSkip_);
         if (mipsToSkip >= levels)
             mipsToSkip = levels - 1;
         while (mipsToSkip && (width / (1u << mipsToSkip) < 4 || height / (1u << mipsToSkip) < 4))
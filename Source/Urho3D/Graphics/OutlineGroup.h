@@ -61,6 +61,7 @@ public:
     /// Manage collection.
     /// @{
     bool HasDrawables() const { return !drawables_.empty(); }
+    const ea::unordered_set<WeakPtr<Drawable>>& GetDrawables() const { return drawables_; }
     bool ContainsDrawable(Drawable* drawable) const { return drawables_.find_as(drawable) != drawables_.end(); }
     void ClearDrawables();
     /// Check if Drawable is present in group.
@@ -71,6 +71,7 @@ void ParticleEmitter::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Draw Distance", GetDrawDistance, SetDrawDistance, float, 0.0f, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Shadow Distance", GetShadowDistance, SetShadowDistance, float, 0.0f, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Animation LOD Bias", GetAnimationLodBias, SetAnimationLodBias, float, 1.0f, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Expand On GPU", IsExpandedOnGPU, SetExpandOnGPU, bool, false, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Is Emitting", bool, emitting_, true, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Period Timer", float, periodTimer_, 0.0f, AM_DEFAULT | AM_NOEDIT);
     URHO3D_ATTRIBUTE("Emission Timer", float, emissionTimer_, 0.0f, AM_DEFAULT | AM_NOEDIT);
@@ -23,10 +23,14 @@
 #include "../Graphics/PipelineState.h"
 
 #include "../Core/Context.h"
+#include "../Core/CoreEvents.h"
+#include "../Core/Profiler.h"
 #include "../Core/Thread.h"
+#include "../Core/Timer.h"
 #include "../IO/Log.h"
 #include "../Graphics/Geometry.h"
 #include "../Graphics/Graphics.h"
+#include "../Graphics/PipelineStatePrecache.h"
 #include "../Graphics/Shader.h"
 #include "../Resource/ResourceEvents.h"
 
@@ -125,11 +129,14 @@ void PipelineState::Apply(Graphics* graphics)
 PipelineStateCache::PipelineStateCache(Context* context)
     : Object(context)
     , GPUObject(GetSubsystem<Graphics>())
+    , requestsMetric_(GetMetricCounter(context, "urho3d_pipeline_state_requests_total", "Number of pipeline state cache lookups"))
+    , missesMetric_(GetMetricCounter(context, "urho3d_pipeline_state_misses_total", "Number of pipeline states created on cache miss"))
 {
     SubscribeToEvent(E_RELOADFINISHED, &PipelineStateCache::HandleResourceReload);
+    SubscribeToEvent(E_BEGINFRAME, [this](StringHash, VariantMap&) { ProcessPendingStates(); });
 }
 
-SharedPtr<PipelineState> PipelineStateCache::GetPipelineState(PipelineStateDesc desc)
+SharedPtr<PipelineState> PipelineStateCache::GetPipelineState(PipelineStateDesc desc, bool allowAsync)
 {
     if (!desc.IsInitialized())
         return nullptr;
@@ -138,16 +145,108 @@ SharedPtr<PipelineState> PipelineStateCache::GetPipelineState(PipelineStateDesc
 
     WeakPtr<PipelineState>& weakPipelineState = states_[desc];
     SharedPtr<PipelineState> pipelineState = weakPipelineState.Lock();
-    if (!pipelineState)
+    const bool isNew = !pipelineState;
+    requestsMetric_->Increment();
+    if (isNew)
     {
+        missesMetric_->Increment();
         pipelineState = MakeShared<PipelineState>(this);
         pipelineState->Setup(desc);
         weakPipelineState = pipelineState;
+
+        if (precache_)
+            precache_->StorePipelineState(desc);
     }
+
+    if (asyncCompilation_ && allowAsync)
+    {
+        if (isNew)
+        {
+            pipelineState->SetPending(true);
+            pendingStates_.emplace_back(pipelineState);
+        }
+        if (pipelineState->IsPending())
+            return pipelineState;
+    }
+
+    pipelineState->SetPending(false);
     pipelineState->RestoreCachedState(graphics_);
     return pipelineState;
 }
 
+void PipelineStateCache::ProcessPendingStates()
+{
+    if (pendingStates_.empty() || !graphics_ || graphics_->IsDeviceLost())
+        return;
+
+    URHO3D_PROFILE("CompilePendingPipelineStates");
+
+    const long long budgetUs = static_cast<long long>(asyncCompilationBudget_ * 1000.0f);
+    HiresTimer timer;
+
+    unsigned numProcessed = 0;
+    while (numProcessed < pendingStates_.size())
+    {
+        SharedPtr<PipelineState> pipelineState = pendingStates_[numProcessed++].Lock();
+        if (!pipelineState || !pipelineState->IsPending())
+            continue;
+
+        pipelineState->SetPending(false);
+        pipelineState->RestoreCachedState(graphics_);
+
+        if (timer.GetUSec(false) >= budgetUs)
+            break;
+    }
+
+    pendingStates_.erase(pendingStates_.begin(), pendingStates_.begin() + numProcessed);
+}
+
+void PipelineStateCache::SetAsyncCompilation(bool enable)
+{
+    asyncCompilation_ = enable;
+
+    // Don't leave states pending forever if asynchronous compilation is turned off
+    if (!asyncCompilation_)
+    {
+        for (const WeakPtr<PipelineState>& weakPipelineState : pendingStates_)
+        {
+            if (SharedPtr<PipelineState> pipelineState = weakPipelineState.Lock())
+            {
+                pipelineState->SetPending(false);
+                pipelineState->RestoreCachedState(graphics_);
+            }
+        }
+        pendingStates_.clear();
+    }
+}
+
+void PipelineStateCache::BeginDumpPipelineStates(const ea::string& fileName)
+{
+    precache_ = MakeShared<PipelineStatePrecache>(context_, fileName);
+}
+
+void PipelineStateCache::EndDumpPipelineStates()
+{
+    precache_ = nullptr;
+}
+
+void PipelineStateCache::PrecachePipelineStates(Deserializer& source)
+{
+    URHO3D_PROFILE("PrecachePipelineStates");
+
+    if (!graphics_)
+        return;
+
+    const ea::vector<PipelineStateDesc> descs = PipelineStatePrecache::LoadPipelineStates(graphics_, source);
+    for (const PipelineStateDesc& desc : descs)
+    {
+        if (SharedPtr<PipelineState> pipelineState = GetPipelineState(desc, true))
+            precachedStates_.push_back(pipelineState);
+    }
+
+    URHO3D_LOGDEBUG("Precached {} pipeline states", descs.size());
+}
+
 void PipelineStateCache::ReleasePipelineState(const PipelineStateDesc& desc)
 {
     if (states_.erase(desc) != 1)
@@ -167,7 +266,8 @@ void PipelineStateCache::OnDeviceReset()
 {
     for (const auto& item : states_)
     {
-        if (SharedPtr<PipelineState> pipelineState = item.second.Lock())
+        SharedPtr<PipelineState> pipelineState = item.second.Lock();
+        if (pipelineState && !pipelineState->IsPending())
             pipelineState->RestoreCachedState(graphics_);
     }
 }
@@ -179,13 +279,22 @@ void PipelineStateCache::Release()
 
 void PipelineStateCache::HandleResourceReload(StringHash /*eventType*/, VariantMap& /*eventData*/)
 {
-    if (context_->GetEventSender()->GetType() == Shader::GetTypeStatic())
+    auto shader = dynamic_cast<Shader*>(context_->GetEventSender());
+    if (!shader)
+        return;
+
+    // Only states that use variations of the reloaded shader are affected
+    const auto usesShader = [shader](const ShaderVariation* variation)
+    { return variation && variation->GetOwner() == shader; };
+
+    for (const auto& [desc, weakPipelineState] : states_)
     {
-        for (const auto& item : states_)
-        {
-            if (SharedPtr<PipelineState> pipelineState = item.second.Lock())
-                pipelineState->RestoreCachedState(graphics_);
-        }
+        if (!usesShader(desc.vertexShader_) && !usesShader(desc.pixelShader_))
+            continue;
+
+        SharedPtr<PipelineState> pipelineState = weakPipelineState.Lock();
+        if (pipelineState && !pipelineState->IsPending())
+            pipelineState->RestoreCachedState(graphics_);
     }
 }
 
@@ -25,6 +25,7 @@
 #include "../Container/IndexAllocator.h"
 #include "../Container/Hash.h"
 #include "../Container/RefCounted.h"
+#include "../Core/Metrics.h"
 #include "../Graphics/GraphicsDefs.h"
 #include "../Graphics/GPUObject.h"
 #include "../Graphics/IndexBuffer.h"
@@ -39,7 +40,9 @@ namespace Urho3D
 {
 
 class Geometry;
+class Deserializer;
 class PipelineStateCache;
+class PipelineStatePrecache;
 class ShaderVariation;
 
 /// Set of input buffers with vertex and index data.
@@ -238,6 +241,7 @@ public:
     void Setup(const PipelineStateDesc& desc);
     void ResetCachedState();
     void RestoreCachedState(Graphics* graphics);
+    void SetPending(bool pending) { pending_ = pending; }
 
     /// Set pipeline state to GPU.
     void Apply(Graphics* graphics);
@@ -245,6 +249,8 @@ public:
     /// Getters
     /// @{
     bool IsValid() const { return !!shaderProgramLayout_; }
+    /// Return whether the state is queued for asynchronous compilation and is not ready yet.
+    bool IsPending() const { return pending_; }
     const PipelineStateDesc& GetDesc() const { return desc_; }
     ShaderProgramLayout* GetShaderProgramLayout() const { return shaderProgramLayout_; }
     unsigned GetShaderID() const { return shaderProgramLayout_->GetObjectID(); }
@@ -254,6 +260,7 @@ private:
     WeakPtr<PipelineStateCache> owner_;
     PipelineStateDesc desc_;
     WeakPtr<ShaderProgramLayout> shaderProgramLayout_{};
+    bool pending_{};
 };
 
 /// Generic pipeline state cache.
@@ -266,7 +273,34 @@ public:
 
     /// Create new or return existing pipeline state. Returned state may be invalid.
     /// Return nullptr if description is malformed.
-    SharedPtr<PipelineState> GetPipelineState(PipelineStateDesc desc);
+    /// If asynchronous compilation is enabled and allowed for this call,
+    /// new state is returned pending and is compiled during one of the following frames.
+    SharedPtr<PipelineState> GetPipelineState(PipelineStateDesc desc, bool allowAsync = false);
+    /// Compile pending pipeline states within time budget. Called automatically at the beginning of the frame.
+    void ProcessPendingStates();
+
+    /// Set whether to compile new pipeline states asynchronously when allowed by the caller.
+    void SetAsyncCompilation(bool enable);
+    /// Set time budget in milliseconds for compiling pending pipeline states per frame.
+    /// At least one pending state is compiled every frame regardless of the budget.
+    void SetAsyncCompilationBudget(float budgetMs) { asyncCompilationBudget_ = budgetMs; }
+    /// Return whether asynchronous compilation is enabled.
+    bool GetAsyncCompilation() const { return asyncCompilation_; }
+    /// Return time budget for compiling pending pipeline states per frame.
+    float GetAsyncCompilationBudget() const { return asyncCompilationBudget_; }
+    /// Return number of pipeline states waiting for compilation.
+    unsigned GetNumPendingStates() const { return pendingStates_.size(); }
+
+    /// Begin collecting created pipeline states to binary manifest. Existing states in the file are kept.
+    void BeginDumpPipelineStates(const ea::string& fileName);
+    /// End collecting pipeline states and write the manifest.
+    void EndDumpPipelineStates();
+    /// Create pipeline states from manifest generated with BeginDumpPipelineStates().
+    /// If asynchronous compilation is enabled, states are compiled in the following frames within time budget.
+    /// Created states are kept alive until ReleasePrecachedPipelineStates() is called.
+    void PrecachePipelineStates(Deserializer& source);
+    /// Release references to precached pipeline states. States still in use are not affected.
+    void ReleasePrecachedPipelineStates() { precachedStates_.clear(); }
 
     /// Internal. Remove pipeline state with given description from cache.
     void ReleasePipelineState(const PipelineStateDesc& desc);
@@ -282,6 +316,25 @@ private:
     void HandleResourceReload(StringHash eventType, VariantMap& eventData);
 
     ea::unordered_map<PipelineStateDesc, WeakPtr<PipelineState>> states_;
+
+    /// Asynchronous compilation
+    /// @{
+    bool asyncCompilation_{};
+    float asyncCompilationBudget_{2.0f};
+    ea::vector<WeakPtr<PipelineState>> pendingStates_;
+    /// @}
+
+    /// Precaching
+    /// @{
+    SharedPtr<PipelineStatePrecache> precache_;
+    ea::vector<SharedPtr<PipelineState>> precachedStates_;
+    /// @}
+
+    /// Metrics
+    /// @{
+    SharedPtr<MetricCounter> requestsMetric_;
+    SharedPtr<MetricCounter> missesMetric_;
+    /// @}
 };
 
 }
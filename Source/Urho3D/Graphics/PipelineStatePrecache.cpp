@@ -0,0 +1,235 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Graphics/Graphics.h"
+#include "../Graphics/PipelineStatePrecache.h"
+#include "../Graphics/ShaderVariation.h"
+#include "../IO/File.h"
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
+#include "../IO/VectorBuffer.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+static const char* manifestFileID = "UPSM";
+static const unsigned manifestVersion = 1;
+
+void WriteShader(Serializer& dest, ShaderVariation* shader)
+{
+    dest.WriteString(shader->GetName());
+    dest.WriteString(shader->GetDefines());
+}
+
+ShaderVariation* ReadShader(Graphics* graphics, Deserializer& source, ShaderType type)
+{
+    const ea::string name = source.ReadString();
+    const ea::string defines = source.ReadString();
+    return graphics->GetShader(type, name, defines);
+}
+
+}
+
+PipelineStatePrecache::PipelineStatePrecache(Context* context, const ea::string& fileName)
+    : Object(context)
+    , fileName_(fileName)
+{
+    if (GetSubsystem<FileSystem>()->FileExists(fileName))
+    {
+        // If file exists, read the already listed states
+        File source(context_, fileName);
+        if (source.ReadFileID() == manifestFileID && source.ReadUInt() == manifestVersion)
+        {
+            const unsigned numStates = source.ReadVLE();
+            for (unsigned i = 0; i < numStates && !source.IsEof(); ++i)
+            {
+                const ByteVector buffer = source.ReadBuffer();
+                ea::string state(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+                if (usedStates_.insert(state).second)
+                    serializedStates_.push_back(ea::move(state));
+            }
+        }
+        else
+            URHO3D_LOGWARNING("Pipeline state manifest {} is malformed or outdated and will be overwritten", fileName_);
+    }
+
+    URHO3D_LOGINFO("Begin dumping pipeline states to " + fileName_);
+}
+
+PipelineStatePrecache::~PipelineStatePrecache()
+{
+    URHO3D_LOGINFO("End dumping pipeline states");
+
+    if (serializedStates_.empty())
+        return;
+
+    File dest(context_, fileName_, FILE_WRITE);
+    dest.WriteFileID(manifestFileID);
+    dest.WriteUInt(manifestVersion);
+    dest.WriteVLE(serializedStates_.size());
+    for (const ea::string& state : serializedStates_)
+    {
+        dest.WriteVLE(state.size());
+        dest.Write(state.data(), state.size());
+    }
+}
+
+void PipelineStatePrecache::StorePipelineState(const PipelineStateDesc& desc)
+{
+    if (!desc.IsInitialized())
+        return;
+
+    // Check for duplicate using pointers first (fast)
+    if (!usedDescs_.insert(desc).second)
+        return;
+
+    // Check for duplicate using serialized state (needed for states loaded from existing file)
+    VectorBuffer buffer;
+    WriteDesc(buffer, desc);
+    ea::string state(reinterpret_cast<const char*>(buffer.GetData()), buffer.GetSize());
+    if (usedStates_.insert(state).second)
+        serializedStates_.push_back(ea::move(state));
+}
+
+ea::vector<PipelineStateDesc> PipelineStatePrecache::LoadPipelineStates(Graphics* graphics, Deserializer& source)
+{
+    ea::vector<PipelineStateDesc> result;
+    if (source.ReadFileID() != manifestFileID || source.ReadUInt() != manifestVersion)
+    {
+        URHO3D_LOGERROR("Pipeline state manifest {} is malformed or outdated", source.GetName());
+        return result;
+    }
+
+    const unsigned numStates = source.ReadVLE();
+    result.reserve(numStates);
+    for (unsigned i = 0; i < numStates && !source.IsEof(); ++i)
+    {
+        const ByteVector buffer = source.ReadBuffer();
+        MemoryBuffer stateSource(buffer);
+
+        PipelineStateDesc desc;
+        if (ReadDesc(graphics, stateSource, desc))
+            result.push_back(desc);
+    }
+
+    return result;
+}
+
+void PipelineStatePrecache::WriteDesc(Serializer& dest, const PipelineStateDesc& desc)
+{
+    dest.WriteUByte(static_cast<unsigned char>(desc.primitiveType_));
+
+    dest.WriteUByte(static_cast<unsigned char>(desc.numVertexElements_));
+    for (unsigned i = 0; i < desc.numVertexElements_; ++i)
+    {
+        const VertexElement& element = desc.vertexElements_[i];
+        dest.WriteUByte(static_cast<unsigned char>(element.type_));
+        dest.WriteUByte(static_cast<unsigned char>(element.semantic_));
+        dest.WriteUByte(element.index_);
+        dest.WriteBool(element.perInstance_);
+        dest.WriteVLE(element.offset_);
+    }
+    dest.WriteUByte(static_cast<unsigned char>(desc.indexType_));
+
+    WriteShader(dest, desc.vertexShader_);
+    WriteShader(dest, desc.pixelShader_);
+
+    dest.WriteBool(desc.depthWriteEnabled_);
+    dest.WriteBool(desc.stencilTestEnabled_);
+    dest.WriteUByte(static_cast<unsigned char>(desc.depthCompareFunction_));
+    dest.WriteUByte(static_cast<unsigned char>(desc.stencilCompareFunction_));
+    dest.WriteUByte(static_cast<unsigned char>(desc.stencilOperationOnPassed_));
+    dest.WriteUByte(static_cast<unsigned char>(desc.stencilOperationOnStencilFailed_));
+    dest.WriteUByte(static_cast<unsigned char>(desc.stencilOperationOnDepthFailed_));
+    dest.WriteUInt(desc.stencilReferenceValue_);
+    dest.WriteUInt(desc.stencilCompareMask_);
+    dest.WriteUInt(desc.stencilWriteMask_);
+
+    dest.WriteUByte(static_cast<unsigned char>(desc.fillMode_));
+    dest.WriteUByte(static_cast<unsigned char>(desc.cullMode_));
+    dest.WriteFloat(desc.constantDepthBias_);
+    dest.WriteFloat(desc.slopeScaledDepthBias_);
+    dest.WriteBool(desc.scissorTestEnabled_);
+    dest.WriteBool(desc.lineAntiAlias_);
+
+    dest.WriteBool(desc.colorWriteEnabled_);
+    dest.WriteUByte(static_cast<unsigned char>(desc.blendMode_));
+    dest.WriteBool(desc.alphaToCoverageEnabled_);
+}
+
+bool PipelineStatePrecache::ReadDesc(Graphics* graphics, Deserializer& source, PipelineStateDesc& desc)
+{
+    desc.primitiveType_ = static_cast<PrimitiveType>(source.ReadUByte());
+
+    desc.numVertexElements_ = source.ReadUByte();
+    if (desc.numVertexElements_ > PipelineStateDesc::MaxNumVertexElements)
+        return false;
+    for (unsigned i = 0; i < desc.numVertexElements_; ++i)
+    {
+        VertexElement& element = desc.vertexElements_[i];
+        element.type_ = static_cast<VertexElementType>(source.ReadUByte());
+        element.semantic_ = static_cast<VertexElementSemantic>(source.ReadUByte());
+        element.index_ = source.ReadUByte();
+        element.perInstance_ = source.ReadBool();
+        element.offset_ = source.ReadVLE();
+    }
+    desc.indexType_ = static_cast<IndexBufferType>(source.ReadUByte());
+
+    desc.vertexShader_ = ReadShader(graphics, source, VS);
+    desc.pixelShader_ = ReadShader(graphics, source, PS);
+
+    desc.depthWriteEnabled_ = source.ReadBool();
+    desc.stencilTestEnabled_ = source.ReadBool();
+    desc.depthCompareFunction_ = static_cast<CompareMode>(source.ReadUByte());
+    desc.stencilCompareFunction_ = static_cast<CompareMode>(source.ReadUByte());
+    desc.stencilOperationOnPassed_ = static_cast<StencilOp>(source.ReadUByte());
+    desc.stencilOperationOnStencilFailed_ = static_cast<StencilOp>(source.ReadUByte());
+    desc.stencilOperationOnDepthFailed_ = static_cast<StencilOp>(source.ReadUByte());
+    desc.stencilReferenceValue_ = source.ReadUInt();
+    desc.stencilCompareMask_ = source.ReadUInt();
+    desc.stencilWriteMask_ = source.ReadUInt();
+
+    desc.fillMode_ = static_cast<FillMode>(source.ReadUByte());
+    desc.cullMode_ = static_cast<CullMode>(source.ReadUByte());
+    desc.constantDepthBias_ = source.ReadFloat();
+    desc.slopeScaledDepthBias_ = source.ReadFloat();
+    desc.scissorTestEnabled_ = source.ReadBool();
+    desc.lineAntiAlias_ = source.ReadBool();
+
+    desc.colorWriteEnabled_ = source.ReadBool();
+    desc.blendMode_ = static_cast<BlendMode>(source.ReadUByte());
+    desc.alphaToCoverageEnabled_ = source.ReadBool();
+
+    // Shaders may be missing if the manifest is older than the data
+    return desc.IsInitialized();
+}
+
+}
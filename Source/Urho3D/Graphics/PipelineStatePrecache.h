@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Core/Object.h"
+#include "../Graphics/PipelineState.h"
+
+#include <EASTL/hash_set.h>
+
+namespace Urho3D
+{
+
+class Deserializer;
+class Graphics;
+class Serializer;
+
+/// Utility class for collecting pipeline states created during runtime, so they can be created ahead of time later.
+/// States are stored in compact binary manifest.
+class URHO3D_API PipelineStatePrecache : public Object
+{
+    URHO3D_OBJECT(PipelineStatePrecache, Object);
+
+public:
+    /// Construct and begin collecting pipeline states. Load existing states from manifest if the file exists.
+    PipelineStatePrecache(Context* context, const ea::string& fileName);
+    /// Destruct. Write the collected pipeline states to manifest.
+    ~PipelineStatePrecache() override;
+
+    /// Collect a pipeline state. Called by PipelineStateCache when new state is created.
+    void StorePipelineState(const PipelineStateDesc& desc);
+
+    /// Read pipeline state descriptions from manifest. Shaders are resolved via Graphics.
+    static ea::vector<PipelineStateDesc> LoadPipelineStates(Graphics* graphics, Deserializer& source);
+
+private:
+    /// Write pipeline state description.
+    static void WriteDesc(Serializer& dest, const PipelineStateDesc& desc);
+    /// Read pipeline state description. Return false if manifest is malformed.
+    static bool ReadDesc(Graphics* graphics, Deserializer& source, PipelineStateDesc& desc);
+
+    /// Manifest file name.
+    ea::string fileName_;
+    /// Already encountered states, pointer version for fast queries.
+    ea::hash_set<PipelineStateDesc> usedDescs_;
+    /// Already encountered states in serialized form (needed for states loaded from existing file).
+    ea::hash_set<ea::string> usedStates_;
+    /// Serialized states in order of appearance.
+    ea::vector<ea::string> serializedStates_;
+};
+
+}
@@ -27,7 +27,10 @@
 #include "../Graphics/DebugRenderer.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/GraphicsEvents.h"
+#include "../Graphics/Octree.h"
+#include "../Graphics/OctreeQuery.h"
 #include "../Graphics/ReflectionProbe.h"
+#include "../Graphics/Renderer.h"
 #include "../Graphics/TextureCube.h"
 #include "../IO/FileSystem.h"
 #include "../RenderPipeline/RenderPipeline.h"
@@ -35,6 +38,7 @@
 #include "../Resource/XMLElement.h"
 #include "../Resource/XMLFile.h"
 #include "../Scene/Node.h"
+#include "../Scene/Scene.h"
 
 namespace Urho3D
 {
@@ -148,6 +152,12 @@ void QueryBVH(ea::vector<const ReflectionProbeBVH*>& intersections,
     }
 }
 
+float GetProbeDistance(ReflectionProbe* probe, const Vector3& position)
+{
+    const BoundingBox worldBoundingBox = probe->GetBoundingBox().Transformed(probe->GetNode()->GetWorldTransform());
+    return worldBoundingBox.DistanceToPoint(position);
+}
+
 }
 
 InternalReflectionProbeData::InternalReflectionProbeData(ReflectionProbe* probe)
@@ -199,6 +209,8 @@ void ReflectionProbeManager::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Query Padding", float, queryPadding_, DefaultQueryPadding, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Render Budget", unsigned, renderBudget_, DefaultRenderBudget, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Filter Cubemaps", bool, filterCubemaps_, true, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Max Realtime Distance", float, maxRealtimeDistance_, DefaultMaxRealtimeDistance, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Skip Unchanged Probes", bool, skipUnchangedProbes_, false, AM_DEFAULT);
 }
 
 void ReflectionProbeManager::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
@@ -273,8 +285,7 @@ void ReflectionProbeManager::Update()
     for (InternalReflectionProbeData& probeData : spatial_.movableProbes_)
         probeData.Update();
 
-    for (ReflectionProbe* probe : autoQueue_.realtimeProbes_)
-        QueueProbeUpdate(probe);
+    QueueRealtimeProbes();
 
     if (updateQueue_.empty())
         FillUpdateQueue();
@@ -311,9 +322,34 @@ void ReflectionProbeManager::UpdateAutoQueueCache()
             autoQueue_.realtimeProbes_.push_back(reflectionProbe);
     }
 
+    autoQueue_.contentHashes_.clear();
+    autoQueue_.contentHashes_.resize(autoQueue_.realtimeProbes_.size());
     autoQueue_.dirty_ = false;
 }
 
+void ReflectionProbeManager::QueueRealtimeProbes()
+{
+    Vector3 focusPosition;
+    const bool checkDistance = maxRealtimeDistance_ > 0.0f && GetFocusPosition(focusPosition);
+
+    for (unsigned i = 0; i < autoQueue_.realtimeProbes_.size(); ++i)
+    {
+        ReflectionProbe* probe = autoQueue_.realtimeProbes_[i];
+        if (checkDistance && GetProbeDistance(probe, focusPosition) > maxRealtimeDistance_)
+            continue;
+
+        if (skipUnchangedProbes_)
+        {
+            const unsigned contentHash = CalculateContentHash(probe);
+            if (contentHash == autoQueue_.contentHashes_[i])
+                continue;
+            autoQueue_.contentHashes_[i] = contentHash;
+        }
+
+        QueueProbeUpdate(probe);
+    }
+}
+
 void ReflectionProbeManager::FillUpdateQueue()
 {
     for (const auto& probe : probesToUpdate_)
@@ -325,6 +361,55 @@ void ReflectionProbeManager::FillUpdateQueue()
         updateQueue_.push_back(QueuedReflectionProbe{probe, ea::move(cubemapRenderer)});
     }
     probesToUpdate_.clear();
+
+    // Update probes closest to the camera first, so they are not delayed if the budget is exceeded
+    Vector3 focusPosition;
+    if (GetFocusPosition(focusPosition))
+    {
+        ea::stable_sort(updateQueue_.begin(), updateQueue_.end(),
+            [&](const QueuedReflectionProbe& lhs, const QueuedReflectionProbe& rhs)
+        {
+            return GetProbeDistance(lhs.probe_, focusPosition) < GetProbeDistance(rhs.probe_, focusPosition);
+        });
+    }
+}
+
+bool ReflectionProbeManager::GetFocusPosition(Vector3& position) const
+{
+    auto renderer = GetSubsystem<Renderer>();
+    Viewport* viewport = renderer ? renderer->GetViewportForScene(GetScene(), 0) : nullptr;
+    Camera* camera = viewport ? viewport->GetCamera() : nullptr;
+    if (!camera || !camera->GetNode())
+        return false;
+
+    position = camera->GetNode()->GetWorldPosition();
+    return true;
+}
+
+unsigned ReflectionProbeManager::CalculateContentHash(ReflectionProbe* probe) const
+{
+    Scene* scene = GetScene();
+    auto octree = scene ? scene->GetComponent<Octree>() : nullptr;
+    if (!octree)
+        return 0;
+
+    Node* node = probe->GetNode();
+    const BoundingBox worldBoundingBox = probe->GetBoundingBox().Transformed(node->GetWorldTransform());
+    const unsigned viewMask = probe->GetCubemapRenderingSettings().viewMask_;
+
+    tempDrawables_.clear();
+    BoxOctreeQuery query(tempDrawables_, worldBoundingBox, DRAWABLE_GEOMETRY | DRAWABLE_LIGHT, viewMask);
+    octree->GetDrawables(query);
+
+    // Changes of materials and light parameters are not tracked, only movement of objects
+    unsigned hash = node->GetWorldPosition().ToHash();
+    for (Drawable* drawable : tempDrawables_)
+    {
+        CombineHash(hash, MakeHash(drawable));
+        CombineHash(hash, drawable->GetWorldBoundingBox().min_.ToHash());
+        CombineHash(hash, drawable->GetWorldBoundingBox().max_.ToHash());
+    }
+    return ea::max(hash, 1u);
 }
 
 void ReflectionProbeManager::ConsumeUpdateQueue()
@@ -81,6 +81,7 @@ public:
     using ReflectionProbeSpan = TransformedSpan<TrackedComponentBase* const, ReflectionProbe* const, StaticCaster<ReflectionProbe* const>>;
     static constexpr float DefaultQueryPadding = 2.0f;
     static constexpr unsigned DefaultRenderBudget = 6;
+    static constexpr float DefaultMaxRealtimeDistance = 0.0f;
 
     explicit ReflectionProbeManager(Context* context);
     ~ReflectionProbeManager() override;
@@ -119,9 +120,15 @@ protected:
 private:
     void UpdateSpatialCache();
     void UpdateAutoQueueCache();
+    void QueueRealtimeProbes();
     void FillUpdateQueue();
     void ConsumeUpdateQueue();
 
+    /// Return position of the camera used to prioritize probe updates. Return false if there is no camera.
+    bool GetFocusPosition(Vector3& position) const;
+    /// Return hash of probe position and drawables inside of the probe volume.
+    unsigned CalculateContentHash(ReflectionProbe* probe) const;
+
     void RestoreCubemaps();
 
     ea::string GetBakedProbeFilePath() const;
@@ -147,6 +154,8 @@ private:
     {
         bool dirty_{};
         ea::vector<ReflectionProbe*> realtimeProbes_;
+        /// Content hashes as of last queued update, zero if unknown.
+        ea::vector<unsigned> contentHashes_;
     } autoQueue_;
 
     static constexpr unsigned MaxStaticUpdates = 1;
@@ -156,10 +165,15 @@ private:
     float queryPadding_{DefaultQueryPadding};
     unsigned renderBudget_{DefaultRenderBudget};
     bool filterCubemaps_{true};
+    /// Realtime probes farther from the camera are not updated. Zero means no limit.
+    float maxRealtimeDistance_{DefaultMaxRealtimeDistance};
+    /// Whether to skip realtime probes if their contents didn't change since last update.
+    bool skipUnchangedProbes_{};
 
     ea::unordered_set<WeakPtr<ReflectionProbe>> probesToUpdate_;
     ea::vector<QueuedReflectionProbe> updateQueue_;
     ea::vector<QueuedReflectionProbe> frameUpdates_;
+    mutable ea::vector<Drawable*> tempDrawables_;
 };
 
 /// Type of reflection probe.
@@ -587,6 +587,12 @@ void Renderer::SetNumSoftwareSkinningBones(unsigned numBones)
     numSoftwareSkinningBones_ = numBones;
 }
 
+void Renderer::SetAnimationLodSettings(const AnimationLodSettings& settings)
+{
+    animationLodSettings_ = settings;
+    animationLodRateScale_ = 1;
+}
+
 void Renderer::SetOccluderSizeThreshold(float screenSize)
 {
     occluderSizeThreshold_ = Max(screenSize, 0.0f);
@@ -612,9 +618,34 @@ void Renderer::ApplyShadowMapFilter(View* view, Texture2D* shadowMap, float blur
         (shadowMapFilterInstance_->*shadowMapFilter_)(view, shadowMap, blurScale);
 }
 
-SharedPtr<PipelineState> Renderer::GetOrCreatePipelineState(const PipelineStateDesc& desc)
+void Renderer::SetAsyncPipelineStateCompilation(bool enable)
+{
+    pipelineStateCache_->SetAsyncCompilation(enable);
+}
+
+void Renderer::BeginDumpPipelineStates(const ea::string& fileName)
+{
+    pipelineStateCache_->BeginDumpPipelineStates(fileName);
+}
+
+void Renderer::EndDumpPipelineStates()
+{
+    pipelineStateCache_->EndDumpPipelineStates();
+}
+
+void Renderer::PrecachePipelineStates(Deserializer& source)
 {
-    return pipelineStateCache_->GetPipelineState(desc);
+    pipelineStateCache_->PrecachePipelineStates(source);
+}
+
+SharedPtr<PipelineState> Renderer::GetOrCreatePipelineState(const PipelineStateDesc& desc, bool allowAsync)
+{
+    return pipelineStateCache_->GetPipelineState(desc, allowAsync);
+}
+
+bool Renderer::GetAsyncPipelineStateCompilation() const
+{
+    return pipelineStateCache_->GetAsyncCompilation();
 }
 
 Viewport* Renderer::GetViewport(unsigned index) const
@@ -1617,6 +1648,20 @@ const Rect& Renderer::GetLightScissor(Light* light, Camera* camera)
     }
 }
 
+void Renderer::UpdateAnimationLodRateScale()
+{
+    const unsigned demand = animationLodDemand_.exchange(0, std::memory_order_relaxed);
+    const unsigned budget = animationLodSettings_.boneBudget_;
+
+    // Demand is measured without rate scale, so the scale doesn't oscillate
+    animationLodRateScale_ = 1;
+    if (!animationLodSettings_.enabled_ || budget == 0)
+        return;
+
+    while (demand > budget * animationLodRateScale_ && animationLodRateScale_ < AnimationLodSettings::MaxUpdateInterval)
+        animationLodRateScale_ *= 2;
+}
+
 void Renderer::UpdateQueuedViewport(unsigned index)
 {
     WeakPtr<RenderSurface> renderTarget = queuedViewports_[index].first;
@@ -1788,7 +1833,9 @@ void Renderer::Initialize()
     SubscribeToEvent(E_RENDERUPDATE, URHO3D_HANDLER(Renderer, HandleRenderUpdate));
     SubscribeToEvent(E_ENDFRAME, [this](StringHash, VariantMap&)
     {
+        UpdateAnimationLodRateScale();
         frameStats_ = FrameStatistics{};
+        frameStats_.animationLodRateScale_ = animationLodRateScale_;
     });
 
     URHO3D_LOGINFO("Initialized renderer");
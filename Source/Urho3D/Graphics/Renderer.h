@@ -36,9 +36,12 @@
 #include <EASTL/unique_ptr.h>
 #include <EASTL/unordered_set.h>
 
+#include <atomic>
+
 namespace Urho3D
 {
 
+class Deserializer;
 class RenderPipelineView;
 class Geometry;
 class Drawable;
@@ -183,6 +186,34 @@ enum SkinningMode
     SKINNING_AUTO,
     SKINNING_HARDWARE,
     SKINNING_SOFTWARE,
+    /// Skinning and morphing in compute shader if supported, software otherwise.
+    SKINNING_COMPUTE,
+};
+
+/// Settings of budgeted animation LOD for AnimatedModel.
+/// Screen sizes are fractions of viewport height covered by the model.
+struct AnimationLodSettings
+{
+    /// Max interval between animation updates, in frames.
+    static const unsigned MaxUpdateInterval = 8;
+
+    /// Whether animation LOD is enabled. If disabled, animation LOD bias of each model is used.
+    bool enabled_{};
+    /// Models smaller than this are updated every 2nd frame.
+    float halfRateScreenSize_{0.25f};
+    /// Models smaller than this are updated every 4th frame.
+    float quarterRateScreenSize_{0.1f};
+    /// Models smaller than this are not updated at all.
+    float frozenScreenSize_{0.01f};
+    /// Models smaller than this are animated with reduced set of bones.
+    float reducedBonesScreenSize_{0.1f};
+    /// Max depth of bones in hierarchy animated in reduced set. Deeper bones keep their last pose.
+    unsigned reducedBonesMaxDepth_{4};
+    /// Max number of bones evaluated per frame. If exceeded, update intervals are increased. 0 to disable.
+    unsigned boneBudget_{};
+    /// Whether to interpolate animation between updates.
+    /// Interpolated animation is delayed by one update interval.
+    bool interpolate_{true};
 };
 
 /// Statistics collected during the last frame.
@@ -191,6 +222,7 @@ struct FrameStatistics
 {
     unsigned animations_{};
     unsigned changedAnimations_{};
+    unsigned animationLodRateScale_{1};
 };
 
 /// High-level rendering subsystem. Manages drawing of 3D views.
@@ -307,8 +339,21 @@ public:
     void SetSkinningMode(SkinningMode mode);
     /// Set number of bones used for software skinning.
     void SetNumSoftwareSkinningBones(unsigned numBones);
+    /// Set animation LOD settings.
+    void SetAnimationLodSettings(const AnimationLodSettings& settings);
+    /// Add number of bones AnimatedModel wants to evaluate per frame. Safe to call from worker threads.
+    void AddAnimationLodDemand(unsigned numBones) { animationLodDemand_.fetch_add(numBones, std::memory_order_relaxed); }
     /// Force reload of shaders.
     void ReloadShaders();
+    /// Set whether to compile pipeline states of scene batches asynchronously.
+    /// When enabled, batches are not drawn until their pipeline states are compiled in one of the following frames.
+    void SetAsyncPipelineStateCompilation(bool enable);
+    /// Begin collecting created pipeline states to binary manifest.
+    void BeginDumpPipelineStates(const ea::string& fileName);
+    /// End collecting pipeline states and write the manifest.
+    void EndDumpPipelineStates();
+    /// Create pipeline states from manifest generated with BeginDumpPipelineStates().
+    void PrecachePipelineStates(Deserializer& source);
 
     /// Apply post processing filter to the shadow map. Called by View.
     void ApplyShadowMapFilter(View* view, Texture2D* shadowMap, float blurScale);
@@ -317,8 +362,10 @@ public:
     /// @property
     unsigned GetNumViewports() const { return viewports_.size(); }
 
-    /// Return new or existing pipeline state.
-    SharedPtr<PipelineState> GetOrCreatePipelineState(const PipelineStateDesc& desc);
+    /// Return new or existing pipeline state. Returned state may be pending if asynchronous compilation is allowed.
+    SharedPtr<PipelineState> GetOrCreatePipelineState(const PipelineStateDesc& desc, bool allowAsync = false);
+    /// Return whether pipeline states of scene batches are compiled asynchronously.
+    bool GetAsyncPipelineStateCompilation() const;
     /// Return default draw queue that can be used to cook and execute draw commands from main thread.
     DrawCommandQueue* GetDefaultDrawQueue() { return defaultDrawQueue_.Get(); }
     /// Return backbuffer viewport by index.
@@ -444,6 +491,10 @@ public:
 
     /// Return number of bones used for software skinning.
     unsigned GetNumSoftwareSkinningBones() const { return numSoftwareSkinningBones_; }
+    /// Return animation LOD settings.
+    const AnimationLodSettings& GetAnimationLodSettings() const { return animationLodSettings_; }
+    /// Return multiplier of animation update intervals required to stay within bone budget.
+    unsigned GetAnimationLodRateScale() const { return animationLodRateScale_; }
 
     /// Return number of views rendered.
     /// @property
@@ -575,6 +626,8 @@ private:
     void SetIndirectionTextureData();
     /// Update a queued viewport for rendering.
     void UpdateQueuedViewport(unsigned index);
+    /// Update animation LOD rate scale from the demand of the last frame.
+    void UpdateAnimationLodRateScale();
     /// Prepare for rendering of a new view.
     void PrepareViewRender();
     /// Remove unused occlusion and screen buffers.
@@ -747,6 +800,12 @@ private:
     SkinningMode skinningMode_{};
     /// Number of bones used for software skinning.
     unsigned numSoftwareSkinningBones_{ 4 };
+    /// Animation LOD settings.
+    AnimationLodSettings animationLodSettings_;
+    /// Number of bones requested for evaluation during current frame.
+    std::atomic<unsigned> animationLodDemand_{};
+    /// Multiplier of animation update intervals for current frame.
+    unsigned animationLodRateScale_{1};
     /// Pipeline state cache.
     SharedPtr<PipelineStateCache> pipelineStateCache_;
     SharedPtr<DrawCommandQueue> defaultDrawQueue_;
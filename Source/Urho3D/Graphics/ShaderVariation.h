@@ -130,6 +130,9 @@ public:
     /// Return constant buffer data sizes.
     const ConstantBufferSizes& GetConstantBufferSizes() const { return constantBufferSizes_; }
 
+    /// Return hash of the final source code passed to the compiler. Used to cache linked programs on OpenGL, zero otherwise.
+    unsigned GetSourceCodeHash() const;
+
     /// D3D11 vertex semantic names. Used internally.
     static const char* elementSemanticNames[];
 
@@ -157,11 +157,7 @@ void StaticModel::UpdateBatches(const FrameInfo& frame)
     float scale = worldBoundingBox.Size().DotProduct(DOT_SCALE);
     float newLodDistance = frame.camera_->GetLodDistance(distance_, scale, lodBias_);
 
-    if (newLodDistance != lodDistance_)
-    {
-        lodDistance_ = newLodDistance;
-        CalculateLodLevels();
-    }
+    UpdateLodLevels(newLodDistance, frame.frameNumber_);
 }
 
 Geometry* StaticModel::GetLodGeometry(unsigned batchIndex, unsigned level)
@@ -317,7 +313,7 @@ void StaticModel::ApplyMaterialList(const ea::string& fileName)
         return;
 
     const StringVector lines = file->ReadLines();
-    for (unsigned index = 0; index < ea::min(batches_.size(), lines.size()); ++index)
+    for (unsigned index = 0; index < ea::min(geometries_.size(), lines.size()); ++index)
     {
         auto* material = cache->GetResource<Material>(lines[index]);
         if (material)
@@ -386,8 +382,8 @@ void StaticModel::SetMaterialsAttr(const ResourceRefList& value)
     auto* cache = GetSubsystem<ResourceCache>();
     for (unsigned i = 0; i < value.names_.size(); ++i)
         SetMaterial(i, cache->GetResource<Material>(value.names_[i]));
-    for (unsigned i = value.names_.size(); i < batches_.size(); ++i)
-        batches_[i].material_ = nullptr;
+    for (unsigned i = value.names_.size(); i < geometries_.size(); ++i)
+        SetMaterial(i, nullptr);
 }
 
 ResourceRef StaticModel::GetModelAttr() const
@@ -397,8 +393,8 @@ ResourceRef StaticModel::GetModelAttr() const
 
 const ResourceRefList& StaticModel::GetMaterialsAttr() const
 {
-    materialsAttr_.names_.resize(batches_.size());
-    for (unsigned i = 0; i < batches_.size(); ++i)
+    materialsAttr_.names_.resize(geometries_.size());
+    for (unsigned i = 0; i < geometries_.size(); ++i)
         materialsAttr_.names_[i] = GetResourceName(GetMaterial(i));
 
     return materialsAttr_;
@@ -418,6 +414,7 @@ void StaticModel::ResetLodLevels()
             geometries_[i].resize(1);
         batches_[i].geometry_ = GetGeometryIfNotEmpty(geometries_[i][0]);
         geometryData_[i].lodLevel_ = 0;
+        geometryData_[i].desiredLodLevel_ = 0;
     }
 
     // Find out the real LOD levels on next geometry update
@@ -442,7 +439,17 @@ void StaticModel::CalculateLodLevels()
         }
 
         unsigned newLodLevel = j - 1;
-        if (geometryData_[i].lodLevel_ != newLodLevel)
+        geometryData_[i].desiredLodLevel_ = newLodLevel;
+
+        // Fall back to the closest coarser resident LOD level
+        const bool isStreamed = model_ && model_->IsLodStreamed();
+        if (isStreamed)
+        {
+            while (newLodLevel + 1 < batchGeometries.size() && !model_->IsLodResident(i, newLodLevel))
+                ++newLodLevel;
+        }
+
+        if (geometryData_[i].lodLevel_ != newLodLevel || isStreamed)
         {
             geometryData_[i].lodLevel_ = newLodLevel;
             batches_[i].geometry_ = GetGeometryIfNotEmpty(batchGeometries[newLodLevel]);
@@ -450,6 +457,25 @@ void StaticModel::CalculateLodLevels()
     }
 }
 
+void StaticModel::UpdateLodLevels(float newLodDistance, unsigned frameNumber)
+{
+    const bool isStreamed = model_ && model_->IsLodStreamed();
+    const unsigned residencyVersion = isStreamed ? model_->GetLodResidencyVersion() : 0;
+
+    if (newLodDistance != lodDistance_ || residencyVersion != lodResidencyVersion_)
+    {
+        lodDistance_ = newLodDistance;
+        lodResidencyVersion_ = residencyVersion;
+        CalculateLodLevels();
+    }
+
+    if (isStreamed)
+    {
+        for (unsigned i = 0; i < batches_.size(); ++i)
+            model_->RequestLod(i, geometryData_[i].desiredLodLevel_, frameNumber);
+    }
+}
+
 void StaticModel::UpdateBatchesLightmaps()
 {
     if (GetBakeLightmapEffective())
@@ -36,6 +36,8 @@ struct StaticModelGeometryData
     Vector3 center_;
     /// Current LOD level.
     unsigned lodLevel_;
+    /// LOD level chosen by distance. May be not resident if the model is streamed.
+    unsigned desiredLodLevel_;
 };
 
 /// Static model component.
@@ -144,6 +146,8 @@ protected:
     void ResetLodLevels();
     /// Choose LOD levels based on distance.
     void CalculateLodLevels();
+    /// Update LOD levels if LOD distance or residency of model LOD levels changed and request streamed LOD levels.
+    void UpdateLodLevels(float newLodDistance, unsigned frameNumber);
     /// Update lightmaps in batches.
     void UpdateBatchesLightmaps();
 
@@ -155,6 +159,8 @@ protected:
     SharedPtr<Model> model_;
     /// Occlusion LOD level.
     unsigned occlusionLodLevel_;
+    /// Residency version of model LOD levels used to choose current LOD levels.
+    unsigned lodResidencyVersion_{};
     /// Material list attribute.
     mutable ResourceRefList materialsAttr_;
 
@@ -32,6 +32,7 @@
 #include "../Graphics/OctreeQuery.h"
 #include "../Graphics/StaticModelGroup.h"
 #include "../Graphics/VertexBuffer.h"
+#include "../Math/BatchMath.h"
 #include "../Scene/Scene.h"
 
 #include "../DebugNew.h"
@@ -192,11 +193,7 @@ void StaticModelGroup::UpdateBatches(const FrameInfo& frame)
     float scale = worldBoundingBox.Size().DotProduct(DOT_SCALE);
     float newLodDistance = frame.camera_->GetLodDistance(distance_, scale, lodBias_);
 
-    if (newLodDistance != lodDistance_)
-    {
-        lodDistance_ = newLodDistance;
-        CalculateLodLevels();
-    }
+    UpdateLodLevels(newLodDistance, frame.frameNumber_);
 }
 
 unsigned StaticModelGroup::GetNumOccluderTriangles()
@@ -367,23 +364,19 @@ void StaticModelGroup::OnNodeSetEnabled(Node* node)
 
 void StaticModelGroup::OnWorldBoundingBoxUpdate()
 {
-    // Update transforms and bounding box at the same time to have to go through the objects only once
+    // Gather transforms first, then transform the bounding box by all of them in one batch
     unsigned index = 0;
 
-    BoundingBox worldBox;
-
     for (unsigned i = 0; i < instanceNodes_.size(); ++i)
     {
         Node* node = instanceNodes_[i];
         if (!node || !node->IsEnabled())
             continue;
 
-        const Matrix3x4& worldTransform = node->GetWorldTransform();
-        worldTransforms_[index++] = worldTransform;
-        worldBox.Merge(boundingBox_.Transformed(worldTransform));
+        worldTransforms_[index++] = node->GetWorldTransform();
     }
 
-    worldBoundingBox_ = worldBox;
+    worldBoundingBox_ = TransformAndMergeBoundingBox(boundingBox_, worldTransforms_.data(), index);
 
     // Store the amount of valid instances we found instead of resizing worldTransforms_. This is because this function may be
     // called from multiple worker threads simultaneously
@@ -253,6 +253,7 @@ bool Technique::BeginLoad(Deserializer& source)
 {
     passes_.clear();
     cloneTechniques_.clear();
+    MarkRevisionUpdated();
 
     SetMemoryUse(sizeof(Technique));
 
@@ -359,6 +360,7 @@ bool Technique::BeginLoad(Deserializer& source)
 void Technique::SetIsDesktop(bool enable)
 {
     isDesktop_ = enable;
+    MarkRevisionUpdated();
 }
 
 void Technique::ReleaseShaders()
@@ -414,6 +416,7 @@ Pass* Technique::CreatePass(const ea::string& name)
     if (passIndex >= passes_.size())
         passes_.resize(passIndex + 1);
     passes_[passIndex] = newPass;
+    MarkRevisionUpdated();
 
     // Calculate memory use now
     SetMemoryUse((unsigned)(sizeof(Technique) + GetNumPasses() * sizeof(Pass)));
@@ -429,6 +432,7 @@ void Technique::RemovePass(const ea::string& name)
     else if (i->second < passes_.size() && passes_[i->second].Get())
     {
         passes_[i->second].Reset();
+        MarkRevisionUpdated();
         SetMemoryUse((unsigned)(sizeof(Technique) + GetNumPasses() * sizeof(Pass)));
     }
 }
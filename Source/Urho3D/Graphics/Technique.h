@@ -25,6 +25,7 @@
 #pragma once
 
 #include "../Container/Hash.h"
+#include "../Core/ObjectRevisionTracker.h"
 #include "../Graphics/GraphicsDefs.h"
 #include "../Graphics/PipelineStateTracker.h"
 #include "../Resource/Resource.h"
@@ -257,8 +258,8 @@ private:
     ea::string name_;
 };
 
-/// %Material technique. Consists of several passes.
-class URHO3D_API Technique : public Resource
+/// %Material technique. Consists of several passes. Revision is updated whenever the set of passes changes.
+class URHO3D_API Technique : public Resource, public ObjectRevisionTracker
 {
     URHO3D_OBJECT(Technique, Resource);
 
@@ -26,11 +26,14 @@
 #include "../Core/Profiler.h"
 #include "../Graphics/DrawableEvents.h"
 #include "../Graphics/Geometry.h"
+#include "../Graphics/Graphics.h"
 #include "../Graphics/IndexBuffer.h"
 #include "../Graphics/Material.h"
 #include "../Graphics/Octree.h"
+#include "../Graphics/Renderer.h"
 #include "../Graphics/Terrain.h"
 #include "../Graphics/TerrainPatch.h"
+#include "../Graphics/Texture2D.h"
 #include "../Graphics/VertexBuffer.h"
 #include "../IO/Log.h"
 #include "../Resource/Image.h"
@@ -54,6 +57,7 @@ static const unsigned STITCH_NORTH = 1;
 static const unsigned STITCH_SOUTH = 2;
 static const unsigned STITCH_WEST = 4;
 static const unsigned STITCH_EAST = 8;
+static const char* HEIGHTMAP_SHADER_DEFINE = "URHO3D_TERRAIN_HEIGHTMAP";
 
 inline void GrowUpdateRegion(IntRect& updateRegion, int x, int y)
 {
@@ -133,6 +137,7 @@ void Terrain::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("Patch Size", GetPatchSize, SetPatchSizeAttr, int, DEFAULT_PATCH_SIZE, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Max LOD Levels", GetMaxLodLevels, SetMaxLodLevelsAttr, unsigned, MAX_LOD_LEVELS, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Smooth Height Map", bool, smoothing_, MarkTerrainDirty, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("GPU Height Map", GetGpuHeightMap, SetGpuHeightMapAttr, bool, false, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Is Occluder", IsOccluder, SetOccluder, bool, false, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Can Be Occluded", IsOccludee, SetOccludee, bool, true, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Cast Shadows", GetCastShadows, SetCastShadows, bool, false, AM_DEFAULT);
@@ -249,11 +254,7 @@ bool Terrain::SetHeightMap(Image* image)
 void Terrain::SetMaterial(Material* material)
 {
     material_ = material;
-    for (unsigned i = 0; i < patches_.size(); ++i)
-    {
-        if (patches_[i])
-            patches_[i]->SetMaterial(material);
-    }
+    UpdateHeightMapMaterial();
 }
 
 void Terrain::SetNorthNeighbor(Terrain* north)
@@ -482,6 +483,17 @@ void Terrain::SetEnableDebug(bool enable)
     debugGeometry_ = enable;
 }
 
+void Terrain::SetGpuHeightMap(bool enable)
+{
+    if (enable != gpuHeightMap_)
+    {
+        gpuHeightMap_ = enable;
+        lastPatchSize_ = 0; // Force full recreate
+
+        CreateGeometry();
+    }
+}
+
 void Terrain::ApplyHeightMap()
 {
     if (heightMap_)
@@ -498,6 +510,11 @@ Material* Terrain::GetMaterial() const
     return material_;
 }
 
+Texture2D* Terrain::GetHeightTexture() const
+{
+    return heightTexture_;
+}
+
 TerrainPatch* Terrain::GetPatch(unsigned index) const
 {
     return index < patches_.size() ? patches_[index].Get() : nullptr;
@@ -634,6 +651,8 @@ void Terrain::CreatePatchGeometry(TerrainPatch* patch)
 
     auto row = (unsigned)(patchSize_ + 1);
     VertexBuffer* vertexBuffer = patch->GetVertexBuffer();
+    // In GPU height map mode patch vertex buffer is unused, shared grid is rendered instead
+    const bool gpuHeightMap = gridVertexBuffer_ != nullptr;
     Geometry* geometry = patch->GetGeometry();
     Geometry* maxLodGeometry = patch->GetMaxLodGeometry();
     Geometry* occlusionGeometry = patch->GetOcclusionGeometry();
@@ -644,13 +663,18 @@ void Terrain::CreatePatchGeometry(TerrainPatch* patch)
     if (bakeLightmap_)
         vertexMask |= MASK_TEXCOORD2;
 
-    if (vertexBuffer->GetVertexCount() != row * row || vertexBuffer->GetElementMask() != vertexMask)
+    if (gpuHeightMap)
+    {
+        if (vertexBuffer->GetVertexCount() != 0)
+            vertexBuffer->SetSize(0, MASK_POSITION);
+    }
+    else if (vertexBuffer->GetVertexCount() != row * row || vertexBuffer->GetElementMask() != vertexMask)
         vertexBuffer->SetSize(row * row, vertexMask);
 
     ea::shared_array<unsigned char> cpuVertexData(new unsigned char[row * row * sizeof(Vector3)]);
     ea::shared_array<unsigned char> occlusionCpuVertexData(new unsigned char[row * row * sizeof(Vector3)]);
 
-    auto* vertexData = (float*)vertexBuffer->Lock(0, vertexBuffer->GetVertexCount());
+    auto* vertexData = gpuHeightMap ? nullptr : (float*)vertexBuffer->Lock(0, vertexBuffer->GetVertexCount());
     auto* positionData = (float*)cpuVertexData.get();
     auto* occlusionData = (float*)occlusionCpuVertexData.get();
     BoundingBox box;
@@ -659,7 +683,7 @@ void Terrain::CreatePatchGeometry(TerrainPatch* patch)
     if (occlusionLevel > numLodLevels_ - 1)
         occlusionLevel = numLodLevels_ - 1;
 
-    if (vertexData)
+    if (vertexData || gpuHeightMap)
     {
         const IntVector2& coords = patch->GetCoordinates();
         unsigned lodExpand = (1u << (occlusionLevel)) - 1;
@@ -674,9 +698,6 @@ void Terrain::CreatePatchGeometry(TerrainPatch* patch)
 
                 // Position
                 Vector3 position((float)x * spacing_.x_, GetRawHeight(xPos, zPos), (float)z * spacing_.z_);
-                *vertexData++ = position.x_;
-                *vertexData++ = position.y_;
-                *vertexData++ = position.z_;
                 *positionData++ = position.x_;
                 *positionData++ = position.y_;
                 *positionData++ = position.z_;
@@ -702,6 +723,13 @@ void Terrain::CreatePatchGeometry(TerrainPatch* patch)
                 *occlusionData++ = minHeight;
                 *occlusionData++ = position.z_;
 
+                if (!vertexData)
+                    continue;
+
+                *vertexData++ = position.x_;
+                *vertexData++ = position.y_;
+                *vertexData++ = position.z_;
+
                 // Normal
                 Vector3 normal = GetRawNormal(xPos, zPos);
                 *vertexData++ = normal.x_;
@@ -728,7 +756,8 @@ void Terrain::CreatePatchGeometry(TerrainPatch* patch)
             }
         }
 
-        vertexBuffer->Unlock();
+        if (vertexData)
+            vertexBuffer->Unlock();
         vertexBuffer->ClearDataLost();
     }
 
@@ -737,13 +766,17 @@ void Terrain::CreatePatchGeometry(TerrainPatch* patch)
     if (drawRanges_.size())
     {
         unsigned occlusionDrawRange = occlusionLevel << 4u;
+        VertexBuffer* renderVertexBuffer = gpuHeightMap ? gridVertexBuffer_.Get() : vertexBuffer;
 
+        geometry->SetVertexBuffer(0, renderVertexBuffer);
         geometry->SetIndexBuffer(indexBuffer_);
         geometry->SetDrawRange(TRIANGLE_LIST, drawRanges_[0].first, drawRanges_[0].second, false);
         geometry->SetRawVertexData(cpuVertexData, MASK_POSITION);
+        maxLodGeometry->SetVertexBuffer(0, renderVertexBuffer);
         maxLodGeometry->SetIndexBuffer(indexBuffer_);
         maxLodGeometry->SetDrawRange(TRIANGLE_LIST, drawRanges_[0].first, drawRanges_[0].second, false);
         maxLodGeometry->SetRawVertexData(cpuVertexData, MASK_POSITION);
+        occlusionGeometry->SetVertexBuffer(0, renderVertexBuffer);
         occlusionGeometry->SetIndexBuffer(indexBuffer_);
         occlusionGeometry->SetDrawRange(TRIANGLE_LIST, drawRanges_[occlusionDrawRange].first, drawRanges_[occlusionDrawRange].second, false);
         occlusionGeometry->SetRawVertexData(occlusionCpuVertexData, MASK_POSITION);
@@ -754,6 +787,13 @@ void Terrain::CreatePatchGeometry(TerrainPatch* patch)
 
 void Terrain::UpdatePatchLod(TerrainPatch* patch)
 {
+    if (heightTexture_)
+    {
+        if (heightTexture_->IsDataLost())
+            UpdateHeightTexture();
+        UpdateHeightMapMaterialTransform();
+    }
+
     Geometry* geometry = patch->GetGeometry();
 
     // All LOD levels except the coarsest have 16 versions for stitching
@@ -827,6 +867,16 @@ void Terrain::SetOcclusionLodLevelAttr(unsigned value)
     }
 }
 
+void Terrain::SetGpuHeightMapAttr(bool value)
+{
+    if (value != gpuHeightMap_)
+    {
+        gpuHeightMap_ = value;
+        lastPatchSize_ = 0; // Force full recreate
+        recreateTerrain_ = true;
+    }
+}
+
 ResourceRef Terrain::GetMaterialAttr() const
 {
     return GetResourceRef(material_, Material::GetTypeStatic());
@@ -1068,7 +1118,7 @@ void Terrain::CreateGeometry()
 
                         // Copy initial drawable parameters
                         patch->SetEnabled(enabled);
-                        patch->SetMaterial(material_);
+                        patch->SetMaterial(GetPatchMaterial());
                         patch->SetDrawDistance(drawDistance_);
                         patch->SetShadowDistance(shadowDistance_);
                         patch->SetLodBias(lodBias_);
@@ -1131,6 +1181,23 @@ void Terrain::CreateGeometry()
             }
         }
 
+        // Prepare shared resources for GPU height map before patch geometry is created
+        if (IsGpuHeightMapEffective())
+        {
+            if (updateAll || !gridVertexBuffer_)
+                CreateGridVertexBuffer();
+            if (updateAll || !heightTexture_ || ea::find(dirtyPatches.begin(), dirtyPatches.end(), true) != dirtyPatches.end())
+                UpdateHeightTexture();
+            if (updateAll || !heightMapMaterial_)
+                UpdateHeightMapMaterial();
+        }
+        else if (gridVertexBuffer_)
+        {
+            gridVertexBuffer_ = nullptr;
+            heightTexture_ = nullptr;
+            UpdateHeightMapMaterial();
+        }
+
         for (unsigned i = 0; i < patches_.size(); ++i)
         {
             TerrainPatch* patch = patches_[i];
@@ -1503,6 +1570,117 @@ void Terrain::UpdatePatchesLightmaps()
     }
 }
 
+bool Terrain::IsGpuHeightMapEffective() const
+{
+#ifdef DESKTOP_GRAPHICS
+    return gpuHeightMap_ && GetSubsystem<Graphics>();
+#else
+    return false;
+#endif
+}
+
+void Terrain::CreateGridVertexBuffer()
+{
+    URHO3D_PROFILE("CreateGridVertexBuffer");
+
+    const auto row = (unsigned)(patchSize_ + 1);
+    ea::vector<Vector3> positions;
+    positions.reserve(row * row);
+    for (unsigned z = 0; z < row; ++z)
+    {
+        for (unsigned x = 0; x < row; ++x)
+            positions.emplace_back((float)x * spacing_.x_, 0.0f, (float)z * spacing_.z_);
+    }
+
+    if (!gridVertexBuffer_)
+    {
+        // Shadowed buffer is restored automatically on device loss
+        gridVertexBuffer_ = MakeShared<VertexBuffer>(context_);
+        gridVertexBuffer_->SetShadowed(true);
+    }
+
+    gridVertexBuffer_->SetSize(row * row, MASK_POSITION);
+    gridVertexBuffer_->SetData(positions.data());
+}
+
+void Terrain::UpdateHeightTexture()
+{
+    URHO3D_PROFILE("UpdateHeightTexture");
+
+    if (!heightTexture_)
+    {
+        heightTexture_ = MakeShared<Texture2D>(context_);
+        heightTexture_->SetNumLevels(1);
+        heightTexture_->SetFilterMode(FILTER_NEAREST);
+        heightTexture_->SetAddressMode(COORD_U, ADDRESS_CLAMP);
+        heightTexture_->SetAddressMode(COORD_V, ADDRESS_CLAMP);
+    }
+
+    if (heightTexture_->GetWidth() != numVertices_.x_ || heightTexture_->GetHeight() != numVertices_.y_)
+        heightTexture_->SetSize(numVertices_.x_, numVertices_.y_, Graphics::GetFloat32Format());
+
+    heightTexture_->SetData(0, 0, 0, numVertices_.x_, numVertices_.y_, heightData_.get());
+    heightTexture_->ClearDataLost();
+}
+
+void Terrain::UpdateHeightMapMaterial()
+{
+    heightMapMaterial_ = nullptr;
+
+    auto* renderer = GetSubsystem<Renderer>();
+    Material* sourceMaterial = material_ ? material_.Get() : renderer ? renderer->GetDefaultMaterial() : nullptr;
+    if (heightTexture_ && sourceMaterial)
+    {
+        heightMapMaterial_ = sourceMaterial->Clone();
+
+        ea::string vertexDefines = sourceMaterial->GetVertexShaderDefines();
+        if (!vertexDefines.empty())
+            vertexDefines += " ";
+        heightMapMaterial_->SetVertexShaderDefines(vertexDefines + HEIGHTMAP_SHADER_DEFINE);
+#ifdef DESKTOP_GRAPHICS
+        heightMapMaterial_->SetTexture(TU_CUSTOM1, heightTexture_);
+#endif
+
+        // Force update of shader parameters
+        heightMapMaterialTransform_ = Matrix3x4::ZERO;
+        UpdateHeightMapMaterialTransform();
+    }
+
+    Material* patchMaterial = GetPatchMaterial();
+    for (unsigned i = 0; i < patches_.size(); ++i)
+    {
+        if (patches_[i])
+            patches_[i]->SetMaterial(patchMaterial);
+    }
+}
+
+void Terrain::UpdateHeightMapMaterialTransform()
+{
+    if (!heightMapMaterial_ || !node_)
+        return;
+
+    const Matrix3x4& worldTransform = node_->GetWorldTransform();
+    if (worldTransform == heightMapMaterialTransform_)
+        return;
+
+    heightMapMaterialTransform_ = worldTransform;
+
+    // Map world position to terrain space and then to height map grid
+    const Matrix3x4 inverse = worldTransform.Inverse();
+    const Vector4 gridX{inverse.m00_, inverse.m01_, inverse.m02_, inverse.m03_ - patchWorldOrigin_.x_};
+    const Vector4 gridZ{inverse.m20_, inverse.m21_, inverse.m22_, inverse.m23_ - patchWorldOrigin_.y_};
+    const Vector4 terrainSize{static_cast<float>(numVertices_.x_), static_cast<float>(numVertices_.y_), spacing_.x_, spacing_.z_};
+
+    heightMapMaterial_->SetShaderParameter("TerrainGridX", gridX / spacing_.x_);
+    heightMapMaterial_->SetShaderParameter("TerrainGridZ", gridZ / spacing_.z_);
+    heightMapMaterial_->SetShaderParameter("TerrainSize", terrainSize);
+}
+
+Material* Terrain::GetPatchMaterial() const
+{
+    return heightMapMaterial_ ? heightMapMaterial_.Get() : material_.Get();
+}
+
 void Terrain::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
 {
     for (const auto& patch: patches_)
@@ -34,6 +34,8 @@ class IndexBuffer;
 class Material;
 class Node;
 class TerrainPatch;
+class Texture2D;
+class VertexBuffer;
 
 /// Heightmap terrain component.
 class URHO3D_API Terrain : public Component
@@ -126,6 +128,10 @@ public:
     void SetOccludee(bool enable);
     /// Enable drawing debug information. Set this before applying heightmap. Increases memory usage.
     void SetEnableDebug(bool enable);
+    /// Set whether to sample heights from texture in vertex shader.
+    /// Patches share single grid vertex buffer instead of owning vertex buffers. Desktop graphics only.
+    /// @property
+    void SetGpuHeightMap(bool enable);
     /// Apply changes from the heightmap image.
     void ApplyHeightMap();
 
@@ -137,6 +143,13 @@ public:
     /// @property
     const Vector3& GetSpacing() const { return spacing_; }
 
+    /// Return whether heights are sampled from texture in vertex shader.
+    /// @property
+    bool GetGpuHeightMap() const { return gpuHeightMap_; }
+
+    /// Return height texture used by vertex shader. Null unless GPU height map is enabled.
+    Texture2D* GetHeightTexture() const;
+
     /// Return heightmap size in vertices.
     /// @property
     const IntVector2& GetNumVertices() const { return numVertices_; }
@@ -261,6 +274,8 @@ public:
     void SetMaxLodLevelsAttr(unsigned value);
     /// Set occlusion LOD level attribute.
     void SetOcclusionLodLevelAttr(unsigned value);
+    /// Set GPU height map mode attribute.
+    void SetGpuHeightMapAttr(bool value);
     /// Return heightmap attribute.
     ResourceRef GetHeightMapAttr() const;
     /// Return material attribute.
@@ -319,6 +334,18 @@ private:
     void MarkTerrainDirty() { recreateTerrain_ = true; }
     /// Update lightmap settings in patches.
     void UpdatePatchesLightmaps();
+    /// Return whether GPU height map is enabled and supported.
+    bool IsGpuHeightMapEffective() const;
+    /// Create grid vertex buffer shared by all patches in GPU height map mode.
+    void CreateGridVertexBuffer();
+    /// Upload height data to height texture.
+    void UpdateHeightTexture();
+    /// Create material used by patches in GPU height map mode.
+    void UpdateHeightMapMaterial();
+    /// Update shader parameters of GPU height map material if terrain transform changed.
+    void UpdateHeightMapMaterialTransform();
+    /// Return material to be used by patches.
+    Material* GetPatchMaterial() const;
 
     /// Shared index buffer.
     SharedPtr<IndexBuffer> indexBuffer_;
@@ -328,6 +355,16 @@ private:
     ea::shared_array<float> heightData_;
     /// Source height data for smoothing.
     ea::shared_array<float> sourceHeightData_;
+    /// Whether to sample heights from texture in vertex shader.
+    bool gpuHeightMap_{};
+    /// Grid vertex buffer shared by all patches in GPU height map mode.
+    SharedPtr<VertexBuffer> gridVertexBuffer_;
+    /// Height texture sampled in vertex shader.
+    SharedPtr<Texture2D> heightTexture_;
+    /// Material with height texture used by patches in GPU height map mode.
+    SharedPtr<Material> heightMapMaterial_;
+    /// Terrain transform used to calculate shader parameters of GPU height map material.
+    Matrix3x4 heightMapMaterialTransform_;
     /// Material.
     SharedPtr<Material> material_;
     /// Whether the lightmap is enabled.
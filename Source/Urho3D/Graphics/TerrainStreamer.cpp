@@ -0,0 +1,649 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
+#include "../Graphics/Camera.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/Renderer.h"
+#include "../Graphics/Terrain.h"
+#include "../Graphics/TerrainStreamer.h"
+#include "../Graphics/Texture2D.h"
+#include "../Graphics/Viewport.h"
+#include "../IO/Log.h"
+#include "../Resource/Image.h"
+#include "../Resource/ResourceCache.h"
+#include "../Scene/Node.h"
+#include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
+
+#include <EASTL/sort.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+static const Vector3 DEFAULT_SPACING(1.0f, 0.25f, 1.0f);
+static const int DEFAULT_TILE_SIZE = 256;
+static const int DEFAULT_PATCH_SIZE = 32;
+static const int DEFAULT_PAGE_SIZE = 256;
+static const unsigned DEFAULT_LOAD_RADIUS = 2;
+static const unsigned DEFAULT_NEAR_RADIUS = 1;
+static const unsigned DEFAULT_MAX_PENDING_LOADS = 2;
+static const unsigned MAX_SPLAT_LAYERS = 3;
+
+/// Return distance between tiles in tiles.
+unsigned GetTileDistance(const IntVector2& lhs, const IntVector2& rhs)
+{
+    return static_cast<unsigned>(Max(Abs(lhs.x_ - rhs.x_), Abs(lhs.y_ - rhs.y_)));
+}
+
+}
+
+TerrainStreamer::TerrainStreamer(Context* context)
+    : Component(context)
+    , numTiles_(IntVector2::ONE)
+    , tileSize_(DEFAULT_TILE_SIZE)
+    , spacing_(DEFAULT_SPACING)
+    , patchSize_(DEFAULT_PATCH_SIZE)
+    , loadRadius_(DEFAULT_LOAD_RADIUS)
+    , nearRadius_(DEFAULT_NEAR_RADIUS)
+    , layerImagesAttr_(Image::GetTypeStatic())
+    , pageSize_(DEFAULT_PAGE_SIZE)
+    , maxPendingLoads_(DEFAULT_MAX_PENDING_LOADS)
+{
+}
+
+TerrainStreamer::~TerrainStreamer()
+{
+    // Pending loads access the resource cache, wait for them
+    auto workQueue = GetSubsystem<WorkQueue>();
+    for (const auto& pendingLoad : pendingLoads_)
+    {
+        if (pendingLoad->task_ && workQueue)
+            workQueue->WaitForTask(pendingLoad->task_);
+    }
+}
+
+void TerrainStreamer::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<TerrainStreamer>(Category_Geometry);
+
+    URHO3D_ACCESSOR_ATTRIBUTE("Is Enabled", IsEnabled, SetEnabled, bool, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Height Map Pattern", GetHeightMapPattern, SetHeightMapPattern, ea::string, EMPTY_STRING, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Weight Map Pattern", GetWeightMapPattern, SetWeightMapPattern, ea::string, EMPTY_STRING, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Number of Tiles", GetNumTiles, SetNumTiles, IntVector2, IntVector2::ONE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Tile Size", GetTileSize, SetTileSize, int, DEFAULT_TILE_SIZE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Vertex Spacing", GetSpacing, SetSpacing, Vector3, DEFAULT_SPACING, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Patch Size", GetPatchSize, SetPatchSize, int, DEFAULT_PATCH_SIZE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Load Radius", GetLoadRadius, SetLoadRadius, unsigned, DEFAULT_LOAD_RADIUS, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Near Radius", GetNearRadius, SetNearRadius, unsigned, DEFAULT_NEAR_RADIUS, AM_DEFAULT);
+    URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Material", GetMaterialAttr, SetMaterialAttr, ResourceRef,
+        ResourceRef(Material::GetTypeStatic()), AM_DEFAULT);
+    URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Far Material", GetFarMaterialAttr, SetFarMaterialAttr, ResourceRef,
+        ResourceRef(Material::GetTypeStatic()), AM_DEFAULT);
+    URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Layer Images", GetLayerImagesAttr, SetLayerImagesAttr, ResourceRefList,
+        ResourceRefList(Image::GetTypeStatic()), AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Page Size", GetPageSize, SetPageSize, int, DEFAULT_PAGE_SIZE, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max Pending Loads", GetMaxPendingLoads, SetMaxPendingLoads, unsigned, DEFAULT_MAX_PENDING_LOADS, AM_DEFAULT);
+}
+
+void TerrainStreamer::Update()
+{
+    URHO3D_PROFILE("UpdateTerrainStreaming");
+
+    if (tilesDirty_)
+        UnloadTiles();
+
+    Vector3 focusPosition;
+    const bool hasFocus = node_ && !heightMapPattern_.empty() && GetFocusPosition(focusPosition);
+    if (hasFocus)
+        focusTile_ = WorldToTile(focusPosition);
+
+    // Finish completed loads
+    for (const auto& pendingLoad : pendingLoads_)
+    {
+        if (pendingLoad->task_->IsCompleted())
+            FinishLoad(*pendingLoad);
+    }
+    ea::erase_if(pendingLoads_, [](const ea::unique_ptr<PendingLoad>& pendingLoad) { return !pendingLoad->task_; });
+
+    if (!hasFocus)
+        return;
+
+    // Unload distant tiles. Keep one extra tile to avoid reloading when the focus moves back and forth.
+    ea::vector<IntVector2> unloadedTiles;
+    for (const auto& [coordinates, tile] : tiles_)
+    {
+        if (!IsWithinRadius(coordinates, focusTile_, loadRadius_ + 1))
+            unloadedTiles.push_back(coordinates);
+    }
+
+    for (const IntVector2& coordinates : unloadedTiles)
+    {
+        if (Node* tileNode = tiles_[coordinates].node_)
+            tileNode->Remove();
+        tiles_.erase(coordinates);
+        UpdateNeighbors(coordinates);
+    }
+
+    // Switch between splat material and pre-blended page
+    for (auto& [coordinates, tile] : tiles_)
+    {
+        const bool near = IsWithinRadius(coordinates, focusTile_, nearRadius_);
+        if (tile.near_ != near)
+            UpdateTileMaterial(tile, near);
+    }
+
+    // Load missing tiles, closest first
+    ea::vector<IntVector2> requestedTiles;
+    const int radius = static_cast<int>(loadRadius_);
+    for (int z = focusTile_.y_ - radius; z <= focusTile_.y_ + radius; ++z)
+    {
+        for (int x = focusTile_.x_ - radius; x <= focusTile_.x_ + radius; ++x)
+        {
+            const IntVector2 coordinates{x, z};
+            if (x < 0 || z < 0 || x >= numTiles_.x_ || z >= numTiles_.y_)
+                continue;
+            if (tiles_.contains(coordinates) || IsLoading(coordinates))
+                continue;
+            requestedTiles.push_back(coordinates);
+        }
+    }
+
+    ea::sort(requestedTiles.begin(), requestedTiles.end(), [&](const IntVector2& lhs, const IntVector2& rhs)
+    {
+        return GetTileDistance(lhs, focusTile_) < GetTileDistance(rhs, focusTile_);
+    });
+
+    for (const IntVector2& coordinates : requestedTiles)
+    {
+        if (pendingLoads_.size() >= maxPendingLoads_)
+            break;
+        StartLoad(coordinates);
+    }
+}
+
+void TerrainStreamer::UnloadTiles()
+{
+    tilesDirty_ = false;
+
+    for (const auto& pendingLoad : pendingLoads_)
+        pendingLoad->discarded_ = true;
+
+    for (const auto& [coordinates, tile] : tiles_)
+    {
+        if (tile.node_)
+            tile.node_->Remove();
+    }
+    tiles_.clear();
+}
+
+void TerrainStreamer::SetHeightMapPattern(const ea::string& pattern)
+{
+    if (pattern != heightMapPattern_)
+    {
+        heightMapPattern_ = pattern;
+        MarkTilesDirty();
+    }
+}
+
+void TerrainStreamer::SetWeightMapPattern(const ea::string& pattern)
+{
+    if (pattern != weightMapPattern_)
+    {
+        weightMapPattern_ = pattern;
+        MarkTilesDirty();
+    }
+}
+
+void TerrainStreamer::SetNumTiles(const IntVector2& numTiles)
+{
+    const IntVector2 newNumTiles = VectorMax(numTiles, IntVector2::ZERO);
+    if (newNumTiles != numTiles_)
+    {
+        numTiles_ = newNumTiles;
+        MarkTilesDirty();
+    }
+}
+
+void TerrainStreamer::SetTileSize(int size)
+{
+    const int newSize = Max(size, 1);
+    if (newSize != tileSize_)
+    {
+        tileSize_ = newSize;
+        MarkTilesDirty();
+    }
+}
+
+void TerrainStreamer::SetSpacing(const Vector3& spacing)
+{
+    if (spacing != spacing_)
+    {
+        spacing_ = spacing;
+        MarkTilesDirty();
+    }
+}
+
+void TerrainStreamer::SetPatchSize(int size)
+{
+    if (size != patchSize_)
+    {
+        patchSize_ = size;
+        MarkTilesDirty();
+    }
+}
+
+void TerrainStreamer::SetLoadRadius(unsigned radius)
+{
+    loadRadius_ = radius;
+}
+
+void TerrainStreamer::SetNearRadius(unsigned radius)
+{
+    nearRadius_ = radius;
+}
+
+void TerrainStreamer::SetMaterial(Material* material)
+{
+    if (material == material_)
+        return;
+
+    material_ = material;
+
+    // Layer levels depend on detail tiling of the material
+    UpdateLayerLevels();
+    MarkTilesDirty();
+}
+
+void TerrainStreamer::SetFarMaterial(Material* material)
+{
+    if (material == farMaterial_)
+        return;
+
+    // Pages are blended only when there's far material
+    const bool pagesChanged = !farMaterial_ != !material;
+    farMaterial_ = material;
+
+    if (pagesChanged)
+        MarkTilesDirty();
+    else
+    {
+        for (auto& [coordinates, tile] : tiles_)
+            UpdateTileMaterial(tile, tile.near_);
+    }
+}
+
+void TerrainStreamer::SetLayerImages(const ea::vector<SharedPtr<Image>>& images)
+{
+    layerImages_ = images;
+    UpdateLayerLevels();
+    MarkTilesDirty();
+}
+
+void TerrainStreamer::SetPageSize(int size)
+{
+    const int newSize = Max(size, 1);
+    if (newSize != pageSize_)
+    {
+        pageSize_ = newSize;
+        UpdateLayerLevels();
+        MarkTilesDirty();
+    }
+}
+
+Material* TerrainStreamer::GetMaterial() const
+{
+    return material_;
+}
+
+Material* TerrainStreamer::GetFarMaterial() const
+{
+    return farMaterial_;
+}
+
+Vector2 TerrainStreamer::GetTileWorldSize() const
+{
+    return Vector2(spacing_.x_, spacing_.z_) * static_cast<float>(tileSize_);
+}
+
+IntVector2 TerrainStreamer::WorldToTile(const Vector3& worldPosition) const
+{
+    if (!node_)
+        return IntVector2::ZERO;
+
+    const Vector3 position = node_->GetWorldTransform().Inverse() * worldPosition;
+    const Vector2 tileWorldSize = GetTileWorldSize();
+    return IntVector2(FloorToInt(position.x_ / tileWorldSize.x_), FloorToInt(position.z_ / tileWorldSize.y_));
+}
+
+Terrain* TerrainStreamer::GetTileTerrain(const IntVector2& tile) const
+{
+    const auto iter = tiles_.find(tile);
+    return iter != tiles_.end() ? iter->second.terrain_.Get() : nullptr;
+}
+
+void TerrainStreamer::SetMaterialAttr(const ResourceRef& value)
+{
+    auto cache = GetSubsystem<ResourceCache>();
+    SetMaterial(cache->GetResource<Material>(value.name_));
+}
+
+ResourceRef TerrainStreamer::GetMaterialAttr() const
+{
+    return GetResourceRef(material_, Material::GetTypeStatic());
+}
+
+void TerrainStreamer::SetFarMaterialAttr(const ResourceRef& value)
+{
+    auto cache = GetSubsystem<ResourceCache>();
+    SetFarMaterial(cache->GetResource<Material>(value.name_));
+}
+
+ResourceRef TerrainStreamer::GetFarMaterialAttr() const
+{
+    return GetResourceRef(farMaterial_, Material::GetTypeStatic());
+}
+
+void TerrainStreamer::SetLayerImagesAttr(const ResourceRefList& value)
+{
+    auto cache = GetSubsystem<ResourceCache>();
+
+    ea::vector<SharedPtr<Image>> images;
+    for (const ea::string& name : value.names_)
+        images.emplace_back(cache->GetResource<Image>(name));
+    SetLayerImages(images);
+}
+
+const ResourceRefList& TerrainStreamer::GetLayerImagesAttr() const
+{
+    layerImagesAttr_.names_.resize(layerImages_.size());
+    for (unsigned i = 0; i < layerImages_.size(); ++i)
+        layerImagesAttr_.names_[i] = GetResourceName(layerImages_[i]);
+    return layerImagesAttr_;
+}
+
+void TerrainStreamer::OnSceneSet(Scene* scene)
+{
+    if (scene)
+        SubscribeToEvent(scene, E_SCENEUPDATE, URHO3D_HANDLER(TerrainStreamer, HandleSceneUpdate));
+    else
+    {
+        UnsubscribeFromEvent(E_SCENEUPDATE);
+        UnloadTiles();
+    }
+}
+
+bool TerrainStreamer::IsWithinRadius(const IntVector2& tile, const IntVector2& focusTile, unsigned radius)
+{
+    return GetTileDistance(tile, focusTile) <= radius;
+}
+
+ea::string TerrainStreamer::GetTileFileName(const ea::string& pattern, const IntVector2& tile)
+{
+    return pattern.replaced("{x}", ea::to_string(tile.x_)).replaced("{z}", ea::to_string(tile.y_));
+}
+
+bool TerrainStreamer::GetFocusPosition(Vector3& position) const
+{
+    if (focusNode_)
+    {
+        position = focusNode_->GetWorldPosition();
+        return true;
+    }
+
+    auto renderer = GetSubsystem<Renderer>();
+    Viewport* viewport = renderer ? renderer->GetViewportForScene(GetScene(), 0) : nullptr;
+    Camera* camera = viewport ? viewport->GetCamera() : nullptr;
+    if (!camera || !camera->GetNode())
+        return false;
+
+    position = camera->GetNode()->GetWorldPosition();
+    return true;
+}
+
+bool TerrainStreamer::IsLoading(const IntVector2& tile) const
+{
+    return ea::any_of(pendingLoads_.begin(), pendingLoads_.end(), [&](const ea::unique_ptr<PendingLoad>& pendingLoad)
+    {
+        return !pendingLoad->discarded_ && pendingLoad->coordinates_ == tile;
+    });
+}
+
+void TerrainStreamer::StartLoad(const IntVector2& tile)
+{
+    auto cache = GetSubsystem<ResourceCache>();
+    auto workQueue = GetSubsystem<WorkQueue>();
+
+    pendingLoads_.push_back(ea::make_unique<PendingLoad>());
+    PendingLoad& pendingLoad = *pendingLoads_.back();
+    pendingLoad.coordinates_ = tile;
+
+    // Objects are created in the main thread, worker thread only fills them
+    pendingLoad.heightMap_ = MakeShared<Image>(context_);
+    if (!weightMapPattern_.empty())
+        pendingLoad.weightMap_ = MakeShared<Image>(context_);
+    if (farMaterial_ && !layerLevels_.empty())
+    {
+        pendingLoad.layers_ = layerLevels_;
+        pendingLoad.page_ = MakeShared<Image>(context_);
+        pendingLoad.page_->SetSize(pageSize_, pageSize_, 4);
+
+        const Variant& tiling = material_ ? material_->GetShaderParameter("DetailTiling") : Variant::EMPTY;
+        pendingLoad.tiling_ = tiling.GetType() == VAR_VECTOR2 ? tiling.GetVector2() : Vector2::ONE;
+    }
+
+    const ea::string heightMapName = GetTileFileName(heightMapPattern_, tile);
+    const ea::string weightMapName = GetTileFileName(weightMapPattern_, tile);
+    const auto loadData = [cache, heightMapName, weightMapName, &pendingLoad](unsigned)
+    {
+        AbstractFilePtr file = cache->GetFile(heightMapName, false);
+        pendingLoad.success_ = file && pendingLoad.heightMap_->Load(*file);
+
+        if (pendingLoad.weightMap_)
+        {
+            file = cache->GetFile(weightMapName, false);
+            pendingLoad.weightMapLoaded_ = file && pendingLoad.weightMap_->Load(*file)
+                && !pendingLoad.weightMap_->IsCompressed();
+        }
+
+        if (pendingLoad.success_ && pendingLoad.page_)
+            BlendPage(pendingLoad);
+    };
+
+    if (workQueue && workQueue->GetNumThreads() > 0)
+        pendingLoad.task_ = workQueue->PostTask(loadData);
+    else
+    {
+        loadData(0);
+        FinishLoad(pendingLoad);
+        pendingLoads_.pop_back();
+    }
+}
+
+void TerrainStreamer::FinishLoad(PendingLoad& pendingLoad)
+{
+    pendingLoad.task_ = nullptr;
+    if (pendingLoad.discarded_ || !node_)
+        return;
+
+    // Failed tiles are kept empty until unloaded so they are not reloaded every frame
+    const IntVector2& coordinates = pendingLoad.coordinates_;
+    Tile& tile = tiles_[coordinates];
+    if (!pendingLoad.success_)
+    {
+        URHO3D_LOGWARNING("Failed to load height map of terrain tile {}", coordinates.ToString());
+        return;
+    }
+
+    const IntVector2 heightMapSize = pendingLoad.heightMap_->GetSize().ToIntVector2();
+    if (heightMapSize != IntVector2::ONE * (tileSize_ + 1))
+    {
+        URHO3D_LOGWARNING("Height map of terrain tile {} is {}x{}, expected {}x{}", coordinates.ToString(),
+            heightMapSize.x_, heightMapSize.y_, tileSize_ + 1, tileSize_ + 1);
+    }
+
+    if (pendingLoad.weightMapLoaded_)
+    {
+        tile.weightTexture_ = MakeShared<Texture2D>(context_);
+        tile.weightTexture_->SetData(pendingLoad.weightMap_);
+    }
+
+    if (pendingLoad.page_)
+    {
+        tile.pageTexture_ = MakeShared<Texture2D>(context_);
+        tile.pageTexture_->SetData(pendingLoad.page_);
+    }
+
+    const Vector2 tileWorldSize = GetTileWorldSize();
+    Node* tileNode = node_->CreateTemporaryChild(Format("Tile_{}_{}", coordinates.x_, coordinates.y_));
+    tileNode->SetPosition(Vector3((coordinates.x_ + 0.5f) * tileWorldSize.x_, 0.0f, (coordinates.y_ + 0.5f) * tileWorldSize.y_));
+
+    auto terrain = tileNode->CreateComponent<Terrain>();
+    terrain->SetSpacing(spacing_);
+    terrain->SetPatchSize(patchSize_);
+
+    tile.node_ = tileNode;
+    tile.terrain_ = terrain;
+    UpdateTileMaterial(tile, IsWithinRadius(coordinates, focusTile_, nearRadius_));
+
+    terrain->SetHeightMap(pendingLoad.heightMap_);
+    UpdateNeighbors(coordinates);
+}
+
+void TerrainStreamer::BlendPage(PendingLoad& pendingLoad)
+{
+    Image& page = *pendingLoad.page_;
+    const Image* weightMap = pendingLoad.weightMapLoaded_ ? pendingLoad.weightMap_.Get() : nullptr;
+    const unsigned numLayers = ea::min(pendingLoad.layers_.size(), MAX_SPLAT_LAYERS);
+
+    const int width = page.GetWidth();
+    const int height = page.GetHeight();
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            const Vector2 uv{(x + 0.5f) / width, (y + 0.5f) / height};
+            const Vector2 detailUV = uv * pendingLoad.tiling_;
+            const Color weights = weightMap ? weightMap->GetPixelBilinear(uv.x_, uv.y_) : Color::RED;
+            const float layerWeights[MAX_SPLAT_LAYERS] = {weights.r_, weights.g_, weights.b_};
+
+            // Same blending as in terrain shader
+            Color color = Color::TRANSPARENT_BLACK;
+            float sumWeights = 0.0f;
+            for (unsigned i = 0; i < numLayers; ++i)
+            {
+                if (!pendingLoad.layers_[i])
+                    continue;
+
+                color += pendingLoad.layers_[i]->GetPixelBilinear(Fract(detailUV.x_), Fract(detailUV.y_)) * layerWeights[i];
+                sumWeights += layerWeights[i];
+            }
+
+            color = sumWeights > M_EPSILON ? color * (1.0f / sumWeights) : Color::BLACK;
+            color.a_ = 1.0f;
+            page.SetPixel(x, y, color);
+        }
+    }
+}
+
+void TerrainStreamer::UpdateTileMaterial(Tile& tile, bool near)
+{
+    tile.near_ = near;
+    if (!tile.terrain_)
+        return;
+
+    const bool usePage = !near && farMaterial_ && tile.pageTexture_;
+    Material* sourceMaterial = usePage ? farMaterial_ : material_;
+    Texture2D* texture = usePage ? tile.pageTexture_ : tile.weightTexture_;
+    if (!sourceMaterial || !texture)
+    {
+        tile.terrain_->SetMaterial(sourceMaterial);
+        return;
+    }
+
+    SharedPtr<Material> material = sourceMaterial->Clone();
+    material->SetTexture(TU_DIFFUSE, texture);
+    tile.terrain_->SetMaterial(material);
+}
+
+void TerrainStreamer::UpdateNeighbors(const IntVector2& tile)
+{
+    const auto updateTile = [this](const IntVector2& coordinates)
+    {
+        Terrain* terrain = GetTileTerrain(coordinates);
+        if (!terrain)
+            return;
+
+        terrain->SetNeighbors(GetTileTerrain(coordinates + IntVector2::UP), GetTileTerrain(coordinates + IntVector2::DOWN),
+            GetTileTerrain(coordinates + IntVector2::LEFT), GetTileTerrain(coordinates + IntVector2::RIGHT));
+    };
+
+    updateTile(tile);
+    updateTile(tile + IntVector2::UP);
+    updateTile(tile + IntVector2::DOWN);
+    updateTile(tile + IntVector2::LEFT);
+    updateTile(tile + IntVector2::RIGHT);
+}
+
+void TerrainStreamer::UpdateLayerLevels()
+{
+    layerLevels_.clear();
+
+    const Variant& tilingParameter = material_ ? material_->GetShaderParameter("DetailTiling") : Variant::EMPTY;
+    const Vector2 tiling = tilingParameter.GetType() == VAR_VECTOR2 ? tilingParameter.GetVector2() : Vector2::ONE;
+
+    // Pick mip level that matches footprint of page texel to avoid aliasing
+    const int targetSize = Max(1, RoundToInt(pageSize_ / Max(Max(tiling.x_, tiling.y_), 1.0f)));
+    for (Image* image : layerImages_)
+    {
+        SharedPtr<Image> level;
+        if (image)
+            level = image->IsCompressed() ? image->GetDecompressedImage() : SharedPtr<Image>(image);
+
+        while (level && Max(level->GetWidth(), level->GetHeight()) > targetSize)
+        {
+            SharedPtr<Image> nextLevel = level->GetNextLevel();
+            if (!nextLevel)
+                break;
+            level = nextLevel;
+        }
+
+        layerLevels_.push_back(level);
+    }
+}
+
+void TerrainStreamer::HandleSceneUpdate(StringHash eventType, VariantMap& eventData)
+{
+    if (IsEnabledEffective())
+        Update();
+}
+
+}
@@ -0,0 +1,280 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Scene/Component.h"
+
+#include <EASTL/unique_ptr.h>
+#include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class Image;
+class Material;
+class Terrain;
+class Texture2D;
+class WorkTask;
+
+/// Streams terrain split into square tiles around the focus node.
+/// Each tile is a separate Terrain with its own height map and optional splat weight map, loaded from files
+/// named by patterns where "{x}" and "{z}" are replaced with tile coordinates.
+/// Tiles close to the focus are rendered with the splat material. Distant tiles are rendered with
+/// the far material that samples single page with splat layers pre-blended on load.
+class URHO3D_API TerrainStreamer : public Component
+{
+    URHO3D_OBJECT(TerrainStreamer, Component);
+
+public:
+    /// Construct.
+    explicit TerrainStreamer(Context* context);
+    /// Destruct.
+    ~TerrainStreamer() override;
+    /// Register object factory.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Update tiles around the focus. Called on scene update.
+    void Update();
+    /// Unload all tiles.
+    void UnloadTiles();
+
+    /// Set focus node. Camera of the first viewport is used if not set.
+    void SetFocusNode(Node* node) { focusNode_ = node; }
+    /// Set file name pattern of height maps.
+    /// @property
+    void SetHeightMapPattern(const ea::string& pattern);
+    /// Set file name pattern of splat weight maps.
+    /// @property
+    void SetWeightMapPattern(const ea::string& pattern);
+    /// Set number of tiles along X and Z axes.
+    /// @property
+    void SetNumTiles(const IntVector2& numTiles);
+    /// Set number of quads per tile side. Tile height maps should have (size + 1) pixels per side.
+    /// @property
+    void SetTileSize(int size);
+    /// Set vertex and height spacing.
+    /// @property
+    void SetSpacing(const Vector3& spacing);
+    /// Set patch size of tile terrains.
+    /// @property
+    void SetPatchSize(int size);
+    /// Set radius in tiles within which tiles are loaded.
+    /// @property
+    void SetLoadRadius(unsigned radius);
+    /// Set radius in tiles within which tiles are rendered with splat material.
+    /// @property
+    void SetNearRadius(unsigned radius);
+    /// Set material of near tiles. Splat weight map is bound to diffuse texture unit.
+    /// @property
+    void SetMaterial(Material* material);
+    /// Set material of far tiles. Pre-blended page is bound to diffuse texture unit.
+    /// @property
+    void SetFarMaterial(Material* material);
+    /// Set splat layer images blended into pages in the same order as weight map channels.
+    void SetLayerImages(const ea::vector<SharedPtr<Image>>& images);
+    /// Set resolution of pre-blended pages.
+    /// @property
+    void SetPageSize(int size);
+    /// Set maximum number of tiles being loaded at the same time.
+    /// @property
+    void SetMaxPendingLoads(unsigned count) { maxPendingLoads_ = Max(count, 1u); }
+
+    /// Return focus node.
+    Node* GetFocusNode() const { return focusNode_; }
+    /// Return file name pattern of height maps.
+    /// @property
+    const ea::string& GetHeightMapPattern() const { return heightMapPattern_; }
+    /// Return file name pattern of splat weight maps.
+    /// @property
+    const ea::string& GetWeightMapPattern() const { return weightMapPattern_; }
+    /// Return number of tiles along X and Z axes.
+    /// @property
+    const IntVector2& GetNumTiles() const { return numTiles_; }
+    /// Return number of quads per tile side.
+    /// @property
+    int GetTileSize() const { return tileSize_; }
+    /// Return vertex and height spacing.
+    /// @property
+    const Vector3& GetSpacing() const { return spacing_; }
+    /// Return patch size of tile terrains.
+    /// @property
+    int GetPatchSize() const { return patchSize_; }
+    /// Return radius in tiles within which tiles are loaded.
+    /// @property
+    unsigned GetLoadRadius() const { return loadRadius_; }
+    /// Return radius in tiles within which tiles are rendered with splat material.
+    /// @property
+    unsigned GetNearRadius() const { return nearRadius_; }
+    /// Return material of near tiles.
+    /// @property
+    Material* GetMaterial() const;
+    /// Return material of far tiles.
+    /// @property
+    Material* GetFarMaterial() const;
+    /// Return resolution of pre-blended pages.
+    /// @property
+    int GetPageSize() const { return pageSize_; }
+    /// Return maximum number of tiles being loaded at the same time.
+    /// @property
+    unsigned GetMaxPendingLoads() const { return maxPendingLoads_; }
+
+    /// Return tile world size.
+    Vector2 GetTileWorldSize() const;
+    /// Return tile coordinates at world position.
+    IntVector2 WorldToTile(const Vector3& worldPosition) const;
+    /// Return loaded tile terrain, if any.
+    Terrain* GetTileTerrain(const IntVector2& tile) const;
+    /// Return number of loaded tiles.
+    unsigned GetNumLoadedTiles() const { return tiles_.size(); }
+    /// Return number of tiles being loaded.
+    unsigned GetNumPendingLoads() const { return pendingLoads_.size(); }
+
+    /// Set material attribute.
+    void SetMaterialAttr(const ResourceRef& value);
+    /// Return material attribute.
+    ResourceRef GetMaterialAttr() const;
+    /// Set far material attribute.
+    void SetFarMaterialAttr(const ResourceRef& value);
+    /// Return far material attribute.
+    ResourceRef GetFarMaterialAttr() const;
+    /// Set layer images attribute.
+    void SetLayerImagesAttr(const ResourceRefList& value);
+    /// Return layer images attribute.
+    const ResourceRefList& GetLayerImagesAttr() const;
+
+protected:
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
+
+private:
+    /// Loaded tile.
+    struct Tile
+    {
+        /// Tile node.
+        WeakPtr<Node> node_;
+        /// Tile terrain.
+        WeakPtr<Terrain> terrain_;
+        /// Splat weight texture.
+        SharedPtr<Texture2D> weightTexture_;
+        /// Pre-blended page texture.
+        SharedPtr<Texture2D> pageTexture_;
+        /// Whether the tile is rendered with near material.
+        bool near_{};
+    };
+
+    /// Tile being loaded.
+    struct PendingLoad
+    {
+        /// Tile coordinates.
+        IntVector2 coordinates_;
+        /// Height map.
+        SharedPtr<Image> heightMap_;
+        /// Splat weight map.
+        SharedPtr<Image> weightMap_;
+        /// Splat layer images used for blending.
+        ea::vector<SharedPtr<Image>> layers_;
+        /// Splat layer tiling.
+        Vector2 tiling_;
+        /// Pre-blended page.
+        SharedPtr<Image> page_;
+        /// Whether the height map was loaded successfully.
+        bool success_{};
+        /// Whether the splat weight map was loaded successfully.
+        bool weightMapLoaded_{};
+        /// Whether the settings changed and the data is outdated.
+        bool discarded_{};
+        /// Task that loads the data.
+        SharedPtr<WorkTask> task_;
+    };
+
+    /// Return whether the tile is within radius from the focus tile.
+    static bool IsWithinRadius(const IntVector2& tile, const IntVector2& focusTile, unsigned radius);
+    /// Return file name of tile resource.
+    static ea::string GetTileFileName(const ea::string& pattern, const IntVector2& tile);
+    /// Return focus position in world space. Return false if there's no focus.
+    bool GetFocusPosition(Vector3& position) const;
+    /// Return whether the tile is being loaded.
+    bool IsLoading(const IntVector2& tile) const;
+    /// Start loading of the tile.
+    void StartLoad(const IntVector2& tile);
+    /// Finish loading of the tile and create tile terrain.
+    void FinishLoad(PendingLoad& pendingLoad);
+    /// Blend splat layers into page. Called from worker thread.
+    static void BlendPage(PendingLoad& pendingLoad);
+    /// Update tile material depending on distance to the focus tile.
+    void UpdateTileMaterial(Tile& tile, bool near);
+    /// Update neighbors of tile terrains around the tile.
+    void UpdateNeighbors(const IntVector2& tile);
+    /// Prepare layer image levels used for page blending.
+    void UpdateLayerLevels();
+    /// Discard loaded and pending tiles after settings change.
+    void MarkTilesDirty() { tilesDirty_ = true; }
+    /// Handle scene update.
+    void HandleSceneUpdate(StringHash eventType, VariantMap& eventData);
+
+    /// Loaded tiles.
+    ea::unordered_map<IntVector2, Tile> tiles_;
+    /// Tiles being loaded.
+    ea::vector<ea::unique_ptr<PendingLoad>> pendingLoads_;
+    /// Layer image levels used for page blending.
+    ea::vector<SharedPtr<Image>> layerLevels_;
+    /// Tile containing the focus as of last update.
+    IntVector2 focusTile_;
+    /// Whether the tiles should be reloaded.
+    bool tilesDirty_{};
+
+    /// Focus node.
+    WeakPtr<Node> focusNode_;
+    /// File name pattern of height maps.
+    ea::string heightMapPattern_;
+    /// File name pattern of splat weight maps.
+    ea::string weightMapPattern_;
+    /// Number of tiles along X and Z axes.
+    IntVector2 numTiles_;
+    /// Number of quads per tile side.
+    int tileSize_;
+    /// Vertex and height spacing.
+    Vector3 spacing_;
+    /// Patch size of tile terrains.
+    int patchSize_;
+    /// Radius in tiles within which tiles are loaded.
+    unsigned loadRadius_;
+    /// Radius in tiles within which tiles are rendered with splat material.
+    unsigned nearRadius_;
+    /// Material of near tiles.
+    SharedPtr<Material> material_;
+    /// Material of far tiles.
+    SharedPtr<Material> farMaterial_;
+    /// Splat layer images.
+    ea::vector<SharedPtr<Image>> layerImages_;
+    /// Splat layer images attribute.
+    mutable ResourceRefList layerImagesAttr_;
+    /// Resolution of pre-blended pages.
+    int pageSize_;
+    /// Maximum number of tiles being loaded at the same time.
+    unsigned maxPendingLoads_;
+};
+
+}
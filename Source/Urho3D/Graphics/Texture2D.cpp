@@ -29,6 +29,7 @@
 #include "../Graphics/GraphicsImpl.h"
 #include "../Graphics/Renderer.h"
 #include "../Graphics/Texture2D.h"
+#include "../Graphics/TextureStreamer.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
 #include "../Resource/ResourceCache.h"
@@ -100,6 +101,10 @@ bool Texture2D::EndLoad()
     // If over the texture budget, see if materials can be freed to allow textures to be freed
     CheckTextureBudget(GetTypeStatic());
 
+    // Streamed textures start with low resolution mip levels only
+    if (auto textureStreamer = GetSubsystem<TextureStreamer>())
+        textureStreamer->AddTexture(this, loadImage_);
+
     SetParameters(loadParameters_);
     bool success = SetData(loadImage_);
 
@@ -109,6 +114,14 @@ bool Texture2D::EndLoad()
     return success;
 }
 
+void Texture2D::RequestStreamingResolution(unsigned resolution)
+{
+    unsigned current = requestedStreamingResolution_.load(std::memory_order_relaxed);
+    while (current < resolution && !requestedStreamingResolution_.compare_exchange_weak(current, resolution, std::memory_order_relaxed))
+    {
+    }
+}
+
 bool Texture2D::SetSize(int width, int height, unsigned format, TextureUsage usage, int multiSample, bool autoResolve)
 {
     if (width <= 0 || height <= 0)
@@ -26,6 +26,8 @@
 #include "../Graphics/RenderSurface.h"
 #include "../Graphics/Texture.h"
 
+#include <atomic>
+
 namespace Urho3D
 {
 
@@ -78,6 +80,17 @@ public:
     /// @property
     RenderSurface* GetRenderSurface() const { return renderSurface_; }
 
+    /// Set mip levels skipped by texture streaming in addition to the quality setting. Takes effect on the next SetData from image.
+    void SetStreamingMipsToSkip(unsigned toSkip) { streamingMipsToSkip_ = toSkip; }
+    /// Return mip levels skipped by texture streaming.
+    unsigned GetStreamingMipsToSkip() const { return streamingMipsToSkip_; }
+    /// Request resolution of the texture for streaming, in texels. Thread-safe.
+    void RequestStreamingResolution(unsigned resolution);
+    /// Return the maximum resolution requested since the last call and reset it.
+    unsigned ConsumeStreamingResolution() { return requestedStreamingResolution_.exchange(0, std::memory_order_relaxed); }
+    /// Return size of the last image set, before any mip levels are skipped.
+    const IntVector2& GetSourceSize() const { return sourceSize_; }
+
 protected:
     /// Create the GPU texture.
     bool Create() override;
@@ -92,6 +105,12 @@ private:
     SharedPtr<Image> loadImage_;
     /// Parameter file acquired during BeginLoad.
     SharedPtr<XMLFile> loadParameters_;
+    /// Size of the last image set.
+    IntVector2 sourceSize_;
+    /// Mip levels skipped by texture streaming.
+    unsigned streamingMipsToSkip_{};
+    /// Maximum requested resolution for texture streaming.
+    std::atomic<unsigned> requestedStreamingResolution_{};
 };
 
 }
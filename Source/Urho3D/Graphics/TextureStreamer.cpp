@@ -0,0 +1,335 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/CoreEvents.h"
+#include "../Core/Profiler.h"
+#include "../Core/Timer.h"
+#include "../Core/WorkQueue.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/Texture2D.h"
+#include "../Graphics/TextureStreamer.h"
+#include "../IO/Log.h"
+#include "../Resource/Image.h"
+#include "../Resource/ResourceCache.h"
+
+#include <EASTL/sort.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+TextureStreamer::TextureStreamer(Context* context)
+    : Object(context)
+{
+    SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(TextureStreamer, HandleEndFrame));
+}
+
+TextureStreamer::~TextureStreamer()
+{
+    // Pending loads access the resource cache, wait for them
+    auto workQueue = GetSubsystem<WorkQueue>();
+    for (StreamedTexture& streamedTexture : textures_)
+    {
+        if (streamedTexture.loadTask_ && workQueue)
+            workQueue->WaitForTask(streamedTexture.loadTask_);
+    }
+}
+
+void TextureStreamer::AddTexture(Texture2D* texture, Image* image)
+{
+    // Only textures that can be reloaded from file are streamed
+    if (!texture || !image || texture->GetName().empty() || texture->GetUsage() != TEXTURE_STATIC)
+        return;
+
+    const IntVector2 sourceSize{image->GetWidth(), image->GetHeight()};
+    if (sourceSize.x_ <= static_cast<int>(minResolution_) && sourceSize.y_ <= static_cast<int>(minResolution_))
+        return;
+
+    auto iter = ea::find_if(textures_.begin(), textures_.end(),
+        [texture](const StreamedTexture& streamedTexture) { return streamedTexture.texture_ == texture; });
+    if (iter == textures_.end())
+    {
+        textures_.emplace_back();
+        iter = &textures_.back();
+        iter->texture_ = texture;
+    }
+
+    StreamedTexture& streamedTexture = *iter;
+    streamedTexture.sourceSize_ = sourceSize;
+    streamedTexture.maxMipsToSkip_ = GetMipsToSkip(sourceSize, minResolution_);
+    streamedTexture.requestedMipsToSkip_ = streamedTexture.maxMipsToSkip_;
+    streamedTexture.windowMipsToSkip_ = streamedTexture.maxMipsToSkip_;
+    streamedTexture.windowStartTime_ = time_;
+    streamedTexture.targetMipsToSkip_ = streamedTexture.maxMipsToSkip_;
+
+    if (image->IsCompressed())
+    {
+        const CompressedLevel level = image->GetCompressedLevel(0);
+        streamedTexture.fullMemory_ = static_cast<double>(level.rows_) * level.rowSize_ * image->GetDepth();
+    }
+    else
+        streamedTexture.fullMemory_ = static_cast<double>(sourceSize.x_) * sourceSize.y_ * image->GetComponents();
+    // Account for mip levels
+    streamedTexture.fullMemory_ *= 4.0 / 3.0;
+
+    texture->SetStreamingMipsToSkip(streamedTexture.maxMipsToSkip_);
+}
+
+void TextureStreamer::RequestMaterialTextures(Material* material, float screenSize) const
+{
+    if (!material)
+        return;
+
+    const unsigned resolution = static_cast<unsigned>(Clamp(screenSize * texelDensityScale_, 1.0f, static_cast<float>(M_MAX_INT)));
+    for (const auto& item : material->GetTextures())
+    {
+        Texture* texture = item.second;
+        if (texture && texture->GetType() == Texture2D::GetTypeStatic())
+            static_cast<Texture2D*>(texture)->RequestStreamingResolution(resolution);
+    }
+}
+
+void TextureStreamer::Update()
+{
+    URHO3D_PROFILE("UpdateTextureStreaming");
+
+    if (auto time = GetSubsystem<Time>())
+        time_ = time->GetElapsedTime();
+
+    // Remove destroyed textures, waiting for their loads to finish
+    ea::erase_if(textures_, [](const StreamedTexture& streamedTexture)
+    {
+        return !streamedTexture.texture_ && (!streamedTexture.loadTask_ || streamedTexture.loadTask_->IsCompleted());
+    });
+
+    // Gather requests
+    for (StreamedTexture& streamedTexture : textures_)
+    {
+        Texture2D* texture = streamedTexture.texture_;
+        if (!texture)
+            continue;
+
+        if (const unsigned resolution = texture->ConsumeStreamingResolution())
+        {
+            const unsigned mipsToSkip = Min(GetMipsToSkip(streamedTexture.sourceSize_, resolution), streamedTexture.maxMipsToSkip_);
+            streamedTexture.windowMipsToSkip_ = Min(streamedTexture.windowMipsToSkip_, mipsToSkip);
+            // Higher resolution is applied immediately
+            streamedTexture.requestedMipsToSkip_ = Min(streamedTexture.requestedMipsToSkip_, mipsToSkip);
+        }
+
+        // Lower resolution is applied only if nothing needed more during the whole time window
+        if (time_ - streamedTexture.windowStartTime_ >= evictionDelay_)
+        {
+            streamedTexture.requestedMipsToSkip_ = streamedTexture.windowMipsToSkip_;
+            streamedTexture.windowMipsToSkip_ = streamedTexture.maxMipsToSkip_;
+            streamedTexture.windowStartTime_ = time_;
+        }
+    }
+
+    ApplyMemoryBudget();
+
+    // Finish completed loads within upload budget. At least one texture is uploaded per frame.
+    // Completed loads that do not fit stay pending until the next frame.
+    unsigned numPendingLoads = 0;
+    double uploadedBytes = 0.0;
+    for (StreamedTexture& streamedTexture : textures_)
+    {
+        if (!streamedTexture.loadTask_)
+            continue;
+
+        const double uploadBytes = GetMemoryEstimate(streamedTexture, streamedTexture.loadMipsToSkip_);
+        const bool fitsBudget = uploadedBytes == 0.0
+            || uploadedBytes + uploadBytes <= static_cast<double>(maxUploadBytesPerFrame_);
+        if (streamedTexture.loadTask_->IsCompleted() && fitsBudget)
+        {
+            FinishLoad(streamedTexture);
+            uploadedBytes += uploadBytes;
+        }
+        else
+            ++numPendingLoads;
+    }
+
+    // Start new loads. Unload first to free memory, then load the textures that miss the most levels.
+    ea::vector<StreamedTexture*> loadQueue;
+    for (StreamedTexture& streamedTexture : textures_)
+    {
+        Texture2D* texture = streamedTexture.texture_;
+        if (texture && !streamedTexture.loadTask_ && !streamedTexture.loadImage_
+            && texture->GetStreamingMipsToSkip() != streamedTexture.targetMipsToSkip_)
+            loadQueue.push_back(&streamedTexture);
+    }
+
+    const auto getPriority = [](const StreamedTexture* streamedTexture)
+    {
+        const int currentMipsToSkip = static_cast<int>(streamedTexture->texture_->GetStreamingMipsToSkip());
+        const int delta = currentMipsToSkip - static_cast<int>(streamedTexture->targetMipsToSkip_);
+        return delta < 0 ? M_MAX_INT : delta;
+    };
+    ea::sort(loadQueue.begin(), loadQueue.end(),
+        [&](const StreamedTexture* lhs, const StreamedTexture* rhs) { return getPriority(lhs) > getPriority(rhs); });
+
+    for (StreamedTexture* streamedTexture : loadQueue)
+    {
+        if (numPendingLoads >= maxPendingLoads_)
+            break;
+
+        StartLoad(*streamedTexture);
+        if (streamedTexture->loadTask_)
+            ++numPendingLoads;
+    }
+
+    // Update statistics
+    double memoryUse = 0.0;
+    for (const StreamedTexture& streamedTexture : textures_)
+    {
+        if (Texture2D* texture = streamedTexture.texture_)
+            memoryUse += GetMemoryEstimate(streamedTexture, texture->GetStreamingMipsToSkip());
+    }
+    memoryUse_ = static_cast<unsigned long long>(memoryUse);
+}
+
+unsigned TextureStreamer::GetNumPendingLoads() const
+{
+    return ea::count_if(textures_.begin(), textures_.end(),
+        [](const StreamedTexture& streamedTexture) { return streamedTexture.loadTask_ != nullptr; });
+}
+
+unsigned TextureStreamer::GetMipsToSkip(const IntVector2& size, unsigned resolution)
+{
+    unsigned mipsToSkip = 0;
+    unsigned maxDimension = static_cast<unsigned>(Max(size.x_, size.y_));
+    while (maxDimension > 1 && maxDimension > resolution)
+    {
+        maxDimension /= 2;
+        ++mipsToSkip;
+    }
+    return mipsToSkip;
+}
+
+double TextureStreamer::GetMemoryEstimate(const StreamedTexture& streamedTexture, unsigned mipsToSkip)
+{
+    return streamedTexture.fullMemory_ / static_cast<double>(1ull << (2 * Min(mipsToSkip, 31u)));
+}
+
+void TextureStreamer::ApplyMemoryBudget()
+{
+    double memoryUse = 0.0;
+    for (StreamedTexture& streamedTexture : textures_)
+    {
+        streamedTexture.targetMipsToSkip_ = streamedTexture.requestedMipsToSkip_;
+        if (streamedTexture.texture_)
+            memoryUse += GetMemoryEstimate(streamedTexture, streamedTexture.targetMipsToSkip_);
+    }
+
+    if (memoryUse <= static_cast<double>(memoryBudget_))
+        return;
+
+    // Drop one mip level at a time from the largest textures
+    ea::vector<StreamedTexture*> candidates;
+    for (StreamedTexture& streamedTexture : textures_)
+    {
+        if (streamedTexture.texture_)
+            candidates.push_back(&streamedTexture);
+    }
+
+    bool reduced = true;
+    while (memoryUse > static_cast<double>(memoryBudget_) && reduced)
+    {
+        ea::sort(candidates.begin(), candidates.end(), [](const StreamedTexture* lhs, const StreamedTexture* rhs)
+        {
+            return GetMemoryEstimate(*lhs, lhs->targetMipsToSkip_) > GetMemoryEstimate(*rhs, rhs->targetMipsToSkip_);
+        });
+
+        reduced = false;
+        for (StreamedTexture* streamedTexture : candidates)
+        {
+            if (streamedTexture->targetMipsToSkip_ >= streamedTexture->maxMipsToSkip_)
+                continue;
+
+            const double oldMemory = GetMemoryEstimate(*streamedTexture, streamedTexture->targetMipsToSkip_);
+            ++streamedTexture->targetMipsToSkip_;
+            memoryUse -= oldMemory - GetMemoryEstimate(*streamedTexture, streamedTexture->targetMipsToSkip_);
+            reduced = true;
+
+            if (memoryUse <= static_cast<double>(memoryBudget_))
+                break;
+        }
+    }
+}
+
+void TextureStreamer::StartLoad(StreamedTexture& streamedTexture)
+{
+    Texture2D* texture = streamedTexture.texture_;
+    auto cache = GetSubsystem<ResourceCache>();
+    auto workQueue = GetSubsystem<WorkQueue>();
+
+    streamedTexture.loadImage_ = MakeShared<Image>(context_);
+    streamedTexture.loadMipsToSkip_ = streamedTexture.targetMipsToSkip_;
+
+    const auto loadImage = [cache, image = streamedTexture.loadImage_, name = texture->GetName()](unsigned)
+    {
+        AbstractFilePtr file = cache->GetFile(name, false);
+        if (file && image->Load(*file))
+            image->PrecalculateLevels();
+    };
+
+    if (workQueue && workQueue->GetNumThreads() > 0)
+        streamedTexture.loadTask_ = workQueue->PostTask(loadImage);
+    else
+    {
+        loadImage(0);
+        FinishLoad(streamedTexture);
+    }
+}
+
+void TextureStreamer::FinishLoad(StreamedTexture& streamedTexture)
+{
+    SharedPtr<Image> image = ea::move(streamedTexture.loadImage_);
+    streamedTexture.loadImage_ = nullptr;
+    streamedTexture.loadTask_ = nullptr;
+
+    Texture2D* texture = streamedTexture.texture_;
+    if (!texture)
+        return;
+
+    if (!image || image->GetWidth() == 0)
+    {
+        URHO3D_LOGWARNING("Failed to stream texture {}", texture->GetName());
+        // Do not retry until requested resolution changes
+        streamedTexture.requestedMipsToSkip_ = texture->GetStreamingMipsToSkip();
+        return;
+    }
+
+    texture->SetStreamingMipsToSkip(streamedTexture.loadMipsToSkip_);
+    texture->SetData(image);
+}
+
+void TextureStreamer::HandleEndFrame(StringHash eventType, VariantMap& eventData)
+{
+    Update();
+}
+
+}
@@ -0,0 +1,155 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Core/Object.h"
+
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class Image;
+class Material;
+class Texture2D;
+class WorkTask;
+
+/// Streams mip levels of 2D textures loaded from files within the GPU memory budget.
+/// Textures are loaded with low resolution mip levels only. Higher resolution levels are loaded
+/// when requested by visible geometry and unloaded when not used for a while.
+/// Register as subsystem to enable streaming for textures loaded afterwards.
+class URHO3D_API TextureStreamer : public Object
+{
+    URHO3D_OBJECT(TextureStreamer, Object);
+
+public:
+    /// Construct.
+    explicit TextureStreamer(Context* context);
+    /// Destruct.
+    ~TextureStreamer() override;
+
+    /// Start streaming of the texture. Called before initial image is uploaded.
+    void AddTexture(Texture2D* texture, Image* image);
+    /// Request texture resolution for textures of the material given geometry size on screen in pixels. Thread-safe.
+    void RequestMaterialTextures(Material* material, float screenSize) const;
+    /// Update streaming state and apply loaded mip levels. Called on the end of the frame.
+    void Update();
+
+    /// Set GPU memory budget in bytes for streamed textures.
+    void SetMemoryBudget(unsigned long long budget) { memoryBudget_ = budget; }
+    /// Set maximum resolution of the mip levels resident initially and for unused textures.
+    void SetMinResolution(unsigned resolution) { minResolution_ = Max(resolution, 1u); }
+    /// Set multiplier for requested resolution. Increase for geometries with tiled texture coordinates.
+    void SetTexelDensityScale(float scale) { texelDensityScale_ = scale; }
+    /// Set time in seconds after which unused textures fall back to minimal resolution.
+    void SetEvictionDelay(float delay) { evictionDelay_ = delay; }
+    /// Set maximum number of textures being loaded at the same time.
+    void SetMaxPendingLoads(unsigned count) { maxPendingLoads_ = Max(count, 1u); }
+    /// Set maximum amount of texture data in bytes uploaded to GPU per frame. At least one texture is uploaded anyway.
+    void SetMaxUploadBytesPerFrame(unsigned long long bytes) { maxUploadBytesPerFrame_ = bytes; }
+
+    /// Return GPU memory budget in bytes.
+    unsigned long long GetMemoryBudget() const { return memoryBudget_; }
+    /// Return maximum resolution of the mip levels resident initially.
+    unsigned GetMinResolution() const { return minResolution_; }
+    /// Return multiplier for requested resolution.
+    float GetTexelDensityScale() const { return texelDensityScale_; }
+    /// Return time in seconds after which unused textures fall back to minimal resolution.
+    float GetEvictionDelay() const { return evictionDelay_; }
+    /// Return maximum number of textures being loaded at the same time.
+    unsigned GetMaxPendingLoads() const { return maxPendingLoads_; }
+    /// Return maximum amount of texture data in bytes uploaded to GPU per frame.
+    unsigned long long GetMaxUploadBytesPerFrame() const { return maxUploadBytesPerFrame_; }
+
+    /// Return number of streamed textures.
+    unsigned GetNumTextures() const { return textures_.size(); }
+    /// Return GPU memory used by streamed textures, as of last update.
+    unsigned long long GetMemoryUse() const { return memoryUse_; }
+    /// Return number of textures being loaded.
+    unsigned GetNumPendingLoads() const;
+
+    /// Return mip levels to skip so that the largest dimension does not exceed resolution.
+    static unsigned GetMipsToSkip(const IntVector2& size, unsigned resolution);
+
+private:
+    /// Streamed texture.
+    struct StreamedTexture
+    {
+        /// Texture.
+        WeakPtr<Texture2D> texture_;
+        /// Size of the texture image.
+        IntVector2 sourceSize_;
+        /// Estimated GPU memory of the full resolution texture.
+        double fullMemory_{};
+        /// Mip levels skipped when the texture is unused.
+        unsigned maxMipsToSkip_{};
+        /// Mip levels to skip as requested by geometry.
+        unsigned requestedMipsToSkip_{};
+        /// Minimal mip levels to skip requested within current time window.
+        unsigned windowMipsToSkip_{};
+        /// Start time of current time window.
+        float windowStartTime_{};
+        /// Mip levels to skip as requested by geometry and limited by memory budget.
+        unsigned targetMipsToSkip_{};
+        /// Image being loaded.
+        SharedPtr<Image> loadImage_;
+        /// Mip levels to skip for the image being loaded.
+        unsigned loadMipsToSkip_{};
+        /// Task that loads the image.
+        SharedPtr<WorkTask> loadTask_;
+    };
+
+    /// Return estimated GPU memory of texture with mip levels skipped.
+    static double GetMemoryEstimate(const StreamedTexture& streamedTexture, unsigned mipsToSkip);
+    /// Reduce target resolution of the textures until they fit into the memory budget.
+    void ApplyMemoryBudget();
+    /// Start loading of the image for the texture.
+    void StartLoad(StreamedTexture& streamedTexture);
+    /// Finish loading of the image and upload it to the texture.
+    void FinishLoad(StreamedTexture& streamedTexture);
+    /// Handle end of frame.
+    void HandleEndFrame(StringHash eventType, VariantMap& eventData);
+
+    /// Streamed textures.
+    ea::vector<StreamedTexture> textures_;
+    /// Current time.
+    float time_{};
+    /// Memory use.
+    unsigned long long memoryUse_{};
+
+    /// GPU memory budget.
+    unsigned long long memoryBudget_{256 * 1024 * 1024};
+    /// Resolution of mip levels resident initially.
+    unsigned minResolution_{64};
+    /// Multiplier for requested resolution.
+    float texelDensityScale_{1.0f};
+    /// Time after which unused textures fall back to minimal resolution.
+    float evictionDelay_{2.0f};
+    /// Maximum number of textures being loaded at the same time.
+    unsigned maxPendingLoads_{4};
+    /// Maximum amount of texture data uploaded per frame.
+    unsigned long long maxUploadBytesPerFrame_{16 * 1024 * 1024};
+};
+
+}
@@ -123,6 +123,92 @@ Vector3 Vector4ToVector3(const Vector4& value) { return { value.x_, value.y_, va
 Ubyte4 Vector4ToUbyte4Norm(const Vector4& value) { return Vector4ToUbyte4(value * 255.0f); }
 /// @}
 
+/// Helper types for 16-bit vectors.
+using Ushort2 = ea::array<unsigned short, 2>;
+using Short2 = ea::array<short, 2>;
+
+/// Convert half float vector to float vector and back.
+/// @{
+Vector4 Half2ToVector4(const Ushort2& value) { return { HalfToFloat(value[0]), HalfToFloat(value[1]), 0.0f, 0.0f }; }
+Ushort2 Vector4ToHalf2(const Vector4& value) { return { FloatToHalf(value.x_), FloatToHalf(value.y_) }; }
+/// @}
+
+/// Convert float in range [-1, 1] to signed normalized short and back.
+/// @{
+short FloatToShortNorm(float value) { return static_cast<short>(Clamp(RoundToInt(value * 32767.0f), -32767, 32767)); }
+float ShortNormToFloat(short value) { return Max(value / 32767.0f, -1.0f); }
+/// @}
+
+/// Convert signed normalized short vector to float vector and back.
+/// @{
+Vector4 Short2NormToVector4(const Short2& value) { return { ShortNormToFloat(value[0]), ShortNormToFloat(value[1]), 0.0f, 0.0f }; }
+Short2 Vector4ToShort2Norm(const Vector4& value) { return { FloatToShortNorm(value.x_), FloatToShortNorm(value.y_) }; }
+/// @}
+
+/// Decode octahedral normal.
+Vector4 OctahedralToNormal(const Short2& value)
+{
+    const float x = ShortNormToFloat(value[0]);
+    const float y = ShortNormToFloat(value[1]);
+    Vector3 normal{x, y, 1.0f - Abs(x) - Abs(y)};
+    const float t = Max(-normal.z_, 0.0f);
+    normal.x_ += normal.x_ >= 0.0f ? -t : t;
+    normal.y_ += normal.y_ >= 0.0f ? -t : t;
+    return normal.Normalized().ToVector4();
+}
+
+/// Encode normal with octahedral mapping.
+Short2 NormalToOctahedral(const Vector4& value)
+{
+    Vector3 normal = value.ToVector3();
+    const float length = Abs(normal.x_) + Abs(normal.y_) + Abs(normal.z_);
+    if (length < M_EPSILON)
+        return { 0, 0 };
+
+    normal /= length;
+    if (normal.z_ < 0.0f)
+    {
+        const float x = (1.0f - Abs(normal.y_)) * (normal.x_ >= 0.0f ? 1.0f : -1.0f);
+        const float y = (1.0f - Abs(normal.x_)) * (normal.y_ >= 0.0f ? 1.0f : -1.0f);
+        normal.x_ = x;
+        normal.y_ = y;
+    }
+    return { FloatToShortNorm(normal.x_), FloatToShortNorm(normal.y_) };
+}
+
+/// Convert 10:10:10:2 unsigned normalized vector to float vector and back.
+/// @{
+Vector4 Uint1010102NormToVector4(unsigned value)
+{
+    return {
+        (value & 0x3ff) / 1023.0f,
+        ((value >> 10) & 0x3ff) / 1023.0f,
+        ((value >> 20) & 0x3ff) / 1023.0f,
+        (value >> 30) / 3.0f
+    };
+}
+
+unsigned Vector4ToUint1010102Norm(const Vector4& value)
+{
+    const auto quantize = [](float component, int maxValue)
+    { return static_cast<unsigned>(Clamp(RoundToInt(component * maxValue), 0, maxValue)); };
+    return quantize(value.x_, 1023) | (quantize(value.y_, 1023) << 10) | (quantize(value.z_, 1023) << 20)
+        | (quantize(value.w_, 3) << 30);
+}
+/// @}
+
+/// Convert 10:10:10:2 unsigned normalized vector to float vector in range [-1, 1] and back.
+/// @{
+Vector4 Uint1010102NormToSignedVector4(unsigned value) { return Uint1010102NormToVector4(value) * 2.0f - Vector4::ONE; }
+unsigned SignedVector4ToUint1010102Norm(const Vector4& value) { return Vector4ToUint1010102Norm(value * 0.5f + Vector4::ONE * 0.5f); }
+/// @}
+
+/// Return whether the semantic is unit vector in range [-1, 1].
+bool IsSignedDirection(VertexElementSemantic semantic)
+{
+    return semantic == SEM_NORMAL || semantic == SEM_TANGENT || semantic == SEM_BINORMAL;
+}
+
 }
 
 VertexBuffer::VertexBuffer(Context* context, bool forceHeadless) :
@@ -374,6 +460,21 @@ void VertexBuffer::UnpackVertexData(const void* source, unsigned sourceStride,
     case TYPE_UBYTE4_NORM:
         ConvertArray<Vector4, Ubyte4>(destBytes, sourceBytes, destStride, sourceStride, count, Ubyte4NormToVector4);
         break;
+    case TYPE_HALF2:
+        ConvertArray<Vector4, Ushort2>(destBytes, sourceBytes, destStride, sourceStride, count, Half2ToVector4);
+        break;
+    case TYPE_SHORT2_NORM:
+        if (element.semantic_ == SEM_NORMAL)
+            ConvertArray<Vector4, Short2>(destBytes, sourceBytes, destStride, sourceStride, count, OctahedralToNormal);
+        else
+            ConvertArray<Vector4, Short2>(destBytes, sourceBytes, destStride, sourceStride, count, Short2NormToVector4);
+        break;
+    case TYPE_UINT_10_10_10_2_NORM:
+        if (IsSignedDirection(element.semantic_))
+            ConvertArray<Vector4, unsigned>(destBytes, sourceBytes, destStride, sourceStride, count, Uint1010102NormToSignedVector4);
+        else
+            ConvertArray<Vector4, unsigned>(destBytes, sourceBytes, destStride, sourceStride, count, Uint1010102NormToVector4);
+        break;
     default:
         assert(0);
         break;
@@ -412,6 +513,21 @@ void VertexBuffer::PackVertexData(const Vector4 source[], unsigned sourceStride,
         else
             ConvertArray<Ubyte4, Vector4>(destBytes, sourceBytes, destStride, sourceStride, count, Vector4ToUbyte4Norm);
         break;
+    case TYPE_HALF2:
+        ConvertArray<Ushort2, Vector4>(destBytes, sourceBytes, destStride, sourceStride, count, Vector4ToHalf2);
+        break;
+    case TYPE_SHORT2_NORM:
+        if (element.semantic_ == SEM_NORMAL)
+            ConvertArray<Short2, Vector4>(destBytes, sourceBytes, destStride, sourceStride, count, NormalToOctahedral);
+        else
+            ConvertArray<Short2, Vector4>(destBytes, sourceBytes, destStride, sourceStride, count, Vector4ToShort2Norm);
+        break;
+    case TYPE_UINT_10_10_10_2_NORM:
+        if (IsSignedDirection(element.semantic_))
+            ConvertArray<unsigned, Vector4>(destBytes, sourceBytes, destStride, sourceStride, count, SignedVector4ToUint1010102Norm);
+        else
+            ConvertArray<unsigned, Vector4>(destBytes, sourceBytes, destStride, sourceStride, count, Vector4ToUint1010102Norm);
+        break;
     default:
         assert(0);
         break;
@@ -466,12 +582,16 @@ DynamicVertexBuffer::DynamicVertexBuffer(Context* context)
 {
 }
 
-bool DynamicVertexBuffer::Initialize(unsigned vertexCount, const ea::vector<VertexElement>& elements)
+bool DynamicVertexBuffer::Initialize(unsigned vertexCount, const ea::vector<VertexElement>& elements, bool persistent)
 {
     numVertices_ = 0;
     maxNumVertices_ = vertexCount;
+    persistent_ = persistent;
+    numCommittedVertices_ = 0;
+    numUploadedVertices_ = 0;
 
-    if (!vertexBuffer_->SetSize(vertexCount, elements, true))
+    // Persistent buffer is partially updated, so it's not dynamic
+    if (!vertexBuffer_->SetSize(vertexCount, elements, !persistent_))
     {
         URHO3D_LOGERROR("Failed to create DynamicVertexBuffer");
         return false;
@@ -479,6 +599,7 @@ bool DynamicVertexBuffer::Initialize(unsigned vertexCount, const ea::vector<Vert
 
     vertexSize_ = vertexBuffer_->GetVertexSize();
     shadowData_.resize(vertexSize_ * maxNumVertices_);
+    committedData_.clear();
     return true;
 }
 
@@ -489,13 +610,15 @@ void DynamicVertexBuffer::Discard()
 
 void DynamicVertexBuffer::Commit()
 {
+    numUploadedVertices_ = 0;
     if (numVertices_ == 0)
         return;
 
     if (vertexBufferNeedResize_)
     {
         vertexBufferNeedResize_ = false;
-        if (!vertexBuffer_->SetSize(maxNumVertices_, vertexBuffer_->GetElements(), true))
+        numCommittedVertices_ = 0;
+        if (!vertexBuffer_->SetSize(maxNumVertices_, vertexBuffer_->GetElements(), !persistent_))
         {
             URHO3D_LOGERROR("Failed to grow DynamicVertexBuffer to {} vertices with stride {}",
                 maxNumVertices_, vertexSize_);
@@ -503,8 +626,57 @@ void DynamicVertexBuffer::Commit()
         }
     }
 
+    if (persistent_)
+    {
+        CommitChangedBlocks();
+        return;
+    }
+
     //vertexBuffer_->SetData(shadowData_.data());
     vertexBuffer_->SetDataRange(shadowData_.data(), 0, numVertices_, true);
+    numUploadedVertices_ = numVertices_;
+}
+
+void DynamicVertexBuffer::CommitChangedBlocks()
+{
+    committedData_.resize(shadowData_.size());
+    if (vertexBuffer_->IsDataLost())
+    {
+        vertexBuffer_->ClearDataLost();
+        numCommittedVertices_ = 0;
+    }
+
+    const auto uploadRange = [&](unsigned start, unsigned count)
+    {
+        const unsigned offset = start * vertexSize_;
+        const unsigned size = count * vertexSize_;
+        vertexBuffer_->SetDataRange(shadowData_.data() + offset, start, count);
+        memcpy(committedData_.data() + offset, shadowData_.data() + offset, size);
+        numUploadedVertices_ += count;
+    };
+
+    // Merge adjacent changed blocks into single upload
+    unsigned dirtyStart = M_MAX_UNSIGNED;
+    for (unsigned blockStart = 0; blockStart < numVertices_; blockStart += PersistentBlockSize)
+    {
+        const unsigned blockSize = ea::min(PersistentBlockSize, numVertices_ - blockStart);
+        const bool isDirty = blockStart + blockSize > numCommittedVertices_
+            || memcmp(shadowData_.data() + blockStart * vertexSize_,
+                committedData_.data() + blockStart * vertexSize_, blockSize * vertexSize_) != 0;
+
+        if (isDirty && dirtyStart == M_MAX_UNSIGNED)
+            dirtyStart = blockStart;
+        else if (!isDirty && dirtyStart != M_MAX_UNSIGNED)
+        {
+            uploadRange(dirtyStart, blockStart - dirtyStart);
+            dirtyStart = M_MAX_UNSIGNED;
+        }
+    }
+
+    if (dirtyStart != M_MAX_UNSIGNED)
+        uploadRange(dirtyStart, numVertices_ - dirtyStart);
+
+    numCommittedVertices_ = ea::max(numCommittedVertices_, numVertices_);
 }
 
 void DynamicVertexBuffer::GrowBuffer(unsigned newMaxNumVertices)
@@ -212,8 +212,13 @@ class URHO3D_API DynamicVertexBuffer : public Object
     URHO3D_OBJECT(DynamicVertexBuffer, Object);
 
 public:
+    /// Number of vertices compared and uploaded as one unit in persistent mode.
+    static const unsigned PersistentBlockSize = 64;
+
     DynamicVertexBuffer(Context* context);
-    bool Initialize(unsigned vertexCount, const ea::vector<VertexElement>& elements);
+    /// Initialize buffer. In persistent mode GPU data is kept between frames
+    /// and only blocks of vertices that changed since previous commit are uploaded.
+    bool Initialize(unsigned vertexCount, const ea::vector<VertexElement>& elements, bool persistent = false);
 
     /// Discard existing content of the buffer.
     void Discard();
@@ -243,14 +248,24 @@ public:
 
     VertexBuffer* GetVertexBuffer() const { return vertexBuffer_; }
     unsigned GetVertexCount() const { return numVertices_; }
+    bool IsPersistent() const { return persistent_; }
+    /// Return number of vertices uploaded to GPU during last commit.
+    unsigned GetNumUploadedVertices() const { return numUploadedVertices_; }
 
 private:
     void GrowBuffer(unsigned newMaxNumVertices);
+    void CommitChangedBlocks();
 
     SharedPtr<VertexBuffer> vertexBuffer_;
     ByteVector shadowData_;
     bool vertexBufferNeedResize_{};
 
+    /// Persistent mode: copy of data currently stored in GPU buffer.
+    bool persistent_{};
+    ByteVector committedData_;
+    unsigned numCommittedVertices_{};
+    unsigned numUploadedVertices_{};
+
     unsigned vertexSize_{};
     unsigned numVertices_{};
     unsigned maxNumVertices_{};
@@ -45,6 +45,10 @@ public:
 
     void PostUpdate(float timeStep) override;
     StringHash GetPostUpdateEvent() const override { return E_SCENEDRAWABLEUPDATEFINISHED; }
+    /// Solvers of different characters are independent and are solved in parallel.
+    /// Characters should not be attached to bones of other characters with IKSolver,
+    /// world transforms of nodes above the solver node are resolved before the parallel update.
+    bool IsUpdateThreadSafe() const override { return true; }
 
     /// Attributes.
     /// @{
@@ -0,0 +1,157 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../IO/AsyncFileReader.h"
+
+#include "../Core/Profiler.h"
+#include "../Core/Format.h"
+#include "../Core/Thread.h"
+#include "../IO/Log.h"
+#include "../IO/VirtualFileSystem.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+class AsyncFileReader::ReaderThread : public Thread, public RefCounted
+{
+public:
+    ReaderThread(AsyncFileReader* owner, unsigned index)
+        : Thread(Format("AsyncFileReader {}", index))
+        , owner_(owner)
+    {
+    }
+
+    void ThreadFunction() override
+    {
+        URHO3D_PROFILE_THREAD(name_.c_str());
+        owner_->ProcessReads();
+    }
+
+private:
+    AsyncFileReader* owner_{};
+};
+
+AsyncFileRead::AsyncFileRead(const FileIdentifier& fileName, unsigned offset, unsigned size, Callback callback)
+    : fileName_(fileName)
+    , offset_(offset)
+    , size_(size)
+    , callback_(ea::move(callback))
+{
+}
+
+bool AsyncFileRead::Cancel()
+{
+    AsyncReadState expected = AsyncReadState::Queued;
+    return state_.compare_exchange_strong(expected, AsyncReadState::Cancelled, std::memory_order_acq_rel);
+}
+
+AsyncFileReader::AsyncFileReader(VirtualFileSystem* vfs, unsigned numThreads)
+    : vfs_(vfs)
+{
+    for (unsigned i = 0; i < Max(numThreads, 1u); ++i)
+    {
+        auto thread = MakeShared<ReaderThread>(this, i);
+        thread->Run();
+        threads_.push_back(thread);
+    }
+}
+
+AsyncFileReader::~AsyncFileReader()
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        stopping_ = true;
+        for (AsyncFileRead* read : queue_)
+            read->Cancel();
+        queue_.clear();
+    }
+    queueCondition_.notify_all();
+
+    for (ReaderThread* thread : threads_)
+        thread->Stop();
+}
+
+void AsyncFileReader::QueueRead(AsyncFileRead* read)
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        queue_.emplace_back(read);
+    }
+    queueCondition_.notify_one();
+}
+
+void AsyncFileReader::ProcessReads()
+{
+    while (true)
+    {
+        SharedPtr<AsyncFileRead> read;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queueCondition_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (stopping_)
+                return;
+
+            read = ea::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        ProcessRead(read);
+    }
+}
+
+void AsyncFileReader::ProcessRead(AsyncFileRead* read)
+{
+    AsyncReadState expected = AsyncReadState::Queued;
+    if (!read->state_.compare_exchange_strong(expected, AsyncReadState::Reading, std::memory_order_acq_rel))
+        return;
+
+    URHO3D_PROFILE("AsyncFileRead");
+
+    bool success = false;
+    if (AbstractFilePtr file = vfs_->OpenFile(read->fileName_, FILE_READ))
+    {
+        const unsigned fileSize = file->GetSize();
+        if (read->offset_ <= fileSize)
+        {
+            const unsigned size = Min(read->size_, fileSize - read->offset_);
+            read->data_.resize(size);
+            success = file->Seek(read->offset_) == read->offset_ && file->Read(read->data_.data(), size) == size;
+        }
+    }
+
+    if (!success)
+    {
+        URHO3D_LOGERROR("Failed to read file {} asynchronously", read->fileName_.fileName_);
+        read->data_.clear();
+    }
+
+    read->state_.store(success ? AsyncReadState::Completed : AsyncReadState::Failed, std::memory_order_release);
+    if (read->callback_)
+        read->callback_(read);
+}
+
+}
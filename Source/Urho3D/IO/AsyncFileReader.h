@@ -0,0 +1,137 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Container/Ptr.h"
+#include "../Container/RefCounted.h"
+#include "../IO/FileIdentifier.h"
+
+#include <EASTL/deque.h>
+#include <EASTL/functional.h>
+#include <EASTL/vector.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace Urho3D
+{
+
+class VirtualFileSystem;
+
+/// State of asynchronous file read.
+enum class AsyncReadState
+{
+    Queued,
+    Reading,
+    Completed,
+    Failed,
+    Cancelled
+};
+
+/// Asynchronous read of a byte range of a file in the virtual file system.
+class URHO3D_API AsyncFileRead : public RefCounted
+{
+public:
+    /// Callback invoked from an I/O thread when the read is completed or failed.
+    using Callback = ea::function<void(AsyncFileRead* read)>;
+
+    /// Construct.
+    AsyncFileRead(const FileIdentifier& fileName, unsigned offset, unsigned size, Callback callback);
+
+    /// Cancel the read if it has not started yet. Callback is not invoked for cancelled reads. Return true if cancelled.
+    bool Cancel();
+
+    /// Return file name.
+    const FileIdentifier& GetFileName() const { return fileName_; }
+    /// Return offset of the range in the file.
+    unsigned GetOffset() const { return offset_; }
+    /// Return requested size of the range.
+    unsigned GetRequestedSize() const { return size_; }
+    /// Return current state. Thread-safe.
+    AsyncReadState GetState() const { return state_.load(std::memory_order_acquire); }
+    /// Return whether the read is finished, successfully or not. Thread-safe.
+    bool IsFinished() const { return GetState() >= AsyncReadState::Completed; }
+    /// Return read data. Valid only when the read is completed.
+    const ea::vector<unsigned char>& GetData() const { return data_; }
+    /// Return read data for modification, e.g. to move it out. Valid only when the read is completed.
+    ea::vector<unsigned char>& GetData() { return data_; }
+
+private:
+    friend class AsyncFileReader;
+
+    /// File name.
+    const FileIdentifier fileName_;
+    /// Offset of the range.
+    const unsigned offset_;
+    /// Requested size of the range.
+    const unsigned size_;
+    /// Completion callback.
+    Callback callback_;
+    /// Read data.
+    ea::vector<unsigned char> data_;
+    /// Current state.
+    std::atomic<AsyncReadState> state_{AsyncReadState::Queued};
+};
+
+/// Pool of I/O threads that perform asynchronous reads from the virtual file system. Owned by VirtualFileSystem.
+/// Each thread keeps one blocking read in flight, so the number of threads is the number of concurrent reads.
+/// @nobind
+class URHO3D_API AsyncFileReader
+{
+public:
+    /// Construct and start the threads.
+    AsyncFileReader(VirtualFileSystem* vfs, unsigned numThreads);
+    /// Destruct. Queued reads are cancelled, reads in progress are finished.
+    ~AsyncFileReader();
+
+    /// Queue read.
+    void QueueRead(AsyncFileRead* read);
+    /// Return number of I/O threads.
+    unsigned GetNumThreads() const { return threads_.size(); }
+
+private:
+    class ReaderThread;
+
+    /// Process queued reads until stopped.
+    void ProcessReads();
+    /// Perform the read.
+    void ProcessRead(AsyncFileRead* read);
+
+    /// Virtual file system.
+    VirtualFileSystem* vfs_{};
+    /// I/O threads.
+    ea::vector<SharedPtr<ReaderThread>> threads_;
+
+    /// Mutex for the queue.
+    std::mutex queueMutex_;
+    /// Condition signaled when the queue is changed.
+    std::condition_variable queueCondition_;
+    /// Queued reads.
+    ea::deque<SharedPtr<AsyncFileRead>> queue_;
+    /// Whether the threads should stop.
+    bool stopping_{};
+};
+
+}
@@ -0,0 +1,211 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/Assert.h"
+#include "../IO/BitStream.h"
+#include "../IO/Deserializer.h"
+#include "../IO/Serializer.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Max absolute value of the three smallest components of unit quaternion.
+const float MaxSmallestComponent = 0.70710678f;
+
+unsigned GetMaxQuantizedValue(unsigned numBits)
+{
+    return numBits >= 32 ? M_MAX_UNSIGNED : (1u << numBits) - 1;
+}
+
+}
+
+void BitStreamWriter::WriteBits(unsigned value, unsigned numBits)
+{
+    URHO3D_ASSERT(numBits <= 32);
+    if (numBits == 0)
+        return;
+
+    const unsigned long long mask = (1ull << numBits) - 1;
+    pendingBits_ |= (static_cast<unsigned long long>(value) & mask) << numPendingBits_;
+    numPendingBits_ += numBits;
+
+    while (numPendingBits_ >= 8)
+    {
+        dest_.WriteUByte(static_cast<unsigned char>(pendingBits_ & 0xffu));
+        pendingBits_ >>= 8;
+        numPendingBits_ -= 8;
+    }
+}
+
+void BitStreamWriter::WriteQuantizedFloat(float value, float minValue, float maxValue, unsigned numBits)
+{
+    const unsigned maxQuantizedValue = GetMaxQuantizedValue(numBits);
+    const float range = maxValue - minValue;
+    const double normalized = range > 0.0f ? Clamp((value - minValue) / range, 0.0f, 1.0f) : 0.0;
+    WriteBits(static_cast<unsigned>(normalized * maxQuantizedValue + 0.5), numBits);
+}
+
+void BitStreamWriter::WriteQuantizedVector3(const Vector3& value, float minValue, float maxValue, unsigned numBits)
+{
+    WriteQuantizedFloat(value.x_, minValue, maxValue, numBits);
+    WriteQuantizedFloat(value.y_, minValue, maxValue, numBits);
+    WriteQuantizedFloat(value.z_, minValue, maxValue, numBits);
+}
+
+void BitStreamWriter::WriteQuantizedQuaternion(const Quaternion& value, unsigned numBits)
+{
+    const Quaternion normalized = value.Normalized();
+    const float components[4] = {normalized.w_, normalized.x_, normalized.y_, normalized.z_};
+
+    unsigned largestIndex = 0;
+    for (unsigned i = 1; i < 4; ++i)
+    {
+        if (Abs(components[i]) > Abs(components[largestIndex]))
+            largestIndex = i;
+    }
+
+    // Quaternions q and -q represent the same rotation, so the largest component is always positive
+    const float sign = components[largestIndex] < 0.0f ? -1.0f : 1.0f;
+
+    WriteBits(largestIndex, 2);
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        if (i != largestIndex)
+            WriteQuantizedFloat(components[i] * sign, -MaxSmallestComponent, MaxSmallestComponent, numBits);
+    }
+}
+
+void BitStreamWriter::WriteFloat(float value)
+{
+    unsigned bits;
+    memcpy(&bits, &value, sizeof(bits));
+    WriteBits(bits, 32);
+}
+
+void BitStreamWriter::WriteVector3(const Vector3& value)
+{
+    WriteFloat(value.x_);
+    WriteFloat(value.y_);
+    WriteFloat(value.z_);
+}
+
+void BitStreamWriter::Flush()
+{
+    if (numPendingBits_ > 0)
+    {
+        dest_.WriteUByte(static_cast<unsigned char>(pendingBits_ & 0xffu));
+        pendingBits_ = 0;
+        numPendingBits_ = 0;
+    }
+}
+
+unsigned BitStreamReader::ReadBits(unsigned numBits)
+{
+    URHO3D_ASSERT(numBits <= 32);
+    if (numBits == 0)
+        return 0;
+
+    while (numPendingBits_ < numBits)
+    {
+        pendingBits_ |= static_cast<unsigned long long>(src_.ReadUByte()) << numPendingBits_;
+        numPendingBits_ += 8;
+    }
+
+    const unsigned long long mask = (1ull << numBits) - 1;
+    const auto value = static_cast<unsigned>(pendingBits_ & mask);
+    pendingBits_ >>= numBits;
+    numPendingBits_ -= numBits;
+    return value;
+}
+
+float BitStreamReader::ReadQuantizedFloat(float minValue, float maxValue, unsigned numBits)
+{
+    const unsigned maxQuantizedValue = GetMaxQuantizedValue(numBits);
+    const unsigned quantizedValue = ReadBits(numBits);
+    const double normalized = maxQuantizedValue > 0 ? static_cast<double>(quantizedValue) / maxQuantizedValue : 0.0;
+    return static_cast<float>(minValue + (maxValue - minValue) * normalized);
+}
+
+Vector3 BitStreamReader::ReadQuantizedVector3(float minValue, float maxValue, unsigned numBits)
+{
+    const float x = ReadQuantizedFloat(minValue, maxValue, numBits);
+    const float y = ReadQuantizedFloat(minValue, maxValue, numBits);
+    const float z = ReadQuantizedFloat(minValue, maxValue, numBits);
+    return {x, y, z};
+}
+
+Quaternion BitStreamReader::ReadQuantizedQuaternion(unsigned numBits)
+{
+    const unsigned largestIndex = ReadBits(2);
+
+    float components[4]{};
+    float sumSquares = 0.0f;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        if (i == largestIndex)
+            continue;
+
+        components[i] = ReadQuantizedFloat(-MaxSmallestComponent, MaxSmallestComponent, numBits);
+        sumSquares += components[i] * components[i];
+    }
+    components[largestIndex] = Sqrt(ea::max(0.0f, 1.0f - sumSquares));
+
+    return Quaternion{components[0], components[1], components[2], components[3]}.Normalized();
+}
+
+float BitStreamReader::ReadFloat()
+{
+    const unsigned bits = ReadBits(32);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+Vector3 BitStreamReader::ReadVector3()
+{
+    const float x = ReadFloat();
+    const float y = ReadFloat();
+    const float z = ReadFloat();
+    return {x, y, z};
+}
+
+unsigned GetNumQuantizationBits(float range, float precision)
+{
+    if (range <= 0.0f || precision <= 0.0f)
+        return 0;
+
+    const double numSteps = ceil(static_cast<double>(range) / precision);
+    unsigned numBits = 1;
+    while (numBits < 32 && static_cast<double>(GetMaxQuantizedValue(numBits)) < numSteps)
+        ++numBits;
+    return numBits;
+}
+
+}
@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Math/Quaternion.h"
+#include "../Math/Vector3.h"
+
+namespace Urho3D
+{
+
+class Deserializer;
+class Serializer;
+
+/// Writes values with arbitrary bit width into serializer.
+/// Bits are accumulated and written byte by byte, the last partial byte is written on Flush.
+class URHO3D_API BitStreamWriter
+{
+public:
+    /// Construct.
+    explicit BitStreamWriter(Serializer& dest) : dest_(dest) {}
+    /// Destruct. Flush pending bits.
+    ~BitStreamWriter() { Flush(); }
+
+    /// Write lowest bits of the value. Number of bits must not exceed 32.
+    void WriteBits(unsigned value, unsigned numBits);
+    /// Write single bit.
+    void WriteBool(bool value) { WriteBits(value ? 1u : 0u, 1); }
+    /// Write float quantized in range with specified number of bits. Value is clamped to range.
+    void WriteQuantizedFloat(float value, float minValue, float maxValue, unsigned numBits);
+    /// Write vector with components quantized in range.
+    void WriteQuantizedVector3(const Vector3& value, float minValue, float maxValue, unsigned numBits);
+    /// Write unit quaternion as three smallest components quantized with specified number of bits, plus two bits of index.
+    void WriteQuantizedQuaternion(const Quaternion& value, unsigned numBits);
+    /// Write float without quantization.
+    void WriteFloat(float value);
+    /// Write vector without quantization.
+    void WriteVector3(const Vector3& value);
+
+    /// Write pending bits padded with zeros to whole byte.
+    void Flush();
+
+private:
+    Serializer& dest_;
+    unsigned long long pendingBits_{};
+    unsigned numPendingBits_{};
+};
+
+/// Reads values written by BitStreamWriter from deserializer.
+/// Reader consumes exactly as many bytes as writer wrote for the same sequence of values.
+class URHO3D_API BitStreamReader
+{
+public:
+    /// Construct.
+    explicit BitStreamReader(Deserializer& src) : src_(src) {}
+
+    /// Read value of specified bit width. Number of bits must not exceed 32.
+    unsigned ReadBits(unsigned numBits);
+    /// Read single bit.
+    bool ReadBool() { return ReadBits(1) != 0; }
+    /// Read float quantized in range.
+    float ReadQuantizedFloat(float minValue, float maxValue, unsigned numBits);
+    /// Read vector with components quantized in range.
+    Vector3 ReadQuantizedVector3(float minValue, float maxValue, unsigned numBits);
+    /// Read unit quaternion stored as three smallest components.
+    Quaternion ReadQuantizedQuaternion(unsigned numBits);
+    /// Read float without quantization.
+    float ReadFloat();
+    /// Read vector without quantization.
+    Vector3 ReadVector3();
+
+    /// Discard remaining bits of the current byte.
+    void Reset() { pendingBits_ = 0; numPendingBits_ = 0; }
+
+private:
+    Deserializer& src_;
+    unsigned long long pendingBits_{};
+    unsigned numPendingBits_{};
+};
+
+/// Return number of bits required to quantize range with specified precision.
+URHO3D_API unsigned GetNumQuantizationBits(float range, float precision);
+
+}
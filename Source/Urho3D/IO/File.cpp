@@ -23,6 +23,7 @@
 #include "../Precompiled.h"
 
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../IO/File.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
@@ -37,6 +38,7 @@
 #include <emscripten/emscripten.h>
 #endif
 
+#include <atomic>
 #include <cstdio>
 #include <LZ4/lz4.h>
 
@@ -152,6 +154,12 @@ bool File::Open(PackageFile* package, const ea::string& fileName)
     checksum_ = entry->checksum_;
     size_ = entry->size_;
     compressed_ = package->IsCompressed();
+    if (compressed_ && package->GetBlockSize() && !entry->blockOffsets_.empty())
+    {
+        blockSize_ = package->GetBlockSize();
+        packedSize_ = entry->packedSize_;
+        blockOffsets_ = entry->blockOffsets_;
+    }
 
     // Seek to beginning of package entry's file data
     SeekInternal(offset_);
@@ -219,6 +227,23 @@ unsigned File::Read(void* dest, unsigned size)
 
         while (sizeLeft)
         {
+            // Large reads starting from block boundary bypass the read buffer
+            if (blockSize_ && readBufferOffset_ >= readBufferSize_ && sizeLeft >= blockSize_)
+            {
+                const unsigned bytesRead = ReadCompressedBlocks(destPtr, sizeLeft);
+                if (bytesRead)
+                {
+                    // Read buffer no longer matches current position
+                    readBufferOffset_ = 0;
+                    readBufferSize_ = 0;
+                }
+                destPtr += bytesRead;
+                sizeLeft -= bytesRead;
+                position_ += bytesRead;
+                if (!sizeLeft)
+                    break;
+            }
+
             if (!readBuffer_ || readBufferOffset_ >= readBufferSize_)
             {
                 unsigned char blockHeaderBytes[4];
@@ -230,8 +255,10 @@ unsigned File::Read(void* dest, unsigned size)
 
                 if (!readBuffer_)
                 {
-                    readBuffer_ = new unsigned char[unpackedSize];
-                    inputBuffer_ = new unsigned char[LZ4_compressBound(unpackedSize)];
+                    // Random access may start from the last block, which can be smaller than the rest
+                    const unsigned bufferSize = Max(unpackedSize, blockSize_);
+                    readBuffer_ = new unsigned char[bufferSize];
+                    inputBuffer_ = new unsigned char[LZ4_compressBound(bufferSize)];
                 }
 
                 /// \todo Handle errors
@@ -295,6 +322,18 @@ unsigned File::Seek(unsigned position)
             readBufferSize_ = 0;
             SeekInternal(offset_);
         }
+        // Jump directly to the block if the package has block index
+        else if (blockSize_)
+        {
+            const unsigned bufferStart = position_ - readBufferOffset_;
+            if (position < bufferStart || position >= bufferStart + readBufferSize_)
+                SeekCompressedBlock(position);
+            else
+            {
+                readBufferOffset_ = position - bufferStart;
+                position_ = position;
+            }
+        }
         // Skip bytes
         else if (position >= position_)
         {
@@ -446,6 +485,9 @@ bool File::OpenInternal(const ea::string& fileName, FileMode mode, bool fromPack
     Close();
 
     compressed_ = false;
+    blockSize_ = 0;
+    packedSize_ = 0;
+    blockOffsets_.clear();
     readSyncNeeded_ = false;
     writeSyncNeeded_ = false;
 
@@ -568,6 +610,84 @@ void File::SeekInternal(unsigned newPosition)
         fseek((FILE*)handle_, newPosition, SEEK_SET);
 }
 
+bool File::SeekCompressedBlock(unsigned position)
+{
+    const auto blockIndex = Min(position / blockSize_, static_cast<unsigned>(blockOffsets_.size() - 1));
+    SeekInternal(offset_ + blockOffsets_[blockIndex]);
+    readBufferOffset_ = 0;
+    readBufferSize_ = 0;
+    position_ = blockIndex * blockSize_;
+
+    unsigned char skipBuffer[SKIP_BUFFER_SIZE];
+    while (position > position_)
+    {
+        if (!Read(skipBuffer, Min(position - position_, SKIP_BUFFER_SIZE)))
+            return false;
+    }
+    return true;
+}
+
+unsigned File::ReadCompressedBlocks(unsigned char* dest, unsigned size)
+{
+    if (position_ % blockSize_ != 0)
+        return 0;
+
+    const auto totalBlocks = static_cast<unsigned>(blockOffsets_.size());
+    const unsigned firstBlock = position_ / blockSize_;
+    unsigned numBlocks = Min(size / blockSize_, totalBlocks - Min(firstBlock, totalBlocks));
+    // Size of the last block is only known from the packed size of the entry
+    if (firstBlock + numBlocks == totalBlocks && !packedSize_ && numBlocks)
+        --numBlocks;
+    if (!numBlocks)
+        return 0;
+
+    const unsigned beginOffset = blockOffsets_[firstBlock];
+    const unsigned endOffset = firstBlock + numBlocks < totalBlocks ? blockOffsets_[firstBlock + numBlocks] : packedSize_;
+    if (endOffset <= beginOffset)
+        return 0;
+
+    ea::vector<unsigned char> packedData(endOffset - beginOffset);
+    if (!ReadInternal(packedData.data(), packedData.size()))
+    {
+        SeekInternal(offset_ + beginOffset);
+        return 0;
+    }
+
+    std::atomic<bool> failed{false};
+    const auto decompressBlocks = [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            const unsigned blockOffset = blockOffsets_[firstBlock + i] - beginOffset;
+            const unsigned blockEnd = i + 1 < numBlocks ? blockOffsets_[firstBlock + i + 1] - beginOffset : packedData.size();
+            MemoryBuffer blockHeader(packedData.data() + blockOffset, 4);
+            const unsigned unpackedSize = blockHeader.ReadUShort();
+            const unsigned packedSize = blockHeader.ReadUShort();
+            if (unpackedSize != blockSize_ || blockOffset + 4 + packedSize > blockEnd
+                || LZ4_decompress_safe(reinterpret_cast<const char*>(packedData.data() + blockOffset + 4),
+                    reinterpret_cast<char*>(dest + i * blockSize_), packedSize, blockSize_) != static_cast<int>(unpackedSize))
+            {
+                failed = true;
+            }
+        }
+    };
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    if (workQueue && workQueue->GetNumThreads() > 0)
+        ForEachParallel(workQueue, 1u, numBlocks, decompressBlocks);
+    else
+        decompressBlocks(0, numBlocks);
+
+    if (failed)
+    {
+        URHO3D_LOGERROR("Corrupted compressed data in file " + GetName());
+        SeekInternal(offset_ + beginOffset);
+        return 0;
+    }
+
+    return numBlocks * blockSize_;
+}
+
 void File::ReadBinary(ea::vector<unsigned char>& buffer)
 {
     buffer.clear();
@@ -127,6 +127,10 @@ private:
     bool ReadInternal(void* dest, unsigned size);
     /// Seek in file internally using either C standard IO functions or SDL RWops for Android asset files.
     void SeekInternal(unsigned newPosition);
+    /// Read and decompress the block containing the position of a compressed file with block index.
+    bool SeekCompressedBlock(unsigned position);
+    /// Decompress consecutive whole blocks of a compressed file with block index directly into the destination, using worker threads if available. Return number of bytes read.
+    unsigned ReadCompressedBlocks(unsigned char* dest, unsigned size);
 
     /// Absolute file name.
     ea::string absoluteFileName_;
@@ -152,6 +156,12 @@ private:
     unsigned checksum_;
     /// Compression flag.
     bool compressed_;
+    /// Uncompressed size of compressed blocks, 0 if the package has no block index.
+    unsigned blockSize_{};
+    /// Size of compressed file data in a package with block index.
+    unsigned packedSize_{};
+    /// Offsets of compressed blocks from the beginning of compressed file data.
+    ea::vector<unsigned> blockOffsets_;
     /// Synchronization needed before read -flag.
     bool readSyncNeeded_;
     /// Synchronization needed before write -flag.
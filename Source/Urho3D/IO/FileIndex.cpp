@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../IO/FileIndex.h"
+
+#include "../IO/Deserializer.h"
+#include "../IO/FileSystem.h"
+#include "../IO/FileWatcher.h"
+#include "../IO/Serializer.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+bool IsHiddenPath(const ea::string& fileName)
+{
+    return fileName.starts_with(".") || fileName.contains("/.");
+}
+
+}
+
+FileIndex::FileIndex(const ea::string& directory)
+    : directory_(AddTrailingSlash(directory))
+{
+}
+
+void FileIndex::Build(const FileSystem* fileSystem)
+{
+    ea::vector<ea::string> fileNames;
+    fileSystem->ScanDir(fileNames, directory_, "*", SCAN_FILES | SCAN_HIDDEN, true);
+
+    files_.clear();
+    for (const ea::string& fileName : fileNames)
+        AddFile(fileName);
+}
+
+void FileIndex::ApplyChange(const FileSystem* fileSystem, const FileChange& change)
+{
+    const auto addFileOrDirectory = [&](const ea::string& fileName)
+    {
+        if (fileSystem->FileExists(directory_ + fileName))
+            AddFile(fileName);
+        else if (fileSystem->DirExists(directory_ + fileName))
+        {
+            ea::vector<ea::string> fileNames;
+            fileSystem->ScanDir(fileNames, directory_ + fileName, "*", SCAN_FILES | SCAN_HIDDEN, true);
+            for (const ea::string& nestedFileName : fileNames)
+                AddFile(AddTrailingSlash(fileName) + nestedFileName);
+        }
+    };
+
+    switch (change.kind_)
+    {
+    case FILECHANGE_ADDED:
+    case FILECHANGE_MODIFIED:
+        addFileOrDirectory(change.fileName_);
+        break;
+
+    case FILECHANGE_REMOVED:
+        RemoveFile(change.fileName_);
+        break;
+
+    case FILECHANGE_RENAMED:
+        RemoveFile(change.oldFileName_);
+        addFileOrDirectory(change.fileName_);
+        break;
+    }
+}
+
+void FileIndex::AddFile(const ea::string& fileName)
+{
+    files_[GetKey(fileName)] = fileName;
+}
+
+void FileIndex::RemoveFile(const ea::string& fileName)
+{
+    const ea::string key = GetKey(fileName);
+    if (files_.erase(key))
+        return;
+
+    // Removed directory takes all nested files with it
+    const ea::string prefix = AddTrailingSlash(key);
+    for (auto iter = files_.begin(); iter != files_.end();)
+    {
+        if (iter->first.starts_with(prefix))
+            iter = files_.erase(iter);
+        else
+            ++iter;
+    }
+}
+
+bool FileIndex::Save(Serializer& dest) const
+{
+    if (!dest.WriteString(directory_) || !dest.WriteVLE(files_.size()))
+        return false;
+
+    for (const auto& [key, fileName] : files_)
+    {
+        if (!dest.WriteString(fileName))
+            return false;
+    }
+    return true;
+}
+
+bool FileIndex::Load(Deserializer& source)
+{
+    directory_ = source.ReadString();
+    files_.clear();
+
+    const unsigned numFiles = source.ReadVLE();
+    for (unsigned i = 0; i < numFiles; ++i)
+    {
+        if (source.IsEof())
+            return false;
+        AddFile(source.ReadString());
+    }
+    return true;
+}
+
+bool FileIndex::Contains(const ea::string& fileName) const
+{
+    return files_.contains(GetKey(fileName));
+}
+
+void FileIndex::Scan(ea::vector<ea::string>& result, const ea::string& pathName, const ea::string& filter, unsigned flags, bool recursive) const
+{
+    result.clear();
+    if (!(flags & SCAN_FILES))
+        return;
+
+    // Same filtering rules as FileSystem::ScanDir
+    ea::string filterExtension;
+    const unsigned dotPos = filter.find_last_of('.');
+    if (dotPos != ea::string::npos)
+        filterExtension = filter.substr(dotPos);
+    if (filterExtension.contains('*'))
+        filterExtension.clear();
+
+    const ea::string prefix = pathName.empty() ? EMPTY_STRING : GetKey(AddTrailingSlash(pathName));
+    for (const auto& [key, fileName] : files_)
+    {
+        if (!key.starts_with(prefix))
+            continue;
+
+        const ea::string relativeName = fileName.substr(prefix.length());
+        if (!recursive && relativeName.contains('/'))
+            continue;
+        if (!(flags & SCAN_HIDDEN) && IsHiddenPath(relativeName))
+            continue;
+        if (!filterExtension.empty() && !relativeName.ends_with(filterExtension))
+            continue;
+
+        result.push_back(relativeName);
+    }
+}
+
+ea::string FileIndex::GetKey(const ea::string& fileName)
+{
+#ifdef _WIN32
+    return fileName.to_lower();
+#else
+    return fileName;
+#endif
+}
+
+}
@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Container/RefCounted.h"
+#include "../Container/Str.h"
+
+#include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class Deserializer;
+class FileSystem;
+class Serializer;
+struct FileChange;
+
+/// In-memory index of the files in a directory tree.
+/// Answers existence checks and scans without querying the OS file system.
+class URHO3D_API FileIndex : public RefCounted
+{
+public:
+    /// Construct empty index for the directory.
+    explicit FileIndex(const ea::string& directory);
+
+    /// Scan the directory recursively and rebuild the index.
+    void Build(const FileSystem* fileSystem);
+    /// Update the index after the change reported by FileWatcher.
+    void ApplyChange(const FileSystem* fileSystem, const FileChange& change);
+    /// Add file to the index. File name is relative to the directory.
+    void AddFile(const ea::string& fileName);
+    /// Remove file or directory with all its contents from the index. File name is relative to the directory.
+    void RemoveFile(const ea::string& fileName);
+
+    /// Write the index. Return true if successful.
+    bool Save(Serializer& dest) const;
+    /// Read the index written by Save. Return true if successful.
+    bool Load(Deserializer& source);
+
+    /// Return whether the file exists. File name is relative to the directory.
+    /// This will be case-insensitive on Windows and case-sensitive on other platforms.
+    bool Contains(const ea::string& fileName) const;
+    /// Scan files in the index, similarly to FileSystem::ScanDir for SCAN_FILES with optional SCAN_HIDDEN.
+    void Scan(ea::vector<ea::string>& result, const ea::string& pathName, const ea::string& filter, unsigned flags, bool recursive) const;
+
+    /// Return indexed directory.
+    const ea::string& GetDirectory() const { return directory_; }
+    /// Return number of indexed files.
+    unsigned GetNumFiles() const { return files_.size(); }
+
+private:
+    /// Return lookup key for the file name.
+    static ea::string GetKey(const ea::string& fileName);
+
+    /// Indexed directory with trailing slash.
+    ea::string directory_;
+    /// Indexed files by lookup key. Values are file names relative to the directory.
+    ea::unordered_map<ea::string, ea::string> files_;
+};
+
+}
@@ -22,8 +22,10 @@
 
 #include "../Precompiled.h"
 
+#include "../Container/MultipleProducerQueue.h"
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
+#include "../Core/Profiler.h"
 #include "../Core/Thread.h"
 #include "../Core/Timer.h"
 #include "../IO/IOEvents.h"
@@ -39,10 +41,14 @@
 #else
 #include <spdlog/sinks/stdout_sinks.h>
 #endif
+#include <spdlog/details/log_msg_buffer.h>
 #include <spdlog/details/null_mutex.h>
 
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
 #include <cstdio>
+#include <thread>
 
 #ifdef __ANDROID__
 #include <android/log.h>
@@ -142,8 +148,153 @@ private:
     ea::vector<MessageInfo> lastMessages_;
 };
 
+/// Sink that forwards messages to target sink either immediately or from background thread.
+/// In asynchronous mode messages are pushed to lock-free queue, so pattern formatting and I/O don't block callers.
+class AsyncSink : public spdlog::sinks::sink
+{
+public:
+    static constexpr unsigned QueueCapacity = 8192;
+    static constexpr std::chrono::milliseconds IdleInterval{10};
+
+    explicit AsyncSink(std::shared_ptr<spdlog::sinks::sink> target)
+        : target_(std::move(target))
+    {
+    }
+
+    ~AsyncSink() override { SetAsync(false); }
+
+    void SetAsync(bool async)
+    {
+        if (async == IsAsync())
+            return;
+
+        if (async)
+        {
+            if (queue_.GetCapacity() == 0)
+                queue_.Allocate(QueueCapacity);
+
+            stopping_ = false;
+            thread_ = ea::make_unique<WriterThread>(this);
+            thread_->Run();
+            async_.store(true, std::memory_order_release);
+        }
+        else
+        {
+            async_.store(false, std::memory_order_release);
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex_);
+                stopping_ = true;
+            }
+            wakeCondition_.notify_one();
+            thread_->Stop();
+            thread_ = nullptr;
+
+            // Write messages pushed after the thread has stopped
+            DrainQueue();
+            target_->flush();
+        }
+    }
+
+    bool IsAsync() const { return async_.load(std::memory_order_acquire); }
+
+    void log(const spdlog::details::log_msg& msg) override
+    {
+        if (!IsAsync())
+        {
+            target_->log(msg);
+            return;
+        }
+
+        spdlog::details::log_msg_buffer buffer{msg};
+        while (!queue_.Push(buffer))
+        {
+            // Queue is full, wait for background thread to catch up
+            wakeCondition_.notify_one();
+            std::this_thread::yield();
+        }
+
+        if (msg.level >= spdlog::level::err)
+            wakeCondition_.notify_one();
+    }
+
+    void flush() override
+    {
+        if (!IsAsync())
+            target_->flush();
+        else
+        {
+            flushRequested_.store(true, std::memory_order_relaxed);
+            wakeCondition_.notify_one();
+        }
+    }
+
+    void set_pattern(const std::string& pattern) override { target_->set_pattern(pattern); }
+
+    void set_formatter(std::unique_ptr<spdlog::formatter> formatter) override
+    {
+        target_->set_formatter(std::move(formatter));
+    }
+
+private:
+    class WriterThread : public Thread
+    {
+    public:
+        explicit WriterThread(AsyncSink* owner)
+            : Thread("LogWriter")
+            , owner_(owner)
+        {
+        }
+
+        void ThreadFunction() override
+        {
+            URHO3D_PROFILE_THREAD(name_.c_str());
+            owner_->ProcessQueue();
+        }
+
+    private:
+        AsyncSink* owner_{};
+    };
+
+    void ProcessQueue()
+    {
+        while (true)
+        {
+            DrainQueue();
+            if (flushRequested_.exchange(false, std::memory_order_relaxed))
+                target_->flush();
+
+            // Poll with timeout instead of signalling from every producer so that logging stays lock-free
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            if (stopping_)
+                break;
+            wakeCondition_.wait_for(lock, IdleInterval);
+        }
+    }
+
+    void DrainQueue()
+    {
+        spdlog::details::log_msg_buffer buffer;
+        while (queue_.Pop(buffer))
+            target_->log(buffer);
+    }
+
+    std::shared_ptr<spdlog::sinks::sink> target_;
+
+    MultipleProducerQueue<spdlog::details::log_msg_buffer> queue_;
+    std::atomic<bool> async_{};
+    std::atomic<bool> flushRequested_{};
+
+    ea::unique_ptr<WriterThread> thread_;
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCondition_;
+    bool stopping_{};
+};
+
 }
 
+/// Number of messages from other threads that can be queued without locking between frames.
+static const unsigned THREAD_MESSAGES_CAPACITY = 4096;
+
 static Log* GetLog()
 {
     auto* context = Context::GetInstance();
@@ -266,6 +417,15 @@ Logger::Logger(void* logger)
 {
 }
 
+bool Logger::IsEnabled(LogLevel level) const
+{
+    if (logger_ == nullptr)
+        return false;
+
+    auto* logger = reinterpret_cast<spdlog::logger*>(logger_);
+    return logger->should_log(ConvertLogLevel(level));
+}
+
 void Logger::Write(LogLevel level, ea::string_view message) const
 {
     if (logger_ == nullptr)
@@ -325,7 +485,9 @@ public:
             std::chrono::seconds(5), spdlog::level::err, 10);
         dupFilterSink_->add_sink(distributorSink_);
 
-        mainSink_ = dupFilterSink_;
+        asyncSink_ = std::make_shared<AsyncSink>(dupFilterSink_);
+
+        mainSink_ = asyncSink_;
     }
 
 #ifdef __ANDROID__
@@ -351,6 +513,8 @@ public:
     std::shared_ptr<spdlog::sinks::dist_sink_mt> distributorSink_;
     /// Sink that filters out duplicate messages.
     std::shared_ptr<DuplicateFilterSink> dupFilterSink_;
+    /// Sink that optionally defers writing to background thread.
+    std::shared_ptr<AsyncSink> asyncSink_;
 
     /// Sink that should be used for logging.
     std::shared_ptr<spdlog::sinks::sink> mainSink_;
@@ -363,6 +527,7 @@ Log::Log(Context* context) :
     defaultLogger_(GetOrCreateLogger("main"))
 {
     impl_->platformSink_->set_pattern(formatPattern_.c_str());
+    threadMessages_.Allocate(THREAD_MESSAGES_CAPACITY);
 
 #if !__EMSCRIPTEN__
     spdlog::flush_every(std::chrono::seconds(5));
@@ -372,6 +537,7 @@ Log::Log(Context* context) :
 
 Log::~Log()
 {
+    impl_->asyncSink_->SetAsync(false);
     spdlog::shutdown();
 }
 
@@ -421,6 +587,18 @@ void Log::SetQuiet(bool quiet)
     impl_->platformSink_->set_level(ConvertLogLevel(quiet ? LOG_NONE : level_));
 }
 
+void Log::SetAsync(bool async)
+{
+#ifdef URHO3D_THREADING
+    impl_->asyncSink_->SetAsync(async);
+#endif
+}
+
+bool Log::IsAsync() const
+{
+    return impl_->asyncSink_->IsAsync();
+}
+
 void Log::SetLogFormat(const ea::string& format)
 {
     formatPattern_ = format;
@@ -497,8 +675,13 @@ void Log::SendMessageEvent(LogLevel level, time_t timestamp, const ea::string& l
     // If not in the main thread, store message for later processing
     if (!Thread::IsMainThread())
     {
-        MutexLock lock(logMutex_);
-        threadMessages_.push_back(StoredLogMessage(level, timestamp, logger, message));
+        StoredLogMessage stored(level, timestamp, logger, message);
+        if (!threadMessages_.Push(stored))
+        {
+            MutexLock lock(logMutex_);
+            overflowThreadMessages_.push_back(ea::move(stored));
+            hasOverflowThreadMessages_.store(true, std::memory_order_release);
+        }
         return;
     }
 
@@ -533,14 +716,23 @@ void Log::PumpThreadMessages()
         return;
     }
 
-    MutexLock lock(logMutex_);
-
     // Process messages accumulated from other threads (if any)
-    while (!threadMessages_.empty())
-    {
-        const StoredLogMessage& stored = threadMessages_.front();
+    StoredLogMessage stored;
+    while (threadMessages_.Pop(stored))
         SendMessageEvent(stored.level_, stored.timestamp_, stored.logger_, stored.message_);
-        threadMessages_.pop_front();
+
+    if (hasOverflowThreadMessages_.load(std::memory_order_acquire))
+    {
+        ea::list<StoredLogMessage> overflowMessages;
+        {
+            MutexLock lock(logMutex_);
+            overflowMessages.swap(overflowThreadMessages_);
+            hasOverflowThreadMessages_.store(false, std::memory_order_relaxed);
+        }
+
+        for (const StoredLogMessage& overflowStored : overflowMessages)
+            SendMessageEvent(overflowStored.level_, overflowStored.timestamp_, overflowStored.logger_,
+                overflowStored.message_);
     }
 }
 
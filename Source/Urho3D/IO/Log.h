@@ -24,6 +24,7 @@
 
 #include <EASTL/list.h>
 
+#include "../Container/MultipleProducerQueue.h"
 #include "../Core/Assert.h"
 #include "../Core/Macros.h"
 #include "../Core/Mutex.h"
@@ -119,11 +120,24 @@ public:
     Logger() = default;
     Logger(const Logger& other) = default;
 
-    /// Write formatted message to log if there are extra arguments.
+    /// Write formatted message to log if there are extra arguments. Message is not formatted if the level is disabled.
     template <class Arg, class... Args>
-    void Write(LogLevel level, ea::string_view format, const Arg& arg, const Args&... args) const { Write(level, Format(format, arg, args...)); }
+    void Write(LogLevel level, ea::string_view format, const Arg& arg, const Args&... args) const
+    {
+        if (IsEnabled(level))
+            Write(level, Format(format, arg, args...));
+    }
     /// Write message to log as is if there's no extra arguments.
     void Write(LogLevel level, ea::string_view message) const;
+    /// Write message formatted with printf-style format string. Message is not formatted if the level is disabled.
+    template <class... Args>
+    void WriteF(LogLevel level, const char* format, Args... args) const
+    {
+        if (IsEnabled(level))
+            Write(level, ToString(format, args...));
+    }
+    /// Return whether the messages of specified level are written.
+    bool IsEnabled(LogLevel level) const;
 
     template<typename... Args> void Trace(ea::string_view format, Args... args) const   { Write(LOG_TRACE, format, args...); }
     template<typename... Args> void Debug(ea::string_view format, Args... args) const   { Write(LOG_DEBUG, format, args...); }
@@ -162,6 +176,10 @@ public:
     /// Set quiet mode ie. only print error entries to standard error stream (which is normally redirected to console also). Output to log file is not affected by this mode.
     /// @property
     void SetQuiet(bool quiet);
+    /// Set asynchronous mode. Messages are pushed to lock-free queue and written to sinks from background thread.
+    /// Should not be toggled while other threads are logging.
+    /// @property
+    void SetAsync(bool async);
 
     /// Return logging level.
     /// @property
@@ -170,6 +188,9 @@ public:
     /// Return whether log is in quiet mode (only errors printed to standard error stream).
     /// @property
     bool IsQuiet() const { return quiet_; }
+    /// Return whether log is in asynchronous mode.
+    /// @property
+    bool IsAsync() const;
 
     /// Returns a logger with specified name.
     static Logger GetLogger(const ea::string& name);
@@ -191,8 +212,12 @@ private:
     ea::string formatPattern_{};
     /// Mutex for threaded operation.
     Mutex logMutex_{};
-    /// Log messages from other threads.
-    ea::list<StoredLogMessage> threadMessages_{};
+    /// Log messages from other threads. Pushed without locking.
+    MultipleProducerQueue<StoredLogMessage> threadMessages_;
+    /// Log messages from other threads that did not fit into the queue. Protected by logMutex_.
+    ea::list<StoredLogMessage> overflowThreadMessages_{};
+    /// Whether there are overflow messages. Checked without locking.
+    std::atomic<bool> hasOverflowThreadMessages_{};
     /// Logging level.
 #ifdef _DEBUG
     LogLevel level_ = LOG_DEBUG;
@@ -207,34 +232,49 @@ private:
     Logger defaultLogger_;
 };
 
-#ifdef URHO3D_LOGGING
+/// Messages below this level are removed at compile time, arguments are not evaluated.
+#ifndef URHO3D_LOGGING_MIN_LEVEL
+#define URHO3D_LOGGING_MIN_LEVEL 0
+#endif
 
+#if defined(URHO3D_LOGGING) && URHO3D_LOGGING_MIN_LEVEL <= 0
 #define URHO3D_LOGTRACE(message, ...) Urho3D::Log::GetLogger().Trace(message, ##__VA_ARGS__)
-#define URHO3D_LOGDEBUG(message, ...) Urho3D::Log::GetLogger().Debug(message, ##__VA_ARGS__)
-#define URHO3D_LOGINFO(message, ...) Urho3D::Log::GetLogger().Info(message, ##__VA_ARGS__)
-#define URHO3D_LOGWARNING(message, ...) Urho3D::Log::GetLogger().Warning(message, ##__VA_ARGS__)
-#define URHO3D_LOGERROR(message, ...) Urho3D::Log::GetLogger().Error(message, ##__VA_ARGS__)
-
-#define URHO3D_LOGTRACEF(format, ...) Urho3D::Log::GetLogger().Write(Urho3D::LOG_TRACE, Urho3D::ToString(format, ##__VA_ARGS__))
-#define URHO3D_LOGDEBUGF(format, ...) Urho3D::Log::GetLogger().Write(Urho3D::LOG_DEBUG, Urho3D::ToString(format, ##__VA_ARGS__))
-#define URHO3D_LOGINFOF(format, ...) Urho3D::Log::GetLogger().Write(Urho3D::LOG_INFO, Urho3D::ToString(format, ##__VA_ARGS__))
-#define URHO3D_LOGWARNINGF(format, ...) Urho3D::Log::GetLogger().Write(Urho3D::LOG_WARNING, Urho3D::ToString(format, ##__VA_ARGS__))
-#define URHO3D_LOGERRORF(format, ...) Urho3D::Log::GetLogger().Write(Urho3D::LOG_ERROR, Urho3D::ToString(format, ##__VA_ARGS__))
-
+#define URHO3D_LOGTRACEF(format, ...) Urho3D::Log::GetLogger().WriteF(Urho3D::LOG_TRACE, format, ##__VA_ARGS__)
 #else
-
 #define URHO3D_LOGTRACE(...) ((void)0)
-#define URHO3D_LOGDEBUG(...) ((void)0)
-#define URHO3D_LOGINFO(...) ((void)0)
-#define URHO3D_LOGWARNING(...) ((void)0)
-#define URHO3D_LOGERROR(...) ((void)0)
-
 #define URHO3D_LOGTRACEF(...) ((void)0)
+#endif
+
+#if defined(URHO3D_LOGGING) && URHO3D_LOGGING_MIN_LEVEL <= 1
+#define URHO3D_LOGDEBUG(message, ...) Urho3D::Log::GetLogger().Debug(message, ##__VA_ARGS__)
+#define URHO3D_LOGDEBUGF(format, ...) Urho3D::Log::GetLogger().WriteF(Urho3D::LOG_DEBUG, format, ##__VA_ARGS__)
+#else
+#define URHO3D_LOGDEBUG(...) ((void)0)
 #define URHO3D_LOGDEBUGF(...) ((void)0)
+#endif
+
+#if defined(URHO3D_LOGGING) && URHO3D_LOGGING_MIN_LEVEL <= 2
+#define URHO3D_LOGINFO(message, ...) Urho3D::Log::GetLogger().Info(message, ##__VA_ARGS__)
+#define URHO3D_LOGINFOF(format, ...) Urho3D::Log::GetLogger().WriteF(Urho3D::LOG_INFO, format, ##__VA_ARGS__)
+#else
+#define URHO3D_LOGINFO(...) ((void)0)
 #define URHO3D_LOGINFOF(...) ((void)0)
+#endif
+
+#if defined(URHO3D_LOGGING) && URHO3D_LOGGING_MIN_LEVEL <= 3
+#define URHO3D_LOGWARNING(message, ...) Urho3D::Log::GetLogger().Warning(message, ##__VA_ARGS__)
+#define URHO3D_LOGWARNINGF(format, ...) Urho3D::Log::GetLogger().WriteF(Urho3D::LOG_WARNING, format, ##__VA_ARGS__)
+#else
+#define URHO3D_LOGWARNING(...) ((void)0)
 #define URHO3D_LOGWARNINGF(...) ((void)0)
-#define URHO3D_LOGERRORF(...) ((void)0)
+#endif
 
+#if defined(URHO3D_LOGGING) && URHO3D_LOGGING_MIN_LEVEL <= 4
+#define URHO3D_LOGERROR(message, ...) Urho3D::Log::GetLogger().Error(message, ##__VA_ARGS__)
+#define URHO3D_LOGERRORF(format, ...) Urho3D::Log::GetLogger().WriteF(Urho3D::LOG_ERROR, format, ##__VA_ARGS__)
+#else
+#define URHO3D_LOGERROR(...) ((void)0)
+#define URHO3D_LOGERRORF(...) ((void)0)
 #endif
 
 }
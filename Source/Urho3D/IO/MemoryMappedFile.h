@@ -0,0 +1,94 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Container/Ptr.h"
+#include "../Container/RefCounted.h"
+#include "../IO/MemoryBuffer.h"
+
+namespace Urho3D
+{
+
+/// Read-only file mapped into memory. Pages are loaded by the OS on first access.
+class URHO3D_API MemoryMappedFile : public RefCounted
+{
+public:
+    /// Construct.
+    MemoryMappedFile() = default;
+    /// Construct and open.
+    explicit MemoryMappedFile(const ea::string& fileName);
+    /// Destruct. Unmaps the file.
+    ~MemoryMappedFile() override;
+
+    /// Map the file. Return true if successful.
+    bool Open(const ea::string& fileName);
+    /// Unmap the file.
+    void Close();
+
+    /// Return whether the file is mapped.
+    bool IsOpen() const { return data_ != nullptr; }
+    /// Return file name.
+    const ea::string& GetName() const { return fileName_; }
+    /// Return mapped data.
+    const unsigned char* GetData() const { return data_; }
+    /// Return size of mapped data.
+    unsigned GetSize() const { return size_; }
+
+private:
+    /// File name.
+    ea::string fileName_;
+    /// Mapped data.
+    const unsigned char* data_{};
+    /// Size of mapped data.
+    unsigned size_{};
+#ifdef _WIN32
+    /// File handle.
+    void* fileHandle_{};
+    /// File mapping handle.
+    void* mappingHandle_{};
+#endif
+};
+
+/// Read-only view of a memory mapped file region. Keeps the mapping alive.
+/// Consumers that can work with raw bytes can access them via GetData() without intermediate copies.
+/// @nobind
+class URHO3D_API MemoryMappedFileView : public RefCounted, public MemoryBuffer
+{
+public:
+    /// Construct from mapping and region within it.
+    MemoryMappedFileView(MemoryMappedFile* mapping, unsigned offset, unsigned size, const ea::string& name, unsigned checksum);
+
+    /// Return checksum of the region.
+    unsigned GetChecksum() override { return checksum_; }
+    /// Return mapping.
+    MemoryMappedFile* GetMapping() const { return mapping_; }
+
+private:
+    /// Mapping.
+    SharedPtr<MemoryMappedFile> mapping_;
+    /// Checksum.
+    unsigned checksum_{};
+};
+
+}
@@ -62,6 +62,20 @@ ea::string MountedDirectory::SanitizeDirName(const ea::string& name) const
     return fixedPath;
 }
 
+void MountedDirectory::SetFileIndexEnabled(bool enable)
+{
+    if (enable == IsFileIndexEnabled())
+        return;
+
+    if (enable)
+    {
+        fileIndex_ = MakeShared<FileIndex>(directory_);
+        fileIndex_->Build(GetSubsystem<FileSystem>());
+    }
+    else
+        fileIndex_ = nullptr;
+}
+
 /// Checks if mount point accepts scheme.
 bool MountedDirectory::AcceptsScheme(const ea::string& scheme) const
 {
@@ -75,6 +89,9 @@ bool MountedDirectory::Exists(const FileIdentifier& fileName) const
     if (!AcceptsScheme(fileName.scheme_))
         return false;
 
+    if (fileIndex_)
+        return fileIndex_->Contains(fileName.fileName_);
+
     const auto fileSystem = context_->GetSubsystem<FileSystem>();
 
     return fileSystem->FileExists(directory_ + fileName.fileName_);
@@ -98,7 +115,7 @@ AbstractFilePtr MountedDirectory::OpenFile(const FileIdentifier& fileName, FileM
                 return AbstractFilePtr();
     }
 
-    if (mode == FILE_READ && !fileSystem->FileExists(fullPath))
+    if (mode == FILE_READ && !(fileIndex_ ? fileIndex_->Contains(fileName.fileName_) : fileSystem->FileExists(fullPath)))
         return AbstractFilePtr();
 
     // Construct the file first with full path, then rename it to not contain the resource path,
@@ -108,6 +125,9 @@ AbstractFilePtr MountedDirectory::OpenFile(const FileIdentifier& fileName, FileM
     if (!file->IsOpen())
         return AbstractFilePtr();
 
+    if (fileIndex_ && mode != FILE_READ)
+        fileIndex_->AddFile(fileName.fileName_);
+
     return file;
 }
 
@@ -23,6 +23,7 @@
 #pragma once
 
 #include "FileWatcher.h"
+#include "../IO/FileIndex.h"
 #include "../IO/MountPoint.h"
 #include "../Container/FlagSet.h"
 
@@ -57,6 +58,12 @@ public:
     /// Get mounted directory path.
     const ea::string& GetDirectory() const { return directory_; }
 
+    /// Enable or disable in-memory index of the files in the directory, which replaces file system queries in existence checks.
+    /// Files written through this mount point are added to the index, external changes are not tracked. Default false.
+    void SetFileIndexEnabled(bool enable);
+    /// Return whether the file index is enabled.
+    bool IsFileIndexEnabled() const { return fileIndex_ != nullptr; }
+
 protected:
     ea::string SanitizeDirName(const ea::string& name) const;
 
@@ -67,6 +74,8 @@ private:
     const ea::string directory_;
     /// Name of the mount point.
     const ea::string name_;
+    /// File index, if enabled.
+    SharedPtr<FileIndex> fileIndex_;
 };
 
 } // namespace Urho3D
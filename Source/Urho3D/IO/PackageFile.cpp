@@ -90,17 +90,26 @@ bool PackageFile::Open(const ea::string& fileName, unsigned startOffset)
     compressed_ = id == "ULZ4" || id == "RLZ4";
     unsigned numFiles = file->ReadUInt();
     checksum_ = file->ReadUInt();
+    blockSize_ = 0;
+    unsigned version = 0;
 
     if (id == "RPAK" || id == "RLZ4")
     {
         // New PAK file format includes two extra PAK header fields:
-        // * Version. At this time this field is unused and is always 0. It will be used in the future if PAK format needs to be extended.
+        // * Version. Version 1 adds the uncompressed block size to the header, and packed size and block offsets to each compressed
+        //   file entry, which allows random access into compressed files.
         // * File list offset. New format writes file list in the end of the file. This allows PAK creation without knowing entire file list
         //   beforehand.
-        unsigned version = file->ReadUInt();                        // Reserved for future use.
-        assert(version == 0);
+        version = file->ReadUInt();
+        if (version > 1)
+        {
+            URHO3D_LOGERROR("{} has unsupported package version {}", fileName, version);
+            return false;
+        }
         int64_t fileListOffset = file->ReadInt64();                 // New format has file list at the end of the file.
-        file->Seek(fileListOffset);                                 // TODO: Serializer/Deserializer do not support files bigger than 4 GB
+        if (version >= 1)
+            blockSize_ = file->ReadUInt();
+        file->Seek(startOffset + fileListOffset);                   // TODO: Serializer/Deserializer do not support files bigger than 4 GB
     }
 
     for (unsigned i = 0; i < numFiles; ++i)
@@ -110,6 +119,13 @@ bool PackageFile::Open(const ea::string& fileName, unsigned startOffset)
         newEntry.offset_ = file->ReadUInt() + startOffset;
         totalDataSize_ += (newEntry.size_ = file->ReadUInt());
         newEntry.checksum_ = file->ReadUInt();
+        if (version >= 1 && compressed_)
+        {
+            newEntry.packedSize_ = file->ReadUInt();
+            newEntry.blockOffsets_.resize(file->ReadVLE());
+            for (unsigned& blockOffset : newEntry.blockOffsets_)
+                blockOffset = file->ReadUInt();
+        }
         if (!compressed_ && newEntry.offset_ + newEntry.size_ > totalSize_)
         {
             URHO3D_LOGERROR("File entry " + entryName + " outside package file");
@@ -119,6 +135,15 @@ bool PackageFile::Open(const ea::string& fileName, unsigned startOffset)
             entries_[entryName] = newEntry;
     }
 
+    // Uncompressed entries can be served directly from the mapping without per-file handles
+    mapping_ = nullptr;
+    if (!compressed_ && memoryMappingEnabled_)
+    {
+        auto mapping = MakeShared<MemoryMappedFile>(fileName);
+        if (mapping->IsOpen() && mapping->GetSize() == totalSize_)
+            mapping_ = mapping;
+    }
+
     return true;
 }
 
@@ -233,6 +258,12 @@ AbstractFilePtr PackageFile::OpenFile(const FileIdentifier& fileName, FileMode m
     if (!Exists(fileName.fileName_))
         return {};
 
+    if (mapping_)
+    {
+        if (const PackageEntry* entry = GetEntry(fileName.fileName_))
+            return MakeShared<MemoryMappedFileView>(mapping_, entry->offset_, entry->size_, fileName.fileName_, entry->checksum_);
+    }
+
     auto file = MakeShared<File>(context_, this, fileName.fileName_);
     return file;
 }
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "../IO/MemoryMappedFile.h"
 #include "../IO/MountPoint.h"
 
 namespace Urho3D
@@ -36,6 +37,10 @@ struct PackageEntry
     unsigned size_;
     /// File checksum.
     unsigned checksum_;
+    /// Size of compressed file data, if known.
+    unsigned packedSize_;
+    /// Offsets of compressed blocks from the beginning of file data, if the package has block index.
+    ea::vector<unsigned> blockOffsets_;
 };
 
 /// Stores files of a directory tree sequentially for convenient access.
@@ -84,6 +89,16 @@ public:
     /// @property
     bool IsCompressed() const { return compressed_; }
 
+    /// Return uncompressed size of compressed blocks if the package has block index, 0 otherwise.
+    unsigned GetBlockSize() const { return blockSize_; }
+
+    /// Set whether uncompressed packages are memory mapped. Takes effect on the next Open.
+    void SetMemoryMappingEnabled(bool enable) { memoryMappingEnabled_ = enable; }
+    /// Return whether uncompressed packages are memory mapped.
+    bool IsMemoryMappingEnabled() const { return memoryMappingEnabled_; }
+    /// Return whether the package is currently memory mapped.
+    bool IsMemoryMapped() const { return mapping_ != nullptr; }
+
     /// Return list of file names in the package.
     const ea::vector<ea::string> GetEntryNames() const { return entries_.keys(); }
 
@@ -126,6 +141,12 @@ private:
     unsigned checksum_;
     /// Compressed flag.
     bool compressed_;
+    /// Uncompressed size of compressed blocks, if the package has block index.
+    unsigned blockSize_{};
+    /// Whether to memory map uncompressed packages.
+    bool memoryMappingEnabled_{true};
+    /// Memory mapping of the package file, if mapped.
+    SharedPtr<MemoryMappedFile> mapping_;
 };
 
 }
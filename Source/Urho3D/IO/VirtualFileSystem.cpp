@@ -43,7 +43,11 @@ VirtualFileSystem::VirtualFileSystem(Context* context)
 {
 }
 
-VirtualFileSystem::~VirtualFileSystem() = default;
+VirtualFileSystem::~VirtualFileSystem()
+{
+    // Finish reads in progress while mount points are still alive
+    asyncReader_ = nullptr;
+}
 
 void VirtualFileSystem::MountDir(const ea::string& path)
 {
@@ -220,5 +224,16 @@ bool VirtualFileSystem::Exists(const FileIdentifier& fileName) const
     return false;
 }
 
+SharedPtr<AsyncFileRead> VirtualFileSystem::ReadFileAsync(
+    const FileIdentifier& fileName, unsigned offset, unsigned size, AsyncFileRead::Callback callback)
+{
+    auto read = MakeShared<AsyncFileRead>(fileName, offset, size, ea::move(callback));
+
+    MutexLock lock(asyncReaderMutex_);
+    if (!asyncReader_)
+        asyncReader_ = ea::make_unique<AsyncFileReader>(this, numAsyncReadThreads_);
+    asyncReader_->QueueRead(read);
+    return read;
+}
 
 } // namespace Urho3D
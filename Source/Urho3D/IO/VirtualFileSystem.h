@@ -24,8 +24,11 @@
 
 #include "../Core/Object.h"
 #include "../IO/AbstractFile.h"
+#include "../IO/AsyncFileReader.h"
 #include "../IO/MountPoint.h"
 
+#include <EASTL/unique_ptr.h>
+
 namespace Urho3D
 {
 /// Subsystem for virtual file system.
@@ -48,8 +51,10 @@ public:
     ///Mount subfolders and pak files from real folder into virtual file system under the scheme.
     void AutomountDir(const ea::string& scheme, const ea::string& path);
     /// Mount package file into virtual file system.
+    /// Patch packages created by PackageTool -p should be mounted after their base package.
     void MountPackageFile(const ea::string& path);
     /// Mount virtual or real folder into virtual file system.
+    /// Mount points mounted later take precedence over the earlier ones.
     void Mount(MountPoint* mountPoint);
     /// Remove mount point from the virtual file system.
     void Unmount(MountPoint* mountPoint);
@@ -73,11 +78,27 @@ public:
     /// Return full absolute file name of the file if possible, or empty if not found.
     ea::string GetFileName(const FileIdentifier& name);
 
+    /// Read byte range of the file asynchronously. Size M_MAX_UNSIGNED reads until the end of the file.
+    /// Callback is invoked from an I/O thread when the read is finished. Reads are processed in the order of submission.
+    SharedPtr<AsyncFileRead> ReadFileAsync(const FileIdentifier& fileName, unsigned offset, unsigned size,
+        AsyncFileRead::Callback callback = {});
+    /// Set number of I/O threads, i.e. maximum number of reads in flight. Takes effect before the first asynchronous read.
+    void SetNumAsyncReadThreads(unsigned numThreads) { numAsyncReadThreads_ = Max(numThreads, 1u); }
+    /// Return number of I/O threads.
+    unsigned GetNumAsyncReadThreads() const { return numAsyncReadThreads_; }
+
 private:
     /// Mutex for thread-safe access to the mount points.
     mutable Mutex mountMutex_;
     /// File system mount points. It is expected to have small number of mount points.
     ea::vector<SharedPtr<MountPoint>> mountPoints_;
+
+    /// Mutex for lazy creation of asynchronous reader.
+    Mutex asyncReaderMutex_;
+    /// Number of I/O threads.
+    unsigned numAsyncReadThreads_{4};
+    /// Asynchronous reader, created on first use.
+    ea::unique_ptr<AsyncFileReader> asyncReader_;
 };
 
 }
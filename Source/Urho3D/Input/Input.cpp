@@ -437,6 +437,12 @@ void Input::Update()
     while (SDL_PollEvent(&evt))
         HandleSDLEvent(&evt);
 
+    if (mouseMoveEventPending_)
+    {
+        mouseMoveEventPending_ = false;
+        SendMouseMoveEvent(pendingMouseMovePosition_, pendingMouseMoveDelta_);
+    }
+
     if (!enabled_)
         return;
 
@@ -1622,6 +1628,9 @@ void Input::ResetInputAccumulation()
     mouseButtonClick_ = MOUSEB_NONE;
     mouseMove_ = IntVector2::ZERO;
     mouseMoveWheel_ = 0;
+    mouseMotionSamples_.clear();
+    mouseMoveEventPending_ = false;
+    pendingMouseMoveDelta_ = IntVector2::ZERO;
     for (auto i = joysticks_.begin(); i != joysticks_.end(); ++i)
     {
         for (unsigned j = 0; j < i->second.buttonPress_.size(); ++j)
@@ -1921,6 +1930,21 @@ void Input::UnsuppressMouseMove()
     lastMousePosition_ = GetMousePosition();
 }
 
+void Input::SendMouseMoveEvent(const IntVector2& localPosition, const IntVector2& delta)
+{
+    using namespace MouseMove;
+
+    VariantMap& eventData = GetEventDataMap();
+    eventData[P_X] = (int)(localPosition.x_ * systemToBackbufferScale_.x_);
+    eventData[P_Y] = (int)(localPosition.y_ * systemToBackbufferScale_.y_);
+    // The "on-the-fly" motion data needs to be scaled now, though this may reduce accuracy
+    eventData[P_DX] = (int)(delta.x_ * systemToBackbufferScale_.x_);
+    eventData[P_DY] = (int)(delta.y_ * systemToBackbufferScale_.y_);
+    eventData[P_BUTTONS] = (unsigned)mouseButtonDown_;
+    eventData[P_QUALIFIERS] = (unsigned)GetQualifiers();
+    SendEvent(E_MOUSEMOVE, eventData);
+}
+
 void Input::OnSDLRawInput(SDL_Event& evt, bool& consumed)
 {
     if (consumed)
@@ -2111,10 +2135,11 @@ void Input::HandleSDLEvent(void* sdlEvent)
             mouseMove_.y_ += evt.motion.yrel;
             mouseMoveScaled_ = false;
 
+            const IntVector2 delta{evt.motion.xrel, evt.motion.yrel};
+            mouseMotionSamples_.push_back({evt.motion.timestamp, delta.ToVector2() * systemToBackbufferScale_});
+
             if (!suppressNextMouseMove_)
             {
-                using namespace MouseMove;
-
                 // Adjust position to allow explicit window rectangle
                 SDL_Window* currentWindow = SDL_GetWindowFromID(evt.motion.windowID);
                 IntVector2 windowPosition{};
@@ -2122,15 +2147,16 @@ void Input::HandleSDLEvent(void* sdlEvent)
                     SDL_GetWindowPosition(currentWindow, &windowPosition.x_, &windowPosition.y_);
                 const IntVector2 localPosition = windowPosition + IntVector2{evt.motion.x, evt.motion.y} - GetGlobalWindowPosition();
 
-                VariantMap& eventData = GetEventDataMap();
-                eventData[P_X] = (int)(localPosition.x_ * systemToBackbufferScale_.x_);
-                eventData[P_Y] = (int)(localPosition.y_ * systemToBackbufferScale_.y_);
-                // The "on-the-fly" motion data needs to be scaled now, though this may reduce accuracy
-                eventData[P_DX] = (int)(evt.motion.xrel * systemToBackbufferScale_.x_);
-                eventData[P_DY] = (int)(evt.motion.yrel * systemToBackbufferScale_.y_);
-                eventData[P_BUTTONS] = (unsigned)mouseButtonDown_;
-                eventData[P_QUALIFIERS] = (unsigned)GetQualifiers();
-                SendEvent(E_MOUSEMOVE, eventData);
+#ifndef __EMSCRIPTEN__
+                if (coalesceMouseMoveEvents_)
+                {
+                    mouseMoveEventPending_ = true;
+                    pendingMouseMovePosition_ = localPosition;
+                    pendingMouseMoveDelta_ += delta;
+                    break;
+                }
+#endif
+                SendMouseMoveEvent(localPosition, delta);
             }
         }
         // Only the left mouse button "finger" moves along with the mouse movement
@@ -80,6 +80,16 @@ struct URHO3D_API TouchState
     WeakPtr<UIElement> touchedElement_;
 };
 
+/// Relative mouse motion reported by the operating system.
+/// @nocount
+struct URHO3D_API MouseMotionSample
+{
+    /// System timestamp in milliseconds.
+    unsigned timestamp_{};
+    /// Movement in backbuffer pixels.
+    Vector2 delta_;
+};
+
 /// %Input state for a joystick.
 /// @nocount
 struct URHO3D_API JoystickState
@@ -201,6 +211,9 @@ public:
     void SetMouseGrabbed(bool grab, bool suppressEvent = false);
     /// Reset the mouse grabbed to the last unsuppressed SetMouseGrabbed call.
     void ResetMouseGrabbed();
+    /// Set whether mouse motion received during the frame is sent as single E_MOUSEMOVE event at the end of input update.
+    /// Reduces event overhead with high polling rate mice. Not supported on Web platform.
+    void SetCoalesceMouseMoveEvents(bool enable) { coalesceMouseMoveEvents_ = enable; }
     /// Set the mouse mode.
     /** Set the mouse mode behaviour.
      *  MM_ABSOLUTE is the default behaviour, allowing the toggling of operating system cursor visibility and allowing the cursor to escape the window when visible.
@@ -328,6 +341,11 @@ public:
     /// Return mouse wheel movement since last frame.
     /// @property
     int GetMouseMoveWheel() const { return mouseMoveWheel_; }
+    /// Return mouse motion samples received since last frame in the order of arrival.
+    /// Unlike GetMouseMove(), preserves timing of the movement within the frame, e.g. for input prediction.
+    const ea::vector<MouseMotionSample>& GetMouseMotionSamples() const { return mouseMotionSamples_; }
+    /// Return whether mouse motion is sent as single E_MOUSEMOVE event per frame.
+    bool GetCoalesceMouseMoveEvents() const { return coalesceMouseMoveEvents_; }
     /// Return input coordinate scaling. Should return non-unity on High DPI display.
     /// @property
     Vector2 GetSystemToBackbufferScale() const { return systemToBackbufferScale_; }
@@ -445,6 +463,8 @@ private:
     void SuppressNextMouseMove();
     /// Unsuppress mouse movement.
     void UnsuppressMouseMove();
+    /// Send mouse move event. Position and movement are in system coordinates.
+    void SendMouseMoveEvent(const IntVector2& localPosition, const IntVector2& delta);
     /// Handle screen mode event.
     void HandleScreenMode(StringHash eventType, VariantMap& eventData);
     /// Handle frame start event.
@@ -510,6 +530,16 @@ private:
     IntVector2 mouseMove_;
     /// Mouse wheel movement since last frame.
     int mouseMoveWheel_;
+    /// Mouse motion samples since last frame.
+    ea::vector<MouseMotionSample> mouseMotionSamples_;
+    /// Whether mouse motion is sent as single E_MOUSEMOVE event per frame.
+    bool coalesceMouseMoveEvents_{};
+    /// Whether coalesced E_MOUSEMOVE event is pending.
+    bool mouseMoveEventPending_{};
+    /// Mouse position of pending E_MOUSEMOVE event in system coordinates.
+    IntVector2 pendingMouseMovePosition_;
+    /// Mouse movement of pending E_MOUSEMOVE event in system coordinates.
+    IntVector2 pendingMouseMoveDelta_;
     /// Input coordinate scaling. Non-unity when window and backbuffer have different sizes (e.g. Retina display).
     Vector2 systemToBackbufferScale_;
     /// SDL window ID.
@@ -0,0 +1,304 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Math/BatchMath.h"
+
+#if defined(URHO3D_SSE)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Number of elements processed at once by vectorized frustum tests.
+static const unsigned FRUSTUM_TEST_WIDTH = 4;
+
+#if defined(URHO3D_SSE)
+/// Transform box given by center (w = 1) and half size (w = 0). Same as BoundingBox::Transformed.
+inline void TransformCenterAndHalfSize(const Matrix3x4& transform, __m128 center, __m128 halfSize,
+    __m128& newCenter, __m128& newHalfSize)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 m0 = _mm_loadu_ps(&transform.m00_);
+    const __m128 m1 = _mm_loadu_ps(&transform.m10_);
+    const __m128 m2 = _mm_loadu_ps(&transform.m20_);
+
+    const __m128 r0 = _mm_mul_ps(m0, center);
+    const __m128 r1 = _mm_mul_ps(m1, center);
+    const __m128 r2 = _mm_mul_ps(m2, center);
+    __m128 t0 = _mm_add_ps(_mm_unpacklo_ps(r0, r1), _mm_unpackhi_ps(r0, r1));
+    __m128 t2 = _mm_add_ps(_mm_unpacklo_ps(r2, zero), _mm_unpackhi_ps(r2, zero));
+    newCenter = _mm_add_ps(_mm_movelh_ps(t0, t2), _mm_movehl_ps(t2, t0));
+
+    const __m128 x = _mm_and_ps(absMask, _mm_mul_ps(m0, halfSize));
+    const __m128 y = _mm_and_ps(absMask, _mm_mul_ps(m1, halfSize));
+    const __m128 z = _mm_and_ps(absMask, _mm_mul_ps(m2, halfSize));
+    t0 = _mm_add_ps(_mm_unpacklo_ps(x, y), _mm_unpackhi_ps(x, y));
+    t2 = _mm_add_ps(_mm_unpacklo_ps(z, zero), _mm_unpackhi_ps(z, zero));
+    newHalfSize = _mm_add_ps(_mm_movelh_ps(t0, t2), _mm_movehl_ps(t2, t0));
+}
+
+/// Load center (w = 1) and half size (w = 0) of the box.
+inline void LoadCenterAndHalfSize(const BoundingBox& box, __m128& center, __m128& halfSize)
+{
+    const __m128 minPt = _mm_set_ps(1.0f, box.min_.z_, box.min_.y_, box.min_.x_);
+    const __m128 maxPt = _mm_set_ps(1.0f, box.max_.z_, box.max_.y_, box.max_.x_);
+    center = _mm_mul_ps(_mm_add_ps(minPt, maxPt), _mm_set1_ps(0.5f));
+    halfSize = _mm_sub_ps(center, minPt);
+}
+#endif
+
+/// Structure-of-arrays block of centers and extents, optionally padded with empty elements.
+struct FrustumTestBlock
+{
+    alignas(16) float centerX_[FRUSTUM_TEST_WIDTH]{};
+    alignas(16) float centerY_[FRUSTUM_TEST_WIDTH]{};
+    alignas(16) float centerZ_[FRUSTUM_TEST_WIDTH]{};
+    alignas(16) float extentX_[FRUSTUM_TEST_WIDTH]{};
+    alignas(16) float extentY_[FRUSTUM_TEST_WIDTH]{};
+    alignas(16) float extentZ_[FRUSTUM_TEST_WIDTH]{};
+};
+
+/// Test block against frustum. Extents are projected onto absolute normals for boxes
+/// or used as is for spheres, where all components contain sphere radius.
+void TestBlockInside(bool dest[], const Frustum& frustum, const FrustumTestBlock& block, unsigned count, bool spheres)
+{
+#if defined(URHO3D_SSE)
+    const __m128 cx = _mm_load_ps(block.centerX_);
+    const __m128 cy = _mm_load_ps(block.centerY_);
+    const __m128 cz = _mm_load_ps(block.centerZ_);
+    const __m128 ex = _mm_load_ps(block.extentX_);
+    const __m128 ey = _mm_load_ps(block.extentY_);
+    const __m128 ez = _mm_load_ps(block.extentZ_);
+
+    __m128 outside = _mm_setzero_ps();
+    for (const Plane& plane : frustum.planes_)
+    {
+        const __m128 dist = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(plane.normal_.x_)), _mm_mul_ps(cy, _mm_set1_ps(plane.normal_.y_))),
+            _mm_add_ps(_mm_mul_ps(cz, _mm_set1_ps(plane.normal_.z_)), _mm_set1_ps(plane.d_)));
+        const __m128 extent = spheres ? ex
+            : _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(ex, _mm_set1_ps(plane.absNormal_.x_)), _mm_mul_ps(ey, _mm_set1_ps(plane.absNormal_.y_))),
+                _mm_mul_ps(ez, _mm_set1_ps(plane.absNormal_.z_)));
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, _mm_sub_ps(_mm_setzero_ps(), extent)));
+    }
+
+    const int mask = _mm_movemask_ps(outside);
+    for (unsigned i = 0; i < count; ++i)
+        dest[i] = !(mask & (1 << i));
+#elif defined(__ARM_NEON)
+    const float32x4_t cx = vld1q_f32(block.centerX_);
+    const float32x4_t cy = vld1q_f32(block.centerY_);
+    const float32x4_t cz = vld1q_f32(block.centerZ_);
+    const float32x4_t ex = vld1q_f32(block.extentX_);
+    const float32x4_t ey = vld1q_f32(block.extentY_);
+    const float32x4_t ez = vld1q_f32(block.extentZ_);
+
+    uint32x4_t outside = vdupq_n_u32(0);
+    for (const Plane& plane : frustum.planes_)
+    {
+        float32x4_t dist = vdupq_n_f32(plane.d_);
+        dist = vmlaq_n_f32(dist, cx, plane.normal_.x_);
+        dist = vmlaq_n_f32(dist, cy, plane.normal_.y_);
+        dist = vmlaq_n_f32(dist, cz, plane.normal_.z_);
+        float32x4_t extent = ex;
+        if (!spheres)
+        {
+            extent = vmulq_n_f32(ex, plane.absNormal_.x_);
+            extent = vmlaq_n_f32(extent, ey, plane.absNormal_.y_);
+            extent = vmlaq_n_f32(extent, ez, plane.absNormal_.z_);
+        }
+        outside = vorrq_u32(outside, vcltq_f32(dist, vnegq_f32(extent)));
+    }
+
+    alignas(16) uint32_t mask[FRUSTUM_TEST_WIDTH];
+    vst1q_u32(mask, outside);
+    for (unsigned i = 0; i < count; ++i)
+        dest[i] = !mask[i];
+#else
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const Vector3 center{block.centerX_[i], block.centerY_[i], block.centerZ_[i]};
+        const Vector3 extent{block.extentX_[i], block.extentY_[i], block.extentZ_[i]};
+
+        bool outside = false;
+        for (const Plane& plane : frustum.planes_)
+        {
+            const float dist = plane.normal_.DotProduct(center) + plane.d_;
+            const float absDist = spheres ? extent.x_ : plane.absNormal_.DotProduct(extent);
+            if (dist < -absDist)
+            {
+                outside = true;
+                break;
+            }
+        }
+        dest[i] = !outside;
+    }
+#endif
+}
+
+}
+
+void TransformBoundingBoxes(BoundingBox dest[], const BoundingBox source[], const Matrix3x4 transforms[],
+    unsigned count)
+{
+#if defined(URHO3D_SSE)
+    for (unsigned i = 0; i < count; ++i)
+    {
+        __m128 center, halfSize, newCenter, newHalfSize;
+        LoadCenterAndHalfSize(source[i], center, halfSize);
+        TransformCenterAndHalfSize(transforms[i], center, halfSize, newCenter, newHalfSize);
+        dest[i] = BoundingBox(_mm_sub_ps(newCenter, newHalfSize), _mm_add_ps(newCenter, newHalfSize));
+    }
+#else
+    for (unsigned i = 0; i < count; ++i)
+        dest[i] = source[i].Transformed(transforms[i]);
+#endif
+}
+
+BoundingBox TransformAndMergeBoundingBox(const BoundingBox& box, const Matrix3x4 transforms[], unsigned count)
+{
+#if defined(URHO3D_SSE)
+    __m128 center, halfSize;
+    LoadCenterAndHalfSize(box, center, halfSize);
+
+    __m128 minPt = _mm_set1_ps(M_INFINITY);
+    __m128 maxPt = _mm_set1_ps(-M_INFINITY);
+    for (unsigned i = 0; i < count; ++i)
+    {
+        __m128 newCenter, newHalfSize;
+        TransformCenterAndHalfSize(transforms[i], center, halfSize, newCenter, newHalfSize);
+        minPt = _mm_min_ps(minPt, _mm_sub_ps(newCenter, newHalfSize));
+        maxPt = _mm_max_ps(maxPt, _mm_add_ps(newCenter, newHalfSize));
+    }
+
+    return count ? BoundingBox(minPt, maxPt) : BoundingBox{};
+#else
+    BoundingBox result;
+    for (unsigned i = 0; i < count; ++i)
+        result.Merge(box.Transformed(transforms[i]));
+    return result;
+#endif
+}
+
+void MultiplyMatrices(Matrix3x4 dest[], const Matrix3x4 lhs[], const Matrix3x4 rhs[], unsigned count)
+{
+    // Matrix3x4 multiplication is vectorized already, batching only avoids call overhead and temporaries
+    for (unsigned i = 0; i < count; ++i)
+        dest[i] = lhs[i] * rhs[i];
+}
+
+void TransformPoints(Vector3 dest[], const Vector3 source[], unsigned count, const Matrix3x4& transform)
+{
+#if defined(URHO3D_SSE)
+    const __m128 col0 = _mm_set_ps(0.0f, transform.m20_, transform.m10_, transform.m00_);
+    const __m128 col1 = _mm_set_ps(0.0f, transform.m21_, transform.m11_, transform.m01_);
+    const __m128 col2 = _mm_set_ps(0.0f, transform.m22_, transform.m12_, transform.m02_);
+    const __m128 col3 = _mm_set_ps(0.0f, transform.m23_, transform.m13_, transform.m03_);
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const Vector3& point = source[i];
+        const __m128 result = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(col0, _mm_set1_ps(point.x_)), _mm_mul_ps(col1, _mm_set1_ps(point.y_))),
+            _mm_add_ps(_mm_mul_ps(col2, _mm_set1_ps(point.z_)), col3));
+        _mm_storel_pi(reinterpret_cast<__m64*>(&dest[i].x_), result);
+        _mm_store_ss(&dest[i].z_, _mm_movehl_ps(result, result));
+    }
+#elif defined(__ARM_NEON)
+    // Load four points at once deinterleaved into structure of arrays
+    unsigned i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4x3_t points = vld3q_f32(&source[i].x_);
+        float32x4x3_t result;
+        result.val[0] = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(transform.m03_),
+            points.val[0], transform.m00_), points.val[1], transform.m01_), points.val[2], transform.m02_);
+        result.val[1] = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(transform.m13_),
+            points.val[0], transform.m10_), points.val[1], transform.m11_), points.val[2], transform.m12_);
+        result.val[2] = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(transform.m23_),
+            points.val[0], transform.m20_), points.val[1], transform.m21_), points.val[2], transform.m22_);
+        vst3q_f32(&dest[i].x_, result);
+    }
+    for (; i < count; ++i)
+        dest[i] = transform * source[i];
+#else
+    for (unsigned i = 0; i < count; ++i)
+        dest[i] = transform * source[i];
+#endif
+}
+
+void TestBoundingBoxesInside(bool dest[], const Frustum& frustum, const BoundingBox boxes[], unsigned count)
+{
+    FrustumTestBlock block;
+    for (unsigned base = 0; base < count; base += FRUSTUM_TEST_WIDTH)
+    {
+        const unsigned blockSize = ea::min(count - base, FRUSTUM_TEST_WIDTH);
+        for (unsigned i = 0; i < blockSize; ++i)
+        {
+            const BoundingBox& box = boxes[base + i];
+            const Vector3 center = box.Center();
+            const Vector3 extent = center - box.min_;
+            block.centerX_[i] = center.x_;
+            block.centerY_[i] = center.y_;
+            block.centerZ_[i] = center.z_;
+            block.extentX_[i] = extent.x_;
+            block.extentY_[i] = extent.y_;
+            block.extentZ_[i] = extent.z_;
+        }
+        TestBlockInside(dest + base, frustum, block, blockSize, false);
+    }
+}
+
+void TestSpheresInside(bool dest[], const Frustum& frustum, const Sphere spheres[], unsigned count)
+{
+    FrustumTestBlock block;
+    for (unsigned base = 0; base < count; base += FRUSTUM_TEST_WIDTH)
+    {
+        const unsigned blockSize = ea::min(count - base, FRUSTUM_TEST_WIDTH);
+        for (unsigned i = 0; i < blockSize; ++i)
+        {
+            const Sphere& sphere = spheres[base + i];
+            block.centerX_[i] = sphere.center_.x_;
+            block.centerY_[i] = sphere.center_.y_;
+            block.centerZ_[i] = sphere.center_.z_;
+            block.extentX_[i] = sphere.radius_;
+            block.extentY_[i] = sphere.radius_;
+            block.extentZ_[i] = sphere.radius_;
+        }
+        TestBlockInside(dest + base, frustum, block, blockSize, true);
+    }
+}
+
+}
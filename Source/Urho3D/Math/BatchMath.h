@@ -0,0 +1,52 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/// \file
+/// Batched math kernels that process arrays of transforms, points and volumes at once.
+/// Results are identical to per-object operations up to floating point rounding.
+
+#pragma once
+
+#include "../Math/BoundingBox.h"
+#include "../Math/Frustum.h"
+#include "../Math/Matrix3x4.h"
+#include "../Math/Sphere.h"
+
+namespace Urho3D
+{
+
+/// Transform bounding boxes by corresponding transforms.
+URHO3D_API void TransformBoundingBoxes(BoundingBox dest[], const BoundingBox source[], const Matrix3x4 transforms[],
+    unsigned count);
+/// Transform bounding box by each of transforms and return union of results. Return undefined box if count is zero.
+URHO3D_API BoundingBox TransformAndMergeBoundingBox(const BoundingBox& box, const Matrix3x4 transforms[], unsigned count);
+/// Multiply corresponding matrices. Destination may alias either source.
+URHO3D_API void MultiplyMatrices(Matrix3x4 dest[], const Matrix3x4 lhs[], const Matrix3x4 rhs[], unsigned count);
+/// Transform points by single transform. Destination may alias source.
+URHO3D_API void TransformPoints(Vector3 dest[], const Vector3 source[], unsigned count, const Matrix3x4& transform);
+/// Test whether bounding boxes are (partially) inside frustum. Same as Frustum::IsInsideFast(box) != OUTSIDE.
+URHO3D_API void TestBoundingBoxesInside(bool dest[], const Frustum& frustum, const BoundingBox boxes[], unsigned count);
+/// Test whether spheres are (partially) inside frustum. Same as Frustum::IsInsideFast(sphere) != OUTSIDE.
+URHO3D_API void TestSpheresInside(bool dest[], const Frustum& frustum, const Sphere spheres[], unsigned count);
+
+}
@@ -154,6 +154,33 @@ BoundingBox BoundingBox::Transformed(const Matrix3x4& transform) const
     t2 = _mm_add_ps(_mm_unpacklo_ps(z, zero), _mm_unpackhi_ps(z, zero));
     __m128 newDir = _mm_add_ps(_mm_movelh_ps(t0, t2), _mm_movehl_ps(t2, t0));
     return BoundingBox(_mm_sub_ps(newCenter, newDir), _mm_add_ps(newCenter, newDir));
+#elif defined(__ARM_NEON)
+    const float32x4_t minPt = vld1q_f32(&min_.x_);
+    const float32x4_t maxPt = vld1q_f32(&max_.x_);
+    const float32x4_t centerPoint = vsetq_lane_f32(1.0f, vmulq_n_f32(vaddq_f32(minPt, maxPt), 0.5f), 3);
+    const float32x4_t halfSize = vsetq_lane_f32(0.0f, vsubq_f32(centerPoint, minPt), 3);
+    const float32x4_t m0 = vld1q_f32(&transform.m00_);
+    const float32x4_t m1 = vld1q_f32(&transform.m10_);
+    const float32x4_t m2 = vld1q_f32(&transform.m20_);
+
+    const float32x4_t r0 = vmulq_f32(m0, centerPoint);
+    const float32x4_t r1 = vmulq_f32(m1, centerPoint);
+    const float32x4_t r2 = vmulq_f32(m2, centerPoint);
+    const float32x2_t c01 = vpadd_f32(vadd_f32(vget_low_f32(r0), vget_high_f32(r0)), vadd_f32(vget_low_f32(r1), vget_high_f32(r1)));
+    const float32x2_t c2 = vadd_f32(vget_low_f32(r2), vget_high_f32(r2));
+    const float32x4_t newCenter = vcombine_f32(c01, vpadd_f32(c2, vdup_n_f32(0.0f)));
+
+    const float32x4_t x = vabsq_f32(vmulq_f32(m0, halfSize));
+    const float32x4_t y = vabsq_f32(vmulq_f32(m1, halfSize));
+    const float32x4_t z = vabsq_f32(vmulq_f32(m2, halfSize));
+    const float32x2_t d01 = vpadd_f32(vadd_f32(vget_low_f32(x), vget_high_f32(x)), vadd_f32(vget_low_f32(y), vget_high_f32(y)));
+    const float32x2_t d2 = vadd_f32(vget_low_f32(z), vget_high_f32(z));
+    const float32x4_t newDir = vcombine_f32(d01, vpadd_f32(d2, vdup_n_f32(0.0f)));
+
+    BoundingBox result;
+    vst1q_f32(&result.min_.x_, vsubq_f32(newCenter, newDir));
+    vst1q_f32(&result.max_.x_, vaddq_f32(newCenter, newDir));
+    return result;
 #else
     Vector3 newCenter = transform * Center();
     Vector3 oldEdge = Size() * 0.5f;
@@ -25,8 +25,10 @@
 #include "../Math/Rect.h"
 #include "../Math/Vector3.h"
 
-#ifdef URHO3D_SSE
+#if defined(URHO3D_SSE)
 #include <xmmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
 #endif
 
 namespace Urho3D
@@ -181,6 +183,11 @@ public:
         __m128 vec = _mm_set_ps(1.f, point.z_, point.y_, point.x_);
         _mm_storeu_ps(&min_.x_, _mm_min_ps(_mm_loadu_ps(&min_.x_), vec));
         _mm_storeu_ps(&max_.x_, _mm_max_ps(_mm_loadu_ps(&max_.x_), vec));
+#elif defined(__ARM_NEON)
+        const float values[4] = {point.x_, point.y_, point.z_, 1.0f};
+        const float32x4_t vec = vld1q_f32(values);
+        vst1q_f32(&min_.x_, vminq_f32(vld1q_f32(&min_.x_), vec));
+        vst1q_f32(&max_.x_, vmaxq_f32(vld1q_f32(&max_.x_), vec));
 #else
         if (point.x_ < min_.x_)
             min_.x_ = point.x_;
@@ -203,6 +210,9 @@ public:
 #ifdef URHO3D_SSE
         _mm_storeu_ps(&min_.x_, _mm_min_ps(_mm_loadu_ps(&min_.x_), _mm_loadu_ps(&box.min_.x_)));
         _mm_storeu_ps(&max_.x_, _mm_max_ps(_mm_loadu_ps(&max_.x_), _mm_loadu_ps(&box.max_.x_)));
+#elif defined(__ARM_NEON)
+        vst1q_f32(&min_.x_, vminq_f32(vld1q_f32(&min_.x_), vld1q_f32(&box.min_.x_)));
+        vst1q_f32(&max_.x_, vmaxq_f32(vld1q_f32(&max_.x_), vld1q_f32(&box.max_.x_)));
 #else
         if (box.min_.x_ < min_.x_)
             min_.x_ = box.min_.x_;
@@ -24,8 +24,10 @@
 
 #include "../Math/Matrix4.h"
 
-#ifdef URHO3D_SSE
+#if defined(URHO3D_SSE)
 #include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
 #endif
 
 namespace Urho3D
@@ -303,6 +305,16 @@ public:
             _mm_cvtss_f32(vec),
             _mm_cvtss_f32(_mm_shuffle_ps(vec, vec, _MM_SHUFFLE(1, 1, 1, 1))),
             _mm_cvtss_f32(_mm_movehl_ps(vec, vec)));
+#elif defined(__ARM_NEON)
+        const float values[4] = {rhs.x_, rhs.y_, rhs.z_, 1.0f};
+        const float32x4_t vec = vld1q_f32(values);
+        const float32x4_t r0 = vmulq_f32(vld1q_f32(&m00_), vec);
+        const float32x4_t r1 = vmulq_f32(vld1q_f32(&m10_), vec);
+        const float32x4_t r2 = vmulq_f32(vld1q_f32(&m20_), vec);
+        const float32x2_t t0 = vpadd_f32(vadd_f32(vget_low_f32(r0), vget_high_f32(r0)), vadd_f32(vget_low_f32(r1), vget_high_f32(r1)));
+        const float32x2_t t2 = vadd_f32(vget_low_f32(r2), vget_high_f32(r2));
+
+        return Vector3(vget_lane_f32(t0, 0), vget_lane_f32(t0, 1), vget_lane_f32(vpadd_f32(t2, t2), 0));
 #else
         return Vector3(
             (m00_ * rhs.x_ + m01_ * rhs.y_ + m02_ * rhs.z_ + m03_),
@@ -333,6 +345,15 @@ public:
             _mm_cvtss_f32(vec),
             _mm_cvtss_f32(_mm_shuffle_ps(vec, vec, _MM_SHUFFLE(1, 1, 1, 1))),
             _mm_cvtss_f32(_mm_movehl_ps(vec, vec)));
+#elif defined(__ARM_NEON)
+        const float32x4_t vec = vld1q_f32(&rhs.x_);
+        const float32x4_t r0 = vmulq_f32(vld1q_f32(&m00_), vec);
+        const float32x4_t r1 = vmulq_f32(vld1q_f32(&m10_), vec);
+        const float32x4_t r2 = vmulq_f32(vld1q_f32(&m20_), vec);
+        const float32x2_t t0 = vpadd_f32(vadd_f32(vget_low_f32(r0), vget_high_f32(r0)), vadd_f32(vget_low_f32(r1), vget_high_f32(r1)));
+        const float32x2_t t2 = vadd_f32(vget_low_f32(r2), vget_high_f32(r2));
+
+        return Vector3(vget_lane_f32(t0, 0), vget_lane_f32(t0, 1), vget_lane_f32(vpadd_f32(t2, t2), 0));
 #else
         return Vector3(
             (m00_ * rhs.x_ + m01_ * rhs.y_ + m02_ * rhs.z_ + m03_ * rhs.w_),
@@ -351,6 +372,12 @@ public:
         _mm_storeu_ps(&ret.m10_, _mm_add_ps(_mm_loadu_ps(&m10_), _mm_loadu_ps(&rhs.m10_)));
         _mm_storeu_ps(&ret.m20_, _mm_add_ps(_mm_loadu_ps(&m20_), _mm_loadu_ps(&rhs.m20_)));
         return ret;
+#elif defined(__ARM_NEON)
+        Matrix3x4 ret;
+        vst1q_f32(&ret.m00_, vaddq_f32(vld1q_f32(&m00_), vld1q_f32(&rhs.m00_)));
+        vst1q_f32(&ret.m10_, vaddq_f32(vld1q_f32(&m10_), vld1q_f32(&rhs.m10_)));
+        vst1q_f32(&ret.m20_, vaddq_f32(vld1q_f32(&m20_), vld1q_f32(&rhs.m20_)));
+        return ret;
 #else
         return Matrix3x4(
             m00_ + rhs.m00_,
@@ -378,6 +405,12 @@ public:
         _mm_storeu_ps(&ret.m10_, _mm_sub_ps(_mm_loadu_ps(&m10_), _mm_loadu_ps(&rhs.m10_)));
         _mm_storeu_ps(&ret.m20_, _mm_sub_ps(_mm_loadu_ps(&m20_), _mm_loadu_ps(&rhs.m20_)));
         return ret;
+#elif defined(__ARM_NEON)
+        Matrix3x4 ret;
+        vst1q_f32(&ret.m00_, vsubq_f32(vld1q_f32(&m00_), vld1q_f32(&rhs.m00_)));
+        vst1q_f32(&ret.m10_, vsubq_f32(vld1q_f32(&m10_), vld1q_f32(&rhs.m10_)));
+        vst1q_f32(&ret.m20_, vsubq_f32(vld1q_f32(&m20_), vld1q_f32(&rhs.m20_)));
+        return ret;
 #else
         return Matrix3x4(
             m00_ - rhs.m00_,
@@ -406,6 +439,12 @@ public:
         _mm_storeu_ps(&ret.m10_, _mm_mul_ps(_mm_loadu_ps(&m10_), mul));
         _mm_storeu_ps(&ret.m20_, _mm_mul_ps(_mm_loadu_ps(&m20_), mul));
         return ret;
+#elif defined(__ARM_NEON)
+        Matrix3x4 ret;
+        vst1q_f32(&ret.m00_, vmulq_n_f32(vld1q_f32(&m00_), rhs));
+        vst1q_f32(&ret.m10_, vmulq_n_f32(vld1q_f32(&m10_), rhs));
+        vst1q_f32(&ret.m20_, vmulq_n_f32(vld1q_f32(&m20_), rhs));
+        return ret;
 #else
         return Matrix3x4(
             m00_ * rhs,
@@ -456,6 +495,27 @@ public:
         t3 = _mm_mul_ps(l, r3);
         _mm_storeu_ps(&out.m20_, _mm_add_ps(_mm_add_ps(t0, t1), _mm_add_ps(t2, t3)));
 
+        return out;
+#elif defined(__ARM_NEON)
+        Matrix3x4 out;
+
+        const float32x4_t r0 = vld1q_f32(&rhs.m00_);
+        const float32x4_t r1 = vld1q_f32(&rhs.m10_);
+        const float32x4_t r2 = vld1q_f32(&rhs.m20_);
+
+        const float* lhsRows = &m00_;
+        float* outRows = &out.m00_;
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            const float32x4_t l = vld1q_f32(lhsRows + i * 4);
+            float32x4_t row = vmulq_lane_f32(r0, vget_low_f32(l), 0);
+            row = vaddq_f32(row, vmulq_lane_f32(r1, vget_low_f32(l), 1));
+            row = vaddq_f32(row, vmulq_lane_f32(r2, vget_high_f32(l), 0));
+            // Implicit fourth row of rhs is (0, 0, 0, 1), so only translation is added
+            row = vsetq_lane_f32(vgetq_lane_f32(row, 3) + vgetq_lane_f32(l, 3), row, 3);
+            vst1q_f32(outRows + i * 4, row);
+        }
+
         return out;
 #else
         return Matrix3x4(
@@ -509,6 +569,29 @@ public:
 
         _mm_storeu_ps(&out.m30_, r3);
 
+        return out;
+#elif defined(__ARM_NEON)
+        Matrix4 out;
+
+        const float32x4_t r0 = vld1q_f32(&rhs.m00_);
+        const float32x4_t r1 = vld1q_f32(&rhs.m10_);
+        const float32x4_t r2 = vld1q_f32(&rhs.m20_);
+        const float32x4_t r3 = vld1q_f32(&rhs.m30_);
+
+        const float* lhsRows = &m00_;
+        float* outRows = &out.m00_;
+        for (unsigned i = 0; i < 3; ++i)
+        {
+            const float32x4_t l = vld1q_f32(lhsRows + i * 4);
+            float32x4_t row = vmulq_lane_f32(r0, vget_low_f32(l), 0);
+            row = vaddq_f32(row, vmulq_lane_f32(r1, vget_low_f32(l), 1));
+            row = vaddq_f32(row, vmulq_lane_f32(r2, vget_high_f32(l), 0));
+            row = vaddq_f32(row, vmulq_lane_f32(r3, vget_high_f32(l), 1));
+            vst1q_f32(outRows + i * 4, row);
+        }
+
+        vst1q_f32(&out.m30_, r3);
+
         return out;
 #else
         return Matrix4(
@@ -25,8 +25,10 @@
 #include "../Math/Quaternion.h"
 #include "../Math/Vector4.h"
 
-#ifdef URHO3D_SSE
+#if defined(URHO3D_SSE)
 #include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
 #endif
 
 namespace Urho3D
@@ -275,6 +277,18 @@ public:
             _mm_cvtss_f32(vec),
             _mm_cvtss_f32(_mm_shuffle_ps(vec, vec, _MM_SHUFFLE(1, 1, 1, 1))),
             _mm_cvtss_f32(_mm_movehl_ps(vec, vec)));
+#elif defined(__ARM_NEON)
+        const float values[4] = {rhs.x_, rhs.y_, rhs.z_, 1.0f};
+        const float32x4_t vec = vld1q_f32(values);
+        const float32x4_t r0 = vmulq_f32(vld1q_f32(&m00_), vec);
+        const float32x4_t r1 = vmulq_f32(vld1q_f32(&m10_), vec);
+        const float32x4_t r2 = vmulq_f32(vld1q_f32(&m20_), vec);
+        const float32x4_t r3 = vmulq_f32(vld1q_f32(&m30_), vec);
+        const float32x2_t t0 = vpadd_f32(vadd_f32(vget_low_f32(r0), vget_high_f32(r0)), vadd_f32(vget_low_f32(r1), vget_high_f32(r1)));
+        const float32x2_t t2 = vpadd_f32(vadd_f32(vget_low_f32(r2), vget_high_f32(r2)), vadd_f32(vget_low_f32(r3), vget_high_f32(r3)));
+        const float invW = 1.0f / vget_lane_f32(t2, 1);
+
+        return Vector3(vget_lane_f32(t0, 0) * invW, vget_lane_f32(t0, 1) * invW, vget_lane_f32(t2, 0) * invW);
 #else
         float invW = 1.0f / (m30_ * rhs.x_ + m31_ * rhs.y_ + m32_ * rhs.z_ + m33_);
 
@@ -306,6 +320,18 @@ public:
         Vector4 ret;
         _mm_storeu_ps(&ret.x_, vec);
         return ret;
+#elif defined(__ARM_NEON)
+        const float32x4_t vec = vld1q_f32(&rhs.x_);
+        const float32x4_t r0 = vmulq_f32(vld1q_f32(&m00_), vec);
+        const float32x4_t r1 = vmulq_f32(vld1q_f32(&m10_), vec);
+        const float32x4_t r2 = vmulq_f32(vld1q_f32(&m20_), vec);
+        const float32x4_t r3 = vmulq_f32(vld1q_f32(&m30_), vec);
+        const float32x2_t t0 = vpadd_f32(vadd_f32(vget_low_f32(r0), vget_high_f32(r0)), vadd_f32(vget_low_f32(r1), vget_high_f32(r1)));
+        const float32x2_t t2 = vpadd_f32(vadd_f32(vget_low_f32(r2), vget_high_f32(r2)), vadd_f32(vget_low_f32(r3), vget_high_f32(r3)));
+
+        Vector4 ret;
+        vst1q_f32(&ret.x_, vcombine_f32(t0, t2));
+        return ret;
 #else
         return Vector4(
             m00_ * rhs.x_ + m01_ * rhs.y_ + m02_ * rhs.z_ + m03_ * rhs.w_,
@@ -326,6 +352,13 @@ public:
         _mm_storeu_ps(&ret.m20_, _mm_add_ps(_mm_loadu_ps(&m20_), _mm_loadu_ps(&rhs.m20_)));
         _mm_storeu_ps(&ret.m30_, _mm_add_ps(_mm_loadu_ps(&m30_), _mm_loadu_ps(&rhs.m30_)));
         return ret;
+#elif defined(__ARM_NEON)
+        Matrix4 ret;
+        vst1q_f32(&ret.m00_, vaddq_f32(vld1q_f32(&m00_), vld1q_f32(&rhs.m00_)));
+        vst1q_f32(&ret.m10_, vaddq_f32(vld1q_f32(&m10_), vld1q_f32(&rhs.m10_)));
+        vst1q_f32(&ret.m20_, vaddq_f32(vld1q_f32(&m20_), vld1q_f32(&rhs.m20_)));
+        vst1q_f32(&ret.m30_, vaddq_f32(vld1q_f32(&m30_), vld1q_f32(&rhs.m30_)));
+        return ret;
 #else
         return Matrix4(
             m00_ + rhs.m00_,
@@ -358,6 +391,13 @@ public:
         _mm_storeu_ps(&ret.m20_, _mm_sub_ps(_mm_loadu_ps(&m20_), _mm_loadu_ps(&rhs.m20_)));
         _mm_storeu_ps(&ret.m30_, _mm_sub_ps(_mm_loadu_ps(&m30_), _mm_loadu_ps(&rhs.m30_)));
         return ret;
+#elif defined(__ARM_NEON)
+        Matrix4 ret;
+        vst1q_f32(&ret.m00_, vsubq_f32(vld1q_f32(&m00_), vld1q_f32(&rhs.m00_)));
+        vst1q_f32(&ret.m10_, vsubq_f32(vld1q_f32(&m10_), vld1q_f32(&rhs.m10_)));
+        vst1q_f32(&ret.m20_, vsubq_f32(vld1q_f32(&m20_), vld1q_f32(&rhs.m20_)));
+        vst1q_f32(&ret.m30_, vsubq_f32(vld1q_f32(&m30_), vld1q_f32(&rhs.m30_)));
+        return ret;
 #else
         return Matrix4(
             m00_ - rhs.m00_,
@@ -391,6 +431,13 @@ public:
         _mm_storeu_ps(&ret.m20_, _mm_mul_ps(_mm_loadu_ps(&m20_), mul));
         _mm_storeu_ps(&ret.m30_, _mm_mul_ps(_mm_loadu_ps(&m30_), mul));
         return ret;
+#elif defined(__ARM_NEON)
+        Matrix4 ret;
+        vst1q_f32(&ret.m00_, vmulq_n_f32(vld1q_f32(&m00_), rhs));
+        vst1q_f32(&ret.m10_, vmulq_n_f32(vld1q_f32(&m10_), rhs));
+        vst1q_f32(&ret.m20_, vmulq_n_f32(vld1q_f32(&m20_), rhs));
+        vst1q_f32(&ret.m30_, vmulq_n_f32(vld1q_f32(&m30_), rhs));
+        return ret;
 #else
         return Matrix4(
             m00_ * rhs,
@@ -452,6 +499,27 @@ public:
         t3 = _mm_mul_ps(_mm_shuffle_ps(l, l, _MM_SHUFFLE(3, 3, 3, 3)), r3);
         _mm_storeu_ps(&out.m30_, _mm_add_ps(_mm_add_ps(t0, t1), _mm_add_ps(t2, t3)));
 
+        return out;
+#elif defined(__ARM_NEON)
+        Matrix4 out;
+
+        const float32x4_t r0 = vld1q_f32(&rhs.m00_);
+        const float32x4_t r1 = vld1q_f32(&rhs.m10_);
+        const float32x4_t r2 = vld1q_f32(&rhs.m20_);
+        const float32x4_t r3 = vld1q_f32(&rhs.m30_);
+
+        const float* lhsRows = &m00_;
+        float* outRows = &out.m00_;
+        for (unsigned i = 0; i < 4; ++i)
+        {
+            const float32x4_t l = vld1q_f32(lhsRows + i * 4);
+            float32x4_t row = vmulq_lane_f32(r0, vget_low_f32(l), 0);
+            row = vaddq_f32(row, vmulq_lane_f32(r1, vget_low_f32(l), 1));
+            row = vaddq_f32(row, vmulq_lane_f32(r2, vget_high_f32(l), 0));
+            row = vaddq_f32(row, vmulq_lane_f32(r3, vget_high_f32(l), 1));
+            vst1q_f32(outRows + i * 4, row);
+        }
+
         return out;
 #else
         return Matrix4(
@@ -715,6 +783,13 @@ public:
             _mm_storeu_ps(dest + 4, m1);
             _mm_storeu_ps(dest + 8, m2);
             _mm_storeu_ps(dest + 12, m3);
+#elif defined(__ARM_NEON)
+            // Deinterleaving load with stride 4 is exactly the transpose
+            const float32x4x4_t m = vld4q_f32(src);
+            vst1q_f32(dest, m.val[0]);
+            vst1q_f32(dest + 4, m.val[1]);
+            vst1q_f32(dest + 8, m.val[2]);
+            vst1q_f32(dest + 12, m.val[3]);
 #else
             dest[0] = src[0];
             dest[1] = src[4];
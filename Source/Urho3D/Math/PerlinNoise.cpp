@@ -26,9 +26,31 @@
 
 #include <EASTL/numeric.h>
 
+#if defined(URHO3D_SSE)
+#include <emmintrin.h>
+#endif
+
+#include "../DebugNew.h"
+
 namespace Urho3D
 {
 
+namespace
+{
+
+/// Number of positions processed at once by GetBlock.
+static const unsigned NOISE_BLOCK_WIDTH = 4;
+
+/// Gradient directions selected by lower 4 bits of hash. Same as PerlinNoise::Grad.
+static const float gradients[16][3] = {
+    {1, 1, 0}, {-1, 1, 0}, {1, -1, 0}, {-1, -1, 0},
+    {1, 0, 1}, {-1, 0, 1}, {1, 0, -1}, {-1, 0, -1},
+    {0, 1, 1}, {0, -1, 1}, {0, 1, -1}, {0, -1, -1},
+    {1, 1, 0}, {0, -1, 1}, {-1, 1, 0}, {0, -1, -1},
+};
+
+}
+
 PerlinNoise::PerlinNoise(RandomEngine& engine)
 {
     ea::iota(p_.begin(), p_.begin() + NumPer, 0);
@@ -73,6 +95,119 @@ double PerlinNoise::GetDouble(double x, double y, double z, int repeat) const
     return (res + 1.0) / 2.0;
 }
 
+void PerlinNoise::GetBatch(float dest[], const Vector3 positions[], unsigned count, int repeat) const
+{
+    repeat = Clamp(repeat, 0, static_cast<int>(NumPer));
+
+    unsigned i = 0;
+    for (; i + NOISE_BLOCK_WIDTH <= count; i += NOISE_BLOCK_WIDTH)
+        GetBlock(dest + i, positions + i, repeat);
+    for (; i < count; ++i)
+        dest[i] = Get(positions[i].x_, positions[i].y_, positions[i].z_, repeat);
+}
+
+void PerlinNoise::GetBlock(float dest[], const Vector3 positions[], int repeat) const
+{
+    // Hashing is done per lane, gradients and interpolation are done for all lanes at once
+    int hashes[8][NOISE_BLOCK_WIDTH];
+    float coords[3][NOISE_BLOCK_WIDTH];
+    for (unsigned lane = 0; lane < NOISE_BLOCK_WIDTH; ++lane)
+    {
+        const Vector3& pos = positions[lane];
+        const float floorX = floorf(pos.x_);
+        const float floorY = floorf(pos.y_);
+        const float floorZ = floorf(pos.z_);
+
+        const int hX = AbsMod(static_cast<int>(floorX), repeat);
+        const int hY = AbsMod(static_cast<int>(floorY), repeat);
+        const int hZ = AbsMod(static_cast<int>(floorZ), repeat);
+        const int hX1 = Inc(hX, repeat);
+        const int hY1 = Inc(hY, repeat);
+        const int hZ1 = Inc(hZ, repeat);
+
+        hashes[0][lane] = p_[p_[p_[hX] + hY] + hZ];
+        hashes[1][lane] = p_[p_[p_[hX1] + hY] + hZ];
+        hashes[2][lane] = p_[p_[p_[hX] + hY1] + hZ];
+        hashes[3][lane] = p_[p_[p_[hX1] + hY1] + hZ];
+        hashes[4][lane] = p_[p_[p_[hX] + hY] + hZ1];
+        hashes[5][lane] = p_[p_[p_[hX1] + hY] + hZ1];
+        hashes[6][lane] = p_[p_[p_[hX] + hY1] + hZ1];
+        hashes[7][lane] = p_[p_[p_[hX1] + hY1] + hZ1];
+
+        coords[0][lane] = pos.x_ - floorX;
+        coords[1][lane] = pos.y_ - floorY;
+        coords[2][lane] = pos.z_ - floorZ;
+    }
+
+#if defined(URHO3D_SSE)
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 x = _mm_loadu_ps(coords[0]);
+    const __m128 y = _mm_loadu_ps(coords[1]);
+    const __m128 z = _mm_loadu_ps(coords[2]);
+    const __m128 offsets[2][3] = {{x, y, z}, {_mm_sub_ps(x, one), _mm_sub_ps(y, one), _mm_sub_ps(z, one)}};
+
+    const auto fade = [](__m128 t)
+    {
+        // t * t * t * (t * (t * 6 - 15) + 10)
+        const __m128 inner = _mm_add_ps(
+            _mm_mul_ps(t, _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f))), _mm_set1_ps(10.0f));
+        return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), inner);
+    };
+    const auto lerp = [](__m128 lhs, __m128 rhs, __m128 t) { return _mm_add_ps(lhs, _mm_mul_ps(_mm_sub_ps(rhs, lhs), t)); };
+
+    __m128 corners[8];
+    for (unsigned corner = 0; corner < 8; ++corner)
+    {
+        const int* hash = hashes[corner];
+        const float* g0 = gradients[hash[0] & 15];
+        const float* g1 = gradients[hash[1] & 15];
+        const float* g2 = gradients[hash[2] & 15];
+        const float* g3 = gradients[hash[3] & 15];
+        const __m128 gx = _mm_setr_ps(g0[0], g1[0], g2[0], g3[0]);
+        const __m128 gy = _mm_setr_ps(g0[1], g1[1], g2[1], g3[1]);
+        const __m128 gz = _mm_setr_ps(g0[2], g1[2], g2[2], g3[2]);
+
+        const __m128 dx = offsets[corner & 1][0];
+        const __m128 dy = offsets[(corner >> 1) & 1][1];
+        const __m128 dz = offsets[(corner >> 2) & 1][2];
+        corners[corner] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(gx, dx), _mm_mul_ps(gy, dy)), _mm_mul_ps(gz, dz));
+    }
+
+    const __m128 u = fade(x);
+    const __m128 v = fade(y);
+    const __m128 w = fade(z);
+
+    const __m128 a = lerp(lerp(corners[0], corners[1], u), lerp(corners[2], corners[3], u), v);
+    const __m128 b = lerp(lerp(corners[4], corners[5], u), lerp(corners[6], corners[7], u), v);
+    const __m128 res = lerp(a, b, w);
+    _mm_storeu_ps(dest, _mm_mul_ps(_mm_add_ps(res, one), _mm_set1_ps(0.5f)));
+#else
+    for (unsigned lane = 0; lane < NOISE_BLOCK_WIDTH; ++lane)
+    {
+        const float x = coords[0][lane];
+        const float y = coords[1][lane];
+        const float z = coords[2][lane];
+        const float offsets[2][3] = {{x, y, z}, {x - 1.0f, y - 1.0f, z - 1.0f}};
+
+        float corners[8];
+        for (unsigned corner = 0; corner < 8; ++corner)
+        {
+            const float* g = gradients[hashes[corner][lane] & 15];
+            corners[corner] = g[0] * offsets[corner & 1][0] + g[1] * offsets[(corner >> 1) & 1][1]
+                + g[2] * offsets[(corner >> 2) & 1][2];
+        }
+
+        const auto u = static_cast<float>(Fade(x));
+        const auto v = static_cast<float>(Fade(y));
+        const auto w = static_cast<float>(Fade(z));
+
+        const float a = Lerp(Lerp(corners[0], corners[1], u), Lerp(corners[2], corners[3], u), v);
+        const float b = Lerp(Lerp(corners[4], corners[5], u), Lerp(corners[6], corners[7], u), v);
+        dest[lane] = (Lerp(a, b, w) + 1.0f) * 0.5f;
+    }
+#endif
+}
+
 double PerlinNoise::Fade(double t)
 {
     return t * t * t * (t * (t * 6 - 15) + 10);
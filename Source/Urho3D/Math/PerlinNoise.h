@@ -23,6 +23,7 @@
 #pragma once
 
 #include "../Math/RandomEngine.h"
+#include "../Math/Vector3.h"
 
 namespace Urho3D
 {
@@ -39,6 +40,8 @@ public:
     double GetDouble(double x, double y, double z, int repeat = NumPer) const;
     /// Return noise value as float.
     float Get(float x, float y, float z, int repeat = NumPer) const { return static_cast<float>(GetDouble(x, y, z, repeat)); }
+    /// Return noise values for array of positions. Same as Get for each position up to floating point rounding.
+    void GetBatch(float dest[], const Vector3 positions[], unsigned count, int repeat = NumPer) const;
 
 private:
     /// Apply 5-th order smoothstep.
@@ -47,6 +50,8 @@ private:
     static int Inc(int coord, int repeat) { return AbsMod(coord + 1, repeat); }
     /// Return random gradient.
     double Grad(int hash, double x, double y, double z) const;
+    /// Return noise values for 4 positions at once.
+    void GetBlock(float dest[], const Vector3 positions[], int repeat) const;
 
     /// Permutations.
     ea::array<int, NumPer * 2> p_{};
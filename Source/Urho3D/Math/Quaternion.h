@@ -24,8 +24,10 @@
 
 #include "../Math/Matrix3.h"
 
-#ifdef URHO3D_SSE
+#if defined(URHO3D_SSE)
 #include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
 #endif
 
 namespace Urho3D
@@ -258,6 +260,24 @@ public:
         out = _mm_add_ps(_mm_mul_ps(_mm_xor_ps(signz, _mm_shuffle_ps(q1, q1, _MM_SHUFFLE(3, 3, 3, 3))), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(2, 3, 0, 1))), out);
         out = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(q1, q1, _MM_SHUFFLE(0, 0, 0, 0)), q2), out);
         return Quaternion(_mm_shuffle_ps(out, out, _MM_SHUFFLE(2, 1, 0, 3)));
+#elif defined(__ARM_NEON)
+        static const float signX[4] = {-1.0f, 1.0f, -1.0f, 1.0f};
+        static const float signY[4] = {-1.0f, 1.0f, 1.0f, -1.0f};
+        static const float signZ[4] = {-1.0f, -1.0f, 1.0f, 1.0f};
+        const float32x4_t q1 = vld1q_f32(&w_);
+        const float32x4_t q2 = vld1q_f32(&rhs.w_);
+        // Permutations of rhs multiplied by x, y and z of lhs: (x, w, z, y), (y, z, w, x) and (z, y, x, w)
+        const float32x4_t q2xwzy = vmulq_f32(vrev64q_f32(q2), vld1q_f32(signX));
+        const float32x4_t q2yzwx = vextq_f32(q2, q2, 2);
+        const float32x4_t q2zyxw = vmulq_f32(vrev64q_f32(q2yzwx), vld1q_f32(signZ));
+        float32x4_t out = vmulq_lane_f32(q2, vget_low_f32(q1), 0);
+        out = vaddq_f32(out, vmulq_lane_f32(q2xwzy, vget_low_f32(q1), 1));
+        out = vaddq_f32(out, vmulq_lane_f32(vmulq_f32(q2yzwx, vld1q_f32(signY)), vget_high_f32(q1), 0));
+        out = vaddq_f32(out, vmulq_lane_f32(q2zyxw, vget_high_f32(q1), 1));
+
+        Quaternion ret;
+        vst1q_f32(&ret.w_, out);
+        return ret;
 #else
         return Quaternion(
             w_ * rhs.w_ - x_ * rhs.x_ - y_ * rhs.y_ - z_ * rhs.z_,
@@ -191,4 +191,84 @@ Vector3 RandomEngine::GetVector3(const Vector3& min, const Vector3& max)
     return result;
 }
 
+void RandomEngine::GetUIntArray(ea::span<unsigned> dest)
+{
+    if (dest.empty())
+        return;
+
+    // Linear congruential engine can jump ahead, so values are generated in independent lanes
+    // with exactly the same sequence as sequential calls.
+    using StateType = unsigned long long;
+    static constexpr StateType modulus = EngineType::modulus;
+    static constexpr StateType step1 = EngineType::multiplier % modulus;
+    static constexpr StateType step2 = step1 * step1 % modulus;
+    static constexpr StateType step3 = step2 * step1 % modulus;
+    static constexpr StateType step4 = step3 * step1 % modulus;
+    static constexpr unsigned minValue = EngineType::min();
+
+    StateType state = engine_();
+    dest[0] = static_cast<unsigned>(state) - minValue;
+
+    const unsigned count = dest.size();
+    unsigned i = 1;
+    for (; i + 4 <= count; i += 4)
+    {
+        const StateType x0 = state * step1 % modulus;
+        const StateType x1 = state * step2 % modulus;
+        const StateType x2 = state * step3 % modulus;
+        const StateType x3 = state * step4 % modulus;
+        dest[i] = static_cast<unsigned>(x0) - minValue;
+        dest[i + 1] = static_cast<unsigned>(x1) - minValue;
+        dest[i + 2] = static_cast<unsigned>(x2) - minValue;
+        dest[i + 3] = static_cast<unsigned>(x3) - minValue;
+        state = x3;
+    }
+    for (; i < count; ++i)
+    {
+        state = state * step1 % modulus;
+        dest[i] = static_cast<unsigned>(state) - minValue;
+    }
+
+    engine_.seed(static_cast<EngineType::result_type>(state));
+}
+
+void RandomEngine::GetFloatArray(ea::span<float> dest, float min, float max)
+{
+    static const unsigned blockSize = 64;
+    unsigned values[blockSize];
+
+    const double range = static_cast<double>(MaxRange() - 1);
+    const double delta = static_cast<double>(max) - min;
+    for (unsigned offset = 0; offset < dest.size(); offset += blockSize)
+    {
+        const unsigned count = ea::min<unsigned>(blockSize, dest.size() - offset);
+        GetUIntArray({values, count});
+        for (unsigned i = 0; i < count; ++i)
+            dest[offset + i] = static_cast<float>(values[i] / range * delta + min);
+    }
+}
+
+void RandomEngine::GetVector3Array(ea::span<Vector3> dest, const Vector3& min, const Vector3& max)
+{
+    static const unsigned blockSize = 64;
+    unsigned values[blockSize * 3];
+
+    const double range = static_cast<double>(MaxRange() - 1);
+    const double deltaX = static_cast<double>(max.x_) - min.x_;
+    const double deltaY = static_cast<double>(max.y_) - min.y_;
+    const double deltaZ = static_cast<double>(max.z_) - min.z_;
+    for (unsigned offset = 0; offset < dest.size(); offset += blockSize)
+    {
+        const unsigned count = ea::min<unsigned>(blockSize, dest.size() - offset);
+        GetUIntArray({values, count * 3});
+        for (unsigned i = 0; i < count; ++i)
+        {
+            Vector3& result = dest[offset + i];
+            result.x_ = static_cast<float>(values[i * 3] / range * deltaX + min.x_);
+            result.y_ = static_cast<float>(values[i * 3 + 1] / range * deltaY + min.y_);
+            result.z_ = static_cast<float>(values[i * 3 + 2] / range * deltaZ + min.z_);
+        }
+    }
+}
+
 }
@@ -118,6 +118,13 @@ public:
     /// Return random 3D vector in 3D volume.
     Vector3 GetVector3(const BoundingBox& boundingBox) { return GetVector3(boundingBox.min_, boundingBox.max_); }
 
+    /// Fill array with random unsigned integers in range [0, MaxRange). Same as calling GetUInt for each element.
+    void GetUIntArray(ea::span<unsigned> dest);
+    /// Fill array with random floats in range [min, max]. Same as calling GetFloat for each element.
+    void GetFloatArray(ea::span<float> dest, float min, float max);
+    /// Fill array with random 3D vectors in 3D volume. Same as calling GetVector3 for each element.
+    void GetVector3Array(ea::span<Vector3> dest, const Vector3& min, const Vector3& max);
+
 private:
     /// Return random array of floats with standard normal distribution.
     void GetStandardNormalFloatArray(ea::span<float> array);
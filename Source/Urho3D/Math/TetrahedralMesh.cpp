@@ -153,6 +153,7 @@ void TetrahedralMesh::Define(ea::span<const Vector3> positions)
     boundingBox.max_ += Vector3::ONE;
     InitializeSuperMesh(boundingBox);
     BuildTetrahedrons(positions);
+    UpdateSeedGrid();
 }
 
 void TetrahedralMesh::CollectEdges(ea::vector<ea::pair<unsigned, unsigned>>& edges)
@@ -269,26 +270,108 @@ Vector4 TetrahedralMesh::GetInterpolationFactors(const Vector3& position, unsign
     if (tetrahedrons_.empty())
         return Vector4::ZERO;
 
-    const unsigned maxIters = tetrahedrons_.size();
-    if (tetIndexHint >= maxIters)
-        tetIndexHint = 0;
+    const unsigned numTetrahedrons = tetrahedrons_.size();
+    const bool hasHint = tetIndexHint < numTetrahedrons;
+    if (!hasHint)
+        tetIndexHint = GetSeedTetrahedron(position);
 
-    for (unsigned i = 0; i < maxIters; ++i)
+    // Hint is usually within a few steps for coherent queries, restart from the seed grid if it is not.
+    Vector4 weights;
+    if (WalkToTetrahedron(position, tetIndexHint, weights, hasHint ? MaxHintWalkSteps : numTetrahedrons))
+        return weights;
+
+    if (hasHint)
     {
-        const Vector4 weights = GetBarycentricCoords(tetIndexHint, position);
-        if (weights.x_ >= 0.0f && weights.y_ >= 0.0f && weights.z_ >= 0.0f && weights.w_ >= 0.0f)
+        tetIndexHint = GetSeedTetrahedron(position);
+        if (WalkToTetrahedron(position, tetIndexHint, weights, numTetrahedrons))
             return weights;
+    }
+
+    // Walk may get stuck near the hull because coordinates in outer tetrahedrons are not linear.
+    // This is rare and the hint is updated, so just check all tetrahedrons.
+    for (unsigned tetIndex = 0; tetIndex < numTetrahedrons; ++tetIndex)
+    {
+        const Vector4 tetWeights = GetBarycentricCoords(tetIndex, position);
+        if (tetWeights.x_ >= 0.0f && tetWeights.y_ >= 0.0f && tetWeights.z_ >= 0.0f && tetWeights.w_ >= 0.0f)
+        {
+            tetIndexHint = tetIndex;
+            return tetWeights;
+        }
+    }
+    return weights;
+}
 
+bool TetrahedralMesh::WalkToTetrahedron(
+    const Vector3& position, unsigned& tetIndex, Vector4& weights, unsigned maxSteps) const
+{
+    for (unsigned i = 0; i < maxSteps; ++i)
+    {
+        weights = GetBarycentricCoords(tetIndex, position);
+        if (weights.x_ >= 0.0f && weights.y_ >= 0.0f && weights.z_ >= 0.0f && weights.w_ >= 0.0f)
+            return true;
+
+        unsigned nextTetIndex{};
         if (weights.x_ < weights.y_ && weights.x_ < weights.z_ && weights.x_ < weights.w_)
-            tetIndexHint = tetrahedrons_[tetIndexHint].neighbors_[0];
+            nextTetIndex = tetrahedrons_[tetIndex].neighbors_[0];
         else if (weights.y_ < weights.z_ && weights.y_ < weights.w_)
-            tetIndexHint = tetrahedrons_[tetIndexHint].neighbors_[1];
+            nextTetIndex = tetrahedrons_[tetIndex].neighbors_[1];
         else if (weights.z_ < weights.w_)
-            tetIndexHint = tetrahedrons_[tetIndexHint].neighbors_[2];
+            nextTetIndex = tetrahedrons_[tetIndex].neighbors_[2];
         else
-            tetIndexHint = tetrahedrons_[tetIndexHint].neighbors_[3];
+            nextTetIndex = tetrahedrons_[tetIndex].neighbors_[3];
+
+        if (nextTetIndex >= tetrahedrons_.size())
+            return false;
+        tetIndex = nextTetIndex;
     }
-    return GetBarycentricCoords(tetIndexHint, position);
+
+    weights = GetBarycentricCoords(tetIndex, position);
+    return false;
+}
+
+void TetrahedralMesh::UpdateSeedGrid()
+{
+    seedGrid_.clear();
+    seedGridSize_ = IntVector3::ZERO;
+    seedGridBox_ = BoundingBox{};
+    if (tetrahedrons_.empty() || vertices_.empty())
+        return;
+
+    // Aim for a few inner tetrahedrons per cell
+    const auto numCellsPerAxis = static_cast<int>(std::ceil(std::cbrt(numInnerTetrahedrons_ / 4.0f)));
+    seedGridSize_ = IntVector3::ONE * Clamp(numCellsPerAxis, 1, static_cast<int>(MaxSeedGridSize));
+    seedGridBox_.Define(vertices_.data(), vertices_.size());
+
+    const Vector3 cellSize = seedGridBox_.Size() / seedGridSize_.ToVector3();
+    seedGrid_.reserve(seedGridSize_.x_ * seedGridSize_.y_ * seedGridSize_.z_);
+
+    // Neighboring cells are close to each other, so each walk starts from the previous result
+    unsigned tetIndex = 0;
+    Vector4 weights;
+    for (int z = 0; z < seedGridSize_.z_; ++z)
+    {
+        for (int y = 0; y < seedGridSize_.y_; ++y)
+        {
+            for (int x = 0; x < seedGridSize_.x_; ++x)
+            {
+                const Vector3 cellCenter = seedGridBox_.min_ + (Vector3(x, y, z) + Vector3::ONE * 0.5f) * cellSize;
+                WalkToTetrahedron(cellCenter, tetIndex, weights, tetrahedrons_.size());
+                seedGrid_.push_back(tetIndex);
+            }
+        }
+    }
+}
+
+unsigned TetrahedralMesh::GetSeedTetrahedron(const Vector3& position) const
+{
+    if (seedGrid_.empty())
+        return 0;
+
+    const Vector3 gridSize = seedGridBox_.Size();
+    const Vector3 relativePosition = (position - seedGridBox_.min_) / VectorMax(gridSize, Vector3::ONE * M_EPSILON);
+    const IntVector3 cell = VectorMin(VectorMax(VectorFloorToInt(relativePosition * seedGridSize_.ToVector3()),
+        IntVector3::ZERO), seedGridSize_ - IntVector3::ONE);
+    return seedGrid_[(cell.z_ * seedGridSize_.y_ + cell.y_) * seedGridSize_.x_ + cell.x_];
 }
 
 int TetrahedralMesh::SolveCubicEquation(double result[], double a, double b, double c, double eps)
@@ -1239,6 +1322,9 @@ void SerializeValue(Archive& archive, const char* name, TetrahedralMesh& value)
     SerializeVector(archive, "tetrahedrons", value.tetrahedrons_);
     SerializeVector(archive, "hullNormals", value.hullNormals_);
     SerializeValue(archive, "numInnerTetrahedrons", value.numInnerTetrahedrons_);
+
+    if (archive.IsInput())
+        value.UpdateSeedGrid();
 }
 
 }
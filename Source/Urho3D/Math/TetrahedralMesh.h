@@ -319,8 +319,15 @@ public:
     Vector4 GetBarycentricCoords(unsigned tetIndex, const Vector3& position) const;
 
     /// Find tetrahedron containing given position and calculate barycentric coordinates within this tetrahedron.
+    /// Search starts from the hint and walks through adjacent tetrahedrons. Invalid hint is replaced with
+    /// the nearest starting tetrahedron from the seed grid.
     Vector4 GetInterpolationFactors(const Vector3& position, unsigned& tetIndexHint) const;
 
+    /// Rebuild grid of starting tetrahedrons. Called automatically after Define and on load.
+    void UpdateSeedGrid();
+    /// Return tetrahedron to start the search from for given position.
+    unsigned GetSeedTetrahedron(const Vector3& position) const;
+
     /// Sample value at given position from the arbitrary container of per-vertex data.
     template <class Container>
     auto Sample(const Container& container, const Vector3& position, unsigned& tetIndexHint) const
@@ -353,6 +360,13 @@ private:
         const Vector3& p1, const Vector3& p2, const Vector3& p3);
     /// Find tetrahedron for given position. Ignore removed tetrahedrons. Return invalid index if cannot find.
     unsigned FindTetrahedron(const Vector3& position, ea::vector<bool>& removed) const;
+    /// Walk through adjacent tetrahedrons toward given position. Return true if containing tetrahedron is found.
+    bool WalkToTetrahedron(const Vector3& position, unsigned& tetIndex, Vector4& weights, unsigned maxSteps) const;
+
+    /// Max number of cells along each axis of the seed grid.
+    static const unsigned MaxSeedGridSize = 16;
+    /// Max number of steps of the walk from the hint before restarting it from the seed grid.
+    static const unsigned MaxHintWalkSteps = 32;
 
     /// Number of initial super-mesh vertices.
     static const unsigned NumSuperMeshVertices = 8;
@@ -424,6 +438,13 @@ public:
     /// Number of inner tetrahedrons.
     unsigned numInnerTetrahedrons_{};
 
+    /// Bounding box covered by the seed grid.
+    BoundingBox seedGridBox_;
+    /// Number of seed grid cells along each axis.
+    IntVector3 seedGridSize_;
+    /// Starting tetrahedron for each seed grid cell.
+    ea::vector<unsigned> seedGrid_;
+
     /// Debug array of edges related to errors in generation.
     mutable ea::vector<ea::pair<unsigned, unsigned>> debugHighlightEdges_;
 };
@@ -526,8 +526,9 @@ void CrowdAgent::OnCrowdPositionUpdate(dtCrowdAgent* ag, float* /*pos*/, float d
         Vector3 newPos(ag->npos);
         Vector3 newVel(ag->vel);
 
-        // Notify parent node of the reposition
-        if (newPos != previousPosition_)
+        // Move parent node to the new position
+        const bool repositioned = newPos != previousPosition_;
+        if (repositioned)
         {
             previousPosition_ = newPos;
 
@@ -537,7 +538,11 @@ void CrowdAgent::OnCrowdPositionUpdate(dtCrowdAgent* ag, float* /*pos*/, float d
                 node_->SetWorldPosition(newPos);
                 ignoreTransformChanges_ = false;
             }
+        }
 
+        // Skip per-agent notifications if the crowd manager is configured to only move nodes
+        if (repositioned && crowdManager_->GetRepositionEvents())
+        {
             using namespace CrowdAgentReposition;
 
             VariantMap& map = GetEventDataMap();
@@ -24,6 +24,7 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../IO/Log.h"
 #include "../Navigation/CrowdAgent.h"
@@ -76,6 +77,30 @@ void CrowdAgentUpdateCallback(bool positionUpdate, dtCrowdAgent* ag, float* pos,
         crowdAgent->OnCrowdVelocityUpdate(ag, pos, dt);
 }
 
+/// Runs loops of the Detour crowd update on WorkQueue threads.
+class CrowdTaskExecutor : public dtCrowdTaskExecutor
+{
+public:
+    explicit CrowdTaskExecutor(WorkQueue* workQueue) : workQueue_(workQueue) {}
+
+    /// One extra slot is reserved for the calling thread if it doesn't belong to WorkQueue.
+    int getNumThreads() const override { return static_cast<int>(WorkQueue::GetMaxThreadIndex() + 1); }
+
+    void parallelFor(int count, Task task, void* context) override
+    {
+        static const unsigned agentsPerTask = 16;
+        ForEachParallel(workQueue_, agentsPerTask, static_cast<unsigned>(count),
+            [&](unsigned beginIndex, unsigned endIndex)
+        {
+            const unsigned threadIndex = ea::min(WorkQueue::GetThreadIndex(), WorkQueue::GetMaxThreadIndex());
+            task(context, static_cast<int>(beginIndex), static_cast<int>(endIndex), static_cast<int>(threadIndex));
+        });
+    }
+
+private:
+    WorkQueue* workQueue_{};
+};
+
 CrowdManager::CrowdManager(Context* context) :
     Component(context),
     maxAgents_(DEFAULT_MAX_AGENTS),
@@ -89,6 +114,7 @@ CrowdManager::CrowdManager(Context* context) :
 
 CrowdManager::~CrowdManager()
 {
+    // Crowd keeps a pointer to the task executor, free it first
     dtFreeCrowd(crowd_);
     crowd_ = nullptr;
 }
@@ -100,6 +126,8 @@ void CrowdManager::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Max Agents", unsigned, maxAgents_, DEFAULT_MAX_AGENTS, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Max Agent Radius", float, maxAgentRadius_, DEFAULT_MAX_AGENT_RADIUS, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Navigation Mesh", unsigned, navigationMeshId_, 0, AM_DEFAULT | AM_COMPONENTID);
+    URHO3D_ACCESSOR_ATTRIBUTE("Multi Threaded", GetMultiThreaded, SetMultiThreaded, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Reposition Events", GetRepositionEvents, SetRepositionEvents, bool, true, AM_DEFAULT);
     URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Filter Types", GetQueryFilterTypesAttr, SetQueryFilterTypesAttr,
         VariantVector, Variant::emptyVariantVector, AM_DEFAULT)
         .SetMetadata(AttributeMetadata::VectorStructElements, filterTypesStructureElementNames);
@@ -253,6 +281,33 @@ void CrowdManager::SetMaxAgentRadius(float maxAgentRadius)
     }
 }
 
+void CrowdManager::SetMultiThreaded(bool enable)
+{
+    if (enable != multiThreaded_)
+    {
+        multiThreaded_ = enable;
+        UpdateTaskExecutor();
+    }
+}
+
+void CrowdManager::UpdateTaskExecutor()
+{
+    if (!crowd_)
+        return;
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    if (multiThreaded_ && workQueue && workQueue->GetNumThreads() > 0)
+    {
+        if (!taskExecutor_)
+            taskExecutor_ = ea::make_unique<CrowdTaskExecutor>(workQueue);
+        if (crowd_->setTaskExecutor(taskExecutor_.get()))
+            return;
+        URHO3D_LOGWARNING("Could not allocate thread data for DetourCrowd, falling back to single-threaded update");
+    }
+
+    crowd_->setTaskExecutor(nullptr);
+}
+
 void CrowdManager::SetNavigationMesh(NavigationMesh* navMesh)
 {
     UnsubscribeFromEvent(E_COMPONENTADDED);
@@ -585,6 +640,8 @@ bool CrowdManager::CreateCrowd()
         return false;
     }
 
+    UpdateTaskExecutor();
+
     // Reconfigure the newly initialized crowd
     SetQueryFilterTypesAttr(queryFilterTypeConfiguration);
     SetObstacleAvoidanceTypesAttr(obstacleAvoidanceTypeConfiguration);
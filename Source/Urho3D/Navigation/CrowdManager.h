@@ -31,6 +31,7 @@ using dtPolyRef = unsigned int;
 #endif
 
 class dtCrowd;
+class dtCrowdTaskExecutor;
 class dtQueryFilter;
 struct dtCrowdAgent;
 
@@ -114,6 +115,12 @@ public:
     void SetObstacleAvoidanceTypesAttr(const VariantVector& value);
     /// Set the params for the specified obstacle avoidance type.
     void SetObstacleAvoidanceParams(unsigned obstacleAvoidanceType, const CrowdObstacleAvoidanceParams& params);
+    /// Set whether the crowd update is distributed between WorkQueue threads. Velocity shaders and events are always processed on the main thread.
+    /// @property
+    void SetMultiThreaded(bool enable);
+    /// Set whether to send reposition events for each moved agent. Node positions are updated regardless.
+    /// @property
+    void SetRepositionEvents(bool enable) { repositionEvents_ = enable; }
 
     /// Get all the crowd agent components in the specified node hierarchy. If the node is not specified then use scene node. When inCrowdFilter is set to true then only get agents that are in the crowd.
     ea::vector<CrowdAgent*> GetAgents(Node* node = nullptr, bool inCrowdFilter = true) const;
@@ -136,6 +143,13 @@ public:
     /// @property
     unsigned GetMaxAgents() const { return maxAgents_; }
 
+    /// Return whether the crowd update is distributed between WorkQueue threads.
+    /// @property
+    bool GetMultiThreaded() const { return multiThreaded_; }
+    /// Return whether reposition events are sent for each moved agent.
+    /// @property
+    bool GetRepositionEvents() const { return repositionEvents_; }
+
     /// Get the maximum radius of any agent.
     /// @property
     float GetMaxAgentRadius() const { return maxAgentRadius_; }
@@ -198,8 +212,13 @@ private:
     /// Handle component added in the scene to check for late addition of the navmesh.
     void HandleComponentAdded(StringHash eventType, VariantMap& eventData);
 
+    /// Update the task executor of Detour crowd.
+    void UpdateTaskExecutor();
+
     /// Internal Detour crowd object.
     dtCrowd* crowd_{};
+    /// Task executor used by Detour crowd to run the update on WorkQueue threads.
+    ea::unique_ptr<dtCrowdTaskExecutor> taskExecutor_;
     /// Velocity shader.
     CrowdAgentVelocityShader velocityShader_;
     /// NavigationMesh for which the crowd was created.
@@ -216,6 +235,10 @@ private:
     ea::vector<unsigned> numAreas_;
     /// Number of obstacle avoidance types configured in the crowd. Limit to DT_CROWD_MAX_OBSTAVOIDANCE_PARAMS.
     unsigned numObstacleAvoidanceTypes_{};
+    /// Whether the crowd update is distributed between WorkQueue threads.
+    bool multiThreaded_{};
+    /// Whether to send reposition events for each moved agent.
+    bool repositionEvents_{true};
 };
 
 }
@@ -24,6 +24,7 @@
 
 #include <cassert>
 
+#include "../Math/MathDefs.h"
 #include "../Navigation/NavBuildData.h"
 
 #include <DetourTileCache/DetourTileCacheBuilder.h>
@@ -32,6 +33,152 @@
 namespace Urho3D
 {
 
+void NavGeometrySoup::Reset(const Vector3& origin, float tileEdgeLength, float tileBorder,
+    const IntVector2& from, const IntVector2& to)
+{
+    vertices_.clear();
+    indices_.clear();
+    offMeshConnections_.clear();
+    navAreas_.clear();
+    items_.clear();
+
+    origin_ = origin;
+    tileEdgeLength_ = tileEdgeLength;
+    tileBorder_ = tileBorder;
+    from_ = from;
+    to_ = to;
+
+    tileItems_.clear();
+    if (to_.x_ >= from_.x_ && to_.y_ >= from_.y_)
+        tileItems_.resize((to_.x_ - from_.x_ + 1) * (to_.y_ - from_.y_ + 1));
+}
+
+void NavGeometrySoup::AddTriangles(const BoundingBox& boundingBox, unsigned vertexStart, unsigned indexStart)
+{
+    if (indexStart >= indices_.size())
+        return;
+
+    Item item;
+    item.type_ = ITEM_TRIANGLES;
+    item.boundingBox_ = boundingBox;
+    item.first_ = vertexStart;
+    item.vertexCount_ = vertices_.size() - vertexStart;
+    item.indexStart_ = indexStart;
+    item.indexCount_ = indices_.size() - indexStart;
+    AddItem(item);
+}
+
+void NavGeometrySoup::AddOffMeshConnection(const BoundingBox& boundingBox, const NavOffMeshStub& connection)
+{
+    Item item{};
+    item.type_ = ITEM_OFFMESH_CONNECTION;
+    item.boundingBox_ = boundingBox;
+    item.first_ = offMeshConnections_.size();
+    offMeshConnections_.push_back(connection);
+    AddItem(item);
+}
+
+void NavGeometrySoup::AddNavArea(const BoundingBox& boundingBox, const NavAreaStub& area)
+{
+    Item item{};
+    item.type_ = ITEM_NAV_AREA;
+    item.boundingBox_ = boundingBox;
+    item.first_ = navAreas_.size();
+    navAreas_.push_back(area);
+    AddItem(item);
+}
+
+bool NavGeometrySoup::IsInsideArea(const BoundingBox& boundingBox) const
+{
+    if (tileItems_.empty() || tileEdgeLength_ <= 0.0f)
+        return false;
+
+    IntVector2 minTile;
+    IntVector2 maxTile;
+    GetTileRange(boundingBox, minTile, maxTile);
+    return maxTile.x_ >= from_.x_ && maxTile.y_ >= from_.y_ && minTile.x_ <= to_.x_ && minTile.y_ <= to_.y_;
+}
+
+void NavGeometrySoup::AddItem(const Item& item)
+{
+    if (!IsInsideArea(item.boundingBox_))
+        return;
+
+    IntVector2 minTile;
+    IntVector2 maxTile;
+    GetTileRange(item.boundingBox_, minTile, maxTile);
+
+    const unsigned itemIndex = items_.size();
+    items_.push_back(item);
+
+    const int width = to_.x_ - from_.x_ + 1;
+    for (int z = Max(minTile.y_, from_.y_); z <= Min(maxTile.y_, to_.y_); ++z)
+    {
+        for (int x = Max(minTile.x_, from_.x_); x <= Min(maxTile.x_, to_.x_); ++x)
+            tileItems_[(z - from_.y_) * width + (x - from_.x_)].push_back(itemIndex);
+    }
+}
+
+void NavGeometrySoup::GetTileRange(const BoundingBox& boundingBox, IntVector2& minTile, IntVector2& maxTile) const
+{
+    minTile.x_ = FloorToInt((boundingBox.min_.x_ - tileBorder_ - origin_.x_) / tileEdgeLength_);
+    minTile.y_ = FloorToInt((boundingBox.min_.z_ - tileBorder_ - origin_.z_) / tileEdgeLength_);
+    maxTile.x_ = FloorToInt((boundingBox.max_.x_ + tileBorder_ - origin_.x_) / tileEdgeLength_);
+    maxTile.y_ = FloorToInt((boundingBox.max_.z_ + tileBorder_ - origin_.z_) / tileEdgeLength_);
+}
+
+void NavGeometrySoup::GetTileGeometry(NavBuildData* build, const IntVector2& tile, const BoundingBox& box) const
+{
+    if (tile.x_ < from_.x_ || tile.y_ < from_.y_ || tile.x_ > to_.x_ || tile.y_ > to_.y_)
+        return;
+
+    const int width = to_.x_ - from_.x_ + 1;
+    for (unsigned itemIndex : tileItems_[(tile.y_ - from_.y_) * width + (tile.x_ - from_.x_)])
+    {
+        const Item& item = items_[itemIndex];
+        if (box.IsInsideFast(item.boundingBox_) == OUTSIDE)
+            continue;
+
+        switch (item.type_)
+        {
+        case ITEM_TRIANGLES:
+            {
+                const int destVertexStart = static_cast<int>(build->vertices_.size());
+                build->vertices_.insert(build->vertices_.end(),
+                    vertices_.begin() + item.first_, vertices_.begin() + item.first_ + item.vertexCount_);
+                for (unsigned i = item.indexStart_; i < item.indexStart_ + item.indexCount_; ++i)
+                    build->indices_.push_back(indices_[i] - static_cast<int>(item.first_) + destVertexStart);
+            }
+            break;
+
+        case ITEM_OFFMESH_CONNECTION:
+            {
+                const NavOffMeshStub& connection = offMeshConnections_[item.first_];
+                build->offMeshVertices_.push_back(connection.start_);
+                build->offMeshVertices_.push_back(connection.end_);
+                build->offMeshRadii_.push_back(connection.radius_);
+                build->offMeshFlags_.push_back(connection.flags_);
+                build->offMeshAreas_.push_back(connection.areaID_);
+                build->offMeshDir_.push_back(connection.direction_);
+            }
+            break;
+
+        case ITEM_NAV_AREA:
+            build->navAreas_.push_back(navAreas_[item.first_]);
+            break;
+        }
+    }
+}
+
+NavTileBuildBatch::~NavTileBuildBatch()
+{
+    for (NavTileBuildResult& result : results_)
+    {
+        for (const auto& data : result.data_)
+            dtFree(data.first);
+    }
+}
+
 NavBuildData::NavBuildData() :
     ctx_(new rcContext(true)),
     heightField_(nullptr),
@@ -22,9 +22,11 @@
 
 #pragma once
 
+#include <EASTL/utility.h>
 #include <EASTL/vector.h>
 
 #include "../Math/BoundingBox.h"
+#include "../Math/Vector2.h"
 #include "../Math/Vector3.h"
 
 class rcContext;
@@ -51,6 +53,130 @@ struct URHO3D_API NavAreaStub
     unsigned char areaID_;
 };
 
+/// Off-mesh connection stub.
+struct URHO3D_API NavOffMeshStub
+{
+    /// Start point in navigation mesh space.
+    Vector3 start_;
+    /// End point in navigation mesh space.
+    Vector3 end_;
+    /// Connection radius.
+    float radius_;
+    /// Connection flags.
+    unsigned short flags_;
+    /// Area ID.
+    unsigned char areaID_;
+    /// Connection direction.
+    unsigned char direction_;
+};
+
+struct NavBuildData;
+
+/// Navigation geometry collected once for a multi-tile build. Geometry is pretransformed to navigation mesh space
+/// and bucketed by tile, so tiles may be built from worker threads without touching scene components.
+/// @nobind
+struct URHO3D_API NavGeometrySoup
+{
+    /// Type of soup item.
+    enum ItemType
+    {
+        ITEM_TRIANGLES = 0,
+        ITEM_OFFMESH_CONNECTION,
+        ITEM_NAV_AREA
+    };
+
+    /// Soup item produced by one geometry component.
+    struct Item
+    {
+        /// Item type.
+        ItemType type_;
+        /// Bounding box in navigation mesh space.
+        BoundingBox boundingBox_;
+        /// First vertex, off-mesh connection or navigation area.
+        unsigned first_;
+        /// Number of vertices.
+        unsigned vertexCount_;
+        /// First index.
+        unsigned indexStart_;
+        /// Number of indices.
+        unsigned indexCount_;
+    };
+
+    /// Reset soup and prepare tile buckets for the rectangular tile area.
+    void Reset(const Vector3& origin, float tileEdgeLength, float tileBorder, const IntVector2& from, const IntVector2& to);
+    /// Register triangles appended to vertices_ and indices_ since given offsets.
+    void AddTriangles(const BoundingBox& boundingBox, unsigned vertexStart, unsigned indexStart);
+    /// Add off-mesh connection.
+    void AddOffMeshConnection(const BoundingBox& boundingBox, const NavOffMeshStub& connection);
+    /// Add navigation area.
+    void AddNavArea(const BoundingBox& boundingBox, const NavAreaStub& area);
+    /// Return whether the bounding box overlaps the tile area, including tile borders.
+    bool IsInsideArea(const BoundingBox& boundingBox) const;
+    /// Copy geometry intersecting the box into build data of the tile. Safe to call from multiple threads.
+    void GetTileGeometry(NavBuildData* build, const IntVector2& tile, const BoundingBox& box) const;
+
+    /// Vertices of all triangle items.
+    ea::vector<Vector3> vertices_;
+    /// Indices of all triangle items.
+    ea::vector<int> indices_;
+    /// Off-mesh connections.
+    ea::vector<NavOffMeshStub> offMeshConnections_;
+    /// Navigation areas.
+    ea::vector<NavAreaStub> navAreas_;
+    /// Items.
+    ea::vector<Item> items_;
+    /// Item indices per tile of the rectangular tile area.
+    ea::vector<ea::vector<unsigned>> tileItems_;
+
+private:
+    /// Register item in all tile buckets it overlaps.
+    void AddItem(const Item& item);
+    /// Calculate tile range overlapped by the bounding box, including tile borders. Not clamped to the tile area.
+    void GetTileRange(const BoundingBox& boundingBox, IntVector2& minTile, IntVector2& maxTile) const;
+
+    /// Origin of the tile grid.
+    Vector3 origin_;
+    /// Tile edge length.
+    float tileEdgeLength_{};
+    /// Tile border. Items within the border of a tile are included in the tile.
+    float tileBorder_{};
+    /// First tile of the area.
+    IntVector2 from_;
+    /// Last tile of the area.
+    IntVector2 to_;
+};
+
+/// Navigation mesh tile built from the geometry soup and waiting to be added to the navigation mesh.
+/// @nobind
+struct URHO3D_API NavTileBuildResult
+{
+    /// Tile index.
+    IntVector2 tile_;
+    /// Whether the tile has geometry and was built successfully.
+    bool success_{};
+    /// Detour data of the tile, or compressed tile cache layers of the tile. Ownership is passed on when the tile is added.
+    ea::vector<ea::pair<unsigned char*, int>> data_;
+};
+
+/// Batch of navigation mesh tiles built together from one geometry soup.
+/// @nobind
+struct URHO3D_API NavTileBuildBatch
+{
+    /// Construct.
+    NavTileBuildBatch() = default;
+    /// Prevent copy construction.
+    NavTileBuildBatch(const NavTileBuildBatch& rhs) = delete;
+    /// Prevent assignment.
+    NavTileBuildBatch& operator =(const NavTileBuildBatch& rhs) = delete;
+    /// Destruct. Free tile data that was not added to the navigation mesh.
+    ~NavTileBuildBatch();
+
+    /// Geometry of all tiles in the batch.
+    NavGeometrySoup soup_;
+    /// Built tiles.
+    ea::vector<NavTileBuildResult> results_;
+};
+
 /// Navigation build data.
 struct URHO3D_API NavBuildData
 {
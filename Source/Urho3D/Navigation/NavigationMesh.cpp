@@ -23,7 +23,9 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/CoreEvents.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../Graphics/Drawable.h"
 #include "../Graphics/Geometry.h"
@@ -78,6 +80,9 @@ static const float DEFAULT_EDGE_MAX_LENGTH = 12.0f;
 static const float DEFAULT_EDGE_MAX_ERROR = 1.3f;
 static const float DEFAULT_DETAIL_SAMPLE_DISTANCE = 6.0f;
 static const float DEFAULT_DETAIL_SAMPLE_MAX_ERROR = 1.0f;
+static const unsigned DEFAULT_MAX_ASYNC_BUILD_TILES = 16;
+static const unsigned DEFAULT_PATH_ITERATIONS_PER_FRAME = 256;
+static const unsigned DEFAULT_MAX_CONCURRENT_PATH_REQUESTS = 64;
 
 static const int MAX_POLYS = 2048;
 
@@ -95,6 +100,80 @@ struct FindPathData
     unsigned char pathFlags_[MAX_POLYS]{};
 };
 
+/// Asynchronous path request.
+struct NavigationPathRequest
+{
+    // Start point in navigation mesh space.
+    Vector3 start_;
+    // End point in navigation mesh space.
+    Vector3 end_;
+    // Search extents.
+    Vector3 extents_;
+    // Query filter.
+    const dtQueryFilter* filter_{};
+    // Completion callback.
+    NavigationPathCallback callback_;
+    // Navigation mesh query holding the state of sliced pathfinding.
+    dtNavMeshQuery* query_{};
+    // End polygon.
+    dtPolyRef endRef_{};
+    // Whether sliced pathfinding is initialized.
+    bool started_{};
+    // Whether the request is completed.
+    bool completed_{};
+    // Points on the path in navigation mesh space.
+    ea::vector<Vector3> pathPoints_;
+    // Flags on the path.
+    ea::vector<unsigned char> pathFlags_;
+};
+
+/// Advance sliced pathfinding of the request. Safe to call for different requests in parallel.
+static void UpdatePathRequest(NavigationPathRequest& request, unsigned maxIterations)
+{
+    dtNavMeshQuery* query = request.query_;
+
+    if (!request.started_)
+    {
+        request.started_ = true;
+
+        dtPolyRef startRef;
+        query->findNearestPoly(&request.start_.x_, &request.extents_.x_, request.filter_, &startRef, nullptr);
+        query->findNearestPoly(&request.end_.x_, &request.extents_.x_, request.filter_, &request.endRef_, nullptr);
+
+        if (!startRef || !request.endRef_
+            || dtStatusFailed(query->initSlicedFindPath(startRef, request.endRef_, &request.start_.x_, &request.end_.x_, request.filter_)))
+        {
+            request.completed_ = true;
+            return;
+        }
+    }
+
+    const dtStatus status = query->updateSlicedFindPath(static_cast<int>(maxIterations), nullptr);
+    if (dtStatusInProgress(status))
+        return;
+
+    request.completed_ = true;
+
+    dtPolyRef polys[MAX_POLYS];
+    int numPolys = 0;
+    if (dtStatusFailed(query->finalizeSlicedFindPath(polys, &numPolys, MAX_POLYS)) || !numPolys)
+        return;
+
+    Vector3 actualEnd = request.end_;
+
+    // If full path was not found, clamp end point to the end polygon
+    if (polys[numPolys - 1] != request.endRef_)
+        query->closestPointOnPoly(polys[numPolys - 1], &request.end_.x_, &actualEnd.x_, nullptr);
+
+    int numPathPoints = 0;
+    request.pathPoints_.resize(MAX_POLYS);
+    request.pathFlags_.resize(MAX_POLYS);
+    query->findStraightPath(&request.start_.x_, &actualEnd.x_, polys, numPolys,
+        &request.pathPoints_[0].x_, request.pathFlags_.data(), nullptr, &numPathPoints, MAX_POLYS);
+    request.pathPoints_.resize(numPathPoints);
+    request.pathFlags_.resize(numPathPoints);
+}
+
 NavigationMesh::NavigationMesh(Context* context) :
     Component(context),
     navMesh_(nullptr),
@@ -120,7 +199,10 @@ NavigationMesh::NavigationMesh(Context* context) :
     partitionType_(NAVMESH_PARTITION_WATERSHED),
     keepInterResults_(false),
     drawOffMeshConnections_(false),
-    drawNavAreas_(false)
+    drawNavAreas_(false),
+    maxAsyncBuildTiles_(DEFAULT_MAX_ASYNC_BUILD_TILES),
+    pathIterationsPerFrame_(DEFAULT_PATH_ITERATIONS_PER_FRAME),
+    maxConcurrentPathRequests_(DEFAULT_MAX_CONCURRENT_PATH_REQUESTS)
 {
 }
 
@@ -157,6 +239,12 @@ void NavigationMesh::RegisterObject(Context* context)
         NAVMESH_PARTITION_WATERSHED, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Draw OffMeshConnections", GetDrawOffMeshConnections, SetDrawOffMeshConnections, bool, false, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Draw NavAreas", GetDrawNavAreas, SetDrawNavAreas, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max Async Build Tiles", GetMaxAsyncBuildTiles, SetMaxAsyncBuildTiles, unsigned,
+        DEFAULT_MAX_ASYNC_BUILD_TILES, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Path Iterations Per Frame", GetPathIterationsPerFrame, SetPathIterationsPerFrame, unsigned,
+        DEFAULT_PATH_ITERATIONS_PER_FRAME, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Max Concurrent Path Requests", GetMaxConcurrentPathRequests, SetMaxConcurrentPathRequests, unsigned,
+        DEFAULT_MAX_CONCURRENT_PATH_REQUESTS, AM_DEFAULT);
 }
 
 void NavigationMesh::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
@@ -493,6 +581,133 @@ bool NavigationMesh::Build(const IntVector2& from, const IntVector2& to)
     return true;
 }
 
+void NavigationMesh::BuildAsync(const BoundingBox& boundingBox)
+{
+    if (!node_ || !navMesh_)
+        return;
+
+    BoundingBox localSpaceBox = boundingBox.Transformed(node_->GetWorldTransform().Inverse());
+
+    float tileEdgeLength = (float)tileSize_ * cellSize_;
+
+    int sx = Clamp((int)((localSpaceBox.min_.x_ - boundingBox_.min_.x_) / tileEdgeLength), 0, numTilesX_ - 1);
+    int sz = Clamp((int)((localSpaceBox.min_.z_ - boundingBox_.min_.z_) / tileEdgeLength), 0, numTilesZ_ - 1);
+    int ex = Clamp((int)((localSpaceBox.max_.x_ - boundingBox_.min_.x_) / tileEdgeLength), 0, numTilesX_ - 1);
+    int ez = Clamp((int)((localSpaceBox.max_.z_ - boundingBox_.min_.z_) / tileEdgeLength), 0, numTilesZ_ - 1);
+
+    BuildAsync(IntVector2(sx, sz), IntVector2(ex, ez));
+}
+
+void NavigationMesh::BuildAsync(const IntVector2& from, const IntVector2& to)
+{
+    if (!node_)
+        return;
+
+    if (!navMesh_)
+    {
+        URHO3D_LOGERROR("Navigation mesh must first be built fully before it can be partially rebuilt");
+        return;
+    }
+
+    // Tiles in the ongoing batch are scheduled again, because their geometry snapshot may be outdated
+    for (int z = from.y_; z <= to.y_; ++z)
+    {
+        for (int x = from.x_; x <= to.x_; ++x)
+        {
+            const IntVector2 tile{x, z};
+            if (!asyncDirtyTiles_.contains(tile))
+                asyncDirtyTiles_.push_back(tile);
+        }
+    }
+
+    if (!asyncDirtyTiles_.empty())
+        SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(NavigationMesh, HandleEndFrame));
+}
+
+void NavigationMesh::CompleteAsyncBuild()
+{
+    auto* workQueue = GetSubsystem<WorkQueue>();
+    while (IsBuildingAsync())
+    {
+        if (asyncTask_ && workQueue)
+            workQueue->WaitForTask(asyncTask_);
+        UpdateAsyncBuild();
+    }
+}
+
+bool NavigationMesh::IsBuildingAsync() const
+{
+    return asyncBatch_ || !asyncDirtyTiles_.empty();
+}
+
+void NavigationMesh::UpdateAsyncBuild()
+{
+    // Wait until the ongoing batch is finished
+    if (asyncTask_ && !asyncTask_->IsCompleted())
+        return;
+
+    if (asyncBatch_)
+    {
+        URHO3D_PROFILE("CommitNavigationMeshTiles");
+
+        const unsigned numTiles = CommitTileBatch(*asyncBatch_);
+        URHO3D_LOGDEBUG("Rebuilt " + ea::to_string(numTiles) + " tiles of the navigation mesh asynchronously");
+
+        asyncBatch_ = nullptr;
+        asyncTask_ = nullptr;
+    }
+
+    if (asyncDirtyTiles_.empty() || !navMesh_ || !node_)
+    {
+        asyncDirtyTiles_.clear();
+        return;
+    }
+
+    // Take snapshot of the geometry for the next batch
+    const unsigned numTiles = Min(maxAsyncBuildTiles_, asyncDirtyTiles_.size());
+    const ea::vector<IntVector2> tiles(asyncDirtyTiles_.begin(), asyncDirtyTiles_.begin() + numTiles);
+    asyncDirtyTiles_.erase(asyncDirtyTiles_.begin(), asyncDirtyTiles_.begin() + numTiles);
+
+    ea::vector<NavigationGeometryInfo> geometryList;
+    CollectGeometries(geometryList);
+
+    asyncBatch_ = ea::make_unique<NavTileBuildBatch>();
+    PrepareTileBatch(*asyncBatch_, geometryList, tiles);
+
+    auto* workQueue = GetSubsystem<WorkQueue>();
+    if (workQueue && workQueue->GetNumThreads() > 0)
+    {
+        NavTileBuildBatch* batch = asyncBatch_.get();
+        asyncTask_ = workQueue->PostTask([this, batch](unsigned) { BuildTileBatch(*batch); });
+    }
+    else
+        BuildTileBatch(*asyncBatch_);
+}
+
+void NavigationMesh::CancelAsyncBuild()
+{
+    if (asyncTask_)
+    {
+        // Task uses the navigation mesh settings and the batch, wait for it
+        auto* workQueue = GetSubsystem<WorkQueue>();
+        if (workQueue)
+            workQueue->WaitForTask(asyncTask_);
+        asyncTask_ = nullptr;
+    }
+
+    asyncBatch_ = nullptr;
+    asyncDirtyTiles_.clear();
+}
+
+void NavigationMesh::HandleEndFrame(StringHash eventType, VariantMap& eventData)
+{
+    UpdateAsyncBuild();
+    UpdatePathRequests();
+
+    if (!IsBuildingAsync() && pathRequests_.empty())
+        UnsubscribeFromEvent(E_ENDFRAME);
+}
+
 ea::vector<unsigned char> NavigationMesh::GetTileData(const IntVector2& tile) const
 {
     VectorBuffer ret;
@@ -681,32 +896,159 @@ void NavigationMesh::FindPath(ea::vector<NavigationPathPoint>& dest, const Vecto
         NavigationPathPoint pt;
         pt.position_ = transform * pathData_->pathPoints_[i];
         pt.flag_ = (NavigationPathPointFlag)pathData_->pathFlags_[i];
+        pt.areaID_ = GetNavAreaID(pt.position_);
+
+        dest.push_back(pt);
+    }
+}
+
+void NavigationMesh::FindPathAsync(const Vector3& start, const Vector3& end, const NavigationPathCallback& callback,
+    const Vector3& extents, const dtQueryFilter* filter)
+{
+    if (!navMesh_ || !node_)
+    {
+        if (callback)
+            callback({});
+        return;
+    }
+
+    // Navigation data is in local space. Transform path points from world to local
+    const Matrix3x4 inverse = node_->GetWorldTransform().Inverse();
 
-        // Walk through all NavAreas and find nearest
-        unsigned nearestNavAreaID = 0;       // 0 is the default nav area ID
-        float nearestDistance = M_LARGE_VALUE;
-        for (unsigned j = 0; j < areas_.size(); j++)
+    auto request = ea::make_unique<NavigationPathRequest>();
+    request->start_ = inverse * start;
+    request->end_ = inverse * end;
+    request->extents_ = extents;
+    request->filter_ = filter ? filter : queryFilter_.get();
+    request->callback_ = callback;
+    pathRequests_.push_back(ea::move(request));
+
+    SubscribeToEvent(E_ENDFRAME, URHO3D_HANDLER(NavigationMesh, HandleEndFrame));
+}
+
+void NavigationMesh::UpdatePathRequests()
+{
+    if (pathRequests_.empty())
+        return;
+
+    if (!navMesh_ || !node_)
+    {
+        CancelPathRequests();
+        return;
+    }
+
+    URHO3D_PROFILE("UpdatePathRequests");
+
+    // Assign queries to the oldest requests, each query holds the state of one sliced search
+    unsigned numActiveRequests = 0;
+    for (const auto& request : pathRequests_)
+    {
+        if (numActiveRequests >= maxConcurrentPathRequests_)
+            break;
+
+        if (!request->query_)
         {
-            NavArea* area = areas_[j];
-            if (area && area->IsEnabledEffective())
+            if (!freePathQueries_.empty())
             {
-                BoundingBox bb = area->GetWorldBoundingBox();
-                if (bb.IsInside(pt.position_) == INSIDE)
+                request->query_ = freePathQueries_.back();
+                freePathQueries_.pop_back();
+            }
+            else
+            {
+                dtNavMeshQuery* query = dtAllocNavMeshQuery();
+                if (!query || dtStatusFailed(query->init(navMesh_, MAX_POLYS)))
                 {
-                    Vector3 areaWorldCenter = area->GetNode()->GetWorldPosition();
-                    float distance = (areaWorldCenter - pt.position_).LengthSquared();
-                    if (distance < nearestDistance)
-                    {
-                        nearestDistance = distance;
-                        nearestNavAreaID = area->GetAreaID();
-                    }
+                    URHO3D_LOGERROR("Could not create navigation mesh query");
+                    dtFreeNavMeshQuery(query);
+                    break;
                 }
+                request->query_ = query;
             }
         }
-        pt.areaID_ = (unsigned char)nearestNavAreaID;
+        ++numActiveRequests;
+    }
 
-        dest.push_back(pt);
+    const unsigned maxIterations = pathIterationsPerFrame_;
+    const auto updateRequests = [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+            UpdatePathRequest(*pathRequests_[i], maxIterations);
+    };
+
+    auto* workQueue = GetSubsystem<WorkQueue>();
+    if (workQueue && workQueue->GetNumThreads() > 0)
+        ForEachParallel(workQueue, 1, numActiveRequests, updateRequests);
+    else
+        updateRequests(0, numActiveRequests);
+
+    // Detach completed requests first, callbacks may add new requests
+    ea::vector<ea::unique_ptr<NavigationPathRequest>> completedRequests;
+    for (auto& request : pathRequests_)
+    {
+        if (request->completed_)
+        {
+            freePathQueries_.push_back(request->query_);
+            request->query_ = nullptr;
+            completedRequests.push_back(ea::move(request));
+        }
+    }
+    ea::erase_if(pathRequests_, [](const ea::unique_ptr<NavigationPathRequest>& request) { return !request; });
+
+    // Transform path results back to world space
+    const Matrix3x4& transform = node_->GetWorldTransform();
+    ea::vector<NavigationPathPoint> path;
+    for (const auto& request : completedRequests)
+    {
+        path.clear();
+        for (unsigned i = 0; i < request->pathPoints_.size(); ++i)
+        {
+            NavigationPathPoint pt;
+            pt.position_ = transform * request->pathPoints_[i];
+            pt.flag_ = (NavigationPathPointFlag)request->pathFlags_[i];
+            pt.areaID_ = GetNavAreaID(pt.position_);
+            path.push_back(pt);
+        }
+
+        if (request->callback_)
+            request->callback_(path);
+    }
+}
+
+void NavigationMesh::CancelPathRequests()
+{
+    for (const auto& request : pathRequests_)
+        dtFreeNavMeshQuery(request->query_);
+    pathRequests_.clear();
+
+    for (dtNavMeshQuery* query : freePathQueries_)
+        dtFreeNavMeshQuery(query);
+    freePathQueries_.clear();
+}
+
+unsigned char NavigationMesh::GetNavAreaID(const Vector3& worldPosition) const
+{
+    // Walk through all NavAreas and find nearest
+    unsigned nearestNavAreaID = 0;       // 0 is the default nav area ID
+    float nearestDistance = M_LARGE_VALUE;
+    for (unsigned j = 0; j < areas_.size(); j++)
+    {
+        NavArea* area = areas_[j];
+        if (area && area->IsEnabledEffective())
+        {
+            BoundingBox bb = area->GetWorldBoundingBox();
+            if (bb.IsInside(worldPosition) == INSIDE)
+            {
+                Vector3 areaWorldCenter = area->GetNode()->GetWorldPosition();
+                float distance = (areaWorldCenter - worldPosition).LengthSquared();
+                if (distance < nearestDistance)
+                {
+                    nearestDistance = distance;
+                    nearestNavAreaID = area->GetAreaID();
+                }
+            }
+        }
     }
+    return (unsigned char)nearestNavAreaID;
 }
 
 Vector3 NavigationMesh::GetRandomPoint(const dtQueryFilter* filter, dtPolyRef* randomRef)
@@ -1054,15 +1396,25 @@ void NavigationMesh::CollectGeometries(ea::vector<NavigationGeometryInfo>& geome
     }
 }
 
-void NavigationMesh::GetTileGeometry(NavBuildData* build, ea::vector<NavigationGeometryInfo>& geometryList, BoundingBox& box)
+void NavigationMesh::CollectGeometrySoup(NavGeometrySoup& soup, const ea::vector<NavigationGeometryInfo>& geometryList,
+    const IntVector2& from, const IntVector2& to)
 {
+    URHO3D_PROFILE("CollectNavigationGeometry");
+
+    const float tileEdgeLength = (float)tileSize_ * cellSize_;
+    const float tileBorder = (float)(CeilToInt(agentRadius_ / cellSize_) + 3) * cellSize_;
+    soup.Reset(boundingBox_.min_, tileEdgeLength, tileBorder, from, to);
+
     Matrix3x4 inverse = node_->GetWorldTransform().Inverse();
 
     for (unsigned i = 0; i < geometryList.size(); ++i)
     {
-        if (box.IsInsideFast(geometryList[i].boundingBox_) != OUTSIDE)
+        if (soup.IsInsideArea(geometryList[i].boundingBox_))
         {
             const Matrix3x4& transform = geometryList[i].transform_;
+            const BoundingBox& boundingBox = geometryList[i].boundingBox_;
+            const unsigned vertexStart = soup.vertices_.size();
+            const unsigned indexStart = soup.indices_.size();
 
             if (geometryList[i].component_->GetType() == OffMeshConnection::GetTypeStatic())
             {
@@ -1070,12 +1422,14 @@ void NavigationMesh::GetTileGeometry(NavBuildData* build, ea::vector<NavigationG
                 Vector3 start = inverse * connection->GetNode()->GetWorldPosition();
                 Vector3 end = inverse * connection->GetEndPoint()->GetWorldPosition();
 
-                build->offMeshVertices_.push_back(start);
-                build->offMeshVertices_.push_back(end);
-                build->offMeshRadii_.push_back(connection->GetRadius());
-                build->offMeshFlags_.push_back((unsigned short) connection->GetMask());
-                build->offMeshAreas_.push_back((unsigned char) connection->GetAreaID());
-                build->offMeshDir_.push_back((unsigned char) (connection->IsBidirectional() ? DT_OFFMESH_CON_BIDIR : 0));
+                NavOffMeshStub stub;
+                stub.start_ = start;
+                stub.end_ = end;
+                stub.radius_ = connection->GetRadius();
+                stub.flags_ = (unsigned short) connection->GetMask();
+                stub.areaID_ = (unsigned char) connection->GetAreaID();
+                stub.direction_ = (unsigned char) (connection->IsBidirectional() ? DT_OFFMESH_CON_BIDIR : 0);
+                soup.AddOffMeshConnection(boundingBox, stub);
                 continue;
             }
             else if (geometryList[i].component_->GetType() == NavArea::GetTypeStatic())
@@ -1084,7 +1438,7 @@ void NavigationMesh::GetTileGeometry(NavBuildData* build, ea::vector<NavigationG
                 NavAreaStub stub;
                 stub.areaID_ = (unsigned char)area->GetAreaID();
                 stub.bounds_ = area->GetWorldBoundingBox();
-                build->navAreas_.push_back(stub);
+                soup.AddNavArea(boundingBox, stub);
                 continue;
             }
 
@@ -1102,7 +1456,7 @@ void NavigationMesh::GetTileGeometry(NavBuildData* build, ea::vector<NavigationG
 
                         unsigned lodLevel = shape->GetLodLevel();
                         for (unsigned j = 0; j < model->GetNumGeometries(); ++j)
-                            AddTriMeshGeometry(build, model->GetGeometry(j, lodLevel), transform);
+                            AddTriMeshGeometry(soup, model->GetGeometry(j, lodLevel), transform);
                     }
                     break;
 
@@ -1114,28 +1468,28 @@ void NavigationMesh::GetTileGeometry(NavBuildData* build, ea::vector<NavigationG
 
                         unsigned numVertices = data->vertexCount_;
                         unsigned numIndices = data->indexCount_;
-                        unsigned destVertexStart = build->vertices_.size();
+                        unsigned destVertexStart = soup.vertices_.size();
 
                         for (unsigned j = 0; j < numVertices; ++j)
-                            build->vertices_.push_back(transform * data->vertexData_[j]);
+                            soup.vertices_.push_back(transform * data->vertexData_[j]);
 
                         for (unsigned j = 0; j < numIndices; ++j)
-                            build->indices_.push_back(data->indexData_[j] + destVertexStart);
+                            soup.indices_.push_back(data->indexData_[j] + destVertexStart);
                     }
                     break;
 
                 case SHAPE_BOX:
                     {
-                        unsigned destVertexStart = build->vertices_.size();
+                        unsigned destVertexStart = soup.vertices_.size();
 
-                        build->vertices_.push_back(transform * Vector3(-0.5f, 0.5f, -0.5f));
-                        build->vertices_.push_back(transform * Vector3(0.5f, 0.5f, -0.5f));
-                        build->vertices_.push_back(transform * Vector3(0.5f, -0.5f, -0.5f));
-                        build->vertices_.push_back(transform * Vector3(-0.5f, -0.5f, -0.5f));
-                        build->vertices_.push_back(transform * Vector3(-0.5f, 0.5f, 0.5f));
-                        build->vertices_.push_back(transform * Vector3(0.5f, 0.5f, 0.5f));
-                        build->vertices_.push_back(transform * Vector3(0.5f, -0.5f, 0.5f));
-                        build->vertices_.push_back(transform * Vector3(-0.5f, -0.5f, 0.5f));
+                        soup.vertices_.push_back(transform * Vector3(-0.5f, 0.5f, -0.5f));
+                        soup.vertices_.push_back(transform * Vector3(0.5f, 0.5f, -0.5f));
+                        soup.vertices_.push_back(transform * Vector3(0.5f, -0.5f, -0.5f));
+                        soup.vertices_.push_back(transform * Vector3(-0.5f, -0.5f, -0.5f));
+                        soup.vertices_.push_back(transform * Vector3(-0.5f, 0.5f, 0.5f));
+                        soup.vertices_.push_back(transform * Vector3(0.5f, 0.5f, 0.5f));
+                        soup.vertices_.push_back(transform * Vector3(0.5f, -0.5f, 0.5f));
+                        soup.vertices_.push_back(transform * Vector3(-0.5f, -0.5f, 0.5f));
 
                         const unsigned indices[] = {
                             0, 1, 2, 0, 2, 3, 1, 5, 6, 1, 6, 2, 4, 5, 1, 4, 1, 0, 5, 4, 7, 5, 7, 6,
@@ -1143,7 +1497,7 @@ void NavigationMesh::GetTileGeometry(NavBuildData* build, ea::vector<NavigationG
                         };
 
                         for (unsigned index : indices)
-                            build->indices_.push_back(index + destVertexStart);
+                            soup.indices_.push_back(index + destVertexStart);
                     }
                     break;
 
@@ -1151,6 +1505,7 @@ void NavigationMesh::GetTileGeometry(NavBuildData* build, ea::vector<NavigationG
                     break;
                 }
 
+                soup.AddTriangles(boundingBox, vertexStart, indexStart);
                 continue;
             }
 #endif
@@ -1160,13 +1515,15 @@ void NavigationMesh::GetTileGeometry(NavBuildData* build, ea::vector<NavigationG
                 const ea::vector<SourceBatch>& batches = drawable->GetBatches();
 
                 for (unsigned j = 0; j < batches.size(); ++j)
-                    AddTriMeshGeometry(build, drawable->GetLodGeometry(j, geometryList[i].lodLevel_), transform);
+                    AddTriMeshGeometry(soup, drawable->GetLodGeometry(j, geometryList[i].lodLevel_), transform);
+
+                soup.AddTriangles(boundingBox, vertexStart, indexStart);
             }
         }
     }
 }
 
-void NavigationMesh::AddTriMeshGeometry(NavBuildData* build, Geometry* geometry, const Matrix3x4& transform)
+void NavigationMesh::AddTriMeshGeometry(NavGeometrySoup& soup, Geometry* geometry, const Matrix3x4& transform)
 {
     if (!geometry)
         return;
@@ -1189,12 +1546,12 @@ void NavigationMesh::AddTriMeshGeometry(NavBuildData* build, Geometry* geometry,
     if (!srcIndexCount)
         return;
 
-    unsigned destVertexStart = build->vertices_.size();
+    unsigned destVertexStart = soup.vertices_.size();
 
     for (unsigned k = srcVertexStart; k < srcVertexStart + srcVertexCount; ++k)
     {
         Vector3 vertex = transform * *((const Vector3*)(&vertexData[k * vertexSize]));
-        build->vertices_.push_back(vertex);
+        soup.vertices_.push_back(vertex);
     }
 
     // Copy remapped indices
@@ -1205,7 +1562,7 @@ void NavigationMesh::AddTriMeshGeometry(NavBuildData* build, Geometry* geometry,
 
         while (indices < indicesEnd)
         {
-            build->indices_.push_back(*indices - srcVertexStart + destVertexStart);
+            soup.indices_.push_back(*indices - srcVertexStart + destVertexStart);
             ++indices;
         }
     }
@@ -1216,7 +1573,7 @@ void NavigationMesh::AddTriMeshGeometry(NavBuildData* build, Geometry* geometry,
 
         while (indices < indicesEnd)
         {
-            build->indices_.push_back(*indices - srcVertexStart + destVertexStart);
+            soup.indices_.push_back(*indices - srcVertexStart + destVertexStart);
             ++indices;
         }
     }
@@ -1271,13 +1628,12 @@ bool NavigationMesh::ReadTile(Deserializer& source, bool silent)
     return true;
 }
 
-bool NavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometryList, int x, int z)
+bool NavigationMesh::BuildTileData(const NavGeometrySoup& soup, NavTileBuildResult& result) const
 {
     URHO3D_PROFILE("BuildNavigationMeshTile");
 
-    // Remove previous tile (if any)
-    navMesh_->removeTile(navMesh_->getTileRefAt(x, z, 0), nullptr, nullptr);
-
+    const int x = result.tile_.x_;
+    const int z = result.tile_.y_;
     const BoundingBox tileBoundingBox = GetTileBoundingBox(IntVector2(x, z));
 
     SimpleNavBuildData build;
@@ -1310,7 +1666,7 @@ bool NavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometryList,
     cfg.bmax[2] += cfg.borderSize * cfg.cs;
 
     BoundingBox expandedBox(*reinterpret_cast<Vector3*>(cfg.bmin), *reinterpret_cast<Vector3*>(cfg.bmax));
-    GetTileGeometry(&build, geometryList, expandedBox);
+    soup.GetTileGeometry(&build, IntVector2(x, z), expandedBox);
 
     if (build.vertices_.empty() || build.indices_.empty())
         return true; // Nothing to do
@@ -1434,9 +1790,6 @@ bool NavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometryList,
             build.polyMesh_->flags[i] = 0x1;
     }
 
-    unsigned char* navData = nullptr;
-    int navDataSize = 0;
-
     dtNavMeshCreateParams params;       // NOLINT(hicpp-member-init)
     memset(&params, 0, sizeof params);
     params.verts = build.polyMesh_->verts;
@@ -1473,12 +1826,31 @@ bool NavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometryList,
         params.offMeshConDir = &build.offMeshDir_[0];
     }
 
+    unsigned char* navData = nullptr;
+    int navDataSize = 0;
+
     if (!dtCreateNavMeshData(&params, &navData, &navDataSize))
     {
         URHO3D_LOGERROR("Could not build navigation mesh tile data");
         return false;
     }
 
+    result.data_.emplace_back(navData, navDataSize);
+    return true;
+}
+
+bool NavigationMesh::CommitTile(NavTileBuildResult& result)
+{
+    // Remove previous tile (if any)
+    navMesh_->removeTile(navMesh_->getTileRefAt(result.tile_.x_, result.tile_.y_, 0), nullptr, nullptr);
+
+    if (!result.success_ || result.data_.empty())
+        return result.success_;
+
+    unsigned char* navData = result.data_[0].first;
+    const int navDataSize = result.data_[0].second;
+    result.data_.clear();
+
     if (dtStatusFailed(navMesh_->addTile(navData, navDataSize, DT_TILE_FREE_DATA, 0, nullptr)))
     {
         URHO3D_LOGERROR("Failed to add navigation mesh tile");
@@ -1486,32 +1858,87 @@ bool NavigationMesh::BuildTile(ea::vector<NavigationGeometryInfo>& geometryList,
         return false;
     }
 
-    // Send a notification of the rebuild of this tile to anyone interested
+    SendTileRebuiltEvent(result.tile_);
+    return true;
+}
+
+void NavigationMesh::SendTileRebuiltEvent(const IntVector2& tile)
+{
+    const BoundingBox tileBoundingBox = GetTileBoundingBox(tile);
+
+    using namespace NavigationAreaRebuilt;
+    VariantMap& eventData = GetContext()->GetEventDataMap();
+    eventData[P_NODE] = GetNode();
+    eventData[P_MESH] = this;
+    eventData[P_BOUNDSMIN] = Variant(tileBoundingBox.min_);
+    eventData[P_BOUNDSMAX] = Variant(tileBoundingBox.max_);
+    SendEvent(E_NAVIGATION_AREA_REBUILT, eventData);
+}
+
+void NavigationMesh::PrepareTileBatch(NavTileBuildBatch& batch, const ea::vector<NavigationGeometryInfo>& geometryList,
+    const ea::vector<IntVector2>& tiles)
+{
+    if (tiles.empty())
+        return;
+
+    IntVector2 from = tiles[0];
+    IntVector2 to = tiles[0];
+    batch.results_.resize(tiles.size());
+    for (unsigned i = 0; i < tiles.size(); ++i)
     {
-        using namespace NavigationAreaRebuilt;
-        VariantMap& eventData = GetContext()->GetEventDataMap();
-        eventData[P_NODE] = GetNode();
-        eventData[P_MESH] = this;
-        eventData[P_BOUNDSMIN] = Variant(tileBoundingBox.min_);
-        eventData[P_BOUNDSMAX] = Variant(tileBoundingBox.max_);
-        SendEvent(E_NAVIGATION_AREA_REBUILT, eventData);
+        batch.results_[i].tile_ = tiles[i];
+        from = VectorMin(from, tiles[i]);
+        to = VectorMax(to, tiles[i]);
     }
-    return true;
+
+    CollectGeometrySoup(batch.soup_, geometryList, from, to);
 }
 
-unsigned NavigationMesh::BuildTiles(ea::vector<NavigationGeometryInfo>& geometryList, const IntVector2& from, const IntVector2& to)
+void NavigationMesh::BuildTileBatch(NavTileBuildBatch& batch) const
+{
+    const auto buildTiles = [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            NavTileBuildResult& result = batch.results_[i];
+            result.success_ = BuildTileData(batch.soup_, result);
+        }
+    };
+
+    const unsigned numTiles = batch.results_.size();
+    auto* workQueue = GetSubsystem<WorkQueue>();
+    if (workQueue && workQueue->GetNumThreads() > 0)
+        ForEachParallel(workQueue, 1, numTiles, buildTiles);
+    else
+        buildTiles(0, numTiles);
+}
+
+unsigned NavigationMesh::CommitTileBatch(NavTileBuildBatch& batch)
 {
     unsigned numTiles = 0;
+    for (NavTileBuildResult& result : batch.results_)
+    {
+        if (CommitTile(result))
+            ++numTiles;
+    }
+    return numTiles;
+}
 
+unsigned NavigationMesh::BuildTiles(ea::vector<NavigationGeometryInfo>& geometryList, const IntVector2& from, const IntVector2& to)
+{
+    ea::vector<IntVector2> tiles;
     for (int z = from.y_; z <= to.y_; ++z)
     {
         for (int x = from.x_; x <= to.x_; ++x)
-        {
-            if (BuildTile(geometryList, x, z))
-                ++numTiles;
-        }
+            tiles.emplace_back(x, z);
     }
-    return numTiles;
+
+    // Extract geometry on the main thread once, then build tiles in parallel.
+    // Detour navigation mesh is not thread-safe, so tiles are added on the main thread
+    NavTileBuildBatch batch;
+    PrepareTileBatch(batch, geometryList, tiles);
+    BuildTileBatch(batch);
+    return CommitTileBatch(batch);
 }
 
 bool NavigationMesh::InitializeQuery()
@@ -1540,6 +1967,9 @@ bool NavigationMesh::InitializeQuery()
 
 void NavigationMesh::ReleaseNavigationMesh()
 {
+    CancelAsyncBuild();
+    CancelPathRequests();
+
     dtFreeNavMesh(navMesh_);
     navMesh_ = nullptr;
 
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <EASTL/functional.h>
 #include <EASTL/unique_ptr.h>
 #include <EASTL/unordered_set.h>
 
@@ -52,9 +53,14 @@ enum NavmeshPartitionType
 
 class Geometry;
 class NavArea;
+class WorkTask;
 
 struct FindPathData;
+struct NavigationPathRequest;
 struct NavBuildData;
+struct NavGeometrySoup;
+struct NavTileBuildBatch;
+struct NavTileBuildResult;
 
 /// Description of a navigation mesh geometry component, with transform and bounds information.
 struct NavigationGeometryInfo
@@ -89,6 +95,9 @@ struct URHO3D_API NavigationPathPoint
     unsigned char areaID_;
 };
 
+/// Callback of asynchronous path request, invoked from the main thread. Path is empty if not found.
+using NavigationPathCallback = ea::function<void(const ea::vector<NavigationPathPoint>& path)>;
+
 /// Navigation mesh component. Collects the navigation geometry from child nodes with the Navigable component and responds to path queries.
 class URHO3D_API NavigationMesh : public Component
 {
@@ -160,6 +169,21 @@ public:
     virtual bool Build(const BoundingBox& boundingBox);
     /// Rebuild part of the navigation mesh in the rectangular area. Return true if successful.
     virtual bool Build(const IntVector2& from, const IntVector2& to);
+    /// Schedule asynchronous rebuild of the part of the navigation mesh contained by the world-space bounding box.
+    /// Tiles are built on worker threads from a geometry snapshot and added to the navigation mesh at the end of a frame.
+    void BuildAsync(const BoundingBox& boundingBox);
+    /// Schedule asynchronous rebuild of the part of the navigation mesh in the rectangular area.
+    void BuildAsync(const IntVector2& from, const IntVector2& to);
+    /// Wait for scheduled asynchronous rebuilds and apply them immediately.
+    void CompleteAsyncBuild();
+    /// Return whether there are scheduled or ongoing asynchronous rebuilds.
+    bool IsBuildingAsync() const;
+    /// Set max number of tiles rebuilt in one asynchronous batch.
+    /// @property
+    void SetMaxAsyncBuildTiles(unsigned maxTiles) { maxAsyncBuildTiles_ = Max(maxTiles, 1u); }
+    /// Return max number of tiles rebuilt in one asynchronous batch.
+    /// @property
+    unsigned GetMaxAsyncBuildTiles() const { return maxAsyncBuildTiles_; }
     /// Return tile data.
     virtual ea::vector<unsigned char> GetTileData(const IntVector2& tile) const;
     /// Add tile to navigation mesh.
@@ -187,6 +211,26 @@ public:
     void FindPath
         (ea::vector<NavigationPathPoint>& dest, const Vector3& start, const Vector3& end, const Vector3& extents = Vector3::ONE,
             const dtQueryFilter* filter = nullptr);
+    /// Request a path between world space points asynchronously. Requests are processed in parallel at the end of the frame
+    /// with sliced pathfinding, the callback is invoked when the path is found. Filter must be kept alive until then.
+    /// Pending requests are discarded without invoking callbacks if the navigation mesh is released.
+    /// @nobind
+    void FindPathAsync(const Vector3& start, const Vector3& end, const NavigationPathCallback& callback,
+        const Vector3& extents = Vector3::ONE, const dtQueryFilter* filter = nullptr);
+    /// Return number of pending asynchronous path requests.
+    unsigned GetNumPathRequests() const { return pathRequests_.size(); }
+    /// Set max number of pathfinding iterations per asynchronous path request per frame.
+    /// @property
+    void SetPathIterationsPerFrame(unsigned iterations) { pathIterationsPerFrame_ = Max(iterations, 1u); }
+    /// Return max number of pathfinding iterations per asynchronous path request per frame.
+    /// @property
+    unsigned GetPathIterationsPerFrame() const { return pathIterationsPerFrame_; }
+    /// Set max number of asynchronous path requests processed concurrently. Each one holds a navigation mesh query.
+    /// @property
+    void SetMaxConcurrentPathRequests(unsigned maxRequests) { maxConcurrentPathRequests_ = Max(maxRequests, 1u); }
+    /// Return max number of asynchronous path requests processed concurrently.
+    /// @property
+    unsigned GetMaxConcurrentPathRequests() const { return maxConcurrentPathRequests_; }
     /// Return a random point on the navigation mesh.
     Vector3 GetRandomPoint(const dtQueryFilter* filter = nullptr, dtPolyRef* randomRef = nullptr);
     /// Return a random point on the navigation mesh within a circle. The circle radius is only a guideline and in practice the returned point may be further away.
@@ -325,14 +369,38 @@ protected:
     void CollectGeometries(ea::vector<NavigationGeometryInfo>& geometryList);
     /// Visit nodes and collect navigable geometry.
     void CollectGeometries(ea::vector<NavigationGeometryInfo>& geometryList, Node* node, ea::hash_set<Node*>& processedNodes, bool recursive);
-    /// Get geometry data within a bounding box.
-    void GetTileGeometry(NavBuildData* build, ea::vector<NavigationGeometryInfo>& geometryList, BoundingBox& box);
-    /// Add a triangle mesh to the geometry data.
-    void AddTriMeshGeometry(NavBuildData* build, Geometry* geometry, const Matrix3x4& transform);
-    /// Build one tile of the navigation mesh. Return true if successful.
-    virtual bool BuildTile(ea::vector<NavigationGeometryInfo>& geometryList, int x, int z);
-    /// Build tiles in the rectangular area. Return number of built tiles.
+    /// Extract geometry data overlapping the rectangular tile area into the soup. Should be called from the main thread.
+    void CollectGeometrySoup(NavGeometrySoup& soup, const ea::vector<NavigationGeometryInfo>& geometryList,
+        const IntVector2& from, const IntVector2& to);
+    /// Add a triangle mesh to the geometry soup.
+    void AddTriMeshGeometry(NavGeometrySoup& soup, Geometry* geometry, const Matrix3x4& transform);
+    /// Build data of one tile of the navigation mesh. Safe to call from worker threads. Return true if successful.
+    virtual bool BuildTileData(const NavGeometrySoup& soup, NavTileBuildResult& result) const;
+    /// Replace the tile in the navigation mesh with the built one. Return true if successful.
+    virtual bool CommitTile(NavTileBuildResult& result);
+    /// Send rebuild notification for the tile.
+    void SendTileRebuiltEvent(const IntVector2& tile);
+    /// Prepare batch of tiles and collect its geometry. Should be called from the main thread.
+    void PrepareTileBatch(NavTileBuildBatch& batch, const ea::vector<NavigationGeometryInfo>& geometryList,
+        const ea::vector<IntVector2>& tiles);
+    /// Build data of all tiles in the batch in parallel. Safe to call from worker threads.
+    void BuildTileBatch(NavTileBuildBatch& batch) const;
+    /// Add all tiles of the batch to the navigation mesh. Return number of built tiles.
+    unsigned CommitTileBatch(NavTileBuildBatch& batch);
+    /// Build tiles in the rectangular area in parallel and add them to the navigation mesh. Return number of built tiles.
     unsigned BuildTiles(ea::vector<NavigationGeometryInfo>& geometryList, const IntVector2& from, const IntVector2& to);
+    /// Apply finished asynchronous batch and start the next one.
+    void UpdateAsyncBuild();
+    /// Wait for the ongoing asynchronous batch and discard it, along with scheduled rebuilds.
+    void CancelAsyncBuild();
+    /// Advance pending asynchronous path requests and invoke callbacks of completed ones.
+    void UpdatePathRequests();
+    /// Discard pending asynchronous path requests and release navigation mesh queries used by them.
+    void CancelPathRequests();
+    /// Return ID of the nearest enabled navigation area containing the world space point, or 0 if none.
+    unsigned char GetNavAreaID(const Vector3& worldPosition) const;
+    /// Handle end of frame.
+    void HandleEndFrame(StringHash eventType, VariantMap& eventData);
     /// Ensure that the navigation mesh query is initialized. Return true if successful.
     bool InitializeQuery();
     /// Release the navigation mesh and the query.
@@ -392,6 +460,22 @@ protected:
     bool drawNavAreas_;
     /// NavAreas for this NavMesh.
     ea::vector<WeakPtr<NavArea> > areas_;
+    /// Max number of tiles rebuilt in one asynchronous batch.
+    unsigned maxAsyncBuildTiles_;
+    /// Tiles scheduled for asynchronous rebuild.
+    ea::vector<IntVector2> asyncDirtyTiles_;
+    /// Asynchronous batch being built.
+    ea::unique_ptr<NavTileBuildBatch> asyncBatch_;
+    /// Task building the asynchronous batch.
+    SharedPtr<WorkTask> asyncTask_;
+    /// Max number of pathfinding iterations per asynchronous path request per frame.
+    unsigned pathIterationsPerFrame_;
+    /// Max number of asynchronous path requests processed concurrently.
+    unsigned maxConcurrentPathRequests_;
+    /// Pending asynchronous path requests.
+    ea::vector<ea::unique_ptr<NavigationPathRequest>> pathRequests_;
+    /// Navigation mesh queries not used by path requests.
+    ea::vector<dtNavMeshQuery*> freePathQueries_;
 };
 
 /// Register Navigation library objects.
@@ -56,10 +56,27 @@
 namespace Urho3D
 {
 
+namespace
+{
+
+PacketReliability GetPacketReliability(PacketType type)
+{
+    switch (type)
+    {
+    case PT_RELIABLE_ORDERED: return PacketReliability::RELIABLE_ORDERED;
+    case PT_RELIABLE_UNORDERED: return PacketReliability::RELIABLE;
+    case PT_UNRELIABLE_ORDERED: return PacketReliability::UNRELIABLE_SEQUENCED;
+    default: return PacketReliability::UNRELIABLE;
+    }
+}
+
+}
+
 static const int STATS_INTERVAL_MSEC = 2000;
 
 PackageDownload::PackageDownload() :
     totalFragments_(0),
+    resumedFragments_(0),
     checksum_(0),
     initiated_(false)
 {
@@ -79,7 +96,9 @@ Connection::Connection(Context* context) :
     sceneLoaded_(false),
     logStatistics_(false),
     address_(nullptr),
-    packedMessageLimit_(1024)
+    packedMessageLimit_(1024),
+    bytesSentMetric_(GetMetricCounter(context, "urho3d_network_bytes_sent_total", "Number of bytes sent over network")),
+    packetsSentMetric_(GetMetricCounter(context, "urho3d_network_packets_sent_total", "Number of packets sent over network"))
 {
 }
 
@@ -138,6 +157,13 @@ void Connection::SendMessageInternal(NetworkMessageId messageId, bool reliable,
     if (buffer.GetSize() + numBytes >= packedMessageLimit_)
         SendBuffer(type);
 
+    // Large message would be sent alone anyway, send it from caller memory without copying into the buffer
+    if (numBytes >= packedMessageLimit_)
+    {
+        SendUnbufferedMessage(type, messageId, data, numBytes);
+        return;
+    }
+
     if (buffer.GetSize() == 0)
     {
         buffer.WriteUByte((unsigned char)DefaultMessageIDTypes::ID_USER_PACKET_ENUM);
@@ -265,26 +291,37 @@ void Connection::SendRemoteEvents()
 
 void Connection::SendPackages()
 {
-    while (!uploads_.empty())
-    {
-        unsigned char buffer[PACKAGE_FRAGMENT_SIZE];
+    if (uploads_.empty())
+        return;
 
+    // Keep only limited amount of package data in flight so other messages are not stalled behind it
+    const unsigned bytesInSendBuffer = GetNumBytesInSendBuffer();
+    if (bytesInSendBuffer >= PACKAGE_SEND_WINDOW_SIZE)
+        return;
+
+    const unsigned maxBytesToSend = PACKAGE_SEND_WINDOW_SIZE - bytesInSendBuffer;
+    unsigned bytesSent = 0;
+    ea::vector<unsigned char> buffer(PACKAGE_FRAGMENT_SIZE);
+
+    while (!uploads_.empty() && bytesSent < maxBytesToSend)
+    {
         for (auto i = uploads_.begin(); i != uploads_.end();)
         {
             auto current = i++;
             PackageUpload& upload = current->second;
             auto fragmentSize =
                 (unsigned)Min((int)(upload.file_->GetSize() - upload.file_->GetPosition()), (int)PACKAGE_FRAGMENT_SIZE);
-            upload.file_->Read(buffer, fragmentSize);
+            upload.file_->Read(buffer.data(), fragmentSize);
 
             msg_.Clear();
             msg_.WriteStringHash(current->first);
             msg_.WriteUInt(upload.fragment_++);
-            msg_.Write(buffer, fragmentSize);
-            SendMessage(MSG_PACKAGEDATA, true, false, msg_);
+            msg_.Write(buffer.data(), fragmentSize);
+            SendMessage(MSG_PACKAGEDATA, true, true, msg_);
+            bytesSent += fragmentSize;
 
             // Check if upload finished
-            if (upload.fragment_ == upload.totalFragments_)
+            if (upload.fragment_ >= upload.totalFragments_)
                 uploads_.erase(current);
         }
     }
@@ -296,25 +333,38 @@ void Connection::SendBuffer(PacketType type)
     if (buffer.GetSize() == 0)
         return;
 
-    PacketReliability reliability = PacketReliability::UNRELIABLE;
-    if (type == PT_UNRELIABLE_ORDERED)
-        reliability = PacketReliability::UNRELIABLE_SEQUENCED;
-
-    if (type == PT_RELIABLE_ORDERED)
-        reliability = PacketReliability::RELIABLE_ORDERED;
-
-    if (type == PT_RELIABLE_UNORDERED)
-        reliability = PacketReliability::RELIABLE;
-
     if (peer_) {
-        peer_->Send((const char *) buffer.GetData(), (int) buffer.GetSize(), HIGH_PRIORITY, reliability, (char) 0,
-                    *address_, false);
+        peer_->Send((const char *) buffer.GetData(), (int) buffer.GetSize(), HIGH_PRIORITY, GetPacketReliability(type),
+                    (char) 0, *address_, false);
         tempPacketCounter_.y_++;
+        bytesSentMetric_->Increment(buffer.GetSize());
+        packetsSentMetric_->Increment();
     }
 
     buffer.Clear();
 }
 
+void Connection::SendUnbufferedMessage(PacketType type, NetworkMessageId messageId, const unsigned char* data, unsigned numBytes)
+{
+    if (!peer_)
+        return;
+
+    // Header is identical to packed message with single entry, so the receiver doesn't need to know the difference
+    unsigned char header[1 + 3 * sizeof(unsigned)];
+    MemoryBuffer headerBuffer(header, sizeof(header));
+    headerBuffer.WriteUByte((unsigned char)DefaultMessageIDTypes::ID_USER_PACKET_ENUM);
+    headerBuffer.WriteUInt((unsigned int)MSG_PACKED_MESSAGE);
+    headerBuffer.WriteUInt((unsigned int)messageId);
+    headerBuffer.WriteUInt(numBytes);
+
+    const char* parts[] = {reinterpret_cast<const char*>(header), reinterpret_cast<const char*>(data)};
+    const int lengths[] = {static_cast<int>(sizeof(header)), static_cast<int>(numBytes)};
+    peer_->SendList(parts, lengths, 2, HIGH_PRIORITY, GetPacketReliability(type), (char) 0, *address_, false);
+    tempPacketCounter_.y_++;
+    bytesSentMetric_->Increment(sizeof(header) + numBytes);
+    packetsSentMetric_->Increment();
+}
+
 void Connection::SendAllBuffers()
 {
     // Send clock messages at the last time to have better precision
@@ -486,6 +536,8 @@ void Connection::ProcessPackageDownload(int msgID, MemoryBuffer& msg)
         else
         {
             ea::string name = msg.ReadString();
+            // Older clients don't send the fragment to resume from
+            const unsigned startFragment = msg.IsEof() ? 0 : msg.ReadUInt();
 
             if (!scene_)
             {
@@ -519,11 +571,26 @@ void Connection::ProcessPackageDownload(int msgID, MemoryBuffer& msg)
                         return;
                     }
 
-                    URHO3D_LOGINFO("Transmitting package file " + name + " to client " + ToString());
+                    const unsigned totalFragments = (file->GetSize() + PACKAGE_FRAGMENT_SIZE - 1) / PACKAGE_FRAGMENT_SIZE;
+                    if (startFragment > 0 && startFragment >= totalFragments)
+                    {
+                        URHO3D_LOGERROR("Client requested package file " + name + " from invalid fragment");
+                        SendPackageError(name);
+                        return;
+                    }
+
+                    if (startFragment > 0)
+                    {
+                        URHO3D_LOGINFO("Resuming transmission of package file {} to client {} from fragment {}", name,
+                            ToString(), startFragment);
+                    }
+                    else
+                        URHO3D_LOGINFO("Transmitting package file " + name + " to client " + ToString());
 
+                    file->Seek(startFragment * PACKAGE_FRAGMENT_SIZE);
                     uploads_[nameHash].file_ = file;
-                    uploads_[nameHash].fragment_ = 0;
-                    uploads_[nameHash].totalFragments_ = (file->GetSize() + PACKAGE_FRAGMENT_SIZE - 1) / PACKAGE_FRAGMENT_SIZE;
+                    uploads_[nameHash].fragment_ = startFragment;
+                    uploads_[nameHash].totalFragments_ = totalFragments;
                     return;
                 }
             }
@@ -599,12 +666,7 @@ void Connection::ProcessPackageDownload(int msgID, MemoryBuffer& msg)
                 else
                 {
                     PackageDownload& nextDownload = downloads_.begin()->second;
-
-                    URHO3D_LOGINFO("Requesting package " + nextDownload.name_ + " from server");
-                    msg_.Clear();
-                    msg_.WriteString(nextDownload.name_);
-                    SendMessage(MSG_REQUESTPACKAGE, true, true, msg_);
-                    nextDownload.initiated_ = true;
+                    SendPackageRequest(nextDownload);
                 }
             }
         }
@@ -934,13 +996,55 @@ void Connection::RequestPackage(const ea::string& name, unsigned fileSize, unsig
 
     // Start download now only if no existing downloads, else wait for the existing ones to finish
     if (downloads_.size() == 1)
+        SendPackageRequest(download);
+}
+
+void Connection::SendPackageRequest(PackageDownload& download)
+{
+    // Fragments are delivered in order, so partial file from interrupted download contains only complete fragments
+    download.resumedFragments_ = 0;
+    const ea::string partialFileName = GetPackageCacheFileName(download) + ".part";
+    auto fileSystem = GetSubsystem<FileSystem>();
+    if (fileSystem->FileExists(partialFileName))
     {
-        URHO3D_LOGINFO("Requesting package " + name + " from server");
-        msg_.Clear();
-        msg_.WriteString(name);
-        SendMessage(MSG_REQUESTPACKAGE, true, true, msg_);
-        download.initiated_ = true;
+        File partialFile(context_, partialFileName);
+        if (partialFile.IsOpen() && download.totalFragments_ > 0)
+        {
+            const unsigned completeFragments = partialFile.GetSize() / PACKAGE_FRAGMENT_SIZE;
+            download.resumedFragments_ = Min(completeFragments, download.totalFragments_ - 1);
+        }
     }
+
+    if (download.resumedFragments_ > 0)
+    {
+        URHO3D_LOGINFO(
+            "Resuming download of package {} from server at fragment {}", download.name_, download.resumedFragments_);
+    }
+    else
+        URHO3D_LOGINFO("Requesting package " + download.name_ + " from server");
+
+    msg_.Clear();
+    msg_.WriteString(download.name_);
+    msg_.WriteUInt(download.resumedFragments_);
+    SendMessage(MSG_REQUESTPACKAGE, true, true, msg_);
+    download.initiated_ = true;
+}
+
+ea::string Connection::GetPackageCacheFileName(const PackageDownload& download) const
+{
+    // Prepend the checksum to the filename to allow multiple versions
+    return GetSubsystem<Network>()->GetPackageCacheDir() + ToStringHex(download.checksum_) + "_" + download.name_;
+}
+
+unsigned Connection::GetNumBytesInSendBuffer() const
+{
+    if (peer_)
+    {
+        SLNet::RakNetStatistics stats{};
+        if (peer_->GetStatistics(address_->systemAddress, &stats))
+            return static_cast<unsigned>(stats.bytesInSendBuffer[HIGH_PRIORITY]);
+    }
+    return 0;
 }
 
 void Connection::SendPackageError(const ea::string& name)
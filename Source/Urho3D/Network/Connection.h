@@ -26,6 +26,7 @@
 
 #include <EASTL/hash_set.h>
 
+#include "../Core/Metrics.h"
 #include "../Core/Object.h"
 #include "../Core/Timer.h"
 #include "../IO/VectorBuffer.h"
@@ -78,6 +79,8 @@ struct PackageDownload
     ea::string name_;
     /// Total number of fragments.
     unsigned totalFragments_;
+    /// Number of fragments received before the download was resumed.
+    unsigned resumedFragments_;
     /// Checksum.
     unsigned checksum_;
     /// Download initiated flag.
@@ -152,6 +155,8 @@ public:
     void SendBuffer(PacketType type);
     /// Send out all buffered messages
     void SendAllBuffers();
+    /// Send message immediately without copying it into the buffer. Buffered messages of the same type should be sent first.
+    void SendUnbufferedMessage(PacketType type, NetworkMessageId messageId, const unsigned char* data, unsigned numBytes);
     /// Process a message from the server or client. Called by Network.
     bool ProcessMessage(int msgID, MemoryBuffer& buffer);
     /// Ban this connections IP address.
@@ -258,6 +263,12 @@ private:
     bool RequestNeededPackages(unsigned numPackages, MemoryBuffer& msg);
     /// Initiate a package download.
     void RequestPackage(const ea::string& name, unsigned fileSize, unsigned checksum);
+    /// Send a package request to the server. Resume from partially downloaded file if any.
+    void SendPackageRequest(PackageDownload& download);
+    /// Return file name of downloaded package in the package cache.
+    ea::string GetPackageCacheFileName(const PackageDownload& download) const;
+    /// Return number of bytes waiting in the send buffer of the connection.
+    unsigned GetNumBytesInSendBuffer() const;
     /// Send an error reply for a package download.
     void SendPackageError(const ea::string& name);
     /// Handle scene load failure on the server or client.
@@ -308,6 +319,10 @@ private:
     ea::unordered_map<int, VectorBuffer> outgoingBuffer_;
     /// Outgoing packet size limit
     int packedMessageLimit_;
+    /// Number of bytes sent by all connections.
+    SharedPtr<MetricCounter> bytesSentMetric_;
+    /// Number of packets sent by all connections.
+    SharedPtr<MetricCounter> packetsSentMetric_;
 };
 
 }
@@ -25,6 +25,7 @@
 #include "../Core/Profiler.h"
 #include "../Core/Timer.h"
 #include "../IO/Log.h"
+#include "../IO/Serializer.h"
 #include "../Network/HttpRequest.h"
 
 #include <Civetweb/civetweb.h>
@@ -37,7 +38,8 @@ namespace Urho3D
 static const unsigned ERROR_BUFFER_SIZE = 256;
 static const unsigned READ_BUFFER_SIZE = 65536; // Must be a power of two
 
-HttpRequest::HttpRequest(const ea::string& url, const ea::string& verb, const ea::vector<ea::string>& headers, const ea::string& postData) :
+HttpRequest::HttpRequest(const ea::string& url, const ea::string& verb, const ea::vector<ea::string>& headers,
+    const ea::string& postData, Serializer* destination, bool start) :
     url_(url.trimmed()),
     verb_(!verb.empty() ? verb : "GET"),
     headers_(headers),
@@ -46,7 +48,8 @@ HttpRequest::HttpRequest(const ea::string& url, const ea::string& verb, const ea
     httpReadBuffer_(new unsigned char[READ_BUFFER_SIZE]),
     readBuffer_(new unsigned char[READ_BUFFER_SIZE]),
     readPosition_(0),
-    writePosition_(0)
+    writePosition_(0),
+    destination_(destination)
 {
     // Size of response is unknown, so just set maximum value. The position will also be changed
     // to maximum value once the request is done, signaling end for Deserializer::IsEof().
@@ -63,6 +66,15 @@ HttpRequest::HttpRequest(const ea::string& url, const ea::string& verb, const ea
     }
 #endif
 
+    if (start)
+        Start();
+}
+
+void HttpRequest::Start()
+{
+    if (IsStarted())
+        return;
+
 #ifdef URHO3D_THREADING
     // Start the worker thread to actually create the connection and read the response data.
     Run();
@@ -163,6 +175,23 @@ void HttpRequest::ThreadFunction()
         if (bytesRead <= 0)
             break;
 
+        bytesReceived_.fetch_add(static_cast<unsigned>(bytesRead), std::memory_order_relaxed);
+
+        // Stream directly into the destination, skipping the main thread buffer
+        if (destination_)
+        {
+            const auto numBytes = static_cast<unsigned>(bytesRead);
+            if (destination_->Write(httpReadBuffer_.get(), numBytes) != numBytes)
+            {
+                MutexLock lock(mutex_);
+                error_ = "Failed to write response data";
+                state_ = HTTP_ERROR;
+                mg_close_connection(connection);
+                return;
+            }
+            continue;
+        }
+
         mutex_.Acquire();
 
         // Wait until enough space in the main thread's ring buffer
@@ -293,6 +322,12 @@ HttpRequestState HttpRequest::GetState() const
     return state_;
 }
 
+bool HttpRequest::IsFinished() const
+{
+    const HttpRequestState state = GetState();
+    return state == HTTP_ERROR || state == HTTP_CLOSED;
+}
+
 unsigned HttpRequest::GetAvailableSize() const
 {
     MutexLock lock(mutex_);
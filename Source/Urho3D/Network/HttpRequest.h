@@ -31,9 +31,13 @@
 #include "../Core/Thread.h"
 #include "../IO/Deserializer.h"
 
+#include <atomic>
+
 namespace Urho3D
 {
 
+class Serializer;
+
 /// HTTP connection state.
 enum HttpRequestState
 {
@@ -47,11 +51,15 @@ enum HttpRequestState
 class URHO3D_API HttpRequest : public RefCounted, public Deserializer, public Thread
 {
 public:
-    /// Construct with parameters.
-    HttpRequest(const ea::string& url, const ea::string& verb, const ea::vector<ea::string>& headers, const ea::string& postData);
+    /// Construct with parameters. If destination is specified, response data is written directly into it from the
+    /// worker thread instead of being buffered for Read. If start is false, the request waits for Start call.
+    HttpRequest(const ea::string& url, const ea::string& verb, const ea::vector<ea::string>& headers,
+        const ea::string& postData, Serializer* destination = nullptr, bool start = true);
     /// Destruct. Release the connection object.
     ~HttpRequest() override;
 
+    /// Start the request if it was constructed without starting.
+    void Start();
     /// Process the connection in the worker thread until closed.
     void ThreadFunction() override;
 
@@ -83,6 +91,11 @@ public:
     /// Return whether connection is in the open state.
     /// @property
     bool IsOpen() const { return GetState() == HTTP_OPEN; }
+    /// Return whether the request is finished, either successfully or with an error.
+    bool IsFinished() const;
+    /// Return total amount of response bytes received so far.
+    /// @property
+    unsigned GetBytesReceived() const { return bytesReceived_.load(std::memory_order_relaxed); }
 
 private:
     /// Check for available read data in buffer and whether end has been reached. Must only be called when the mutex is held by the main thread.
@@ -110,6 +123,10 @@ private:
     unsigned readPosition_;
     /// Read buffer write cursor.
     unsigned writePosition_;
+    /// Destination of response data. Accessed only from the worker thread while the request is running.
+    Serializer* destination_{};
+    /// Total amount of response bytes received.
+    std::atomic<unsigned> bytesReceived_{};
 };
 
 }
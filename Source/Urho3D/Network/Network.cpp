@@ -225,6 +225,9 @@ Network::Network(Context* context) :
     // Register Network library object factories
     RegisterNetworkLibrary(context_);
 
+    bytesReceivedMetric_ = GetMetricCounter(context_, "urho3d_network_bytes_received_total", "Number of bytes received over network");
+    packetsReceivedMetric_ = GetMetricCounter(context_, "urho3d_network_packets_received_total", "Number of packets received over network");
+
     SubscribeToEvent(E_BEGINFRAME, URHO3D_HANDLER(Network, HandleBeginFrame));
     SubscribeToEvent(E_RENDERUPDATE, URHO3D_HANDLER(Network, HandleRenderUpdate));
 }
@@ -487,13 +490,18 @@ void Network::BroadcastMessage(int msgID, bool reliable, bool inOrder, const uns
     if (!rakPeer_)
         return;
 
-    VectorBuffer msgData;
-    msgData.WriteUByte((unsigned char)ID_USER_PACKET_ENUM);
-    msgData.WriteUInt((unsigned int)msgID);
-    msgData.Write(data, numBytes);
+    // Send header and payload as separate parts to avoid copying the payload
+    unsigned char header[1 + sizeof(unsigned)];
+    MemoryBuffer headerBuffer(header, sizeof(header));
+    headerBuffer.WriteUByte((unsigned char)ID_USER_PACKET_ENUM);
+    headerBuffer.WriteUInt((unsigned int)msgID);
+
+    const char* parts[] = {reinterpret_cast<const char*>(header), reinterpret_cast<const char*>(data)};
+    const int lengths[] = {static_cast<int>(sizeof(header)), static_cast<int>(numBytes)};
+    const int numParts = numBytes > 0 ? 2 : 1;
 
     if (isServer_)
-        rakPeer_->Send((const char*)msgData.GetData(), (int)msgData.GetSize(), HIGH_PRIORITY, RELIABLE, (char)0, SLNet::UNASSIGNED_RAKNET_GUID, true);
+        rakPeer_->SendList(parts, lengths, numParts, HIGH_PRIORITY, RELIABLE, (char)0, SLNet::UNASSIGNED_RAKNET_GUID, true);
     else
         URHO3D_LOGERROR("Server not running, can not broadcast messages");
 }
@@ -616,10 +624,52 @@ SharedPtr<HttpRequest> Network::MakeHttpRequest(const ea::string& url, const ea:
     URHO3D_PROFILE("MakeHttpRequest");
 
     // The initialization of the request will take time, can not know at this point if it has an error or not
-    SharedPtr<HttpRequest> request(new HttpRequest(url, verb, headers, postData));
+    SharedPtr<HttpRequest> request(new HttpRequest(url, verb, headers, postData, nullptr, false));
+    QueueHttpRequest(request);
+    return request;
+}
+
+SharedPtr<HttpRequest> Network::MakeHttpRequest(const ea::string& url, Serializer* destination, const ea::string& verb,
+    const ea::vector<ea::string>& headers, const ea::string& postData)
+{
+    URHO3D_PROFILE("MakeHttpRequest");
+
+    SharedPtr<HttpRequest> request(new HttpRequest(url, verb, headers, postData, destination, false));
+    QueueHttpRequest(request);
     return request;
 }
 
+void Network::QueueHttpRequest(HttpRequest* request)
+{
+    UpdateHttpRequests();
+
+    if (maxConcurrentHttpRequests_ == 0 || runningHttpRequests_.size() < maxConcurrentHttpRequests_)
+    {
+        request->Start();
+        runningHttpRequests_.emplace_back(request);
+    }
+    else
+        queuedHttpRequests_.emplace_back(request);
+}
+
+void Network::UpdateHttpRequests()
+{
+    ea::erase_if(runningHttpRequests_, [](const SharedPtr<HttpRequest>& request) { return request->IsFinished(); });
+
+    // Requests that are not referenced from outside are abandoned and don't need to be started
+    ea::erase_if(queuedHttpRequests_, [](const SharedPtr<HttpRequest>& request) { return request->Refs() == 1; });
+
+    unsigned numStarted = 0;
+    while (numStarted < queuedHttpRequests_.size()
+        && (maxConcurrentHttpRequests_ == 0 || runningHttpRequests_.size() < maxConcurrentHttpRequests_))
+    {
+        HttpRequest* request = queuedHttpRequests_[numStarted++];
+        request->Start();
+        runningHttpRequests_.emplace_back(request);
+    }
+    queuedHttpRequests_.erase(queuedHttpRequests_.begin(), queuedHttpRequests_.begin() + numStarted);
+}
+
 void Network::BanAddress(const ea::string& address)
 {
     rakPeer_->AddToBanList(address.c_str(), 0);
@@ -714,6 +764,9 @@ void Network::HandleIncomingPacket(SLNet::Packet* packet, bool isServer)
     unsigned char packetID = packet->data[0];
     bool packetHandled = false;
 
+    bytesReceivedMetric_->Increment(packet->length);
+    packetsReceivedMetric_->Increment();
+
     // Deal with timestamped backents
     unsigned dataStart = sizeof(char);
     if (packetID == ID_TIMESTAMP)
@@ -907,6 +960,8 @@ void Network::Update(float timeStep)
 {
     URHO3D_PROFILE("UpdateNetwork");
 
+    UpdateHttpRequests();
+
     // Check if periodic update should happen now
     updateAcc_ += timeStep;
     updateNow_ = updateAcc_ >= updateInterval_;
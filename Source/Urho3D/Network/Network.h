@@ -34,6 +34,7 @@ namespace Urho3D
 class HttpRequest;
 class MemoryBuffer;
 class Scene;
+class Serializer;
 
 /// %Network subsystem. Manages client-server communications using the UDP protocol.
 class URHO3D_API Network : public Object
@@ -118,6 +119,17 @@ public:
     void SendPackageToClients(Scene* scene, PackageFile* package);
     /// Perform an HTTP request to the specified URL. Empty verb defaults to a GET request. Return a request object which can be used to read the response data.
     SharedPtr<HttpRequest> MakeHttpRequest(const ea::string& url, const ea::string& verb = EMPTY_STRING, const ea::vector<ea::string>& headers = ea::vector<ea::string>(), const ea::string& postData = EMPTY_STRING);
+    /// Perform an HTTP request and stream the response data directly into the destination from the worker thread.
+    /// Destination must stay alive and must not be used until the request is finished.
+    SharedPtr<HttpRequest> MakeHttpRequest(const ea::string& url, Serializer* destination,
+        const ea::string& verb = EMPTY_STRING, const ea::vector<ea::string>& headers = ea::vector<ea::string>(),
+        const ea::string& postData = EMPTY_STRING);
+    /// Set max number of HTTP requests executed at the same time. Extra requests are queued. 0 means unlimited.
+    /// @property
+    void SetMaxConcurrentHttpRequests(unsigned count) { maxConcurrentHttpRequests_ = count; }
+    /// Return max number of HTTP requests executed at the same time.
+    /// @property
+    unsigned GetMaxConcurrentHttpRequests() const { return maxConcurrentHttpRequests_; }
     /// Ban specific IP addresses.
     void BanAddress(const ea::string& address);
     /// Return network update FPS.
@@ -188,6 +200,10 @@ private:
     static unsigned long GetEndpointHash(const SLNet::AddressOrGUID& endpoint);
 
     void SendNetworkUpdateEvent(StringHash eventType, bool isServer);
+    /// Queue HTTP request or start it immediately if the limit allows.
+    void QueueHttpRequest(HttpRequest* request);
+    /// Remove finished HTTP requests and start queued ones.
+    void UpdateHttpRequests();
 
     /// Used for testing only
     /// @{
@@ -244,6 +260,16 @@ private:
     SLNet::RakNetGUID* remoteGUID_;
     /// Local server GUID.
     ea::string guid_;
+    /// Number of bytes received by all connections.
+    SharedPtr<MetricCounter> bytesReceivedMetric_;
+    /// Number of packets received by all connections.
+    SharedPtr<MetricCounter> packetsReceivedMetric_;
+    /// Max number of HTTP requests executed at the same time.
+    unsigned maxConcurrentHttpRequests_{16};
+    /// Running HTTP requests.
+    ea::vector<SharedPtr<HttpRequest>> runningHttpRequests_;
+    /// HTTP requests waiting for a free slot.
+    ea::vector<SharedPtr<HttpRequest>> queuedHttpRequests_;
 };
 
 /// Register Network library objects.
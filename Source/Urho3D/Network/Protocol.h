@@ -75,7 +75,9 @@ enum NetworkMessageId
     MSG_USER = 512
 };
 
-/// Package file fragment size.
-static const unsigned PACKAGE_FRAGMENT_SIZE = 1024;
+/// Package file fragment size. Large fragments are split into packets by the network layer.
+static const unsigned PACKAGE_FRAGMENT_SIZE = 64 * 1024;
+/// Max size of package data waiting in the send buffer of the connection.
+static const unsigned PACKAGE_SEND_WINDOW_SIZE = 1024 * 1024;
 
 }
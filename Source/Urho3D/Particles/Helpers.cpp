@@ -31,11 +31,61 @@
 #include "UpdateContext.h"
 #include "Urho3D/IO/Log.h"
 
+#ifdef URHO3D_SSE
+    #include <xmmintrin.h>
+#endif
+
 namespace Urho3D
 {
 
 namespace ParticleGraphNodes
 {
+
+void AddFloatLanes(float* out, const float* x, const float* y, unsigned count)
+{
+    unsigned i = 0;
+#ifdef URHO3D_SSE
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i)));
+#endif
+    for (; i < count; ++i)
+        out[i] = x[i] + y[i];
+}
+
+void SubtractFloatLanes(float* out, const float* x, const float* y, unsigned count)
+{
+    unsigned i = 0;
+#ifdef URHO3D_SSE
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(out + i, _mm_sub_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i)));
+#endif
+    for (; i < count; ++i)
+        out[i] = x[i] - y[i];
+}
+
+void MultiplyFloatLanes(float* out, const float* x, const float* y, unsigned count)
+{
+    unsigned i = 0;
+#ifdef URHO3D_SSE
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i)));
+#endif
+    for (; i < count; ++i)
+        out[i] = x[i] * y[i];
+}
+
+void MultiplyAddFloatLanes(float* out, const float* x, const float* y, float scale, unsigned count)
+{
+    unsigned i = 0;
+#ifdef URHO3D_SSE
+    const __m128 scale4 = _mm_set1_ps(scale);
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(_mm_loadu_ps(y + i), scale4)));
+#endif
+    for (; i < count; ++i)
+        out[i] = x[i] + y[i] * scale;
+}
+
 namespace
 {
 class NopInstance: public ParticleGraphNodeInstance
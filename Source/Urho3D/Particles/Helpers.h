@@ -46,6 +46,38 @@ template <typename T> struct GetPinType<ParticleGraphTypedPin<T>>
     typedef T Type;
 };
 
+/// Number of float lanes in the value type. Zero if the value cannot be processed as a flat array of floats.
+template <typename T> struct FloatLanes { static constexpr unsigned Value = 0; };
+template <> struct FloatLanes<float> { static constexpr unsigned Value = 1; };
+template <> struct FloatLanes<Vector2> { static constexpr unsigned Value = 2; };
+template <> struct FloatLanes<Vector3> { static constexpr unsigned Value = 3; };
+template <> struct FloatLanes<Vector4> { static constexpr unsigned Value = 4; };
+template <> struct FloatLanes<Color> { static constexpr unsigned Value = 4; };
+
+/// Whether the value type is a plain sequence of floats.
+template <typename T> constexpr bool IsFloatLanes = FloatLanes<T>::Value != 0;
+
+/// Dense kernels over flat arrays of floats. Count is the number of floats, not the number of particles.
+/// @{
+URHO3D_API void AddFloatLanes(float* out, const float* x, const float* y, unsigned count);
+URHO3D_API void SubtractFloatLanes(float* out, const float* x, const float* y, unsigned count);
+URHO3D_API void MultiplyFloatLanes(float* out, const float* x, const float* y, unsigned count);
+/// Evaluate out = x + y * scale.
+URHO3D_API void MultiplyAddFloatLanes(float* out, const float* x, const float* y, float scale, unsigned count);
+/// @}
+
+/// Return span of values as flat array of floats.
+/// @{
+template <typename T> float* AsFloatLanes(T* values) { return reinterpret_cast<float*>(values); }
+template <typename T> const float* AsFloatLanes(const T* values) { return reinterpret_cast<const float*>(values); }
+/// @}
+
+/// Return whether all pins are dense spans.
+template <typename SpanTuple> bool IsDenseSpanTuple(SpanTuple& spans)
+{
+    return ea::apply([](auto&... span) { return ((span.type_ == ParticleGraphContainerType::Span) && ...); }, spans);
+}
+
 /// Abstract update runner.
 template <typename Instance, typename SpanTuple, typename Tuple>
 void RunUpdate(UpdateContext& context, Instance& instance, bool scalar, SpanTuple& spanTuple, Tuple tuple)
@@ -96,6 +128,15 @@ template <typename Instance, typename... Values>
 void RunUpdate(UpdateContext& context, Instance& instance, ParticleGraphPinRef* pinRefs)
 {
     auto spans = SpanVariantTuple<Values...>::Make(context, pinRefs);
+
+    // Fast version for dense pins: pass raw pointers so the loops are free of per-element dispatch.
+    if (IsDenseSpanTuple(spans))
+    {
+        auto denseSpans = ea::apply([](auto&... span) { return ea::make_tuple(span.GetSpan()...); }, spans);
+        ea::apply(instance, ea::tuple_cat(ea::tie(context), ea::make_tuple(static_cast<unsigned>(context.indices_.size())), denseSpans));
+        return;
+    }
+
     // Slow but small version:
     ea::apply(instance, ea::tuple_cat(ea::tie(context), ea::make_tuple(static_cast<unsigned>(context.indices_.size())), spans));
 
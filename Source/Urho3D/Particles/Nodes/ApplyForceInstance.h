@@ -42,6 +42,13 @@ public:
             result[i] = vel[i] + force[i] * context.timeStep_;
         }
     }
+
+    /// Dense version.
+    void operator()(UpdateContext& context, unsigned numParticles, Vector3* vel, Vector3* force, Vector3* result)
+    {
+        MultiplyAddFloatLanes(AsFloatLanes(result), AsFloatLanes(vel), AsFloatLanes(force), context.timeStep_,
+            numParticles * FloatLanes<Vector3>::Value);
+    }
 };
 
 } // namespace ParticleGraphNodes
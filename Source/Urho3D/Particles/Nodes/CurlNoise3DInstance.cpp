@@ -71,6 +71,37 @@ Vector3 CurlNoise3DInstance::Generate(const Vector3& pos)
     return Vector3(dz - dy, dx - dz, dy - dx);
 }
 
+void CurlNoise3DInstance::GenerateBatch(Vector3 dest[], const Vector3 positions[], unsigned count)
+{
+    constexpr float offset = 0.01f;
+    constexpr float frequency = 2.0f;
+    constexpr float scale = 0.02f;
+
+    // Center and three offset samples are evaluated in single batch
+    Vector3 samplePositions[BlockSize * 4];
+    float samples[BlockSize * 4];
+    const auto scroll = static_cast<float>(scrollPos_);
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const Vector3 pos{positions[i].x_ * frequency, positions[i].y_ * frequency, positions[i].z_ * frequency + scroll};
+        samplePositions[i * 4] = pos;
+        samplePositions[i * 4 + 1] = pos + Vector3(offset, 0.0f, 0.0f);
+        samplePositions[i * 4 + 2] = pos + Vector3(0.0f, offset, 0.0f);
+        samplePositions[i * 4 + 3] = pos + Vector3(0.0f, 0.0f, offset);
+    }
+
+    noise_.GetBatch(samples, samplePositions, count * 4);
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        const float center = samples[i * 4];
+        const float dx = (samples[i * 4 + 1] - center) * scale / offset;
+        const float dy = (samples[i * 4 + 2] - center) * scale / offset;
+        const float dz = (samples[i * 4 + 3] - center) * scale / offset;
+        dest[i] = Vector3(dz - dy, dx - dz, dy - dx);
+    }
+}
+
 } // namespace ParticleGraphNodes
 
 } // namespace Urho3D
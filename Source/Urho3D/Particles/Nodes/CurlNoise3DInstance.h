@@ -35,6 +35,9 @@ namespace ParticleGraphNodes
 class CurlNoise3DInstance final : public CurlNoise3D::InstanceBase
 {
 public:
+    /// Number of particles processed at once.
+    static const unsigned BlockSize = 64;
+
     CurlNoise3DInstance();
 
     void Init(ParticleGraphNode* node, ParticleGraphLayerInstance* layer) override;
@@ -43,13 +46,23 @@ public:
     void operator()(UpdateContext& context, unsigned numParticles, Pos x, Vel out)
     {
         scrollPos_ += context.timeStep_;
-        for (unsigned i = 0; i < numParticles; ++i)
+
+        // Positions are gathered into blocks to evaluate noise in batch
+        Vector3 positions[BlockSize];
+        Vector3 velocities[BlockSize];
+        for (unsigned offset = 0; offset < numParticles; offset += BlockSize)
         {
-            out[i] = Generate(x[i]);
+            const unsigned count = ea::min(BlockSize, numParticles - offset);
+            for (unsigned i = 0; i < count; ++i)
+                positions[i] = x[offset + i];
+            GenerateBatch(velocities, positions, count);
+            for (unsigned i = 0; i < count; ++i)
+                out[offset + i] = velocities[i];
         }
     }
 
     Vector3 Generate(const Vector3& pos);
+    void GenerateBatch(Vector3 dest[], const Vector3 positions[], unsigned count);
 
     PerlinNoise noise_;
     double scrollPos_{};
@@ -45,6 +45,13 @@ public:
             pin2[i] = pin0[i] + context.timeStep_ * pin1[i];
         }
     }
+
+    /// Dense version.
+    void operator()(UpdateContext& context, unsigned numParticles, Vector3* pin0, Vector3* pin1, Vector3* pin2)
+    {
+        MultiplyAddFloatLanes(AsFloatLanes(pin2), AsFloatLanes(pin0), AsFloatLanes(pin1), context.timeStep_,
+            numParticles * FloatLanes<Vector3>::Value);
+    }
 };
 
 } // namespace ParticleGraphNodes
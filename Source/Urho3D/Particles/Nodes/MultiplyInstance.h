@@ -38,6 +38,13 @@ template <typename Value0, typename Value1, typename Value2> struct MultiplyInst
             out[i] = x[i] * y[i];
         }
     }
+
+    /// Dense version for values made of floats.
+    template <typename T, typename = ea::enable_if_t<IsFloatLanes<T>>>
+    void operator()(UpdateContext& context, unsigned numParticles, T* x, T* y, T* out)
+    {
+        MultiplyFloatLanes(AsFloatLanes(out), AsFloatLanes(x), AsFloatLanes(y), numParticles * FloatLanes<T>::Value);
+    }
 };
 
 } // namespace ParticleGraphNodes
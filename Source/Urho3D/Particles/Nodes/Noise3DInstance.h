@@ -35,15 +35,26 @@ namespace ParticleGraphNodes
 class Noise3DInstance final : public Noise3D::InstanceBase
 {
 public:
+    /// Number of particles processed at once.
+    static const unsigned BlockSize = 64;
+
     Noise3DInstance();
 
     void Init(ParticleGraphNode* node, ParticleGraphLayerInstance* layer) override;
 
     template <typename Pos, typename Vel> void operator()(UpdateContext& context, unsigned numParticles, Pos x, Vel out)
     {
-        for (unsigned i = 0; i < numParticles; ++i)
+        // Positions are gathered into blocks to evaluate noise in batch
+        Vector3 positions[BlockSize];
+        float values[BlockSize];
+        for (unsigned offset = 0; offset < numParticles; offset += BlockSize)
         {
-            out[i] = Generate(x[i]);
+            const unsigned count = ea::min(BlockSize, numParticles - offset);
+            for (unsigned i = 0; i < count; ++i)
+                positions[i] = x[offset + i];
+            noise_.GetBatch(values, positions, count);
+            for (unsigned i = 0; i < count; ++i)
+                out[offset + i] = values[i];
         }
     }
 
@@ -0,0 +1,459 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "ParticleGraphComputeGenerator.h"
+
+#include "ParticleGraphLayer.h"
+#include "ParticleGraphNode.h"
+#include "Nodes/Add.h"
+#include "Nodes/ApplyForce.h"
+#include "Nodes/Attribute.h"
+#include "Nodes/Constant.h"
+#include "Nodes/CurlNoise3D.h"
+#include "Nodes/EffectTime.h"
+#include "Nodes/Expire.h"
+#include "Nodes/Move.h"
+#include "Nodes/Multiply.h"
+#include "Nodes/Random.h"
+#include "Nodes/RenderBillboard.h"
+#include "Nodes/Subtract.h"
+#include "Nodes/TimeStep.h"
+
+#include <EASTL/optional.h>
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Common declarations of generated shader.
+const char* shaderHeader = R"(#version 430
+
+// Generated from particle graph layer. Executes init graph for emitted particles and update graph for alive ones.
+
+layout(std430, binding = 0) readonly buffer LayerParameters
+{
+    // x: capacity, y: first emitted particle, z: number of emitted particles, w: random seed
+    uvec4 header;
+    // x: time step, y: layer time
+    vec4 timing;
+};
+
+layout(std430, binding = 1) buffer Attributes
+{
+    // Attribute slots of all particles, attribute-major
+    vec4 attributes[];
+};
+
+uint HashUInt(uint x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+float RandomFloat(inout uint state)
+{
+    state = HashUInt(state);
+    return float(state >> 8) * (1.0 / 16777216.0);
+}
+
+float Hash31(vec3 p)
+{
+    return fract(sin(dot(p, vec3(127.1, 311.7, 74.7))) * 43758.5453) * 2.0 - 1.0;
+}
+
+float ValueNoise3D(vec3 p)
+{
+    const vec3 i = floor(p);
+    const vec3 f = fract(p);
+    const vec3 u = f * f * (3.0 - 2.0 * f);
+    return mix(
+        mix(mix(Hash31(i), Hash31(i + vec3(1, 0, 0)), u.x),
+            mix(Hash31(i + vec3(0, 1, 0)), Hash31(i + vec3(1, 1, 0)), u.x), u.y),
+        mix(mix(Hash31(i + vec3(0, 0, 1)), Hash31(i + vec3(1, 0, 1)), u.x),
+            mix(Hash31(i + vec3(0, 1, 1)), Hash31(i + vec3(1, 1, 1)), u.x), u.y), u.z);
+}
+
+// Same frequency, scale and finite differences as CurlNoise3D node on CPU
+vec3 CurlNoise3D(vec3 pos, float scroll)
+{
+    const float offset = 0.01;
+    const float frequency = 2.0;
+    const float scale = 0.02;
+    const vec3 p = vec3(pos.xy * frequency, pos.z * frequency + scroll);
+
+    const float center = ValueNoise3D(p) * scale;
+    const float dx = (ValueNoise3D(p + vec3(offset, 0, 0)) * scale - center) / offset;
+    const float dy = (ValueNoise3D(p + vec3(0, offset, 0)) * scale - center) / offset;
+    const float dz = (ValueNoise3D(p + vec3(0, 0, offset)) * scale - center) / offset;
+    return vec3(dz - dy, dx - dz, dy - dx);
+}
+)";
+
+/// Billboard output of generated shader. Vertex layout matches BillboardSet.
+const char* billboardHeader = R"(
+layout(std430, binding = 2) writeonly buffer BillboardVertices
+{
+    // Position, packed color, UV and corner offset per vertex, four vertices per particle
+    uint vertices[];
+};
+
+void WriteBillboardVertex(uint vertex, vec3 position, uint color, vec2 uv, vec2 offset)
+{
+    const uint base = vertex * 8u;
+    vertices[base + 0u] = floatBitsToUint(position.x);
+    vertices[base + 1u] = floatBitsToUint(position.y);
+    vertices[base + 2u] = floatBitsToUint(position.z);
+    vertices[base + 3u] = color;
+    vertices[base + 4u] = floatBitsToUint(uv.x);
+    vertices[base + 5u] = floatBitsToUint(uv.y);
+    vertices[base + 6u] = floatBitsToUint(offset.x);
+    vertices[base + 7u] = floatBitsToUint(offset.y);
+}
+
+void WriteBillboard(uint index, vec3 position, vec2 size, float frame, vec4 color, float rotation)
+{
+    const int frameIndex = int(frame);
+    const vec2 tileSize = vec2(1.0) / vec2(billboardTiles);
+    const vec2 tile = vec2(frameIndex % billboardTiles.x, frameIndex / billboardTiles.x);
+    const vec2 uvMin = (tile + billboardCropOffset) * tileSize;
+    const vec2 uvMax = uvMin + tileSize * billboardCropSize;
+    const vec2 s = size * billboardCropSize;
+    const float rs = sin(radians(rotation));
+    const float rc = cos(radians(rotation));
+    const uint packedColor = packUnorm4x8(color);
+
+    const uint vertex = index * 4u;
+    WriteBillboardVertex(vertex + 0u, position, packedColor, vec2(uvMin.x, uvMin.y), vec2(-s.x * rc + s.y * rs, s.x * rs + s.y * rc));
+    WriteBillboardVertex(vertex + 1u, position, packedColor, vec2(uvMax.x, uvMin.y), vec2(s.x * rc + s.y * rs, -s.x * rs + s.y * rc));
+    WriteBillboardVertex(vertex + 2u, position, packedColor, vec2(uvMax.x, uvMax.y), vec2(s.x * rc - s.y * rs, -s.x * rs - s.y * rc));
+    WriteBillboardVertex(vertex + 3u, position, packedColor, vec2(uvMin.x, uvMax.y), vec2(-s.x * rc - s.y * rs, s.x * rs - s.y * rc));
+}
+
+void ClearBillboard(uint index)
+{
+    for (uint i = 0u; i < 4u; ++i)
+        WriteBillboardVertex(index * 4u + i, vec3(0.0), 0u, vec2(0.0), vec2(0.0));
+}
+)";
+
+const char* GetShaderType(VariantType type)
+{
+    switch (type)
+    {
+    case VAR_FLOAT: return "float";
+    case VAR_VECTOR2: return "vec2";
+    case VAR_VECTOR3: return "vec3";
+    case VAR_VECTOR4:
+    case VAR_COLOR: return "vec4";
+    default: return nullptr;
+    }
+}
+
+const char* GetSlotSwizzle(VariantType type)
+{
+    switch (type)
+    {
+    case VAR_FLOAT: return ".x";
+    case VAR_VECTOR2: return ".xy";
+    case VAR_VECTOR3: return ".xyz";
+    default: return "";
+    }
+}
+
+ea::string FormatSlotValue(VariantType type, const ea::string& value)
+{
+    switch (type)
+    {
+    case VAR_FLOAT: return Format("vec4({}, 0.0, 0.0, 0.0)", value);
+    case VAR_VECTOR2: return Format("vec4({}, 0.0, 0.0)", value);
+    case VAR_VECTOR3: return Format("vec4({}, 0.0)", value);
+    default: return value;
+    }
+}
+
+ea::string FormatFloat(float value)
+{
+    return Format("float({:.9g})", value);
+}
+
+ea::optional<ea::string> FormatValue(const Variant& value)
+{
+    switch (value.GetType())
+    {
+    case VAR_FLOAT:
+        return FormatFloat(value.GetFloat());
+    case VAR_VECTOR2:
+    {
+        const Vector2& v = value.GetVector2();
+        return Format("vec2({}, {})", FormatFloat(v.x_), FormatFloat(v.y_));
+    }
+    case VAR_VECTOR3:
+    {
+        const Vector3& v = value.GetVector3();
+        return Format("vec3({}, {}, {})", FormatFloat(v.x_), FormatFloat(v.y_), FormatFloat(v.z_));
+    }
+    case VAR_VECTOR4:
+    {
+        const Vector4& v = value.GetVector4();
+        return Format("vec4({}, {}, {}, {})", FormatFloat(v.x_), FormatFloat(v.y_), FormatFloat(v.z_), FormatFloat(v.w_));
+    }
+    case VAR_COLOR:
+    {
+        const Color& c = value.GetColor();
+        return Format("vec4({}, {}, {}, {})", FormatFloat(c.r_), FormatFloat(c.g_), FormatFloat(c.b_), FormatFloat(c.a_));
+    }
+    default:
+        return ea::nullopt;
+    }
+}
+
+}
+
+ParticleGraphComputeGenerator::ParticleGraphComputeGenerator(ParticleGraphLayer* layer)
+    : layer_(layer)
+{
+}
+
+bool ParticleGraphComputeGenerator::Generate()
+{
+    source_.clear();
+    error_.clear();
+    billboardNode_ = nullptr;
+
+    if (!layer_ || !layer_->Commit())
+    {
+        error_ = "Particle graph layer is not committed";
+        return false;
+    }
+
+    const ParticleGraphAttributeLayout& attributes = layer_->GetAttributeLayout();
+    for (unsigned i = 0; i < attributes.GetNumAttributes(); ++i)
+    {
+        if (!GetShaderType(attributes.GetType(i)))
+        {
+            error_ = Format("Attribute '{}' of type {} is not supported on GPU", attributes.GetName(i),
+                Variant::GetTypeName(attributes.GetType(i)));
+            return false;
+        }
+    }
+    numSlots_ = attributes.GetNumAttributes() + 1;
+
+    ea::string initCode;
+    ea::string updateCode;
+    if (!GenerateGraph(layer_->GetInitGraph(), "init", initCode))
+        return false;
+    if (billboardNode_)
+    {
+        error_ = "RenderBillboard is supported only in update graph";
+        return false;
+    }
+    if (!GenerateGraph(layer_->GetUpdateGraph(), "update", updateCode))
+        return false;
+
+    source_ += shaderHeader;
+    if (billboardNode_)
+    {
+        const Rect crop = billboardNode_->GetCrop();
+        source_ += Format("\nconst ivec2 billboardTiles = ivec2({}, {});\n", ea::max(1, billboardNode_->GetColumns()),
+            ea::max(1, billboardNode_->GetRows()));
+        source_ += Format("const vec2 billboardCropOffset = vec2({}, {});\n", FormatFloat(crop.min_.x_), FormatFloat(crop.min_.y_));
+        source_ += Format("const vec2 billboardCropSize = vec2({}, {});\n", FormatFloat(crop.Size().x_), FormatFloat(crop.Size().y_));
+        source_ += billboardHeader;
+    }
+
+    const unsigned aliveSlot = numSlots_ - 1;
+    source_ += Format("\nlayout(local_size_x = {}, local_size_y = 1, local_size_z = 1) in;\n", GroupSize);
+    source_ += "void main()\n{\n";
+    source_ += "    const uint index = gl_GlobalInvocationID.x;\n";
+    source_ += "    const uint capacity = header.x;\n";
+    source_ += "    if (index >= capacity)\n        return;\n\n";
+    source_ += "    uint randomState = HashUInt(index ^ HashUInt(header.w));\n";
+    source_ += Format("    bool alive = attributes[{}u * capacity + index].x != 0.0;\n", aliveSlot);
+    source_ += "    if ((index + capacity - header.y) % capacity < header.z)\n    {\n";
+    source_ += "        alive = true;\n";
+    source_ += "        const float timeStep = 0.0;\n";
+    source_ += initCode;
+    source_ += "    }\n\n";
+    source_ += "    if (!alive)\n    {\n";
+    if (billboardNode_)
+        source_ += "        ClearBillboard(index);\n";
+    source_ += Format("        attributes[{}u * capacity + index] = vec4(0.0);\n", aliveSlot);
+    source_ += "        return;\n    }\n\n";
+    source_ += "    {\n";
+    source_ += "        const float timeStep = timing.x;\n";
+    source_ += updateCode;
+    source_ += "    }\n";
+    source_ += Format("    attributes[{}u * capacity + index] = vec4(alive ? 1.0 : 0.0);\n", aliveSlot);
+    source_ += "}\n";
+    return true;
+}
+
+bool ParticleGraphComputeGenerator::GenerateGraph(ParticleGraph& graph, const ea::string& prefix, ea::string& code)
+{
+    prefix_ = prefix;
+    for (unsigned i = 0; i < graph.GetNumNodes(); ++i)
+    {
+        ParticleGraphNode* node = graph.GetNode(i);
+        if (!GenerateNode(node, i, code))
+        {
+            if (error_.empty())
+                error_ = Format("Node {} of {} graph is not supported on GPU", node->GetTypeName(), prefix);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ParticleGraphComputeGenerator::GenerateNode(ParticleGraphNode* node, unsigned nodeIndex, ea::string& code)
+{
+    using namespace ParticleGraphNodes;
+
+    const StringHash nodeType = node->GetType();
+
+    if (nodeType == Constant::GetTypeStatic())
+    {
+        const auto value = FormatValue(static_cast<Constant*>(node)->GetValue());
+        return value && DeclareOutput(node, nodeIndex, 0, *value, code);
+    }
+    else if (nodeType == GetAttribute::GetTypeStatic())
+    {
+        const ParticleGraphPin& pin = node->GetPin(0);
+        const ea::string value = Format("attributes[{}u * capacity + index]{}", pin.GetAttributeIndex(),
+            GetSlotSwizzle(pin.GetValueType()));
+        return DeclareOutput(node, nodeIndex, 0, value, code);
+    }
+    else if (nodeType == SetAttribute::GetTypeStatic())
+    {
+        const ParticleGraphPin& pin = node->GetPin(0);
+        const ea::string value = GetInputName(node, 1);
+        if (!DeclareOutput(node, nodeIndex, 0, value, code))
+            return false;
+        code += Format("        attributes[{}u * capacity + index] = {};\n", pin.GetAttributeIndex(),
+            FormatSlotValue(pin.GetValueType(), value));
+        return true;
+    }
+    else if (nodeType == TimeStep::GetTypeStatic())
+    {
+        return DeclareOutput(node, nodeIndex, 0, "timeStep", code);
+    }
+    else if (nodeType == EffectTime::GetTypeStatic())
+    {
+        return DeclareOutput(node, nodeIndex, 0, "timing.y", code);
+    }
+    else if (nodeType == ParticleGraphNodes::Random::GetTypeStatic())
+    {
+        const auto* random = static_cast<ParticleGraphNodes::Random*>(node);
+        const VariantType type = node->GetPin(0).GetValueType();
+        if (random->GetMin().GetType() != type || random->GetMax().GetType() != type)
+            return false;
+        const auto min = FormatValue(random->GetMin());
+        const auto max = FormatValue(random->GetMax());
+        return min && max
+            && DeclareOutput(node, nodeIndex, 0, Format("mix({}, {}, RandomFloat(randomState))", *min, *max), code);
+    }
+    else if (nodeType == Add::GetTypeStatic() || nodeType == Subtract::GetTypeStatic()
+        || nodeType == Multiply::GetTypeStatic())
+    {
+        const char* operation = nodeType == Add::GetTypeStatic() ? "+" : nodeType == Subtract::GetTypeStatic() ? "-" : "*";
+        const unsigned x = node->GetPinIndex("x");
+        const unsigned y = node->GetPinIndex("y");
+        if (!GetShaderType(node->GetPin(x).GetValueType()) || !GetShaderType(node->GetPin(y).GetValueType()))
+            return false;
+        const ea::string value = Format("{} {} {}", GetInputName(node, x), operation, GetInputName(node, y));
+        return DeclareOutput(node, nodeIndex, node->GetPinIndex("out"), value, code);
+    }
+    else if (nodeType == Move::GetTypeStatic())
+    {
+        const ea::string value = Format("{} + timeStep * {}", GetInputName(node, 0), GetInputName(node, 1));
+        return DeclareOutput(node, nodeIndex, 2, value, code);
+    }
+    else if (nodeType == ApplyForce::GetTypeStatic())
+    {
+        const ea::string value = Format("{} + {} * timeStep", GetInputName(node, 0), GetInputName(node, 1));
+        return DeclareOutput(node, nodeIndex, 2, value, code);
+    }
+    else if (nodeType == CurlNoise3D::GetTypeStatic())
+    {
+        const ea::string value = Format("CurlNoise3D({}, timing.y + timing.x)", GetInputName(node, 0));
+        return DeclareOutput(node, nodeIndex, 1, value, code);
+    }
+    else if (nodeType == Expire::GetTypeStatic())
+    {
+        code += Format("        if ({} >= {})\n            alive = false;\n", GetInputName(node, 0), GetInputName(node, 1));
+        return true;
+    }
+    else if (nodeType == RenderBillboard::GetTypeStatic())
+    {
+        auto* renderBillboard = static_cast<RenderBillboard*>(node);
+        const auto faceCameraMode = static_cast<FaceCameraMode>(renderBillboard->GetFaceCameraMode());
+        if (billboardNode_)
+        {
+            error_ = "Only one RenderBillboard node is supported on GPU";
+            return false;
+        }
+        if (faceCameraMode == FC_DIRECTION || faceCameraMode == FC_AXIS_ANGLE)
+        {
+            error_ = "Direction and axis-angle billboards are not supported on GPU";
+            return false;
+        }
+
+        billboardNode_ = renderBillboard;
+        code += Format("        WriteBillboard(index, {}, {}, {}, {}, {});\n", GetInputName(node, 0),
+            GetInputName(node, 1), GetInputName(node, 2), GetInputName(node, 3), GetInputName(node, 4));
+        return true;
+    }
+
+    return false;
+}
+
+ea::string ParticleGraphComputeGenerator::GetVariableName(unsigned nodeIndex, unsigned pinIndex) const
+{
+    return Format("{}_{}_{}", prefix_, nodeIndex, pinIndex);
+}
+
+ea::string ParticleGraphComputeGenerator::GetInputName(ParticleGraphNode* node, unsigned pinIndex) const
+{
+    const ParticleGraphPin& pin = node->GetPin(pinIndex);
+    return GetVariableName(pin.GetConnectedNodeIndex(), pin.GetConnectedPinIndex());
+}
+
+bool ParticleGraphComputeGenerator::DeclareOutput(
+    ParticleGraphNode* node, unsigned nodeIndex, unsigned pinIndex, const ea::string& value, ea::string& code)
+{
+    const char* type = GetShaderType(node->GetPin(pinIndex).GetValueType());
+    if (!type)
+        return false;
+
+    code += Format("        const {} {} = {};\n", type, GetVariableName(nodeIndex, pinIndex), value);
+    return true;
+}
+
+}
@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Container/Str.h"
+
+#include <EASTL/string.h>
+#include <EASTL/unordered_map.h>
+
+namespace Urho3D
+{
+
+class ParticleGraph;
+class ParticleGraphLayer;
+class ParticleGraphNode;
+
+namespace ParticleGraphNodes
+{
+class RenderBillboard;
+}
+
+/// Generator of compute shader that executes init and update graphs of particle graph layer on GPU.
+/// Emit graph is not translated: emission is evaluated on CPU and only the number of new particles is sent to GPU.
+///
+/// Attributes of particle are stored in ring buffer of vec4 slots, one slot per attribute per particle,
+/// followed by the slot with alive flag. New particles overwrite the oldest ones when the layer is full.
+/// RenderBillboard node writes vertices in the same layout as BillboardSet, dead particles are degenerate quads.
+class URHO3D_API ParticleGraphComputeGenerator
+{
+public:
+    /// Number of threads in compute group.
+    static constexpr unsigned GroupSize = 64;
+    /// Number of 32-bit values in billboard vertex.
+    static constexpr unsigned BillboardVertexSize = 8;
+
+    /// Construct.
+    explicit ParticleGraphComputeGenerator(ParticleGraphLayer* layer);
+
+    /// Generate shader source. Return false if the layer contains nodes that are not supported on GPU.
+    bool Generate();
+
+    /// Return generated shader source.
+    const ea::string& GetSource() const { return source_; }
+    /// Return description of the reason why the layer cannot be executed on GPU.
+    const ea::string& GetError() const { return error_; }
+    /// Return number of vec4 slots per particle, including alive flag.
+    unsigned GetNumSlots() const { return numSlots_; }
+    /// Return RenderBillboard node of update graph, if any.
+    ParticleGraphNodes::RenderBillboard* GetBillboardNode() const { return billboardNode_; }
+
+private:
+    /// Generate code of the graph.
+    bool GenerateGraph(ParticleGraph& graph, const ea::string& prefix, ea::string& code);
+    /// Generate code of the node.
+    bool GenerateNode(ParticleGraphNode* node, unsigned nodeIndex, ea::string& code);
+    /// Return name of variable that holds value of output pin.
+    ea::string GetVariableName(unsigned nodeIndex, unsigned pinIndex) const;
+    /// Return name of variable connected to input pin.
+    ea::string GetInputName(ParticleGraphNode* node, unsigned pinIndex) const;
+    /// Declare variable for output pin.
+    bool DeclareOutput(ParticleGraphNode* node, unsigned nodeIndex, unsigned pinIndex, const ea::string& value,
+        ea::string& code);
+
+    /// Layer.
+    ParticleGraphLayer* layer_{};
+    /// Prefix of variables in currently generated graph.
+    ea::string prefix_;
+    /// Generated source.
+    ea::string source_;
+    /// Error message.
+    ea::string error_;
+    /// Number of vec4 slots per particle.
+    unsigned numSlots_{};
+    /// RenderBillboard node.
+    ParticleGraphNodes::RenderBillboard* billboardNode_{};
+};
+
+}
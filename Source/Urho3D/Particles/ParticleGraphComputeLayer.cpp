@@ -0,0 +1,339 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "ParticleGraphComputeLayer.h"
+
+#include "ParticleGraphComputeGenerator.h"
+#include "ParticleGraphLayer.h"
+#include "Nodes/RenderBillboard.h"
+
+#include "../Core/Context.h"
+#include "../Graphics/Camera.h"
+#include "../Graphics/ComputeBuffer.h"
+#include "../Graphics/ComputeDevice.h"
+#include "../Graphics/Geometry.h"
+#include "../Graphics/Graphics.h"
+#include "../Graphics/IndexBuffer.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/Octree.h"
+#include "../Graphics/Shader.h"
+#include "../Graphics/ShaderVariation.h"
+#include "../Graphics/VertexBuffer.h"
+#include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
+#include "../Resource/ResourceCache.h"
+#include "../Scene/Node.h"
+#include "../Scene/Scene.h"
+
+#include "../DebugNew.h"
+
+#if defined(URHO3D_COMPUTE)
+
+namespace Urho3D
+{
+
+namespace
+{
+
+unsigned DivideRoundUp(unsigned value, unsigned divisor)
+{
+    return (value + divisor - 1) / divisor;
+}
+
+}
+
+ParticleGraphComputeBillboards::ParticleGraphComputeBillboards(Context* context)
+    : Drawable(context, DRAWABLE_GEOMETRY)
+    , geometry_(MakeShared<Geometry>(context))
+    , vertexBuffer_(MakeShared<VertexBuffer>(context))
+    , indexBuffer_(MakeShared<IndexBuffer>(context))
+{
+    geometry_->SetVertexBuffer(0, vertexBuffer_);
+    geometry_->SetIndexBuffer(indexBuffer_);
+
+    batches_.resize(1);
+    batches_[0].geometry_ = geometry_;
+    batches_[0].geometryType_ = GEOM_BILLBOARD;
+    batches_[0].worldTransform_ = &transforms_[0];
+}
+
+ParticleGraphComputeBillboards::~ParticleGraphComputeBillboards() = default;
+
+void ParticleGraphComputeBillboards::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<ParticleGraphComputeBillboards>();
+}
+
+void ParticleGraphComputeBillboards::UpdateBatches(const FrameInfo& frame)
+{
+    distance_ = frame.camera_->GetDistance(GetWorldBoundingBox().Center());
+
+    const Quaternion billboardRotation = faceCameraMode_ != FC_NONE
+        ? frame.camera_->GetFaceCameraRotation(node_->GetWorldPosition(), node_->GetWorldRotation(), faceCameraMode_)
+        : node_->GetWorldRotation();
+    transforms_[0] = relative_ ? node_->GetWorldTransform() : Matrix3x4::IDENTITY;
+    transforms_[1] = Matrix3x4(Vector3::ZERO, billboardRotation, Vector3::ONE);
+
+    batches_[0].distance_ = distance_;
+    batches_[0].numWorldTransforms_ = 2;
+}
+
+bool ParticleGraphComputeBillboards::SetCapacity(unsigned capacity)
+{
+    // Layout matches BillboardSet so existing billboard shaders can be used
+    const unsigned numVertices = capacity * 4;
+    if (!vertexBuffer_->SetSize(numVertices, MASK_POSITION | MASK_COLOR | MASK_TEXCOORD1 | MASK_TEXCOORD2, false))
+        return false;
+    static_assert(ParticleGraphComputeGenerator::BillboardVertexSize * sizeof(float) == 32);
+
+    // Dead particles are degenerate quads, so the buffer is zeroed until first simulation step
+    ea::vector<uint8_t> vertexData(numVertices * vertexBuffer_->GetVertexSize());
+    vertexBuffer_->SetData(vertexData.data());
+
+    const bool largeIndices = numVertices >= 65536;
+    if (!indexBuffer_->SetSize(capacity * 6, largeIndices))
+        return false;
+
+    ea::vector<unsigned> indices(capacity * 6);
+    for (unsigned i = 0; i < capacity; ++i)
+    {
+        const unsigned vertexIndex = i * 4;
+        unsigned* dest = &indices[i * 6];
+        dest[0] = vertexIndex;
+        dest[1] = vertexIndex + 1;
+        dest[2] = vertexIndex + 2;
+        dest[3] = vertexIndex + 2;
+        dest[4] = vertexIndex + 3;
+        dest[5] = vertexIndex;
+    }
+
+    if (largeIndices)
+        indexBuffer_->SetData(indices.data());
+    else
+    {
+        ea::vector<unsigned short> shortIndices(indices.begin(), indices.end());
+        indexBuffer_->SetData(shortIndices.data());
+    }
+
+    geometry_->SetDrawRange(TRIANGLE_LIST, 0, capacity * 6, false);
+    return true;
+}
+
+void ParticleGraphComputeBillboards::SetMaterial(Material* material)
+{
+    batches_[0].material_ = material;
+}
+
+void ParticleGraphComputeBillboards::SetFaceCameraMode(FaceCameraMode mode)
+{
+    faceCameraMode_ = mode;
+}
+
+void ParticleGraphComputeBillboards::SetBoundingBox(const BoundingBox& box)
+{
+    boundingBox_ = box;
+    OnMarkedDirty(node_);
+}
+
+void ParticleGraphComputeBillboards::OnWorldBoundingBoxUpdate()
+{
+    worldBoundingBox_ = boundingBox_.Transformed(node_->GetWorldTransform());
+}
+
+ParticleGraphComputeLayer::ParticleGraphComputeLayer(Context* context)
+    : Object(context)
+    , computeDevice_(GetSubsystem<ComputeDevice>())
+{
+}
+
+ParticleGraphComputeLayer::~ParticleGraphComputeLayer()
+{
+    OnSceneSet(nullptr);
+}
+
+bool ParticleGraphComputeLayer::IsSupported(Context* context)
+{
+#if defined(URHO3D_OPENGL)
+    // Generated shaders are GLSL only
+    auto computeDevice = context->GetSubsystem<ComputeDevice>();
+    return computeDevice && computeDevice->IsSupported();
+#else
+    return false;
+#endif
+}
+
+bool ParticleGraphComputeLayer::Initialize(ParticleGraphLayer* layer)
+{
+    ParticleGraphComputeGenerator generator(layer);
+    if (!generator.Generate())
+    {
+        URHO3D_LOGWARNING("Particle graph layer is simulated on CPU: {}", generator.GetError());
+        return false;
+    }
+
+    // Identical layers share the same shader
+    const ea::string& source = generator.GetSource();
+    const ea::string shaderName = Format("Shaders/GLSL/v2/C_ParticleGraph_{}.glsl", StringHash(source).ToString());
+    auto cache = GetSubsystem<ResourceCache>();
+    shader_ = cache->GetExistingResource<Shader>(shaderName);
+    if (!shader_)
+    {
+        shader_ = MakeShared<Shader>(context_);
+        shader_->SetName(shaderName);
+        MemoryBuffer buffer(source.data(), source.size());
+        if (!shader_->Load(buffer))
+        {
+            URHO3D_LOGERROR("Failed to load particle graph compute shader");
+            return false;
+        }
+        cache->AddManualResource(shader_);
+    }
+
+    computeShader_ = shader_->GetVariation(CS, "");
+    if (!computeShader_)
+        return false;
+
+    capacity_ = layer->GetCapacity();
+    numSlots_ = generator.GetNumSlots();
+
+    parameters_ = MakeShared<ComputeBuffer>(context_);
+    attributes_ = MakeShared<ComputeBuffer>(context_);
+    if (!parameters_->SetSize(sizeof(LayerParameters), sizeof(Vector4))
+        || !attributes_->SetSize(capacity_ * numSlots_ * sizeof(Vector4), sizeof(Vector4)))
+    {
+        URHO3D_LOGERROR("Failed to create buffers for particle graph compute layer");
+        return false;
+    }
+
+    if (auto renderBillboard = generator.GetBillboardNode())
+    {
+        sceneNode_ = MakeShared<Node>(context_);
+        billboards_ = sceneNode_->CreateComponent<ParticleGraphComputeBillboards>();
+        if (!billboards_->SetCapacity(capacity_))
+        {
+            URHO3D_LOGERROR("Failed to create billboards for particle graph compute layer");
+            return false;
+        }
+
+        const float halfSize = layer->GetComputeBoundsSize() * 0.5f;
+        billboards_->SetMaterial(cache->GetResource<Material>(renderBillboard->GetMaterial().name_));
+        billboards_->SetFaceCameraMode(static_cast<FaceCameraMode>(renderBillboard->GetFaceCameraMode()));
+        billboards_->SetRelative(!renderBillboard->GetIsWorldspace());
+        billboards_->SetBoundingBox(BoundingBox(-Vector3::ONE * halfSize, Vector3::ONE * halfSize));
+    }
+
+    Reset();
+    return true;
+}
+
+void ParticleGraphComputeLayer::Reset()
+{
+    if (attributes_)
+    {
+        ea::vector<Vector4> data(capacity_ * numSlots_, Vector4::ZERO);
+        attributes_->SetData(data.data(), data.size() * sizeof(Vector4), sizeof(Vector4));
+    }
+
+    emitCursor_ = 0;
+    emitStart_ = 0;
+    emitCount_ = 0;
+    updatePending_ = false;
+}
+
+void ParticleGraphComputeLayer::Emit(unsigned count)
+{
+    if (!capacity_ || !count)
+        return;
+
+    if (!emitCount_)
+        emitStart_ = emitCursor_;
+    count = ea::min(count, capacity_ - emitCount_);
+    emitCount_ += count;
+    emitCursor_ = (emitCursor_ + count) % capacity_;
+}
+
+void ParticleGraphComputeLayer::Update(float timeStep, float time)
+{
+    timeStep_ = updatePending_ ? timeStep_ + timeStep : timeStep;
+    time_ = time;
+    updatePending_ = true;
+}
+
+void ParticleGraphComputeLayer::Commit(const Matrix3x4& emitterTransform)
+{
+    if (!updatePending_ || !computeDevice_ || !computeShader_)
+        return;
+
+    randomSeed_ = randomSeed_ * 1664525u + 1013904223u;
+
+    LayerParameters parameters;
+    parameters.header_[0] = capacity_;
+    parameters.header_[1] = emitStart_;
+    parameters.header_[2] = emitCount_;
+    parameters.header_[3] = randomSeed_;
+    parameters.timing_[0] = timeStep_;
+    parameters.timing_[1] = time_;
+    parameters_->SetData(&parameters, sizeof(parameters), sizeof(Vector4));
+
+    emitCount_ = 0;
+    updatePending_ = false;
+
+    computeDevice_->SetProgram(computeShader_);
+    computeDevice_->SetWriteBuffer(parameters_, 0);
+    computeDevice_->SetWriteBuffer(attributes_, 1);
+    if (billboards_)
+    {
+        sceneNode_->SetWorldTransform(emitterTransform);
+        computeDevice_->SetWriteBuffer(billboards_->GetVertexBuffer(), 2);
+    }
+    computeDevice_->Dispatch(DivideRoundUp(capacity_, ParticleGraphComputeGenerator::GroupSize), 1, 1);
+
+    // Unbind output buffers so they can be used as vertex buffers
+    for (unsigned unit = 0; unit < 3; ++unit)
+        computeDevice_->SetWriteBuffer(static_cast<ComputeBuffer*>(nullptr), unit);
+    computeDevice_->SetProgram(nullptr);
+    computeDevice_->ApplyBindings();
+}
+
+void ParticleGraphComputeLayer::OnSceneSet(Scene* scene)
+{
+    if (!billboards_)
+        return;
+
+    if (octree_)
+    {
+        octree_->RemoveManualDrawable(billboards_);
+        octree_.Reset();
+    }
+    if (scene)
+    {
+        octree_ = scene->GetOrCreateComponent<Octree>();
+        octree_->AddManualDrawable(billboards_);
+    }
+}
+
+}
+
+#endif
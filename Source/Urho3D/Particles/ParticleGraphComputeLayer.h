@@ -0,0 +1,173 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Graphics/Drawable.h"
+#include "../Math/Matrix3x4.h"
+
+#if defined(URHO3D_COMPUTE)
+
+namespace Urho3D
+{
+
+class ComputeBuffer;
+class ComputeDevice;
+class Geometry;
+class IndexBuffer;
+class Octree;
+class ParticleGraphLayer;
+class Scene;
+class Shader;
+class ShaderVariation;
+class VertexBuffer;
+
+/// Drawable that renders billboards written by particle graph compute shader.
+/// Vertex buffer is never touched by CPU, so the bounding box is fixed and should enclose all particles.
+class URHO3D_API ParticleGraphComputeBillboards : public Drawable
+{
+    URHO3D_OBJECT(ParticleGraphComputeBillboards, Drawable);
+
+public:
+    /// Construct.
+    explicit ParticleGraphComputeBillboards(Context* context);
+    /// Destruct.
+    ~ParticleGraphComputeBillboards() override;
+    /// Register object factory.
+    static void RegisterObject(Context* context);
+
+    /// Calculate distance and prepare batches for rendering.
+    void UpdateBatches(const FrameInfo& frame) override;
+
+    /// Allocate vertex and index buffers for specified number of billboards.
+    bool SetCapacity(unsigned capacity);
+    /// Set material.
+    void SetMaterial(Material* material);
+    /// Set how the billboards should rotate in relation to the camera.
+    void SetFaceCameraMode(FaceCameraMode mode);
+    /// Set whether billboard positions are relative to the scene node.
+    void SetRelative(bool relative) { relative_ = relative; }
+    /// Set local space bounding box.
+    void SetBoundingBox(const BoundingBox& box);
+
+    /// Return vertex buffer written by compute shader.
+    VertexBuffer* GetVertexBuffer() const { return vertexBuffer_; }
+
+protected:
+    /// Recalculate the world-space bounding box.
+    void OnWorldBoundingBoxUpdate() override;
+
+private:
+    /// Geometry.
+    SharedPtr<Geometry> geometry_;
+    /// Vertex buffer.
+    SharedPtr<VertexBuffer> vertexBuffer_;
+    /// Index buffer.
+    SharedPtr<IndexBuffer> indexBuffer_;
+    /// Transform matrices for position and billboard orientation.
+    Matrix3x4 transforms_[2];
+    /// Billboard rotation mode in relation to the camera.
+    FaceCameraMode faceCameraMode_{FC_ROTATE_XYZ};
+    /// Whether billboard positions are relative to the scene node.
+    bool relative_{};
+};
+
+/// Particle graph layer simulated in compute shader.
+/// Emission is evaluated on CPU, particle attributes never leave GPU memory.
+class URHO3D_API ParticleGraphComputeLayer : public Object
+{
+    URHO3D_OBJECT(ParticleGraphComputeLayer, Object);
+
+public:
+    /// Construct.
+    explicit ParticleGraphComputeLayer(Context* context);
+    /// Destruct.
+    ~ParticleGraphComputeLayer() override;
+
+    /// Return whether compute simulation is supported by the device.
+    static bool IsSupported(Context* context);
+
+    /// Initialize from layer. Return false if the layer cannot be simulated on GPU.
+    bool Initialize(ParticleGraphLayer* layer);
+    /// Remove all particles.
+    void Reset();
+    /// Queue new particles. Oldest particles are replaced when the layer is full.
+    void Emit(unsigned count);
+    /// Queue simulation step. Safe to call from worker threads.
+    void Update(float timeStep, float time);
+    /// Dispatch queued simulation step. Shall be called from main thread.
+    void Commit(const Matrix3x4& emitterTransform);
+    /// Handle scene change.
+    void OnSceneSet(Scene* scene);
+
+private:
+    /// Parameters of simulation step. Layout should match generated shader.
+    struct LayerParameters
+    {
+        /// Capacity, first emitted particle, number of emitted particles and random seed.
+        unsigned header_[4]{};
+        /// Time step and layer time.
+        float timing_[4]{};
+    };
+
+    /// Compute device.
+    WeakPtr<ComputeDevice> computeDevice_;
+    /// Generated shader.
+    SharedPtr<Shader> shader_;
+    /// Compute shader variation.
+    SharedPtr<ShaderVariation> computeShader_;
+    /// Step parameters.
+    SharedPtr<ComputeBuffer> parameters_;
+    /// Particle attributes.
+    SharedPtr<ComputeBuffer> attributes_;
+
+    /// Detached scene node of billboards.
+    SharedPtr<Node> sceneNode_;
+    /// Billboards, if the layer is rendered.
+    SharedPtr<ParticleGraphComputeBillboards> billboards_;
+    /// Octree where billboards are added as manual drawable.
+    WeakPtr<Octree> octree_;
+
+    /// Maximum number of particles.
+    unsigned capacity_{};
+    /// Number of vec4 slots per particle.
+    unsigned numSlots_{};
+    /// Next particle slot to emit into.
+    unsigned emitCursor_{};
+    /// First particle emitted in queued step.
+    unsigned emitStart_{};
+    /// Number of particles emitted in queued step.
+    unsigned emitCount_{};
+    /// Random seed of next step.
+    unsigned randomSeed_{};
+    /// Time step of queued step.
+    float timeStep_{};
+    /// Layer time of queued step.
+    float time_{};
+    /// Whether the step is queued.
+    bool updatePending_{};
+};
+
+}
+
+#endif
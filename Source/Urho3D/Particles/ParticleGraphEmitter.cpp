@@ -25,12 +25,14 @@
 #include "ParticleGraphEmitter.h"
 
 #include "../Core/Context.h"
+#include "../Engine/Engine.h"
 #include "../Resource/ResourceCache.h"
 #include "../Resource/ResourceEvents.h"
 #include "../Scene/Scene.h"
 #include "../Scene/SceneEvents.h"
 #include "ParticleGraphLayer.h"
 #include "ParticleGraphLayerInstance.h"
+#include "ParticleGraphSystem.h"
 
 namespace Urho3D
 {
@@ -54,14 +56,7 @@ void ParticleGraphEmitter::OnSetEnabled()
 {
     Component::OnSetEnabled();
 
-    Scene* scene = GetScene();
-    if (scene)
-    {
-        if (IsEnabledEffective())
-            SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(ParticleGraphEmitter, HandleScenePostUpdate));
-        else
-            UnsubscribeFromEvent(scene, E_SCENEPOSTUPDATE);
-    }
+    UpdateSceneSubscription(GetScene());
 }
 
 void ParticleGraphEmitter::Reset()
@@ -149,10 +144,7 @@ void ParticleGraphEmitter::OnSceneSet(Scene* scene)
 {
     Component::OnSceneSet(scene);
 
-    if (scene && IsEnabledEffective())
-        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(ParticleGraphEmitter, HandleScenePostUpdate));
-    else if (!scene)
-        UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+    UpdateSceneSubscription(scene);
 
     for (unsigned i = 0; i < layers_.size(); ++i)
     {
@@ -175,7 +167,55 @@ void ParticleGraphEmitter::Tick(float timeStep)
     for (unsigned i = 0; i < layers_.size(); ++i)
     {
         layers_[i].Update(timeStep, emitting_);
+        layers_[i].CommitCompute();
+    }
+}
+
+bool ParticleGraphEmitter::PrepareUpdate(float timeStep)
+{
+    lastTimeStep_ = timeStep;
+    if (layers_.empty())
+        return false;
+
+    // Evaluate cached world transform now, nodes may read it from worker threads
+    if (node_)
+        node_->GetWorldTransform();
+    return true;
+}
+
+void ParticleGraphEmitter::UpdateSceneSubscription(Scene* scene)
+{
+    // Particles are purely visual and are not simulated on dedicated servers
+    const auto engine = GetSubsystem<Engine>();
+    const bool skipUpdate = engine && engine->IsRenderUpdateSkipped();
+
+    Scene* newScene = scene && IsEnabledEffective() && !skipUpdate ? scene : nullptr;
+    if (updateScene_ == newScene)
+        return;
+
+    auto system = GetSubsystem<ParticleGraphSystem>();
+    if (updateScene_)
+    {
+        if (system)
+            system->RemoveEmitter(updateScene_, this);
+        else
+            UnsubscribeFromEvent(updateScene_, E_SCENEPOSTUPDATE);
     }
+
+    updateScene_ = newScene;
+
+    if (updateScene_)
+    {
+        if (system)
+            system->AddEmitter(updateScene_, this);
+        else
+            SubscribeToEvent(updateScene_, E_SCENEPOSTUPDATE, URHO3D_HANDLER(ParticleGraphEmitter, HandleScenePostUpdate));
+    }
+}
+
+unsigned ParticleGraphEmitter::GetNumLayers() const
+{
+    return layers_.size();
 }
 
 const ParticleGraphLayerInstance* ParticleGraphEmitter::GetLayer(unsigned layer) const
@@ -83,6 +83,11 @@ public:
 
     /// Manually update emitter.
     void Tick(float timeStep);
+    /// Prepare emitter for update of layers from worker threads. Return false if there's nothing to update.
+    bool PrepareUpdate(float timeStep);
+
+    /// Return number of layers.
+    unsigned GetNumLayers() const;
 
     /// Get layer by index.
     const ParticleGraphLayerInstance* GetLayer(unsigned layer) const;
@@ -98,7 +103,9 @@ protected:
     void OnSceneSet(Scene* scene) override;
 
 private:
-    /// Handle scene post-update event.
+    /// Add to or remove from scene updates depending on state.
+    void UpdateSceneSubscription(Scene* scene);
+    /// Handle scene post-update event. Used when there's no particle graph system.
     void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
     /// Handle live reload of the particle effect.
     void HandleEffectReloadFinished(StringHash eventType, VariantMap& eventData);
@@ -113,6 +120,8 @@ private:
 
     /// Currently emitting flag.
     bool emitting_{true};
+    /// Scene the emitter is registered in.
+    WeakPtr<Scene> updateScene_;
 };
 
 }
@@ -202,6 +202,9 @@ void ParticleGraphLayer::RegisterObject(Context* context)
     URHO3D_ACCESSOR_ATTRIBUTE("TimeScale", GetTimeScale, SetTimeScale, float, DefaultTimeScale, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Duration", GetDuration, SetDuration, float, DefaultDuration, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Loop", IsLoop, SetLoop, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Use Compute", IsComputeEnabled, SetComputeEnabled, bool, false, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE(
+        "Compute Bounds Size", GetComputeBoundsSize, SetComputeBoundsSize, float, DefaultComputeBoundsSize, AM_DEFAULT);
 }
 
 /// Construct ParticleGraphLayer.
@@ -243,6 +246,17 @@ void ParticleGraphLayer::SetDuration(float duration)
     duration_ = ea::max(1e-6f, duration);
 }
 
+void ParticleGraphLayer::SetComputeEnabled(bool enable)
+{
+    computeEnabled_ = enable;
+    Invalidate();
+}
+
+void ParticleGraphLayer::SetComputeBoundsSize(float size)
+{
+    computeBoundsSize_ = ea::max(0.0f, size);
+}
+
 ParticleGraph& ParticleGraphLayer::GetEmitGraph() { return *emit_; }
 
 ParticleGraph& ParticleGraphLayer::GetInitGraph() { return *init_; }
@@ -284,7 +298,7 @@ void ParticleGraphLayer::AttributeBufferLayout::EvaluateLayout(const ParticleGra
     }
     nodeInstances_ = Append(this, instanceSize);
     indices_ = Append<unsigned>(this, layer.capacity_);
-    destructionQueue_ = Append<unsigned>(this, layer.capacity_);
+    destructionMask_ = Append<unsigned>(this, (layer.capacity_ + 31) / 32);
     values_ = Append(this, 0);
 }
 
@@ -334,6 +348,8 @@ void ParticleGraphLayer::SerializeInBlock(Archive& archive)
     SerializeOptionalValue(archive, "duration", duration_, DefaultDuration);
     SerializeOptionalValue(archive, "timeScale", timeScale_, DefaultTimeScale);
     SerializeOptionalValue(archive, "loop", loop_);
+    SerializeOptionalValue(archive, "compute", computeEnabled_);
+    SerializeOptionalValue(archive, "computeBoundsSize", computeBoundsSize_, DefaultComputeBoundsSize);
 
     SerializeOptionalValue(archive, "emit", emit_, EmptyObject{},
         [&](Archive& archive, const char* name, auto& value) { SerializeValue(archive, name, *value); });
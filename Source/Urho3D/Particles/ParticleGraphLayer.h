@@ -38,6 +38,7 @@ class URHO3D_API ParticleGraphLayer : public Serializable
     static constexpr float DefaultDuration = 1.0f;
     static constexpr float DefaultTimeScale = 1.0f;
     static constexpr unsigned DefaultCapacity = 16;
+    static constexpr float DefaultComputeBoundsSize = 100.0f;
 
     URHO3D_OBJECT(ParticleGraphLayer, Serializable)
 
@@ -57,8 +58,8 @@ public:
         ParticleGraphSpan nodeInstances_;
         /// Indices.
         ParticleGraphSpan indices_;
-        /// Indices to destroy.
-        ParticleGraphSpan destructionQueue_;
+        /// Bit mask of particles to destroy.
+        ParticleGraphSpan destructionMask_;
         /// Particle attribute values.
         ParticleGraphSpan values_;
 
@@ -97,6 +98,18 @@ public:
     /// Set effect duration in seconds.
     void SetDuration(float duration);
 
+    /// Return whether init and update graphs are executed in compute shader when possible.
+    bool IsComputeEnabled() const { return computeEnabled_; }
+
+    /// Set whether init and update graphs are executed in compute shader when possible.
+    void SetComputeEnabled(bool enable);
+
+    /// Return size of bounding box around emitter used to cull particles simulated on GPU.
+    float GetComputeBoundsSize() const { return computeBoundsSize_; }
+
+    /// Set size of bounding box around emitter used to cull particles simulated on GPU.
+    void SetComputeBoundsSize(float size);
+
     /// Get emit graph.
     ParticleGraph& GetEmitGraph();
 
@@ -140,6 +153,10 @@ private:
     float duration_{DefaultDuration};
     /// Loop effect.
     bool loop_{};
+    /// Whether to simulate particles in compute shader.
+    bool computeEnabled_{};
+    /// Size of bounding box of particles simulated on GPU.
+    float computeBoundsSize_{DefaultComputeBoundsSize};
     /// Emission graph.
     SharedPtr<ParticleGraph> emit_;
     /// Initialization graph.
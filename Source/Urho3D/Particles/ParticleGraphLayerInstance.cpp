@@ -24,17 +24,20 @@
 
 #include "ParticleGraphLayerInstance.h"
 
+#include "ParticleGraphEmitter.h"
 #include "ParticleGraphNode.h"
 #include "ParticleGraphNodeInstance.h"
 #include "Span.h"
 #include "UpdateContext.h"
 
+#include "../Scene/Node.h"
+
 namespace Urho3D
 {
 
 ParticleGraphLayerInstance::ParticleGraphLayerInstance()
     : activeParticles_(0)
-    , destructionQueueSize_(0)
+    , numParticlesToDestroy_(0)
 {
 }
 
@@ -82,12 +85,35 @@ void ParticleGraphLayerInstance::Apply(const SharedPtr<ParticleGraphLayer>& laye
     {
         indices_[i] = i;
     }
-    destructionQueue_ = layout.destructionQueue_.MakeSpan<unsigned>(attributes_);
+    destructionMask_ = layout.destructionMask_.MakeSpan<unsigned>(attributes_);
+
+#if defined(URHO3D_COMPUTE)
+    computeLayer_ = nullptr;
+    Context* context = layer_->GetContext();
+    if (layer_->IsComputeEnabled() && ParticleGraphComputeLayer::IsSupported(context))
+    {
+        auto computeLayer = MakeShared<ParticleGraphComputeLayer>(context);
+        if (computeLayer->Initialize(layer_))
+        {
+            computeLayer_ = computeLayer;
+            computeLayer_->OnSceneSet(emitter_ ? emitter_->GetScene() : nullptr);
+        }
+    }
+#endif
     Reset();
 }
 
 /// Remove all current particles.
-void ParticleGraphLayerInstance::RemoveAllParticles() { activeParticles_ = 0; }
+void ParticleGraphLayerInstance::RemoveAllParticles()
+{
+    activeParticles_ = 0;
+    numParticlesToDestroy_ = 0;
+    ea::fill(destructionMask_.begin(), destructionMask_.end(), 0u);
+#if defined(URHO3D_COMPUTE)
+    if (computeLayer_)
+        computeLayer_->Reset();
+#endif
+}
 
 bool ParticleGraphLayerInstance::EmitNewParticles(float numParticles)
 {
@@ -99,6 +125,17 @@ bool ParticleGraphLayerInstance::EmitNewParticles(float numParticles)
     unsigned particlesToEmit = static_cast<unsigned>(emitCounterReminder_);
     emitCounterReminder_ -= static_cast<float>(particlesToEmit);
 
+#if defined(URHO3D_COMPUTE)
+    // Init graph is executed on GPU. Number of alive particles is unknown, so it's the upper estimate.
+    if (computeLayer_)
+    {
+        particlesToEmit = Urho3D::Min(particlesToEmit, indices_.size());
+        computeLayer_->Emit(particlesToEmit);
+        activeParticles_ = Urho3D::Min(activeParticles_ + particlesToEmit, indices_.size());
+        return true;
+    }
+#endif
+
     particlesToEmit = Urho3D::Min(particlesToEmit, indices_.size() - activeParticles_);
     if (!particlesToEmit)
         return false;
@@ -125,12 +162,38 @@ void ParticleGraphLayerInstance::Update(float timeStep, bool emitting)
         RunGraph(emitNodeInstances_, emitContext);
     }
 
+#if defined(URHO3D_COMPUTE)
+    if (computeLayer_)
+    {
+        computeLayer_->Update(timeStep, time_);
+        time_ += timeStep;
+        return;
+    }
+#endif
+
     auto updateContext = MakeUpdateContext(timeStep);
     RunGraph(updateNodeInstances_, updateContext);
     DestroyParticles();
     time_ += timeStep;
 }
 
+void ParticleGraphLayerInstance::CommitCompute()
+{
+#if defined(URHO3D_COMPUTE)
+    if (computeLayer_ && emitter_ && emitter_->GetNode())
+        computeLayer_->Commit(emitter_->GetNode()->GetWorldTransform());
+#endif
+}
+
+bool ParticleGraphLayerInstance::IsComputeActive() const
+{
+#if defined(URHO3D_COMPUTE)
+    return computeLayer_ != nullptr;
+#else
+    return false;
+#endif
+}
+
 unsigned ParticleGraphLayerInstance::GetNumAttributes() const
 {
     return layer_->GetAttributeLayout().GetNumAttributes();
@@ -141,11 +204,12 @@ void ParticleGraphLayerInstance::MarkForDeletion(unsigned particleIndex)
     if (particleIndex >= activeParticles_)
         return;
 
-    //TODO: if buffer is full sort and eliminate duplicates.
-    if (destructionQueueSize_ < destructionQueue_.size())
+    unsigned& word = destructionMask_[particleIndex / 32];
+    const unsigned bit = 1u << (particleIndex % 32);
+    if (!(word & bit))
     {
-        destructionQueue_[destructionQueueSize_] = particleIndex;
-        ++destructionQueueSize_;
+        word |= bit;
+        ++numParticlesToDestroy_;
     }
 }
 
@@ -173,7 +237,13 @@ void ParticleGraphLayerInstance::Reset()
     for (ParticleGraphNodeInstance* node : updateNodeInstances_)
         node->Reset();
     activeParticles_ = 0;
+    numParticlesToDestroy_ = 0;
+    ea::fill(destructionMask_.begin(), destructionMask_.end(), 0u);
     time_ = 0.0f;
+#if defined(URHO3D_COMPUTE)
+    if (computeLayer_)
+        computeLayer_->Reset();
+#endif
 }
 
 void ParticleGraphLayerInstance::SetEmitter(ParticleGraphEmitter* emitter)
@@ -196,6 +266,10 @@ void ParticleGraphLayerInstance::OnSceneSet(Scene* scene)
     {
         node->OnSceneSet(scene);
     }
+#if defined(URHO3D_COMPUTE)
+    if (computeLayer_)
+        computeLayer_->OnSceneSet(scene);
+#endif
 }
 
 
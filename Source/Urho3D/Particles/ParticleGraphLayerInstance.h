@@ -22,9 +22,10 @@
 
 #pragma once
 
+#include "ParticleGraphComputeLayer.h"
 #include "ParticleGraphLayer.h"
 #include "ParticleGraphNodeInstance.h"
-#include <EASTL/sort.h>
+#include <EASTL/algorithm.h>
 
 namespace Urho3D
 {
@@ -83,6 +84,12 @@ public:
     /// Run update step.
     void Update(float timeStep, bool emitting);
 
+    /// Dispatch GPU simulation queued by update step. Shall be called from main thread. No-op for CPU layers.
+    void CommitCompute();
+
+    /// Return whether init and update graphs are executed on GPU.
+    bool IsComputeActive() const;
+
     /// Get number of attributes.
     unsigned GetNumAttributes() const;
 
@@ -129,6 +136,9 @@ protected:
 
     /// Destroy particles.
     void DestroyParticles();
+    /// Return index of first active particle starting from given one that is (or is not) marked for deletion.
+    /// Return number of active particles if there is no such particle.
+    unsigned FindMarkedForDeletion(unsigned index, bool marked) const;
 
     ea::span<uint8_t> InitNodeInstances(ea::span<uint8_t> nodeInstanceBuffer,
         ea::span<ParticleGraphNodeInstance*>& nodeInstances, const ParticleGraph& particle_graph);
@@ -147,12 +157,12 @@ private:
     ea::span<ParticleGraphNodeInstance*> initNodeInstances_;
     /// Node instances for update graph
     ea::span<ParticleGraphNodeInstance*> updateNodeInstances_;
-    /// All indices of the particle system.
+    /// All indices of the particle system. Indices are always sequential, active particles are kept dense.
     ea::span<unsigned> indices_;
-    /// Particle indices to be removed.
-    ea::span<unsigned> destructionQueue_;
+    /// Bit mask of particles to be removed.
+    ea::span<unsigned> destructionMask_;
     /// Number of particles to destroy at end of the frame.
-    unsigned destructionQueueSize_;
+    unsigned numParticlesToDestroy_;
     /// Number of active particles.
     unsigned activeParticles_;
     /// Reference to layer.
@@ -161,23 +171,69 @@ private:
     ParticleGraphEmitter* emitter_{};
     /// Time since emitter start.
     float time_{};
+#if defined(URHO3D_COMPUTE)
+    /// GPU simulation of the layer, if enabled and supported.
+    SharedPtr<ParticleGraphComputeLayer> computeLayer_;
+#endif
 
     friend class ParticleGraphEmitter;
 };
 
+inline unsigned ParticleGraphLayerInstance::FindMarkedForDeletion(unsigned index, bool marked) const
+{
+    while (index < activeParticles_)
+    {
+        const unsigned word = marked ? destructionMask_[index / 32] : ~destructionMask_[index / 32];
+        unsigned bits = word >> (index % 32);
+        if (!bits)
+        {
+            // Skip the rest of the word
+            index = (index / 32 + 1) * 32;
+            continue;
+        }
+
+        while (!(bits & 1u))
+        {
+            bits >>= 1;
+            ++index;
+        }
+        return ea::min(index, activeParticles_);
+    }
+    return activeParticles_;
+}
+
 inline void ParticleGraphLayerInstance::DestroyParticles()
 {
-    if (!destructionQueueSize_)
+    if (!numParticlesToDestroy_)
         return;
-    auto queue = destructionQueue_.subspan(0, destructionQueueSize_);
-    ea::sort(queue.begin(), queue.end(), ea::greater<unsigned>());
-    //TODO: Eliminate duplicates.
-    for (unsigned index: queue)
+
+    // Stream compaction in linear time: runs of surviving particles are moved over destroyed ones.
+    // Surviving particles keep their relative order, so attributes stay dense and indices stay sequential.
+    const auto& attributeLayout = layer_->GetAttributeLayout();
+    const unsigned capacity = indices_.size();
+    const unsigned firstDestroyed = FindMarkedForDeletion(0, true);
+    for (unsigned attributeIndex = 0; attributeIndex < attributeLayout.GetNumAttributes(); ++attributeIndex)
     {
-        ea::swap(indices_[index], indices_[activeParticles_ - 1]);
-        --activeParticles_;
+        const auto values = attributeLayout.GetSpan(attributeIndex).MakeSpan<uint8_t>(attributes_);
+        const unsigned elementSize = values.size() / capacity;
+
+        unsigned writeIndex = firstDestroyed;
+        unsigned readIndex = FindMarkedForDeletion(firstDestroyed, false);
+        while (readIndex < activeParticles_)
+        {
+            const unsigned runEnd = FindMarkedForDeletion(readIndex, true);
+            const unsigned runSize = runEnd - readIndex;
+            memmove(values.data() + writeIndex * elementSize, values.data() + readIndex * elementSize,
+                runSize * elementSize);
+            writeIndex += runSize;
+            readIndex = FindMarkedForDeletion(runEnd, false);
+        }
     }
-    destructionQueueSize_ = 0;
+
+    const unsigned numWords = (activeParticles_ + 31) / 32;
+    ea::fill(destructionMask_.begin(), destructionMask_.begin() + numWords, 0u);
+    activeParticles_ -= numParticlesToDestroy_;
+    numParticlesToDestroy_ = 0;
 }
 
 /// Get attribute values.
@@ -24,8 +24,15 @@
 
 #include "ParticleGraphSystem.h"
 
+#include "ParticleGraphComputeLayer.h"
 #include "ParticleGraphEmitter.h"
 #include "ParticleGraphLayer.h"
+#include "ParticleGraphLayerInstance.h"
+
+#include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
+#include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
 
 namespace Urho3D
 {
@@ -47,11 +54,112 @@ ParticleGraphSystem::~ParticleGraphSystem()
 {
 }
 
+void ParticleGraphSystem::AddEmitter(Scene* scene, ParticleGraphEmitter* emitter)
+{
+    const auto isExpired = [](const SceneEmitters& entry) { return entry.scene_.Expired(); };
+    sceneEmitters_.erase(ea::remove_if(sceneEmitters_.begin(), sceneEmitters_.end(), isExpired), sceneEmitters_.end());
+
+    auto iter = ea::find_if(sceneEmitters_.begin(), sceneEmitters_.end(),
+        [scene](const SceneEmitters& entry) { return entry.scene_ == scene; });
+    if (iter == sceneEmitters_.end())
+    {
+        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, URHO3D_HANDLER(ParticleGraphSystem, HandleScenePostUpdate));
+        iter = sceneEmitters_.insert(sceneEmitters_.end(), SceneEmitters{WeakPtr<Scene>(scene)});
+    }
+
+    auto& emitters = iter->emitters_;
+    if (ea::find(emitters.begin(), emitters.end(), emitter) == emitters.end())
+        emitters.emplace_back(emitter);
+}
+
+void ParticleGraphSystem::RemoveEmitter(Scene* scene, ParticleGraphEmitter* emitter)
+{
+    const auto iter = ea::find_if(sceneEmitters_.begin(), sceneEmitters_.end(),
+        [scene](const SceneEmitters& entry) { return entry.scene_ == scene; });
+    if (iter == sceneEmitters_.end())
+        return;
+
+    auto& emitters = iter->emitters_;
+    const auto isRemoved = [emitter](const WeakPtr<ParticleGraphEmitter>& item) { return !item || item == emitter; };
+    emitters.erase(ea::remove_if(emitters.begin(), emitters.end(), isRemoved), emitters.end());
+
+    if (emitters.empty())
+    {
+        UnsubscribeFromEvent(scene, E_SCENEPOSTUPDATE);
+        sceneEmitters_.erase(iter);
+    }
+}
+
+void ParticleGraphSystem::UpdateEmitters(Scene* scene, float timeStep)
+{
+    const auto iter = ea::find_if(sceneEmitters_.begin(), sceneEmitters_.end(),
+        [scene](const SceneEmitters& entry) { return entry.scene_ == scene; });
+    if (iter == sceneEmitters_.end())
+        return;
+
+    URHO3D_PROFILE("UpdateParticleGraphEmitters");
+
+    auto& emitters = iter->emitters_;
+    const auto isExpired = [](const WeakPtr<ParticleGraphEmitter>& emitter) { return !emitter; };
+    emitters.erase(ea::remove_if(emitters.begin(), emitters.end(), isExpired), emitters.end());
+
+    // Prepare emitters in main thread so worker threads don't touch shared node state
+    layersToUpdate_.clear();
+    for (ParticleGraphEmitter* emitter : emitters)
+    {
+        if (!emitter->PrepareUpdate(timeStep))
+            continue;
+
+        const bool emitting = emitter->IsEmitting();
+        for (unsigned i = 0; i < emitter->GetNumLayers(); ++i)
+            layersToUpdate_.emplace_back(emitter->GetLayer(i), emitting);
+    }
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    if (!threadedUpdate_ || !workQueue || workQueue->GetNumThreads() == 0 || layersToUpdate_.size() < MinThreadedLayers)
+    {
+        for (const auto& [layer, emitting] : layersToUpdate_)
+        {
+            layer->Update(timeStep, emitting);
+            layer->CommitCompute();
+        }
+        return;
+    }
+
+    // Drawables of render nodes are queued for octree update in a thread-safe way during threaded update
+    scene->BeginThreadedUpdate();
+    ForEachParallel(workQueue, 1, layersToUpdate_.size(),
+        [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            const auto& [layer, emitting] = layersToUpdate_[i];
+            layer->Update(timeStep, emitting);
+        }
+    });
+    scene->EndThreadedUpdate();
+
+    // GPU simulation is dispatched from main thread
+    for (const auto& [layer, emitting] : layersToUpdate_)
+        layer->CommitCompute();
+}
+
+void ParticleGraphSystem::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
+{
+    using namespace ScenePostUpdate;
+
+    auto scene = static_cast<Scene*>(eventData[P_SCENE].GetPtr());
+    UpdateEmitters(scene, eventData[P_TIMESTEP].GetFloat());
+}
+
 void RegisterParticleGraphLibrary(Context* context, ParticleGraphSystem* system)
 {
     ParticleGraphEffect::RegisterObject(context);
     ParticleGraphLayer::RegisterObject(context);
     ParticleGraphEmitter::RegisterObject(context);
+#if defined(URHO3D_COMPUTE)
+    ParticleGraphComputeBillboards::RegisterObject(context);
+#endif
 
     ParticleGraphNodes::RegisterGraphNodes(system);
 }
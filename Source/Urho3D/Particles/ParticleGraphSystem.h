@@ -28,15 +28,52 @@
 
 namespace Urho3D
 {
+
+class ParticleGraphEmitter;
+class ParticleGraphLayerInstance;
+class Scene;
+
 /// %Particle graph effect definition.
 class URHO3D_API ParticleGraphSystem : public Object, public ObjectReflectionRegistry
 {
     URHO3D_OBJECT(ParticleGraphSystem, Object);
 
 public:
+    /// Min number of active layers to update emitters in worker threads.
+    static const unsigned MinThreadedLayers = 4;
+
     ParticleGraphSystem(Context* context);
 
     ~ParticleGraphSystem() override;
+
+    /// Add emitter to be updated on scene post-update together with other emitters of the scene.
+    void AddEmitter(Scene* scene, ParticleGraphEmitter* emitter);
+    /// Remove emitter from scene updates.
+    void RemoveEmitter(Scene* scene, ParticleGraphEmitter* emitter);
+    /// Update all emitters of the scene. Each layer instance is updated in a separate task if threading is enabled.
+    void UpdateEmitters(Scene* scene, float timeStep);
+
+    /// Set whether to update emitters in worker threads.
+    void SetThreadedUpdate(bool enable) { threadedUpdate_ = enable; }
+    /// Return whether to update emitters in worker threads.
+    bool GetThreadedUpdate() const { return threadedUpdate_; }
+
+private:
+    /// Handle scene post-update event.
+    void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
+
+    struct SceneEmitters
+    {
+        WeakPtr<Scene> scene_;
+        ea::vector<WeakPtr<ParticleGraphEmitter>> emitters_;
+    };
+
+    /// Emitters grouped by scene.
+    ea::vector<SceneEmitters> sceneEmitters_;
+    /// Layer instances to update in the current frame and whether their emitters are emitting.
+    ea::vector<ea::pair<ParticleGraphLayerInstance*, bool>> layersToUpdate_;
+    /// Whether to update emitters in worker threads.
+    bool threadedUpdate_{true};
 };
 
 
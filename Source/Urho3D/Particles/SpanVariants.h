@@ -33,8 +33,11 @@ template <typename T> SpanVariant<T>::SpanVariant(UpdateContext& context, Partic
     type_ = pinRef.type_;
     if (type_ == ParticleGraphContainerType::Sparse)
     {
-        data_ = context.layer_->GetAttributeValues<T>(pinRef.index_).data_;
-        indices_ = context.indices_.data();
+        // Active particles are dense, so attribute values are accessed directly
+        const unsigned firstIndex = context.indices_.empty() ? 0 : context.indices_.front();
+        type_ = ParticleGraphContainerType::Span;
+        data_ = context.layer_->GetSparse<T>(pinRef.index_, context.indices_).data_ + firstIndex;
+        indices_ = nullptr;
     }
     else
     {
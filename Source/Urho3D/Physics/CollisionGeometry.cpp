@@ -0,0 +1,418 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Physics/CollisionGeometry.h"
+
+#include "../Core/Context.h"
+#include "../Graphics/Geometry.h"
+#include "../Graphics/Model.h"
+#include "../Graphics/VertexBuffer.h"
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+#include "../IO/MemoryMappedFile.h"
+#include "../Physics/CollisionShape.h"
+#include "../Resource/ResourceCache.h"
+
+#include <Bullet/BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <Bullet/BulletCollision/CollisionShapes/btOptimizedBvh.h>
+#include <Bullet/BulletCollision/CollisionShapes/btTriangleInfoMap.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+const unsigned CollisionGeometryVersion = 1;
+
+/// Return pointer to the data at current position and skip it. Return null if out of bounds.
+const unsigned char* SkipData(MemoryBuffer& buffer, const unsigned char* data, unsigned size)
+{
+    const unsigned position = buffer.GetPosition();
+    if (size > buffer.GetSize() - position)
+        return nullptr;
+    buffer.Seek(position + size);
+    return data + position;
+}
+
+bool IsAligned(const void* ptr, unsigned alignment)
+{
+    return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+}
+
+}
+
+CollisionGeometry::CollisionGeometry(Context* context)
+    : Resource(context)
+{
+}
+
+CollisionGeometry::~CollisionGeometry() = default;
+
+void CollisionGeometry::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<CollisionGeometry>();
+}
+
+bool CollisionGeometry::BeginLoad(Deserializer& source)
+{
+    ResetData();
+
+    // Reference the data directly if the file is mapped into memory
+    if (auto view = dynamic_cast<MemoryMappedFileView*>(&source))
+    {
+        mapping_ = view->GetMapping();
+        if (!ParseData(view->GetData(), view->GetSize()))
+        {
+            ResetData();
+            return false;
+        }
+        SetMemoryUse(sizeof(CollisionGeometry));
+        return true;
+    }
+
+    auto cache = GetSubsystem<ResourceCache>();
+    const ea::string fileName = cache->GetResourceFileName(GetName());
+    if (!fileName.empty())
+    {
+        auto mapping = MakeShared<MemoryMappedFile>();
+        if (mapping->Open(fileName) && mapping->GetSize() == source.GetSize())
+        {
+            mapping_ = mapping;
+            if (!ParseData(mapping->GetData(), mapping->GetSize()))
+            {
+                ResetData();
+                return false;
+            }
+            SetMemoryUse(sizeof(CollisionGeometry));
+            return true;
+        }
+    }
+
+    // Fall back to reading the whole file
+    source.Seek(0);
+    fileData_.resize(source.GetSize());
+    if (source.Read(fileData_.data(), fileData_.size()) != fileData_.size() || !ParseData(fileData_.data(), fileData_.size()))
+    {
+        ResetData();
+        return false;
+    }
+    SetMemoryUse(sizeof(CollisionGeometry) + fileData_.size());
+    return true;
+}
+
+bool CollisionGeometry::Save(Serializer& dest) const
+{
+    dest.WriteFileID("UCGE");
+    dest.WriteUInt(CollisionGeometryVersion);
+    dest.WriteUInt(sizeof(void*));
+    dest.WriteUInt(numVertices_);
+    dest.WriteUInt(numIndices_);
+    dest.WriteUInt(bvhSize_);
+    dest.WriteUInt(triangleInfos_.size());
+    dest.WriteUInt(hullVertices_.size());
+    dest.WriteUInt(hullIndices_.size());
+
+    dest.Write(vertices_, numVertices_ * sizeof(Vector3));
+    dest.Write(indices_, numIndices_ * sizeof(unsigned));
+    dest.Write(bvhData_, bvhSize_);
+    for (const CollisionTriangleInfo& info : triangleInfos_)
+    {
+        dest.WriteInt(info.key_);
+        dest.WriteInt(info.flags_);
+        dest.WriteVector3(info.edgeAngles_);
+    }
+    dest.Write(hullVertices_.data(), hullVertices_.size() * sizeof(Vector3));
+    if (dest.Write(hullIndices_.data(), hullIndices_.size() * sizeof(unsigned)) != hullIndices_.size() * sizeof(unsigned))
+    {
+        URHO3D_LOGERROR("Can not save collision geometry " + GetName());
+        return false;
+    }
+
+    return true;
+}
+
+bool CollisionGeometry::Bake(Model* model, unsigned lodLevel, bool triangleMesh, bool convexHull)
+{
+    ResetData();
+
+    if (triangleMesh)
+    {
+        // Merge geometries into single mesh with 32-bit indices, copy only referenced vertices
+        const unsigned numGeometries = model->GetNumGeometries();
+        for (unsigned i = 0; i < numGeometries; ++i)
+        {
+            Geometry* geometry = model->GetGeometry(i, lodLevel);
+            if (!geometry)
+                continue;
+
+            const unsigned char* vertexData;
+            const unsigned char* indexData;
+            unsigned vertexSize;
+            unsigned indexSize;
+            const ea::vector<VertexElement>* elements;
+
+            geometry->GetRawData(vertexData, vertexSize, indexData, indexSize, elements);
+            if (!vertexData || !indexData || !elements || VertexBuffer::GetElementOffset(*elements, TYPE_VECTOR3, SEM_POSITION) != 0)
+            {
+                URHO3D_LOGWARNING("Skipping geometry with no or unsuitable CPU-side geometry data for baked triangle mesh");
+                continue;
+            }
+
+            const unsigned indexStart = geometry->GetIndexStart();
+            const unsigned indexCount = geometry->GetIndexCount() / 3 * 3;
+            if (!indexCount)
+                continue;
+
+            const auto readIndex = [&](unsigned index)
+            {
+                return indexSize == sizeof(unsigned short)
+                    ? static_cast<unsigned>(reinterpret_cast<const unsigned short*>(indexData)[index])
+                    : reinterpret_cast<const unsigned*>(indexData)[index];
+            };
+
+            unsigned minVertex = M_MAX_UNSIGNED;
+            unsigned maxVertex = 0;
+            for (unsigned j = indexStart; j < indexStart + indexCount; ++j)
+            {
+                minVertex = Min(minVertex, readIndex(j));
+                maxVertex = Max(maxVertex, readIndex(j));
+            }
+
+            const unsigned baseVertex = vertexStorage_.size();
+            for (unsigned j = minVertex; j <= maxVertex; ++j)
+                vertexStorage_.push_back(*reinterpret_cast<const Vector3*>(&vertexData[j * vertexSize]));
+            for (unsigned j = indexStart; j < indexStart + indexCount; ++j)
+                indexStorage_.push_back(baseVertex + readIndex(j) - minVertex);
+        }
+
+        vertices_ = vertexStorage_.data();
+        numVertices_ = vertexStorage_.size();
+        indices_ = indexStorage_.data();
+        numIndices_ = indexStorage_.size();
+
+        if (numIndices_)
+        {
+            // Build BVH and internal edge info the same way as at runtime, then store them
+            const auto data = MakeShared<TriangleMeshData>(this);
+
+            btOptimizedBvh* bvh = data->shape_->getOptimizedBvh();
+            const unsigned bvhSize = bvh->calculateSerializeBufferSize();
+            void* buffer = btAlignedAlloc(bvhSize, 16);
+            if (bvh->serializeInPlace(buffer, bvhSize, false))
+            {
+                const auto bytes = static_cast<const unsigned char*>(buffer);
+                bvhStorage_.assign(bytes, bytes + bvhSize);
+                bvhData_ = bvhStorage_.data();
+                bvhSize_ = bvhSize;
+            }
+            btAlignedFree(buffer);
+
+            const btTriangleInfoMap& infoMap = *data->infoMap_;
+            triangleInfos_.resize(infoMap.size());
+            for (int i = 0; i < infoMap.size(); ++i)
+            {
+                const btTriangleInfo* info = infoMap.getAtIndex(i);
+                CollisionTriangleInfo& dest = triangleInfos_[i];
+                dest.key_ = infoMap.getKeyAtIndex(i).getUid1();
+                dest.flags_ = info->m_flags;
+                dest.edgeAngles_ = Vector3(info->m_edgeV0V1Angle, info->m_edgeV1V2Angle, info->m_edgeV2V0Angle);
+            }
+        }
+    }
+
+    if (convexHull)
+    {
+        const auto data = MakeShared<ConvexData>(model, lodLevel);
+        hullVertices_.assign(data->vertexData_.get(), data->vertexData_.get() + data->vertexCount_);
+        hullIndices_.assign(data->indexData_.get(), data->indexData_.get() + data->indexCount_);
+    }
+
+    if (!HasTriangleMesh() && !HasConvexHull())
+    {
+        URHO3D_LOGERROR("Cannot bake collision geometry of model '{}' LOD {}: no suitable geometry", model->GetName(), lodLevel);
+        return false;
+    }
+
+    return true;
+}
+
+ea::string CollisionGeometry::GetBakedName(const ea::string& modelName, unsigned lodLevel)
+{
+    const ea::string baseName = ReplaceExtension(modelName, "");
+    return lodLevel == 0 ? baseName + ".colgeo" : Format("{}_LOD{}.colgeo", baseName, lodLevel);
+}
+
+void CollisionGeometry::ResetData()
+{
+    mapping_ = nullptr;
+    fileData_.clear();
+    vertexStorage_.clear();
+    indexStorage_.clear();
+    bvhStorage_.clear();
+
+    vertices_ = nullptr;
+    numVertices_ = 0;
+    indices_ = nullptr;
+    numIndices_ = 0;
+    bvhData_ = nullptr;
+    bvhSize_ = 0;
+    triangleInfos_.clear();
+    hullVertices_.clear();
+    hullIndices_.clear();
+}
+
+bool CollisionGeometry::ParseData(const unsigned char* data, unsigned size)
+{
+    MemoryBuffer buffer(data, size);
+    if (buffer.ReadFileID() != "UCGE")
+    {
+        URHO3D_LOGERROR("{} is not a valid collision geometry file", GetName());
+        return false;
+    }
+
+    const unsigned version = buffer.ReadUInt();
+    if (version != CollisionGeometryVersion)
+    {
+        URHO3D_LOGERROR("Unsupported version {} of collision geometry file {}", version, GetName());
+        return false;
+    }
+
+    const unsigned pointerSize = buffer.ReadUInt();
+    numVertices_ = buffer.ReadUInt();
+    numIndices_ = buffer.ReadUInt();
+    bvhSize_ = buffer.ReadUInt();
+    const unsigned numTriangleInfos = buffer.ReadUInt();
+    const unsigned numHullVertices = buffer.ReadUInt();
+    const unsigned numHullIndices = buffer.ReadUInt();
+
+    const unsigned char* vertexData = SkipData(buffer, data, numVertices_ * sizeof(Vector3));
+    const unsigned char* indexData = SkipData(buffer, data, numIndices_ * sizeof(unsigned));
+    bvhData_ = SkipData(buffer, data, bvhSize_);
+    if (!vertexData || !indexData || !bvhData_)
+    {
+        URHO3D_LOGERROR("Collision geometry file {} is truncated", GetName());
+        return false;
+    }
+
+    // Triangle data is referenced in place unless misaligned
+    if (IsAligned(vertexData, alignof(Vector3)) && IsAligned(indexData, alignof(unsigned)))
+    {
+        vertices_ = reinterpret_cast<const Vector3*>(vertexData);
+        indices_ = reinterpret_cast<const unsigned*>(indexData);
+    }
+    else
+    {
+        vertexStorage_.resize(numVertices_);
+        indexStorage_.resize(numIndices_);
+        memcpy(vertexStorage_.data(), vertexData, numVertices_ * sizeof(Vector3));
+        memcpy(indexStorage_.data(), indexData, numIndices_ * sizeof(unsigned));
+        vertices_ = vertexStorage_.data();
+        indices_ = indexStorage_.data();
+    }
+
+    // Serialized BVH contains object layout of the platform it was baked on
+    if (pointerSize != sizeof(void*))
+    {
+        bvhData_ = nullptr;
+        bvhSize_ = 0;
+    }
+
+    triangleInfos_.resize(numTriangleInfos);
+    for (CollisionTriangleInfo& info : triangleInfos_)
+    {
+        info.key_ = buffer.ReadInt();
+        info.flags_ = buffer.ReadInt();
+        info.edgeAngles_ = buffer.ReadVector3();
+    }
+
+    hullVertices_.resize(numHullVertices);
+    hullIndices_.resize(numHullIndices);
+    const unsigned hullVertexBytes = numHullVertices * sizeof(Vector3);
+    const unsigned hullIndexBytes = numHullIndices * sizeof(unsigned);
+    if (buffer.Read(hullVertices_.data(), hullVertexBytes) != hullVertexBytes
+        || buffer.Read(hullIndices_.data(), hullIndexBytes) != hullIndexBytes)
+    {
+        URHO3D_LOGERROR("Collision geometry file {} is truncated", GetName());
+        return false;
+    }
+
+    return true;
+}
+
+CollisionGeometryBaker::CollisionGeometryBaker(Context* context)
+    : AssetTransformer(context)
+{
+}
+
+CollisionGeometryBaker::~CollisionGeometryBaker()
+{
+}
+
+void CollisionGeometryBaker::RegisterObject(Context* context)
+{
+    context->RegisterFactory<CollisionGeometryBaker>(Category_Transformer);
+
+    URHO3D_ATTRIBUTE("Triangle Mesh", bool, triangleMesh_, true, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Convex Hull", bool, convexHull_, true, AM_DEFAULT);
+}
+
+bool CollisionGeometryBaker::IsApplicable(const AssetTransformerInput& input)
+{
+    return input.inputFileName_.ends_with(".mdl", false);
+}
+
+bool CollisionGeometryBaker::Execute(
+    const AssetTransformerInput& input, AssetTransformerOutput& output, const AssetTransformerVector& transformers)
+{
+    auto cache = GetSubsystem<ResourceCache>();
+    auto model = cache->GetResource<Model>(input.resourceName_);
+    if (!model)
+        return false;
+
+    unsigned numLodLevels = 0;
+    for (unsigned i = 0; i < model->GetNumGeometries(); ++i)
+        numLodLevels = ea::max(numLodLevels, model->GetNumGeometryLodLevels(i));
+
+    for (unsigned lodLevel = 0; lodLevel < numLodLevels; ++lodLevel)
+    {
+        auto geometry = MakeShared<CollisionGeometry>(context_);
+        if (!geometry->Bake(model, lodLevel, triangleMesh_, convexHull_))
+            return false;
+
+        const ea::string resourceName = CollisionGeometry::GetBakedName(input.resourceName_, lodLevel);
+        geometry->SetName(resourceName);
+        if (!geometry->SaveFile(CollisionGeometry::GetBakedName(model->GetAbsoluteFileName(), lodLevel)))
+            return false;
+
+        output.outputResourceNames_.push_back(resourceName);
+    }
+
+    return numLodLevels != 0;
+}
+
+}
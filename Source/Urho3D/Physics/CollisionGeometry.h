@@ -0,0 +1,159 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+/// \file
+
+#pragma once
+
+#include "../Container/ByteVector.h"
+#include "../Math/Vector3.h"
+#include "../Resource/Resource.h"
+#include "../Utility/AssetTransformer.h"
+
+namespace Urho3D
+{
+
+class MemoryMappedFile;
+class Model;
+
+/// Internal edge info of a single triangle of baked triangle mesh.
+struct CollisionTriangleInfo
+{
+    /// Triangle key as used by Bullet: part index and triangle index.
+    int key_{};
+    /// Edge flags.
+    int flags_{};
+    /// Angles of V0V1, V1V2 and V2V0 edges.
+    Vector3 edgeAngles_;
+};
+
+/// Collision geometry of the model LOD baked offline.
+/// Contains merged triangle mesh with serialized BVH and internal edge info, and precomputed convex hull.
+/// Triangle data is used in place when the file is memory mapped.
+class URHO3D_API CollisionGeometry : public Resource
+{
+    URHO3D_OBJECT(CollisionGeometry, Resource);
+
+public:
+    /// Construct.
+    explicit CollisionGeometry(Context* context);
+    /// Destruct.
+    ~CollisionGeometry() override;
+    /// Register object factory.
+    static void RegisterObject(Context* context);
+
+    /// Load resource from stream. May be called from a worker thread. Return true if successful.
+    bool BeginLoad(Deserializer& source) override;
+    /// Save resource. Return true if successful.
+    bool Save(Serializer& dest) const override;
+
+    /// Bake triangle mesh and convex hull from model LOD. Return true if successful.
+    bool Bake(Model* model, unsigned lodLevel, bool triangleMesh = true, bool convexHull = true);
+    /// Return name of baked collision geometry for model LOD. Works for both resource and file names.
+    static ea::string GetBakedName(const ea::string& modelName, unsigned lodLevel);
+
+    /// Return whether the triangle mesh is present.
+    bool HasTriangleMesh() const { return numIndices_ != 0; }
+    /// Return whether the convex hull is present.
+    bool HasConvexHull() const { return !hullIndices_.empty(); }
+    /// Return whether the data is used directly from memory mapped file.
+    bool IsMemoryMapped() const { return mapping_ != nullptr; }
+
+    /// Return triangle mesh vertices.
+    const Vector3* GetVertices() const { return vertices_; }
+    /// Return number of triangle mesh vertices.
+    unsigned GetNumVertices() const { return numVertices_; }
+    /// Return triangle mesh indices.
+    const unsigned* GetIndices() const { return indices_; }
+    /// Return number of triangle mesh indices.
+    unsigned GetNumIndices() const { return numIndices_; }
+    /// Return serialized BVH of the triangle mesh. May be empty if it was baked on the platform with different layout.
+    const unsigned char* GetBvhData() const { return bvhData_; }
+    /// Return size of serialized BVH.
+    unsigned GetBvhSize() const { return bvhSize_; }
+    /// Return internal edge info of the triangle mesh.
+    const ea::vector<CollisionTriangleInfo>& GetTriangleInfos() const { return triangleInfos_; }
+    /// Return convex hull vertices.
+    const ea::vector<Vector3>& GetHullVertices() const { return hullVertices_; }
+    /// Return convex hull indices.
+    const ea::vector<unsigned>& GetHullIndices() const { return hullIndices_; }
+
+private:
+    /// Reset all data.
+    void ResetData();
+    /// Parse data in memory. Triangle data is referenced, not copied.
+    bool ParseData(const unsigned char* data, unsigned size);
+
+    /// Memory mapped file that owns the data.
+    SharedPtr<MemoryMappedFile> mapping_;
+    /// Owned file data if the file is not memory mapped.
+    ByteVector fileData_;
+    /// Owned vertices after baking.
+    ea::vector<Vector3> vertexStorage_;
+    /// Owned indices after baking.
+    ea::vector<unsigned> indexStorage_;
+    /// Owned serialized BVH after baking.
+    ByteVector bvhStorage_;
+
+    /// Triangle mesh vertices.
+    const Vector3* vertices_{};
+    /// Number of triangle mesh vertices.
+    unsigned numVertices_{};
+    /// Triangle mesh indices.
+    const unsigned* indices_{};
+    /// Number of triangle mesh indices.
+    unsigned numIndices_{};
+    /// Serialized BVH.
+    const unsigned char* bvhData_{};
+    /// Size of serialized BVH.
+    unsigned bvhSize_{};
+    /// Internal edge info.
+    ea::vector<CollisionTriangleInfo> triangleInfos_;
+    /// Convex hull vertices.
+    ea::vector<Vector3> hullVertices_;
+    /// Convex hull indices.
+    ea::vector<unsigned> hullIndices_;
+};
+
+/// Asset transformer that bakes collision geometry of the model for every LOD level.
+/// CollisionShape uses baked geometry instead of building BVH and convex hull at runtime.
+class URHO3D_API CollisionGeometryBaker : public AssetTransformer
+{
+    URHO3D_OBJECT(CollisionGeometryBaker, AssetTransformer);
+
+public:
+    CollisionGeometryBaker(Context* context);
+    ~CollisionGeometryBaker() override;
+    static void RegisterObject(Context* context);
+
+    bool IsApplicable(const AssetTransformerInput& input) override;
+    bool Execute(const AssetTransformerInput& input, AssetTransformerOutput& output,
+        const AssetTransformerVector& transformers) override;
+    bool IsExecutedOnOutput() override { return true; }
+
+private:
+    bool triangleMesh_{true};
+    bool convexHull_{true};
+};
+
+}
@@ -33,6 +33,7 @@
 #include "../Graphics/Terrain.h"
 #include "../Graphics/VertexBuffer.h"
 #include "../IO/Log.h"
+#include "../Physics/CollisionGeometry.h"
 #include "../Physics/CollisionShape.h"
 #include "../Physics/PhysicsUtils.h"
 #include "../Physics/PhysicsWorld.h"
@@ -49,6 +50,7 @@
 #include <Bullet/BulletCollision/CollisionShapes/btConvexHullShape.h>
 #include <Bullet/BulletCollision/CollisionShapes/btCylinderShape.h>
 #include <Bullet/BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
+#include <Bullet/BulletCollision/CollisionShapes/btOptimizedBvh.h>
 #include <Bullet/BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
 #include <Bullet/BulletCollision/CollisionShapes/btSphereShape.h>
 #include <Bullet/BulletCollision/CollisionShapes/btTriangleIndexVertexArray.h>
@@ -186,6 +188,24 @@ public:
         useQuantize_ = totalTriangles <= QUANTIZE_MAX_TRIANGLES;
     }
 
+    explicit TriangleMeshInterface(CollisionGeometry* baked) :
+        btTriangleIndexVertexArray()
+    {
+        // Baked data is owned by the resource and may be memory mapped, Bullet only reads it
+        btIndexedMesh meshIndex;
+        meshIndex.m_numTriangles = baked->GetNumIndices() / 3;
+        meshIndex.m_triangleIndexBase = reinterpret_cast<const unsigned char*>(baked->GetIndices());
+        meshIndex.m_triangleIndexStride = 3 * sizeof(unsigned);
+        meshIndex.m_numVertices = baked->GetNumVertices();
+        meshIndex.m_vertexBase = reinterpret_cast<const unsigned char*>(baked->GetVertices());
+        meshIndex.m_vertexStride = sizeof(Vector3);
+        meshIndex.m_indexType = PHY_INTEGER;
+        meshIndex.m_vertexType = PHY_FLOAT;
+        m_indexedMeshes.push_back(meshIndex);
+
+        useQuantize_ = meshIndex.m_numTriangles <= QUANTIZE_MAX_TRIANGLES;
+    }
+
     /// OK to use quantization flag.
     bool useQuantize_;
 
@@ -212,8 +232,61 @@ TriangleMeshData::TriangleMeshData(CustomGeometry* custom)
     btGenerateInternalEdgeInfo(shape_.get(), infoMap_.get());
 }
 
+TriangleMeshData::TriangleMeshData(CollisionGeometry* baked) :
+    baked_(baked)
+{
+    meshInterface_ = ea::make_unique<TriangleMeshInterface>(baked);
+    shape_ = ea::make_unique<btBvhTriangleMeshShape>(meshInterface_.get(), meshInterface_->useQuantize_, false);
+
+    // Deserialization patches the BVH in place, so it cannot use read-only mapped memory directly
+    btOptimizedBvh* bvh = nullptr;
+    if (baked->GetBvhData())
+    {
+        bvhBuffer_ = btAlignedAlloc(baked->GetBvhSize(), 16);
+        memcpy(bvhBuffer_, baked->GetBvhData(), baked->GetBvhSize());
+        bvh = btOptimizedBvh::deSerializeInPlace(bvhBuffer_, baked->GetBvhSize(), false);
+
+        // Data may be corrupted or serialized with different layout, BVH will be built from scratch then
+        if (!bvh)
+        {
+            btAlignedFree(bvhBuffer_);
+            bvhBuffer_ = nullptr;
+        }
+    }
+    if (bvh)
+        shape_->setOptimizedBvh(bvh);
+    else
+        shape_->buildOptimizedBvh();
+
+    infoMap_ = ea::make_unique<btTriangleInfoMap>();
+    const ea::vector<CollisionTriangleInfo>& triangleInfos = baked->GetTriangleInfos();
+    if (!triangleInfos.empty())
+    {
+        for (const CollisionTriangleInfo& info : triangleInfos)
+        {
+            btTriangleInfo triangleInfo;
+            triangleInfo.m_flags = info.flags_;
+            triangleInfo.m_edgeV0V1Angle = info.edgeAngles_.x_;
+            triangleInfo.m_edgeV1V2Angle = info.edgeAngles_.y_;
+            triangleInfo.m_edgeV2V0Angle = info.edgeAngles_.z_;
+            infoMap_->insert(info.key_, triangleInfo);
+        }
+        shape_->setTriangleInfoMap(infoMap_.get());
+    }
+    else
+        btGenerateInternalEdgeInfo(shape_.get(), infoMap_.get());
+}
+
 TriangleMeshData::~TriangleMeshData()
 {
+    if (bvhBuffer_)
+    {
+        // The shape does not own deserialized BVH
+        if (btOptimizedBvh* bvh = shape_->getOptimizedBvh())
+            bvh->~btOptimizedBvh();
+        shape_.reset();
+        btAlignedFree(bvhBuffer_);
+    }
 }
 
 GImpactMeshData::GImpactMeshData(Model* model, unsigned lodLevel)
@@ -226,6 +299,12 @@ GImpactMeshData::GImpactMeshData(CustomGeometry* custom)
     meshInterface_ = ea::make_unique<TriangleMeshInterface>(custom);
 }
 
+GImpactMeshData::GImpactMeshData(CollisionGeometry* baked) :
+    baked_(baked)
+{
+    meshInterface_ = ea::make_unique<TriangleMeshInterface>(baked);
+}
+
 GImpactMeshData::~GImpactMeshData()
 {
 }
@@ -285,6 +364,20 @@ ConvexData::ConvexData(CustomGeometry* custom)
     BuildHull(vertices);
 }
 
+ConvexData::ConvexData(CollisionGeometry* baked)
+{
+    const ea::vector<Vector3>& hullVertices = baked->GetHullVertices();
+    const ea::vector<unsigned>& hullIndices = baked->GetHullIndices();
+
+    vertexCount_ = hullVertices.size();
+    vertexData_ = new Vector3[vertexCount_];
+    indexCount_ = hullIndices.size();
+    indexData_ = new unsigned[indexCount_];
+
+    ea::copy(hullVertices.begin(), hullVertices.end(), vertexData_.get());
+    ea::copy(hullIndices.begin(), hullIndices.end(), indexData_.get());
+}
+
 void ConvexData::BuildHull(const ea::vector<Vector3>& vertices)
 {
     if (vertices.size())
@@ -400,8 +493,29 @@ bool HasDynamicBuffers(Model* model, unsigned lodLevel)
     return false;
 }
 
+CollisionGeometry* GetBakedCollisionGeometry(Model* model, unsigned lodLevel)
+{
+    auto cache = model->GetSubsystem<ResourceCache>();
+    const ea::string name = CollisionGeometry::GetBakedName(model->GetName(), lodLevel);
+    return !model->GetName().empty() && cache->Exists(name) ? cache->GetResource<CollisionGeometry>(name) : nullptr;
+}
+
 CollisionGeometryData* CreateCollisionGeometryData(ShapeType shapeType, Model* model, unsigned lodLevel)
 {
+    // Prefer geometry baked at import time
+    if (shapeType == SHAPE_TRIANGLEMESH || shapeType == SHAPE_CONVEXHULL || shapeType == SHAPE_GIMPACTMESH)
+    {
+        if (CollisionGeometry* baked = GetBakedCollisionGeometry(model, lodLevel))
+        {
+            if (shapeType == SHAPE_CONVEXHULL && baked->HasConvexHull())
+                return new ConvexData(baked);
+            if (shapeType == SHAPE_TRIANGLEMESH && baked->HasTriangleMesh())
+                return new TriangleMeshData(baked);
+            if (shapeType == SHAPE_GIMPACTMESH && baked->HasTriangleMesh())
+                return new GImpactMeshData(baked);
+        }
+    }
+
     switch (shapeType)
     {
     case SHAPE_TRIANGLEMESH:
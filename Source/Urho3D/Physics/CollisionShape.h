@@ -41,6 +41,7 @@ struct btTriangleInfoMap;
 namespace Urho3D
 {
 
+class CollisionGeometry;
 class CustomGeometry;
 class Geometry;
 class Model;
@@ -80,14 +81,20 @@ struct TriangleMeshData : public CollisionGeometryData
     TriangleMeshData(Model* model, unsigned lodLevel);
     /// Construct from a custom geometry.
     explicit TriangleMeshData(CustomGeometry* custom);
+    /// Construct from a baked collision geometry. BVH and edge info are built only if missing.
+    explicit TriangleMeshData(CollisionGeometry* baked);
     ~TriangleMeshData();
 
+    /// Baked collision geometry that owns the triangle data, if any.
+    SharedPtr<CollisionGeometry> baked_;
     /// Bullet triangle mesh interface.
     ea::unique_ptr<TriangleMeshInterface> meshInterface_;
     /// Bullet triangle mesh collision shape.
     ea::unique_ptr<btBvhTriangleMeshShape> shape_;
     /// Bullet triangle info map.
     ea::unique_ptr<btTriangleInfoMap> infoMap_;
+    /// Aligned buffer of deserialized BVH, if any.
+    void* bvhBuffer_{};
 };
 
 /// Triangle mesh geometry data.
@@ -97,8 +104,12 @@ struct GImpactMeshData : public CollisionGeometryData
     GImpactMeshData(Model* model, unsigned lodLevel);
     /// Construct from a custom geometry.
     explicit GImpactMeshData(CustomGeometry* custom);
+    /// Construct from a baked collision geometry.
+    explicit GImpactMeshData(CollisionGeometry* baked);
     ~GImpactMeshData();
 
+    /// Baked collision geometry that owns the triangle data, if any.
+    SharedPtr<CollisionGeometry> baked_;
     /// Bullet triangle mesh interface.
     ea::unique_ptr<TriangleMeshInterface> meshInterface_;
 };
@@ -110,6 +121,8 @@ struct ConvexData : public CollisionGeometryData
     ConvexData(Model* model, unsigned lodLevel);
     /// Construct from a custom geometry.
     explicit ConvexData(CustomGeometry* custom);
+    /// Construct from a baked collision geometry.
+    explicit ConvexData(CollisionGeometry* baked);
 
     /// Build the convex hull from vertices.
     void BuildHull(const ea::vector<Vector3>& vertices);
@@ -46,6 +46,7 @@ public:
     /// Register object factory and attributes.
     static void RegisterObject(Context* context);
     void OnSetAttribute(const AttributeInfo& attr, const Variant& src) override;
+    bool HasDirectAttributeAccess() const override { return false; }
 
     /// Perform post-load after deserialization. Acquire the components from the scene nodes.
     void ApplyAttributes() override;
@@ -27,11 +27,13 @@
 #include "../Core/Context.h"
 #include "../Core/Mutex.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../Graphics/Model.h"
 #include "../IO/Log.h"
 #include "../Math/Ray.h"
 #include "../Physics/KinematicCharacterController.h"
+#include "../Physics/CollisionGeometry.h"
 #include "../Physics/CollisionShape.h"
 #include "../Physics/Constraint.h"
 #include "../Physics/PhysicsEvents.h"
@@ -43,69 +45,240 @@
 #include "../Scene/SceneEvents.h"
 
 #include <Bullet/BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <Bullet/BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
 #include <Bullet/BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
 #include <Bullet/BulletCollision/CollisionDispatch/btInternalEdgeUtility.h>
 #include <Bullet/BulletCollision/CollisionShapes/btBoxShape.h>
 #include <Bullet/BulletCollision/CollisionShapes/btSphereShape.h>
 #include <Bullet/BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h>
 #include <Bullet/BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
+#include <Bullet/BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
 #include <Bullet/BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <Bullet/BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 
 extern ContactAddedCallback gContactAddedCallback;
 
+template <class T>
 ATTRIBUTE_ALIGNED16(class)
-btCustomDiscreteDynamicsWorld : public btDiscreteDynamicsWorld
+btCustomDynamicsWorld : public T
 {
 public:
-    using btDiscreteDynamicsWorld::btDiscreteDynamicsWorld;
+    using T::T;
 
     void customStepSimulation(unsigned clampedSimulationSteps, btScalar fixedTimeStep, btScalar overtime)
     {
-        m_fixedTimeStep = fixedTimeStep;
-        m_localTime = overtime;
+        this->m_fixedTimeStep = fixedTimeStep;
+        this->m_localTime = overtime;
 
-        if (getDebugDrawer())
+        if (this->getDebugDrawer())
         {
-            btIDebugDraw* debugDrawer = getDebugDrawer();
+            btIDebugDraw* debugDrawer = this->getDebugDrawer();
             gDisableDeactivation = (debugDrawer->getDebugMode() & btIDebugDraw::DBG_NoDeactivation) != 0;
         }
 
         if (clampedSimulationSteps > 0)
         {
-            saveKinematicState(fixedTimeStep * clampedSimulationSteps);
+            this->saveKinematicState(fixedTimeStep * clampedSimulationSteps);
 
             for (int i = 0; i < clampedSimulationSteps; i++)
             {
                 // Urho3D: apply gravity on each substep
-                applyGravity();
+                this->applyGravity();
 
-                internalSingleStepSimulation(fixedTimeStep);
-                synchronizeMotionStates();
+                this->internalSingleStepSimulation(fixedTimeStep);
+                this->synchronizeMotionStates();
 
                 // Urho3D: clear forces on each substep
-                clearForces();
+                this->clearForces();
             }
         }
         else
         {
-            synchronizeMotionStates();
+            this->synchronizeMotionStates();
         }
 
-        clearForces();
+        this->clearForces();
     }
 
-    btScalar getLocalTime() const { return m_localTime; }
+    btScalar getLocalTime() const { return this->m_localTime; }
 };
 
+using btCustomDiscreteDynamicsWorld = btCustomDynamicsWorld<btDiscreteDynamicsWorld>;
+#if BT_THREADSAFE
+using btCustomDiscreteDynamicsWorldMt = btCustomDynamicsWorld<btDiscreteDynamicsWorldMt>;
+#endif
+
 namespace Urho3D
 {
 
 static const int MAX_SOLVER_ITERATIONS = 256;
 static const Vector3 DEFAULT_GRAVITY = Vector3(0.0f, -9.81f, 0.0f);
+static const unsigned RAYCAST_BATCH_SIZE = 64;
+static const unsigned OVERLAP_BATCH_SIZE = 16;
 
 PhysicsWorldConfig PhysicsWorld::config;
 
+static const char* lodModeNames[] =
+{
+    "Reduced Sync",
+    "Freeze",
+    nullptr
+};
+
+namespace
+{
+
+#if BT_THREADSAFE
+/// Bullet task scheduler that executes parallel loops on WorkQueue.
+class WorkQueueTaskScheduler : public btITaskScheduler
+{
+public:
+    WorkQueueTaskScheduler() : btITaskScheduler("WorkQueue") {}
+
+    /// Set work queue to execute tasks on.
+    void SetWorkQueue(WorkQueue* workQueue) { workQueue_ = workQueue; }
+
+    int getMaxNumThreads() const override { return BT_MAX_THREAD_COUNT; }
+    int getNumThreads() const override { return workQueue_ ? workQueue_->GetNumThreads() + 1 : 1; }
+    void setNumThreads(int /*numThreads*/) override {}
+
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override
+    {
+        if (iBegin >= iEnd)
+            return;
+
+        if (!workQueue_ || workQueue_->GetNumThreads() == 0)
+        {
+            body.forLoop(iBegin, iEnd);
+            return;
+        }
+
+        const auto size = static_cast<unsigned>(iEnd - iBegin);
+        const auto bucket = static_cast<unsigned>(ea::max(grainSize, 1));
+        ForEachParallel(workQueue_, bucket, size,
+            [&](unsigned beginIndex, unsigned endIndex) { body.forLoop(iBegin + beginIndex, iBegin + endIndex); });
+    }
+
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override
+    {
+        if (iBegin >= iEnd)
+            return 0;
+
+        if (!workQueue_ || workQueue_->GetNumThreads() == 0)
+            return body.sumLoop(iBegin, iEnd);
+
+        Mutex mutex;
+        btScalar sum = 0;
+        const auto size = static_cast<unsigned>(iEnd - iBegin);
+        const auto bucket = static_cast<unsigned>(ea::max(grainSize, 1));
+        ForEachParallel(workQueue_, bucket, size, [&](unsigned beginIndex, unsigned endIndex)
+        {
+            const btScalar partialSum = body.sumLoop(iBegin + beginIndex, iBegin + endIndex);
+            MutexLock<Mutex> lock(mutex);
+            sum += partialSum;
+        });
+        return sum;
+    }
+
+private:
+    WeakPtr<WorkQueue> workQueue_;
+};
+
+WorkQueueTaskScheduler* GetWorkQueueTaskScheduler(WorkQueue* workQueue)
+{
+    static WorkQueueTaskScheduler taskScheduler;
+    taskScheduler.SetWorkQueue(workQueue);
+    if (btGetTaskScheduler() != &taskScheduler)
+        btSetTaskScheduler(&taskScheduler);
+    return &taskScheduler;
+}
+#endif
+
+void PerformRaycastSingle(const btCollisionWorld* world, PhysicsRaycastResult& result, const Ray& ray, float maxDistance,
+    unsigned collisionMask)
+{
+    btCollisionWorld::ClosestRayResultCallback
+        rayCallback(ToBtVector3(ray.origin_), ToBtVector3(ray.origin_ + maxDistance * ray.direction_));
+    rayCallback.m_collisionFilterGroup = (short)0xffff;
+    rayCallback.m_collisionFilterMask = (short)collisionMask;
+
+    world->rayTest(rayCallback.m_rayFromWorld, rayCallback.m_rayToWorld, rayCallback);
+
+    if (rayCallback.hasHit())
+    {
+        result.position_ = ToVector3(rayCallback.m_hitPointWorld);
+        result.normal_ = ToVector3(rayCallback.m_hitNormalWorld);
+        result.distance_ = (result.position_ - ray.origin_).Length();
+        result.hitFraction_ = rayCallback.m_closestHitFraction;
+        result.body_ = static_cast<RigidBody*>(rayCallback.m_collisionObject->getUserPointer());
+    }
+    else
+    {
+        result.position_ = Vector3::ZERO;
+        result.normal_ = Vector3::ZERO;
+        result.distance_ = M_INFINITY;
+        result.hitFraction_ = 0.0f;
+        result.body_ = nullptr;
+    }
+}
+
+void PerformSphereCast(const btCollisionWorld* world, PhysicsRaycastResult& result, const Ray& ray, float radius,
+    float maxDistance, unsigned collisionMask)
+{
+    btSphereShape shape(radius);
+    Vector3 endPos = ray.origin_ + maxDistance * ray.direction_;
+
+    btCollisionWorld::ClosestConvexResultCallback
+        convexCallback(ToBtVector3(ray.origin_), ToBtVector3(endPos));
+    convexCallback.m_collisionFilterGroup = (short)0xffff;
+    convexCallback.m_collisionFilterMask = (short)collisionMask;
+
+    world->convexSweepTest(&shape, btTransform(btQuaternion::getIdentity(), convexCallback.m_convexFromWorld),
+        btTransform(btQuaternion::getIdentity(), convexCallback.m_convexToWorld), convexCallback);
+
+    if (convexCallback.hasHit())
+    {
+        result.body_ = static_cast<RigidBody*>(convexCallback.m_hitCollisionObject->getUserPointer());
+        result.position_ = ToVector3(convexCallback.m_hitPointWorld);
+        result.normal_ = ToVector3(convexCallback.m_hitNormalWorld);
+        result.distance_ = convexCallback.m_closestHitFraction * (endPos - ray.origin_).Length();
+        result.hitFraction_ = convexCallback.m_closestHitFraction;
+    }
+    else
+    {
+        result.body_ = nullptr;
+        result.position_ = Vector3::ZERO;
+        result.normal_ = Vector3::ZERO;
+        result.distance_ = M_INFINITY;
+        result.hitFraction_ = 0.0f;
+    }
+}
+
+void CustomStepSimulation(btDiscreteDynamicsWorld* world, bool multiThreaded,
+    unsigned numSteps, btScalar fixedTimeStep, btScalar overtime)
+{
+#if BT_THREADSAFE
+    if (multiThreaded)
+    {
+        static_cast<btCustomDiscreteDynamicsWorldMt*>(world)->customStepSimulation(numSteps, fixedTimeStep, overtime);
+        return;
+    }
+#endif
+    static_cast<btCustomDiscreteDynamicsWorld*>(world)->customStepSimulation(numSteps, fixedTimeStep, overtime);
+}
+
+btScalar GetLocalTime(btDiscreteDynamicsWorld* world, bool multiThreaded)
+{
+#if BT_THREADSAFE
+    if (multiThreaded)
+        return static_cast<btCustomDiscreteDynamicsWorldMt*>(world)->getLocalTime();
+#endif
+    return static_cast<btCustomDiscreteDynamicsWorld*>(world)->getLocalTime();
+}
+
+}
+
 static bool CompareRaycastResults(const PhysicsRaycastResult& lhs, const PhysicsRaycastResult& rhs)
 {
     return lhs.distance_ < rhs.distance_;
@@ -189,6 +362,122 @@ struct PhysicsQueryCallback : public btCollisionWorld::ContactResultCallback
     unsigned collisionMask_;
 };
 
+/// Manifold result that forwards contact points to the query callback without persistent manifold.
+struct PhysicsOverlapResult : public btManifoldResult
+{
+    /// Construct.
+    PhysicsOverlapResult(const btCollisionObjectWrapper* obj0Wrap, const btCollisionObjectWrapper* obj1Wrap,
+        PhysicsQueryCallback& callback) :
+        btManifoldResult(obj0Wrap, obj1Wrap),
+        callback_(callback)
+    {
+    }
+
+    /// Add a contact point.
+    void addContactPoint(const btVector3& /*normalOnBInWorld*/, const btVector3& /*pointInWorld*/, btScalar /*depth*/) override
+    {
+        btManifoldPoint point;
+        callback_.addSingleResult(point, m_body0Wrap, m_partId0, m_index0, m_body1Wrap, m_partId1, m_index1);
+    }
+
+    /// Query callback.
+    PhysicsQueryCallback& callback_;
+};
+
+/// Same as btCollisionWorld::contactTest, but uses caller-provided dispatcher.
+/// It's safe to execute multiple overlap tests in parallel as long as each thread has its own dispatcher.
+struct PhysicsOverlapCallback : public btBroadphaseAabbCallback
+{
+    /// Construct.
+    PhysicsOverlapCallback(btCollisionObject* queryObject, const btCollisionWorld* world, btDispatcher* dispatcher,
+        PhysicsQueryCallback& callback) :
+        queryObject_(queryObject),
+        world_(world),
+        dispatcher_(dispatcher),
+        callback_(callback)
+    {
+    }
+
+    /// Process broadphase proxy.
+    bool process(const btBroadphaseProxy* proxy) override
+    {
+        auto* collisionObject = static_cast<btCollisionObject*>(proxy->m_clientObject);
+        if (collisionObject == queryObject_ || !callback_.needsCollision(collisionObject->getBroadphaseHandle()))
+            return true;
+
+        btCollisionObjectWrapper obj0Wrap(nullptr, queryObject_->getCollisionShape(), queryObject_,
+            queryObject_->getWorldTransform(), -1, -1);
+        btCollisionObjectWrapper obj1Wrap(nullptr, collisionObject->getCollisionShape(), collisionObject,
+            collisionObject->getWorldTransform(), -1, -1);
+
+        btCollisionAlgorithm* algorithm = dispatcher_->findAlgorithm(&obj0Wrap, &obj1Wrap, nullptr, BT_CLOSEST_POINT_ALGORITHMS);
+        if (algorithm)
+        {
+            PhysicsOverlapResult result(&obj0Wrap, &obj1Wrap, callback_);
+            algorithm->processCollision(&obj0Wrap, &obj1Wrap, world_->getDispatchInfo(), &result);
+            algorithm->~btCollisionAlgorithm();
+            dispatcher_->freeCollisionAlgorithm(algorithm);
+        }
+        return true;
+    }
+
+    /// Query object.
+    btCollisionObject* queryObject_;
+    /// Physics world.
+    const btCollisionWorld* world_;
+    /// Dispatcher used to create collision algorithms.
+    btDispatcher* dispatcher_;
+    /// Query callback.
+    PhysicsQueryCallback& callback_;
+};
+
+/// Process batched queries on WorkQueue, or on the current thread if there is no WorkQueue.
+template <class Callback>
+void ForEachQueryParallel(WorkQueue* workQueue, unsigned bucket, unsigned size, const Callback& callback)
+{
+    if (workQueue)
+        ForEachParallel(workQueue, bucket, size, callback);
+    else if (size > 0)
+        callback(0, size);
+}
+
+/// Perform batched overlap queries. Shape factory returns Bullet shape and shape position for the query.
+template <class Query, class ShapeFactory>
+void PerformOverlapBatch(WorkQueue* workQueue, btCollisionWorld* world, btCollisionConfiguration* collisionConfiguration,
+    ea::vector<ea::vector<RigidBody*>>& result, ea::span<const Query> queries, unsigned collisionMask,
+    const ShapeFactory& shapeFactory)
+{
+    const auto numQueries = static_cast<unsigned>(queries.size());
+    result.resize(numQueries);
+
+    ForEachQueryParallel(workQueue, OVERLAP_BATCH_SIZE, numQueries, [&](unsigned beginIndex, unsigned endIndex)
+    {
+        // Collision dispatcher owns temporary manifolds and is not thread-safe, create one per bucket
+        btCollisionDispatcher dispatcher(collisionConfiguration);
+        btGImpactCollisionAlgorithm::registerAlgorithm(&dispatcher);
+
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            ea::vector<RigidBody*>& bodies = result[i];
+            bodies.clear();
+
+            Vector3 position;
+            auto shape = shapeFactory(queries[i], position);
+
+            btCollisionObject queryObject;
+            queryObject.setCollisionShape(&shape);
+            queryObject.setWorldTransform(btTransform(btQuaternion::getIdentity(), ToBtVector3(position)));
+
+            btVector3 aabbMin, aabbMax;
+            shape.getAabb(queryObject.getWorldTransform(), aabbMin, aabbMax);
+
+            PhysicsQueryCallback queryCallback(bodies, collisionMask);
+            PhysicsOverlapCallback overlapCallback(&queryObject, world, &dispatcher, queryCallback);
+            world->getBroadphase()->aabbTest(aabbMin, aabbMax, overlapCallback);
+        }
+    });
+}
+
 PhysicsWorld::PhysicsWorld(Context* context) :
     Component(context),
     fps_(DEFAULT_FPS),
@@ -201,12 +490,46 @@ PhysicsWorld::PhysicsWorld(Context* context) :
     else
         collisionConfiguration_ = new btDefaultCollisionConfiguration();
 
-    collisionDispatcher_ = ea::make_unique<btCollisionDispatcher>(collisionConfiguration_);
-    btGImpactCollisionAlgorithm::registerAlgorithm(static_cast<btCollisionDispatcher*>(collisionDispatcher_.get()));
+    auto workQueue = GetSubsystem<WorkQueue>();
+    multiThreaded_ = PhysicsWorld::config.multiThreaded_;
+#if BT_THREADSAFE
+    if (multiThreaded_ && (!workQueue || workQueue->GetNumThreads() + 1 > BT_MAX_THREAD_COUNT))
+    {
+        URHO3D_LOGWARNING("Multithreaded physics requires WorkQueue with at most {} threads", BT_MAX_THREAD_COUNT);
+        multiThreaded_ = false;
+    }
+#else
+    if (multiThreaded_)
+    {
+        URHO3D_LOGWARNING("Multithreaded physics is not supported in this build");
+        multiThreaded_ = false;
+    }
+#endif
 
     broadphase_ = ea::make_unique<btDbvtBroadphase>();
-    solver_ = ea::make_unique<btSequentialImpulseConstraintSolver>();
-    world_ = ea::make_unique<btCustomDiscreteDynamicsWorld>(collisionDispatcher_.get(), broadphase_.get(), solver_.get(), collisionConfiguration_);
+#if BT_THREADSAFE
+    if (multiThreaded_)
+    {
+        GetWorkQueueTaskScheduler(workQueue);
+
+        const unsigned solverPoolSize = PhysicsWorld::config.solverPoolSize_
+            ? PhysicsWorld::config.solverPoolSize_ : workQueue->GetNumThreads() + 1;
+
+        collisionDispatcher_ = ea::make_unique<btCollisionDispatcherMt>(collisionConfiguration_);
+        solverPool_ = ea::make_unique<btConstraintSolverPoolMt>(static_cast<int>(solverPoolSize));
+        solver_ = ea::make_unique<btSequentialImpulseConstraintSolverMt>();
+        world_ = ea::make_unique<btCustomDiscreteDynamicsWorldMt>(
+            collisionDispatcher_.get(), broadphase_.get(), solverPool_.get(), solver_.get(), collisionConfiguration_);
+    }
+    else
+#endif
+    {
+        collisionDispatcher_ = ea::make_unique<btCollisionDispatcher>(collisionConfiguration_);
+        solver_ = ea::make_unique<btSequentialImpulseConstraintSolver>();
+        world_ = ea::make_unique<btCustomDiscreteDynamicsWorld>(
+            collisionDispatcher_.get(), broadphase_.get(), solver_.get(), collisionConfiguration_);
+    }
+    btGImpactCollisionAlgorithm::registerAlgorithm(static_cast<btCollisionDispatcher*>(collisionDispatcher_.get()));
 
     world_->setGravity(ToBtVector3(DEFAULT_GRAVITY));
     world_->getDispatchInfo().m_useContinuous = true;
@@ -214,7 +537,8 @@ PhysicsWorld::PhysicsWorld(Context* context) :
     world_->setDebugDrawer(this);
     world_->setInternalTickCallback(InternalPreTickCallback, static_cast<void*>(this), true);
     world_->setInternalTickCallback(InternalTickCallback, static_cast<void*>(this), false);
-    world_->setSynchronizeAllMotionStates(true);
+    // Sleeping bodies are ignored by RigidBody::setWorldTransform anyway, so don't interpolate them at all
+    world_->setSynchronizeAllMotionStates(false);
 
     // Add ghost pair callback
     ghostPairCallback_ = new btGhostPairCallback();
@@ -238,6 +562,7 @@ PhysicsWorld::~PhysicsWorld()
 
     world_.reset();
     solver_.reset();
+    solverPool_.reset();
     broadphase_.reset();
     collisionDispatcher_.reset();
 
@@ -266,6 +591,13 @@ void PhysicsWorld::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE("Net Max Angular Vel.", float, maxNetworkAngularVelocity_, DEFAULT_MAX_NETWORK_ANGULAR_VELOCITY, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Interpolation", bool, interpolation_, true, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Internal Edge Utility", bool, internalEdge_, true, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Bulk Transform Sync", bool, bulkTransformSync_, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Collision Events", bool, collisionEventsEnabled_, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Contact Buffer", IsContactBufferEnabled, SetContactBufferEnabled, bool, false, AM_DEFAULT);
+    URHO3D_ENUM_ATTRIBUTE("LOD Mode", lodMode_, lodModeNames, PHYSICS_LOD_REDUCED_SYNC, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("LOD Radius", float, lodRadius_, DEFAULT_LOD_RADIUS, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("LOD Collision Mask", unsigned, lodCollisionMask_, 0, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("LOD Sync Interval", GetLodSyncInterval, SetLodSyncInterval, unsigned, DEFAULT_LOD_SYNC_INTERVAL, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Split Impulse", GetSplitImpulse, SetSplitImpulse, bool, false, AM_DEFAULT);
 }
 
@@ -325,8 +657,11 @@ void PhysicsWorld::Update(float timeStep)
         maxSubSteps = Min(maxSubSteps, maxSubSteps_);
 
     delayedWorldTransforms_.clear();
+    contactPairs_.clear();
+    bufferedContactPoints_.clear();
     simulating_ = true;
     PreUpdate(timeStep);
+    UpdateLod();
 
     if (interpolation_)
         world_->stepSimulation(timeStep, maxSubSteps, internalTimeStep);
@@ -341,7 +676,8 @@ void PhysicsWorld::Update(float timeStep)
         }
     }
 
-    PostUpdate(timeStep, world_->getLocalTime());
+    ApplyBulkWorldTransforms();
+    PostUpdate(timeStep, GetLocalTime(world_.get(), multiThreaded_));
     simulating_ = false;
     ApplyDelayedWorldTransforms();
 }
@@ -368,19 +704,82 @@ void PhysicsWorld::ApplyDelayedWorldTransforms()
     }
 }
 
+void PhysicsWorld::UpdateLod()
+{
+    if (lodInterestPoints_.empty() && !hasDistantBodies_)
+        return;
+
+    URHO3D_PROFILE("UpdatePhysicsLod");
+
+    const float radiusSquared = lodRadius_ * lodRadius_;
+    const bool freeze = lodMode_ == PHYSICS_LOD_FREEZE;
+
+    hasDistantBodies_ = false;
+    for (RigidBody* body : rigidBodies_)
+    {
+        bool distant = false;
+        if (!lodInterestPoints_.empty() && body->GetMass() > 0.0f && !body->IsKinematic()
+            && (body->IsLodEnabled() || (body->GetCollisionLayer() & lodCollisionMask_)))
+        {
+            const Vector3 position = body->GetPosition();
+            distant = ea::none_of(lodInterestPoints_.begin(), lodInterestPoints_.end(),
+                [&](const Vector3& point) { return (point - position).LengthSquared() <= radiusSquared; });
+        }
+
+        // Spread node updates of distant bodies across physics updates
+        const bool skipSync = !freeze && (lodUpdateIndex_ + body->GetID()) % lodSyncInterval_ != 0;
+        body->UpdateLod(distant, freeze, skipSync);
+        hasDistantBodies_ |= distant;
+    }
+
+    ++lodUpdateIndex_;
+}
+
+void PhysicsWorld::ApplyBulkWorldTransforms()
+{
+    if (bulkWorldTransforms_.empty())
+        return;
+
+    URHO3D_PROFILE("ApplyBulkWorldTransforms");
+
+    SetApplyingTransforms(true);
+    for (const DelayedWorldTransform& transform : bulkWorldTransforms_)
+    {
+        RigidBody* body = transform.rigidBody_;
+        if (!body)
+            continue;
+
+        body->bulkTransformIndex_ = M_MAX_UNSIGNED;
+        if (Node* node = body->GetNode())
+        {
+            // Don't read world transform back to avoid eager update of the node hierarchy
+            node->SetWorldTransform(transform.worldPosition_, transform.worldRotation_);
+            body->lastPosition_ = transform.worldPosition_;
+            body->lastRotation_ = transform.worldRotation_;
+        }
+    }
+    SetApplyingTransforms(false);
+
+    bulkWorldTransforms_.clear();
+}
+
 void PhysicsWorld::CustomUpdate(unsigned numSteps, float fixedTimeStep, float overtime, ea::optional<SynchronizedPhysicsStep> sync)
 {
     URHO3D_PROFILE("UpdatePhysics");
     const float timeStep = numSteps * fixedTimeStep + overtime;
 
     delayedWorldTransforms_.clear();
+    contactPairs_.clear();
+    bufferedContactPoints_.clear();
     simulating_ = true;
     PreUpdate(timeStep);
+    UpdateLod();
 
     timeAcc_ = overtime;
     synchronizedStep_ = sync;
-    world_->customStepSimulation(numSteps, fixedTimeStep, overtime);
+    CustomStepSimulation(world_.get(), multiThreaded_, numSteps, fixedTimeStep, overtime);
 
+    ApplyBulkWorldTransforms();
     PostUpdate(timeStep, overtime);
     simulating_ = false;
     ApplyDelayedWorldTransforms();
@@ -427,6 +826,16 @@ void PhysicsWorld::SetInternalEdge(bool enable)
     internalEdge_ = enable;
 }
 
+void PhysicsWorld::SetContactBufferEnabled(bool enable)
+{
+    contactBufferEnabled_ = enable;
+    if (!contactBufferEnabled_)
+    {
+        contactPairs_.clear();
+        bufferedContactPoints_.clear();
+    }
+}
+
 void PhysicsWorld::SetSplitImpulse(bool enable)
 {
     world_->getSolverInfo().m_splitImpulse = enable;
@@ -472,29 +881,7 @@ void PhysicsWorld::RaycastSingle(PhysicsRaycastResult& result, const Ray& ray, f
     if (maxDistance >= M_INFINITY)
         URHO3D_LOGWARNING("Infinite maxDistance in physics raycast is not supported");
 
-    btCollisionWorld::ClosestRayResultCallback
-        rayCallback(ToBtVector3(ray.origin_), ToBtVector3(ray.origin_ + maxDistance * ray.direction_));
-    rayCallback.m_collisionFilterGroup = (short)0xffff;
-    rayCallback.m_collisionFilterMask = (short)collisionMask;
-
-    world_->rayTest(rayCallback.m_rayFromWorld, rayCallback.m_rayToWorld, rayCallback);
-
-    if (rayCallback.hasHit())
-    {
-        result.position_ = ToVector3(rayCallback.m_hitPointWorld);
-        result.normal_ = ToVector3(rayCallback.m_hitNormalWorld);
-        result.distance_ = (result.position_ - ray.origin_).Length();
-        result.hitFraction_ = rayCallback.m_closestHitFraction;
-        result.body_ = static_cast<RigidBody*>(rayCallback.m_collisionObject->getUserPointer());
-    }
-    else
-    {
-        result.position_ = Vector3::ZERO;
-        result.normal_ = Vector3::ZERO;
-        result.distance_ = M_INFINITY;
-        result.hitFraction_ = 0.0f;
-        result.body_ = nullptr;
-    }
+    PerformRaycastSingle(world_.get(), result, ray, maxDistance, collisionMask);
 }
 
 void PhysicsWorld::RaycastSingleSegmented(PhysicsRaycastResult& result, const Ray& ray, float maxDistance, float segmentDistance, unsigned collisionMask, float overlapDistance)
@@ -556,33 +943,7 @@ void PhysicsWorld::SphereCast(PhysicsRaycastResult& result, const Ray& ray, floa
     if (maxDistance >= M_INFINITY)
         URHO3D_LOGWARNING("Infinite maxDistance in physics sphere cast is not supported");
 
-    btSphereShape shape(radius);
-    Vector3 endPos = ray.origin_ + maxDistance * ray.direction_;
-
-    btCollisionWorld::ClosestConvexResultCallback
-        convexCallback(ToBtVector3(ray.origin_), ToBtVector3(endPos));
-    convexCallback.m_collisionFilterGroup = (short)0xffff;
-    convexCallback.m_collisionFilterMask = (short)collisionMask;
-
-    world_->convexSweepTest(&shape, btTransform(btQuaternion::getIdentity(), convexCallback.m_convexFromWorld),
-        btTransform(btQuaternion::getIdentity(), convexCallback.m_convexToWorld), convexCallback);
-
-    if (convexCallback.hasHit())
-    {
-        result.body_ = static_cast<RigidBody*>(convexCallback.m_hitCollisionObject->getUserPointer());
-        result.position_ = ToVector3(convexCallback.m_hitPointWorld);
-        result.normal_ = ToVector3(convexCallback.m_hitNormalWorld);
-        result.distance_ = convexCallback.m_closestHitFraction * (endPos - ray.origin_).Length();
-        result.hitFraction_ = convexCallback.m_closestHitFraction;
-    }
-    else
-    {
-        result.body_ = nullptr;
-        result.position_ = Vector3::ZERO;
-        result.normal_ = Vector3::ZERO;
-        result.distance_ = M_INFINITY;
-        result.hitFraction_ = 0.0f;
-    }
+    PerformSphereCast(world_.get(), result, ray, radius, maxDistance, collisionMask);
 }
 
 void PhysicsWorld::ConvexCast(PhysicsRaycastResult& result, CollisionShape* shape, const Vector3& startPos,
@@ -746,6 +1107,68 @@ void PhysicsWorld::GetRigidBodies(ea::vector<RigidBody*>& result, const RigidBod
     }
 }
 
+void PhysicsWorld::RaycastSingleBatch(ea::vector<PhysicsRaycastResult>& result, ea::span<const PhysicsRaycastQuery> queries)
+{
+    URHO3D_PROFILE("PhysicsRaycastSingleBatch");
+
+    const auto numQueries = static_cast<unsigned>(queries.size());
+    result.resize(numQueries);
+
+    btCollisionWorld* world = world_.get();
+    ForEachQueryParallel(GetSubsystem<WorkQueue>(), RAYCAST_BATCH_SIZE, numQueries, [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            const PhysicsRaycastQuery& query = queries[i];
+            PerformRaycastSingle(world, result[i], query.ray_, query.maxDistance_, query.collisionMask_);
+        }
+    });
+}
+
+void PhysicsWorld::SphereCastBatch(ea::vector<PhysicsRaycastResult>& result, ea::span<const PhysicsSphereCastQuery> queries)
+{
+    URHO3D_PROFILE("PhysicsSphereCastBatch");
+
+    const auto numQueries = static_cast<unsigned>(queries.size());
+    result.resize(numQueries);
+
+    btCollisionWorld* world = world_.get();
+    ForEachQueryParallel(GetSubsystem<WorkQueue>(), RAYCAST_BATCH_SIZE, numQueries, [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            const PhysicsSphereCastQuery& query = queries[i];
+            PerformSphereCast(world, result[i], query.ray_, query.radius_, query.maxDistance_, query.collisionMask_);
+        }
+    });
+}
+
+void PhysicsWorld::GetRigidBodiesBatch(
+    ea::vector<ea::vector<RigidBody*>>& result, ea::span<const Sphere> spheres, unsigned collisionMask)
+{
+    URHO3D_PROFILE("PhysicsSphereQueryBatch");
+
+    PerformOverlapBatch(GetSubsystem<WorkQueue>(), world_.get(), collisionConfiguration_, result, spheres, collisionMask,
+        [](const Sphere& sphere, Vector3& position)
+    {
+        position = sphere.center_;
+        return btSphereShape(sphere.radius_);
+    });
+}
+
+void PhysicsWorld::GetRigidBodiesBatch(
+    ea::vector<ea::vector<RigidBody*>>& result, ea::span<const BoundingBox> boxes, unsigned collisionMask)
+{
+    URHO3D_PROFILE("PhysicsBoxQueryBatch");
+
+    PerformOverlapBatch(GetSubsystem<WorkQueue>(), world_.get(), collisionConfiguration_, result, boxes, collisionMask,
+        [](const BoundingBox& box, Vector3& position)
+    {
+        position = box.Center();
+        return btBoxShape(ToBtVector3(box.HalfSize()));
+    });
+}
+
 void PhysicsWorld::GetCollidingBodies(ea::vector<RigidBody*>& result, const RigidBody* body)
 {
     URHO3D_PROFILE("GetCollidingBodies");
@@ -793,6 +1216,11 @@ void PhysicsWorld::RemoveRigidBody(RigidBody* body)
     rigidBodies_.erase_first(body);
     // Remove possible dangling pointer from the delayedWorldTransforms structure
     delayedWorldTransforms_.erase(body);
+    if (body->bulkTransformIndex_ < bulkWorldTransforms_.size())
+    {
+        bulkWorldTransforms_[body->bulkTransformIndex_].rigidBody_ = nullptr;
+        body->bulkTransformIndex_ = M_MAX_UNSIGNED;
+    }
 }
 
 void PhysicsWorld::AddCollisionShape(CollisionShape* shape)
@@ -820,6 +1248,20 @@ void PhysicsWorld::AddDelayedWorldTransform(const DelayedWorldTransform& transfo
     delayedWorldTransforms_[transform.rigidBody_] = transform;
 }
 
+void PhysicsWorld::AddBulkWorldTransform(RigidBody* body, const Vector3& worldPosition, const Quaternion& worldRotation)
+{
+    const DelayedWorldTransform transform{body, nullptr, worldPosition, worldRotation};
+
+    // Keep only the latest transform if the body is updated on several simulation steps
+    if (body->bulkTransformIndex_ < bulkWorldTransforms_.size())
+        bulkWorldTransforms_[body->bulkTransformIndex_] = transform;
+    else
+    {
+        body->bulkTransformIndex_ = bulkWorldTransforms_.size();
+        bulkWorldTransforms_.push_back(transform);
+    }
+}
+
 void PhysicsWorld::DrawDebugGeometry(bool depthTest)
 {
     auto* debug = GetComponent<DebugRenderer>();
@@ -937,11 +1379,10 @@ void PhysicsWorld::SendCollisionEvents()
     nodeCollisionData_.clear();
 
     int numManifolds = collisionDispatcher_->getNumManifolds();
+    const bool hasTypedSubscribers = OnCollisionStart.HasSubscriptions() || OnCollision.HasSubscriptions();
 
     if (numManifolds)
     {
-        physicsCollisionData_[PhysicsCollision::P_WORLD] = this;
-
         for (int i = 0; i < numManifolds; ++i)
         {
             btPersistentManifold* contactManifold = collisionDispatcher_->getManifoldByIndexInternal(i);
@@ -984,6 +1425,20 @@ void PhysicsWorld::SendCollisionEvents()
                 currentCollisions_[bodyPair].flippedManifold_ = contactManifold;
             }
         }
+    }
+
+    if (contactBufferEnabled_)
+        BufferContacts();
+
+    if (!collisionEventsEnabled_)
+    {
+        previousCollisions_ = currentCollisions_;
+        return;
+    }
+
+    if (!currentCollisions_.empty())
+    {
+        physicsCollisionData_[PhysicsCollision::P_WORLD] = this;
 
         for (auto i = currentCollisions_.begin();
              i != currentCollisions_.end(); ++i)
@@ -1008,6 +1463,7 @@ void PhysicsWorld::SendCollisionEvents()
             physicsCollisionData_[PhysicsCollision::P_TRIGGER] = trigger;
 
             contacts_.Clear();
+            contactPoints_.clear();
 
             // "Pointers not flipped"-manifold, send unmodified normals
             btPersistentManifold* contactManifold = i->second.manifold_;
@@ -1020,6 +1476,11 @@ void PhysicsWorld::SendCollisionEvents()
                     contacts_.WriteVector3(ToVector3(point.m_normalWorldOnB));
                     contacts_.WriteFloat(point.m_distance1);
                     contacts_.WriteFloat(point.m_appliedImpulse);
+                    if (hasTypedSubscribers)
+                    {
+                        contactPoints_.push_back({ToVector3(point.m_positionWorldOnB), ToVector3(point.m_normalWorldOnB),
+                            point.m_distance1, point.m_appliedImpulse});
+                    }
                 }
             }
             // "Pointers flipped"-manifold, flip normals also
@@ -1033,23 +1494,39 @@ void PhysicsWorld::SendCollisionEvents()
                     contacts_.WriteVector3(-ToVector3(point.m_normalWorldOnB));
                     contacts_.WriteFloat(point.m_distance1);
                     contacts_.WriteFloat(point.m_appliedImpulse);
+                    if (hasTypedSubscribers)
+                    {
+                        contactPoints_.push_back({ToVector3(point.m_positionWorldOnB), -ToVector3(point.m_normalWorldOnB),
+                            point.m_distance1, point.m_appliedImpulse});
+                    }
                 }
             }
 
             physicsCollisionData_[PhysicsCollision::P_CONTACTS] = contacts_.GetBuffer();
 
+            const PhysicsCollisionEventArgs args{bodyA, bodyB, nodeA, nodeB, trigger, contactPoints_};
+            const auto isCollisionAlive = [&] { return nodeWeakA && nodeWeakB && i->first.first && i->first.second; };
+
             // Send separate collision start event if collision is new
             if (newCollision)
             {
+                OnCollisionStart(this, args);
+                if (!isCollisionAlive())
+                    continue;
+
                 SendEvent(E_PHYSICSCOLLISIONSTART, physicsCollisionData_);
                 // Skip rest of processing if either of the nodes or bodies is removed as a response to the event
-                if (!nodeWeakA || !nodeWeakB || !i->first.first || !i->first.second)
+                if (!isCollisionAlive())
                     continue;
             }
 
             // Then send the ongoing collision event
+            OnCollision(this, args);
+            if (!isCollisionAlive())
+                continue;
+
             SendEvent(E_PHYSICSCOLLISION, physicsCollisionData_);
-            if (!nodeWeakA || !nodeWeakB || !i->first.first || !i->first.second)
+            if (!isCollisionAlive())
                 continue;
 
             nodeCollisionData_[NodeCollision::P_BODY] = bodyA;
@@ -1148,6 +1625,10 @@ void PhysicsWorld::SendCollisionEvents()
                 physicsCollisionData_[PhysicsCollisionEnd::P_NODEB] = nodeB;
                 physicsCollisionData_[PhysicsCollisionEnd::P_TRIGGER] = trigger;
 
+                OnCollisionEnd(this, PhysicsCollisionEventArgs{bodyA, bodyB, nodeA, nodeB, trigger, {}});
+                if (!nodeWeakA || !nodeWeakB || !i->first.first || !i->first.second)
+                    continue;
+
                 SendEvent(E_PHYSICSCOLLISIONEND, physicsCollisionData_);
                 // Skip rest of processing if either of the nodes or bodies is removed as a response to the event
                 if (!nodeWeakA || !nodeWeakB || !i->first.first || !i->first.second)
@@ -1174,9 +1655,71 @@ void PhysicsWorld::SendCollisionEvents()
     previousCollisions_ = currentCollisions_;
 }
 
+void PhysicsWorld::BufferContacts()
+{
+    const auto appendContacts = [this](btPersistentManifold* manifold, float normalSign)
+    {
+        if (!manifold)
+            return;
+
+        for (int j = 0; j < manifold->getNumContacts(); ++j)
+        {
+            const btManifoldPoint& point = manifold->getContactPoint(j);
+            bufferedContactPoints_.push_back({ToVector3(point.m_positionWorldOnB),
+                normalSign * ToVector3(point.m_normalWorldOnB), point.m_distance1, point.m_appliedImpulse});
+        }
+    };
+
+    for (const auto& [bodies, manifolds] : currentCollisions_)
+    {
+        RigidBody* bodyA = bodies.first;
+        RigidBody* bodyB = bodies.second;
+        if (!bodyA || !bodyB)
+            continue;
+
+        PhysicsContactPair& pair = contactPairs_.emplace_back();
+        pair.bodyA_ = bodyA;
+        pair.bodyB_ = bodyB;
+        pair.trigger_ = bodyA->IsTrigger() || bodyB->IsTrigger();
+        pair.state_ = previousCollisions_.contains(bodies) ? PhysicsContactState::Ongoing : PhysicsContactState::Started;
+        pair.firstContact_ = bufferedContactPoints_.size();
+
+        // Same normal convention as collision events: normals point towards body A
+        appendContacts(manifolds.manifold_, 1.0f);
+        appendContacts(manifolds.flippedManifold_, -1.0f);
+        pair.numContacts_ = bufferedContactPoints_.size() - pair.firstContact_;
+    }
+
+    for (const auto& [bodies, manifolds] : previousCollisions_)
+    {
+        RigidBody* bodyA = bodies.first;
+        RigidBody* bodyB = bodies.second;
+        if (!bodyA || !bodyB || currentCollisions_.contains(bodies))
+            continue;
+
+        // Same filtering as collision end events
+        if (bodyA->GetMass() == 0.0f && bodyB->GetMass() == 0.0f)
+            continue;
+        if (bodyA->GetCollisionEventMode() == COLLISION_NEVER || bodyB->GetCollisionEventMode() == COLLISION_NEVER)
+            continue;
+        if (bodyA->GetCollisionEventMode() == COLLISION_ACTIVE && bodyB->GetCollisionEventMode() == COLLISION_ACTIVE &&
+            !bodyA->IsActive() && !bodyB->IsActive())
+            continue;
+
+        PhysicsContactPair& pair = contactPairs_.emplace_back();
+        pair.bodyA_ = bodyA;
+        pair.bodyB_ = bodyB;
+        pair.trigger_ = bodyA->IsTrigger() || bodyB->IsTrigger();
+        pair.state_ = PhysicsContactState::Ended;
+        pair.firstContact_ = bufferedContactPoints_.size();
+    }
+}
+
 void RegisterPhysicsLibrary(Context* context)
 {
     CollisionShape::RegisterObject(context);
+    CollisionGeometry::RegisterObject(context);
+    CollisionGeometryBaker::RegisterObject(context);
     RigidBody::RegisterObject(context);
     Constraint::RegisterObject(context);
     PhysicsWorld::RegisterObject(context);
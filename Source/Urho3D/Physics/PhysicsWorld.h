@@ -24,8 +24,10 @@
 
 #include <EASTL/unique_ptr.h>
 
+#include "../Core/Signal.h"
 #include "../IO/VectorBuffer.h"
 #include "../Math/BoundingBox.h"
+#include "../Math/Ray.h"
 #include "../Math/Sphere.h"
 #include "../Math/Vector3.h"
 #include "../Replica/NetworkId.h"
@@ -34,13 +36,14 @@
 #include <Bullet/LinearMath/btIDebugDraw.h>
 
 #include <EASTL/optional.h>
+#include <EASTL/span.h>
 
 class btCollisionConfiguration;
 class btCollisionShape;
 class btBroadphaseInterface;
 class btConstraintSolver;
+class btConstraintSolverPoolMt;
 class btDiscreteDynamicsWorld;
-class btCustomDiscreteDynamicsWorld;
 class btDispatcher;
 class btDynamicsWorld;
 class btPersistentManifold;
@@ -54,7 +57,6 @@ class Deserializer;
 class Constraint;
 class Model;
 class Node;
-class Ray;
 class RigidBody;
 class Scene;
 class Serializer;
@@ -89,6 +91,88 @@ struct URHO3D_API PhysicsRaycastResult
     RigidBody* body_{};
 };
 
+/// Physics raycast query for batched raycasts.
+struct PhysicsRaycastQuery
+{
+    /// Ray to cast.
+    Ray ray_;
+    /// Maximum distance of the raycast.
+    float maxDistance_{};
+    /// Collision mask of the raycast.
+    unsigned collisionMask_{M_MAX_UNSIGNED};
+};
+
+/// Physics swept sphere query for batched sphere casts.
+struct PhysicsSphereCastQuery
+{
+    /// Ray to sweep the sphere along.
+    Ray ray_;
+    /// Radius of the sphere.
+    float radius_{};
+    /// Maximum distance of the sweep.
+    float maxDistance_{};
+    /// Collision mask of the sweep.
+    unsigned collisionMask_{M_MAX_UNSIGNED};
+};
+
+/// Physics collision contact point. Same as one element of E_PHYSICSCOLLISION contacts buffer.
+struct PhysicsContactPoint
+{
+    /// Worldspace position.
+    Vector3 position_;
+    /// Worldspace normal.
+    Vector3 normal_;
+    /// Contact distance.
+    float distance_{};
+    /// Contact impulse.
+    float impulse_{};
+};
+
+/// Arguments of typed physics collision signals. Same as the parameters of E_PHYSICSCOLLISION and related events.
+struct PhysicsCollisionEventArgs
+{
+    /// First rigid body.
+    RigidBody* bodyA_{};
+    /// Second rigid body.
+    RigidBody* bodyB_{};
+    /// First node.
+    Node* nodeA_{};
+    /// Second node.
+    Node* nodeB_{};
+    /// Whether either of the bodies is a trigger.
+    bool trigger_{};
+    /// Contact points with normals pointing towards body A. Empty for collision end.
+    ea::span<const PhysicsContactPoint> contacts_;
+};
+
+/// State of the contact pair in the contact buffer.
+enum class PhysicsContactState
+{
+    /// Bodies started touching on this step.
+    Started,
+    /// Bodies were touching on the previous step and still do.
+    Ongoing,
+    /// Bodies stopped touching on this step. Pair has no contact points.
+    Ended
+};
+
+/// Contact pair in the contact buffer. Contact points of all pairs are stored in a separate contiguous array.
+struct PhysicsContactPair
+{
+    /// First rigid body.
+    RigidBody* bodyA_{};
+    /// Second rigid body.
+    RigidBody* bodyB_{};
+    /// Whether either of the bodies is a trigger.
+    bool trigger_{};
+    /// Contact state.
+    PhysicsContactState state_{};
+    /// Index of the first contact point. Contact normals point towards body A.
+    unsigned firstContact_{};
+    /// Number of contact points.
+    unsigned numContacts_{};
+};
+
 /// Delayed world transform assignment for parented rigidbodies.
 struct DelayedWorldTransform
 {
@@ -128,10 +212,26 @@ struct PhysicsWorldConfig
 
     /// Override for the collision configuration (default btDefaultCollisionConfiguration).
     btCollisionConfiguration* collisionConfig_;
+    /// Whether to create multithreaded Bullet world that runs collision dispatch and island solving on WorkQueue.
+    /// Requires URHO3D_THREADING, ignored otherwise. Applied on PhysicsWorld construction.
+    bool multiThreaded_{};
+    /// Number of constraint solvers in the pool of multithreaded world. 0 (default) means one solver per WorkQueue thread.
+    unsigned solverPoolSize_{};
+};
+
+/// Physics level of detail mode for distant rigid bodies.
+enum PhysicsLodMode
+{
+    /// Distant bodies are simulated, but their node transforms are updated once per several physics updates.
+    PHYSICS_LOD_REDUCED_SYNC = 0,
+    /// Distant bodies are put to sleep until they get back into the interest radius. Velocities are restored on wake up.
+    PHYSICS_LOD_FREEZE
 };
 
 static const int DEFAULT_FPS = 60;
 static const float DEFAULT_MAX_NETWORK_ANGULAR_VELOCITY = 100.0f;
+static const float DEFAULT_LOD_RADIUS = 100.0f;
+static const unsigned DEFAULT_LOD_SYNC_INTERVAL = 4;
 
 /// Cache of collision geometry data.
 using CollisionGeometryDataCache = ea::unordered_map<ea::pair<Model*, unsigned>, SharedPtr<CollisionGeometryData> >;
@@ -201,6 +301,31 @@ public:
     /// Set whether to use Bullet's internal edge utility for trimesh collisions. Disabled by default.
     /// @property
     void SetInternalEdge(bool enable);
+    /// Set whether to write simulated transforms to nodes once after all simulation steps instead of after each step.
+    /// Nodes are not updated between steps, so E_PHYSICSPOSTSTEP handlers see rigid body positions of the previous update.
+    /// Disabled by default.
+    /// @property
+    void SetBulkTransformSync(bool enable) { bulkTransformSync_ = enable; }
+    /// Set physics LOD mode for distant bodies.
+    /// @property
+    void SetLodMode(PhysicsLodMode mode) { lodMode_ = mode; }
+    /// Set physics LOD radius. Bodies farther than this from all interest points are distant.
+    /// @property
+    void SetLodRadius(float radius) { lodRadius_ = radius; }
+    /// Set collision layers affected by physics LOD. Individual bodies may be opted in via RigidBody::SetLodEnabled.
+    /// @property
+    void SetLodCollisionMask(unsigned mask) { lodCollisionMask_ = mask; }
+    /// Set node transform update interval in physics updates for distant bodies in PHYSICS_LOD_REDUCED_SYNC mode.
+    /// @property
+    void SetLodSyncInterval(unsigned interval) { lodSyncInterval_ = Max(interval, 1u); }
+    /// Set interest points of physics LOD, e.g. positions of cameras and players. Physics LOD is disabled if empty.
+    void SetLodInterestPoints(ea::span<const Vector3> points) { lodInterestPoints_.assign(points.begin(), points.end()); }
+    /// Set whether to send collision events and typed collision signals. Enabled by default.
+    /// @property
+    void SetCollisionEventsEnabled(bool enable) { collisionEventsEnabled_ = enable; }
+    /// Set whether to collect contact pairs and points into the contact buffer on each physics update. Disabled by default.
+    /// @property
+    void SetContactBufferEnabled(bool enable);
     /// Set split impulse collision mode. This is more accurate, but slower. Disabled by default.
     /// @property
     void SetSplitImpulse(bool enable);
@@ -231,6 +356,15 @@ public:
     void GetRigidBodies(ea::vector<RigidBody*>& result, const BoundingBox& box, unsigned collisionMask = M_MAX_UNSIGNED);
     /// Return rigid bodies by contact test with the specified body. It needs to be active to return all contacts reliably.
     void GetRigidBodies(ea::vector<RigidBody*>& result, const RigidBody* body);
+    /// Batched queries. Queries are executed in parallel on WorkQueue threads and results are stored in the order of queries.
+    /// Each query is processed independently, so results don't depend on the number of threads.
+    /// Physics world must not be modified or simulated while batched query is running.
+    /// @{
+    void RaycastSingleBatch(ea::vector<PhysicsRaycastResult>& result, ea::span<const PhysicsRaycastQuery> queries);
+    void SphereCastBatch(ea::vector<PhysicsRaycastResult>& result, ea::span<const PhysicsSphereCastQuery> queries);
+    void GetRigidBodiesBatch(ea::vector<ea::vector<RigidBody*>>& result, ea::span<const Sphere> spheres, unsigned collisionMask = M_MAX_UNSIGNED);
+    void GetRigidBodiesBatch(ea::vector<ea::vector<RigidBody*>>& result, ea::span<const BoundingBox> boxes, unsigned collisionMask = M_MAX_UNSIGNED);
+    /// @}
     /// Return rigid bodies that have been in collision with the specified body on the last simulation step. Only returns collisions that were sent as events (depends on collision event mode) and excludes e.g. static-static collisions.
     void GetCollidingBodies(ea::vector<RigidBody*>& result, const RigidBody* body);
 
@@ -258,6 +392,47 @@ public:
     /// @property
     bool GetInternalEdge() const { return internalEdge_; }
 
+    /// Return whether simulated transforms are written to nodes once per update.
+    /// @property
+    bool IsBulkTransformSync() const { return bulkTransformSync_; }
+
+    /// Return physics LOD mode.
+    /// @property
+    PhysicsLodMode GetLodMode() const { return lodMode_; }
+
+    /// Return physics LOD radius.
+    /// @property
+    float GetLodRadius() const { return lodRadius_; }
+
+    /// Return collision layers affected by physics LOD.
+    /// @property
+    unsigned GetLodCollisionMask() const { return lodCollisionMask_; }
+
+    /// Return node transform update interval for distant bodies.
+    /// @property
+    unsigned GetLodSyncInterval() const { return lodSyncInterval_; }
+
+    /// Return interest points of physics LOD.
+    const ea::vector<Vector3>& GetLodInterestPoints() const { return lodInterestPoints_; }
+
+    /// Return whether collision events are sent.
+    /// @property
+    bool IsCollisionEventsEnabled() const { return collisionEventsEnabled_; }
+
+    /// Return whether the contact buffer is collected.
+    /// @property
+    bool IsContactBufferEnabled() const { return contactBufferEnabled_; }
+
+    /// Return contact pairs collected from all simulation steps of the last physics update.
+    const ea::vector<PhysicsContactPair>& GetContactPairs() const { return contactPairs_; }
+    /// Return contact points of all pairs in the contact buffer.
+    const ea::vector<PhysicsContactPoint>& GetContactPoints() const { return bufferedContactPoints_; }
+    /// Return contact points of the contact pair.
+    ea::span<const PhysicsContactPoint> GetContactPoints(const PhysicsContactPair& pair) const
+    {
+        return ea::span<const PhysicsContactPoint>(bufferedContactPoints_).subspan(pair.firstContact_, pair.numContacts_);
+    }
+
     /// Return whether split impulse collision mode is enabled.
     /// @property
     bool GetSplitImpulse() const;
@@ -283,6 +458,8 @@ public:
     void RemoveConstraint(Constraint* constraint);
     /// Add a delayed world transform assignment. Called by RigidBody.
     void AddDelayedWorldTransform(const DelayedWorldTransform& transform);
+    /// Add a world transform assignment for the bulk transform sync. Called by RigidBody.
+    void AddBulkWorldTransform(RigidBody* body, const Vector3& worldPosition, const Quaternion& worldRotation);
     /// Add debug geometry to the debug renderer.
     void DrawDebugGeometry(bool depthTest);
     /// Set debug renderer to use. Called both by PhysicsWorld itself and physics components.
@@ -292,6 +469,8 @@ public:
 
     /// Return the Bullet physics world.
     btDiscreteDynamicsWorld* GetWorld() const;
+    /// Return whether the Bullet physics world is multithreaded.
+    bool IsMultiThreaded() const { return multiThreaded_; }
 
     /// Clean up the geometry cache.
     void CleanupGeometryCache();
@@ -317,6 +496,14 @@ public:
     /// Overrides of the internal configuration.
     static struct PhysicsWorldConfig config;
 
+    /// Typed collision signals, invoked right before E_PHYSICSCOLLISIONSTART, E_PHYSICSCOLLISION and E_PHYSICSCOLLISIONEND.
+    /// Handlers are called directly without building event data. String hash events are still sent for compatibility.
+    /// @{
+    Signal<void(const PhysicsCollisionEventArgs&), PhysicsWorld> OnCollisionStart;
+    Signal<void(const PhysicsCollisionEventArgs&), PhysicsWorld> OnCollision;
+    Signal<void(const PhysicsCollisionEventArgs&), PhysicsWorld> OnCollisionEnd;
+    /// @}
+
 protected:
     /// Handle scene being assigned.
     void OnSceneSet(Scene* scene) override;
@@ -334,7 +521,13 @@ private:
     void PostStep(float timeStep);
     /// Send accumulated collision events.
     void SendCollisionEvents();
+    /// Append current and ended collisions to the contact buffer.
+    void BufferContacts();
+    /// Update physics LOD of rigid bodies.
+    void UpdateLod();
     void ApplyDelayedWorldTransforms();
+    /// Write transforms collected by the bulk transform sync to nodes.
+    void ApplyBulkWorldTransforms();
 
     /// Bullet collision configuration.
     btCollisionConfiguration* collisionConfiguration_{};
@@ -344,8 +537,12 @@ private:
     ea::unique_ptr<btBroadphaseInterface> broadphase_;
     /// Bullet constraint solver.
     ea::unique_ptr<btConstraintSolver> solver_;
+    /// Bullet constraint solver pool for multithreaded world.
+    ea::unique_ptr<btConstraintSolverPoolMt> solverPool_;
     /// Bullet physics world.
-    ea::unique_ptr<btCustomDiscreteDynamicsWorld> world_;
+    ea::unique_ptr<btDiscreteDynamicsWorld> world_;
+    /// Whether the Bullet physics world is multithreaded.
+    bool multiThreaded_{};
     /// Extra weak pointer to scene to allow for cleanup in case the world is destroyed before other components.
     WeakPtr<Scene> scene_;
     /// Rigid bodies in the world.
@@ -372,6 +569,28 @@ private:
     VariantMap nodeCollisionData_;
     /// Preallocated buffer for physics collision contact data.
     VectorBuffer contacts_;
+    /// Preallocated contact points for typed collision signals.
+    ea::vector<PhysicsContactPoint> contactPoints_;
+    /// Contact pairs of the contact buffer.
+    ea::vector<PhysicsContactPair> contactPairs_;
+    /// Contact points of the contact buffer.
+    ea::vector<PhysicsContactPoint> bufferedContactPoints_;
+    /// World transforms collected by the bulk transform sync.
+    ea::vector<DelayedWorldTransform> bulkWorldTransforms_;
+    /// Interest points of physics LOD.
+    ea::vector<Vector3> lodInterestPoints_;
+    /// Physics LOD mode.
+    PhysicsLodMode lodMode_{PHYSICS_LOD_REDUCED_SYNC};
+    /// Physics LOD radius.
+    float lodRadius_{DEFAULT_LOD_RADIUS};
+    /// Collision layers affected by physics LOD.
+    unsigned lodCollisionMask_{};
+    /// Node transform update interval for distant bodies.
+    unsigned lodSyncInterval_{DEFAULT_LOD_SYNC_INTERVAL};
+    /// Number of physics LOD updates, used to spread transform updates of distant bodies.
+    unsigned lodUpdateIndex_{};
+    /// Whether there were distant bodies on the last physics LOD update.
+    bool hasDistantBodies_{};
     /// Simulation substeps per second.
     unsigned fps_{DEFAULT_FPS};
     /// Maximum number of simulation substeps per frame. 0 (default) unlimited, or negative values for adaptive timestep.
@@ -388,6 +607,12 @@ private:
     bool interpolation_{true};
     /// Use internal edge utility flag.
     bool internalEdge_{true};
+    /// Bulk transform sync flag.
+    bool bulkTransformSync_{};
+    /// Collision events flag.
+    bool collisionEventsEnabled_{true};
+    /// Contact buffer flag.
+    bool contactBufferEnabled_{};
     /// Applying transforms flag.
     bool applyingTransforms_{};
     /// Simulating flag.
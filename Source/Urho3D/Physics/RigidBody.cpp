@@ -121,6 +121,7 @@ void RigidBody::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE_EX("Is Kinematic", bool, kinematic_, MarkBodyDirty, false, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Is Trigger", bool, trigger_, MarkBodyDirty, false, AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Gravity Override", GetGravityOverride, SetGravityOverride, Vector3, Vector3::ZERO, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Physics LOD", bool, lodEnabled_, false, AM_DEFAULT);
 }
 
 void RigidBody::ApplyAttributes()
@@ -159,6 +160,21 @@ void RigidBody::setWorldTransform(const btTransform& worldTrans)
     if (!body_->isActive()) // Fix #2491
         return;
 
+    // Distant body, node will be updated on one of the next physics updates
+    if (lodSkipSync_)
+    {
+        lodSyncPending_ = true;
+        hasSimulated_ = true;
+        return;
+    }
+
+    ApplyMotionStateTransform(worldTrans);
+}
+
+void RigidBody::ApplyMotionStateTransform(const btTransform& worldTrans)
+{
+    lodSyncPending_ = false;
+
     Quaternion newWorldRotation = ToQuaternion(worldTrans.getRotation());
     Vector3 newWorldPosition = ToVector3(worldTrans.getOrigin()) - newWorldRotation * centerOfMass_;
     RigidBody* parentRigidBody = nullptr;
@@ -174,7 +190,12 @@ void RigidBody::setWorldTransform(const btTransform& worldTrans)
             parentRigidBody = parent->GetComponent<RigidBody>();
 
         if (!parentRigidBody)
-            ApplyWorldTransform(newWorldPosition, newWorldRotation);
+        {
+            if (physicsWorld_->IsBulkTransformSync())
+                physicsWorld_->AddBulkWorldTransform(this, newWorldPosition, newWorldRotation);
+            else
+                ApplyWorldTransform(newWorldPosition, newWorldRotation);
+        }
         else
         {
             DelayedWorldTransform delayed;
@@ -545,6 +566,36 @@ void RigidBody::Activate()
         body_->activate(true);
 }
 
+void RigidBody::UpdateLod(bool distant, bool freeze, bool skipSync)
+{
+    lodDistant_ = distant;
+    lodSkipSync_ = distant && skipSync;
+
+    // Sleeping bodies are not synchronized, so apply the transform skipped before the body fell asleep
+    if (lodSyncPending_ && body_ && !body_->isActive())
+        ApplyMotionStateTransform(body_->getWorldTransform());
+
+    const bool frozen = body_ && distant && freeze;
+    if (frozen == lodFrozen_)
+        return;
+
+    lodFrozen_ = frozen;
+    if (frozen)
+    {
+        lodLinearVelocity_ = ToVector3(body_->getLinearVelocity());
+        lodAngularVelocity_ = ToVector3(body_->getAngularVelocity());
+        if (body_->getActivationState() != DISABLE_DEACTIVATION)
+            body_->setActivationState(ISLAND_SLEEPING);
+    }
+    else if (body_ && !body_->isActive())
+    {
+        // Restore velocities only if the body was not woken up by something else in the meantime
+        Activate();
+        body_->setLinearVelocity(ToBtVector3(lodLinearVelocity_));
+        body_->setAngularVelocity(ToBtVector3(lodAngularVelocity_));
+    }
+}
+
 void RigidBody::ReAddBodyToWorld()
 {
     if (body_ && inWorld_)
@@ -683,8 +734,7 @@ void RigidBody::ApplyWorldTransform(const Vector3& newWorldPosition, const Quate
 
     physicsWorld_->SetApplyingTransforms(true);
 
-    node_->SetWorldPosition(newWorldPosition);
-    node_->SetWorldRotation(newWorldRotation);
+    node_->SetWorldTransform(newWorldPosition, newWorldRotation);
     lastPosition_ = node_->GetWorldPosition();
     lastRotation_ = node_->GetWorldRotation();
 
@@ -51,6 +51,7 @@ enum CollisionEventMode
 class URHO3D_API RigidBody : public Component, public btMotionState
 {
     URHO3D_OBJECT(RigidBody, Component);
+    friend class PhysicsWorld;
 
 public:
     /// Construct.
@@ -169,6 +170,9 @@ public:
     void ResetForces();
     /// Activate rigid body if it was resting.
     void Activate();
+    /// Set whether the rigid body is affected by physics LOD regardless of its collision layer.
+    /// @property
+    void SetLodEnabled(bool enable) { lodEnabled_ = enable; }
     /// Readd rigid body to the physics world to clean up internal state like stale contacts.
     void ReAddBodyToWorld();
     /// Disable mass update. Call this to optimize performance when adding or editing multiple collision shapes in the same node.
@@ -279,6 +283,13 @@ public:
     /// @property
     CollisionEventMode GetCollisionEventMode() const { return collisionEventMode_; }
 
+    /// Return whether the rigid body is affected by physics LOD regardless of its collision layer.
+    /// @property
+    bool IsLodEnabled() const { return lodEnabled_; }
+
+    /// Return whether the rigid body was outside of physics LOD interest radius on the last physics update.
+    bool IsLodDistant() const { return lodDistant_; }
+
     /// Return colliding rigid bodies from the last simulation step. Only returns collisions that were sent as events (depends on collision event mode) and excludes e.g. static-static collisions.
     void GetCollidingBodies(ea::vector<RigidBody*>& result) const;
 
@@ -294,6 +305,8 @@ public:
     void RemoveConstraint(Constraint* constraint);
     /// Remove the rigid body.
     void ReleaseBody();
+    /// Apply physics LOD state. Called by PhysicsWorld.
+    void UpdateLod(bool distant, bool freeze, bool skipSync);
 
 protected:
     /// Handle node being assigned.
@@ -304,6 +317,8 @@ protected:
     void OnMarkedDirty(Node* node) override;
 
 private:
+    /// Apply transform of Bullet rigid body to the node.
+    void ApplyMotionStateTransform(const btTransform& worldTrans);
     /// Create the rigid body, or re-add to the physics world with changed flags. Calls UpdateMass().
     void AddBodyToWorld();
     /// Remove the rigid body from the physics world.
@@ -351,6 +366,22 @@ private:
     bool enableMassUpdate_;
     /// Internal flag whether has simulated at least once.
     mutable bool hasSimulated_;
+    /// Index of the pending transform in the bulk transform sync of PhysicsWorld.
+    unsigned bulkTransformIndex_{M_MAX_UNSIGNED};
+    /// Linear velocity before physics LOD froze the body.
+    Vector3 lodLinearVelocity_;
+    /// Angular velocity before physics LOD froze the body.
+    Vector3 lodAngularVelocity_;
+    /// Physics LOD enabled flag.
+    bool lodEnabled_{};
+    /// Whether the body is outside of physics LOD interest radius.
+    bool lodDistant_{};
+    /// Whether the body is frozen by physics LOD.
+    bool lodFrozen_{};
+    /// Whether to skip node transform update on this physics update.
+    bool lodSkipSync_{};
+    /// Whether node transform update was skipped and not applied yet.
+    bool lodSyncPending_{};
 };
 
 }
@@ -24,6 +24,7 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/DebugRenderer.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/Renderer.h"
@@ -44,6 +45,37 @@ namespace Urho3D
 static const Vector2 DEFAULT_GRAVITY(0.0f, -9.81f);
 static const int DEFAULT_VELOCITY_ITERATIONS = 8;
 static const int DEFAULT_POSITION_ITERATIONS = 3;
+static const unsigned ISLAND_BATCH_SIZE = 8;
+
+namespace
+{
+
+/// Executes Box2D island solving tasks on the WorkQueue.
+class WorkQueueTaskExecutor2D : public b2TaskExecutor
+{
+public:
+    explicit WorkQueueTaskExecutor2D(WorkQueue* workQueue) : workQueue_(workQueue) {}
+
+    void ParallelFor(int32 count, Task task, void* context) override
+    {
+        if (count <= 0)
+            return;
+
+        if (!workQueue_ || workQueue_->GetNumThreads() == 0)
+        {
+            task(context, 0, count);
+            return;
+        }
+
+        ForEachParallel(workQueue_, ISLAND_BATCH_SIZE, static_cast<unsigned>(count),
+            [&](unsigned beginIndex, unsigned endIndex) { task(context, beginIndex, endIndex); });
+    }
+
+private:
+    WorkQueue* workQueue_{};
+};
+
+}
 
 PhysicsWorld2D::PhysicsWorld2D(Context* context) :
     Component(context),
@@ -88,6 +120,9 @@ void PhysicsWorld2D::RegisterObject(Context* context)
         AM_DEFAULT);
     URHO3D_ACCESSOR_ATTRIBUTE("Position Iterations", GetPositionIterations, SetPositionIterations, int, DEFAULT_POSITION_ITERATIONS,
         AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Multi Threaded", IsMultiThreaded, SetMultiThreaded, bool, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Contact Events", bool, contactEventsEnabled_, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Contact Buffer", IsContactBufferEnabled, SetContactBufferEnabled, bool, false, AM_DEFAULT);
 }
 
 void PhysicsWorld2D::DrawDebugGeometry(DebugRenderer* debug, bool depthTest)
@@ -114,7 +149,10 @@ void PhysicsWorld2D::BeginContact(b2Contact* contact)
     if (!fixtureA || !fixtureB)
         return;
 
-    beginContactInfos_.push_back(ContactInfo(contact));
+    if (contactBufferEnabled_)
+        BufferContact(contact, true);
+    if (contactEventsEnabled_)
+        beginContactInfos_.push_back(ContactInfo(contact));
 }
 
 void PhysicsWorld2D::EndContact(b2Contact* contact)
@@ -127,11 +165,17 @@ void PhysicsWorld2D::EndContact(b2Contact* contact)
     if (!fixtureA || !fixtureB)
         return;
 
-    endContactInfos_.push_back(ContactInfo(contact));
+    if (contactBufferEnabled_)
+        BufferContact(contact, false);
+    if (contactEventsEnabled_)
+        endContactInfos_.push_back(ContactInfo(contact));
 }
 
 void PhysicsWorld2D::PreSolve(b2Contact* contact, const b2Manifold* oldManifold)
 {
+    if (!contactEventsEnabled_)
+        return;
+
     b2Fixture* fixtureA = contact->GetFixtureA();
     b2Fixture* fixtureB = contact->GetFixtureB();
     if (!fixtureA || !fixtureB)
@@ -289,43 +333,13 @@ void PhysicsWorld2D::Update(float timeStep)
         SendEvent(E_PHYSICSPRESTEP, eventData);
     }
 
+    bufferedContacts_.clear();
+
     physicsStepping_ = true;
     world_->Step(timeStep, velocityIterations_, positionIterations_);
     physicsStepping_ = false;
 
-    // Apply world transforms. Unparented transforms first
-    for (unsigned i = 0; i < rigidBodies_.size();)
-    {
-        if (rigidBodies_[i])
-        {
-            rigidBodies_[i]->ApplyWorldTransform();
-            ++i;
-        }
-        else
-        {
-            // Erase possible stale weak pointer
-            rigidBodies_.erase_at(i);
-        }
-    }
-
-    // Apply delayed (parented) world transforms now, if any
-    while (!delayedWorldTransforms_.empty())
-    {
-        for (auto i = delayedWorldTransforms_.begin();
-            i != delayedWorldTransforms_.end();)
-        {
-            const DelayedWorldTransform2D& transform = i->second;
-
-            // If parent's transform has already been assigned, can proceed
-            if (!delayedWorldTransforms_.contains(transform.parentRigidBody_))
-            {
-                transform.rigidBody_->ApplyWorldTransform(transform.worldPosition_, transform.worldRotation_);
-                i = delayedWorldTransforms_.erase(i);
-            }
-            else
-                ++i;
-        }
-    }
+    ApplyWorldTransforms();
 
     SendBeginContactEvents();
     SendEndContactEvents();
@@ -436,6 +450,26 @@ void PhysicsWorld2D::SetPositionIterations(int positionIterations)
     positionIterations_ = positionIterations;
 }
 
+void PhysicsWorld2D::SetMultiThreaded(bool enable)
+{
+    if (enable == multiThreaded_)
+        return;
+
+    multiThreaded_ = enable;
+    if (multiThreaded_)
+        taskExecutor_ = ea::make_unique<WorkQueueTaskExecutor2D>(GetSubsystem<WorkQueue>());
+    world_->SetTaskExecutor(taskExecutor_.get());
+    if (!multiThreaded_)
+        taskExecutor_ = nullptr;
+}
+
+void PhysicsWorld2D::SetContactBufferEnabled(bool enable)
+{
+    contactBufferEnabled_ = enable;
+    if (!contactBufferEnabled_)
+        bufferedContacts_.clear();
+}
+
 void PhysicsWorld2D::AddRigidBody(RigidBody2D* rigidBody)
 {
     if (!rigidBody)
@@ -729,6 +763,71 @@ void PhysicsWorld2D::HandleSceneSubsystemUpdate(StringHash eventType, VariantMap
     Update(eventData[P_TIMESTEP].GetFloat());
 }
 
+void PhysicsWorld2D::ApplyWorldTransforms()
+{
+    // Node dirtying is disregarded for the whole batch instead of each body
+    SetApplyingTransforms(true);
+
+    // Apply world transforms. Unparented transforms first
+    for (unsigned i = 0; i < rigidBodies_.size();)
+    {
+        if (rigidBodies_[i])
+        {
+            rigidBodies_[i]->ApplyWorldTransform();
+            ++i;
+        }
+        else
+        {
+            // Erase possible stale weak pointer
+            rigidBodies_.erase_at(i);
+        }
+    }
+
+    // Apply delayed (parented) world transforms now, if any
+    while (!delayedWorldTransforms_.empty())
+    {
+        for (auto i = delayedWorldTransforms_.begin();
+            i != delayedWorldTransforms_.end();)
+        {
+            const DelayedWorldTransform2D& transform = i->second;
+
+            // If parent's transform has already been assigned, can proceed
+            if (!delayedWorldTransforms_.contains(transform.parentRigidBody_))
+            {
+                transform.rigidBody_->ApplyWorldTransform(transform.worldPosition_, transform.worldRotation_);
+                i = delayedWorldTransforms_.erase(i);
+            }
+            else
+                ++i;
+        }
+    }
+
+    SetApplyingTransforms(false);
+}
+
+void PhysicsWorld2D::BufferContact(b2Contact* contact, bool begin)
+{
+    b2Fixture* fixtureA = contact->GetFixtureA();
+    b2Fixture* fixtureB = contact->GetFixtureB();
+
+    PhysicsContact2D& bufferedContact = bufferedContacts_.emplace_back();
+    bufferedContact.bodyA_ = static_cast<RigidBody2D*>(fixtureA->GetBody()->GetUserData());
+    bufferedContact.bodyB_ = static_cast<RigidBody2D*>(fixtureB->GetBody()->GetUserData());
+    bufferedContact.shapeA_ = static_cast<CollisionShape2D*>(fixtureA->GetUserData());
+    bufferedContact.shapeB_ = static_cast<CollisionShape2D*>(fixtureB->GetUserData());
+    bufferedContact.begin_ = begin;
+
+    b2WorldManifold worldManifold;
+    contact->GetWorldManifold(&worldManifold);
+    bufferedContact.numPoints_ = contact->GetManifold()->pointCount;
+    bufferedContact.worldNormal_ = Vector2(worldManifold.normal.x, worldManifold.normal.y);
+    for (int i = 0; i < bufferedContact.numPoints_; ++i)
+    {
+        bufferedContact.worldPositions_[i] = Vector2(worldManifold.points[i].x, worldManifold.points[i].y);
+        bufferedContact.separations_[i] = worldManifold.separations[i];
+    }
+}
+
 void PhysicsWorld2D::SendBeginContactEvents()
 {
     if (beginContactInfos_.empty())
@@ -53,6 +53,29 @@ struct URHO3D_API PhysicsRaycastResult2D
     RigidBody2D* body_{};
 };
 
+/// Contact buffered by PhysicsWorld2D during the physics update.
+struct URHO3D_API PhysicsContact2D
+{
+    /// Rigid body A.
+    RigidBody2D* bodyA_{};
+    /// Rigid body B.
+    RigidBody2D* bodyB_{};
+    /// Shape A.
+    CollisionShape2D* shapeA_{};
+    /// Shape B.
+    CollisionShape2D* shapeB_{};
+    /// Whether the fixtures began to touch. False if they ceased to touch.
+    bool begin_{};
+    /// Number of contact points.
+    int numPoints_{};
+    /// Contact normal in world space.
+    Vector2 worldNormal_;
+    /// Contact positions in world space.
+    Vector2 worldPositions_[b2_maxManifoldPoints];
+    /// Contact overlap values.
+    float separations_[b2_maxManifoldPoints]{};
+};
+
 /// Delayed world transform assignment for parented 2D rigidbodies.
 struct DelayedWorldTransform2D
 {
@@ -153,6 +176,16 @@ public:
     /// Set position iterations.
     /// @property
     void SetPositionIterations(int positionIterations);
+    /// Set whether to solve simulation islands in parallel on the WorkQueue threads. Disabled by default.
+    /// Box2D contact listener PostSolve callback is called from worker threads in this mode.
+    /// @property
+    void SetMultiThreaded(bool enable);
+    /// Set whether to send begin, end and update contact events. Enabled by default.
+    /// @property
+    void SetContactEventsEnabled(bool enable) { contactEventsEnabled_ = enable; }
+    /// Set whether to collect begin and end contacts into the contact buffer on each physics update. Disabled by default.
+    /// @property
+    void SetContactBufferEnabled(bool enable);
     /// Add rigid body.
     void AddRigidBody(RigidBody2D* rigidBody);
     /// Remove rigid body.
@@ -225,6 +258,21 @@ public:
     /// @property
     int GetPositionIterations() const { return positionIterations_; }
 
+    /// Return whether simulation islands are solved in parallel.
+    /// @property
+    bool IsMultiThreaded() const { return multiThreaded_; }
+
+    /// Return whether contact events are sent.
+    /// @property
+    bool IsContactEventsEnabled() const { return contactEventsEnabled_; }
+
+    /// Return whether the contact buffer is collected.
+    /// @property
+    bool IsContactBufferEnabled() const { return contactBufferEnabled_; }
+
+    /// Return contacts collected during the last physics update. Pointers are not valid after the bodies are removed.
+    const ea::vector<PhysicsContact2D>& GetContacts() const { return bufferedContacts_; }
+
     /// Return the Box2D physics world.
     b2World* GetWorld() { return world_.get(); }
 
@@ -240,6 +288,10 @@ protected:
 
     /// Handle the scene subsystem update event, step simulation here.
     void HandleSceneSubsystemUpdate(StringHash eventType, VariantMap& eventData);
+    /// Apply simulated transforms to nodes of all rigid bodies.
+    void ApplyWorldTransforms();
+    /// Append contact to the contact buffer.
+    void BufferContact(b2Contact* contact, bool begin);
     /// Send begin contact events.
     void SendBeginContactEvents();
     /// Send end contact events.
@@ -253,6 +305,14 @@ protected:
     int velocityIterations_{};
     /// Position iterations.
     int positionIterations_{};
+    /// Executor of parallel island solving, if enabled.
+    ea::unique_ptr<b2TaskExecutor> taskExecutor_;
+    /// Parallel island solving flag.
+    bool multiThreaded_{};
+    /// Contact events flag.
+    bool contactEventsEnabled_{true};
+    /// Contact buffer flag.
+    bool contactBufferEnabled_{};
 
     /// Extra weak pointer to scene to allow for cleanup in case the world is destroyed before other components.
     WeakPtr<Scene> scene_;
@@ -309,6 +369,8 @@ protected:
     ea::vector<ContactInfo> endContactInfos_;
     /// Temporary buffer with contact data.
     VectorBuffer contacts_;
+    /// Contact buffer.
+    ea::vector<PhysicsContact2D> bufferedContacts_;
 };
 
 }
@@ -424,14 +424,9 @@ void RigidBody2D::ApplyWorldTransform()
 
 void RigidBody2D::ApplyWorldTransform(const Vector3& newWorldPosition, const Quaternion& newWorldRotation)
 {
+    // PhysicsWorld2D disregards node dirtying while applying transforms, so changed position is not fed back to simulation
     if (newWorldPosition != node_->GetWorldPosition() || newWorldRotation != node_->GetWorldRotation())
-    {
-        // Do not feed changed position back to simulation now
-        physicsWorld_->SetApplyingTransforms(true);
-        node_->SetWorldPosition(newWorldPosition);
-        node_->SetWorldRotation(newWorldRotation);
-        physicsWorld_->SetApplyingTransforms(false);
-    }
+        node_->SetWorldTransform(newWorldPosition, newWorldRotation);
 }
 
 void RigidBody2D::AddCollisionShape2D(CollisionShape2D* collisionShape)
@@ -125,7 +125,7 @@ public:
 
     /// Apply world transform from the Box2D body. Called by PhysicsWorld2D.
     void ApplyWorldTransform();
-    /// Apply specified world position & rotation. Called by PhysicsWorld2D.
+    /// Apply specified world position & rotation. Called by PhysicsWorld2D while applying transforms.
     void ApplyWorldTransform(const Vector3& newWorldPosition, const Quaternion& newWorldRotation);
     /// Add collision shape.
     void AddCollisionShape2D(CollisionShape2D* collisionShape);
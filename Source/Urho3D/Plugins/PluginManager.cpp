@@ -77,6 +77,7 @@ ea::string PathToName(const ea::string& path)
 
 PluginStack::PluginStack(PluginManager* manager, const StringVector& plugins)
     : Object(manager->GetContext())
+    , manager_(manager)
 {
     for (const ea::string& name : plugins)
     {
@@ -149,11 +150,17 @@ void PluginStack::StartApplication(const ea::string& mainPlugin)
     }
 
     mainApplication_ = FindMainPlugin(mainPlugin);
+    mainApplicationName_.clear();
 
     for (const PluginInfo& info : applications_)
     {
-        if (info.application_)
-            info.application_->StartApplication(info.application_ == mainApplication_);
+        if (!info.application_)
+            continue;
+
+        const bool isMain = info.application_ == mainApplication_;
+        if (isMain)
+            mainApplicationName_ = info.name_;
+        info.application_->StartApplication(isMain);
     }
     isStarted_ = true;
 }
@@ -170,13 +177,7 @@ SerializedPlugins PluginStack::SuspendApplication()
     isStarted_ = false;
 
     for (const PluginInfo& info : ea::reverse(applications_))
-    {
-        if (!info.application_)
-            continue;
-
-        BinaryOutputArchive archive{context_, data[info.name_]};
-        info.application_->SuspendApplication(archive, info.version_);
-    }
+        SuspendPlugin(info, data);
     return data;
 }
 
@@ -189,21 +190,7 @@ void PluginStack::ResumeApplication(const SerializedPlugins& serializedPlugins)
     }
 
     for (const PluginInfo& info : applications_)
-    {
-        if (!info.application_)
-            continue;
-
-        const auto iter = serializedPlugins.find(info.name_);
-        if (iter == serializedPlugins.end())
-            info.application_->ResumeApplication(nullptr, info.version_);
-        else
-        {
-            const VectorBuffer& pluginData = iter->second;
-            MemoryBuffer dataView{pluginData.GetBuffer()};
-            BinaryInputArchive archive{context_, dataView};
-            info.application_->ResumeApplication(&archive, info.version_);
-        }
-    }
+        ResumePlugin(info, serializedPlugins);
     isStarted_ = true;
 }
 
@@ -224,6 +211,106 @@ void PluginStack::StopApplication()
     }
 }
 
+unsigned PluginStack::FindFirstPlugin(const StringVector& plugins) const
+{
+    for (unsigned i = 0; i < applications_.size(); ++i)
+    {
+        if (plugins.contains(applications_[i].name_))
+            return i;
+    }
+    return M_MAX_UNSIGNED;
+}
+
+StringVector PluginStack::GetReflectedTypeNames(unsigned startIndex) const
+{
+    StringVector result;
+    for (unsigned i = startIndex; i < applications_.size(); ++i)
+    {
+        if (const PluginApplication* application = applications_[i].application_)
+        {
+            for (const StringHash type : application->GetReflectedTypes())
+                result.push_back(context_->GetTypeName(type));
+        }
+    }
+    return result;
+}
+
+SerializedPlugins PluginStack::SuspendPlugins(unsigned startIndex)
+{
+    SerializedPlugins data;
+    if (startIndex >= applications_.size())
+        return data;
+
+    const auto affectedApplications = ea::span(applications_).subspan(startIndex);
+    if (isStarted_)
+    {
+        for (const PluginInfo& info : ea::reverse(affectedApplications))
+            SuspendPlugin(info, data);
+    }
+
+    for (const PluginInfo& info : ea::reverse(affectedApplications))
+    {
+        if (info.application_)
+            info.application_->UnloadPlugin();
+    }
+    return data;
+}
+
+void PluginStack::ResumePlugins(unsigned startIndex, const SerializedPlugins& serializedPlugins)
+{
+    if (startIndex >= applications_.size() || !manager_)
+        return;
+
+    // Reloaded modules have new instances of plugin applications
+    const auto affectedApplications = ea::span(applications_).subspan(startIndex);
+    for (PluginInfo& info : affectedApplications)
+    {
+        info.application_ = manager_->GetPluginApplication(info.name_, true, &info.version_);
+        for (PluginInfo& mainInfo : mainApplications_)
+        {
+            if (mainInfo.name_ == info.name_)
+                mainInfo = info;
+        }
+        if (!mainApplicationName_.empty() && info.name_ == mainApplicationName_)
+            mainApplication_ = info.application_;
+
+        if (info.application_)
+            info.application_->LoadPlugin();
+    }
+
+    if (isStarted_)
+    {
+        for (const PluginInfo& info : affectedApplications)
+            ResumePlugin(info, serializedPlugins);
+    }
+}
+
+void PluginStack::SuspendPlugin(const PluginInfo& info, SerializedPlugins& serializedPlugins)
+{
+    if (!info.application_)
+        return;
+
+    BinaryOutputArchive archive{context_, serializedPlugins[info.name_]};
+    info.application_->SuspendApplication(archive, info.version_);
+}
+
+void PluginStack::ResumePlugin(const PluginInfo& info, const SerializedPlugins& serializedPlugins)
+{
+    if (!info.application_)
+        return;
+
+    const auto iter = serializedPlugins.find(info.name_);
+    if (iter == serializedPlugins.end())
+        info.application_->ResumeApplication(nullptr, info.version_);
+    else
+    {
+        const VectorBuffer& pluginData = iter->second;
+        MemoryBuffer dataView{pluginData.GetBuffer()};
+        BinaryInputArchive archive{context_, dataView};
+        info.application_->ResumeApplication(&archive, info.version_);
+    }
+}
+
 PluginApplication* PluginStack::GetMainPlugin() const
 {
     return mainApplication_;
@@ -424,7 +511,10 @@ void PluginManager::DisposeStack()
 {
     URHO3D_ASSERT(pluginStack_ != nullptr);
 
-    SendEvent(E_BEGINPLUGINRELOAD);
+    using namespace BeginPluginReload;
+    VariantMap& eventData = GetEventDataMap();
+    eventData[P_PARTIAL] = false;
+    SendEvent(E_BEGINPLUGINRELOAD, eventData);
 
     wasStarted_ = pluginStack_->IsStarted();
     if (wasStarted_)
@@ -441,7 +531,10 @@ void PluginManager::RestoreStack()
         pluginStack_->ResumeApplication(restoreBuffer_);
     restoreBuffer_.clear();
 
-    SendEvent(E_ENDPLUGINRELOAD);
+    using namespace EndPluginReload;
+    VariantMap& eventData = GetEventDataMap();
+    eventData[P_PARTIAL] = false;
+    SendEvent(E_ENDPLUGINRELOAD, eventData);
 }
 
 void PluginManager::Update(bool exiting)
@@ -464,10 +557,27 @@ void PluginManager::Update(bool exiting)
     if (checkOutOfDate)
         reloadTimer_.Reset();
 
+    ea::vector<Plugin*> outOfDatePlugins;
     for (const auto& [name, plugin] : dynamicPlugins_)
-        UpdatePlugin(plugin, checkOutOfDate);
+    {
+        if (!plugin->GetApplication())
+            continue;
+
+        const bool pluginOutOfDate = forceReload_ || (checkOutOfDate && plugin->IsOutOfDate());
+        if (plugin->IsUnloading())
+        {
+            PerformPluginUnload(plugin);
+            if (pluginOutOfDate)
+                TryReloadPlugin(plugin);
+        }
+        else if (pluginOutOfDate)
+            outOfDatePlugins.push_back(plugin);
+    }
     forceReload_ = false;
 
+    if (!outOfDatePlugins.empty())
+        ReloadPlugins(outOfDatePlugins);
+
     ea::erase_if(dynamicPlugins_, [&](const auto& item) { return CheckAndRemoveUnloadedPlugin(item.second); });
 
     if (exiting)
@@ -486,19 +596,59 @@ void PluginManager::Update(bool exiting)
     }
 }
 
-void PluginManager::UpdatePlugin(Plugin* plugin, bool checkOutOfDate)
+void PluginManager::ReloadPlugins(const ea::vector<Plugin*>& plugins)
 {
-    if (!plugin->GetApplication())
+    if (ReloadPluginsIncremental(plugins))
         return;
 
-    const bool wasApplicationLoaded = plugin->GetApplication()->IsLoaded();
-    const bool pluginOutOfDate = forceReload_ || (checkOutOfDate && plugin->IsOutOfDate());
-
-    if (plugin->IsUnloading() || pluginOutOfDate)
+    for (Plugin* plugin : plugins)
+    {
         PerformPluginUnload(plugin);
+        TryReloadPlugin(plugin);
+    }
+}
+
+bool PluginManager::ReloadPluginsIncremental(const ea::vector<Plugin*>& plugins)
+{
+    if (!pluginStack_)
+        return false;
+
+    StringVector pluginNames;
+    for (Plugin* plugin : plugins)
+        pluginNames.push_back(plugin->GetName());
 
-    if (pluginOutOfDate)
+    // Plugins loaded after the reloaded ones may depend on them, so they are restarted too.
+    // Plugins loaded before stay intact together with all their objects.
+    const unsigned startIndex = pluginStack_->FindFirstPlugin(pluginNames);
+    if (startIndex != M_MAX_UNSIGNED)
+    {
+        using namespace BeginPluginReload;
+        VariantMap& eventData = GetEventDataMap();
+        eventData[P_PARTIAL] = true;
+        eventData[P_TYPES] = pluginStack_->GetReflectedTypeNames(startIndex);
+        SendEvent(E_BEGINPLUGINRELOAD, eventData);
+    }
+
+    const SerializedPlugins serializedPlugins = startIndex != M_MAX_UNSIGNED
+        ? pluginStack_->SuspendPlugins(startIndex) : SerializedPlugins{};
+
+    for (Plugin* plugin : plugins)
+    {
+        plugin->PerformUnload();
         TryReloadPlugin(plugin);
+    }
+
+    if (startIndex != M_MAX_UNSIGNED)
+    {
+        pluginStack_->ResumePlugins(startIndex, serializedPlugins);
+
+        using namespace EndPluginReload;
+        VariantMap& eventData = GetEventDataMap();
+        eventData[P_PARTIAL] = true;
+        SendEvent(E_ENDPLUGINRELOAD, eventData);
+    }
+
+    return true;
 }
 
 void PluginManager::PerformPluginUnload(Plugin* plugin)
@@ -55,6 +55,15 @@ public:
     /// Stop plugin application for all loaded plugins.
     void StopApplication();
 
+    /// Return index of the first plugin from the list, or M_MAX_UNSIGNED if none of the plugins is in the stack.
+    unsigned FindFirstPlugin(const StringVector& plugins) const;
+    /// Return names of object types registered by plugins starting from specified index.
+    StringVector GetReflectedTypeNames(unsigned startIndex) const;
+    /// Suspend and unload plugins starting from specified index. Preceding plugins stay loaded and running.
+    SerializedPlugins SuspendPlugins(unsigned startIndex);
+    /// Reacquire, load and resume plugins starting from specified index.
+    void ResumePlugins(unsigned startIndex, const SerializedPlugins& serializedPlugins);
+
     /// Return whether the application is started now.
     bool IsStarted() const { return isStarted_; }
     /// Return number of loaded plugins.
@@ -74,10 +83,14 @@ private:
     void LoadPlugins();
     void UnloadPlugins();
     PluginApplication* FindMainPlugin(const ea::string& mainPlugin) const;
+    void SuspendPlugin(const PluginInfo& info, SerializedPlugins& serializedPlugins);
+    void ResumePlugin(const PluginInfo& info, const SerializedPlugins& serializedPlugins);
 
+    WeakPtr<PluginManager> manager_;
     ea::vector<PluginInfo> applications_;
     ea::vector<PluginInfo> mainApplications_;
     WeakPtr<PluginApplication> mainApplication_;
+    ea::string mainApplicationName_;
     bool isStarted_{};
 };
 
@@ -136,7 +149,8 @@ private:
     void RestoreStack();
 
     void Update(bool exiting);
-    void UpdatePlugin(Plugin* plugin, bool checkOutOfDate);
+    void ReloadPlugins(const ea::vector<Plugin*>& plugins);
+    bool ReloadPluginsIncremental(const ea::vector<Plugin*>& plugins);
 
     void PerformPluginUnload(Plugin* plugin);
     void TryReloadPlugin(Plugin* plugin);
@@ -46,7 +46,8 @@ void AmbientOcclusionPass::SetSettings(const AmbientOcclusionPassSettings& setti
 {
     if (settings_ != settings)
     {
-        const bool resetCachedTextures = settings_.downscale_ != settings.downscale_;
+        const bool resetCachedTextures =
+            settings_.downscale_ != settings.downscale_ || settings_.temporal_ != settings.temporal_;
         settings_ = settings;
         if (resetCachedTextures)
             InitializeTextures();
@@ -60,6 +61,21 @@ void AmbientOcclusionPass::InitializeTextures()
     const RenderBufferParams params{format, 1, RenderBufferFlag::BilinearFiltering};
     textures_.currentTarget_ = renderBufferManager_->CreateColorBuffer(params, sizeMultiplier);
     textures_.previousTarget_ = renderBufferManager_->CreateColorBuffer(params, sizeMultiplier);
+
+    if (settings_.temporal_)
+    {
+        const RenderBufferParams historyParams{Graphics::GetRGBAFloat16Format(), 1,
+            RenderBufferFlag::BilinearFiltering | RenderBufferFlag::Persistent};
+        for (SharedPtr<RenderBuffer>& history : textures_.history_)
+            history = renderBufferManager_->CreateColorBuffer(historyParams, sizeMultiplier);
+    }
+    else
+    {
+        for (SharedPtr<RenderBuffer>& history : textures_.history_)
+            history = nullptr;
+    }
+    isHistoryValid_ = false;
+
     textures_.noise_ = context_->GetSubsystem<ResourceCache>()->GetResource<Texture2D>("Textures/SSAONoise.png");
 }
 
@@ -71,6 +87,7 @@ void AmbientOcclusionPass::InitializeStates()
     pipelineStates_->ssaoDeferred_ = renderBufferManager_->CreateQuadPipelineState(BLEND_REPLACE, "v2/P_SSAO", "EVALUATE_OCCLUSION DEFERRED");
     pipelineStates_->blurForward_ = renderBufferManager_->CreateQuadPipelineState(BLEND_REPLACE, "v2/P_SSAO", "BLUR");
     pipelineStates_->blurDeferred_ = renderBufferManager_->CreateQuadPipelineState(BLEND_REPLACE, "v2/P_SSAO", "BLUR DEFERRED");
+    pipelineStates_->temporal_ = renderBufferManager_->CreateQuadPipelineState(BLEND_REPLACE, "v2/P_SSAO", "TEMPORAL");
     pipelineStates_->combine_ = renderBufferManager_->CreateQuadPipelineState(BLEND_ALPHA, "v2/P_SSAO", "COMBINE");
     pipelineStates_->preview_ = renderBufferManager_->CreateQuadPipelineState(BLEND_REPLACE, "v2/P_SSAO", "PREVIEW");
 }
@@ -102,6 +119,14 @@ void AmbientOcclusionPass::EvaluateAO(Camera* camera, const Matrix4& viewToTextu
     radiusInfo.z_ = settings_.radiusNear_;
     radiusInfo.w_ = settings_.radiusFar_;
 
+    // Shift noise texture every frame in temporal mode so each pixel cycles through all 16 sample rotations
+    Vector2 noiseOffset;
+    if (settings_.temporal_)
+    {
+        const unsigned offsetIndex = frameIndex_ % 16;
+        noiseOffset = Vector2{static_cast<float>(offsetIndex % 4), static_cast<float>(offsetIndex / 4)} * 0.25f;
+    }
+
     const ShaderParameterDesc shaderParameters[] = {
         {"InputInvSize", inputInvSize},
         {"BlurStep", inputInvSize},
@@ -109,6 +134,7 @@ void AmbientOcclusionPass::EvaluateAO(Camera* camera, const Matrix4& viewToTextu
         {"Exponent", settings_.exponent_},
         {"RadiusInfo", radiusInfo},
         {"FadeDistance", Vector2{settings_.fadeDistanceBegin_, settings_.fadeDistanceEnd_}},
+        {"NoiseOffset", noiseOffset},
         {"ViewToTexture", viewToTextureSpace},
         {"TextureToView", textureToViewSpace},
         {"WorldToView", worldToViewSpaceCorrected},
@@ -185,12 +211,60 @@ void AmbientOcclusionPass::BlurTexture(const Matrix4& textureToViewSpace)
     }
 }
 
-void AmbientOcclusionPass::Blit(PipelineState* state)
+Texture2D* AmbientOcclusionPass::AccumulateAO(
+    Camera* camera, const Matrix4& viewToTextureSpace, const Matrix4& textureToViewSpace)
+{
+    static const float historyWeight = 0.9f;
+
+    RenderBuffer* currentHistory = textures_.history_[historyIndex_];
+    RenderBuffer* previousHistory = textures_.history_[historyIndex_ ^ 1];
+    historyIndex_ ^= 1;
+
+    // Persistent buffers are recreated on resize, history is lost in this case
+    const Matrix4 worldToView = camera->GetView().ToMatrix4();
+    const IntVector2 historySize = currentHistory->GetTexture2D()->GetSize();
+    if (historySize != historySize_)
+    {
+        historySize_ = historySize;
+        isHistoryValid_ = false;
+    }
+
+    const Matrix4 viewToPreviousView = previousWorldToView_ * worldToView.Inverse();
+    previousWorldToView_ = worldToView;
+
+    const ShaderParameterDesc shaderParameters[] = {
+        {"ViewToTexture", viewToTextureSpace},
+        {"TextureToView", textureToViewSpace},
+        {"ViewToPreviousView", viewToPreviousView},
+        {"BlurZThreshold", settings_.blurDepthThreshold_},
+        {"HistoryWeight", isHistoryValid_ ? historyWeight : 0.0f},
+    };
+
+    const ShaderResourceDesc shaderResources[] = {
+        {TU_DIFFUSE, textures_.previousTarget_->GetTexture2D()},
+        {TU_SPECULAR, previousHistory->GetTexture2D()},
+        {TU_DEPTHBUFFER, renderBufferManager_->GetDepthStencilTexture()},
+    };
+
+    DrawQuadParams drawParams;
+    drawParams.resources_ = shaderResources;
+    drawParams.parameters_ = shaderParameters;
+    drawParams.clipToUVOffsetAndScale_ = renderBufferManager_->GetDefaultClipToUVSpaceOffsetAndScale();
+    drawParams.pipelineState_ = pipelineStates_->temporal_;
+
+    renderBufferManager_->SetRenderTargets(nullptr, {currentHistory});
+    renderBufferManager_->DrawQuad("SSAO Temporal Accumulation", drawParams);
+
+    isHistoryValid_ = true;
+    return currentHistory->GetTexture2D();
+}
+
+void AmbientOcclusionPass::Blit(PipelineState* state, Texture2D* texture)
 {
     renderBufferManager_->SetOutputRenderTargets();
 
     const ShaderResourceDesc shaderResources[] = {
-        {TU_DIFFUSE, textures_.previousTarget_->GetTexture2D()}};
+        {TU_DIFFUSE, texture}};
 
     renderBufferManager_->DrawViewportQuad("SSAO Combine", state, shaderResources, {});
 }
@@ -209,7 +283,10 @@ void AmbientOcclusionPass::Execute(Camera* camera)
         return;
 
     if (settings_.strength_ <= 0.0f)
+    {
+        isHistoryValid_ = false;
         return;
+    }
 
     // Convert texture coordinates into clip space
     Matrix4 clipToTextureSpace = Matrix4::IDENTITY;
@@ -220,12 +297,24 @@ void AmbientOcclusionPass::Execute(Camera* camera)
     const Matrix4 textureToViewSpace = viewToTextureSpace.Inverse();
 
     EvaluateAO(camera, viewToTextureSpace, textureToViewSpace);
-    BlurTexture(textureToViewSpace);
+
+    // Temporal accumulation replaces spatial blur
+    Texture2D* ambientOcclusionTexture = nullptr;
+    if (settings_.temporal_)
+    {
+        ambientOcclusionTexture = AccumulateAO(camera, viewToTextureSpace, textureToViewSpace);
+        ++frameIndex_;
+    }
+    else
+    {
+        BlurTexture(textureToViewSpace);
+        ambientOcclusionTexture = textures_.previousTarget_->GetTexture2D();
+    }
 
     switch (settings_.ambientOcclusionMode_)
     {
-    case AmbientOcclusionMode::Preview: Blit(pipelineStates_->preview_); break;
-    default: Blit(pipelineStates_->combine_); break;
+    case AmbientOcclusionMode::Preview: Blit(pipelineStates_->preview_, ambientOcclusionTexture); break;
+    default: Blit(pipelineStates_->combine_, ambientOcclusionTexture); break;
     }
 }
 
@@ -62,7 +62,9 @@ protected:
     void InitializeStates();
     void EvaluateAO(Camera* camera, const Matrix4& viewToTextureSpace, const Matrix4& textureToViewSpace);
     void BlurTexture(const Matrix4& textureToViewSpace);
-    void Blit(PipelineState* state);
+    /// Blend evaluated AO with reprojected history. Return texture with accumulated AO.
+    Texture2D* AccumulateAO(Camera* camera, const Matrix4& viewToTextureSpace, const Matrix4& textureToViewSpace);
+    void Blit(PipelineState* state, Texture2D* texture);
 
     AmbientOcclusionPassSettings settings_;
 
@@ -73,6 +75,8 @@ protected:
         SharedPtr<Texture2D> noise_;
         SharedPtr<RenderBuffer> currentTarget_;
         SharedPtr<RenderBuffer> previousTarget_;
+        /// History buffers for temporal mode: view-space depth in R channel and occlusion in A channel.
+        SharedPtr<RenderBuffer> history_[2];
     };
     CachedTextures textures_;
 
@@ -82,17 +86,27 @@ protected:
         SharedPtr<PipelineState> ssaoDeferred_;
         SharedPtr<PipelineState> blurForward_;
         SharedPtr<PipelineState> blurDeferred_;
+        SharedPtr<PipelineState> temporal_;
         SharedPtr<PipelineState> combine_;
         SharedPtr<PipelineState> preview_;
 
         bool IsValid()
         {
             return !!ssaoForward_ && ssaoForward_->IsValid() && blurForward_->IsValid() && ssaoDeferred_->IsValid()
-                && blurDeferred_->IsValid() && combine_->IsValid() && preview_->IsValid();
+                && blurDeferred_->IsValid() && temporal_->IsValid() && combine_->IsValid() && preview_->IsValid();
         }
     };
     ea::optional<CachedStates> pipelineStates_;
 
+    /// Temporal mode state
+    /// @{
+    unsigned frameIndex_{};
+    unsigned historyIndex_{};
+    bool isHistoryValid_{};
+    IntVector2 historySize_;
+    Matrix4 previousWorldToView_;
+    /// @}
+
 #endif
 };
 
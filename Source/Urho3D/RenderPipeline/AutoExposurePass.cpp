@@ -22,8 +22,12 @@
 
 #include "../Precompiled.h"
 
+#include "../Core/Timer.h"
+#include "../Graphics/ComputeBuffer.h"
+#include "../Graphics/ComputeDevice.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/Texture2D.h"
+#include "../IO/Log.h"
 #include "../RenderPipeline/RenderBufferManager.h"
 #include "../RenderPipeline/AutoExposurePass.h"
 
@@ -32,9 +36,21 @@
 namespace Urho3D
 {
 
+namespace
+{
+
+#if defined(URHO3D_COMPUTE)
+const char* histogramShaderName = "v2/C_AutoExposureHistogram";
+#endif
+
+}
+
 AutoExposurePass::AutoExposurePass(
     RenderPipelineInterface* renderPipeline, RenderBufferManager* renderBufferManager)
     : PostProcessPass(renderPipeline, renderBufferManager)
+#if defined(URHO3D_COMPUTE)
+    , computeDevice_(GetSubsystem<ComputeDevice>())
+#endif
 {
     InitializeTextures();
 }
@@ -49,6 +65,9 @@ void AutoExposurePass::SetSettings(const AutoExposurePassSettings& settings)
         {
             pipelineStates_ = ea::nullopt;
             InitializeTextures();
+#if defined(URHO3D_COMPUTE)
+            isHistogramInitialized_ = false;
+#endif
         }
     }
 }
@@ -163,6 +182,84 @@ void AutoExposurePass::EvaluateAdaptedLuminance()
     isAdaptedLuminanceInitialized_ = true;
 }
 
+#if defined(URHO3D_COMPUTE)
+bool AutoExposurePass::InitializeHistogram()
+{
+    if (!computeDevice_ || !computeDevice_->IsSupported() || !Graphics::GetRGBAFloat16Format())
+        return false;
+
+    if (!histogramLuminance_)
+    {
+        histogramBuffer_ = MakeShared<ComputeBuffer>(context_);
+        histogramParametersBuffer_ = MakeShared<ComputeBuffer>(context_);
+
+        histogramLuminance_ = MakeShared<Texture2D>(context_);
+        histogramLuminance_->SetNumLevels(1);
+        histogramLuminance_->SetFilterMode(FILTER_NEAREST);
+        histogramLuminance_->SetUnorderedAccess(true);
+        if (!histogramLuminance_->SetSize(1, 1, Graphics::GetRGBAFloat16Format()))
+        {
+            URHO3D_LOGERROR("Failed to create texture for luminance histogram");
+            computeDevice_ = nullptr;
+            return false;
+        }
+    }
+
+    // Histogram is cleared by the shader after use, so it has to be cleared manually only once
+    ea::vector<Vector4> histogramData(NumHistogramBins / 4 + 1);
+    const unsigned histogramSize = histogramData.size() * sizeof(Vector4);
+    if (!histogramBuffer_->SetData(histogramData.data(), histogramSize, sizeof(Vector4)))
+        return false;
+
+    isHistogramInitialized_ = true;
+    return true;
+}
+
+Texture2D* AutoExposurePass::EvaluateHistogramLuminance()
+{
+    const bool isFirstFrame = !isHistogramInitialized_;
+    if (isFirstFrame && !InitializeHistogram())
+        return nullptr;
+
+    auto graphics = GetSubsystem<Graphics>();
+    ShaderVariation* histogramShader = graphics->GetShader(CS, histogramShaderName, "HISTOGRAM");
+    ShaderVariation* averageShader = graphics->GetShader(CS, histogramShaderName, "AVERAGE");
+    Texture2D* inputTexture = renderBufferManager_->GetSecondaryColorTexture();
+    if (!histogramShader || !averageShader || !inputTexture)
+        return nullptr;
+
+    const float timeStep = GetSubsystem<Time>()->GetTimeStep();
+    const float adaptationFactor = isFirstFrame ? 1.0f : 1.0f - std::exp(-timeStep * settings_.adaptRate_);
+
+    HistogramParameters parameters;
+    parameters.logLuminanceRange_ = Vector4(
+        MinLogLuminance, MaxLogLuminance - MinLogLuminance, 1.0f / (MaxLogLuminance - MinLogLuminance), 0.0f);
+    parameters.percentilesAndAdaptation_ =
+        Vector4(settings_.lowPercentile_, settings_.highPercentile_, adaptationFactor, 0.0f);
+    histogramParametersBuffer_->SetData(&parameters, sizeof(HistogramParameters), sizeof(HistogramParameters));
+
+    const IntVector2 inputSize = inputTexture->GetSize();
+    computeDevice_->SetReadTexture(inputTexture, 0);
+    computeDevice_->SetWriteTexture(histogramLuminance_, 0, 0, 0);
+    computeDevice_->SetWriteBuffer(histogramBuffer_, 1);
+    computeDevice_->SetWriteBuffer(histogramParametersBuffer_, 2);
+    computeDevice_->SetProgram(histogramShader);
+    computeDevice_->Dispatch((inputSize.x_ + HistogramGroupSize - 1) / HistogramGroupSize,
+        (inputSize.y_ + HistogramGroupSize - 1) / HistogramGroupSize, 1);
+
+    computeDevice_->SetProgram(averageShader);
+    computeDevice_->Dispatch(1, 1, 1);
+
+    computeDevice_->SetReadTexture(nullptr, 0);
+    computeDevice_->SetWriteTexture(nullptr, 0, 0, 0);
+    computeDevice_->SetWriteBuffer(static_cast<ComputeBuffer*>(nullptr), 1);
+    computeDevice_->SetWriteBuffer(static_cast<ComputeBuffer*>(nullptr), 2);
+    computeDevice_->ApplyBindings();
+
+    return histogramLuminance_;
+}
+#endif
+
 void AutoExposurePass::Execute(Camera* camera)
 {
     if (!pipelineStates_)
@@ -173,15 +270,24 @@ void AutoExposurePass::Execute(Camera* camera)
 
     renderBufferManager_->SwapColorBuffers(false);
 
+    Texture2D* adaptedLuminance = nullptr;
     if (settings_.autoExposure_)
     {
-        EvaluateDownsampledColorBuffer();
-        EvaluateLuminance();
-        EvaluateAdaptedLuminance();
+#if defined(URHO3D_COMPUTE)
+        if (settings_.luminanceHistogram_)
+            adaptedLuminance = EvaluateHistogramLuminance();
+#endif
+        if (!adaptedLuminance)
+        {
+            EvaluateDownsampledColorBuffer();
+            EvaluateLuminance();
+            EvaluateAdaptedLuminance();
+            adaptedLuminance = textures_.adaptedLum_->GetTexture2D();
+        }
     }
 
     const ShaderResourceDesc shaderResources[] = {
-        { TU_NORMAL, settings_.autoExposure_ ? textures_.adaptedLum_->GetTexture2D() : nullptr }
+        { TU_NORMAL, adaptedLuminance }
     };
     const ShaderParameterDesc shaderParameters[] = {
         { "MinMaxExposure", Vector2(settings_.minExposure_, settings_.maxExposure_) },
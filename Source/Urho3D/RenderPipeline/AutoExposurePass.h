@@ -32,10 +32,15 @@
 namespace Urho3D
 {
 
+class ComputeBuffer;
+class ComputeDevice;
 class RenderBufferManager;
 class RenderPipelineInterface;
+class Texture2D;
 
 /// Post-processing pass that adjusts HDR scene exposure.
+/// If compute is supported, average luminance is evaluated from histogram of log luminance in single dispatch.
+/// Otherwise, luminance is evaluated by downsampling color buffer to 1x1 texture.
 class URHO3D_API AutoExposurePass
     : public PostProcessPass
 {
@@ -56,6 +61,33 @@ protected:
     void EvaluateLuminance();
     void EvaluateAdaptedLuminance();
 
+#if defined(URHO3D_COMPUTE)
+    /// Number of histogram bins. Bin 0 is reserved for black pixels. Should match C_AutoExposureHistogram shader.
+    static const unsigned NumHistogramBins = 256;
+    /// Size of compute group. Should match C_AutoExposureHistogram shader.
+    static const unsigned HistogramGroupSize = 16;
+    /// Range of log2 luminance covered by histogram.
+    static constexpr float MinLogLuminance = -10.0f;
+    static constexpr float MaxLogLuminance = 6.0f;
+
+    /// Parameters of histogram shader. Layout should match C_AutoExposureHistogram shader.
+    struct HistogramParameters
+    {
+        Vector4 logLuminanceRange_;
+        Vector4 percentilesAndAdaptation_;
+    };
+
+    bool InitializeHistogram();
+    /// Evaluate adapted luminance from histogram. Return null if not supported.
+    Texture2D* EvaluateHistogramLuminance();
+
+    WeakPtr<ComputeDevice> computeDevice_;
+    bool isHistogramInitialized_{};
+    SharedPtr<ComputeBuffer> histogramBuffer_;
+    SharedPtr<ComputeBuffer> histogramParametersBuffer_;
+    SharedPtr<Texture2D> histogramLuminance_;
+#endif
+
     bool isAdaptedLuminanceInitialized_{};
     AutoExposurePassSettings settings_;
 
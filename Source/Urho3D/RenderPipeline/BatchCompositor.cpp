@@ -22,10 +22,12 @@
 
 #include "../Precompiled.h"
 
+#include "../Container/RadixSort.h"
 #include "../IO/Log.h"
 #include "../Graphics/Renderer.h"
 #include "../RenderPipeline/BatchCompositor.h"
 #include "../RenderPipeline/LightProcessor.h"
+#include "../RenderPipeline/PipelineBatchSortKey.h"
 #include "../RenderPipeline/RenderPipelineDefs.h"
 #include "../Scene/Node.h"
 
@@ -243,7 +245,10 @@ void BatchCompositor::ComposeShadowBatches()
         {
             workQueue_->AddWorkItem([=](unsigned threadIndex)
             {
-                BeginShadowBatchesComposition(lightIndex, lightProcessor->GetMutableSplit(splitIndex));
+                // Sort batches right away unless some of them are waiting for pipeline state creation
+                ShadowSplitProcessor* splitProcessor = lightProcessor->GetMutableSplit(splitIndex);
+                if (!BeginShadowBatchesComposition(lightIndex, splitProcessor))
+                    splitProcessor->FinalizeShadowBatches();
             }, M_MAX_UNSIGNED);
         }
     }
@@ -273,7 +278,7 @@ void BatchCompositor::ComposeLightVolumeBatches()
     for (unsigned lightIndex = 0; lightIndex < lightProcessors.size(); ++lightIndex)
     {
         LightProcessor* lightProcessor = lightProcessors[lightIndex];
-        if (!lightProcessor->HasLitGeometries())
+        if (!lightProcessor->HasLitGeometries() || lightProcessor->IsTiled())
             continue;
 
         Light* light = lightProcessor->GetLight();
@@ -298,7 +303,33 @@ void BatchCompositor::ComposeLightVolumeBatches()
     }
 
     FillSortKeys(sortedLightVolumeBatches_, lightVolumeBatches_);
-    ea::sort(sortedLightVolumeBatches_.begin(), sortedLightVolumeBatches_.end());
+    SortBatches(sortedLightVolumeBatches_);
+}
+
+void BatchCompositor::SortBatches(ea::span<PipelineBatchByState> sortedBatches)
+{
+    thread_local ea::vector<PipelineBatchByState> buffer;
+
+    // Sort by secondary key first, stable sort by primary key preserves secondary order
+    PipelineBatchByState* begin = sortedBatches.data();
+    PipelineBatchByState* end = begin + sortedBatches.size();
+    RadixSort(begin, end, buffer, [](const PipelineBatchByState& batch) { return batch.secondaryKey_; });
+    RadixSort(begin, end, buffer, [](const PipelineBatchByState& batch) { return batch.primaryKey_; });
+}
+
+void BatchCompositor::SortBatches(ea::span<PipelineBatchBackToFront> sortedBatches)
+{
+    thread_local ea::vector<PipelineBatchBackToFront> buffer;
+
+    PipelineBatchBackToFront* begin = sortedBatches.data();
+    PipelineBatchBackToFront* end = begin + sortedBatches.size();
+    RadixSort(begin, end, buffer, [](const PipelineBatchBackToFront& batch)
+    {
+        // Inverted distance key sorts batches back to front
+        const unsigned long long renderOrder = batch.renderOrder_;
+        const unsigned long long distance = ~FloatToRadixKey(batch.distance_);
+        return (renderOrder << 32) | distance;
+    });
 }
 
 void BatchCompositor::OnUpdateBegin(const CommonFrameInfo& frameInfo)
@@ -318,8 +349,10 @@ void BatchCompositor::OnPipelineStatesInvalidated()
     lightVolumeCache_.Invalidate();
 }
 
-void BatchCompositor::BeginShadowBatchesComposition(unsigned lightIndex, ShadowSplitProcessor* splitProcessor)
+bool BatchCompositor::BeginShadowBatchesComposition(unsigned lightIndex, ShadowSplitProcessor* splitProcessor)
 {
+    bool hasDelayedBatches = false;
+
     LightProcessor* lightProcessor = splitProcessor->GetLightProcessor();
     const unsigned lightHash = lightProcessor->GetShadowHash(splitProcessor->GetSplitIndex());
 
@@ -372,9 +405,13 @@ void BatchCompositor::BeginShadowBatchesComposition(unsigned lightIndex, ShadowS
                 }
             }
             else
+            {
                 delayedShadowBatches_.PushBack(threadIndex, { splitProcessor, desc });
+                hasDelayedBatches = true;
+            }
         }
     }
+    return hasDelayedBatches;
 }
 
 void BatchCompositor::FinalizeShadowBatchesComposition()
@@ -396,19 +433,19 @@ void BatchCompositor::FinalizeShadowBatchesComposition()
         }
     }
 
-    // Finalize shadow batches
-    const auto& lightProcessors = drawableProcessor_->GetLightProcessors();
-    for (unsigned lightIndex = 0; lightIndex < lightProcessors.size(); ++lightIndex)
+    // Finalize shadow batches of splits that were not finalized in worker threads
+    delayedShadowSplits_.clear();
+    for (const auto& splitAndKey : delayedShadowBatches_)
+        delayedShadowSplits_.push_back(splitAndKey.first);
+    ea::sort(delayedShadowSplits_.begin(), delayedShadowSplits_.end());
+    delayedShadowSplits_.erase(ea::unique(delayedShadowSplits_.begin(), delayedShadowSplits_.end()), delayedShadowSplits_.end());
+
+    for (ShadowSplitProcessor* splitProcessor : delayedShadowSplits_)
     {
-        LightProcessor* lightProcessor = lightProcessors[lightIndex];
-        const unsigned numSplits = lightProcessor->GetNumSplits();
-        for (unsigned splitIndex = 0; splitIndex < numSplits; ++splitIndex)
+        workQueue_->AddWorkItem([=](unsigned threadIndex)
         {
-            workQueue_->AddWorkItem([=](unsigned threadIndex)
-            {
-                lightProcessor->GetMutableSplit(splitIndex)->FinalizeShadowBatches();
-            }, M_MAX_UNSIGNED);
-        }
+            splitProcessor->FinalizeShadowBatches();
+        }, M_MAX_UNSIGNED);
     }
     workQueue_->Complete(M_MAX_UNSIGNED);
 }
@@ -41,6 +41,7 @@ class PipelineState;
 class PipelineStateBuilder;
 class ShadowSplitProcessor;
 class WorkQueue;
+struct PipelineBatchBackToFront;
 struct PipelineBatchByState;
 
 /// Self-sufficient batch that can be sorted and rendered by RenderPipeline.
@@ -257,6 +258,12 @@ public:
         }
     }
 
+    /// Sort batches in place using radix sort. Safe to call from worker thread.
+    /// @{
+    static void SortBatches(ea::span<PipelineBatchByState> sortedBatches);
+    static void SortBatches(ea::span<PipelineBatchBackToFront> sortedBatches);
+    /// @}
+
 protected:
     /// Callbacks from RenderPipeline
     /// @{
@@ -264,8 +271,8 @@ protected:
     virtual void OnPipelineStatesInvalidated();
     /// @}
 
-    /// Safe to call from worker thread.
-    void BeginShadowBatchesComposition(unsigned lightIndex, ShadowSplitProcessor* splitProcessor);
+    /// Safe to call from worker thread. Return whether some batches are delayed until pipeline states are created.
+    bool BeginShadowBatchesComposition(unsigned lightIndex, ShadowSplitProcessor* splitProcessor);
     /// Should be called from main thread.
     void FinalizeShadowBatchesComposition();
 
@@ -295,6 +302,7 @@ private:
     /// @}
 
     WorkQueueVector<ea::pair<ShadowSplitProcessor*, PipelineBatchDesc>> delayedShadowBatches_;
+    ea::vector<ShadowSplitProcessor*> delayedShadowSplits_;
     ea::vector<PipelineBatch> lightVolumeBatches_;
     ea::vector<PipelineBatchByState> sortedLightVolumeBatches_;
 };
@@ -23,6 +23,7 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/Camera.h"
 #include "../Graphics/DrawCommandQueue.h"
 #include "../Graphics/Graphics.h"
@@ -50,6 +51,12 @@ namespace Urho3D
 namespace
 {
 
+/// Return whether two materials bind exactly the same textures.
+bool HaveSameTextures(const Material& lhs, const Material& rhs)
+{
+    return lhs.GetTexturesHash() == rhs.GetTexturesHash() && lhs.GetTextures() == rhs.GetTextures();
+}
+
 /// Return shader parameter for camera depth mode.
 Vector4 GetCameraDepthModeParameter(const Camera& camera)
 {
@@ -303,6 +310,9 @@ private:
         current_.constantDepthBias_ = constantDepthBias;
 
         dirty_.material_ = current_.material_ != pipelineBatch.material_;
+        // Materials that share textures don't need shader resources to be rebound
+        dirty_.materialTextures_ = dirty_.material_
+            && (!current_.material_ || !HaveSameTextures(*current_.material_, *pipelineBatch.material_));
         current_.material_ = pipelineBatch.material_;
 
         dirty_.geometry_ = current_.geometry_ != pipelineBatch.geometry_;
@@ -434,9 +444,22 @@ private:
         }
 
         customMaterialParameters_->clear();
-        if (drawQueue_.BeginShaderParameterGroup(SP_MATERIAL, dirty_.material_ || dirty_.lightmapConstants_))
+        const bool materialConstantsDirty = dirty_.material_ || dirty_.lightmapConstants_;
+        const bool hasLightmapConstants = enabled_.ambientLighting_ && current_.lightmapScaleOffset_;
+        if (drawQueue_.UsesConstantBuffers() && !hasLightmapConstants)
+        {
+            // Material constants don't depend on the batch and are stored in persistent buffer owned by material
+            if (drawQueue_.SetMaterialConstantBuffer(current_.material_, depthRange_, materialConstantsDirty))
+            {
+                for (const auto& parameter : current_.material_->GetShaderParameters())
+                {
+                    if (parameter.second.isCustom_)
+                        customMaterialParameters_->push_back(&parameter);
+                }
+            }
+        }
+        else if (drawQueue_.BeginShaderParameterGroup(SP_MATERIAL, materialConstantsDirty))
         {
-            // TODO: This block may be cached for some APIs
             const auto& materialParameters = current_.material_->GetShaderParameters();
             for (const auto& parameter : materialParameters)
             {
@@ -446,6 +469,7 @@ private:
                     continue;
                 }
 
+                // Keep in sync with Material::GetOrCreateConstantBuffer
                 if (parameter.first == ShaderConsts::Material_FadeOffsetScale)
                 {
                     const Vector2 param = parameter.second.value_.GetVector2();
@@ -456,7 +480,7 @@ private:
                     drawQueue_.AddShaderParameter(parameter.first, parameter.second.value_);
             }
 
-            if (enabled_.ambientLighting_ && current_.lightmapScaleOffset_)
+            if (hasLightmapConstants)
                 drawQueue_.AddShaderParameter(ShaderConsts::Material_LMOffset, *current_.lightmapScaleOffset_);
 
             drawQueue_.CommitShaderParameterGroup(SP_MATERIAL);
@@ -476,7 +500,7 @@ private:
 
     void UpdateDirtyResources()
     {
-        const bool resourcesDirty = dirty_.material_ || dirty_.reflectionProbe_ || dirty_.IsResourcesDirty();
+        const bool resourcesDirty = dirty_.materialTextures_ || dirty_.reflectionProbe_ || dirty_.IsResourcesDirty();
         if (resourcesDirty)
         {
             for (const ShaderResourceDesc& desc : globalResources_)
@@ -654,19 +678,28 @@ private:
     /// @{
     void CommitDrawCalls(unsigned numInstances, const SourceBatch& sourceBatch)
     {
-        IndexBuffer* indexBuffer = current_.geometry_->GetIndexBuffer();
+        Geometry* geometry = current_.geometry_;
+        IndexBuffer* indexBuffer = geometry->GetDrawIndexBuffer();
 
         if (dirty_.geometry_)
-            drawQueue_.SetBuffers({ current_.geometry_->GetVertexBuffers(), indexBuffer, nullptr });
+            drawQueue_.SetBuffers({ geometry->GetDrawVertexBuffers(), indexBuffer, nullptr });
 
         for (unsigned i = 0; i < numInstances; ++i)
         {
             objectParameterBuilder_.AddBatchUniformsToDrawQueue(drawQueue_, cameraNode_, sourceBatch, i);
 
-            if (indexBuffer != nullptr)
-                drawQueue_.DrawIndexed(current_.geometry_->GetIndexStart(), current_.geometry_->GetIndexCount());
+            if (indexBuffer != nullptr && sourceBatch.numGeometryInstances_ > 0)
+            {
+                drawQueue_.DrawIndexedInstanced(geometry->GetDrawIndexStart(), geometry->GetIndexCount(),
+                    geometry->GetDrawBaseVertexIndex(), 0, sourceBatch.numGeometryInstances_);
+            }
+            else if (indexBuffer != nullptr)
+            {
+                drawQueue_.DrawIndexed(geometry->GetDrawIndexStart(), geometry->GetIndexCount(),
+                    geometry->GetDrawBaseVertexIndex());
+            }
             else
-                drawQueue_.Draw(current_.geometry_->GetVertexStart(), current_.geometry_->GetVertexCount());
+                drawQueue_.Draw(geometry->GetVertexStart(), geometry->GetVertexCount());
         }
     }
 
@@ -674,10 +707,10 @@ private:
     {
         assert(instancingGroup_.count_ > 0);
         Geometry* geometry = instancingGroup_.geometry_;
-        drawQueue_.SetBuffers({ geometry->GetVertexBuffers(), geometry->GetIndexBuffer(),
+        drawQueue_.SetBuffers({ geometry->GetDrawVertexBuffers(), geometry->GetDrawIndexBuffer(),
             instancingBuffer_.GetVertexBuffer() });
-        drawQueue_.DrawIndexedInstanced(geometry->GetIndexStart(), geometry->GetIndexCount(),
-            instancingGroup_.start_, instancingGroup_.count_);
+        drawQueue_.DrawIndexedInstanced(geometry->GetDrawIndexStart(), geometry->GetIndexCount(),
+            geometry->GetDrawBaseVertexIndex(), instancingGroup_.start_, instancingGroup_.count_);
         instancingGroup_.count_ = 0;
     }
     /// @}
@@ -777,6 +810,7 @@ private:
         /// @{
         bool pipelineState_{};
         bool material_{};
+        bool materialTextures_{};
         bool geometry_{};
         bool reflectionProbe_{};
 
@@ -876,10 +910,21 @@ BatchRenderingContext::BatchRenderingContext(DrawCommandQueue& drawQueue, const
 {
 }
 
+BatchRenderingContext::BatchRenderingContext(DrawCommandQueue& drawQueue, const BatchRenderingContext& other)
+    : drawQueue_(drawQueue)
+    , camera_(other.camera_)
+    , outputShadowSplit_(other.outputShadowSplit_)
+    , globalResources_(other.globalResources_)
+    , frameParameters_(other.frameParameters_)
+    , cameraParameters_(other.cameraParameters_)
+{
+}
+
 BatchRenderer::BatchRenderer(RenderPipelineInterface* renderPipeline, const DrawableProcessor* drawableProcessor,
     InstancingBuffer* instancingBuffer)
     : Object(renderPipeline->GetContext())
     , renderer_(context_->GetSubsystem<Renderer>())
+    , workQueue_(context_->GetSubsystem<WorkQueue>())
     , debugger_(renderPipeline->GetDebugger())
     , drawableProcessor_(drawableProcessor)
     , instancingBuffer_(instancingBuffer)
@@ -903,7 +948,7 @@ void BatchRenderer::RenderBatches(const BatchRenderingContext& ctx, PipelineBatc
             compositor.ProcessSceneBatch(*sortedBatch.pipelineBatch_);
         compositor.FlushDrawCommands(batchGroup.startInstance_ + batchGroup.numInstances_);
     }
-    else
+    else if (!RenderBatchesInParallel(ctx, batchGroup))
     {
         DrawCommandCompositor<false> compositor(ctx, settings_, nullptr,
             *drawableProcessor_, *instancingBuffer_, batchGroup.flags_, batchGroup.startInstance_);
@@ -925,7 +970,7 @@ void BatchRenderer::RenderBatches(const BatchRenderingContext& ctx, PipelineBatc
             compositor.ProcessSceneBatch(*sortedBatch.pipelineBatch_);
         compositor.FlushDrawCommands(batchGroup.startInstance_ + batchGroup.numInstances_);
     }
-    else
+    else if (!RenderBatchesInParallel(ctx, batchGroup))
     {
         DrawCommandCompositor<false> compositor(ctx, settings_, nullptr,
             *drawableProcessor_, *instancingBuffer_, batchGroup.flags_, batchGroup.startInstance_);
@@ -997,6 +1042,67 @@ void BatchRenderer::PrepareInstancingBufferImpl(PipelineBatchGroup<T>& batches)
     }
 }
 
+template <class T>
+bool BatchRenderer::RenderBatchesInParallel(const BatchRenderingContext& ctx, const PipelineBatchGroup<T>& batchGroup)
+{
+    // Merging of draw queues is supported only for constant buffers
+    const unsigned numBatches = batchGroup.batches_.size();
+    const unsigned maxChunks = ea::min(workQueue_->GetNumThreads() + 1, numBatches / MinBatchesPerRecordingTask);
+    if (maxChunks <= 1 || !ctx.drawQueue_.UsesConstantBuffers())
+        return false;
+
+    const unsigned chunkSize = (numBatches + maxChunks - 1) / maxChunks;
+    const unsigned numChunks = (numBatches + chunkSize - 1) / chunkSize;
+
+    // Find first instance of each chunk, it should match the order of instances in PrepareInstancingBuffer
+    ObjectParameterBuilder objectParameterBuilder(settings_, batchGroup.flags_);
+    ea::fixed_vector<unsigned, 32> chunkStartInstances(numChunks + 1);
+    unsigned instanceIndex = batchGroup.startInstance_;
+    for (unsigned i = 0; i < numBatches; ++i)
+    {
+        if (i % chunkSize == 0)
+            chunkStartInstances[i / chunkSize] = instanceIndex;
+
+        const PipelineBatch& pipelineBatch = *batchGroup.batches_[i].pipelineBatch_;
+        if (objectParameterBuilder.IsBatchInstanced(pipelineBatch))
+        {
+            instanceIndex += pipelineBatch.geometryType_ == GEOM_STATIC
+                ? pipelineBatch.GetSourceBatch().numWorldTransforms_ : 1u;
+        }
+    }
+    chunkStartInstances[numChunks] = instanceIndex;
+
+    auto graphics = GetSubsystem<Graphics>();
+    while (recordingQueues_.size() < numChunks)
+        recordingQueues_.push_back(MakeShared<DrawCommandQueue>(graphics));
+
+    const IntRect& scissorRect = ctx.drawQueue_.GetCurrentScissorRect();
+    ForEachParallel(workQueue_, 1, numChunks, [&](unsigned beginChunk, unsigned endChunk)
+    {
+        for (unsigned chunkIndex = beginChunk; chunkIndex < endChunk; ++chunkIndex)
+        {
+            DrawCommandQueue& drawQueue = *recordingQueues_[chunkIndex];
+            drawQueue.Reset();
+            if (scissorRect != IntRect::ZERO)
+                drawQueue.SetScissorRect(scissorRect);
+
+            const BatchRenderingContext chunkCtx(drawQueue, ctx);
+            DrawCommandCompositor<false> compositor(chunkCtx, settings_, nullptr,
+                *drawableProcessor_, *instancingBuffer_, batchGroup.flags_, chunkStartInstances[chunkIndex]);
+
+            const unsigned beginBatch = chunkIndex * chunkSize;
+            const unsigned endBatch = ea::min(beginBatch + chunkSize, numBatches);
+            for (unsigned batchIndex = beginBatch; batchIndex < endBatch; ++batchIndex)
+                compositor.ProcessSceneBatch(*batchGroup.batches_[batchIndex].pipelineBatch_);
+            compositor.FlushDrawCommands(chunkStartInstances[chunkIndex + 1]);
+        }
+    });
+
+    for (unsigned chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex)
+        ctx.drawQueue_.Append(*recordingQueues_[chunkIndex]);
+    return true;
+}
+
 BatchRenderFlags BatchRenderer::AdjustRenderFlags(BatchRenderFlags flags) const
 {
     if (!instancingBuffer_->IsEnabled())
@@ -37,6 +37,7 @@ class Camera;
 class DrawableProcessor;
 class InstancingBuffer;
 class ShadowSplitProcessor;
+class WorkQueue;
 
 /// Common parameters of batch rendering
 struct BatchRenderingContext
@@ -51,6 +52,8 @@ struct BatchRenderingContext
 
     BatchRenderingContext(DrawCommandQueue& drawQueue, const Camera& camera);
     BatchRenderingContext(DrawCommandQueue& drawQueue, const ShadowSplitProcessor& outputShadowSplit);
+    /// Copy context with different draw queue.
+    BatchRenderingContext(DrawCommandQueue& drawQueue, const BatchRenderingContext& other);
 };
 
 /// Utility class to convert pipeline batches into sequence of draw commands.
@@ -77,20 +80,30 @@ public:
     void PrepareInstancingBuffer(PipelineBatchGroup<PipelineBatchBackToFront>& batches);
     /// @}
 
+    /// Minimum number of batches recorded by one thread.
+    static const unsigned MinBatchesPerRecordingTask = 128;
+
 private:
     template <class T>
     void PrepareInstancingBufferImpl(PipelineBatchGroup<T>& batches);
+    /// Record batches into multiple draw queues in worker threads and append them to the output queue in order.
+    /// Return false if parallel recording is not possible or not worth it.
+    template <class T>
+    bool RenderBatchesInParallel(const BatchRenderingContext& ctx, const PipelineBatchGroup<T>& batchGroup);
     BatchRenderFlags AdjustRenderFlags(BatchRenderFlags flags) const;
 
     /// External dependencies
     /// @{
     Renderer* renderer_{};
+    WorkQueue* workQueue_{};
     RenderPipelineDebugger* debugger_{};
     const DrawableProcessor* drawableProcessor_{};
     InstancingBuffer* instancingBuffer_{};
     /// @}
 
     BatchRendererSettings settings_;
+    /// Draw queues for parallel recording.
+    ea::vector<SharedPtr<DrawCommandQueue>> recordingQueues_;
 };
 
 }
@@ -0,0 +1,264 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../RenderPipeline/ClusteredLightProcessor.h"
+
+#include "../Core/Context.h"
+#include "../Graphics/Camera.h"
+#include "../Graphics/ClusteredDecalSet.h"
+#include "../Graphics/Graphics.h"
+#include "../Graphics/Light.h"
+#include "../Graphics/Texture2D.h"
+#include "../RenderPipeline/DrawableProcessor.h"
+#include "../RenderPipeline/LightProcessor.h"
+#include "../RenderPipeline/ShaderConsts.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Cluster texture layout: light indices of each cluster are stored in NumIndexRowsPerCluster consecutive texels along Y.
+/// Decal indices of all clusters are stored below light indices in the same layout.
+const int ClusterTextureWidth = static_cast<int>(ClusteredLightProcessor::NumClustersX * ClusteredLightProcessor::NumClustersY);
+const int ClusterTextureLightRows = static_cast<int>(ClusteredLightProcessor::NumClustersZ * ClusteredLightProcessor::MaxLightsPerCluster / 4);
+const int ClusterTextureDecalRows = static_cast<int>(ClusteredLightProcessor::NumClustersZ * ClusteredLightProcessor::MaxDecalsPerCluster / 4);
+const int ClusterTextureHeight = ClusterTextureLightRows + ClusterTextureDecalRows;
+
+}
+
+ClusteredLightProcessor::ClusteredLightProcessor(Context* context)
+    : Object(context)
+{
+    static_assert(MaxDecals == MaxLights, "Decal data is stored in the same texture as light data");
+
+    clusterLightCounts_.resize(NumClustersX * NumClustersY * NumClustersZ);
+    clusterDecalCounts_.resize(NumClustersX * NumClustersY * NumClustersZ);
+    clusterData_.resize(ClusterTextureWidth * ClusterTextureHeight);
+    lightData_.resize(MaxLights * (NumDataRowsPerLight + NumDataRowsPerDecal));
+    CreateTextures();
+}
+
+ClusteredLightProcessor::~ClusteredLightProcessor() = default;
+
+bool ClusteredLightProcessor::IsClusteredLight(const LightProcessor* lightProcessor)
+{
+    const Light* light = lightProcessor->GetLight();
+    const LightType lightType = light->GetLightType();
+    if (lightType != LIGHT_POINT && lightType != LIGHT_SPOT)
+        return false;
+
+    const CookedLightParams& params = lightProcessor->GetParams();
+    return !lightProcessor->HasShadow() && !light->IsNegative()
+        && !params.lightRamp_ && !params.lightShape_
+        && params.volumetricRadius_ <= 0.0f && params.volumetricLength_ <= 0.0f;
+}
+
+void ClusteredLightProcessor::CreateTextures()
+{
+    const unsigned format = Graphics::GetRGBAFloat32Format();
+
+    clusterTexture_ = MakeShared<Texture2D>(context_);
+    clusterTexture_->SetName("[LightClusterMap]");
+    clusterTexture_->SetNumLevels(1);
+    clusterTexture_->SetFilterMode(FILTER_NEAREST);
+    clusterTexture_->SetSize(ClusterTextureWidth, ClusterTextureHeight, format, TEXTURE_DYNAMIC);
+
+    lightDataTexture_ = MakeShared<Texture2D>(context_);
+    lightDataTexture_->SetName("[LightDataMap]");
+    lightDataTexture_->SetNumLevels(1);
+    lightDataTexture_->SetFilterMode(FILTER_NEAREST);
+    lightDataTexture_->SetSize(MaxLights, NumDataRowsPerLight + NumDataRowsPerDecal, format, TEXTURE_DYNAMIC);
+}
+
+void ClusteredLightProcessor::Update(Camera* camera, DrawableProcessor* drawableProcessor,
+    const ClusteredDecalSet* decalSet, bool linearSpaceLighting)
+{
+    URHO3D_PROFILE("UpdateClusteredLights");
+
+    // Setup depth slices
+    const Matrix3x4& view = camera->GetView();
+    projection_ = camera->GetProjection();
+    clusterNear_ = ea::max(camera->GetNearClip(), MinClusterDepth);
+    clusterFar_ = ea::max(camera->GetFarClip(), clusterNear_ * 2.0f);
+    depthSliceScale_ = NumClustersZ / Ln(clusterFar_ / clusterNear_);
+    depthSliceBias_ = -Ln(clusterNear_) * depthSliceScale_;
+
+    ea::fill(clusterLightCounts_.begin(), clusterLightCounts_.end(), 0u);
+    ea::fill(clusterDecalCounts_.begin(), clusterDecalCounts_.end(), 0u);
+    ea::fill(clusterData_.begin(), clusterData_.end(), Vector4{-1.0f, -1.0f, -1.0f, -1.0f});
+
+    // Select and bin lights
+    numLights_ = 0;
+    for (LightProcessor* lightProcessor : drawableProcessor->GetLightProcessors())
+    {
+        if (numLights_ >= MaxLights)
+            break;
+        if (!lightProcessor->HasForwardLitGeometries() || !IsClusteredLight(lightProcessor))
+            continue;
+
+        const CookedLightParams& params = lightProcessor->GetParams();
+        const float range = lightProcessor->GetLight()->GetRange();
+        BinSphere(numLights_, view * params.position_, range, clusterLightCounts_, MaxLightsPerCluster,
+            0, NumIndexRowsPerCluster);
+
+        Vector4* lightData = &lightData_[numLights_];
+        lightData[0 * MaxLights] = Vector4{ params.position_, params.inverseRange_ };
+        lightData[1 * MaxLights] = Vector4{ params.GetColor(linearSpaceLighting), params.effectiveSpecularIntensity_ };
+        lightData[2 * MaxLights] = Vector4{ params.direction_, params.spotCutoff_ };
+        lightData[3 * MaxLights] = Vector4{ params.inverseSpotCutoff_, 0.0f, 0.0f, 0.0f };
+
+        lightProcessor->SetClustered(true);
+        ++numLights_;
+    }
+
+    UpdateDecals(view, decalSet);
+
+    // Upload data
+    clusterTexture_->SetData(0, 0, 0, ClusterTextureWidth, ClusterTextureHeight, clusterData_.data());
+    if (numLights_ > 0 || numDecals_ > 0)
+        lightDataTexture_->SetData(0, 0, 0, MaxLights, NumDataRowsPerLight + NumDataRowsPerDecal, lightData_.data());
+
+    // Setup shader resources
+    shaderResources_.clear();
+#ifdef DESKTOP_GRAPHICS
+    shaderResources_.push_back({ TU_FACESELECT, clusterTexture_ });
+    shaderResources_.push_back({ TU_INDIRECTION, lightDataTexture_ });
+    if (numDecals_ > 0)
+        shaderResources_.push_back({ TU_LIGHTBUFFER, decalSet->GetTexture() });
+#endif
+
+    // Setup shader parameters
+    shaderParameters_.clear();
+    shaderParameters_.push_back({ ShaderConsts::Camera_LightClusterViewProj, projection_ * view });
+    shaderParameters_.push_back({ ShaderConsts::Camera_LightClusterViewZ, Vector4{ view.m20_, view.m21_, view.m22_, view.m23_ } });
+    shaderParameters_.push_back({ ShaderConsts::Camera_LightClusterDepthParams, Vector4{ depthSliceScale_, depthSliceBias_, 0.0f, 0.0f } });
+}
+
+void ClusteredLightProcessor::UpdateDecals(const Matrix3x4& view, const ClusteredDecalSet* decalSet)
+{
+    numDecals_ = 0;
+    if (!decalSet || !decalSet->IsEnabledEffective() || !decalSet->GetTexture())
+        return;
+
+    for (const ClusteredDecal& decal : decalSet->GetDecals())
+    {
+        if (numDecals_ >= MaxDecals)
+            break;
+
+        // Decal box spans [-0.5, 0.5] along each local axis
+        const Matrix3x4& transform = decal.worldTransform_;
+        const Vector3 halfSize = transform.Scale() * 0.5f;
+        BinSphere(numDecals_, view * transform.Translation(), halfSize.Length(), clusterDecalCounts_, MaxDecalsPerCluster,
+            ClusterTextureLightRows, NumDecalIndexRowsPerCluster);
+
+        const Matrix3x4 worldToDecal = transform.Inverse();
+        const Rect& uvRect = decal.uvRect_;
+        Vector4* decalData = &lightData_[NumDataRowsPerLight * MaxLights + numDecals_];
+        decalData[0 * MaxLights] = Vector4{ worldToDecal.m00_, worldToDecal.m01_, worldToDecal.m02_, worldToDecal.m03_ };
+        decalData[1 * MaxLights] = Vector4{ worldToDecal.m10_, worldToDecal.m11_, worldToDecal.m12_, worldToDecal.m13_ };
+        decalData[2 * MaxLights] = Vector4{ worldToDecal.m20_, worldToDecal.m21_, worldToDecal.m22_, worldToDecal.m23_ };
+        decalData[3 * MaxLights] = Vector4{ uvRect.Size(), uvRect.min_ };
+
+        ++numDecals_;
+    }
+}
+
+int ClusteredLightProcessor::GetDepthSlice(float depth) const
+{
+    if (depth <= clusterNear_)
+        return 0;
+    const int slice = FloorToInt(Ln(depth) * depthSliceScale_ + depthSliceBias_);
+    return Clamp(slice, 0, static_cast<int>(NumClustersZ) - 1);
+}
+
+void ClusteredLightProcessor::BinSphere(unsigned index, const Vector3& viewCenter, float radius,
+    ea::vector<unsigned>& clusterCounts, unsigned maxPerCluster, unsigned firstRow, unsigned numRowsPerCluster)
+{
+    // Sphere is outside of clustered depth range
+    const float minDepth = viewCenter.z_ - radius;
+    const float maxDepth = viewCenter.z_ + radius;
+    if (maxDepth <= 0.0f || minDepth >= clusterFar_)
+        return;
+
+    const int minZ = GetDepthSlice(minDepth);
+    const int maxZ = GetDepthSlice(maxDepth);
+
+    // Project bounding box corners to get screen rectangle, use whole screen if box intersects camera plane
+    Vector2 minNdc{ -1.0f, -1.0f };
+    Vector2 maxNdc{ 1.0f, 1.0f };
+    if (minDepth > M_EPSILON)
+    {
+        minNdc = Vector2{ M_INFINITY, M_INFINITY };
+        maxNdc = Vector2{ -M_INFINITY, -M_INFINITY };
+        for (unsigned i = 0; i < 8; ++i)
+        {
+            const Vector3 offset{ i & 1 ? radius : -radius, i & 2 ? radius : -radius, i & 4 ? radius : -radius };
+            const Vector4 clipPos = projection_ * Vector4{ viewCenter + offset, 1.0f };
+            const Vector2 ndc = Vector2{ clipPos.x_, clipPos.y_ } / clipPos.w_;
+            minNdc = VectorMin(minNdc, ndc);
+            maxNdc = VectorMax(maxNdc, ndc);
+        }
+    }
+
+    const auto toCluster = [](float ndc, unsigned numClusters)
+    {
+        const int index = FloorToInt((ndc * 0.5f + 0.5f) * numClusters);
+        return Clamp(index, 0, static_cast<int>(numClusters) - 1);
+    };
+
+    if (minNdc.x_ > 1.0f || minNdc.y_ > 1.0f || maxNdc.x_ < -1.0f || maxNdc.y_ < -1.0f)
+        return;
+
+    const int minX = toCluster(minNdc.x_, NumClustersX);
+    const int maxX = toCluster(maxNdc.x_, NumClustersX);
+    const int minY = toCluster(minNdc.y_, NumClustersY);
+    const int maxY = toCluster(maxNdc.y_, NumClustersY);
+
+    for (int z = minZ; z <= maxZ; ++z)
+    {
+        for (int y = minY; y <= maxY; ++y)
+        {
+            for (int x = minX; x <= maxX; ++x)
+            {
+                const unsigned clusterIndex = (z * NumClustersY + y) * NumClustersX + x;
+                unsigned& count = clusterCounts[clusterIndex];
+                if (count >= maxPerCluster)
+                    continue;
+
+                const unsigned texelX = y * NumClustersX + x;
+                const unsigned texelY = firstRow + z * numRowsPerCluster + count / 4;
+                float* indices = &clusterData_[texelY * ClusterTextureWidth + texelX].x_;
+                indices[count % 4] = static_cast<float>(index);
+                ++count;
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Core/Object.h"
+#include "../Graphics/DrawCommandQueue.h"
+#include "../Math/Vector4.h"
+
+#include <EASTL/array.h>
+#include <EASTL/span.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class Camera;
+class ClusteredDecalSet;
+class DrawableProcessor;
+class LightProcessor;
+class Texture2D;
+
+/// Bins point and spot lights into 3D grid of view frustum clusters (froxels) for clustered forward lighting.
+/// Clustered lights are evaluated in the base pass and don't produce additive light batches.
+/// Directional, shadowed, negative and textured lights are still rendered as forward pixel lights.
+/// Decals of ClusteredDecalSet are binned into the same clusters and applied to surface albedo.
+/// Constants should match _ClusteredLighting.glsl.
+class URHO3D_API ClusteredLightProcessor : public Object
+{
+    URHO3D_OBJECT(ClusteredLightProcessor, Object);
+
+public:
+    /// Number of clusters along each axis. Clusters are distributed exponentially along Z axis.
+    /// @{
+    static const unsigned NumClustersX = 16;
+    static const unsigned NumClustersY = 8;
+    static const unsigned NumClustersZ = 24;
+    /// @}
+    /// Max number of lights in one cluster. Extra lights are ignored.
+    static const unsigned MaxLightsPerCluster = 32;
+    /// Max number of clustered lights. Extra lights are rendered as forward pixel lights.
+    static const unsigned MaxLights = 256;
+    /// Max number of decals in one cluster. Extra decals are ignored.
+    static const unsigned MaxDecalsPerCluster = 16;
+    /// Max number of clustered decals. Extra decals are ignored.
+    static const unsigned MaxDecals = MaxLights;
+    /// Min distance to the first cluster slice, used if near clip is too small.
+    static constexpr float MinClusterDepth = 0.1f;
+
+    explicit ClusteredLightProcessor(Context* context);
+    ~ClusteredLightProcessor() override;
+
+    /// Return whether the light can be clustered. Shall be called after light processors are updated.
+    static bool IsClusteredLight(const LightProcessor* lightProcessor);
+
+    /// Select clustered lights and decals, bin them into clusters and upload cluster data to GPU.
+    /// Shall be called after lights are processed and before forward lighting is processed.
+    void Update(Camera* camera, DrawableProcessor* drawableProcessor, const ClusteredDecalSet* decalSet,
+        bool linearSpaceLighting);
+
+    /// Return shader resources and camera parameters needed to render clustered lights.
+    /// @{
+    ea::span<const ShaderResourceDesc> GetShaderResources() const { return shaderResources_; }
+    ea::span<const ShaderParameterDesc> GetShaderParameters() const { return shaderParameters_; }
+    /// @}
+
+    /// Return number of lights clustered at the last update.
+    unsigned GetNumLights() const { return numLights_; }
+    /// Return number of decals clustered at the last update.
+    unsigned GetNumDecals() const { return numDecals_; }
+
+private:
+    /// Number of texture rows with light indices for one cluster.
+    static const unsigned NumIndexRowsPerCluster = MaxLightsPerCluster / 4;
+    /// Number of texture rows with decal indices for one cluster. Stored after rows of all light indices.
+    static const unsigned NumDecalIndexRowsPerCluster = MaxDecalsPerCluster / 4;
+    /// Number of texture rows with data for one light.
+    static const unsigned NumDataRowsPerLight = 4;
+    /// Number of texture rows with data for one decal. Stored after rows of all light data.
+    static const unsigned NumDataRowsPerDecal = 4;
+
+    /// Create GPU textures.
+    void CreateTextures();
+    /// Bin decals and fill decal data.
+    void UpdateDecals(const Matrix3x4& view, const ClusteredDecalSet* decalSet);
+    /// Add light or decal index to index lists of clusters overlapping bounding sphere in view space.
+    void BinSphere(unsigned index, const Vector3& viewCenter, float radius, ea::vector<unsigned>& clusterCounts,
+        unsigned maxPerCluster, unsigned firstRow, unsigned numRowsPerCluster);
+    /// Return depth slice index for given view space depth.
+    int GetDepthSlice(float depth) const;
+
+    /// Textures with light indices per cluster and with light parameters.
+    SharedPtr<Texture2D> clusterTexture_;
+    SharedPtr<Texture2D> lightDataTexture_;
+
+    /// Current frame parameters
+    /// @{
+    Matrix4 projection_;
+    float clusterNear_{};
+    float clusterFar_{};
+    float depthSliceScale_{};
+    float depthSliceBias_{};
+    /// @}
+
+    /// CPU-side data
+    /// @{
+    unsigned numLights_{};
+    unsigned numDecals_{};
+    ea::vector<unsigned> clusterLightCounts_;
+    ea::vector<unsigned> clusterDecalCounts_;
+    ea::vector<Vector4> clusterData_;
+    ea::vector<Vector4> lightData_;
+    /// @}
+
+    ea::vector<ShaderResourceDesc> shaderResources_;
+    ea::vector<ShaderParameterDesc> shaderParameters_;
+};
+
+}
@@ -27,6 +27,7 @@
 #include "../Core/Context.h"
 #include "../Graphics/Camera.h"
 #include "../Graphics/DebugRenderer.h"
+#include "../Graphics/GPUProfiler.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/GraphicsEvents.h"
 #include "../Graphics/OutlineGroup.h"
@@ -36,6 +37,7 @@
 #include "../RenderPipeline/AutoExposurePass.h"
 #include "../RenderPipeline/BatchRenderer.h"
 #include "../RenderPipeline/BloomPass.h"
+#include "../RenderPipeline/ClusteredLightProcessor.h"
 #include "../RenderPipeline/DrawableProcessor.h"
 #include "../RenderPipeline/InstancingBuffer.h"
 #include "../RenderPipeline/LightProcessor.h"
@@ -49,6 +51,9 @@
 #endif
 
 #include "AmbientOcclusionPass.h"
+
+#include <EASTL/fixed_vector.h>
+
 #include "../DebugNew.h"
 
 namespace Urho3D
@@ -59,6 +64,13 @@ DefaultRenderPipelineView::DefaultRenderPipelineView(RenderPipeline* renderPipel
 {
     SetSettings(renderPipeline_->GetSettings());
     renderPipeline_->OnSettingsChanged.Subscribe(this, &DefaultRenderPipelineView::SetSettings);
+
+    viewsMetric_ = GetMetricCounter(context_, "urho3d_render_views_total", "Number of rendered views");
+    visibleDrawablesMetric_ = GetMetricCounter(context_, "urho3d_render_visible_drawables_total", "Number of drawables within view frustum");
+    culledDrawablesMetric_ = GetMetricCounter(context_, "urho3d_render_culled_drawables_total", "Number of drawables rejected by frustum culling");
+    lightsMetric_ = GetMetricCounter(context_, "urho3d_render_lights_total", "Number of processed lights");
+    shadowedLightsMetric_ = GetMetricCounter(context_, "urho3d_render_shadowed_lights_total", "Number of processed lights with shadows");
+    occludersMetric_ = GetMetricCounter(context_, "urho3d_render_occluders_total", "Number of rendered occluders");
 }
 
 DefaultRenderPipelineView::~DefaultRenderPipelineView()
@@ -102,6 +114,7 @@ void DefaultRenderPipelineView::SendViewEvent(StringHash eventType)
 void DefaultRenderPipelineView::ApplySettings()
 {
     sceneProcessor_->SetSettings(settings_);
+    dynamicResolution_.SetSettings(settings_.dynamicResolution_);
     instancingBuffer_->SetSettings(settings_.instancingBuffer_);
     shadowMapAllocator_->SetSettings(settings_.shadowMapAllocator_);
 
@@ -127,6 +140,8 @@ void DefaultRenderPipelineView::ApplySettings()
             deferred_->albedoBuffer_ = renderBufferManager_->CreateColorBuffer({ Graphics::GetRGBAFormat() });
             deferred_->specularBuffer_ = renderBufferManager_->CreateColorBuffer({ Graphics::GetRGBAFormat() });
             deferred_->normalBuffer_ = renderBufferManager_->CreateColorBuffer({ Graphics::GetRGBAFormat() });
+            deferred_->tiledLightsPipelineState_ = renderBufferManager_->CreateQuadPipelineState(
+                BLEND_ADD, "v2/CopyFramebuffer", "");
         }
         else
         {
@@ -245,7 +260,8 @@ bool DefaultRenderPipelineView::Define(RenderSurface* renderTarget, Viewport* vi
 
     frameInfo_.viewport_ = viewport;
     frameInfo_.renderTarget_ = renderTarget;
-    frameInfo_.viewportRect_ = viewport->GetEffectiveRect(renderTarget);
+    frameInfo_.outputRect_ = viewport->GetEffectiveRect(renderTarget);
+    frameInfo_.viewportRect_ = dynamicResolution_.ScaleRect(frameInfo_.outputRect_);
     frameInfo_.viewportSize_ = frameInfo_.viewportRect_.Size();
 
     if (!sceneProcessor_->Define(frameInfo_))
@@ -269,6 +285,9 @@ void DefaultRenderPipelineView::Update(const FrameInfo& frameInfo)
     frameInfo_.frameNumber_ = frameInfo.frameNumber_;
     frameInfo_.timeStep_ = frameInfo.timeStep_;
 
+    // Rendering resolution for the next frame
+    dynamicResolution_.Update(frameInfo.timeStep_);
+
     // Begin debug snapshot
 #if URHO3D_SYSTEMUI
     const bool shiftDown = ui::IsKeyDown(KEY_LSHIFT) || ui::IsKeyDown(KEY_RSHIFT);
@@ -311,6 +330,7 @@ void DefaultRenderPipelineView::Render()
     const bool hasRefraction = alphaPass_->HasRefractionBatches();
     RenderBufferManagerFrameSettings frameSettings;
     frameSettings.supportColorReadWrite_ = postProcessFlags_.Test(PostProcessPassFlag::NeedColorOutputReadAndWrite);
+    frameSettings.upscaleSharpness_ = settings_.dynamicResolution_.sharpness_;
     if (hasRefraction)
         frameSettings.supportColorReadWrite_ = true;
     renderBufferManager_->SetFrameSettings(frameSettings);
@@ -376,7 +396,18 @@ void DefaultRenderPipelineView::Render()
             {ShaderConsts::Camera_GBufferInvSize, renderBufferManager_->GetInvOutputSize()},
         };
 
+        RenderBuffer* depthBuffer = renderBufferManager_->GetDepthStencilOutput();
+        Texture2D* tiledLightsTexture = sceneProcessor_->RenderTiledDeferredLights(depthBuffer->GetTexture2D(),
+            depthBuffer->GetViewportRect(), deferred_->albedoBuffer_->GetTexture2D(),
+            deferred_->specularBuffer_->GetTexture2D(), deferred_->normalBuffer_->GetTexture2D());
+
         renderBufferManager_->SetOutputRenderTargets();
+        if (tiledLightsTexture)
+        {
+            const ShaderResourceDesc tiledLightsResources[] = {{TU_DIFFUSE, tiledLightsTexture}};
+            renderBufferManager_->DrawViewportQuad(
+                "Apply tiled lights", deferred_->tiledLightsPipelineState_, tiledLightsResources, {});
+        }
         sceneProcessor_->RenderLightVolumeBatches("LightVolumes", camera, geometryBuffer, cameraParameters);
     }
     else
@@ -389,32 +420,45 @@ void DefaultRenderPipelineView::Render()
             sceneProcessor_->RenderSceneBatches("DepthPrePass", camera, depthPrePass_->GetBaseBatches());
     }
 
-    const ShaderParameterDesc cameraParameters[] = {
+    ea::fixed_vector<ShaderResourceDesc, 4> sceneResources;
+    ea::fixed_vector<ShaderParameterDesc, 8> cameraParameters = {
         {VSP_GBUFFEROFFSETS, renderBufferManager_->GetDefaultClipToUVSpaceOffsetAndScale()},
         {PSP_GBUFFERINVSIZE, renderBufferManager_->GetInvOutputSize()},
     };
+    if (ClusteredLightProcessor* clusteredLightProcessor = sceneProcessor_->GetClusteredLightProcessor())
+    {
+        const auto clusteredResources = clusteredLightProcessor->GetShaderResources();
+        const auto clusteredParameters = clusteredLightProcessor->GetShaderParameters();
+        sceneResources.insert(sceneResources.end(), clusteredResources.begin(), clusteredResources.end());
+        cameraParameters.insert(cameraParameters.end(), clusteredParameters.begin(), clusteredParameters.end());
+    }
+
+    sceneProcessor_->RenderSceneBatches("OpaqueBase", camera, opaquePass_->GetBaseBatches(), sceneResources, cameraParameters);
+    sceneProcessor_->RenderSceneBatches("OpaqueLight", camera, opaquePass_->GetLightBatches(), sceneResources, cameraParameters);
+    sceneProcessor_->RenderSceneBatches("PostOpaque", camera, postOpaquePass_->GetBaseBatches(), sceneResources, cameraParameters);
 
-    sceneProcessor_->RenderSceneBatches("OpaqueBase", camera, opaquePass_->GetBaseBatches(), {}, cameraParameters);
-    sceneProcessor_->RenderSceneBatches("OpaqueLight", camera, opaquePass_->GetLightBatches(), {}, cameraParameters);
-    sceneProcessor_->RenderSceneBatches("PostOpaque", camera, postOpaquePass_->GetBaseBatches(), {}, cameraParameters);
+    if (settings_.sceneProcessor_.hiZOcclusion_)
+    {
+        RenderBuffer* depthBuffer = renderBufferManager_->GetDepthStencilOutput();
+        Texture2D* depthTexture = depthBuffer->GetTexture2D();
+        if (depthTexture && depthBuffer->GetViewportRect() == IntRect{IntVector2::ZERO, depthTexture->GetSize()})
+            sceneProcessor_->TestHiZOcclusion(depthTexture);
+    }
 
     if (hasRefraction)
         renderBufferManager_->SwapColorBuffers(true);
 
+    ea::fixed_vector<ShaderResourceDesc, 6> depthAndColorTextures = {
 #ifdef DESKTOP_GRAPHICS
-    ShaderResourceDesc depthAndColorTextures[] = {
         { TU_DEPTHBUFFER, renderBufferManager_->GetDepthStencilTexture() },
+#endif
         { TU_EMISSIVE, renderBufferManager_->GetSecondaryColorTexture() },
     };
-#else
-    ShaderResourceDesc depthAndColorTextures[] = {
-        { TU_EMISSIVE, renderBufferManager_->GetSecondaryColorTexture() },
-    };
-#endif
+    depthAndColorTextures.insert(depthAndColorTextures.end(), sceneResources.begin(), sceneResources.end());
 
     sceneProcessor_->RenderSceneBatches("Alpha", camera, alphaPass_->GetBatches(),
         depthAndColorTextures, cameraParameters);
-    sceneProcessor_->RenderSceneBatches("PostAlpha", camera, postAlphaPass_->GetBatches());
+    sceneProcessor_->RenderSceneBatches("PostAlpha", camera, postAlphaPass_->GetBatches(), sceneResources, cameraParameters);
 
     if (outlinePostProcessPass_->IsEnabled())
     {
@@ -445,8 +489,12 @@ void DefaultRenderPipelineView::Render()
     }
 #endif
 
+    auto gpuProfiler = GetSubsystem<GPUProfiler>();
     for (PostProcessPass* postProcessPass : postProcessPasses_)
+    {
+        GPUProfilerScope gpuScope(gpuProfiler, postProcessPass->GetTypeName());
         postProcessPass->Execute(camera);
+    }
 
     auto debug = sceneProcessor_->GetFrameInfo().scene_->GetComponent<DebugRenderer>();
     if (settings_.drawDebugGeometry_ && debug && debug->IsEnabledEffective() && debug->HasContent())
@@ -464,6 +512,13 @@ void DefaultRenderPipelineView::Render()
     stats_ = {};
     OnCollectStatistics(this, stats_);
 
+    viewsMetric_->Increment();
+    visibleDrawablesMetric_->Increment(stats_.numVisibleDrawables_);
+    culledDrawablesMetric_->Increment(stats_.numCulledDrawables_);
+    lightsMetric_->Increment(stats_.numLights_);
+    shadowedLightsMetric_->Increment(stats_.numShadowedLights_);
+    occludersMetric_->Increment(stats_.numOccluders_);
+
     // End debug snapshot
     if (debugger_.IsSnapshotInProgress())
     {
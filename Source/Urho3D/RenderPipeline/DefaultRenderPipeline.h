@@ -25,12 +25,14 @@
 #include "OutlinePass.h"
 #include "../RenderPipeline/SceneProcessor.h"
 #include "../RenderPipeline/CameraProcessor.h"
+#include "../RenderPipeline/DynamicResolutionController.h"
 #include "../RenderPipeline/RenderBuffer.h"
 #include "../RenderPipeline/RenderBufferManager.h"
 #include "../RenderPipeline/RenderPipeline.h"
 #include "../RenderPipeline/PostProcessPass.h"
 #include "../RenderPipeline/ScenePass.h"
 #include "../RenderPipeline/AmbientOcclusionPass.h"
+#include "../Core/Metrics.h"
 
 #include <EASTL/optional.h>
 
@@ -81,6 +83,7 @@ private:
 
     CommonFrameInfo frameInfo_;
     PostProcessPassFlags postProcessFlags_;
+    DynamicResolutionController dynamicResolution_;
 
     RenderPipelineStats stats_;
     RenderPipelineDebugger debugger_;
@@ -105,10 +108,21 @@ private:
         SharedPtr<RenderBuffer> albedoBuffer_;
         SharedPtr<RenderBuffer> specularBuffer_;
         SharedPtr<RenderBuffer> normalBuffer_;
+        SharedPtr<PipelineState> tiledLightsPipelineState_;
     };
     ea::optional<DeferredLightingData> deferred_;
 
     ea::vector<SharedPtr<PostProcessPass>> postProcessPasses_;
+
+    /// Metrics
+    /// @{
+    SharedPtr<MetricCounter> viewsMetric_;
+    SharedPtr<MetricCounter> visibleDrawablesMetric_;
+    SharedPtr<MetricCounter> culledDrawablesMetric_;
+    SharedPtr<MetricCounter> lightsMetric_;
+    SharedPtr<MetricCounter> shadowedLightsMetric_;
+    SharedPtr<MetricCounter> occludersMetric_;
+    /// @}
 };
 
 }
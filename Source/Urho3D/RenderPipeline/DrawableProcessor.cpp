@@ -31,6 +31,7 @@
 #include "../Graphics/Renderer.h"
 #include "../Graphics/Texture2D.h"
 #include "../Graphics/TextureCube.h"
+#include "../Graphics/TextureStreamer.h"
 #include "../Graphics/Zone.h"
 #include "../IO/Log.h"
 #include "../RenderPipeline/DrawableProcessor.h"
@@ -134,21 +135,37 @@ DrawableProcessorPass::AddBatchResult DrawableProcessorPass::AddBatch(unsigned t
     if (useBatchCallback_)
         return AddCustomBatch(threadIndex, drawable, sourceBatchIndex, technique);
 
-    if (Pass* deferredPass = technique->GetPass(deferredPassIndex_))
+    return AddBatch(threadIndex, drawable, sourceBatchIndex, FindTechniquePasses(technique));
+}
+
+DrawableProcessorPass::AddBatchResult DrawableProcessorPass::AddBatch(unsigned threadIndex,
+    Drawable* drawable, unsigned sourceBatchIndex, const TechniquePasses& passes)
+{
+    if (passes.deferredPass_)
     {
-        geometryBatches_.PushBack(threadIndex, GeometryBatch::Deferred(drawable, sourceBatchIndex, deferredPass));
+        geometryBatches_.PushBack(threadIndex, GeometryBatch::Deferred(drawable, sourceBatchIndex, passes.deferredPass_));
         return { true, false };
     }
 
-    Pass* unlitBasePass = technique->GetPass(unlitBasePassIndex_);
-    Pass* lightPass = technique->GetPass(lightPassIndex_);
-    Pass* litBasePass = lightPass ? technique->GetPass(litBasePassIndex_) : nullptr;
-
-    if (!unlitBasePass)
+    if (!passes.unlitBasePass_)
         return { false, false };
 
-    geometryBatches_.PushBack(threadIndex, GeometryBatch::Forward(drawable, sourceBatchIndex, unlitBasePass, litBasePass, lightPass));
-    return { true, !!lightPass };
+    geometryBatches_.PushBack(threadIndex, GeometryBatch::Forward(
+        drawable, sourceBatchIndex, passes.unlitBasePass_, passes.litBasePass_, passes.lightPass_));
+    return { true, !!passes.lightPass_ };
+}
+
+DrawableProcessorPass::TechniquePasses DrawableProcessorPass::FindTechniquePasses(Technique* technique) const
+{
+    TechniquePasses passes;
+    passes.deferredPass_ = technique->GetPass(deferredPassIndex_);
+    if (passes.deferredPass_)
+        return passes;
+
+    passes.unlitBasePass_ = technique->GetPass(unlitBasePassIndex_);
+    passes.lightPass_ = technique->GetPass(lightPassIndex_);
+    passes.litBasePass_ = passes.lightPass_ ? technique->GetPass(litBasePassIndex_) : nullptr;
+    return passes;
 }
 
 void DrawableProcessorPass::OnUpdateBegin(const CommonFrameInfo& frameInfo)
@@ -182,9 +199,12 @@ void DrawableProcessor::SetSettings(const DrawableProcessorSettings& settings)
 
 void DrawableProcessor::OnUpdateBegin(const FrameInfo& frameInfo)
 {
+    const ea::vector<DrawableProcessorPass*> previousPasses = ea::move(passes_);
     passes_.clear();
     ea::copy_if(allPasses_.begin(), allPasses_.end(), ea::back_inserter(passes_),
         [](const SharedPtr<DrawableProcessorPass>& pass) { return pass->IsEnabled(); });
+    if (passes_ != previousPasses)
+        ++passesRevision_;
 
     // Initialize frame constants
     frameInfo_ = frameInfo;
@@ -199,6 +219,10 @@ void DrawableProcessor::OnUpdateBegin(const FrameInfo& frameInfo)
 
     gi_ = frameInfo_.scene_->GetComponent<GlobalIllumination>();
 
+    // Texture streaming is driven by the main viewport only
+    textureStreamer_ = !frameInfo_.renderTarget_ ? GetSubsystem<TextureStreamer>() : nullptr;
+    screenSizeScale_ = frameInfo_.viewSize_.y_ * 0.5f / frameInfo_.camera_->GetHalfViewSize();
+
     // Clean temporary containers
     sceneZRangeTemp_.clear();
     sceneZRangeTemp_.resize(WorkQueue::GetMaxThreadIndex());
@@ -213,6 +237,7 @@ void DrawableProcessor::OnUpdateBegin(const FrameInfo& frameInfo)
 
     geometryZRanges_.resize(numDrawables_);
     geometryLighting_.resize(numDrawables_);
+    cachedSourceBatches_.resize(numDrawables_);
 
     sortedOccluders_.clear();
     geometries_.Clear();
@@ -232,6 +257,8 @@ void DrawableProcessor::OnCollectStatistics(RenderPipelineStats& stats)
     stats.numOccluders_ += sortedOccluders_.size();
     stats.numLights_ += lights_.size();
     stats.numShadowedLights_ += numShadowedLights_;
+    stats.numVisibleDrawables_ += numVisibleDrawables_;
+    stats.numCulledDrawables_ += numDrawables_ - ea::min(numVisibleDrawables_, numDrawables_);
 }
 
 void DrawableProcessor::ProcessOccluders(const ea::vector<Drawable*>& occluders, float sizeThreshold)
@@ -283,6 +310,8 @@ void DrawableProcessor::ProcessVisibleDrawables(const ea::vector<Drawable*>& dra
 {
     URHO3D_PROFILE("ProcessVisibleDrawables");
 
+    numVisibleDrawables_ = drawables.size();
+
     ForEachParallel(workQueue_, drawables,
         [&](unsigned /*index*/, Drawable* drawable)
     {
@@ -433,6 +462,43 @@ void DrawableProcessor::CheckMaterialForAuxiliaryRenderSurfaces(Material* materi
     material->MarkForAuxView(frameInfo_.frameNumber_);
 }
 
+Technique* DrawableProcessor::FindTechnique(CachedSourceBatch& cache, Material* material, Drawable* drawable) const
+{
+    const bool isMaterialCached = cache.material_ == material && cache.materialRevision_ == material->GetRevision()
+        && cache.materialQuality_ == materialQuality_;
+    if (isMaterialCached && !cache.lodDependent_)
+        return cache.technique_;
+
+    if (!isMaterialCached)
+    {
+        cache.material_ = material;
+        cache.materialRevision_ = material->GetRevision();
+        cache.materialQuality_ = materialQuality_;
+        cache.lodDependent_ = material->GetNumTechniques() > 1;
+    }
+    return material->FindTechnique(drawable, materialQuality_);
+}
+
+void DrawableProcessor::UpdateTechniquePasses(CachedSourceBatch& cache, Technique* technique) const
+{
+    if (cache.technique_ == technique && cache.techniqueRevision_ == technique->GetRevision()
+        && cache.passesRevision_ == passesRevision_)
+        return;
+
+    cache.technique_ = technique;
+    cache.techniqueRevision_ = technique->GetRevision();
+    cache.passesRevision_ = passesRevision_;
+
+    cache.passes_.clear();
+    for (DrawableProcessorPass* pass : passes_)
+    {
+        if (pass->UsesBatchCallback())
+            cache.passes_.emplace_back();
+        else
+            cache.passes_.push_back(pass->FindTechniquePasses(technique));
+    }
+}
+
 void DrawableProcessor::ProcessVisibleDrawable(Drawable* drawable)
 {
     const unsigned drawableIndex = drawable->GetDrawableIndex();
@@ -472,32 +538,57 @@ void DrawableProcessor::ProcessVisibleDrawable(Drawable* drawable)
         LightAccumulator& lightAccumulator = geometryLighting_[drawableIndex];
         lightAccumulator.ResetLights();
 
+        // Estimate size on screen in pixels to request texture resolution and to skip depth pre-pass
+        float screenSize = M_LARGE_VALUE;
+        if (textureStreamer_ || settings_.depthPrePassMinScreenSize_ > 0.0f)
+        {
+            const float size = boundingBox.Size().Length();
+            const float distance = Max(drawable->GetDistance(), frameInfo_.camera_->GetNearClip());
+            screenSize = screenSizeScale_ * (frameInfo_.camera_->IsOrthographic() ? size : size / distance);
+        }
+        const bool skipDepthPrePass = screenSize < settings_.depthPrePassMinScreenSize_;
+
         // Collect batches
         bool isForwardLit = false;
         bool needAmbient = false;
 
         const auto& sourceBatches = drawable->GetBatches();
+        ea::vector<CachedSourceBatch>& cachedSourceBatches = cachedSourceBatches_[drawableIndex];
+        if (cachedSourceBatches.size() != sourceBatches.size())
+            cachedSourceBatches.resize(sourceBatches.size());
+
         for (unsigned sourceBatchIndex = 0; sourceBatchIndex < sourceBatches.size(); ++sourceBatchIndex)
         {
             const SourceBatch& sourceBatch = sourceBatches[sourceBatchIndex];
             if (!sourceBatch.geometry_ || sourceBatch.numWorldTransforms_ == 0)
                 continue;
 
-            // Find current technique
+            // Find current technique, reuse cached one if material is not changed
+            CachedSourceBatch& cache = cachedSourceBatches[sourceBatchIndex];
             Material* material = sourceBatch.material_ ? sourceBatch.material_ : defaultMaterial_;
-            Technique* technique = material->FindTechnique(drawable, materialQuality_);
+            Technique* technique = FindTechnique(cache, material, drawable);
             if (!technique)
                 continue;
 
+            UpdateTechniquePasses(cache, technique);
+
             // Check for aux views
             CheckMaterialForAuxiliaryRenderSurfaces(sourceBatch.material_);
 
+            if (textureStreamer_)
+                textureStreamer_->RequestMaterialTextures(material, screenSize);
+
             // Update scene passes
-            for (DrawableProcessorPass* pass : passes_)
+            for (unsigned passIndex = 0; passIndex < passes_.size(); ++passIndex)
             {
                 // TODO: Check whether pass is supported on mobile?
-                const DrawableProcessorPass::AddBatchResult result = pass->AddBatch(
-                    threadIndex, drawable, sourceBatchIndex, technique);
+                DrawableProcessorPass* pass = passes_[passIndex];
+                if (skipDepthPrePass && pass->GetFlags().Test(DrawableProcessorPassFlag::DepthOnlyPass))
+                    continue;
+
+                const DrawableProcessorPass::AddBatchResult result = pass->UsesBatchCallback()
+                    ? pass->AddBatch(threadIndex, drawable, sourceBatchIndex, technique)
+                    : pass->AddBatch(threadIndex, drawable, sourceBatchIndex, cache.passes_[passIndex]);
                 if (result.forwardLitAdded_)
                     isForwardLit = true;
                 if (result.added_ && pass->GetFlags().Test(DrawableProcessorPassFlag::HasAmbientLighting))
@@ -599,6 +690,26 @@ void DrawableProcessor::ProcessLights(LightProcessorCallback* callback)
         lightProcessor->Update(this, callback);
     });
 
+    // Process shadow splits as independent tasks so that a single light with many splits is not serialized
+    lightSplitsToUpdate_.clear();
+    for (LightProcessor* lightProcessor : lightProcessors_)
+    {
+        for (unsigned splitIndex = 0; splitIndex < lightProcessor->GetNumSplits(); ++splitIndex)
+            lightSplitsToUpdate_.emplace_back(lightProcessor, splitIndex);
+    }
+
+    ForEachParallel(workQueue_, lightSplitsToUpdate_,
+        [&](unsigned /*index*/, const ea::pair<LightProcessor*, unsigned>& lightSplit)
+    {
+        lightSplit.first->UpdateSplit(this, lightSplit.second);
+    });
+
+    ForEachParallel(workQueue_, lightProcessors_,
+        [&](unsigned /*index*/, LightProcessor* lightProcessor)
+    {
+        lightProcessor->FinalizeUpdate(callback);
+    });
+
     SortLightProcessorsByShadowMapSize();
 
     numShadowedLights_ = 0;
@@ -678,7 +789,7 @@ void DrawableProcessor::ProcessForwardLighting()
     for (unsigned i = 0; i < lightProcessors_.size(); ++i)
     {
         const LightProcessor* lightProcessor = lightProcessors_[i];
-        if (lightProcessor->HasForwardLitGeometries())
+        if (lightProcessor->HasForwardLitGeometries() && !lightProcessor->IsClustered())
         {
             ProcessForwardLightingForLight(i, lightProcessor->GetLitGeometries());
             hasForwardLights = true;
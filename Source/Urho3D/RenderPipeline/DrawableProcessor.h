@@ -43,6 +43,7 @@ class OcclusionBuffer;
 class Pass;
 class RenderPipelineInterface;
 class Technique;
+class TextureStreamer;
 struct FrameInfo;
 
 /// Flags related to geometry rendering.
@@ -127,6 +128,15 @@ public:
         bool forwardLitAdded_{};
     };
 
+    /// Passes of technique used by this scene pass. Valid until technique revision changes.
+    struct TechniquePasses
+    {
+        Pass* deferredPass_{};
+        Pass* unlitBasePass_{};
+        Pass* litBasePass_{};
+        Pass* lightPass_{};
+    };
+
     DrawableProcessorPass(RenderPipelineInterface* renderPipeline, DrawableProcessorPassFlags flags,
         unsigned deferredPassIndex, unsigned unlitBasePassIndex, unsigned litBasePassIndex, unsigned lightPassIndex);
 
@@ -137,6 +147,11 @@ public:
     virtual AddBatchResult AddCustomBatch(unsigned threadIndex, Drawable* drawable, unsigned sourceBatchIndex, Technique* technique) { return {}; }
 
     AddBatchResult AddBatch(unsigned threadIndex, Drawable* drawable, unsigned sourceBatchIndex, Technique* technique);
+    /// Add batch with passes resolved in advance. Should not be used if batch callback is used.
+    AddBatchResult AddBatch(unsigned threadIndex, Drawable* drawable, unsigned sourceBatchIndex, const TechniquePasses& passes);
+    /// Resolve passes of technique.
+    TechniquePasses FindTechniquePasses(Technique* technique) const;
+    bool UsesBatchCallback() const { return useBatchCallback_; }
 
     DrawableProcessorPassFlags GetFlags() const { return flags_; }
     bool IsFlagSet(DrawableProcessorPassFlags flag) const { return flags_.Test(flag); }
@@ -247,6 +262,27 @@ protected:
     void SortLightProcessorsByShadowMapTexture();
 
 private:
+    /// Technique and resolved passes of drawable source batch, cached between frames.
+    struct CachedSourceBatch
+    {
+        WeakPtr<Material> material_;
+        unsigned materialRevision_{};
+        MaterialQuality materialQuality_{};
+        /// Whether the technique depends on drawable LOD distance and should be looked up every frame.
+        bool lodDependent_{};
+
+        WeakPtr<Technique> technique_;
+        unsigned techniqueRevision_{};
+        unsigned passesRevision_{};
+        /// Resolved passes for each enabled scene pass.
+        ea::vector<DrawableProcessorPass::TechniquePasses> passes_;
+    };
+
+    /// Find technique of source batch, using cached value if possible.
+    Technique* FindTechnique(CachedSourceBatch& cache, Material* material, Drawable* drawable) const;
+    /// Update resolved passes of source batch if needed.
+    void UpdateTechniquePasses(CachedSourceBatch& cache, Technique* technique) const;
+
     /// Whether the drawable is already updated for this pipeline and frame.
     /// Technically copyable to allow storage in vector, but is invalidated on copying.
     struct UpdateFlag : public std::atomic_flag
@@ -266,6 +302,8 @@ private:
     /// @{
     ea::vector<SharedPtr<DrawableProcessorPass>> allPasses_;
     ea::vector<DrawableProcessorPass*> passes_;
+    /// Incremented whenever the list of enabled passes changes.
+    unsigned passesRevision_{};
     DrawableProcessorSettings settings_;
     ea::unique_ptr<LightProcessorCache> lightProcessorCache_;
     /// @}
@@ -274,6 +312,7 @@ private:
     /// @{
     FrameInfo frameInfo_;
     unsigned numDrawables_{};
+    unsigned numVisibleDrawables_{};
 
     Matrix3x4 cullCameraViewMatrix_;
     Vector3 cullCameraZAxis_;
@@ -281,6 +320,9 @@ private:
 
     MaterialQuality materialQuality_{};
     GlobalIllumination* gi_{};
+    TextureStreamer* textureStreamer_{};
+    /// Scale from bounding box size to distance ratio to size on screen in pixels.
+    float screenSizeScale_{};
     /// @}
 
     /// Arrays indexed with drawable index
@@ -289,6 +331,8 @@ private:
     ea::vector<unsigned char> geometryFlags_;
     ea::vector<FloatRange> geometryZRanges_;
     ea::vector<LightAccumulator> geometryLighting_;
+    /// Persistent between frames, reused while material, technique and passes are not changed.
+    ea::vector<ea::vector<CachedSourceBatch>> cachedSourceBatches_;
     /// @}
 
     ea::vector<FloatRange> sceneZRangeTemp_;
@@ -306,6 +350,8 @@ private:
     ea::vector<LightProcessor*> lightProcessors_;
     ea::vector<LightProcessor*> lightProcessorsByShadowMapSize_;
     ea::vector<LightProcessor*> lightProcessorsByShadowMapTexture_;
+    /// Shadow splits to be processed in parallel.
+    ea::vector<ea::pair<LightProcessor*, unsigned>> lightSplitsToUpdate_;
     unsigned numShadowedLights_{};
 
     WorkQueueVector<Drawable*> queuedDrawableUpdates_;
@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../RenderPipeline/DynamicResolutionController.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Factor of exponential smoothing of frame time.
+const float frameTimeSmoothing = 0.1f;
+/// Frame time relative to the budget that triggers downscale.
+const float overBudgetThreshold = 1.05f;
+/// Frame time relative to the budget that allows immediate upscale.
+const float underBudgetThreshold = 0.85f;
+
+}
+
+void DynamicResolutionController::SetSettings(const DynamicResolutionSettings& settings)
+{
+    settings_ = settings;
+    if (!settings_.enabled_)
+        renderScale_ = 1.0f;
+    renderScale_ = Clamp(renderScale_, settings_.minScale_, settings_.maxScale_);
+    averageFrameTime_ = 0.0f;
+    framesSinceChange_ = 0;
+    framesWithinBudget_ = 0;
+}
+
+void DynamicResolutionController::Update(float frameTime)
+{
+    if (!settings_.enabled_ || frameTime <= 0.0f)
+        return;
+
+    averageFrameTime_ = averageFrameTime_ > 0.0f ? Lerp(averageFrameTime_, frameTime, frameTimeSmoothing) : frameTime;
+
+    ++framesSinceChange_;
+    if (framesSinceChange_ < MinFramesBetweenChanges)
+        return;
+
+    const float budget = 1.0f / settings_.targetFrameRate_;
+    const float load = averageFrameTime_ / budget;
+    framesWithinBudget_ = load <= overBudgetThreshold ? framesWithinBudget_ + 1 : 0;
+
+    // Pixel cost is proportional to squared scale
+    float desiredScale = renderScale_;
+    if (load > overBudgetThreshold || load < underBudgetThreshold)
+        desiredScale = renderScale_ * Sqrt(1.0f / load);
+    // Frame time is capped by vsync or frame limiter, probe higher scale from time to time
+    else if (framesWithinBudget_ >= UpscaleProbeFrames)
+        desiredScale = renderScale_ + ScaleStep;
+
+    desiredScale = Round(desiredScale / ScaleStep) * ScaleStep;
+    desiredScale = Clamp(desiredScale, settings_.minScale_, settings_.maxScale_);
+    if (desiredScale != renderScale_)
+    {
+        renderScale_ = desiredScale;
+        averageFrameTime_ = 0.0f;
+        framesSinceChange_ = 0;
+        framesWithinBudget_ = 0;
+    }
+}
+
+IntRect DynamicResolutionController::ScaleRect(const IntRect& rect) const
+{
+    if (renderScale_ == 1.0f)
+        return rect;
+
+    const IntVector2 size = VectorMax(IntVector2::ONE, VectorRoundToInt(rect.Size().ToVector2() * renderScale_));
+    return {rect.Min(), rect.Min() + size};
+}
+
+}
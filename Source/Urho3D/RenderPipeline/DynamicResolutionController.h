@@ -0,0 +1,61 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../RenderPipeline/RenderPipelineDefs.h"
+
+namespace Urho3D
+{
+
+/// Adjusts rendering resolution scale to keep frame time within the budget.
+/// Frame time is measured on CPU and includes time spent waiting for GPU.
+class URHO3D_API DynamicResolutionController
+{
+public:
+    /// Number of frames to wait after scale change before next change.
+    static constexpr unsigned MinFramesBetweenChanges = 15;
+    /// Number of frames within budget to wait before trying to increase scale.
+    static constexpr unsigned UpscaleProbeFrames = 120;
+    /// Scale is changed in steps to avoid reallocation of render buffers every frame.
+    static constexpr float ScaleStep = 0.05f;
+
+    void SetSettings(const DynamicResolutionSettings& settings);
+    /// Update with duration of the last frame.
+    void Update(float frameTime);
+
+    /// Return current scale of viewport size.
+    float GetRenderScale() const { return renderScale_; }
+    /// Return rectangle scaled by current scale.
+    IntRect ScaleRect(const IntRect& rect) const;
+
+private:
+    DynamicResolutionSettings settings_;
+
+    float renderScale_{1.0f};
+    float averageFrameTime_{};
+    unsigned framesSinceChange_{};
+    unsigned framesWithinBudget_{};
+};
+
+}
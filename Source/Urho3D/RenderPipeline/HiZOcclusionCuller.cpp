@@ -0,0 +1,236 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Graphics/Camera.h"
+#include "../Graphics/ComputeBuffer.h"
+#include "../Graphics/ComputeDevice.h"
+#include "../Graphics/Drawable.h"
+#include "../Graphics/Graphics.h"
+#include "../Graphics/Texture2D.h"
+#include "../IO/Log.h"
+#include "../RenderPipeline/HiZOcclusionCuller.h"
+
+#include "../DebugNew.h"
+
+#if defined(URHO3D_COMPUTE)
+
+namespace Urho3D
+{
+
+namespace
+{
+
+unsigned DivideRoundUp(unsigned value, unsigned divisor)
+{
+    return (value + divisor - 1) / divisor;
+}
+
+}
+
+HiZOcclusionCuller::HiZOcclusionCuller(Context* context)
+    : Object(context)
+    , computeDevice_(GetSubsystem<ComputeDevice>())
+    , parametersBuffer_(MakeShared<ComputeBuffer>(context))
+    , boundsBuffer_(MakeShared<ComputeBuffer>(context))
+    , visibilityBuffer_(MakeShared<ComputeBuffer>(context))
+{
+}
+
+HiZOcclusionCuller::~HiZOcclusionCuller()
+{
+}
+
+bool HiZOcclusionCuller::IsSupported() const
+{
+    return computeDevice_ && computeDevice_->IsSupported();
+}
+
+void HiZOcclusionCuller::ReadBackResults()
+{
+    occludedDrawables_.clear();
+    if (testedDrawables_.empty())
+        return;
+
+    const unsigned numDrawables = testedDrawables_.size();
+    visibilityData_.resize(numDrawables);
+    if (visibilityBuffer_->GetData(visibilityData_.data(), 0, numDrawables * sizeof(unsigned)))
+    {
+        for (unsigned i = 0; i < numDrawables; ++i)
+        {
+            if (!visibilityData_[i] && testedDrawables_[i])
+                occludedDrawables_.insert(testedDrawables_[i].Get());
+        }
+    }
+
+    testedDrawables_.clear();
+}
+
+void HiZOcclusionCuller::TestDrawables(Texture2D* depthTexture, Camera* camera, ea::span<Drawable* const> drawables)
+{
+    testedDrawables_.clear();
+    if (!IsSupported() || !depthTexture || !camera || drawables.empty())
+        return;
+
+    if (depthTexture->GetMultiSample() > 1)
+    {
+        URHO3D_LOGWARNING("HiZOcclusionCuller cannot read multisampled depth texture");
+        return;
+    }
+
+    if (!UpdateHiZTexture(depthTexture->GetSize()))
+        return;
+
+    auto graphics = GetSubsystem<Graphics>();
+    ShaderVariation* cullShader = graphics->GetShader(CS, "v2/C_HiZCull");
+    if (!cullShader)
+        return;
+
+    BuildHiZ(depthTexture);
+
+    // Pad data to buffer capacity to avoid buffer reallocation on every size change
+    const unsigned numDrawables = drawables.size();
+    const unsigned capacity = NextPowerOfTwo(numDrawables);
+    boundsData_.clear();
+    boundsData_.resize(capacity * 2);
+    testedDrawables_.reserve(numDrawables);
+    for (unsigned i = 0; i < numDrawables; ++i)
+    {
+        Drawable* drawable = drawables[i];
+        const BoundingBox& box = drawable->GetWorldBoundingBox();
+        boundsData_[i * 2] = Vector4(box.min_, 0.0f);
+        boundsData_[i * 2 + 1] = Vector4(box.max_, 0.0f);
+        testedDrawables_.emplace_back(drawable);
+    }
+
+    CullParameters parameters;
+    parameters.viewProj_ = camera->GetProjection() * camera->GetView();
+    parameters.hiZSize_ = Vector4(static_cast<float>(hiZTexture_->GetWidth()), static_cast<float>(hiZTexture_->GetHeight()),
+        static_cast<float>(hiZTexture_->GetLevels()), static_cast<float>(numDrawables));
+    parameters.uvScale_ = GetUVScaleOffset();
+
+    if (!EnsureBufferSize(parametersBuffer_, sizeof(CullParameters), sizeof(CullParameters))
+        || !EnsureBufferSize(boundsBuffer_, capacity * 2 * sizeof(Vector4), sizeof(Vector4))
+        || !EnsureBufferSize(visibilityBuffer_, capacity * sizeof(unsigned), sizeof(unsigned)))
+    {
+        testedDrawables_.clear();
+        return;
+    }
+
+    parametersBuffer_->SetData(&parameters, sizeof(CullParameters), sizeof(CullParameters));
+    boundsBuffer_->SetData(boundsData_.data(), boundsData_.size() * sizeof(Vector4), sizeof(Vector4));
+
+    computeDevice_->SetReadTexture(hiZTexture_, 0);
+    computeDevice_->SetWriteBuffer(parametersBuffer_, 0);
+    computeDevice_->SetWriteBuffer(boundsBuffer_, 1);
+    computeDevice_->SetWriteBuffer(visibilityBuffer_, 2);
+    computeDevice_->SetProgram(cullShader);
+    computeDevice_->Dispatch(DivideRoundUp(numDrawables, CullGroupSize), 1, 1);
+
+    computeDevice_->SetReadTexture(nullptr, 0);
+    for (unsigned unit = 0; unit < 3; ++unit)
+        computeDevice_->SetWriteBuffer(static_cast<ComputeBuffer*>(nullptr), unit);
+    computeDevice_->ApplyBindings();
+}
+
+Vector4 HiZOcclusionCuller::GetUVScaleOffset()
+{
+    // Texture rows go bottom-up in OpenGL and top-down in other backends
+#ifdef URHO3D_OPENGL
+    return Vector4(0.5f, 0.5f, 0.5f, 0.5f);
+#else
+    return Vector4(0.5f, -0.5f, 0.5f, 0.5f);
+#endif
+}
+
+Vector2 HiZOcclusionCuller::WorldToUV(Camera* camera, const Vector3& worldPosition)
+{
+    const Matrix4 viewProj = camera->GetProjection() * camera->GetView();
+    const Vector4 clipPosition = viewProj * Vector4(worldPosition, 1.0f);
+    const Vector2 ndcPosition{clipPosition.x_ / clipPosition.w_, clipPosition.y_ / clipPosition.w_};
+
+    const Vector4 uvScaleOffset = GetUVScaleOffset();
+    return {ndcPosition.x_ * uvScaleOffset.x_ + uvScaleOffset.z_, ndcPosition.y_ * uvScaleOffset.y_ + uvScaleOffset.w_};
+}
+
+bool HiZOcclusionCuller::UpdateHiZTexture(const IntVector2& depthSize)
+{
+    const IntVector2 hiZSize{ea::max(1, (depthSize.x_ + 1) / 2), ea::max(1, (depthSize.y_ + 1) / 2)};
+    if (hiZTexture_ && hiZTexture_->GetSize() == hiZSize)
+        return true;
+
+    const unsigned numLevels = LogBaseTwo(static_cast<unsigned>(ea::max(hiZSize.x_, hiZSize.y_))) + 1;
+
+    hiZTexture_ = MakeShared<Texture2D>(context_);
+    hiZTexture_->SetNumLevels(numLevels);
+    hiZTexture_->SetFilterMode(FILTER_NEAREST);
+    hiZTexture_->SetAddressMode(COORD_U, ADDRESS_CLAMP);
+    hiZTexture_->SetAddressMode(COORD_V, ADDRESS_CLAMP);
+    hiZTexture_->SetUnorderedAccess(true);
+    if (!hiZTexture_->SetSize(hiZSize.x_, hiZSize.y_, Graphics::GetFloat32Format()))
+    {
+        URHO3D_LOGERROR("Failed to create Hi-Z texture of size {}x{}", hiZSize.x_, hiZSize.y_);
+        hiZTexture_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void HiZOcclusionCuller::BuildHiZ(Texture2D* depthTexture)
+{
+    auto graphics = GetSubsystem<Graphics>();
+    ShaderVariation* depthShader = graphics->GetShader(CS, "v2/C_HiZ", "SOURCE_DEPTH");
+    ShaderVariation* downsampleShader = graphics->GetShader(CS, "v2/C_HiZ");
+
+    // First level is reduced from depth texture, other levels are reduced from previous level
+    computeDevice_->SetReadTexture(depthTexture, 0);
+    computeDevice_->SetWriteTexture(hiZTexture_, 2, 0, 0);
+    computeDevice_->SetProgram(depthShader);
+    computeDevice_->Dispatch(DivideRoundUp(hiZTexture_->GetWidth(), HiZGroupSize),
+        DivideRoundUp(hiZTexture_->GetHeight(), HiZGroupSize), 1);
+    computeDevice_->SetReadTexture(nullptr, 0);
+
+    computeDevice_->SetProgram(downsampleShader);
+    for (unsigned level = 1; level < hiZTexture_->GetLevels(); ++level)
+    {
+        computeDevice_->SetWriteTexture(hiZTexture_, 1, 0, level - 1);
+        computeDevice_->SetWriteTexture(hiZTexture_, 2, 0, level);
+        computeDevice_->Dispatch(DivideRoundUp(hiZTexture_->GetLevelWidth(level), HiZGroupSize),
+            DivideRoundUp(hiZTexture_->GetLevelHeight(level), HiZGroupSize), 1);
+    }
+
+    computeDevice_->SetWriteTexture(nullptr, 1, 0, 0);
+    computeDevice_->SetWriteTexture(nullptr, 2, 0, 0);
+}
+
+bool HiZOcclusionCuller::EnsureBufferSize(ComputeBuffer* buffer, unsigned size, unsigned structureSize)
+{
+    if (buffer->GetSize() == size && buffer->GetStructSize() == structureSize)
+        return true;
+    return buffer->SetSize(size, structureSize);
+}
+
+}
+
+#endif
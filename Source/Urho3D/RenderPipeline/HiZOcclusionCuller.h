@@ -0,0 +1,123 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Core/Object.h"
+#include "../Math/Matrix4.h"
+
+#include <EASTL/span.h>
+#include <EASTL/unordered_set.h>
+#include <EASTL/vector.h>
+
+#if defined(URHO3D_COMPUTE)
+
+namespace Urho3D
+{
+
+class Camera;
+class ComputeBuffer;
+class ComputeDevice;
+class Drawable;
+class Texture2D;
+
+/// GPU occlusion culling against hierarchical depth buffer (Hi-Z).
+/// Drawables are tested in compute shader against the depth of the frame that was just rendered.
+/// Results are read back on the next frame, so disoccluded drawables appear with one frame of delay.
+class URHO3D_API HiZOcclusionCuller : public Object
+{
+    URHO3D_OBJECT(HiZOcclusionCuller, Object);
+
+public:
+    /// Number of threads in compute group of culling shader.
+    static const unsigned CullGroupSize = 64;
+    /// Number of threads along each axis in compute group of Hi-Z shader.
+    static const unsigned HiZGroupSize = 8;
+
+    explicit HiZOcclusionCuller(Context* context);
+    ~HiZOcclusionCuller() override;
+
+    /// Return whether GPU occlusion culling is supported by the device.
+    bool IsSupported() const;
+
+    /// Read back results of the previous test. Should be called before IsVisible.
+    void ReadBackResults();
+    /// Return whether the drawable was visible at the previous test. Untested drawables are considered visible.
+    /// Safe to call from worker threads.
+    bool IsVisible(const Drawable* drawable) const { return occludedDrawables_.find(drawable) == occludedDrawables_.end(); }
+    /// Build Hi-Z from depth texture and test drawables against it.
+    /// Depth texture should contain the whole viewport of the camera.
+    void TestDrawables(Texture2D* depthTexture, Camera* camera, ea::span<Drawable* const> drawables);
+
+    /// Return number of drawables occluded at the previous test.
+    unsigned GetNumOccludedDrawables() const { return occludedDrawables_.size(); }
+    /// Return Hi-Z texture.
+    Texture2D* GetHiZTexture() const { return hiZTexture_; }
+
+    /// Return scale (xy) and offset (zw) that convert normalized device coordinates to Hi-Z texture coordinates.
+    /// Depends only on the backend: camera flip is already applied by the projection.
+    static Vector4 GetUVScaleOffset();
+    /// Return Hi-Z texture coordinates of world position as seen by the camera. Same as in culling shader.
+    static Vector2 WorldToUV(Camera* camera, const Vector3& worldPosition);
+
+private:
+    /// Parameters of culling shader. Layout should match C_HiZCull shader.
+    struct CullParameters
+    {
+        Matrix4 viewProj_;
+        Vector4 hiZSize_;
+        Vector4 uvScale_;
+    };
+
+    /// Resize Hi-Z texture if needed.
+    bool UpdateHiZTexture(const IntVector2& depthSize);
+    /// Build Hi-Z mip chain from depth texture.
+    void BuildHiZ(Texture2D* depthTexture);
+    /// Ensure that compute buffer has at least specified size.
+    bool EnsureBufferSize(ComputeBuffer* buffer, unsigned size, unsigned structureSize);
+
+    /// Compute device.
+    WeakPtr<ComputeDevice> computeDevice_;
+
+    /// Hi-Z texture with mip chain.
+    SharedPtr<Texture2D> hiZTexture_;
+    /// Parameters of culling shader.
+    SharedPtr<ComputeBuffer> parametersBuffer_;
+    /// Bounding boxes of drawables, two elements per drawable.
+    SharedPtr<ComputeBuffer> boundsBuffer_;
+    /// Visibility of drawables.
+    SharedPtr<ComputeBuffer> visibilityBuffer_;
+
+    /// CPU-side data of bounding boxes.
+    ea::vector<Vector4> boundsData_;
+    /// CPU-side data of visibility.
+    ea::vector<unsigned> visibilityData_;
+    /// Drawables tested at the last test.
+    ea::vector<WeakPtr<Drawable>> testedDrawables_;
+    /// Drawables occluded at the last test.
+    ea::unordered_set<const Drawable*> occludedDrawables_;
+};
+
+}
+
+#endif
@@ -70,7 +70,7 @@ void InstancingBuffer::Initialize()
         }
 
         vertexBuffer_ = MakeShared<DynamicVertexBuffer>(context_);
-        vertexBuffer_->Initialize(128, vertexElements);
+        vertexBuffer_->Initialize(128, vertexElements, settings_.persistentBuffer_);
     }
 }
 
@@ -45,6 +45,7 @@ public:
     /// Begin buffer composition.
     void Begin();
     /// End buffer composition and commit added instances to GPU.
+    /// If persistent buffer is enabled, only instances changed since previous frame are uploaded.
     void End();
 
     /// Return index of next added instance.
@@ -69,6 +70,7 @@ public:
     const InstancingBufferSettings& GetSettings() const { return settings_; }
     VertexBuffer* GetVertexBuffer() const { return vertexBuffer_ ? vertexBuffer_->GetVertexBuffer() : nullptr; }
     bool IsEnabled() const { return settings_.enableInstancing_; }
+    unsigned GetNumUploadedInstances() const { return vertexBuffer_ ? vertexBuffer_->GetNumUploadedVertices() : 0; }
     /// @}
 
 private:
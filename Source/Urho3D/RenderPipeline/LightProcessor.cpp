@@ -162,6 +162,8 @@ void LightProcessor::BeginUpdate(DrawableProcessor* drawableProcessor, LightProc
     litGeometries_.clear();
     shadowCasterCandidates_.clear();
     shadowMap_ = {};
+    clustered_ = false;
+    tiled_ = false;
 
     // Initialize shadow
     isShadowRequested_ = callback->IsLightShadowed(light_);
@@ -249,24 +251,34 @@ void LightProcessor::Update(DrawableProcessor* drawableProcessor, const LightPro
     }
 
     InitializeShadowSplits(drawableProcessor);
+}
 
-    for (unsigned i = 0; i < numActiveSplits_; ++i)
+void LightProcessor::UpdateSplit(DrawableProcessor* drawableProcessor, unsigned splitIndex)
+{
+    ShadowSplitProcessor& split = splits_[splitIndex];
+    switch (light_->GetLightType())
     {
-        switch (lightType)
-        {
-        case LIGHT_SPOT:
-            splits_[i].ProcessSpotShadowCasters(drawableProcessor, shadowCasterCandidates_);
-            break;
-        case LIGHT_POINT:
-            splits_[i].ProcessPointShadowCasters(drawableProcessor, shadowCasterCandidates_);
-            break;
-        case LIGHT_DIRECTIONAL:
-            splits_[i].ProcessDirectionalShadowCasters(drawableProcessor, shadowCasterCandidates_);
-            break;
-        default:
-            break;
-        }
+    case LIGHT_SPOT:
+        split.InitializeSpot();
+        split.ProcessSpotShadowCasters(drawableProcessor, shadowCasterCandidates_);
+        break;
+    case LIGHT_POINT:
+        split.InitializePoint(static_cast<CubeMapFace>(splitIndex));
+        split.ProcessPointShadowCasters(drawableProcessor, shadowCasterCandidates_);
+        break;
+    case LIGHT_DIRECTIONAL:
+        split.InitializeDirectional(drawableProcessor, cascadeSplitRanges_[splitIndex], litGeometries_);
+        split.ProcessDirectionalShadowCasters(drawableProcessor);
+        break;
+    default:
+        break;
     }
+}
+
+void LightProcessor::FinalizeUpdate(const LightProcessorCallback* callback)
+{
+    if (numActiveSplits_ == 0)
+        return;
 
     const auto hasShadowCaster = [](const ShadowSplitProcessor& split) { return split.HasShadowCasters(); };
     if (!ea::any_of(splits_.begin(), splits_.begin() + numActiveSplits_, hasShadowCaster))
@@ -278,15 +290,29 @@ void LightProcessor::Update(DrawableProcessor* drawableProcessor, const LightPro
     // Evaluate split shadow map size
     shadowMapSplitSize_ = callback->GetShadowMapSize(light_, numActiveSplits_);
     shadowMapSize_ = IntVector2{ shadowMapSplitSize_, shadowMapSplitSize_ } * GetNumSplitsInGrid();
+
+    // Directional light shadows follow the camera. Skip expensive hashing of casters while shadow cameras move.
+    if (light_->GetLightType() != LIGHT_DIRECTIONAL)
+        shadowMapHash_ = CalculateShadowMapHash();
+    else
+    {
+        const unsigned splitCamerasHash = CalculateSplitCamerasHash();
+        shadowMapHash_ = splitCamerasHash == previousSplitCamerasHash_ ? CalculateShadowMapHash() : 0;
+        previousSplitCamerasHash_ = splitCamerasHash;
+    }
 }
 
 void LightProcessor::EndUpdate(DrawableProcessor* drawableProcessor,
     LightProcessorCallback* callback, unsigned pcfKernelSize)
 {
     // Allocate shadow map
+    isShadowMapCached_ = false;
     if (numActiveSplits_ > 0)
     {
-        shadowMap_ = callback->AllocateTransientShadowMap(shadowMapSize_);
+        if (shadowMapHash_ != 0)
+            CombineHash(shadowMapHash_, pcfKernelSize);
+
+        shadowMap_ = AllocateShadowMap(callback);
         if (!shadowMap_)
             numActiveSplits_ = 0;
         else
@@ -301,9 +327,80 @@ void LightProcessor::EndUpdate(DrawableProcessor* drawableProcessor,
     UpdateHashes();
 }
 
+unsigned LightProcessor::CalculateSplitCamerasHash() const
+{
+    unsigned hash = 0;
+    CombineHash(hash, numActiveSplits_);
+    for (unsigned i = 0; i < numActiveSplits_; ++i)
+    {
+        Camera* shadowCamera = splits_[i].GetShadowCamera();
+        CombineHash(hash, shadowCamera->GetView().ToHash());
+        CombineHash(hash, shadowCamera->GetProjection().ToHash());
+    }
+    return hash;
+}
+
+unsigned LightProcessor::CalculateShadowMapHash() const
+{
+    const BiasParameters& bias = light_->GetShadowBias();
+
+    unsigned hash = 0;
+    CombineHash(hash, MakeHash(shadowMapSize_));
+    CombineHash(hash, MakeHash(bias.constantBias_));
+    CombineHash(hash, MakeHash(bias.slopeScaledBias_));
+    CombineHash(hash, MakeHash(bias.normalOffset_));
+
+    for (unsigned i = 0; i < numActiveSplits_; ++i)
+    {
+        const ShadowSplitProcessor& split = splits_[i];
+        Camera* shadowCamera = split.GetShadowCamera();
+        CombineHash(hash, shadowCamera->GetView().ToHash());
+        CombineHash(hash, shadowCamera->GetProjection().ToHash());
+
+        for (Drawable* drawable : split.GetShadowCasters())
+        {
+            // Animated and otherwise dynamic geometry may change without changing transform
+            if (drawable->GetUpdateGeometryType() != UPDATE_NONE)
+                return 0;
+
+            CombineHash(hash, MakeHash(drawable));
+            CombineHash(hash, drawable->GetNode()->GetWorldTransform().ToHash());
+            CombineHash(hash, drawable->GetWorldBoundingBox().min_.ToHash());
+            CombineHash(hash, drawable->GetWorldBoundingBox().max_.ToHash());
+        }
+    }
+
+    // Reserve 0 for non-cacheable shadow maps
+    return ea::max(hash, 1u);
+}
+
+ShadowMapRegion LightProcessor::AllocateShadowMap(LightProcessorCallback* callback)
+{
+    if (shadowMapHash_ != 0)
+    {
+        const bool isCachedShadowMapValid = callback->IsPersistentShadowMapValid(cachedShadowMap_)
+            && cachedShadowMap_.rect_.Size() == shadowMapSize_;
+        if (!isCachedShadowMapValid)
+        {
+            cachedShadowMap_ = callback->AllocatePersistentShadowMap(shadowMapSize_);
+            cachedShadowMapHash_ = 0;
+        }
+
+        if (cachedShadowMap_)
+        {
+            isShadowMapCached_ = cachedShadowMapHash_ == shadowMapHash_;
+            cachedShadowMapHash_ = shadowMapHash_;
+            return cachedShadowMap_;
+        }
+    }
+
+    // Shadow map will be rendered into transient region, cached contents are no longer up to date
+    cachedShadowMapHash_ = 0;
+    return callback->AllocateTransientShadowMap(shadowMapSize_);
+}
+
 void LightProcessor::InitializeShadowSplits(DrawableProcessor* drawableProcessor)
 {
-    /// Setup splits
     switch (light_->GetLightType())
     {
     case LIGHT_DIRECTIONAL:
@@ -313,25 +410,16 @@ void LightProcessor::InitializeShadowSplits(DrawableProcessor* drawableProcessor
         const auto activeSplits = GetActiveSplits(light_, cullCamera->GetNearClip(), cullCamera->GetFarClip());
 
         numActiveSplits_ = activeSplits.size();
-        for (unsigned i = 0; i < numActiveSplits_; ++i)
-            splits_[i].InitializeDirectional(drawableProcessor, activeSplits[i], litGeometries_);
+        ea::copy(activeSplits.begin(), activeSplits.end(), cascadeSplitRanges_.begin());
         break;
     }
     case LIGHT_SPOT:
-    {
         numActiveSplits_ = 1;
-        splits_[0].InitializeSpot();
         break;
-    }
     case LIGHT_POINT:
-    {
         numActiveSplits_ = MAX_CUBEMAP_FACES;
-        for (unsigned i = 0; i < MAX_CUBEMAP_FACES; ++i)
-            splits_[i].InitializePoint(static_cast<CubeMapFace>(i));
         break;
     }
-    }
-
 }
 
 void LightProcessor::CookShaderParameters(Camera* cullCamera, const DrawableProcessorSettings& settings)
@@ -99,6 +99,11 @@ public:
     void BeginUpdate(DrawableProcessor* drawableProcessor, LightProcessorCallback* callback);
     /// Update light in worker thread.
     void Update(DrawableProcessor* drawableProcessor, const LightProcessorCallback* callback);
+    /// Initialize shadow split and process its shadow casters in worker thread.
+    /// Splits of the same light are independent and may be processed in parallel after Update.
+    void UpdateSplit(DrawableProcessor* drawableProcessor, unsigned splitIndex);
+    /// Finalize threaded update in worker thread after all splits are updated.
+    void FinalizeUpdate(const LightProcessorCallback* callback);
     /// End update from main thread.
     void EndUpdate(DrawableProcessor* drawableProcessor, LightProcessorCallback* callback, unsigned pcfKernelSize);
 
@@ -114,6 +119,15 @@ public:
     Light* GetLight() const { return light_; }
     /// @}
 
+    /// Mark light as clustered. Clustered lights are not processed as forward pixel or vertex lights.
+    /// Shall be called after threaded update and before forward lighting is processed.
+    void SetClustered(bool clustered) { clustered_ = clustered; }
+    bool IsClustered() const { return clustered_; }
+    /// Mark light as tiled. Tiled lights are evaluated by compute shader and are not rendered as light volumes.
+    /// Shall be called after threaded update and before light volume batches are composed.
+    void SetTiled(bool tiled) { tiled_ = tiled; }
+    bool IsTiled() const { return tiled_; }
+
     /// Return values are valid after threaded update
     /// @{
     const ea::vector<Drawable*>& GetLitGeometries() const { return litGeometries_; }
@@ -134,6 +148,8 @@ public:
     ea::span<ShadowSplitProcessor> GetMutableSplits() { return { splits_.data(), numActiveSplits_ }; }
 
     ShadowMapRegion GetShadowMap() const { return shadowMap_; }
+    /// Return whether shadow map is cached from previous frames and doesn't need to be rendered.
+    bool IsShadowMapCached() const { return isShadowMapCached_; }
     const CookedLightParams& GetParams() const { return cookedParams_; }
     /// @}
 
@@ -142,6 +158,12 @@ private:
     void UpdateHashes();
     void CookShaderParameters(Camera* cullCamera, const DrawableProcessorSettings& settings);
     IntVector2 GetNumSplitsInGrid() const;
+    /// Return hash of shadow camera transforms of active splits.
+    unsigned CalculateSplitCamerasHash() const;
+    /// Return hash of everything that affects shadow map contents. Return 0 if shadow map cannot be cached.
+    unsigned CalculateShadowMapHash() const;
+    /// Allocate shadow map, reuse cached shadow map if possible.
+    ShadowMapRegion AllocateShadowMap(LightProcessorCallback* callback);
 
     Light* light_{};
     ea::vector<ShadowSplitProcessor> splits_;
@@ -161,15 +183,28 @@ private:
     IntVector2 shadowMapSize_{};
     bool hasLitGeometries_{};
     bool hasForwardLitGeometries_{};
+    bool clustered_{};
+    bool tiled_{};
     /// Point and spot lights: only forward lit geometries.
     /// Directional lights: all lit geometries, for shadow focusing.
     ea::vector<Drawable*> litGeometries_;
     /// Point and spot lights: all possible shadow casters.
-    /// Directional lights: temporary buffer for split queries.
     ea::vector<Drawable*> shadowCasterCandidates_;
+    /// Directional lights: Z ranges of active cascades.
+    ea::array<FloatRange, MAX_CASCADE_SPLITS> cascadeSplitRanges_;
     /// Accumulative shadow map region containing all the splits.
     ShadowMapRegion shadowMap_;
     CookedLightParams cookedParams_;
+    unsigned shadowMapHash_{};
+    bool isShadowMapCached_{};
+    /// @}
+
+    /// Persistent shadow map kept between frames and hash of its contents.
+    /// @{
+    ShadowMapRegion cachedShadowMap_;
+    unsigned cachedShadowMapHash_{};
+    /// Directional lights: hash of shadow cameras at the previous frame.
+    unsigned previousSplitCamerasHash_{};
     /// @}
 
     /// Pipeline state hashes
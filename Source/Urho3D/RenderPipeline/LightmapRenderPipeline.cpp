@@ -72,6 +72,7 @@ void LightmapRenderPipelineView::RenderGeometryBuffer(Viewport* viewport, int te
     frameInfo.renderTarget_ = nullptr;
     frameInfo.viewportRect_ = viewport->GetEffectiveRect(nullptr);
     frameInfo.viewportSize_ = frameInfo.viewportRect_.Size();
+    frameInfo.outputRect_ = frameInfo.viewportRect_;
 
     sceneProcessor->SetPasses({ pass });
     sceneProcessor->Define(frameInfo);
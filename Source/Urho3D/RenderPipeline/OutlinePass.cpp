@@ -28,6 +28,8 @@
 #include "../RenderPipeline/RenderBufferManager.h"
 #include "../Scene/Scene.h"
 
+#include <EASTL/sort.h>
+
 namespace Urho3D
 {
 
@@ -61,33 +63,38 @@ void OutlineScenePass::SetOutlineGroups(Scene* scene)
 {
     scene->GetComponents<OutlineGroup>(outlineGroups_);
 
-    const bool hasDrawables = ea::any_of(outlineGroups_.begin(), outlineGroups_.end(),
-        [](const OutlineGroup* group) { return group->HasDrawables(); });
-    SetEnabled(hasDrawables);
+    ea::erase_if(outlineGroups_, [](const OutlineGroup* group) { return !group->HasDrawables(); });
+    ea::stable_sort(outlineGroups_.begin(), outlineGroups_.end(),
+        [](const OutlineGroup* lhs, const OutlineGroup* rhs) { return lhs->GetRenderOrder() < rhs->GetRenderOrder(); });
+
+    // Groups are processed in render order, so the last group overrides previous ones like it would on the screen
+    drawableToGroup_.clear();
+    for (OutlineGroup* outlineGroup : outlineGroups_)
+    {
+        for (Drawable* drawable : outlineGroup->GetDrawables())
+        {
+            if (drawable)
+                drawableToGroup_[drawable] = outlineGroup;
+        }
+    }
+
+    SetEnabled(!drawableToGroup_.empty());
 }
 
 DrawableProcessorPass::AddBatchResult OutlineScenePass::AddCustomBatch(
     unsigned threadIndex, Drawable* drawable, unsigned sourceBatchIndex, Technique* technique)
 {
-    if (outlineGroups_.empty())
+    const auto iter = drawableToGroup_.find(drawable);
+    if (iter == drawableToGroup_.end())
         return {};
 
-    // TODO: Check if all groups are empty
-    bool batchAdded = false;
-    for (OutlineGroup* outlineGroup : outlineGroups_)
-    {
-        if (!outlineGroup->ContainsDrawable(drawable))
-            continue;
-
-        if (Pass* referencePass = GetFirstPass(technique, outlinedPasses_))
-        {
-            geometryBatches_.PushBack(threadIndex, GeometryBatch::Deferred(drawable, sourceBatchIndex, referencePass, outlineGroup));
-
-            batchAdded = true;
-        }
-    }
+    Pass* referencePass = GetFirstPass(technique, outlinedPasses_);
+    if (!referencePass)
+        return {};
 
-    return {batchAdded, false};
+    OutlineGroup* outlineGroup = iter->second;
+    geometryBatches_.PushBack(threadIndex, GeometryBatch::Deferred(drawable, sourceBatchIndex, referencePass, outlineGroup));
+    return {true, false};
 }
 
 bool OutlineScenePass::CreatePipelineState(PipelineStateDesc& desc, PipelineStateBuilder* builder,
@@ -135,7 +142,7 @@ void OutlineScenePass::OnBatchesReady()
     }
 
     BatchCompositor::FillSortKeys(sortedBatches_, deferredBatches_);
-    ea::sort(sortedBatches_.begin(), sortedBatches_.end());
+    BatchCompositor::SortBatches(sortedBatches_);
 
     batchGroup_ = {sortedBatches_};
     batchGroup_.flags_ = BatchRenderFlag::EnableInstancingForStaticGeometry;
@@ -46,6 +46,7 @@ public:
         BatchStateCacheCallback* callback, const StringVector& outlinedPasses);
 
     /// Initialize outline groups from scene. Should be called every frame.
+    /// All groups are merged into single lookup table, so each drawable is rendered at most once.
     void SetOutlineGroups(Scene* scene);
 
     /// Implement ScenePass
@@ -66,6 +67,8 @@ public:
 private:
     ea::vector<unsigned> outlinedPasses_;
     ea::vector<OutlineGroup*> outlineGroups_;
+    /// Group of each outlined drawable. The group with the highest render order wins.
+    ea::unordered_map<Drawable*, OutlineGroup*> drawableToGroup_;
 
     /// Internal temporary containers:
     /// @{
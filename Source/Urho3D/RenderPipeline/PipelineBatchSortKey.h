@@ -41,7 +41,8 @@ struct PipelineBatchByState
     /// @{
     static constexpr unsigned long long PixelLightBits      = 8;
     static constexpr unsigned long long LightmapBits        = 8;
-    static constexpr unsigned long long MaterialBits        = 16;
+    static constexpr unsigned long long MaterialBits        = 8;
+    static constexpr unsigned long long TexturesBits        = 8;
     static constexpr unsigned long long PipelineStateBits   = 8;
     static constexpr unsigned long long ShaderProgramBits   = 16;
     static constexpr unsigned long long RenderOrderBits     = 8;
@@ -49,6 +50,7 @@ struct PipelineBatchByState
     static constexpr unsigned long long PixelLightMask      = (1ull << PixelLightBits) - 1;
     static constexpr unsigned long long LightmapMask        = (1ull << LightmapBits) - 1;
     static constexpr unsigned long long MaterialMask        = (1ull << MaterialBits) - 1;
+    static constexpr unsigned long long TexturesMask        = (1ull << TexturesBits) - 1;
     static constexpr unsigned long long PipelineStateMask   = (1ull << PipelineStateBits) - 1;
     static constexpr unsigned long long ShaderProgramMask   = (1ull << ShaderProgramBits) - 1;
     static constexpr unsigned long long RenderOrderMask     = (1ull << RenderOrderBits) - 1;
@@ -56,7 +58,8 @@ struct PipelineBatchByState
     static constexpr unsigned long long PixelLightOffset    = 0;
     static constexpr unsigned long long LightmapOffset      = PixelLightOffset    + PixelLightBits;
     static constexpr unsigned long long MaterialOffset      = LightmapOffset      + LightmapBits;
-    static constexpr unsigned long long PipelineStateOffset = MaterialOffset      + MaterialBits;
+    static constexpr unsigned long long TexturesOffset      = MaterialOffset      + MaterialBits;
+    static constexpr unsigned long long PipelineStateOffset = TexturesOffset      + TexturesBits;
     static constexpr unsigned long long ShaderProgramOffset = PipelineStateOffset + PipelineStateBits;
     static constexpr unsigned long long RenderOrderOffset   = ShaderProgramOffset + ShaderProgramBits;
 
@@ -65,6 +68,7 @@ struct PipelineBatchByState
         (PixelLightMask << PixelLightOffset)
         | (LightmapMask << LightmapOffset)
         | (MaterialMask << MaterialOffset)
+        | (TexturesMask << TexturesOffset)
         | (PipelineStateMask << PipelineStateOffset)
         | (ShaderProgramMask << ShaderProgramOffset)
         | (RenderOrderMask << RenderOrderOffset)
@@ -111,6 +115,8 @@ struct PipelineBatchByState
         primaryKey_ |= (batch->material_->GetRenderOrder() & RenderOrderMask) << RenderOrderOffset;
         primaryKey_ |= (batch->pipelineState_->GetShaderID() & ShaderProgramMask) << ShaderProgramOffset;
         primaryKey_ |= (batch->pipelineState_->GetObjectID() & PipelineStateMask) << PipelineStateOffset;
+        // Keep materials that share textures together, so shader resources are not rebound between them
+        primaryKey_ |= (batch->material_->GetTexturesHash() & TexturesMask) << TexturesOffset;
         primaryKey_ |= (batch->material_->GetObjectID() & MaterialMask) << MaterialOffset;
         primaryKey_ |= (batch->lightmapIndex_ & LightmapMask) << LightmapOffset;
         primaryKey_ |= (batch->pixelLightIndex_ & PixelLightMask) << PixelLightOffset;
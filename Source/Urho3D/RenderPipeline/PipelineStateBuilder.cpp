@@ -140,7 +140,8 @@ SharedPtr<PipelineState> PipelineStateBuilder::CreateBatchPipelineState(
         SetupShaders(pipelineStateDesc_, shaderProgramDesc_);
     }
 
-    return renderer_->GetOrCreatePipelineState(pipelineStateDesc_);
+    // Scene batches are simply skipped until their pipeline states are ready
+    return renderer_->GetOrCreatePipelineState(pipelineStateDesc_, true);
 }
 
 void PipelineStateBuilder::ClearState()
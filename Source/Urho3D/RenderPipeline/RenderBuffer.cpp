@@ -98,8 +98,72 @@ bool RenderBuffer::CheckIfBufferIsReady() const
     return true;
 }
 
+TransientRenderBufferAllocator::TransientRenderBufferAllocator(Renderer* renderer)
+    : renderer_(renderer)
+{
+}
+
+void TransientRenderBufferAllocator::OnRenderBegin()
+{
+    // Skip aliasing for one frame after conflict so buffers record fresh lifetimes
+    isEnabledThisFrame_ = enabled_ && !isConflictDetected_;
+    isConflictDetected_ = false;
+    nextAccessIndex_ = 0;
+    textures_.clear();
+}
+
+Texture* TransientRenderBufferAllocator::AcquireTexture(TextureRenderBuffer* buffer)
+{
+    const unsigned accessIndex = nextAccessIndex_++;
+    TextureRenderBuffer::Lifetime& lifetime = buffer->currentLifetime_;
+    if (!lifetime.IsValid())
+        lifetime.first_ = accessIndex;
+    lifetime.last_ = accessIndex;
+
+    // Check if texture is still owned by the buffer
+    if (buffer->currentTexture_)
+    {
+        if (buffer->aliasedTextureIndex_ == M_MAX_UNSIGNED || textures_[buffer->aliasedTextureIndex_].owner_ == buffer)
+            return buffer->currentTexture_;
+
+        URHO3D_LOGDEBUG("Transient render buffer was accessed after its texture was reused, aliasing is reset");
+        isConflictDetected_ = true;
+        buffer->aliasedTextureIndex_ = M_MAX_UNSIGNED;
+        buffer->currentTexture_ = buffer->AllocateTexture();
+        return buffer->currentTexture_;
+    }
+
+    // Reuse texture if previous owner was not used after this buffer was first used during previous frame
+    const IntVector2 size = buffer->GetCurrentSize();
+    const TextureRenderBuffer::Lifetime& previousLifetime = buffer->previousLifetime_;
+    if (isEnabledThisFrame_ && previousLifetime.IsValid())
+    {
+        for (unsigned i = 0; i < textures_.size(); ++i)
+        {
+            AliasedTexture& aliasedTexture = textures_[i];
+            if (aliasedTexture.params_ != buffer->GetParams() || aliasedTexture.size_ != size)
+                continue;
+
+            const TextureRenderBuffer::Lifetime& ownerLifetime = aliasedTexture.owner_->previousLifetime_;
+            if (!ownerLifetime.IsValid() || ownerLifetime.last_ >= previousLifetime.first_)
+                continue;
+
+            aliasedTexture.owner_ = buffer;
+            buffer->aliasedTextureIndex_ = i;
+            buffer->currentTexture_ = aliasedTexture.texture_;
+            return buffer->currentTexture_;
+        }
+    }
+
+    Texture* texture = buffer->AllocateTexture();
+    buffer->aliasedTextureIndex_ = textures_.size();
+    buffer->currentTexture_ = texture;
+    textures_.push_back(AliasedTexture{buffer->GetParams(), size, texture, buffer});
+    return texture;
+}
+
 TextureRenderBuffer::TextureRenderBuffer(RenderPipelineInterface* renderPipeline,
-    const RenderBufferParams& params, const Vector2& size)
+    const RenderBufferParams& params, const Vector2& size, TransientRenderBufferAllocator* allocator)
     : RenderBuffer(renderPipeline)
     , params_(params)
 {
@@ -119,6 +183,8 @@ TextureRenderBuffer::TextureRenderBuffer(RenderPipelineInterface* renderPipeline
 
     if (isPersistent || isDepthStencil)
         persistenceKey_ = GetObjectID();
+    else
+        allocator_ = allocator;
 }
 
 TextureRenderBuffer::~TextureRenderBuffer()
@@ -128,31 +194,57 @@ TextureRenderBuffer::~TextureRenderBuffer()
 void TextureRenderBuffer::OnRenderBegin(const CommonFrameInfo& frameInfo)
 {
     currentSize_ = CalculateRenderTargetSize(frameInfo.viewportRect_, sizeMultiplier_, fixedSize_);
+
+    if (allocator_ && allocator_->IsEnabled())
+    {
+        // Texture is allocated on first access
+        previousLifetime_ = currentLifetime_;
+        currentLifetime_ = {};
+        aliasedTextureIndex_ = M_MAX_UNSIGNED;
+        currentTexture_ = nullptr;
+    }
+    else
+    {
+        previousLifetime_ = {};
+        currentLifetime_ = {};
+        currentTexture_ = AllocateTexture();
+    }
+    bufferIsReady_ = true;
+}
+
+void TextureRenderBuffer::OnRenderEnd(const CommonFrameInfo& frameInfo)
+{
+    currentTexture_ = nullptr;
+    bufferIsReady_ = false;
+}
+
+Texture* TextureRenderBuffer::AllocateTexture() const
+{
     const bool autoResolve = !params_.flags_.Test(RenderBufferFlag::NoMultiSampledAutoResolve);
     const bool isCubemap = params_.flags_.Test(RenderBufferFlag::CubeMap);
     const bool isFiltered = params_.flags_.Test(RenderBufferFlag::BilinearFiltering);
     const bool isSRGB = params_.flags_.Test(RenderBufferFlag::sRGB);
 
-    currentTexture_ = renderer_->GetScreenBuffer(currentSize_.x_, currentSize_.y_,
+    return renderer_->GetScreenBuffer(currentSize_.x_, currentSize_.y_,
         params_.textureFormat_, params_.multiSampleLevel_, autoResolve,
         isCubemap, isFiltered, isSRGB, persistenceKey_);
-    bufferIsReady_ = true;
 }
 
-void TextureRenderBuffer::OnRenderEnd(const CommonFrameInfo& frameInfo)
+Texture* TextureRenderBuffer::GetCurrentTexture() const
 {
-    currentTexture_ = nullptr;
-    bufferIsReady_ = false;
+    if (allocator_ && (currentTexture_ == nullptr || aliasedTextureIndex_ != M_MAX_UNSIGNED))
+        return allocator_->AcquireTexture(const_cast<TextureRenderBuffer*>(this));
+    return currentTexture_;
 }
 
 Texture* TextureRenderBuffer::GetTexture() const
 {
-    return CheckIfBufferIsReady() ? currentTexture_ : nullptr;
+    return CheckIfBufferIsReady() ? GetCurrentTexture() : nullptr;
 }
 
 RenderSurface* TextureRenderBuffer::GetRenderSurface(CubeMapFace face) const
 {
-    return CheckIfBufferIsReady() ? GetRenderSurfaceFromTexture(currentTexture_, face) : nullptr;
+    return CheckIfBufferIsReady() ? GetRenderSurfaceFromTexture(GetCurrentTexture(), face) : nullptr;
 }
 
 IntRect TextureRenderBuffer::GetViewportRect() const
@@ -178,7 +270,7 @@ RenderSurface* ViewportColorRenderBuffer::GetRenderSurface(CubeMapFace face) con
 void ViewportColorRenderBuffer::OnRenderBegin(const CommonFrameInfo& frameInfo)
 {
     renderTarget_ = frameInfo.renderTarget_;
-    viewportRect_ = frameInfo.viewportRect_;
+    viewportRect_ = frameInfo.outputRect_;
     bufferIsReady_ = true;
 }
 
@@ -204,7 +296,7 @@ RenderSurface* ViewportDepthStencilRenderBuffer::GetRenderSurface(CubeMapFace fa
 
 void ViewportDepthStencilRenderBuffer::OnRenderBegin(const CommonFrameInfo& frameInfo)
 {
-    viewportRect_ = frameInfo.viewportRect_;
+    viewportRect_ = frameInfo.outputRect_;
 
     if (!frameInfo.renderTarget_)
     {
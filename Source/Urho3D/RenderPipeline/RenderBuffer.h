@@ -72,6 +72,44 @@ protected:
     bool bufferIsReady_{};
 };
 
+class TextureRenderBuffer;
+
+/// Allocates textures for transient render buffers on first access.
+/// Buffers that have the same parameters and were not alive at the same time during previous frame share one texture.
+/// If the order of accesses changes and aliased buffers overlap, conflicting buffer falls back to dedicated texture
+/// and aliasing is disabled for one frame to record new lifetimes.
+class URHO3D_API TransientRenderBufferAllocator
+{
+public:
+    explicit TransientRenderBufferAllocator(Renderer* renderer);
+
+    /// Enable or disable aliasing. Takes effect next frame.
+    void SetEnabled(bool enabled) { enabled_ = enabled; }
+    bool IsEnabled() const { return enabled_; }
+
+    void OnRenderBegin();
+
+    /// Return texture for the buffer and register buffer access.
+    Texture* AcquireTexture(TextureRenderBuffer* buffer);
+
+private:
+    struct AliasedTexture
+    {
+        RenderBufferParams params_;
+        IntVector2 size_;
+        Texture* texture_{};
+        TextureRenderBuffer* owner_{};
+    };
+
+    Renderer* renderer_{};
+    bool enabled_{};
+
+    bool isEnabledThisFrame_{};
+    bool isConflictDetected_{};
+    unsigned nextAccessIndex_{};
+    ea::vector<AliasedTexture> textures_;
+};
+
 /// Writable and readable render buffer texture (2D or cubemap).
 class URHO3D_API TextureRenderBuffer : public RenderBuffer
 {
@@ -79,7 +117,8 @@ class URHO3D_API TextureRenderBuffer : public RenderBuffer
 
 public:
     TextureRenderBuffer(RenderPipelineInterface* renderPipeline,
-        const RenderBufferParams& params, const Vector2& size = Vector2::ONE);
+        const RenderBufferParams& params, const Vector2& size = Vector2::ONE,
+        TransientRenderBufferAllocator* allocator = nullptr);
     ~TextureRenderBuffer() override;
 
     /// RenderBuffer implementation
@@ -89,10 +128,32 @@ public:
     IntRect GetViewportRect() const override;
     /// @}
 
+    /// Return parameters and size of the texture in current frame.
+    /// @{
+    const RenderBufferParams& GetParams() const { return params_; }
+    IntVector2 GetCurrentSize() const { return currentSize_; }
+    /// @}
+
 private:
+    friend class TransientRenderBufferAllocator;
+
+    /// Range of buffer accesses within the frame.
+    struct Lifetime
+    {
+        unsigned first_{M_MAX_UNSIGNED};
+        unsigned last_{};
+
+        bool IsValid() const { return first_ != M_MAX_UNSIGNED; }
+    };
+
     void OnRenderBegin(const CommonFrameInfo& frameInfo) override;
     void OnRenderEnd(const CommonFrameInfo& frameInfo) override;
 
+    /// Allocate new texture from Renderer.
+    Texture* AllocateTexture() const;
+    /// Return current texture, allocating it on first access if transient.
+    Texture* GetCurrentTexture() const;
+
     /// Immutable properties
     /// @{
     RenderBufferParams params_;
@@ -100,12 +161,21 @@ private:
     IntVector2 fixedSize_;
     /// If not zero, texture will keep content between frames.
     unsigned persistenceKey_{};
+    /// Allocator of transient textures. Null if texture is allocated for the whole frame.
+    TransientRenderBufferAllocator* allocator_{};
     /// @}
 
     /// Current frame info
     /// @{
     IntVector2 currentSize_;
-    Texture* currentTexture_{};
+    mutable Texture* currentTexture_{};
+    /// @}
+
+    /// Transient texture aliasing state
+    /// @{
+    Lifetime previousLifetime_;
+    Lifetime currentLifetime_;
+    unsigned aliasedTextureIndex_{M_MAX_UNSIGNED};
     /// @}
 };
 
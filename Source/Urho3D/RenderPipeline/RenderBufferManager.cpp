@@ -215,6 +215,7 @@ RenderBufferManager::RenderBufferManager(RenderPipelineInterface* renderPipeline
     , renderer_(GetSubsystem<Renderer>())
     , debugger_(renderPipeline_->GetDebugger())
     , drawQueue_(renderer_->GetDefaultDrawQueue())
+    , transientBufferAllocator_(renderer_)
 {
     // Order is important. RenderBufferManager should receive callbacks before any of render buffers
     renderPipeline_->OnPipelineStatesInvalidated.Subscribe(this, &RenderBufferManager::OnPipelineStatesInvalidated);
@@ -228,6 +229,7 @@ RenderBufferManager::RenderBufferManager(RenderPipelineInterface* renderPipeline
 void RenderBufferManager::SetSettings(const RenderBufferManagerSettings& settings)
 {
     settings_ = settings;
+    transientBufferAllocator_.SetEnabled(settings_.aliasTransientBuffers_);
 }
 
 void RenderBufferManager::SetFrameSettings(const RenderBufferManagerFrameSettings& frameSettings)
@@ -239,7 +241,7 @@ void RenderBufferManager::SetFrameSettings(const RenderBufferManagerFrameSetting
 
 SharedPtr<RenderBuffer> RenderBufferManager::CreateColorBuffer(const RenderBufferParams& params, const Vector2& size)
 {
-    return MakeShared<TextureRenderBuffer>(renderPipeline_, params, size);
+    return MakeShared<TextureRenderBuffer>(renderPipeline_, params, size, &transientBufferAllocator_);
 }
 
 void RenderBufferManager::SwapColorBuffers(bool synchronizeContents)
@@ -502,6 +504,7 @@ void RenderBufferManager::OnRenderBegin(const CommonFrameInfo& frameInfo)
 {
     timeStep_ = frameInfo.timeStep_;
     viewportRect_ = frameInfo.viewportRect_;
+    transientBufferAllocator_.OnRenderBegin();
 
     // Get parameters of output render surface
     const unsigned outputFormat = RenderSurface::GetFormat(graphics_, frameInfo.renderTarget_);
@@ -513,8 +516,9 @@ void RenderBufferManager::OnRenderBegin(const CommonFrameInfo& frameInfo)
     const bool outputHasReadableDepth = outputDepthStencil && HasReadableDepth(*outputDepthStencil);
 
     Texture2D* outputTexture = GetParentTexture2D(frameInfo.renderTarget_);
-    const bool isFullRectOutput = frameInfo.viewportRect_ == IntRect::ZERO
-        || frameInfo.viewportRect_ == RenderSurface::GetRect(graphics_, frameInfo.renderTarget_);
+    const bool isFullRectOutput = frameInfo.outputRect_ == IntRect::ZERO
+        || frameInfo.outputRect_ == RenderSurface::GetRect(graphics_, frameInfo.renderTarget_);
+    isScaledOutput_ = frameInfo.viewportRect_.Size() != frameInfo.outputRect_.Size();
     const bool isSimpleTextureOutput = outputTexture != nullptr && isFullRectOutput;
     const bool isBilinearFilteredOutput = outputTexture && outputTexture->GetFilterMode() != FILTER_NEAREST;
 
@@ -527,7 +531,8 @@ void RenderBufferManager::OnRenderBegin(const CommonFrameInfo& frameInfo)
         ? outputMultiSample : settings_.multiSampleLevel_;
     viewportParams.textureFormat_ = needHDR ? Graphics::GetRGBAFloat16Format() : Graphics::GetRGBFormat();
     viewportParams.flags_.Set(RenderBufferFlag::sRGB, needSRGB);
-    viewportParams.flags_.Set(RenderBufferFlag::BilinearFiltering, settings_.filteredColor_ || isBilinearFilteredOutput);
+    viewportParams.flags_.Set(RenderBufferFlag::BilinearFiltering,
+        settings_.filteredColor_ || isBilinearFilteredOutput || isScaledOutput_);
 
     if (previousViewportParams_ != viewportParams)
     {
@@ -546,9 +551,9 @@ void RenderBufferManager::OnRenderBegin(const CommonFrameInfo& frameInfo)
     const bool isColorUsageMatching = isSimpleTextureOutput || !needSimpleTexture;
 
     const bool needSecondaryBuffer = frameSettings_.supportColorReadWrite_;
-    const bool needSubstitutePrimaryBuffer = !isColorFormatMatching
+    const bool needSubstitutePrimaryBuffer = isScaledOutput_ || !isColorFormatMatching
         || !isColorSRGBMatching || !isMultiSampleMatching || !isFilterMatching || !isColorUsageMatching;
-    const bool needSubstituteDepthBuffer = !isMultiSampleMatching || !outputDepthStencil.has_value()
+    const bool needSubstituteDepthBuffer = isScaledOutput_ || !isMultiSampleMatching || !outputDepthStencil.has_value()
         || ((needSecondaryBuffer || needSubstitutePrimaryBuffer) && outputDepthStencil.value() == nullptr)
         || (settings_.readableDepth_ && (!outputHasReadableDepth || !isSimpleTextureOutput))
         || (settings_.stencilBuffer_ && !outputHasStencil);
@@ -556,11 +561,13 @@ void RenderBufferManager::OnRenderBegin(const CommonFrameInfo& frameInfo)
     // Allocate substitute buffers if necessary
     if (needSubstitutePrimaryBuffer && !substituteRenderBuffers_[0])
     {
-        substituteRenderBuffers_[0] = MakeShared<TextureRenderBuffer>(renderPipeline_, viewportParams);
+        substituteRenderBuffers_[0] = MakeShared<TextureRenderBuffer>(
+            renderPipeline_, viewportParams, Vector2::ONE, &transientBufferAllocator_);
     }
     if (needSecondaryBuffer && !substituteRenderBuffers_[1])
     {
-        substituteRenderBuffers_[1] = MakeShared<TextureRenderBuffer>(renderPipeline_, viewportParams);
+        substituteRenderBuffers_[1] = MakeShared<TextureRenderBuffer>(
+            renderPipeline_, viewportParams, Vector2::ONE, &transientBufferAllocator_);
     }
     if (needSubstituteDepthBuffer && !substituteDepthBuffer_)
     {
@@ -591,10 +598,12 @@ void RenderBufferManager::OnRenderEnd(const CommonFrameInfo& frameInfo)
 {
     if (writeableColorBuffer_ != viewportColorBuffer_.Get())
     {
+        // Upscale and sharpen if rendering resolution is scaled
         Texture* colorTexture = writeableColorBuffer_->GetTexture();
+        const float sharpness = isScaledOutput_ ? frameSettings_.upscaleSharpness_ : 0.0f;
         CopyTextureRegion("Copy final color to output RenderSurface", colorTexture,
             colorTexture->GetRect(), viewportColorBuffer_->GetRenderSurface(),
-            viewportColorBuffer_->GetViewportRect(), ColorSpaceTransition::Automatic, false);
+            viewportColorBuffer_->GetViewportRect(), ColorSpaceTransition::Automatic, false, sharpness);
 
         // If viewport is reused for ping-ponging, optimize away final copy
         flipColorBuffersNextTime_ ^= viewportColorBuffer_ == readableColorBuffer_;
@@ -614,22 +623,32 @@ void RenderBufferManager::InitializeCopyTexturePipelineState()
     copyTexturePipelineState_ = CreateQuadPipelineState(BLEND_REPLACE, shaderName, "");
     copyGammaToLinearTexturePipelineState_ = CreateQuadPipelineState(BLEND_REPLACE, shaderName, "URHO3D_GAMMA_TO_LINEAR");
     copyLinearToGammaTexturePipelineState_ = CreateQuadPipelineState(BLEND_REPLACE, shaderName, "URHO3D_LINEAR_TO_GAMMA");
+    sharpenTexturePipelineState_ = CreateQuadPipelineState(BLEND_REPLACE, shaderName, "URHO3D_SHARPEN");
+    sharpenGammaToLinearTexturePipelineState_ = CreateQuadPipelineState(BLEND_REPLACE, shaderName, "URHO3D_SHARPEN URHO3D_GAMMA_TO_LINEAR");
+    sharpenLinearToGammaTexturePipelineState_ = CreateQuadPipelineState(BLEND_REPLACE, shaderName, "URHO3D_SHARPEN URHO3D_LINEAR_TO_GAMMA");
 }
 
 void RenderBufferManager::CopyTextureRegion(ea::string_view debugComment,
     Texture* sourceTexture, const IntRect& sourceRect,
-    RenderSurface* destinationSurface, const IntRect& destinationRect, ColorSpaceTransition mode, bool flipVertical)
+    RenderSurface* destinationSurface, const IntRect& destinationRect, ColorSpaceTransition mode, bool flipVertical,
+    float sharpness)
 {
     graphics_->SetRenderTarget(0, destinationSurface);
     for (unsigned i = 1; i < MAX_RENDERTARGETS; ++i)
         graphics_->ResetRenderTarget(i);
     graphics_->SetDepthStencil(renderer_->GetDepthStencil(destinationSurface));
     graphics_->SetViewport(destinationRect);
-    DrawTextureRegion(debugComment, sourceTexture, sourceRect, mode, flipVertical);
+    DrawTextureRegion(debugComment, sourceTexture, sourceRect, mode, flipVertical, sharpness);
 }
 
 void RenderBufferManager::DrawTextureRegion(ea::string_view debugComment, Texture* sourceTexture,
     const IntRect& sourceRect, ColorSpaceTransition mode, bool flipVertical)
+{
+    DrawTextureRegion(debugComment, sourceTexture, sourceRect, mode, flipVertical, 0.0f);
+}
+
+void RenderBufferManager::DrawTextureRegion(ea::string_view debugComment, Texture* sourceTexture,
+    const IntRect& sourceRect, ColorSpaceTransition mode, bool flipVertical, float sharpness)
 {
     if (!sourceTexture->IsInstanceOf<Texture2D>())
     {
@@ -644,12 +663,17 @@ void RenderBufferManager::DrawTextureRegion(ea::string_view debugComment, Textur
     const bool isSRGBDestination = RenderSurface::GetSRGB(graphics_, graphics_->GetRenderTarget(0));
 
     DrawQuadParams callParams;
+    const bool sharpen = sharpness > 0.0f;
     if (mode == ColorSpaceTransition::None || isSRGBSource == isSRGBDestination)
-        callParams.pipelineState_ = copyTexturePipelineState_;
+        callParams.pipelineState_ = sharpen ? sharpenTexturePipelineState_ : copyTexturePipelineState_;
     else if (isSRGBDestination)
-        callParams.pipelineState_ = copyGammaToLinearTexturePipelineState_;
+        callParams.pipelineState_ = sharpen ? sharpenGammaToLinearTexturePipelineState_ : copyGammaToLinearTexturePipelineState_;
     else
-        callParams.pipelineState_ = copyLinearToGammaTexturePipelineState_;
+        callParams.pipelineState_ = sharpen ? sharpenLinearToGammaTexturePipelineState_ : copyLinearToGammaTexturePipelineState_;
+
+    const ShaderParameterDesc shaderParameters[] = { { "Sharpness", sharpness } };
+    if (sharpen)
+        callParams.parameters_ = shaderParameters;
 
     callParams.invInputSize_ = Vector2::ONE / sourceTexture->GetSize().ToVector2();
 
@@ -168,7 +168,10 @@ private:
     void InitializeCopyTexturePipelineState();
     void ResetCachedRenderBuffers();
     void CopyTextureRegion(ea::string_view debugComment, Texture* sourceTexture, const IntRect& sourceRect,
-        RenderSurface* destinationSurface, const IntRect& destinationRect, ColorSpaceTransition mode, bool flipVertical);
+        RenderSurface* destinationSurface, const IntRect& destinationRect, ColorSpaceTransition mode, bool flipVertical,
+        float sharpness = 0.0f);
+    void DrawTextureRegion(ea::string_view debugComment, Texture* sourceTexture, const IntRect& sourceRect,
+        ColorSpaceTransition mode, bool flipVertical, float sharpness);
 
     /// Extrenal dependencies
     /// @{
@@ -179,6 +182,8 @@ private:
     SharedPtr<DrawCommandQueue> drawQueue_;
     /// @}
 
+    TransientRenderBufferAllocator transientBufferAllocator_;
+
     /// Cached between frames
     /// @{
     RenderBufferManagerSettings settings_;
@@ -189,6 +194,9 @@ private:
     SharedPtr<PipelineState> copyTexturePipelineState_;
     SharedPtr<PipelineState> copyGammaToLinearTexturePipelineState_;
     SharedPtr<PipelineState> copyLinearToGammaTexturePipelineState_;
+    SharedPtr<PipelineState> sharpenTexturePipelineState_;
+    SharedPtr<PipelineState> sharpenGammaToLinearTexturePipelineState_;
+    SharedPtr<PipelineState> sharpenLinearToGammaTexturePipelineState_;
 
     SharedPtr<RenderBuffer> substituteRenderBuffers_[2];
     SharedPtr<RenderBuffer> substituteDepthBuffer_;
@@ -208,6 +216,7 @@ private:
     RenderBuffer* readableColorBuffer_{};
 
     bool flipColorBuffersNextTime_{};
+    bool isScaledOutput_{};
     /// @}
 };
 
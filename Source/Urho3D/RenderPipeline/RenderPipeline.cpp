@@ -82,6 +82,7 @@ static const ea::vector<ea::string> directLightingModeNames =
     "Forward",
     "Deferred Blinn-Phong",
     "Deferred PBR",
+    "Clustered Forward",
 };
 
 static const ea::vector<ea::string> postProcessAntialiasingNames =
@@ -130,12 +131,18 @@ void RenderPipeline::RegisterObject(Context* context)
     URHO3D_ENUM_ATTRIBUTE_EX("Specular Quality", settings_.sceneProcessor_.specularQuality_, MarkSettingsDirty, specularQualityNames, SceneProcessorSettings{}.specularQuality_, AM_DEFAULT);
     URHO3D_ENUM_ATTRIBUTE_EX("Reflection Quality", settings_.sceneProcessor_.reflectionQuality_, MarkSettingsDirty, reflectionQualityNames, SceneProcessorSettings{}.reflectionQuality_, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Readable Depth", bool, settings_.renderBufferManager_.readableDepth_, MarkSettingsDirty, RenderBufferManagerSettings{}.readableDepth_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Alias Transient Buffers", bool, settings_.renderBufferManager_.aliasTransientBuffers_, MarkSettingsDirty, RenderBufferManagerSettings{}.aliasTransientBuffers_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Hi-Z Occlusion", bool, settings_.sceneProcessor_.hiZOcclusion_, MarkSettingsDirty, OcclusionBufferSettings{}.hiZOcclusion_, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Max Vertex Lights", unsigned, settings_.sceneProcessor_.maxVertexLights_, MarkSettingsDirty, DrawableProcessorSettings{}.maxVertexLights_, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Max Pixel Lights", unsigned, settings_.sceneProcessor_.maxPixelLights_, MarkSettingsDirty, DrawableProcessorSettings{}.maxPixelLights_, AM_DEFAULT);
     URHO3D_ENUM_ATTRIBUTE_EX("Ambient Mode", settings_.sceneProcessor_.ambientMode_, MarkSettingsDirty, ambientModeNames, DrawableAmbientMode::Directional, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Enable Instancing", bool, settings_.instancingBuffer_.enableInstancing_, MarkSettingsDirty, true, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Persistent Instancing Buffer", bool, settings_.instancingBuffer_.persistentBuffer_, MarkSettingsDirty, InstancingBufferSettings{}.persistentBuffer_, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Depth Pre-Pass", bool, settings_.sceneProcessor_.depthPrePass_, MarkSettingsDirty, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Depth Pre-Pass Min Screen Size", float, settings_.sceneProcessor_.depthPrePassMinScreenSize_, MarkSettingsDirty, DrawableProcessorSettings{}.depthPrePassMinScreenSize_, AM_DEFAULT);
     URHO3D_ENUM_ATTRIBUTE_EX("Lighting Mode", settings_.sceneProcessor_.lightingMode_, MarkSettingsDirty, directLightingModeNames, DirectLightingMode::Forward, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Dynamic Light Type", bool, settings_.sceneProcessor_.dynamicLightType_, MarkSettingsDirty, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Tiled Deferred Lighting", bool, settings_.sceneProcessor_.tiledDeferredLighting_, MarkSettingsDirty, false, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Enable Shadows", bool, settings_.sceneProcessor_.enableShadows_, MarkSettingsDirty, true, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Cubemap Box Projection", bool, settings_.sceneProcessor_.cubemapBoxProjection_, MarkSettingsDirty, false, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("PCF Kernel Size", unsigned, settings_.sceneProcessor_.pcfKernelSize_, MarkSettingsDirty, 1, AM_DEFAULT);
@@ -143,12 +150,17 @@ void RenderPipeline::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE_EX("VSM Shadow Settings", Vector2, settings_.sceneProcessor_.varianceShadowMapParams_, MarkSettingsDirty, BatchRendererSettings{}.varianceShadowMapParams_, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("VSM Multi Sample", unsigned, settings_.shadowMapAllocator_.varianceShadowMapMultiSample_, MarkSettingsDirty, 1, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("16-bit Shadow Maps", bool, settings_.shadowMapAllocator_.use16bitShadowMaps_, MarkSettingsDirty, false, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Cache Static Shadow Maps", bool, settings_.shadowMapAllocator_.cacheStaticShadowMaps_, MarkSettingsDirty, false, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Auto Exposure", bool, settings_.autoExposure_.autoExposure_, MarkSettingsDirty, false, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Min Exposure", float, settings_.autoExposure_.minExposure_, MarkSettingsDirty, AutoExposurePassSettings{}.minExposure_, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Max Exposure", float, settings_.autoExposure_.maxExposure_, MarkSettingsDirty, AutoExposurePassSettings{}.maxExposure_, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Adapt Rate", float, settings_.autoExposure_.adaptRate_, MarkSettingsDirty, AutoExposurePassSettings{}.adaptRate_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Luminance Histogram", bool, settings_.autoExposure_.luminanceHistogram_, MarkSettingsDirty, AutoExposurePassSettings{}.luminanceHistogram_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Low Luminance Percentile", float, settings_.autoExposure_.lowPercentile_, MarkSettingsDirty, AutoExposurePassSettings{}.lowPercentile_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("High Luminance Percentile", float, settings_.autoExposure_.highPercentile_, MarkSettingsDirty, AutoExposurePassSettings{}.highPercentile_, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("SSAO", bool, settings_.ssao_.enabled_, MarkSettingsDirty, AmbientOcclusionPassSettings{}.enabled_, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("SSAO Downscale", unsigned, settings_.ssao_.downscale_, MarkSettingsDirty, AmbientOcclusionPassSettings{}.downscale_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("SSAO Temporal", bool, settings_.ssao_.temporal_, MarkSettingsDirty, AmbientOcclusionPassSettings{}.temporal_, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("SSAO Strength", float, settings_.ssao_.strength_, MarkSettingsDirty, AmbientOcclusionPassSettings{}.strength_, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("SSAO Exponent", float, settings_.ssao_.exponent_, MarkSettingsDirty, AmbientOcclusionPassSettings{}.exponent_, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("SSAO Near Radius", float, settings_.ssao_.radiusNear_, MarkSettingsDirty, AmbientOcclusionPassSettings{}.radiusNear_, AM_DEFAULT);
@@ -160,6 +172,11 @@ void RenderPipeline::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE_EX("SSAO Depth Threshold", float, settings_.ssao_.blurDepthThreshold_, MarkSettingsDirty, AmbientOcclusionPassSettings{}.blurDepthThreshold_, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("SSAO Normal Threshold", float, settings_.ssao_.blurNormalThreshold_, MarkSettingsDirty, AmbientOcclusionPassSettings{}.blurNormalThreshold_, AM_DEFAULT);
     URHO3D_ENUM_ATTRIBUTE_EX("SSAO Mode", settings_.ssao_.ambientOcclusionMode_, MarkSettingsDirty, ssaoModeNames, AmbientOcclusionMode::Combine, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Dynamic Resolution", bool, settings_.dynamicResolution_.enabled_, MarkSettingsDirty, DynamicResolutionSettings{}.enabled_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Dynamic Resolution Target FPS", float, settings_.dynamicResolution_.targetFrameRate_, MarkSettingsDirty, DynamicResolutionSettings{}.targetFrameRate_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Dynamic Resolution Min Scale", float, settings_.dynamicResolution_.minScale_, MarkSettingsDirty, DynamicResolutionSettings{}.minScale_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Dynamic Resolution Max Scale", float, settings_.dynamicResolution_.maxScale_, MarkSettingsDirty, DynamicResolutionSettings{}.maxScale_, AM_DEFAULT);
+    URHO3D_ATTRIBUTE_EX("Dynamic Resolution Sharpness", float, settings_.dynamicResolution_.sharpness_, MarkSettingsDirty, DynamicResolutionSettings{}.sharpness_, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Bloom", bool, settings_.bloom_.enabled_, MarkSettingsDirty, BloomPassSettings{}.enabled_, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Bloom Iterations", unsigned, settings_.bloom_.numIterations_, MarkSettingsDirty, BloomPassSettings{}.numIterations_, AM_DEFAULT);
     URHO3D_ATTRIBUTE_EX("Bloom Threshold", float, settings_.bloom_.threshold_, MarkSettingsDirty, BloomPassSettings{}.threshold_, AM_DEFAULT);
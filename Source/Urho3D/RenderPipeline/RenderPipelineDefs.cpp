@@ -75,6 +75,18 @@ void RenderPipelineSettings::AdjustToSupported(Context* context)
 #endif
 
     // OcclusionBufferSettings
+#ifdef URHO3D_COMPUTE
+    if (sceneProcessor_.hiZOcclusion_ && !renderBufferManager_.readableDepth_)
+    {
+#ifdef GL_ES_VERSION_2_0
+        sceneProcessor_.hiZOcclusion_ = false;
+#else
+        renderBufferManager_.readableDepth_ = true;
+#endif
+    }
+#else
+    sceneProcessor_.hiZOcclusion_ = false;
+#endif
 
     // BatchRendererSettings
 
@@ -90,6 +102,21 @@ void RenderPipelineSettings::AdjustToSupported(Context* context)
     if (sceneProcessor_.IsDeferredLighting() && !deferredSupported)
         sceneProcessor_.lightingMode_ = DirectLightingMode::Forward;
 
+#ifdef URHO3D_COMPUTE
+    if (!sceneProcessor_.IsDeferredLighting())
+        sceneProcessor_.tiledDeferredLighting_ = false;
+#else
+    sceneProcessor_.tiledDeferredLighting_ = false;
+#endif
+
+#if defined(DESKTOP_GRAPHICS) && !defined(GL_ES_VERSION_2_0)
+    const bool clusteredSupported = Graphics::GetRGBAFloat32Format() != 0;
+#else
+    const bool clusteredSupported = false;
+#endif
+    if (sceneProcessor_.IsClusteredLighting() && !clusteredSupported)
+        sceneProcessor_.lightingMode_ = DirectLightingMode::Forward;
+
     // ShadowMapAllocatorSettings
     if (!graphics->GetRGFloat32Format())
         shadowMapAllocator_.enableVarianceShadowMaps_ = false;
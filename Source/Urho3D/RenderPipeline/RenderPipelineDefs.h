@@ -52,8 +52,11 @@ struct CommonFrameInfo
     unsigned frameNumber_{};
     float timeStep_{};
 
+    /// Size and rectangle of rendered region. Smaller than output rectangle if rendering resolution is scaled.
     IntVector2 viewportSize_;
     IntRect viewportRect_;
+    /// Rectangle of the output region in render target.
+    IntRect outputRect_;
 
     Viewport* viewport_{};
     RenderSurface* renderTarget_{};
@@ -166,6 +169,8 @@ struct RenderBufferManagerSettings
     /// Whether the both of output color buffers should be usable with other render targets.
     /// OpenGL backbuffer color cannot do that.
     bool colorUsableWithMultipleRenderTargets_{};
+    /// Whether transient render buffers with same parameters and non-overlapping lifetimes share textures.
+    bool aliasTransientBuffers_{};
 
     /// Utility operators
     /// @{
@@ -189,7 +194,8 @@ struct RenderBufferManagerSettings
             && filteredColor_ == rhs.filteredColor_
             && stencilBuffer_ == rhs.stencilBuffer_
             && readableDepth_ == rhs.readableDepth_
-            && colorUsableWithMultipleRenderTargets_ == rhs.colorUsableWithMultipleRenderTargets_;
+            && colorUsableWithMultipleRenderTargets_ == rhs.colorUsableWithMultipleRenderTargets_
+            && aliasTransientBuffers_ == rhs.aliasTransientBuffers_;
     }
 
     bool operator!=(const RenderBufferManagerSettings& rhs) const { return !(*this == rhs); }
@@ -203,6 +209,8 @@ struct RenderBufferManagerFrameSettings
     bool readableColor_{};
     /// Whether it's should be supported to read from and write to output color buffer simultaneously.
     bool supportColorReadWrite_{};
+    /// Strength of sharpening applied when scaled rendering is upscaled to output.
+    float upscaleSharpness_{};
 };
 
 /// Traits of post-processing pass
@@ -243,6 +251,10 @@ struct RenderPipelineStats
     unsigned numShadowedLights_{};
     /// Number of occluders rendered.
     unsigned numOccluders_{};
+    /// Number of drawables within view frustum.
+    unsigned numVisibleDrawables_{};
+    /// Number of drawables rejected by frustum culling.
+    unsigned numCulledDrawables_{};
 };
 
 /// Base interface of render pipeline required by Render Pipeline classes.
@@ -269,6 +281,8 @@ struct ShadowMapRegion
     unsigned pageIndex_{};
     Texture2D* texture_;
     IntRect rect_;
+    /// Generation of atlas page at the moment of allocation. Used to validate persistent shadow maps.
+    unsigned generation_{};
 
     /// Return whether the shadow map region is not empty.
     operator bool() const { return !!texture_; }
@@ -287,6 +301,10 @@ public:
     virtual unsigned GetShadowMapSize(Light* light, unsigned numActiveSplits) const = 0;
     /// Allocate shadow map for one frame.
     virtual ShadowMapRegion AllocateTransientShadowMap(const IntVector2& size) = 0;
+    /// Allocate shadow map that keeps its contents between frames. Return empty region if not supported.
+    virtual ShadowMapRegion AllocatePersistentShadowMap(const IntVector2& /*size*/) { return {}; }
+    /// Return whether persistent shadow map is still valid and keeps its contents.
+    virtual bool IsPersistentShadowMapValid(const ShadowMapRegion& /*shadowMap*/) const { return false; }
 };
 
 struct LightProcessorCacheSettings
@@ -317,6 +335,9 @@ struct DrawableProcessorSettings
     unsigned maxVertexLights_{ 4 };
     unsigned maxPixelLights_{ 4 };
     unsigned pcfKernelSize_{ 1 };
+    /// Drawables smaller than this size on screen in pixels are not rendered in depth-only passes.
+    /// They occlude too little to pay for the extra draw.
+    float depthPrePassMinScreenSize_{};
     LightProcessorCacheSettings lightProcessorCache_;
 
     /// Utility operators
@@ -334,6 +355,7 @@ struct DrawableProcessorSettings
         maxVertexLights_ = Clamp(maxVertexLights_, 0u, 4u);
         maxPixelLights_ = Clamp(maxPixelLights_, 0u, 256u);
         pcfKernelSize_ = Clamp(pcfKernelSize_, 1u, 5u);
+        depthPrePassMinScreenSize_ = Max(depthPrePassMinScreenSize_, 0.0f);
 
         // Kernel size of 4 is not supported
         if (pcfKernelSize_ == 4)
@@ -346,6 +368,7 @@ struct DrawableProcessorSettings
             && maxVertexLights_ == rhs.maxVertexLights_
             && maxPixelLights_ == rhs.maxPixelLights_
             && pcfKernelSize_ == rhs.pcfKernelSize_
+            && depthPrePassMinScreenSize_ == rhs.depthPrePassMinScreenSize_
             && lightProcessorCache_ == rhs.lightProcessorCache_;
     }
 
@@ -356,6 +379,9 @@ struct DrawableProcessorSettings
 struct InstancingBufferSettings
 {
     bool enableInstancing_{};
+    /// Whether to keep instance data in GPU memory between frames and upload only changed instances.
+    /// Beneficial when most instances are static and the set of visible batches is stable.
+    bool persistentBuffer_{};
     unsigned firstInstancingTexCoord_{};
     unsigned numInstancingTexCoords_{};
 
@@ -377,6 +403,7 @@ struct InstancingBufferSettings
     bool operator==(const InstancingBufferSettings& rhs) const
     {
         return enableInstancing_ == rhs.enableInstancing_
+            && persistentBuffer_ == rhs.persistentBuffer_
             && firstInstancingTexCoord_ == rhs.firstInstancingTexCoord_
             && numInstancingTexCoords_ == rhs.numInstancingTexCoords_;
     }
@@ -432,6 +459,9 @@ struct ShadowMapAllocatorSettings
     int varianceShadowMapMultiSample_{ 1 };
     bool use16bitShadowMaps_{};
     unsigned shadowAtlasPageSize_{ 2048 };
+    /// Whether to keep shadow maps of spot and point lights between frames
+    /// and re-render them only when shadow casters or light change.
+    bool cacheStaticShadowMaps_{};
 
     /// Utility operators
     /// @{
@@ -454,7 +484,8 @@ struct ShadowMapAllocatorSettings
         return enableVarianceShadowMaps_ == rhs.enableVarianceShadowMaps_
             && varianceShadowMapMultiSample_ == rhs.varianceShadowMapMultiSample_
             && use16bitShadowMaps_ == rhs.use16bitShadowMaps_
-            && shadowAtlasPageSize_ == rhs.shadowAtlasPageSize_;
+            && shadowAtlasPageSize_ == rhs.shadowAtlasPageSize_
+            && cacheStaticShadowMaps_ == rhs.cacheStaticShadowMaps_;
     }
 
     bool operator!=(const ShadowMapAllocatorSettings& rhs) const { return !(*this == rhs); }
@@ -467,6 +498,9 @@ struct OcclusionBufferSettings
     unsigned maxOccluderTriangles_{ 5000 };
     unsigned occlusionBufferSize_{ 256 };
     float occluderSizeThreshold_{ 0.025f };
+    /// Whether to cull drawables against Hi-Z of the previous frame on GPU.
+    /// Requires compute shaders and readable depth.
+    bool hiZOcclusion_{};
 
     /// Utility operators
     /// @{
@@ -485,7 +519,8 @@ struct OcclusionBufferSettings
         return threadedOcclusion_ == rhs.threadedOcclusion_
             && maxOccluderTriangles_ == rhs.maxOccluderTriangles_
             && occlusionBufferSize_ == rhs.occlusionBufferSize_
-            && occluderSizeThreshold_ == rhs.occluderSizeThreshold_;
+            && occluderSizeThreshold_ == rhs.occluderSizeThreshold_
+            && hiZOcclusion_ == rhs.hiZOcclusion_;
     }
 
     bool operator!=(const OcclusionBufferSettings& rhs) const { return !(*this == rhs); }
@@ -496,7 +531,9 @@ enum class DirectLightingMode
 {
     Forward,
     DeferredBlinnPhong,
-    DeferredPBR
+    DeferredPBR,
+    /// Forward lighting with unshadowed point and spot lights binned into view frustum clusters.
+    ClusteredForward
 };
 
 enum class SpecularQuality
@@ -522,6 +559,12 @@ struct SceneProcessorSettings
     bool depthPrePass_{ false };
     bool enableShadows_{ true };
     DirectLightingMode lightingMode_{};
+    /// Whether to render forward lights without shadows, shape and ramp textures with single shader per material,
+    /// selecting light type via uniform branching instead of separate shader variations.
+    bool dynamicLightType_{ false };
+    /// Whether to evaluate unshadowed point and spot lights of deferred lighting in screen tiles by compute shader
+    /// instead of rendering them as light volumes.
+    bool tiledDeferredLighting_{ false };
     unsigned directionalShadowSize_{ 1024 };
     unsigned spotShadowSize_{ 1024 };
     unsigned pointShadowSize_{ 256 };
@@ -540,6 +583,8 @@ struct SceneProcessorSettings
         }
     }
 
+    bool IsClusteredLighting() const { return lightingMode_ == DirectLightingMode::ClusteredForward; }
+
     unsigned CalculatePipelineStateHash() const
     {
         unsigned hash = 0;
@@ -550,6 +595,7 @@ struct SceneProcessorSettings
         CombineHash(hash, MakeHash(reflectionQuality_));
         CombineHash(hash, enableShadows_);
         CombineHash(hash, MakeHash(lightingMode_));
+        CombineHash(hash, dynamicLightType_);
         return hash;
     }
 
@@ -573,6 +619,8 @@ struct SceneProcessorSettings
             && depthPrePass_ == rhs.depthPrePass_
             && enableShadows_ == rhs.enableShadows_
             && lightingMode_ == rhs.lightingMode_
+            && dynamicLightType_ == rhs.dynamicLightType_
+            && tiledDeferredLighting_ == rhs.tiledDeferredLighting_
             && directionalShadowSize_ == rhs.directionalShadowSize_
             && spotShadowSize_ == rhs.spotShadowSize_
             && pointShadowSize_ == rhs.pointShadowSize_;
@@ -636,11 +684,20 @@ struct AutoExposurePassSettings
     float minExposure_{ 1.0f };
     float maxExposure_{ 3.0f };
     float adaptRate_{ 0.6f };
+    /// Whether to evaluate luminance from histogram on compute device if supported.
+    bool luminanceHistogram_{ true };
+    /// Range of histogram percentiles used to evaluate average luminance.
+    /// @{
+    float lowPercentile_{ 0.5f };
+    float highPercentile_{ 0.95f };
+    /// @}
 
     /// Utility operators
     /// @{
     void Validate()
     {
+        lowPercentile_ = Clamp(lowPercentile_, 0.0f, 1.0f);
+        highPercentile_ = Clamp(highPercentile_, lowPercentile_, 1.0f);
     }
 
     bool operator==(const AutoExposurePassSettings& rhs) const
@@ -648,7 +705,10 @@ struct AutoExposurePassSettings
         return autoExposure_ == rhs.autoExposure_
             && minExposure_ == rhs.minExposure_
             && maxExposure_ == rhs.maxExposure_
-            && adaptRate_ == rhs.adaptRate_;
+            && adaptRate_ == rhs.adaptRate_
+            && luminanceHistogram_ == rhs.luminanceHistogram_
+            && lowPercentile_ == rhs.lowPercentile_
+            && highPercentile_ == rhs.highPercentile_;
     }
 
     bool operator!=(const AutoExposurePassSettings& rhs) const { return !(*this == rhs); }
@@ -666,6 +726,8 @@ struct AmbientOcclusionPassSettings
     bool enabled_{};
 
     unsigned downscale_{0};
+    /// Whether to evaluate SSAO with rotating sample pattern and accumulate it between frames instead of blurring.
+    bool temporal_{};
     float strength_{0.7f};
     float exponent_{1.5f};
 
@@ -691,6 +753,7 @@ struct AmbientOcclusionPassSettings
         return enabled_ == rhs.enabled_
 
             && downscale_ == rhs.downscale_
+            && temporal_ == rhs.temporal_
             && strength_ == rhs.strength_
             && exponent_ == rhs.exponent_
 
@@ -744,6 +807,41 @@ struct BloomPassSettings
     /// @}
 };
 
+/// Dynamic resolution scaling driven by frame time.
+struct DynamicResolutionSettings
+{
+    bool enabled_{};
+    /// Desired frame rate. Rendering resolution is decreased if frame takes longer.
+    float targetFrameRate_{ 60.0f };
+    /// Range of scale applied to viewport size.
+    float minScale_{ 0.5f };
+    float maxScale_{ 1.0f };
+    /// Strength of sharpening applied on upscale.
+    float sharpness_{ 0.25f };
+
+    /// Utility operators
+    /// @{
+    void Validate()
+    {
+        targetFrameRate_ = ea::max(1.0f, targetFrameRate_);
+        maxScale_ = Clamp(maxScale_, 0.1f, 1.0f);
+        minScale_ = Clamp(minScale_, 0.1f, maxScale_);
+        sharpness_ = Clamp(sharpness_, 0.0f, 1.0f);
+    }
+
+    bool operator==(const DynamicResolutionSettings& rhs) const
+    {
+        return enabled_ == rhs.enabled_
+            && targetFrameRate_ == rhs.targetFrameRate_
+            && minScale_ == rhs.minScale_
+            && maxScale_ == rhs.maxScale_
+            && sharpness_ == rhs.sharpness_;
+    }
+
+    bool operator!=(const DynamicResolutionSettings& rhs) const { return !(*this == rhs); }
+    /// @}
+};
+
 /// Post-processing antialiasing mode.
 enum class PostProcessAntialiasing
 {
@@ -758,6 +856,7 @@ struct RenderPipelineSettings : public ShaderProgramCompositorSettings
     /// Global pipeline settings
     /// @{
     bool drawDebugGeometry_{true};
+    DynamicResolutionSettings dynamicResolution_;
     /// @}
 
     /// Post-processing settings
@@ -785,12 +884,14 @@ struct RenderPipelineSettings : public ShaderProgramCompositorSettings
 
         autoExposure_.Validate();
         bloom_.Validate();
+        dynamicResolution_.Validate();
     }
 
     bool operator==(const RenderPipelineSettings& rhs) const
     {
         return ShaderProgramCompositorSettings::operator==(rhs)
             && drawDebugGeometry_ == rhs.drawDebugGeometry_
+            && dynamicResolution_ == rhs.dynamicResolution_
             && autoExposure_ == rhs.autoExposure_
             && bloom_ == rhs.bloom_
             && toneMapping_ == rhs.toneMapping_
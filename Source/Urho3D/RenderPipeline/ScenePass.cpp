@@ -57,12 +57,13 @@ void UnorderedScenePass::OnBatchesReady()
     BatchCompositor::FillSortKeys(sortedBaseBatches_, baseBatches_);
     BatchCompositor::FillSortKeys(sortedLightBatches_, lightBatches_, negativeLightBatches_);
 
-    ea::sort(sortedDeferredBatches_.begin(), sortedDeferredBatches_.end());
-    ea::sort(sortedBaseBatches_.begin(), sortedBaseBatches_.end());
+    BatchCompositor::SortBatches(sortedDeferredBatches_);
+    BatchCompositor::SortBatches(sortedBaseBatches_);
 
     const unsigned numNegativeLightBatches = negativeLightBatches_.Size();
-    ea::sort(sortedLightBatches_.begin(), sortedLightBatches_.end() - numNegativeLightBatches);
-    ea::sort(sortedLightBatches_.end() - numNegativeLightBatches, sortedLightBatches_.end());
+    const unsigned numPositiveLightBatches = sortedLightBatches_.size() - numNegativeLightBatches;
+    BatchCompositor::SortBatches({ sortedLightBatches_.data(), numPositiveLightBatches });
+    BatchCompositor::SortBatches({ sortedLightBatches_.data() + numPositiveLightBatches, numNegativeLightBatches });
 
     deferredBatchGroup_ = { sortedDeferredBatches_ };
     baseBatchGroup_ = { sortedBaseBatches_ };
@@ -119,7 +120,7 @@ void BackToFrontScenePass::OnBatchesReady()
     static const float additiveDistanceFactor = 1 - M_EPSILON;
     static const float subtractiveDistanceFactor = 1 - 2 * M_EPSILON;
 
-    // Validate distances before sorting, NaN may corrupt ea::sort
+    // Validate distances before sorting, NaN has no meaningful sort key
     for (PipelineBatchBackToFront& sortedBatch : sortedBatches_)
     {
         if (std::isfinite(sortedBatch.distance_))
@@ -137,7 +138,7 @@ void BackToFrontScenePass::OnBatchesReady()
     for (unsigned i = subtractiveLightBatchesBegin; i < subtractiveLightBatchesEnd; ++i)
         sortedBatches_[i].distance_ *= subtractiveDistanceFactor;
 
-    ea::sort(sortedBatches_.begin(), sortedBatches_.end());
+    BatchCompositor::SortBatches(sortedBatches_);
 
     if (GetFlags().Test(DrawableProcessorPassFlag::RefractionPass))
     {
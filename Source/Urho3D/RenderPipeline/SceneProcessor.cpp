@@ -24,8 +24,10 @@
 
 #include "../Core/Context.h"
 #include "../Core/IteratorRange.h"
+#include "../Graphics/ClusteredDecalSet.h"
 #include "../Graphics/Drawable.h"
 #include "../Graphics/DrawCommandQueue.h"
+#include "../Graphics/GPUProfiler.h"
 #include "../Graphics/OcclusionBuffer.h"
 #include "../Graphics/Octree.h"
 #include "../Graphics/OctreeQuery.h"
@@ -34,10 +36,13 @@
 #include "../Graphics/RenderSurface.h"
 #include "../Graphics/Technique.h"
 #include "../Graphics/Viewport.h"
+#include "../IO/Log.h"
 #include "../RenderPipeline/BatchCompositor.h"
 #include "../RenderPipeline/BatchRenderer.h"
 #include "../RenderPipeline/CameraProcessor.h"
+#include "../RenderPipeline/ClusteredLightProcessor.h"
 #include "../RenderPipeline/DrawableProcessor.h"
+#include "../RenderPipeline/HiZOcclusionCuller.h"
 #include "../RenderPipeline/InstancingBuffer.h"
 #include "../RenderPipeline/LightProcessor.h"
 #include "../RenderPipeline/PipelineBatchSortKey.h"
@@ -48,6 +53,7 @@
 #include "../RenderPipeline/SceneProcessor.h"
 #include "../Graphics/OutlineGroup.h"
 #include "../RenderPipeline/ShadowMapAllocator.h"
+#include "../RenderPipeline/TiledDeferredLightProcessor.h"
 #include "../Scene/Scene.h"
 
 #include "../DebugNew.h"
@@ -266,15 +272,48 @@ void SceneProcessor::SetSettings(const ShaderProgramCompositorSettings& settings
         drawableProcessor_->SetSettings(settings.sceneProcessor_);
         batchRenderer_->SetSettings(settings.sceneProcessor_);
         batchCompositor_->SetShadowMaterialQuality(settings.sceneProcessor_.materialQuality_);
+
+        clusteredLightProcessor_ = nullptr;
+        if (settings_.IsClusteredLighting())
+            clusteredLightProcessor_ = MakeShared<ClusteredLightProcessor>(context_);
+
+#ifdef URHO3D_COMPUTE
+        hiZOcclusionCuller_ = nullptr;
+        if (settings_.hiZOcclusion_)
+        {
+            hiZOcclusionCuller_ = MakeShared<HiZOcclusionCuller>(context_);
+            if (!hiZOcclusionCuller_->IsSupported())
+            {
+                URHO3D_LOGWARNING("Hi-Z occlusion culling is not supported");
+                hiZOcclusionCuller_ = nullptr;
+            }
+        }
+
+        tiledDeferredLightProcessor_ = nullptr;
+        if (settings_.tiledDeferredLighting_)
+        {
+            tiledDeferredLightProcessor_ = MakeShared<TiledDeferredLightProcessor>(context_);
+            if (!tiledDeferredLightProcessor_->IsSupported())
+            {
+                URHO3D_LOGWARNING("Tiled deferred lighting is not supported");
+                tiledDeferredLightProcessor_ = nullptr;
+            }
+        }
+#endif
     }
 }
 
 void SceneProcessor::Update()
 {
+    // Views sharing explicit cull camera (e.g. stereo eyes or mirrored split-screen) reuse the first query this frame
+    Camera* sharedCullCamera = frameInfo_.viewport_->GetCullCamera();
+    const ea::vector<Drawable*>* cachedDrawables = sharedCullCamera
+        ? frameInfo_.octree_->GetCachedVisibleDrawables(frameInfo_.frameNumber_, sharedCullCamera) : nullptr;
+
     // Collect occluders
     currentOcclusionBuffer_ = nullptr;
     const Frustum& frustum = frameInfo_.camera_->GetFrustum();
-    if (settings_.maxOccluderTriangles_ > 0)
+    if (settings_.maxOccluderTriangles_ > 0 && !cachedDrawables)
     {
         URHO3D_PROFILE("ProcessOccluders");
 
@@ -297,24 +336,72 @@ void SceneProcessor::Update()
     }
 
     // Collect visible drawables
-    if (currentOcclusionBuffer_)
+    if (cachedDrawables)
+        drawables_ = *cachedDrawables;
+    else
     {
         URHO3D_PROFILE("QueryVisibleDrawables");
-        OccludedFrustumOctreeQuery query(drawables_, frustum,
-            currentOcclusionBuffer_, DRAWABLE_GEOMETRY | DRAWABLE_LIGHT, frameInfo_.camera_->GetViewMask());
-        frameInfo_.octree_->GetDrawables(query);
+        auto workQueue = GetSubsystem<WorkQueue>();
+        const DrawableFlags drawableFlags = DRAWABLE_GEOMETRY | DRAWABLE_LIGHT;
+        const unsigned viewMask = frameInfo_.camera_->GetViewMask();
+        if (currentOcclusionBuffer_)
+        {
+            OcclusionBuffer* occlusionBuffer = currentOcclusionBuffer_;
+            frameInfo_.octree_->GetDrawablesParallel<OccludedFrustumOctreeQuery>(
+                workQueue, drawablesTemp_, frustum, occlusionBuffer, drawableFlags, viewMask);
+        }
+        else
+        {
+            frameInfo_.octree_->GetDrawablesParallel<PackedFrustumOctreeQuery>(
+                workQueue, drawablesTemp_, frustum, drawableFlags, viewMask);
+        }
+        drawablesTemp_.CopyTo(drawables_);
+
+        if (sharedCullCamera)
+            frameInfo_.octree_->SetCachedVisibleDrawables(frameInfo_.frameNumber_, sharedCullCamera, drawables_);
     }
-    else
+
+#ifdef URHO3D_COMPUTE
+    // Cull drawables occluded at the previous frame, keep all candidates to test them again
+    hiZOccludees_.clear();
+    if (hiZOcclusionCuller_)
     {
-        URHO3D_PROFILE("QueryVisibleDrawables");
-        FrustumOctreeQuery drawableQuery(drawables_, frustum,
-            DRAWABLE_GEOMETRY | DRAWABLE_LIGHT, frameInfo_.camera_->GetViewMask());
-        frameInfo_.octree_->GetDrawables(drawableQuery);
+        URHO3D_PROFILE("ApplyHiZOcclusion");
+
+        hiZOcclusionCuller_->ReadBackResults();
+        const auto isOccludee = [](Drawable* drawable)
+        { return drawable->GetDrawableFlags() == DRAWABLE_GEOMETRY && drawable->IsOccludee(); };
+        for (Drawable* drawable : drawables_)
+        {
+            if (isOccludee(drawable))
+                hiZOccludees_.push_back(drawable);
+        }
+
+        if (hiZOcclusionCuller_->GetNumOccludedDrawables() > 0)
+        {
+            const auto isOccluded = [&](Drawable* drawable)
+            { return isOccludee(drawable) && !hiZOcclusionCuller_->IsVisible(drawable); };
+            drawables_.erase(ea::remove_if(drawables_.begin(), drawables_.end(), isOccluded), drawables_.end());
+        }
     }
+#endif
 
     // Process drawables
     drawableProcessor_->ProcessVisibleDrawables(drawables_, currentOcclusionBuffer_);
     drawableProcessor_->ProcessLights(this);
+    if (clusteredLightProcessor_)
+    {
+        const auto decalSet = frameInfo_.scene_->GetComponent<ClusteredDecalSet>();
+        clusteredLightProcessor_->Update(frameInfo_.camera_, drawableProcessor_, decalSet, settings_.linearSpaceLighting_);
+    }
+#ifdef URHO3D_COMPUTE
+    if (tiledDeferredLightProcessor_)
+    {
+        const bool physicalLighting = settings_.lightingMode_ == DirectLightingMode::DeferredPBR;
+        tiledDeferredLightProcessor_->Update(
+            frameInfo_.camera_, drawableProcessor_, physicalLighting, settings_.linearSpaceLighting_);
+    }
+#endif
     drawableProcessor_->ProcessForwardLighting();
 
     batchCompositor_->ComposeSceneBatches();
@@ -337,6 +424,9 @@ void SceneProcessor::PrepareInstancingBuffer()
 
     for (LightProcessor* sceneLight : visibleLights)
     {
+        if (sceneLight->IsShadowMapCached())
+            continue;
+
         for (ShadowSplitProcessor& split : sceneLight->GetMutableSplits())
             batchRenderer_->PrepareInstancingBuffer(split.GetMutableShadowBatches());
     }
@@ -361,10 +451,15 @@ void SceneProcessor::RenderShadowMaps()
         return;
 
     URHO3D_PROFILE("RenderShadowMaps");
+    GPUProfilerScope gpuScope(GetSubsystem<GPUProfiler>(), "ShadowMaps");
 
     const auto& lightsByShadowMap = drawableProcessor_->GetLightProcessorsByShadowMap();
     for (LightProcessor* sceneLight : lightsByShadowMap)
     {
+        // Cached shadow map is already up to date
+        if (sceneLight->IsShadowMapCached())
+            continue;
+
         for (const ShadowSplitProcessor& split : sceneLight->GetSplits())
         {
             if (RenderPipelineDebugger::IsSnapshotInProgress(debugger_))
@@ -407,6 +502,7 @@ void SceneProcessor::RenderLightVolumeBatches(ea::string_view debugName, Camera*
     if (RenderPipelineDebugger::IsSnapshotInProgress(debugger_))
         debugger_->BeginPass(debugName);
 
+    GPUProfilerScope gpuScope(GetSubsystem<GPUProfiler>(), debugName);
     drawQueue_->Reset();
 
     BatchRenderingContext ctx{ *drawQueue_, *camera };
@@ -429,6 +525,7 @@ void SceneProcessor::RenderBatchesInternal(ea::string_view debugName, Camera* ca
     if (RenderPipelineDebugger::IsSnapshotInProgress(debugger_))
         debugger_->BeginPass(debugName);
 
+    GPUProfilerScope gpuScope(GetSubsystem<GPUProfiler>(), debugName);
     drawQueue_->Reset();
 
     BatchRenderingContext ctx{ *drawQueue_, *camera };
@@ -455,6 +552,32 @@ BatchCompositorPass* SceneProcessor::GetUserPass(Object* pass) const
     return static_cast<BatchCompositorPass*>(pass);
 }
 
+void SceneProcessor::TestHiZOcclusion(Texture2D* depthTexture)
+{
+#ifdef URHO3D_COMPUTE
+    if (!hiZOcclusionCuller_ || hiZOccludees_.empty())
+        return;
+
+    URHO3D_PROFILE("TestHiZOcclusion");
+    hiZOcclusionCuller_->TestDrawables(depthTexture, frameInfo_.camera_, hiZOccludees_);
+#endif
+}
+
+Texture2D* SceneProcessor::RenderTiledDeferredLights(Texture2D* depthTexture, const IntRect& depthRect,
+    Texture2D* albedoTexture, Texture2D* specularTexture, Texture2D* normalTexture)
+{
+#ifdef URHO3D_COMPUTE
+    if (!tiledDeferredLightProcessor_ || tiledDeferredLightProcessor_->GetNumLights() == 0)
+        return nullptr;
+
+    URHO3D_PROFILE("RenderTiledDeferredLights");
+    return tiledDeferredLightProcessor_->Render(
+        frameInfo_.camera_, depthTexture, depthRect, albedoTexture, specularTexture, normalTexture);
+#else
+    return nullptr;
+#endif
+}
+
 void SceneProcessor::OnUpdateBegin(const CommonFrameInfo& frameInfo)
 {
     frameInfo_.frameNumber_ = frameInfo.frameNumber_;
@@ -515,6 +638,16 @@ ShadowMapRegion SceneProcessor::AllocateTransientShadowMap(const IntVector2& siz
     return shadowMapAllocator_->AllocateShadowMap(size);
 }
 
+ShadowMapRegion SceneProcessor::AllocatePersistentShadowMap(const IntVector2& size)
+{
+    return shadowMapAllocator_->AllocatePersistentShadowMap(size);
+}
+
+bool SceneProcessor::IsPersistentShadowMapValid(const ShadowMapRegion& shadowMap) const
+{
+    return shadowMapAllocator_->IsPersistentShadowMapValid(shadowMap);
+}
+
 void SceneProcessor::DrawOccluders()
 {
     const auto& activeOccluders = drawableProcessor_->GetOccluders();
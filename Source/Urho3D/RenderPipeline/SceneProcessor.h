@@ -31,15 +31,19 @@ namespace Urho3D
 class BatchCompositor;
 class BatchRenderer;
 class CameraProcessor;
+class ClusteredLightProcessor;
 class Drawable;
 class DrawableProcessor;
 class DrawCommandQueue;
+class HiZOcclusionCuller;
 class InstancingBuffer;
 class PipelineStateBuilder;
 class RenderPipelineInterface;
 class RenderSurface;
 class ScenePass;
 class ShadowMapAllocator;
+class Texture2D;
+class TiledDeferredLightProcessor;
 class Viewport;
 struct ShaderParameterDesc;
 struct ShaderResourceDesc;
@@ -87,6 +91,12 @@ public:
         ea::span<const ShaderResourceDesc> globalResources = {}, ea::span<const ShaderParameterDesc> cameraParameters = {});
     void RenderLightVolumeBatches(ea::string_view debugName, Camera* camera,
         ea::span<const ShaderResourceDesc> globalResources, ea::span<const ShaderParameterDesc> cameraParameters);
+    /// Test visible drawables against depth of opaque geometry for the next frame, if Hi-Z occlusion is enabled.
+    void TestHiZOcclusion(Texture2D* depthTexture);
+    /// Evaluate tiled deferred lights for geometry buffer, if tiled deferred lighting is enabled.
+    /// Return texture with accumulated lighting of the viewport or null if there are no tiled lights.
+    Texture2D* RenderTiledDeferredLights(Texture2D* depthTexture, const IntRect& depthRect,
+        Texture2D* albedoTexture, Texture2D* specularTexture, Texture2D* normalTexture);
     /// @}
 
     /// Getters
@@ -103,6 +113,8 @@ public:
     DrawableProcessor* GetDrawableProcessor() const { return drawableProcessor_; }
     BatchCompositor* GetBatchCompositor() const { return batchCompositor_; }
     BatchRenderer* GetBatchRenderer() const { return batchRenderer_; }
+    /// Return clustered light processor. Null unless clustered forward lighting is enabled.
+    ClusteredLightProcessor* GetClusteredLightProcessor() const { return clusteredLightProcessor_; }
     /// @}
 
 private:
@@ -118,6 +130,8 @@ private:
     bool IsLightShadowed(Light* light) override;
     unsigned GetShadowMapSize(Light* light, unsigned numActiveSplits) const override;
     ShadowMapRegion AllocateTransientShadowMap(const IntVector2& size) override;
+    ShadowMapRegion AllocatePersistentShadowMap(const IntVector2& size) override;
+    bool IsPersistentShadowMapValid(const ShadowMapRegion& shadowMap) const override;
     /// @}
 
     void DrawOccluders();
@@ -144,6 +158,11 @@ private:
     SharedPtr<BatchCompositor> batchCompositor_;
     SharedPtr<BatchRenderer> batchRenderer_;
     SharedPtr<OcclusionBuffer> occlusionBuffer_;
+    SharedPtr<ClusteredLightProcessor> clusteredLightProcessor_;
+#ifdef URHO3D_COMPUTE
+    SharedPtr<HiZOcclusionCuller> hiZOcclusionCuller_;
+    SharedPtr<TiledDeferredLightProcessor> tiledDeferredLightProcessor_;
+#endif
     BatchStateCacheCallback* batchStateCacheCallback_{};
     /// @}
 
@@ -156,6 +175,8 @@ private:
     OcclusionBuffer* currentOcclusionBuffer_{};
     ea::vector<Drawable*> occluders_;
     ea::vector<Drawable*> drawables_;
+    WorkQueueVector<Drawable*> drawablesTemp_;
+    ea::vector<Drawable*> hiZOccludees_;
 };
 
 }
@@ -50,6 +50,9 @@ namespace ShaderConsts
     URHO3D_SHADER_CONST(Camera, FogParams);
     URHO3D_SHADER_CONST(Camera, FogColor);
     URHO3D_SHADER_CONST(Camera, NormalOffsetScale);
+    URHO3D_SHADER_CONST(Camera, LightClusterViewProj);
+    URHO3D_SHADER_CONST(Camera, LightClusterViewZ);
+    URHO3D_SHADER_CONST(Camera, LightClusterDepthParams);
 
     URHO3D_SHADER_CONST(Zone, CubemapCenter0);
     URHO3D_SHADER_CONST(Zone, CubemapCenter1);
@@ -95,8 +95,12 @@ void ShaderProgramCompositor::ProcessUserBatch(ShaderProgramDesc& result, Drawab
     else if (isDepthOnly)
         result.AddCommonShaderDefines("URHO3D_NUM_RENDER_TARGETS=0");
 
+    // Clustered decals modify albedo in both ambient and additive light passes
+    if (settings_.sceneProcessor_.IsClusteredLighting() && !isDeferred && !isDepthOnly)
+        result.AddCommonShaderDefines("URHO3D_CLUSTERED_DECALS");
+
     if (light)
-        ApplyPixelLightPixelAndCommonDefines(result, light, hasShadow, material->GetSpecular());
+        ApplyPixelLightPixelAndCommonDefines(result, light, hasShadow, material->GetSpecular(), true);
 }
 
 void ShaderProgramCompositor::ProcessShadowBatch(ShaderProgramDesc& result,
@@ -116,7 +120,7 @@ void ShaderProgramCompositor::ProcessLightVolumeBatch(ShaderProgramDesc& result,
     SetupShaders(result, pass);
     ApplyCommonDefines(result, flags, pass);
     ApplyGeometryVertexDefines(result, flags, geometry, geometryType);
-    ApplyPixelLightPixelAndCommonDefines(result, light, hasShadow, true);
+    ApplyPixelLightPixelAndCommonDefines(result, light, hasShadow, true, false);
     ApplyDefinesForLightVolumePass(result);
 }
 
@@ -193,10 +197,18 @@ void ShaderProgramCompositor::ApplyGeometryVertexDefines(ShaderProgramDesc& resu
         result.AddShaderDefines(VS, geometryDefines[geometryTypeIndex]);
     else
         result.AddShaderDefines(VS, Format("URHO3D_GEOMETRY_CUSTOM={} ", geometryTypeIndex));
+
+    // Billboards may be stored one per instance and expanded into quads in vertex shader
+    if (geometryType == GEOM_BILLBOARD)
+    {
+        VertexBuffer* vertexBuffer = geometry->GetVertexBuffer(0);
+        if (vertexBuffer && !vertexBuffer->GetElements().empty() && vertexBuffer->GetElements()[0].perInstance_)
+            result.AddShaderDefines(VS, "URHO3D_BILLBOARD_PER_INSTANCE");
+    }
 }
 
 void ShaderProgramCompositor::ApplyPixelLightPixelAndCommonDefines(ShaderProgramDesc& result,
-    Light* light, bool hasShadow, bool materialHasSpecular) const
+    Light* light, bool hasShadow, bool materialHasSpecular, bool allowDynamicLightType) const
 {
     if (light->GetShapeTexture())
         result.AddCommonShaderDefines("URHO3D_LIGHT_CUSTOM_SHAPE");
@@ -204,6 +216,14 @@ void ShaderProgramCompositor::ApplyPixelLightPixelAndCommonDefines(ShaderProgram
     if (light->GetRampTexture())
         result.AddShaderDefines(PS, "URHO3D_LIGHT_CUSTOM_RAMP");
 
+    // Simple lights of all types share one shader that selects light type from uniforms
+    const bool isSimpleLight = !hasShadow && !light->GetShapeTexture() && !light->GetRampTexture();
+    if (allowDynamicLightType && isSimpleLight && settings_.sceneProcessor_.dynamicLightType_)
+    {
+        result.AddCommonShaderDefines("URHO3D_LIGHT_DYNAMIC_TYPE");
+        return;
+    }
+
     static const ea::string lightTypeDefines[] = {
         "URHO3D_LIGHT_DIRECTIONAL ",
         "URHO3D_LIGHT_SPOT ",
@@ -230,8 +250,12 @@ void ShaderProgramCompositor::ApplyLayoutVertexAndCommonDefinesForUserPass(
 {
     if (vertexBuffer->HasElement(SEM_NORMAL))
         result.AddShaderDefines(VS, "URHO3D_VERTEX_HAS_NORMAL");
+    if (vertexBuffer->HasElement(TYPE_SHORT2_NORM, SEM_NORMAL))
+        result.AddShaderDefines(VS, "URHO3D_VERTEX_NORMAL_OCTAHEDRAL");
     if (vertexBuffer->HasElement(SEM_TANGENT))
         result.AddShaderDefines(VS, "URHO3D_VERTEX_HAS_TANGENT");
+    if (vertexBuffer->HasElement(TYPE_UINT_10_10_10_2_NORM, SEM_TANGENT))
+        result.AddShaderDefines(VS, "URHO3D_VERTEX_TANGENT_PACKED");
     if (vertexBuffer->HasElement(SEM_TEXCOORD, 0))
         result.AddShaderDefines(VS, "URHO3D_VERTEX_HAS_TEXCOORD0");
     if (vertexBuffer->HasElement(SEM_TEXCOORD, 1))
@@ -280,8 +304,13 @@ void ShaderProgramCompositor::ApplyAmbientLightingVertexAndCommonDefinesForUserP
     result.AddCommonShaderDefines("URHO3D_AMBIENT_PASS");
     if (isGeometryBufferPass)
         result.AddCommonShaderDefines("URHO3D_GBUFFER_PASS");
-    else if (settings_.sceneProcessor_.maxVertexLights_ > 0)
-        result.AddCommonShaderDefines(Format("URHO3D_NUM_VERTEX_LIGHTS={}", settings_.sceneProcessor_.maxVertexLights_));
+    else
+    {
+        if (settings_.sceneProcessor_.maxVertexLights_ > 0)
+            result.AddCommonShaderDefines(Format("URHO3D_NUM_VERTEX_LIGHTS={}", settings_.sceneProcessor_.maxVertexLights_));
+        if (settings_.sceneProcessor_.IsClusteredLighting())
+            result.AddCommonShaderDefines("URHO3D_CLUSTERED_LIGHTS");
+    }
 
     if (drawable->GetGlobalIlluminationType() == GlobalIlluminationType::UseLightMap)
         result.AddCommonShaderDefines("URHO3D_HAS_LIGHTMAP");
@@ -307,6 +336,8 @@ void ShaderProgramCompositor::ApplyDefinesForShadowPass(ShaderProgramDesc& resul
 {
     if (vertexBuffer->HasElement(SEM_NORMAL))
         result.AddShaderDefines(VS, "URHO3D_VERTEX_HAS_NORMAL");
+    if (vertexBuffer->HasElement(TYPE_SHORT2_NORM, SEM_NORMAL))
+        result.AddShaderDefines(VS, "URHO3D_VERTEX_NORMAL_OCTAHEDRAL");
 
     if (light->GetShadowBias().normalOffset_ > 0.0)
         result.AddShaderDefines(VS, "URHO3D_SHADOW_NORMAL_OFFSET");
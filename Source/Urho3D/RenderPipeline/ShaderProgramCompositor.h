@@ -110,7 +110,7 @@ private:
     void ApplyGeometryVertexDefines(ShaderProgramDesc& result,
         DrawableProcessorPassFlags flags, Geometry* geometry, GeometryType geometryType) const;
     void ApplyPixelLightPixelAndCommonDefines(ShaderProgramDesc& result,
-        Light* light, bool hasShadow, bool materialHasSpecular) const;
+        Light* light, bool hasShadow, bool materialHasSpecular, bool allowDynamicLightType) const;
     /// @}
 
     bool IsInstancingUsed(DrawableProcessorPassFlags flags, Geometry* geometry, GeometryType geometryType) const;
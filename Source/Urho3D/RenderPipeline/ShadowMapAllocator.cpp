@@ -63,6 +63,8 @@ void ShadowMapAllocator::SetSettings(const ShadowMapAllocatorSettings& settings)
 
         dummyColorTexture_ = nullptr;
         pages_.clear();
+        numPersistentPages_ = 0;
+        resetPersistentPages_ = false;
     }
 }
 
@@ -84,8 +86,23 @@ void ShadowMapAllocator::ResetAllShadowMaps()
 {
     for (AtlasPage& element : pages_)
     {
-        element.areaAllocator_.Reset(shadowAtlasPageSize_.x_, shadowAtlasPageSize_.y_, shadowAtlasPageSize_.x_, shadowAtlasPageSize_.y_);
-        element.clearBeforeRendering_ = false;
+        // Persistent pages are reset only if they are out of space or their contents are lost
+        if (element.persistent_ && !resetPersistentPages_ && !element.texture_->IsDataLost())
+            continue;
+
+        ResetPage(element);
+    }
+    resetPersistentPages_ = false;
+}
+
+void ShadowMapAllocator::ResetPage(AtlasPage& page)
+{
+    page.areaAllocator_.Reset(shadowAtlasPageSize_.x_, shadowAtlasPageSize_.y_, shadowAtlasPageSize_.x_, shadowAtlasPageSize_.y_);
+    page.clearBeforeRendering_ = false;
+    if (page.persistent_)
+    {
+        page.texture_->ClearDataLost();
+        ++page.generation_;
     }
 }
 
@@ -98,15 +115,58 @@ ShadowMapRegion ShadowMapAllocator::AllocateShadowMap(const IntVector2& size)
 
     for (AtlasPage& element : pages_)
     {
+        if (element.persistent_)
+            continue;
+
         const ShadowMapRegion shadowMap = element.AllocateRegion(clampedSize);
         if (shadowMap)
             return shadowMap;
     }
 
-    AllocatePage();
+    AllocatePage(false);
     return pages_.back().AllocateRegion(clampedSize);
 }
 
+ShadowMapRegion ShadowMapAllocator::AllocatePersistentShadowMap(const IntVector2& size)
+{
+    if (!settings_.cacheStaticShadowMaps_ || !settings_.shadowAtlasPageSize_ || !shadowMapFormat_)
+        return {};
+
+    // Don't cache shadow maps that would take whole page
+    if (size.x_ > shadowAtlasPageSize_.x_ / 2 || size.y_ > shadowAtlasPageSize_.y_ / 2)
+        return {};
+
+    for (AtlasPage& element : pages_)
+    {
+        if (!element.persistent_)
+            continue;
+
+        const ShadowMapRegion shadowMap = element.AllocateRegion(size);
+        if (shadowMap)
+            return shadowMap;
+    }
+
+    if (numPersistentPages_ < MaxPersistentPages)
+    {
+        AllocatePage(true);
+        return pages_.back().AllocateRegion(size);
+    }
+
+    // Persistent pages are fragmented or occupied by stale shadow maps, start over at the next frame.
+    // Don't reset now because regions allocated during this frame are still in use.
+    resetPersistentPages_ = true;
+    return {};
+}
+
+bool ShadowMapAllocator::IsPersistentShadowMapValid(const ShadowMapRegion& shadowMap) const
+{
+    if (!shadowMap || shadowMap.pageIndex_ >= pages_.size())
+        return false;
+
+    const AtlasPage& page = pages_[shadowMap.pageIndex_];
+    return page.persistent_ && page.texture_ == shadowMap.texture_ && page.generation_ == shadowMap.generation_;
+}
+
 bool ShadowMapAllocator::BeginShadowMapRendering(const ShadowMapRegion& shadowMap)
 {
     if (!shadowMap || shadowMap.pageIndex_ >= pages_.size())
@@ -135,8 +195,17 @@ bool ShadowMapAllocator::BeginShadowMapRendering(const ShadowMapRegion& shadowMa
     for (unsigned i = 1; i < MAX_RENDERTARGETS; ++i)
         graphics_->SetRenderTarget(i, (RenderSurface*) nullptr);
 
+    // Clear only the region of persistent page, other regions keep cached shadow maps
+    if (poolElement.persistent_)
+    {
+        graphics_->SetViewport(shadowMap.rect_);
+        ClearTargetFlags clearFlags = CLEAR_DEPTH;
+        if (settings_.enableVarianceShadowMaps_ || dummyColorTexture_)
+            clearFlags |= CLEAR_COLOR;
+        graphics_->Clear(clearFlags, Color::WHITE);
+    }
     // Clear whole texture if needed
-    if (poolElement.clearBeforeRendering_)
+    else if (poolElement.clearBeforeRendering_)
     {
         poolElement.clearBeforeRendering_ = false;
 
@@ -162,6 +231,7 @@ ShadowMapRegion ShadowMapAllocator::AtlasPage::AllocateRegion(const IntVector2&
         shadowMap.pageIndex_ = index_;
         shadowMap.texture_ = texture_;
         shadowMap.rect_ = IntRect(offset, offset + size);
+        shadowMap.generation_ = generation_;
 
         // Mark shadow map as used
         clearBeforeRendering_ = true;
@@ -170,7 +240,7 @@ ShadowMapRegion ShadowMapAllocator::AtlasPage::AllocateRegion(const IntVector2&
     return {};
 }
 
-void ShadowMapAllocator::AllocatePage()
+void ShadowMapAllocator::AllocatePage(bool persistent)
 {
     const bool isDepthTexture = !settings_.enableVarianceShadowMaps_;
     const TextureUsage textureUsage = isDepthTexture ? TEXTURE_DEPTHSTENCIL : TEXTURE_RENDERTARGET;
@@ -208,7 +278,10 @@ void ShadowMapAllocator::AllocatePage()
     AtlasPage& element = pages_.emplace_back();
     element.index_ = pages_.size() - 1;
     element.texture_ = newShadowMap;
+    element.persistent_ = persistent;
     element.areaAllocator_.Reset(shadowAtlasPageSize_.x_, shadowAtlasPageSize_.y_, shadowAtlasPageSize_.x_, shadowAtlasPageSize_.y_);
+    if (persistent)
+        ++numPersistentPages_;
 }
 
 }
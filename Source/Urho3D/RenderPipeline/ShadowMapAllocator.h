@@ -42,6 +42,9 @@ class URHO3D_API ShadowMapAllocator : public Object
     URHO3D_OBJECT(ShadowMapAllocator, Object);
 
 public:
+    /// Max number of atlas pages used for persistent shadow maps.
+    static const unsigned MaxPersistentPages = 2;
+
     explicit ShadowMapAllocator(Context* context);
     void SetSettings(const ShadowMapAllocatorSettings& settings);
 
@@ -49,6 +52,11 @@ public:
     void ResetAllShadowMaps();
     /// Allocate shadow map of given size. It is better to allocate from bigger to smaller sizes.
     ShadowMapRegion AllocateShadowMap(const IntVector2& size);
+    /// Allocate shadow map of given size that keeps its contents between frames.
+    /// Returns empty region if shadow map caching is disabled or persistent atlas is full.
+    ShadowMapRegion AllocatePersistentShadowMap(const IntVector2& size);
+    /// Return whether persistent shadow map is not reset yet.
+    bool IsPersistentShadowMapValid(const ShadowMapRegion& shadowMap) const;
     /// Begin shadow map rendering. Clears shadow map if necessary.
     bool BeginShadowMapRendering(const ShadowMapRegion& shadowMap);
 
@@ -61,13 +69,18 @@ private:
         SharedPtr<Texture2D> texture_;
         AreaAllocator areaAllocator_;
         bool clearBeforeRendering_{};
+        /// Persistent pages are not reset every frame and are cleared region by region.
+        bool persistent_{};
+        /// Incremented whenever persistent page is reset.
+        unsigned generation_{};
 
         /// Allocate shadow map.
         ShadowMapRegion AllocateRegion(const IntVector2& size);
     };
 
     void CacheSettings();
-    void AllocatePage();
+    void AllocatePage(bool persistent);
+    void ResetPage(AtlasPage& page);
 
     /// External dependencies
     /// @{
@@ -85,6 +98,9 @@ private:
     /// Dummy color map for workaround, if needed.
     SharedPtr<Texture2D> dummyColorTexture_;
     ea::vector<AtlasPage> pages_;
+    unsigned numPersistentPages_{};
+    /// Whether to reset persistent pages at the next frame because they are out of space.
+    bool resetPersistentPages_{};
 };
 
 }
@@ -138,8 +138,7 @@ void ShadowSplitProcessor::InitializePoint(CubeMapFace face)
     shadowCamera_->SetZoom(1.0f);
 }
 
-void ShadowSplitProcessor::ProcessDirectionalShadowCasters(
-    DrawableProcessor* drawableProcessor, ea::vector<Drawable*>& shadowCastersBuffer)
+void ShadowSplitProcessor::ProcessDirectionalShadowCasters(DrawableProcessor* drawableProcessor)
 {
     shadowCasters_.clear();
     unsortedShadowBatches_.clear();
@@ -155,11 +154,11 @@ void ShadowSplitProcessor::ProcessDirectionalShadowCasters(
     Octree* octree = frameInfo.octree_;
 
     DirectionalLightShadowCasterQuery query(
-        shadowCastersBuffer, shadowCamera_->GetFrustum(), DRAWABLE_GEOMETRY, light_, cullCamera->GetViewMask());
+        shadowCasterCandidates_, shadowCamera_->GetFrustum(), DRAWABLE_GEOMETRY, light_, cullCamera->GetViewMask());
     octree->GetDrawables(query);
 
     // Preprocess shadow casters
-    drawableProcessor->PreprocessShadowCasters(shadowCasters_, shadowCastersBuffer, cascadeZRange_, light_, shadowCamera_);
+    drawableProcessor->PreprocessShadowCasters(shadowCasters_, shadowCasterCandidates_, cascadeZRange_, light_, shadowCamera_);
 }
 
 void ShadowSplitProcessor::ProcessSpotShadowCasters(
@@ -362,7 +361,7 @@ Matrix4 ShadowSplitProcessor::GetWorldToShadowSpaceMatrix(float subPixelOffset)
 void ShadowSplitProcessor::FinalizeShadowBatches()
 {
     BatchCompositor::FillSortKeys(sortedShadowBatches_, unsortedShadowBatches_);
-    ea::sort(sortedShadowBatches_.begin(), sortedShadowBatches_.end());
+    BatchCompositor::SortBatches(sortedShadowBatches_);
     shadowBatches_ = { sortedShadowBatches_,
         BatchRenderFlag::EnableInstancingForStaticGeometry | BatchRenderFlag::DisableColorOutput };
 }
@@ -59,7 +59,7 @@ public:
 
     /// Process shadow casters
     /// @{
-    void ProcessDirectionalShadowCasters(DrawableProcessor* drawableProcessor, ea::vector<Drawable*>& shadowCastersBuffer);
+    void ProcessDirectionalShadowCasters(DrawableProcessor* drawableProcessor);
     void ProcessSpotShadowCasters(DrawableProcessor* drawableProcessor, const ea::vector<Drawable*>& shadowCasterCandidates);
     void ProcessPointShadowCasters(DrawableProcessor* drawableProcessor, const ea::vector<Drawable*>& shadowCasterCandidates);
     /// @}
@@ -119,6 +119,8 @@ private:
     FloatRange cascadeZRange_{};
     FloatRange focusedCascadeZRange_{};
     ea::vector<Drawable*> shadowCasters_;
+    /// Temporary buffer for directional light shadow caster query.
+    ea::vector<Drawable*> shadowCasterCandidates_;
 
     ShadowMapRegion shadowMap_;
     float shadowMapWorldSpaceTexelSize_{};
@@ -0,0 +1,215 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Graphics/Camera.h"
+#include "../Graphics/ComputeBuffer.h"
+#include "../Graphics/ComputeDevice.h"
+#include "../Graphics/Graphics.h"
+#include "../Graphics/Light.h"
+#include "../Graphics/Texture2D.h"
+#include "../IO/Log.h"
+#include "../RenderPipeline/DrawableProcessor.h"
+#include "../RenderPipeline/LightProcessor.h"
+#include "../RenderPipeline/TiledDeferredLightProcessor.h"
+
+#include "../DebugNew.h"
+
+#if defined(URHO3D_COMPUTE)
+
+namespace Urho3D
+{
+
+namespace
+{
+
+const char* lightingShaderName = "v2/C_TiledDeferredLighting";
+
+unsigned DivideRoundUp(unsigned value, unsigned divisor)
+{
+    return (value + divisor - 1) / divisor;
+}
+
+}
+
+TiledDeferredLightProcessor::TiledDeferredLightProcessor(Context* context)
+    : Object(context)
+    , computeDevice_(GetSubsystem<ComputeDevice>())
+    , parametersBuffer_(MakeShared<ComputeBuffer>(context))
+    , lightDataBuffer_(MakeShared<ComputeBuffer>(context))
+    , lightData_(MaxLights * NumDataRowsPerLight)
+{
+}
+
+TiledDeferredLightProcessor::~TiledDeferredLightProcessor()
+{
+}
+
+bool TiledDeferredLightProcessor::IsSupported() const
+{
+    if (!computeDevice_ || !computeDevice_->IsSupported() || !Graphics::GetRGBAFloat16Format())
+        return false;
+
+    auto graphics = GetSubsystem<Graphics>();
+    return graphics->GetShader(CS, lightingShaderName) != nullptr;
+}
+
+bool TiledDeferredLightProcessor::IsTiledLight(const LightProcessor* lightProcessor)
+{
+    const Light* light = lightProcessor->GetLight();
+    const LightType lightType = light->GetLightType();
+    if (lightType != LIGHT_POINT && lightType != LIGHT_SPOT)
+        return false;
+
+    const CookedLightParams& params = lightProcessor->GetParams();
+    return !lightProcessor->HasShadow() && !light->IsNegative()
+        && !params.lightRamp_ && !params.lightShape_
+        && params.volumetricRadius_ <= 0.0f && params.volumetricLength_ <= 0.0f;
+}
+
+void TiledDeferredLightProcessor::Update(Camera* camera, DrawableProcessor* drawableProcessor,
+    bool physicalLighting, bool linearSpaceLighting)
+{
+    URHO3D_PROFILE("UpdateTiledDeferredLights");
+
+    view_ = camera->GetView();
+    physicalLighting_ = physicalLighting;
+
+    numLights_ = 0;
+    for (LightProcessor* lightProcessor : drawableProcessor->GetLightProcessors())
+    {
+        if (numLights_ >= MaxLights)
+            break;
+        if (!lightProcessor->HasLitGeometries() || !IsTiledLight(lightProcessor))
+            continue;
+
+        const CookedLightParams& params = lightProcessor->GetParams();
+        const float range = lightProcessor->GetLight()->GetRange();
+
+        Vector4* lightData = &lightData_[numLights_ * NumDataRowsPerLight];
+        lightData[0] = Vector4{ view_ * params.position_, params.inverseRange_ };
+        lightData[1] = Vector4{ params.GetColor(linearSpaceLighting), params.effectiveSpecularIntensity_ };
+        lightData[2] = Vector4{ view_ * Vector4{ params.direction_, 0.0f }, params.spotCutoff_ };
+        lightData[3] = Vector4{ params.inverseSpotCutoff_, range, 0.0f, 0.0f };
+
+        lightProcessor->SetTiled(true);
+        ++numLights_;
+    }
+}
+
+Texture2D* TiledDeferredLightProcessor::Render(Camera* camera, Texture2D* depthTexture, const IntRect& depthRect,
+    Texture2D* albedoTexture, Texture2D* specularTexture, Texture2D* normalTexture)
+{
+    if (numLights_ == 0 || !IsSupported() || !depthTexture || !albedoTexture || !specularTexture || !normalTexture)
+        return nullptr;
+
+    if (depthTexture->GetMultiSample() > 1)
+    {
+        URHO3D_LOGWARNING("TiledDeferredLightProcessor cannot read multisampled depth texture");
+        return nullptr;
+    }
+
+    const IntVector2 size = albedoTexture->GetSize();
+    if (!UpdateLightingTexture(size))
+        return nullptr;
+
+    auto graphics = GetSubsystem<Graphics>();
+    ShaderVariation* lightingShader = graphics->GetShader(CS, lightingShaderName, physicalLighting_ ? "PHYSICAL" : "");
+    if (!lightingShader)
+        return nullptr;
+
+    // Flip texture coordinates in the same way as the scene was rendered
+#ifdef URHO3D_OPENGL
+    const bool invertY = camera->GetFlipVertical();
+#else
+    const bool invertY = !camera->GetFlipVertical();
+#endif
+
+    LightingParameters parameters;
+    parameters.clipToView_ = camera->GetProjection().Inverse();
+    parameters.worldToView_ = view_.ToMatrix4();
+    parameters.uvToClip_ = Vector4(2.0f, invertY ? -2.0f : 2.0f, -1.0f, invertY ? 1.0f : -1.0f);
+    parameters.depthOffsetAndSize_ = Vector4(static_cast<float>(depthRect.left_), static_cast<float>(depthRect.top_),
+        static_cast<float>(size.x_), static_cast<float>(size.y_));
+    parameters.numLights_ = Vector4(static_cast<float>(numLights_), 0.0f, 0.0f, 0.0f);
+
+    // Pad data to buffer capacity to avoid buffer reallocation on every light count change
+    const unsigned lightDataSize = NextPowerOfTwo(numLights_) * NumDataRowsPerLight * sizeof(Vector4);
+    if (!EnsureBufferSize(parametersBuffer_, sizeof(LightingParameters), sizeof(LightingParameters))
+        || !EnsureBufferSize(lightDataBuffer_, lightDataSize, sizeof(Vector4)))
+        return nullptr;
+
+    parametersBuffer_->SetData(&parameters, sizeof(LightingParameters), sizeof(LightingParameters));
+    lightDataBuffer_->SetData(lightData_.data(), lightDataSize, sizeof(Vector4));
+
+    computeDevice_->SetReadTexture(depthTexture, 0);
+    computeDevice_->SetReadTexture(albedoTexture, 1);
+    computeDevice_->SetReadTexture(specularTexture, 2);
+    computeDevice_->SetReadTexture(normalTexture, 3);
+    computeDevice_->SetWriteTexture(lightingTexture_, 0, 0, 0);
+    computeDevice_->SetWriteBuffer(parametersBuffer_, 1);
+    computeDevice_->SetWriteBuffer(lightDataBuffer_, 2);
+    computeDevice_->SetProgram(lightingShader);
+    computeDevice_->Dispatch(DivideRoundUp(size.x_, TileSize), DivideRoundUp(size.y_, TileSize), 1);
+
+    for (unsigned unit = 0; unit < 4; ++unit)
+        computeDevice_->SetReadTexture(nullptr, unit);
+    computeDevice_->SetWriteTexture(nullptr, 0, 0, 0);
+    computeDevice_->SetWriteBuffer(static_cast<ComputeBuffer*>(nullptr), 1);
+    computeDevice_->SetWriteBuffer(static_cast<ComputeBuffer*>(nullptr), 2);
+    computeDevice_->ApplyBindings();
+
+    return lightingTexture_;
+}
+
+bool TiledDeferredLightProcessor::UpdateLightingTexture(const IntVector2& size)
+{
+    if (lightingTexture_ && lightingTexture_->GetSize() == size)
+        return true;
+
+    lightingTexture_ = MakeShared<Texture2D>(context_);
+    lightingTexture_->SetNumLevels(1);
+    lightingTexture_->SetFilterMode(FILTER_NEAREST);
+    lightingTexture_->SetAddressMode(COORD_U, ADDRESS_CLAMP);
+    lightingTexture_->SetAddressMode(COORD_V, ADDRESS_CLAMP);
+    lightingTexture_->SetUnorderedAccess(true);
+    if (!lightingTexture_->SetSize(size.x_, size.y_, Graphics::GetRGBAFloat16Format()))
+    {
+        URHO3D_LOGERROR("Failed to create tiled lighting texture of size {}x{}", size.x_, size.y_);
+        lightingTexture_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool TiledDeferredLightProcessor::EnsureBufferSize(ComputeBuffer* buffer, unsigned size, unsigned structureSize)
+{
+    if (buffer->GetSize() == size && buffer->GetStructSize() == structureSize)
+        return true;
+    return buffer->SetSize(size, structureSize);
+}
+
+}
+
+#endif
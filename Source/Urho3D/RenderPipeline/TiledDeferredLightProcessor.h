@@ -0,0 +1,124 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Core/Object.h"
+#include "../Math/Matrix4.h"
+#include "../Math/Rect.h"
+
+#include <EASTL/vector.h>
+
+#if defined(URHO3D_COMPUTE)
+
+namespace Urho3D
+{
+
+class Camera;
+class ComputeBuffer;
+class ComputeDevice;
+class DrawableProcessor;
+class LightProcessor;
+class Texture2D;
+
+/// Evaluates unshadowed point and spot lights of deferred lighting in single compute dispatch over screen tiles.
+/// Each tile finds its depth bounds, culls lights against them and accumulates lighting for all lights in the tile.
+/// Lights that are not handled here (shadowed, negative, textured) are still rendered as light volumes.
+/// Light masks of drawables are ignored for tiled lights.
+/// Constants should match C_TiledDeferredLighting shader.
+class URHO3D_API TiledDeferredLightProcessor : public Object
+{
+    URHO3D_OBJECT(TiledDeferredLightProcessor, Object);
+
+public:
+    /// Size of screen tile in pixels. Equal to size of compute group.
+    static const unsigned TileSize = 16;
+    /// Max number of lights in one tile. Extra lights are ignored.
+    static const unsigned MaxLightsPerTile = 128;
+    /// Max number of tiled lights. Extra lights are rendered as light volumes.
+    static const unsigned MaxLights = 1024;
+    /// Number of vectors with data for one light.
+    static const unsigned NumDataRowsPerLight = 4;
+
+    explicit TiledDeferredLightProcessor(Context* context);
+    ~TiledDeferredLightProcessor() override;
+
+    /// Return whether tiled deferred lighting is supported by the device.
+    bool IsSupported() const;
+    /// Return whether the light can be evaluated in tiles. Shall be called after light processors are updated.
+    static bool IsTiledLight(const LightProcessor* lightProcessor);
+
+    /// Select tiled lights and upload light data to GPU.
+    /// Shall be called after lights are processed and before light volume batches are composed.
+    void Update(Camera* camera, DrawableProcessor* drawableProcessor, bool physicalLighting, bool linearSpaceLighting);
+    /// Evaluate tiled lights for geometry buffer and return texture with accumulated lighting.
+    /// Geometry buffer textures should have the size of the viewport, depth is read from viewport rectangle.
+    /// Returns null if there are no tiled lights.
+    Texture2D* Render(Camera* camera, Texture2D* depthTexture, const IntRect& depthRect,
+        Texture2D* albedoTexture, Texture2D* specularTexture, Texture2D* normalTexture);
+
+    /// Return number of lights selected at the last update.
+    unsigned GetNumLights() const { return numLights_; }
+    /// Return texture with accumulated lighting.
+    Texture2D* GetLightingTexture() const { return lightingTexture_; }
+
+private:
+    /// Parameters of lighting shader. Layout should match C_TiledDeferredLighting shader.
+    struct LightingParameters
+    {
+        Matrix4 clipToView_;
+        Matrix4 worldToView_;
+        Vector4 uvToClip_;
+        Vector4 depthOffsetAndSize_;
+        Vector4 numLights_;
+    };
+
+    /// Resize lighting texture if needed.
+    bool UpdateLightingTexture(const IntVector2& size);
+    /// Ensure that compute buffer has at least specified size.
+    bool EnsureBufferSize(ComputeBuffer* buffer, unsigned size, unsigned structureSize);
+
+    /// Compute device.
+    WeakPtr<ComputeDevice> computeDevice_;
+
+    /// Texture with accumulated lighting.
+    SharedPtr<Texture2D> lightingTexture_;
+    /// Parameters of lighting shader.
+    SharedPtr<ComputeBuffer> parametersBuffer_;
+    /// Data of tiled lights.
+    SharedPtr<ComputeBuffer> lightDataBuffer_;
+
+    /// Current frame parameters
+    /// @{
+    bool physicalLighting_{};
+    unsigned numLights_{};
+    Matrix3x4 view_;
+    /// @}
+
+    /// CPU-side data of tiled lights, NumDataRowsPerLight vectors per light.
+    ea::vector<Vector4> lightData_;
+};
+
+}
+
+#endif
@@ -231,6 +231,26 @@ ea::optional<NetworkObjectRelevance> BehaviorNetworkObject::GetRelevanceForClien
     return ea::nullopt;
 }
 
+ea::optional<float> BehaviorNetworkObject::GetInterestRadius()
+{
+    // Object is irrelevant beyond the radius only if all relevance filters agree
+    ea::optional<float> result;
+    if (callbackMask_.Test(NetworkCallbackMask::GetRelevanceForClient))
+    {
+        for (const auto& connectedBehavior : behaviors_)
+        {
+            if (connectedBehavior.callbackMask_.Test(NetworkCallbackMask::GetRelevanceForClient))
+            {
+                const auto radius = connectedBehavior.component_->GetInterestRadius();
+                if (!radius)
+                    return ea::nullopt;
+                result = ea::max(result.value_or(0.0f), *radius);
+            }
+        }
+    }
+    return result;
+}
+
 void BehaviorNetworkObject::UpdateTransformOnServer()
 {
     BaseClassName::UpdateTransformOnServer();
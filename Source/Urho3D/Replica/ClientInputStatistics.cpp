@@ -33,7 +33,7 @@ ClientInputStatistics::ClientInputStatistics(unsigned windowSize, unsigned maxIn
     numLostFrames_.set_capacity(windowSize);
 }
 
-void ClientInputStatistics::OnInputReceived(NetworkFrame frame)
+void ClientInputStatistics::OnInputReceived(NetworkFrame frame, unsigned numInputFrames)
 {
     if (!latestInputFrame_)
     {
@@ -47,7 +47,9 @@ void ClientInputStatistics::OnInputReceived(NetworkFrame frame)
     if (delta <= 0)
         return;
 
-    const int numLostFrames = ea::min(delta, maxInputLoss_) - 1;
+    // Frames recovered from redundant input arrive late, buffering should cover that delay
+    const unsigned maxDelay = ea::min(ea::max(numInputFrames, 1u), static_cast<unsigned>(maxInputLoss_));
+    const int numLostFrames = ea::min(delta, static_cast<int>(maxDelay)) - 1;
     for (int i = 0; i <= numLostFrames; ++i)
         numLostFrames_.push_back(i);
 
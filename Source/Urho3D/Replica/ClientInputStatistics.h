@@ -38,7 +38,9 @@ public:
     ClientInputStatistics(unsigned windowSize, unsigned maxInputLoss);
 
     /// Notify that the input was received for given frame.
-    void OnInputReceived(NetworkFrame frame);
+    /// Input may contain several most recent frames, so lost frames are recovered from redundant input with delay.
+    /// Frames older than that are not recovered at all and buffering doesn't help with them.
+    void OnInputReceived(NetworkFrame frame, unsigned numInputFrames = M_MAX_UNSIGNED);
 
     unsigned GetRecommendedBufferSize() const { return bufferSize_; }
 
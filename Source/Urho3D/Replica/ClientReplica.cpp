@@ -131,6 +131,9 @@ ClientReplica::ClientReplica(
     : ClientReplicaClock(scene, connection, initialClock, serverSettings)
     , network_(GetSubsystem<Network>())
     , objectRegistry_(scene->GetComponent<ReplicationManager>())
+    , unreliableDeltaWindow_(
+          ea::min(GetSetting(NetworkSettings::UnreliableDeltaWindow).GetUInt(), MaxUnreliableDeltaWindow))
+    , maxInputRedundancy_(GetSetting(NetworkSettings::MaxInputRedundancy).GetUInt())
 {
     URHO3D_ASSERT(objectRegistry_);
 
@@ -287,13 +290,41 @@ void ClientReplica::ProcessUpdateObjectsUnreliable(MemoryBuffer& messageData)
 {
     const auto messageFrame = static_cast<NetworkFrame>(messageData.ReadInt64());
 
+    bool isFrameComplete = true;
     while (!messageData.IsEof())
     {
         const auto networkId = static_cast<NetworkId>(messageData.ReadUInt());
         const StringHash componentType = messageData.ReadStringHash();
 
+        const unsigned baselineAge = unreliableDeltaWindow_ != 0 ? messageData.ReadVLE() : 0;
         messageData.ReadBuffer(componentBuffer_.GetBuffer());
 
+        if (unreliableDeltaWindow_ != 0)
+        {
+            auto& history = unreliableBaselines_[networkId];
+            if (baselineAge != 0)
+            {
+                const NetworkFrame baselineFrame = messageFrame + (-static_cast<long long>(baselineAge));
+                const auto iter = ea::find_if(history.begin(), history.end(),
+                    [&](const UnreliableDeltaBaseline& baseline) { return baseline.frame_ == baselineFrame; });
+
+                MemoryBuffer encodedData(componentBuffer_.GetBuffer());
+                if (iter == history.end() || !DecodeDeltaAgainstBaseline(iter->data_, encodedData, deltaBuffer_))
+                {
+                    URHO3D_LOGWARNING("Cannot decode unreliable update of NetworkObject {} against frame #{}",
+                        ToString(networkId), static_cast<long long>(baselineFrame));
+                    ++numUnreliableDeltaFailures_;
+                    isFrameComplete = false;
+                    continue;
+                }
+                componentBuffer_.GetBuffer().swap(deltaBuffer_);
+                ++numUnreliableDeltaUpdates_;
+            }
+
+            // Server may use any received update as baseline, even if it is not applied
+            StoreDeltaBaseline(history, messageFrame, componentBuffer_.GetBuffer(), unreliableDeltaWindow_);
+        }
+
         if (NetworkObject* networkObject = GetCheckedNetworkObject(networkId, componentType))
         {
             componentBuffer_.Resize(componentBuffer_.GetBuffer().size());
@@ -301,6 +332,10 @@ void ClientReplica::ProcessUpdateObjectsUnreliable(MemoryBuffer& messageData)
             networkObject->ReadUnreliableDelta(messageFrame, componentBuffer_);
         }
     }
+
+    // Server encodes against the latest acknowledged frame, so don't acknowledge frame without all baselines
+    if (unreliableDeltaWindow_ != 0 && isFrameComplete)
+        receivedUnreliableFrames_.Add(messageFrame);
 }
 
 NetworkObject* ClientReplica::CreateNetworkObject(NetworkId networkId, StringHash componentType)
@@ -349,6 +384,8 @@ NetworkObject* ClientReplica::GetCheckedNetworkObject(NetworkId networkId, Strin
 
 void ClientReplica::RemoveNetworkObject(WeakPtr<NetworkObject> networkObject)
 {
+    unreliableBaselines_.erase(networkObject->GetNetworkId());
+
     if (networkObject->GetNetworkMode() == NetworkObjectMode::ClientOwned)
         ownedObjects_.erase(networkObject);
 
@@ -410,14 +447,29 @@ void ClientReplica::OnNetworkUpdate()
     }
 }
 
+unsigned ClientReplica::GetInputRedundancy() const
+{
+    // Input frames between replica and input time are not confirmed by server yet
+    const int numUnconfirmedFrames = FloorToInt(GetInputTime() - GetReplicaTime());
+    return static_cast<unsigned>(Clamp(numUnconfirmedFrames, 1, static_cast<int>(ea::max(maxInputRedundancy_, 1u))));
+}
+
 void ClientReplica::SendObjectsFeedbackUnreliable(NetworkFrame feedbackFrame)
 {
     connection_->SendGeneratedMessage(MSG_OBJECTS_FEEDBACK_UNRELIABLE, PT_UNRELIABLE_UNORDERED,
         [&](VectorBuffer& msg, ea::string* debugInfo)
     {
         msg.WriteInt64(static_cast<long long>(feedbackFrame));
+        msg.WriteVLE(GetInputRedundancy());
 
+        // Acknowledge received frames so server can use them as baselines for delta compression
         bool sendMessage = false;
+        if (unreliableDeltaWindow_ != 0)
+        {
+            receivedUnreliableFrames_.Save(msg);
+            sendMessage = true;
+        }
+
         for (NetworkObject* networkObject : ownedObjects_)
         {
             if (!networkObject)
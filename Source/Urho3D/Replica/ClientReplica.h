@@ -32,6 +32,7 @@
 #include "../Replica/ProtocolMessages.h"
 
 #include <EASTL/optional.h>
+#include <EASTL/unordered_map.h>
 #include <EASTL/unordered_set.h>
 #include <EASTL/bonus/ring_buffer.h>
 
@@ -136,6 +137,14 @@ public:
     const ea::unordered_set<WeakPtr<NetworkObject>>& GetOwnedNetworkObjects() const { return ownedObjects_; };
     bool HasOwnedNetworkObjects() const { return !ownedObjects_.empty(); }
     NetworkObject* GetOwnedNetworkObject() const { return ownedObjects_.size() == 1 ? *ownedObjects_.begin() : nullptr; }
+    /// Return number of most recent input frames that owned objects should send with each feedback.
+    /// Server uses it to tell lost input from input recovered from redundancy.
+    unsigned GetInputRedundancy() const;
+    /// Return number of unreliable updates decoded against baseline and number of updates that failed to decode.
+    /// @{
+    unsigned GetNumUnreliableDeltaUpdates() const { return numUnreliableDeltaUpdates_; }
+    unsigned GetNumUnreliableDeltaFailures() const { return numUnreliableDeltaFailures_; }
+    /// @}
 
 private:
     void OnInputReady(float timeStep);
@@ -158,6 +167,19 @@ private:
     ea::vector<MsgSceneClock> pendingClockUpdates_;
     ea::unordered_set<WeakPtr<NetworkObject>> ownedObjects_;
 
+    /// Max number of recent input frames sent with each feedback.
+    const unsigned maxInputRedundancy_{};
+
+    /// Recently received unreliable updates and frames, used for delta compression.
+    /// @{
+    const unsigned unreliableDeltaWindow_{};
+    ea::unordered_map<NetworkId, ea::vector<UnreliableDeltaBaseline>> unreliableBaselines_;
+    ReceivedFramesMask receivedUnreliableFrames_;
+    ByteVector deltaBuffer_;
+    unsigned numUnreliableDeltaUpdates_{};
+    unsigned numUnreliableDeltaFailures_{};
+    /// @}
+
     VectorBuffer componentBuffer_;
 };
 
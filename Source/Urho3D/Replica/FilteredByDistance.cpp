@@ -81,4 +81,12 @@ ea::optional<NetworkObjectRelevance> FilteredByDistance::GetRelevanceForClient(A
     return static_cast<NetworkObjectRelevance>(ea::min(updatePeriod_, maxPeriod));
 }
 
+ea::optional<float> FilteredByDistance::GetInterestRadius()
+{
+    // Distant object is still replicated if it's relevant
+    if (isRelevant_)
+        return ea::nullopt;
+    return distance_;
+}
+
 }
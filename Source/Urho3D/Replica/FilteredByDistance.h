@@ -58,6 +58,7 @@ public:
     /// Implement NetworkBehavior.
     /// @{
     ea::optional<NetworkObjectRelevance> GetRelevanceForClient(AbstractConnection* connection) override;
+    ea::optional<float> GetInterestRadius() override;
     /// @}
 
 private:
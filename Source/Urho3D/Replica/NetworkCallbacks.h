@@ -77,7 +77,11 @@ public:
 
     /// Return whether the component should be replicated for specified client connection, and how frequently.
     /// The first reported valid relevance is used.
+    /// May be called from worker threads for different connections simultaneously, must not modify any shared state.
     virtual ea::optional<NetworkObjectRelevance> GetRelevanceForClient(AbstractConnection* connection) { return ea::nullopt; }
+    /// Return radius around objects owned by the client beyond which the object is always irrelevant for the client.
+    /// Such objects are tracked in the interest grid and relevance is not evaluated for distant clients.
+    virtual ea::optional<float> GetInterestRadius() { return ea::nullopt; }
     /// Called when world transform or parent of the object is updated in Server mode.
     virtual void UpdateTransformOnServer() {}
 
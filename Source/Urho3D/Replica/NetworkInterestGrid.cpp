@@ -0,0 +1,104 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Core/Assert.h"
+#include "../Replica/NetworkInterestGrid.h"
+
+namespace Urho3D
+{
+
+void NetworkInterestGrid::Reset(float cellSize)
+{
+    cellSize_ = ea::max(cellSize, M_EPSILON);
+    maxRadius_ = 0.0f;
+    numObjects_ = 0;
+    objects_.clear();
+    cells_.clear();
+}
+
+void NetworkInterestGrid::UpdateObject(unsigned index, const Vector3& position, float radius)
+{
+    if (index >= objects_.size())
+        objects_.resize(index + 1);
+
+    ObjectData& data = objects_[index];
+    const IntVector2 cell = GetCell(position.x_, position.z_);
+    maxRadius_ = ea::max(maxRadius_, radius);
+
+    if (data.present_)
+    {
+        if (data.cell_ == cell)
+            return;
+        RemoveObject(index);
+    }
+
+    data.cell_ = cell;
+    data.present_ = true;
+    cells_[cell].push_back(index);
+    ++numObjects_;
+}
+
+void NetworkInterestGrid::RemoveObject(unsigned index)
+{
+    if (!HasObject(index))
+        return;
+
+    ObjectData& data = objects_[index];
+    const auto iter = cells_.find(data.cell_);
+    URHO3D_ASSERT(iter != cells_.end());
+
+    auto& bucket = iter->second;
+    const auto objectIter = ea::find(bucket.begin(), bucket.end(), index);
+    URHO3D_ASSERT(objectIter != bucket.end());
+    *objectIter = bucket.back();
+    bucket.pop_back();
+    if (bucket.empty())
+        cells_.erase(iter);
+
+    data.present_ = false;
+    --numObjects_;
+}
+
+void NetworkInterestGrid::QueryObjects(const Vector3& position, float radius, ea::vector<unsigned>& result) const
+{
+    const IntVector2 minCell = GetCell(position.x_ - radius, position.z_ - radius);
+    const IntVector2 maxCell = GetCell(position.x_ + radius, position.z_ + radius);
+
+    for (int y = minCell.y_; y <= maxCell.y_; ++y)
+    {
+        for (int x = minCell.x_; x <= maxCell.x_; ++x)
+        {
+            const auto iter = cells_.find(IntVector2{x, y});
+            if (iter != cells_.end())
+                result.insert(result.end(), iter->second.begin(), iter->second.end());
+        }
+    }
+}
+
+IntVector2 NetworkInterestGrid::GetCell(float x, float z) const
+{
+    return {FloorToInt(x / cellSize_), FloorToInt(z / cellSize_)};
+}
+
+}
@@ -0,0 +1,80 @@
+//
+// Copyright (c) 2017-2020 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/// \file
+
+#pragma once
+
+#include "../Container/TaggedAllocator.h"
+#include "../Math/Vector2.h"
+#include "../Math/Vector3.h"
+
+#include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+/// Spatial hash of NetworkObject positions on XZ plane, addressed by NetworkObject index.
+/// Used by ServerReplicator to find objects that may be relevant for the client
+/// without evaluating relevance of every object for every client.
+class URHO3D_API NetworkInterestGrid
+{
+public:
+    /// Remove all objects and set new cell size.
+    void Reset(float cellSize);
+    /// Add object or update its position and interest radius.
+    /// Object is moved between buckets only when it crosses cell boundary.
+    void UpdateObject(unsigned index, const Vector3& position, float radius);
+    /// Remove object from the grid if present.
+    void RemoveObject(unsigned index);
+    /// Collect indices of objects in cells overlapping the circle around the position.
+    /// Result may contain objects outside of the circle and duplicates from previous queries.
+    void QueryObjects(const Vector3& position, float radius, ea::vector<unsigned>& result) const;
+
+    /// Return properties of the grid.
+    /// @{
+    bool HasObject(unsigned index) const { return index < objects_.size() && objects_[index].present_; }
+    bool IsEmpty() const { return numObjects_ == 0; }
+    unsigned GetNumObjects() const { return numObjects_; }
+    float GetCellSize() const { return cellSize_; }
+    /// Return max interest radius of objects added since the last reset.
+    float GetMaxRadius() const { return maxRadius_; }
+    /// @}
+
+private:
+    struct ObjectData
+    {
+        IntVector2 cell_;
+        bool present_{};
+    };
+
+    IntVector2 GetCell(float x, float z) const;
+
+    float cellSize_{1.0f};
+    float maxRadius_{};
+    unsigned numObjects_{};
+    TaggedVector<ObjectData, MemoryTag::Network> objects_;
+    TaggedUnorderedMap<IntVector2, TaggedVector<unsigned, MemoryTag::Network>, MemoryTag::Network> cells_;
+};
+
+}
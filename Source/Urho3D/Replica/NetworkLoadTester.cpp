@@ -0,0 +1,278 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Replica/NetworkLoadTester.h"
+
+#include "../Core/CoreEvents.h"
+#include "../IO/Log.h"
+#include "../Network/Network.h"
+#include "../Network/NetworkEvents.h"
+#include "../Replica/NetworkObject.h"
+#include "../Replica/NetworkSettingsConsts.h"
+#include "../Replica/ReplicationManager.h"
+#include "../Replica/ServerReplicator.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+NetworkLoadTestClient::NetworkLoadTestClient(NetworkLoadTester* owner, unsigned index)
+    : AbstractConnection(owner->GetContext())
+    , owner_(owner)
+    , index_(index)
+{
+}
+
+NetworkLoadTestClient::~NetworkLoadTestClient()
+{
+}
+
+void NetworkLoadTestClient::SendMessageInternal(
+    NetworkMessageId messageId, bool reliable, bool inOrder, const unsigned char* data, unsigned numBytes)
+{
+    numBytesReceived_ += numBytes;
+    owner_->numBytesReceived_ += numBytes;
+    ++numMessagesReceived_;
+
+    switch (messageId)
+    {
+    case MSG_CONFIGURE:
+    {
+        MemoryBuffer messageData{data, numBytes};
+        const auto msg = ReadNetworkMessage<MsgConfigure>(messageData);
+        pendingSynchronization_ = msg.magic_;
+        const unsigned deltaWindow = GetNetworkSetting(msg.settings_, NetworkSettings::UnreliableDeltaWindow).GetUInt();
+        unreliableDeltaWindow_ = ea::min(deltaWindow, MaxUnreliableDeltaWindow);
+        isSynchronized_ = false;
+        receivedUnreliableFrames_ = {};
+        break;
+    }
+
+    case MSG_UPDATE_OBJECTS_UNRELIABLE:
+    {
+        // Only frame is needed to acknowledge the message, the payload is not decoded
+        MemoryBuffer messageData{data, numBytes};
+        const auto messageFrame = static_cast<NetworkFrame>(messageData.ReadInt64());
+        receivedUnreliableFrames_.Add(messageFrame);
+        break;
+    }
+
+    default: break;
+    }
+}
+
+ea::string NetworkLoadTestClient::ToString() const
+{
+    return Format("Load Test Client #{}", index_);
+}
+
+unsigned NetworkLoadTestClient::GetLocalTime() const
+{
+    return static_cast<unsigned>(RoundToInt(owner_->GetElapsedTime() * 1000.0f));
+}
+
+void NetworkLoadTestClient::Update(ReplicationManager* server, NetworkFrame frame)
+{
+    if (pendingSynchronization_)
+    {
+        messageBuffer_.Clear();
+        MsgSynchronized{*pendingSynchronization_}.Save(messageBuffer_);
+        pendingSynchronization_ = ea::nullopt;
+        isSynchronized_ = true;
+
+        DeliverMessage(server, MSG_SYNCHRONIZED, messageBuffer_);
+    }
+
+    if (isSynchronized_)
+        SendFeedback(server, frame);
+}
+
+void NetworkLoadTestClient::SendFeedback(ReplicationManager* server, NetworkFrame frame)
+{
+    messageBuffer_.Clear();
+    messageBuffer_.WriteInt64(static_cast<long long>(frame));
+    messageBuffer_.WriteVLE(1);
+
+    bool sendMessage = false;
+    if (unreliableDeltaWindow_ != 0)
+    {
+        receivedUnreliableFrames_.Save(messageBuffer_);
+        sendMessage = true;
+    }
+
+    const NetworkLoadTestInputGenerator& inputGenerator = owner_->GetInputGenerator();
+    if (inputGenerator)
+    {
+        ServerReplicator* serverReplicator = server->GetServerReplicator();
+        for (NetworkObject* networkObject : serverReplicator->GetNetworkObjectsOwnedByConnection(this))
+        {
+            objectBuffer_.Clear();
+            if (inputGenerator(index_, networkObject, frame, objectBuffer_))
+            {
+                messageBuffer_.WriteUInt(static_cast<unsigned>(networkObject->GetNetworkId()));
+                messageBuffer_.WriteBuffer(objectBuffer_.GetBuffer());
+                sendMessage = true;
+            }
+        }
+    }
+
+    if (sendMessage)
+        DeliverMessage(server, MSG_OBJECTS_FEEDBACK_UNRELIABLE, messageBuffer_);
+}
+
+void NetworkLoadTestClient::DeliverMessage(
+    ReplicationManager* server, NetworkMessageId messageId, const VectorBuffer& buffer)
+{
+    numBytesSent_ += buffer.GetSize();
+    owner_->numBytesSent_ += buffer.GetSize();
+
+    MemoryBuffer messageData{buffer.GetBuffer()};
+    server->ProcessMessage(this, messageId, messageData);
+}
+
+NetworkLoadTester::NetworkLoadTester(ReplicationManager* server)
+    : Object(server->GetContext())
+    , server_(server)
+{
+    SubscribeToEvent(E_UPDATE, [this](StringHash, VariantMap& eventData)
+    {
+        using namespace Update;
+        Update(eventData[P_TIMESTEP].GetFloat());
+    });
+
+    auto network = GetSubsystem<Network>();
+    SubscribeToEvent(network, E_BEGINSERVERNETWORKFRAME, [this](StringHash, VariantMap&) { OnBeginServerFrame(); });
+    SubscribeToEvent(network, E_NETWORKUPDATESENT, [this](StringHash, VariantMap& eventData)
+    {
+        using namespace NetworkUpdateSent;
+        if (eventData[P_ISSERVER].GetBool())
+            OnServerUpdateSent();
+    });
+}
+
+NetworkLoadTester::~NetworkLoadTester()
+{
+    RemoveAllClients();
+}
+
+void NetworkLoadTester::AddClients(unsigned count)
+{
+    ServerReplicator* serverReplicator = server_ ? server_->GetServerReplicator() : nullptr;
+    if (!serverReplicator)
+    {
+        URHO3D_LOGERROR("Load test clients can be added only to running server");
+        return;
+    }
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        auto client = MakeShared<NetworkLoadTestClient>(this, clients_.size());
+        clients_.push_back(client);
+        serverReplicator->AddConnection(client);
+    }
+}
+
+void NetworkLoadTester::RemoveAllClients()
+{
+    ServerReplicator* serverReplicator = server_ ? server_->GetServerReplicator() : nullptr;
+    if (serverReplicator)
+    {
+        for (NetworkLoadTestClient* client : clients_)
+            serverReplicator->RemoveConnection(client);
+    }
+    clients_.clear();
+}
+
+void NetworkLoadTester::ResetStats()
+{
+    numFrames_ = 0;
+    statsTime_ = 0.0f;
+    statsClientTime_ = 0.0f;
+    totalServerFrameTime_ = 0;
+    maxServerFrameTime_ = 0;
+    totalClientFrameTime_ = 0;
+    maxClientFrameTime_ = 0;
+    numBytesReceived_ = 0;
+    numBytesSent_ = 0;
+}
+
+NetworkLoadTestStats NetworkLoadTester::GetStats() const
+{
+    static constexpr float usecToMsec = 0.001f;
+
+    NetworkLoadTestStats stats;
+    stats.numFrames_ = numFrames_;
+    stats.elapsedTime_ = statsTime_;
+    if (numFrames_ != 0)
+    {
+        stats.averageServerFrameTime_ = totalServerFrameTime_ * usecToMsec / numFrames_;
+        stats.maxServerFrameTime_ = maxServerFrameTime_ * usecToMsec;
+        stats.averageClientFrameTime_ = totalClientFrameTime_ * usecToMsec / numFrames_;
+        stats.maxClientFrameTime_ = maxClientFrameTime_ * usecToMsec;
+    }
+    if (statsClientTime_ > 0.0f)
+    {
+        stats.bytesReceivedPerClient_ = numBytesReceived_ / statsClientTime_;
+        stats.bytesSentPerClient_ = numBytesSent_ / statsClientTime_;
+    }
+    return stats;
+}
+
+void NetworkLoadTester::Update(float timeStep)
+{
+    elapsedTime_ += timeStep;
+    statsTime_ += timeStep;
+    statsClientTime_ += timeStep * clients_.size();
+}
+
+void NetworkLoadTester::OnBeginServerFrame()
+{
+    frameTimer_.Reset();
+    isFrameStarted_ = true;
+}
+
+void NetworkLoadTester::OnServerUpdateSent()
+{
+    ServerReplicator* serverReplicator = server_ ? server_->GetServerReplicator() : nullptr;
+    if (!isFrameStarted_ || !serverReplicator)
+        return;
+
+    isFrameStarted_ = false;
+    const long long serverFrameTime = frameTimer_.GetUSec(true);
+
+    // Clients send feedback for the next frame, as if their input was delayed by one frame
+    const NetworkFrame feedbackFrame = serverReplicator->GetCurrentFrame() + 1;
+    for (NetworkLoadTestClient* client : clients_)
+        client->Update(server_, feedbackFrame);
+    const long long clientFrameTime = frameTimer_.GetUSec(false);
+
+    ++numFrames_;
+    totalServerFrameTime_ += serverFrameTime;
+    maxServerFrameTime_ = ea::max(maxServerFrameTime_, serverFrameTime);
+    totalClientFrameTime_ += clientFrameTime;
+    maxClientFrameTime_ = ea::max(maxClientFrameTime_, clientFrameTime);
+}
+
+}
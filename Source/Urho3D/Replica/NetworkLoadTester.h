@@ -0,0 +1,191 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/// \file
+
+#pragma once
+
+#include "../Core/Timer.h"
+#include "../Network/AbstractConnection.h"
+#include "../Replica/ProtocolMessages.h"
+
+#include <EASTL/functional.h>
+#include <EASTL/optional.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class NetworkLoadTester;
+class NetworkObject;
+class ReplicationManager;
+
+/// Scripted input generator. Write feedback payload for the object owned by the simulated client.
+/// Return false to skip the object in this frame.
+using NetworkLoadTestInputGenerator =
+    ea::function<bool(unsigned clientIndex, NetworkObject* networkObject, NetworkFrame frame, VectorBuffer& dest)>;
+
+/// Load test statistics aggregated since the last reset.
+struct NetworkLoadTestStats
+{
+    /// Number of server network frames.
+    unsigned numFrames_{};
+    /// Total simulated time in seconds.
+    float elapsedTime_{};
+
+    /// Average and max time of server network frame, in milliseconds.
+    /// Includes scene update, replication and message generation for all clients.
+    /// @{
+    float averageServerFrameTime_{};
+    float maxServerFrameTime_{};
+    /// @}
+
+    /// Average and max time spent in simulated clients per frame, in milliseconds.
+    /// @{
+    float averageClientFrameTime_{};
+    float maxClientFrameTime_{};
+    /// @}
+
+    /// Average bandwidth per client, in bytes per second.
+    /// @{
+    float bytesReceivedPerClient_{};
+    float bytesSentPerClient_{};
+    /// @}
+};
+
+/// Lightweight connection that imitates remote client without scene or ClientReplica.
+/// It acknowledges configuration, tracks received unreliable frames and sends scripted feedback.
+class URHO3D_API NetworkLoadTestClient : public AbstractConnection
+{
+    URHO3D_OBJECT(NetworkLoadTestClient, AbstractConnection);
+
+public:
+    NetworkLoadTestClient(NetworkLoadTester* owner, unsigned index);
+    ~NetworkLoadTestClient() override;
+
+    /// Return properties of the client.
+    /// @{
+    unsigned GetIndex() const { return index_; }
+    bool IsSynchronized() const { return isSynchronized_; }
+    unsigned long long GetNumBytesReceived() const { return numBytesReceived_; }
+    unsigned long long GetNumBytesSent() const { return numBytesSent_; }
+    unsigned GetNumMessagesReceived() const { return numMessagesReceived_; }
+    /// @}
+
+    /// Implement AbstractConnection.
+    /// @{
+    void SendMessageInternal(NetworkMessageId messageId, bool reliable, bool inOrder, const unsigned char* data,
+        unsigned numBytes) override;
+    ea::string ToString() const override;
+    bool IsClockSynchronized() const override { return true; }
+    unsigned RemoteToLocalTime(unsigned time) const override { return time; }
+    unsigned LocalToRemoteTime(unsigned time) const override { return time; }
+    unsigned GetLocalTime() const override;
+    unsigned GetLocalTimeOfLatestRoundtrip() const override { return GetLocalTime(); }
+    unsigned GetPing() const override { return 0; }
+    /// @}
+
+private:
+    friend class NetworkLoadTester;
+
+    /// Send pending acknowledgement and feedback for the frame.
+    void Update(ReplicationManager* server, NetworkFrame frame);
+    void SendFeedback(ReplicationManager* server, NetworkFrame frame);
+    void DeliverMessage(ReplicationManager* server, NetworkMessageId messageId, const VectorBuffer& buffer);
+
+    NetworkLoadTester* owner_{};
+    const unsigned index_{};
+
+    ea::optional<unsigned> pendingSynchronization_;
+    bool isSynchronized_{};
+    unsigned unreliableDeltaWindow_{};
+    ReceivedFramesMask receivedUnreliableFrames_;
+
+    VectorBuffer messageBuffer_;
+    VectorBuffer objectBuffer_;
+
+    unsigned long long numBytesReceived_{};
+    unsigned long long numBytesSent_{};
+    unsigned numMessagesReceived_{};
+};
+
+/// Stress-tests server replication with many lightweight simulated clients in the same process.
+/// Simulated clients are connected directly to ServerReplicator and don't have their own scenes,
+/// so hundreds of them can be simulated cheaply while measuring server frame time and bandwidth.
+/// Objects should be assigned to simulated clients via NetworkObject::SetOwner to receive scripted input.
+class URHO3D_API NetworkLoadTester : public Object
+{
+    URHO3D_OBJECT(NetworkLoadTester, Object);
+
+public:
+    explicit NetworkLoadTester(ReplicationManager* server);
+    ~NetworkLoadTester() override;
+
+    /// Connect simulated clients to the server.
+    void AddClients(unsigned count);
+    /// Disconnect all simulated clients.
+    void RemoveAllClients();
+    /// Set scripted input generator for the objects owned by simulated clients.
+    void SetInputGenerator(const NetworkLoadTestInputGenerator& generator) { inputGenerator_ = generator; }
+    /// Discard aggregated statistics.
+    void ResetStats();
+
+    /// Return properties of the tester.
+    /// @{
+    unsigned GetNumClients() const { return clients_.size(); }
+    NetworkLoadTestClient* GetClient(unsigned index) const { return clients_[index]; }
+    const NetworkLoadTestInputGenerator& GetInputGenerator() const { return inputGenerator_; }
+    NetworkLoadTestStats GetStats() const;
+    float GetElapsedTime() const { return elapsedTime_; }
+    /// @}
+
+private:
+    friend class NetworkLoadTestClient;
+
+    void Update(float timeStep);
+    void OnBeginServerFrame();
+    void OnServerUpdateSent();
+
+    WeakPtr<ReplicationManager> server_;
+    NetworkLoadTestInputGenerator inputGenerator_;
+    ea::vector<SharedPtr<NetworkLoadTestClient>> clients_;
+
+    HiresTimer frameTimer_;
+    bool isFrameStarted_{};
+    float elapsedTime_{};
+
+
+    /// Statistics since the last reset.
+    /// @{
+    unsigned numFrames_{};
+    float statsTime_{};
+    float statsClientTime_{};
+    long long totalServerFrameTime_{};
+    long long maxServerFrameTime_{};
+    long long totalClientFrameTime_{};
+    long long maxClientFrameTime_{};
+    unsigned long long numBytesReceived_{};
+    unsigned long long numBytesSent_{};
+    /// @}
+};
+
+}
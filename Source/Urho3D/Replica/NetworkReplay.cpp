@@ -0,0 +1,397 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Replica/NetworkReplay.h"
+
+#include "../Core/CoreEvents.h"
+#include "../IO/Compression.h"
+#include "../IO/Log.h"
+#include "../Replica/ProtocolMessages.h"
+#include "../Replica/ReplicationManager.h"
+#include "../Replica/ServerReplicator.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+static const ea::string REPLAY_FILE_ID = "URPL";
+static const unsigned REPLAY_VERSION = 1;
+
+}
+
+NetworkReplayRecorder::NetworkReplayRecorder(ReplicationManager* server)
+    : AbstractConnection(server->GetContext())
+    , server_(server)
+{
+    SubscribeToEvent(E_UPDATE, [this](StringHash, VariantMap& eventData)
+    {
+        using namespace Update;
+        Update(eventData[P_TIMESTEP].GetFloat());
+    });
+}
+
+NetworkReplayRecorder::~NetworkReplayRecorder()
+{
+    if (IsRecording())
+        StopRecording();
+}
+
+bool NetworkReplayRecorder::StartRecording(Serializer* dest)
+{
+    if (IsRecording())
+        StopRecording();
+
+    if (!dest || !server_ || !server_->GetServerReplicator())
+    {
+        URHO3D_LOGERROR("Replay recording requires destination and running server");
+        return false;
+    }
+
+    dest_ = dest;
+    dest_->WriteFileID(REPLAY_FILE_ID);
+    dest_->WriteUInt(REPLAY_VERSION);
+    numBytesWritten_ = REPLAY_FILE_ID.length() + sizeof(unsigned);
+
+    currentTime_ = 0.0f;
+    chunkData_.Clear();
+    chunkStartTime_ = ea::nullopt;
+    chunks_.clear();
+
+    isNextChunkKeyFrame_ = true;
+    Connect();
+    return true;
+}
+
+void NetworkReplayRecorder::StopRecording()
+{
+    if (!IsRecording())
+        return;
+
+    Disconnect();
+    FlushChunk();
+
+    // Write chunk index at the end so the stream can be written sequentially
+    const unsigned indexOffset = numBytesWritten_;
+    dest_->WriteUInt(GetCurrentTimeMs());
+    dest_->WriteVLE(chunks_.size());
+    for (const NetworkReplayChunk& chunk : chunks_)
+    {
+        dest_->WriteUInt(chunk.startTime_);
+        dest_->WriteBool(chunk.isKeyFrame_);
+        dest_->WriteUInt(chunk.offset_);
+        dest_->WriteUInt(chunk.compressedSize_);
+        dest_->WriteUInt(chunk.uncompressedSize_);
+    }
+    dest_->WriteUInt(indexOffset);
+
+    dest_ = nullptr;
+}
+
+void NetworkReplayRecorder::Update(float timeStep)
+{
+    if (!IsRecording())
+        return;
+
+    currentTime_ += timeStep;
+    keyFrameTime_ += timeStep;
+
+    if (!server_ || !server_->GetServerReplicator())
+    {
+        URHO3D_LOGWARNING("Replay recording is stopped because server is stopped");
+        StopRecording();
+        return;
+    }
+
+    // Acknowledge configuration as a client would, outside of server message processing
+    if (pendingSynchronization_)
+    {
+        VectorBuffer buffer;
+        MsgSynchronized{*pendingSynchronization_}.Save(buffer);
+        pendingSynchronization_ = ea::nullopt;
+
+        MemoryBuffer messageData{buffer.GetBuffer()};
+        server_->ProcessMessage(this, MSG_SYNCHRONIZED, messageData);
+    }
+
+    // Reconnect to get full scene state from the server
+    if (keyFrameInterval_ > 0.0f && keyFrameTime_ >= keyFrameInterval_)
+    {
+        Disconnect();
+        FlushChunk();
+        isNextChunkKeyFrame_ = true;
+        Connect();
+    }
+}
+
+void NetworkReplayRecorder::SendMessageInternal(
+    NetworkMessageId messageId, bool reliable, bool inOrder, const unsigned char* data, unsigned numBytes)
+{
+    if (!IsRecording())
+        return;
+
+    WriteMessage(messageId, data, numBytes);
+
+    if (messageId == MSG_CONFIGURE)
+    {
+        MemoryBuffer messageData{data, numBytes};
+        const auto msg = ReadNetworkMessage<MsgConfigure>(messageData);
+        pendingSynchronization_ = msg.magic_;
+
+        // Server sends scene clock only after periodic interval, and client cannot start without it.
+        // Write current clock right away so every session in the replay can be played from its start.
+        ServerReplicator* serverReplicator = server_ ? server_->GetServerReplicator() : nullptr;
+        if (serverReplicator)
+        {
+            VectorBuffer clockData;
+            MsgSceneClock{serverReplicator->GetCurrentFrame(), GetCurrentTimeMs(), 0}.Save(clockData);
+            WriteMessage(MSG_SCENE_CLOCK, clockData.GetData(), clockData.GetSize());
+        }
+    }
+
+    if (chunkData_.GetSize() >= maxChunkSize_)
+        FlushChunk();
+}
+
+void NetworkReplayRecorder::WriteMessage(NetworkMessageId messageId, const unsigned char* data, unsigned numBytes)
+{
+    const unsigned currentTime = GetCurrentTimeMs();
+    if (!chunkStartTime_)
+        chunkStartTime_ = currentTime;
+
+    chunkData_.WriteUInt(currentTime);
+    chunkData_.WriteVLE(static_cast<unsigned>(messageId));
+    chunkData_.WriteVLE(numBytes);
+    chunkData_.Write(data, numBytes);
+}
+
+void NetworkReplayRecorder::Connect()
+{
+    if (isConnected_)
+        return;
+
+    server_->GetServerReplicator()->AddConnection(this);
+    isConnected_ = true;
+    keyFrameTime_ = 0.0f;
+    pendingSynchronization_ = ea::nullopt;
+}
+
+void NetworkReplayRecorder::Disconnect()
+{
+    if (!isConnected_)
+        return;
+
+    if (server_ && server_->GetServerReplicator())
+        server_->GetServerReplicator()->RemoveConnection(this);
+    isConnected_ = false;
+}
+
+void NetworkReplayRecorder::FlushChunk()
+{
+    if (chunkData_.GetSize() == 0)
+        return;
+
+    const unsigned uncompressedSize = chunkData_.GetSize();
+    ByteVector compressedData(EstimateCompressBound(uncompressedSize));
+    const unsigned compressedSize = CompressData(compressedData.data(), chunkData_.GetData(), uncompressedSize);
+
+    NetworkReplayChunk& chunk = chunks_.emplace_back();
+    chunk.startTime_ = *chunkStartTime_;
+    chunk.isKeyFrame_ = isNextChunkKeyFrame_;
+    chunk.offset_ = numBytesWritten_;
+    chunk.compressedSize_ = compressedSize;
+    chunk.uncompressedSize_ = uncompressedSize;
+
+    dest_->Write(compressedData.data(), compressedSize);
+    numBytesWritten_ += compressedSize;
+
+    chunkData_.Clear();
+    chunkStartTime_ = ea::nullopt;
+    isNextChunkKeyFrame_ = false;
+}
+
+NetworkReplayPlayer::NetworkReplayPlayer(ReplicationManager* client)
+    : AbstractConnection(client->GetContext())
+    , client_(client)
+{
+    SubscribeToEvent(E_UPDATE, [this](StringHash, VariantMap& eventData)
+    {
+        using namespace Update;
+        Update(eventData[P_TIMESTEP].GetFloat());
+    });
+}
+
+NetworkReplayPlayer::~NetworkReplayPlayer()
+{
+}
+
+bool NetworkReplayPlayer::Load(Deserializer& source)
+{
+    chunks_.clear();
+    duration_ = 0.0f;
+
+    if (source.ReadFileID() != REPLAY_FILE_ID || source.ReadUInt() != REPLAY_VERSION)
+    {
+        URHO3D_LOGERROR("Replay stream '{}' has unknown format", source.GetName());
+        return false;
+    }
+
+    const unsigned headerSize = source.GetPosition();
+    if (source.GetSize() < headerSize + sizeof(unsigned))
+    {
+        URHO3D_LOGERROR("Replay stream '{}' is truncated", source.GetName());
+        return false;
+    }
+
+    source.Seek(source.GetSize() - sizeof(unsigned));
+    const unsigned indexOffset = source.ReadUInt();
+    if (indexOffset < headerSize || indexOffset >= source.GetSize())
+    {
+        URHO3D_LOGERROR("Replay stream '{}' has invalid chunk index", source.GetName());
+        return false;
+    }
+
+    source.Seek(indexOffset);
+    duration_ = source.ReadUInt() * 0.001f;
+    chunks_.resize(source.ReadVLE());
+    for (NetworkReplayChunk& chunk : chunks_)
+    {
+        chunk.startTime_ = source.ReadUInt();
+        chunk.isKeyFrame_ = source.ReadBool();
+        chunk.offset_ = source.ReadUInt();
+        chunk.compressedSize_ = source.ReadUInt();
+        chunk.uncompressedSize_ = source.ReadUInt();
+    }
+
+    for (NetworkReplayChunk& chunk : chunks_)
+    {
+        chunk.compressedData_.resize(chunk.compressedSize_);
+        if (chunk.offset_ + chunk.compressedSize_ > indexOffset || source.Seek(chunk.offset_) != chunk.offset_
+            || source.Read(chunk.compressedData_.data(), chunk.compressedSize_) != chunk.compressedSize_)
+        {
+            URHO3D_LOGERROR("Replay stream '{}' has invalid chunk", source.GetName());
+            chunks_.clear();
+            return false;
+        }
+    }
+
+    Seek(0.0f);
+    return true;
+}
+
+void NetworkReplayPlayer::Update(float timeStep)
+{
+    if (paused_ || chunks_.empty() || !client_)
+        return;
+
+    currentTime_ = ea::min(currentTime_ + timeStep * speed_, duration_);
+    DeliverMessages(GetCurrentTimeMs());
+}
+
+void NetworkReplayPlayer::Seek(float time)
+{
+    if (chunks_.empty() || !client_)
+        return;
+
+    currentTime_ = Clamp(time, 0.0f, duration_);
+    const unsigned currentTime = GetCurrentTimeMs();
+
+    // First chunk always starts the session, so it's used as fallback
+    unsigned keyFrameIndex = 0;
+    for (unsigned i = 0; i < chunks_.size() && chunks_[i].startTime_ <= currentTime; ++i)
+    {
+        if (chunks_[i].isKeyFrame_)
+            keyFrameIndex = i;
+    }
+
+    client_->StartClient(this);
+    if (BeginChunk(keyFrameIndex))
+        DeliverMessages(currentTime);
+}
+
+unsigned NetworkReplayPlayer::GetNumKeyFrames() const
+{
+    const auto isKeyFrame = [](const NetworkReplayChunk& chunk) { return chunk.isKeyFrame_; };
+    return ea::count_if(chunks_.begin(), chunks_.end(), isKeyFrame);
+}
+
+bool NetworkReplayPlayer::BeginChunk(unsigned index)
+{
+    const NetworkReplayChunk& chunk = chunks_[index];
+    nextChunkIndex_ = index + 1;
+
+    chunkData_.Clear();
+    chunkData_.Resize(chunk.uncompressedSize_);
+    const unsigned decompressedSize =
+        DecompressData(chunkData_.GetModifiableData(), chunk.compressedData_.data(), chunk.uncompressedSize_);
+    chunkData_.Seek(0);
+
+    if (decompressedSize != chunk.compressedSize_)
+    {
+        URHO3D_LOGERROR("Failed to decompress replay chunk #{}", index);
+        chunkData_.Clear();
+        return false;
+    }
+
+    // Server state is sent from scratch after reconnect, restart the client to accept it
+    if (chunk.isKeyFrame_ && client_->GetClientReplica())
+        client_->StartClient(this);
+    return true;
+}
+
+void NetworkReplayPlayer::DeliverMessages(unsigned timeMs)
+{
+    while (true)
+    {
+        if (chunkData_.IsEof())
+        {
+            if (nextChunkIndex_ >= chunks_.size() || chunks_[nextChunkIndex_].startTime_ > timeMs)
+                return;
+            if (!BeginChunk(nextChunkIndex_))
+                return;
+            continue;
+        }
+
+        const unsigned messagePosition = chunkData_.GetPosition();
+        const unsigned messageTime = chunkData_.ReadUInt();
+        if (messageTime > timeMs)
+        {
+            chunkData_.Seek(messagePosition);
+            return;
+        }
+
+        const auto messageId = static_cast<NetworkMessageId>(chunkData_.ReadVLE());
+        chunkData_.ReadBuffer(messageData_);
+
+        MemoryBuffer messageData{messageData_};
+        client_->ProcessMessage(this, messageId, messageData);
+        if (!client_)
+            return;
+    }
+}
+
+}
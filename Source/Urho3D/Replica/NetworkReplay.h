@@ -0,0 +1,195 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/// \file
+
+#pragma once
+
+#include "../Container/ByteVector.h"
+#include "../Network/AbstractConnection.h"
+
+#include <EASTL/optional.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class Deserializer;
+class ReplicationManager;
+class Serializer;
+
+/// Chunk of recorded replication messages.
+struct NetworkReplayChunk
+{
+    /// Replay time of the first message in the chunk, in milliseconds.
+    unsigned startTime_{};
+    /// Whether the chunk starts new replication session with full scene state.
+    bool isKeyFrame_{};
+    /// Offset of compressed chunk data in the replay stream.
+    unsigned offset_{};
+    /// Size of compressed chunk data.
+    unsigned compressedSize_{};
+    /// Size of uncompressed chunk data.
+    unsigned uncompressedSize_{};
+    /// Compressed chunk data. Only present in loaded replay.
+    ByteVector compressedData_;
+};
+
+/// Records replication messages sent by server into the replay stream.
+/// Recorder is added to ServerReplicator as a spectator connection.
+///
+/// Replay stream consists of compressed chunks of messages followed by chunk index.
+/// Every key frame interval the recorder reconnects to the server, so the next chunk starts
+/// with full scene state and can be used as seek point during playback.
+class URHO3D_API NetworkReplayRecorder : public AbstractConnection
+{
+    URHO3D_OBJECT(NetworkReplayRecorder, AbstractConnection);
+
+public:
+    explicit NetworkReplayRecorder(ReplicationManager* server);
+    ~NetworkReplayRecorder() override;
+
+    /// Start recording into the destination. Destination should stay alive until recording is stopped.
+    bool StartRecording(Serializer* dest);
+    /// Stop recording, write chunk index and disconnect from server.
+    void StopRecording();
+    /// Advance recording time. Called automatically on update.
+    void Update(float timeStep);
+
+    /// Set interval between key frames in seconds. Zero disables key frames.
+    void SetKeyFrameInterval(float interval) { keyFrameInterval_ = interval; }
+    /// Set max size of uncompressed chunk in bytes.
+    void SetMaxChunkSize(unsigned size) { maxChunkSize_ = size; }
+
+    /// Return properties of the recorder.
+    /// @{
+    bool IsRecording() const { return dest_ != nullptr; }
+    float GetKeyFrameInterval() const { return keyFrameInterval_; }
+    unsigned GetMaxChunkSize() const { return maxChunkSize_; }
+    unsigned GetNumChunks() const { return chunks_.size(); }
+    float GetRecordingTime() const { return currentTime_; }
+    /// @}
+
+    /// Implement AbstractConnection.
+    /// @{
+    void SendMessageInternal(NetworkMessageId messageId, bool reliable, bool inOrder, const unsigned char* data,
+        unsigned numBytes) override;
+    ea::string ToString() const override { return "Replay Recorder"; }
+    bool IsClockSynchronized() const override { return true; }
+    unsigned RemoteToLocalTime(unsigned time) const override { return time; }
+    unsigned LocalToRemoteTime(unsigned time) const override { return time; }
+    unsigned GetLocalTime() const override { return GetCurrentTimeMs(); }
+    unsigned GetLocalTimeOfLatestRoundtrip() const override { return GetCurrentTimeMs(); }
+    unsigned GetPing() const override { return 0; }
+    /// @}
+
+private:
+    unsigned GetCurrentTimeMs() const { return static_cast<unsigned>(RoundToInt(currentTime_ * 1000.0f)); }
+    void Connect();
+    void Disconnect();
+    void WriteMessage(NetworkMessageId messageId, const unsigned char* data, unsigned numBytes);
+    void FlushChunk();
+
+    WeakPtr<ReplicationManager> server_;
+    Serializer* dest_{};
+
+    float keyFrameInterval_{10.0f};
+    unsigned maxChunkSize_{64 * 1024};
+
+    bool isConnected_{};
+    float currentTime_{};
+    float keyFrameTime_{};
+    ea::optional<unsigned> pendingSynchronization_;
+
+    bool isNextChunkKeyFrame_{};
+    ea::optional<unsigned> chunkStartTime_;
+    VectorBuffer chunkData_;
+    ea::vector<NetworkReplayChunk> chunks_;
+    unsigned numBytesWritten_{};
+};
+
+/// Plays back replay stream recorded by NetworkReplayRecorder through client ReplicationManager.
+/// Player acts as the connection to the server.
+class URHO3D_API NetworkReplayPlayer : public AbstractConnection
+{
+    URHO3D_OBJECT(NetworkReplayPlayer, AbstractConnection);
+
+public:
+    explicit NetworkReplayPlayer(ReplicationManager* client);
+    ~NetworkReplayPlayer() override;
+
+    /// Load replay stream. Chunks are kept compressed in memory and decompressed on demand.
+    bool Load(Deserializer& source);
+    /// Advance playback time. Called automatically on update.
+    void Update(float timeStep);
+    /// Seek to the time in seconds. Playback restarts from the closest preceding key frame.
+    void Seek(float time);
+
+    /// Set whether playback is paused.
+    void SetPaused(bool paused) { paused_ = paused; }
+    /// Set playback speed multiplier.
+    void SetSpeed(float speed) { speed_ = ea::max(0.0f, speed); }
+
+    /// Return properties of the player.
+    /// @{
+    bool IsPaused() const { return paused_; }
+    bool IsFinished() const { return nextChunkIndex_ >= chunks_.size() && chunkData_.IsEof(); }
+    float GetSpeed() const { return speed_; }
+    float GetPlaybackTime() const { return currentTime_; }
+    float GetDuration() const { return duration_; }
+    unsigned GetNumChunks() const { return chunks_.size(); }
+    unsigned GetNumKeyFrames() const;
+    /// @}
+
+    /// Implement AbstractConnection.
+    /// @{
+    void SendMessageInternal(NetworkMessageId messageId, bool reliable, bool inOrder, const unsigned char* data,
+        unsigned numBytes) override {}
+    ea::string ToString() const override { return "Replay Player"; }
+    bool IsClockSynchronized() const override { return true; }
+    unsigned RemoteToLocalTime(unsigned time) const override { return time; }
+    unsigned LocalToRemoteTime(unsigned time) const override { return time; }
+    unsigned GetLocalTime() const override { return GetCurrentTimeMs(); }
+    unsigned GetLocalTimeOfLatestRoundtrip() const override { return GetCurrentTimeMs(); }
+    unsigned GetPing() const override { return 0; }
+    /// @}
+
+private:
+    unsigned GetCurrentTimeMs() const { return static_cast<unsigned>(RoundToInt(currentTime_ * 1000.0f)); }
+    bool BeginChunk(unsigned index);
+    void DeliverMessages(unsigned timeMs);
+
+    WeakPtr<ReplicationManager> client_;
+
+    ea::vector<NetworkReplayChunk> chunks_;
+    float duration_{};
+
+    bool paused_{};
+    float speed_{1.0f};
+    float currentTime_{};
+
+    unsigned nextChunkIndex_{};
+    VectorBuffer chunkData_;
+    ByteVector messageData_;
+};
+
+}
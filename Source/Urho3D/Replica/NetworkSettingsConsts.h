@@ -103,6 +103,16 @@ URHO3D_NETWORK_SETTING(InputBufferingMin, unsigned, 0);
 URHO3D_NETWORK_SETTING(InputBufferingMax, unsigned, 8);
 /// Interval in seconds between NetworkObject becoming unneeded for client and replication stopped.
 URHO3D_NETWORK_SETTING(RelevanceTimeout, float, 5.0f);
+/// Cell size of the grid used to find NetworkObjects with interest radius that may be relevant for the client.
+/// Set to zero to disable the grid and evaluate relevance of all objects for all clients.
+URHO3D_NETWORK_SETTING(InterestGridCellSize, float, 32.0f);
+/// Max size in bytes of unreliable update message sent to each client per frame.
+/// If limited, objects are sent in order of accumulated priority and postponed updates are sent in later frames.
+/// Set to zero to send all updates according to their relevance.
+URHO3D_NETWORK_SETTING(UnreliableUpdateBudget, unsigned, 0);
+/// Max age in frames of unreliable update acknowledged by the client that can be used as baseline for delta compression.
+/// Cannot exceed 32 frames. Set to zero to disable delta compression of unreliable updates.
+URHO3D_NETWORK_SETTING(UnreliableDeltaWindow, unsigned, 0);
 /// Duration in seconds of value tracking on server. Used for lag compensation.
 URHO3D_NETWORK_SETTING(ServerTracingDuration, float, 5.0f);
 
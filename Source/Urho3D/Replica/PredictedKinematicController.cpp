@@ -33,6 +33,7 @@
 #include "../Scene/Node.h"
 #include "../Scene/Scene.h"
 #include "../Network/NetworkEvents.h"
+#include "../Replica/ClientReplica.h"
 #include "../Replica/NetworkSettingsConsts.h"
 #include "../Replica/ReplicatedTransform.h"
 
@@ -167,7 +168,11 @@ void PredictedKinematicController::InterpolateState(float replicaTimeStep, float
     }
     else
     {
-        client_.desiredRedundancy_ = ea::max(1, FloorToInt(inputTime - replicaTime));
+        ReplicationManager* replicationManager = networkObject->GetReplicationManager();
+        if (ClientReplica* clientReplica = replicationManager->GetClientReplica())
+            client_.desiredRedundancy_ = clientReplica->GetInputRedundancy();
+        else
+            client_.desiredRedundancy_ = ea::max(1, FloorToInt(inputTime - replicaTime));
     }
 }
 
@@ -213,16 +218,23 @@ void PredictedKinematicController::WriteUnreliableFeedback(NetworkFrame frame, S
     const unsigned maxSize = client_.input_.size();
     const unsigned inputBufferSize = ea::min({client_.desiredRedundancy_, maxRedundancy_, maxSize});
 
+    // Each frame is delta-compressed against the next one, most of redundant frames are usually identical
     dest.WriteVLE(inputBufferSize);
+    const InputFrame* baseFrame = nullptr;
     ea::for_each_n(client_.input_.rbegin(), inputBufferSize,
-        [&](const InputFrame& inputFrame) { WriteInputFrame(inputFrame, dest); });
+        [&](const InputFrame& inputFrame)
+    {
+        WriteInputFrame(inputFrame, baseFrame, dest);
+        baseFrame = &inputFrame;
+    });
 }
 
 void PredictedKinematicController::ReadUnreliableFeedback(NetworkFrame feedbackFrame, Deserializer& src)
 {
     const unsigned numInputFrames = ea::min(src.ReadVLE(), maxRedundancy_);
+    InputFrame baseFrame;
     for (unsigned i = 0; i < numInputFrames; ++i)
-        ReadInputFrame(feedbackFrame - i, src);
+        baseFrame = ReadInputFrame(feedbackFrame - i, baseFrame, src);
 }
 
 void PredictedKinematicController::OnServerFrameBegin(NetworkFrame serverFrame)
@@ -370,27 +382,43 @@ void PredictedKinematicController::TrackCurrentInput(NetworkFrame frame)
     client_.input_.push_back(currentInput);
 }
 
-void PredictedKinematicController::WriteInputFrame(const InputFrame& inputFrame, Serializer& dest) const
+void PredictedKinematicController::WriteInputFrame(
+    const InputFrame& inputFrame, const InputFrame* baseFrame, Serializer& dest) const
 {
-    dest.WriteVector3(inputFrame.walkVelocity_);
-    dest.WriteBool(inputFrame.needJump_);
-    dest.WriteQuaternion(inputFrame.rotation_);
+    // Walk velocity and rotation are skipped if same as in base frame, jump flag is packed into the mask
+    const bool isFullFrame = baseFrame == nullptr;
+    const bool hasWalkVelocity = isFullFrame || inputFrame.walkVelocity_ != baseFrame->walkVelocity_;
+    const bool hasRotation = isFullFrame || inputFrame.rotation_ != baseFrame->rotation_;
+
+    unsigned char mask = 0;
+    if (hasWalkVelocity)
+        mask |= InputFrameWalkVelocity;
+    if (hasRotation)
+        mask |= InputFrameRotation;
+    if (inputFrame.needJump_)
+        mask |= InputFrameJump;
+
+    dest.WriteUByte(mask);
+    if (hasWalkVelocity)
+        dest.WriteVector3(inputFrame.walkVelocity_);
+    if (hasRotation)
+        dest.WriteQuaternion(inputFrame.rotation_);
 }
 
-void PredictedKinematicController::ReadInputFrame(NetworkFrame frame, Deserializer& src)
+PredictedKinematicController::InputFrame PredictedKinematicController::ReadInputFrame(
+    NetworkFrame frame, const InputFrame& baseFrame, Deserializer& src)
 {
-    const Vector3 walkVelocity = src.ReadVector3();
-    const bool needJump = src.ReadBool();
-    const Quaternion rotation = src.ReadQuaternion();
+    const unsigned char mask = src.ReadUByte();
 
     InputFrame inputFrame;
     inputFrame.frame_ = frame;
-    inputFrame.walkVelocity_ = walkVelocity;
-    inputFrame.needJump_ = needJump;
-    inputFrame.rotation_ = rotation;
+    inputFrame.walkVelocity_ = (mask & InputFrameWalkVelocity) ? src.ReadVector3() : baseFrame.walkVelocity_;
+    inputFrame.rotation_ = (mask & InputFrameRotation) ? src.ReadQuaternion() : baseFrame.rotation_;
+    inputFrame.needJump_ = (mask & InputFrameJump) != 0;
 
     if (!server_.input_.Has(frame))
         server_.input_.Set(frame, inputFrame);
+    return inputFrame;
 }
 
 }
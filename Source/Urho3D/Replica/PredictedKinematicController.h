@@ -79,6 +79,14 @@ public:
     /// @}
 
 private:
+    /// Bits of input frame mask.
+    enum InputFrameMask : unsigned char
+    {
+        InputFrameWalkVelocity = 1 << 0,
+        InputFrameRotation = 1 << 1,
+        InputFrameJump = 1 << 2,
+    };
+
     struct InputFrame
     {
         bool isLost_{};
@@ -100,8 +108,8 @@ private:
     void ApplyActionsOnClient();
     void UpdateEffectiveVelocity(float timeStep);
 
-    void WriteInputFrame(const InputFrame& inputFrame, Serializer& dest) const;
-    void ReadInputFrame(NetworkFrame frame, Deserializer& src);
+    void WriteInputFrame(const InputFrame& inputFrame, const InputFrame* baseFrame, Serializer& dest) const;
+    InputFrame ReadInputFrame(NetworkFrame frame, const InputFrame& baseFrame, Deserializer& src);
 
     WeakPtr<ReplicatedTransform> replicatedTransform_;
     WeakPtr<KinematicCharacterController> kinematicController_;
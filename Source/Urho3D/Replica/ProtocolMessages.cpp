@@ -82,4 +82,132 @@ ea::string MsgSceneClock::ToString() const
     return Format("{{latestFrame={} at {}, inputDelay={}}}", latestFrame_, latestFrameTime_, inputDelay_);
 }
 
+void ReceivedFramesMask::Add(NetworkFrame frame)
+{
+    if (!latestFrame_ || frame > *latestFrame_)
+    {
+        const long long offset = latestFrame_ ? frame - *latestFrame_ : MaxUnreliableDeltaWindow;
+        mask_ = offset < MaxUnreliableDeltaWindow ? (mask_ << offset) | 1u : 1u;
+        latestFrame_ = frame;
+    }
+    else
+    {
+        const long long offset = *latestFrame_ - frame;
+        if (offset < MaxUnreliableDeltaWindow)
+            mask_ |= 1u << offset;
+    }
+}
+
+void ReceivedFramesMask::Merge(const ReceivedFramesMask& other)
+{
+    if (other.latestFrame_ && (!latestFrame_ || *other.latestFrame_ >= *latestFrame_))
+        *this = other;
+}
+
+bool ReceivedFramesMask::Contains(NetworkFrame frame) const
+{
+    if (!latestFrame_ || frame > *latestFrame_)
+        return false;
+
+    const long long offset = *latestFrame_ - frame;
+    return offset < MaxUnreliableDeltaWindow && (mask_ & (1u << offset)) != 0;
+}
+
+void ReceivedFramesMask::Save(Serializer& dest) const
+{
+    dest.WriteBool(latestFrame_.has_value());
+    if (latestFrame_)
+    {
+        dest.WriteInt64(static_cast<long long>(*latestFrame_));
+        dest.WriteUInt(mask_);
+    }
+}
+
+void ReceivedFramesMask::Load(Deserializer& src)
+{
+    latestFrame_ = ea::nullopt;
+    mask_ = 0;
+    if (src.ReadBool())
+    {
+        latestFrame_ = static_cast<NetworkFrame>(src.ReadInt64());
+        mask_ = src.ReadUInt();
+    }
+}
+
+void StoreDeltaBaseline(
+    ea::vector<UnreliableDeltaBaseline>& history, NetworkFrame frame, ConstByteSpan data, unsigned window)
+{
+    // Updates may arrive out of order, so keep history sorted and never discard newer baselines
+    const auto isNotOlder = [&](const UnreliableDeltaBaseline& baseline) { return baseline.frame_ - frame >= 0; };
+    const auto iter = ea::find_if(history.begin(), history.end(), isNotOlder);
+    if (iter != history.end() && iter->frame_ == frame)
+        iter->data_.assign(data.begin(), data.end());
+    else
+        history.insert(iter, UnreliableDeltaBaseline{frame, ByteVector(data.begin(), data.end())});
+
+    const NetworkFrame latestFrame = history.back().frame_;
+    const auto isExpired = [&](const UnreliableDeltaBaseline& baseline)
+    {
+        const long long age = latestFrame - baseline.frame_;
+        return age >= window;
+    };
+    history.erase(ea::remove_if(history.begin(), history.end(), isExpired), history.end());
+}
+
+void EncodeDeltaAgainstBaseline(ConstByteSpan baseline, ConstByteSpan data, Serializer& dest)
+{
+    const auto size = static_cast<unsigned>(data.size());
+    dest.WriteVLE(size);
+
+    unsigned index = 0;
+    while (index < size)
+    {
+        const unsigned char baselineByte = index < baseline.size() ? baseline[index] : 0;
+        const unsigned char delta = data[index] ^ baselineByte;
+        if (delta != 0)
+        {
+            dest.WriteUByte(delta);
+            ++index;
+            continue;
+        }
+
+        unsigned runLength = 0;
+        while (index < size && data[index] == (index < baseline.size() ? baseline[index] : 0))
+        {
+            ++runLength;
+            ++index;
+        }
+
+        dest.WriteUByte(0);
+        dest.WriteVLE(runLength);
+    }
+}
+
+bool DecodeDeltaAgainstBaseline(ConstByteSpan baseline, Deserializer& src, ByteVector& result)
+{
+    const unsigned size = src.ReadVLE();
+    result.clear();
+    result.reserve(size);
+
+    while (result.size() < size)
+    {
+        if (src.IsEof())
+            return false;
+
+        const unsigned char delta = src.ReadUByte();
+        const unsigned runLength = delta != 0 ? 1 : src.ReadVLE();
+        if (runLength == 0 || result.size() + runLength > size)
+            return false;
+
+        for (unsigned i = 0; i < runLength; ++i)
+        {
+            const unsigned index = result.size();
+            const unsigned char baselineByte = index < baseline.size() ? baseline[index] : 0;
+            result.push_back(baselineByte ^ delta);
+        }
+    }
+
+    return true;
+}
+
 }
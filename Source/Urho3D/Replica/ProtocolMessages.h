@@ -68,4 +68,39 @@ struct MsgSceneClock
     ea::string ToString() const;
 };
 
+/// Max number of frames that can be acknowledged by client in single feedback message.
+static constexpr unsigned MaxUnreliableDeltaWindow = 32;
+
+/// Unreliable update of NetworkObject that may be used as baseline for delta compression.
+struct UnreliableDeltaBaseline
+{
+    NetworkFrame frame_{};
+    ByteVector data_;
+};
+
+/// Set of recent frames of unreliable updates received by the client.
+struct ReceivedFramesMask
+{
+    ea::optional<NetworkFrame> latestFrame_;
+    unsigned mask_{};
+
+    /// Mark frame as received.
+    void Add(NetworkFrame frame);
+    /// Merge newer state received from the client.
+    void Merge(const ReceivedFramesMask& other);
+    /// Return whether the frame is known to be received.
+    bool Contains(NetworkFrame frame) const;
+
+    void Save(Serializer& dest) const;
+    void Load(Deserializer& src);
+};
+
+/// Add baseline to history sorted by frame and discard baselines older than window relative to the latest one.
+URHO3D_API void StoreDeltaBaseline(
+    ea::vector<UnreliableDeltaBaseline>& history, NetworkFrame frame, ConstByteSpan data, unsigned window);
+/// Encode data as XOR difference with baseline, runs of zero bytes are packed.
+URHO3D_API void EncodeDeltaAgainstBaseline(ConstByteSpan baseline, ConstByteSpan data, Serializer& dest);
+/// Decode data encoded by EncodeDeltaAgainstBaseline. Return false if encoded data is malformed.
+URHO3D_API bool DecodeDeltaAgainstBaseline(ConstByteSpan baseline, Deserializer& src, ByteVector& result);
+
 }
@@ -23,6 +23,7 @@
 #include "../Precompiled.h"
 
 #include "../Core/Context.h"
+#include "../IO/BitStream.h"
 #include "../Network/NetworkEvents.h"
 #include "../Replica/ReplicatedTransform.h"
 #include "../Replica/NetworkSettingsConsts.h"
@@ -39,6 +40,23 @@ const StringVector replicatedRotationModeNames = {
     //"Y"
 };
 
+/// Write vector quantized in symmetric range, or full precision vector if it is out of range.
+void WriteQuantizedOrFullVector3(BitStreamWriter& dest, const Vector3& value, float range, unsigned numBits)
+{
+    const bool isInRange = Abs(value.x_) <= range && Abs(value.y_) <= range && Abs(value.z_) <= range;
+    dest.WriteBool(isInRange);
+    if (isInRange)
+        dest.WriteQuantizedVector3(value, -range, range, numBits);
+    else
+        dest.WriteVector3(value);
+}
+
+Vector3 ReadQuantizedOrFullVector3(BitStreamReader& src, float range, unsigned numBits)
+{
+    const bool isInRange = src.ReadBool();
+    return isInRange ? src.ReadQuantizedVector3(-range, range, numBits) : src.ReadVector3();
+}
+
 }
 
 ReplicatedTransform::ReplicatedTransform(Context* context)
@@ -68,6 +86,10 @@ void ReplicatedTransform::RegisterObject(Context* context)
     URHO3D_ENUM_ATTRIBUTE("Synchronize Rotation", synchronizeRotation_, replicatedRotationModeNames, DefaultSynchronizeRotation, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Extrapolate Position", bool, extrapolatePosition_, DefaultExtrapolatePosition, AM_DEFAULT);
     URHO3D_ATTRIBUTE("Extrapolate Rotation", bool, extrapolateRotation_, DefaultExtrapolateRotation, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Compress Transform", bool, compressTransform_, DefaultCompressTransform, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Position Range", float, positionRange_, DefaultPositionRange, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Position Precision", float, positionPrecision_, DefaultPositionPrecision, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Rotation Bits", unsigned, rotationBits_, DefaultRotationBits, AM_DEFAULT);
 }
 
 void ReplicatedTransform::InitializeOnServer()
@@ -95,7 +117,15 @@ void ReplicatedTransform::WriteSnapshot(NetworkFrame frame, Serializer& dest)
     flags[1] = synchronizeRotation_ != ReplicatedRotationMode::None;
     flags[2] = extrapolatePosition_;
     flags[3] = extrapolateRotation_;
+    flags[4] = compressTransform_;
     dest.WriteVLE(flags.to_uint32());
+
+    if (compressTransform_)
+    {
+        dest.WriteFloat(positionRange_);
+        dest.WriteFloat(positionPrecision_);
+        dest.WriteVLE(rotationBits_);
+    }
 }
 
 void ReplicatedTransform::InitializeFromSnapshot(NetworkFrame frame, Deserializer& src, bool isOwned)
@@ -107,6 +137,14 @@ void ReplicatedTransform::InitializeFromSnapshot(NetworkFrame frame, Deserialize
     synchronizeRotation_ = flags[1] ? ReplicatedRotationMode::XYZ : ReplicatedRotationMode::None;
     extrapolatePosition_ = flags[2];
     extrapolateRotation_ = flags[3];
+    compressTransform_ = flags[4];
+
+    if (compressTransform_)
+    {
+        positionRange_ = src.ReadFloat();
+        positionPrecision_ = src.ReadFloat();
+        rotationBits_ = src.ReadVLE();
+    }
 
     const auto replicationManager = GetNetworkObject()->GetReplicationManager();
     const unsigned updateFrequency = replicationManager->GetUpdateFrequency();
@@ -196,6 +234,12 @@ bool ReplicatedTransform::PrepareUnreliableDelta(NetworkFrame frame)
 
 void ReplicatedTransform::WriteUnreliableDelta(NetworkFrame frame, Serializer& dest)
 {
+    if (compressTransform_)
+    {
+        WriteCompressedDelta(dest);
+        return;
+    }
+
     if (synchronizePosition_)
     {
         dest.WriteVector3(server_.position_);
@@ -211,6 +255,12 @@ void ReplicatedTransform::WriteUnreliableDelta(NetworkFrame frame, Serializer& d
 
 void ReplicatedTransform::ReadUnreliableDelta(NetworkFrame frame, Deserializer& src)
 {
+    if (compressTransform_)
+    {
+        ReadCompressedDelta(frame, src);
+        return;
+    }
+
     if (synchronizePosition_)
     {
         const Vector3 position = src.ReadVector3();
@@ -228,6 +278,51 @@ void ReplicatedTransform::ReadUnreliableDelta(NetworkFrame frame, Deserializer&
     }
 }
 
+unsigned ReplicatedTransform::GetPositionBits() const
+{
+    return ea::max(1u, GetNumQuantizationBits(2.0f * positionRange_, positionPrecision_));
+}
+
+void ReplicatedTransform::WriteCompressedDelta(Serializer& dest) const
+{
+    BitStreamWriter writer(dest);
+
+    if (synchronizePosition_)
+    {
+        const unsigned positionBits = GetPositionBits();
+        WriteQuantizedOrFullVector3(writer, server_.position_, positionRange_, positionBits);
+        WriteQuantizedOrFullVector3(writer, server_.velocity_, positionRange_, positionBits);
+    }
+
+    if (synchronizeRotation_ == ReplicatedRotationMode::XYZ)
+    {
+        writer.WriteQuantizedQuaternion(server_.rotation_, rotationBits_);
+        WriteQuantizedOrFullVector3(writer, server_.angularVelocity_, AngularVelocityRange, rotationBits_);
+    }
+}
+
+void ReplicatedTransform::ReadCompressedDelta(NetworkFrame frame, Deserializer& src)
+{
+    BitStreamReader reader(src);
+
+    if (synchronizePosition_)
+    {
+        const unsigned positionBits = GetPositionBits();
+        const Vector3 position = ReadQuantizedOrFullVector3(reader, positionRange_, positionBits);
+        const Vector3 velocity = ReadQuantizedOrFullVector3(reader, positionRange_, positionBits);
+
+        positionTrace_.Set(frame, {position, velocity});
+    }
+
+    if (synchronizeRotation_ == ReplicatedRotationMode::XYZ)
+    {
+        const Quaternion rotation = reader.ReadQuantizedQuaternion(rotationBits_);
+        const Vector3 angularVelocity = ReadQuantizedOrFullVector3(reader, AngularVelocityRange, rotationBits_);
+
+        rotationTrace_.Set(frame, {rotation, angularVelocity});
+    }
+}
+
 PositionAndVelocity ReplicatedTransform::SampleTemporalPosition(const NetworkTime& time) const
 {
     return positionTrace_.SampleValid(time);
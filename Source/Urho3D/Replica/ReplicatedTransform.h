@@ -59,6 +59,11 @@ public:
     static constexpr ReplicatedRotationMode DefaultSynchronizeRotation = ReplicatedRotationMode::XYZ;
     static constexpr bool DefaultExtrapolatePosition = true;
     static constexpr bool DefaultExtrapolateRotation = false;
+    static constexpr bool DefaultCompressTransform = false;
+    static constexpr float DefaultPositionRange = 1024.0f;
+    static constexpr float DefaultPositionPrecision = 0.001f;
+    static constexpr unsigned DefaultRotationBits = 12;
+    static constexpr float AngularVelocityRange = 6.2831853f;
 
     static constexpr NetworkCallbackFlags CallbackMask =
         NetworkCallbackMask::UpdateTransformOnServer | NetworkCallbackMask::UnreliableDelta | NetworkCallbackMask::InterpolateState;
@@ -91,6 +96,14 @@ public:
     bool GetExtrapolatePosition() const { return extrapolatePosition_; }
     void SetExtrapolateRotation(bool value) { extrapolateRotation_ = value; }
     bool GetExtrapolateRotation() const { return extrapolateRotation_; }
+    void SetCompressTransform(bool value) { compressTransform_ = value; }
+    bool GetCompressTransform() const { return compressTransform_; }
+    void SetPositionRange(float value) { positionRange_ = value; }
+    float GetPositionRange() const { return positionRange_; }
+    void SetPositionPrecision(float value) { positionPrecision_ = value; }
+    float GetPositionPrecision() const { return positionPrecision_; }
+    void SetRotationBits(unsigned value) { rotationBits_ = value; }
+    unsigned GetRotationBits() const { return rotationBits_; }
 
     /// Implement NetworkBehavior.
     /// @{
@@ -118,6 +131,9 @@ public:
 private:
     void InitializeCommon();
     void OnServerFrameEnd(NetworkFrame frame);
+    void WriteCompressedDelta(Serializer& dest) const;
+    void ReadCompressedDelta(NetworkFrame frame, Deserializer& src);
+    unsigned GetPositionBits() const;
 
     /// Attributes independent on the client and the server.
     /// @{
@@ -136,6 +152,10 @@ private:
     ReplicatedRotationMode synchronizeRotation_{DefaultSynchronizeRotation};
     bool extrapolatePosition_{DefaultExtrapolatePosition};
     bool extrapolateRotation_{DefaultExtrapolateRotation};
+    bool compressTransform_{DefaultCompressTransform};
+    float positionRange_{DefaultPositionRange};
+    float positionPrecision_{DefaultPositionPrecision};
+    unsigned rotationBits_{DefaultRotationBits};
     /// @}
 
     NetworkValue<PositionAndVelocity> positionTrace_;
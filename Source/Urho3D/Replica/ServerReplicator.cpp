@@ -26,6 +26,7 @@
 #include <Urho3D/Core/CoreEvents.h>
 #include <Urho3D/Core/Exception.h>
 #include <Urho3D/Core/Timer.h>
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/IO/Log.h>
 #include <Urho3D/Math/RandomEngine.h>
 #include <Urho3D/Network/Connection.h>
@@ -51,6 +52,18 @@ unsigned GetIndex(NetworkId networkId)
     return DeconstructComponentReference(networkId).first;
 }
 
+template <class T>
+void ForEachClientParallel(WorkQueue* workQueue, const ea::vector<ClientReplicationState*>& clientStates, const T& callback)
+{
+    if (workQueue && workQueue->GetNumThreads() > 0)
+        ForEachParallel(workQueue, clientStates, [&](unsigned, ClientReplicationState* clientState) { callback(clientState); });
+    else
+    {
+        for (ClientReplicationState* clientState : clientStates)
+            callback(clientState);
+    }
+}
+
 } // namespace
 
 SharedReplicationState::SharedReplicationState(NetworkObjectRegistry* objectRegistry)
@@ -74,6 +87,7 @@ void SharedReplicationState::OnNetworkObjectRemoved(NetworkObject* networkObject
 {
     if (recentlyAddedObjects_.erase(networkObject->GetNetworkId()) == 0)
         recentlyRemovedObjects_.insert(networkObject->GetNetworkId());
+    interestGrid_.RemoveObject(GetIndex(networkObject->GetNetworkId()));
 
     if (AbstractConnection* ownerConnection = networkObject->GetOwnerConnection())
     {
@@ -84,13 +98,55 @@ void SharedReplicationState::OnNetworkObjectRemoved(NetworkObject* networkObject
     }
 }
 
-void SharedReplicationState::PrepareForUpdate()
+void SharedReplicationState::PrepareForUpdate(float interestGridCellSize)
 {
     ResetFrameBuffers();
     InitializeNewObjects();
 
     objectRegistry_->UpdateNetworkObjects();
     objectRegistry_->GetSortedNetworkObjects(sortedNetworkObjects_);
+
+    // Relevance is evaluated from worker threads, make sure that it doesn't update cached transforms
+    for (NetworkObject* networkObject : sortedNetworkObjects_)
+        networkObject->GetNode()->GetWorldTransform();
+
+    UpdateInterestGrid(interestGridCellSize);
+}
+
+void SharedReplicationState::UpdateInterestGrid(float cellSize)
+{
+    const unsigned numObjects = sortedNetworkObjects_.size();
+
+    sortedPositionByIndex_.clear();
+    sortedPositionByIndex_.resize(GetIndexUpperBound(), M_MAX_UNSIGNED);
+    for (unsigned position = 0; position < numObjects; ++position)
+        sortedPositionByIndex_[GetIndex(sortedNetworkObjects_[position]->GetNetworkId())] = position;
+
+    untrackedObjects_.clear();
+
+    const bool enabled = cellSize > 0.0f;
+    if (enabled != interestGridEnabled_ || (enabled && cellSize != interestGrid_.GetCellSize()))
+    {
+        interestGridEnabled_ = enabled;
+        interestGrid_.Reset(cellSize);
+    }
+
+    if (!interestGridEnabled_)
+        return;
+
+    // Objects only move between cells when they cross cell boundary, so the update is cheap
+    for (unsigned position = 0; position < numObjects; ++position)
+    {
+        NetworkObject* networkObject = sortedNetworkObjects_[position];
+        const unsigned index = GetIndex(networkObject->GetNetworkId());
+        if (const auto radius = networkObject->GetInterestRadius())
+            interestGrid_.UpdateObject(index, networkObject->GetNode()->GetWorldPosition(), *radius);
+        else
+        {
+            interestGrid_.RemoveObject(index);
+            untrackedObjects_.push_back(position);
+        }
+    }
 }
 
 void SharedReplicationState::ResetFrameBuffers()
@@ -171,6 +227,16 @@ void SharedReplicationState::CookDeltaUpdates(NetworkFrame currentFrame)
     }
 }
 
+const NetworkInterestGrid* SharedReplicationState::GetInterestGrid() const
+{
+    return interestGridEnabled_ && !interestGrid_.IsEmpty() ? &interestGrid_ : nullptr;
+}
+
+unsigned SharedReplicationState::GetSortedPositionByIndex(unsigned index) const
+{
+    return index < sortedPositionByIndex_.size() ? sortedPositionByIndex_[index] : M_MAX_UNSIGNED;
+}
+
 unsigned SharedReplicationState::GetIndexUpperBound() const
 {
     return objectRegistry_->GetNetworkIndexUpperBound();
@@ -225,6 +291,11 @@ void ClientSynchronizationState::BeginNetworkFrame(NetworkFrame currentFrame, fl
     clockTimeAccumulator_ += timeStep;
 }
 
+void ClientSynchronizationState::SetSetting(const NetworkSetting& setting, const Variant& value)
+{
+    SetNetworkSetting(settings_, setting, value);
+}
+
 const Variant& ClientSynchronizationState::GetSetting(const NetworkSetting& setting) const
 {
     return GetNetworkSetting(settings_, setting);
@@ -307,9 +378,9 @@ bool ClientSynchronizationState::ProcessMessage(NetworkMessageId messageId, Memo
     }
 }
 
-void ClientSynchronizationState::OnInputReceived(NetworkFrame inputFrame)
+void ClientSynchronizationState::OnInputReceived(NetworkFrame inputFrame, unsigned numInputFrames)
 {
-    inputStats_.OnInputReceived(inputFrame);
+    inputStats_.OnInputReceived(inputFrame, numInputFrames);
 }
 
 unsigned ClientSynchronizationState::MakeMagic() const
@@ -323,19 +394,60 @@ ClientReplicationState::ClientReplicationState(
 {
 }
 
-void ClientReplicationState::SendMessages(NetworkFrame currentFrame, const SharedReplicationState& sharedState)
+void ClientReplicationState::GenerateMessages(NetworkFrame currentFrame, const SharedReplicationState& sharedState)
+{
+    removeObjectsMessage_.send_ = false;
+    updateObjectsReliableMessage_.send_ = false;
+    updateObjectsUnreliableMessage_.send_ = false;
+
+    if (IsSynchronized())
+    {
+        GenerateRemoveObjects();
+        GenerateUpdateObjectsReliable(sharedState);
+        GenerateUpdateObjectsUnreliable(currentFrame, sharedState);
+    }
+}
+
+void ClientReplicationState::SendMessages()
 {
     ClientSynchronizationState::SendMessages();
 
     if (IsSynchronized())
     {
-        SendRemoveObjects();
+        // Snapshots are written by user callbacks and therefore are generated here on the main thread
+        SendPendingMessage(MSG_REMOVE_OBJECTS, PT_RELIABLE_ORDERED, removeObjectsMessage_);
         SendAddObjects();
-        SendUpdateObjectsReliable(sharedState);
-        SendUpdateObjectsUnreliable(currentFrame, sharedState);
+        SendPendingMessage(MSG_UPDATE_OBJECTS_RELIABLE, PT_RELIABLE_ORDERED, updateObjectsReliableMessage_);
+        SendPendingMessage(MSG_UPDATE_OBJECTS_UNRELIABLE, PT_UNRELIABLE_UNORDERED, updateObjectsUnreliableMessage_);
     }
 }
 
+template <class T>
+void ClientReplicationState::GenerateMessage(PendingMessage& message, T generator)
+{
+#ifdef URHO3D_LOGGING
+    ea::string* debugInfoPtr = &message.debugInfo_;
+#else
+    ea::string* debugInfoPtr = nullptr;
+#endif
+
+    message.data_.Clear();
+    message.debugInfo_.clear();
+    message.send_ = generator(message.data_, debugInfoPtr);
+}
+
+void ClientReplicationState::SendPendingMessage(
+    NetworkMessageId messageId, PacketType messageType, const PendingMessage& message)
+{
+    if (!message.send_)
+        return;
+
+    const bool reliable = messageType == PT_RELIABLE_ORDERED || messageType == PT_RELIABLE_UNORDERED;
+    const bool inOrder = messageType == PT_RELIABLE_ORDERED || messageType == PT_UNRELIABLE_ORDERED;
+    connection_->SendLoggedMessage(messageId, reliable, inOrder, message.data_.GetData(), message.data_.GetSize(),
+        message.debugInfo_);
+}
+
 bool ClientReplicationState::ProcessMessage(NetworkMessageId messageId, MemoryBuffer& messageData)
 {
     if (ClientSynchronizationState::ProcessMessage(messageId, messageData))
@@ -362,7 +474,16 @@ void ClientReplicationState::ProcessObjectsFeedbackUnreliable(MemoryBuffer& mess
     }
 
     const auto feedbackFrame = static_cast<NetworkFrame>(messageData.ReadInt64());
-    OnInputReceived(feedbackFrame);
+    const unsigned maxInputRedundancy = GetSetting(NetworkSettings::MaxInputRedundancy).GetUInt();
+    const unsigned inputRedundancy = ea::min(messageData.ReadVLE(), maxInputRedundancy);
+    OnInputReceived(feedbackFrame, inputRedundancy);
+
+    if (GetSetting(NetworkSettings::UnreliableDeltaWindow).GetUInt() != 0)
+    {
+        ReceivedFramesMask receivedFrames;
+        receivedFrames.Load(messageData);
+        receivedUnreliableFrames_.Merge(receivedFrames);
+    }
 
     while (!messageData.IsEof())
     {
@@ -390,9 +511,9 @@ void ClientReplicationState::ProcessObjectsFeedbackUnreliable(MemoryBuffer& mess
     }
 }
 
-void ClientReplicationState::SendRemoveObjects()
+void ClientReplicationState::GenerateRemoveObjects()
 {
-    connection_->SendGeneratedMessage(MSG_REMOVE_OBJECTS, PT_RELIABLE_ORDERED,
+    GenerateMessage(removeObjectsMessage_,
         [&](VectorBuffer& msg, ea::string* debugInfo)
     {
         if (debugInfo)
@@ -447,9 +568,9 @@ void ClientReplicationState::SendAddObjects()
     });
 }
 
-void ClientReplicationState::SendUpdateObjectsReliable(const SharedReplicationState& sharedState)
+void ClientReplicationState::GenerateUpdateObjectsReliable(const SharedReplicationState& sharedState)
 {
-    connection_->SendGeneratedMessage(MSG_UPDATE_OBJECTS_RELIABLE, PT_RELIABLE_ORDERED,
+    GenerateMessage(updateObjectsReliableMessage_,
         [&](VectorBuffer& msg, ea::string* debugInfo)
     {
         msg.WriteInt64(static_cast<long long>(GetCurrentFrame()));
@@ -483,16 +604,70 @@ void ClientReplicationState::SendUpdateObjectsReliable(const SharedReplicationSt
     });
 }
 
-void ClientReplicationState::SendUpdateObjectsUnreliable(
+void ClientReplicationState::GenerateUpdateObjectsUnreliable(
     NetworkFrame currentFrame, const SharedReplicationState& sharedState)
 {
-    connection_->SendGeneratedMessage(MSG_UPDATE_OBJECTS_UNRELIABLE, PT_UNRELIABLE_UNORDERED,
+    const unsigned budget = GetSetting(NetworkSettings::UnreliableUpdateBudget).GetUInt();
+    const unsigned deltaWindow =
+        ea::min(GetSetting(NetworkSettings::UnreliableDeltaWindow).GetUInt(), MaxUnreliableDeltaWindow);
+    const NetworkFrame messageFrame = GetCurrentFrame();
+
+    GenerateMessage(updateObjectsUnreliableMessage_,
         [&](VectorBuffer& msg, ea::string* debugInfo)
     {
         bool sendMessage = false;
 
-        msg.WriteInt64(static_cast<long long>(GetCurrentFrame()));
+        msg.WriteInt64(static_cast<long long>(messageFrame));
+        const unsigned headerSize = msg.GetSize();
+
+        const auto writeUpdate = [&](NetworkObject* networkObject, ConstByteSpan updateSpan)
+        {
+            msg.WriteUInt(static_cast<unsigned>(networkObject->GetNetworkId()));
+            msg.WriteStringHash(networkObject->GetType());
+
+            if (deltaWindow != 0)
+            {
+                // Encode update against the latest baseline known to the client, if it makes update smaller
+                const unsigned index = GetIndex(networkObject->GetNetworkId());
+                if (const UnreliableDeltaBaseline* baseline = FindAcknowledgedBaseline(index, messageFrame, deltaWindow))
+                {
+                    deltaBuffer_.Clear();
+                    EncodeDeltaAgainstBaseline(baseline->data_, updateSpan, deltaBuffer_);
+                    if (deltaBuffer_.GetSize() < updateSpan.size())
+                    {
+                        msg.WriteVLE(static_cast<unsigned>(messageFrame - baseline->frame_));
+                        msg.WriteBuffer(deltaBuffer_.GetBuffer());
+                        return;
+                    }
+                }
+                msg.WriteVLE(0);
+            }
+
+            msg.WriteVLE(updateSpan.size());
+            msg.Write(updateSpan.data(), updateSpan.size());
+        };
+
+        const auto commitUpdate = [&](NetworkObject* networkObject, ConstByteSpan updateSpan)
+        {
+            sendMessage = true;
+            if (deltaWindow != 0)
+            {
+                const unsigned index = GetIndex(networkObject->GetNetworkId());
+                StoreDeltaBaseline(unreliableBaselines_[index], messageFrame, updateSpan, deltaWindow);
+            }
+        };
+
+        const auto writeDebugInfo = [&](NetworkObject* networkObject)
+        {
+            if (debugInfo)
+            {
+                if (!debugInfo->empty())
+                    debugInfo->append(", ");
+                debugInfo->append(ToString(networkObject->GetNetworkId()));
+            }
+        };
 
+        prioritizedUpdates_.clear();
         for (const auto& [networkObject, isSnapshot] : pendingUpdatedObjects_)
         {
             // Skip redundant updates, both if update is empty or if snapshot was already sent
@@ -509,28 +684,74 @@ void ClientReplicationState::SendUpdateObjectsUnreliable(
             if (relevance == NetworkObjectRelevance::NoUpdates)
                 continue;
 
-            if (static_cast<long long>(currentFrame) % static_cast<unsigned>(relevance) != 0)
-                continue;
+            if (budget == 0)
+            {
+                if (static_cast<long long>(currentFrame) % static_cast<unsigned>(relevance) != 0)
+                    continue;
 
-            sendMessage = true;
-            msg.WriteUInt(static_cast<unsigned>(networkObject->GetNetworkId()));
-            msg.WriteStringHash(networkObject->GetType());
+                writeUpdate(networkObject, *updateSpan);
+                commitUpdate(networkObject, *updateSpan);
+                writeDebugInfo(networkObject);
+            }
+            else
+            {
+                // Objects accumulate priority according to update period and are ready when priority reaches one
+                float& priority = objectsPriority_[index];
+                priority += 1.0f / static_cast<unsigned>(relevance);
+                if (priority >= 1.0f)
+                    prioritizedUpdates_.push_back({priority, networkObject});
+            }
+        }
 
-            msg.WriteVLE(updateSpan->size());
-            msg.Write(updateSpan->data(), updateSpan->size());
+        if (budget != 0)
+        {
+            // Send the most starved objects first, postpone updates that don't fit into the budget
+            ea::sort(prioritizedUpdates_.begin(), prioritizedUpdates_.end(),
+                [](const ea::pair<float, NetworkObject*>& lhs, const ea::pair<float, NetworkObject*>& rhs)
+            {
+                if (lhs.first != rhs.first)
+                    return lhs.first > rhs.first;
+                return lhs.second->GetNetworkId() < rhs.second->GetNetworkId();
+            });
 
-            if (debugInfo)
+            for (const auto& [priority, networkObject] : prioritizedUpdates_)
             {
-                if (!debugInfo->empty())
-                    debugInfo->append(", ");
-                debugInfo->append(ToString(networkObject->GetNetworkId()));
+                const unsigned index = GetIndex(networkObject->GetNetworkId());
+                const ConstByteSpan updateSpan = *sharedState.GetUnreliableUpdateByIndex(index);
+                const unsigned sizeBefore = msg.GetSize();
+                writeUpdate(networkObject, updateSpan);
+
+                // Oversized update is still sent if it's the only one
+                if (msg.GetSize() > budget && sizeBefore != headerSize)
+                {
+                    msg.Resize(sizeBefore);
+                    continue;
+                }
+
+                commitUpdate(networkObject, updateSpan);
+                objectsPriority_[index] = 0.0f;
+                writeDebugInfo(networkObject);
             }
         }
+
         return sendMessage;
     });
 }
 
-void ClientReplicationState::UpdateNetworkObjects(SharedReplicationState& sharedState)
+const UnreliableDeltaBaseline* ClientReplicationState::FindAcknowledgedBaseline(
+    unsigned index, NetworkFrame frame, unsigned window) const
+{
+    const auto& history = unreliableBaselines_[index];
+    for (auto iter = history.rbegin(); iter != history.rend(); ++iter)
+    {
+        const long long age = frame - iter->frame_;
+        if (age > 0 && age < window && receivedUnreliableFrames_.Contains(iter->frame_))
+            return &*iter;
+    }
+    return nullptr;
+}
+
+void ClientReplicationState::UpdateNetworkObjects(const SharedReplicationState& sharedState)
 {
     if (!IsSynchronized())
         return;
@@ -541,6 +762,8 @@ void ClientReplicationState::UpdateNetworkObjects(SharedReplicationState& shared
     const unsigned indexUpperBound = sharedState.GetIndexUpperBound();
     objectsRelevance_.resize(indexUpperBound, NetworkObjectRelevance::Irrelevant);
     objectsRelevanceTimeouts_.resize(indexUpperBound);
+    objectsPriority_.resize(indexUpperBound);
+    unreliableBaselines_.resize(indexUpperBound);
 
     pendingRemovedObjects_.clear();
     pendingUpdatedObjects_.clear();
@@ -556,52 +779,111 @@ void ClientReplicationState::UpdateNetworkObjects(SharedReplicationState& shared
         }
     }
 
-    // Process active components
-    for (NetworkObject* networkObject : sharedState.GetSortedObjects())
+    // Process active components. If possible, skip distant objects that cannot be relevant.
+    const ea::vector<NetworkObject*>& sortedObjects = sharedState.GetSortedObjects();
+    if (const NetworkInterestGrid* interestGrid = sharedState.GetInterestGrid())
     {
-        const NetworkId networkId = networkObject->GetNetworkId();
-        const NetworkId parentNetworkId = networkObject->GetParentNetworkId();
-        const unsigned index = GetIndex(networkId);
+        CollectInterestingObjects(sharedState, *interestGrid);
+        for (unsigned position : interestingObjects_)
+            UpdateNetworkObject(sortedObjects[position], timeStep, relevanceTimeout);
+    }
+    else
+    {
+        for (NetworkObject* networkObject : sortedObjects)
+            UpdateNetworkObject(networkObject, timeStep, relevanceTimeout);
+    }
+
+    relevantObjects_.clear();
+    for (const auto& [networkObject, isSnapshot] : pendingUpdatedObjects_)
+        relevantObjects_.push_back(GetIndex(networkObject->GetNetworkId()));
+}
+
+void ClientReplicationState::CollectInterestingObjects(
+    const SharedReplicationState& sharedState, const NetworkInterestGrid& interestGrid)
+{
+    // Objects outside of the grid may be relevant anywhere
+    interestingObjects_ = sharedState.GetUntrackedObjects();
 
-        const bool wasRelevant = objectsRelevance_[index] != NetworkObjectRelevance::Irrelevant;
-        const bool isParentRelevant = parentNetworkId == NetworkId::None
-            || objectsRelevance_[GetIndex(parentNetworkId)] != NetworkObjectRelevance::Irrelevant;
+    // Objects owned by the client are never filtered
+    interestingObjectIndices_.clear();
+    const auto& ownedObjects = sharedState.GetOwnedObjectsByConnection(connection_);
+    for (NetworkObject* networkObject : ownedObjects)
+        interestingObjectIndices_.push_back(GetIndex(networkObject->GetNetworkId()));
 
-        if (!wasRelevant && isParentRelevant)
+    // Relevant objects should be updated until they are removed
+    interestingObjectIndices_.insert(interestingObjectIndices_.end(), relevantObjects_.begin(), relevantObjects_.end());
+
+    // Objects in the grid are interesting only if they are close enough to any object owned by the client
+    const float radius = interestGrid.GetMaxRadius();
+    for (NetworkObject* networkObject : ownedObjects)
+        interestGrid.QueryObjects(networkObject->GetNode()->GetWorldPosition(), radius, interestingObjectIndices_);
+
+    for (unsigned index : interestingObjectIndices_)
+    {
+        const unsigned position = sharedState.GetSortedPositionByIndex(index);
+        if (position != M_MAX_UNSIGNED)
+            interestingObjects_.push_back(position);
+    }
+
+    // Keep the order of sorted objects so parents are processed before children
+    ea::sort(interestingObjects_.begin(), interestingObjects_.end());
+    interestingObjects_.erase(ea::unique(interestingObjects_.begin(), interestingObjects_.end()), interestingObjects_.end());
+}
+
+void ClientReplicationState::UpdateNetworkObject(NetworkObject* networkObject, float timeStep, float relevanceTimeout)
+{
+    const NetworkId networkId = networkObject->GetNetworkId();
+    const NetworkId parentNetworkId = networkObject->GetParentNetworkId();
+    const unsigned index = GetIndex(networkId);
+
+    const bool wasRelevant = objectsRelevance_[index] != NetworkObjectRelevance::Irrelevant;
+    const bool isParentRelevant = parentNetworkId == NetworkId::None
+        || objectsRelevance_[GetIndex(parentNetworkId)] != NetworkObjectRelevance::Irrelevant;
+
+    if (!wasRelevant && isParentRelevant)
+    {
+        // Begin replication of the object if both the object and its parent are relevant
+        objectsRelevance_[index] =
+            networkObject->GetRelevanceForClient(connection_).value_or(NetworkObjectRelevance::NormalUpdates);
+        if (objectsRelevance_[index] != NetworkObjectRelevance::Irrelevant)
         {
-            // Begin replication of the object if both the object and its parent are relevant
-            objectsRelevance_[index] =
-                networkObject->GetRelevanceForClient(connection_).value_or(NetworkObjectRelevance::NormalUpdates);
-            if (objectsRelevance_[index] != NetworkObjectRelevance::Irrelevant)
-            {
-                objectsRelevanceTimeouts_[index] = relevanceTimeout;
-                pendingUpdatedObjects_.push_back({networkObject, true});
-            }
+            objectsRelevanceTimeouts_[index] = relevanceTimeout;
+            objectsPriority_[index] = 0.0f;
+            unreliableBaselines_[index].clear();
+            pendingUpdatedObjects_.push_back({networkObject, true});
         }
-        else if (wasRelevant)
+    }
+    else if (wasRelevant)
+    {
+        // If replicating, check periodically (abort replication immediately if parent is removed)
+        objectsRelevanceTimeouts_[index] -= timeStep;
+        if (objectsRelevanceTimeouts_[index] < 0.0f || !isParentRelevant)
         {
-            // If replicating, check periodically (abort replication immediately if parent is removed)
-            objectsRelevanceTimeouts_[index] -= timeStep;
-            if (objectsRelevanceTimeouts_[index] < 0.0f || !isParentRelevant)
+            objectsRelevance_[index] = isParentRelevant
+                ? networkObject->GetRelevanceForClient(connection_).value_or(NetworkObjectRelevance::NormalUpdates)
+                : NetworkObjectRelevance::Irrelevant;
+
+            if (objectsRelevance_[index] == NetworkObjectRelevance::Irrelevant)
             {
-                objectsRelevance_[index] = isParentRelevant
-                    ? networkObject->GetRelevanceForClient(connection_).value_or(NetworkObjectRelevance::NormalUpdates)
-                    : NetworkObjectRelevance::Irrelevant;
+                // Remove irrelevant component
+                pendingRemovedObjects_.push_back(networkId);
+                return;
+            }
 
-                if (objectsRelevance_[index] == NetworkObjectRelevance::Irrelevant)
-                {
-                    // Remove irrelevant component
-                    pendingRemovedObjects_.push_back(networkId);
-                    continue;
-                }
+            objectsRelevanceTimeouts_[index] = relevanceTimeout;
+        }
 
-                objectsRelevanceTimeouts_[index] = relevanceTimeout;
-            }
+        // Queue non-snapshot update
+        pendingUpdatedObjects_.push_back({networkObject, false});
+    }
+}
 
-            // Queue non-snapshot update
+void ClientReplicationState::QueueDeltaUpdates(SharedReplicationState& sharedState) const
+{
+    for (const auto& [networkObject, isSnapshot] : pendingUpdatedObjects_)
+    {
+        if (!isSnapshot)
             sharedState.QueueDeltaUpdate(networkObject);
-            pendingUpdatedObjects_.push_back({networkObject, false});
-        }
     }
 }
 
@@ -670,13 +952,27 @@ void ServerReplicator::OnNetworkUpdate()
     eventData[P_FRAME] = static_cast<long long>(currentFrame_);
     network_->SendEvent(E_ENDSERVERNETWORKFRAME, eventData);
 
-    sharedState_->PrepareForUpdate();
+    sharedState_->PrepareForUpdate(GetSetting(NetworkSettings::InterestGridCellSize).GetFloat());
+
+    clientStates_.clear();
     for (auto& [connection, clientState] : connections_)
-        clientState->UpdateNetworkObjects(*sharedState_);
+        clientStates_.push_back(clientState);
+
+    // Shared state is read-only while clients are processed in parallel
+    auto workQueue = GetSubsystem<WorkQueue>();
+    ForEachClientParallel(workQueue, clientStates_,
+        [&](ClientReplicationState* clientState) { clientState->UpdateNetworkObjects(*sharedState_); });
+
+    for (ClientReplicationState* clientState : clientStates_)
+        clientState->QueueDeltaUpdates(*sharedState_);
     sharedState_->CookDeltaUpdates(currentFrame_);
 
-    for (auto& [connection, clientState] : connections_)
-        clientState->SendMessages(currentFrame_, *sharedState_);
+    ForEachClientParallel(workQueue, clientStates_,
+        [&](ClientReplicationState* clientState) { clientState->GenerateMessages(currentFrame_, *sharedState_); });
+
+    // Submit messages to connections in the same order as before
+    for (ClientReplicationState* clientState : clientStates_)
+        clientState->SendMessages();
 }
 
 void ServerReplicator::AddConnection(AbstractConnection* connection)
@@ -740,6 +1036,13 @@ void ServerReplicator::SetCurrentFrame(NetworkFrame frame)
     currentFrame_ = frame;
 }
 
+void ServerReplicator::SetSetting(const NetworkSetting& setting, const Variant& value)
+{
+    SetNetworkSetting(settings_, setting, value);
+    for (auto& [connection, clientState] : connections_)
+        clientState->SetSetting(setting, value);
+}
+
 ClientReplicationState* ServerReplicator::GetClientState(AbstractConnection* connection) const
 {
     auto iter = connections_.find(connection);
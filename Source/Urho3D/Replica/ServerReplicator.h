@@ -28,9 +28,11 @@
 #include "../Core/Timer.h"
 #include "../IO/MemoryBuffer.h"
 #include "../IO/VectorBuffer.h"
+#include "../Network/AbstractConnection.h"
 #include "../Network/ClockSynchronizer.h"
 #include "../Replica/ClientInputStatistics.h"
 #include "../Replica/NetworkId.h"
+#include "../Replica/NetworkInterestGrid.h"
 #include "../Replica/TickSynchronizer.h"
 #include "../Replica/ProtocolMessages.h"
 
@@ -55,8 +57,8 @@ class SharedReplicationState : public RefCounted
 public:
     explicit SharedReplicationState(NetworkObjectRegistry* objectRegistry);
 
-    /// Initial preparation for network update.
-    void PrepareForUpdate();
+    /// Initial preparation for network update. Interest grid is disabled if cell size is zero.
+    void PrepareForUpdate(float interestGridCellSize);
     /// Request delta update to be prepared for specified object.
     void QueueDeltaUpdate(NetworkObject* networkObject);
     /// Cook all requested delta updates.
@@ -66,6 +68,12 @@ public:
     /// @{
     const ea::unordered_set<NetworkId>& GetRecentlyRemovedObjects() const { return recentlyRemovedObjects_; }
     const ea::vector<NetworkObject*>& GetSortedObjects() const { return sortedNetworkObjects_; }
+    /// Return interest grid, or null if no objects are tracked in the grid.
+    const NetworkInterestGrid* GetInterestGrid() const;
+    /// Return positions in sorted objects of the objects not tracked in the interest grid, in ascending order.
+    const ea::vector<unsigned>& GetUntrackedObjects() const { return untrackedObjects_; }
+    /// Return position in sorted objects by object index, or M_MAX_UNSIGNED if there's no such object.
+    unsigned GetSortedPositionByIndex(unsigned index) const;
     unsigned GetIndexUpperBound() const;
     const ea::unordered_set<NetworkObject*>& GetOwnedObjectsByConnection(AbstractConnection* connection) const;
     ea::optional<ConstByteSpan> GetReliableUpdateByIndex(unsigned index) const;
@@ -85,6 +93,7 @@ private:
 
     void ResetFrameBuffers();
     void InitializeNewObjects();
+    void UpdateInterestGrid(float cellSize);
 
     ConstByteSpan GetSpanData(const DeltaBufferSpan& span) const;
 
@@ -94,6 +103,11 @@ private:
     ea::unordered_set<NetworkId> recentlyAddedObjects_;
 
     ea::vector<NetworkObject*> sortedNetworkObjects_;
+    ea::vector<unsigned> sortedPositionByIndex_;
+
+    NetworkInterestGrid interestGrid_;
+    bool interestGridEnabled_{};
+    ea::vector<unsigned> untrackedObjects_;
 
     ea::vector<bool> isDeltaUpdateQueued_;
     ea::vector<bool> needReliableDeltaUpdate_;
@@ -116,6 +130,9 @@ public:
     /// Begin network frame. Overtime indicates how much time has passed since actual frame start time.
     void BeginNetworkFrame(NetworkFrame currentFrame, float overtime);
 
+    /// Override setting for this client.
+    void SetSetting(const NetworkSetting& setting, const Variant& value);
+
     /// Return current state and properties
     /// @{
     const Variant& GetSetting(const NetworkSetting& setting) const;
@@ -131,7 +148,7 @@ protected:
     /// Process messages for this client.
     bool ProcessMessage(NetworkMessageId messageId, MemoryBuffer& messageData);
     /// Notify statistics aggregator that user input has received for specified frame.
-    void OnInputReceived(NetworkFrame inputFrame);
+    void OnInputReceived(NetworkFrame inputFrame, unsigned numInputFrames);
 
     const WeakPtr<NetworkObjectRegistry> objectRegistry_;
     const WeakPtr<AbstractConnection> connection_;
@@ -171,12 +188,18 @@ public:
         NetworkObjectRegistry* objectRegistry, AbstractConnection* connection, const VariantMap& settings);
 
     /// Perform network update from the perspective of this client connection.
-    void UpdateNetworkObjects(SharedReplicationState& sharedState);
+    /// Shared state is not modified, so it is safe to call this function for different clients in parallel.
+    void UpdateNetworkObjects(const SharedReplicationState& sharedState);
+    /// Queue delta updates for objects replicated to this client.
+    void QueueDeltaUpdates(SharedReplicationState& sharedState) const;
+    /// Generate delta update messages for current frame from cooked shared state.
+    /// Shared state is not modified, so it is safe to call this function for different clients in parallel.
+    void GenerateMessages(NetworkFrame currentFrame, const SharedReplicationState& sharedState);
 
     /// Process messages for this client.
     bool ProcessMessage(NetworkMessageId messageId, MemoryBuffer& messageData);
-    /// Send messages to connection for current frame.
-    void SendMessages(NetworkFrame currentFrame, const SharedReplicationState& sharedState);
+    /// Send generated messages and object snapshots to connection for current frame.
+    void SendMessages();
 
     /// Manage reported input loss.
     /// @{
@@ -185,20 +208,55 @@ public:
     /// @}
 
 private:
+    /// Message generated in advance and pending submission to the connection.
+    struct PendingMessage
+    {
+        VectorBuffer data_;
+        ea::string debugInfo_;
+        bool send_{};
+    };
+
     void ProcessObjectsFeedbackUnreliable(MemoryBuffer& messageData);
-    void SendRemoveObjects();
+    void CollectInterestingObjects(const SharedReplicationState& sharedState, const NetworkInterestGrid& interestGrid);
+    void UpdateNetworkObject(NetworkObject* networkObject, float timeStep, float relevanceTimeout);
+    template <class T> void GenerateMessage(PendingMessage& message, T generator);
+    void SendPendingMessage(NetworkMessageId messageId, PacketType messageType, const PendingMessage& message);
+    void GenerateRemoveObjects();
     void SendAddObjects();
-    void SendUpdateObjectsReliable(const SharedReplicationState& sharedState);
-    void SendUpdateObjectsUnreliable(NetworkFrame currentFrame, const SharedReplicationState& sharedState);
+    void GenerateUpdateObjectsReliable(const SharedReplicationState& sharedState);
+    void GenerateUpdateObjectsUnreliable(NetworkFrame currentFrame, const SharedReplicationState& sharedState);
+    const UnreliableDeltaBaseline* FindAcknowledgedBaseline(unsigned index, NetworkFrame frame, unsigned window) const;
 
     ea::vector<NetworkObjectRelevance> objectsRelevance_;
     ea::vector<float> objectsRelevanceTimeouts_;
+    /// Accumulated priority of unreliable updates, used if update size is limited.
+    ea::vector<float> objectsPriority_;
 
     ea::vector<NetworkId> pendingRemovedObjects_;
     ea::vector<ea::pair<NetworkObject*, bool>> pendingUpdatedObjects_;
 
+    /// Indices of objects relevant for the client after the latest update.
+    ea::vector<unsigned> relevantObjects_;
+    /// Temporary buffers for objects that may be relevant for the client.
+    /// @{
+    ea::vector<unsigned> interestingObjectIndices_;
+    ea::vector<unsigned> interestingObjects_;
+    ea::vector<ea::pair<float, NetworkObject*>> prioritizedUpdates_;
+    /// @}
+
+    /// Recently sent unreliable updates and frames acknowledged by the client, used for delta compression.
+    /// @{
+    ea::vector<ea::vector<UnreliableDeltaBaseline>> unreliableBaselines_;
+    ReceivedFramesMask receivedUnreliableFrames_;
+    VectorBuffer deltaBuffer_;
+    /// @}
+
     VectorBuffer componentBuffer_;
 
+    PendingMessage removeObjectsMessage_;
+    PendingMessage updateObjectsReliableMessage_;
+    PendingMessage updateObjectsUnreliableMessage_;
+
     float reportedLoss_{};
 };
 
@@ -218,6 +276,9 @@ public:
     void ReportInputLoss(AbstractConnection* connection, float percentLoss);
 
     void SetCurrentFrame(NetworkFrame frame);
+    /// Override network setting for all current and future connections.
+    /// Settings shared with the client are sent only to connections that are not synchronized yet.
+    void SetSetting(const NetworkSetting& setting, const Variant& value);
 
     /// Return current state of the replicator.
     /// @{
@@ -250,6 +311,8 @@ private:
 
     SharedPtr<SharedReplicationState> sharedState_;
     ea::unordered_map<AbstractConnection*, SharedPtr<ClientReplicationState>> connections_;
+    /// Temporary list of client states processed in parallel.
+    ea::vector<ClientReplicationState*> clientStates_;
 };
 
 }
@@ -24,6 +24,7 @@
 
 #include "../Core/Context.h"
 #include "../Graphics/AnimatedModel.h"
+#include "../Graphics/OctreeQuery.h"
 #include "../Network/NetworkEvents.h"
 #include "../Replica/TrackedAnimatedModel.h"
 #include "../Replica/NetworkSettingsConsts.h"
@@ -121,24 +122,16 @@ Quaternion TrackedAnimatedModel::SampleTemporalBoneRotation(const NetworkTime& t
     return index < result.Size() ? result[index] : Quaternion::IDENTITY;
 }
 
-void TrackedAnimatedModel::ProcessTemporalRayQuery(const NetworkTime& time, const RayOctreeQuery& query, ea::vector<RayQueryResult>& results) const
+bool TrackedAnimatedModel::SampleTemporalBoneTransforms(const NetworkTime& time, ea::vector<Matrix3x4>& boneTransforms) const
 {
-    if (!animatedModel_)
-        return;
-
     const auto& bones = animatedModel_->GetSkeleton().GetBones();
     const unsigned numBones = bones.size();
     if (numBones != bonePositionsTrace_.Size() || numBones != boneRotationsTrace_.Size())
-        return;
+        return false;
 
-    const BoundingBox worldBoundingBox = boundingBoxTrace_.GetClosestRaw(time.Frame());
-    const Matrix3x4 worldTransform = transformTrace_.SampleValid(time);
     const auto bonePositions = bonePositionsTrace_.SampleValid(time);
     const auto boneRotations = boneRotationsTrace_.SampleValid(time);
 
-    thread_local ea::vector<Matrix3x4> boneTransformsStorage;
-    auto& boneTransforms = boneTransformsStorage;
-    auto boneTransforms11 = boneTransformsStorage;
     boneTransforms.resize(numBones);
     for (unsigned i = 0; i < numBones; ++i)
     {
@@ -147,8 +140,52 @@ void TrackedAnimatedModel::ProcessTemporalRayQuery(const NetworkTime& time, cons
         const Vector3 scale = bones[i].node_ ? bones[i].node_->GetWorldScale() : Vector3::ONE;
         boneTransforms[i] = Matrix3x4{position, rotation, scale};
     }
+    return true;
+}
+
+void TrackedAnimatedModel::ProcessTemporalRayQuery(const NetworkTime& time, const RayOctreeQuery& query, ea::vector<RayQueryResult>& results) const
+{
+    if (!animatedModel_)
+        return;
+
+    // Check bounding box before rewinding the pose
+    const BoundingBox worldBoundingBox = boundingBoxTrace_.GetClosestRaw(time.Frame());
+    if (query.ray_.HitDistance(worldBoundingBox) >= query.maxDistance_)
+        return;
+
+    thread_local ea::vector<Matrix3x4> boneTransformsStorage;
+    auto& boneTransforms = boneTransformsStorage;
+    if (!SampleTemporalBoneTransforms(time, boneTransforms))
+        return;
 
+    const Matrix3x4 worldTransform = transformTrace_.SampleValid(time);
     animatedModel_->ProcessCustomRayQuery(query, worldBoundingBox, worldTransform, boneTransforms, results);
 }
 
+void TrackedAnimatedModel::ProcessTemporalRayQueries(const NetworkTime& time, ea::span<const RayOctreeQuery* const> queries) const
+{
+    if (!animatedModel_)
+        return;
+
+    const BoundingBox worldBoundingBox = boundingBoxTrace_.GetClosestRaw(time.Frame());
+    const auto isHit = [&](const RayOctreeQuery* query)
+    {
+        return query->ray_.HitDistance(worldBoundingBox) < query->maxDistance_;
+    };
+    if (ea::none_of(queries.begin(), queries.end(), isHit))
+        return;
+
+    thread_local ea::vector<Matrix3x4> boneTransformsStorage;
+    auto& boneTransforms = boneTransformsStorage;
+    if (!SampleTemporalBoneTransforms(time, boneTransforms))
+        return;
+
+    const Matrix3x4 worldTransform = transformTrace_.SampleValid(time);
+    for (const RayOctreeQuery* query : queries)
+    {
+        if (isHit(query))
+            animatedModel_->ProcessCustomRayQuery(*query, worldBoundingBox, worldTransform, boneTransforms, query->result_);
+    }
+}
+
 }
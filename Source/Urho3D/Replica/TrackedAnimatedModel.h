@@ -55,10 +55,14 @@ public:
     Vector3 SampleTemporalBonePosition(const NetworkTime& time, unsigned index) const;
     Quaternion SampleTemporalBoneRotation(const NetworkTime& time, unsigned index) const;
     void ProcessTemporalRayQuery(const NetworkTime& time, const RayOctreeQuery& query, ea::vector<RayQueryResult>& results) const;
+    /// Process multiple ray queries at the same time, results are stored in the queries.
+    /// The pose is rewound once for all queries and only if any query hits the bounding box.
+    void ProcessTemporalRayQueries(const NetworkTime& time, ea::span<const RayOctreeQuery* const> queries) const;
     /// @}
 
 private:
     void OnServerFrameEnd(NetworkFrame frame);
+    bool SampleTemporalBoneTransforms(const NetworkTime& time, ea::vector<Matrix3x4>& boneTransforms) const;
 
     /// Attributes independent on the client and the server.
     /// @{
@@ -26,87 +26,106 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
+#include "../IO/VectorBuffer.h"
 #include "../Resource/BackgroundLoader.h"
 #include "../Resource/ResourceCache.h"
 #include "../Resource/ResourceEvents.h"
 
+#include <EASTL/sort.h>
+
 #include "../DebugNew.h"
 
 namespace Urho3D
 {
 
+namespace
+{
+
+/// Reference counted in-memory copy of the resource file, passed from the loader thread to worker threads.
+class BackgroundLoadBuffer : public RefCounted, public VectorBuffer
+{
+public:
+    explicit BackgroundLoadBuffer(AbstractFile& file)
+        : VectorBuffer(file, file.GetSize())
+    {
+        SetName(file.GetName());
+    }
+
+    /// Return name of the source file.
+    const ea::string& GetName() const override { return name_; }
+};
+
+}
+
 BackgroundLoader::BackgroundLoader(ResourceCache* owner) :
-    owner_(owner)
+    owner_(owner),
+    loadsMetric_(GetMetricCounter(owner->GetContext(), "urho3d_resource_loads_total", "Number of loaded resources")),
+    loadFailuresMetric_(GetMetricCounter(owner->GetContext(), "urho3d_resource_load_failures_total", "Number of resources failed to load"))
 {
 }
 
 BackgroundLoader::~BackgroundLoader()
 {
+    // Stop the loader thread and let the resources being decoded finish before destroying the queue
+    Stop();
+    while (numDecodingResources_.load(std::memory_order_acquire) > 0)
+        Time::Sleep(1);
+
     MutexLock lock(backgroundLoadMutex_);
 
     backgroundLoadQueue_.clear();
+    pendingResources_.clear();
 }
 
 void BackgroundLoader::ThreadFunction()
 {
     URHO3D_PROFILE_THREAD("BackgroundLoader Thread");
 
+    auto workQueue = owner_->GetSubsystem<WorkQueue>();
+    const bool decodeInWorkQueue = workQueue && workQueue->GetNumThreads() > 0;
+
     while (shouldRun_)
     {
-        backgroundLoadMutex_.Acquire();
-
-        // Search for a queued resource that has not been loaded yet
-        auto i = backgroundLoadQueue_.begin();
-        while (i != backgroundLoadQueue_.end())
+        // Throttle reading so that only a limited amount of file data is kept in memory
+        if (decodeInWorkQueue && numDecodingResources_.load(std::memory_order_acquire) >= GetMaxDecodingResources())
         {
-            if (i->second.resource_->GetAsyncLoadState() == ASYNC_QUEUED)
-                break;
-            else
-                ++i;
+            Time::Sleep(1);
+            continue;
         }
 
-        if (i == backgroundLoadQueue_.end())
+        backgroundLoadMutex_.Acquire();
+
+        BackgroundLoadItem* item = TakePendingItem();
+        if (!item)
         {
             // No resources to load found
             backgroundLoadMutex_.Release();
             Time::Sleep(5);
+            continue;
         }
-        else
-        {
-            BackgroundLoadItem& item = i->second;
-            Resource* resource = item.resource_;
-            // We can be sure that the item is not removed from the queue as long as it is in the
-            // "queued" or "loading" state
-            backgroundLoadMutex_.Release();
 
-            bool success = false;
-            AbstractFilePtr file = owner_->GetFile(resource->GetName(), item.sendEventOnFailure_);
-            if (file)
-            {
-                resource->SetAsyncLoadState(ASYNC_LOADING);
-                success = resource->BeginLoad(*file);
-            }
-
-            // Process dependencies now
-            // Need to lock the queue again when manipulating other entries
-            ea::pair<StringHash, StringHash> key = ea::make_pair(resource->GetType(), resource->GetNameHash());
-            backgroundLoadMutex_.Acquire();
-            if (item.dependents_.size())
-            {
-                for (auto i = item.dependents_.begin(); i != item.dependents_.end(); ++i)
-                {
-                    auto j = backgroundLoadQueue_.find(*i);
-                    if (j != backgroundLoadQueue_.end())
-                        j->second.dependencies_.erase(key);
-                }
-
-                item.dependents_.clear();
-            }
+        // We can be sure that the item is not removed from the queue as long as it is in the
+        // "queued" or "loading" state
+        item->resource_->SetAsyncLoadState(ASYNC_LOADING);
+        backgroundLoadMutex_.Release();
 
-            resource->SetAsyncLoadState(success ? ASYNC_SUCCESS : ASYNC_FAIL);
-            backgroundLoadMutex_.Release();
+        // I/O stage is performed by the loader thread, decoding is handed over to worker threads
+        AbstractFilePtr file = ReadResourceFile(*item);
+        if (!file || !decodeInWorkQueue)
+        {
+            DecodeResource(*item, file);
+            continue;
         }
+
+        numDecodingResources_.fetch_add(1, std::memory_order_acq_rel);
+        workQueue->PostTask([this, item, file](unsigned)
+        {
+            DecodeResource(*item, file);
+            numDecodingResources_.fetch_sub(1, std::memory_order_acq_rel);
+        });
     }
 }
 
@@ -118,35 +137,24 @@ bool BackgroundLoader::QueueResource(StringHash type, const ea::string& name, bo
     MutexLock lock(backgroundLoadMutex_);
 
     // Check if already exists in the queue
-    if (backgroundLoadQueue_.find(key) != backgroundLoadQueue_.end())
-        return false;
-
-    BackgroundLoadItem& item = backgroundLoadQueue_[key];
-    item.sendEventOnFailure_ = sendEventOnFailure;
-
-    // Make sure the pointer is non-null and is a Resource subclass
-    item.resource_ = DynamicCast<Resource>(owner_->GetContext()->CreateObject(type));
-    if (!item.resource_)
+    auto existing = backgroundLoadQueue_.find(key);
+    if (existing != backgroundLoadQueue_.end())
     {
-        URHO3D_LOGERROR("Could not load unknown resource type " + type.ToString());
-
-        if (sendEventOnFailure && Thread::IsMainThread())
+        // Resource may have been requested explicitly before, now it is needed regardless
+        if (!existing->second.isImplicitlyRequested_)
         {
-            using namespace UnknownResourceType;
-
-            VariantMap& eventData = owner_->GetEventDataMap();
-            eventData[P_RESOURCETYPE] = type;
-            owner_->SendEvent(E_UNKNOWNRESOURCETYPE, eventData);
+            existing->second.isImplicitlyRequested_ = true;
+            UpdateItemPriority(existing->second);
         }
-
-        backgroundLoadQueue_.erase(key);
         return false;
     }
 
-    URHO3D_LOGDEBUG("Background loading resource " + name);
+    BackgroundLoadItem* item = CreateItem(type, name, sendEventOnFailure);
+    if (!item)
+        return false;
 
-    item.resource_->SetName(name);
-    item.resource_->SetAsyncLoadState(ASYNC_QUEUED);
+    item->isImplicitlyRequested_ = true;
+    UpdateItemPriority(*item);
 
     // If this is a resource calling for the background load of more resources, mark the dependency as necessary
     if (caller)
@@ -157,8 +165,11 @@ bool BackgroundLoader::QueueResource(StringHash type, const ea::string& name, bo
         if (j != backgroundLoadQueue_.end())
         {
             BackgroundLoadItem& callerItem = j->second;
-            item.dependents_.insert(callerKey);
+            item->dependents_.insert(callerKey);
             callerItem.dependencies_.insert(key);
+            // Dependencies are needed as soon as the caller
+            item->implicitPriority_ = callerItem.priority_;
+            UpdateItemPriority(*item);
         }
         else
             URHO3D_LOGWARNING("Resource " + caller->GetName() +
@@ -172,6 +183,73 @@ bool BackgroundLoader::QueueResource(StringHash type, const ea::string& name, bo
     return true;
 }
 
+bool BackgroundLoader::QueueRequest(ResourceLoadRequest* request, bool sendEventOnFailure)
+{
+    const ea::pair<StringHash, StringHash> key = ea::make_pair(request->GetResourceType(), StringHash(request->GetResourceName()));
+
+    MutexLock lock(backgroundLoadMutex_);
+
+    BackgroundLoadItem* item = nullptr;
+    auto existing = backgroundLoadQueue_.find(key);
+    if (existing != backgroundLoadQueue_.end())
+        item = &existing->second;
+    else
+    {
+        item = CreateItem(request->GetResourceType(), request->GetResourceName(), sendEventOnFailure);
+        if (!item)
+            return false;
+    }
+
+    request->loader_ = this;
+    item->requests_.emplace_back(request);
+    UpdateItemPriority(*item);
+
+    if (!IsStarted())
+        Run();
+
+    return true;
+}
+
+void BackgroundLoader::SetRequestPriority(ResourceLoadRequest* request, float priority)
+{
+    const ea::pair<StringHash, StringHash> key = ea::make_pair(request->GetResourceType(), StringHash(request->GetResourceName()));
+
+    MutexLock lock(backgroundLoadMutex_);
+
+    request->priority_ = priority;
+    auto i = backgroundLoadQueue_.find(key);
+    if (i != backgroundLoadQueue_.end())
+        UpdateItemPriority(i->second);
+}
+
+void BackgroundLoader::CancelRequest(ResourceLoadRequest* request)
+{
+    const ea::pair<StringHash, StringHash> key = ea::make_pair(request->GetResourceType(), StringHash(request->GetResourceName()));
+
+    MutexLock lock(backgroundLoadMutex_);
+
+    request->cancelled_ = true;
+    request->loader_ = nullptr;
+
+    auto i = backgroundLoadQueue_.find(key);
+    if (i == backgroundLoadQueue_.end())
+        return;
+
+    BackgroundLoadItem& item = i->second;
+    item.requests_.erase_first(SharedPtr<ResourceLoadRequest>(request));
+
+    // Drop the resource if nobody needs it and loading has not started yet
+    const bool isNeeded = item.isImplicitlyRequested_ || !item.requests_.empty() || !item.dependents_.empty();
+    if (!isNeeded && item.resource_->GetAsyncLoadState() == ASYNC_QUEUED)
+    {
+        URHO3D_LOGDEBUG("Cancelled background loading of resource " + item.resource_->GetName());
+        backgroundLoadQueue_.erase(i);
+        return;
+    }
+
+    UpdateItemPriority(item);
+}
+
 void BackgroundLoader::WaitForResource(StringHash type, StringHash nameHash)
 {
     backgroundLoadMutex_.Acquire();
@@ -261,10 +339,166 @@ unsigned BackgroundLoader::GetNumQueuedResources() const
     return backgroundLoadQueue_.size();
 }
 
+BackgroundLoadItem* BackgroundLoader::CreateItem(StringHash type, const ea::string& name, bool sendEventOnFailure)
+{
+    const ea::pair<StringHash, StringHash> key = ea::make_pair(type, StringHash(name));
+
+    BackgroundLoadItem& item = backgroundLoadQueue_[key];
+    item.sendEventOnFailure_ = sendEventOnFailure;
+
+    // Make sure the pointer is non-null and is a Resource subclass
+    item.resource_ = DynamicCast<Resource>(owner_->GetContext()->CreateObject(type));
+    if (!item.resource_)
+    {
+        URHO3D_LOGERROR("Could not load unknown resource type " + type.ToString());
+
+        if (sendEventOnFailure && Thread::IsMainThread())
+        {
+            using namespace UnknownResourceType;
+
+            VariantMap& eventData = owner_->GetEventDataMap();
+            eventData[P_RESOURCETYPE] = type;
+            owner_->SendEvent(E_UNKNOWNRESOURCETYPE, eventData);
+        }
+
+        backgroundLoadQueue_.erase(key);
+        return nullptr;
+    }
+
+    URHO3D_LOGDEBUG("Background loading resource " + name);
+
+    item.resource_->SetName(name);
+    item.resource_->SetAsyncLoadState(ASYNC_QUEUED);
+    item.sequence_ = nextSequence_++;
+
+    pendingResources_.push_back(key);
+    pendingResourcesDirty_ = true;
+
+    return &item;
+}
+
+void BackgroundLoader::UpdateItemPriority(BackgroundLoadItem& item)
+{
+    if (!item.isImplicitlyRequested_ && item.requests_.empty())
+        return;
+
+    float priority = item.isImplicitlyRequested_ ? item.implicitPriority_ : -M_LARGE_VALUE;
+    for (const ResourceLoadRequest* request : item.requests_)
+        priority = Max(priority, request->priority_);
+
+    if (item.priority_ != priority)
+    {
+        item.priority_ = priority;
+        pendingResourcesDirty_ = true;
+    }
+}
+
+BackgroundLoadItem* BackgroundLoader::TakePendingItem()
+{
+    // Keep the highest priority in the back. Resources queued earlier go first if priorities are equal.
+    if (pendingResourcesDirty_)
+    {
+        const auto getItem = [this](const ea::pair<StringHash, StringHash>& key)
+        {
+            auto i = backgroundLoadQueue_.find(key);
+            return i != backgroundLoadQueue_.end() ? &i->second : nullptr;
+        };
+        const auto isLess = [&](const ea::pair<StringHash, StringHash>& lhs, const ea::pair<StringHash, StringHash>& rhs)
+        {
+            const BackgroundLoadItem* lhsItem = getItem(lhs);
+            const BackgroundLoadItem* rhsItem = getItem(rhs);
+            // Stale keys are moved to the front and discarded eventually
+            if (!lhsItem || !rhsItem)
+                return !lhsItem && rhsItem;
+            if (lhsItem->priority_ != rhsItem->priority_)
+                return lhsItem->priority_ < rhsItem->priority_;
+            return lhsItem->sequence_ > rhsItem->sequence_;
+        };
+
+        ea::sort(pendingResources_.begin(), pendingResources_.end(), isLess);
+        pendingResourcesDirty_ = false;
+    }
+
+    while (!pendingResources_.empty())
+    {
+        auto i = backgroundLoadQueue_.find(pendingResources_.back());
+        pendingResources_.pop_back();
+        if (i != backgroundLoadQueue_.end() && i->second.resource_->GetAsyncLoadState() == ASYNC_QUEUED)
+            return &i->second;
+    }
+    return nullptr;
+}
+
+unsigned BackgroundLoader::GetMaxDecodingResources() const
+{
+    // Keep a few resources in flight per worker thread so that workers do not wait for I/O
+    auto workQueue = owner_->GetSubsystem<WorkQueue>();
+    return Max(workQueue ? workQueue->GetNumThreads() * 2 : 0u, 1u);
+}
+
+AbstractFilePtr BackgroundLoader::ReadResourceFile(BackgroundLoadItem& item) const
+{
+    Resource* resource = item.resource_;
+    AbstractFilePtr file = owner_->GetFile(resource->GetName(), item.sendEventOnFailure_);
+    if (!file)
+        return nullptr;
+
+    // Memory backed files (e.g. memory mapped package entries) can be decoded directly
+    if (dynamic_cast<MemoryBuffer*>(file.Get()))
+        return file;
+
+    URHO3D_PROFILE("ReadBackgroundResource");
+
+    const unsigned fileSize = file->GetSize();
+    SharedPtr<BackgroundLoadBuffer> buffer{new BackgroundLoadBuffer(*file)};
+    if (buffer->GetSize() != fileSize)
+    {
+        URHO3D_LOGERROR("Failed to read background loaded resource " + resource->GetName());
+        return nullptr;
+    }
+    return buffer;
+}
+
+void BackgroundLoader::DecodeResource(BackgroundLoadItem& item, AbstractFile* file)
+{
+    Resource* resource = item.resource_;
+
+    bool success = false;
+    if (file)
+    {
+        URHO3D_PROFILE("BeginBackgroundLoading");
+        success = resource->BeginLoad(*file);
+    }
+
+    // Process dependencies now
+    // Need to lock the queue again when manipulating other entries
+    ea::pair<StringHash, StringHash> key = ea::make_pair(resource->GetType(), resource->GetNameHash());
+    MutexLock lock(backgroundLoadMutex_);
+    if (item.dependents_.size())
+    {
+        for (auto i = item.dependents_.begin(); i != item.dependents_.end(); ++i)
+        {
+            auto j = backgroundLoadQueue_.find(*i);
+            if (j != backgroundLoadQueue_.end())
+                j->second.dependencies_.erase(key);
+        }
+
+        item.dependents_.clear();
+    }
+
+    resource->SetAsyncLoadState(success ? ASYNC_SUCCESS : ASYNC_FAIL);
+}
+
 void BackgroundLoader::FinishBackgroundLoading(BackgroundLoadItem& item)
 {
     Resource* resource = item.resource_;
 
+    ea::vector<SharedPtr<ResourceLoadRequest>> requests;
+    {
+        MutexLock lock(backgroundLoadMutex_);
+        requests.swap(item.requests_);
+    }
+
     bool success = resource->GetAsyncLoadState() == ASYNC_SUCCESS;
     // If BeginLoad() phase was successful, call EndLoad() and get the final success/failure result
     if (success)
@@ -276,6 +510,10 @@ void BackgroundLoader::FinishBackgroundLoading(BackgroundLoadItem& item)
     }
     resource->SetAsyncLoadState(ASYNC_DONE);
 
+    loadsMetric_->Increment();
+    if (!success)
+        loadFailuresMetric_->Increment();
+
     if (!success && item.sendEventOnFailure_)
     {
         using namespace LoadFailed;
@@ -299,6 +537,9 @@ void BackgroundLoader::FinishBackgroundLoading(BackgroundLoadItem& item)
         eventData[P_RESOURCE] = resource;
         owner_->SendEvent(E_RESOURCEBACKGROUNDLOADED, eventData);
     }
+
+    for (ResourceLoadRequest* request : requests)
+        request->Complete(resource, success);
 }
 
 }
@@ -25,10 +25,15 @@
 #include <EASTL/hash_set.h>
 #include <EASTL/unordered_map.h>
 
+#include <atomic>
+
+#include "../Core/Metrics.h"
 #include "../Core/Mutex.h"
 #include "../Container/Ptr.h"
 #include "../Core/Thread.h"
+#include "../IO/AbstractFile.h"
 #include "../Math/StringHash.h"
+#include "../Resource/ResourceLoadRequest.h"
 
 namespace Urho3D
 {
@@ -45,11 +50,23 @@ struct URHO3D_API BackgroundLoadItem
     ea::hash_set<ea::pair<StringHash, StringHash> > dependencies_;
     /// Resources that depend on this resource's loading.
     ea::hash_set<ea::pair<StringHash, StringHash> > dependents_;
+    /// Explicit requests for the resource.
+    ea::vector<SharedPtr<ResourceLoadRequest>> requests_;
+    /// Loading priority, the highest priority of all requests.
+    float priority_{};
+    /// Priority of the implicit request.
+    float implicitPriority_{};
+    /// Sequence number used to keep queue order for equal priorities.
+    unsigned sequence_{};
+    /// Whether the resource is needed regardless of explicit requests, e.g. as dependency or fire-and-forget load.
+    bool isImplicitlyRequested_{};
     /// Whether to send failure event.
     bool sendEventOnFailure_;
 };
 
 /// Background loader of resources. Owned by the ResourceCache.
+/// The loader thread performs file I/O and hands loaded data over to WorkQueue threads,
+/// which call Resource::BeginLoad concurrently. EndLoad is always called from the main thread.
 /// @nobind
 class URHO3D_API BackgroundLoader : public RefCounted, public Thread
 {
@@ -65,6 +82,13 @@ public:
 
     /// Queue loading of a resource. The name must be sanitated to ensure consistent format. Return true if queued (not a duplicate and resource was a known type).
     bool QueueResource(StringHash type, const ea::string& name, bool sendEventOnFailure, Resource* caller);
+    /// Queue loading of a resource for the request. Request is merged with the pending load of the same resource, if any.
+    /// Return false if resource type is unknown.
+    bool QueueRequest(ResourceLoadRequest* request, bool sendEventOnFailure);
+    /// Change priority of a pending request.
+    void SetRequestPriority(ResourceLoadRequest* request, float priority);
+    /// Cancel a pending request.
+    void CancelRequest(ResourceLoadRequest* request);
     /// Wait and finish possible loading of a resource when being requested from the cache.
     void WaitForResource(StringHash type, StringHash nameHash);
     /// Process resources that are ready to finish.
@@ -74,6 +98,18 @@ public:
     unsigned GetNumQueuedResources() const;
 
 private:
+    /// Create queue item for the resource. Return null if resource type is unknown. Queue must be locked.
+    BackgroundLoadItem* CreateItem(StringHash type, const ea::string& name, bool sendEventOnFailure);
+    /// Recalculate priority of the item from its requests. Queue must be locked.
+    void UpdateItemPriority(BackgroundLoadItem& item);
+    /// Take the pending item with the highest priority. Queue must be locked.
+    BackgroundLoadItem* TakePendingItem();
+    /// Return maximum number of resources being decoded at the same time.
+    unsigned GetMaxDecodingResources() const;
+    /// Open the file of the resource and read it into memory if necessary. Return null on failure.
+    AbstractFilePtr ReadResourceFile(BackgroundLoadItem& item) const;
+    /// Call BeginLoad for the resource and update dependent resources. May be called from any thread.
+    void DecodeResource(BackgroundLoadItem& item, AbstractFile* file);
     /// Finish one background loaded resource.
     void FinishBackgroundLoading(BackgroundLoadItem& item);
 
@@ -83,6 +119,18 @@ private:
     mutable Mutex backgroundLoadMutex_;
     /// Resources that are queued for background loading.
     ea::unordered_map<ea::pair<StringHash, StringHash>, BackgroundLoadItem> backgroundLoadQueue_;
+    /// Keys of resources that are waiting for the loader thread. Sorted by ascending priority when not dirty.
+    ea::vector<ea::pair<StringHash, StringHash>> pendingResources_;
+    /// Whether the pending resources should be sorted again.
+    bool pendingResourcesDirty_{};
+    /// Next sequence number of the queue item.
+    unsigned nextSequence_{};
+    /// Number of resources being decoded by WorkQueue threads.
+    std::atomic<unsigned> numDecodingResources_{};
+    /// Number of loaded resources.
+    SharedPtr<MetricCounter> loadsMetric_;
+    /// Number of resources failed to load.
+    SharedPtr<MetricCounter> loadFailuresMetric_;
 };
 
 }
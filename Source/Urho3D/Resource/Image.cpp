@@ -24,10 +24,13 @@
 
 #include "../Core/Context.h"
 #include "../Core/Profiler.h"
+#include "../Core/WorkQueue.h"
 #include "../IO/File.h"
 #include "../IO/FileSystem.h"
 #include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
 #include "../Resource/Decompress.h"
+#include "../Resource/ImageCompression.h"
 
 #include <SDL_surface.h>
 #include <STB/stb_image.h>
@@ -1211,6 +1214,82 @@ bool Image::FlipVertical()
     return true;
 }
 
+/// Source pixels and weights contributing to one destination pixel along one axis.
+struct ResampleTaps
+{
+    /// Index of the first source pixel.
+    int first_{};
+    /// Number of source pixels.
+    unsigned count_{};
+    /// Weights of source pixels, normalized.
+    ea::vector<float> weights_;
+};
+
+/// Minimum number of destination pixels to resize image on multiple threads.
+static const int MIN_PARALLEL_RESIZE_PIXELS = 256 * 256;
+
+/// Calculate resampling taps along one axis.
+/// Box filter over the whole source footprint is used when reducing size, so no source pixels are skipped.
+/// Bilinear filter is used when increasing size. Pixels are copied as is when size is not changed.
+static ea::vector<ResampleTaps> CalculateResampleTaps(int srcSize, int destSize)
+{
+    ea::vector<ResampleTaps> taps(destSize);
+    if (destSize == srcSize)
+    {
+        for (int i = 0; i < destSize; ++i)
+        {
+            taps[i].first_ = i;
+            taps[i].count_ = 1;
+            taps[i].weights_ = {1.0f};
+        }
+    }
+    else if (destSize < srcSize)
+    {
+        const float scale = static_cast<float>(srcSize) / destSize;
+        for (int i = 0; i < destSize; ++i)
+        {
+            const float begin = i * scale;
+            const float end = Min((i + 1) * scale, static_cast<float>(srcSize));
+            const int first = FloorToInt(begin);
+            const int last = Min(CeilToInt(end), srcSize) - 1;
+
+            ResampleTaps& tap = taps[i];
+            tap.first_ = first;
+            tap.count_ = static_cast<unsigned>(last - first + 1);
+            tap.weights_.resize(tap.count_);
+            for (int j = first; j <= last; ++j)
+            {
+                const float coverage = Min(end, j + 1.0f) - Max(begin, static_cast<float>(j));
+                tap.weights_[j - first] = Max(coverage, 0.0f) / (end - begin);
+            }
+        }
+    }
+    else
+    {
+        for (int i = 0; i < destSize; ++i)
+        {
+            const float coord = destSize > 1 ? static_cast<float>(i) / (destSize - 1) : 0.0f;
+            const float srcCoord = Clamp(coord * srcSize - 0.5f, 0.0f, static_cast<float>(srcSize - 1));
+            const int first = Min(static_cast<int>(srcCoord), srcSize - 1);
+            const float fraction = srcCoord - first;
+
+            ResampleTaps& tap = taps[i];
+            tap.first_ = first;
+            if (first + 1 < srcSize)
+            {
+                tap.count_ = 2;
+                tap.weights_ = {1.0f - fraction, fraction};
+            }
+            else
+            {
+                tap.count_ = 1;
+                tap.weights_ = {1.0f};
+            }
+        }
+    }
+    return taps;
+}
+
 bool Image::Resize(int width, int height)
 {
     URHO3D_PROFILE("ResizeImage");
@@ -1230,36 +1309,50 @@ bool Image::Resize(int width, int height)
     if (!data_ || width <= 0 || height <= 0)
         return false;
 
-    /// \todo Reducing image size does not sample all needed pixels
+    const ea::vector<ResampleTaps> tapsX = CalculateResampleTaps(width_, width);
+    const ea::vector<ResampleTaps> tapsY = CalculateResampleTaps(height_, height);
+
     ea::shared_array<unsigned char> newData(new unsigned char[width * height * components_]);
-    for (int y = 0; y < height; ++y)
-    {
-        for (int x = 0; x < width; ++x)
+    const unsigned char* srcData = data_.get();
+    unsigned char* destData = newData.get();
+    const int components = static_cast<int>(components_);
+    const int srcStride = width_ * components;
+    const auto resizeRows = [&](unsigned beginRow, unsigned endRow)
+    {
+        float accum[4];
+        for (unsigned y = beginRow; y < endRow; ++y)
         {
-            // Calculate float coordinates between 0 - 1 for resampling
-            float xF = (width_ > 1) ? (float)x / (float)(width - 1) : 0.0f;
-            float yF = (height_ > 1) ? (float)y / (float)(height - 1) : 0.0f;
-            unsigned uintColor = GetPixelBilinear(xF, yF).ToUInt();
-            unsigned char* dest = newData.get() + (y * width + x) * components_;
-            auto* src = (unsigned char*)&uintColor;
-
-            switch (components_)
+            const ResampleTaps& tapY = tapsY[y];
+            unsigned char* dest = destData + y * width * components;
+            for (int x = 0; x < width; ++x)
             {
-            case 4:
-                dest[3] = src[3];
-                // Fall through
-            case 3:
-                dest[2] = src[2];
-                // Fall through
-            case 2:
-                dest[1] = src[1];
-                // Fall through
-            default:
-                dest[0] = src[0];
-                break;
+                const ResampleTaps& tapX = tapsX[x];
+                ea::fill_n(accum, components, 0.0f);
+                for (unsigned i = 0; i < tapY.count_; ++i)
+                {
+                    const float weightY = tapY.weights_[i];
+                    const unsigned char* srcRow = srcData + (tapY.first_ + i) * srcStride + tapX.first_ * components;
+                    for (unsigned j = 0; j < tapX.count_; ++j)
+                    {
+                        const float weight = weightY * tapX.weights_[j];
+                        const unsigned char* src = srcRow + j * components;
+                        for (int c = 0; c < components; ++c)
+                            accum[c] += weight * src[c];
+                    }
+                }
+
+                for (int c = 0; c < components; ++c)
+                    dest[c] = static_cast<unsigned char>(Clamp(RoundToInt(accum[c]), 0, 255));
+                dest += components;
             }
         }
-    }
+    };
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    if (workQueue && width * height >= MIN_PARALLEL_RESIZE_PIXELS)
+        ForEachParallel(workQueue, 1u, static_cast<unsigned>(height), resizeRows);
+    else
+        resizeRows(0, height);
 
     width_ = width;
     height_ = height;
@@ -1434,6 +1527,81 @@ bool Image::SaveDDS(const ea::string& fileName) const
     return true;
 }
 
+bool Image::SaveCompressedDDS(Serializer& dest, CompressedFormat format, bool mipmaps) const
+{
+    URHO3D_PROFILE("SaveImageCompressedDDS");
+
+    if (IsCompressed())
+    {
+        URHO3D_LOGERROR("Can not compress already compressed image");
+        return false;
+    }
+
+    if (depth_ > 1 || cubemap_ || array_)
+    {
+        URHO3D_LOGERROR("Can not compress 3D, cube or array image");
+        return false;
+    }
+
+    unsigned fourCC{};
+    switch (format)
+    {
+    case CF_DXT1: fourCC = FOURCC_DXT1; break;
+    case CF_DXT5: fourCC = FOURCC_DXT5; break;
+    case CF_ETC1: fourCC = FOURCC_ETC1; break;
+    case CF_ETC2_RGB: fourCC = FOURCC_ETC2; break;
+    case CF_ETC2_RGBA: fourCC = FOURCC_ETC2A; break;
+    default:
+        URHO3D_LOGERROR("Unsupported compressed format for DDS");
+        return false;
+    }
+
+    // Generate mip levels from RGBA image
+    ea::vector<SharedPtr<Image>> levels;
+    levels.push_back(ConvertToRGBA());
+    if (!levels.back())
+        return false;
+
+    while (mipmaps && (levels.back()->GetWidth() > 1 || levels.back()->GetHeight() > 1))
+    {
+        SharedPtr<Image> nextLevel = levels.back()->GetNextLevel();
+        if (!nextLevel)
+            return false;
+        levels.push_back(nextLevel);
+    }
+
+    dest.WriteFileID("DDS ");
+
+    DDSurfaceDesc2 ddsd;        // NOLINT(hicpp-member-init)
+    memset(&ddsd, 0, sizeof(ddsd));
+    ddsd.dwSize_ = sizeof(ddsd);
+    ddsd.dwFlags_ = 0x00000001l /*DDSD_CAPS*/
+        | 0x00000002l /*DDSD_HEIGHT*/ | 0x00000004l /*DDSD_WIDTH*/ | 0x00020000l /*DDSD_MIPMAPCOUNT*/ | 0x00001000l /*DDSD_PIXELFORMAT*/
+        | 0x00080000l /*DDSD_LINEARSIZE*/;
+    ddsd.dwWidth_ = width_;
+    ddsd.dwHeight_ = height_;
+    ddsd.dwLinearSize_ = GetCompressedImageSize(width_, height_, format);
+    ddsd.dwMipMapCount_ = levels.size();
+    ddsd.ddpfPixelFormat_.dwFlags_ = 0x00000004l /*DDPF_FOURCC*/;
+    ddsd.ddpfPixelFormat_.dwSize_ = sizeof(ddsd.ddpfPixelFormat_);
+    ddsd.ddpfPixelFormat_.dwFourCC_ = fourCC;
+    ddsd.ddsCaps_.dwCaps_ = DDSCAPS_TEXTURE | (levels.size() > 1 ? DDSCAPS_COMPLEX | DDSCAPS_MIPMAP : 0);
+
+    dest.Write(&ddsd, sizeof(ddsd));
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+    ByteVector blocks;
+    for (const Image* level : levels)
+    {
+        blocks.resize(GetCompressedImageSize(level->GetWidth(), level->GetHeight(), format));
+        if (!CompressImage(blocks.data(), level->GetData(), level->GetWidth(), level->GetHeight(), format, workQueue))
+            return false;
+        dest.Write(blocks.data(), blocks.size());
+    }
+
+    return true;
+}
+
 bool Image::SaveWEBP(const ea::string& fileName, float compression /* = 0.0f */) const
 {
 #ifdef URHO3D_WEBP
@@ -1732,84 +1900,93 @@ SharedPtr<Image> Image::GetNextLevel() const
     // 2D case
     else if (depth_ == 1)
     {
-        switch (components_)
+        const auto downsampleRows = [&](unsigned beginRow, unsigned endRow)
         {
-        case 1:
-            for (int y = 0; y < heightOut; ++y)
+            switch (components_)
             {
-                const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_];
-                const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_];
-                unsigned char* out = &pixelDataOut[y * widthOut];
-
-                for (int x = 0; x < widthOut; ++x)
+            case 1:
+                for (int y = static_cast<int>(beginRow); y < static_cast<int>(endRow); ++y)
                 {
-                    out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 1] +
-                                              inLower[x * 2] + inLower[x * 2 + 1]) >> 2);
-                }
-            }
-            break;
+                    const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_];
+                    const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_];
+                    unsigned char* out = &pixelDataOut[y * widthOut];
 
-        case 2:
-            for (int y = 0; y < heightOut; ++y)
-            {
-                const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_ * 2];
-                const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_ * 2];
-                unsigned char* out = &pixelDataOut[y * widthOut * 2];
+                    for (int x = 0; x < widthOut; ++x)
+                    {
+                        out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 1] +
+                                                  inLower[x * 2] + inLower[x * 2 + 1]) >> 2);
+                    }
+                }
+                break;
 
-                for (int x = 0; x < widthOut * 2; x += 2)
+            case 2:
+                for (int y = static_cast<int>(beginRow); y < static_cast<int>(endRow); ++y)
                 {
-                    out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 2] +
-                                              inLower[x * 2] + inLower[x * 2 + 2]) >> 2);
-                    out[x + 1] = (unsigned char)(((unsigned)inUpper[x * 2 + 1] + inUpper[x * 2 + 3] +
-                                                  inLower[x * 2 + 1] + inLower[x * 2 + 3]) >> 2);
-                }
-            }
-            break;
+                    const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_ * 2];
+                    const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_ * 2];
+                    unsigned char* out = &pixelDataOut[y * widthOut * 2];
 
-        case 3:
-            for (int y = 0; y < heightOut; ++y)
-            {
-                const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_ * 3];
-                const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_ * 3];
-                unsigned char* out = &pixelDataOut[y * widthOut * 3];
+                    for (int x = 0; x < widthOut * 2; x += 2)
+                    {
+                        out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 2] +
+                                                  inLower[x * 2] + inLower[x * 2 + 2]) >> 2);
+                        out[x + 1] = (unsigned char)(((unsigned)inUpper[x * 2 + 1] + inUpper[x * 2 + 3] +
+                                                      inLower[x * 2 + 1] + inLower[x * 2 + 3]) >> 2);
+                    }
+                }
+                break;
 
-                for (int x = 0; x < widthOut * 3; x += 3)
+            case 3:
+                for (int y = static_cast<int>(beginRow); y < static_cast<int>(endRow); ++y)
                 {
-                    out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 3] +
-                                              inLower[x * 2] + inLower[x * 2 + 3]) >> 2);
-                    out[x + 1] = (unsigned char)(((unsigned)inUpper[x * 2 + 1] + inUpper[x * 2 + 4] +
-                                                  inLower[x * 2 + 1] + inLower[x * 2 + 4]) >> 2);
-                    out[x + 2] = (unsigned char)(((unsigned)inUpper[x * 2 + 2] + inUpper[x * 2 + 5] +
-                                                  inLower[x * 2 + 2] + inLower[x * 2 + 5]) >> 2);
-                }
-            }
-            break;
+                    const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_ * 3];
+                    const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_ * 3];
+                    unsigned char* out = &pixelDataOut[y * widthOut * 3];
 
-        case 4:
-            for (int y = 0; y < heightOut; ++y)
-            {
-                const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_ * 4];
-                const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_ * 4];
-                unsigned char* out = &pixelDataOut[y * widthOut * 4];
+                    for (int x = 0; x < widthOut * 3; x += 3)
+                    {
+                        out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 3] +
+                                                  inLower[x * 2] + inLower[x * 2 + 3]) >> 2);
+                        out[x + 1] = (unsigned char)(((unsigned)inUpper[x * 2 + 1] + inUpper[x * 2 + 4] +
+                                                      inLower[x * 2 + 1] + inLower[x * 2 + 4]) >> 2);
+                        out[x + 2] = (unsigned char)(((unsigned)inUpper[x * 2 + 2] + inUpper[x * 2 + 5] +
+                                                      inLower[x * 2 + 2] + inLower[x * 2 + 5]) >> 2);
+                    }
+                }
+                break;
 
-                for (int x = 0; x < widthOut * 4; x += 4)
+            case 4:
+                for (int y = static_cast<int>(beginRow); y < static_cast<int>(endRow); ++y)
                 {
-                    out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 4] +
-                                              inLower[x * 2] + inLower[x * 2 + 4]) >> 2);
-                    out[x + 1] = (unsigned char)(((unsigned)inUpper[x * 2 + 1] + inUpper[x * 2 + 5] +
-                                                  inLower[x * 2 + 1] + inLower[x * 2 + 5]) >> 2);
-                    out[x + 2] = (unsigned char)(((unsigned)inUpper[x * 2 + 2] + inUpper[x * 2 + 6] +
-                                                  inLower[x * 2 + 2] + inLower[x * 2 + 6]) >> 2);
-                    out[x + 3] = (unsigned char)(((unsigned)inUpper[x * 2 + 3] + inUpper[x * 2 + 7] +
-                                                  inLower[x * 2 + 3] + inLower[x * 2 + 7]) >> 2);
+                    const unsigned char* inUpper = &pixelDataIn[(y * 2) * width_ * 4];
+                    const unsigned char* inLower = &pixelDataIn[(y * 2 + 1) * width_ * 4];
+                    unsigned char* out = &pixelDataOut[y * widthOut * 4];
+
+                    for (int x = 0; x < widthOut * 4; x += 4)
+                    {
+                        out[x] = (unsigned char)(((unsigned)inUpper[x * 2] + inUpper[x * 2 + 4] +
+                                                  inLower[x * 2] + inLower[x * 2 + 4]) >> 2);
+                        out[x + 1] = (unsigned char)(((unsigned)inUpper[x * 2 + 1] + inUpper[x * 2 + 5] +
+                                                      inLower[x * 2 + 1] + inLower[x * 2 + 5]) >> 2);
+                        out[x + 2] = (unsigned char)(((unsigned)inUpper[x * 2 + 2] + inUpper[x * 2 + 6] +
+                                                      inLower[x * 2 + 2] + inLower[x * 2 + 6]) >> 2);
+                        out[x + 3] = (unsigned char)(((unsigned)inUpper[x * 2 + 3] + inUpper[x * 2 + 7] +
+                                                      inLower[x * 2 + 3] + inLower[x * 2 + 7]) >> 2);
+                    }
                 }
+                break;
+
+            default:
+                assert(false);  // Should never reach here
+                break;
             }
-            break;
+        };
 
-        default:
-            assert(false);  // Should never reach here
-            break;
-        }
+        auto workQueue = GetSubsystem<WorkQueue>();
+        if (workQueue && widthOut * heightOut >= MIN_PARALLEL_RESIZE_PIXELS)
+            ForEachParallel(workQueue, 1u, static_cast<unsigned>(heightOut), downsampleRows);
+        else
+            downsampleRows(0, heightOut);
     }
     // 3D case
     else
@@ -2410,6 +2587,14 @@ void Image::GetLevels(ea::vector<const Image*>& levels) const
 
 unsigned char* Image::GetImageData(Deserializer& source, int& width, int& height, unsigned& components)
 {
+    // Decode directly from memory backed sources, e.g. memory mapped package entries
+    if (auto memoryBuffer = dynamic_cast<MemoryBuffer*>(&source))
+    {
+        const unsigned position = memoryBuffer->GetPosition();
+        return stbi_load_from_memory(memoryBuffer->GetData() + position, memoryBuffer->GetSize() - position, &width,
+            &height, (int*)&components, 0);
+    }
+
     unsigned dataSize = source.GetSize();
 
     ea::shared_array<unsigned char> buffer(new unsigned char[dataSize]);
@@ -119,7 +119,8 @@ public:
     bool FlipHorizontal();
     /// Flip image vertically. Return true if successful.
     bool FlipVertical();
-    /// Resize image by bilinear resampling. Return true if successful.
+    /// Resize image. Box filter is used when reducing size and bilinear filter is used when increasing size.
+    /// Return true if successful. Large images are resized on WorkQueue threads.
     bool Resize(int width, int height);
     /// Clear the image with a color.
     void Clear(const Color& color);
@@ -135,6 +136,8 @@ public:
     bool SaveJPG(const ea::string& fileName, int quality) const;
     /// Save in DDS format. Only uncompressed RGBA images are supported. Return true if successful.
     bool SaveDDS(const ea::string& fileName) const;
+    /// Compress and save in DDS format with optional mip levels. DXT1, DXT5, ETC1, ETC2 RGB and ETC2 RGBA formats are supported. Return true if successful.
+    bool SaveCompressedDDS(Serializer& dest, CompressedFormat format, bool mipmaps = true) const;
     /// Save in WebP format with minimum (fastest) or specified compression. Return true if successful. Fails always if WebP support is not compiled in.
     bool SaveWEBP(const ea::string& fileName, float compression = 0.0f) const;
     /// Whether this texture is detected as a cubemap, only relevant for DDS.
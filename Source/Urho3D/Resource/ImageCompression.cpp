@@ -0,0 +1,538 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Resource/ImageCompression.h"
+
+#include "../Core/WorkQueue.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// RGBA pixels of 4x4 block in row-major order.
+using PixelBlock = unsigned char[16][4];
+
+/// ETC1 intensity modifier tables, only positive values are listed.
+const int etcModifiers[8][2] = {{2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+
+/// EAC alpha modifier tables.
+const int eacModifiers[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14},
+    {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12},
+    {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11},
+    {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10},
+    {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},
+    {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},
+    {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},
+    {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},
+    {-3, -5, -7, -9, 2, 4, 6, 8},
+};
+
+unsigned GetBlockSize(CompressedFormat format)
+{
+    switch (format)
+    {
+    case CF_DXT1:
+    case CF_ETC1:
+    case CF_ETC2_RGB:
+        return 8;
+
+    case CF_DXT5:
+    case CF_ETC2_RGBA:
+        return 16;
+
+    default:
+        return 0;
+    }
+}
+
+int Clamp255(int value)
+{
+    return Clamp(value, 0, 255);
+}
+
+int Square(int value)
+{
+    return value * value;
+}
+
+void FetchBlock(PixelBlock& block, const unsigned char* rgba, int width, int height, int blockX, int blockY)
+{
+    // Edge blocks repeat the last row and column
+    for (int y = 0; y < 4; ++y)
+    {
+        for (int x = 0; x < 4; ++x)
+        {
+            const int sourceX = Min(blockX * 4 + x, width - 1);
+            const int sourceY = Min(blockY * 4 + y, height - 1);
+            memcpy(block[y * 4 + x], rgba + (sourceY * width + sourceX) * 4, 4);
+        }
+    }
+}
+
+unsigned short PackRGB565(const Vector3& color)
+{
+    const int r = Clamp(RoundToInt(color.x_ * 31.0f / 255.0f), 0, 31);
+    const int g = Clamp(RoundToInt(color.y_ * 63.0f / 255.0f), 0, 63);
+    const int b = Clamp(RoundToInt(color.z_ * 31.0f / 255.0f), 0, 31);
+    return static_cast<unsigned short>((r << 11) | (g << 5) | b);
+}
+
+IntVector3 UnpackRGB565(unsigned short value)
+{
+    const int r = (value >> 11) & 31;
+    const int g = (value >> 5) & 63;
+    const int b = value & 31;
+    return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+/// Compress colors into DXT color block. Endpoints are taken along the principal axis of the colors.
+void CompressColorBlock(unsigned char* dest, const PixelBlock& block)
+{
+    Vector3 colors[16];
+    Vector3 mean;
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        colors[i] = Vector3{static_cast<float>(block[i][0]), static_cast<float>(block[i][1]),
+            static_cast<float>(block[i][2])};
+        mean += colors[i];
+    }
+    mean /= 16.0f;
+
+    // Covariance matrix: xx, xy, xz, yy, yz, zz
+    float covariance[6]{};
+    for (const Vector3& color : colors)
+    {
+        const Vector3 delta = color - mean;
+        covariance[0] += delta.x_ * delta.x_;
+        covariance[1] += delta.x_ * delta.y_;
+        covariance[2] += delta.x_ * delta.z_;
+        covariance[3] += delta.y_ * delta.y_;
+        covariance[4] += delta.y_ * delta.z_;
+        covariance[5] += delta.z_ * delta.z_;
+    }
+
+    // Power iteration converges quickly for typical blocks
+    Vector3 axis = Vector3::ONE;
+    for (unsigned iteration = 0; iteration < 8; ++iteration)
+    {
+        axis = Vector3{covariance[0] * axis.x_ + covariance[1] * axis.y_ + covariance[2] * axis.z_,
+            covariance[1] * axis.x_ + covariance[3] * axis.y_ + covariance[4] * axis.z_,
+            covariance[2] * axis.x_ + covariance[4] * axis.y_ + covariance[5] * axis.z_};
+        const float length = axis.Length();
+        if (length < M_EPSILON)
+        {
+            axis = Vector3::ZERO;
+            break;
+        }
+        axis /= length;
+    }
+
+    float minProjection = 0.0f;
+    float maxProjection = 0.0f;
+    for (const Vector3& color : colors)
+    {
+        const float projection = (color - mean).DotProduct(axis);
+        minProjection = Min(minProjection, projection);
+        maxProjection = Max(maxProjection, projection);
+    }
+
+    unsigned short color0 = PackRGB565(mean + axis * maxProjection);
+    unsigned short color1 = PackRGB565(mean + axis * minProjection);
+    if (color0 < color1)
+        ea::swap(color0, color1);
+
+    unsigned indices = 0;
+    if (color0 != color1)
+    {
+        // Four color mode is used because color0 > color1
+        const IntVector3 endpoint0 = UnpackRGB565(color0);
+        const IntVector3 endpoint1 = UnpackRGB565(color1);
+        const IntVector3 palette[4] = {
+            endpoint0,
+            endpoint1,
+            (endpoint0 * 2 + endpoint1) / 3,
+            (endpoint0 + endpoint1 * 2) / 3,
+        };
+
+        for (unsigned i = 0; i < 16; ++i)
+        {
+            unsigned bestIndex = 0;
+            int bestError = M_MAX_INT;
+            for (unsigned index = 0; index < 4; ++index)
+            {
+                const int error = Square(block[i][0] - palette[index].x_) + Square(block[i][1] - palette[index].y_)
+                    + Square(block[i][2] - palette[index].z_);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    bestIndex = index;
+                }
+            }
+            indices |= bestIndex << (i * 2);
+        }
+    }
+
+    dest[0] = color0 & 0xff;
+    dest[1] = color0 >> 8;
+    dest[2] = color1 & 0xff;
+    dest[3] = color1 >> 8;
+    for (unsigned i = 0; i < 4; ++i)
+        dest[4 + i] = (indices >> (i * 8)) & 0xff;
+}
+
+/// Compress alpha into DXT5 alpha block with eight interpolated values.
+void CompressAlphaBlock(unsigned char* dest, const PixelBlock& block)
+{
+    int minAlpha = 255;
+    int maxAlpha = 0;
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        minAlpha = Min<int>(minAlpha, block[i][3]);
+        maxAlpha = Max<int>(maxAlpha, block[i][3]);
+    }
+
+    unsigned long long indices = 0;
+    if (maxAlpha > minAlpha)
+    {
+        int palette[8] = {maxAlpha, minAlpha};
+        for (int i = 1; i < 7; ++i)
+            palette[i + 1] = ((7 - i) * maxAlpha + i * minAlpha) / 7;
+
+        for (unsigned i = 0; i < 16; ++i)
+        {
+            unsigned long long bestIndex = 0;
+            int bestError = M_MAX_INT;
+            for (unsigned index = 0; index < 8; ++index)
+            {
+                const int error = Abs(block[i][3] - palette[index]);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    bestIndex = index;
+                }
+            }
+            indices |= bestIndex << (i * 3);
+        }
+    }
+
+    dest[0] = static_cast<unsigned char>(maxAlpha);
+    dest[1] = static_cast<unsigned char>(minAlpha);
+    for (unsigned i = 0; i < 6; ++i)
+        dest[2 + i] = (indices >> (i * 8)) & 0xff;
+}
+
+/// Return whether the pixel belongs to the first ETC sub-block.
+bool IsInFirstETCSubBlock(unsigned x, unsigned y, bool flip)
+{
+    return flip ? y < 2 : x < 2;
+}
+
+/// Choose modifier table and pixel indices of ETC sub-block. Return squared error.
+int CompressETCSubBlock(const PixelBlock& block, const IntVector3& baseColor, bool flip, bool firstSubBlock,
+    unsigned& table, unsigned& indexBits)
+{
+    int bestError = M_MAX_INT;
+    for (unsigned tableIndex = 0; tableIndex < 8; ++tableIndex)
+    {
+        const int modifiers[4] = {etcModifiers[tableIndex][0], etcModifiers[tableIndex][1],
+            -etcModifiers[tableIndex][0], -etcModifiers[tableIndex][1]};
+
+        int error = 0;
+        unsigned bits = 0;
+        for (unsigned x = 0; x < 4; ++x)
+        {
+            for (unsigned y = 0; y < 4; ++y)
+            {
+                if (IsInFirstETCSubBlock(x, y, flip) != firstSubBlock)
+                    continue;
+
+                const unsigned char* pixel = block[y * 4 + x];
+                unsigned bestIndex = 0;
+                int bestPixelError = M_MAX_INT;
+                for (unsigned index = 0; index < 4; ++index)
+                {
+                    const int pixelError = Square(pixel[0] - Clamp255(baseColor.x_ + modifiers[index]))
+                        + Square(pixel[1] - Clamp255(baseColor.y_ + modifiers[index]))
+                        + Square(pixel[2] - Clamp255(baseColor.z_ + modifiers[index]));
+                    if (pixelError < bestPixelError)
+                    {
+                        bestPixelError = pixelError;
+                        bestIndex = index;
+                    }
+                }
+
+                // Most significant bits of indices are stored in upper half
+                const unsigned bitIndex = x * 4 + y;
+                bits |= (bestIndex >> 1) << (bitIndex + 16);
+                bits |= (bestIndex & 1) << bitIndex;
+                error += bestPixelError;
+            }
+        }
+
+        if (error < bestError)
+        {
+            bestError = error;
+            table = tableIndex;
+            indexBits = bits;
+        }
+    }
+    return bestError;
+}
+
+/// Compress colors into ETC1 block. The block is also valid ETC2 RGB block.
+void CompressETCBlock(unsigned char* dest, const PixelBlock& block)
+{
+    int bestError = M_MAX_INT;
+    unsigned bestHigh = 0;
+    unsigned bestLow = 0;
+
+    for (bool flip : {false, true})
+    {
+        Vector3 averages[2];
+        for (unsigned x = 0; x < 4; ++x)
+        {
+            for (unsigned y = 0; y < 4; ++y)
+            {
+                const unsigned char* pixel = block[y * 4 + x];
+                averages[IsInFirstETCSubBlock(x, y, flip) ? 0 : 1] +=
+                    Vector3{static_cast<float>(pixel[0]), static_cast<float>(pixel[1]), static_cast<float>(pixel[2])};
+            }
+        }
+        averages[0] /= 8.0f;
+        averages[1] /= 8.0f;
+
+        // Prefer differential mode with 5-bit colors if the delta fits into 3 bits
+        const auto quantize = [](const Vector3& color, float maxValue)
+        {
+            return IntVector3{RoundToInt(color.x_ * maxValue / 255.0f), RoundToInt(color.y_ * maxValue / 255.0f),
+                RoundToInt(color.z_ * maxValue / 255.0f)};
+        };
+        const IntVector3 quantized0 = quantize(averages[0], 31.0f);
+        const IntVector3 quantized1 = quantize(averages[1], 31.0f);
+        const IntVector3 delta = quantized1 - quantized0;
+        const bool differential = delta.x_ >= -4 && delta.x_ <= 3 && delta.y_ >= -4 && delta.y_ <= 3
+            && delta.z_ >= -4 && delta.z_ <= 3;
+
+        IntVector3 baseColors[2];
+        unsigned high = 0;
+        if (differential)
+        {
+            const auto expand5 = [](int value) { return (value << 3) | (value >> 2); };
+            baseColors[0] = {expand5(quantized0.x_), expand5(quantized0.y_), expand5(quantized0.z_)};
+            baseColors[1] = {expand5(quantized1.x_), expand5(quantized1.y_), expand5(quantized1.z_)};
+            high = (static_cast<unsigned>(quantized0.x_) << 27) | ((delta.x_ & 7u) << 24)
+                | (static_cast<unsigned>(quantized0.y_) << 19) | ((delta.y_ & 7u) << 16)
+                | (static_cast<unsigned>(quantized0.z_) << 11) | ((delta.z_ & 7u) << 8) | 0x2u;
+        }
+        else
+        {
+            const IntVector3 individual0 = quantize(averages[0], 15.0f);
+            const IntVector3 individual1 = quantize(averages[1], 15.0f);
+            baseColors[0] = individual0 * 17;
+            baseColors[1] = individual1 * 17;
+            high = (static_cast<unsigned>(individual0.x_) << 28) | (static_cast<unsigned>(individual1.x_) << 24)
+                | (static_cast<unsigned>(individual0.y_) << 20) | (static_cast<unsigned>(individual1.y_) << 16)
+                | (static_cast<unsigned>(individual0.z_) << 12) | (static_cast<unsigned>(individual1.z_) << 8);
+        }
+
+        unsigned tables[2]{};
+        unsigned indexBits[2]{};
+        const int error = CompressETCSubBlock(block, baseColors[0], flip, true, tables[0], indexBits[0])
+            + CompressETCSubBlock(block, baseColors[1], flip, false, tables[1], indexBits[1]);
+
+        if (error < bestError)
+        {
+            bestError = error;
+            bestHigh = high | (tables[0] << 5) | (tables[1] << 2) | (flip ? 1 : 0);
+            bestLow = indexBits[0] | indexBits[1];
+        }
+    }
+
+    // Blocks are stored as big-endian words
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        dest[i] = (bestHigh >> (24 - i * 8)) & 0xff;
+        dest[4 + i] = (bestLow >> (24 - i * 8)) & 0xff;
+    }
+}
+
+/// Compress alpha into ETC2 EAC alpha block.
+void CompressEACAlphaBlock(unsigned char* dest, const PixelBlock& block)
+{
+    int minAlpha = 255;
+    int maxAlpha = 0;
+    for (unsigned i = 0; i < 16; ++i)
+    {
+        minAlpha = Min<int>(minAlpha, block[i][3]);
+        maxAlpha = Max<int>(maxAlpha, block[i][3]);
+    }
+
+    int bestError = M_MAX_INT;
+    unsigned char bestHeader[2]{};
+    unsigned long long bestIndices = 0;
+    for (unsigned tableIndex = 0; tableIndex < 16; ++tableIndex)
+    {
+        const int* modifiers = eacModifiers[tableIndex];
+        const int span = modifiers[7] - modifiers[3];
+        const int multiplier = Clamp((maxAlpha - minAlpha + span - 1) / span, 1, 15);
+        const int base = (minAlpha + maxAlpha - (modifiers[7] + modifiers[3]) * multiplier) / 2;
+
+        // Small neighborhood search compensates for rounding of the base and multiplier
+        for (int multiplierOffset = -1; multiplierOffset <= 1; ++multiplierOffset)
+        {
+            const int effectiveMultiplier = multiplier + multiplierOffset;
+            if (effectiveMultiplier < 1 || effectiveMultiplier > 15)
+                continue;
+
+            for (int baseOffset = -1; baseOffset <= 1; ++baseOffset)
+            {
+                const int effectiveBase = Clamp255(base + baseOffset);
+
+                int error = 0;
+                unsigned long long indices = 0;
+                for (unsigned x = 0; x < 4; ++x)
+                {
+                    for (unsigned y = 0; y < 4; ++y)
+                    {
+                        const int alpha = block[y * 4 + x][3];
+                        unsigned long long bestIndex = 0;
+                        int bestPixelError = M_MAX_INT;
+                        for (unsigned index = 0; index < 8; ++index)
+                        {
+                            const int value = Clamp255(effectiveBase + modifiers[index] * effectiveMultiplier);
+                            const int pixelError = Square(alpha - value);
+                            if (pixelError < bestPixelError)
+                            {
+                                bestPixelError = pixelError;
+                                bestIndex = index;
+                            }
+                        }
+
+                        // Pixels are stored in column-major order starting from the most significant bits
+                        indices |= bestIndex << (45 - (x * 4 + y) * 3);
+                        error += bestPixelError;
+                    }
+                }
+
+                if (error < bestError)
+                {
+                    bestError = error;
+                    bestHeader[0] = static_cast<unsigned char>(effectiveBase);
+                    bestHeader[1] = static_cast<unsigned char>((effectiveMultiplier << 4) | tableIndex);
+                    bestIndices = indices;
+                }
+            }
+        }
+    }
+
+    dest[0] = bestHeader[0];
+    dest[1] = bestHeader[1];
+    for (unsigned i = 0; i < 6; ++i)
+        dest[2 + i] = (bestIndices >> (40 - i * 8)) & 0xff;
+}
+
+void CompressBlock(unsigned char* dest, const PixelBlock& block, CompressedFormat format)
+{
+    switch (format)
+    {
+    case CF_DXT1:
+        CompressColorBlock(dest, block);
+        break;
+
+    case CF_DXT5:
+        CompressAlphaBlock(dest, block);
+        CompressColorBlock(dest + 8, block);
+        break;
+
+    case CF_ETC1:
+    case CF_ETC2_RGB:
+        CompressETCBlock(dest, block);
+        break;
+
+    case CF_ETC2_RGBA:
+        CompressEACAlphaBlock(dest, block);
+        CompressETCBlock(dest + 8, block);
+        break;
+
+    default:
+        break;
+    }
+}
+
+}
+
+bool IsImageCompressionSupported(CompressedFormat format)
+{
+    return GetBlockSize(format) != 0;
+}
+
+unsigned GetCompressedImageSize(int width, int height, CompressedFormat format)
+{
+    const unsigned blocksX = (Max(width, 1) + 3) / 4;
+    const unsigned blocksY = (Max(height, 1) + 3) / 4;
+    return blocksX * blocksY * GetBlockSize(format);
+}
+
+bool CompressImage(unsigned char* blocks, const unsigned char* rgba, int width, int height,
+    CompressedFormat format, WorkQueue* workQueue)
+{
+    const unsigned blockSize = GetBlockSize(format);
+    if (!blockSize || width <= 0 || height <= 0)
+        return false;
+
+    const int blocksX = (width + 3) / 4;
+    const int blocksY = (height + 3) / 4;
+    const auto compressRows = [&](unsigned beginRow, unsigned endRow)
+    {
+        PixelBlock block;
+        for (int blockY = static_cast<int>(beginRow); blockY < static_cast<int>(endRow); ++blockY)
+        {
+            for (int blockX = 0; blockX < blocksX; ++blockX)
+            {
+                FetchBlock(block, rgba, width, height, blockX, blockY);
+                CompressBlock(blocks + (blockY * blocksX + blockX) * blockSize, block, format);
+            }
+        }
+    };
+
+    if (workQueue)
+        ForEachParallel(workQueue, 1u, static_cast<unsigned>(blocksY), compressRows);
+    else
+        compressRows(0, blocksY);
+    return true;
+}
+
+}
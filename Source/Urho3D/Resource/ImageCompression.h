@@ -0,0 +1,44 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+/// \file
+/// Block compression of RGBA images, counterpart of Decompress.h.
+
+#pragma once
+
+#include "../Resource/Image.h"
+
+namespace Urho3D
+{
+
+class WorkQueue;
+
+/// Return whether the format is supported by CompressImage.
+URHO3D_API bool IsImageCompressionSupported(CompressedFormat format);
+/// Return size in bytes of compressed image data. Return 0 if the format is not supported.
+URHO3D_API unsigned GetCompressedImageSize(int width, int height, CompressedFormat format);
+/// Compress RGBA image into DXT1, DXT5, ETC1, ETC2 RGB or ETC2 RGBA blocks. Return false if the format is not supported.
+/// Rows of blocks are compressed in parallel if the work queue is provided.
+URHO3D_API bool CompressImage(unsigned char* blocks, const unsigned char* rgba, int width, int height,
+    CompressedFormat format, WorkQueue* workQueue = nullptr);
+
+}
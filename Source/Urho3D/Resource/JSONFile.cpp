@@ -35,6 +35,7 @@
 #include <rapidjson/document.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/prettywriter.h>
+#include <rapidjson/reader.h>
 
 #include "../DebugNew.h"
 
@@ -55,61 +56,96 @@ void JSONFile::RegisterObject(Context* context)
     context->AddFactoryReflection<JSONFile>();
 }
 
-// Convert rapidjson value to JSON value.
-static void ToJSONValue(JSONValue& jsonValue, const rapidjson::Value& rapidjsonValue)
+namespace
 {
-    switch (rapidjsonValue.GetType())
+
+/// SAX handler that builds JSON value directly from rapidjson reader events without intermediate document.
+class JSONValueBuilder : public BaseReaderHandler<UTF8<>, JSONValueBuilder>
+{
+public:
+    explicit JSONValueBuilder(JSONValue& root)
+        : root_(root)
     {
-    case kNullType:
-        // Reset to null type
-        jsonValue.SetType(JSON_NULL);
-        break;
+    }
 
-    case kFalseType:
-        jsonValue = false;
-        break;
+    bool Null() { CreateValue().SetType(JSON_NULL); return true; }
+    bool Bool(bool value) { CreateValue() = value; return true; }
+    bool Int(int value) { CreateValue() = value; return true; }
+    bool Uint(unsigned value) { CreateValue() = value; return true; }
+    bool Int64(int64_t value) { CreateValue() = static_cast<double>(value); return true; }
+    bool Uint64(uint64_t value) { CreateValue() = static_cast<double>(value); return true; }
+    bool Double(double value) { CreateValue() = value; return true; }
 
-    case kTrueType:
-        jsonValue = true;
-        break;
+    bool String(const char* value, SizeType length, bool /*copy*/)
+    {
+        CreateValue() = ea::string(value, length);
+        return true;
+    }
 
-    case kNumberType:
-        if (rapidjsonValue.IsInt())
-            jsonValue = rapidjsonValue.GetInt();
-        else if (rapidjsonValue.IsUint())
-            jsonValue = rapidjsonValue.GetUint();
-        else
-            jsonValue = rapidjsonValue.GetDouble();
-        break;
+    bool Key(const char* value, SizeType length, bool /*copy*/)
+    {
+        key_.assign(value, length);
+        return true;
+    }
 
-    case kStringType:
-        jsonValue = rapidjsonValue.GetString();
-        break;
+    bool StartObject()
+    {
+        JSONValue& value = CreateValue();
+        value.SetType(JSON_OBJECT);
+        stack_.push_back(&value);
+        return true;
+    }
 
-    case kArrayType:
-        {
-            jsonValue.Resize(rapidjsonValue.Size());
-            for (unsigned i = 0; i < rapidjsonValue.Size(); ++i)
-            {
-                ToJSONValue(jsonValue[i], rapidjsonValue[i]);
-            }
-        }
-        break;
+    bool StartArray()
+    {
+        JSONValue& value = CreateValue();
+        value.SetType(JSON_ARRAY);
+        stack_.push_back(&value);
+        return true;
+    }
+
+    bool EndObject(SizeType /*memberCount*/) { stack_.pop_back(); return true; }
+    bool EndArray(SizeType /*elementCount*/) { stack_.pop_back(); return true; }
 
-    case kObjectType:
+private:
+    /// Create new value in the current container. Previous siblings are complete at this point,
+    /// so reallocation of the parent array doesn't invalidate any pointer on the stack.
+    JSONValue& CreateValue()
+    {
+        if (stack_.empty())
+            return root_;
+
+        JSONValue& parent = *stack_.back();
+        if (parent.IsArray())
         {
-            jsonValue.SetType(JSON_OBJECT);
-            for (rapidjson::Value::ConstMemberIterator i = rapidjsonValue.MemberBegin(); i != rapidjsonValue.MemberEnd(); ++i)
-            {
-                JSONValue& value = jsonValue[ea::string(i->name.GetString())];
-                ToJSONValue(value, i->value);
-            }
+            parent.Push(JSONValue{});
+            return parent[parent.Size() - 1];
         }
-        break;
-
-    default:
-        break;
+        return parent[key_];
     }
+
+    /// Root value.
+    JSONValue& root_;
+    /// Stack of open arrays and objects.
+    ea::vector<JSONValue*> stack_;
+    /// Last parsed object key.
+    ea::string key_;
+};
+
+/// Parse null-terminated JSON string into value. Value is left unchanged on error.
+template <unsigned ParseFlags>
+ParseResult ParseJSONValue(const char* json, JSONValue& value)
+{
+    JSONValue result;
+    JSONValueBuilder builder{result};
+    StringStream stream{json};
+    Reader reader;
+    const ParseResult parseResult = reader.Parse<ParseFlags>(stream, builder);
+    if (!parseResult.IsError())
+        value = ea::move(result);
+    return parseResult;
+}
+
 }
 
 bool JSONFile::BeginLoad(Deserializer& source)
@@ -126,15 +162,12 @@ bool JSONFile::BeginLoad(Deserializer& source)
         return false;
     buffer[dataSize] = '\0';
 
-    rapidjson::Document document;
-    if (document.Parse<kParseCommentsFlag | kParseTrailingCommasFlag>(buffer.get()).HasParseError())
+    if (ParseJSONValue<kParseCommentsFlag | kParseTrailingCommasFlag>(buffer.get(), root_).IsError())
     {
         URHO3D_LOGERROR("Could not parse JSON data from " + source.GetName());
         return false;
     }
 
-    ToJSONValue(root_, document);
-
     SetMemoryUse(dataSize);
 
     return true;
@@ -273,15 +306,14 @@ bool JSONFile::FromString(const ea::string & source)
 
 bool JSONFile::ParseJSON(const ea::string& json, JSONValue& value, bool reportError)
 {
-    rapidjson::Document document;
-    if (document.Parse<0>(json.c_str()).HasParseError())
+    const ParseResult result = ParseJSONValue<0>(json.c_str(), value);
+    if (result.IsError())
     {
         if (reportError)
-            URHO3D_LOGERRORF("Could not parse JSON data from string with error: %s", document.GetParseError());
+            URHO3D_LOGERRORF("Could not parse JSON data from string with error: %d", result.Code());
 
         return false;
     }
-    ToJSONValue(value, document);
     return true;
 }
 
@@ -25,11 +25,15 @@
 #include "../Core/Context.h"
 #include "../Core/CoreEvents.h"
 #include "../Core/Profiler.h"
+#include "../Core/Timer.h"
 #include "../Core/WorkQueue.h"
+#include "../IO/FileIndex.h"
 #include "../IO/FileSystem.h"
 #include "../IO/FileWatcher.h"
 #include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
 #include "../IO/PackageFile.h"
+#include "../IO/VectorBuffer.h"
 #include "../Resource/BackgroundLoader.h"
 #include "../Resource/BinaryFile.h"
 #include "../Resource/Image.h"
@@ -93,6 +97,11 @@ ResourceCache::ResourceCache(Context* context) :
     // Register Resource library object factories
     RegisterResourceLibrary(context_);
 
+    loadsMetric_ = GetMetricCounter(context_, "urho3d_resource_loads_total", "Number of loaded resources");
+    loadFailuresMetric_ = GetMetricCounter(context_, "urho3d_resource_load_failures_total", "Number of resources failed to load");
+    loadTimeMetric_ = GetMetricHistogram(context_, "urho3d_resource_load_time_seconds", GetDefaultTimingBounds(),
+        "Time of synchronous resource loading");
+
 #ifdef URHO3D_THREADING
     // Create resource background loader. Its thread will start on the first background request
     backgroundLoader_ = new BackgroundLoader(this);
@@ -138,9 +147,17 @@ bool ResourceCache::AddResourceDir(const ea::string& pathName, unsigned priority
     }
 
     if (priority < resourceDirs_.size())
+    {
         resourceDirs_.insert_at(priority, fixedPath);
+        if (fileIndexEnabled_)
+            fileIndices_.insert_at(priority, CreateFileIndex(fixedPath));
+    }
     else
+    {
         resourceDirs_.push_back(fixedPath);
+        if (fileIndexEnabled_)
+            fileIndices_.push_back(CreateFileIndex(fixedPath));
+    }
 
     // If resource auto-reloading active, create a file watcher for the directory
     if (autoReloadResources_)
@@ -212,6 +229,8 @@ void ResourceCache::RemoveResourceDir(const ea::string& pathName)
         if (!resourceDirs_[i].comparei(fixedPath))
         {
             resourceDirs_.erase_at(i);
+            if (fileIndexEnabled_)
+                fileIndices_.erase_at(i);
             // Remove the filewatcher with the matching path
             for (unsigned j = 0; j < fileWatchers_.size(); ++j)
             {
@@ -443,12 +462,17 @@ bool ResourceCache::ReloadResource(Resource* resource)
     if (!resource)
         return false;
 
+    const AbstractFilePtr file = GetFile(resource->GetName());
+    return ReloadResource(resource, file.Get());
+}
+
+bool ResourceCache::ReloadResource(Resource* resource, AbstractFile* file)
+{
     resource->SendEvent(E_RELOADSTARTED);
 
     bool success = false;
-    const AbstractFilePtr file = GetFile(resource->GetName());
     if (file)
-        success = resource->Load(*(file.Get()));
+        success = resource->Load(*file);
 
     if (success)
     {
@@ -466,41 +490,74 @@ bool ResourceCache::ReloadResource(Resource* resource)
 
 void ResourceCache::ReloadResourceWithDependencies(const ea::string& fileName)
 {
-    StringHash fileNameHash(fileName);
-    // If the filename is a resource we keep track of, reload it
-    const SharedPtr<Resource>& resource = FindResource(fileNameHash);
-    if (resource)
+    ReloadResourcesWithDependencies({fileName});
+}
+
+void ResourceCache::ReloadResourcesWithDependencies(const ea::vector<ea::string>& fileNames)
+{
+    // Reloading a resource may modify the dependency tracking structure. Therefore collect the
+    // resources we need to reload first. Changed resources go before resources depending on them.
+    ea::vector<SharedPtr<Resource>> resources;
+    ea::hash_set<Resource*> visitedResources;
+    const auto addResource = [&](Resource* resource)
+    {
+        if (visitedResources.insert(resource).second)
+            resources.emplace_back(resource);
+    };
+
+    for (const ea::string& fileName : fileNames)
     {
-        URHO3D_LOGDEBUG("Reloading changed resource " + fileName);
-        ReloadResource(resource.Get());
+        // If the filename is a resource we keep track of, reload it
+        if (const SharedPtr<Resource>& resource = FindResource(StringHash{fileName}))
+        {
+            URHO3D_LOGDEBUG("Reloading changed resource " + fileName);
+            addResource(resource);
+        }
     }
-    // Always perform dependency resource check for resource loaded from XML file as it could be used in inheritance
-    if (NeedToReloadDependencies(resource))
+
+    for (const ea::string& fileName : fileNames)
     {
+        const StringHash fileNameHash{fileName};
+        // Always perform dependency resource check for resource loaded from XML file as it could be used in inheritance
+        if (!NeedToReloadDependencies(FindResource(fileNameHash)))
+            continue;
+
         // Check if this is a dependency resource, reload dependents
-        auto j = dependentResources_.find(
-            fileNameHash);
-        if (j != dependentResources_.end())
-        {
-            // Reloading a resource may modify the dependency tracking structure. Therefore collect the
-            // resources we need to reload first
-            ea::vector<SharedPtr<Resource> > dependents;
-            dependents.reserve(j->second.size());
+        const auto iter = dependentResources_.find(fileNameHash);
+        if (iter == dependentResources_.end())
+            continue;
 
-            for (auto k = j->second.begin(); k != j->second.end(); ++k)
+        for (const StringHash& dependentNameHash : iter->second)
+        {
+            if (const SharedPtr<Resource>& dependent = FindResource(dependentNameHash))
             {
-                const SharedPtr<Resource>& dependent = FindResource(*k);
-                if (dependent)
-                    dependents.push_back(dependent);
+                URHO3D_LOGDEBUG("Reloading resource " + dependent->GetName() + " depending on " + fileName);
+                addResource(dependent);
             }
+        }
+    }
+
+    // Read files in parallel. Resources are loaded on the main thread because they are modified in place
+    ea::vector<AbstractFilePtr> files(resources.size());
+    ea::vector<ea::unique_ptr<VectorBuffer>> buffers(resources.size());
+    ForEachParallel(GetSubsystem<WorkQueue>(), 1u, resources.size(),
+        [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+        {
+            files[i] = GetFile(resources[i]->GetName(), false);
 
-            for (unsigned k = 0; k < dependents.size(); ++k)
+            // Memory backed files (e.g. memory mapped package entries) can be loaded directly
+            if (files[i] && !dynamic_cast<MemoryBuffer*>(files[i].Get()))
             {
-                URHO3D_LOGDEBUG("Reloading resource " + dependents[k]->GetName() + " depending on " + fileName);
-                ReloadResource(dependents[k].Get());
+                buffers[i] = ea::make_unique<VectorBuffer>(*files[i], files[i]->GetSize());
+                buffers[i]->SetName(files[i]->GetName());
             }
         }
-    }
+    });
+
+    for (unsigned i = 0; i < resources.size(); ++i)
+        ReloadResource(resources[i], buffers[i] ? buffers[i].get() : files[i].Get());
 }
 
 void ResourceCache::SetMemoryBudget(StringHash type, unsigned long long budget)
@@ -508,6 +565,90 @@ void ResourceCache::SetMemoryBudget(StringHash type, unsigned long long budget)
     resourceGroups_[type].memoryBudget_ = budget;
 }
 
+void ResourceCache::SetFileIndexEnabled(bool enable)
+{
+    MutexLock lock(resourceMutex_);
+
+    if (enable == fileIndexEnabled_)
+        return;
+
+    fileIndices_.clear();
+    if (enable)
+        fileIndices_ = CreateFileIndices(resourceDirs_);
+    fileIndexEnabled_ = enable;
+}
+
+bool ResourceCache::SaveFileIndex(const ea::string& fileName) const
+{
+    MutexLock lock(resourceMutex_);
+
+    File file(context_, fileName, FILE_WRITE);
+    if (!file.IsOpen())
+    {
+        URHO3D_LOGERROR("Could not open file index {} for writing", fileName);
+        return false;
+    }
+
+    const ea::vector<SharedPtr<FileIndex>> indices = fileIndexEnabled_ ? fileIndices_ : CreateFileIndices(resourceDirs_);
+
+    file.WriteFileID("FIDX");
+    file.WriteVLE(indices.size());
+    for (const FileIndex* index : indices)
+    {
+        if (!index->Save(file))
+        {
+            URHO3D_LOGERROR("Could not write file index {}", fileName);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ResourceCache::LoadFileIndex(const ea::string& fileName)
+{
+    MutexLock lock(resourceMutex_);
+
+    File file(context_, fileName);
+    if (!file.IsOpen() || file.ReadFileID() != "FIDX")
+    {
+        URHO3D_LOGERROR("Could not read file index {}", fileName);
+        return false;
+    }
+
+    ea::unordered_map<ea::string, SharedPtr<FileIndex>> loadedIndices;
+    const unsigned numIndices = file.ReadVLE();
+    for (unsigned i = 0; i < numIndices; ++i)
+    {
+        auto index = MakeShared<FileIndex>(EMPTY_STRING);
+        if (!index->Load(file))
+        {
+            URHO3D_LOGERROR("Could not read file index {}", fileName);
+            return false;
+        }
+        loadedIndices[index->GetDirectory().to_lower()] = index;
+    }
+
+    fileIndices_.clear();
+    ea::vector<unsigned> missingIndices;
+    ea::vector<ea::string> missingDirs;
+    for (const ea::string& resourceDir : resourceDirs_)
+    {
+        const auto iter = loadedIndices.find(AddTrailingSlash(resourceDir).to_lower());
+        if (iter == loadedIndices.end())
+        {
+            missingIndices.push_back(fileIndices_.size());
+            missingDirs.push_back(resourceDir);
+        }
+        fileIndices_.push_back(iter != loadedIndices.end() ? iter->second : nullptr);
+    }
+
+    const ea::vector<SharedPtr<FileIndex>> scannedIndices = CreateFileIndices(missingDirs);
+    for (unsigned i = 0; i < missingIndices.size(); ++i)
+        fileIndices_[missingIndices[i]] = scannedIndices[i];
+    fileIndexEnabled_ = true;
+    return true;
+}
+
 void ResourceCache::SetAutoReloadResources(bool enable)
 {
     if (enable != autoReloadResources_)
@@ -676,8 +817,14 @@ Resource* ResourceCache::GetResource(StringHash type, const ea::string& name, bo
     resource->SetName(sanitatedName);
     resource->SetAbsoluteFileName(file->GetAbsoluteName());
 
-    if (!resource->Load(*(file.Get())))
+    HiresTimer loadTimer;
+    const bool loaded = resource->Load(*(file.Get()));
+    loadTimeMetric_->Observe(loadTimer.GetUSec(false) / 1000000.0);
+    loadsMetric_->Increment();
+
+    if (!loaded)
     {
+        loadFailuresMetric_->Increment();
         // Error should already been logged by corresponding resource descendant class
         if (sendEventOnFailure)
         {
@@ -720,6 +867,37 @@ bool ResourceCache::BackgroundLoadResource(StringHash type, const ea::string& na
 #endif
 }
 
+SharedPtr<ResourceLoadRequest> ResourceCache::RequestResource(
+    StringHash type, const ea::string& name, float priority, ResourceLoadCallback callback, bool sendEventOnFailure)
+{
+    const ea::string sanitatedName = SanitateResourceName(name);
+    SharedPtr<ResourceLoadRequest> request{new ResourceLoadRequest(type, sanitatedName, priority, ea::move(callback))};
+
+    // If empty name, fail immediately
+    if (sanitatedName.empty())
+    {
+        request->Complete(nullptr, false);
+        return request;
+    }
+
+    // First check if already exists as a loaded resource
+    if (Resource* existingResource = FindResource(type, StringHash(sanitatedName)))
+    {
+        request->Complete(existingResource, true);
+        return request;
+    }
+
+#ifdef URHO3D_THREADING
+    if (!backgroundLoader_->QueueRequest(request, sendEventOnFailure))
+        request->Complete(nullptr, false);
+#else
+    // When threading not supported, fall back to synchronous loading
+    Resource* resource = GetResource(type, sanitatedName, sendEventOnFailure);
+    request->Complete(resource, resource != nullptr);
+#endif
+    return request;
+}
+
 SharedPtr<Resource> ResourceCache::GetTempResource(StringHash type, const ea::string& name, bool sendEventOnFailure)
 {
     ea::string sanitatedName = SanitateResourceName(name);
@@ -774,6 +952,13 @@ SharedPtr<Resource> ResourceCache::GetTempResource(StringHash type, const ea::st
     return resource;
 }
 
+void ResourceCache::SetBackgroundLoaderAffinity(unsigned long long mask)
+{
+#ifdef URHO3D_THREADING
+    backgroundLoader_->SetAffinity(mask);
+#endif
+}
+
 unsigned ResourceCache::GetNumBackgroundLoadResources() const
 {
 #ifdef URHO3D_THREADING
@@ -814,7 +999,7 @@ bool ResourceCache::Exists(const ea::string& name) const
     auto* fileSystem = GetSubsystem<FileSystem>();
     for (unsigned i = 0; i < resourceDirs_.size(); ++i)
     {
-        if (fileSystem->FileExists(resourceDirs_[i] + sanitatedName))
+        if (ResourceDirContains(i, sanitatedName))
             return true;
     }
 
@@ -850,7 +1035,7 @@ ea::string ResourceCache::GetResourceFileName(const ea::string& name) const
     auto* fileSystem = GetSubsystem<FileSystem>();
     for (unsigned i = 0; i < resourceDirs_.size(); ++i)
     {
-        if (fileSystem->FileExists(resourceDirs_[i] + name))
+        if (ResourceDirContains(i, name))
             return resourceDirs_[i] + name;
     }
 
@@ -1139,13 +1324,24 @@ void ResourceCache::UpdateResourceGroup(StringHash type)
     }
 }
 
-void ResourceCache::HandleBeginFrame(StringHash eventType, VariantMap& eventData)
+void ResourceCache::CollectFileChanges()
 {
-    for (unsigned i = 0; i < fileWatchers_.size(); ++i)
+    for (FileWatcher* fileWatcher : fileWatchers_)
     {
         FileChange change;
-        while (fileWatchers_[i]->GetNextChange(change))
+        while (fileWatcher->GetNextChange(change))
         {
+            if (fileIndexEnabled_)
+            {
+                MutexLock lock(resourceMutex_);
+                const ea::string watcherPath = AddTrailingSlash(fileWatcher->GetPath());
+                for (FileIndex* index : fileIndices_)
+                {
+                    if (!index->GetDirectory().comparei(watcherPath))
+                        index->ApplyChange(GetSubsystem<FileSystem>(), change);
+                }
+            }
+
             auto it = ignoreResourceAutoReload_.find(change.fileName_);
             if (it != ignoreResourceAutoReload_.end())
             {
@@ -1153,17 +1349,46 @@ void ResourceCache::HandleBeginFrame(StringHash eventType, VariantMap& eventData
                 continue;
             }
 
-            ReloadResourceWithDependencies(change.fileName_);
+            const auto isSameFile = [&](const ea::pair<ea::string, ea::string>& item)
+            { return item.first == change.fileName_; };
+            if (ea::none_of(pendingFileChanges_.begin(), pendingFileChanges_.end(), isSameFile))
+                pendingFileChanges_.emplace_back(change.fileName_, fileWatcher->GetPath() + change.fileName_);
+            fileChangeTimer_.Reset();
+        }
+    }
+}
+
+void ResourceCache::ProcessFileChanges()
+{
+    URHO3D_PROFILE("ReloadChangedResources");
 
-            // Finally send a general file changed event even if the file was not a tracked resource
-            using namespace FileChanged;
+    const auto fileChanges = ea::move(pendingFileChanges_);
+    pendingFileChanges_.clear();
 
-            VariantMap& eventData = GetEventDataMap();
-            eventData[P_FILENAME] = fileWatchers_[i]->GetPath() + change.fileName_;
-            eventData[P_RESOURCENAME] = change.fileName_;
-            SendEvent(E_FILECHANGED, eventData);
-        }
+    ea::vector<ea::string> fileNames;
+    for (const auto& [resourceName, fileName] : fileChanges)
+        fileNames.push_back(resourceName);
+    ReloadResourcesWithDependencies(fileNames);
+
+    // Finally send a general file changed event even if the file was not a tracked resource
+    for (const auto& [resourceName, fileName] : fileChanges)
+    {
+        using namespace FileChanged;
+
+        VariantMap& eventData = GetEventDataMap();
+        eventData[P_FILENAME] = fileName;
+        eventData[P_RESOURCENAME] = resourceName;
+        SendEvent(E_FILECHANGED, eventData);
     }
+}
+
+void ResourceCache::HandleBeginFrame(StringHash eventType, VariantMap& eventData)
+{
+    // Changes are reloaded in batches when files stop changing, so that all affected resources
+    // are updated within the same frame and each of them is reloaded only once
+    CollectFileChanges();
+    if (!pendingFileChanges_.empty() && fileChangeTimer_.GetMSec(false) >= autoReloadBatchDelayMs_)
+        ProcessFileChanges();
 
     // Check for background loaded resources that can be finished
 #ifdef URHO3D_THREADING
@@ -1179,7 +1404,7 @@ AbstractFilePtr ResourceCache::SearchResourceDirs(const ea::string& name)
     auto* fileSystem = GetSubsystem<FileSystem>();
     for (unsigned i = 0; i < resourceDirs_.size(); ++i)
     {
-        if (fileSystem->FileExists(resourceDirs_[i] + name))
+        if (ResourceDirContains(i, name))
         {
             // Construct the file first with full path, then rename it to not contain the resource path,
             // so that the file's sanitatedName can be used in further GetFile() calls (for example over the network)
@@ -1196,6 +1421,34 @@ AbstractFilePtr ResourceCache::SearchResourceDirs(const ea::string& name)
     return nullptr;
 }
 
+bool ResourceCache::ResourceDirContains(unsigned index, const ea::string& name) const
+{
+    if (fileIndexEnabled_)
+        return fileIndices_[index]->Contains(name);
+    return GetSubsystem<FileSystem>()->FileExists(resourceDirs_[index] + name);
+}
+
+SharedPtr<FileIndex> ResourceCache::CreateFileIndex(const ea::string& directory) const
+{
+    URHO3D_PROFILE("BuildFileIndex");
+
+    auto index = MakeShared<FileIndex>(directory);
+    index->Build(GetSubsystem<FileSystem>());
+    return index;
+}
+
+ea::vector<SharedPtr<FileIndex>> ResourceCache::CreateFileIndices(const ea::vector<ea::string>& directories) const
+{
+    ea::vector<SharedPtr<FileIndex>> indices(directories.size());
+    ForEachParallel(GetSubsystem<WorkQueue>(), 1u, directories.size(),
+        [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned i = beginIndex; i < endIndex; ++i)
+            indices[i] = CreateFileIndex(directories[i]);
+    });
+    return indices;
+}
+
 AbstractFilePtr ResourceCache::SearchPackages(const ea::string& name)
 {
     for (unsigned i = 0; i < packages_.size(); ++i)
@@ -1232,7 +1485,10 @@ void ResourceCache::Scan(ea::vector<ea::string>& result, const ea::string& pathN
     FileSystem* fileSystem = GetSubsystem<FileSystem>();
     for (unsigned i = 0; i < resourceDirs_.size(); ++i)
     {
-        fileSystem->ScanDir(interimResult, resourceDirs_[i] + pathName, filter, flags, recursive);
+        if (fileIndexEnabled_ && !(flags & SCAN_DIRS))
+            fileIndices_[i]->Scan(interimResult, pathName, filter, flags, recursive);
+        else
+            fileSystem->ScanDir(interimResult, resourceDirs_[i] + pathName, filter, flags, recursive);
         result.insert(result.end(), interimResult.begin(), interimResult.end());
     }
 
@@ -1263,7 +1519,7 @@ void ResourceCache::Scan(ea::vector<ea::string>& result, const ea::string& pathN
                 // Manual resources do not exist in resource dirs.
                 bool isPhysicalResource = false;
                 for (unsigned i = 0; i < resourceDirs_.size() && !isPhysicalResource; ++i)
-                    isPhysicalResource = fileSystem->FileExists(resourceDirs_[i] + entryName);
+                    isPhysicalResource = ResourceDirContains(i, entryName);
 
                 if (!isPhysicalResource)
                 {
@@ -28,14 +28,18 @@
 #include <EASTL/hash_set.h>
 
 #include "../Container/Ptr.h"
+#include "../Core/Metrics.h"
 #include "../Core/Mutex.h"
+#include "../Core/Timer.h"
 #include "../IO/File.h"
 #include "../Resource/Resource.h"
+#include "../Resource/ResourceLoadRequest.h"
 
 namespace Urho3D
 {
 
 class BackgroundLoader;
+class FileIndex;
 class FileWatcher;
 class PackageFile;
 
@@ -127,12 +131,26 @@ public:
     bool ReloadResource(Resource* resource);
     /// Reload a resource based on filename. Causes also reload of dependent resources if necessary.
     void ReloadResourceWithDependencies(const ea::string& fileName);
+    /// Reload resources based on filenames. Causes also reload of dependent resources if necessary.
+    /// Each affected resource is reloaded once even if several of its dependencies changed.
+    void ReloadResourcesWithDependencies(const ea::vector<ea::string>& fileNames);
     /// Set memory budget for a specific resource type, default 0 is unlimited.
     /// @property
     void SetMemoryBudget(StringHash type, unsigned long long budget);
     /// Enable or disable automatic reloading of resources as files are modified. Default false.
     /// @property
     void SetAutoReloadResources(bool enable);
+    /// Set time in milliseconds without new file changes after which the collected changes are reloaded in one batch.
+    /// @property
+    void SetAutoReloadBatchDelayMs(unsigned ms) { autoReloadBatchDelayMs_ = ms; }
+    /// Enable or disable in-memory index of the files in resource directories, which replaces file system queries in existence checks and scans.
+    /// The index is kept current only while automatic reloading is enabled. Default false.
+    void SetFileIndexEnabled(bool enable);
+    /// Save file index of resource directories to file. Return true if successful.
+    bool SaveFileIndex(const ea::string& fileName) const;
+    /// Load file index of resource directories saved by SaveFileIndex and enable the index.
+    /// Resource directories missing from the file are scanned. Return true if successful.
+    bool LoadFileIndex(const ea::string& fileName);
     /// Enable or disable returning resources that failed to load. Default false. This may be useful in editing to not lose resource ref attributes.
     /// @property
     void SetReturnFailedResources(bool enable) { returnFailedResources_ = enable; }
@@ -144,6 +162,8 @@ public:
     /// Set how many milliseconds maximum per frame to spend on finishing background loaded resources.
     /// @property
     void SetFinishBackgroundResourcesMs(int ms) { finishBackgroundResourcesMs_ = Max(ms, 1); }
+    /// Set mask of logical CPUs the background loading thread may run on. Zero mask allows any CPU.
+    void SetBackgroundLoaderAffinity(unsigned long long mask);
 
     /// Add a resource router object. By default there is none, so the routing process is skipped.
     void AddResourceRouter(ResourceRouter* router, bool addAsFirst = false);
@@ -158,6 +178,11 @@ public:
     SharedPtr<Resource> GetTempResource(StringHash type, const ea::string& name, bool sendEventOnFailure = true);
     /// Background load a resource. An event will be sent when complete. Return true if successfully stored to the load queue, false if eg. already exists. Can be called from outside the main thread.
     bool BackgroundLoadResource(StringHash type, const ea::string& name, bool sendEventOnFailure = true, Resource* caller = nullptr);
+    /// Request background load of a resource with priority. Callback is invoked from the main thread on completion,
+    /// immediately if the resource is already loaded. Returned handle can be used to change priority or cancel the request.
+    /// Can be called only from the main thread.
+    SharedPtr<ResourceLoadRequest> RequestResource(StringHash type, const ea::string& name, float priority = 0.0f,
+        ResourceLoadCallback callback = nullptr, bool sendEventOnFailure = true);
     /// Return number of pending background-loaded resources.
     /// @property
     unsigned GetNumBackgroundLoadResources() const;
@@ -187,6 +212,9 @@ public:
     template <class T> void ReleaseResource(const ea::string& resourceName, bool force = false);
     /// Template version of queueing a resource background load.
     template <class T> bool BackgroundLoadResource(const ea::string& name, bool sendEventOnFailure = true, Resource* caller = nullptr);
+    /// Template version of requesting a resource background load.
+    template <class T> SharedPtr<ResourceLoadRequest> RequestResource(const ea::string& name, float priority = 0.0f,
+        ResourceLoadCallback callback = nullptr, bool sendEventOnFailure = true);
     /// Template version of returning loaded resources of a specific type.
     template <class T> void GetResources(ea::vector<T*>& result) const;
     /// Return whether a file exists in the resource directories or package files. Does not check manually added in-memory resources.
@@ -206,6 +234,12 @@ public:
     /// Return whether automatic resource reloading is enabled.
     /// @property
     bool GetAutoReloadResources() const { return autoReloadResources_; }
+    /// Return time in milliseconds without new file changes after which the collected changes are reloaded.
+    /// @property
+    unsigned GetAutoReloadBatchDelayMs() const { return autoReloadBatchDelayMs_; }
+
+    /// Return whether the file index of resource directories is enabled.
+    bool IsFileIndexEnabled() const { return fileIndexEnabled_; }
 
     /// Return whether resources that failed to load are returned.
     /// @property
@@ -267,8 +301,20 @@ private:
     void UpdateResourceGroup(StringHash type);
     /// Handle begin frame event. Automatic resource reloads and the finalization of background loaded resources are processed here.
     void HandleBeginFrame(StringHash eventType, VariantMap& eventData);
+    /// Collect changes from file watchers for batched reload.
+    void CollectFileChanges();
+    /// Reload resources affected by collected file changes.
+    void ProcessFileChanges();
+    /// Reload a resource from file. Send reload events.
+    bool ReloadResource(Resource* resource, AbstractFile* file);
     /// Search FileSystem for file.
     AbstractFilePtr SearchResourceDirs(const ea::string& name);
+    /// Return whether the file exists in the resource directory. Uses the file index if enabled.
+    bool ResourceDirContains(unsigned index, const ea::string& name) const;
+    /// Create file index for the resource directory.
+    SharedPtr<FileIndex> CreateFileIndex(const ea::string& directory) const;
+    /// Create file indices for the resource directories. Directories are scanned in parallel.
+    ea::vector<SharedPtr<FileIndex>> CreateFileIndices(const ea::vector<ea::string>& directories) const;
     /// Search resource packages for file.
     AbstractFilePtr SearchPackages(const ea::string& name);
 
@@ -278,6 +324,8 @@ private:
     ea::unordered_map<StringHash, ResourceGroup> resourceGroups_;
     /// Resource load directories.
     ea::vector<ea::string> resourceDirs_;
+    /// File indices of resource directories in the same order, if file index enabled.
+    ea::vector<SharedPtr<FileIndex>> fileIndices_;
     /// File watchers for resource directories, if automatic reloading enabled.
     ea::vector<SharedPtr<FileWatcher> > fileWatchers_;
     /// Package files.
@@ -292,16 +340,31 @@ private:
     bool autoReloadResources_;
     /// Return failed resources flag.
     bool returnFailedResources_;
+    /// File index flag.
+    bool fileIndexEnabled_{};
     /// Search priority flag.
     bool searchPackagesFirst_;
     /// Resource routing flag to prevent endless recursion.
     mutable bool isRouting_;
     /// How many milliseconds maximum per frame to spend on finishing background loaded resources.
     int finishBackgroundResourcesMs_;
+    /// Time without new file changes after which the collected changes are reloaded.
+    unsigned autoReloadBatchDelayMs_{100};
+    /// Resource names and full file names of changed files waiting for reload, in order of change.
+    ea::vector<ea::pair<ea::string, ea::string>> pendingFileChanges_;
+    /// Time since the last file change.
+    Timer fileChangeTimer_;
     /// List of resources that will not be auto-reloaded if reloading event triggers.
     ea::vector<ea::string> ignoreResourceAutoReload_;
     /// Sanitized path to executable
     ea::string exePath_;
+
+    /// Resource loading metrics.
+    /// @{
+    SharedPtr<MetricCounter> loadsMetric_;
+    SharedPtr<MetricCounter> loadFailuresMetric_;
+    SharedPtr<MetricHistogram> loadTimeMetric_;
+    /// @}
 };
 
 template <class T> T* ResourceCache::GetExistingResource(const ea::string& name)
@@ -334,6 +397,13 @@ template <class T> bool ResourceCache::BackgroundLoadResource(const ea::string&
     return BackgroundLoadResource(type, name, sendEventOnFailure, caller);
 }
 
+template <class T> SharedPtr<ResourceLoadRequest> ResourceCache::RequestResource(
+    const ea::string& name, float priority, ResourceLoadCallback callback, bool sendEventOnFailure)
+{
+    StringHash type = T::GetTypeStatic();
+    return RequestResource(type, name, priority, ea::move(callback), sendEventOnFailure);
+}
+
 template <class T> void ResourceCache::GetResources(ea::vector<T*>& result) const
 {
     auto& resources = reinterpret_cast<ea::vector<Resource*>&>(result);
@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Resource/BackgroundLoader.h"
+#include "../Resource/Resource.h"
+#include "../Resource/ResourceLoadRequest.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+ResourceLoadRequest::ResourceLoadRequest(StringHash type, const ea::string& name, float priority, ResourceLoadCallback callback)
+    : type_(type)
+    , name_(name)
+    , priority_(priority)
+    , callback_(ea::move(callback))
+{
+}
+
+void ResourceLoadRequest::SetPriority(float priority)
+{
+#ifdef URHO3D_THREADING
+    if (loader_)
+    {
+        loader_->SetRequestPriority(this, priority);
+        return;
+    }
+#endif
+    priority_ = priority;
+}
+
+void ResourceLoadRequest::Cancel()
+{
+    if (cancelled_ || completed_)
+        return;
+
+#ifdef URHO3D_THREADING
+    if (loader_)
+    {
+        loader_->CancelRequest(this);
+        return;
+    }
+#endif
+    cancelled_ = true;
+}
+
+void ResourceLoadRequest::Complete(Resource* resource, bool success)
+{
+    loader_ = nullptr;
+    if (cancelled_ || completed_)
+        return;
+
+    completed_ = true;
+    resource_ = success ? resource : nullptr;
+    if (callback_)
+    {
+        // Release the callback after the call so that captured objects do not outlive the request needlessly
+        const ResourceLoadCallback callback = ea::move(callback_);
+        callback_ = nullptr;
+        callback(resource_, success);
+    }
+}
+
+}
@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Container/Ptr.h"
+#include "../Math/StringHash.h"
+
+#include <EASTL/functional.h>
+
+namespace Urho3D
+{
+
+class BackgroundLoader;
+class Resource;
+
+/// Callback invoked on the main thread when a requested resource is loaded or failed to load.
+using ResourceLoadCallback = ea::function<void(Resource* resource, bool success)>;
+
+/// Handle of a background resource request. Requests with higher priority are loaded first.
+/// Priority may be changed while the request is pending, e.g. from the distance to the camera.
+/// Unless stated otherwise, should be used from the main thread only.
+class URHO3D_API ResourceLoadRequest : public RefCounted
+{
+public:
+    /// Construct.
+    ResourceLoadRequest(StringHash type, const ea::string& name, float priority, ResourceLoadCallback callback);
+
+    /// Set priority. Pending requests are reordered accordingly.
+    void SetPriority(float priority);
+    /// Cancel the request. The callback will not be invoked.
+    /// Resource loading is aborted if it has not started yet and no other request needs the resource.
+    void Cancel();
+
+    /// Return resource type.
+    StringHash GetResourceType() const { return type_; }
+    /// Return resource name.
+    const ea::string& GetResourceName() const { return name_; }
+    /// Return priority.
+    float GetPriority() const { return priority_; }
+    /// Return whether the request is cancelled.
+    bool IsCancelled() const { return cancelled_; }
+    /// Return whether the request is completed.
+    bool IsCompleted() const { return completed_; }
+    /// Return whether the request is completed successfully.
+    bool IsSuccessful() const { return completed_ && resource_; }
+    /// Return loaded resource. Null if not completed or failed.
+    Resource* GetResource() const { return resource_; }
+
+private:
+    friend class BackgroundLoader;
+    friend class ResourceCache;
+
+    /// Complete the request and invoke the callback.
+    void Complete(Resource* resource, bool success);
+
+    /// Resource type.
+    StringHash type_;
+    /// Resource name.
+    ea::string name_;
+    /// Priority. Protected by the loader mutex while the request is pending.
+    float priority_{};
+    /// Completion callback.
+    ResourceLoadCallback callback_;
+    /// Loader that has the request pending.
+    WeakPtr<BackgroundLoader> loader_;
+    /// Loaded resource.
+    SharedPtr<Resource> resource_;
+    /// Whether the request is cancelled.
+    bool cancelled_{};
+    /// Whether the request is completed.
+    bool completed_{};
+};
+
+}
@@ -85,11 +85,15 @@ bool XMLFile::BeginLoad(Deserializer& source)
         return false;
     }
 
-    ea::shared_array<char> buffer(new char[dataSize]);
-    if (source.Read(buffer.get(), dataSize) != dataSize)
+    // Parse in place so that node names and values point into the buffer instead of being copied.
+    // The document takes ownership of the buffer, so it must come from pugixml allocator.
+    const auto deallocate = pugi::get_memory_deallocation_function();
+    ea::unique_ptr<char, decltype(deallocate)> buffer(
+        static_cast<char*>(pugi::get_memory_allocation_function()(ea::max(dataSize, 1u))), deallocate);
+    if (!buffer || source.Read(buffer.get(), dataSize) != dataSize)
         return false;
 
-    if (!document_->load_buffer(buffer.get(), dataSize))
+    if (!document_->load_buffer_inplace_own(buffer.release(), dataSize))
     {
         URHO3D_LOGERROR("Could not parse XML data from " + source.GetName());
         document_->reset();
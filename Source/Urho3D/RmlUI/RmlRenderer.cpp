@@ -61,6 +61,25 @@ struct CachedRmlTexture
     SharedPtr<Texture2D> texture_;
 };
 
+/// Internal RmlUI compiled geometry, converted to the vertex format once.
+struct CompiledRmlGeometry
+{
+    ea::vector<RmlVertex> vertices_;
+    ea::vector<unsigned> indices_;
+    Rml::TextureHandle texture_{};
+};
+
+/// Convert RmlUI vertex to internal vertex.
+RmlVertex ConvertVertex(const Rml::Vertex& vertex, const Rml::Vector2f& translation)
+{
+    const Rml::Colourb& color = vertex.colour;
+    RmlVertex result;
+    result.position_ = Vector3{vertex.position.x + translation.x, vertex.position.y + translation.y, 0.0f};
+    result.color_ = (color.alpha << 24u) | (color.blue << 16u) | (color.green << 8u) | color.red;
+    result.texCoord_ = Vector2{vertex.tex_coord.x, vertex.tex_coord.y};
+    return result;
+}
+
 /// Wrap CachedRmlTexture pointer to RmlUI handle.
 Rml::TextureHandle WrapTextureHandle(CachedRmlTexture* texture) { return reinterpret_cast<Rml::TextureHandle>(texture); }
 
@@ -105,6 +124,7 @@ void RmlRenderer::BeginRendering()
     indexBuffer_->Discard();
     drawQueue_->Reset(false);
     textures_.clear();
+    pendingDraw_ = {};
 
     VertexBuffer* vertexBuffer = vertexBuffer_->GetVertexBuffer();
     IndexBuffer* indexBuffer = indexBuffer_->GetIndexBuffer();
@@ -143,6 +163,7 @@ void RmlRenderer::BeginRendering()
 
 void RmlRenderer::EndRendering()
 {
+    FlushDraw();
     vertexBuffer_->Commit();
     indexBuffer_->Commit();
     drawQueue_->Execute();
@@ -185,20 +206,60 @@ void RmlRenderer::RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* i
 
     RmlVertex* destVertices = reinterpret_cast<RmlVertex*>(vertexData);
     for (unsigned i = 0; i < num_vertices; ++i)
-    {
-        destVertices[i].position_.x_ = vertices[i].position.x + translation.x;
-        destVertices[i].position_.y_ = vertices[i].position.y + translation.y;
-        destVertices[i].position_.z_ = 0.0f;
-        const Rml::Colourb& color = vertices[i].colour;
-        destVertices[i].color_ = (color.alpha << 24u) | (color.blue << 16u) | (color.green << 8u) | color.red;
-        destVertices[i].texCoord_.x_ = vertices[i].tex_coord.x;
-        destVertices[i].texCoord_.y_ = vertices[i].tex_coord.y;
-    }
+        destVertices[i] = ConvertVertex(vertices[i], translation);
 
     unsigned* destIndices = reinterpret_cast<unsigned*>(indexData);
     for (unsigned i = 0; i < num_indices; ++i)
         destIndices[i] = indices[i] + firstVertex;
 
+    QueueDraw(textureHandle, firstIndex, num_indices);
+}
+
+Rml::CompiledGeometryHandle RmlRenderer::CompileGeometry(Rml::Vertex* vertices, int num_vertices, int* indices,
+    int num_indices, Rml::TextureHandle textureHandle)
+{
+    auto geometry = new CompiledRmlGeometry;
+    geometry->texture_ = textureHandle;
+
+    geometry->vertices_.resize(num_vertices);
+    for (unsigned i = 0; i < num_vertices; ++i)
+        geometry->vertices_[i] = ConvertVertex(vertices[i], Rml::Vector2f{0.0f, 0.0f});
+
+    geometry->indices_.assign(indices, indices + num_indices);
+    return reinterpret_cast<Rml::CompiledGeometryHandle>(geometry);
+}
+
+void RmlRenderer::RenderCompiledGeometry(Rml::CompiledGeometryHandle geometryHandle, const Rml::Vector2f& translation)
+{
+    const auto geometry = reinterpret_cast<CompiledRmlGeometry*>(geometryHandle);
+    const unsigned numVertices = geometry->vertices_.size();
+    const unsigned numIndices = geometry->indices_.size();
+
+    const auto [firstVertex, vertexData] = vertexBuffer_->AddVertices(numVertices);
+    const auto [firstIndex, indexData] = indexBuffer_->AddIndices(numIndices);
+
+    const Vector3 offset{translation.x, translation.y, 0.0f};
+    RmlVertex* destVertices = reinterpret_cast<RmlVertex*>(vertexData);
+    for (unsigned i = 0; i < numVertices; ++i)
+    {
+        destVertices[i] = geometry->vertices_[i];
+        destVertices[i].position_ += offset;
+    }
+
+    unsigned* destIndices = reinterpret_cast<unsigned*>(indexData);
+    for (unsigned i = 0; i < numIndices; ++i)
+        destIndices[i] = geometry->indices_[i] + firstVertex;
+
+    QueueDraw(geometry->texture_, firstIndex, numIndices);
+}
+
+void RmlRenderer::ReleaseCompiledGeometry(Rml::CompiledGeometryHandle geometryHandle)
+{
+    delete reinterpret_cast<CompiledRmlGeometry*>(geometryHandle);
+}
+
+void RmlRenderer::QueueDraw(Rml::TextureHandle textureHandle, unsigned indexStart, unsigned indexCount)
+{
     // Restore texture data if lost
     CachedRmlTexture* cachedTexture = UnwrapTextureHandle(textureHandle);
     Texture2D* texture = cachedTexture ? cachedTexture->texture_ : nullptr;
@@ -208,11 +269,6 @@ void RmlRenderer::RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* i
         texture->ClearDataLost();
     }
 
-    Material* material = GetBatchMaterial(texture);
-    Pass* pass = material->GetDefaultPass();
-    const UIBatchStateKey batchStateKey{ isRenderSurfaceSRGB_, material, pass, BLEND_ALPHA };
-    PipelineState* pipelineState = batchStateCache_->GetOrCreatePipelineState(batchStateKey, batchStateCreateContext_);
-
     IntRect scissor;
     if (!scissorEnabled_)
         scissor = IntRect{IntVector2::ZERO, viewportSize_};
@@ -221,7 +277,36 @@ void RmlRenderer::RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* i
     else
         scissor = scissor_;
 
-    drawQueue_->SetScissorRect(scissor);
+    // Merge with pending draw if render state is the same and indices are adjacent
+    const bool canMerge = pendingDraw_.indexCount_ != 0 && pendingDraw_.texture_ == texture
+        && pendingDraw_.scissor_ == scissor && pendingDraw_.transform_ == transform_
+        && pendingDraw_.indexStart_ + pendingDraw_.indexCount_ == indexStart;
+    if (canMerge)
+    {
+        pendingDraw_.indexCount_ += indexCount;
+        return;
+    }
+
+    FlushDraw();
+    pendingDraw_.texture_ = texture;
+    pendingDraw_.scissor_ = scissor;
+    pendingDraw_.transform_ = transform_;
+    pendingDraw_.indexStart_ = indexStart;
+    pendingDraw_.indexCount_ = indexCount;
+}
+
+void RmlRenderer::FlushDraw()
+{
+    if (pendingDraw_.indexCount_ == 0)
+        return;
+
+    Texture2D* texture = pendingDraw_.texture_;
+    Material* material = GetBatchMaterial(texture);
+    Pass* pass = material->GetDefaultPass();
+    const UIBatchStateKey batchStateKey{ isRenderSurfaceSRGB_, material, pass, BLEND_ALPHA };
+    PipelineState* pipelineState = batchStateCache_->GetOrCreatePipelineState(batchStateKey, batchStateCreateContext_);
+
+    drawQueue_->SetScissorRect(pendingDraw_.scissor_);
     drawQueue_->SetPipelineState(pipelineState);
 
     if (texture)
@@ -245,11 +330,12 @@ void RmlRenderer::RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* i
 
     if (drawQueue_->BeginShaderParameterGroup(SP_OBJECT, true))
     {
-        drawQueue_->AddShaderParameter(VSP_MODEL, transform_);
+        drawQueue_->AddShaderParameter(VSP_MODEL, pendingDraw_.transform_);
         drawQueue_->CommitShaderParameterGroup(SP_OBJECT);
     }
 
-    drawQueue_->DrawIndexed(firstIndex, num_indices);
+    drawQueue_->DrawIndexed(pendingDraw_.indexStart_, pendingDraw_.indexCount_);
+    pendingDraw_.indexCount_ = 0;
 }
 
 void RmlRenderer::EnableScissorRegion(bool enable)
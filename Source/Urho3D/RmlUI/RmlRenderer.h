@@ -57,6 +57,9 @@ public:
     bool LoadTexture(Rml::TextureHandle& textureOut, Rml::Vector2i& sizeOut, const Rml::String& source) override;
 
     void RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, Rml::TextureHandle texture, const Rml::Vector2f& translation) override;
+    Rml::CompiledGeometryHandle CompileGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, Rml::TextureHandle texture) override;
+    void RenderCompiledGeometry(Rml::CompiledGeometryHandle geometry, const Rml::Vector2f& translation) override;
+    void ReleaseCompiledGeometry(Rml::CompiledGeometryHandle geometry) override;
     void EnableScissorRegion(bool enable) override;
     void SetScissorRegion(int x, int y, int width, int height) override;
     void SetTransform(const Rml::Matrix4f* transform) override;
@@ -66,6 +69,20 @@ private:
     /// Perform initialization tasks that require graphics subsystem.
     void InitializeGraphics();
     Material* GetBatchMaterial(Texture2D* texture);
+    /// Queue drawing of indices already added to the index buffer. Merged with previous draw if possible.
+    void QueueDraw(Rml::TextureHandle textureHandle, unsigned indexStart, unsigned indexCount);
+    /// Submit pending draw to the draw queue.
+    void FlushDraw();
+
+    /// Draw call pending submission.
+    struct PendingDraw
+    {
+        Texture2D* texture_{};
+        IntRect scissor_;
+        Matrix3x4 transform_;
+        unsigned indexStart_{};
+        unsigned indexCount_{};
+    };
 
     /// Default materials
     /// @{
@@ -90,6 +107,7 @@ private:
     DrawCommandQueue* drawQueue_{};
     ea::vector<SharedPtr<Texture2D>> textures_{};
     Matrix4 projection_;
+    PendingDraw pendingDraw_;
     /// @}
 
     bool scissorEnabled_ = false;
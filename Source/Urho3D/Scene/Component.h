@@ -49,6 +49,7 @@ class URHO3D_API Component : public Serializable
 
     friend class Node;
     friend class Scene;
+    friend class SceneComponentIndex;
 
 public:
     /// Construct.
@@ -136,6 +137,8 @@ protected:
     bool networkUpdate_;
     /// Enabled flag.
     bool enabled_;
+    /// Slot in the scene component index, if the component type is indexed.
+    unsigned indexSlot_{M_MAX_UNSIGNED};
 };
 
 template <class T> T* Component::GetComponent() const { return static_cast<T*>(GetComponent(T::GetTypeStatic())); }
@@ -41,7 +41,10 @@ LogicComponent::LogicComponent(Context* context) :
 {
 }
 
-LogicComponent::~LogicComponent() = default;
+LogicComponent::~LogicComponent()
+{
+    RemoveFromUpdateQueue();
+}
 
 void LogicComponent::OnSetEnabled()
 {
@@ -98,7 +101,7 @@ void LogicComponent::OnSceneSet(Scene* scene)
         UpdateEventSubscription();
     else
     {
-        UnsubscribeFromEvent(E_SCENEUPDATE);
+        RemoveFromUpdateQueue();
         UnsubscribeFromEvent(GetPostUpdateEvent());
 #if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
         UnsubscribeFromEvent(E_PHYSICSPRESTEP);
@@ -114,29 +117,48 @@ void LogicComponent::UpdateEventSubscription()
     if (!scene)
         return;
 
+    // The component may have been moved to another scene without being detached first
+    if (updateQueueScene_ && updateQueueScene_ != scene)
+        RemoveFromUpdateQueue();
+
     bool enabled = IsEnabledEffective();
+    LogicUpdateQueue& updateQueue = scene->GetLogicUpdateQueue();
 
     bool needUpdate = enabled && ((updateEventMask_ & USE_UPDATE) || !delayedStartCalled_);
     if (needUpdate && !(currentEventMask_ & USE_UPDATE))
     {
-        SubscribeToEvent(scene, E_SCENEUPDATE, URHO3D_HANDLER(LogicComponent, HandleSceneUpdate));
+        updateQueue.Add(this, LogicUpdatePhase::Update);
+        updateQueueScene_ = scene;
         currentEventMask_ |= USE_UPDATE;
     }
     else if (!needUpdate && (currentEventMask_ & USE_UPDATE))
     {
-        UnsubscribeFromEvent(scene, E_SCENEUPDATE);
+        updateQueue.Remove(this, LogicUpdatePhase::Update);
         currentEventMask_ &= ~USE_UPDATE;
     }
 
+    // Other custom post-update events are still delivered as events
+    const StringHash postUpdateEvent = GetPostUpdateEvent();
+    LogicUpdatePhase postUpdatePhase{};
+    const bool queuedPostUpdate = GetPostUpdatePhase(postUpdateEvent, postUpdatePhase);
     bool needPostUpdate = enabled && (updateEventMask_ & USE_POSTUPDATE);
     if (needPostUpdate && !(currentEventMask_ & USE_POSTUPDATE))
     {
-        SubscribeToEvent(scene, GetPostUpdateEvent(), URHO3D_HANDLER(LogicComponent, HandleScenePostUpdate));
+        if (queuedPostUpdate)
+        {
+            updateQueue.Add(this, postUpdatePhase);
+            updateQueueScene_ = scene;
+        }
+        else
+            SubscribeToEvent(scene, postUpdateEvent, URHO3D_HANDLER(LogicComponent, HandleScenePostUpdate));
         currentEventMask_ |= USE_POSTUPDATE;
     }
     else if (!needPostUpdate && (currentEventMask_ & USE_POSTUPDATE))
     {
-        UnsubscribeFromEvent(scene, GetPostUpdateEvent());
+        if (queuedPostUpdate)
+            updateQueue.Remove(this, postUpdatePhase);
+        else
+            UnsubscribeFromEvent(scene, postUpdateEvent);
         currentEventMask_ &= ~USE_POSTUPDATE;
     }
 
@@ -171,27 +193,50 @@ void LogicComponent::UpdateEventSubscription()
 #endif
 }
 
-void LogicComponent::HandleSceneUpdate(StringHash eventType, VariantMap& eventData)
+void LogicComponent::RemoveFromUpdateQueue()
 {
-    using namespace SceneUpdate;
+    if (Scene* scene = updateQueueScene_)
+    {
+        LogicUpdateQueue& updateQueue = scene->GetLogicUpdateQueue();
+        updateQueue.Remove(this, LogicUpdatePhase::Update);
+        updateQueue.Remove(this, LogicUpdatePhase::PostUpdate);
+        updateQueue.Remove(this, LogicUpdatePhase::DrawableUpdateFinished);
+        LogicUpdatePhase postUpdatePhase{};
+        if (GetPostUpdatePhase(GetPostUpdateEvent(), postUpdatePhase))
+            currentEventMask_ &= ~USE_POSTUPDATE;
+        currentEventMask_ &= ~USE_UPDATE;
+    }
+    updateQueueScene_ = nullptr;
+}
+
+bool LogicComponent::GetPostUpdatePhase(StringHash postUpdateEvent, LogicUpdatePhase& phase)
+{
+    if (postUpdateEvent == E_SCENEPOSTUPDATE)
+        phase = LogicUpdatePhase::PostUpdate;
+    else if (postUpdateEvent == E_SCENEDRAWABLEUPDATEFINISHED)
+        phase = LogicUpdatePhase::DrawableUpdateFinished;
+    else
+        return false;
+    return true;
+}
 
+void LogicComponent::CallDelayedStart()
+{
     // Execute user-defined delayed start function before first update
-    if (!delayedStartCalled_)
-    {
-        DelayedStart();
-        delayedStartCalled_ = true;
+    DelayedStart();
+    delayedStartCalled_ = true;
 
-        // If did not need actual update events, unsubscribe now
-        if (!(updateEventMask_ & USE_UPDATE))
-        {
-            UnsubscribeFromEvent(GetScene(), E_SCENEUPDATE);
-            currentEventMask_ &= ~USE_UPDATE;
-            return;
-        }
-    }
+    // If did not need actual update events, unsubscribe now
+    if (!(updateEventMask_ & USE_UPDATE))
+        UpdateEventSubscription();
+}
 
-    // Then execute user-defined update function
-    Update(eventData[P_TIMESTEP].GetFloat());
+void LogicComponent::CallUpdate(LogicUpdatePhase phase, float timeStep)
+{
+    if (phase == LogicUpdatePhase::Update)
+        Update(timeStep);
+    else
+        PostUpdate(timeStep);
 }
 
 void LogicComponent::HandleScenePostUpdate(StringHash eventType, VariantMap& eventData)
@@ -26,6 +26,7 @@
 
 #include "../Container/FlagSet.h"
 #include "../Scene/Component.h"
+#include "../Scene/LogicUpdateQueue.h"
 
 namespace Urho3D
 {
@@ -78,6 +79,8 @@ class URHO3D_API LogicComponent : public Component
 
     /// Return post update event type. Should stay the same for any given instance of the component.
     virtual StringHash GetPostUpdateEvent() const;
+    /// Return whether Update() and PostUpdate() of this component type may be called from worker threads in parallel with other instances of the same type. Such updates must not create, remove, enable or disable objects. Should stay the same for all instances of the type.
+    virtual bool IsUpdateThreadSafe() const { return false; }
 
     /// Set what update events should be subscribed to. Use this for optimization: by default all are in use. Note that this is not an attribute and is not saved or network-serialized, therefore it should always be called eg. in the subclass constructor.
     void SetUpdateEventMask(UpdateEventFlags mask);
@@ -95,11 +98,19 @@ protected:
     void OnSceneSet(Scene* scene) override;
 
 private:
+    friend class LogicUpdateQueue;
+
     /// Subscribe/unsubscribe to update events based on current enabled state and update event mask.
     void UpdateEventSubscription();
-    /// Handle scene update event.
-    void HandleSceneUpdate(StringHash eventType, VariantMap& eventData);
-    /// Handle scene post-update event.
+    /// Remove from the update queue of the scene.
+    void RemoveFromUpdateQueue();
+    /// Return update queue phase of post-update event. Return false if the event is delivered as event.
+    static bool GetPostUpdatePhase(StringHash postUpdateEvent, LogicUpdatePhase& phase);
+    /// Call delayed start function before the first update.
+    void CallDelayedStart();
+    /// Call update function of the phase.
+    void CallUpdate(LogicUpdatePhase phase, float timeStep);
+    /// Handle custom post-update event.
     void HandleScenePostUpdate(StringHash eventType, VariantMap& eventData);
 #if defined(URHO3D_PHYSICS) || defined(URHO3D_PHYSICS2D)
     /// Handle physics pre-step event.
@@ -113,6 +124,11 @@ private:
     UpdateEventFlags currentEventMask_;
     /// Flag for delayed start.
     bool delayedStartCalled_;
+    /// Scene whose update queue contains the component.
+    WeakPtr<Scene> updateQueueScene_;
+    /// Indices in the update queue for each phase.
+    unsigned updateSlots_[static_cast<unsigned>(LogicUpdatePhase::Count)]{
+        M_MAX_UNSIGNED, M_MAX_UNSIGNED, M_MAX_UNSIGNED};
 };
 
 }
@@ -0,0 +1,253 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Scene/LogicUpdateQueue.h"
+
+#include "../Core/Thread.h"
+#include "../Core/WorkQueue.h"
+#include "../Scene/LogicComponent.h"
+#include "../Scene/Scene.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+static const unsigned ParallelUpdateBucket = 64;
+
+}
+
+ScriptLogicUpdateCallback LogicUpdateQueue::scriptUpdateCallback_{};
+
+void LogicUpdateQueue::Add(LogicComponent* component, LogicUpdatePhase phase)
+{
+    const auto iter = groupIndices_.find(component->GetType());
+    unsigned groupIndex = 0;
+    if (iter != groupIndices_.end())
+        groupIndex = iter->second;
+    else
+    {
+        groupIndex = groups_.size();
+        groupIndices_.emplace(component->GetType(), groupIndex);
+        TypeGroup& group = groups_.emplace_back();
+        group.threadSafe_ = component->IsUpdateThreadSafe();
+        group.script_ = component->HasScriptObject();
+    }
+
+    auto& components = groups_[groupIndex].components_[static_cast<unsigned>(phase)];
+    component->updateSlots_[static_cast<unsigned>(phase)] = components.size();
+    components.push_back(component);
+    ++numComponents_[static_cast<unsigned>(phase)];
+}
+
+void LogicUpdateQueue::Remove(LogicComponent* component, LogicUpdatePhase phase)
+{
+    const auto phaseIndex = static_cast<unsigned>(phase);
+    unsigned& slot = component->updateSlots_[phaseIndex];
+    const auto iter = groupIndices_.find(component->GetType());
+    if (slot == M_MAX_UNSIGNED || iter == groupIndices_.end())
+        return;
+
+    TypeGroup& group = groups_[iter->second];
+    auto& components = group.components_[phaseIndex];
+    --numComponents_[phaseIndex];
+
+    if (updating_)
+    {
+        // Keep slots stable while iterating, compact after the update
+        components[slot] = nullptr;
+        ++group.numRemoved_[phaseIndex];
+        if (iter->second == scriptGroupIndex_ && slot < scriptObjects_.size())
+            scriptObjects_[slot] = nullptr;
+    }
+    else
+    {
+        LogicComponent* lastComponent = components.back();
+        lastComponent->updateSlots_[phaseIndex] = slot;
+        components[slot] = lastComponent;
+        components.pop_back();
+    }
+    slot = M_MAX_UNSIGNED;
+}
+
+void LogicUpdateQueue::Update(LogicUpdatePhase phase, float timeStep, Scene* scene)
+{
+    const auto phaseIndex = static_cast<unsigned>(phase);
+    auto workQueue = scene->GetSubsystem<WorkQueue>();
+    const bool parallel = workQueue && workQueue->GetNumThreads() > 0;
+
+    updating_ = true;
+    // Components and type groups added during update are not updated until the next frame.
+    // Containers may be reallocated by the update, so access them by index
+    const unsigned numGroups = groups_.size();
+    for (unsigned groupIndex = 0; groupIndex < numGroups; ++groupIndex)
+    {
+        const auto getComponent = [&](unsigned index) { return groups_[groupIndex].components_[phaseIndex][index]; };
+        const unsigned numComponents = groups_[groupIndex].components_[phaseIndex].size();
+
+        // Delayed start may modify the scene and is never called in parallel
+        if (phase == LogicUpdatePhase::Update)
+        {
+            for (unsigned i = 0; i < numComponents; ++i)
+            {
+                LogicComponent* component = getComponent(i);
+                if (component && !component->IsDelayedStartCalled())
+                {
+                    URHO3D_ASSERT(Thread::IsMainThread(), "Delayed start should be called from main thread");
+                    component->CallDelayedStart();
+                }
+            }
+        }
+
+        if (scriptUpdateCallback_ && groups_[groupIndex].script_)
+        {
+            URHO3D_ASSERT(Thread::IsMainThread(), "Script components should be updated from main thread");
+            UpdateScriptGroup(groupIndex, phase, timeStep, numComponents);
+        }
+        else if (parallel && groups_[groupIndex].threadSafe_ && numComponents > ParallelUpdateBucket)
+        {
+            // World transforms are evaluated lazily and update cached transforms of parent nodes,
+            // which may be shared between components, so resolve them in the main thread first
+            for (unsigned i = 0; i < numComponents; ++i)
+            {
+                LogicComponent* component = getComponent(i);
+                if (Node* node = component ? component->GetNode() : nullptr)
+                    node->GetWorldTransform();
+            }
+
+            // Components react to being moved in threaded update mode as they do during octree update
+            scene->BeginThreadedUpdate();
+            ForEachParallel(workQueue, ParallelUpdateBucket, numComponents,
+                [&](unsigned beginIndex, unsigned endIndex)
+            {
+                for (unsigned i = beginIndex; i < endIndex; ++i)
+                {
+                    if (LogicComponent* component = getComponent(i))
+                        component->CallUpdate(phase, timeStep);
+                }
+            });
+            scene->EndThreadedUpdate();
+        }
+        else
+        {
+            for (unsigned i = 0; i < numComponents; ++i)
+            {
+                if (LogicComponent* component = getComponent(i))
+                    component->CallUpdate(phase, timeStep);
+            }
+        }
+    }
+    updating_ = false;
+
+    // Components may be removed from any phase during the update
+    for (TypeGroup& group : groups_)
+    {
+        for (unsigned i = 0; i < static_cast<unsigned>(LogicUpdatePhase::Count); ++i)
+        {
+            if (group.numRemoved_[i] > 0)
+                Compact(group, static_cast<LogicUpdatePhase>(i));
+        }
+    }
+}
+
+void LogicUpdateQueue::CallDelayedStarts()
+{
+    const auto phaseIndex = static_cast<unsigned>(LogicUpdatePhase::Update);
+
+    // Delayed start may add components, start them too. Containers may be reallocated, so access them by index
+    for (unsigned groupIndex = 0; groupIndex < groups_.size(); ++groupIndex)
+    {
+        for (unsigned i = 0; i < groups_[groupIndex].components_[phaseIndex].size(); ++i)
+        {
+            LogicComponent* component = groups_[groupIndex].components_[phaseIndex][i];
+            if (component && !component->IsDelayedStartCalled())
+                component->CallDelayedStart();
+        }
+    }
+}
+
+bool LogicUpdateQueue::HasScriptUpdates() const
+{
+    const auto isScript = [](const TypeGroup& group) { return group.script_; };
+    return scriptUpdateCallback_ && ea::any_of(groups_.begin(), groups_.end(), isScript);
+}
+
+unsigned LogicUpdateQueue::GetNumComponents(LogicUpdatePhase phase) const
+{
+    return numComponents_[static_cast<unsigned>(phase)];
+}
+
+void LogicUpdateQueue::UpdateScriptGroup(
+    unsigned groupIndex, LogicUpdatePhase phase, float timeStep, unsigned numComponents)
+{
+    const auto phaseIndex = static_cast<unsigned>(phase);
+
+    // Collect handles first, the callback may remove components and reset their handles
+    scriptObjects_.resize(numComponents);
+    for (unsigned i = 0; i < numComponents; ++i)
+    {
+        LogicComponent* component = groups_[groupIndex].components_[phaseIndex][i];
+#if URHO3D_CSHARP
+        scriptObjects_[i] = component ? component->GetScriptObject() : nullptr;
+#else
+        scriptObjects_[i] = nullptr;
+#endif
+    }
+
+    for (unsigned i = 0; i < numComponents; ++i)
+    {
+        LogicComponent* component = groups_[groupIndex].components_[phaseIndex][i];
+        if (component && !scriptObjects_[i])
+            component->CallUpdate(phase, timeStep);
+    }
+
+    scriptGroupIndex_ = groupIndex;
+    scriptUpdateCallback_(scriptObjects_.data(), numComponents, phase, timeStep);
+    scriptGroupIndex_ = M_MAX_UNSIGNED;
+    scriptObjects_.clear();
+}
+
+void LogicUpdateQueue::Compact(TypeGroup& group, LogicUpdatePhase phase)
+{
+    const auto phaseIndex = static_cast<unsigned>(phase);
+    auto& components = group.components_[phaseIndex];
+
+    unsigned numAlive = 0;
+    for (LogicComponent* component : components)
+    {
+        if (component)
+        {
+            component->updateSlots_[phaseIndex] = numAlive;
+            components[numAlive++] = component;
+        }
+    }
+    components.resize(numAlive);
+    group.numRemoved_[phaseIndex] = 0;
+}
+
+}
@@ -0,0 +1,114 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Math/StringHash.h"
+
+#include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class LogicComponent;
+class Scene;
+
+/// Variable timestep update phase of logic components.
+enum class LogicUpdatePhase
+{
+    Update,
+    PostUpdate,
+    /// Post-update of components that use E_SCENEDRAWABLEUPDATEFINISHED as post-update event.
+    DrawableUpdateFinished,
+    Count
+};
+
+/// Callback that updates script-implemented components in one call. Receives script object handles of components.
+/// Handles of components removed during the call are reset to null.
+using ScriptLogicUpdateCallback = void (*)(
+    void* const* scriptObjects, unsigned count, LogicUpdatePhase phase, float timeStep);
+
+/// Scene-owned lists of logic components that receive variable timestep updates.
+/// Components are grouped by concrete type and called directly instead of through scene events.
+class URHO3D_API LogicUpdateQueue
+{
+public:
+    /// Add component to the update phase.
+    void Add(LogicComponent* component, LogicUpdatePhase phase);
+    /// Remove component from the update phase. Safe to call during update.
+    void Remove(LogicComponent* component, LogicUpdatePhase phase);
+    /// Call update phase for all components. Thread-safe component types are updated in worker threads if available.
+    /// Delayed start and script update callback are called only from main thread.
+    void Update(LogicUpdatePhase phase, float timeStep, Scene* scene);
+    /// Call delayed start for all components that need it, including components added by delayed start.
+    /// Should be called from main thread before Update is called from another thread.
+    void CallDelayedStarts();
+
+    /// Return whether any components are updated via script update callback.
+    bool HasScriptUpdates() const;
+    /// Return number of components in the update phase.
+    unsigned GetNumComponents(LogicUpdatePhase phase) const;
+
+    /// Set callback that updates script-implemented components in bulk instead of one virtual call per component.
+    static void SetScriptUpdateCallback(ScriptLogicUpdateCallback callback) { scriptUpdateCallback_ = callback; }
+    /// Return callback that updates script-implemented components.
+    static ScriptLogicUpdateCallback GetScriptUpdateCallback() { return scriptUpdateCallback_; }
+
+private:
+    /// Components of the same type.
+    struct TypeGroup
+    {
+        /// Whether the components can be updated in parallel.
+        bool threadSafe_{};
+        /// Whether the components are implemented in script.
+        bool script_{};
+        /// Components for each phase. Removed components are null until compacted.
+        ea::vector<LogicComponent*> components_[static_cast<unsigned>(LogicUpdatePhase::Count)];
+        /// Number of null components for each phase.
+        unsigned numRemoved_[static_cast<unsigned>(LogicUpdatePhase::Count)]{};
+    };
+
+    /// Remove null components of the phase and update slots.
+    void Compact(TypeGroup& group, LogicUpdatePhase phase);
+    /// Update components of script type group. Components without script object are updated directly.
+    void UpdateScriptGroup(unsigned groupIndex, LogicUpdatePhase phase, float timeStep, unsigned numComponents);
+
+    /// Callback that updates script-implemented components.
+    static ScriptLogicUpdateCallback scriptUpdateCallback_;
+
+    /// Type groups in the order of creation.
+    ea::vector<TypeGroup> groups_;
+    /// Index of type group by component type.
+    ea::unordered_map<StringHash, unsigned> groupIndices_;
+    /// Number of components for each phase.
+    unsigned numComponents_[static_cast<unsigned>(LogicUpdatePhase::Count)]{};
+    /// Whether the update is in progress.
+    bool updating_{};
+    /// Index of the script type group being updated.
+    unsigned scriptGroupIndex_{M_MAX_UNSIGNED};
+    /// Script object handles of the script type group being updated.
+    ea::vector<void*> scriptObjects_;
+};
+
+}
@@ -32,6 +32,7 @@
 #include "../Resource/JSONFile.h"
 #include "../Scene/Component.h"
 #include "../Scene/ObjectAnimation.h"
+#include "../Scene/ParsedSceneData.h"
 #include "../Scene/PrefabReader.h"
 #include "../Scene/PrefabWriter.h"
 #include "../Scene/Scene.h"
@@ -259,6 +260,30 @@ Node* Node::InstantiatePrefab(const NodePrefab& prefab, const Vector3& position,
     return childNode;
 }
 
+ea::vector<Node*> Node::InstantiatePrefab(const NodePrefab& prefab, ea::span<const Transform> transforms)
+{
+    URHO3D_PROFILE("InstantiatePrefabBulk");
+
+    ea::vector<Node*> result;
+    result.reserve(transforms.size());
+    children_.reserve(children_.size() + transforms.size());
+
+    for (const Transform& transform : transforms)
+    {
+        Node* childNode = CreateChild();
+        PrefabReaderFromMemory reader{prefab};
+        if (!childNode->Load(reader, PrefabLoadFlag::None))
+        {
+            childNode->Remove();
+            continue;
+        }
+
+        childNode->SetTransform(transform);
+        result.push_back(childNode);
+    }
+    return result;
+}
+
 void Node::GeneratePrefab(NodePrefab& prefab) const
 {
     const PrefabSaveFlags flags = PrefabSaveFlag::EnumsAsStrings | PrefabSaveFlag::Prefab;
@@ -494,10 +519,10 @@ bool Node::SaveJSON(Serializer& dest, const ea::string& indentation) const
 
 void Node::SetName(const ea::string& name)
 {
-    if (name != impl_->name_)
+    if (name != impl_->name_.GetString())
     {
-        impl_->name_ = name;
-        impl_->nameHash_ = name;
+        impl_->name_ = InternedString{name};
+        impl_->nameHash_ = impl_->name_.GetHash();
 
         // Send change event
         if (scene_)
@@ -698,8 +723,11 @@ void Node::SetWorldScale(const Vector3& scale)
 
 void Node::SetWorldTransform(const Vector3& position, const Quaternion& rotation)
 {
-    SetWorldPosition(position);
-    SetWorldRotation(rotation);
+    // Mark dirty only once
+    if (IsTransformHierarchyRoot())
+        SetTransform(position, rotation);
+    else
+        SetTransform(parent_->GetWorldTransform().Inverse() * position, parent_->GetWorldRotation().Inverse() * rotation);
 }
 
 void Node::SetWorldTransform(const Vector3& position, const Quaternion& rotation, float scale)
@@ -917,6 +945,11 @@ void Node::SetEnabledRecursive(bool enable)
 
 void Node::MarkDirty()
 {
+    // Top of the dirty subtree is queued for batched update, the rest is covered by the invariant below.
+    // Nodes moved during threaded update are left for lazy update
+    if (!dirty_ && scene_ && scene_->IsBatchedTransformUpdate() && !scene_->IsThreadedUpdate() && (!parent_ || !parent_->dirty_))
+        scene_->QueueDirtyTransform(this);
+
     Node *cur = this;
     for (;;)
     {
@@ -1580,7 +1613,7 @@ bool Node::HasComponent(StringHash type) const
 ea::string Node::GetFullNameDebug() const
 {
     ea::string fullName = parent_ ? Format("{}/[{}]", parent_->GetFullNameDebug(), parent_->GetChildIndex(this)) : "";
-    fullName += impl_->name_.empty() ? GetTypeName() : impl_->name_;
+    fullName += impl_->name_.IsEmpty() ? GetTypeName() : impl_->name_.GetString();
     return fullName;
 }
 
@@ -1755,6 +1788,32 @@ bool Node::Load(Deserializer& source, SceneResolver& resolver, bool loadChildren
     return true;
 }
 
+Node* Node::CreateChild(const ParsedNodeData& data, SceneResolver& resolver)
+{
+    Node* newNode = CreateChild(data.id_);
+    resolver.AddNode(data.id_, newNode);
+    ApplyParsedAttributes(newNode, data.attributes_);
+
+    for (const ParsedComponentData& componentData : data.components_)
+    {
+        Component* newComponent = newNode->SafeCreateComponent(EMPTY_STRING, componentData.type_, componentData.id_);
+        if (!newComponent)
+            continue;
+
+        resolver.AddComponent(componentData.id_, newComponent);
+        if (componentData.hasAttributes_)
+            ApplyParsedAttributes(newComponent, componentData.attributes_);
+        else
+        {
+            MemoryBuffer compBuffer(componentData.data_.data() + componentData.dataOffset_,
+                componentData.data_.size() - componentData.dataOffset_);
+            newComponent->Load(compBuffer);
+        }
+    }
+
+    return newNode;
+}
+
 bool Node::LoadXML(const XMLElement& source, SceneResolver& resolver, bool loadChildren, bool rewriteIDs, bool removeComponents)
 {
     // Remove all children and components first in case this is not a fresh load
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "../Core/InternedString.h"
 #include "../IO/VectorBuffer.h"
 #include "../Math/Matrix3x4.h"
 #include "../Math/Transform.h"
@@ -31,6 +32,7 @@
 #include "../Scene/PrefabTypes.h"
 #include "../Scene/Serializable.h"
 
+#include <EASTL/span.h>
 #include <EASTL/type_traits.h>
 
 #include <atomic>
@@ -46,6 +48,7 @@ class Scene;
 class NodePrefab;
 class SceneResolver;
 class SerializablePrefab;
+struct ParsedNodeData;
 
 /// Transform space for translations and rotations.
 enum TransformSpace
@@ -60,8 +63,8 @@ struct URHO3D_API NodeImpl
 {
     /// Nodes this node depends on for network updates.
     ea::vector<Node*> dependencyNodes_;
-    /// Name.
-    ea::string name_;
+    /// Name. Interned, so nodes with the same name share the string storage.
+    InternedString name_;
     /// Tag strings.
     StringVector tags_;
     /// Name hash.
@@ -107,6 +110,9 @@ public:
 
     /// Instantiate scene content from prefab. Return root node if successful.
     Node* InstantiatePrefab(const NodePrefab& prefab, const Vector3& position, const Quaternion& rotation);
+    /// Instantiate multiple copies of prefab, one per transform. Transform of each root node is replaced entirely.
+    /// Return root nodes of created copies.
+    ea::vector<Node*> InstantiatePrefab(const NodePrefab& prefab, ea::span<const Transform> transforms);
     /// Generate prefab from scene content.
     void GeneratePrefab(NodePrefab& prefab) const;
     NodePrefab GeneratePrefab() const;
@@ -393,7 +399,7 @@ public:
 
     /// Return name.
     /// @property
-    const ea::string& GetName() const { return impl_->name_; }
+    const ea::string& GetName() const { return impl_->name_.GetString(); }
 
     /// Return name hash.
     StringHash GetNameHash() const { return impl_->nameHash_; }
@@ -694,6 +700,8 @@ public:
     void ResetScene();
     /// Load components and optionally load child nodes.
     bool Load(Deserializer& source, SceneResolver& resolver, bool loadChildren = true, bool rewriteIDs = false);
+    /// Create child node with components from parsed binary data. Child nodes of the parsed node are not created.
+    Node* CreateChild(const ParsedNodeData& data, SceneResolver& resolver);
     /// Load components from XML data and optionally load child nodes.
     bool LoadXML(const XMLElement& source, SceneResolver& resolver, bool loadChildren = true, bool rewriteIDs = false,
         bool removeComponents = true);
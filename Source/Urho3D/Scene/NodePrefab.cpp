@@ -171,6 +171,7 @@ void SerializablePrefab::Import(const Serializable* serializable, PrefabSaveFlag
     typeNameHash_ = reflection->GetTypeNameHash();
     temporary_ = serializable->IsTemporary();
 
+    InvalidateCompiledAttributes();
     attributes_.clear();
     attributes_.reserve(numObjectAttributes);
     for (unsigned attributeIndex = 0; attributeIndex < numObjectAttributes; ++attributeIndex)
@@ -223,43 +224,69 @@ void SerializablePrefab::Export(Serializable* serializable, PrefabLoadFlags flag
     if (!flags.Test(PrefabLoadFlag::KeepTemporaryState))
         serializable->SetTemporary(temporary_);
 
+    if (compiledRevision_ != reflection->GetAttributesRevision())
+        CompileAttributes(reflection);
+
+    const auto& objectAttributes = reflection->GetAttributes();
+    for (const CompiledAttribute& compiledAttribute : compiledAttributes_)
+    {
+        const AttributeInfo& attr = objectAttributes[compiledAttribute.attributeIndex_];
+        if (compiledAttribute.enumValue_ != M_MAX_UNSIGNED)
+            serializable->OnSetAttribute(attr, compiledAttribute.enumValue_);
+        else
+            serializable->OnSetAttribute(attr, attributes_[compiledAttribute.prefabIndex_].GetValue());
+    }
+}
+
+void SerializablePrefab::CompileAttributes(const ObjectReflection* reflection) const
+{
     const auto& objectAttributes = reflection->GetAttributes();
-    const unsigned numObjectAttributes = objectAttributes.size();
 
-    for (const AttributePrefab& attributePrefab : attributes_)
+    compiledAttributes_.clear();
+    unsigned hintIndex = 0;
+    for (unsigned prefabIndex = 0; prefabIndex < attributes_.size(); ++prefabIndex)
     {
+        const AttributePrefab& attributePrefab = attributes_[prefabIndex];
+
         // Not supported
         if (attributePrefab.GetId() != AttributeId::None)
             continue;
 
-        const unsigned attributeIndex = reflection->GetAttributeIndex(attributePrefab.GetNameHash());
+        // Attributes are usually stored in reflection order
+        const unsigned attributeIndex = reflection->GetAttributeIndex(attributePrefab.GetNameHash(), hintIndex);
         if (attributeIndex == M_MAX_UNSIGNED)
             continue;
+        hintIndex = attributeIndex + 1;
 
         const AttributeInfo& attr = objectAttributes[attributeIndex];
         if (!attr.ShouldLoad())
             continue;
 
-        const Variant& value = attributePrefab.GetValue();
+        CompiledAttribute compiledAttribute{prefabIndex, attributeIndex};
 
+        const Variant& value = attributePrefab.GetValue();
         if (value.GetType() == VAR_STRING && !attr.enumNames_.empty())
         {
-            const unsigned enumValue = attr.ConvertEnumToUInt(value.GetString());
-            if (enumValue != M_MAX_UNSIGNED)
-                serializable->OnSetAttribute(attr, enumValue);
-            else
+            compiledAttribute.enumValue_ = attr.ConvertEnumToUInt(value.GetString());
+            if (compiledAttribute.enumValue_ == M_MAX_UNSIGNED)
             {
                 URHO3D_LOGWARNING("Attribute '{}' of Serializable '{}' has unknown enum value '{}'",
                     attr.name_, reflection->GetTypeName(), value.GetString());
+                continue;
             }
         }
-        else
-            serializable->OnSetAttribute(attr, value);
+
+        compiledAttributes_.push_back(compiledAttribute);
     }
+
+    compiledRevision_ = reflection->GetAttributesRevision();
 }
 
 void SerializablePrefab::SerializeInBlock(Archive& archive, PrefabArchiveFlags flags, bool compactSave)
 {
+    if (archive.IsInput())
+        InvalidateCompiledAttributes();
+
     // Serialize ID
     if (flags.Test(PrefabArchiveFlag::IgnoreSerializableId))
     {
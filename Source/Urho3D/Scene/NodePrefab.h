@@ -104,12 +104,28 @@ public:
     StringHash GetTypeNameHash() const { return typeNameHash_; }
     SerializableId GetId() const { return id_; }
     const ea::vector<AttributePrefab>& GetAttributes() const { return attributes_; }
-    ea::vector<AttributePrefab>& GetMutableAttributes() { return attributes_; }
+    ea::vector<AttributePrefab>& GetMutableAttributes() { InvalidateCompiledAttributes(); return attributes_; }
 
     bool operator==(const SerializablePrefab& rhs) const;
     bool operator!=(const SerializablePrefab& rhs) const { return !(*this == rhs); }
 
 private:
+    /// Attribute resolved against object reflection.
+    struct CompiledAttribute
+    {
+        /// Index in attributes_.
+        unsigned prefabIndex_{};
+        /// Index in reflection attributes.
+        unsigned attributeIndex_{};
+        /// Value of enum attribute stored as string. M_MAX_UNSIGNED if value is used as is.
+        unsigned enumValue_{M_MAX_UNSIGNED};
+    };
+
+    /// Resolve attributes against reflection, so repeated Export doesn't need any lookups.
+    void CompileAttributes(const ObjectReflection* reflection) const;
+    /// Invalidate resolved attributes.
+    void InvalidateCompiledAttributes() { compiledRevision_ = 0; }
+
     ea::string typeName_;
     StringHash typeNameHash_;
 
@@ -117,6 +133,10 @@ private:
     bool temporary_{};
 
     ea::vector<AttributePrefab> attributes_;
+
+    /// Attributes resolved against reflection with given attributes revision. Not thread-safe.
+    mutable ea::vector<CompiledAttribute> compiledAttributes_;
+    mutable unsigned compiledRevision_{};
 };
 
 URHO3D_API void SerializeValue(Archive& archive, const char* name, SerializablePrefab& value,
@@ -0,0 +1,234 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Core/WorkQueue.h"
+#include "../IO/Deserializer.h"
+#include "../IO/Log.h"
+#include "../IO/MemoryBuffer.h"
+#include "../Scene/Node.h"
+#include "../Scene/ParsedSceneData.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+bool ReadParsedAttributes(Context* context, Deserializer& source, const ea::vector<AttributeInfo>& attributes,
+    ea::vector<Variant>& values)
+{
+    values.clear();
+    for (const AttributeInfo& attr : attributes)
+    {
+        if (!attr.ShouldLoad())
+            continue;
+
+        if (source.IsEof())
+            return false;
+
+        values.push_back(source.ReadVariant(attr.type_, context));
+    }
+    return true;
+}
+
+bool ParseNode(Context* context, Deserializer& source, const ea::vector<AttributeInfo>* nodeAttributes,
+    ea::vector<ParsedNodeData>& nodes)
+{
+    const unsigned nodeIndex = nodes.size();
+    nodes.emplace_back();
+    nodes[nodeIndex].id_ = source.ReadUInt();
+
+    if (nodeAttributes && !ReadParsedAttributes(context, source, *nodeAttributes, nodes[nodeIndex].attributes_))
+    {
+        URHO3D_LOGERROR("Could not load Node, stream not open or at end");
+        return false;
+    }
+
+    // Component data is nested and can be decoded separately
+    const unsigned numComponents = source.ReadVLE();
+    nodes[nodeIndex].components_.resize(numComponents);
+    for (ParsedComponentData& component : nodes[nodeIndex].components_)
+    {
+        component.data_.resize(source.ReadVLE());
+        if (source.Read(component.data_.data(), component.data_.size()) != component.data_.size())
+            return false;
+    }
+
+    const unsigned numChildren = source.ReadVLE();
+    nodes[nodeIndex].numChildren_ = numChildren;
+    for (unsigned i = 0; i < numChildren; ++i)
+    {
+        if (!ParseNode(context, source, nodeAttributes, nodes))
+            return false;
+    }
+
+    return true;
+}
+
+}
+
+bool ParseParsedNodeHierarchy(Context* context, Deserializer& source, ParsedNodeHierarchy& hierarchy)
+{
+    hierarchy.nodes_.clear();
+    if (source.IsEof())
+        return false;
+
+    return ParseNode(context, source, context->GetAttributes(Node::GetTypeStatic()), hierarchy.nodes_);
+}
+
+void DecodeParsedComponents(Context* context, ParsedNodeHierarchy& hierarchy)
+{
+    for (ParsedNodeData& node : hierarchy.nodes_)
+    {
+        for (ParsedComponentData& component : node.components_)
+        {
+            MemoryBuffer source(component.data_);
+            component.type_ = source.ReadStringHash();
+            component.id_ = source.ReadUInt();
+            component.dataOffset_ = source.GetPosition();
+
+            // Custom components keep raw data and are loaded on creation
+            const ea::vector<AttributeInfo>* attributes = context->GetAttributes(component.type_);
+            if (!attributes)
+                continue;
+
+            if (!ReadParsedAttributes(context, source, *attributes, component.attributes_))
+                URHO3D_LOGERROR("Could not load component, stream not open or at end");
+
+            component.hasAttributes_ = true;
+            component.data_.clear();
+            component.data_.shrink_to_fit();
+        }
+    }
+}
+
+void ApplyParsedAttributes(Serializable* serializable, const ea::vector<Variant>& attributes)
+{
+    const ea::vector<AttributeInfo>* serializableAttributes = serializable->GetAttributes();
+    if (!serializableAttributes)
+        return;
+
+    unsigned valueIndex = 0;
+    for (const AttributeInfo& attr : *serializableAttributes)
+    {
+        if (valueIndex >= attributes.size())
+            break;
+
+        if (!attr.ShouldLoad())
+            continue;
+
+        serializable->OnSetAttribute(attr, attributes[valueIndex++]);
+    }
+}
+
+AsyncSceneParser::AsyncSceneParser(Context* context, AbstractFilePtr file, unsigned numHierarchies)
+    : context_(context)
+    , file_(file)
+{
+    hierarchies_.resize(numHierarchies);
+    for (auto& hierarchy : hierarchies_)
+        hierarchy = ea::make_unique<ParsedNodeHierarchy>();
+
+    auto workQueue = context_->GetSubsystem<WorkQueue>();
+    if (workQueue && workQueue->GetNumThreads() > 0)
+        workQueue_ = workQueue;
+}
+
+AsyncSceneParser::~AsyncSceneParser()
+{
+    Stop();
+}
+
+void AsyncSceneParser::Start()
+{
+    if (workQueue_ && !parseTask_ && !hierarchies_.empty())
+        parseTask_ = workQueue_->PostTask([this](unsigned) { ParseHierarchies(); });
+}
+
+void AsyncSceneParser::Stop()
+{
+    stopped_.store(true, std::memory_order_relaxed);
+    if (!parseTask_)
+        return;
+
+    // Decode tasks are posted by the parse task, so they are known after it is completed
+    workQueue_->WaitForTask(parseTask_);
+    workQueue_->WaitForTasks(decodeTasks_);
+    decodeTasks_.clear();
+    parseTask_ = nullptr;
+}
+
+const ParsedNodeHierarchy* AsyncSceneParser::GetHierarchy(unsigned index)
+{
+    if (index >= hierarchies_.size() || !hierarchies_[index])
+        return nullptr;
+
+    ParsedNodeHierarchy& hierarchy = *hierarchies_[index];
+    if (!workQueue_ && !hierarchy.ready_.load(std::memory_order_relaxed) && index == numInlineParsed_)
+    {
+        hierarchy.success_ = ParseParsedNodeHierarchy(context_, *file_, hierarchy);
+        if (hierarchy.success_)
+            DecodeParsedComponents(context_, hierarchy);
+        hierarchy.ready_.store(true, std::memory_order_relaxed);
+        ++numInlineParsed_;
+    }
+
+    return hierarchy.ready_.load(std::memory_order_acquire) ? &hierarchy : nullptr;
+}
+
+void AsyncSceneParser::ReleaseHierarchy(unsigned index)
+{
+    // Tasks do not access the hierarchy after it is ready
+    if (index < hierarchies_.size() && hierarchies_[index] && hierarchies_[index]->ready_.load(std::memory_order_acquire))
+        hierarchies_[index] = nullptr;
+}
+
+void AsyncSceneParser::ParseHierarchies()
+{
+    for (auto& hierarchyPtr : hierarchies_)
+    {
+        if (stopped_.load(std::memory_order_relaxed))
+            return;
+
+        ParsedNodeHierarchy& hierarchy = *hierarchyPtr;
+        hierarchy.success_ = ParseParsedNodeHierarchy(context_, *file_, hierarchy);
+        if (!hierarchy.success_)
+        {
+            hierarchy.ready_.store(true, std::memory_order_release);
+            return;
+        }
+
+        decodeTasks_.push_back(workQueue_->PostTask([this, &hierarchy](unsigned)
+        {
+            DecodeParsedComponents(context_, hierarchy);
+            hierarchy.ready_.store(true, std::memory_order_release);
+        }));
+    }
+}
+
+}
@@ -0,0 +1,139 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Container/Ptr.h"
+#include "../Core/Variant.h"
+#include "../IO/AbstractFile.h"
+#include "../Math/StringHash.h"
+
+#include <EASTL/unique_ptr.h>
+#include <EASTL/vector.h>
+
+#include <atomic>
+
+namespace Urho3D
+{
+
+class Context;
+class Deserializer;
+class Serializable;
+class WorkQueue;
+class WorkTask;
+
+/// Component parsed from binary scene data.
+struct ParsedComponentData
+{
+    /// Component type.
+    StringHash type_;
+    /// Component ID.
+    unsigned id_{};
+    /// Values of loadable attributes in declaration order. Used if the component type is reflected.
+    ea::vector<Variant> attributes_;
+    /// Whether the attributes are decoded.
+    bool hasAttributes_{};
+    /// Raw component data. Used if the component type is not reflected.
+    ea::vector<unsigned char> data_;
+    /// Offset of the attribute data within the raw data.
+    unsigned dataOffset_{};
+};
+
+/// Node parsed from binary scene data.
+struct ParsedNodeData
+{
+    /// Node ID.
+    unsigned id_{};
+    /// Values of loadable node attributes in declaration order.
+    ea::vector<Variant> attributes_;
+    /// Components.
+    ea::vector<ParsedComponentData> components_;
+    /// Number of child nodes.
+    unsigned numChildren_{};
+};
+
+/// Hierarchy of a root-level child node parsed from binary scene data.
+/// Nodes are stored in depth-first order, so the hierarchy can be instantiated incrementally.
+struct ParsedNodeHierarchy
+{
+    /// Nodes.
+    ea::vector<ParsedNodeData> nodes_;
+    /// Whether the hierarchy was parsed successfully.
+    bool success_{};
+    /// Whether the hierarchy is parsed and decoded. Other members should not be accessed until set.
+    std::atomic<bool> ready_{};
+};
+
+/// Parse node hierarchy from binary scene data without decoding component attributes. Thread-safe.
+URHO3D_API bool ParseParsedNodeHierarchy(Context* context, Deserializer& source, ParsedNodeHierarchy& hierarchy);
+/// Decode attributes of all components of the node hierarchy and release raw data. Thread-safe.
+URHO3D_API void DecodeParsedComponents(Context* context, ParsedNodeHierarchy& hierarchy);
+/// Assign decoded attribute values to the object.
+URHO3D_API void ApplyParsedAttributes(Serializable* serializable, const ea::vector<Variant>& attributes);
+
+/// Parses root-level child nodes of binary scene data on WorkQueue threads.
+/// Hierarchies are parsed sequentially by one task, and components of each hierarchy are decoded by separate tasks.
+/// Hierarchies are parsed on demand on the calling thread if there are no worker threads.
+class URHO3D_API AsyncSceneParser : public RefCounted
+{
+public:
+    /// Construct. The file should be positioned at the first root-level child node.
+    AsyncSceneParser(Context* context, AbstractFilePtr file, unsigned numHierarchies);
+    /// Destruct. Wait for pending tasks.
+    ~AsyncSceneParser() override;
+
+    /// Start parsing.
+    void Start();
+    /// Stop parsing and wait for pending tasks. The file is not accessed afterwards.
+    void Stop();
+
+    /// Return hierarchy by index if ready, null otherwise. Hierarchies should be requested in order.
+    const ParsedNodeHierarchy* GetHierarchy(unsigned index);
+    /// Release memory of hierarchy that is not needed anymore.
+    void ReleaseHierarchy(unsigned index);
+    /// Return number of hierarchies.
+    unsigned GetNumHierarchies() const { return hierarchies_.size(); }
+
+private:
+    /// Parse hierarchies until stopped or failed.
+    void ParseHierarchies();
+
+    /// Context.
+    Context* context_{};
+    /// Work queue, if there are worker threads.
+    WorkQueue* workQueue_{};
+    /// File.
+    AbstractFilePtr file_;
+    /// Hierarchies.
+    ea::vector<ea::unique_ptr<ParsedNodeHierarchy>> hierarchies_;
+    /// Task that parses hierarchies.
+    SharedPtr<WorkTask> parseTask_;
+    /// Tasks that decode components. Accessed by the parse task until it is completed.
+    ea::vector<SharedPtr<WorkTask>> decodeTasks_;
+    /// Number of hierarchies parsed on the calling thread.
+    unsigned numInlineParsed_{};
+    /// Whether parsing should stop.
+    std::atomic<bool> stopped_{};
+};
+
+}
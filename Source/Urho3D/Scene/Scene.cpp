@@ -40,6 +40,7 @@
 #include "../Scene/Scene.h"
 #include "../Scene/SceneEvents.h"
 #include "../Scene/SceneResource.h"
+#include "../Scene/SpatialIndex.h"
 #include "../Scene/SplinePath.h"
 #include "../Scene/UnknownComponent.h"
 #include "../Scene/ValueAnimation.h"
@@ -74,6 +75,9 @@ Scene::Scene(Context* context) :
 
 Scene::~Scene()
 {
+    // Pending parse tasks access the file
+    StopAsyncLoading();
+
     // Remove root-level components first, so that scene subsystems such as the octree destroy themselves. This will speed up
     // the removal of child nodes' components
     RemoveAllComponents();
@@ -98,6 +102,33 @@ void Scene::RegisterObject(Context* context)
     URHO3D_ATTRIBUTE_EX("Lightmaps", ResourceRefList, lightmaps_, ReloadLightmaps, ResourceRefList(Texture2D::GetTypeStatic()), AM_DEFAULT);
 }
 
+void SceneComponentIndex::Insert(Component* component)
+{
+    if (Contains(component))
+        return;
+
+    component->indexSlot_ = components_.size();
+    components_.push_back(component);
+}
+
+void SceneComponentIndex::Erase(Component* component)
+{
+    if (!Contains(component))
+        return;
+
+    Component* lastComponent = components_.back();
+    components_[component->indexSlot_] = lastComponent;
+    lastComponent->indexSlot_ = component->indexSlot_;
+    components_.pop_back();
+    component->indexSlot_ = M_MAX_UNSIGNED;
+}
+
+bool SceneComponentIndex::Contains(const Component* component) const
+{
+    const unsigned slot = component->indexSlot_;
+    return slot < components_.size() && components_[slot] == component;
+}
+
 bool Scene::CreateComponentIndex(StringHash componentType)
 {
     if (!IsEmpty())
@@ -398,8 +429,10 @@ bool Scene::LoadAsync(AbstractFilePtr file, LoadMode mode)
             return false;
         }
 
-        // Then prepare to load child nodes in the async updates
+        // Then prepare to load child nodes in the async updates. Nodes are parsed ahead on worker threads.
         asyncProgress_.totalNodes_ = file->ReadVLE();
+        asyncProgress_.sceneParser_ = MakeShared<AsyncSceneParser>(context_, file, asyncProgress_.totalNodes_);
+        asyncProgress_.sceneParser_->Start();
     }
     else
     {
@@ -555,6 +588,11 @@ void Scene::StopAsyncLoading()
     asyncProgress_.xmlElement_ = XMLElement::EMPTY;
     asyncProgress_.jsonIndex_ = 0;
     asyncProgress_.resources_.clear();
+    if (asyncProgress_.sceneParser_)
+        asyncProgress_.sceneParser_->Stop();
+    asyncProgress_.sceneParser_ = nullptr;
+    asyncProgress_.parsedNodeIndex_ = 0;
+    asyncProgress_.parsedNodeStack_.clear();
     resolver_.Reset();
 }
 
@@ -778,6 +816,7 @@ void Scene::Update(float timeStep)
 
     // Update variable timestep logic
     SendEvent(E_SCENEUPDATE, eventData);
+    logicUpdateQueue_.Update(LogicUpdatePhase::Update, timeStep, this);
 
     // Update scene attribute animation.
     SendEvent(E_ATTRIBUTEANIMATIONUPDATE, eventData);
@@ -787,6 +826,7 @@ void Scene::Update(float timeStep)
 
     // Post-update variable timestep logic
     SendEvent(E_SCENEPOSTUPDATE, eventData);
+    logicUpdateQueue_.Update(LogicUpdatePhase::PostUpdate, timeStep, this);
 
     // Note: using a float for elapsed time accumulation is inherently inaccurate. The purpose of this value is
     // primarily to update material animation effects, as it is available to shaders. It can be reset by calling
@@ -794,6 +834,115 @@ void Scene::Update(float timeStep)
     elapsedTime_ += timeStep;
 }
 
+void Scene::UpdateLogicComponents(float timeStep)
+{
+    // Async loading is driven by events
+    if (asyncLoading_)
+        return;
+
+    URHO3D_PROFILE("UpdateSceneLogicComponents");
+
+    timeStep *= timeScale_;
+
+    logicUpdateQueue_.Update(LogicUpdatePhase::Update, timeStep, this);
+    logicUpdateQueue_.Update(LogicUpdatePhase::PostUpdate, timeStep, this);
+
+    elapsedTime_ += timeStep;
+}
+
+void Scene::UpdateLogicComponents(ea::span<Scene* const> scenes, float timeStep)
+{
+    if (scenes.empty())
+        return;
+
+    // Delayed start may modify the scene and script callback is not thread-safe, keep them in the main thread
+    ea::vector<Scene*> parallelScenes;
+    ea::vector<Scene*> mainThreadScenes;
+    for (Scene* scene : scenes)
+    {
+        if (scene->asyncLoading_)
+            continue;
+
+        scene->logicUpdateQueue_.CallDelayedStarts();
+        if (scene->logicUpdateQueue_.HasScriptUpdates())
+            mainThreadScenes.push_back(scene);
+        else
+            parallelScenes.push_back(scene);
+    }
+
+    auto workQueue = scenes[0]->GetSubsystem<WorkQueue>();
+    ForEachParallel(workQueue, 1u, parallelScenes,
+        [&](unsigned /*index*/, Scene* scene) { scene->UpdateLogicComponents(timeStep); });
+
+    for (Scene* scene : mainThreadScenes)
+        scene->UpdateLogicComponents(timeStep);
+}
+
+void Scene::SetBatchedTransformUpdate(bool enable)
+{
+    batchedTransformUpdate_ = enable;
+    if (!enable)
+    {
+        MutexLock<SpinLockMutex> lock(dirtyTransformMutex_);
+        dirtyTransformRoots_.clear();
+    }
+}
+
+void Scene::QueueDirtyTransform(Node* node)
+{
+    MutexLock<SpinLockMutex> lock(dirtyTransformMutex_);
+    dirtyTransformRoots_.emplace_back(node);
+}
+
+void Scene::UpdateDirtyTransforms()
+{
+    ea::vector<WeakPtr<Node>> queuedNodes;
+    {
+        MutexLock<SpinLockMutex> lock(dirtyTransformMutex_);
+        queuedNodes.swap(dirtyTransformRoots_);
+    }
+
+    if (queuedNodes.empty())
+        return;
+
+    URHO3D_PROFILE("UpdateDirtyTransforms");
+
+    auto workQueue = GetSubsystem<WorkQueue>();
+
+    // Skip nodes that were already updated or that are now covered by a dirty parent, so subtrees are disjoint.
+    // If any ancestor is dirty then the parent is dirty too.
+    LinearVector<Node*> subtreeRoots{LinearAllocatorAdaptor{&workQueue->GetFrameAllocator()}};
+    for (Node* node : queuedNodes)
+    {
+        if (node && node->IsDirty() && (!node->GetParent() || !node->GetParent()->IsDirty()))
+            subtreeRoots.push_back(node);
+    }
+
+    static const unsigned SubtreeBucket = 16;
+    ForEachParallel(workQueue, SubtreeBucket, subtreeRoots.size(),
+        [&](unsigned beginIndex, unsigned endIndex)
+    {
+        LinearVector<Node*> stack{LinearAllocatorAdaptor{&workQueue->GetFrameAllocator()}};
+        for (unsigned index = beginIndex; index < endIndex; ++index)
+        {
+            stack.push_back(subtreeRoots[index]);
+            while (!stack.empty())
+            {
+                Node* node = stack.back();
+                stack.pop_back();
+                node->GetWorldTransform();
+
+                // Children of clean node are clean
+                for (Node* child : node->GetChildren())
+                {
+                    if (child->IsDirty())
+                        stack.push_back(child);
+                }
+            }
+        }
+    });
+}
+
 void Scene::BeginThreadedUpdate()
 {
     // Check the work queue subsystem whether it actually has created worker threads. If not, do not enter threaded mode.
@@ -965,7 +1114,7 @@ void Scene::ComponentAdded(Component* component)
     component->OnSceneSet(this);
 
     if (auto index = GetMutableComponentIndex(component->GetType()))
-        index->insert(component);
+        index->Insert(component);
 }
 
 void Scene::ComponentRemoved(Component* component)
@@ -974,7 +1123,7 @@ void Scene::ComponentRemoved(Component* component)
         return;
 
     if (auto index = GetMutableComponentIndex(component->GetType()))
-        index->erase(component);
+        index->Erase(component);
 
     unsigned id = component->GetID();
     replicatedComponents_.erase(id);
@@ -1073,10 +1222,39 @@ void Scene::UpdateAsyncLoading()
         }
         else // Load from binary
         {
-            unsigned nodeID = asyncProgress_.file_->ReadUInt();
-            Node* newNode = CreateChild(nodeID);
-            resolver_.AddNode(nodeID, newNode);
-            newNode->Load(*asyncProgress_.file_, resolver_);
+            AsyncSceneParser* loader = asyncProgress_.sceneParser_;
+            const ParsedNodeHierarchy* hierarchy = loader->GetHierarchy(asyncProgress_.loadedNodes_);
+            // Wait until the node is parsed
+            if (!hierarchy)
+                break;
+
+            if (!hierarchy->success_)
+            {
+                URHO3D_LOGERROR("Failed to load node from {}", asyncProgress_.file_->GetName());
+                FinishAsyncLoading();
+                return;
+            }
+
+            // Create one node at a time, so that large hierarchies are spread across frames too
+            auto& nodeStack = asyncProgress_.parsedNodeStack_;
+            const ParsedNodeData& nodeData = hierarchy->nodes_[asyncProgress_.parsedNodeIndex_];
+            Node* parent = !nodeStack.empty() ? nodeStack.back().first.Get() : this;
+            Node* newNode = parent->CreateChild(nodeData, resolver_);
+
+            if (!nodeStack.empty() && --nodeStack.back().second == 0)
+                nodeStack.pop_back();
+            if (nodeData.numChildren_ > 0)
+                nodeStack.emplace_back(SharedPtr<Node>(newNode), nodeData.numChildren_);
+
+            if (++asyncProgress_.parsedNodeIndex_ < hierarchy->nodes_.size())
+            {
+                if (asyncLoadTimer.GetUSec(false) >= asyncLoadingMs_ * 1000LL)
+                    break;
+                continue;
+            }
+
+            loader->ReleaseHierarchy(asyncProgress_.loadedNodes_);
+            asyncProgress_.parsedNodeIndex_ = 0;
         }
 
         ++asyncProgress_.loadedNodes_;
@@ -1102,6 +1280,9 @@ void Scene::FinishAsyncLoading()
 {
     if (asyncProgress_.mode_ > LOAD_RESOURCES_ONLY)
     {
+        if (asyncProgress_.sceneParser_)
+            asyncProgress_.sceneParser_->Stop();
+
         resolver_.Resolve();
         ApplyAttributes();
         FinishLoading(asyncProgress_.file_);
@@ -1398,6 +1579,8 @@ void RegisterSceneLibrary(Context* context)
     SplinePath::RegisterObject(context);
     PrefabReference::RegisterObject(context);
     PrefabResource::RegisterObject(context);
+    SpatialIndex::RegisterObject(context);
+    SpatialIndexItem::RegisterObject(context);
 }
 
 }
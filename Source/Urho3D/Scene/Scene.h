@@ -25,9 +25,12 @@
 #pragma once
 
 #include "../Core/Mutex.h"
+#include "../Core/WorkQueue.h"
 #include "../Resource/JSONFile.h"
 #include "../Resource/XMLElement.h"
+#include "../Scene/LogicUpdateQueue.h"
 #include "../Scene/Node.h"
+#include "../Scene/ParsedSceneData.h"
 #include "../Scene/SceneResolver.h"
 
 #include <EASTL/span.h>
@@ -84,10 +87,44 @@ struct AsyncProgress
     unsigned loadedNodes_;
     /// Total root-level nodes.
     unsigned totalNodes_;
+
+    /// Parser of root-level nodes for binary mode.
+    SharedPtr<AsyncSceneParser> sceneParser_;
+    /// Index of the next node to create within current parsed root-level node.
+    unsigned parsedNodeIndex_{};
+    /// Created parsed nodes with the number of child nodes left to create.
+    ea::vector<ea::pair<SharedPtr<Node>, unsigned>> parsedNodeStack_;
 };
 
-/// Index of components in the Scene.
-using SceneComponentIndex = ea::hash_set<Component*>;
+/// Index of scene components of one type.
+/// Components are stored in dense array, removed component is replaced with the last one.
+class URHO3D_API SceneComponentIndex
+{
+public:
+    /// Add component.
+    void Insert(Component* component);
+    /// Remove component.
+    void Erase(Component* component);
+    /// Return whether the component is in the index.
+    bool Contains(const Component* component) const;
+
+    /// Return all components.
+    ea::span<Component* const> GetComponents() const { return components_; }
+    /// Return number of components.
+    unsigned Size() const { return components_.size(); }
+
+    /// Iteration and size for range-based loops and ForEachParallel.
+    /// @{
+    auto begin() const { return components_.begin(); }
+    auto end() const { return components_.end(); }
+    unsigned size() const { return components_.size(); }
+    bool empty() const { return components_.empty(); }
+    /// @}
+
+private:
+    /// Components in no particular order.
+    ea::vector<Component*> components_;
+};
 
 /// Root scene node, represents the whole scene.
 class URHO3D_API Scene : public Node
@@ -117,6 +154,9 @@ public:
     const SceneComponentIndex& GetComponentIndex(StringHash componentType);
     /// Return component index for template type. Invalidated when indexed component is added or removed!
     template <class T> const SceneComponentIndex& GetComponentIndex() { return GetComponentIndex(T::GetTypeStatic()); }
+    /// Process all components of indexed type in multiple threads. Components must not be added or removed meanwhile.
+    /// Signature of callback: void(unsigned index, T* component)
+    template <class T, class Callback> void ForEachComponentParallel(unsigned bucket, const Callback& callback);
 
     /// Serialize object. May throw ArchiveException.
     void SerializeInBlock(Archive& archive) override;
@@ -251,6 +291,18 @@ public:
 
     /// Update scene. Called by HandleUpdate.
     void Update(float timeStep);
+    /// Update only logic components in the scene update queue, without sending any events.
+    /// Unlike Update(), doesn't use global event state and may be called from worker thread,
+    /// as long as the scene is not updated by any other thread at the same time.
+    /// Delayed starts and script components are never updated from worker thread, see the overload for many scenes.
+    /// Attribute animation, scene subsystems (e.g. physics) and components updated via events are not updated.
+    /// Components must not create or remove nodes and components, nor subscribe to or send events.
+    void UpdateLogicComponents(float timeStep);
+    /// Update logic components of several scenes via UpdateLogicComponents.
+    /// Each scene is updated sequentially by one WorkQueue task, scenes are updated concurrently.
+    /// Delayed starts are called from main thread first. Scenes with script components are updated in main thread.
+    /// Should be called from main thread. Scenes should not share nodes or components.
+    static void UpdateLogicComponents(ea::span<Scene* const> scenes, float timeStep);
     /// Begin a threaded update. During threaded update components can choose to delay dirty processing.
     void BeginThreadedUpdate();
     /// End a threaded update. Notify components that marked themselves for delayed dirty processing.
@@ -260,6 +312,18 @@ public:
 
     /// Return threaded update flag.
     bool IsThreadedUpdate() const { return threadedUpdate_; }
+    /// Return logic components updated directly by the scene.
+    LogicUpdateQueue& GetLogicUpdateQueue() { return logicUpdateQueue_; }
+
+    /// Enable or disable batched update of dirty world transforms. When enabled, the octree recalculates world transforms
+    /// of all nodes moved during the frame in one pass over independent subtrees, in worker threads if available. Default false.
+    void SetBatchedTransformUpdate(bool enable);
+    /// Return whether batched update of dirty world transforms is enabled.
+    bool IsBatchedTransformUpdate() const { return batchedTransformUpdate_; }
+    /// Add the node that became dirty while its parent is not to the batched update. Called by Node::MarkDirty outside of threaded update.
+    void QueueDirtyTransform(Node* node);
+    /// Recalculate world transforms of all queued dirty nodes and their children.
+    void UpdateDirtyTransforms();
 
     /// Get free node ID.
     unsigned GetFreeNodeID();
@@ -331,6 +395,12 @@ private:
     ea::unordered_map<StringHash, ea::string> varNames_;
     /// Delayed dirty notification queue for components.
     ea::vector<Component*> delayedDirtyComponents_;
+    /// Logic components updated directly by the scene.
+    LogicUpdateQueue logicUpdateQueue_;
+    /// Nodes that became dirty while their parents were not, for batched transform update.
+    ea::vector<WeakPtr<Node>> dirtyTransformRoots_;
+    /// Mutex for the batched transform update queue.
+    SpinLockMutex dirtyTransformMutex_;
     /// Mutex for the delayed dirty notification queue.
     Mutex sceneMutex_;
     /// Next free non-local node ID.
@@ -351,6 +421,8 @@ private:
     bool asyncLoading_;
     /// Threaded update flag.
     bool threadedUpdate_;
+    /// Batched transform update flag.
+    bool batchedTransformUpdate_{};
 
     /// Lightmap textures names.
     ResourceRefList lightmaps_;
@@ -358,6 +430,13 @@ private:
     ea::vector<SharedPtr<Texture2D>> lightmapTextures_;
 };
 
+template <class T, class Callback> void Scene::ForEachComponentParallel(unsigned bucket, const Callback& callback)
+{
+    const SceneComponentIndex& index = GetComponentIndex<T>();
+    ForEachParallel(GetSubsystem<WorkQueue>(), bucket, index.GetComponents(),
+        [&](unsigned componentIndex, Component* component) { callback(componentIndex, static_cast<T*>(component)); });
+}
+
 /// Register Scene library objects.
 /// @nobind
 void URHO3D_API RegisterSceneLibrary(Context* context);
@@ -23,12 +23,15 @@
 #include <Urho3D/Precompiled.h>
 
 #include <Urho3D/IO/BinaryArchive.h>
+#include <Urho3D/IO/Compression.h>
 #include <Urho3D/IO/File.h>
 #include <Urho3D/IO/FileSystem.h>
 #include <Urho3D/IO/Log.h>
 #include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
 #include <Urho3D/Scene/PrefabResource.h>
 #include <Urho3D/Scene/SceneResource.h>
+#include <Urho3D/Scene/SceneSnapshot.h>
 #include <Urho3D/Resource/BinaryFile.h>
 #include <Urho3D/Resource/JSONArchive.h>
 #include <Urho3D/Resource/JSONFile.h>
@@ -140,6 +143,24 @@ bool SceneResource::BeginLoad(Deserializer& source)
     loadJsonFile_ = nullptr;
     loadXmlFile_ = nullptr;
 
+    // Decompress scene snapshot if needed
+    BinaryMagic magic;
+    const unsigned basePos = source.Tell();
+    if (source.Read(magic.data(), BinaryMagicSize) == BinaryMagicSize && magic == SceneSnapshot::CompressedMagic)
+    {
+        VectorBuffer buffer;
+        if (!DecompressStream(buffer, source))
+        {
+            URHO3D_LOGERROR("Cannot decompress scene");
+            return false;
+        }
+
+        buffer.Seek(0);
+        buffer.SetName(source.GetName());
+        return BeginLoad(buffer);
+    }
+    source.Seek(basePos);
+
     const auto format = PeekResourceFormat(source, DefaultBinaryMagic);
     switch (format)
     {
@@ -0,0 +1,181 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include <Urho3D/Precompiled.h>
+
+#include <Urho3D/Scene/SceneSnapshot.h>
+
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/IO/BinaryArchive.h>
+#include <Urho3D/IO/Compression.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/IO/VectorBuffer.h>
+#include <Urho3D/Resource/JSONArchive.h>
+#include <Urho3D/Resource/JSONFile.h>
+#include <Urho3D/Resource/XMLArchive.h>
+#include <Urho3D/Resource/XMLFile.h>
+#include <Urho3D/Scene/PrefabWriter.h>
+#include <Urho3D/Scene/Scene.h>
+
+namespace Urho3D
+{
+
+namespace
+{
+
+// Should be the same as in SceneResource.
+const char* rootBlockName = "resource";
+
+}
+
+const BinaryMagic SceneSnapshot::CompressedMagic{{'\0', 'C', 'S', 'N'}};
+
+SceneSnapshot::SceneSnapshot(Scene* scene, InternalResourceFormat format)
+    : context_(scene->GetContext())
+    , format_(format)
+{
+    URHO3D_PROFILE("CaptureSceneSnapshot");
+
+    // Use the same flags as SceneResource so the output is identical
+    const PrefabSaveFlags saveFlags = format == InternalResourceFormat::Binary
+        ? PrefabSaveFlag::CompactAttributeNames
+        : PrefabSaveFlag::EnumsAsStrings;
+
+    auto prefab = ea::make_shared<NodePrefab>();
+    PrefabWriterToMemory writer{*prefab, saveFlags};
+    if (scene->Save(writer))
+        prefab_ = ea::move(prefab);
+}
+
+bool SceneSnapshot::Save(Serializer& dest, bool compress) const
+{
+    if (!compress)
+        return SaveUncompressed(dest);
+
+    VectorBuffer buffer;
+    if (!SaveUncompressed(buffer))
+        return false;
+
+    buffer.Seek(0);
+    dest.Write(CompressedMagic.data(), BinaryMagicSize);
+    return CompressStream(dest, buffer);
+}
+
+bool SceneSnapshot::SaveUncompressed(Serializer& dest) const
+{
+    URHO3D_PROFILE("SaveSceneSnapshot");
+
+    if (!prefab_)
+    {
+        URHO3D_LOGERROR("Cannot save empty scene snapshot");
+        return false;
+    }
+
+    // Archive is output only, prefab is not modified
+    auto& prefab = const_cast<NodePrefab&>(*prefab_);
+
+    try
+    {
+        switch (format_)
+        {
+        case InternalResourceFormat::Json:
+        {
+            JSONFile jsonFile(context_);
+            JSONOutputArchive archive{context_, jsonFile.GetRoot(), &jsonFile};
+            {
+                ArchiveBlock block = archive.OpenUnorderedBlock(rootBlockName);
+                prefab.SerializeInBlock(archive, PrefabArchiveFlag::None);
+            }
+            return jsonFile.Save(dest);
+        }
+        case InternalResourceFormat::Xml:
+        {
+            XMLFile xmlFile(context_);
+            XMLOutputArchive archive{context_, xmlFile.GetOrCreateRoot(rootBlockName), &xmlFile};
+            {
+                ArchiveBlock block = archive.OpenUnorderedBlock(rootBlockName);
+                prefab.SerializeInBlock(archive, PrefabArchiveFlag::None);
+            }
+            return xmlFile.Save(dest);
+        }
+        case InternalResourceFormat::Binary:
+        {
+            dest.Write(DefaultBinaryMagic.data(), BinaryMagicSize);
+
+            BinaryOutputArchive archive{context_, dest};
+            {
+                ArchiveBlock block = archive.OpenUnorderedBlock(rootBlockName);
+                prefab.SerializeInBlock(archive, PrefabArchiveFlag::CompactTypeNames);
+            }
+            return true;
+        }
+        default:
+        {
+            URHO3D_LOGERROR("Cannot save scene snapshot in unknown format");
+            return false;
+        }
+        }
+    }
+    catch (const ArchiveException& e)
+    {
+        URHO3D_LOGERROR("Cannot save scene snapshot: {}", e.what());
+        return false;
+    }
+}
+
+bool SceneSnapshot::SaveFile(const ea::string& fileName, bool compress) const
+{
+    // Serialize into memory first, so incomplete file is not left on disk on failure
+    VectorBuffer buffer;
+    if (!Save(buffer, compress))
+        return false;
+
+    auto fs = context_->GetSubsystem<FileSystem>();
+    if (!fs->CreateDirsRecursive(GetPath(fileName)))
+        return false;
+
+    File file(context_);
+    if (!file.Open(fileName, FILE_WRITE))
+        return false;
+
+    return file.Write(buffer.GetData(), buffer.GetSize()) == buffer.GetSize();
+}
+
+SharedPtr<WorkTask> SceneSnapshot::SaveFileAsync(
+    const ea::string& fileName, bool compress, ea::function<void(bool success)> callback) const
+{
+    auto workQueue = context_->GetSubsystem<WorkQueue>();
+    return workQueue->PostTask([=, snapshot = *this](unsigned /*threadIndex*/)
+    {
+        const bool success = snapshot.SaveFile(fileName, compress);
+        if (!success)
+            URHO3D_LOGERROR("Cannot save scene snapshot to '{}'", fileName);
+
+        if (callback)
+            workQueue->CallFromMainThread([=](unsigned /*threadIndex*/) { callback(success); });
+    });
+}
+
+} // namespace Urho3D
@@ -0,0 +1,74 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include <Urho3D/Resource/Resource.h>
+#include <Urho3D/Scene/NodePrefab.h>
+
+#include <EASTL/functional.h>
+#include <EASTL/shared_ptr.h>
+
+namespace Urho3D
+{
+
+class Scene;
+class WorkTask;
+
+/// Snapshot of scene attributes captured at frame boundary.
+/// Capture only copies attribute values and is done on the main thread.
+/// Saving doesn't touch the live scene and may be done from any thread, so scene may be saved in background.
+/// Snapshot is cheap to copy, all copies share the same immutable data.
+class URHO3D_API SceneSnapshot
+{
+public:
+    /// Magic header of compressed snapshot. SceneResource recognizes and decompresses it on load.
+    static const BinaryMagic CompressedMagic;
+
+    SceneSnapshot() = default;
+    /// Capture scene for saving in specified format.
+    SceneSnapshot(Scene* scene, InternalResourceFormat format);
+
+    /// Save snapshot in the same format as SceneResource. Thread-safe.
+    bool Save(Serializer& dest, bool compress = false) const;
+    /// Save snapshot to file. Thread-safe.
+    bool SaveFile(const ea::string& fileName, bool compress = false) const;
+    /// Save snapshot to file in worker thread. Callback is invoked from main thread when saving is finished.
+    SharedPtr<WorkTask> SaveFileAsync(
+        const ea::string& fileName, bool compress = false, ea::function<void(bool success)> callback = {}) const;
+
+    /// Return whether the snapshot contains any data.
+    bool IsEmpty() const { return !prefab_; }
+    /// Return format.
+    InternalResourceFormat GetFormat() const { return format_; }
+    /// Return captured scene hierarchy.
+    const NodePrefab& GetPrefab() const { return prefab_ ? *prefab_ : NodePrefab::Empty; }
+
+private:
+    bool SaveUncompressed(Serializer& dest) const;
+
+    Context* context_{};
+    InternalResourceFormat format_{InternalResourceFormat::Unknown};
+    ea::shared_ptr<const NodePrefab> prefab_;
+};
+
+} // namespace Urho3D
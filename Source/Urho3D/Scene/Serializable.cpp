@@ -102,6 +102,8 @@ bool Serializable::Load(Deserializer& source)
     if (!attributes)
         return true;
 
+    const bool hasBinaryAccess = !setInstanceDefault_ && HasDirectAttributeAccess();
+
     for (unsigned i = 0; i < attributes->size(); ++i)
     {
         const AttributeInfo& attr = attributes->at(i);
@@ -114,6 +116,13 @@ bool Serializable::Load(Deserializer& source)
             return false;
         }
 
+        // Read plain values directly if nothing intercepts attribute assignment
+        if (hasBinaryAccess && attr.accessor_->HasBinaryAccess())
+        {
+            attr.accessor_->ReadBinary(this, source);
+            continue;
+        }
+
         Variant varValue = source.ReadVariant(attr.type_, context_);
         OnSetAttribute(attr, varValue);
     }
@@ -127,6 +136,7 @@ bool Serializable::Save(Serializer& dest) const
     if (!attributes)
         return true;
 
+    const bool hasBinaryAccess = HasDirectAttributeAccess();
     Variant value;
 
     for (unsigned i = 0; i < attributes->size(); ++i)
@@ -135,6 +145,17 @@ bool Serializable::Save(Serializer& dest) const
         if (!attr.ShouldSave())
             continue;
 
+        // Write plain values directly if nothing intercepts attribute access
+        if (hasBinaryAccess && attr.accessor_->HasBinaryAccess())
+        {
+            if (!attr.accessor_->WriteBinary(this, dest))
+            {
+                URHO3D_LOGERROR("Could not save " + GetTypeName() + ", writing to stream failed");
+                return false;
+            }
+            continue;
+        }
+
         OnGetAttribute(attr, value);
 
         if (!dest.WriteVariantData(value))
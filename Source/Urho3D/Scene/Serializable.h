@@ -24,6 +24,8 @@
 
 #include "../Core/Attribute.h"
 #include "../Core/Object.h"
+#include "../IO/Deserializer.h"
+#include "../IO/Serializer.h"
 
 #include <cstddef>
 
@@ -53,6 +55,8 @@ public:
     virtual void OnSetAttribute(const AttributeInfo& attr, const Variant& src);
     /// Handle attribute read access. Default implementation reads the variable at offset, or invokes the get accessor.
     virtual void OnGetAttribute(const AttributeInfo& attr, Variant& dest) const;
+    /// Return whether binary serialization may access attributes directly, bypassing OnSetAttribute and OnGetAttribute. Should return false if they are overridden.
+    virtual bool HasDirectAttributeAccess() const { return true; }
     /// Return reflection used for serialization.
     virtual ObjectReflection* GetReflection() const;
     /// Return attribute descriptions, or null if none defined.
@@ -178,15 +182,125 @@ SharedPtr<AttributeAccessor> MakeVariantAttributeAccessor(TGetFunction getFuncti
     return SharedPtr<AttributeAccessor>(new VariantAttributeAccessorImpl<TClassType, TGetFunction, TSetFunction>(getFunction, setFunction));
 }
 
+/// Whether the attribute type is stored in Variant binary data as a plain memory block.
+template <class T> struct IsBinaryBlockAttribute : ea::false_type {};
+template <> struct IsBinaryBlockAttribute<int> : ea::true_type {};
+template <> struct IsBinaryBlockAttribute<unsigned> : ea::true_type {};
+template <> struct IsBinaryBlockAttribute<long long> : ea::true_type {};
+template <> struct IsBinaryBlockAttribute<unsigned long long> : ea::true_type {};
+template <> struct IsBinaryBlockAttribute<float> : ea::true_type {};
+template <> struct IsBinaryBlockAttribute<double> : ea::true_type {};
+template <> struct IsBinaryBlockAttribute<Vector2> : ea::true_type {};
+template <> struct IsBinaryBlockAttribute<Vector3> : ea::true_type {};
+template <> struct IsBinaryBlockAttribute<Vector4> : ea::true_type {};
+template <> struct IsBinaryBlockAttribute<IntVector2> : ea::true_type {};
+template <> struct IsBinaryBlockAttribute<IntVector3> : ea::true_type {};
+template <> struct IsBinaryBlockAttribute<Quaternion> : ea::true_type {};
+template <> struct IsBinaryBlockAttribute<Color> : ea::true_type {};
+template <> struct IsBinaryBlockAttribute<Rect> : ea::true_type {};
+template <> struct IsBinaryBlockAttribute<IntRect> : ea::true_type {};
+template <> struct IsBinaryBlockAttribute<Matrix3> : ea::true_type {};
+template <> struct IsBinaryBlockAttribute<Matrix3x4> : ea::true_type {};
+template <> struct IsBinaryBlockAttribute<Matrix4> : ea::true_type {};
+
+/// Template implementation of the attribute accessor for values of known type.
+/// Attributes of plain types are written and read in binary form directly, without constructing Variants.
+template <class TClassType, class T, class TGetFunction, class TSetFunction>
+class TypedAttributeAccessorImpl : public AttributeAccessor
+{
+public:
+    /// Construct.
+    TypedAttributeAccessorImpl(TGetFunction getFunction, TSetFunction setFunction) : getFunction_(getFunction), setFunction_(setFunction) { }
+
+    /// Invoke getter function.
+    void Get(const Serializable* ptr, Variant& value) const override
+    {
+        assert(ptr);
+        const auto classPtr = static_cast<const TClassType*>(ptr);
+        value = getFunction_(*classPtr);
+    }
+
+    /// Invoke setter function.
+    void Set(Serializable* ptr, const Variant& value) override
+    {
+        assert(ptr);
+        auto classPtr = static_cast<TClassType*>(ptr);
+        setFunction_(*classPtr, value.Get<T>());
+    }
+
+    /// Return whether the attribute can be written and read in binary form without Variant conversion.
+    bool HasBinaryAccess() const override { return IsBinaryValue || IsBoolValue; }
+
+    /// Write the attribute in binary form.
+    bool WriteBinary(const Serializable* ptr, Serializer& dest) const override
+    {
+        assert(ptr);
+        if constexpr (IsBinaryValue)
+        {
+            const T value = getFunction_(*static_cast<const TClassType*>(ptr));
+            return dest.Write(&value, sizeof(value)) == sizeof(value);
+        }
+        else if constexpr (IsBoolValue)
+            return dest.WriteBool(getFunction_(*static_cast<const TClassType*>(ptr)));
+        else
+            return false;
+    }
+
+    /// Read the attribute in binary form.
+    bool ReadBinary(Serializable* ptr, Deserializer& source) override
+    {
+        assert(ptr);
+        if constexpr (IsBinaryValue)
+        {
+            T value{};
+            if (source.Read(&value, sizeof(value)) != sizeof(value))
+                return false;
+            setFunction_(*static_cast<TClassType*>(ptr), value);
+            return true;
+        }
+        else if constexpr (IsBoolValue)
+        {
+            setFunction_(*static_cast<TClassType*>(ptr), source.ReadBool());
+            return true;
+        }
+        else
+            return false;
+    }
+
+private:
+    /// Type returned by getter function.
+    using GetResultType = ea::decay_t<decltype(ea::declval<TGetFunction>()(ea::declval<const TClassType&>()))>;
+    /// Whether the value is written as memory block. Getter should return exact type to match Variant binary data.
+    static constexpr bool IsBinaryValue = IsBinaryBlockAttribute<T>::value && ea::is_same_v<GetResultType, T>;
+    /// Whether the value is boolean.
+    static constexpr bool IsBoolValue = ea::is_same_v<T, bool> && ea::is_same_v<GetResultType, bool>;
+
+    /// Get functor.
+    TGetFunction getFunction_;
+    /// Set functor.
+    TSetFunction setFunction_;
+};
+
+/// Make typed attribute accessor implementation.
+/// \tparam TClassType Serializable class type.
+/// \tparam T Attribute value type.
+/// \tparam TGetFunction Functional object with call signature `T getFunction(const TClassType& self)`
+/// \tparam TSetFunction Functional object with call signature `void setFunction(TClassType& self, const T& value)`
+template <class TClassType, class T, class TGetFunction, class TSetFunction>
+SharedPtr<AttributeAccessor> MakeTypedAttributeAccessor(TGetFunction getFunction, TSetFunction setFunction)
+{
+    return SharedPtr<AttributeAccessor>(new TypedAttributeAccessorImpl<TClassType, T, TGetFunction, TSetFunction>(getFunction, setFunction));
+}
+
 /// Make member attribute accessor.
-#define URHO3D_MAKE_MEMBER_ATTRIBUTE_ACCESSOR(typeName, variable) Urho3D::MakeVariantAttributeAccessor<ClassName>( \
-    [](const ClassName& self, Urho3D::Variant& value) { value = self.variable; }, \
-    [](ClassName& self, const Urho3D::Variant& value) { self.variable = value.Get<typeName>(); })
+#define URHO3D_MAKE_MEMBER_ATTRIBUTE_ACCESSOR(typeName, variable) Urho3D::MakeTypedAttributeAccessor<ClassName, typeName>( \
+    [](const ClassName& self) -> decltype(auto) { return (self.variable); }, \
+    [](ClassName& self, const typeName& value) { self.variable = value; })
 
 /// Make member attribute accessor with custom post-set callback.
-#define URHO3D_MAKE_MEMBER_ATTRIBUTE_ACCESSOR_EX(typeName, variable, postSetCallback) Urho3D::MakeVariantAttributeAccessor<ClassName>( \
-    [](const ClassName& self, Urho3D::Variant& value) { value = self.variable; }, \
-    [](ClassName& self, const Urho3D::Variant& value) { self.variable = value.Get<typeName>(); self.postSetCallback(); })
+#define URHO3D_MAKE_MEMBER_ATTRIBUTE_ACCESSOR_EX(typeName, variable, postSetCallback) Urho3D::MakeTypedAttributeAccessor<ClassName, typeName>( \
+    [](const ClassName& self) -> decltype(auto) { return (self.variable); }, \
+    [](ClassName& self, const typeName& value) { self.variable = value; self.postSetCallback(); })
 
 /// Make custom member attribute accessor.
 #define URHO3D_MAKE_CUSTOM_MEMBER_ATTRIBUTE_ACCESSOR(typeName, variable) Urho3D::MakeVariantAttributeAccessor<ClassName>( \
@@ -194,9 +308,9 @@ SharedPtr<AttributeAccessor> MakeVariantAttributeAccessor(TGetFunction getFuncti
     [](ClassName& self, const Urho3D::Variant& value) { self.variable = value.GetCustom<typeName>(); })
 
 /// Make get/set attribute accessor.
-#define URHO3D_MAKE_GET_SET_ATTRIBUTE_ACCESSOR(getFunction, setFunction, typeName) Urho3D::MakeVariantAttributeAccessor<ClassName>( \
-    [](const ClassName& self, Urho3D::Variant& value) { value = self.getFunction(); }, \
-    [](ClassName& self, const Urho3D::Variant& value) { self.setFunction(value.Get<typeName>()); })
+#define URHO3D_MAKE_GET_SET_ATTRIBUTE_ACCESSOR(getFunction, setFunction, typeName) Urho3D::MakeTypedAttributeAccessor<ClassName, typeName>( \
+    [](const ClassName& self) -> decltype(auto) { return self.getFunction(); }, \
+    [](ClassName& self, const typeName& value) { self.setFunction(value); })
 
 /// Make member enum attribute accessor.
 #define URHO3D_MAKE_MEMBER_ENUM_ATTRIBUTE_ACCESSOR(variable) Urho3D::MakeVariantAttributeAccessor<ClassName>( \
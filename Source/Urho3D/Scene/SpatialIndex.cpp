@@ -0,0 +1,413 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Scene/Node.h"
+#include "../Scene/Scene.h"
+#include "../Scene/SceneEvents.h"
+#include "../Scene/SpatialIndex.h"
+
+#include <EASTL/sort.h>
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+long long GetNumCellsInRange(const IntVector3& minCell, const IntVector3& maxCell)
+{
+    const IntVector3 size = maxCell - minCell + IntVector3::ONE;
+    return static_cast<long long>(size.x_) * size.y_ * size.z_;
+}
+
+bool IsCellInRange(const IntVector3& cell, const IntVector3& minCell, const IntVector3& maxCell)
+{
+    return cell.x_ >= minCell.x_ && cell.y_ >= minCell.y_ && cell.z_ >= minCell.z_
+        && cell.x_ <= maxCell.x_ && cell.y_ <= maxCell.y_ && cell.z_ <= maxCell.z_;
+}
+
+int GetChebyshevDistance(const IntVector3& lhs, const IntVector3& rhs)
+{
+    const IntVector3 delta = lhs - rhs;
+    return ea::max({Abs(delta.x_), Abs(delta.y_), Abs(delta.z_)});
+}
+
+}
+
+SpatialIndex::SpatialIndex(Context* context)
+    : TrackedComponentRegistryBase(context, SpatialIndexItem::GetTypeStatic())
+{
+}
+
+SpatialIndex::~SpatialIndex()
+{
+}
+
+void SpatialIndex::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<SpatialIndex>();
+
+    URHO3D_ACCESSOR_ATTRIBUTE("Cell Size", GetCellSize, SetCellSize, float, DefaultCellSize, AM_DEFAULT);
+}
+
+void SpatialIndex::SetCellSize(float cellSize)
+{
+    cellSize = ea::max(cellSize, M_EPSILON);
+    if (cellSize_ != cellSize)
+    {
+        cellSize_ = cellSize;
+        RebuildCells();
+    }
+}
+
+void SpatialIndex::Update()
+{
+    URHO3D_PROFILE("UpdateSpatialIndex");
+
+    for (SpatialIndexItem* item : dirtyItems_)
+    {
+        item->dirty_ = false;
+
+        Node* node = item->GetNode();
+        const Vector3 worldScale = node->GetWorldScale();
+        const float maxScale = ea::max({Abs(worldScale.x_), Abs(worldScale.y_), Abs(worldScale.z_)});
+
+        item->indexedPosition_ = node->GetWorldPosition();
+        item->indexedRadius_ = item->radius_ * maxScale;
+        maxRadius_ = ea::max(maxRadius_, item->indexedRadius_);
+
+        const IntVector3 cell = GetCell(item->indexedPosition_);
+        if (!item->inCell_ || item->cell_ != cell)
+        {
+            RemoveItem(item);
+            InsertItem(item);
+        }
+    }
+    dirtyItems_.clear();
+}
+
+void SpatialIndex::QueryRadius(
+    ea::vector<SpatialIndexItem*>& result, const Vector3& center, float radius, unsigned layerMask) const
+{
+    result.clear();
+
+    const Vector3 padding = Vector3::ONE * (radius + maxRadius_);
+    const IntVector3 minCell = GetCell(center - padding);
+    const IntVector3 maxCell = GetCell(center + padding);
+    ForEachCell(minCell, maxCell, [&](const CellItems& items)
+    {
+        for (SpatialIndexItem* item : items)
+        {
+            if (!(item->layerMask_ & layerMask))
+                continue;
+
+            const float maxDistance = radius + item->indexedRadius_;
+            if ((item->indexedPosition_ - center).LengthSquared() <= maxDistance * maxDistance)
+                result.push_back(item);
+        }
+    });
+}
+
+void SpatialIndex::QueryBox(ea::vector<SpatialIndexItem*>& result, const BoundingBox& box, unsigned layerMask) const
+{
+    result.clear();
+    if (!box.Defined())
+        return;
+
+    const Vector3 padding = Vector3::ONE * maxRadius_;
+    const IntVector3 minCell = GetCell(box.min_ - padding);
+    const IntVector3 maxCell = GetCell(box.max_ + padding);
+    ForEachCell(minCell, maxCell, [&](const CellItems& items)
+    {
+        for (SpatialIndexItem* item : items)
+        {
+            if (!(item->layerMask_ & layerMask))
+                continue;
+
+            if (box.DistanceToPoint(item->indexedPosition_) <= item->indexedRadius_)
+                result.push_back(item);
+        }
+    });
+}
+
+void SpatialIndex::QueryNearest(ea::vector<SpatialIndexItem*>& result, const Vector3& position, unsigned count,
+    float maxDistance, unsigned layerMask) const
+{
+    result.clear();
+    if (count == 0 || cells_.empty())
+        return;
+
+    const float maxDistanceSquared = maxDistance * maxDistance;
+    ea::vector<ea::pair<float, SpatialIndexItem*>> candidates;
+    const auto addCandidates = [&](const CellItems& items)
+    {
+        for (SpatialIndexItem* item : items)
+        {
+            if (!(item->layerMask_ & layerMask))
+                continue;
+
+            const float distanceSquared = (item->indexedPosition_ - position).LengthSquared();
+            if (distanceSquared <= maxDistanceSquared)
+                candidates.emplace_back(distanceSquared, item);
+        }
+    };
+
+    // Visit shells of cells around the position until remaining cells cannot contain closer items
+    const IntVector3 centerCell = GetCell(position);
+    const int maxRing = ea::max(GetChebyshevDistance(centerCell, minOccupiedCell_),
+        GetChebyshevDistance(centerCell, maxOccupiedCell_));
+    for (int ring = 0; ring <= maxRing; ++ring)
+    {
+        const float ringDistance = ea::max(0, ring - 1) * cellSize_;
+        if (ringDistance > maxDistance)
+            break;
+
+        // If shell is bigger than the whole grid, visit all remaining cells at once
+        const IntVector3 minCell = VectorMax(centerCell - IntVector3::ONE * ring, minOccupiedCell_);
+        const IntVector3 maxCell = VectorMin(centerCell + IntVector3::ONE * ring, maxOccupiedCell_);
+        if (GetNumCellsInRange(minCell, maxCell) > static_cast<long long>(cells_.size()))
+        {
+            for (const auto& [cell, items] : cells_)
+            {
+                if (GetChebyshevDistance(cell, centerCell) >= ring)
+                    addCandidates(items);
+            }
+            break;
+        }
+
+        for (int z = minCell.z_; z <= maxCell.z_; ++z)
+        {
+            for (int y = minCell.y_; y <= maxCell.y_; ++y)
+            {
+                const bool isShellFace = Abs(z - centerCell.z_) == ring || Abs(y - centerCell.y_) == ring;
+                const int step = isShellFace ? 1 : ea::max(1, 2 * ring);
+                for (int x = centerCell.x_ - ring; x <= centerCell.x_ + ring; x += step)
+                {
+                    if (x < minCell.x_ || x > maxCell.x_)
+                        continue;
+
+                    const auto iter = cells_.find(IntVector3{x, y, z});
+                    if (iter != cells_.end())
+                        addCandidates(iter->second);
+                }
+            }
+        }
+
+        // Items in the next rings are at least this far from the position
+        const float nextRingDistance = ring * cellSize_;
+        if (candidates.size() >= count)
+        {
+            ea::nth_element(candidates.begin(), candidates.begin() + (count - 1), candidates.end());
+            if (candidates[count - 1].first <= nextRingDistance * nextRingDistance)
+                break;
+        }
+    }
+
+    const unsigned numResults = ea::min(count, candidates.size());
+    ea::partial_sort(candidates.begin(), candidates.begin() + numResults, candidates.end());
+    for (unsigned i = 0; i < numResults; ++i)
+        result.push_back(candidates[i].second);
+}
+
+void SpatialIndex::MarkItemDirty(SpatialIndexItem* item)
+{
+    if (!item->dirty_)
+    {
+        item->dirty_ = true;
+        dirtyItems_.push_back(item);
+    }
+}
+
+void SpatialIndex::OnSceneSet(Scene* scene)
+{
+    TrackedComponentRegistryBase::OnSceneSet(scene);
+
+    if (scene)
+        SubscribeToEvent(scene, E_SCENEPOSTUPDATE, [this](StringHash, VariantMap&) { Update(); });
+    else
+        UnsubscribeFromEvent(E_SCENEPOSTUPDATE);
+}
+
+void SpatialIndex::OnComponentAdded(TrackedComponentBase* baseComponent)
+{
+    auto item = static_cast<SpatialIndexItem*>(baseComponent);
+    MarkItemDirty(item);
+}
+
+void SpatialIndex::OnComponentRemoved(TrackedComponentBase* baseComponent)
+{
+    auto item = static_cast<SpatialIndexItem*>(baseComponent);
+    RemoveItem(item);
+
+    if (item->dirty_)
+    {
+        item->dirty_ = false;
+        dirtyItems_.erase(ea::find(dirtyItems_.begin(), dirtyItems_.end(), item));
+    }
+}
+
+IntVector3 SpatialIndex::GetCell(const Vector3& position) const
+{
+    return VectorFloorToInt(position / cellSize_);
+}
+
+void SpatialIndex::InsertItem(SpatialIndexItem* item)
+{
+    const IntVector3 cell = GetCell(item->indexedPosition_);
+    if (cells_.empty())
+    {
+        minOccupiedCell_ = cell;
+        maxOccupiedCell_ = cell;
+    }
+    else
+    {
+        minOccupiedCell_ = VectorMin(minOccupiedCell_, cell);
+        maxOccupiedCell_ = VectorMax(maxOccupiedCell_, cell);
+    }
+
+    cells_[cell].push_back(item);
+    item->cell_ = cell;
+    item->inCell_ = true;
+}
+
+void SpatialIndex::RemoveItem(SpatialIndexItem* item)
+{
+    if (!item->inCell_)
+        return;
+
+    item->inCell_ = false;
+    const auto iter = cells_.find(item->cell_);
+    if (iter == cells_.end())
+    {
+        URHO3D_ASSERTLOG(0, "SpatialIndex is corrupted");
+        return;
+    }
+
+    CellItems& items = iter->second;
+    items.erase_first_unsorted(item);
+    if (items.empty())
+        cells_.erase(iter);
+}
+
+void SpatialIndex::RebuildCells()
+{
+    cells_.clear();
+    maxRadius_ = 0.0f;
+    for (TrackedComponentBase* baseComponent : GetTrackedComponents())
+    {
+        auto item = static_cast<SpatialIndexItem*>(baseComponent);
+        item->inCell_ = false;
+        MarkItemDirty(item);
+    }
+}
+
+template <class T>
+void SpatialIndex::ForEachCell(const IntVector3& minCell, const IntVector3& maxCell, const T& callback) const
+{
+    if (cells_.empty())
+        return;
+
+    const IntVector3 clampedMinCell = VectorMax(minCell, minOccupiedCell_);
+    const IntVector3 clampedMaxCell = VectorMin(maxCell, maxOccupiedCell_);
+    if (clampedMinCell.x_ > clampedMaxCell.x_ || clampedMinCell.y_ > clampedMaxCell.y_
+        || clampedMinCell.z_ > clampedMaxCell.z_)
+        return;
+
+    // Iterate over all cells if the range is too big
+    if (GetNumCellsInRange(clampedMinCell, clampedMaxCell) > static_cast<long long>(cells_.size()))
+    {
+        for (const auto& [cell, items] : cells_)
+        {
+            if (IsCellInRange(cell, clampedMinCell, clampedMaxCell))
+                callback(items);
+        }
+        return;
+    }
+
+    for (int z = clampedMinCell.z_; z <= clampedMaxCell.z_; ++z)
+    {
+        for (int y = clampedMinCell.y_; y <= clampedMaxCell.y_; ++y)
+        {
+            for (int x = clampedMinCell.x_; x <= clampedMaxCell.x_; ++x)
+            {
+                const auto iter = cells_.find(IntVector3{x, y, z});
+                if (iter != cells_.end())
+                    callback(iter->second);
+            }
+        }
+    }
+}
+
+SpatialIndexItem::SpatialIndexItem(Context* context)
+    : TrackedComponent<TrackedComponentBase, SpatialIndex>(context)
+{
+}
+
+SpatialIndexItem::~SpatialIndexItem()
+{
+}
+
+void SpatialIndexItem::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<SpatialIndexItem>(Category_Scene);
+
+    URHO3D_ACCESSOR_ATTRIBUTE("Is Enabled", IsEnabled, SetEnabled, bool, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Radius", GetRadius, SetRadius, float, 0.0f, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Layer Mask", GetLayerMask, SetLayerMask, unsigned, M_MAX_UNSIGNED, AM_DEFAULT);
+}
+
+void SpatialIndexItem::SetRadius(float radius)
+{
+    radius = ea::max(radius, 0.0f);
+    if (radius_ != radius)
+    {
+        radius_ = radius;
+        MarkDirty();
+    }
+}
+
+void SpatialIndexItem::OnNodeSet(Node* previousNode, Node* currentNode)
+{
+    if (node_)
+        node_->AddListener(this);
+}
+
+void SpatialIndexItem::OnMarkedDirty(Node* node)
+{
+    MarkDirty();
+}
+
+void SpatialIndexItem::MarkDirty()
+{
+    if (IsTrackedInRegistry())
+    {
+        if (SpatialIndex* spatialIndex = GetRegistry())
+            spatialIndex->MarkItemDirty(this);
+    }
+}
+
+}
@@ -0,0 +1,148 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Math/BoundingBox.h"
+#include "../Scene/TrackedComponent.h"
+
+#include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class SpatialIndexItem;
+
+/// Scene-wide spatial index of nodes marked with SpatialIndexItem.
+/// Unlike Octree, it's not limited to drawables and can be used for gameplay, AI or interest management queries.
+/// Items are binned into loose grid by their centers, queries are expanded by the max item radius.
+/// Index is updated on scene post-update or on explicit Update call. Queries reflect the state at the last update.
+/// Queries are read-only and may be executed from multiple threads simultaneously between updates.
+class URHO3D_API SpatialIndex : public TrackedComponentRegistryBase
+{
+    URHO3D_OBJECT(SpatialIndex, TrackedComponentRegistryBase);
+
+public:
+    static constexpr bool IsOnlyEnabledTracked = true;
+    static constexpr float DefaultCellSize = 16.0f;
+
+    explicit SpatialIndex(Context* context);
+    ~SpatialIndex() override;
+    static void RegisterObject(Context* context);
+
+    /// Set size of grid cell. Should be comparable with typical query radius.
+    void SetCellSize(float cellSize);
+    float GetCellSize() const { return cellSize_; }
+
+    /// Update positions of moved items. Usually called internally once per frame.
+    void Update();
+
+    /// Return items with bounding spheres intersecting the sphere.
+    void QueryRadius(ea::vector<SpatialIndexItem*>& result, const Vector3& center, float radius,
+        unsigned layerMask = M_MAX_UNSIGNED) const;
+    /// Return items with bounding spheres intersecting the box.
+    void QueryBox(ea::vector<SpatialIndexItem*>& result, const BoundingBox& box,
+        unsigned layerMask = M_MAX_UNSIGNED) const;
+    /// Return up to count items nearest to the position, sorted by distance between position and item center.
+    void QueryNearest(ea::vector<SpatialIndexItem*>& result, const Vector3& position, unsigned count,
+        float maxDistance = M_LARGE_VALUE, unsigned layerMask = M_MAX_UNSIGNED) const;
+
+    /// Return number of non-empty grid cells.
+    unsigned GetNumCells() const { return cells_.size(); }
+
+    /// Internal. Mark item as moved or resized.
+    void MarkItemDirty(SpatialIndexItem* item);
+
+protected:
+    void OnSceneSet(Scene* scene) override;
+    void OnComponentAdded(TrackedComponentBase* baseComponent) override;
+    void OnComponentRemoved(TrackedComponentBase* baseComponent) override;
+
+private:
+    using CellItems = ea::vector<SpatialIndexItem*>;
+
+    IntVector3 GetCell(const Vector3& position) const;
+    void InsertItem(SpatialIndexItem* item);
+    void RemoveItem(SpatialIndexItem* item);
+    void RebuildCells();
+    /// Call callback for each non-empty cell overlapping the range of cells.
+    template <class T> void ForEachCell(const IntVector3& minCell, const IntVector3& maxCell, const T& callback) const;
+
+    float cellSize_{DefaultCellSize};
+    /// Max radius of items added since the last rebuild.
+    float maxRadius_{};
+    /// Range of cells that have ever been occupied since the last rebuild.
+    IntVector3 minOccupiedCell_;
+    IntVector3 maxOccupiedCell_;
+
+    ea::unordered_map<IntVector3, CellItems> cells_;
+    ea::vector<SpatialIndexItem*> dirtyItems_;
+};
+
+/// Marks node to be indexed by SpatialIndex of the scene.
+class URHO3D_API SpatialIndexItem : public TrackedComponent<TrackedComponentBase, SpatialIndex>
+{
+    URHO3D_OBJECT(SpatialIndexItem, TrackedComponentBase);
+
+public:
+    explicit SpatialIndexItem(Context* context);
+    ~SpatialIndexItem() override;
+    static void RegisterObject(Context* context);
+
+    /// Manage properties.
+    /// @{
+    void SetRadius(float radius);
+    float GetRadius() const { return radius_; }
+    void SetLayerMask(unsigned layerMask) { layerMask_ = layerMask; }
+    unsigned GetLayerMask() const { return layerMask_; }
+    /// @}
+
+    /// Return world position and radius at the last update of the index.
+    /// @{
+    const Vector3& GetIndexedPosition() const { return indexedPosition_; }
+    float GetIndexedRadius() const { return indexedRadius_; }
+    /// @}
+
+protected:
+    void OnNodeSet(Node* previousNode, Node* currentNode) override;
+    void OnMarkedDirty(Node* node) override;
+
+private:
+    friend class SpatialIndex;
+
+    void MarkDirty();
+
+    float radius_{};
+    unsigned layerMask_{M_MAX_UNSIGNED};
+
+    /// Spatial index state.
+    /// @{
+    Vector3 indexedPosition_;
+    float indexedRadius_{};
+    IntVector3 cell_;
+    bool inCell_{};
+    bool dirty_{};
+    /// @}
+};
+
+}
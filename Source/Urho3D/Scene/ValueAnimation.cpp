@@ -247,6 +247,7 @@ void ValueAnimation::SetValueType(VariantType valueType)
     eventFrames_.clear();
     beginTime_ = M_INFINITY;
     endTime_ = -M_INFINITY;
+    UpdatePackedKeyFrames();
 }
 
 void ValueAnimation::SetOwner(void* owner)
@@ -265,12 +266,14 @@ void ValueAnimation::SetInterpolationMethod(InterpMethod method)
 
     interpolationMethod_ = method;
     splineTangentsDirty_ = true;
+    UpdatePackedKeyFrames();
 }
 
 void ValueAnimation::SetSplineTension(float tension)
 {
     splineTension_ = tension;
     splineTangentsDirty_ = true;
+    UpdatePackedKeyFrames();
 }
 
 bool ValueAnimation::SetKeyFrame(float time, const Variant& value)
@@ -304,6 +307,7 @@ bool ValueAnimation::SetKeyFrame(float time, const Variant& value)
     beginTime_ = Min(time, beginTime_);
     endTime_ = Max(time, endTime_);
     splineTangentsDirty_ = true;
+    UpdatePackedKeyFrames();
 
     return true;
 }
@@ -342,13 +346,20 @@ bool ValueAnimation::IsValid() const
 
 Variant ValueAnimation::GetAnimationValue(float scaledTime) const
 {
-    unsigned index = 1;
-    for (; index < keyFrames_.size(); ++index)
+    if (HasPackedValues())
     {
-        if (scaledTime < keyFrames_[index].time_)
-            break;
+        const Vector4 value = GetPackedAnimationValue(scaledTime);
+        switch (valueType_)
+        {
+        case VAR_FLOAT: return value.x_;
+        case VAR_VECTOR2: return Vector2(value.x_, value.y_);
+        case VAR_VECTOR3: return Vector3(value.x_, value.y_, value.z_);
+        case VAR_COLOR: return Color(value.x_, value.y_, value.z_, value.w_);
+        default: return value;
+        }
     }
 
+    const unsigned index = FindNextKeyFrame(scaledTime);
     if (index >= keyFrames_.size() || !interpolatable_ || interpolationMethod_ == IM_NONE)
         return keyFrames_[index - 1].value_;
     else
@@ -360,6 +371,30 @@ Variant ValueAnimation::GetAnimationValue(float scaledTime) const
     }
 }
 
+Vector4 ValueAnimation::GetPackedAnimationValue(float scaledTime) const
+{
+    const unsigned index = FindNextKeyFrame(scaledTime);
+    if (index >= packedKeyFrameValues_.size() || interpolationMethod_ == IM_NONE)
+        return packedKeyFrameValues_[index - 1];
+
+    const float time1 = keyFrameTimes_[index - 1];
+    const float time2 = keyFrameTimes_[index];
+    const float t = (scaledTime - time1) / (time2 - time1);
+    const Vector4& value1 = packedKeyFrameValues_[index - 1];
+    const Vector4& value2 = packedKeyFrameValues_[index];
+
+    if (interpolationMethod_ == IM_LINEAR || packedSplineTangents_.empty())
+        return value1.Lerp(value2, t);
+
+    const float tt = t * t;
+    const float ttt = t * tt;
+    const float h1 = 2.0f * ttt - 3.0f * tt + 1.0f;
+    const float h2 = -2.0f * ttt + 3.0f * tt;
+    const float h3 = ttt - 2.0f * tt + t;
+    const float h4 = ttt - tt;
+    return value1 * h1 + value2 * h2 + packedSplineTangents_[index - 1] * h3 + packedSplineTangents_[index] * h4;
+}
+
 void ValueAnimation::GetEventFrames(float beginTime, float endTime, ea::vector<const VAnimEventFrame*>& eventFrames) const
 {
     for (unsigned i = 0; i < eventFrames_.size(); ++i)
@@ -512,6 +547,61 @@ void ValueAnimation::UpdateSplineTangents() const
     splineTangentsDirty_ = false;
 }
 
+unsigned ValueAnimation::FindNextKeyFrame(float scaledTime) const
+{
+    if (keyFrameTimes_.size() <= 1)
+        return 1;
+
+    const auto iter = ea::upper_bound(keyFrameTimes_.begin() + 1, keyFrameTimes_.end(), scaledTime);
+    return static_cast<unsigned>(iter - keyFrameTimes_.begin());
+}
+
+void ValueAnimation::UpdatePackedKeyFrames()
+{
+    const unsigned size = keyFrames_.size();
+    keyFrameTimes_.resize(size);
+    for (unsigned i = 0; i < size; ++i)
+        keyFrameTimes_[i] = keyFrames_[i].time_;
+
+    packedKeyFrameValues_.clear();
+    packedSplineTangents_.clear();
+
+    const bool isPackable = valueType_ == VAR_FLOAT || valueType_ == VAR_VECTOR2 || valueType_ == VAR_VECTOR3
+        || valueType_ == VAR_VECTOR4 || valueType_ == VAR_COLOR;
+    if (!isPackable || size == 0)
+        return;
+
+    packedKeyFrameValues_.resize(size);
+    for (unsigned i = 0; i < size; ++i)
+    {
+        const Variant& value = keyFrames_[i].value_;
+        switch (valueType_)
+        {
+        case VAR_FLOAT: packedKeyFrameValues_[i] = Vector4(value.GetFloat(), 0.0f, 0.0f, 0.0f); break;
+        case VAR_VECTOR2: packedKeyFrameValues_[i] = value.GetVector2().ToVector4(); break;
+        case VAR_VECTOR3: packedKeyFrameValues_[i] = value.GetVector3().ToVector4(); break;
+        case VAR_VECTOR4: packedKeyFrameValues_[i] = value.GetVector4(); break;
+        case VAR_COLOR: packedKeyFrameValues_[i] = value.GetColor().ToVector4(); break;
+        default: break;
+        }
+    }
+
+    // Same as UpdateSplineTangents
+    if (interpolationMethod_ != IM_SPLINE || size <= 2)
+        return;
+
+    packedSplineTangents_.resize(size);
+    for (unsigned i = 1; i < size - 1; ++i)
+        packedSplineTangents_[i] = (packedKeyFrameValues_[i + 1] - packedKeyFrameValues_[i - 1]) * splineTension_;
+
+    // If spline is not closed, make end point's tangent zero
+    if (keyFrames_[0].value_ != keyFrames_[size - 1].value_)
+        packedSplineTangents_[0] = packedSplineTangents_[size - 1] = Vector4::ZERO;
+    else
+        packedSplineTangents_[0] = packedSplineTangents_[size - 1] =
+            (packedKeyFrameValues_[1] - packedKeyFrameValues_[size - 2]) * splineTension_;
+}
+
 Variant ValueAnimation::SubstractAndMultiply(const Variant& value1, const Variant& value2, float t) const
 {
     switch (valueType_)
@@ -136,6 +136,11 @@ public:
 
     /// Return animation value.
     Variant GetAnimationValue(float scaledTime) const;
+    /// Return whether the values are stored packed, i.e. value type is float, vector or color.
+    bool HasPackedValues() const { return !packedKeyFrameValues_.empty(); }
+    /// Return animation value packed into Vector4. Faster than GetAnimationValue and safe to call from any thread.
+    /// Should be called only if HasPackedValues is true.
+    Vector4 GetPackedAnimationValue(float scaledTime) const;
 
     /// Return all key frames.
     const ea::vector<VAnimKeyFrame>& GetKeyFrames() const { return keyFrames_; }
@@ -155,6 +160,10 @@ protected:
     void UpdateSplineTangents() const;
     /// Return (value1 - value2) * t.
     Variant SubstractAndMultiply(const Variant& value1, const Variant& value2, float t) const;
+    /// Return index of the first key frame after the time, or the number of key frames. Never returns 0.
+    unsigned FindNextKeyFrame(float scaledTime) const;
+    /// Update key frame times and packed values.
+    void UpdatePackedKeyFrames();
 
     /// Owner.
     void* owner_;
@@ -178,6 +187,12 @@ protected:
     mutable bool splineTangentsDirty_;
     /// Event frames.
     ea::vector<VAnimEventFrame> eventFrames_;
+    /// Times of key frames, stored contiguously for fast lookup.
+    ea::vector<float> keyFrameTimes_;
+    /// Values of key frames packed into Vector4, if value type is float, vector or color.
+    ea::vector<Vector4> packedKeyFrameValues_;
+    /// Spline tangents of packed values.
+    ea::vector<Vector4> packedSplineTangents_;
 };
 
 }
@@ -29,6 +29,7 @@
 #include "../Core/CoreEvents.h"
 #include "../Core/Profiler.h"
 #include "../Engine/Engine.h"
+#include "../Graphics/GPUProfiler.h"
 #include "../Graphics/Graphics.h"
 #include "../Graphics/GraphicsEvents.h"
 #include "../Graphics/Renderer.h"
@@ -76,6 +77,14 @@ DebugHud::~DebugHud()
 void DebugHud::SetMode(DebugHudModeFlags mode)
 {
     mode_ = mode;
+
+    // GPU timestamps have a cost, so only collect them while they are shown
+    if (auto gpuProfiler = GetSubsystem<GPUProfiler>())
+    {
+        const bool showGpu = !!(mode_ & DEBUGHUD_SHOW_GPU);
+        if (showGpu != gpuProfiler->IsEnabled() && (!showGpu || gpuProfiler->IsSupported()))
+            gpuProfiler->SetEnabled(showGpu);
+    }
 }
 
 void DebugHud::CycleMode()
@@ -149,6 +158,14 @@ void DebugHud::RenderUI(DebugHudModeFlags mode)
             fps_ = static_cast<unsigned int>(Round(context_->GetSubsystem<Time>()->GetFramesPerSecond()));
             ea::swap(numChangedAnimations_[0], numChangedAnimations_[1]);
             numChangedAnimations_[1] = 0;
+
+            const unsigned elapsedMs = Max(fpsTimer_.GetMSec(false), 1u);
+            for (unsigned i = 0; i < static_cast<unsigned>(MemoryTag::Count); ++i)
+            {
+                const MemoryTagStats memoryStats = GetMemoryTagStats(static_cast<MemoryTag>(i));
+                allocationsPerSecond_[i] = (memoryStats.totalAllocations_ - lastTotalAllocations_[i]) * 1000 / elapsedMs;
+                lastTotalAllocations_[i] = memoryStats.totalAllocations_;
+            }
             fpsTimer_.Reset();
         }
 
@@ -184,6 +201,23 @@ void DebugHud::RenderUI(DebugHudModeFlags mode)
         ui::SetCursorPosX(left_offset);
         ui::Text("Animations %u(%u)", stats.animations_, numChangedAnimations_[0]);
         ui::SetCursorPosX(left_offset);
+        if (renderer->GetAnimationLodSettings().enabled_)
+        {
+            ui::Text("Animation LOD x%u", stats.animationLodRateScale_);
+            ui::SetCursorPosX(left_offset);
+        }
+
+        for (unsigned i = 0; i < static_cast<unsigned>(MemoryTag::Count); ++i)
+        {
+            const auto tag = static_cast<MemoryTag>(i);
+            const MemoryTagStats memoryStats = GetMemoryTagStats(tag);
+            if (memoryStats.numAllocations_ == 0 && allocationsPerSecond_[i] == 0)
+                continue;
+
+            ui::Text("Memory %s %.1f KB (%llu allocs/s)", GetMemoryTagName(tag), memoryStats.bytes_ / 1024.0,
+                allocationsPerSecond_[i]);
+            ui::SetCursorPosX(left_offset);
+        }
 
         for (auto i = appStats_.begin(); i != appStats_.end(); ++i)
         {
@@ -192,6 +226,20 @@ void DebugHud::RenderUI(DebugHudModeFlags mode)
         }
     }
 
+    auto gpuProfiler = GetSubsystem<GPUProfiler>();
+    if ((mode & DEBUGHUD_SHOW_GPU) && gpuProfiler && gpuProfiler->IsEnabled())
+    {
+        const float left_offset = ui::GetCursorPos().x;
+
+        ui::Text("GPU %.2f ms", gpuProfiler->GetFrameTime());
+        for (const GPUProfilerZone& zone : gpuProfiler->GetZones())
+        {
+            ui::SetCursorPosX(left_offset + (zone.depth_ + 1) * ui::GetStyle().IndentSpacing);
+            ui::Text("%s %.2f ms", zone.name_.GetString().c_str(), zone.duration_);
+        }
+        ui::SetCursorPosX(left_offset);
+    }
+
     if (mode & DEBUGHUD_SHOW_MODE)
     {
         const ImGuiStyle& style = ui::GetStyle();
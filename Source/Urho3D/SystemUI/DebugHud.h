@@ -24,6 +24,7 @@
 #pragma once
 
 #include "../Container/FlagSet.h"
+#include "../Container/TaggedAllocator.h"
 #include "../Core/Object.h"
 #include "../Core/Timer.h"
 #include "../SystemUI/SystemUI.h"
@@ -38,6 +39,7 @@ enum DebugHudMode : unsigned
     DEBUGHUD_SHOW_NONE = 0x0,
     DEBUGHUD_SHOW_STATS = 0x1,
     DEBUGHUD_SHOW_MODE = 0x2,
+    DEBUGHUD_SHOW_GPU = 0x4,
     DEBUGHUD_SHOW_ALL = 0x7,
 };
 URHO3D_FLAGSET(DebugHudMode, DebugHudModeFlags);
@@ -101,6 +103,9 @@ private:
     /// Calculated fps
     unsigned fps_ = 0;
     unsigned numChangedAnimations_[2]{};
+    /// Tracked allocations per second and total allocations as of last update, per memory tag.
+    unsigned long long allocationsPerSecond_[static_cast<unsigned>(MemoryTag::Count)]{};
+    unsigned long long lastTotalAllocations_[static_cast<unsigned>(MemoryTag::Count)]{};
 };
 
 }
@@ -36,6 +36,9 @@ namespace Urho3D
 namespace
 {
 
+/// ID of tree node item. Doesn't depend on the title so the open state can be queried without rendering.
+const char* treeNodeId = "##Item";
+
 unsigned GetObjectIndexInParent(Node* parentNode, Node* node)
 {
     return parentNode->GetChildIndex(node);
@@ -141,6 +144,9 @@ void SceneHierarchyWidget::RenderContent(Scene* scene, SceneSelection& selection
 
     BeginRangeSelection();
 
+    // Range selection and scrolling to the active object need every item to be submitted
+    canCullItems_ = rowHeight_ > 0.0f && !scrollToActiveObject_ && !rangeSelection_.currentRequest_;
+
     const ImGuiStyle& style = ui::GetStyle();
     ui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(style.ItemSpacing.x, 0));
     if (search_.lastQuery_.empty())
@@ -166,6 +172,9 @@ void SceneHierarchyWidget::RenderContent(Scene* scene, SceneSelection& selection
     // Suppress future updates if selection was changed by the widget
     lastActiveObject_ = selection.GetActiveObject();
 
+    // Don't keep looking for the active object if it's not shown
+    scrollToActiveObject_ = false;
+
     // Reset flag just in case
     if (ignoreNextMouseRelease_ && ui::IsMouseReleased(MOUSEB_LEFT))
         ignoreNextMouseRelease_ = false;
@@ -176,8 +185,6 @@ void SceneHierarchyWidget::RenderNode(SceneSelection& selection, Node* node)
     if (!settings_.showTemporary_ && node->IsTemporary())
         return;
 
-    ProcessItemIfActive(selection, node);
-
     const bool isEmpty = node->GetChildren().empty() && (!settings_.showComponents_ || node->GetComponents().empty());
     ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow
         | ImGuiTreeNodeFlags_OpenOnDoubleClick
@@ -199,9 +206,24 @@ void SceneHierarchyWidget::RenderNode(SceneSelection& selection, Node* node)
         ui::SetNextItemOpen(true);
 
     const IdScopeGuard guard(static_cast<void*>(node));
+    if (IsItemCulled(selection, node))
+    {
+        const bool defaultOpen = !!(flags & ImGuiTreeNodeFlags_DefaultOpen);
+        if (!isEmpty && ui::GetStateStorage()->GetInt(ui::GetID(treeNodeId), defaultOpen) != 0)
+        {
+            ui::TreePush(treeNodeId);
+            RenderNodeChildren(selection, node);
+            ui::TreePop();
+        }
+        return;
+    }
+
+    ProcessItemIfActive(selection, node);
+
     ui::PushStyleColor(ImGuiCol_Text, GetItemColor(itemFlags));
-    const bool opened = ui::TreeNodeEx(GetNodeTitle(node).c_str(), flags);
+    const bool opened = ui::TreeNodeEx(treeNodeId, flags, "%s", GetNodeTitle(node).c_str());
     ui::PopStyleColor();
+    rowHeight_ = ui::GetItemRectSize().y;
     const bool toggleSelect = ui::IsKeyDown(KEY_CTRL);
     const bool rangeSelect = ui::IsKeyDown(KEY_SHIFT);
 
@@ -251,26 +273,40 @@ void SceneHierarchyWidget::RenderNode(SceneSelection& selection, Node* node)
 
     if (opened)
     {
-        if (settings_.showComponents_)
-        {
-            for (Component* component : node->GetComponents())
-                RenderComponent(selection, component);
-        }
-
-        for (Node* child : node->GetChildren())
-            RenderNode(selection, child);
-
+        RenderNodeChildren(selection, node);
         ui::TreePop();
     }
 }
 
+void SceneHierarchyWidget::RenderNodeChildren(SceneSelection& selection, Node* node)
+{
+    if (settings_.showComponents_)
+    {
+        for (Component* component : node->GetComponents())
+            RenderComponent(selection, component);
+    }
+
+    for (Node* child : node->GetChildren())
+        RenderNode(selection, child);
+}
+
+bool SceneHierarchyWidget::IsItemCulled(SceneSelection& selection, Object* object)
+{
+    if (!canCullItems_ || ui::IsRectVisible(ImVec2(1.0f, rowHeight_)))
+        return false;
+
+    // Reserve space of the row so the scroll area stays the same
+    if (selection.GetActiveObject() == object)
+        isActiveObjectVisible_ = true;
+    ui::Dummy(ImVec2(1.0f, rowHeight_));
+    return true;
+}
+
 void SceneHierarchyWidget::RenderComponent(SceneSelection& selection, Component* component)
 {
     if (component->IsTemporary() && !settings_.showTemporary_)
         return;
 
-    ProcessItemIfActive(selection, component);
-
     ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow
         | ImGuiTreeNodeFlags_OpenOnDoubleClick
         | ImGuiTreeNodeFlags_SpanAvailWidth
@@ -285,8 +321,13 @@ void SceneHierarchyWidget::RenderComponent(SceneSelection& selection, Component*
         itemFlags |= HierarchyItemFlag::Enabled;
 
     const IdScopeGuard guard(static_cast<void*>(component));
+    if (IsItemCulled(selection, component))
+        return;
+
+    ProcessItemIfActive(selection, component);
+
     ui::PushStyleColor(ImGuiCol_Text, GetItemColor(itemFlags));
-    const bool opened = ui::TreeNodeEx(component->GetTypeName().c_str(), flags);
+    const bool opened = ui::TreeNodeEx(treeNodeId, flags, "%s", component->GetTypeName().c_str());
     ui::PopStyleColor();
     const bool toggleSelect = ui::IsKeyDown(KEY_CTRL);
     const bool rangeSelect = ui::IsKeyDown(KEY_SHIFT);
@@ -55,7 +55,10 @@ public:
 
 private:
     void RenderNode(SceneSelection& selection, Node* node);
+    void RenderNodeChildren(SceneSelection& selection, Node* node);
     void RenderComponent(SceneSelection& selection, Component* component);
+    /// Skip rendering of the item if it's outside of the visible area. Space of the row is reserved.
+    bool IsItemCulled(SceneSelection& selection, Object* object);
     void ApplyPendingUpdates(Scene* scene);
 
     void ProcessObjectSelected(SceneSelection& selection, Object* object, bool toggle, bool range);
@@ -109,6 +112,10 @@ private:
 
     bool ignoreNextMouseRelease_{};
 
+    /// Height of single row, measured from the last rendered item.
+    float rowHeight_{};
+    bool canCullItems_{};
+
     bool scrollToActiveObject_{};
     Object* lastActiveObject_{};
     ea::vector<Node*> pathToActiveObject_;
@@ -22,6 +22,7 @@
 
 #include "../Precompiled.h"
 
+#include "../Container/Hash.h"
 #include "../Core/Context.h"
 #include "../IO/Log.h"
 #include "../Graphics/Texture2D.h"
@@ -34,6 +35,24 @@
 namespace Urho3D
 {
 
+namespace
+{
+
+/// Max number of cached text layouts per font face.
+const unsigned MAX_TEXT_LAYOUTS = 256;
+/// Max length of text which is worth caching. Long texts are rarely repeated.
+const unsigned MAX_TEXT_LAYOUT_LENGTH = 256;
+
+unsigned GetTextLayoutHash(const ea::vector<unsigned>& text, int wrapWidth)
+{
+    unsigned hash = static_cast<unsigned>(wrapWidth);
+    for (unsigned c : text)
+        CombineHash(hash, c);
+    return hash;
+}
+
+}
+
 FontFace::FontFace(Font* font) :
     font_(font)
 {
@@ -64,6 +83,40 @@ const FontGlyph* FontFace::GetGlyph(unsigned c)
         return nullptr;
 }
 
+const FontTextLayout* FontFace::GetTextLayout(const ea::vector<unsigned>& text, int wrapWidth)
+{
+    if (text.size() > MAX_TEXT_LAYOUT_LENGTH)
+        return nullptr;
+
+    const auto iter = textLayouts_.find(GetTextLayoutHash(text, wrapWidth));
+    if (iter == textLayouts_.end() || iter->second.wrapWidth_ != wrapWidth || iter->second.text_ != text)
+        return nullptr;
+
+    iter->second.lastUsed_ = ++textLayoutStamp_;
+    return &iter->second;
+}
+
+void FontFace::StoreTextLayout(FontTextLayout layout)
+{
+    if (layout.text_.size() > MAX_TEXT_LAYOUT_LENGTH)
+        return;
+
+    const unsigned hash = GetTextLayoutHash(layout.text_, layout.wrapWidth_);
+    if (textLayouts_.size() >= MAX_TEXT_LAYOUTS && !textLayouts_.contains(hash))
+    {
+        auto leastRecentlyUsed = textLayouts_.begin();
+        for (auto iter = textLayouts_.begin(); iter != textLayouts_.end(); ++iter)
+        {
+            if (iter->second.lastUsed_ < leastRecentlyUsed->second.lastUsed_)
+                leastRecentlyUsed = iter;
+        }
+        textLayouts_.erase(leastRecentlyUsed);
+    }
+
+    layout.lastUsed_ = ++textLayoutStamp_;
+    textLayouts_[hash] = ea::move(layout);
+}
+
 float FontFace::GetKerning(unsigned c, unsigned d) const
 {
     if (kerningMapping_.empty())
@@ -63,6 +63,25 @@ struct URHO3D_API FontGlyph
     bool used_{};
 };
 
+/// Cached layout of a text string, as split into rows by %Text.
+struct URHO3D_API FontTextLayout
+{
+    /// Source text.
+    ea::vector<unsigned> text_;
+    /// Word wrap width, negative if word wrap is disabled.
+    int wrapWidth_{};
+    /// Text to print, including inserted line breaks.
+    ea::vector<unsigned> printText_;
+    /// Mapping from printed characters to source characters.
+    ea::vector<unsigned> printToText_;
+    /// Row widths.
+    ea::vector<float> rowWidths_;
+    /// Width of the widest row.
+    int width_{};
+    /// Last use stamp for least recently used eviction.
+    unsigned lastUsed_{};
+};
+
 /// %Font face description.
 class URHO3D_API FontFace : public RefCounted
 {
@@ -87,6 +106,11 @@ public:
     /// Return true when one of the texture has a data loss.
     bool IsDataLost() const;
 
+    /// Return cached layout of the text with given word wrap width (negative if disabled), or null if not cached.
+    const FontTextLayout* GetTextLayout(const ea::vector<unsigned>& text, int wrapWidth);
+    /// Store layout of the text in the cache, evicting the least recently used layout if full.
+    void StoreTextLayout(FontTextLayout layout);
+
     /// Return point size.
     float GetPointSize() const { return pointSize_; }
 
@@ -115,6 +139,10 @@ protected:
     float pointSize_{};
     /// Row height.
     float rowHeight_{};
+    /// Cached text layouts keyed by text and wrap width hash.
+    ea::unordered_map<unsigned, FontTextLayout> textLayouts_;
+    /// Text layout use counter.
+    unsigned textLayoutStamp_{};
 };
 
 }
@@ -372,42 +372,50 @@ void Text::SetSelection(unsigned start, unsigned length)
     selectionStart_ = start;
     selectionLength_ = length;
     ValidateSelection();
+    MarkBatchesDirty();
 }
 
 void Text::ClearSelection()
 {
     selectionStart_ = 0;
     selectionLength_ = 0;
+    MarkBatchesDirty();
 }
 
 void Text::SetTextEffect(TextEffect textEffect)
 {
     textEffect_ = textEffect;
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectShadowOffset(const IntVector2& offset)
 {
     shadowOffset_ = offset;
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectStrokeThickness(int thickness)
 {
     strokeThickness_ = Abs(thickness);
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectRoundStroke(bool roundStroke)
 {
     roundStroke_ = roundStroke;
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectColor(const Color& effectColor)
 {
     effectColor_ = effectColor;
+    MarkBatchesDirty();
 }
 
 void Text::SetEffectDepthBias(float bias)
 {
     effectDepthBias_ = bias;
+    MarkBatchesDirty();
 }
 
 float Text::GetRowWidth(unsigned index) const
@@ -496,183 +504,206 @@ void Text::UpdateText(bool onResize)
 
         rowHeight_ = face->GetRowHeight();
 
+        const int wrapWidth = wordWrap_ ? GetWidth() : -1;
         int width = 0;
-        int height = 0;
-        int rowWidth = 0;
-        auto rowHeight = RoundToInt(rowSpacing_ * rowHeight_);
-
-        // First see if the text must be split up
-        if (!wordWrap_)
+        if (const FontTextLayout* cachedLayout = face->GetTextLayout(unicodeText_, wrapWidth))
         {
-            printText_ = unicodeText_;
-            printToText_.resize(printText_.size());
-            for (unsigned i = 0; i < printText_.size(); ++i)
-                printToText_[i] = i;
+            printText_ = cachedLayout->printText_;
+            printToText_ = cachedLayout->printToText_;
+            rowWidths_ = cachedLayout->rowWidths_;
+            width = cachedLayout->width_;
         }
         else
         {
-            int maxWidth = GetWidth();
-            unsigned nextBreak = 0;
-            unsigned lineStart = 0;
-            printToText_.clear();
+            width = LayoutText(face, wrapWidth);
+
+            FontTextLayout layout;
+            layout.text_ = unicodeText_;
+            layout.wrapWidth_ = wrapWidth;
+            layout.printText_ = printText_;
+            layout.printToText_ = printToText_;
+            layout.rowWidths_ = rowWidths_;
+            layout.width_ = width;
+            face->StoreTextLayout(ea::move(layout));
+        }
+
+        // Set at least one row height even if text is empty
+        const int height = Max(static_cast<int>(rowWidths_.size()), 1) * RoundToInt(rowSpacing_ * rowHeight_);
 
-            for (unsigned i = 0; i < unicodeText_.size(); ++i)
+        // Set minimum and current size according to the text size, but respect fixed width if set
+        if (!IsFixedWidth())
+        {
+            if (wordWrap_)
+                SetMinWidth(0);
+            else
             {
-                unsigned j;
-                unsigned c = unicodeText_[i];
+                SetMinWidth(width);
+                SetWidth(width);
+            }
+        }
+        SetFixedHeight(height);
 
-                if (c != '\n')
-                {
-                    bool ok = true;
+        charLocationsDirty_ = true;
+    }
+    else
+    {
+        // No font, nothing to render
+        pageGlyphLocations_.clear();
+    }
+
+    // If wordwrap is on, parent may need layout update to correct for overshoot in size. However, do not do this when the
+    // update is a response to resize, as that could cause infinite recursion
+    if (wordWrap_ && !onResize)
+    {
+        UIElement* parent = GetParent();
+        if (parent && parent->GetLayoutMode() != LM_FREE)
+            parent->UpdateLayout();
+    }
+    MarkBatchesDirty();
+}
 
-                    if (nextBreak <= i)
+int Text::LayoutText(FontFace* face, int wrapWidth)
+{
+    int width = 0;
+    int rowWidth = 0;
+
+    // First see if the text must be split up
+    if (!wordWrap_)
+    {
+        printText_ = unicodeText_;
+        printToText_.resize(printText_.size());
+        for (unsigned i = 0; i < printText_.size(); ++i)
+            printToText_[i] = i;
+    }
+    else
+    {
+        unsigned nextBreak = 0;
+        unsigned lineStart = 0;
+        printToText_.clear();
+
+        for (unsigned i = 0; i < unicodeText_.size(); ++i)
+        {
+            unsigned j;
+            unsigned c = unicodeText_[i];
+
+            if (c != '\n')
+            {
+                bool ok = true;
+
+                if (nextBreak <= i)
+                {
+                    int futureRowWidth = rowWidth;
+                    for (j = i; j < unicodeText_.size(); ++j)
                     {
-                        int futureRowWidth = rowWidth;
-                        for (j = i; j < unicodeText_.size(); ++j)
+                        unsigned d = unicodeText_[j];
+                        if (d == ' ' || d == '\n')
                         {
-                            unsigned d = unicodeText_[j];
-                            if (d == ' ' || d == '\n')
-                            {
-                                nextBreak = j;
-                                break;
-                            }
-                            const FontGlyph* glyph = face->GetGlyph(d);
-                            if (glyph)
-                            {
-                                futureRowWidth += glyph->advanceX_;
-                                if (j < unicodeText_.size() - 1)
-                                    futureRowWidth += face->GetKerning(d, unicodeText_[j + 1]);
-                            }
-                            if (d == '-' && futureRowWidth <= maxWidth)
-                            {
-                                nextBreak = j + 1;
-                                break;
-                            }
-                            if (futureRowWidth > maxWidth)
-                            {
-                                ok = false;
-                                break;
-                            }
+                            nextBreak = j;
+                            break;
                         }
-                    }
-
-                    if (!ok)
-                    {
-                        // If did not find any breaks on the line, copy until j, or at least 1 char, to prevent infinite loop
-                        if (nextBreak == lineStart)
+                        const FontGlyph* glyph = face->GetGlyph(d);
+                        if (glyph)
                         {
-                            while (i < j)
-                            {
-                                printText_.push_back(unicodeText_[i]);
-                                printToText_.push_back(i);
-                                ++i;
-                            }
+                            futureRowWidth += glyph->advanceX_;
+                            if (j < unicodeText_.size() - 1)
+                                futureRowWidth += face->GetKerning(d, unicodeText_[j + 1]);
                         }
-                        // Eliminate spaces that have been copied before the forced break
-                        while (printText_.size() && printText_.back() == ' ')
+                        if (d == '-' && futureRowWidth <= wrapWidth)
                         {
-                            printText_.pop_back();
-                            printToText_.pop_back();
+                            nextBreak = j + 1;
+                            break;
+                        }
+                        if (futureRowWidth > wrapWidth)
+                        {
+                            ok = false;
+                            break;
                         }
-                        printText_.push_back('\n');
-                        printToText_.push_back(Min(i, unicodeText_.size() - 1));
-                        rowWidth = 0;
-                        nextBreak = lineStart = i;
                     }
+                }
 
-                    if (i < unicodeText_.size())
+                if (!ok)
+                {
+                    // If did not find any breaks on the line, copy until j, or at least 1 char, to prevent infinite loop
+                    if (nextBreak == lineStart)
                     {
-                        // When copying a space, position is allowed to be over row width
-                        c = unicodeText_[i];
-                        const FontGlyph* glyph = face->GetGlyph(c);
-                        if (glyph)
-                        {
-                            rowWidth += glyph->advanceX_;
-                            if (i < unicodeText_.size() - 1)
-                                rowWidth += face->GetKerning(c, unicodeText_[i + 1]);
-                        }
-                        if (rowWidth <= maxWidth)
+                        while (i < j)
                         {
-                            printText_.push_back(c);
+                            printText_.push_back(unicodeText_[i]);
                             printToText_.push_back(i);
+                            ++i;
                         }
                     }
-                }
-                else
-                {
+                    // Eliminate spaces that have been copied before the forced break
+                    while (printText_.size() && printText_.back() == ' ')
+                    {
+                        printText_.pop_back();
+                        printToText_.pop_back();
+                    }
                     printText_.push_back('\n');
                     printToText_.push_back(Min(i, unicodeText_.size() - 1));
                     rowWidth = 0;
                     nextBreak = lineStart = i;
                 }
-            }
-        }
-
-        rowWidth = 0;
 
-        for (unsigned i = 0; i < printText_.size(); ++i)
-        {
-            unsigned c = printText_[i];
-
-            if (c != '\n')
-            {
-                const FontGlyph* glyph = face->GetGlyph(c);
-                if (glyph)
+                if (i < unicodeText_.size())
                 {
-                    rowWidth += glyph->advanceX_;
-                    if (i < printText_.size() - 1)
-                        rowWidth += face->GetKerning(c, printText_[i + 1]);
+                    // When copying a space, position is allowed to be over row width
+                    c = unicodeText_[i];
+                    const FontGlyph* glyph = face->GetGlyph(c);
+                    if (glyph)
+                    {
+                        rowWidth += glyph->advanceX_;
+                        if (i < unicodeText_.size() - 1)
+                            rowWidth += face->GetKerning(c, unicodeText_[i + 1]);
+                    }
+                    if (rowWidth <= wrapWidth)
+                    {
+                        printText_.push_back(c);
+                        printToText_.push_back(i);
+                    }
                 }
             }
             else
             {
-                width = Max(width, rowWidth);
-                height += rowHeight;
-                rowWidths_.push_back(rowWidth);
+                printText_.push_back('\n');
+                printToText_.push_back(Min(i, unicodeText_.size() - 1));
                 rowWidth = 0;
+                nextBreak = lineStart = i;
             }
         }
+    }
 
-        if (rowWidth)
-        {
-            width = Max(width, rowWidth);
-            height += rowHeight;
-            rowWidths_.push_back(rowWidth);
-        }
+    rowWidth = 0;
 
-        // Set at least one row height even if text is empty
-        if (!height)
-            height = rowHeight;
+    for (unsigned i = 0; i < printText_.size(); ++i)
+    {
+        unsigned c = printText_[i];
 
-        // Set minimum and current size according to the text size, but respect fixed width if set
-        if (!IsFixedWidth())
+        if (c != '\n')
         {
-            if (wordWrap_)
-                SetMinWidth(0);
-            else
+            const FontGlyph* glyph = face->GetGlyph(c);
+            if (glyph)
             {
-                SetMinWidth(width);
-                SetWidth(width);
+                rowWidth += glyph->advanceX_;
+                if (i < printText_.size() - 1)
+                    rowWidth += face->GetKerning(c, printText_[i + 1]);
             }
         }
-        SetFixedHeight(height);
-
-        charLocationsDirty_ = true;
-    }
-    else
-    {
-        // No font, nothing to render
-        pageGlyphLocations_.clear();
+        else
+        {
+            width = Max(width, rowWidth);
+            rowWidths_.push_back(rowWidth);
+            rowWidth = 0;
+        }
     }
 
-    // If wordwrap is on, parent may need layout update to correct for overshoot in size. However, do not do this when the
-    // update is a response to resize, as that could cause infinite recursion
-    if (wordWrap_ && !onResize)
+    if (rowWidth)
     {
-        UIElement* parent = GetParent();
-        if (parent && parent->GetLayoutMode() != LM_FREE)
-            parent->UpdateLayout();
+        width = Max(width, rowWidth);
+        rowWidths_.push_back(rowWidth);
     }
+
+    return width;
 }
 
 void Text::UpdateCharLocations()
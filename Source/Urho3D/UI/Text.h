@@ -237,6 +237,8 @@ protected:
     bool FilterImplicitAttributes(XMLElement& dest) const override;
     /// Update text when text, font or spacing changed.
     void UpdateText(bool onResize = false);
+    /// Split text into rows and calculate row widths. Return width of the widest row.
+    int LayoutText(FontFace* face, int wrapWidth);
     /// Update cached character locations after text update, or when text alignment or indent has changed.
     void UpdateCharLocations();
     /// Validate text selection to be within the text.
@@ -92,6 +92,7 @@ UI::UI(Context* context) :
     Object(context),
     rootElement_(MakeShared<UIElement>(context)),
     rootModalElement_(MakeShared<UIElement>(context)),
+    batchCacheFrame_(0),
     doubleClickInterval_(DEFAULT_DOUBLECLICK_INTERVAL),
     dragBeginInterval_(DEFAULT_DRAGBEGIN_INTERVAL),
     defaultToolTipDelay_(DEFAULT_TOOLTIP_DELAY),
@@ -116,6 +117,7 @@ UI::UI(Context* context) :
 #endif
     useMutableGlyphs_(false),
     forceAutoHint_(false),
+    batchCaching_(false),
     fontHintLevel_(FONT_HINT_LEVEL_NORMAL),
     fontSubpixelThreshold_(12),
     fontOversampling_(2),
@@ -207,6 +209,7 @@ void UI::SetFocusElement(UIElement* element, bool byKey)
     {
         UIElement* oldFocusElement = focusElement_;
         focusElement_.Reset();
+        oldFocusElement->MarkBatchesDirty();
 
         VariantMap& focusEventData = GetEventDataMap();
         focusEventData[Defocused::P_ELEMENT] = oldFocusElement;
@@ -217,6 +220,7 @@ void UI::SetFocusElement(UIElement* element, bool byKey)
     if (element && element->GetFocusMode() >= FM_FOCUSABLE)
     {
         focusElement_ = element;
+        element->MarkBatchesDirty();
 
         VariantMap& focusEventData = GetEventDataMap();
         focusEventData[Focused::P_ELEMENT] = element;
@@ -402,6 +406,9 @@ void UI::Update(float timeStep)
             {
                 using namespace HoverEnd;
 
+                // Hover state is reset during batch generation, so cached batches may still show the hover effect
+                element->MarkBatchesDirty();
+
                 VariantMap& eventData = GetEventDataMap();
                 eventData[P_ELEMENT] = element;
                 element->SendEvent(E_HOVEREND, eventData);
@@ -434,14 +441,24 @@ void UI::RenderUpdate()
     const IntVector2& rootPos = rootElement_->GetPosition();
     // Note: the scissors operate on unscaled coordinates. Scissor scaling is only performed during render
     IntRect currentScissor = IntRect(rootPos.x_, rootPos.y_, rootPos.x_ + rootSize.x_, rootPos.y_ + rootSize.y_);
+    ++batchCacheFrame_;
     if (rootElement_->IsVisible())
-        GetBatches(batches_, vertexData_, rootElement_, currentScissor);
+        GetRootBatches(batches_, vertexData_, rootElement_, currentScissor);
 
     // Save the batch size of the non-modal batches for later use
     nonModalBatchSize_ = batches_.size();
 
     // Get rendering batches from the modal UI elements
-    GetBatches(batches_, vertexData_, rootModalElement_, currentScissor);
+    GetRootBatches(batches_, vertexData_, rootModalElement_, currentScissor);
+
+    // Drop cached batches of elements that are no longer root-level
+    for (auto i = batchCache_.begin(); i != batchCache_.end();)
+    {
+        if (i->second.lastUsedFrame_ != batchCacheFrame_)
+            i = batchCache_.erase(i);
+        else
+            ++i;
+    }
 
     // Get batches from the cursor (and its possible children) last to draw it on top of everything
     if (cursor_ && cursor_->IsVisible() && !osCursorVisible)
@@ -628,6 +645,13 @@ void UI::SetUseMutableGlyphs(bool enable)
     }
 }
 
+void UI::SetBatchCaching(bool enable)
+{
+    batchCaching_ = enable;
+    if (!batchCaching_)
+        batchCache_.clear();
+}
+
 void UI::SetForceAutoHint(bool enable)
 {
     if (enable != forceAutoHint_)
@@ -1095,6 +1119,64 @@ void UI::GetBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData,
     }
 }
 
+void UI::GetRootBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData, UIElement* root, IntRect currentScissor)
+{
+    // Breadth-first traversal interleaves root-level subtrees, so they cannot be cached separately.
+    // Mutable glyphs must be reacquired by the text elements every frame
+    if (!batchCaching_ || useMutableGlyphs_ || root->GetTraversalMode() == TM_BREADTH_FIRST)
+    {
+        GetBatches(batches, vertexData, root, currentScissor);
+        return;
+    }
+
+    root->AdjustScissor(currentScissor);
+    if (currentScissor.left_ == currentScissor.right_ || currentScissor.top_ == currentScissor.bottom_)
+        return;
+
+    root->SortChildren();
+    for (UIElement* child : root->GetChildren())
+    {
+        if (child == cursor_)
+            continue;
+
+        CachedSubtreeBatches& cache = batchCache_[child];
+        if (cache.element_.Get() != child || cache.scissor_ != currentScissor || child->AreBatchesDirty())
+        {
+            cache.element_ = child;
+            cache.scissor_ = currentScissor;
+            cache.batches_.clear();
+            cache.vertexData_.clear();
+            cache.textures_.clear();
+
+            if (child->IsWithinScissor(currentScissor))
+                child->GetBatches(cache.batches_, cache.vertexData_, currentScissor);
+            if (child->IsVisible())
+                GetBatches(cache.batches_, cache.vertexData_, child, currentScissor);
+
+            for (const UIBatch& batch : cache.batches_)
+            {
+                if (batch.texture_)
+                    cache.textures_.emplace_back(batch.texture_);
+            }
+
+            // Batch generation may touch element state (e.g. reset hovering), so clear the flags afterwards
+            child->ClearBatchesDirty();
+        }
+        cache.lastUsedFrame_ = batchCacheFrame_;
+
+        // Append cached batches, rebasing their vertex ranges
+        const unsigned vertexOffset = vertexData.size();
+        vertexData.insert(vertexData.end(), cache.vertexData_.begin(), cache.vertexData_.end());
+        for (UIBatch batch : cache.batches_)
+        {
+            batch.vertexData_ = &vertexData;
+            batch.vertexStart_ += vertexOffset;
+            batch.vertexEnd_ += vertexOffset;
+            UIBatch::AddOrMerge(batch, batches);
+        }
+    }
+}
+
 void UI::GetElementAt(UIElement*& result, UIElement* current, const IntVector2& position, bool enabledOnly)
 {
     if (!current)
@@ -1232,6 +1314,9 @@ void UI::ReleaseFontFaces()
 
     for (unsigned i = 0; i < fonts.size(); ++i)
         fonts[i]->ReleaseFaces();
+
+    // Cached text batches refer to the released font face textures
+    batchCache_.clear();
 }
 
 void UI::ProcessHover(const IntVector2& windowCursorPos, MouseButtonFlags buttons, QualifierFlags qualifiers, Cursor* cursor)
@@ -138,6 +138,9 @@ public:
     /// Set the oversampling (horizonal stretching) used to improve subpixel font rendering. Only affects fonts smaller than the subpixel limit.
     /// @property
     void SetFontOversampling(int oversampling);
+    /// Set whether to cache rendering batches of root-level elements and rebuild them only when their subtree changes. Has no effect with mutable glyphs. Custom elements must call UIElement::MarkBatchesDirty() when their appearance changes outside of the built-in setters. Default false.
+    /// @property
+    void SetBatchCaching(bool enable);
     /// Set %UI scale. 1.0 is default (pixel perfect). Resize the root element to match.
     /// @property
     void SetScale(float scale);
@@ -258,6 +261,10 @@ public:
     /// @property
     int GetFontOversampling() const { return fontOversampling_; }
 
+    /// Return whether rendering batches of root-level elements are cached.
+    /// @property
+    bool GetBatchCaching() const { return batchCaching_; }
+
     /// Return true when UI has modal element(s).
     bool HasModalElement() const;
 
@@ -312,6 +319,8 @@ private:
     void Render(VertexBuffer* buffer, const ea::vector<UIBatch>& batches, unsigned batchStart, unsigned batchEnd);
     /// Generate batches from an UI element recursively. Skip the cursor element.
     void GetBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData, UIElement* element, IntRect currentScissor);
+    /// Generate batches from a root element, reusing cached batches of unchanged root-level subtrees if enabled.
+    void GetRootBatches(ea::vector<UIBatch>& batches, ea::vector<float>& vertexData, UIElement* root, IntRect currentScissor);
     /// Return UI element at screen position recursively.
     void GetElementAt(UIElement*& result, UIElement* current, const IntVector2& position, bool enabledOnly);
     /// Return the first element in hierarchy that can alter focus.
@@ -406,12 +415,33 @@ private:
     WeakPtr<UIElement> focusElement_;
     /// Cached pipeline states.
     SharedPtr<DefaultUIBatchStateCache> batchStateCache_;
+    /// Cached rendering batches of a root-level element and its children.
+    struct CachedSubtreeBatches
+    {
+        /// Element the batches were generated from. Guards against element address reuse.
+        WeakPtr<UIElement> element_;
+        /// Scissor the batches were generated with.
+        IntRect scissor_;
+        /// Batches with vertex ranges relative to the cached vertex data.
+        ea::vector<UIBatch> batches_;
+        /// Cached vertex data.
+        ea::vector<float> vertexData_;
+        /// Textures referenced by the batches, kept alive while cached.
+        ea::vector<SharedPtr<Texture>> textures_;
+        /// Frame number when the batches were last used.
+        unsigned lastUsedFrame_{};
+    };
+
     /// UI rendering batches.
     ea::vector<UIBatch> batches_;
     /// UI rendering vertex data.
     ea::vector<float> vertexData_;
     /// UI rendering batches for debug draw.
     ea::vector<UIBatch> debugDrawBatches_;
+    /// Cached batches of root-level elements.
+    ea::unordered_map<UIElement*, CachedSubtreeBatches> batchCache_;
+    /// Frame counter used to prune unused cached batches.
+    unsigned batchCacheFrame_;
     /// UI rendering vertex data for debug draw.
     ea::vector<float> debugVertexData_;
     /// UI vertex buffer.
@@ -452,6 +482,8 @@ private:
     bool useMutableGlyphs_;
     /// Flag for forcing FreeType auto hinting.
     bool forceAutoHint_;
+    /// Flag for caching rendering batches of root-level elements.
+    bool batchCaching_;
     /// FreeType hinting level (default is FONT_HINT_LEVEL_NORMAL).
     FontHintLevel fontHintLevel_;
     /// Maxmimum font size for subpixel glyph positioning and oversampling (default is 12).
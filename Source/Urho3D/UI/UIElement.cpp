@@ -163,6 +163,7 @@ void UIElement::ApplyAttributes()
 {
     colorGradient_ = false;
     derivedColorDirty_ = true;
+    MarkBatchesDirty();
 
     for (unsigned i = 1; i < MAX_UIELEMENT_CORNERS; ++i)
     {
@@ -448,7 +449,7 @@ const IntVector2& UIElement::GetScreenPosition() const
 
 void UIElement::OnHover(const IntVector2& position, const IntVector2& screenPosition, MouseButtonFlags buttons, QualifierFlags qualifiers, Cursor* cursor)
 {
-    hovering_ = true;
+    SetHovering(true);
 }
 
 void UIElement::OnDragBegin(const IntVector2& position, const IntVector2& screenPosition, MouseButtonFlags buttons, QualifierFlags qualifiers,
@@ -845,6 +846,7 @@ void UIElement::SetClipBorder(const IntRect& rect)
     clipBorder_.top_ = Max(rect.top_, 0);
     clipBorder_.right_ = Max(rect.right_, 0);
     clipBorder_.bottom_ = Max(rect.bottom_, 0);
+    MarkBatchesDirty();
 }
 
 void UIElement::SetColor(const Color& color)
@@ -853,6 +855,7 @@ void UIElement::SetColor(const Color& color)
         cornerColor = color;
     colorGradient_ = false;
     derivedColorDirty_ = true;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetColor(Corner corner, const Color& color)
@@ -860,6 +863,7 @@ void UIElement::SetColor(Corner corner, const Color& color)
     colors_[corner] = color;
     colorGradient_ = false;
     derivedColorDirty_ = true;
+    MarkBatchesDirty();
 
     for (unsigned i = 0; i < MAX_UIELEMENT_CORNERS; ++i)
     {
@@ -876,6 +880,7 @@ void UIElement::SetPriority(int priority)
     priority_ = priority;
     if (parent_)
         parent_->sortOrderDirty_ = true;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetOpacity(float opacity)
@@ -897,6 +902,7 @@ void UIElement::SetBringToBack(bool enable)
 void UIElement::SetClipChildren(bool enable)
 {
     clipChildren_ = enable;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetSortChildren(bool enable)
@@ -905,6 +911,7 @@ void UIElement::SetSortChildren(bool enable)
         sortOrderDirty_ = true;
 
     sortChildren_ = enable;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetUseDerivedOpacity(bool enable)
@@ -916,11 +923,13 @@ void UIElement::SetEnabled(bool enable)
 {
     enabled_ = enable;
     enabledPrev_ = enable;
+    MarkBatchesDirty();
 }
 
 void UIElement::SetDeepEnabled(bool enable)
 {
     enabled_ = enable;
+    MarkBatchesDirty();
 
     for (auto i = children_.begin(); i != children_.end(); ++i)
         (*i)->SetDeepEnabled(enable);
@@ -929,6 +938,7 @@ void UIElement::SetDeepEnabled(bool enable)
 void UIElement::ResetDeepEnabled()
 {
     enabled_ = enabledPrev_;
+    MarkBatchesDirty();
 
     for (auto i = children_.begin(); i != children_.end(); ++i)
         (*i)->ResetDeepEnabled();
@@ -938,6 +948,7 @@ void UIElement::SetEnabledRecursive(bool enable)
 {
     enabled_ = enable;
     enabledPrev_ = enable;
+    MarkBatchesDirty();
 
     for (auto i = children_.begin(); i != children_.end(); ++i)
         (*i)->SetEnabledRecursive(enable);
@@ -979,7 +990,11 @@ void UIElement::SetFocus(bool enable)
 
 void UIElement::SetSelected(bool enable)
 {
-    selected_ = enable;
+    if (enable != selected_)
+    {
+        selected_ = enable;
+        MarkBatchesDirty();
+    }
 }
 
 void UIElement::SetVisible(bool enable)
@@ -992,6 +1007,7 @@ void UIElement::SetVisible(bool enable)
     if (enable != visible_)
     {
         visible_ = enable;
+        MarkBatchesDirty();
 
         // Parent's layout may change as a result of visibility change
         if (parent_)
@@ -1346,6 +1362,7 @@ void UIElement::InsertChild(unsigned index, UIElement* element)
 
     element->parent_ = this;
     element->MarkDirty();
+    MarkBatchesDirty();
 
     // Apply style now if child element (and its children) has it defined
     ApplyStyleRecursive(element);
@@ -1391,6 +1408,7 @@ void UIElement::RemoveChild(UIElement* element, unsigned index)
 
             element->Detach();
             children_.erase_at(i);
+            MarkBatchesDirty();
             UpdateLayout();
             return;
         }
@@ -1418,6 +1436,7 @@ void UIElement::RemoveChildAtIndex(unsigned index)
 
     children_[index]->Detach();
     children_.erase_at(index);
+    MarkBatchesDirty();
     UpdateLayout();
 }
 
@@ -1444,6 +1463,7 @@ void UIElement::RemoveAllChildren()
         (*i++)->Detach();
     }
     children_.clear();
+    MarkBatchesDirty();
     UpdateLayout();
 }
 
@@ -1855,7 +1875,11 @@ void UIElement::SetChildOffset(const IntVector2& offset)
 
 void UIElement::SetHovering(bool enable)
 {
-    hovering_ = enable;
+    if (enable != hovering_)
+    {
+        hovering_ = enable;
+        MarkBatchesDirty();
+    }
 }
 
 void UIElement::AdjustScissor(IntRect& currentScissor)
@@ -1983,11 +2007,27 @@ void UIElement::MarkDirty()
     positionDirty_ = true;
     opacityDirty_ = true;
     derivedColorDirty_ = true;
+    MarkBatchesDirty();
 
     for (auto i = children_.begin(); i != children_.end(); ++i)
         (*i)->MarkDirty();
 }
 
+void UIElement::MarkBatchesDirty()
+{
+    // Stop at the first flagged element: its ancestors are flagged already
+    for (UIElement* element = this; element && !element->batchesDirty_; element = element->parent_)
+        element->batchesDirty_ = true;
+}
+
+void UIElement::ClearBatchesDirty()
+{
+    batchesDirty_ = false;
+
+    for (auto i = children_.begin(); i != children_.end(); ++i)
+        (*i)->ClearBatchesDirty();
+}
+
 bool UIElement::RemoveChildXML(XMLElement& parent, const ea::string& name) const
 {
     thread_local XPathQuery matchXPathQuery("./attribute[@name=$attributeName]", "attributeName:String");
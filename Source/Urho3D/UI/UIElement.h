@@ -763,6 +763,13 @@ public:
     /// Return effective minimum size, also considering layout. Used internally.
     IntVector2 GetEffectiveMinSize() const;
 
+    /// Mark cached rendering batches of this element and its ancestors as dirty. Built-in setters call this automatically; custom elements should call it when their appearance changes by other means.
+    void MarkBatchesDirty();
+    /// Return whether cached rendering batches are dirty. Used internally.
+    bool AreBatchesDirty() const { return batchesDirty_; }
+    /// Clear the batches dirty flag of this element and its children. Used internally.
+    void ClearBatchesDirty();
+
 protected:
     /// Handle attribute animation added.
     void OnAttributeAnimationAdded() override;
@@ -914,6 +921,8 @@ private:
     mutable bool derivedColorDirty_{true};
     /// Child priority sorting dirty flag.
     bool sortOrderDirty_{};
+    /// Cached rendering batches dirty flag. When set, all ancestors are also flagged.
+    bool batchesDirty_{true};
     /// Has color gradient flag.
     bool colorGradient_{};
     /// Default style file.
@@ -159,9 +159,9 @@ void View3D::ResetScene()
     if (!ownScene_)
     {
         RefCount* refCount = scene_->RefCountPtr();
-        ea::Internal::atomic_increment(&refCount->refs_);
+        RefCount::Increment(refCount->refs_);
         scene_ = nullptr;
-        ea::Internal::atomic_decrement(&refCount->refs_);
+        RefCount::Decrement(refCount->refs_);
     }
     else
         scene_ = nullptr;
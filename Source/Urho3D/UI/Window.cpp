@@ -285,6 +285,7 @@ void Window::SetModal(bool modal)
     if (ui->SetModalElement(this, modal))
     {
         modal_ = modal;
+        MarkBatchesDirty();
 
         using namespace ModalChanged;
 
@@ -298,16 +299,19 @@ void Window::SetModal(bool modal)
 void Window::SetModalShadeColor(const Color& color)
 {
     modalShadeColor_ = color;
+    MarkBatchesDirty();
 }
 
 void Window::SetModalFrameColor(const Color& color)
 {
     modalFrameColor_ = color;
+    MarkBatchesDirty();
 }
 
 void Window::SetModalFrameSize(const IntVector2& size)
 {
     modalFrameSize_ = size;
+    MarkBatchesDirty();
 }
 
 void Window::SetModalAutoDismiss(bool enable)
@@ -50,6 +50,10 @@ namespace Urho3D
 {
 
 static const unsigned MASK_VERTEX2D = MASK_POSITION | MASK_COLOR | MASK_TEXCOORD1;
+/// Min number of source batches per chunk sorted in parallel.
+static const unsigned MIN_PARALLEL_SORT_CHUNK = 4096;
+/// Number of source batches per vertex copy task.
+static const unsigned VERTEX_COPY_BUCKET = 1024;
 
 ViewBatchInfo2D::ViewBatchInfo2D() :
     vertexBufferUpdateFrameNumber_(0),
@@ -205,13 +209,16 @@ void Renderer2D::UpdateBatchesDelayed(const FrameInfo& frame)
             if (dest)
             {
                 const ea::vector<const SourceBatch2D*>& sourceBatches = viewBatchInfo.sourceBatches_;
-                for (unsigned b = 0; b < sourceBatches.size(); ++b)
+                const ea::vector<unsigned>& vertexOffsets = viewBatchInfo.sourceBatchVertexOffsets_;
+                ForEachParallel(GetSubsystem<WorkQueue>(), VERTEX_COPY_BUCKET, sourceBatches.size(),
+                    [&](unsigned beginIndex, unsigned endIndex)
                 {
-                    const ea::vector<Vertex2D>& vertices = sourceBatches[b]->vertices_;
-                    for (unsigned i = 0; i < vertices.size(); ++i)
-                        dest[i] = vertices[i];
-                    dest += vertices.size();
-                }
+                    for (unsigned b = beginIndex; b < endIndex; ++b)
+                    {
+                        const ea::vector<Vertex2D>& vertices = sourceBatches[b]->vertices_;
+                        ea::copy(vertices.begin(), vertices.end(), dest + vertexOffsets[b]);
+                    }
+                });
 
                 vertexBuffer->Unlock();
             }
@@ -314,7 +321,14 @@ void CheckDrawableVisibilityWork(const WorkItem* item, unsigned threadIndex)
     {
         Drawable2D* drawable = *start++;
         if (renderer->CheckVisibility(drawable))
+        {
             drawable->MarkInView(renderer->frame_);
+
+            // Generate vertices and view distance here so that the main thread only needs to sort and merge batches
+            const float distance = renderer->frame_.camera_->GetDistance(drawable->GetNode()->GetWorldPosition());
+            for (const SourceBatch2D& sourceBatch : drawable->GetSourceBatches())
+                sourceBatch.distance_ = distance;
+        }
     }
 }
 
@@ -440,17 +454,11 @@ void Renderer2D::UpdateViewBatchInfo(ViewBatchInfo2D& viewBatchInfo, Camera* cam
         }
     }
 
-    for (unsigned i = 0; i < sourceBatches.size(); ++i)
-    {
-        const SourceBatch2D* sourceBatch = sourceBatches[i];
-        // if (sourceBatch->owner_)
-        {
-            Vector3 worldPos = sourceBatch->owner_->GetNode()->GetWorldPosition();
-            sourceBatch->distance_ = camera->GetDistance(worldPos);
-        }
-    }
+    // Source batch distances are calculated in CheckDrawableVisibilityWork
+    SortSourceBatches(sourceBatches);
 
-    ea::quick_sort(sourceBatches.begin(), sourceBatches.end(), CompareSourceBatch2Ds);
+    ea::vector<unsigned>& vertexOffsets = viewBatchInfo.sourceBatchVertexOffsets_;
+    vertexOffsets.resize(sourceBatches.size());
 
     viewBatchInfo.batchCount_ = 0;
     Material* currMaterial = nullptr;
@@ -465,6 +473,7 @@ void Renderer2D::UpdateViewBatchInfo(ViewBatchInfo2D& viewBatchInfo, Camera* cam
         distance = Min(distance, sourceBatches[b]->distance_);
         Material* material = sourceBatches[b]->material_;
         const ea::vector<Vertex2D>& vertices = sourceBatches[b]->vertices_;
+        vertexOffsets[b] = vStart + vCount;
 
         // When new material encountered, finish the current batch and start new
         if (currMaterial != material)
@@ -495,6 +504,50 @@ void Renderer2D::UpdateViewBatchInfo(ViewBatchInfo2D& viewBatchInfo, Camera* cam
     viewBatchInfo.batchUpdatedFrameNumber_ = frame_.frameNumber_;
 }
 
+void Renderer2D::SortSourceBatches(ea::vector<const SourceBatch2D*>& sourceBatches)
+{
+    auto* workQueue = GetSubsystem<WorkQueue>();
+    const unsigned size = sourceBatches.size();
+    const unsigned numChunks = Min(workQueue->GetNumThreads() + 1, size / MIN_PARALLEL_SORT_CHUNK);
+    if (numChunks <= 1)
+    {
+        ea::quick_sort(sourceBatches.begin(), sourceBatches.end(), CompareSourceBatch2Ds);
+        return;
+    }
+
+    // Sort chunks in parallel
+    const unsigned chunkSize = (size + numChunks - 1) / numChunks;
+    ForEachParallel(workQueue, 1u, numChunks, [&](unsigned beginIndex, unsigned endIndex)
+    {
+        for (unsigned chunk = beginIndex; chunk < endIndex; ++chunk)
+        {
+            const auto first = sourceBatches.begin() + chunk * chunkSize;
+            const auto last = sourceBatches.begin() + Min((chunk + 1) * chunkSize, size);
+            ea::quick_sort(first, last, CompareSourceBatch2Ds);
+        }
+    });
+
+    // Merge sorted chunks pairwise. Comparison is a strict total order, so the result is the same as of serial sort
+    sortBuffer_.resize(size);
+    for (unsigned width = chunkSize; width < size; width *= 2)
+    {
+        const unsigned numPairs = (size + 2 * width - 1) / (2 * width);
+        ForEachParallel(workQueue, 1u, numPairs, [&](unsigned beginIndex, unsigned endIndex)
+        {
+            for (unsigned pair = beginIndex; pair < endIndex; ++pair)
+            {
+                const unsigned first = pair * 2 * width;
+                const unsigned middle = Min(first + width, size);
+                const unsigned last = Min(first + 2 * width, size);
+                ea::merge(sourceBatches.begin() + first, sourceBatches.begin() + middle,
+                    sourceBatches.begin() + middle, sourceBatches.begin() + last,
+                    sortBuffer_.begin() + first, CompareSourceBatch2Ds);
+            }
+        });
+        sourceBatches.swap(sortBuffer_);
+    }
+}
+
 void Renderer2D::AddViewBatch(ViewBatchInfo2D& viewBatchInfo, Material* material,
     unsigned indexStart, unsigned indexCount, unsigned vertexStart, unsigned vertexCount, float distance)
 {
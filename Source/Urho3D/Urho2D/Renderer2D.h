@@ -56,6 +56,8 @@ struct ViewBatchInfo2D
     unsigned batchUpdatedFrameNumber_;
     /// Source batches.
     ea::vector<const SourceBatch2D*> sourceBatches_;
+    /// Offsets of source batches in the vertex buffer.
+    ea::vector<unsigned> sourceBatchVertexOffsets_;
     /// Batch count.
     unsigned batchCount_;
     /// Distances.
@@ -110,6 +112,8 @@ private:
     void GetDrawables(ea::vector<Drawable2D*>& drawables, Node* node);
     /// Update view batch info.
     void UpdateViewBatchInfo(ViewBatchInfo2D& viewBatchInfo, Camera* camera);
+    /// Sort source batches by draw order, in parallel if there are many of them.
+    void SortSourceBatches(ea::vector<const SourceBatch2D*>& sourceBatches);
     /// Add view batch.
     void AddViewBatch(ViewBatchInfo2D& viewBatchInfo, Material* material,
         unsigned indexStart, unsigned indexCount, unsigned vertexStart, unsigned vertexCount, float distance);
@@ -124,6 +128,8 @@ private:
     FrameInfo frame_;
     /// View batch info.
     ea::unordered_map<Camera*, ViewBatchInfo2D> viewBatchInfos_;
+    /// Temporary buffer for merging sorted source batches.
+    ea::vector<const SourceBatch2D*> sortBuffer_;
     /// Frustum for current frame.
     Frustum frustum_;
     /// View mask of current camera for visibility checking.
@@ -0,0 +1,168 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Graphics/Texture2D.h"
+#include "../IO/Log.h"
+#include "../Resource/Image.h"
+#include "../Urho2D/Sprite2D.h"
+#include "../Urho2D/SpriteAtlasBuilder2D.h"
+#include "../Urho2D/SpriteSheet2D.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+const int minPageSize = 256;
+
+}
+
+SpriteAtlasBuilder2D::SpriteAtlasBuilder2D(Context* context, int maxPageSize, int padding)
+    : Object(context)
+    , maxPageSize_(Max(maxPageSize, 1))
+    , padding_(Max(padding, 0))
+{
+}
+
+SpriteAtlasBuilder2D::~SpriteAtlasBuilder2D() = default;
+
+Sprite2D* SpriteAtlasBuilder2D::AddSprite(const ea::string& name, const Image* image, const Vector2& hotSpot)
+{
+    if (Sprite2D* sprite = GetSprite(name))
+        return sprite;
+
+    if (!image || image->IsCompressed() || image->GetDepth() > 1)
+    {
+        URHO3D_LOGERROR("Cannot add sprite '{}' to atlas: image should be uncompressed 2D image", name);
+        return nullptr;
+    }
+
+    const int width = image->GetWidth();
+    const int height = image->GetHeight();
+    IntVector2 position;
+    const unsigned pageIndex = Allocate(width + padding_, height + padding_, position);
+    if (pageIndex == M_MAX_UNSIGNED)
+    {
+        URHO3D_LOGERROR("Cannot add sprite '{}' of size {}x{} to atlas with page size {}", name, width, height,
+            maxPageSize_);
+        return nullptr;
+    }
+
+    Page& page = pages_[pageIndex];
+    const IntRect rect{position.x_, position.y_, position.x_ + width, position.y_ + height};
+    if (image->GetComponents() == 4)
+        page.image_->SetSubimage(image, rect);
+    else
+        page.image_->SetSubimage(image->ConvertToRGBA(), rect);
+    page.dirty_ = true;
+
+    page.spriteSheet_->DefineSprite(name, rect, hotSpot);
+    Sprite2D* sprite = page.spriteSheet_->GetSprite(name);
+    sprites_[name] = sprite;
+    return sprite;
+}
+
+void SpriteAtlasBuilder2D::Commit()
+{
+    for (Page& page : pages_)
+    {
+        if (!page.dirty_)
+            continue;
+
+        page.texture_->SetData(page.image_, true);
+        page.dirty_ = false;
+    }
+}
+
+Sprite2D* SpriteAtlasBuilder2D::GetSprite(const ea::string& name) const
+{
+    const auto iter = sprites_.find(name);
+    return iter != sprites_.end() ? iter->second : nullptr;
+}
+
+SpriteSheet2D* SpriteAtlasBuilder2D::GetPage(unsigned index) const
+{
+    return index < pages_.size() ? pages_[index].spriteSheet_ : nullptr;
+}
+
+unsigned SpriteAtlasBuilder2D::Allocate(int width, int height, IntVector2& position)
+{
+    if (width > maxPageSize_ || height > maxPageSize_)
+        return M_MAX_UNSIGNED;
+
+    for (unsigned i = 0; i < pages_.size(); ++i)
+    {
+        Page& page = pages_[i];
+        const IntVector2 oldSize{page.allocator_.GetWidth(), page.allocator_.GetHeight()};
+        if (page.allocator_.Allocate(width, height, position.x_, position.y_))
+        {
+            if (oldSize != IntVector2{page.allocator_.GetWidth(), page.allocator_.GetHeight()})
+                ResizePageImage(page);
+            return i;
+        }
+    }
+
+    // New page is large enough for the sprite
+    const int initialSize = Min(maxPageSize_, NextPowerOfTwo(Max(Max(width, height), minPageSize)));
+    Page& page = CreatePage(initialSize);
+    if (!page.allocator_.Allocate(width, height, position.x_, position.y_))
+        return M_MAX_UNSIGNED;
+    return pages_.size() - 1;
+}
+
+SpriteAtlasBuilder2D::Page& SpriteAtlasBuilder2D::CreatePage(int initialSize)
+{
+    Page& page = pages_.emplace_back();
+    page.allocator_.Reset(initialSize, initialSize, maxPageSize_, maxPageSize_, false);
+
+    page.image_ = MakeShared<Image>(context_);
+    page.image_->SetSize(initialSize, initialSize, 4);
+    page.image_->ClearInt(0);
+
+    page.texture_ = MakeShared<Texture2D>(context_);
+    page.texture_->SetName(Format("SpriteAtlas_{}", pages_.size() - 1));
+    page.texture_->SetNumLevels(1);
+    page.texture_->SetAddressMode(COORD_U, ADDRESS_CLAMP);
+    page.texture_->SetAddressMode(COORD_V, ADDRESS_CLAMP);
+
+    page.spriteSheet_ = MakeShared<SpriteSheet2D>(context_);
+    page.spriteSheet_->SetTexture(page.texture_);
+    return page;
+}
+
+void SpriteAtlasBuilder2D::ResizePageImage(Page& page)
+{
+    const SharedPtr<Image> oldImage = page.image_;
+    const IntRect oldRect{0, 0, oldImage->GetWidth(), oldImage->GetHeight()};
+
+    page.image_ = MakeShared<Image>(context_);
+    page.image_->SetSize(page.allocator_.GetWidth(), page.allocator_.GetHeight(), 4);
+    page.image_->ClearInt(0);
+    page.image_->SetSubimage(oldImage, oldRect);
+}
+
+}
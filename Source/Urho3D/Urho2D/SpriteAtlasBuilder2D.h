@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Core/Object.h"
+#include "../Math/AreaAllocator.h"
+#include "../Math/Vector2.h"
+
+#include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
+
+namespace Urho3D
+{
+
+class Image;
+class Sprite2D;
+class SpriteSheet2D;
+class Texture2D;
+
+/// Packs images loaded at runtime into shared textures, so sprites from different images can be batched together.
+/// Each page is a SpriteSheet2D with its own texture. Pages start small and grow up to max page size.
+/// Textures of modified pages are updated on Commit.
+class URHO3D_API SpriteAtlasBuilder2D : public Object
+{
+    URHO3D_OBJECT(SpriteAtlasBuilder2D, Object);
+
+public:
+    /// Construct.
+    explicit SpriteAtlasBuilder2D(Context* context, int maxPageSize = 2048, int padding = 1);
+    /// Destruct.
+    ~SpriteAtlasBuilder2D() override;
+
+    /// Pack image into atlas and define sprite. Return existing sprite if the name is already used.
+    /// Return null if the image is compressed or doesn't fit into page.
+    Sprite2D* AddSprite(const ea::string& name, const Image* image, const Vector2& hotSpot = Vector2(0.5f, 0.5f));
+    /// Update textures of modified pages. Should be called from main thread.
+    void Commit();
+
+    /// Return sprite by name.
+    Sprite2D* GetSprite(const ea::string& name) const;
+    /// Return number of pages.
+    unsigned GetNumPages() const { return pages_.size(); }
+    /// Return sprite sheet of the page.
+    SpriteSheet2D* GetPage(unsigned index) const;
+    /// Return max page size.
+    int GetMaxPageSize() const { return maxPageSize_; }
+    /// Return padding between sprites.
+    int GetPadding() const { return padding_; }
+
+private:
+    /// Page of atlas.
+    struct Page
+    {
+        SharedPtr<SpriteSheet2D> spriteSheet_;
+        SharedPtr<Texture2D> texture_;
+        SharedPtr<Image> image_;
+        AreaAllocator allocator_;
+        bool dirty_{};
+    };
+
+    /// Allocate area in existing page or create new one. Return page index or M_MAX_UNSIGNED.
+    unsigned Allocate(int width, int height, IntVector2& position);
+    /// Create new empty page.
+    Page& CreatePage(int initialSize);
+    /// Resize page image after allocator has grown.
+    void ResizePageImage(Page& page);
+
+    /// Max width and height of page.
+    const int maxPageSize_{};
+    /// Padding between sprites.
+    const int padding_{};
+    /// Pages.
+    ea::vector<Page> pages_;
+    /// Sprites by name.
+    ea::unordered_map<ea::string, SharedPtr<Sprite2D>> sprites_;
+};
+
+}
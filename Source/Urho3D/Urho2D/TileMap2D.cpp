@@ -50,6 +50,7 @@ void TileMap2D::RegisterObject(Context* context)
     context->AddFactoryReflection<TileMap2D>(Category_Urho2D);
 
     URHO3D_ACCESSOR_ATTRIBUTE("Is Enabled", IsEnabled, SetEnabled, bool, true, AM_DEFAULT);
+    URHO3D_ACCESSOR_ATTRIBUTE("Chunk Size", GetChunkSize, SetChunkSize, int, 0, AM_DEFAULT);
     URHO3D_MIXED_ACCESSOR_ATTRIBUTE("Tmx File", GetTmxFileAttr, SetTmxFileAttr, ResourceRef, ResourceRef(TmxFile2D::GetTypeStatic()),
         AM_DEFAULT);
 }
@@ -150,6 +151,23 @@ void TileMap2D::SetTmxFile(TmxFile2D* tmxFile)
     }
 }
 
+void TileMap2D::SetChunkSize(int chunkSize)
+{
+    chunkSize = Max(chunkSize, 0);
+    if (chunkSize == chunkSize_)
+        return;
+
+    chunkSize_ = chunkSize;
+
+    // Recreate layers
+    if (tmxFile_)
+    {
+        SharedPtr<TmxFile2D> tmxFile = tmxFile_;
+        SetTmxFile(nullptr);
+        SetTmxFile(tmxFile);
+    }
+}
+
 TmxFile2D* TileMap2D::GetTmxFile() const
 {
     return tmxFile_;
@@ -53,11 +53,18 @@ public:
     void SetTmxFile(TmxFile2D* tmxFile);
     /// Add debug geometry to the debug renderer.
     void DrawDebugGeometry();
+    /// Set chunk size in tiles. Tile layers are split into chunks rendered as single drawables. Zero creates node per tile.
+    /// @property
+    void SetChunkSize(int chunkSize);
 
     /// Return tmx file.
     /// @property
     TmxFile2D* GetTmxFile() const;
 
+    /// Return chunk size in tiles.
+    /// @property
+    int GetChunkSize() const { return chunkSize_; }
+
     /// Return information.
     /// @property
     const TileMapInfo2D& GetInfo() const { return info_; }
@@ -84,6 +91,8 @@ private:
     SharedPtr<TmxFile2D> tmxFile_;
     /// Tile map information.
     TileMapInfo2D info_{};
+    /// Chunk size in tiles.
+    int chunkSize_{};
     /// Root node for tile map layer.
     SharedPtr<Node> rootNode_;
     /// Tile map layers.
@@ -0,0 +1,208 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Precompiled.h"
+
+#include "../Core/Context.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/Texture2D.h"
+#include "../Scene/Node.h"
+#include "../Urho2D/Renderer2D.h"
+#include "../Urho2D/Sprite2D.h"
+#include "../Urho2D/TileMapChunk2D.h"
+
+#include "../DebugNew.h"
+
+namespace Urho3D
+{
+
+TileMapChunk2D::TileMapChunk2D(Context* context) :
+    Drawable2D(context)
+{
+}
+
+TileMapChunk2D::~TileMapChunk2D() = default;
+
+void TileMapChunk2D::RegisterObject(Context* context)
+{
+    context->AddFactoryReflection<TileMapChunk2D>();
+}
+
+void TileMapChunk2D::Initialize(const TileMapInfo2D& info, const IntVector2& firstTile, const IntVector2& size)
+{
+    info_ = info;
+    firstTile_ = firstTile;
+    size_ = VectorMax(size, IntVector2::ZERO);
+
+    tiles_.clear();
+    tiles_.resize(size_.x_ * size_.y_);
+    tileBatches_.clear();
+    tileBatches_.resize(tiles_.size(), M_MAX_UNSIGNED);
+    batchTextures_.clear();
+    sourceBatches_.clear();
+
+    sourceBatchesDirty_ = true;
+    worldBoundingBoxDirty_ = true;
+}
+
+bool TileMapChunk2D::SetTile(const IntVector2& index, Sprite2D* sprite, bool flipX, bool flipY, bool swapXY)
+{
+    const IntVector2 localIndex = index - firstTile_;
+    if (localIndex.x_ < 0 || localIndex.x_ >= size_.x_ || localIndex.y_ < 0 || localIndex.y_ >= size_.y_)
+        return false;
+
+    const unsigned tileIndex = localIndex.y_ * size_.x_ + localIndex.x_;
+    TileMapChunkTile2D& tile = tiles_[tileIndex];
+    tile.sprite_ = sprite;
+    tile.flipX_ = flipX;
+    tile.flipY_ = flipY;
+    tile.swapXY_ = swapXY;
+
+    // Materials are resolved here because source batches may be updated from worker threads
+    tileBatches_[tileIndex] = sprite ? GetOrCreateBatch(sprite->GetTexture()) : M_MAX_UNSIGNED;
+
+    sourceBatchesDirty_ = true;
+    worldBoundingBoxDirty_ = true;
+    return true;
+}
+
+const TileMapChunkTile2D* TileMapChunk2D::GetTile(const IntVector2& index) const
+{
+    const IntVector2 localIndex = index - firstTile_;
+    if (localIndex.x_ < 0 || localIndex.x_ >= size_.x_ || localIndex.y_ < 0 || localIndex.y_ >= size_.y_)
+        return nullptr;
+
+    return &tiles_[localIndex.y_ * size_.x_ + localIndex.x_];
+}
+
+void TileMapChunk2D::OnSceneSet(Scene* scene)
+{
+    Drawable2D::OnSceneSet(scene);
+
+    UpdateMaterials();
+}
+
+void TileMapChunk2D::OnWorldBoundingBoxUpdate()
+{
+    boundingBox_.Clear();
+    worldBoundingBox_.Clear();
+
+    const ea::vector<SourceBatch2D>& sourceBatches = GetSourceBatches();
+    for (const SourceBatch2D& sourceBatch : sourceBatches)
+    {
+        for (const Vertex2D& vertex : sourceBatch.vertices_)
+            worldBoundingBox_.Merge(vertex.position_);
+    }
+
+    boundingBox_ = worldBoundingBox_.Transformed(node_->GetWorldTransform().Inverse());
+}
+
+void TileMapChunk2D::OnDrawOrderChanged()
+{
+    const int drawOrder = GetDrawOrder();
+    for (SourceBatch2D& sourceBatch : sourceBatches_)
+        sourceBatch.drawOrder_ = drawOrder;
+}
+
+void TileMapChunk2D::UpdateSourceBatches()
+{
+    if (!sourceBatchesDirty_)
+        return;
+
+    for (SourceBatch2D& sourceBatch : sourceBatches_)
+        sourceBatch.vertices_.clear();
+
+    const Matrix3x4& worldTransform = node_->GetWorldTransform();
+    const unsigned color = Color::WHITE.ToUInt();
+
+    Rect drawRect;
+    Rect textureRect;
+    for (int y = 0; y < size_.y_; ++y)
+    {
+        for (int x = 0; x < size_.x_; ++x)
+        {
+            const unsigned tileIndex = y * size_.x_ + x;
+            const TileMapChunkTile2D& tile = tiles_[tileIndex];
+            if (!tile.sprite_ || tileBatches_[tileIndex] == M_MAX_UNSIGNED)
+                continue;
+
+            if (!tile.sprite_->GetDrawRectangle(drawRect, tile.flipX_, tile.flipY_)
+                || !tile.sprite_->GetTextureRectangle(textureRect, tile.flipX_, tile.flipY_))
+                continue;
+
+            const Vector2 position = info_.TileIndexToPosition(firstTile_.x_ + x, firstTile_.y_ + y);
+            drawRect.min_ += position;
+            drawRect.max_ += position;
+
+            // Same layout as in StaticSprite2D
+            Vertex2D vertex0;
+            Vertex2D vertex1;
+            Vertex2D vertex2;
+            Vertex2D vertex3;
+
+            vertex0.position_ = worldTransform * Vector3(drawRect.min_.x_, drawRect.min_.y_, 0.0f);
+            vertex1.position_ = worldTransform * Vector3(drawRect.min_.x_, drawRect.max_.y_, 0.0f);
+            vertex2.position_ = worldTransform * Vector3(drawRect.max_.x_, drawRect.max_.y_, 0.0f);
+            vertex3.position_ = worldTransform * Vector3(drawRect.max_.x_, drawRect.min_.y_, 0.0f);
+
+            vertex0.uv_ = textureRect.min_;
+            (tile.swapXY_ ? vertex3.uv_ : vertex1.uv_) = Vector2(textureRect.min_.x_, textureRect.max_.y_);
+            vertex2.uv_ = textureRect.max_;
+            (tile.swapXY_ ? vertex1.uv_ : vertex3.uv_) = Vector2(textureRect.max_.x_, textureRect.min_.y_);
+
+            vertex0.color_ = vertex1.color_ = vertex2.color_ = vertex3.color_ = color;
+
+            ea::vector<Vertex2D>& vertices = sourceBatches_[tileBatches_[tileIndex]].vertices_;
+            vertices.push_back(vertex0);
+            vertices.push_back(vertex1);
+            vertices.push_back(vertex2);
+            vertices.push_back(vertex3);
+        }
+    }
+
+    sourceBatchesDirty_ = false;
+}
+
+unsigned TileMapChunk2D::GetOrCreateBatch(Texture2D* texture)
+{
+    const auto iter = ea::find(batchTextures_.begin(), batchTextures_.end(), texture);
+    if (iter != batchTextures_.end())
+        return static_cast<unsigned>(iter - batchTextures_.begin());
+
+    SourceBatch2D& sourceBatch = sourceBatches_.emplace_back();
+    sourceBatch.owner_ = this;
+    sourceBatch.drawOrder_ = GetDrawOrder();
+    if (renderer_)
+        sourceBatch.material_ = renderer_->GetMaterial(texture, BLEND_ALPHA);
+
+    batchTextures_.push_back(texture);
+    return batchTextures_.size() - 1;
+}
+
+void TileMapChunk2D::UpdateMaterials()
+{
+    for (unsigned i = 0; i < sourceBatches_.size(); ++i)
+        sourceBatches_[i].material_ = renderer_ ? renderer_->GetMaterial(batchTextures_[i], BLEND_ALPHA) : nullptr;
+}
+
+}
@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Urho2D/Drawable2D.h"
+#include "../Urho2D/TileMapDefs2D.h"
+
+namespace Urho3D
+{
+
+class Sprite2D;
+
+/// Tile stored in tile map chunk.
+struct TileMapChunkTile2D
+{
+    /// Sprite.
+    SharedPtr<Sprite2D> sprite_;
+    /// Flip X.
+    bool flipX_{};
+    /// Flip Y.
+    bool flipY_{};
+    /// Swap X and Y.
+    bool swapXY_{};
+};
+
+/// Rectangular block of tiles of tile map layer rendered as single drawable. Geometry is rebuilt only when tiles or transform change.
+class URHO3D_API TileMapChunk2D : public Drawable2D
+{
+    URHO3D_OBJECT(TileMapChunk2D, Drawable2D);
+
+public:
+    /// Construct.
+    explicit TileMapChunk2D(Context* context);
+    /// Destruct.
+    ~TileMapChunk2D() override;
+    /// Register object factory. Drawable2D must be registered first.
+    /// @nobind
+    static void RegisterObject(Context* context);
+
+    /// Initialize with tile map information, index of first tile in layer and chunk size in tiles. Removes all tiles.
+    void Initialize(const TileMapInfo2D& info, const IntVector2& firstTile, const IntVector2& size);
+    /// Set tile at layer tile index. Null sprite removes the tile. Return false if index is outside of chunk.
+    bool SetTile(const IntVector2& index, Sprite2D* sprite, bool flipX = false, bool flipY = false, bool swapXY = false);
+
+    /// Return tile at layer tile index, or null if index is outside of chunk.
+    const TileMapChunkTile2D* GetTile(const IntVector2& index) const;
+    /// Return index of first tile in layer.
+    const IntVector2& GetFirstTile() const { return firstTile_; }
+    /// Return chunk size in tiles.
+    const IntVector2& GetSize() const { return size_; }
+
+protected:
+    /// Handle scene being assigned.
+    void OnSceneSet(Scene* scene) override;
+    /// Recalculate the world-space bounding box.
+    void OnWorldBoundingBoxUpdate() override;
+    /// Handle draw order changed.
+    void OnDrawOrderChanged() override;
+    /// Update source batches.
+    void UpdateSourceBatches() override;
+
+private:
+    /// Return source batch index for texture, adding new batch if needed.
+    unsigned GetOrCreateBatch(Texture2D* texture);
+    /// Update materials of all source batches.
+    void UpdateMaterials();
+
+    /// Tile map information.
+    TileMapInfo2D info_{};
+    /// Index of first tile in layer.
+    IntVector2 firstTile_;
+    /// Chunk size in tiles.
+    IntVector2 size_;
+    /// Tiles in row-major order.
+    ea::vector<TileMapChunkTile2D> tiles_;
+    /// Source batch index for each tile.
+    ea::vector<unsigned> tileBatches_;
+    /// Texture of each source batch.
+    ea::vector<Texture2D*> batchTextures_;
+};
+
+}
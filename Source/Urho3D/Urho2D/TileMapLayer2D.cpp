@@ -26,8 +26,10 @@
 #include "../Graphics/DebugRenderer.h"
 #include "../Resource/ResourceCache.h"
 #include "../Scene/Node.h"
+#include "../Urho2D/Sprite2D.h"
 #include "../Urho2D/StaticSprite2D.h"
 #include "../Urho2D/TileMap2D.h"
+#include "../Urho2D/TileMapChunk2D.h"
 #include "../Urho2D/TileMapLayer2D.h"
 #include "../Urho2D/TmxFile2D.h"
 
@@ -181,9 +183,12 @@ void TileMapLayer2D::Initialize(TileMap2D* tileMap, const TmxLayer2D* tmxLayer)
         }
 
         nodes_.clear();
+        chunks_.clear();
     }
 
     tileLayer_ = nullptr;
+    chunkSize_ = 0;
+    numChunks_ = IntVector2::ZERO;
     objectGroup_ = nullptr;
     imageLayer_ = nullptr;
 
@@ -230,6 +235,12 @@ void TileMapLayer2D::SetDrawOrder(int drawOrder)
         if (staticSprite)
             staticSprite->SetLayer(drawOrder_);
     }
+
+    for (TileMapChunk2D* chunk : chunks_)
+    {
+        if (chunk)
+            chunk->SetLayer(drawOrder_);
+    }
 }
 
 void TileMapLayer2D::SetVisible(bool visible)
@@ -291,7 +302,7 @@ Tile2D* TileMapLayer2D::GetTile(int x, int y) const
 
 Node* TileMapLayer2D::GetTileNode(int x, int y) const
 {
-    if (!tileLayer_)
+    if (!tileLayer_ || chunkSize_ > 0)
         return nullptr;
 
     if (x < 0 || x >= tileLayer_->GetWidth() || y < 0 || y >= tileLayer_->GetHeight())
@@ -300,6 +311,54 @@ Node* TileMapLayer2D::GetTileNode(int x, int y) const
     return nodes_[y * tileLayer_->GetWidth() + x];
 }
 
+bool TileMapLayer2D::SetTileSprite(int x, int y, Sprite2D* sprite, bool flipX, bool flipY, bool swapXY)
+{
+    if (!tileLayer_)
+        return false;
+
+    if (x < 0 || x >= tileLayer_->GetWidth() || y < 0 || y >= tileLayer_->GetHeight())
+        return false;
+
+    if (chunkSize_ > 0)
+    {
+        TileMapChunk2D* chunk = GetTileChunk(x, y);
+        return chunk && chunk->SetTile(IntVector2(x, y), sprite, flipX, flipY, swapXY);
+    }
+
+    SharedPtr<Node>& tileNode = nodes_[y * tileLayer_->GetWidth() + x];
+    if (!tileNode)
+    {
+        if (sprite)
+            tileNode = CreateTileNode(x, y, sprite, flipX, flipY, swapXY);
+        return true;
+    }
+
+    auto* staticSprite = tileNode->GetComponent<StaticSprite2D>();
+    if (staticSprite)
+    {
+        staticSprite->SetSprite(sprite);
+        staticSprite->SetFlip(flipX, flipY, swapXY);
+    }
+    return true;
+}
+
+Sprite2D* TileMapLayer2D::GetTileSprite(int x, int y) const
+{
+    if (!tileLayer_)
+        return nullptr;
+
+    if (chunkSize_ > 0)
+    {
+        TileMapChunk2D* chunk = GetTileChunk(x, y);
+        const TileMapChunkTile2D* tile = chunk ? chunk->GetTile(IntVector2(x, y)) : nullptr;
+        return tile ? tile->sprite_.Get() : nullptr;
+    }
+
+    Node* tileNode = GetTileNode(x, y);
+    auto* staticSprite = tileNode ? tileNode->GetComponent<StaticSprite2D>() : nullptr;
+    return staticSprite ? staticSprite->GetSprite() : nullptr;
+}
+
 unsigned TileMapLayer2D::GetNumObjects() const
 {
     if (!objectGroup_)
@@ -338,12 +397,18 @@ Node* TileMapLayer2D::GetImageNode() const
 void TileMapLayer2D::SetTileLayer(const TmxTileLayer2D* tileLayer)
 {
     tileLayer_ = tileLayer;
+    chunkSize_ = tileMap_->GetChunkSize();
+
+    if (chunkSize_ > 0)
+    {
+        CreateTileChunks(tileLayer);
+        return;
+    }
 
     int width = tileLayer->GetWidth();
     int height = tileLayer->GetHeight();
     nodes_.resize((unsigned) (width * height));
 
-    const TileMapInfo2D& info = tileMap_->GetInfo();
     for (int y = 0; y < height; ++y)
     {
         for (int x = 0; x < width; ++x)
@@ -352,20 +417,83 @@ void TileMapLayer2D::SetTileLayer(const TmxTileLayer2D* tileLayer)
             if (!tile)
                 continue;
 
-            SharedPtr<Node> tileNode(GetNode()->CreateTemporaryChild("Tile"));
-            tileNode->SetPosition(info.TileIndexToPosition(x, y).ToVector3());
+            nodes_[y * width + x] = CreateTileNode(x, y, tile->GetSprite(), tile->GetFlipX(), tile->GetFlipY(), tile->GetSwapXY());
+        }
+    }
+}
 
-            auto* staticSprite = tileNode->CreateComponent<StaticSprite2D>();
-            staticSprite->SetSprite(tile->GetSprite());
-            staticSprite->SetFlip(tile->GetFlipX(), tile->GetFlipY(), tile->GetSwapXY());
-            staticSprite->SetLayer(drawOrder_);
-            staticSprite->SetOrderInLayer(y * width + x);
+Node* TileMapLayer2D::CreateTileNode(int x, int y, Sprite2D* sprite, bool flipX, bool flipY, bool swapXY)
+{
+    const TileMapInfo2D& info = tileMap_->GetInfo();
+
+    Node* tileNode = GetNode()->CreateTemporaryChild("Tile");
+    tileNode->SetPosition(info.TileIndexToPosition(x, y).ToVector3());
+    tileNode->SetEnabled(visible_);
 
-            nodes_[y * width + x] = tileNode;
+    auto* staticSprite = tileNode->CreateComponent<StaticSprite2D>();
+    staticSprite->SetSprite(sprite);
+    staticSprite->SetFlip(flipX, flipY, swapXY);
+    staticSprite->SetLayer(drawOrder_);
+    staticSprite->SetOrderInLayer(y * tileLayer_->GetWidth() + x);
+
+    return tileNode;
+}
+
+void TileMapLayer2D::CreateTileChunks(const TmxTileLayer2D* tileLayer)
+{
+    const int width = tileLayer->GetWidth();
+    const int height = tileLayer->GetHeight();
+    numChunks_ = IntVector2((width + chunkSize_ - 1) / chunkSize_, (height + chunkSize_ - 1) / chunkSize_);
+
+    nodes_.resize(numChunks_.x_ * numChunks_.y_);
+    chunks_.resize(numChunks_.x_ * numChunks_.y_);
+
+    const TileMapInfo2D& info = tileMap_->GetInfo();
+    for (int chunkY = 0; chunkY < numChunks_.y_; ++chunkY)
+    {
+        for (int chunkX = 0; chunkX < numChunks_.x_; ++chunkX)
+        {
+            const IntVector2 firstTile{chunkX * chunkSize_, chunkY * chunkSize_};
+            const IntVector2 size{Min(chunkSize_, width - firstTile.x_), Min(chunkSize_, height - firstTile.y_)};
+            const unsigned chunkIndex = chunkY * numChunks_.x_ + chunkX;
+
+            SharedPtr<Node> chunkNode(GetNode()->CreateTemporaryChild("TileChunk"));
+            chunkNode->SetEnabled(visible_);
+
+            auto* chunk = chunkNode->CreateComponent<TileMapChunk2D>();
+            chunk->Initialize(info, firstTile, size);
+            chunk->SetLayer(drawOrder_);
+            chunk->SetOrderInLayer(chunkIndex);
+
+            for (int y = firstTile.y_; y < firstTile.y_ + size.y_; ++y)
+            {
+                for (int x = firstTile.x_; x < firstTile.x_ + size.x_; ++x)
+                {
+                    const Tile2D* tile = tileLayer->GetTile(x, y);
+                    if (tile)
+                        chunk->SetTile(IntVector2(x, y), tile->GetSprite(), tile->GetFlipX(), tile->GetFlipY(), tile->GetSwapXY());
+                }
+            }
+
+            nodes_[chunkIndex] = chunkNode;
+            chunks_[chunkIndex] = chunk;
         }
     }
 }
 
+TileMapChunk2D* TileMapLayer2D::GetTileChunk(int x, int y) const
+{
+    if (chunkSize_ <= 0 || x < 0 || y < 0)
+        return nullptr;
+
+    const int chunkX = x / chunkSize_;
+    const int chunkY = y / chunkSize_;
+    if (chunkX >= numChunks_.x_ || chunkY >= numChunks_.y_)
+        return nullptr;
+
+    return chunks_[chunkY * numChunks_.x_ + chunkX];
+}
+
 void TileMapLayer2D::SetObjectGroup(const TmxObjectGroup2D* objectGroup)
 {
     objectGroup_ = objectGroup;
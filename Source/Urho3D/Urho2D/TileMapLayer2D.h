@@ -34,7 +34,9 @@ namespace Urho3D
 
 class DebugRenderer;
 class Node;
+class Sprite2D;
 class TileMap2D;
+class TileMapChunk2D;
 class TmxImageLayer2D;
 class TmxLayer2D;
 class TmxObjectGroup2D;
@@ -94,10 +96,17 @@ public:
     /// Return height (for tile layer only).
     /// @property
     int GetHeight() const;
-    /// Return tile node (for tile layer only).
+    /// Return tile node (for tile layer only). Always null if the layer is split into chunks.
     Node* GetTileNode(int x, int y) const;
-    /// Return tile (for tile layer only).
+    /// Return tile (for tile layer only). Describes the tile as loaded from tmx file and doesn't reflect tile sprite changes.
     Tile2D* GetTile(int x, int y) const;
+    /// Set tile sprite (for tile layer only). Null sprite removes the tile. Return false if tile index is out of layer.
+    bool SetTileSprite(int x, int y, Sprite2D* sprite, bool flipX = false, bool flipY = false, bool swapXY = false);
+    /// Return current tile sprite (for tile layer only).
+    Sprite2D* GetTileSprite(int x, int y) const;
+    /// Return chunk size in tiles (for tile layer only). Zero if every tile is a separate node.
+    /// @property
+    int GetChunkSize() const { return chunkSize_; }
 
     /// Return number of tile map objects (for object group only).
     /// @property
@@ -114,6 +123,12 @@ public:
 private:
     /// Set tile layer.
     void SetTileLayer(const TmxTileLayer2D* tileLayer);
+    /// Create tile node at tile index.
+    Node* CreateTileNode(int x, int y, Sprite2D* sprite, bool flipX, bool flipY, bool swapXY);
+    /// Create tile chunks for tile layer.
+    void CreateTileChunks(const TmxTileLayer2D* tileLayer);
+    /// Return chunk containing tile.
+    TileMapChunk2D* GetTileChunk(int x, int y) const;
     /// Set object group.
     void SetObjectGroup(const TmxObjectGroup2D* objectGroup);
     /// Set image layer.
@@ -135,6 +150,12 @@ private:
     bool visible_{true};
     /// Tile node or image nodes.
     ea::vector<SharedPtr<Node> > nodes_;
+    /// Chunk size in tiles (for tile layer only).
+    int chunkSize_{};
+    /// Number of chunks in each dimension.
+    IntVector2 numChunks_;
+    /// Tile chunks in row-major order.
+    ea::vector<WeakPtr<TileMapChunk2D> > chunks_;
 };
 
 }
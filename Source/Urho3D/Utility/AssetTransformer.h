@@ -114,6 +114,8 @@ public:
     virtual bool IsSingleInstanced() { return true; }
     /// Return whether to execute this transformer on the output of the other transformer.
     virtual bool IsExecutedOnOutput() { return false; }
+    /// Return version of the transformer output. Should be incremented when the output changes for the same input.
+    virtual unsigned GetVersion() const { return 1; }
 
     /// Manage requirement flavor of the transformer.
     /// @{
@@ -26,10 +26,12 @@
 #include "../Core/Context.h"
 #include "../Core/Exception.h"
 #include "../Core/StringUtils.h"
+#include "../Core/WorkQueue.h"
 #include "../Graphics/AnimatedModel.h"
 #include "../Graphics/Animation.h"
 #include "../Graphics/AnimationController.h"
 #include "../Graphics/AnimationTrack.h"
+#include "../Graphics/GeometryOptimizer.h"
 #include "../Graphics/Light.h"
 #include "../Graphics/Material.h"
 #include "../Graphics/Model.h"
@@ -380,6 +382,38 @@ public:
     const GLTFImporterSettings& GetSettings() const { return settings_; }
     const GLTFImporter::ResourceToFileNameMap& GetResourceNames() const { return resourceNameToAbsoluteFileName_; }
 
+    /// Execute independent conversions in worker threads. Exceptions are rethrown in index order.
+    template <class Callback>
+    void ForEachParallel(unsigned size, const Callback& callback) const
+    {
+        ea::vector<std::exception_ptr> exceptions(size);
+        const auto processRange = [&](unsigned beginIndex, unsigned endIndex)
+        {
+            for (unsigned index = beginIndex; index < endIndex; ++index)
+            {
+                try
+                {
+                    callback(index);
+                }
+                catch (...)
+                {
+                    exceptions[index] = std::current_exception();
+                }
+            }
+        };
+
+        if (auto workQueue = context_->GetSubsystem<WorkQueue>())
+            Urho3D::ForEachParallel(workQueue, 1u, size, processRange);
+        else
+            processRange(0, size);
+
+        for (const std::exception_ptr& exception : exceptions)
+        {
+            if (exception)
+                std::rethrow_exception(exception);
+        }
+    }
+
     void CheckAnimation(int index) const { CheckT(index, model_.animations, "Invalid animation #{} referenced"); }
     void CheckAccessor(int index) const { CheckT(index, model_.accessors, "Invalid accessor #{} referenced"); }
     void CheckBufferView(int index) const { CheckT(index, model_.bufferViews, "Invalid buffer view #{} referenced"); }
@@ -1887,13 +1921,19 @@ public:
             throw RuntimeException("Textures are already cooking");
 
         texturesCooked_ = true;
-        for (auto& [indices, texture] : texturesMRO_)
+
+        ea::vector<ea::pair<const ea::pair<int, int>, ImportedRMOTexture>*> texturesToCook;
+        for (auto& elem : texturesMRO_)
+            texturesToCook.push_back(&elem);
+
+        base_.ForEachParallel(texturesToCook.size(), [&](unsigned index)
         {
+            auto& [indices, texture] = *texturesToCook[index];
             const auto [metallicRoughnessTextureIndex, occlusionTextureIndex] = indices;
 
             texture.repackedImage_ = ImportRMOTexture(metallicRoughnessTextureIndex, occlusionTextureIndex,
                 texture.fakeTexture_->GetName());
-        }
+        });
     }
 
     void SaveResources()
@@ -2203,7 +2243,7 @@ private:
     }
 
     SharedPtr<Image> ImportRMOTexture(
-        int metallicRoughnessTextureIndex, int occlusionTextureIndex, const ea::string& name)
+        int metallicRoughnessTextureIndex, int occlusionTextureIndex, const ea::string& name) const
     {
         // Unpack input images
         SharedPtr<Image> metallicRoughnessImage = metallicRoughnessTextureIndex >= 0
@@ -2305,6 +2345,9 @@ public:
     {
         base_.CheckMaterial(materialIndex);
         const SharedPtr<Material> material = materials_[materialIndex].variants_[variant];
+
+        // Called from worker threads during model import
+        MutexLock lock(referencedMaterialsMutex_);
         referencedMaterials_.insert(material);
         return material;
     }
@@ -2588,6 +2631,7 @@ private:
     };
 
     ea::vector<ImportedMaterial> materials_;
+    Mutex referencedMaterialsMutex_;
     ea::unordered_set<SharedPtr<Material>> referencedMaterials_;
 };
 
@@ -2643,7 +2687,8 @@ private:
 
     void InitializeModels()
     {
-        for (const GLTFMeshSkinPairPtr& pair : hierarchyAnalyzer_.GetUniqueMeshSkinPairs())
+        const auto& meshSkinPairs = hierarchyAnalyzer_.GetUniqueMeshSkinPairs();
+        for (const GLTFMeshSkinPairPtr& pair : meshSkinPairs)
         {
             const tg::Mesh& sourceMesh = model_.meshes[pair->mesh_];
 
@@ -2654,9 +2699,14 @@ private:
             const auto [baseName, distance] = ParseLodDistance(model.meshName_);
             model.baseMeshName_ = baseName;
             model.lodDistance_ = distance;
-
-            model.modelView_ = ImportModelView(sourceMesh, hierarchyAnalyzer_.GetSkinBones(pair->skin_));
         }
+
+        base_.ForEachParallel(models_.size(), [&](unsigned index)
+        {
+            const GLTFMeshSkinPair& pair = *meshSkinPairs[index];
+            const tg::Mesh& sourceMesh = model_.meshes[pair.mesh_];
+            models_[index].modelView_ = ImportModelView(sourceMesh, hierarchyAnalyzer_.GetSkinBones(pair.skin_));
+        });
     }
 
     void CombineLODs()
@@ -2858,9 +2908,39 @@ private:
         modelView->RecalculateBoneBoundingBoxes();
         modelView->RepairBoneWeights();
         modelView->Normalize();
+
+        OptimizeGeometries(modelView);
         return modelView;
     }
 
+    void OptimizeGeometries(ModelView* modelView) const
+    {
+        const GLTFImporterSettings& settings = base_.GetSettings();
+        for (GeometryView& geometryView : modelView->GetGeometries())
+        {
+            for (GeometryLODView& geometryLODView : geometryView.lods_)
+            {
+                if (settings.optimizeGeometry_)
+                {
+                    RemoveDuplicateVertices(geometryLODView);
+                    OptimizeVertexCache(geometryLODView);
+                }
+
+                // Meshlets override triangle order but keep it coherent
+                if (settings.buildMeshlets_)
+                    BuildMeshlets(geometryLODView, settings.meshletTriangles_);
+
+                if (settings.optimizeGeometry_)
+                    OptimizeVertexFetch(geometryLODView);
+                if (settings.compactVertexFormat_)
+                    UseCompactVertexFormat(geometryLODView);
+            }
+        }
+
+        if (settings.buildMeshlets_)
+            modelView->AddMetadata("MeshletTriangles", settings.meshletTriangles_);
+    }
+
     static GLTFMaterialImporter::MaterialVariant GetMaterialVariant(const GeometryLODView& lodView)
     {
         if (lodView.IsTriangleGeometry() || lodView.vertexFormat_.tangent_ != ModelVertexFormat::Undefined)
@@ -3070,6 +3150,16 @@ private:
 
     void ImportAnimations()
     {
+        struct AnimationToImport
+        {
+            AnimationKey key_;
+            ea::string name_;
+            const GLTFAnimationTrackGroup* group_{};
+            SharedPtr<Animation> animation_;
+        };
+
+        // Assign names first so they don't depend on the order of parallel import
+        ea::vector<AnimationToImport> animationsToImport;
         const unsigned numAnimations = base_.GetModel().animations.size();
         for (unsigned animationIndex = 0; animationIndex < numAnimations; ++animationIndex)
         {
@@ -3078,25 +3168,36 @@ private:
             {
                 const ea::string animationNameHint = GetAnimationGroupName(sourceAnimation, groupIndex);
                 const ea::string animationName = base_.GetResourceName(animationNameHint, "Animations/", "Animation", ".ani");
+                animationsToImport.push_back({{animationIndex, groupIndex}, animationName, &group});
+            }
+        }
 
-                auto animation = ImportAnimation(animationName, group);
+        base_.ForEachParallel(animationsToImport.size(), [&](unsigned index)
+        {
+            AnimationToImport& item = animationsToImport[index];
+            item.animation_ = ImportAnimation(item.name_, *item.group_);
+        });
 
-                if (groupIndex)
+        for (const AnimationToImport& item : animationsToImport)
+        {
+            const auto& [animationIndex, groupIndex] = item.key_;
+            Animation* animation = item.animation_;
+
+            if (groupIndex)
+            {
+                const GLTFSkeleton& skeleton = hierarchyAnalyzer_.GetSkeleton(*groupIndex);
+                if (!skeleton.rootNode_->skinnedMeshNodes_.empty())
                 {
-                    const GLTFSkeleton& skeleton = hierarchyAnalyzer_.GetSkeleton(*groupIndex);
-                    if (!skeleton.rootNode_->skinnedMeshNodes_.empty())
-                    {
-                        const GLTFNode& skinnedMeshNode = hierarchyAnalyzer_.GetNode(skeleton.rootNode_->skinnedMeshNodes_[0]);
-                        if (Model* model = modelImporter_.GetModel(*skinnedMeshNode.mesh_, *skinnedMeshNode.skin_))
-                            animation->AddMetadata("Model", model->GetName());
-                    }
+                    const GLTFNode& skinnedMeshNode = hierarchyAnalyzer_.GetNode(skeleton.rootNode_->skinnedMeshNodes_[0]);
+                    if (Model* model = modelImporter_.GetModel(*skinnedMeshNode.mesh_, *skinnedMeshNode.skin_))
+                        animation->AddMetadata("Model", model->GetName());
                 }
-
-                base_.AddToResourceCache(animation);
-                animations_[{ animationIndex, groupIndex }] = animation;
-                if (!groupIndex)
-                    hasSceneAnimations_ = true;
             }
+
+            base_.AddToResourceCache(animation);
+            animations_[item.key_] = item.animation_;
+            if (!groupIndex)
+                hasSceneAnimations_ = true;
         }
     }
 
@@ -3183,6 +3284,9 @@ private:
                 animation->AddMetadata("FrameRate", frameRate);
         }
 
+        if (base_.GetSettings().compressAnimations_)
+            animation->Compress(base_.GetSettings().animationCompression_);
+
         return animation;
     }
 
@@ -3737,6 +3841,17 @@ void SerializeValue(Archive& archive, const char* name, GLTFImporterSettings& va
     SerializeValue(archive, "offsetMatrixError", value.offsetMatrixError_);
     SerializeValue(archive, "keyFrameTimeError", value.keyFrameTimeError_);
 
+    SerializeValue(archive, "compressAnimations", value.compressAnimations_);
+    SerializeValue(archive, "animationPositionError", value.animationCompression_.positionError_);
+    SerializeValue(archive, "animationRotationError", value.animationCompression_.rotationError_);
+    SerializeValue(archive, "animationScaleError", value.animationCompression_.scaleError_);
+
+    SerializeValue(archive, "optimizeGeometry", value.optimizeGeometry_);
+    SerializeValue(archive, "compactVertexFormat", value.compactVertexFormat_);
+
+    SerializeValue(archive, "buildMeshlets", value.buildMeshlets_);
+    SerializeValue(archive, "meshletTriangles", value.meshletTriangles_);
+
     SerializeValue(archive, "addLights", value.preview_.addLights_);
     SerializeValue(archive, "addSkybox", value.preview_.addSkybox_);
     SerializeValue(archive, "skyboxMaterial", value.preview_.skyboxMaterial_);
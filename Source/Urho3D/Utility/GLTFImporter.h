@@ -25,6 +25,8 @@
 #pragma once
 
 #include "../Core/Object.h"
+#include "../Graphics/AnimationTrack.h"
+#include "../Graphics/Meshlet.h"
 #include "../IO/Archive.h"
 
 #include <EASTL/unique_ptr.h>
@@ -55,6 +57,19 @@ struct GLTFImporterSettings
     float offsetMatrixError_{0.00002f};
     float keyFrameTimeError_{M_EPSILON};
 
+    /// Whether to store bone tracks of imported animations in compressed form.
+    bool compressAnimations_{false};
+    AnimationCompressionSettings animationCompression_;
+
+    /// Whether to remove duplicate vertices and optimize vertex cache and vertex fetch of imported models.
+    bool optimizeGeometry_{false};
+    /// Whether to store normals, tangents and UVs of imported models in compact vertex formats.
+    bool compactVertexFormat_{false};
+
+    /// Whether to reorder triangles of imported models into spatially coherent meshlets.
+    bool buildMeshlets_{false};
+    unsigned meshletTriangles_{DEFAULT_MESHLET_TRIANGLES};
+
     /// Settings that affect only preview scene.
     struct PreviewSettings
     {
@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Utility/MaterialCompiler.h"
+
+#include "../Graphics/MaterialDesc.h"
+#include "../IO/File.h"
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+#include "../Resource/JSONFile.h"
+#include "../Resource/XMLFile.h"
+
+namespace Urho3D
+{
+
+MaterialCompiler::MaterialCompiler(Context* context)
+    : AssetTransformer(context)
+{
+}
+
+MaterialCompiler::~MaterialCompiler()
+{
+}
+
+void MaterialCompiler::RegisterObject(Context* context)
+{
+    context->RegisterFactory<MaterialCompiler>(Category_Transformer);
+}
+
+bool MaterialCompiler::IsApplicable(const AssetTransformerInput& input)
+{
+    const ea::string extension = GetExtension(input.inputFileName_);
+    return extension == ".xml" || extension == ".json";
+}
+
+bool MaterialCompiler::Execute(
+    const AssetTransformerInput& input, AssetTransformerOutput& output, const AssetTransformerVector& transformers)
+{
+    // Materials don't have dedicated extension, so check the contents
+    MaterialDesc desc;
+    const ea::string extension = GetExtension(input.inputFileName_);
+    if (extension == ".xml")
+    {
+        XMLFile xmlFile(context_);
+        if (!xmlFile.LoadFile(input.inputFileName_))
+            return false;
+
+        const XMLElement rootElem = xmlFile.GetRoot();
+        if (rootElem.GetName() != "material" || !desc.LoadXML(context_, rootElem))
+            return false;
+    }
+    else
+    {
+        JSONFile jsonFile(context_);
+        if (!jsonFile.LoadFile(input.inputFileName_))
+            return false;
+
+        const JSONValue& rootVal = jsonFile.GetRoot();
+        if (!rootVal.Contains("techniques") || !desc.LoadJSON(context_, rootVal))
+            return false;
+    }
+
+    auto fs = GetSubsystem<FileSystem>();
+    fs->CreateDirsRecursive(GetPath(input.outputFileName_));
+
+    // Material detects binary format by the file header, so the file extension is kept
+    File file(context_, input.outputFileName_, FILE_WRITE);
+    if (!file.IsOpen() || !desc.SaveBinary(context_, file))
+    {
+        URHO3D_LOGERROR("Failed to compile material '{}'", input.resourceName_);
+        return false;
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,150 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Utility/ModelLODGenerator.h"
+
+#include "../Graphics/GeometryOptimizer.h"
+#include "../Graphics/ModelView.h"
+#include "../IO/Log.h"
+#include "../Resource/ResourceCache.h"
+
+namespace Urho3D
+{
+
+const VariantVector ModelLODGenerator::DefaultRatios{0.5f, 0.25f, 0.125f};
+const VariantVector ModelLODGenerator::DefaultScreenSizes{0.5f, 0.25f, 0.1f};
+
+ModelLODGenerator::ModelLODGenerator(Context* context)
+    : AssetTransformer(context)
+{
+}
+
+ModelLODGenerator::~ModelLODGenerator()
+{
+}
+
+void ModelLODGenerator::RegisterObject(Context* context)
+{
+    context->RegisterFactory<ModelLODGenerator>(Category_Transformer);
+
+    URHO3D_ATTRIBUTE("Ratios", VariantVector, ratios_, DefaultRatios, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Screen Sizes", VariantVector, screenSizes_, DefaultScreenSizes, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Max Error", float, maxError_, DefaultMaxError, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Field Of View", float, fieldOfView_, DefaultFieldOfView, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Optimize Indices", bool, optimizeIndices_, true, AM_DEFAULT);
+}
+
+bool ModelLODGenerator::IsApplicable(const AssetTransformerInput& input)
+{
+    return input.inputFileName_.ends_with(".mdl", false);
+}
+
+bool ModelLODGenerator::Execute(
+    const AssetTransformerInput& input, AssetTransformerOutput& output, const AssetTransformerVector& transformers)
+{
+    auto cache = GetSubsystem<ResourceCache>();
+    auto model = cache->GetResource<Model>(input.resourceName_);
+    if (!model)
+        return false;
+
+    auto modelView = MakeShared<ModelView>(context_);
+    if (!modelView->ImportModel(model))
+        return false;
+
+    if (!Process(modelView))
+        return true;
+
+    modelView->ExportModel(model);
+    return model->SaveFile(model->GetAbsoluteFileName());
+}
+
+bool ModelLODGenerator::Process(ModelView* modelView) const
+{
+    BoundingBox boundingBox;
+    for (const GeometryView& geometry : modelView->GetGeometries())
+    {
+        for (const GeometryLODView& lod : geometry.lods_)
+        {
+            for (const ModelVertex& vertex : lod.vertices_)
+                boundingBox.Merge(vertex.GetPosition());
+        }
+    }
+    if (!boundingBox.Defined())
+        return false;
+
+    // Model of given radius occupies given fraction of screen height at distance radius / (fraction * tan(fov / 2))
+    const float radius = boundingBox.HalfSize().Length();
+    const float maxError = maxError_ * radius;
+    const float tanHalfFov = Tan(fieldOfView_ * 0.5f);
+    const unsigned numLods = Min(ratios_.size(), screenSizes_.size());
+
+    bool changed = false;
+    for (GeometryView& geometry : modelView->GetGeometries())
+    {
+        if (geometry.lods_.size() == 1 && geometry.lods_[0].IsTriangleGeometry())
+        {
+            const GeometryLODView sourceLod = geometry.lods_[0];
+            const unsigned numSourceTriangles = sourceLod.GetNumPrimitives();
+            unsigned numPreviousTriangles = numSourceTriangles;
+            for (unsigned i = 0; i < numLods; ++i)
+            {
+                const float ratio = ratios_[i].GetFloat();
+                const float screenSize = screenSizes_[i].GetFloat();
+                if (ratio <= 0.0f || ratio >= 1.0f || screenSize <= 0.0f)
+                {
+                    URHO3D_LOGWARNING("Invalid LOD #{}: ratio {} and screen size {} are ignored", i, ratio, screenSize);
+                    continue;
+                }
+
+                const auto targetTriangles = static_cast<unsigned>(numSourceTriangles * ratio);
+                GeometryLODView lod = SimplifyGeometry(sourceLod, targetTriangles, maxError);
+
+                // Stop if simplification is limited by error and the LOD is not much simpler than the previous one
+                const unsigned numTriangles = lod.GetNumPrimitives();
+                if (numTriangles == 0 || numTriangles > numPreviousTriangles * 0.9f)
+                    break;
+
+                lod.lodDistance_ = radius / (screenSize * tanHalfFov);
+                geometry.lods_.push_back(ea::move(lod));
+                numPreviousTriangles = numTriangles;
+                changed = true;
+            }
+        }
+
+        if (optimizeIndices_)
+        {
+            for (GeometryLODView& lod : geometry.lods_)
+            {
+                if (!lod.IsTriangleGeometry())
+                    continue;
+
+                OptimizeVertexCache(lod);
+                OptimizeOverdraw(lod);
+                changed = true;
+            }
+        }
+    }
+    return changed;
+}
+
+}
@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Graphics/Model.h"
+#include "../Utility/AssetTransformer.h"
+
+namespace Urho3D
+{
+
+class ModelView;
+
+/// Asset transformer that generates LOD chains of models and optimizes their index buffers.
+/// Each LOD keeps given ratio of triangles of the original geometry and is switched to
+/// when the model occupies less than given fraction of screen height.
+/// Geometries that already have LODs are only optimized.
+class URHO3D_API ModelLODGenerator : public AssetTransformer
+{
+    URHO3D_OBJECT(ModelLODGenerator, AssetTransformer);
+
+public:
+    static constexpr float DefaultMaxError = 0.02f;
+    static constexpr float DefaultFieldOfView = 45.0f;
+    static const VariantVector DefaultRatios;
+    static const VariantVector DefaultScreenSizes;
+
+    ModelLODGenerator(Context* context);
+    ~ModelLODGenerator() override;
+    static void RegisterObject(Context* context);
+
+    /// Generate LODs and optimize geometries of the model view. Return whether the model was changed.
+    bool Process(ModelView* modelView) const;
+
+    bool IsApplicable(const AssetTransformerInput& input) override;
+    bool Execute(const AssetTransformerInput& input, AssetTransformerOutput& output,
+        const AssetTransformerVector& transformers) override;
+    bool IsExecutedOnOutput() override { return true; }
+
+    /// Attributes.
+    /// @{
+    void SetRatios(const VariantVector& ratios) { ratios_ = ratios; }
+    const VariantVector& GetRatios() const { return ratios_; }
+    void SetScreenSizes(const VariantVector& screenSizes) { screenSizes_ = screenSizes; }
+    const VariantVector& GetScreenSizes() const { return screenSizes_; }
+    void SetMaxError(float maxError) { maxError_ = maxError; }
+    float GetMaxError() const { return maxError_; }
+    void SetOptimizeIndices(bool optimize) { optimizeIndices_ = optimize; }
+    bool GetOptimizeIndices() const { return optimizeIndices_; }
+    /// @}
+
+private:
+    /// Ratios of triangles kept in each LOD.
+    VariantVector ratios_{DefaultRatios};
+    /// Fractions of screen height occupied by the model below which each LOD is used.
+    VariantVector screenSizes_{DefaultScreenSizes};
+    /// Max simplification error relative to the model radius.
+    float maxError_{DefaultMaxError};
+    /// Vertical field of view used to convert screen sizes to LOD distances.
+    float fieldOfView_{DefaultFieldOfView};
+    /// Whether to optimize index buffers for vertex cache and overdraw.
+    bool optimizeIndices_{true};
+};
+
+}
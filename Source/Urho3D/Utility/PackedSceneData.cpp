@@ -91,6 +91,16 @@ Node* PackedNodeData::SpawnCopy(Node* parent) const
     return node;
 }
 
+bool PackedNodeData::operator==(const PackedNodeData& rhs) const
+{
+    return id_ == rhs.id_
+        && parentId_ == rhs.parentId_
+        && indexInParent_ == rhs.indexInParent_
+        && scopeHint_ == rhs.scopeHint_
+        && name_ == rhs.name_
+        && data_.GetBuffer() == rhs.data_.GetBuffer();
+}
+
 PackedComponentData::PackedComponentData(Component* component)
     : id_(component->GetID())
     , nodeId_(component->GetNode() ? component->GetNode()->GetID() : 0)
@@ -51,6 +51,12 @@ public:
     /// Return whether the node spawn would affect the entire scene.
     /// Used to correctly handle undo/redo of node creation.
     AttributeScopeHint GetEffectiveScopeHint() const { return scopeHint_; }
+    /// Return approximate memory used by the data, in bytes.
+    unsigned GetMemoryUsage() const { return sizeof(*this) + name_.size() + data_.GetSize(); }
+
+    /// Compare packed data.
+    bool operator==(const PackedNodeData& rhs) const;
+    bool operator!=(const PackedNodeData& rhs) const { return !(*this == rhs); }
 
 private:
     unsigned id_{};
@@ -77,6 +83,8 @@ public:
     /// Return component ID.
     unsigned GetId() const { return id_; }
     StringHash GetType() const { return type_; }
+    /// Return approximate memory used by the data, in bytes.
+    unsigned GetMemoryUsage() const { return sizeof(*this) + data_.GetSize(); }
 
 private:
     unsigned id_{};
@@ -148,6 +156,7 @@ public:
     /// @{
     const VectorBuffer& GetSceneData() const { return sceneData_; }
     bool HasSceneData() const { return sceneData_.GetSize() > 0; }
+    unsigned GetMemoryUsage() const { return sizeof(*this) + sceneData_.GetSize(); }
     /// @}
 
 private:
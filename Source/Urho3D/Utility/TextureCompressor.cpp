@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#include "../Precompiled.h"
+
+#include "../Utility/TextureCompressor.h"
+
+#include "../IO/File.h"
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+const char* textureCompressionFamilyNames[] = {
+    "Auto",
+    "BC",
+    "ETC",
+    nullptr
+};
+
+bool HasPlatformType(const ApplicationFlavor& flavor, const ea::string& type)
+{
+    const auto iter = flavor.components_.find("platform");
+    return iter != flavor.components_.end() && iter->second.contains(type);
+}
+
+bool IsImageOpaque(const Image& image)
+{
+    if (!image.HasAlphaChannel())
+        return true;
+
+    const unsigned numPixels = image.GetWidth() * image.GetHeight() * image.GetDepth();
+    const unsigned components = image.GetComponents();
+    const unsigned char* data = image.GetData();
+    for (unsigned i = 0; i < numPixels; ++i)
+    {
+        if (data[i * components + components - 1] != 255)
+            return false;
+    }
+    return true;
+}
+
+}
+
+TextureCompressor::TextureCompressor(Context* context)
+    : AssetTransformer(context)
+{
+}
+
+TextureCompressor::~TextureCompressor()
+{
+}
+
+void TextureCompressor::RegisterObject(Context* context)
+{
+    context->RegisterFactory<TextureCompressor>(Category_Transformer);
+
+    URHO3D_ENUM_ATTRIBUTE("Family", family_, textureCompressionFamilyNames, TextureCompressionFamily::Auto, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Mipmaps", bool, mipmaps_, true, AM_DEFAULT);
+}
+
+CompressedFormat TextureCompressor::GetCompressedFormat(const ApplicationFlavor& flavor, bool isOpaque) const
+{
+    TextureCompressionFamily family = family_;
+    if (family == TextureCompressionFamily::Auto)
+    {
+        if (HasPlatformType(flavor, "desktop"))
+            family = TextureCompressionFamily::BC;
+        else if (HasPlatformType(flavor, "mobile"))
+            family = TextureCompressionFamily::ETC;
+        else
+            return CF_NONE;
+    }
+
+    if (family == TextureCompressionFamily::BC)
+        return isOpaque ? CF_DXT1 : CF_DXT5;
+    else
+        return isOpaque ? CF_ETC1 : CF_ETC2_RGBA;
+}
+
+bool TextureCompressor::IsApplicable(const AssetTransformerInput& input)
+{
+    const ea::string extension = GetExtension(input.inputFileName_);
+    if (extension != ".png" && extension != ".jpg" && extension != ".jpeg" && extension != ".tga"
+        && extension != ".bmp")
+        return false;
+
+    return GetCompressedFormat(input.flavor_, true) != CF_NONE;
+}
+
+bool TextureCompressor::Execute(
+    const AssetTransformerInput& input, AssetTransformerOutput& output, const AssetTransformerVector& transformers)
+{
+    auto image = MakeShared<Image>(context_);
+    if (!image->LoadFile(input.inputFileName_))
+        return false;
+
+    if (image->IsCompressed() || image->GetDepth() > 1 || image->IsCubemap() || image->IsArray())
+        return false;
+
+    const CompressedFormat format = GetCompressedFormat(input.flavor_, IsImageOpaque(*image));
+    if (format == CF_NONE)
+        return false;
+
+    auto fs = GetSubsystem<FileSystem>();
+    fs->CreateDirsRecursive(GetPath(input.outputFileName_));
+
+    // Image detects DDS by the file header, so the file extension is kept
+    File file(context_, input.outputFileName_, FILE_WRITE);
+    if (!file.IsOpen() || !image->SaveCompressedDDS(file, format, mipmaps_))
+    {
+        URHO3D_LOGERROR("Failed to compress image '{}'", input.resourceName_);
+        return false;
+    }
+
+    return true;
+}
+
+}
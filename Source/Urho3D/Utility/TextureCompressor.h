@@ -0,0 +1,77 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+#pragma once
+
+#include "../Resource/Image.h"
+#include "../Utility/AssetTransformer.h"
+
+namespace Urho3D
+{
+
+/// Family of GPU compressed texture formats.
+enum class TextureCompressionFamily
+{
+    /// BC for desktop and ETC for mobile flavors. Images are not compressed for other flavors.
+    Auto,
+    /// DXT1 for opaque and DXT5 for transparent images.
+    BC,
+    /// ETC1 for opaque and ETC2 RGBA for transparent images.
+    ETC,
+};
+
+/// Asset transformer that compresses source images into GPU formats with mip levels.
+/// Compressed image is saved in DDS format under the same resource name as the source image,
+/// so materials and texture parameter files don't need to be changed.
+/// Configure instances with different flavors in the asset pipeline to select formats per platform.
+class URHO3D_API TextureCompressor : public AssetTransformer
+{
+    URHO3D_OBJECT(TextureCompressor, AssetTransformer);
+
+public:
+    TextureCompressor(Context* context);
+    ~TextureCompressor() override;
+    static void RegisterObject(Context* context);
+
+    /// Return compressed format used for the image. Return CF_NONE if the image should not be compressed.
+    CompressedFormat GetCompressedFormat(const ApplicationFlavor& flavor, bool isOpaque) const;
+
+    bool IsApplicable(const AssetTransformerInput& input) override;
+    bool Execute(const AssetTransformerInput& input, AssetTransformerOutput& output,
+        const AssetTransformerVector& transformers) override;
+
+    /// Attributes.
+    /// @{
+    void SetFamily(TextureCompressionFamily family) { family_ = family; }
+    TextureCompressionFamily GetFamily() const { return family_; }
+    void SetMipmaps(bool mipmaps) { mipmaps_ = mipmaps; }
+    bool GetMipmaps() const { return mipmaps_; }
+    /// @}
+
+private:
+    /// Family of compressed formats.
+    TextureCompressionFamily family_{TextureCompressionFamily::Auto};
+    /// Whether to generate mip levels.
+    bool mipmaps_{true};
+};
+
+}
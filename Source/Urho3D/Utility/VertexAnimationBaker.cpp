@@ -0,0 +1,352 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#include "../Utility/VertexAnimationBaker.h"
+
+#include "../Graphics/AnimatedModel.h"
+#include "../Graphics/AnimationController.h"
+#include "../Graphics/ModelView.h"
+#include "../Graphics/Octree.h"
+#include "../Graphics/Technique.h"
+#include "../Graphics/Texture2D.h"
+#include "../IO/FileSystem.h"
+#include "../IO/Log.h"
+#include "../Resource/Image.h"
+#include "../Resource/ResourceCache.h"
+#include "../Resource/XMLFile.h"
+#include "../Scene/Scene.h"
+
+namespace Urho3D
+{
+
+namespace
+{
+
+/// Max height of baked texture.
+const unsigned MaxTextureHeight = 16384;
+
+Matrix3x4 GetSkinMatrix(const Bone& bone)
+{
+    return bone.node_ ? bone.node_->GetWorldTransform() * bone.offsetMatrix_ : Matrix3x4::IDENTITY;
+}
+
+void WriteTexel(Image& image, unsigned x, unsigned y, unsigned r, unsigned g, unsigned b)
+{
+    unsigned char* texel = image.GetData() + (y * image.GetWidth() + x) * 4;
+    texel[0] = static_cast<unsigned char>(r);
+    texel[1] = static_cast<unsigned char>(g);
+    texel[2] = static_cast<unsigned char>(b);
+    texel[3] = 255;
+}
+
+unsigned QuantizeUnorm16(float value)
+{
+    return static_cast<unsigned>(Clamp(RoundToInt(value * 65535.0f), 0, 65535));
+}
+
+unsigned QuantizeUnorm8(float value)
+{
+    return static_cast<unsigned>(Clamp(RoundToInt(value * 255.0f), 0, 255));
+}
+
+}
+
+const Vector2 VertexAnimationBaker::DefaultPhaseSpacing{0.31f, 0.17f};
+
+VertexAnimationBaker::VertexAnimationBaker(Context* context)
+    : AssetTransformer(context)
+{
+}
+
+VertexAnimationBaker::~VertexAnimationBaker()
+{
+}
+
+void VertexAnimationBaker::RegisterObject(Context* context)
+{
+    context->RegisterFactory<VertexAnimationBaker>(Category_Transformer);
+
+    URHO3D_ATTRIBUTE("Model", ResourceRef, skeletonModel_, ResourceRef(Model::GetTypeStatic()), AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Material", ResourceRef, material_, ResourceRef(Material::GetTypeStatic()), AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Technique", ea::string, technique_, ea::string{DefaultTechnique}, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Sample Rate", float, sampleRate_, DefaultSampleRate, AM_DEFAULT);
+    URHO3D_ATTRIBUTE("Phase Spacing", Vector2, phaseSpacing_, DefaultPhaseSpacing, AM_DEFAULT);
+}
+
+bool VertexAnimationBaker::IsApplicable(const AssetTransformerInput& input)
+{
+    return input.inputFileName_.ends_with(".ani", false);
+}
+
+bool VertexAnimationBaker::Execute(
+    const AssetTransformerInput& input, AssetTransformerOutput& output, const AssetTransformerVector& transformers)
+{
+    auto cache = GetSubsystem<ResourceCache>();
+    auto animation = cache->GetResource<Animation>(input.resourceName_);
+    if (!animation)
+        return false;
+
+    const ea::string& modelName = GetModelName(animation);
+    auto model = cache->GetResource<Model>(modelName);
+    if (!model)
+    {
+        URHO3D_LOGERROR(
+            "Model used to bake vertex animation is not found. "
+            "You should either specify 'Model' attribute in the transformer "
+            "or add 'Model' variable to the animation metadata.");
+        return false;
+    }
+
+    VertexAnimationBakeResult result;
+    if (!Bake(model, animation, sampleRate_, result))
+        return false;
+
+    const ea::string baseResourceName = ReplaceExtension(input.resourceName_, "") + "_VAT";
+    const ea::string baseFileName = ReplaceExtension(animation->GetAbsoluteFileName(), "") + "_VAT";
+
+    // Texture parameters are loaded from the XML file with the same name as the image
+    if (!result.image_->SavePNG(baseFileName + ".png"))
+        return false;
+
+    XMLFile textureParameters(context_);
+    XMLElement textureElement = textureParameters.CreateRoot("texture");
+    textureElement.CreateChild("mipmap").SetBool("enable", false);
+    textureElement.CreateChild("filter").SetAttribute("mode", "nearest");
+    textureElement.CreateChild("srgb").SetBool("enable", false);
+    if (!textureParameters.SaveFile(baseFileName + ".xml"))
+        return false;
+
+    result.model_->SetName(baseResourceName + ".mdl");
+    if (!result.model_->SaveFile(baseFileName + ".mdl"))
+        return false;
+
+    auto sourceMaterial = !material_.name_.empty() ? cache->GetResource<Material>(material_.name_) : nullptr;
+    const SharedPtr<Material> material = CreateMaterial(result, baseResourceName + ".png", sourceMaterial);
+    if (!material->SaveFile(baseFileName + "Material.xml"))
+        return false;
+
+    output.outputResourceNames_.push_back(baseResourceName + ".png");
+    output.outputResourceNames_.push_back(baseResourceName + ".xml");
+    output.outputResourceNames_.push_back(baseResourceName + ".mdl");
+    output.outputResourceNames_.push_back(baseResourceName + "Material.xml");
+    return true;
+}
+
+bool VertexAnimationBaker::Bake(
+    Model* model, Animation* animation, float sampleRate, VertexAnimationBakeResult& result) const
+{
+    const ea::vector<ea::vector<unsigned>>& boneMappings = model->GetGeometryBoneMappings();
+    if (ea::any_of(boneMappings.begin(), boneMappings.end(), [](const auto& mapping) { return !mapping.empty(); }))
+    {
+        URHO3D_LOGERROR("Cannot bake vertex animation of model '{}' with geometry bone mappings", model->GetName());
+        return false;
+    }
+
+    auto modelView = MakeShared<ModelView>(context_);
+    if (!modelView->ImportModel(model))
+        return false;
+
+    // Vertices are enumerated in order of geometries and LODs, index is stored in the model
+    unsigned numVertices = 0;
+    for (const GeometryView& geometry : modelView->GetGeometries())
+    {
+        for (const GeometryLODView& lod : geometry.lods_)
+            numVertices += lod.vertices_.size();
+    }
+    if (numVertices == 0)
+    {
+        URHO3D_LOGERROR("Cannot bake vertex animation of empty model '{}'", model->GetName());
+        return false;
+    }
+
+    const float animationLength = animation->GetLength();
+    const unsigned numFrames = ea::max(1, CeilToInt(animationLength * sampleRate - M_LARGE_EPSILON));
+    const unsigned width = ea::min(numVertices, MaxTextureWidth);
+    const unsigned rowsPerFrame = (numVertices + width - 1) / width;
+    const unsigned height = 3 * numFrames * rowsPerFrame;
+    if (height > MaxTextureHeight)
+    {
+        URHO3D_LOGERROR("Cannot bake vertex animation '{}': texture height {} exceeds the limit of {}",
+            animation->GetName(), height, MaxTextureHeight);
+        return false;
+    }
+
+    // Sample animation on the temporary scene
+    auto scene = MakeShared<Scene>(context_);
+    scene->CreateComponent<Octree>();
+    Node* node = scene->CreateChild();
+
+    auto animatedModel = node->CreateComponent<AnimatedModel>();
+    animatedModel->SetModel(model);
+    animatedModel->ApplyAnimation();
+
+    auto animationController = node->CreateComponent<AnimationController>();
+    animationController->Update(0.0f);
+    animationController->PlayNew(AnimationParameters{animation}.Looped());
+
+    const ea::vector<Bone>& bones = animatedModel->GetSkeleton().GetBones();
+    ea::vector<Matrix3x4> skinMatrices(bones.size());
+
+    ea::vector<Vector3> positions(numFrames * numVertices);
+    ea::vector<Vector3> normals(numFrames * numVertices);
+    BoundingBox bounds;
+    for (unsigned frame = 0; frame < numFrames; ++frame)
+    {
+        const float frameTime = frame * animationLength / numFrames;
+        animationController->UpdateAnimationTime(animation, frameTime);
+        animationController->Update(0.0f);
+        animatedModel->ApplyAnimation();
+
+        for (unsigned boneIndex = 0; boneIndex < bones.size(); ++boneIndex)
+            skinMatrices[boneIndex] = GetSkinMatrix(bones[boneIndex]);
+
+        unsigned vertexIndex = frame * numVertices;
+        for (const GeometryView& geometry : modelView->GetGeometries())
+        {
+            for (const GeometryLODView& lod : geometry.lods_)
+            {
+                for (const ModelVertex& vertex : lod.vertices_)
+                {
+                    Vector3 position;
+                    Vector3 normal;
+                    float totalWeight = 0.0f;
+                    for (const auto& [boneIndex, weight] : vertex.GetBlendIndicesAndWeights())
+                    {
+                        if (weight <= 0.0f || boneIndex >= skinMatrices.size())
+                            continue;
+
+                        const Matrix3x4& skinMatrix = skinMatrices[boneIndex];
+                        position += skinMatrix * vertex.GetPosition() * weight;
+                        normal += skinMatrix.ToMatrix3() * vertex.GetNormal() * weight;
+                        totalWeight += weight;
+                    }
+
+                    // Keep unskinned vertices intact
+                    if (totalWeight < M_EPSILON)
+                    {
+                        position = vertex.GetPosition();
+                        normal = vertex.GetNormal();
+                    }
+
+                    positions[vertexIndex] = position;
+                    normals[vertexIndex] = normal.NormalizedOrDefault(Vector3::UP);
+                    bounds.Merge(position);
+                    ++vertexIndex;
+                }
+            }
+        }
+    }
+
+    // Encode positions with 16 bits per component within animation bounds
+    const Vector3 boundsSize = VectorMax(bounds.Size(), Vector3::ONE * M_LARGE_EPSILON);
+    auto image = MakeShared<Image>(context_);
+    image->SetSize(width, height, 4);
+    for (unsigned frame = 0; frame < numFrames; ++frame)
+    {
+        for (unsigned vertexIndex = 0; vertexIndex < numVertices; ++vertexIndex)
+        {
+            const unsigned x = vertexIndex % width;
+            const unsigned y = frame * rowsPerFrame + vertexIndex / width;
+            const unsigned blockSize = numFrames * rowsPerFrame;
+
+            const Vector3 position = (positions[frame * numVertices + vertexIndex] - bounds.min_) / boundsSize;
+            const unsigned qx = QuantizeUnorm16(position.x_);
+            const unsigned qy = QuantizeUnorm16(position.y_);
+            const unsigned qz = QuantizeUnorm16(position.z_);
+            WriteTexel(*image, x, y, qx >> 8, qy >> 8, qz >> 8);
+            WriteTexel(*image, x, y + blockSize, qx & 0xff, qy & 0xff, qz & 0xff);
+
+            const Vector3 normal = normals[frame * numVertices + vertexIndex] * 0.5f + Vector3::ONE * 0.5f;
+            WriteTexel(*image, x, y + 2 * blockSize,
+                QuantizeUnorm8(normal.x_), QuantizeUnorm8(normal.y_), QuantizeUnorm8(normal.z_));
+        }
+    }
+
+    // Strip skeleton and store vertex index instead
+    unsigned vertexIndex = 0;
+    for (GeometryView& geometry : modelView->GetGeometries())
+    {
+        for (GeometryLODView& lod : geometry.lods_)
+        {
+            lod.vertexFormat_.blendIndices_ = ModelVertexFormat::Undefined;
+            lod.vertexFormat_.blendWeights_ = ModelVertexFormat::Undefined;
+            lod.vertexFormat_.uv_[1] = TYPE_VECTOR2;
+            for (ModelVertex& vertex : lod.vertices_)
+            {
+                vertex.blendIndices_ = Vector4::ZERO;
+                vertex.blendWeights_ = Vector4::ZERO;
+                vertex.uv_[1] = Vector4(static_cast<float>(vertexIndex), 0.0f, 0.0f, 0.0f);
+                ++vertexIndex;
+            }
+        }
+    }
+    modelView->SetBones({});
+    modelView->SetMorphs({});
+
+    result.model_ = modelView->ExportModel();
+    result.model_->SetBoundingBox(bounds);
+    result.image_ = image;
+    result.layout_ = Vector4(static_cast<float>(width), static_cast<float>(rowsPerFrame),
+        static_cast<float>(numFrames), animationLength > 0.0f ? animationLength : 1.0f);
+    result.bounds_ = BoundingBox(bounds.min_, bounds.min_ + boundsSize);
+    return true;
+}
+
+SharedPtr<Material> VertexAnimationBaker::CreateMaterial(
+    const VertexAnimationBakeResult& result, const ea::string& textureName, Material* sourceMaterial) const
+{
+    auto cache = GetSubsystem<ResourceCache>();
+
+    SharedPtr<Material> material = sourceMaterial ? sourceMaterial->Clone() : MakeShared<Material>(context_);
+    if (!technique_.empty())
+    {
+        if (auto technique = cache->GetResource<Technique>(technique_))
+            material->SetTechnique(0, technique);
+    }
+
+    // Texture may be unavailable if there's no graphics, keep the reference anyway
+    SharedPtr<Texture2D> texture{cache->GetResource<Texture2D>(textureName, false)};
+    if (!texture)
+    {
+        texture = MakeShared<Texture2D>(context_);
+        texture->SetName(textureName);
+    }
+    material->SetTexture(TU_CUSTOM1, texture);
+
+    material->SetShaderParameter("VATBoundsMin", result.bounds_.min_);
+    material->SetShaderParameter("VATBoundsSize", result.bounds_.Size());
+    material->SetShaderParameter("VATLayout", result.layout_);
+    material->SetShaderParameter("VATSpeed", 1.0f);
+    material->SetShaderParameter("VATPhaseSpacing", phaseSpacing_);
+    return material;
+}
+
+ea::string VertexAnimationBaker::GetModelName(Animation* animation) const
+{
+    const ea::string& modelName = animation->GetMetadata("Model").GetString();
+    if (!modelName.empty())
+        return modelName;
+    return skeletonModel_.name_;
+}
+
+}
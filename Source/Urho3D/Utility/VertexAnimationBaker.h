@@ -0,0 +1,90 @@
+//
+// Copyright (c) 2023-2023 the rbfx project.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR rhs
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR rhsWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR rhs DEALINGS IN
+// THE SOFTWARE.
+//
+
+
+#pragma once
+
+#include "../Graphics/Animation.h"
+#include "../Graphics/Material.h"
+#include "../Graphics/Model.h"
+#include "../Utility/AssetTransformer.h"
+
+namespace Urho3D
+{
+
+class Image;
+
+/// Result of vertex animation baking.
+struct VertexAnimationBakeResult
+{
+    /// Static model with global vertex index stored in the first component of the second texture coordinate.
+    SharedPtr<Model> model_;
+    /// Texture with quantized positions and normals for each vertex and frame.
+    SharedPtr<Image> image_;
+    /// Layout of the texture: width, rows per frame, number of frames and animation length.
+    Vector4 layout_;
+    /// Bounds of animated positions in model space.
+    BoundingBox bounds_;
+};
+
+/// Asset transformer that bakes skeletal animation of the model into vertex animation texture (VAT).
+/// Baked animation is played in vertex shader, so animated crowds can be rendered as instanced static models.
+/// Texture stores three blocks of rows: high bytes of positions, low bytes of positions and normals.
+/// Outputs model, texture and material next to the animation.
+class URHO3D_API VertexAnimationBaker : public AssetTransformer
+{
+    URHO3D_OBJECT(VertexAnimationBaker, AssetTransformer);
+
+public:
+    /// Max width of baked texture.
+    static const unsigned MaxTextureWidth = 4096;
+    static constexpr float DefaultSampleRate = 30.0f;
+    static constexpr const char* DefaultTechnique = "Techniques/VertexAnimationDiff.xml";
+    static const Vector2 DefaultPhaseSpacing;
+
+    VertexAnimationBaker(Context* context);
+    ~VertexAnimationBaker() override;
+    static void RegisterObject(Context* context);
+
+    /// Bake animation of the model.
+    bool Bake(Model* model, Animation* animation, float sampleRate, VertexAnimationBakeResult& result) const;
+    /// Create material for baked animation. Source material is cloned if specified.
+    SharedPtr<Material> CreateMaterial(const VertexAnimationBakeResult& result, const ea::string& textureName,
+        Material* sourceMaterial) const;
+
+    bool IsApplicable(const AssetTransformerInput& input) override;
+    bool Execute(const AssetTransformerInput& input, AssetTransformerOutput& output,
+        const AssetTransformerVector& transformers) override;
+    bool IsExecutedOnOutput() override { return true; }
+
+private:
+    ea::string GetModelName(Animation* animation) const;
+
+    float sampleRate_{DefaultSampleRate};
+    ResourceRef skeletonModel_{Model::GetTypeStatic()};
+    ResourceRef material_{Material::GetTypeStatic()};
+    ea::string technique_{DefaultTechnique};
+    /// Animation time offset per world unit along X and Z axes, so instances placed apart play out of sync.
+    Vector2 phaseSpacing_{DefaultPhaseSpacing};
+};
+
+}
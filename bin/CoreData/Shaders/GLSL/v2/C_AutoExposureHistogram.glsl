@@ -0,0 +1,109 @@
+#version 430
+
+// Evaluates average scene luminance from histogram of log2 luminance.
+// HISTOGRAM: accumulate histogram of input texture, one thread per pixel.
+// AVERAGE: evaluate average luminance between percentiles, adapt it and clear histogram. Dispatched as single group.
+// Constants should match AutoExposurePass.
+
+#define NUM_BINS 256
+#define GROUP_SIZE 16
+
+layout(local_size_x = GROUP_SIZE, local_size_y = GROUP_SIZE) in;
+
+layout(binding = 0)
+uniform sampler2D inputTex;
+
+layout(binding = 0, rgba16f)
+uniform writeonly image2D outputTexture;
+
+layout(std430, binding = 1) buffer HistogramData
+{
+    // Bin 0 contains black pixels, other bins cover log2 luminance range
+    uint bins[NUM_BINS];
+    // x: adapted luminance
+    vec4 adaptedLuminance;
+};
+
+layout(std430, binding = 2) readonly buffer HistogramParameters
+{
+    // x: min log2 luminance, y: log2 luminance range, z: inverse log2 luminance range
+    vec4 logLuminanceRange;
+    // x: low percentile, y: high percentile, z: adaptation factor
+    vec4 percentilesAndAdaptation;
+};
+
+shared uint groupBins[NUM_BINS];
+
+uint GetBin(vec3 color)
+{
+    const vec3 LumWeights = vec3(0.2126, 0.7152, 0.0722);
+    const float luminance = dot(color, LumWeights);
+    // Also filters out NaNs
+    if (!(luminance >= 1e-4))
+        return 0;
+
+    const float t = clamp((log2(luminance) - logLuminanceRange.x) * logLuminanceRange.z, 0.0, 1.0);
+    return uint(t * float(NUM_BINS - 2)) + 1;
+}
+
+float GetBinLogLuminance(uint bin)
+{
+    return logLuminanceRange.x + (float(bin) - 0.5) / float(NUM_BINS - 2) * logLuminanceRange.y;
+}
+
+#ifdef HISTOGRAM
+void main()
+{
+    groupBins[gl_LocalInvocationIndex] = 0;
+    barrier();
+
+    const ivec2 pixel = ivec2(gl_GlobalInvocationID.xy);
+    if (all(lessThan(pixel, textureSize(inputTex, 0))))
+        atomicAdd(groupBins[GetBin(texelFetch(inputTex, pixel, 0).rgb)], 1);
+    barrier();
+
+    const uint count = groupBins[gl_LocalInvocationIndex];
+    if (count != 0)
+        atomicAdd(bins[gl_LocalInvocationIndex], count);
+}
+#endif
+
+#ifdef AVERAGE
+void main()
+{
+    const uint bin = gl_LocalInvocationIndex;
+    groupBins[bin] = bins[bin];
+    barrier();
+
+    if (bin == 0)
+    {
+        uint numPixels = 0;
+        for (uint i = 1; i < NUM_BINS; ++i)
+            numPixels += groupBins[i];
+
+        // Average log luminance of pixels between percentiles, black pixels are ignored
+        const float lowCount = float(numPixels) * percentilesAndAdaptation.x;
+        const float highCount = float(numPixels) * percentilesAndAdaptation.y;
+        float accumulatedCount = 0.0;
+        float weightedSum = 0.0;
+        float totalWeight = 0.0;
+        for (uint i = 1; i < NUM_BINS; ++i)
+        {
+            const float binCount = float(groupBins[i]);
+            const float weight = max(0.0, min(accumulatedCount + binCount, highCount) - max(accumulatedCount, lowCount));
+            weightedSum += GetBinLogLuminance(i) * weight;
+            totalWeight += weight;
+            accumulatedCount += binCount;
+        }
+
+        const float currentLuminance = exp2(totalWeight > 0.0 ? weightedSum / totalWeight : logLuminanceRange.x);
+        const float previousLuminance = adaptedLuminance.x;
+        const float luminance = previousLuminance + (currentLuminance - previousLuminance) * percentilesAndAdaptation.z;
+
+        adaptedLuminance.x = luminance;
+        imageStore(outputTexture, ivec2(0, 0), vec4(luminance, 0.0, 0.0, 1.0));
+    }
+
+    bins[bin] = 0;
+}
+#endif
@@ -0,0 +1,63 @@
+#version 430
+
+// Builds one level of hierarchical depth buffer, each texel stores the farthest depth of the covered area.
+// SOURCE_DEPTH: read level 0 from depth texture, otherwise read previous level of Hi-Z texture.
+
+#ifdef SOURCE_DEPTH
+layout(binding = 0)
+uniform sampler2D srcTex;
+#else
+layout(binding = 1, r32f)
+uniform readonly image2D srcTex;
+#endif
+
+layout(binding = 2, r32f)
+uniform writeonly image2D outputTexture;
+
+float LoadDepth(ivec2 coord, ivec2 srcSize)
+{
+    coord = min(coord, srcSize - 1);
+#ifdef SOURCE_DEPTH
+    return texelFetch(srcTex, coord, 0).r;
+#else
+    return imageLoad(srcTex, coord).r;
+#endif
+}
+
+layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+void main()
+{
+    const ivec2 dstSize = imageSize(outputTexture);
+    const ivec2 dstCoord = ivec2(gl_GlobalInvocationID.xy);
+    if (dstCoord.x >= dstSize.x || dstCoord.y >= dstSize.y)
+        return;
+
+#ifdef SOURCE_DEPTH
+    const ivec2 srcSize = textureSize(srcTex, 0);
+#else
+    const ivec2 srcSize = imageSize(srcTex);
+#endif
+
+    const ivec2 srcCoord = dstCoord * 2;
+    float depth = max(
+        max(LoadDepth(srcCoord, srcSize), LoadDepth(srcCoord + ivec2(1, 0), srcSize)),
+        max(LoadDepth(srcCoord + ivec2(0, 1), srcSize), LoadDepth(srcCoord + ivec2(1, 1), srcSize)));
+
+    // Last row and column of odd-sized source are folded into the border texels
+    const bool extraColumn = (srcSize.x & 1) != 0 && dstCoord.x == dstSize.x - 1;
+    const bool extraRow = (srcSize.y & 1) != 0 && dstCoord.y == dstSize.y - 1;
+    if (extraColumn)
+    {
+        depth = max(depth, LoadDepth(srcCoord + ivec2(2, 0), srcSize));
+        depth = max(depth, LoadDepth(srcCoord + ivec2(2, 1), srcSize));
+    }
+    if (extraRow)
+    {
+        depth = max(depth, LoadDepth(srcCoord + ivec2(0, 2), srcSize));
+        depth = max(depth, LoadDepth(srcCoord + ivec2(1, 2), srcSize));
+    }
+    if (extraColumn && extraRow)
+        depth = max(depth, LoadDepth(srcCoord + ivec2(2, 2), srcSize));
+
+    imageStore(outputTexture, dstCoord, vec4(depth));
+}
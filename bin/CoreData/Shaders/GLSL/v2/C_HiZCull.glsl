@@ -0,0 +1,82 @@
+#version 430
+
+// Tests bounding boxes of drawables against hierarchical depth buffer.
+// Writes 1 for potentially visible drawables and 0 for occluded ones.
+
+layout(binding = 0)
+uniform sampler2D hiZTex;
+
+layout(std430, binding = 0) readonly buffer CullParameters
+{
+    layout(row_major) mat4 viewProj;
+    // xy: size of level 0, z: number of levels, w: number of drawables
+    vec4 hiZSize;
+    // xy: scale from NDC to UV, zw: offset from NDC to UV
+    vec4 uvScale;
+};
+
+layout(std430, binding = 1) readonly buffer Bounds
+{
+    // Min and max corners of each bounding box
+    vec4 bounds[];
+};
+
+layout(std430, binding = 2) writeonly buffer Visibility
+{
+    uint visibility[];
+};
+
+bool IsVisible(vec3 boxMin, vec3 boxMax)
+{
+    vec2 rectMin = vec2(1.0);
+    vec2 rectMax = vec2(0.0);
+    float minDepth = 1.0;
+
+    for (int i = 0; i < 8; ++i)
+    {
+        const vec3 corner = mix(boxMin, boxMax, vec3(i & 1, (i >> 1) & 1, (i >> 2) & 1));
+        const vec4 clipPos = viewProj * vec4(corner, 1.0);
+
+        // Box crosses near plane, consider it visible
+        if (clipPos.w <= 0.0)
+            return true;
+
+        const vec3 ndcPos = clipPos.xyz / clipPos.w;
+        const vec2 uv = ndcPos.xy * uvScale.xy + uvScale.zw;
+        rectMin = min(rectMin, uv);
+        rectMax = max(rectMax, uv);
+        minDepth = min(minDepth, ndcPos.z);
+    }
+
+    if (minDepth <= 0.0)
+        return true;
+
+    rectMin = clamp(rectMin, vec2(0.0), vec2(1.0));
+    rectMax = clamp(rectMax, vec2(0.0), vec2(1.0));
+
+    // Pick the level where the rectangle covers at most 2x2 texels
+    const vec2 rectSize = (rectMax - rectMin) * hiZSize.xy;
+    const float level = clamp(ceil(log2(max(max(rectSize.x, rectSize.y), 1.0))), 0.0, hiZSize.z - 1.0);
+
+    const ivec2 levelSize = textureSize(hiZTex, int(level));
+    const ivec2 texelMin = clamp(ivec2(rectMin * vec2(levelSize)), ivec2(0), levelSize - 1);
+    const ivec2 texelMax = clamp(ivec2(rectMax * vec2(levelSize)), ivec2(0), levelSize - 1);
+
+    const float maxDepth = max(
+        max(texelFetch(hiZTex, texelMin, int(level)).r, texelFetch(hiZTex, ivec2(texelMax.x, texelMin.y), int(level)).r),
+        max(texelFetch(hiZTex, ivec2(texelMin.x, texelMax.y), int(level)).r, texelFetch(hiZTex, texelMax, int(level)).r));
+
+    return minDepth <= maxDepth;
+}
+
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+void main()
+{
+    const uint index = gl_GlobalInvocationID.x;
+    if (index >= uint(hiZSize.w))
+        return;
+
+    const vec3 boxMin = bounds[index * 2].xyz;
+    const vec3 boxMax = bounds[index * 2 + 1].xyz;
+    visibility[index] = IsVisible(boxMin, boxMax) ? 1u : 0u;
+}
@@ -0,0 +1,216 @@
+#version 430
+
+// Traces rays against triangle BVH built by GpuRaytracer.
+// By default, writes closest hit for each ray. Closest hit on non-opaque geometry is reported as unresolved.
+// If OCCLUSION is defined, writes 0 for unblocked rays, 1 for rays blocked by opaque geometry
+// and 2 for rays that hit only non-opaque geometry.
+// Rays that overflow traversal stack are reported as unresolved too.
+
+layout(std430, binding = 0) readonly buffer TraceParameters
+{
+    // x: number of rays, y: number of BVH nodes
+    uvec4 traceSize;
+};
+
+layout(std430, binding = 1) readonly buffer Nodes
+{
+    // Per node: min corner and first triangle (leaf) or right child (inner node),
+    // max corner and number of triangles (zero for inner node). Left child follows the node.
+    vec4 nodes[];
+};
+
+layout(std430, binding = 2) readonly buffer Triangles
+{
+    // Per triangle: first vertex and geometry ID, second vertex and primitive ID, third vertex and geometry mask
+    vec4 triangles[];
+};
+
+layout(std430, binding = 3) readonly buffer Geometries
+{
+    // Object index, geometry index, LOD index, flags
+    uvec4 geometries[];
+};
+
+layout(std430, binding = 4) readonly buffer Rays
+{
+    // Per ray: origin and max distance, direction and mask, source geometry
+    vec4 rays[];
+};
+
+#ifdef OCCLUSION
+layout(std430, binding = 5) writeonly buffer Results
+{
+    uint results[];
+};
+#else
+layout(std430, binding = 5) writeonly buffer Results
+{
+    // Per ray: geometry ID, primitive ID and barycentrics, geometric normal and distance
+    vec4 results[];
+};
+#endif
+
+#define MAX_STACK_SIZE 64
+
+const uint NO_SOURCE_GEOMETRY = 0xffffffffu;
+const uint NO_HIT = 0xffffffffu;
+const uint UNRESOLVED = 0xfffffffeu;
+const uint GEOMETRY_FLAG_OPAQUE = 1u;
+
+// Same as IsUnwantedLod in LightTracer.cpp
+bool IsUnwantedLod(uint sourceGeometry, uint hitGeometry)
+{
+    if (sourceGeometry == NO_SOURCE_GEOMETRY)
+        return false;
+
+    const uvec4 source = geometries[sourceGeometry];
+    const uvec4 hit = geometries[hitGeometry];
+    const bool hitLod = hit.z != 0u;
+    const bool sameGeometry = source.x == hit.x && source.y == hit.y;
+    return (!sameGeometry && hitLod) || (sameGeometry && hit.z != source.z);
+}
+
+bool IntersectBox(vec3 origin, vec3 invDirection, vec3 boxMin, vec3 boxMax, float maxDistance)
+{
+    const vec3 t0 = (boxMin - origin) * invDirection;
+    const vec3 t1 = (boxMax - origin) * invDirection;
+    const vec3 tMin = min(t0, t1);
+    const vec3 tMax = max(t0, t1);
+    const float enter = max(max(tMin.x, tMin.y), max(tMin.z, 0.0));
+    const float exit = min(min(tMax.x, tMax.y), min(tMax.z, maxDistance));
+    return enter <= exit;
+}
+
+// Moeller-Trumbore intersection with the same barycentrics as in Embree
+bool IntersectTriangle(vec3 origin, vec3 direction, vec3 v0, vec3 v1, vec3 v2, float maxDistance,
+    out float distance, out vec2 barycentrics)
+{
+    const vec3 e1 = v1 - v0;
+    const vec3 e2 = v2 - v0;
+    const vec3 p = cross(direction, e2);
+    const float det = dot(e1, p);
+    if (det == 0.0)
+        return false;
+
+    const float invDet = 1.0 / det;
+    const vec3 s = origin - v0;
+    const float u = dot(s, p) * invDet;
+    if (u < 0.0 || u > 1.0)
+        return false;
+
+    const vec3 q = cross(s, e1);
+    const float v = dot(direction, q) * invDet;
+    if (v < 0.0 || u + v > 1.0)
+        return false;
+
+    distance = dot(e2, q) * invDet;
+    barycentrics = vec2(u, v);
+    return distance >= 0.0 && distance <= maxDistance;
+}
+
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+void main()
+{
+    const uint index = gl_GlobalInvocationID.x;
+    if (index >= traceSize.x)
+        return;
+
+    const vec4 ray0 = rays[index * 3];
+    const vec4 ray1 = rays[index * 3 + 1];
+    const vec4 ray2 = rays[index * 3 + 2];
+
+    const vec3 origin = ray0.xyz;
+    const vec3 direction = ray1.xyz;
+    const uint mask = floatBitsToUint(ray1.w);
+    const uint sourceGeometry = floatBitsToUint(ray2.x);
+
+    // Avoid NaNs in box test for axis-aligned rays
+    const vec3 safeDirection = mix(direction, vec3(1e-20), lessThan(abs(direction), vec3(1e-20)));
+    const vec3 invDirection = 1.0 / safeDirection;
+
+    float hitDistance = ray0.w;
+    uint hitGeometry = NO_HIT;
+    uint hitPrimitive = 0u;
+    vec2 hitBarycentrics = vec2(0.0);
+    vec3 hitNormal = vec3(0.0);
+    bool hitOpaque = false;
+    bool hitTransparent = false;
+    bool stackOverflow = false;
+
+    uint stack[MAX_STACK_SIZE];
+    int stackSize = 0;
+    if (mask != 0u && traceSize.y != 0u)
+        stack[stackSize++] = 0u;
+
+    while (stackSize > 0)
+    {
+        const uint nodeIndex = stack[--stackSize];
+        const vec4 node0 = nodes[nodeIndex * 2];
+        const vec4 node1 = nodes[nodeIndex * 2 + 1];
+        if (!IntersectBox(origin, invDirection, node0.xyz, node1.xyz, hitDistance))
+            continue;
+
+        const uint offset = floatBitsToUint(node0.w);
+        const uint count = floatBitsToUint(node1.w);
+        if (count == 0u)
+        {
+            if (stackSize + 2 > MAX_STACK_SIZE)
+            {
+                stackOverflow = true;
+                continue;
+            }
+
+            stack[stackSize++] = offset;
+            stack[stackSize++] = nodeIndex + 1u;
+            continue;
+        }
+
+        for (uint i = offset; i < offset + count; ++i)
+        {
+            const vec4 triangle0 = triangles[i * 3];
+            const vec4 triangle1 = triangles[i * 3 + 1];
+            const vec4 triangle2 = triangles[i * 3 + 2];
+            if ((floatBitsToUint(triangle2.w) & mask) == 0u)
+                continue;
+
+            float distance;
+            vec2 barycentrics;
+            if (!IntersectTriangle(origin, direction, triangle0.xyz, triangle1.xyz, triangle2.xyz, hitDistance,
+                distance, barycentrics))
+                continue;
+
+            const uint geometryId = floatBitsToUint(triangle0.w);
+            if (IsUnwantedLod(sourceGeometry, geometryId))
+                continue;
+
+            const bool opaque = (geometries[geometryId].w & GEOMETRY_FLAG_OPAQUE) != 0u;
+        #ifdef OCCLUSION
+            if (!opaque)
+            {
+                hitTransparent = true;
+                continue;
+            }
+
+            results[index] = 1u;
+            return;
+        #else
+            hitDistance = distance;
+            hitGeometry = geometryId;
+            hitPrimitive = floatBitsToUint(triangle1.w);
+            hitBarycentrics = barycentrics;
+            hitNormal = cross(triangle1.xyz - triangle0.xyz, triangle2.xyz - triangle0.xyz);
+            hitOpaque = opaque;
+        #endif
+        }
+    }
+
+#ifdef OCCLUSION
+    results[index] = (hitTransparent || stackOverflow) ? 2u : 0u;
+#else
+    if ((hitGeometry != NO_HIT && !hitOpaque) || stackOverflow)
+        hitGeometry = UNRESOLVED;
+
+    results[index * 2] = vec4(uintBitsToFloat(hitGeometry), uintBitsToFloat(hitPrimitive), hitBarycentrics);
+    results[index * 2 + 1] = vec4(hitNormal, hitDistance);
+#endif
+}
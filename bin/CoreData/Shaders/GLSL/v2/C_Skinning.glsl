@@ -0,0 +1,81 @@
+#version 430
+
+// Applies morphs and skeletal animation to vertices of one vertex buffer.
+// Output vertex consists of position and optional normal and tangent, all stored as vec4.
+
+layout(std430, binding = 0) readonly buffer AnimationParameters
+{
+    // x: number of vertices, y: morph range start, z: morph range count, w: number of active morphs
+    uvec4 header;
+    // x: whether to apply skinning, y: output vertex stride, z: normal offset, w: tangent offset
+    uvec4 outputLayout;
+    // Active morphs as (slot, weight) followed by bone matrices, three rows per bone
+    vec4 parameters[];
+};
+
+layout(std430, binding = 1) readonly buffer SourceVertices
+{
+    // Position, normal, tangent, blend weights and blend indices per vertex
+    vec4 sourceVertices[];
+};
+
+layout(std430, binding = 2) readonly buffer MorphDeltas
+{
+    // Position, normal and tangent deltas per morph slot and per vertex in morph range
+    vec4 morphDeltas[];
+};
+
+layout(std430, binding = 3) writeonly buffer OutputVertices
+{
+    vec4 outputVertices[];
+};
+
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+void main()
+{
+    const uint index = gl_GlobalInvocationID.x;
+    if (index >= header.x)
+        return;
+
+    vec3 position = sourceVertices[index * 5].xyz;
+    vec3 normal = sourceVertices[index * 5 + 1].xyz;
+    vec4 tangent = sourceVertices[index * 5 + 2];
+
+    const uint rangeIndex = index - header.y;
+    if (rangeIndex < header.z)
+    {
+        for (uint i = 0; i < header.w; ++i)
+        {
+            const uint slot = uint(parameters[i].x);
+            const float weight = parameters[i].y;
+            const uint deltaIndex = (slot * header.z + rangeIndex) * 3;
+            position += morphDeltas[deltaIndex].xyz * weight;
+            normal += morphDeltas[deltaIndex + 1].xyz * weight;
+            tangent.xyz += morphDeltas[deltaIndex + 2].xyz * weight;
+        }
+    }
+
+    if (outputLayout.x != 0)
+    {
+        const vec4 weights = sourceVertices[index * 5 + 3];
+        const uvec4 bones = uvec4(sourceVertices[index * 5 + 4]) * 3 + header.w;
+
+        const vec4 row0 = parameters[bones.x] * weights.x + parameters[bones.y] * weights.y
+            + parameters[bones.z] * weights.z + parameters[bones.w] * weights.w;
+        const vec4 row1 = parameters[bones.x + 1] * weights.x + parameters[bones.y + 1] * weights.y
+            + parameters[bones.z + 1] * weights.z + parameters[bones.w + 1] * weights.w;
+        const vec4 row2 = parameters[bones.x + 2] * weights.x + parameters[bones.y + 2] * weights.y
+            + parameters[bones.z + 2] * weights.z + parameters[bones.w + 2] * weights.w;
+
+        position = vec3(dot(row0, vec4(position, 1.0)), dot(row1, vec4(position, 1.0)), dot(row2, vec4(position, 1.0)));
+        normal = vec3(dot(row0.xyz, normal), dot(row1.xyz, normal), dot(row2.xyz, normal));
+        tangent.xyz = vec3(dot(row0.xyz, tangent.xyz), dot(row1.xyz, tangent.xyz), dot(row2.xyz, tangent.xyz));
+    }
+
+    const uint outputIndex = index * outputLayout.y;
+    outputVertices[outputIndex] = vec4(position, 1.0);
+    if (outputLayout.z != 0xffffffffu)
+        outputVertices[outputIndex + outputLayout.z] = vec4(normal, 0.0);
+    if (outputLayout.w != 0xffffffffu)
+        outputVertices[outputIndex + outputLayout.w] = tangent;
+}
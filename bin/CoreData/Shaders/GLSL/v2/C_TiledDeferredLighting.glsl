@@ -0,0 +1,182 @@
+#version 430
+
+// Evaluates unshadowed point and spot lights for deferred geometry buffer in screen tiles.
+// Each group finds depth bounds of its tile, culls lights against them and accumulates lighting of all tile lights.
+// PHYSICAL: evaluate PBR lighting, otherwise evaluate Blinn-Phong lighting.
+// Constants should match TiledDeferredLightProcessor.
+
+#define TILE_SIZE 16
+#define MAX_LIGHTS_PER_TILE 128
+
+layout(binding = 0)
+uniform sampler2D depthTex;
+layout(binding = 1)
+uniform sampler2D albedoTex;
+layout(binding = 2)
+uniform sampler2D specularTex;
+layout(binding = 3)
+uniform sampler2D normalTex;
+
+layout(binding = 0, rgba16f)
+uniform writeonly image2D outputTexture;
+
+layout(std430, binding = 1) readonly buffer LightingParameters
+{
+    layout(row_major) mat4 clipToView;
+    layout(row_major) mat4 worldToView;
+    // xy: scale from UV to NDC, zw: offset from UV to NDC
+    vec4 uvToClip;
+    // xy: offset of viewport in depth texture, zw: size of viewport
+    vec4 depthOffsetAndSize;
+    // x: number of lights
+    vec4 numLights;
+};
+
+layout(std430, binding = 2) readonly buffer LightData
+{
+    // 0: view space position.xyz, inverse range
+    // 1: color.rgb, specular intensity
+    // 2: view space direction.xyz, spot cutoff
+    // 3: inverse spot cutoff, range
+    vec4 lightData[];
+};
+
+shared uint tileMinDepth;
+shared uint tileMaxDepth;
+shared uint tileNumLights;
+shared uint tileLights[MAX_LIGHTS_PER_TILE];
+
+vec3 GetViewPosition(vec2 uv, float depth)
+{
+    const vec4 clipPos = vec4(uv * uvToClip.xy + uvToClip.zw, depth, 1.0);
+    const vec4 viewPos = clipToView * clipPos;
+    return viewPos.xyz / viewPos.w;
+}
+
+bool IsLightInTile(uint lightIndex, vec3 tileMin, vec3 tileMax)
+{
+    const vec3 center = lightData[lightIndex * 4].xyz;
+    const float range = lightData[lightIndex * 4 + 3].y;
+    const vec3 delta = center - clamp(center, tileMin, tileMax);
+    return dot(delta, delta) <= range * range;
+}
+
+vec3 EvaluateLight(uint lightIndex, vec3 viewPos, vec3 normal, vec3 eyeVec, vec3 albedo, vec4 specular)
+{
+    const vec4 positionAndInvRange = lightData[lightIndex * 4];
+    const vec4 colorAndSpecular = lightData[lightIndex * 4 + 1];
+    const vec4 directionAndCutoff = lightData[lightIndex * 4 + 2];
+    const float inverseCutoff = lightData[lightIndex * 4 + 3].x;
+
+    const vec3 scaledLightVec = (positionAndInvRange.xyz - viewPos) * positionAndInvRange.w;
+    const float lightDist = max(0.001, length(scaledLightVec));
+    const float invDistance = max(0.0, 1.0 - lightDist);
+    const vec3 lightVec = scaledLightVec / lightDist;
+    const float spotFactor = clamp((dot(lightVec, directionAndCutoff.xyz) - directionAndCutoff.w) * inverseCutoff, 0.0, 1.0);
+    const vec3 lightColor = colorAndSpecular.rgb * (invDistance * invDistance * spotFactor);
+
+    const vec3 halfVec = normalize(eyeVec + lightVec);
+    const float NoL = max(dot(normal, lightVec), 0.0);
+
+#ifdef PHYSICAL
+    // Same as Direct_PBR from _BRDF.glsl
+    const float roughness2 = specular.a * specular.a;
+    const float NoV = abs(dot(normal, eyeVec)) + 1e-5;
+    const float NoH = clamp(dot(normal, halfVec), 0.0, 1.0);
+    const float LoH = clamp(dot(lightVec, halfVec), 0.0, 1.0);
+
+    const float a = NoH * roughness2;
+    const float k = roughness2 / (1.0 - NoH * NoH + a * a);
+    const float D = k * k;
+    const float GGXV = NoL * (NoV * (1.0 - roughness2) + roughness2);
+    const float GGXL = NoV * (NoL * (1.0 - roughness2) + roughness2);
+    const float V = 0.5 / (GGXV + GGXL);
+    const vec3 F = vec3(pow(1.0 - LoH, 5.0)) + specular.rgb * (1.0 - pow(1.0 - LoH, 5.0));
+    return NoL * lightColor * (albedo + (D * V) * F);
+#else
+    // Same as Direct_SimpleSpecular from _BRDF.glsl
+    const float specularPower = (1.0 - specular.a) * 255.0;
+    const float brdf = pow(max(dot(normal, halfVec), 0.0), specularPower);
+    return NoL * lightColor * (albedo + specular.rgb * (brdf * colorAndSpecular.a));
+#endif
+}
+
+layout(local_size_x = TILE_SIZE, local_size_y = TILE_SIZE, local_size_z = 1) in;
+void main()
+{
+    const ivec2 size = ivec2(depthOffsetAndSize.zw);
+    const ivec2 coord = ivec2(gl_GlobalInvocationID.xy);
+    const bool isInside = coord.x < size.x && coord.y < size.y;
+    const uint threadIndex = gl_LocalInvocationIndex;
+
+    if (threadIndex == 0)
+    {
+        tileMinDepth = 0xffffffffu;
+        tileMaxDepth = 0u;
+        tileNumLights = 0u;
+    }
+    barrier();
+
+    // Depth is non-negative, so bit representations are ordered in the same way as values
+    const ivec2 clampedCoord = min(coord, size - 1);
+    const float depth = texelFetch(depthTex, clampedCoord + ivec2(depthOffsetAndSize.xy), 0).r;
+    const bool isBackground = depth >= 1.0;
+    if (isInside && !isBackground)
+    {
+        atomicMin(tileMinDepth, floatBitsToUint(depth));
+        atomicMax(tileMaxDepth, floatBitsToUint(depth));
+    }
+    barrier();
+
+    // Cull lights against view space bounding box of the tile
+    if (tileMinDepth <= tileMaxDepth)
+    {
+        const float minDepth = uintBitsToFloat(tileMinDepth);
+        const float maxDepth = uintBitsToFloat(tileMaxDepth);
+        const vec2 tileMinUV = vec2(gl_WorkGroupID.xy * TILE_SIZE) / vec2(size);
+        const vec2 tileMaxUV = vec2(gl_WorkGroupID.xy * TILE_SIZE + TILE_SIZE) / vec2(size);
+
+        vec3 tileMin = vec3(1e30);
+        vec3 tileMax = vec3(-1e30);
+        for (int i = 0; i < 8; ++i)
+        {
+            const vec2 uv = mix(tileMinUV, tileMaxUV, vec2(i & 1, (i >> 1) & 1));
+            const vec3 corner = GetViewPosition(uv, (i & 4) != 0 ? maxDepth : minDepth);
+            tileMin = min(tileMin, corner);
+            tileMax = max(tileMax, corner);
+        }
+
+        const uint lightCount = uint(numLights.x);
+        for (uint lightIndex = threadIndex; lightIndex < lightCount; lightIndex += TILE_SIZE * TILE_SIZE)
+        {
+            if (IsLightInTile(lightIndex, tileMin, tileMax))
+            {
+                const uint slot = atomicAdd(tileNumLights, 1u);
+                if (slot < MAX_LIGHTS_PER_TILE)
+                    tileLights[slot] = lightIndex;
+            }
+        }
+    }
+    barrier();
+
+    if (!isInside)
+        return;
+
+    vec3 finalColor = vec3(0.0);
+    if (!isBackground)
+    {
+        const vec2 uv = (vec2(coord) + 0.5) / vec2(size);
+        const vec3 viewPos = GetViewPosition(uv, depth);
+        const vec3 eyeVec = normalize(-viewPos);
+        const vec3 albedo = texelFetch(albedoTex, coord, 0).rgb;
+        const vec4 specular = texelFetch(specularTex, coord, 0);
+        const vec3 worldNormal = texelFetch(normalTex, coord, 0).rgb * 2.0 - 1.0;
+        const vec3 normal = normalize(mat3(worldToView) * worldNormal);
+
+        const uint numTileLights = min(tileNumLights, uint(MAX_LIGHTS_PER_TILE));
+        for (uint i = 0; i < numTileLights; ++i)
+            finalColor += EvaluateLight(tileLights[i], viewPos, normal, eyeVec, albedo, specular);
+    }
+
+    imageStore(outputTexture, coord, vec4(finalColor, 0.0));
+}
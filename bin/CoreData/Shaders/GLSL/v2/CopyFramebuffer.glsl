@@ -7,6 +7,12 @@
 
 uniform sampler2D sDiffMap;
 
+#ifdef URHO3D_SHARPEN
+UNIFORM_BUFFER_BEGIN(6, Custom)
+    UNIFORM(mediump float cSharpness)
+UNIFORM_BUFFER_END(6, Custom)
+#endif
+
 VERTEX_OUTPUT_HIGHP(vec2 vScreenPos)
 
 #ifdef URHO3D_VERTEX_SHADER
@@ -22,6 +28,14 @@ void main()
 void main()
 {
     vec4 color = texture2D(sDiffMap, vScreenPos);
+    #ifdef URHO3D_SHARPEN
+        // Unsharp mask to restore details lost by upscaling
+        vec3 blur = texture2D(sDiffMap, vScreenPos + vec2(cGBufferInvSize.x, 0.0)).rgb
+            + texture2D(sDiffMap, vScreenPos - vec2(cGBufferInvSize.x, 0.0)).rgb
+            + texture2D(sDiffMap, vScreenPos + vec2(0.0, cGBufferInvSize.y)).rgb
+            + texture2D(sDiffMap, vScreenPos - vec2(0.0, cGBufferInvSize.y)).rgb;
+        color.rgb = max(color.rgb + (color.rgb - blur * 0.25) * cSharpness, vec3(0.0));
+    #endif
     #if defined(URHO3D_GAMMA_TO_LINEAR)
         gl_FragColor = GammaToLinearSpaceAlpha(color);
     #elif defined(URHO3D_LINEAR_TO_GAMMA)
@@ -22,7 +22,9 @@ void main()
     gl_Position = WorldToClipSpace(vertexTransform.position.xyz);
     ApplyClipPlane(gl_Position);
 
-    #ifdef URHO3D_VERTEX_HAS_TEXCOORD0
+    #if defined(URHO3D_BILLBOARD_PER_INSTANCE)
+        vTexCoord = mix(iTexCoord.xy, iTexCoord.zw, iTexCoord2);
+    #elif defined(URHO3D_VERTEX_HAS_TEXCOORD0)
         vTexCoord = iTexCoord;
     #else
         vTexCoord = vec2(0.0);
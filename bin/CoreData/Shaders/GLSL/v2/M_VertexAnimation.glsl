@@ -0,0 +1,106 @@
+#define URHO3D_PIXEL_NEED_TEXCOORD
+#define URHO3D_CUSTOM_MATERIAL_UNIFORMS
+
+#include "_Config.glsl"
+#include "_Uniforms.glsl"
+
+UNIFORM_BUFFER_BEGIN(4, Material)
+    DEFAULT_MATERIAL_UNIFORMS
+    UNIFORM(vec3 cVATBoundsMin)
+    UNIFORM(vec3 cVATBoundsSize)
+    UNIFORM(vec4 cVATLayout)
+    UNIFORM(float cVATSpeed)
+    UNIFORM(vec2 cVATPhaseSpacing)
+UNIFORM_BUFFER_END(4, Material)
+
+#include "_Material.glsl"
+
+#ifdef URHO3D_VERTEX_SHADER
+SAMPLER_HIGHP(6, sampler2D sVertexAnimationMap)
+
+/// Return texel corresponding to the vertex in given frame and block of the baked animation.
+vec4 FetchVertexAnimation(int vertexIndex, int frame, int block)
+{
+    int width = int(cVATLayout.x);
+    int rowsPerFrame = int(cVATLayout.y);
+    int numFrames = int(cVATLayout.z);
+    ivec2 coord = ivec2(vertexIndex % width, (block * numFrames + frame) * rowsPerFrame + vertexIndex / width);
+    return texelFetch(sVertexAnimationMap, coord, 0);
+}
+
+/// Decode position in model space from high and low bytes.
+vec3 FetchVertexAnimationPosition(int vertexIndex, int frame)
+{
+    vec3 high = FetchVertexAnimation(vertexIndex, frame, 0).xyz;
+    vec3 low = FetchVertexAnimation(vertexIndex, frame, 1).xyz;
+    vec3 normalized = (high * 65280.0 + low * 255.0) / 65535.0;
+    return cVATBoundsMin + normalized * cVATBoundsSize;
+}
+
+/// Decode normal in model space.
+vec3 FetchVertexAnimationNormal(int vertexIndex, int frame)
+{
+    return FetchVertexAnimation(vertexIndex, frame, 2).xyz * 2.0 - 1.0;
+}
+
+void main()
+{
+    mat4 modelMatrix = GetModelMatrix();
+
+    // Offset animation phase by object position so instances don't move in sync
+    vec3 modelOrigin = vec3(modelMatrix[0][3], modelMatrix[1][3], modelMatrix[2][3]);
+    float animationTime = cElapsedTime * cVATSpeed + dot(modelOrigin.xz, cVATPhaseSpacing);
+    float numFrames = cVATLayout.z;
+    float framePosition = fract(animationTime / cVATLayout.w) * numFrames;
+    int frame1 = int(framePosition) % int(numFrames);
+    int frame2 = (frame1 + 1) % int(numFrames);
+    float blendFactor = fract(framePosition);
+
+    int vertexIndex = int(iTexCoord1.x + 0.5);
+    vec3 position = mix(FetchVertexAnimationPosition(vertexIndex, frame1),
+        FetchVertexAnimationPosition(vertexIndex, frame2), blendFactor);
+
+    VertexTransform vertexTransform;
+    vertexTransform.position = vec4(position, 1.0) * modelMatrix;
+
+    #ifdef URHO3D_VERTEX_NEED_NORMAL
+        vec3 normal = mix(FetchVertexAnimationNormal(vertexIndex, frame1),
+            FetchVertexAnimationNormal(vertexIndex, frame2), blendFactor);
+        mediump mat3 normalMatrix = GetNormalMatrix(modelMatrix);
+        vertexTransform.normal = normalize(normal * normalMatrix);
+
+        ApplyShadowNormalOffset(vertexTransform.position, vertexTransform.normal);
+
+        #ifdef URHO3D_VERTEX_NEED_TANGENT
+            vec4 tangent = GetVertexTangent();
+            vertexTransform.tangent = normalize(tangent.xyz * normalMatrix);
+            vertexTransform.bitangent = cross(vertexTransform.tangent, vertexTransform.normal) * tangent.w;
+        #endif
+    #endif
+
+    FillVertexOutputs(vertexTransform);
+}
+#endif
+
+#ifdef URHO3D_PIXEL_SHADER
+void main()
+{
+#ifdef URHO3D_DEPTH_ONLY_PASS
+    DefaultPixelShader();
+#else
+    SurfaceData surfaceData;
+
+    FillSurfaceCommon(surfaceData);
+    FillSurfaceNormal(surfaceData);
+    FillSurfaceMetallicRoughnessOcclusion(surfaceData);
+    FillSurfaceReflectionColor(surfaceData);
+    FillSurfaceBackground(surfaceData);
+    FillSurfaceAlbedoSpecular(surfaceData);
+    FillSurfaceEmission(surfaceData);
+
+    half3 surfaceColor = GetSurfaceColor(surfaceData);
+    half surfaceAlpha = GetSurfaceAlpha(surfaceData);
+    gl_FragColor = GetFragmentColorAlpha(surfaceColor, surfaceAlpha, surfaceData.fogFactor);
+#endif
+}
+#endif
@@ -24,6 +24,8 @@ UNIFORM_BUFFER_BEGIN(6, Custom)
     UNIFORM(mat4 cTextureToView)
     /// Converts world space to view space.
     UNIFORM(mat4 cWorldToView)
+    /// Converts current view space to view space of previous frame.
+    UNIFORM(mat4 cViewToPreviousView)
 
     /// Inverted size of the input depth and normal textures.
     UNIFORM_HIGHP(vec2 cInputInvSize)
@@ -36,6 +38,10 @@ UNIFORM_BUFFER_BEGIN(6, Custom)
     UNIFORM(half cStrength)
     /// Exponent of the effect
     UNIFORM(half cExponent)
+    /// Offset of noise texture in tiles, changed every frame in temporal mode.
+    UNIFORM(vec2 cNoiseOffset)
+    /// Weight of reprojected history in temporal mode.
+    UNIFORM(half cHistoryWeight)
 
     /// Blur step, aka inverted size of intermediate textures with either x or y set to 0.
     UNIFORM_HIGHP(vec2 cBlurStep)
@@ -204,7 +210,7 @@ void main()
     // Sample textures at the position
     vec3 position = SamplePosition(vTexCoord);
     half3 normal = SampleOrReconstructNormal(position, vTexCoord);
-    half3 noise = DecodeNormal(texture2D(sDiffMap, vTexCoord / cInputInvSize / 4.0));
+    half3 noise = DecodeNormal(texture2D(sDiffMap, vTexCoord / cInputInvSize / 4.0 + cNoiseOffset));
 
     // Sample points around position
     half weightSum = 0.00001;
@@ -250,6 +256,25 @@ void main()
     gl_FragColor = occlusion / weightSum;
 #endif
 
+#ifdef TEMPORAL
+    vec2 texCoord = Saturate(vTexCoord);
+    half currentOcclusion = texture2D(sDiffMap, texCoord).a;
+
+    // Reproject position to previous frame
+    vec3 position = SamplePosition(texCoord);
+    vec3 previousPosition = (vec4(position, 1.0) * cViewToPreviousView).xyz;
+    vec4 previousTexCoordRaw = vec4(previousPosition, 1.0) * cViewToTexture;
+    vec2 previousTexCoord = previousTexCoordRaw.xy / previousTexCoordRaw.w;
+    half4 history = texture2D(sSpecMap, previousTexCoord);
+
+    // Reject history outside of the screen or if depth doesn't match, i.e. surface was disoccluded
+    half2 insideFactor = step(vec2(0.0, 0.0), previousTexCoord) * step(previousTexCoord, vec2(1.0, 1.0));
+    half depthFactor = step(abs(history.r - previousPosition.z), cBlurZThreshold * max(1.0, previousPosition.z));
+    half historyWeight = cHistoryWeight * insideFactor.x * insideFactor.y * depthFactor;
+
+    gl_FragColor = vec4(position.z, 0.0, 0.0, mix(currentOcclusion, history.a, historyWeight));
+#endif
+
 #ifdef PREVIEW
     half4 ao = texture2D(sDiffMap, vTexCoord);
     gl_FragColor = vec4(ao.a, ao.a, ao.a, 1.0);
@@ -257,7 +282,7 @@ void main()
 
 #ifdef COMBINE
     half4 ao = texture2D(sDiffMap, vTexCoord);
-    gl_FragColor = vec4(ao.xyz, 1.0 - ao.a);
+    gl_FragColor = vec4(0.0, 0.0, 0.0, 1.0 - ao.a);
 #endif
 }
 #endif
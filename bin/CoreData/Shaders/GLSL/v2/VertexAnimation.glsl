@@ -0,0 +1 @@
+#include "M_VertexAnimation.glsl"
@@ -100,7 +100,7 @@ half4 Indirect_PBRWater(const half3 reflectionColor, const half3 specular, const
 
 #endif // URHO3D_AMBIENT_PASS
 
-#ifdef URHO3D_LIGHT_PASS
+#if defined(URHO3D_LIGHT_PASS) || defined(URHO3D_CLUSTERED_LIGHTS)
 
 /// Evaluate Blinn-Phong BRDF.
 half BRDF_Direct_BlinnPhongSpecular(const half3 normal, const half3 halfVec, const half specularPower)
@@ -183,7 +183,7 @@ half3 Direct_PBR(const half3 lightColor, const half3 albedo, const half3 specula
 
 #endif // URHO3D_PHYSICAL_MATERIAL
 
-#endif // URHO3D_LIGHT_PASS
+#endif // URHO3D_LIGHT_PASS || URHO3D_CLUSTERED_LIGHTS
 
 #endif // URHO3D_IS_LIT
 
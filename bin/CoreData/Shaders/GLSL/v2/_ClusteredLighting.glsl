@@ -0,0 +1,154 @@
+/// _ClusteredLighting.glsl
+/// [Pixel Shader only]
+/// Helpers to fetch unshadowed point and spot lights and decals binned into view frustum clusters.
+/// Constants should match ClusteredLightProcessor.
+#ifndef _CLUSTERED_LIGHTING_GLSL_
+#define _CLUSTERED_LIGHTING_GLSL_
+
+#ifndef _UNIFORMS_GLSL_
+    #error Include _Uniforms.glsl before _ClusteredLighting.glsl
+#endif
+
+#ifndef _SAMPLERS_GLSL_
+    #error Include _Samplers.glsl before _ClusteredLighting.glsl
+#endif
+
+#if defined(URHO3D_PIXEL_SHADER) && (defined(URHO3D_CLUSTERED_LIGHTS) || defined(URHO3D_CLUSTERED_DECALS))
+
+/// Number of clusters along each axis.
+#define URHO3D_NUM_CLUSTERS_X 16.0
+#define URHO3D_NUM_CLUSTERS_Y 8.0
+#define URHO3D_NUM_CLUSTERS_Z 24.0
+/// Number of texels with light indices per cluster, 4 indices per texel.
+#define URHO3D_NUM_CLUSTER_INDEX_ROWS 8
+/// Number of texels with decal indices per cluster, 4 indices per texel.
+#define URHO3D_NUM_CLUSTER_DECAL_INDEX_ROWS 4
+/// Height of cluster texture. Decal indices of all clusters are stored after light indices.
+#define URHO3D_CLUSTER_TEXTURE_HEIGHT (URHO3D_NUM_CLUSTERS_Z * float(URHO3D_NUM_CLUSTER_INDEX_ROWS + URHO3D_NUM_CLUSTER_DECAL_INDEX_ROWS))
+/// Max number of clustered lights and decals.
+#define URHO3D_MAX_CLUSTERED_LIGHTS 256.0
+/// Height of light data texture. Decal data is stored after light data.
+#define URHO3D_LIGHT_DATA_TEXTURE_HEIGHT 8.0
+
+/// Return cluster coordinates containing world position: XY cluster index and depth slice.
+vec2 GetClusterCoordinates(const vec3 worldPos)
+{
+    vec4 clipPos = vec4(worldPos, 1.0) * cLightClusterViewProj;
+    vec2 ndc = clipPos.xy / clipPos.w;
+    float viewDepth = dot(vec4(worldPos, 1.0), cLightClusterViewZ);
+
+    vec2 clusterXY = clamp(floor((ndc * 0.5 + 0.5) * vec2(URHO3D_NUM_CLUSTERS_X, URHO3D_NUM_CLUSTERS_Y)),
+        vec2(0.0), vec2(URHO3D_NUM_CLUSTERS_X - 1.0, URHO3D_NUM_CLUSTERS_Y - 1.0));
+    float clusterZ = clamp(floor(log(max(viewDepth, 1e-5)) * cLightClusterDepthParams.x + cLightClusterDepthParams.y),
+        0.0, URHO3D_NUM_CLUSTERS_Z - 1.0);
+
+    return vec2(clusterXY.y * URHO3D_NUM_CLUSTERS_X + clusterXY.x, clusterZ);
+}
+
+/// Return UV of the first texel of index list in cluster texture.
+vec2 GetClusterIndexUV(const vec2 clusterCoords, const float firstRow, const float numRowsPerCluster)
+{
+    vec2 texel = vec2(clusterCoords.x, firstRow + clusterCoords.y * numRowsPerCluster);
+    vec2 textureSize = vec2(URHO3D_NUM_CLUSTERS_X * URHO3D_NUM_CLUSTERS_Y, URHO3D_CLUSTER_TEXTURE_HEIGHT);
+    return (texel + 0.5) / textureSize;
+}
+
+/// Return UV of the first texel with light indices of the cluster containing world position.
+vec2 GetLightClusterUV(const vec3 worldPos)
+{
+    return GetClusterIndexUV(GetClusterCoordinates(worldPos), 0.0, float(URHO3D_NUM_CLUSTER_INDEX_ROWS));
+}
+
+/// Return UV of the first texel with decal indices of the cluster containing world position.
+vec2 GetDecalClusterUV(const vec3 worldPos)
+{
+    return GetClusterIndexUV(GetClusterCoordinates(worldPos),
+        URHO3D_NUM_CLUSTERS_Z * float(URHO3D_NUM_CLUSTER_INDEX_ROWS), float(URHO3D_NUM_CLUSTER_DECAL_INDEX_ROWS));
+}
+
+/// Return 4 light or decal indices from cluster texture. Negative index terminates the list.
+#define GetClusterIndices(clusterUV, row) \
+    texture2D(sLightClusterMap, (clusterUV) + vec2(0.0, float(row) / URHO3D_CLUSTER_TEXTURE_HEIGHT))
+
+/// Return row of light data for light index.
+/// 0: position.xyz, inverse range
+/// 1: color.rgb, specular intensity
+/// 2: direction.xyz, spot cutoff
+/// 3: inverse spot cutoff, unused
+#define GetClusteredLightData(lightIndex, row) \
+    texture2D(sLightDataMap, vec2(((lightIndex) + 0.5) / URHO3D_MAX_CLUSTERED_LIGHTS, ((row) + 0.5) / URHO3D_LIGHT_DATA_TEXTURE_HEIGHT))
+
+/// Return row of decal data for decal index.
+/// 0-2: rows of world to decal space matrix, decal box spans [-0.5, 0.5]
+/// 3: UV scale.xy, UV offset.zw
+#define GetClusteredDecalData(decalIndex, row) \
+    texture2D(sLightDataMap, vec2(((decalIndex) + 0.5) / URHO3D_MAX_CLUSTERED_LIGHTS, ((row) + 4.5) / URHO3D_LIGHT_DATA_TEXTURE_HEIGHT))
+
+/// Clustered light input independent of surface.
+struct ClusteredLightData
+{
+    /// Light color with distance and spot attenuation applied.
+    half3 lightColor;
+    /// Normalized light vector.
+    half3 lightVec;
+    /// Specular intensity of the light.
+    half specularIntensity;
+};
+
+/// Fetch light and evaluate attenuation at world position.
+ClusteredLightData GetClusteredLight(const float lightIndex, const vec3 worldPos)
+{
+    vec4 positionAndInvRange = GetClusteredLightData(lightIndex, 0.0);
+    vec4 colorAndSpecular = GetClusteredLightData(lightIndex, 1.0);
+    vec4 directionAndCutoff = GetClusteredLightData(lightIndex, 2.0);
+    float inverseCutoff = GetClusteredLightData(lightIndex, 3.0).x;
+
+    vec3 lightVec = (positionAndInvRange.xyz - worldPos) * positionAndInvRange.w;
+    float lightDist = max(0.001, length(lightVec));
+    float invDistance = max(0.0, 1.0 - lightDist);
+
+    ClusteredLightData result;
+    result.lightVec = lightVec / lightDist;
+    float spotFactor = clamp((dot(result.lightVec, directionAndCutoff.xyz) - directionAndCutoff.w) * inverseCutoff, 0.0, 1.0);
+    result.lightColor = colorAndSpecular.rgb * (invDistance * invDistance * spotFactor);
+    result.specularIntensity = colorAndSpecular.a;
+    return result;
+}
+
+#ifdef URHO3D_CLUSTERED_DECALS
+
+/// Blend decals overlapping world position over albedo. Decals fade out near front and back faces of the box.
+void ApplyClusteredDecals(inout half4 albedo, const vec3 worldPos)
+{
+    vec2 clusterUV = GetDecalClusterUV(worldPos);
+    for (int row = 0; row < URHO3D_NUM_CLUSTER_DECAL_INDEX_ROWS; ++row)
+    {
+        vec4 decalIndices = GetClusterIndices(clusterUV, row);
+        for (int i = 0; i < 4; ++i)
+        {
+            float decalIndex = decalIndices[i];
+            if (decalIndex < 0.0)
+                return;
+
+            vec4 position = vec4(worldPos, 1.0);
+            vec3 localPos = vec3(
+                dot(GetClusteredDecalData(decalIndex, 0.0), position),
+                dot(GetClusteredDecalData(decalIndex, 1.0), position),
+                dot(GetClusteredDecalData(decalIndex, 2.0), position));
+            if (any(greaterThan(abs(localPos), vec3(0.5))))
+                continue;
+
+            vec4 uvScaleOffset = GetClusteredDecalData(decalIndex, 3.0);
+            vec2 uv = (vec2(localPos.x, -localPos.y) + 0.5) * uvScaleOffset.xy + uvScaleOffset.zw;
+            half4 decal = textureLod(sDecalMap, uv, 0.0);
+            half fade = decal.a * smoothstep(0.5, 0.45, abs(localPos.z));
+            albedo.rgb = mix(albedo.rgb, GammaToLightSpace(decal.rgb), fade);
+        }
+    }
+}
+
+#endif // URHO3D_CLUSTERED_DECALS
+
+#endif // URHO3D_PIXEL_SHADER && (URHO3D_CLUSTERED_LIGHTS || URHO3D_CLUSTERED_DECALS)
+
+#endif // _CLUSTERED_LIGHTING_GLSL_
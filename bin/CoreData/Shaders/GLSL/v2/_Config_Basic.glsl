@@ -269,7 +269,7 @@
     #define URHO3D_DEPTH_ONLY_PASS
 #endif
 
-#if defined(URHO3D_LIGHT_DIRECTIONAL) || defined(URHO3D_LIGHT_POINT) || defined(URHO3D_LIGHT_SPOT)
+#if defined(URHO3D_LIGHT_DIRECTIONAL) || defined(URHO3D_LIGHT_POINT) || defined(URHO3D_LIGHT_SPOT) || defined(URHO3D_LIGHT_DYNAMIC_TYPE)
     #define URHO3D_LIGHT_PASS
 #endif
 
@@ -29,6 +29,12 @@
 /// Whether to blur reflection according to surface roughness.
 // #define URHO3D_BLUR_REFLECTION
 
+/// Whether unshadowed point and spot lights are evaluated in ambient pass from light clusters.
+// #define URHO3D_CLUSTERED_LIGHTS
+
+/// Whether decals binned into light clusters are applied to surface albedo.
+// #define URHO3D_CLUSTERED_DECALS
+
 /// =================================== Disable inputs ===================================
 
 #ifdef URHO3D_DISABLE_DIFFUSE_SAMPLING
@@ -130,6 +136,32 @@
 
         #endif // URHO3D_LIGHT_PASS
 
+        #if defined(URHO3D_AMBIENT_PASS) && defined(URHO3D_CLUSTERED_LIGHTS)
+
+            #if !defined(URHO3D_SURFACE_VOLUMETRIC)
+                #ifndef URHO3D_SURFACE_NEED_NORMAL
+                    #define URHO3D_SURFACE_NEED_NORMAL
+                #endif
+            #endif
+
+            #ifndef URHO3D_PIXEL_NEED_WORLD_POSITION
+                #define URHO3D_PIXEL_NEED_WORLD_POSITION
+            #endif
+
+            #if URHO3D_SPECULAR > 0
+                #ifndef URHO3D_PIXEL_NEED_EYE_VECTOR
+                    #define URHO3D_PIXEL_NEED_EYE_VECTOR
+                #endif
+            #endif
+
+        #endif // URHO3D_CLUSTERED_LIGHTS
+
+        #if defined(URHO3D_CLUSTERED_DECALS)
+            #ifndef URHO3D_PIXEL_NEED_WORLD_POSITION
+                #define URHO3D_PIXEL_NEED_WORLD_POSITION
+            #endif
+        #endif // URHO3D_CLUSTERED_DECALS
+
         #if defined(URHO3D_PHYSICAL_MATERIAL) || defined(URHO3D_GBUFFER_PASS)
             #ifndef URHO3D_SURFACE_NEED_NORMAL
                 #define URHO3D_SURFACE_NEED_NORMAL
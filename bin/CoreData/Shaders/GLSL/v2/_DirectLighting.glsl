@@ -8,8 +8,11 @@
 #ifdef URHO3D_LIGHT_PASS
 
 /// Return light vector normalized to light range.
+/// If light type is dynamic, zero inverse range indicates directional light.
 #ifdef URHO3D_LIGHT_DIRECTIONAL
     #define GetLightVector(worldPos) cLightDir
+#elif defined(URHO3D_LIGHT_DYNAMIC_TYPE)
+    #define GetLightVector(worldPos) (cLightPos.w > 0.0 ? (cLightPos.xyz - (worldPos)) * cLightPos.w : cLightDir)
 #else
     #define GetLightVector(worldPos) ((cLightPos.xyz - (worldPos)) * cLightPos.w)
 #endif
@@ -31,6 +34,12 @@
     /// Normalize light vector, return normalized vector and distance
     #ifdef URHO3D_LIGHT_DIRECTIONAL
         #define NormalizeLightVector(lightVec) vec4(lightVec, 0.0)
+    #elif defined(URHO3D_LIGHT_DYNAMIC_TYPE)
+        half4 NormalizeLightVector(const half3 lightVec)
+        {
+            half lightDist = max(0.001, length(lightVec));
+            return vec4(lightVec / lightDist, cLightPos.w > 0.0 ? lightDist : 0.0);
+        }
     #else
         half4 NormalizeLightVector(const half3 lightVec)
         {
@@ -73,7 +82,8 @@
             #define GetLightColorFromShape(shapePos) (cLightColor.rgb)
         #endif
     #else
-        #ifdef URHO3D_LIGHT_SPOT
+        // Spot cutoff parameters of point and directional lights never attenuate the color
+        #if defined(URHO3D_LIGHT_SPOT) || defined(URHO3D_LIGHT_DYNAMIC_TYPE)
             #define GetLightColor(lightVec) \
                 (cLightColor.rgb * clamp((dot(lightVec, cLightDir) - cSpotAngle.x) * cSpotAngle.y, 0.0, 1.0))
         #else
@@ -18,6 +18,7 @@
 #ifdef URHO3D_IS_LIT
 #include "_IndirectLighting.glsl"
 #include "_DirectLighting.glsl"
+#include "_ClusteredLighting.glsl"
 #include "_Shadow.glsl"
 #endif
 #include "_Fog.glsl"
@@ -104,6 +104,47 @@
     }
 #endif
 
+#if defined(URHO3D_AMBIENT_PASS) && defined(URHO3D_CLUSTERED_LIGHTS)
+    /// Calculate lighting from all clustered lights affecting the pixel.
+    half3 CalculateClusteredLighting(const SurfaceData surfaceData)
+    {
+        half3 result = vec3(0.0);
+        vec2 clusterUV = GetLightClusterUV(vWorldPos);
+        for (int row = 0; row < URHO3D_NUM_CLUSTER_INDEX_ROWS; ++row)
+        {
+            vec4 lightIndices = GetClusterIndices(clusterUV, row);
+            for (int i = 0; i < 4; ++i)
+            {
+                float lightIndex = lightIndices[i];
+                if (lightIndex < 0.0)
+                    return result;
+
+                ClusteredLightData lightData = GetClusteredLight(lightIndex, vWorldPos);
+
+            #if defined(URHO3D_PHYSICAL_MATERIAL) || URHO3D_SPECULAR > 0
+                half3 halfVec = normalize(surfaceData.eyeVec + lightData.lightVec);
+            #endif
+
+            #if defined(URHO3D_SURFACE_VOLUMETRIC)
+                result += Direct_Volumetric(lightData.lightColor, surfaceData.albedo.rgb);
+            #elif defined(URHO3D_PHYSICAL_MATERIAL)
+                result += Direct_PBR(lightData.lightColor, surfaceData.albedo.rgb,
+                    surfaceData.specular, surfaceData.roughness,
+                    lightData.lightVec, surfaceData.normal, surfaceData.eyeVec, halfVec);
+            #elif URHO3D_SPECULAR > 0
+                result += Direct_SimpleSpecular(lightData.lightColor,
+                    surfaceData.albedo.rgb, surfaceData.specular,
+                    lightData.lightVec, surfaceData.normal, halfVec, cMatSpecColor.a, lightData.specularIntensity);
+            #else
+                result += Direct_Simple(lightData.lightColor,
+                    surfaceData.albedo.rgb, lightData.lightVec, surfaceData.normal);
+            #endif
+            }
+        }
+        return result;
+    }
+#endif
+
 /// Return color with applied lighting, but without fog.
 /// Fills all channels of geometry buffer except destination color.
 half3 GetSurfaceColor(const SurfaceData surfaceData)
@@ -126,6 +167,9 @@ half3 GetSurfaceColor(const SurfaceData surfaceData)
     gl_FragData[3] = vec4(surfaceData.normal * 0.5 + 0.5, 0.0);
 #elif defined(URHO3D_LIGHT_PASS)
     surfaceColor += CalculateDirectLighting(surfaceData);
+#endif
+#if defined(URHO3D_AMBIENT_PASS) && defined(URHO3D_CLUSTERED_LIGHTS)
+    surfaceColor += CalculateClusteredLighting(surfaceData);
 #endif
     return surfaceColor;
 }
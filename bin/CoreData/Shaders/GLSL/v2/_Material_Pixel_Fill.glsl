@@ -173,6 +173,10 @@ void _GetFragmentAlbedoSpecular(const half oneMinusReflectivity, out half4 albed
     albedo *= LinearToLightSpaceAlpha(vColor);
 #endif
 
+#if defined(URHO3D_CLUSTERED_DECALS) && defined(URHO3D_IS_LIT)
+    ApplyClusteredDecals(albedo, vWorldPos);
+#endif
+
 #ifdef URHO3D_PHYSICAL_MATERIAL
     specular = albedo.rgb * (1.0 - oneMinusReflectivity);
     albedo.rgb *= oneMinusReflectivity;
@@ -28,6 +28,13 @@ SAMPLER(9, samplerCube sLightCubeMap)
     SAMPLER(15, samplerCube sZoneCubeMap)
     SAMPLER(15, sampler3D sZoneVolumeMap)
 #endif
+#if (defined(URHO3D_CLUSTERED_LIGHTS) || defined(URHO3D_CLUSTERED_DECALS)) && !defined(GL_ES)
+    SAMPLER_HIGHP(11, sampler2D sLightClusterMap)
+    SAMPLER_HIGHP(12, sampler2D sLightDataMap)
+#endif
+#if defined(URHO3D_CLUSTERED_DECALS) && !defined(GL_ES)
+    SAMPLER(14, sampler2D sDecalMap)
+#endif
 
 /// Helpers to sample sDiffMap in specified color space.
 #ifdef URHO3D_MATERIAL_DIFFUSE_HINT
@@ -62,6 +62,15 @@ UNIFORM_BUFFER_BEGIN(1, Camera)
     UNIFORM(half3 cFogColor)
     /// Scale of normal shadow bias.
     UNIFORM(half cNormalOffsetScale)
+#if defined(URHO3D_CLUSTERED_LIGHTS) || defined(URHO3D_CLUSTERED_DECALS)
+    /// World to clip space matrix of the camera used to build light clusters.
+    UNIFORM_HIGHP(mat4 cLightClusterViewProj)
+    /// Row of world to view space matrix used to calculate linear depth for light clusters.
+    UNIFORM_HIGHP(vec4 cLightClusterViewZ)
+    /// xy: Scale and bias of logarithm of linear depth used to calculate depth slice of light cluster.
+    /// zw: Unused.
+    UNIFORM_HIGHP(vec4 cLightClusterDepthParams)
+#endif
 UNIFORM_BUFFER_END(1, Camera)
 
 /// Zone: Reflection probe parameters.
@@ -203,11 +212,26 @@ UNIFORM_BUFFER_END(3, Light)
     #define UNIFORMS_PLANAR_REFLECTION
 #endif
 
+/// Uniforms needed for terrain displaced by height map in vertex shader.
+/// cTerrainGridX: Dot with world position to get X coordinate in height map grid.
+/// cTerrainGridZ: Dot with world position to get Z coordinate in height map grid.
+/// cTerrainSize.xy: Number of vertices in height map grid.
+/// cTerrainSize.zw: Spacing between vertices along X and Z axes.
+#ifdef URHO3D_TERRAIN_HEIGHTMAP
+    #define UNIFORMS_TERRAIN_HEIGHTMAP \
+        UNIFORM(vec4 cTerrainGridX) \
+        UNIFORM(vec4 cTerrainGridZ) \
+        UNIFORM(vec4 cTerrainSize)
+#else
+    #define UNIFORMS_TERRAIN_HEIGHTMAP
+#endif
+
 #define DEFAULT_MATERIAL_UNIFORMS \
     UNIFORMS_UV_TRANSFORM \
     UNIFORMS_LIGHTMAP \
     UNIFORMS_SURFACE \
-    UNIFORMS_PLANAR_REFLECTION
+    UNIFORMS_PLANAR_REFLECTION \
+    UNIFORMS_TERRAIN_HEIGHTMAP
 
 /// cLMOffset.xy: Scale applied to lightmap UVs;
 /// cLMOffset.zw: Offset applied to lightmap UVs.
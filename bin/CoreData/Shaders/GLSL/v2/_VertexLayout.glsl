@@ -15,22 +15,61 @@ VERTEX_INPUT(vec4 iPos)
 #endif
 
 // Optional parameters
-#ifdef URHO3D_VERTEX_HAS_TEXCOORD0
-    VERTEX_INPUT(vec2 iTexCoord)
-#endif
-#ifdef URHO3D_VERTEX_HAS_TEXCOORD1
-    VERTEX_INPUT(vec2 iTexCoord1)
+#if defined(URHO3D_BILLBOARD_PER_INSTANCE)
+    // Per-instance UV rectangle, per-instance size and rotation cosine and sine, per-vertex quad corner
+    VERTEX_INPUT(vec4 iTexCoord)
+    VERTEX_INPUT(vec4 iTexCoord1)
+    VERTEX_INPUT(vec2 iTexCoord2)
+#else
+    #ifdef URHO3D_VERTEX_HAS_TEXCOORD0
+        VERTEX_INPUT(vec2 iTexCoord)
+    #endif
+    #ifdef URHO3D_VERTEX_HAS_TEXCOORD1
+        VERTEX_INPUT(vec2 iTexCoord1)
+    #endif
 #endif
 #ifdef URHO3D_VERTEX_HAS_COLOR
     VERTEX_INPUT(vec4 iColor)
 #endif
 #ifdef URHO3D_VERTEX_HAS_NORMAL
-    VERTEX_INPUT(vec3 iNormal)
+    #ifdef URHO3D_VERTEX_NORMAL_OCTAHEDRAL
+        VERTEX_INPUT(vec2 iNormal)
+    #else
+        VERTEX_INPUT(vec3 iNormal)
+    #endif
 #endif
 #ifdef URHO3D_VERTEX_HAS_TANGENT
     VERTEX_INPUT(vec4 iTangent)
 #endif
 
+/// Return vertex normal in model space, decoded from compact format if needed.
+#ifdef URHO3D_VERTEX_HAS_NORMAL
+vec3 GetVertexNormal()
+{
+#ifdef URHO3D_VERTEX_NORMAL_OCTAHEDRAL
+    vec3 normal = vec3(iNormal.xy, 1.0 - abs(iNormal.x) - abs(iNormal.y));
+    float t = max(-normal.z, 0.0);
+    normal.x += normal.x >= 0.0 ? -t : t;
+    normal.y += normal.y >= 0.0 ? -t : t;
+    return normalize(normal);
+#else
+    return iNormal;
+#endif
+}
+#endif
+
+/// Return vertex tangent in model space and sign of binormal, decoded from compact format if needed.
+#ifdef URHO3D_VERTEX_HAS_TANGENT
+vec4 GetVertexTangent()
+{
+#ifdef URHO3D_VERTEX_TANGENT_PACKED
+    return iTangent * 2.0 - 1.0;
+#else
+    return iTangent;
+#endif
+}
+#endif
+
 #endif // URHO3D_VERTEX_SHADER
 
 #endif // _VERTEX_LAYOUT_GLSL_
@@ -13,10 +13,41 @@ mediump mat3 GetNormalMatrix(mat4 modelMatrix)
     return mat3(modelMatrix[0].xyz, modelMatrix[1].xyz, modelMatrix[2].xyz);
 }
 
+#ifdef URHO3D_TERRAIN_HEIGHTMAP
+    SAMPLER(6, sampler2D sHeightMap)
+
+    /// Return vertex position in terrain height map grid.
+    /// Vertex position in model space is expected to be in terrain plane.
+    vec2 GetTerrainGridPosition()
+    {
+        vec4 position = iPos * cModel;
+        return floor(vec2(dot(position, cTerrainGridX), dot(position, cTerrainGridZ)) + 0.5);
+    }
+
+    /// Return terrain height in model space at given position in height map grid.
+    float SampleTerrainHeight(vec2 gridPosition)
+    {
+        vec2 texel = clamp(gridPosition, vec2(0.0, 0.0), cTerrainSize.xy - 1.0);
+        return texture2DLod(sHeightMap, (texel + 0.5) / cTerrainSize.xy, 0.0).r;
+    }
+
+    /// Return terrain UV coordinate at given position in height map grid.
+    vec2 GetTerrainTexCoord(vec2 gridPosition)
+    {
+        return vec2(gridPosition.x, cTerrainSize.y - 1.0 - gridPosition.y) / (cTerrainSize.xy - 1.0);
+    }
+#endif
+
 /// Return transformed primary UV coordinate.
 vec2 GetTransformedTexCoord()
 {
-    #ifdef URHO3D_VERTEX_HAS_TEXCOORD0
+    #if defined(URHO3D_TERRAIN_HEIGHTMAP)
+        vec2 texCoord = GetTerrainTexCoord(GetTerrainGridPosition());
+        return vec2(dot(texCoord, cUOffset.xy) + cUOffset.w, dot(texCoord, cVOffset.xy) + cVOffset.w);
+    #elif defined(URHO3D_BILLBOARD_PER_INSTANCE)
+        vec2 texCoord = mix(iTexCoord.xy, iTexCoord.zw, iTexCoord2);
+        return vec2(dot(texCoord, cUOffset.xy) + cUOffset.w, dot(texCoord, cVOffset.xy) + cVOffset.w);
+    #elif defined(URHO3D_VERTEX_HAS_TEXCOORD0)
         return vec2(dot(iTexCoord, cUOffset.xy) + cUOffset.w, dot(iTexCoord, cVOffset.xy) + cVOffset.w);
     #else
         return vec2(0.0, 0.0);
@@ -27,7 +58,11 @@ vec2 GetTransformedTexCoord()
     /// Return transformed secondary UV coordinate for ligthmap.
     vec2 GetLightMapTexCoord()
     {
-        return iTexCoord1 * cLMOffset.xy + cLMOffset.zw;
+        #ifdef URHO3D_TERRAIN_HEIGHTMAP
+            return GetTerrainTexCoord(GetTerrainGridPosition()) * cLMOffset.xy + cLMOffset.zw;
+        #else
+            return iTexCoord1 * cLMOffset.xy + cLMOffset.zw;
+        #endif
     }
 #endif
 
@@ -118,7 +153,12 @@ mat4 GetModelMatrix()
 ///
 /// URHO3D_GEOMETRY_BILLBOARD:
 ///   iPos.xyz: Billboard position in model space
-///   iTexCoord1.xy: Billboard size
+///   iTexCoord1.xy: Billboard corner offset
+///
+/// URHO3D_GEOMETRY_BILLBOARD with URHO3D_BILLBOARD_PER_INSTANCE:
+///   iPos.xyz: (per-instance) Billboard position in model space
+///   iTexCoord1: (per-instance) Billboard size, cosine and sine of billboard rotation
+///   iTexCoord2.xy: Quad corner in [0, 1] range
 ///
 /// URHO3D_GEOMETRY_DIRBILLBOARD:
 ///   iPos.xyz: Billboard position in model space
@@ -134,7 +174,43 @@ mat4 GetModelMatrix()
 ///   iPos.xyz: Trail position in model space
 ///   iTangent.xyz: Trail previous position in model space
 ///   iTangent.w: Trail width
-#if defined(URHO3D_GEOMETRY_STATIC) || defined(URHO3D_GEOMETRY_SKINNED)
+///
+/// URHO3D_GEOMETRY_STATIC with URHO3D_TERRAIN_HEIGHTMAP:
+///   iPos.xz: Vertex position in model space, height is sampled from sHeightMap
+#if defined(URHO3D_GEOMETRY_STATIC) && defined(URHO3D_TERRAIN_HEIGHTMAP)
+    VertexTransform GetVertexTransform()
+    {
+        mat4 modelMatrix = GetModelMatrix();
+        vec2 gridPosition = GetTerrainGridPosition();
+
+        VertexTransform result;
+        result.position = vec4(iPos.x, SampleTerrainHeight(gridPosition), iPos.z, 1.0) * modelMatrix;
+
+        #ifdef URHO3D_VERTEX_NEED_NORMAL
+            float heightWest = SampleTerrainHeight(gridPosition - vec2(1.0, 0.0));
+            float heightEast = SampleTerrainHeight(gridPosition + vec2(1.0, 0.0));
+            float heightSouth = SampleTerrainHeight(gridPosition - vec2(0.0, 1.0));
+            float heightNorth = SampleTerrainHeight(gridPosition + vec2(0.0, 1.0));
+            half3 normal = normalize(vec3(
+                (heightWest - heightEast) * cTerrainSize.w,
+                2.0 * cTerrainSize.z * cTerrainSize.w,
+                (heightSouth - heightNorth) * cTerrainSize.z));
+
+            mediump mat3 normalMatrix = GetNormalMatrix(modelMatrix);
+            result.normal = normalize(normal * normalMatrix);
+
+            ApplyShadowNormalOffset(result.position, result.normal);
+
+            #ifdef URHO3D_VERTEX_NEED_TANGENT
+                half3 tangent = normalize(vec3(1.0, 0.0, 0.0) - normal * normal.x);
+                result.tangent = normalize(tangent * normalMatrix);
+                result.bitangent = cross(result.tangent, result.normal);
+            #endif
+        #endif
+
+        return result;
+    }
+#elif defined(URHO3D_GEOMETRY_STATIC) || defined(URHO3D_GEOMETRY_SKINNED)
     VertexTransform GetVertexTransform()
     {
         mat4 modelMatrix = GetModelMatrix();
@@ -144,26 +220,38 @@ mat4 GetModelMatrix()
 
         #ifdef URHO3D_VERTEX_NEED_NORMAL
             mediump mat3 normalMatrix = GetNormalMatrix(modelMatrix);
-            result.normal = normalize(iNormal * normalMatrix);
+            result.normal = normalize(GetVertexNormal() * normalMatrix);
 
             ApplyShadowNormalOffset(result.position, result.normal);
 
             #ifdef URHO3D_VERTEX_NEED_TANGENT
-                result.tangent = normalize(iTangent.xyz * normalMatrix);
-                result.bitangent = cross(result.tangent, result.normal) * iTangent.w;
+                vec4 tangent = GetVertexTangent();
+                result.tangent = normalize(tangent.xyz * normalMatrix);
+                result.bitangent = cross(result.tangent, result.normal) * tangent.w;
             #endif
         #endif
 
         return result;
     }
 #elif defined(URHO3D_GEOMETRY_BILLBOARD)
+    /// Return offset of billboard corner in billboard plane.
+    vec2 GetBillboardCornerOffset()
+    {
+    #ifdef URHO3D_BILLBOARD_PER_INSTANCE
+        vec2 corner = vec2(iTexCoord2.x * 2.0 - 1.0, 1.0 - iTexCoord2.y * 2.0) * iTexCoord1.xy;
+        return vec2(corner.x * iTexCoord1.z + corner.y * iTexCoord1.w, corner.y * iTexCoord1.z - corner.x * iTexCoord1.w);
+    #else
+        return iTexCoord1.xy;
+    #endif
+    }
+
     VertexTransform GetVertexTransform()
     {
         mat4 modelMatrix = GetModelMatrix();
 
         VertexTransform result;
         result.position = iPos * modelMatrix;
-        result.position.xyz += vec3(iTexCoord1.x, iTexCoord1.y, 0.0) * cBillboardRot;
+        result.position.xyz += vec3(GetBillboardCornerOffset(), 0.0) * cBillboardRot;
 
         #ifdef URHO3D_VERTEX_NEED_NORMAL
             result.normal = vec3(-cBillboardRot[0][2], -cBillboardRot[1][2], -cBillboardRot[2][2]);